@@ -0,0 +1,535 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "atomic.h"
+#include "active_object.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include active objects.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_ACTIVE_OBJECTS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use active objects.
+    #endif
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use active objects.
+    #endif
+
+/* The size of a structure rounded up so whatever follows it in the same
+ * allocation is aligned. */
+    #define activeALIGNED_SIZE( xSize )    ( ( ( xSize ) + ( ( size_t ) portBYTE_ALIGNMENT - 1U ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* Events that are not in use are linked through their first bytes.  The
+ * events follow the pool structure in the same allocation. */
+    typedef struct ActiveEventPoolDefinition
+    {
+        void * pvFreeEvents;      /*< The first event that is not in use, or NULL if they all are. */
+        UBaseType_t uxFreeEvents; /*< The number of events that are not in use. */
+    } ActiveEventPool_t;
+
+/* Bit n of the dispatcher task's notification value is set when an event is
+ * posted to pxActiveObjects[ n ]. */
+    typedef struct ActiveDispatcherDefinition
+    {
+        TaskHandle_t xTask;                                                   /*< The task that calls the handlers. */
+        struct ActiveObjectDefinition * pxActiveObjects[ activeMAX_PRIORITIES ]; /*< The attached objects, indexed by priority. */
+    } ActiveDispatcher_t;
+
+    typedef struct ActiveObjectDefinition
+    {
+        QueueHandle_t xEventQueue;               /*< Holds pointers to the events waiting to be handled. */
+        ActiveDispatcher_t * pxDispatcher;       /*< The dispatcher the object is attached to. */
+        uint32_t ulReadyBit;                     /*< The notification bit that corresponds to the object's priority. */
+        const ActiveEventHandler_t * pxHandlers; /*< The handlers, indexed by signal. */
+        UBaseType_t uxNumberOfSignals;           /*< The number of entries in pxHandlers. */
+        void * pvContext;                        /*< The value passed to the handlers. */
+    } ActiveObject_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The function run by every dispatcher task.
+ */
+    static portTASK_FUNCTION_PROTO( prvActiveDispatcherTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns an event to its pool.  Must be called from a critical section.
+ */
+    static void prvFreeEvent( ActiveEvent_t * pxEvent ) PRIVILEGED_FUNCTION;
+
+/*
+ * Takes an event from a pool.  Must be called from a critical section.
+ */
+    static ActiveEvent_t * prvAllocateEvent( ActiveEventPool_t * pxPool,
+                                             UBaseType_t uxSignal ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvActiveDispatcherTask, pvParameters )
+    {
+        ActiveDispatcher_t * const pxDispatcher = ( ActiveDispatcher_t * ) pvParameters; /*lint !e9087 The parameter is always the dispatcher the task belongs to. */
+        ActiveObject_t * pxActiveObject;
+        ActiveEvent_t * pxEvent;
+        uint32_t ulReady = 0U;
+        uint32_t ulNotified;
+        UBaseType_t uxPriority;
+
+        for( ; ; )
+        {
+            /* Collect the objects that have been posted to, only blocking if no
+             * object is already known to have events waiting. */
+            if( xTaskNotifyWait( 0U, ( uint32_t ) 0xFFFFFFFFU, &ulNotified, ( ulReady == 0U ) ? portMAX_DELAY : 0U ) == pdTRUE )
+            {
+                ulReady |= ulNotified;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ulReady != 0U )
+            {
+                /* Handle one event of the highest priority object, then check
+                 * for posts again in case a higher priority object has events. */
+                uxPriority = activeMAX_PRIORITIES - 1U;
+
+                while( ( ulReady & ( 1UL << uxPriority ) ) == 0U )
+                {
+                    uxPriority--;
+                }
+
+                pxActiveObject = pxDispatcher->pxActiveObjects[ uxPriority ];
+
+                if( xQueueReceive( pxActiveObject->xEventQueue, &pxEvent, 0 ) == pdPASS )
+                {
+                    traceACTIVE_OBJECT_DISPATCH( pxActiveObject, pxEvent );
+
+                    if( ( pxEvent->uxSignal < pxActiveObject->uxNumberOfSignals ) &&
+                        ( pxActiveObject->pxHandlers[ pxEvent->uxSignal ] != NULL ) )
+                    {
+                        pxActiveObject->pxHandlers[ pxEvent->uxSignal ]( pxActiveObject->pvContext, pxEvent );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    vActiveEventRelease( pxEvent );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* An event posted after this check sets the object's bit in
+                 * the notification value again. */
+                if( uxQueueMessagesWaiting( pxActiveObject->xEventQueue ) == 0U )
+                {
+                    ulReady &= ~( pxActiveObject->ulReadyBit );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeEvent( ActiveEvent_t * pxEvent )
+    {
+        ActiveEventPool_t * const pxPool = pxEvent->pxPool;
+
+        *( ( void ** ) pxEvent ) = pxPool->pvFreeEvents; /*lint !e9087 !e740 A free event holds the link to the next free event. */
+        pxPool->pvFreeEvents = ( void * ) pxEvent;
+        ( pxPool->uxFreeEvents )++;
+    }
+/*-----------------------------------------------------------*/
+
+    static ActiveEvent_t * prvAllocateEvent( ActiveEventPool_t * pxPool,
+                                             UBaseType_t uxSignal )
+    {
+        ActiveEvent_t * pxEvent = ( ActiveEvent_t * ) pxPool->pvFreeEvents; /*lint !e9079 The free list only holds events. */
+
+        if( pxEvent != NULL )
+        {
+            pxPool->pvFreeEvents = *( ( void ** ) pxEvent ); /*lint !e9087 !e740 A free event holds the link to the next free event. */
+            ( pxPool->uxFreeEvents )--;
+
+            pxEvent->uxSignal = uxSignal;
+            pxEvent->ulReferenceCount = 1U;
+            pxEvent->pxPool = pxPool;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxEvent;
+    }
+/*-----------------------------------------------------------*/
+
+    ActiveEventPoolHandle_t xActiveEventPoolCreate( size_t xEventSize,
+                                                    UBaseType_t uxNumberOfEvents )
+    {
+        ActiveEventPool_t * pxPool;
+        uint8_t * pucEvent;
+        size_t xBlockSize;
+        UBaseType_t ux;
+
+        configASSERT( xEventSize >= sizeof( ActiveEvent_t ) );
+        configASSERT( uxNumberOfEvents > ( UBaseType_t ) 0 );
+
+        xBlockSize = activeALIGNED_SIZE( xEventSize );
+
+        /* Check for multiplication overflow. */
+        if( ( SIZE_MAX / xBlockSize ) > ( size_t ) uxNumberOfEvents )
+        {
+            pxPool = ( ActiveEventPool_t * ) pvPortMalloc( activeALIGNED_SIZE( sizeof( ActiveEventPool_t ) ) + ( xBlockSize * ( size_t ) uxNumberOfEvents ) ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            pxPool = NULL;
+        }
+
+        if( pxPool != NULL )
+        {
+            pxPool->pvFreeEvents = NULL;
+            pxPool->uxFreeEvents = 0U;
+            pucEvent = ( ( uint8_t * ) pxPool ) + activeALIGNED_SIZE( sizeof( ActiveEventPool_t ) ); /*lint !e9016 Pointer arithmetic is needed to find the events that follow the pool structure. */
+
+            for( ux = 0U; ux < uxNumberOfEvents; ux++ )
+            {
+                ( ( ActiveEvent_t * ) pucEvent )->pxPool = pxPool; /*lint !e9087 !e826 The block is the size of an event. */
+                prvFreeEvent( ( ActiveEvent_t * ) pucEvent );      /*lint !e9087 !e826 The block is the size of an event. */
+                pucEvent += xBlockSize;
+            }
+
+            traceACTIVE_EVENT_POOL_CREATE( pxPool );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxPool;
+    }
+/*-----------------------------------------------------------*/
+
+    ActiveEvent_t * pxActiveEventAllocate( ActiveEventPoolHandle_t xPool,
+                                           UBaseType_t uxSignal )
+    {
+        ActiveEvent_t * pxEvent;
+
+        configASSERT( xPool );
+
+        taskENTER_CRITICAL();
+        {
+            pxEvent = prvAllocateEvent( xPool, uxSignal );
+        }
+        taskEXIT_CRITICAL();
+
+        return pxEvent;
+    }
+/*-----------------------------------------------------------*/
+
+    ActiveEvent_t * pxActiveEventAllocateFromISR( ActiveEventPoolHandle_t xPool,
+                                                  UBaseType_t uxSignal )
+    {
+        ActiveEvent_t * pxEvent;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xPool );
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            pxEvent = prvAllocateEvent( xPool, uxSignal );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return pxEvent;
+    }
+/*-----------------------------------------------------------*/
+
+    void vActiveEventRetain( const ActiveEvent_t * pxEvent )
+    {
+        ActiveEvent_t * const pxWritableEvent = ( ActiveEvent_t * ) pxEvent; /*lint !e9005 The reference count is the only member that is written. */
+
+        configASSERT( pxEvent );
+
+        if( pxEvent->pxPool != NULL )
+        {
+            configASSERT( pxEvent->ulReferenceCount > 0U );
+            ( void ) Atomic_Increment_u32( &( pxWritableEvent->ulReferenceCount ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vActiveEventRelease( const ActiveEvent_t * pxEvent )
+    {
+        ActiveEvent_t * const pxWritableEvent = ( ActiveEvent_t * ) pxEvent; /*lint !e9005 The reference count is the only member that is written. */
+
+        configASSERT( pxEvent );
+
+        if( pxEvent->pxPool != NULL )
+        {
+            configASSERT( pxEvent->ulReferenceCount > 0U );
+
+            /* Atomic_Decrement_u32() returns the count before the decrement. */
+            if( Atomic_Decrement_u32( &( pxWritableEvent->ulReferenceCount ) ) == 1U )
+            {
+                taskENTER_CRITICAL();
+                {
+                    prvFreeEvent( pxWritableEvent );
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vActiveEventReleaseFromISR( const ActiveEvent_t * pxEvent )
+    {
+        ActiveEvent_t * const pxWritableEvent = ( ActiveEvent_t * ) pxEvent; /*lint !e9005 The reference count is the only member that is written. */
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxEvent );
+
+        if( pxEvent->pxPool != NULL )
+        {
+            configASSERT( pxEvent->ulReferenceCount > 0U );
+
+            if( Atomic_Decrement_u32( &( pxWritableEvent->ulReferenceCount ) ) == 1U )
+            {
+                uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                {
+                    prvFreeEvent( pxWritableEvent );
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    ActiveDispatcherHandle_t xActiveDispatcherCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                      configSTACK_DEPTH_TYPE uxStackDepth,
+                                                      UBaseType_t uxPriority )
+    {
+        ActiveDispatcher_t * pxDispatcher;
+        UBaseType_t ux;
+
+        pxDispatcher = ( ActiveDispatcher_t * ) pvPortMalloc( sizeof( ActiveDispatcher_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxDispatcher != NULL )
+        {
+            for( ux = 0U; ux < activeMAX_PRIORITIES; ux++ )
+            {
+                pxDispatcher->pxActiveObjects[ ux ] = NULL;
+            }
+
+            if( xTaskCreate( prvActiveDispatcherTask,
+                             pcName,
+                             uxStackDepth,
+                             ( void * ) pxDispatcher,
+                             uxPriority,
+                             &( pxDispatcher->xTask ) ) != pdPASS )
+            {
+                vPortFree( pxDispatcher );
+                pxDispatcher = NULL;
+            }
+            else
+            {
+                traceACTIVE_DISPATCHER_CREATE( pxDispatcher );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxDispatcher;
+    }
+/*-----------------------------------------------------------*/
+
+    ActiveObjectHandle_t xActiveObjectCreate( ActiveDispatcherHandle_t xDispatcher,
+                                              UBaseType_t uxPriority,
+                                              UBaseType_t uxQueueLength,
+                                              const ActiveEventHandler_t * pxHandlers,
+                                              UBaseType_t uxNumberOfSignals,
+                                              void * pvContext )
+    {
+        ActiveDispatcher_t * const pxDispatcher = xDispatcher;
+        ActiveObject_t * pxActiveObject;
+
+        configASSERT( pxDispatcher );
+        configASSERT( uxPriority < activeMAX_PRIORITIES );
+        configASSERT( pxDispatcher->pxActiveObjects[ uxPriority ] == NULL );
+        configASSERT( ( pxHandlers != NULL ) || ( uxNumberOfSignals == 0U ) );
+
+        pxActiveObject = ( ActiveObject_t * ) pvPortMalloc( sizeof( ActiveObject_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxActiveObject != NULL )
+        {
+            pxActiveObject->xEventQueue = xQueueCreate( uxQueueLength, sizeof( ActiveEvent_t * ) );
+
+            if( pxActiveObject->xEventQueue != NULL )
+            {
+                pxActiveObject->pxDispatcher = pxDispatcher;
+                pxActiveObject->ulReadyBit = 1UL << uxPriority;
+                pxActiveObject->pxHandlers = pxHandlers;
+                pxActiveObject->uxNumberOfSignals = uxNumberOfSignals;
+                pxActiveObject->pvContext = pvContext;
+
+                /* The dispatcher only reads this entry once the object's bit
+                 * is set by a post, which cannot happen before this returns. */
+                pxDispatcher->pxActiveObjects[ uxPriority ] = pxActiveObject;
+
+                traceACTIVE_OBJECT_CREATE( pxActiveObject );
+            }
+            else
+            {
+                vPortFree( pxActiveObject );
+                pxActiveObject = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxActiveObject;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xActiveObjectPost( ActiveObjectHandle_t xActiveObject,
+                                  const ActiveEvent_t * pxEvent,
+                                  TickType_t xTicksToWait )
+    {
+        ActiveObject_t * const pxActiveObject = xActiveObject;
+        BaseType_t xReturn;
+
+        configASSERT( pxActiveObject );
+        configASSERT( pxEvent );
+
+        traceACTIVE_OBJECT_POST( pxActiveObject, pxEvent );
+
+        /* Take the object's reference before the event is queued, as the
+         * dispatcher may release it as soon as it is. */
+        vActiveEventRetain( pxEvent );
+
+        xReturn = xQueueSendToBack( pxActiveObject->xEventQueue, &pxEvent, xTicksToWait );
+
+        if( xReturn == pdPASS )
+        {
+            ( void ) xTaskNotify( pxActiveObject->pxDispatcher->xTask, pxActiveObject->ulReadyBit, eSetBits );
+        }
+        else
+        {
+            /* The caller still holds a reference, so this cannot free the
+             * event. */
+            vActiveEventRelease( pxEvent );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xActiveObjectPostFromISR( ActiveObjectHandle_t xActiveObject,
+                                         const ActiveEvent_t * pxEvent,
+                                         BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        ActiveObject_t * const pxActiveObject = xActiveObject;
+        BaseType_t xReturn;
+
+        configASSERT( pxActiveObject );
+        configASSERT( pxEvent );
+
+        traceACTIVE_OBJECT_POST( pxActiveObject, pxEvent );
+
+        vActiveEventRetain( pxEvent );
+
+        xReturn = xQueueSendToBackFromISR( pxActiveObject->xEventQueue, &pxEvent, pxHigherPriorityTaskWoken );
+
+        if( xReturn == pdPASS )
+        {
+            ( void ) xTaskNotifyFromISR( pxActiveObject->pxDispatcher->xTask, pxActiveObject->ulReadyBit, eSetBits, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            vActiveEventReleaseFromISR( pxEvent );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include active objects.  This #if is closed at the very bottom of this
+ * file. */
+#endif /* configUSE_ACTIVE_OBJECTS == 1 */
@@ -0,0 +1,654 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "amp_channel.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include AMP channels.  This #if is closed at the very bottom of this file. */
+#if ( configUSE_AMP_CHANNELS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use AMP channels.
+    #endif
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use AMP channels.
+    #endif
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+        #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to use AMP channels.
+    #endif
+
+    #ifndef configAMP_RING_DOORBELL
+        #error configAMP_RING_DOORBELL( uxDoorbell ) must be defined in FreeRTOSConfig.h to use AMP channels.
+    #endif
+
+/*
+ * The part of the shared memory written by one end of a channel.  Each end
+ * has its own control block in a cache line of its own, which the other end
+ * only reads.  ulIndex is a free running count of the bytes the sender has
+ * written to, or the receiver has read from, the ring buffer, so the
+ * difference between the two is the number of bytes in use even after they
+ * wrap.
+ *
+ * An end that has to wait sets ulWaiting, then checks the ring buffer again
+ * before blocking.  The other end reads ulWaiting after updating its index,
+ * and rings the doorbell if it is set, so at least one of them sees the
+ * other's update and a wake up cannot be missed.
+ */
+    typedef struct AMPControlBlock
+    {
+        volatile uint32_t ulIndex;   /*< The number of bytes written by the sender, or read by the receiver. */
+        volatile uint32_t ulWaiting; /*< Non-zero while a task at this end is waiting for the other end. */
+    } AMPControlBlock_t;
+
+/* One core's end of a channel, allocated from that core's heap. */
+    typedef struct AMPChannelDefinition
+    {
+        AMPControlBlock_t * pxLocal;        /*< The control block written by this end. */
+        AMPControlBlock_t * pxRemote;       /*< The control block written by the other end. */
+        uint8_t * pucBuffer;                /*< The ring buffer, which follows the control blocks. */
+        size_t xBufferSizeBytes;            /*< The size of the ring buffer, a power of 2. */
+        UBaseType_t uxDoorbell;             /*< Passed to configAMP_RING_DOORBELL(). */
+        volatile TaskHandle_t xTaskWaiting; /*< The task waiting on this end, otherwise NULL. */
+        BaseType_t xEnd;                    /*< ampCHANNEL_SENDER or ampCHANNEL_RECEIVER. */
+    } AMPChannel_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index in the other end's control block, discarding any copy of
+ * it held in this core's cache first.
+ */
+    static uint32_t prvReadRemoteIndex( const AMPChannel_t * const pxChannel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes this end's control block back from the cache and waits for the
+ * write to complete, so the other core sees the update.
+ */
+    static void prvPublishLocal( const AMPChannel_t * const pxChannel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copy xLength bytes into, or out of, the ring buffer starting at the byte
+ * counted by ulIndex, wrapping to the start of the ring buffer if necessary.
+ */
+    static void prvCopyToBuffer( const AMPChannel_t * const pxChannel,
+                                 uint32_t ulIndex,
+                                 const uint8_t * pucData,
+                                 size_t xLength ) PRIVILEGED_FUNCTION;
+    static void prvCopyFromBuffer( const AMPChannel_t * const pxChannel,
+                                   uint32_t ulIndex,
+                                   uint8_t * pucData,
+                                   size_t xLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies a message into the ring buffer if there is space, returning pdPASS
+ * if it was copied, otherwise pdFAIL.  Only called by the sender.
+ */
+    static BaseType_t prvWriteMessage( const AMPChannel_t * const pxChannel,
+                                       const void * pvTxData,
+                                       size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the oldest message out of the ring buffer if there is one and it
+ * fits in the buffer, returning its length, otherwise 0.  Only called by the
+ * receiver.
+ */
+    static size_t prvReadMessage( const AMPChannel_t * const pxChannel,
+                                  void * pvRxData,
+                                  size_t xBufferLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Publishes whether the calling task is waiting on this end of the channel.
+ */
+    static void prvSetWaiting( AMPChannel_t * const pxChannel,
+                               BaseType_t xWaiting ) PRIVILEGED_FUNCTION;
+
+/*
+ * Rings the doorbell if a task at the other end of the channel is waiting.
+ */
+    static void prvWakeRemote( const AMPChannel_t * const pxChannel ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvReadRemoteIndex( const AMPChannel_t * const pxChannel )
+    {
+        configAMP_CACHE_INVALIDATE( ( void * ) pxChannel->pxRemote, ( size_t ) configAMP_CACHE_LINE_SIZE );
+
+        return pxChannel->pxRemote->ulIndex;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvPublishLocal( const AMPChannel_t * const pxChannel )
+    {
+        /* Remove compiler warnings if configAMP_CACHE_CLEAN() is not defined. */
+        ( void ) pxChannel;
+
+        configAMP_CACHE_CLEAN( ( void * ) pxChannel->pxLocal, ( size_t ) configAMP_CACHE_LINE_SIZE );
+        configAMP_MEMORY_BARRIER();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCopyToBuffer( const AMPChannel_t * const pxChannel,
+                                 uint32_t ulIndex,
+                                 const uint8_t * pucData,
+                                 size_t xLength )
+    {
+        const size_t xOffset = ( size_t ) ulIndex & ( pxChannel->xBufferSizeBytes - ( size_t ) 1 );
+        size_t xFirstLength = pxChannel->xBufferSizeBytes - xOffset;
+
+        if( xFirstLength > xLength )
+        {
+            xFirstLength = xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        ( void ) memcpy( ( void * ) &( pxChannel->pucBuffer[ xOffset ] ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        configAMP_CACHE_CLEAN( ( void * ) &( pxChannel->pucBuffer[ xOffset ] ), xFirstLength );
+
+        if( xLength > xFirstLength )
+        {
+            ( void ) memcpy( ( void * ) pxChannel->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xLength - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+            configAMP_CACHE_CLEAN( ( void * ) pxChannel->pucBuffer, xLength - xFirstLength );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCopyFromBuffer( const AMPChannel_t * const pxChannel,
+                                   uint32_t ulIndex,
+                                   uint8_t * pucData,
+                                   size_t xLength )
+    {
+        const size_t xOffset = ( size_t ) ulIndex & ( pxChannel->xBufferSizeBytes - ( size_t ) 1 );
+        size_t xFirstLength = pxChannel->xBufferSizeBytes - xOffset;
+
+        if( xFirstLength > xLength )
+        {
+            xFirstLength = xLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The receiver never writes to the ring buffer, so invalidating the
+         * cache cannot discard data this core has written. */
+        configAMP_CACHE_INVALIDATE( ( void * ) &( pxChannel->pucBuffer[ xOffset ] ), xFirstLength );
+        ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxChannel->pucBuffer[ xOffset ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+        if( xLength > xFirstLength )
+        {
+            configAMP_CACHE_INVALIDATE( ( void * ) pxChannel->pucBuffer, xLength - xFirstLength );
+            ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( const void * ) pxChannel->pucBuffer, xLength - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvWriteMessage( const AMPChannel_t * const pxChannel,
+                                       const void * pvTxData,
+                                       size_t xDataLengthBytes )
+    {
+        BaseType_t xReturn = pdFAIL;
+        const uint32_t ulHead = pxChannel->pxLocal->ulIndex;
+        const uint32_t ulTail = prvReadRemoteIndex( pxChannel );
+        const uint32_t ulLength = ( uint32_t ) xDataLengthBytes;
+
+        if( ( pxChannel->xBufferSizeBytes - ( size_t ) ( ulHead - ulTail ) ) >= ( ampCHANNEL_MESSAGE_OVERHEAD + xDataLengthBytes ) )
+        {
+            /* The receiver's index must be read before the space it frees is
+             * overwritten. */
+            configAMP_MEMORY_BARRIER();
+
+            prvCopyToBuffer( pxChannel, ulHead, ( const uint8_t * ) &ulLength, ampCHANNEL_MESSAGE_OVERHEAD );
+            prvCopyToBuffer( pxChannel, ulHead + ( uint32_t ) ampCHANNEL_MESSAGE_OVERHEAD, ( const uint8_t * ) pvTxData, xDataLengthBytes );
+
+            /* The message must be in memory before the receiver can see the
+             * updated index. */
+            configAMP_MEMORY_BARRIER();
+            pxChannel->pxLocal->ulIndex = ulHead + ( uint32_t ) ampCHANNEL_MESSAGE_OVERHEAD + ulLength;
+
+            /* The receiver must see the updated index before its waiting
+             * state is read. */
+            prvPublishLocal( pxChannel );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvReadMessage( const AMPChannel_t * const pxChannel,
+                                  void * pvRxData,
+                                  size_t xBufferLengthBytes )
+    {
+        size_t xReturn = 0;
+        const uint32_t ulTail = pxChannel->pxLocal->ulIndex;
+        const uint32_t ulHead = prvReadRemoteIndex( pxChannel );
+        uint32_t ulLength;
+
+        if( ulHead != ulTail )
+        {
+            /* The index must be read before the message it makes visible. */
+            configAMP_MEMORY_BARRIER();
+
+            prvCopyFromBuffer( pxChannel, ulTail, ( uint8_t * ) &ulLength, ampCHANNEL_MESSAGE_OVERHEAD );
+
+            if( ( size_t ) ulLength <= xBufferLengthBytes )
+            {
+                prvCopyFromBuffer( pxChannel, ulTail + ( uint32_t ) ampCHANNEL_MESSAGE_OVERHEAD, ( uint8_t * ) pvRxData, ( size_t ) ulLength );
+
+                /* The message must have been copied out before the sender can
+                 * reuse the space. */
+                configAMP_MEMORY_BARRIER();
+                pxChannel->pxLocal->ulIndex = ulTail + ( uint32_t ) ampCHANNEL_MESSAGE_OVERHEAD + ulLength;
+
+                /* The sender must see the updated index before its waiting
+                 * state is read. */
+                prvPublishLocal( pxChannel );
+                xReturn = ( size_t ) ulLength;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSetWaiting( AMPChannel_t * const pxChannel,
+                               BaseType_t xWaiting )
+    {
+        if( xWaiting != pdFALSE )
+        {
+            /* Should only be one task using each end. */
+            configASSERT( pxChannel->xTaskWaiting == NULL );
+
+            /* The handle must be set before the other core can see this end
+             * is waiting, as it may ring the doorbell immediately. */
+            pxChannel->xTaskWaiting = xTaskGetCurrentTaskHandle();
+            portMEMORY_BARRIER();
+            pxChannel->pxLocal->ulWaiting = ( uint32_t ) 1;
+        }
+        else
+        {
+            pxChannel->pxLocal->ulWaiting = ( uint32_t ) 0;
+            pxChannel->xTaskWaiting = NULL;
+        }
+
+        prvPublishLocal( pxChannel );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWakeRemote( const AMPChannel_t * const pxChannel )
+    {
+        configAMP_CACHE_INVALIDATE( ( void * ) pxChannel->pxRemote, ( size_t ) configAMP_CACHE_LINE_SIZE );
+
+        if( pxChannel->pxRemote->ulWaiting != ( uint32_t ) 0 )
+        {
+            configAMP_RING_DOORBELL( pxChannel->uxDoorbell );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    AMPChannelHandle_t xAMPChannelCreate( void * pvSharedMemory,
+                                          size_t xBufferSizeBytes,
+                                          BaseType_t xEnd,
+                                          UBaseType_t uxDoorbell )
+    {
+        AMPChannel_t * pxChannel;
+        uint8_t * const pucSharedMemory = ( uint8_t * ) pvSharedMemory;
+        AMPControlBlock_t * const pxSender = ( AMPControlBlock_t * ) pucSharedMemory;                                   /*lint !e9087 !e826 The shared memory is aligned to a cache line. */
+        AMPControlBlock_t * const pxReceiver = ( AMPControlBlock_t * ) &( pucSharedMemory[ configAMP_CACHE_LINE_SIZE ] ); /*lint !e9087 !e826 The shared memory is aligned to a cache line. */
+
+        configASSERT( pvSharedMemory );
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pvSharedMemory ) & ( ( portPOINTER_SIZE_TYPE ) configAMP_CACHE_LINE_SIZE - 1U ) ) == 0U );
+        configASSERT( xBufferSizeBytes >= ( size_t ) configAMP_CACHE_LINE_SIZE );
+        configASSERT( ( xBufferSizeBytes & ( xBufferSizeBytes - ( size_t ) 1 ) ) == ( size_t ) 0 );
+        configASSERT( xBufferSizeBytes <= ( size_t ) 0x80000000UL );
+        configASSERT( ( xEnd == ampCHANNEL_SENDER ) || ( xEnd == ampCHANNEL_RECEIVER ) );
+
+        pxChannel = ( AMPChannel_t * ) pvPortMalloc( sizeof( AMPChannel_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of AMPChannel_t is a pointer. */
+
+        if( pxChannel != NULL )
+        {
+            if( xEnd == ampCHANNEL_SENDER )
+            {
+                pxChannel->pxLocal = pxSender;
+                pxChannel->pxRemote = pxReceiver;
+            }
+            else
+            {
+                pxChannel->pxLocal = pxReceiver;
+                pxChannel->pxRemote = pxSender;
+            }
+
+            pxChannel->pucBuffer = &( pucSharedMemory[ 2 * configAMP_CACHE_LINE_SIZE ] );
+            pxChannel->xBufferSizeBytes = xBufferSizeBytes;
+            pxChannel->uxDoorbell = uxDoorbell;
+            pxChannel->xTaskWaiting = NULL;
+            pxChannel->xEnd = xEnd;
+
+            traceAMP_CHANNEL_CREATE( pxChannel );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxChannel;
+    }
+/*-----------------------------------------------------------*/
+
+    void vAMPChannelDelete( AMPChannelHandle_t xChannel )
+    {
+        AMPChannel_t * const pxChannel = xChannel;
+
+        configASSERT( pxChannel );
+        configASSERT( pxChannel->xTaskWaiting == NULL );
+
+        vPortFree( ( void * ) pxChannel );
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xAMPChannelSend( AMPChannelHandle_t xChannel,
+                            const void * pvTxData,
+                            size_t xDataLengthBytes,
+                            TickType_t xTicksToWait )
+    {
+        AMPChannel_t * const pxChannel = xChannel;
+        BaseType_t xReturn;
+        TimeOut_t xTimeOut;
+
+        configASSERT( pxChannel );
+        configASSERT( pvTxData );
+        configASSERT( pxChannel->xEnd == ampCHANNEL_SENDER );
+        configASSERT( xDataLengthBytes > ( size_t ) 0 );
+        configASSERT( xDataLengthBytes <= ( pxChannel->xBufferSizeBytes - ampCHANNEL_MESSAGE_OVERHEAD ) );
+
+        xReturn = prvWriteMessage( pxChannel, pvTxData, xDataLengthBytes );
+
+        if( ( xReturn == pdFAIL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                /* Clear any stale notification, then publish that this task is
+                 * waiting before looking at the ring buffer again so space
+                 * freed by the receiver after the check still rings the
+                 * doorbell. */
+                ( void ) xTaskNotifyStateClear( NULL );
+                prvSetWaiting( pxChannel, pdTRUE );
+
+                xReturn = prvWriteMessage( pxChannel, pvTxData, xDataLengthBytes );
+
+                if( xReturn == pdFAIL )
+                {
+                    ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                    xReturn = prvWriteMessage( pxChannel, pvTxData, xDataLengthBytes );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvSetWaiting( pxChannel, pdFALSE );
+            } while( ( xReturn == pdFAIL ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReturn == pdPASS )
+        {
+            traceAMP_CHANNEL_SEND( pxChannel, xDataLengthBytes );
+            prvWakeRemote( pxChannel );
+        }
+        else
+        {
+            xDataLengthBytes = 0;
+        }
+
+        return xDataLengthBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xAMPChannelSendFromISR( AMPChannelHandle_t xChannel,
+                                   const void * pvTxData,
+                                   size_t xDataLengthBytes )
+    {
+        AMPChannel_t * const pxChannel = xChannel;
+
+        configASSERT( pxChannel );
+        configASSERT( pvTxData );
+        configASSERT( pxChannel->xEnd == ampCHANNEL_SENDER );
+        configASSERT( xDataLengthBytes > ( size_t ) 0 );
+        configASSERT( xDataLengthBytes <= ( pxChannel->xBufferSizeBytes - ampCHANNEL_MESSAGE_OVERHEAD ) );
+
+        if( prvWriteMessage( pxChannel, pvTxData, xDataLengthBytes ) == pdPASS )
+        {
+            traceAMP_CHANNEL_SEND( pxChannel, xDataLengthBytes );
+            prvWakeRemote( pxChannel );
+        }
+        else
+        {
+            xDataLengthBytes = 0;
+        }
+
+        return xDataLengthBytes;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xAMPChannelReceive( AMPChannelHandle_t xChannel,
+                               void * pvRxData,
+                               size_t xBufferLengthBytes,
+                               TickType_t xTicksToWait )
+    {
+        AMPChannel_t * const pxChannel = xChannel;
+        size_t xReceived;
+        TimeOut_t xTimeOut;
+
+        configASSERT( pxChannel );
+        configASSERT( pvRxData );
+        configASSERT( pxChannel->xEnd == ampCHANNEL_RECEIVER );
+
+        xReceived = prvReadMessage( pxChannel, pvRxData, xBufferLengthBytes );
+
+        if( ( xReceived == ( size_t ) 0 ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+        {
+            vTaskSetTimeOutState( &xTimeOut );
+
+            do
+            {
+                /* Clear any stale notification, then publish that this task is
+                 * waiting before looking at the ring buffer again so a message
+                 * sent after the check still rings the doorbell. */
+                ( void ) xTaskNotifyStateClear( NULL );
+                prvSetWaiting( pxChannel, pdTRUE );
+
+                xReceived = prvReadMessage( pxChannel, pvRxData, xBufferLengthBytes );
+
+                if( xReceived == ( size_t ) 0 )
+                {
+                    ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                    xReceived = prvReadMessage( pxChannel, pvRxData, xBufferLengthBytes );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                prvSetWaiting( pxChannel, pdFALSE );
+            } while( ( xReceived == ( size_t ) 0 ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReceived != ( size_t ) 0 )
+        {
+            traceAMP_CHANNEL_RECEIVE( pxChannel, xReceived );
+            prvWakeRemote( pxChannel );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReceived;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xAMPChannelReceiveFromISR( AMPChannelHandle_t xChannel,
+                                      void * pvRxData,
+                                      size_t xBufferLengthBytes )
+    {
+        AMPChannel_t * const pxChannel = xChannel;
+        size_t xReceived;
+
+        configASSERT( pxChannel );
+        configASSERT( pvRxData );
+        configASSERT( pxChannel->xEnd == ampCHANNEL_RECEIVER );
+
+        xReceived = prvReadMessage( pxChannel, pvRxData, xBufferLengthBytes );
+
+        if( xReceived != ( size_t ) 0 )
+        {
+            traceAMP_CHANNEL_RECEIVE( pxChannel, xReceived );
+            prvWakeRemote( pxChannel );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReceived;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAMPChannelDoorbellFromISR( AMPChannelHandle_t xChannel,
+                                           BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        AMPChannel_t * const pxChannel = xChannel;
+        TaskHandle_t xTaskToNotify;
+        BaseType_t xReturn = pdFALSE;
+
+        configASSERT( pxChannel );
+
+        traceAMP_CHANNEL_DOORBELL( pxChannel );
+        xTaskToNotify = pxChannel->xTaskWaiting;
+
+        /* The doorbell may be shared with other channels, so there is only a
+         * task to wake if one is waiting on this end. */
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xAMPChannelBytesAvailable( AMPChannelHandle_t xChannel )
+    {
+        const AMPChannel_t * const pxChannel = xChannel;
+        uint32_t ulLocal;
+        uint32_t ulRemote;
+        size_t xReturn;
+
+        configASSERT( pxChannel );
+
+        ulLocal = pxChannel->pxLocal->ulIndex;
+        ulRemote = prvReadRemoteIndex( pxChannel );
+
+        /* Correct even after the indexes have wrapped. */
+        if( pxChannel->xEnd == ampCHANNEL_SENDER )
+        {
+            xReturn = ( size_t ) ( ulLocal - ulRemote );
+        }
+        else
+        {
+            xReturn = ( size_t ) ( ulRemote - ulLocal );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include AMP channels.  This #if is closed at the very bottom of this file. */
+#endif /* configUSE_AMP_CHANNELS == 1 */
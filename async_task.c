@@ -0,0 +1,1128 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "async_task.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include async tasks.  This #if is closed at the very bottom of this file. */
+#if ( configUSE_ASYNC_TASKS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use async tasks.
+    #endif
+
+    #if ( configUSE_QUEUE_WAIT_FOR_ANY != 1 )
+        #error configUSE_QUEUE_WAIT_FOR_ANY must be set to 1 to use async tasks.
+    #endif
+
+/* Values that can be assigned to the ucNotifyState member of an async task. */
+    #define asyncNOT_WAITING_NOTIFICATION    ( ( uint8_t ) 0 )
+    #define asyncWAITING_NOTIFICATION        ( ( uint8_t ) 1 )
+    #define asyncNOTIFICATION_RECEIVED       ( ( uint8_t ) 2 )
+
+/* The host task of an executor blocks on the queues and semaphores its async
+ * tasks are waiting on, plus the wake semaphore, which is given whenever an
+ * async task is made ready from outside the host task.  The wait records are
+ * allocated in the same block as the executor. */
+    typedef struct AsyncExecutorDefinition
+    {
+        TaskHandle_t xHostTask;                                    /*< The task on whose stack the async tasks run. */
+        SemaphoreHandle_t xWakeSemaphore;                          /*< Given to unblock the host task when an async task is made ready. */
+        List_t xReadyLists[ configMAX_ASYNC_TASK_PRIORITIES ];     /*< Prioritised ready async tasks. */
+        List_t xDelayedList1;                                      /*< Async tasks waiting with a timeout, ordered by wake time. */
+        List_t xDelayedList2;                                      /*< Async tasks whose wake time has overflowed the current tick count. */
+        List_t * pxDelayedList;                                    /*< Points to the delayed list currently being used. */
+        List_t * pxOverflowDelayedList;                            /*< Points to the delayed list for wake times that have overflowed. */
+        TickType_t xLastTick;                                      /*< The tick count when the delayed lists were last checked. */
+        List_t xWaitForeverList;                                   /*< Async tasks waiting without a timeout. */
+        List_t xQueueWaitList;                                     /*< Async tasks waiting on a queue or semaphore, through xEventListItem. */
+        List_t xStreamBufferWaitList;                              /*< Async tasks waiting on a stream buffer, through xEventListItem. */
+        UBaseType_t uxMaxWaitRecords;                              /*< The number of entries in pxWaitRecords. */
+        QueueWaitRecord_t * pxWaitRecords;                         /*< The objects the host task blocks on.  The first is always xWakeSemaphore. */
+        struct AsyncExecutorDefinition * pxNextExecutor;           /*< The next executor created, so stream buffer callbacks can find all waiting async tasks. */
+    } AsyncExecutor_t;
+
+/*-----------------------------------------------------------*/
+
+/* All the executors that have been created. */
+    PRIVILEGED_DATA static AsyncExecutor_t * pxExecutors = NULL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The function run by the host task of every executor.
+ */
+    static portTASK_FUNCTION_PROTO( prvAsyncExecutorTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves an async task to the end of its ready list, removing it from any
+ * state or event list it is in.  Must be called from a critical section.
+ */
+    static void prvReadyAsyncTask( AsyncTask_t * pxAsyncTask ) PRIVILEGED_FUNCTION;
+
+/*
+ * Makes ready every async task in pxWaitList that is waiting on pvObject.
+ * Returns pdTRUE if any were.  Must be called from a critical section.
+ */
+    static BaseType_t prvReadyWaitingAsyncTasks( List_t * pxWaitList,
+                                                 const void * pvObject ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by an operation that could not complete.  Returns xTimedOutValue if
+ * the block time of the await has expired.  Otherwise places the async task
+ * in a delayed list, and in pxWaitList if that is not NULL, and returns
+ * errQUEUE_BLOCKED.
+ */
+    static BaseType_t prvBlockAsyncTask( AsyncTask_t * pxAsyncTask,
+                                         List_t * pxWaitList,
+                                         void * pvWaitObject,
+                                         BaseType_t xTimedOutValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Makes ready the delayed async tasks whose wake time has been reached.
+ */
+    static void prvCheckDelayedAsyncTasks( AsyncExecutor_t * pxExecutor ) PRIVILEGED_FUNCTION;
+
+/*
+ * Fills the wait records of the executor with the distinct objects its async
+ * tasks are waiting on, after the wake semaphore, and returns the number of
+ * records used.  *pxPoll is set to pdTRUE if there were more objects than
+ * records.
+ */
+    static UBaseType_t prvPrepareWaitRecords( AsyncExecutor_t * pxExecutor,
+                                              BaseType_t * pxPoll ) PRIVILEGED_FUNCTION;
+
+/*
+ * Initialises an async task and makes it ready to run on xExecutor.
+ */
+    static void prvInitialiseAsyncTask( AsyncExecutor_t * pxExecutor,
+                                        AsyncTaskFunction_t pxFunction,
+                                        void * pvParameters,
+                                        UBaseType_t uxPriority,
+                                        AsyncTask_t * pxAsyncTask,
+                                        uint8_t ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns how long the host task can block before an async task needs to run.
+ */
+    static TickType_t prvGetHostBlockTime( AsyncExecutor_t * pxExecutor,
+                                           BaseType_t xPoll ) PRIVILEGED_FUNCTION;
+
+/*
+ * Removes the highest priority ready async task from its ready list and
+ * returns it, or returns NULL if no async task is ready.
+ */
+    static AsyncTask_t * prvSelectAsyncTask( AsyncExecutor_t * pxExecutor ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvReadyAsyncTask( AsyncTask_t * pxAsyncTask )
+    {
+        if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xStateListItem ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxAsyncTask->xStateListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+        {
+            ( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        listINSERT_END( &( pxAsyncTask->pxExecutor->xReadyLists[ pxAsyncTask->uxPriority ] ), &( pxAsyncTask->xStateListItem ) );
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReadyWaitingAsyncTasks( List_t * pxWaitList,
+                                                 const void * pvObject )
+    {
+        const ListItem_t * const pxEnd = listGET_END_MARKER( pxWaitList );
+        ListItem_t * pxItem = listGET_HEAD_ENTRY( pxWaitList );
+        ListItem_t * pxNext;
+        AsyncTask_t * pxAsyncTask;
+        BaseType_t xReadied = pdFALSE;
+
+        while( pxItem != pxEnd )
+        {
+            /* Read the next item first, as readying the async task removes
+             * this item from the list. */
+            pxNext = listGET_NEXT( pxItem );
+            pxAsyncTask = listGET_LIST_ITEM_OWNER( pxItem );
+
+            if( pxAsyncTask->pvWaitObject == pvObject )
+            {
+                prvReadyAsyncTask( pxAsyncTask );
+                xReadied = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxItem = pxNext;
+        }
+
+        return xReadied;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvBlockAsyncTask( AsyncTask_t * pxAsyncTask,
+                                         List_t * pxWaitList,
+                                         void * pvWaitObject,
+                                         BaseType_t xTimedOutValue )
+    {
+        AsyncExecutor_t * const pxExecutor = pxAsyncTask->pxExecutor;
+        BaseType_t xReturn = errQUEUE_BLOCKED;
+        TickType_t xDistance;
+        TickType_t xTimeToWake;
+
+        taskENTER_CRITICAL();
+        {
+            if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xStateListItem ) ) != NULL )
+            {
+                /* The async task was made ready while it was running, so
+                 * whatever it is waiting for may have happened after the
+                 * operation was attempted.  Leave it ready so the operation
+                 * is attempted again. */
+                if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( xTaskCheckForTimeOut( &( pxAsyncTask->xTimeOut ), &( pxAsyncTask->xTicksToWait ) ) != pdFALSE )
+            {
+                if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+                {
+                    ( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xReturn = xTimedOutValue;
+            }
+            else
+            {
+                traceASYNC_TASK_BLOCK( pxAsyncTask );
+
+                if( pxWaitList != NULL )
+                {
+                    pxAsyncTask->pvWaitObject = pvWaitObject;
+                    listINSERT_END( pxWaitList, &( pxAsyncTask->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                    if( pxAsyncTask->xTicksToWait == portMAX_DELAY )
+                    {
+                        listINSERT_END( &( pxExecutor->xWaitForeverList ), &( pxAsyncTask->xStateListItem ) );
+                    }
+                    else
+                #endif /* INCLUDE_vTaskSuspend */
+                {
+                    /* Wake times are measured from the tick count at which the
+                     * delayed lists were last checked, as that is the tick
+                     * count to which the current delayed list belongs. */
+                    xDistance = xTaskGetTickCount() - pxExecutor->xLastTick;
+
+                    if( pxAsyncTask->xTicksToWait < ( portMAX_DELAY - xDistance ) )
+                    {
+                        xDistance += pxAsyncTask->xTicksToWait;
+                    }
+                    else
+                    {
+                        /* Wake early, at which point the remaining block time
+                         * is waited again. */
+                        xDistance = portMAX_DELAY - 1U;
+                    }
+
+                    xTimeToWake = pxExecutor->xLastTick + xDistance;
+                    listSET_LIST_ITEM_VALUE( &( pxAsyncTask->xStateListItem ), xTimeToWake );
+
+                    if( xTimeToWake < pxExecutor->xLastTick )
+                    {
+                        vListInsert( pxExecutor->pxOverflowDelayedList, &( pxAsyncTask->xStateListItem ) );
+                    }
+                    else
+                    {
+                        vListInsert( pxExecutor->pxDelayedList, &( pxAsyncTask->xStateListItem ) );
+                    }
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCheckDelayedAsyncTasks( AsyncExecutor_t * pxExecutor )
+    {
+        const TickType_t xConstTickCount = xTaskGetTickCount();
+        List_t * pxTemp;
+
+        taskENTER_CRITICAL();
+        {
+            if( xConstTickCount < pxExecutor->xLastTick )
+            {
+                /* The tick count has overflowed, so every wake time left in
+                 * the current delayed list has passed. */
+                while( listLIST_IS_EMPTY( pxExecutor->pxDelayedList ) == pdFALSE )
+                {
+                    prvReadyAsyncTask( listGET_OWNER_OF_HEAD_ENTRY( pxExecutor->pxDelayedList ) );
+                }
+
+                pxTemp = pxExecutor->pxDelayedList;
+                pxExecutor->pxDelayedList = pxExecutor->pxOverflowDelayedList;
+                pxExecutor->pxOverflowDelayedList = pxTemp;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxExecutor->xLastTick = xConstTickCount;
+
+            while( ( listLIST_IS_EMPTY( pxExecutor->pxDelayedList ) == pdFALSE ) &&
+                   ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxExecutor->pxDelayedList ) <= xConstTickCount ) )
+            {
+                prvReadyAsyncTask( listGET_OWNER_OF_HEAD_ENTRY( pxExecutor->pxDelayedList ) );
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvPrepareWaitRecords( AsyncExecutor_t * pxExecutor,
+                                              BaseType_t * pxPoll )
+    {
+        const ListItem_t * pxEnd;
+        const ListItem_t * pxItem;
+        const AsyncTask_t * pxAsyncTask;
+        UBaseType_t uxRecords = 1U;
+        UBaseType_t ux;
+
+        *pxPoll = pdFALSE;
+
+        taskENTER_CRITICAL();
+        {
+            pxEnd = listGET_END_MARKER( &( pxExecutor->xQueueWaitList ) );
+
+            for( pxItem = listGET_HEAD_ENTRY( &( pxExecutor->xQueueWaitList ) ); pxItem != pxEnd; pxItem = listGET_NEXT( pxItem ) )
+            {
+                pxAsyncTask = listGET_LIST_ITEM_OWNER( pxItem );
+
+                for( ux = 1U; ux < uxRecords; ux++ )
+                {
+                    if( pxExecutor->pxWaitRecords[ ux ].xQueueOrSemaphore == pxAsyncTask->pvWaitObject )
+                    {
+                        break;
+                    }
+                }
+
+                if( ux < uxRecords )
+                {
+                    /* Another async task is waiting on the same object. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+                else if( uxRecords < pxExecutor->uxMaxWaitRecords )
+                {
+                    pxExecutor->pxWaitRecords[ uxRecords ].xQueueOrSemaphore = pxAsyncTask->pvWaitObject;
+                    uxRecords++;
+                }
+                else
+                {
+                    *pxPoll = pdTRUE;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return uxRecords;
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvGetHostBlockTime( AsyncExecutor_t * pxExecutor,
+                                           BaseType_t xPoll )
+    {
+        TickType_t xBlockTime = portMAX_DELAY;
+        TickType_t xElapsed;
+        TickType_t xDistance;
+        List_t * pxList = NULL;
+        UBaseType_t uxPriority;
+
+        taskENTER_CRITICAL();
+        {
+            for( uxPriority = 0U; uxPriority < ( UBaseType_t ) configMAX_ASYNC_TASK_PRIORITIES; uxPriority++ )
+            {
+                if( listLIST_IS_EMPTY( &( pxExecutor->xReadyLists[ uxPriority ] ) ) == pdFALSE )
+                {
+                    xBlockTime = 0U;
+                    break;
+                }
+            }
+
+            if( xBlockTime != 0U )
+            {
+                if( listLIST_IS_EMPTY( pxExecutor->pxDelayedList ) == pdFALSE )
+                {
+                    pxList = pxExecutor->pxDelayedList;
+                }
+                else if( listLIST_IS_EMPTY( pxExecutor->pxOverflowDelayedList ) == pdFALSE )
+                {
+                    pxList = pxExecutor->pxOverflowDelayedList;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( pxList != NULL )
+                {
+                    /* Both distances are measured from the tick count to which
+                     * the delayed lists belong. */
+                    xDistance = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxList ) - pxExecutor->xLastTick;
+                    xElapsed = xTaskGetTickCount() - pxExecutor->xLastTick;
+                    xBlockTime = ( xElapsed >= xDistance ) ? 0U : ( xDistance - xElapsed );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( xPoll != pdFALSE ) && ( xBlockTime > 1U ) )
+        {
+            xBlockTime = 1U;
+        }
+
+        return xBlockTime;
+    }
+/*-----------------------------------------------------------*/
+
+    static AsyncTask_t * prvSelectAsyncTask( AsyncExecutor_t * pxExecutor )
+    {
+        AsyncTask_t * pxAsyncTask = NULL;
+        UBaseType_t uxPriority;
+
+        taskENTER_CRITICAL();
+        {
+            for( uxPriority = ( UBaseType_t ) configMAX_ASYNC_TASK_PRIORITIES; uxPriority > 0U; uxPriority-- )
+            {
+                if( listLIST_IS_EMPTY( &( pxExecutor->xReadyLists[ uxPriority - 1U ] ) ) == pdFALSE )
+                {
+                    pxAsyncTask = listGET_OWNER_OF_HEAD_ENTRY( &( pxExecutor->xReadyLists[ uxPriority - 1U ] ) );
+                    ( void ) uxListRemove( &( pxAsyncTask->xStateListItem ) );
+                    break;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return pxAsyncTask;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvAsyncExecutorTask, pvParameters )
+    {
+        AsyncExecutor_t * const pxExecutor = ( AsyncExecutor_t * ) pvParameters; /*lint !e9087 The parameter is always the executor the task hosts. */
+        AsyncTask_t * pxAsyncTask;
+        QueueSetMemberHandle_t xReady;
+        UBaseType_t uxRecords;
+        BaseType_t xPoll;
+        const ListItem_t * pxEnd;
+        ListItem_t * pxItem;
+        ListItem_t * pxNext;
+
+        for( ; ; )
+        {
+            /* Block until an async task is ready to run, an object one is
+             * waiting on is written, or the next wake time is reached. */
+            uxRecords = prvPrepareWaitRecords( pxExecutor, &xPoll );
+            xReady = xQueueWaitForAny( pxExecutor->pxWaitRecords, uxRecords, prvGetHostBlockTime( pxExecutor, xPoll ) );
+
+            if( xReady == ( QueueSetMemberHandle_t ) pxExecutor->xWakeSemaphore )
+            {
+                ( void ) xSemaphoreTake( pxExecutor->xWakeSemaphore, 0 );
+            }
+            else if( xReady != NULL )
+            {
+                taskENTER_CRITICAL();
+                {
+                    ( void ) prvReadyWaitingAsyncTasks( &( pxExecutor->xQueueWaitList ), xReady );
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xPoll != pdFALSE )
+            {
+                /* Not every object fit in the wait records, so check them all
+                 * each time round. */
+                taskENTER_CRITICAL();
+                {
+                    pxEnd = listGET_END_MARKER( &( pxExecutor->xQueueWaitList ) );
+                    pxItem = listGET_HEAD_ENTRY( &( pxExecutor->xQueueWaitList ) );
+
+                    while( pxItem != pxEnd )
+                    {
+                        pxNext = listGET_NEXT( pxItem );
+                        pxAsyncTask = listGET_LIST_ITEM_OWNER( pxItem );
+
+                        if( uxQueueMessagesWaiting( pxAsyncTask->pvWaitObject ) != 0U )
+                        {
+                            prvReadyAsyncTask( pxAsyncTask );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        pxItem = pxNext;
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvCheckDelayedAsyncTasks( pxExecutor );
+
+            pxAsyncTask = prvSelectAsyncTask( pxExecutor );
+
+            if( pxAsyncTask != NULL )
+            {
+                traceASYNC_TASK_RUN( pxAsyncTask );
+
+                pxAsyncTask->pxFunction( pxAsyncTask, pxAsyncTask->pvParameters );
+
+                if( pxAsyncTask->uxResumePoint == asyncRESUME_POINT_FINISHED )
+                {
+                    traceASYNC_TASK_END( pxAsyncTask );
+
+                    taskENTER_CRITICAL();
+                    {
+                        if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xStateListItem ) ) != NULL )
+                        {
+                            ( void ) uxListRemove( &( pxAsyncTask->xStateListItem ) );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+                        {
+                            ( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    taskEXIT_CRITICAL();
+
+                    if( pxAsyncTask->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+                    {
+                        vPortFree( pxAsyncTask );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        /* An async task that returned without awaiting
+                         * anything, or that yielded, goes to the back of its
+                         * ready list. */
+                        if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xStateListItem ) ) == NULL )
+                        {
+                            listINSERT_END( &( pxExecutor->xReadyLists[ pxAsyncTask->uxPriority ] ), &( pxAsyncTask->xStateListItem ) );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    taskEXIT_CRITICAL();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    AsyncExecutorHandle_t xAsyncExecutorCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                configSTACK_DEPTH_TYPE uxStackDepth,
+                                                UBaseType_t uxPriority,
+                                                UBaseType_t uxMaxQueueWaits )
+    {
+        AsyncExecutor_t * pxExecutor;
+        UBaseType_t uxPriorityList;
+
+        /* One more record than requested is needed for the wake semaphore. */
+        pxExecutor = ( AsyncExecutor_t * ) pvPortMalloc( sizeof( AsyncExecutor_t ) + ( ( uxMaxQueueWaits + 1U ) * sizeof( QueueWaitRecord_t ) ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxExecutor != NULL )
+        {
+            for( uxPriorityList = 0U; uxPriorityList < ( UBaseType_t ) configMAX_ASYNC_TASK_PRIORITIES; uxPriorityList++ )
+            {
+                vListInitialise( &( pxExecutor->xReadyLists[ uxPriorityList ] ) );
+            }
+
+            vListInitialise( &( pxExecutor->xDelayedList1 ) );
+            vListInitialise( &( pxExecutor->xDelayedList2 ) );
+            vListInitialise( &( pxExecutor->xWaitForeverList ) );
+            vListInitialise( &( pxExecutor->xQueueWaitList ) );
+            vListInitialise( &( pxExecutor->xStreamBufferWaitList ) );
+            pxExecutor->pxDelayedList = &( pxExecutor->xDelayedList1 );
+            pxExecutor->pxOverflowDelayedList = &( pxExecutor->xDelayedList2 );
+            pxExecutor->xLastTick = xTaskGetTickCount();
+            pxExecutor->uxMaxWaitRecords = uxMaxQueueWaits + 1U;
+            pxExecutor->pxWaitRecords = ( QueueWaitRecord_t * ) &( pxExecutor[ 1 ] ); /*lint !e9087 The records follow the executor structure in the same allocation. */
+            pxExecutor->xWakeSemaphore = xSemaphoreCreateBinary();
+
+            if( pxExecutor->xWakeSemaphore != NULL )
+            {
+                pxExecutor->pxWaitRecords[ 0 ].xQueueOrSemaphore = pxExecutor->xWakeSemaphore;
+
+                if( xTaskCreate( prvAsyncExecutorTask,
+                                 pcName,
+                                 uxStackDepth,
+                                 ( void * ) pxExecutor,
+                                 uxPriority,
+                                 &( pxExecutor->xHostTask ) ) != pdPASS )
+                {
+                    vSemaphoreDelete( pxExecutor->xWakeSemaphore );
+                    pxExecutor->xWakeSemaphore = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxExecutor->xWakeSemaphore == NULL )
+            {
+                vPortFree( pxExecutor );
+                pxExecutor = NULL;
+            }
+            else
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxExecutor->pxNextExecutor = pxExecutors;
+                    pxExecutors = pxExecutor;
+                }
+                taskEXIT_CRITICAL();
+
+                traceASYNC_EXECUTOR_CREATE( pxExecutor );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxExecutor;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseAsyncTask( AsyncExecutor_t * pxExecutor,
+                                        AsyncTaskFunction_t pxFunction,
+                                        void * pvParameters,
+                                        UBaseType_t uxPriority,
+                                        AsyncTask_t * pxAsyncTask,
+                                        uint8_t ucStaticallyAllocated )
+    {
+        pxAsyncTask->uxResumePoint = 0U;
+        pxAsyncTask->pxFunction = pxFunction;
+        pxAsyncTask->pvParameters = pvParameters;
+        pxAsyncTask->pxExecutor = pxExecutor;
+        pxAsyncTask->pvWaitObject = NULL;
+        pxAsyncTask->xTicksToWait = 0U;
+        pxAsyncTask->uxPriority = uxPriority;
+        pxAsyncTask->ulNotifiedValue = 0U;
+        pxAsyncTask->ucNotifyState = asyncNOT_WAITING_NOTIFICATION;
+        pxAsyncTask->ucStaticallyAllocated = ucStaticallyAllocated;
+
+        vListInitialiseItem( &( pxAsyncTask->xStateListItem ) );
+        vListInitialiseItem( &( pxAsyncTask->xEventListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxAsyncTask->xStateListItem ), pxAsyncTask );
+        listSET_LIST_ITEM_OWNER( &( pxAsyncTask->xEventListItem ), pxAsyncTask );
+
+        traceASYNC_TASK_CREATE( pxAsyncTask );
+
+        taskENTER_CRITICAL();
+        {
+            prvReadyAsyncTask( pxAsyncTask );
+        }
+        taskEXIT_CRITICAL();
+
+        ( void ) xSemaphoreGive( pxExecutor->xWakeSemaphore );
+    }
+/*-----------------------------------------------------------*/
+
+    AsyncTaskHandle_t xAsyncTaskCreateStatic( AsyncExecutorHandle_t xExecutor,
+                                              AsyncTaskFunction_t pxFunction,
+                                              void * pvParameters,
+                                              UBaseType_t uxPriority,
+                                              AsyncTask_t * pxAsyncTaskBuffer )
+    {
+        configASSERT( xExecutor );
+        configASSERT( pxFunction );
+        configASSERT( pxAsyncTaskBuffer );
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_ASYNC_TASK_PRIORITIES );
+
+        prvInitialiseAsyncTask( xExecutor, pxFunction, pvParameters, uxPriority, pxAsyncTaskBuffer, ( uint8_t ) pdTRUE );
+
+        return pxAsyncTaskBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncTaskCreate( AsyncExecutorHandle_t xExecutor,
+                                 AsyncTaskFunction_t pxFunction,
+                                 void * pvParameters,
+                                 UBaseType_t uxPriority,
+                                 AsyncTaskHandle_t * pxCreatedAsyncTask )
+    {
+        AsyncTask_t * pxAsyncTask;
+        BaseType_t xReturn;
+
+        configASSERT( xExecutor );
+        configASSERT( pxFunction );
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_ASYNC_TASK_PRIORITIES );
+
+        pxAsyncTask = ( AsyncTask_t * ) pvPortMalloc( sizeof( AsyncTask_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxAsyncTask != NULL )
+        {
+            prvInitialiseAsyncTask( xExecutor, pxFunction, pvParameters, uxPriority, pxAsyncTask, ( uint8_t ) pdFALSE );
+
+            if( pxCreatedAsyncTask != NULL )
+            {
+                *pxCreatedAsyncTask = pxAsyncTask;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncTaskNotify( AsyncTaskHandle_t xAsyncTask,
+                                 uint32_t ulBitsToSet )
+    {
+        AsyncTask_t * const pxAsyncTask = xAsyncTask;
+        BaseType_t xWasWaiting;
+
+        configASSERT( pxAsyncTask );
+
+        taskENTER_CRITICAL();
+        {
+            pxAsyncTask->ulNotifiedValue |= ulBitsToSet;
+            xWasWaiting = ( pxAsyncTask->ucNotifyState == asyncWAITING_NOTIFICATION ) ? pdTRUE : pdFALSE;
+            pxAsyncTask->ucNotifyState = asyncNOTIFICATION_RECEIVED;
+
+            if( xWasWaiting != pdFALSE )
+            {
+                prvReadyAsyncTask( pxAsyncTask );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xWasWaiting != pdFALSE )
+        {
+            ( void ) xSemaphoreGive( pxAsyncTask->pxExecutor->xWakeSemaphore );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncTaskNotifyFromISR( AsyncTaskHandle_t xAsyncTask,
+                                        uint32_t ulBitsToSet,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        AsyncTask_t * const pxAsyncTask = xAsyncTask;
+        BaseType_t xWasWaiting;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxAsyncTask );
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            pxAsyncTask->ulNotifiedValue |= ulBitsToSet;
+            xWasWaiting = ( pxAsyncTask->ucNotifyState == asyncWAITING_NOTIFICATION ) ? pdTRUE : pdFALSE;
+            pxAsyncTask->ucNotifyState = asyncNOTIFICATION_RECEIVED;
+
+            if( xWasWaiting != pdFALSE )
+            {
+                prvReadyAsyncTask( pxAsyncTask );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xWasWaiting != pdFALSE )
+        {
+            ( void ) xSemaphoreGiveFromISR( pxAsyncTask->pxExecutor->xWakeSemaphore, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
+
+        void vAsyncTaskStreamBufferCallback( StreamBufferHandle_t xStreamBuffer,
+                                             BaseType_t xIsInsideISR,
+                                             BaseType_t * const pxHigherPriorityTaskWoken )
+        {
+            AsyncExecutor_t * pxExecutor;
+            BaseType_t xReadied;
+            UBaseType_t uxSavedInterruptStatus;
+
+            /* Executors are never deleted, so the list of executors can be
+             * walked without a critical section. */
+            for( pxExecutor = pxExecutors; pxExecutor != NULL; pxExecutor = pxExecutor->pxNextExecutor )
+            {
+                if( xIsInsideISR != pdFALSE )
+                {
+                    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+                    {
+                        xReadied = prvReadyWaitingAsyncTasks( &( pxExecutor->xStreamBufferWaitList ), xStreamBuffer );
+                    }
+                    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+                    if( xReadied != pdFALSE )
+                    {
+                        ( void ) xSemaphoreGiveFromISR( pxExecutor->xWakeSemaphore, pxHigherPriorityTaskWoken );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    taskENTER_CRITICAL();
+                    {
+                        xReadied = prvReadyWaitingAsyncTasks( &( pxExecutor->xStreamBufferWaitList ), xStreamBuffer );
+                    }
+                    taskEXIT_CRITICAL();
+
+                    if( xReadied != pdFALSE )
+                    {
+                        ( void ) xSemaphoreGive( pxExecutor->xWakeSemaphore );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+
+    #endif /* configUSE_SB_COMPLETED_CALLBACK */
+/*-----------------------------------------------------------*/
+
+    void vAsyncTaskSetTimeOut( AsyncTaskHandle_t xAsyncTask,
+                               TickType_t xTicksToWait )
+    {
+        vTaskSetTimeOutState( &( xAsyncTask->xTimeOut ) );
+        xAsyncTask->xTicksToWait = xTicksToWait;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncTaskDelay( AsyncTaskHandle_t xAsyncTask )
+    {
+        /* A delay is an await that can only time out. */
+        return prvBlockAsyncTask( xAsyncTask, NULL, NULL, pdPASS );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncTaskQueueReceive( AsyncTaskHandle_t xAsyncTask,
+                                       QueueHandle_t xQueue,
+                                       void * const pvBuffer )
+    {
+        BaseType_t xReturn;
+
+        configASSERT( xQueue );
+
+        /* The host task checks the queue again before it blocks, so data that
+         * arrives after this attempt fails is not missed. */
+        if( xQueueReceive( xQueue, pvBuffer, 0 ) == pdPASS )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvBlockAsyncTask( xAsyncTask, &( xAsyncTask->pxExecutor->xQueueWaitList ), xQueue, errQUEUE_EMPTY );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncTaskNotifyWait( AsyncTaskHandle_t xAsyncTask,
+                                     uint32_t * pulNotificationValue )
+    {
+        BaseType_t xReturn;
+
+        taskENTER_CRITICAL();
+        {
+            if( xAsyncTask->ucNotifyState == asyncNOTIFICATION_RECEIVED )
+            {
+                if( pulNotificationValue != NULL )
+                {
+                    *pulNotificationValue = xAsyncTask->ulNotifiedValue;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xAsyncTask->ulNotifiedValue = 0U;
+                xAsyncTask->ucNotifyState = asyncNOT_WAITING_NOTIFICATION;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xAsyncTask->ucNotifyState = asyncWAITING_NOTIFICATION;
+                xReturn = prvBlockAsyncTask( xAsyncTask, NULL, NULL, pdFAIL );
+
+                if( xReturn == pdFAIL )
+                {
+                    xAsyncTask->ucNotifyState = asyncNOT_WAITING_NOTIFICATION;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* Stream buffers have no event lists, so an async task waiting on one is
+ * placed in the executor's stream buffer wait list, which the completed
+ * callback searches.  It is placed there before the stream buffer is tried,
+ * so a callback that runs between the attempt and the async task blocking
+ * makes the async task ready again rather than being missed. */
+    static void prvWaitOnStreamBuffer( AsyncTask_t * pxAsyncTask,
+                                       StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+    static void prvStopWaiting( AsyncTask_t * pxAsyncTask ) PRIVILEGED_FUNCTION;
+
+    static void prvWaitOnStreamBuffer( AsyncTask_t * pxAsyncTask,
+                                       StreamBufferHandle_t xStreamBuffer )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) == NULL )
+            {
+                pxAsyncTask->pvWaitObject = xStreamBuffer;
+                listINSERT_END( &( pxAsyncTask->pxExecutor->xStreamBufferWaitList ), &( pxAsyncTask->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    static void prvStopWaiting( AsyncTask_t * pxAsyncTask )
+    {
+        taskENTER_CRITICAL();
+        {
+            if( listLIST_ITEM_CONTAINER( &( pxAsyncTask->xEventListItem ) ) != NULL )
+            {
+                ( void ) uxListRemove( &( pxAsyncTask->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncTaskStreamBufferReceive( AsyncTaskHandle_t xAsyncTask,
+                                              StreamBufferHandle_t xStreamBuffer,
+                                              void * pvRxData,
+                                              size_t xBufferLengthBytes,
+                                              size_t * pxReceivedBytes )
+    {
+        BaseType_t xReturn;
+        size_t xReceivedBytes;
+
+        configASSERT( xStreamBuffer );
+        configASSERT( pxReceivedBytes );
+
+        prvWaitOnStreamBuffer( xAsyncTask, xStreamBuffer );
+        xReceivedBytes = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, 0 );
+        *pxReceivedBytes = xReceivedBytes;
+
+        if( xReceivedBytes > ( size_t ) 0 )
+        {
+            prvStopWaiting( xAsyncTask );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvBlockAsyncTask( xAsyncTask, NULL, NULL, pdFAIL );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xAsyncTaskStreamBufferSend( AsyncTaskHandle_t xAsyncTask,
+                                           StreamBufferHandle_t xStreamBuffer,
+                                           const void * pvTxData,
+                                           size_t xDataLengthBytes )
+    {
+        BaseType_t xReturn;
+        size_t xSentBytes = 0;
+
+        configASSERT( xStreamBuffer );
+        configASSERT( xDataLengthBytes > ( size_t ) 0 );
+
+        prvWaitOnStreamBuffer( xAsyncTask, xStreamBuffer );
+
+        /* A stream buffer accepts as many bytes as fit, so only send once
+         * there is space for all of them.  A message buffer also needs space
+         * for the message length, and sends nothing if it does not fit. */
+        if( xStreamBufferSpacesAvailable( xStreamBuffer ) >= xDataLengthBytes )
+        {
+            xSentBytes = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, 0 );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xSentBytes == xDataLengthBytes )
+        {
+            prvStopWaiting( xAsyncTask );
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = prvBlockAsyncTask( xAsyncTask, NULL, NULL, pdFAIL );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include async tasks.  This #if is closed at the very bottom of this file. */
+#endif /* configUSE_ASYNC_TASKS == 1 */
@@ -0,0 +1,360 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* Standard includes. */
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the benchmark hooks.  This #if is closed at the very bottom of
+ * this file. */
+#if ( configUSE_BENCHMARK_HOOKS == 1 )
+
+/* The value of uxAPI while no API call is being timed. */
+    #define benchmarkAPI_NONE    benchmarkAPI_COUNT
+
+/*
+ * The measurements of one core.  Only the core itself updates them, with
+ * interrupts masked, so each member has a single writer.
+ *
+ * An API call is timed only if uxAPI still holds its benchmarkAPI_ constant
+ * when it returns.  Entering a hooked interrupt or switching out the task
+ * clears uxAPI, so a call that was interrupted or blocked is discarded.
+ */
+    typedef struct BenchmarkCore
+    {
+        uint32_t ulISRStart;        /*< The time the outermost hooked interrupt was entered. */
+        UBaseType_t uxISRNesting;   /*< The number of hooked interrupts entered and not yet exited. */
+        uint32_t ulSwitchStart;     /*< The time the current task was switched out. */
+        BaseType_t xSwitchPending;  /*< pdTRUE between switching out a task and switching in the next, as the first task is switched in without one being switched out. */
+        uint32_t ulAPIStart;        /*< The time the API call being timed was entered. */
+        UBaseType_t uxAPI;          /*< The benchmarkAPI_ constant of the API call being timed, or benchmarkAPI_NONE. */
+        BenchmarkStats_t xStats[ benchmarkMETRIC_COUNT ];
+    } BenchmarkCore_t;
+
+    PRIVILEGED_DATA static BenchmarkCore_t xBenchmarkCores[ configNUMBER_OF_CORES ];
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Adds ulTime to pxStats.  Called with interrupts masked.
+ */
+    static void prvBenchmarkRecord( BenchmarkStats_t * pxStats,
+                                    uint32_t ulTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clears the measurements of every core.
+ */
+    static void prvBenchmarkClear( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvBenchmarkRecord( BenchmarkStats_t * pxStats,
+                                    uint32_t ulTime )
+    {
+        UBaseType_t uxBucket = 0U;
+
+        if( ( pxStats->ulCount == 0U ) || ( ulTime < pxStats->ulMinimum ) )
+        {
+            pxStats->ulMinimum = ulTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulTime > pxStats->ulMaximum )
+        {
+            pxStats->ulMaximum = ulTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStats->ullTotal += ulTime;
+        pxStats->ulCount++;
+
+        /* The bucket is the index of the most significant set bit, capped at
+         * the last bucket. */
+        while( ( ulTime > 1U ) && ( uxBucket < ( UBaseType_t ) ( configBENCHMARK_BUCKETS - 1 ) ) )
+        {
+            ulTime >>= 1U;
+            uxBucket++;
+        }
+
+        pxStats->ulHistogram[ uxBucket ]++;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchmarkClear( void )
+    {
+        BaseType_t xCoreID;
+
+        ( void ) memset( xBenchmarkCores, 0x00, sizeof( xBenchmarkCores ) );
+
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            xBenchmarkCores[ xCoreID ].uxAPI = benchmarkAPI_NONE;
+            xBenchmarkCores[ xCoreID ].xSwitchPending = pdFALSE;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkISREnter( void )
+    {
+        BenchmarkCore_t * pxCore;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxCore = &( xBenchmarkCores[ portGET_CORE_ID() ] );
+
+            if( pxCore->uxISRNesting == 0U )
+            {
+                pxCore->ulISRStart = configBENCHMARK_TIMESTAMP();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxCore->uxISRNesting++;
+            pxCore->uxAPI = benchmarkAPI_NONE;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkISRExit( void )
+    {
+        BenchmarkCore_t * pxCore;
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t ulNow;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ulNow = configBENCHMARK_TIMESTAMP();
+            pxCore = &( xBenchmarkCores[ portGET_CORE_ID() ] );
+
+            if( pxCore->uxISRNesting > 0U )
+            {
+                pxCore->uxISRNesting--;
+
+                if( pxCore->uxISRNesting == 0U )
+                {
+                    prvBenchmarkRecord( &( pxCore->xStats[ benchmarkMETRIC_ISR ] ), ulNow - pxCore->ulISRStart );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkTaskSwitchedOut( void )
+    {
+        BenchmarkCore_t * pxCore;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxCore = &( xBenchmarkCores[ portGET_CORE_ID() ] );
+            pxCore->ulSwitchStart = configBENCHMARK_TIMESTAMP();
+            pxCore->xSwitchPending = pdTRUE;
+            pxCore->uxAPI = benchmarkAPI_NONE;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkTaskSwitchedIn( void )
+    {
+        BenchmarkCore_t * pxCore;
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t ulNow;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ulNow = configBENCHMARK_TIMESTAMP();
+            pxCore = &( xBenchmarkCores[ portGET_CORE_ID() ] );
+
+            if( pxCore->xSwitchPending != pdFALSE )
+            {
+                pxCore->xSwitchPending = pdFALSE;
+                prvBenchmarkRecord( &( pxCore->xStats[ benchmarkMETRIC_CONTEXT_SWITCH ] ), ulNow - pxCore->ulSwitchStart );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkAPIEnter( UBaseType_t uxApi )
+    {
+        BenchmarkCore_t * pxCore;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            pxCore = &( xBenchmarkCores[ portGET_CORE_ID() ] );
+            pxCore->uxAPI = uxApi;
+            pxCore->ulAPIStart = configBENCHMARK_TIMESTAMP();
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkAPIExit( UBaseType_t uxApi )
+    {
+        BenchmarkCore_t * pxCore;
+        UBaseType_t uxSavedInterruptStatus;
+        uint32_t ulNow;
+
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ulNow = configBENCHMARK_TIMESTAMP();
+            pxCore = &( xBenchmarkCores[ portGET_CORE_ID() ] );
+
+            if( pxCore->uxAPI == uxApi )
+            {
+                prvBenchmarkRecord( &( pxCore->xStats[ benchmarkMETRIC_API_FIRST + uxApi ] ), ulNow - pxCore->ulAPIStart );
+            }
+            else
+            {
+                /* The call was interrupted, blocked, or made while another
+                 * call was being timed. */
+                pxCore->xStats[ benchmarkMETRIC_API_FIRST + uxApi ].ulDiscarded++;
+            }
+
+            pxCore->uxAPI = benchmarkAPI_NONE;
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkGetStats( UBaseType_t uxMetric,
+                             BenchmarkStats_t * pxStats )
+    {
+        const BenchmarkStats_t * pxCoreStats;
+        BaseType_t xCoreID;
+        UBaseType_t uxBucket;
+
+        configASSERT( uxMetric < benchmarkMETRIC_COUNT );
+        configASSERT( pxStats != NULL );
+
+        ( void ) memset( pxStats, 0x00, sizeof( BenchmarkStats_t ) );
+
+        /* The other cores keep recording while their measurements are added
+         * up, so on multicore systems the result can miss the measurements
+         * made meanwhile. */
+        taskENTER_CRITICAL();
+        {
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                pxCoreStats = &( xBenchmarkCores[ xCoreID ].xStats[ uxMetric ] );
+
+                if( pxCoreStats->ulCount > 0U )
+                {
+                    if( ( pxStats->ulCount == 0U ) || ( pxCoreStats->ulMinimum < pxStats->ulMinimum ) )
+                    {
+                        pxStats->ulMinimum = pxCoreStats->ulMinimum;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( pxCoreStats->ulMaximum > pxStats->ulMaximum )
+                    {
+                        pxStats->ulMaximum = pxCoreStats->ulMaximum;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxStats->ullTotal += pxCoreStats->ullTotal;
+                pxStats->ulCount += pxCoreStats->ulCount;
+                pxStats->ulDiscarded += pxCoreStats->ulDiscarded;
+
+                for( uxBucket = 0U; uxBucket < ( UBaseType_t ) configBENCHMARK_BUCKETS; uxBucket++ )
+                {
+                    pxStats->ulHistogram[ uxBucket ] += pxCoreStats->ulHistogram[ uxBucket ];
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vBenchmarkReset( void )
+    {
+        portENABLE_CYCLE_COUNTER();
+
+        taskENTER_CRITICAL();
+        {
+            prvBenchmarkClear();
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the benchmark hooks.  If you want to include the benchmark hooks
+ * then ensure configUSE_BENCHMARK_HOOKS is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_BENCHMARK_HOOKS == 1 */
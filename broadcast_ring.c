@@ -0,0 +1,688 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "broadcast_ring.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include broadcast rings.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_BROADCAST_RINGS == 1 )
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+        #define broadcastringYIELD_IF_USING_PREEMPTION()
+    #else
+        #define broadcastringYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+    #endif
+
+/*
+ * uxWriteCount is a free running count of the items published, and is only
+ * updated by the writer.  The item published as count n is held in slot
+ * n % uxLength, so each subscriber only needs the count of the items it has
+ * read to find its next item, and the difference between the two counts is
+ * how far it is behind the writer, even after the counts wrap.
+ *
+ * The writer copies item n into its slot while uxWriteCount is n, so a
+ * subscriber can safely copy item r while uxWriteCount - r is less than
+ * uxLength.  It checks that before copying the item, and again afterwards, in
+ * case the writer overwrote the slot while the item was being copied.
+ *
+ * A subscriber that has to wait sets xReceiversWaiting, then checks the count
+ * again before blocking, both from within a critical section.  The writer
+ * checks xReceiversWaiting after updating the count, so at least one of them
+ * sees the other's update and a wake up cannot be missed.
+ */
+    typedef struct BroadcastRingDefinition
+    {
+        volatile UBaseType_t uxWriteCount;      /*< The number of items published, only updated by the writer. */
+        UBaseType_t uxWriteIndex;               /*< The index of the next slot to write, only used by the writer. */
+        UBaseType_t uxLength;                   /*< The number of slots in the ring. */
+        UBaseType_t uxItemSize;                 /*< The size of each item in bytes. */
+        uint8_t * pucStorage;                   /*< The storage area of uxLength * uxItemSize bytes. */
+        List_t xTasksWaitingToReceive;          /*< List of subscribers' tasks that are blocked waiting for an item.  Stored in priority order. */
+        volatile BaseType_t xReceiversWaiting;  /*< Set to pdTRUE when a task may be in xTasksWaitingToReceive, so the writer has to enter the kernel. */
+        uint8_t ucStaticallyAllocated;          /*< Set to pdTRUE if the memory used by the ring was statically allocated so no attempt is made to free it. */
+    } BroadcastRing_t;
+
+    typedef struct BroadcastSubscriberDefinition
+    {
+        BroadcastRing_t * pxRing;       /*< The ring the subscriber reads. */
+        UBaseType_t uxReadCount;        /*< The count of the next item to read, as compared with the ring's uxWriteCount. */
+        UBaseType_t uxMissedCount;      /*< The number of items skipped because the subscriber was lapped. */
+        uint8_t ucStaticallyAllocated;  /*< Set to pdTRUE if the memory used by the subscriber was statically allocated so no attempt is made to free it. */
+    } BroadcastSubscriber_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the dynamic and static create functions to fill in the
+ * members of a newly created ring.
+ */
+    static void prvInitialiseNewBroadcastRing( BroadcastRing_t * const pxRing,
+                                               const UBaseType_t uxLength,
+                                               const UBaseType_t uxItemSize,
+                                               uint8_t * const pucRingStorage,
+                                               const uint8_t ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by both the dynamic and static subscribe functions to fill in the
+ * members of a newly created subscriber.
+ */
+    static void prvInitialiseNewSubscriber( BroadcastSubscriber_t * const pxSubscriber,
+                                            BroadcastRing_t * const pxRing,
+                                            const uint8_t ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item into the ring.  Called by both publish functions.
+ */
+    static void prvWriteItem( BroadcastRing_t * const pxRing,
+                              const void * pvItem ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the subscriber's next item out of the ring if there is one, first
+ * skipping the items that were overwritten if the subscriber was lapped.
+ * Returns pdPASS if an item was copied, otherwise pdFAIL.
+ */
+    static BaseType_t prvReadItem( BroadcastSubscriber_t * const pxSubscriber,
+                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewBroadcastRing( BroadcastRing_t * const pxRing,
+                                               const UBaseType_t uxLength,
+                                               const UBaseType_t uxItemSize,
+                                               uint8_t * const pucRingStorage,
+                                               const uint8_t ucStaticallyAllocated )
+    {
+        ( void ) memset( ( void * ) pxRing, 0x00, sizeof( BroadcastRing_t ) ); /*lint !e9087 memset() requires void *. */
+        pxRing->uxLength = uxLength;
+        pxRing->uxItemSize = uxItemSize;
+        pxRing->pucStorage = pucRingStorage;
+        vListInitialise( &( pxRing->xTasksWaitingToReceive ) );
+        pxRing->ucStaticallyAllocated = ucStaticallyAllocated;
+
+        traceBROADCAST_RING_CREATE( pxRing );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseNewSubscriber( BroadcastSubscriber_t * const pxSubscriber,
+                                            BroadcastRing_t * const pxRing,
+                                            const uint8_t ucStaticallyAllocated )
+    {
+        pxSubscriber->pxRing = pxRing;
+        pxSubscriber->uxReadCount = pxRing->uxWriteCount;
+        pxSubscriber->uxMissedCount = ( UBaseType_t ) 0;
+        pxSubscriber->ucStaticallyAllocated = ucStaticallyAllocated;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        BroadcastRingHandle_t xBroadcastRingCreate( const UBaseType_t uxLength,
+                                                    const UBaseType_t uxItemSize )
+        {
+            uint8_t * pucAllocatedMemory = NULL;
+            size_t xStorageSizeBytes;
+
+            configASSERT( uxLength > ( UBaseType_t ) 1 );
+            configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+            /* Check for multiplication and addition overflow, then allocate the
+             * BroadcastRing_t structure and the storage area in a single call
+             * to pvPortMalloc().  The structure is placed at the start of the
+             * allocated memory and the storage area follows immediately
+             * after. */
+            if( ( ( SIZE_MAX / uxLength ) >= uxItemSize ) &&
+                ( ( SIZE_MAX - sizeof( BroadcastRing_t ) ) >= ( ( size_t ) uxLength * ( size_t ) uxItemSize ) ) )
+            {
+                xStorageSizeBytes = ( size_t ) uxLength * ( size_t ) uxItemSize;
+                pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( BroadcastRing_t ) + xStorageSizeBytes ); /*lint !e9079 malloc() only returns void*. */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pucAllocatedMemory != NULL )
+            {
+                prvInitialiseNewBroadcastRing( ( BroadcastRing_t * ) pucAllocatedMemory,        /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+                                               uxLength,
+                                               uxItemSize,
+                                               pucAllocatedMemory + sizeof( BroadcastRing_t ), /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer. */
+                                               ( uint8_t ) pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return ( BroadcastRingHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        BroadcastRingHandle_t xBroadcastRingCreateStatic( const UBaseType_t uxLength,
+                                                          const UBaseType_t uxItemSize,
+                                                          uint8_t * const pucRingStorage,
+                                                          StaticBroadcastRing_t * const pxStaticRing )
+        {
+            BroadcastRing_t * const pxRing = ( BroadcastRing_t * ) pxStaticRing; /*lint !e740 !e9087 Safe cast as StaticBroadcastRing_t is opaque BroadcastRing_t. */
+            BroadcastRingHandle_t xReturn = NULL;
+
+            configASSERT( uxLength > ( UBaseType_t ) 1 );
+            configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+            configASSERT( pucRingStorage );
+            configASSERT( pxStaticRing );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticBroadcastRing_t equals the size of the
+                 * real ring structure. */
+                volatile size_t xSize = sizeof( StaticBroadcastRing_t );
+                configASSERT( xSize == sizeof( BroadcastRing_t ) );
+            } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+            #endif /* configASSERT_DEFINED */
+
+            if( ( pucRingStorage != NULL ) && ( pxStaticRing != NULL ) )
+            {
+                prvInitialiseNewBroadcastRing( pxRing, uxLength, uxItemSize, pucRingStorage, ( uint8_t ) pdTRUE );
+                xReturn = ( BroadcastRingHandle_t ) pxRing;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vBroadcastRingDelete( BroadcastRingHandle_t xRing )
+    {
+        BroadcastRing_t * const pxRing = xRing;
+
+        configASSERT( pxRing );
+
+        /* No subscriber's task may be waiting on a ring that is deleted. */
+        configASSERT( listLIST_IS_EMPTY( &( pxRing->xTasksWaitingToReceive ) ) != pdFALSE );
+
+        if( pxRing->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                /* Both the structure and the storage area were allocated using
+                 * a single call to pvPortMalloc(), hence only one call to
+                 * vPortFree() is required. */
+                vPortFree( ( void * ) pxRing ); /*lint !e9087 Standard free() semantics require void *. */
+            }
+            #else
+            {
+                /* Should not be possible to get here, the flag must be corrupt.
+                 * Force an assert. */
+                configASSERT( xRing == ( BroadcastRingHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure was not allocated dynamically and cannot be freed -
+             * just scrub it so future use will assert. */
+            ( void ) memset( ( void * ) pxRing, 0x00, sizeof( BroadcastRing_t ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+        BroadcastSubscriberHandle_t xBroadcastRingSubscribe( BroadcastRingHandle_t xRing )
+        {
+            BroadcastSubscriber_t * pxSubscriber;
+
+            configASSERT( xRing );
+
+            pxSubscriber = ( BroadcastSubscriber_t * ) pvPortMalloc( sizeof( BroadcastSubscriber_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+            if( pxSubscriber != NULL )
+            {
+                prvInitialiseNewSubscriber( pxSubscriber, xRing, ( uint8_t ) pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxSubscriber;
+        }
+
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+        BroadcastSubscriberHandle_t xBroadcastRingSubscribeStatic( BroadcastRingHandle_t xRing,
+                                                                   StaticBroadcastSubscriber_t * const pxStaticSubscriber )
+        {
+            BroadcastSubscriber_t * const pxSubscriber = ( BroadcastSubscriber_t * ) pxStaticSubscriber; /*lint !e740 !e9087 Safe cast as StaticBroadcastSubscriber_t is opaque BroadcastSubscriber_t. */
+            BroadcastSubscriberHandle_t xReturn = NULL;
+
+            configASSERT( xRing );
+            configASSERT( pxStaticSubscriber );
+
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticBroadcastSubscriber_t equals the size
+                 * of the real subscriber structure. */
+                volatile size_t xSize = sizeof( StaticBroadcastSubscriber_t );
+                configASSERT( xSize == sizeof( BroadcastSubscriber_t ) );
+            } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+            #endif /* configASSERT_DEFINED */
+
+            if( pxStaticSubscriber != NULL )
+            {
+                prvInitialiseNewSubscriber( pxSubscriber, xRing, ( uint8_t ) pdTRUE );
+                xReturn = ( BroadcastSubscriberHandle_t ) pxSubscriber;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+    void vBroadcastRingUnsubscribe( BroadcastSubscriberHandle_t xSubscriber )
+    {
+        BroadcastSubscriber_t * const pxSubscriber = xSubscriber;
+
+        configASSERT( pxSubscriber );
+
+        if( pxSubscriber->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            {
+                vPortFree( ( void * ) pxSubscriber ); /*lint !e9087 Standard free() semantics require void *. */
+            }
+            #else
+            {
+                /* Should not be possible to get here, the flag must be corrupt.
+                 * Force an assert. */
+                configASSERT( xSubscriber == ( BroadcastSubscriberHandle_t ) ~0 );
+            }
+            #endif
+        }
+        else
+        {
+            /* The structure was not allocated dynamically and cannot be freed -
+             * just scrub it so future use will assert. */
+            ( void ) memset( ( void * ) pxSubscriber, 0x00, sizeof( BroadcastSubscriber_t ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWriteItem( BroadcastRing_t * const pxRing,
+                              const void * pvItem )
+    {
+        ( void ) memcpy( ( void * ) &( pxRing->pucStorage[ pxRing->uxWriteIndex * pxRing->uxItemSize ] ), pvItem, ( size_t ) pxRing->uxItemSize ); /*lint !e9087 memcpy() requires void *. */
+
+        pxRing->uxWriteIndex++;
+
+        if( pxRing->uxWriteIndex == pxRing->uxLength )
+        {
+            pxRing->uxWriteIndex = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The item must be in the storage area before the subscribers can see
+         * the updated count, and the count must be updated before the next
+         * item overwrites a slot. */
+        portMEMORY_BARRIER();
+        pxRing->uxWriteCount++;
+
+        /* The subscribers must see the updated count before their waiting
+         * state is checked. */
+        portMEMORY_BARRIER();
+
+        traceBROADCAST_RING_PUBLISH( pxRing );
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvReadItem( BroadcastSubscriber_t * const pxSubscriber,
+                                   void * const pvBuffer )
+    {
+        BroadcastRing_t * const pxRing = pxSubscriber->pxRing;
+        const UBaseType_t uxMaximumBehind = pxRing->uxLength - ( UBaseType_t ) 1;
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xComplete = pdFALSE;
+        UBaseType_t uxBehind, uxMissed;
+
+        while( xComplete == pdFALSE )
+        {
+            uxBehind = ( UBaseType_t ) ( pxRing->uxWriteCount - pxSubscriber->uxReadCount );
+
+            if( uxBehind == ( UBaseType_t ) 0 )
+            {
+                /* Every item published has been read. */
+                xComplete = pdTRUE;
+            }
+            else
+            {
+                if( uxBehind > uxMaximumBehind )
+                {
+                    /* The subscriber was lapped, so skip to the oldest item the
+                     * writer is not about to overwrite. */
+                    uxMissed = uxBehind - uxMaximumBehind;
+                    pxSubscriber->uxReadCount += uxMissed;
+                    pxSubscriber->uxMissedCount += uxMissed;
+                    traceBROADCAST_RING_LAPPED( pxSubscriber, uxMissed );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The count must be read before the item it makes visible. */
+                portMEMORY_BARRIER();
+                ( void ) memcpy( pvBuffer, ( void * ) &( pxRing->pucStorage[ ( pxSubscriber->uxReadCount % pxRing->uxLength ) * pxRing->uxItemSize ] ), ( size_t ) pxRing->uxItemSize ); /*lint !e9087 memcpy() requires void *. */
+
+                /* The item must have been copied out before the count is read
+                 * again to check the writer did not start to overwrite it. */
+                portMEMORY_BARRIER();
+
+                if( ( UBaseType_t ) ( pxRing->uxWriteCount - pxSubscriber->uxReadCount ) <= uxMaximumBehind )
+                {
+                    pxSubscriber->uxReadCount++;
+                    xReturn = pdPASS;
+                    xComplete = pdTRUE;
+                }
+                else
+                {
+                    /* The item may have changed while it was being copied, so
+                     * go round again, which skips past it. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vBroadcastRingPublish( BroadcastRingHandle_t xRing,
+                                const void * const pvItem )
+    {
+        BroadcastRing_t * const pxRing = xRing;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        configASSERT( pxRing );
+        configASSERT( pvItem );
+
+        prvWriteItem( pxRing, pvItem );
+
+        /* Only enter the kernel if a subscriber may be waiting for the item. */
+        if( pxRing->xReceiversWaiting != pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxRing->xReceiversWaiting = pdFALSE;
+
+                while( listLIST_IS_EMPTY( &( pxRing->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxRing->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    broadcastringYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vBroadcastRingPublishFromISR( BroadcastRingHandle_t xRing,
+                                       const void * const pvItem,
+                                       BaseType_t * const pxHigherPriorityTaskWoken )
+    {
+        BroadcastRing_t * const pxRing = xRing;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxRing );
+        configASSERT( pvItem );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum system call (or maximum API call) interrupt priority.
+         * Interrupts that are above the maximum system call priority are kept
+         * permanently enabled, even when the RTOS kernel is in a critical
+         * section, but cannot make any calls to FreeRTOS API functions. */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        prvWriteItem( pxRing, pvItem );
+
+        if( pxRing->xReceiversWaiting != pdFALSE )
+        {
+            uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+            {
+                pxRing->xReceiversWaiting = pdFALSE;
+
+                while( listLIST_IS_EMPTY( &( pxRing->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxRing->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xBroadcastRingReceive( BroadcastSubscriberHandle_t xSubscriber,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait )
+    {
+        BroadcastSubscriber_t * const pxSubscriber = xSubscriber;
+        BroadcastRing_t * pxRing;
+        BaseType_t xReturn, xEntryTimeSet = pdFALSE, xTimedOut = pdFALSE;
+        TimeOut_t xTimeOut;
+
+        configASSERT( pxSubscriber );
+        configASSERT( pvBuffer );
+
+        pxRing = pxSubscriber->pxRing;
+
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        xReturn = prvReadItem( pxSubscriber, pvBuffer );
+
+        while( ( xReturn == pdFAIL ) && ( xTicksToWait != ( TickType_t ) 0 ) && ( xTimedOut == pdFALSE ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+                {
+                    xTimedOut = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTimedOut == pdFALSE )
+                {
+                    /* Publish that a task is waiting before looking at the
+                     * count again, so an item published after the check still
+                     * unblocks this task. */
+                    pxRing->xReceiversWaiting = pdTRUE;
+                    portMEMORY_BARRIER();
+
+                    if( pxRing->uxWriteCount == pxSubscriber->uxReadCount )
+                    {
+                        traceBLOCKING_ON_BROADCAST_RING_RECEIVE( pxSubscriber );
+                        vTaskPlaceOnEventList( &( pxRing->xTasksWaitingToReceive ), xTicksToWait );
+
+                        /* All ports are written to allow a yield in a critical
+                         * section (some will yield immediately, others wait
+                         * until the critical section exits). */
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = prvReadItem( pxSubscriber, pvBuffer );
+        }
+
+        if( xReturn == pdPASS )
+        {
+            traceBROADCAST_RING_RECEIVE( pxSubscriber );
+        }
+        else
+        {
+            traceBROADCAST_RING_RECEIVE_FAILED( pxSubscriber );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxBroadcastRingItemsAvailable( BroadcastSubscriberHandle_t xSubscriber )
+    {
+        const BroadcastSubscriber_t * const pxSubscriber = xSubscriber;
+        UBaseType_t uxBehind, uxMaximumBehind;
+
+        configASSERT( pxSubscriber );
+
+        uxBehind = ( UBaseType_t ) ( pxSubscriber->pxRing->uxWriteCount - pxSubscriber->uxReadCount );
+        uxMaximumBehind = pxSubscriber->pxRing->uxLength - ( UBaseType_t ) 1;
+
+        if( uxBehind > uxMaximumBehind )
+        {
+            uxBehind = uxMaximumBehind;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxBehind;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxBroadcastRingGetMissedCount( BroadcastSubscriberHandle_t xSubscriber )
+    {
+        configASSERT( xSubscriber );
+
+        return xSubscriber->uxMissedCount;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include broadcast rings.  This #if is closed at the very bottom of this
+ * file. */
+#endif /* configUSE_BROADCAST_RINGS == 1 */
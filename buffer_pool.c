@@ -0,0 +1,437 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "message_buffer.h"
+#include "atomic.h"
+#include "buffer_pool.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include buffer pools.  This #if is closed at the very bottom of this file. */
+#if ( configUSE_BUFFER_POOLS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use buffer pools.
+    #endif
+
+    #if ( configUSE_COUNTING_SEMAPHORES != 1 )
+        #error configUSE_COUNTING_SEMAPHORES must be set to 1 to use buffer pools.
+    #endif
+
+/* The size of a structure rounded up so whatever follows it in the same
+ * allocation is aligned. */
+    #define bufferALIGNED_SIZE( xSize )    ( ( ( xSize ) + ( ( size_t ) portBYTE_ALIGNMENT - 1U ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The buffers follow the pool structure in the same allocation, each one a
+ * header followed by its data.  Free buffers are linked through their pxNext
+ * members.  The count of xFreeBuffers always equals the number of buffers in
+ * pxFreeBuffers that have not been claimed by a task or interrupt that took
+ * the semaphore, so a successful take guarantees a buffer is available. */
+    typedef struct BufferPoolDefinition
+    {
+        SemaphoreHandle_t xFreeBuffers; /*< Counts the free buffers, and holds the tasks waiting for one. */
+        PoolBuffer_t * pxFreeBuffers;   /*< The buffers that are not in use. */
+        size_t xBufferSize;             /*< The number of data bytes in each buffer. */
+    } BufferPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Pops a buffer from the free list of a pool whose semaphore has been taken,
+ * and initialises it.  Must be called from a critical section.
+ */
+    static PoolBuffer_t * prvTakeFreeBuffer( BufferPool_t * pxPool ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static PoolBuffer_t * prvTakeFreeBuffer( BufferPool_t * pxPool )
+    {
+        PoolBuffer_t * const pxBuffer = pxPool->pxFreeBuffers;
+
+        configASSERT( pxBuffer );
+
+        pxPool->pxFreeBuffers = pxBuffer->pxNext;
+        pxBuffer->pxNext = NULL;
+        pxBuffer->ulReferenceCount = 1U;
+        pxBuffer->xLength = 0U;
+
+        return pxBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+    BufferPoolHandle_t xBufferPoolCreate( size_t xBufferSize,
+                                          UBaseType_t uxNumberOfBuffers )
+    {
+        BufferPool_t * pxPool = NULL;
+        PoolBuffer_t * pxBuffer;
+        uint8_t * pucBlock;
+        size_t xBlockSize;
+        UBaseType_t ux;
+
+        configASSERT( xBufferSize > ( size_t ) 0 );
+        configASSERT( uxNumberOfBuffers > ( UBaseType_t ) 0 );
+
+        xBlockSize = bufferALIGNED_SIZE( sizeof( PoolBuffer_t ) ) + bufferALIGNED_SIZE( xBufferSize );
+
+        /* Check for addition and multiplication overflow. */
+        if( ( xBlockSize > xBufferSize ) &&
+            ( ( ( SIZE_MAX - bufferALIGNED_SIZE( sizeof( BufferPool_t ) ) ) / xBlockSize ) >= ( size_t ) uxNumberOfBuffers ) )
+        {
+            pxPool = ( BufferPool_t * ) pvPortMalloc( bufferALIGNED_SIZE( sizeof( BufferPool_t ) ) + ( xBlockSize * ( size_t ) uxNumberOfBuffers ) ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxPool != NULL )
+        {
+            pxPool->xFreeBuffers = xSemaphoreCreateCounting( uxNumberOfBuffers, uxNumberOfBuffers );
+
+            if( pxPool->xFreeBuffers != NULL )
+            {
+                pxPool->pxFreeBuffers = NULL;
+                pxPool->xBufferSize = xBufferSize;
+                pucBlock = ( ( uint8_t * ) pxPool ) + bufferALIGNED_SIZE( sizeof( BufferPool_t ) ); /*lint !e9016 Pointer arithmetic is needed to find the buffers that follow the pool structure. */
+
+                for( ux = 0U; ux < uxNumberOfBuffers; ux++ )
+                {
+                    pxBuffer = ( PoolBuffer_t * ) pucBlock; /*lint !e9087 !e826 The block starts with a buffer header. */
+                    pxBuffer->pxPool = pxPool;
+                    pxBuffer->ulReferenceCount = 0U;
+                    pxBuffer->xLength = 0U;
+                    pxBuffer->pucData = pucBlock + bufferALIGNED_SIZE( sizeof( PoolBuffer_t ) );
+                    pxBuffer->pxNext = pxPool->pxFreeBuffers;
+                    pxPool->pxFreeBuffers = pxBuffer;
+                    pucBlock += xBlockSize;
+                }
+
+                traceBUFFER_POOL_CREATE( pxPool );
+            }
+            else
+            {
+                vPortFree( pxPool );
+                pxPool = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxPool;
+    }
+/*-----------------------------------------------------------*/
+
+    PoolBuffer_t * pxBufferPoolAllocate( BufferPoolHandle_t xPool,
+                                         TickType_t xTicksToWait )
+    {
+        BufferPool_t * const pxPool = xPool;
+        PoolBuffer_t * pxBuffer = NULL;
+
+        configASSERT( pxPool );
+
+        if( xSemaphoreTake( pxPool->xFreeBuffers, xTicksToWait ) == pdPASS )
+        {
+            taskENTER_CRITICAL();
+            {
+                pxBuffer = prvTakeFreeBuffer( pxPool );
+            }
+            taskEXIT_CRITICAL();
+
+            traceBUFFER_POOL_ALLOCATE( pxPool, pxBuffer );
+        }
+        else
+        {
+            traceBUFFER_POOL_ALLOCATE_FAILED( pxPool );
+        }
+
+        return pxBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+    PoolBuffer_t * pxBufferPoolAllocateFromISR( BufferPoolHandle_t xPool )
+    {
+        BufferPool_t * const pxPool = xPool;
+        PoolBuffer_t * pxBuffer = NULL;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxPool );
+
+        /* Taking a semaphore from an ISR never unblocks a task, as only tasks
+         * waiting to give it could be unblocked, and there are none. */
+        if( xSemaphoreTakeFromISR( pxPool->xFreeBuffers, NULL ) == pdPASS )
+        {
+            uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+            {
+                pxBuffer = prvTakeFreeBuffer( pxPool );
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            traceBUFFER_POOL_ALLOCATE( pxPool, pxBuffer );
+        }
+        else
+        {
+            traceBUFFER_POOL_ALLOCATE_FAILED( pxPool );
+        }
+
+        return pxBuffer;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxBufferPoolGetFreeBuffers( BufferPoolHandle_t xPool )
+    {
+        configASSERT( xPool );
+
+        return uxSemaphoreGetCount( xPool->xFreeBuffers );
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xBufferPoolGetBufferSize( BufferPoolHandle_t xPool )
+    {
+        configASSERT( xPool );
+
+        return xPool->xBufferSize;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolBufferRetain( PoolBuffer_t * pxBuffer )
+    {
+        configASSERT( pxBuffer );
+        configASSERT( pxBuffer->ulReferenceCount > 0U );
+
+        ( void ) Atomic_Increment_u32( &( pxBuffer->ulReferenceCount ) );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolBufferRelease( PoolBuffer_t * pxBuffer )
+    {
+        PoolBuffer_t * pxNext;
+        BufferPool_t * pxPool;
+
+        configASSERT( pxBuffer );
+
+        /* Atomic_Decrement_u32() returns the count before the decrement.  A
+         * freed buffer's reference to the next buffer in its chain is released
+         * in turn, without recursion. */
+        while( ( pxBuffer != NULL ) && ( Atomic_Decrement_u32( &( pxBuffer->ulReferenceCount ) ) == 1U ) )
+        {
+            pxNext = pxBuffer->pxNext;
+            pxPool = pxBuffer->pxPool;
+
+            traceBUFFER_POOL_FREE( pxPool, pxBuffer );
+
+            taskENTER_CRITICAL();
+            {
+                pxBuffer->pxNext = pxPool->pxFreeBuffers;
+                pxPool->pxFreeBuffers = pxBuffer;
+            }
+            taskEXIT_CRITICAL();
+
+            /* The buffer is on the free list before the semaphore is given,
+             * so a task unblocked by the give finds it there. */
+            ( void ) xSemaphoreGive( pxPool->xFreeBuffers );
+
+            pxBuffer = pxNext;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolBufferReleaseFromISR( PoolBuffer_t * pxBuffer,
+                                    BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        PoolBuffer_t * pxNext;
+        BufferPool_t * pxPool;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxBuffer );
+
+        while( ( pxBuffer != NULL ) && ( Atomic_Decrement_u32( &( pxBuffer->ulReferenceCount ) ) == 1U ) )
+        {
+            pxNext = pxBuffer->pxNext;
+            pxPool = pxBuffer->pxPool;
+
+            traceBUFFER_POOL_FREE( pxPool, pxBuffer );
+
+            uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+            {
+                pxBuffer->pxNext = pxPool->pxFreeBuffers;
+                pxPool->pxFreeBuffers = pxBuffer;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            ( void ) xSemaphoreGiveFromISR( pxPool->xFreeBuffers, pxHigherPriorityTaskWoken );
+
+            pxBuffer = pxNext;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vPoolBufferChain( PoolBuffer_t * pxHead,
+                           PoolBuffer_t * pxTail )
+    {
+        configASSERT( pxHead );
+        configASSERT( pxTail );
+
+        while( pxHead->pxNext != NULL )
+        {
+            pxHead = pxHead->pxNext;
+        }
+
+        pxHead->pxNext = pxTail;
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xPoolBufferGetChainLength( const PoolBuffer_t * pxHead )
+    {
+        size_t xLength = 0U;
+
+        while( pxHead != NULL )
+        {
+            xLength += pxHead->xLength;
+            pxHead = pxHead->pxNext;
+        }
+
+        return xLength;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPoolBufferQueueSend( QueueHandle_t xQueue,
+                                     PoolBuffer_t * pxBuffer,
+                                     TickType_t xTicksToWait )
+    {
+        configASSERT( pxBuffer );
+        configASSERT( uxQueueGetQueueItemSize( xQueue ) == sizeof( PoolBuffer_t * ) );
+
+        return xQueueSendToBack( xQueue, &pxBuffer, xTicksToWait );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPoolBufferQueueSendFromISR( QueueHandle_t xQueue,
+                                            PoolBuffer_t * pxBuffer,
+                                            BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        configASSERT( pxBuffer );
+        configASSERT( uxQueueGetQueueItemSize( xQueue ) == sizeof( PoolBuffer_t * ) );
+
+        return xQueueSendToBackFromISR( xQueue, &pxBuffer, pxHigherPriorityTaskWoken );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPoolBufferQueueReceive( QueueHandle_t xQueue,
+                                        PoolBuffer_t ** ppxBuffer,
+                                        TickType_t xTicksToWait )
+    {
+        configASSERT( ppxBuffer );
+        configASSERT( uxQueueGetQueueItemSize( xQueue ) == sizeof( PoolBuffer_t * ) );
+
+        return xQueueReceive( xQueue, ppxBuffer, xTicksToWait );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPoolBufferMessageSend( MessageBufferHandle_t xMessageBuffer,
+                                       PoolBuffer_t * pxBuffer,
+                                       TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+
+        configASSERT( pxBuffer );
+
+        if( xMessageBufferSend( xMessageBuffer, &pxBuffer, sizeof( pxBuffer ), xTicksToWait ) == sizeof( pxBuffer ) )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPoolBufferMessageSendFromISR( MessageBufferHandle_t xMessageBuffer,
+                                              PoolBuffer_t * pxBuffer,
+                                              BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        BaseType_t xReturn;
+
+        configASSERT( pxBuffer );
+
+        if( xMessageBufferSendFromISR( xMessageBuffer, &pxBuffer, sizeof( pxBuffer ), pxHigherPriorityTaskWoken ) == sizeof( pxBuffer ) )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPoolBufferMessageReceive( MessageBufferHandle_t xMessageBuffer,
+                                          PoolBuffer_t ** ppxBuffer,
+                                          TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn;
+
+        configASSERT( ppxBuffer );
+
+        if( xMessageBufferReceive( xMessageBuffer, ppxBuffer, sizeof( *ppxBuffer ), xTicksToWait ) == sizeof( *ppxBuffer ) )
+        {
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include buffer pools.  This #if is closed at the very bottom of this file. */
+#endif /* configUSE_BUFFER_POOLS == 1 */
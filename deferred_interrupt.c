@@ -0,0 +1,417 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "deferred_interrupt.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include deferred interrupts.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_DEFERRED_INTERRUPTS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use deferred interrupts.
+    #endif
+
+/* Reads the time used to measure the latency of deferred interrupts.  Only
+ * used from critical sections, which can be entered from interrupts, so the
+ * tick count is read with the FromISR() version of the API function. */
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #define deferredGET_TIME( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+        #else
+            #define deferredGET_TIME( ulTime )    ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+        #endif
+    #else
+        #define deferredGET_TIME( ulTime )        ( ulTime ) = ( configRUN_TIME_COUNTER_TYPE ) xTaskGetTickCountFromISR()
+    #endif
+
+/* The service task of a priority calls the handlers of the deferred interrupts
+ * of that priority.  Service tasks are never deleted, so the list of them is
+ * only ever added to. */
+    typedef struct DeferredInterruptServiceDefinition
+    {
+        TaskHandle_t xTask;                                    /*< The task from which the handlers are called. */
+        UBaseType_t uxPriority;                                /*< The priority of xTask. */
+        List_t xPendingList;                                   /*< The deferred interrupts waiting to be handled, in the order they were raised. */
+        struct DeferredInterruptServiceDefinition * pxNext;    /*< The next service task in the list of all service tasks. */
+    } DeferredInterruptService_t;
+
+/* A deferred interrupt is in its service task's pending list from the time it
+ * is first raised until its handler is called. */
+    typedef struct DeferredInterruptDefinition
+    {
+        DeferredInterruptFunction_t pxFunction;                /*< The handler. */
+        void * pvParameters;                                   /*< The value passed to pxFunction. */
+        DeferredInterruptService_t * pxService;                /*< The service task from which pxFunction is called. */
+        ListItem_t xPendingListItem;                           /*< References the pending list of the service task while the interrupt is waiting to be handled. */
+        uint32_t ulPendingCount;                               /*< The number of raises since the handler was last called. */
+        configRUN_TIME_COUNTER_TYPE ulRaisedTime;              /*< The time of the first of those raises. */
+        DeferredInterruptStats_t xStats;                       /*< The statistics returned by vDeferredInterruptGetStats(). */
+    } DeferredInterrupt_t;
+
+/*-----------------------------------------------------------*/
+
+/* The service tasks created so far. */
+    PRIVILEGED_DATA static DeferredInterruptService_t * pxServices = NULL;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The function run by every service task.
+ */
+    static portTASK_FUNCTION_PROTO( prvDeferredInterruptServiceTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the service task for uxPriority, creating it if it does not exist.
+ * Returns NULL if there was insufficient heap memory to create it.  Must be
+ * called with the scheduler suspended.
+ */
+    static DeferredInterruptService_t * prvGetService( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records a raise of a deferred interrupt, appending it to the pending list of
+ * its service task if it is not already there.  Returns pdTRUE if the service
+ * task must be notified, which is only when the pending list was empty, as the
+ * service task empties the list before it waits for the next notification.
+ * Must be called from a critical section.
+ */
+    static BaseType_t prvRaise( DeferredInterrupt_t * pxInterrupt ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvRaise( DeferredInterrupt_t * pxInterrupt )
+    {
+        List_t * const pxPendingList = &( pxInterrupt->pxService->xPendingList );
+        BaseType_t xNotify = pdFALSE;
+
+        ( pxInterrupt->xStats.ulRaisedCount )++;
+        ( pxInterrupt->ulPendingCount )++;
+
+        if( listLIST_ITEM_CONTAINER( &( pxInterrupt->xPendingListItem ) ) == NULL )
+        {
+            deferredGET_TIME( pxInterrupt->ulRaisedTime );
+            xNotify = listLIST_IS_EMPTY( pxPendingList );
+            listINSERT_END( pxPendingList, &( pxInterrupt->xPendingListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNotify;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvDeferredInterruptServiceTask, pvParameters )
+    {
+        DeferredInterruptService_t * const pxService = ( DeferredInterruptService_t * ) pvParameters; /*lint !e9087 The parameter is always the service the task runs. */
+        DeferredInterrupt_t * pxInterrupt;
+        configRUN_TIME_COUNTER_TYPE ulNow;
+        configRUN_TIME_COUNTER_TYPE ulLatency;
+        uint32_t ulRaisedCount;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+
+            /* Call the handler of every pending interrupt.  Interrupts raised
+             * while these run are appended to the list and handled in turn. */
+            for( ; ; )
+            {
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_IS_EMPTY( &( pxService->xPendingList ) ) == pdFALSE )
+                    {
+                        pxInterrupt = listGET_OWNER_OF_HEAD_ENTRY( &( pxService->xPendingList ) );
+                        ( void ) uxListRemove( &( pxInterrupt->xPendingListItem ) );
+                        ulRaisedCount = pxInterrupt->ulPendingCount;
+                        pxInterrupt->ulPendingCount = 0U;
+
+                        deferredGET_TIME( ulNow );
+                        ulLatency = ulNow - pxInterrupt->ulRaisedTime;
+
+                        if( ( pxInterrupt->xStats.ulHandledCount == 0U ) || ( ulLatency < pxInterrupt->xStats.ulLatencyMinimum ) )
+                        {
+                            pxInterrupt->xStats.ulLatencyMinimum = ulLatency;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        if( ulLatency > pxInterrupt->xStats.ulLatencyMaximum )
+                        {
+                            pxInterrupt->xStats.ulLatencyMaximum = ulLatency;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        pxInterrupt->xStats.ulLatencyTotal += ulLatency;
+                        ( pxInterrupt->xStats.ulHandledCount )++;
+                    }
+                    else
+                    {
+                        pxInterrupt = NULL;
+                        ulRaisedCount = 0U;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxInterrupt == NULL )
+                {
+                    break;
+                }
+
+                traceDEFERRED_INTERRUPT_HANDLER_START( pxInterrupt, ulRaisedCount );
+
+                pxInterrupt->pxFunction( pxInterrupt->pvParameters, ulRaisedCount );
+
+                traceDEFERRED_INTERRUPT_HANDLER_END( pxInterrupt );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static DeferredInterruptService_t * prvGetService( UBaseType_t uxPriority )
+    {
+        DeferredInterruptService_t * pxService;
+
+        for( pxService = pxServices; pxService != NULL; pxService = pxService->pxNext )
+        {
+            if( pxService->uxPriority == uxPriority )
+            {
+                break;
+            }
+        }
+
+        if( pxService == NULL )
+        {
+            pxService = ( DeferredInterruptService_t * ) pvPortMalloc( sizeof( DeferredInterruptService_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+            if( pxService != NULL )
+            {
+                pxService->uxPriority = uxPriority;
+                vListInitialise( &( pxService->xPendingList ) );
+
+                if( xTaskCreate( prvDeferredInterruptServiceTask,
+                                 "DefIRQ",
+                                 configDEFERRED_INTERRUPT_STACK_DEPTH,
+                                 ( void * ) pxService,
+                                 uxPriority,
+                                 &( pxService->xTask ) ) == pdPASS )
+                {
+                    pxService->pxNext = pxServices;
+                    pxServices = pxService;
+                }
+                else
+                {
+                    vPortFree( pxService );
+                    pxService = NULL;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxService;
+    }
+/*-----------------------------------------------------------*/
+
+    DeferredInterruptHandle_t xDeferredInterruptRegister( DeferredInterruptFunction_t pxFunction,
+                                                          void * pvParameters,
+                                                          UBaseType_t uxPriority )
+    {
+        DeferredInterrupt_t * pxInterrupt;
+        DeferredInterruptService_t * pxService;
+
+        configASSERT( pxFunction );
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        pxInterrupt = ( DeferredInterrupt_t * ) pvPortMalloc( sizeof( DeferredInterrupt_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxInterrupt != NULL )
+        {
+            /* The scheduler is suspended so two handlers registered at the
+             * same priority cannot both create a service task for it. */
+            vTaskSuspendAll();
+            {
+                pxService = prvGetService( uxPriority );
+            }
+            ( void ) xTaskResumeAll();
+
+            if( pxService != NULL )
+            {
+                pxInterrupt->pxFunction = pxFunction;
+                pxInterrupt->pvParameters = pvParameters;
+                pxInterrupt->pxService = pxService;
+                pxInterrupt->ulPendingCount = 0U;
+                pxInterrupt->ulRaisedTime = 0U;
+                ( void ) memset( &( pxInterrupt->xStats ), 0x00, sizeof( DeferredInterruptStats_t ) );
+                vListInitialiseItem( &( pxInterrupt->xPendingListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxInterrupt->xPendingListItem ), pxInterrupt );
+
+                traceDEFERRED_INTERRUPT_REGISTER( pxInterrupt );
+            }
+            else
+            {
+                vPortFree( pxInterrupt );
+                pxInterrupt = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxInterrupt;
+    }
+/*-----------------------------------------------------------*/
+
+    void vDeferredInterruptRaiseFromISR( DeferredInterruptHandle_t xInterrupt,
+                                         BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        DeferredInterrupt_t * const pxInterrupt = xInterrupt;
+        BaseType_t xNotify;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxInterrupt );
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            xNotify = prvRaise( pxInterrupt );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        traceDEFERRED_INTERRUPT_RAISE( pxInterrupt );
+
+        if( xNotify != pdFALSE )
+        {
+            vTaskNotifyGiveFromISR( pxInterrupt->pxService->xTask, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vDeferredInterruptRaise( DeferredInterruptHandle_t xInterrupt )
+    {
+        DeferredInterrupt_t * const pxInterrupt = xInterrupt;
+        BaseType_t xNotify;
+
+        configASSERT( pxInterrupt );
+
+        taskENTER_CRITICAL();
+        {
+            xNotify = prvRaise( pxInterrupt );
+        }
+        taskEXIT_CRITICAL();
+
+        traceDEFERRED_INTERRUPT_RAISE( pxInterrupt );
+
+        if( xNotify != pdFALSE )
+        {
+            ( void ) xTaskNotifyGive( pxInterrupt->pxService->xTask );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vDeferredInterruptGetStats( DeferredInterruptHandle_t xInterrupt,
+                                     DeferredInterruptStats_t * pxStats )
+    {
+        DeferredInterrupt_t * const pxInterrupt = xInterrupt;
+
+        configASSERT( pxInterrupt );
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
+        {
+            *pxStats = pxInterrupt->xStats;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vDeferredInterruptResetStats( DeferredInterruptHandle_t xInterrupt )
+    {
+        DeferredInterrupt_t * const pxInterrupt = xInterrupt;
+
+        configASSERT( pxInterrupt );
+
+        taskENTER_CRITICAL();
+        {
+            ( void ) memset( &( pxInterrupt->xStats ), 0x00, sizeof( DeferredInterruptStats_t ) );
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xDeferredInterruptGetServiceTask( DeferredInterruptHandle_t xInterrupt )
+    {
+        DeferredInterrupt_t * const pxInterrupt = xInterrupt;
+
+        configASSERT( pxInterrupt );
+
+        return pxInterrupt->pxService->xTask;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include deferred interrupts.  This #if is closed at the very bottom of this
+ * file. */
+#endif /* configUSE_DEFERRED_INTERRUPTS == 1 */
@@ -0,0 +1,549 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "buffer_pool.h"
+#include "elastic_queue.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include elastic queues.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_ELASTIC_QUEUES == 1 )
+
+    #if ( configUSE_BUFFER_POOLS != 1 )
+        #error configUSE_BUFFER_POOLS must be set to 1 to use elastic queues.
+    #endif
+
+/* The segments form a chain, linked through the buffers' pxNext members, from
+ * the first segment, which items are received from, to the last, which items
+ * are sent to.  An empty queue holds no segments.  xItems never counts more
+ * than the number of items in the segments, and xSpaces never counts more
+ * than the number of places left below the maximum length, so a task or
+ * interrupt that takes xItems is guaranteed an item to receive, and one that
+ * takes xSpaces is guaranteed a place for its item once it has a segment. */
+    typedef struct ElasticQueueDefinition
+    {
+        SemaphoreHandle_t xItems;       /*< Counts the items that can be received, and holds the tasks waiting to receive. */
+        SemaphoreHandle_t xSpaces;      /*< Counts the items that can be sent before the queue is full, and holds the tasks waiting to send. */
+        BufferPoolHandle_t xPool;       /*< The pool segments are taken from. */
+        PoolBuffer_t * pxFirstSegment;  /*< The segment the next item is received from, or NULL. */
+        PoolBuffer_t * pxLastSegment;   /*< The segment the next item is sent to, or NULL. */
+        UBaseType_t uxReadIndex;        /*< The index of the next item to receive in the first segment. */
+        UBaseType_t uxWriteIndex;       /*< The index of the next place to send to in the last segment. */
+        UBaseType_t uxItemSize;         /*< The size of each item in bytes. */
+        UBaseType_t uxItemsPerSegment;  /*< The number of items each segment holds. */
+        UBaseType_t uxSegments;         /*< The number of segments in the chain. */
+    } ElasticQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Copies an item to the last segment.  If the last segment is full, or there
+ * are no segments, *ppxSpare is appended to the chain first and set to NULL.
+ * Returns pdFALSE, without copying the item, if a segment is needed and
+ * ppxSpare is NULL.  Must be called from a critical section.
+ */
+    static BaseType_t prvElasticWriteItem( ElasticQueue_t * pxQueue,
+                                    const void * pvItemToQueue,
+                                    PoolBuffer_t ** ppxSpare ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the first item out of the first segment.  Returns the first segment,
+ * unlinked from the chain, if it no longer holds any items, so the caller can
+ * release it once it has left the critical section, otherwise returns NULL.
+ * Must be called from a critical section.
+ */
+    static PoolBuffer_t * prvElasticReadItem( ElasticQueue_t * pxQueue,
+                                       void * pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    ElasticQueueHandle_t xElasticQueueCreate( UBaseType_t uxMaxLength,
+                                              UBaseType_t uxItemSize,
+                                              BufferPoolHandle_t xSegmentPool )
+    {
+        ElasticQueue_t * pxQueue = NULL;
+        UBaseType_t uxItemsPerSegment = 0U;
+
+        configASSERT( uxMaxLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+        configASSERT( xSegmentPool );
+
+        if( uxItemSize > ( UBaseType_t ) 0 )
+        {
+            uxItemsPerSegment = ( UBaseType_t ) ( xBufferPoolGetBufferSize( xSegmentPool ) / ( size_t ) uxItemSize );
+        }
+
+        /* A buffer in the pool must hold at least one item. */
+        configASSERT( uxItemsPerSegment > ( UBaseType_t ) 0 );
+
+        if( ( uxMaxLength > ( UBaseType_t ) 0 ) && ( uxItemsPerSegment > ( UBaseType_t ) 0 ) )
+        {
+            pxQueue = ( ElasticQueue_t * ) pvPortMalloc( sizeof( ElasticQueue_t ) ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxQueue != NULL )
+        {
+            pxQueue->xItems = xSemaphoreCreateCounting( uxMaxLength, 0U );
+            pxQueue->xSpaces = xSemaphoreCreateCounting( uxMaxLength, uxMaxLength );
+
+            if( ( pxQueue->xItems != NULL ) && ( pxQueue->xSpaces != NULL ) )
+            {
+                pxQueue->xPool = xSegmentPool;
+                pxQueue->pxFirstSegment = NULL;
+                pxQueue->pxLastSegment = NULL;
+                pxQueue->uxReadIndex = 0U;
+                pxQueue->uxWriteIndex = 0U;
+                pxQueue->uxItemSize = uxItemSize;
+                pxQueue->uxItemsPerSegment = uxItemsPerSegment;
+                pxQueue->uxSegments = 0U;
+
+                traceELASTIC_QUEUE_CREATE( pxQueue );
+            }
+            else
+            {
+                if( pxQueue->xItems != NULL )
+                {
+                    vSemaphoreDelete( pxQueue->xItems );
+                }
+
+                if( pxQueue->xSpaces != NULL )
+                {
+                    vSemaphoreDelete( pxQueue->xSpaces );
+                }
+
+                vPortFree( pxQueue );
+                pxQueue = NULL;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxQueue;
+    }
+/*-----------------------------------------------------------*/
+
+    void vElasticQueueDelete( ElasticQueueHandle_t xQueue )
+    {
+        ElasticQueue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        /* Releasing the first segment releases the rest of the chain. */
+        if( pxQueue->pxFirstSegment != NULL )
+        {
+            vPoolBufferRelease( pxQueue->pxFirstSegment );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        vSemaphoreDelete( pxQueue->xItems );
+        vSemaphoreDelete( pxQueue->xSpaces );
+        vPortFree( pxQueue );
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvElasticWriteItem( ElasticQueue_t * pxQueue,
+                                    const void * pvItemToQueue,
+                                    PoolBuffer_t ** ppxSpare )
+    {
+        BaseType_t xReturn = pdTRUE;
+        PoolBuffer_t * pxSegment;
+
+        if( ( pxQueue->pxLastSegment == NULL ) || ( pxQueue->uxWriteIndex == pxQueue->uxItemsPerSegment ) )
+        {
+            if( ( ppxSpare != NULL ) && ( *ppxSpare != NULL ) )
+            {
+                pxSegment = *ppxSpare;
+                *ppxSpare = NULL;
+
+                if( pxQueue->pxLastSegment == NULL )
+                {
+                    pxQueue->pxFirstSegment = pxSegment;
+                    pxQueue->uxReadIndex = 0U;
+                }
+                else
+                {
+                    /* The caller's reference to the segment becomes the
+                     * chain's reference. */
+                    pxQueue->pxLastSegment->pxNext = pxSegment;
+                }
+
+                pxQueue->pxLastSegment = pxSegment;
+                pxQueue->uxWriteIndex = 0U;
+                pxQueue->uxSegments++;
+
+                traceELASTIC_QUEUE_GROW( pxQueue, pxSegment );
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xReturn != pdFALSE )
+        {
+            ( void ) memcpy( pxQueue->pxLastSegment->pucData + ( pxQueue->uxWriteIndex * pxQueue->uxItemSize ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+            pxQueue->uxWriteIndex++;
+            pxQueue->pxLastSegment->xLength += ( size_t ) pxQueue->uxItemSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static PoolBuffer_t * prvElasticReadItem( ElasticQueue_t * pxQueue,
+                                       void * pvBuffer )
+    {
+        PoolBuffer_t * const pxSegment = pxQueue->pxFirstSegment;
+        PoolBuffer_t * pxFreeSegment = NULL;
+
+        configASSERT( pxSegment );
+
+        ( void ) memcpy( pvBuffer, pxSegment->pucData + ( pxQueue->uxReadIndex * pxQueue->uxItemSize ), ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        pxQueue->uxReadIndex++;
+
+        if( pxSegment == pxQueue->pxLastSegment )
+        {
+            /* Once the only segment has been emptied the queue holds no
+             * segments at all. */
+            if( pxQueue->uxReadIndex == pxQueue->uxWriteIndex )
+            {
+                pxQueue->pxFirstSegment = NULL;
+                pxQueue->pxLastSegment = NULL;
+                pxQueue->uxReadIndex = 0U;
+                pxQueue->uxWriteIndex = 0U;
+                pxFreeSegment = pxSegment;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( pxQueue->uxReadIndex == pxQueue->uxItemsPerSegment )
+        {
+            /* The chain's reference to the next segment becomes the queue's
+             * reference. */
+            pxQueue->pxFirstSegment = pxSegment->pxNext;
+            pxSegment->pxNext = NULL;
+            pxQueue->uxReadIndex = 0U;
+            pxFreeSegment = pxSegment;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxFreeSegment != NULL )
+        {
+            pxQueue->uxSegments--;
+            traceELASTIC_QUEUE_SHRINK( pxQueue, pxFreeSegment );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxFreeSegment;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xElasticQueueSend( ElasticQueueHandle_t xQueue,
+                                  const void * pvItemToQueue,
+                                  TickType_t xTicksToWait )
+    {
+        ElasticQueue_t * const pxQueue = xQueue;
+        PoolBuffer_t * pxSpare = NULL;
+        TimeOut_t xTimeOut;
+        BaseType_t xWritten;
+
+        configASSERT( pxQueue );
+        configASSERT( pvItemToQueue );
+
+        vTaskSetTimeOutState( &xTimeOut );
+
+        /* Reserve a place in the queue first, so a segment is never taken
+         * from the pool for an item that cannot be sent. */
+        if( xSemaphoreTake( pxQueue->xSpaces, xTicksToWait ) != pdPASS )
+        {
+            traceELASTIC_QUEUE_SEND_FAILED( pxQueue );
+            return errQUEUE_FULL;
+        }
+
+        taskENTER_CRITICAL();
+        {
+            xWritten = prvElasticWriteItem( pxQueue, pvItemToQueue, NULL );
+        }
+        taskEXIT_CRITICAL();
+
+        if( xWritten == pdFALSE )
+        {
+            /* A segment is needed.  The pool is not accessed from the critical
+             * section, as the allocation can block.  Whatever is left of the
+             * block time is spent waiting for a segment. */
+            ( void ) xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait );
+            pxSpare = pxBufferPoolAllocate( pxQueue->xPool, xTicksToWait );
+
+            if( pxSpare == NULL )
+            {
+                ( void ) xSemaphoreGive( pxQueue->xSpaces );
+                traceELASTIC_QUEUE_SEND_FAILED( pxQueue );
+                return errQUEUE_FULL;
+            }
+
+            taskENTER_CRITICAL();
+            {
+                ( void ) prvElasticWriteItem( pxQueue, pvItemToQueue, &pxSpare );
+            }
+            taskEXIT_CRITICAL();
+
+            /* Another task may have added a segment with room for the item
+             * while this task was allocating, in which case the spare segment
+             * was not used. */
+            if( pxSpare != NULL )
+            {
+                vPoolBufferRelease( pxSpare );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceELASTIC_QUEUE_SEND( pxQueue );
+
+        /* The item is in the queue before it is counted, so a task unblocked
+         * by the give finds it there. */
+        ( void ) xSemaphoreGive( pxQueue->xItems );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xElasticQueueSendFromISR( ElasticQueueHandle_t xQueue,
+                                         const void * pvItemToQueue,
+                                         BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        ElasticQueue_t * const pxQueue = xQueue;
+        PoolBuffer_t * pxSpare = NULL;
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xWritten;
+
+        configASSERT( pxQueue );
+        configASSERT( pvItemToQueue );
+
+        /* Taking xSpaces never unblocks a task, as no task ever waits to give
+         * it. */
+        if( xSemaphoreTakeFromISR( pxQueue->xSpaces, NULL ) != pdPASS )
+        {
+            traceELASTIC_QUEUE_SEND_FAILED( pxQueue );
+            return errQUEUE_FULL;
+        }
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            xWritten = prvElasticWriteItem( pxQueue, pvItemToQueue, NULL );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xWritten == pdFALSE )
+        {
+            pxSpare = pxBufferPoolAllocateFromISR( pxQueue->xPool );
+
+            if( pxSpare == NULL )
+            {
+                ( void ) xSemaphoreGiveFromISR( pxQueue->xSpaces, pxHigherPriorityTaskWoken );
+                traceELASTIC_QUEUE_SEND_FAILED( pxQueue );
+                return errQUEUE_FULL;
+            }
+
+            uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+            {
+                ( void ) prvElasticWriteItem( pxQueue, pvItemToQueue, &pxSpare );
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            if( pxSpare != NULL )
+            {
+                vPoolBufferReleaseFromISR( pxSpare, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceELASTIC_QUEUE_SEND( pxQueue );
+
+        ( void ) xSemaphoreGiveFromISR( pxQueue->xItems, pxHigherPriorityTaskWoken );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xElasticQueueReceive( ElasticQueueHandle_t xQueue,
+                                     void * pvBuffer,
+                                     TickType_t xTicksToWait )
+    {
+        ElasticQueue_t * const pxQueue = xQueue;
+        PoolBuffer_t * pxFreeSegment;
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+
+        if( xSemaphoreTake( pxQueue->xItems, xTicksToWait ) != pdPASS )
+        {
+            traceELASTIC_QUEUE_RECEIVE_FAILED( pxQueue );
+            return errQUEUE_EMPTY;
+        }
+
+        taskENTER_CRITICAL();
+        {
+            pxFreeSegment = prvElasticReadItem( pxQueue, pvBuffer );
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxFreeSegment != NULL )
+        {
+            vPoolBufferRelease( pxFreeSegment );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceELASTIC_QUEUE_RECEIVE( pxQueue );
+
+        ( void ) xSemaphoreGive( pxQueue->xSpaces );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xElasticQueueReceiveFromISR( ElasticQueueHandle_t xQueue,
+                                            void * pvBuffer,
+                                            BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        ElasticQueue_t * const pxQueue = xQueue;
+        PoolBuffer_t * pxFreeSegment;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxQueue );
+        configASSERT( pvBuffer );
+
+        /* Taking xItems never unblocks a task, as no task ever waits to give
+         * it. */
+        if( xSemaphoreTakeFromISR( pxQueue->xItems, NULL ) != pdPASS )
+        {
+            traceELASTIC_QUEUE_RECEIVE_FAILED( pxQueue );
+            return errQUEUE_EMPTY;
+        }
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            pxFreeSegment = prvElasticReadItem( pxQueue, pvBuffer );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( pxFreeSegment != NULL )
+        {
+            vPoolBufferReleaseFromISR( pxFreeSegment, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceELASTIC_QUEUE_RECEIVE( pxQueue );
+
+        ( void ) xSemaphoreGiveFromISR( pxQueue->xSpaces, pxHigherPriorityTaskWoken );
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxElasticQueueMessagesWaiting( ElasticQueueHandle_t xQueue )
+    {
+        configASSERT( xQueue );
+
+        return uxSemaphoreGetCount( xQueue->xItems );
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxElasticQueueGetSegmentCount( ElasticQueueHandle_t xQueue )
+    {
+        configASSERT( xQueue );
+
+        return xQueue->uxSegments;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include elastic queues.  This #if is closed at the very bottom of this
+ * file. */
+#endif /* configUSE_ELASTIC_QUEUES == 1 */
@@ -40,6 +40,10 @@
 #include "timers.h"
 #include "event_groups.h"
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+    #include "object_registry.h"
+#endif
+
 /* Lint e961, e750 and e9021 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -49,7 +53,12 @@
 /* The following bit fields convey control information in a task's event list
  * item value.  It is important they don't clash with the
  * taskEVENT_LIST_ITEM_VALUE_IN_USE definition. */
-#if ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS )
+#if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+    #define eventCLEAR_EVENTS_ON_EXIT_BIT    0x0100000000000000ULL
+    #define eventUNBLOCKED_DUE_TO_BIT_SET    0x0200000000000000ULL
+    #define eventWAIT_FOR_ALL_BITS           0x0400000000000000ULL
+    #define eventEVENT_BITS_CONTROL_BYTES    0xff00000000000000ULL
+#elif ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS )
     #define eventCLEAR_EVENTS_ON_EXIT_BIT    0x0100U
     #define eventUNBLOCKED_DUE_TO_BIT_SET    0x0200U
     #define eventWAIT_FOR_ALL_BITS           0x0400U
@@ -64,13 +73,77 @@
     #define eventUNBLOCKED_DUE_TO_BIT_SET    0x0200000000000000ULL
     #define eventWAIT_FOR_ALL_BITS           0x0400000000000000ULL
     #define eventEVENT_BITS_CONTROL_BYTES    0xff00000000000000ULL
-#endif /* if ( configTICK_TYPE_WIDTH_IN_BITS == TICK_TYPE_WIDTH_16_BITS ) */
+#endif /* if ( configUSE_64_BIT_EVENT_GROUPS == 1 ) */
+
+/* 64-bit event bits do not fit in the TickType_t event list item value of a
+ * task that is narrower than 64 bits, so the value that would be stored in the
+ * event list item is stored in the TCB instead, and the event list item value
+ * itself is left zero. */
+#if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+    #define eventGET_WAITING_TASK_VALUE( pxListItem )            ullTaskGetEventItemBits( ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxListItem ) )
+    #define eventSET_WAITING_TASK_VALUE( pxListItem, uxValue )    vTaskSetEventItemBits( ( TaskHandle_t ) listGET_LIST_ITEM_OWNER( pxListItem ), ( uxValue ) )
+    #define eventSET_CALLING_TASK_VALUE( uxValue )                vTaskSetEventItemBits( NULL, ( uxValue ) )
+    #define eventRESET_CALLING_TASK_VALUE()                       ullTaskResetEventItemBits()
+    #define eventLIST_ITEM_VALUE( uxValue )                       ( ( TickType_t ) 0 )
+#else
+    #define eventGET_WAITING_TASK_VALUE( pxListItem )            listGET_LIST_ITEM_VALUE( pxListItem )
+    #define eventSET_WAITING_TASK_VALUE( pxListItem, uxValue )
+    #define eventSET_CALLING_TASK_VALUE( uxValue )
+    #define eventRESET_CALLING_TASK_VALUE()                       uxTaskResetEventItemValue()
+    #define eventLIST_ITEM_VALUE( uxValue )                       ( uxValue )
+#endif
+
+/* The number of bits in an event group that are available to the application,
+ * which is also the number of per bit wait lists. */
+#define eventNUM_EVENT_BITS    ( ( sizeof( EventBits_t ) * 8U ) - 8U )
+
+/* When bits can be set directly from interrupts, tasks still use the lists of
+ * waiting tasks with the scheduler suspended, but mark the event group as in
+ * use while they do so.  An interrupt that finds the event group in use only
+ * sets the bits, and leaves unblocking the tasks to the timer task.  The
+ * critical sections are only held long enough to update the flag or the event
+ * bits, so an interrupt setting bits at the same time is not lost. */
+#if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+    #define eventENTER_CRITICAL()    taskENTER_CRITICAL()
+    #define eventEXIT_CRITICAL()     taskEXIT_CRITICAL()
+    #define eventBEGIN_TASK_ACCESS( pxEventBits )                       \
+    do {                                                                \
+        taskENTER_CRITICAL();                                           \
+        ( pxEventBits )->xTaskAccessInProgress = pdTRUE;                \
+        taskEXIT_CRITICAL();                                            \
+    } while( 0 )
+    #define eventEND_TASK_ACCESS( pxEventBits )                         \
+    do {                                                                \
+        taskENTER_CRITICAL();                                           \
+        ( pxEventBits )->xTaskAccessInProgress = pdFALSE;               \
+        taskEXIT_CRITICAL();                                            \
+    } while( 0 )
+#else
+    #define eventENTER_CRITICAL()
+    #define eventEXIT_CRITICAL()
+    #define eventBEGIN_TASK_ACCESS( pxEventBits )
+    #define eventEND_TASK_ACCESS( pxEventBits )
+#endif
 
 typedef struct EventGroupDef_t
 {
     EventBits_t uxEventBits;
     List_t xTasksWaitingForBits; /*< List of tasks waiting for a bit to be set. */
 
+    #if ( configUSE_EVENT_GROUP_WAIT_INDEX == 1 )
+        List_t xTasksWaitingForBit[ eventNUM_EVENT_BITS ]; /*< Tasks that can only be unblocked when a particular bit is set, each in the list of that bit.  Other tasks are in xTasksWaitingForBits. */
+    #endif
+
+    #if ( configUSE_EVENT_GROUP_BARRIERS == 1 )
+        List_t xTasksWaitingAtBarrier;   /*< List of tasks blocked in xEventGroupBarrierWait(). */
+        UBaseType_t uxBarrierArrivals;   /*< The number of tasks that have arrived at the barrier in the current generation. */
+        UBaseType_t uxBarrierGeneration; /*< Incremented each time the barrier is passed, so a task that timed out can tell if the barrier was passed before it could withdraw. */
+    #endif
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+        volatile BaseType_t xTaskAccessInProgress; /*< pdTRUE while a task is using the lists of waiting tasks, so interrupts must not. */
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxEventGroupNumber;
     #endif
@@ -78,6 +151,10 @@ typedef struct EventGroupDef_t
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the event group is statically allocated to ensure no attempt is made to free the memory. */
     #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        ObjectRegistryItem_t xRegistryItem; /*< Links the event group into the object registry. */
+    #endif
 } EventGroup_t;
 
 /*-----------------------------------------------------------*/
@@ -94,6 +171,58 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
                                         const EventBits_t uxBitsToWaitFor,
                                         const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the list, or lists, of tasks waiting for bits in pxEventBits, the
+ * barrier if barriers are used, and the flag that marks the lists as in use
+ * if bits can be set directly from interrupts.
+ */
+static void prvInitialiseWaitLists( EventGroup_t * pxEventBits ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock every task in pxList whose wait condition is met by the current
+ * value of the event bits.  Returns the bits that must be cleared because an
+ * unblocked task asked for its bits to be cleared on exit.
+ * pxHigherPriorityTaskWoken is NULL when called from a task with the scheduler
+ * suspended, and non-NULL when called from an interrupt.
+ */
+static EventBits_t prvUnblockMatchingTasks( EventGroup_t * pxEventBits,
+                                            const List_t * pxList,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Call prvUnblockMatchingTasks() for each list of waiting tasks that could
+ * contain a task whose wait condition is met by the current event bits.
+ * Returns the bits the unblocked tasks asked to be cleared on exit.
+ */
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t * pxEventBits,
+                                           BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Set uxBitsToSet, unblock the tasks whose wait condition is now met, and
+ * finally clear any bits the unblocked tasks asked to be cleared on exit.
+ * Called from a task with the scheduler suspended.
+ */
+static void prvSetBitsAndUnblockTasks( EventGroup_t * pxEventBits,
+                                       const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_EVENT_GROUP_WAIT_INDEX == 1 )
+
+/*
+ * Returns the list a task waiting for uxBitsToWaitFor should be placed in.  A
+ * task can only be unblocked when the lowest bit it waits for is set if it
+ * waits for a single bit, or for all of its bits, so it is placed in the list
+ * of that bit.  A task waiting for any one of several bits could be unblocked
+ * by any of them, so it is placed in xTasksWaitingForBits.
+ */
+    static List_t * prvGetWaitList( EventGroup_t * pxEventBits,
+                                    const EventBits_t uxBitsToWaitFor,
+                                    const BaseType_t xWaitForAllBits ) PRIVILEGED_FUNCTION;
+
+    #define eventGET_WAIT_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits )    prvGetWaitList( ( pxEventBits ), ( uxBitsToWaitFor ), ( xWaitForAllBits ) )
+#else
+    #define eventGET_WAIT_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits )    ( &( ( pxEventBits )->xTasksWaitingForBits ) )
+#endif /* configUSE_EVENT_GROUP_WAIT_INDEX */
+
 /*-----------------------------------------------------------*/
 
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -121,7 +250,7 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaitLists( pxEventBits );
 
             #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
@@ -132,6 +261,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             }
             #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 
+            #if ( configUSE_OBJECT_REGISTRY == 1 )
+            {
+                vObjectRegistryAdd( &( pxEventBits->xRegistryItem ), pxEventBits, eObjectEventGroup, NULL );
+            }
+            #endif
+
             traceEVENT_GROUP_CREATE( pxEventBits );
         }
         else
@@ -167,12 +302,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
          * sizeof( TickType_t ), the TickType_t variables will be accessed in two
          * or more reads operations, and the alignment requirements is only that
          * of each individual read. */
-        pxEventBits = ( EventGroup_t * ) pvPortMalloc( sizeof( EventGroup_t ) ); /*lint !e9087 !e9079 see comment above. */
+        pxEventBits = ( EventGroup_t * ) pvPortMallocObject( portOBJECT_POOL_EVENT_GROUP, sizeof( EventGroup_t ) ); /*lint !e9087 !e9079 see comment above. */
 
         if( pxEventBits != NULL )
         {
             pxEventBits->uxEventBits = 0;
-            vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+            prvInitialiseWaitLists( pxEventBits );
 
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
@@ -183,6 +318,12 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
             }
             #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+            #if ( configUSE_OBJECT_REGISTRY == 1 )
+            {
+                vObjectRegistryAdd( &( pxEventBits->xRegistryItem ), pxEventBits, eObjectEventGroup, NULL );
+            }
+            #endif
+
             traceEVENT_GROUP_CREATE( pxEventBits );
         }
         else
@@ -216,46 +357,56 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
 
     vTaskSuspendAll();
     {
-        uxOriginalBitValue = pxEventBits->uxEventBits;
-
-        ( void ) xEventGroupSetBits( xEventGroup, uxBitsToSet );
-
-        if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
+        eventBEGIN_TASK_ACCESS( pxEventBits );
         {
-            /* All the rendezvous bits are now set - no need to block. */
-            uxReturn = ( uxOriginalBitValue | uxBitsToSet );
+            uxOriginalBitValue = pxEventBits->uxEventBits;
 
-            /* Rendezvous always clear the bits.  They will have been cleared
-             * already unless this is the only task in the rendezvous. */
-            pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+            traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
+            prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet );
 
-            xTicksToWait = 0;
-        }
-        else
-        {
-            if( xTicksToWait != ( TickType_t ) 0 )
+            if( ( ( uxOriginalBitValue | uxBitsToSet ) & uxBitsToWaitFor ) == uxBitsToWaitFor )
             {
-                traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor );
+                /* All the rendezvous bits are now set - no need to block. */
+                uxReturn = ( uxOriginalBitValue | uxBitsToSet );
 
-                /* Store the bits that the calling task is waiting for in the
-                 * task's event list item so the kernel knows when a match is
-                 * found.  Then enter the blocked state. */
-                vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+                /* Rendezvous always clear the bits.  They will have been cleared
+                 * already unless this is the only task in the rendezvous. */
+                eventENTER_CRITICAL();
+                {
+                    pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+                }
+                eventEXIT_CRITICAL();
 
-                /* This assignment is obsolete as uxReturn will get set after
-                 * the task unblocks, but some compilers mistakenly generate a
-                 * warning about uxReturn being returned without being set if the
-                 * assignment is omitted. */
-                uxReturn = 0;
+                xTicksToWait = 0;
             }
             else
             {
-                /* The rendezvous bits were not set, but no block time was
-                 * specified - just return the current event bit value. */
-                uxReturn = pxEventBits->uxEventBits;
-                xTimeoutOccurred = pdTRUE;
+                if( xTicksToWait != ( TickType_t ) 0 )
+                {
+                    traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor );
+
+                    /* Store the bits that the calling task is waiting for in the
+                     * task's event list item so the kernel knows when a match is
+                     * found.  Then enter the blocked state. */
+                    eventSET_CALLING_TASK_VALUE( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS );
+                    vTaskPlaceOnUnorderedEventList( eventGET_WAIT_LIST( pxEventBits, uxBitsToWaitFor, pdTRUE ), eventLIST_ITEM_VALUE( uxBitsToWaitFor | eventCLEAR_EVENTS_ON_EXIT_BIT | eventWAIT_FOR_ALL_BITS ), xTicksToWait );
+
+                    /* This assignment is obsolete as uxReturn will get set after
+                     * the task unblocks, but some compilers mistakenly generate a
+                     * warning about uxReturn being returned without being set if the
+                     * assignment is omitted. */
+                    uxReturn = 0;
+                }
+                else
+                {
+                    /* The rendezvous bits were not set, but no block time was
+                     * specified - just return the current event bit value. */
+                    uxReturn = pxEventBits->uxEventBits;
+                    xTimeoutOccurred = pdTRUE;
+                }
             }
         }
+        eventEND_TASK_ACCESS( pxEventBits );
     }
     xAlreadyYielded = xTaskResumeAll();
 
@@ -274,7 +425,7 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
          * point either the required bits were set or the block time expired.  If
          * the required bits were set they will have been stored in the task's
          * event list item, and they should now be retrieved then cleared. */
-        uxReturn = uxTaskResetEventItemValue();
+        uxReturn = eventRESET_CALLING_TASK_VALUE();
 
         if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
         {
@@ -319,6 +470,112 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_EVENT_GROUP_BARRIERS == 1 )
+
+    BaseType_t xEventGroupBarrierWait( EventGroupHandle_t xEventGroup,
+                                       const UBaseType_t uxParticipants,
+                                       TickType_t xTicksToWait )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        List_t const * const pxTasksWaitingAtBarrier = &( pxEventBits->xTasksWaitingAtBarrier );
+        UBaseType_t uxGeneration;
+        BaseType_t xReturn = pdPASS, xAlreadyYielded;
+
+        configASSERT( xEventGroup );
+        configASSERT( uxParticipants != ( UBaseType_t ) 0 );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        vTaskSuspendAll();
+        {
+            eventBEGIN_TASK_ACCESS( pxEventBits );
+            {
+                uxGeneration = pxEventBits->uxBarrierGeneration;
+                ( pxEventBits->uxBarrierArrivals )++;
+
+                if( pxEventBits->uxBarrierArrivals >= uxParticipants )
+                {
+                    /* This is the last task to arrive.  Start the next
+                     * generation of the barrier, then release every task that is
+                     * waiting at it in one pass over the list. */
+                    pxEventBits->uxBarrierArrivals = ( UBaseType_t ) 0;
+                    ( pxEventBits->uxBarrierGeneration )++;
+
+                    while( listLIST_IS_EMPTY( pxTasksWaitingAtBarrier ) == pdFALSE )
+                    {
+                        eventSET_WAITING_TASK_VALUE( listGET_HEAD_ENTRY( pxTasksWaitingAtBarrier ), eventUNBLOCKED_DUE_TO_BIT_SET );
+                        vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxTasksWaitingAtBarrier ), eventLIST_ITEM_VALUE( eventUNBLOCKED_DUE_TO_BIT_SET ) );
+                    }
+
+                    xTicksToWait = ( TickType_t ) 0;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The other tasks have not all arrived and no block time
+                     * was specified, so withdraw from the barrier again. */
+                    ( pxEventBits->uxBarrierArrivals )--;
+                    xReturn = pdFAIL;
+                }
+                else
+                {
+                    /* Wait for the last task to arrive.  The value is cleared
+                     * so it only holds eventUNBLOCKED_DUE_TO_BIT_SET if the task
+                     * is released by another task. */
+                    eventSET_CALLING_TASK_VALUE( ( EventBits_t ) 0 );
+                    vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingAtBarrier ), eventLIST_ITEM_VALUE( ( EventBits_t ) 0 ), xTicksToWait );
+                }
+            }
+            eventEND_TASK_ACCESS( pxEventBits );
+        }
+        xAlreadyYielded = xTaskResumeAll();
+
+        if( xTicksToWait != ( TickType_t ) 0 )
+        {
+            if( xAlreadyYielded == pdFALSE )
+            {
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( eventRESET_CALLING_TASK_VALUE() & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
+            {
+                /* The task timed out.  It still counts as having arrived unless
+                 * it withdraws, which it can only do if the barrier has not
+                 * been passed since it arrived. */
+                taskENTER_CRITICAL();
+                {
+                    if( pxEventBits->uxBarrierGeneration == uxGeneration )
+                    {
+                        ( pxEventBits->uxBarrierArrivals )--;
+                        xReturn = pdFAIL;
+                    }
+                    else
+                    {
+                        /* The last task arrived after this task timed out but
+                         * before it could withdraw. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                /* The task was released by the last task to arrive. */
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_BARRIERS */
+/*-----------------------------------------------------------*/
+
 EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
                                  const EventBits_t uxBitsToWaitFor,
                                  const BaseType_t xClearOnExit,
@@ -343,71 +600,80 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
 
     vTaskSuspendAll();
     {
-        const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
-
-        /* Check to see if the wait condition is already met or not. */
-        xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
-
-        if( xWaitConditionMet != pdFALSE )
+        eventBEGIN_TASK_ACCESS( pxEventBits );
         {
-            /* The wait condition has already been met so there is no need to
-             * block. */
-            uxReturn = uxCurrentEventBits;
-            xTicksToWait = ( TickType_t ) 0;
+            const EventBits_t uxCurrentEventBits = pxEventBits->uxEventBits;
 
-            /* Clear the wait bits if requested to do so. */
-            if( xClearOnExit != pdFALSE )
-            {
-                pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
-            }
-            else
+            /* Check to see if the wait condition is already met or not. */
+            xWaitConditionMet = prvTestWaitCondition( uxCurrentEventBits, uxBitsToWaitFor, xWaitForAllBits );
+
+            if( xWaitConditionMet != pdFALSE )
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The wait condition has already been met so there is no need to
+                 * block. */
+                uxReturn = uxCurrentEventBits;
+                xTicksToWait = ( TickType_t ) 0;
+
+                /* Clear the wait bits if requested to do so. */
+                if( xClearOnExit != pdFALSE )
+                {
+                    eventENTER_CRITICAL();
+                    {
+                        pxEventBits->uxEventBits &= ~uxBitsToWaitFor;
+                    }
+                    eventEXIT_CRITICAL();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-        }
-        else if( xTicksToWait == ( TickType_t ) 0 )
-        {
-            /* The wait condition has not been met, but no block time was
-             * specified, so just return the current value. */
-            uxReturn = uxCurrentEventBits;
-            xTimeoutOccurred = pdTRUE;
-        }
-        else
-        {
-            /* The task is going to block to wait for its required bits to be
-             * set.  uxControlBits are used to remember the specified behaviour of
-             * this call to xEventGroupWaitBits() - for use when the event bits
-             * unblock the task. */
-            if( xClearOnExit != pdFALSE )
+            else if( xTicksToWait == ( TickType_t ) 0 )
             {
-                uxControlBits |= eventCLEAR_EVENTS_ON_EXIT_BIT;
+                /* The wait condition has not been met, but no block time was
+                 * specified, so just return the current value. */
+                uxReturn = uxCurrentEventBits;
+                xTimeoutOccurred = pdTRUE;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
-            }
+                /* The task is going to block to wait for its required bits to be
+                 * set.  uxControlBits are used to remember the specified behaviour of
+                 * this call to xEventGroupWaitBits() - for use when the event bits
+                 * unblock the task. */
+                if( xClearOnExit != pdFALSE )
+                {
+                    uxControlBits |= eventCLEAR_EVENTS_ON_EXIT_BIT;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-            if( xWaitForAllBits != pdFALSE )
-            {
-                uxControlBits |= eventWAIT_FOR_ALL_BITS;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+                if( xWaitForAllBits != pdFALSE )
+                {
+                    uxControlBits |= eventWAIT_FOR_ALL_BITS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-            /* Store the bits that the calling task is waiting for in the
-             * task's event list item so the kernel knows when a match is
-             * found.  Then enter the blocked state. */
-            vTaskPlaceOnUnorderedEventList( &( pxEventBits->xTasksWaitingForBits ), ( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
+                /* Store the bits that the calling task is waiting for in the
+                 * task's event list item so the kernel knows when a match is
+                 * found.  Then enter the blocked state. */
+                eventSET_CALLING_TASK_VALUE( uxBitsToWaitFor | uxControlBits );
+                vTaskPlaceOnUnorderedEventList( eventGET_WAIT_LIST( pxEventBits, uxBitsToWaitFor, xWaitForAllBits ), eventLIST_ITEM_VALUE( uxBitsToWaitFor | uxControlBits ), xTicksToWait );
 
-            /* This is obsolete as it will get set after the task unblocks, but
-             * some compilers mistakenly generate a warning about the variable
-             * being returned without being set if it is not done. */
-            uxReturn = 0;
+                /* This is obsolete as it will get set after the task unblocks, but
+                 * some compilers mistakenly generate a warning about the variable
+                 * being returned without being set if it is not done. */
+                uxReturn = 0;
 
-            traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
+                traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor );
+            }
         }
+        eventEND_TASK_ACCESS( pxEventBits );
     }
     xAlreadyYielded = xTaskResumeAll();
 
@@ -426,7 +692,7 @@ EventBits_t xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
          * point either the required bits were set or the block time expired.  If
          * the required bits were set they will have been stored in the task's
          * event list item, and they should now be retrieved then cleared. */
-        uxReturn = uxTaskResetEventItemValue();
+        uxReturn = eventRESET_CALLING_TASK_VALUE();
 
         if( ( uxReturn & eventUNBLOCKED_DUE_TO_BIT_SET ) == ( EventBits_t ) 0 )
         {
@@ -510,6 +776,13 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
     {
         BaseType_t xReturn;
 
+        #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+        {
+            /* Only 32 bits can be passed to the timer task. */
+            configASSERT( ( uxBitsToClear >> 32 ) == ( EventBits_t ) 0 );
+        }
+        #endif
+
         traceEVENT_GROUP_CLEAR_BITS_FROM_ISR( xEventGroup, uxBitsToClear );
         xReturn = xTimerPendFunctionCallFromISR( vEventGroupClearBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToClear, NULL ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
 
@@ -525,11 +798,11 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
     EventGroup_t const * const pxEventBits = xEventGroup;
     EventBits_t uxReturn;
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
     {
         uxReturn = pxEventBits->uxEventBits;
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return uxReturn;
 } /*lint !e818 EventGroupHandle_t is a typedef used in other functions to so can't be pointer to const. */
@@ -538,96 +811,193 @@ EventBits_t xEventGroupGetBitsFromISR( EventGroupHandle_t xEventGroup )
 EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
                                 const EventBits_t uxBitsToSet )
 {
-    ListItem_t * pxListItem;
-    ListItem_t * pxNext;
-    ListItem_t const * pxListEnd;
-    List_t const * pxList;
-    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
     EventGroup_t * pxEventBits = xEventGroup;
-    BaseType_t xMatchFound = pdFALSE;
+
+    traceBENCHMARK_API_ENTER( benchmarkAPI_EVENT_GROUP_SET_BITS );
 
     /* Check the user is not attempting to set the bits used by the kernel
      * itself. */
     configASSERT( xEventGroup );
     configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
 
-    pxList = &( pxEventBits->xTasksWaitingForBits );
-    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
     vTaskSuspendAll();
     {
         traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet );
 
-        pxListItem = listGET_HEAD_ENTRY( pxList );
+        eventBEGIN_TASK_ACCESS( pxEventBits );
+        {
+            prvSetBitsAndUnblockTasks( pxEventBits, uxBitsToSet );
+        }
+        eventEND_TASK_ACCESS( pxEventBits );
+    }
+    ( void ) xTaskResumeAll();
+
+    traceBENCHMARK_API_EXIT( benchmarkAPI_EVENT_GROUP_SET_BITS );
+    return pxEventBits->uxEventBits;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSetBitsAndUnblockTasks( EventGroup_t * pxEventBits,
+                                       const EventBits_t uxBitsToSet )
+{
+    EventBits_t uxBitsToClear;
 
-        /* Set the bits. */
+    /* Set the bits. */
+    eventENTER_CRITICAL();
+    {
         pxEventBits->uxEventBits |= uxBitsToSet;
+    }
+    eventEXIT_CRITICAL();
 
-        /* See if the new bit value should unblock any tasks. */
-        while( pxListItem != pxListEnd )
-        {
-            pxNext = listGET_NEXT( pxListItem );
-            uxBitsWaitedFor = listGET_LIST_ITEM_VALUE( pxListItem );
-            xMatchFound = pdFALSE;
+    /* See if the new bit value should unblock any tasks. */
+    uxBitsToClear = prvUnblockWaitingTasks( pxEventBits, NULL );
+
+    /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT bit
+     * was set in the control word. */
+    eventENTER_CRITICAL();
+    {
+        pxEventBits->uxEventBits &= ~uxBitsToClear;
+    }
+    eventEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+static EventBits_t prvUnblockWaitingTasks( EventGroup_t * pxEventBits,
+                                           BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    EventBits_t uxBitsToClear;
 
-            /* Split the bits waited for from the control bits. */
-            uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
-            uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+    uxBitsToClear = prvUnblockMatchingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBits ), pxHigherPriorityTaskWoken );
 
-            if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+    #if ( configUSE_EVENT_GROUP_WAIT_INDEX == 1 )
+    {
+        EventBits_t uxBitsToTest;
+        UBaseType_t uxBit;
+
+        /* A task in the list of a bit cannot be unblocked while that bit
+         * is clear, so only the lists of the bits that are set are
+         * visited. */
+        uxBitsToTest = pxEventBits->uxEventBits;
+
+        for( uxBit = 0; uxBitsToTest != ( EventBits_t ) 0; uxBit++ )
+        {
+            if( ( ( uxBitsToTest & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 ) &&
+                ( listLIST_IS_EMPTY( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) ) == pdFALSE ) )
             {
-                /* Just looking for single bit being set. */
-                if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
-                {
-                    xMatchFound = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                uxBitsToClear |= prvUnblockMatchingTasks( pxEventBits, &( pxEventBits->xTasksWaitingForBit[ uxBit ] ), pxHigherPriorityTaskWoken );
             }
-            else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            uxBitsToTest >>= 1;
+        }
+    }
+    #endif /* configUSE_EVENT_GROUP_WAIT_INDEX */
+
+    return uxBitsToClear;
+}
+/*-----------------------------------------------------------*/
+
+static EventBits_t prvUnblockMatchingTasks( EventGroup_t * pxEventBits,
+                                            const List_t * pxList,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    ListItem_t * pxListItem;
+    ListItem_t * pxNext;
+    ListItem_t const * pxListEnd;
+    EventBits_t uxBitsToClear = 0, uxBitsWaitedFor, uxControlBits;
+    BaseType_t xMatchFound;
+
+    pxListEnd = listGET_END_MARKER( pxList ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    pxListItem = listGET_HEAD_ENTRY( pxList );
+
+    while( pxListItem != pxListEnd )
+    {
+        pxNext = listGET_NEXT( pxListItem );
+        uxBitsWaitedFor = eventGET_WAITING_TASK_VALUE( pxListItem );
+        xMatchFound = pdFALSE;
+
+        /* Split the bits waited for from the control bits. */
+        uxControlBits = uxBitsWaitedFor & eventEVENT_BITS_CONTROL_BYTES;
+        uxBitsWaitedFor &= ~eventEVENT_BITS_CONTROL_BYTES;
+
+        if( ( uxControlBits & eventWAIT_FOR_ALL_BITS ) == ( EventBits_t ) 0 )
+        {
+            /* Just looking for single bit being set. */
+            if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) != ( EventBits_t ) 0 )
             {
-                /* All bits are set. */
                 xMatchFound = pdTRUE;
             }
             else
             {
-                /* Need all bits to be set, but not all the bits were set. */
+                mtCOVERAGE_TEST_MARKER();
             }
+        }
+        else if( ( uxBitsWaitedFor & pxEventBits->uxEventBits ) == uxBitsWaitedFor )
+        {
+            /* All bits are set. */
+            xMatchFound = pdTRUE;
+        }
+        else
+        {
+            /* Need all bits to be set, but not all the bits were set. */
+        }
 
-            if( xMatchFound != pdFALSE )
+        if( xMatchFound != pdFALSE )
+        {
+            /* The bits match.  Should the bits be cleared on exit? */
+            if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+            {
+                uxBitsToClear |= uxBitsWaitedFor;
+            }
+            else
             {
-                /* The bits match.  Should the bits be cleared on exit? */
-                if( ( uxControlBits & eventCLEAR_EVENTS_ON_EXIT_BIT ) != ( EventBits_t ) 0 )
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Store the actual event flag value in the task's event list
+             * item before removing the task from the event list.  The
+             * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
+             * that is was unblocked due to its required bits matching, rather
+             * than because it timed out. */
+            eventSET_WAITING_TASK_VALUE( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
+
+            #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+            {
+                if( pxHigherPriorityTaskWoken != NULL )
                 {
-                    uxBitsToClear |= uxBitsWaitedFor;
+                    if( xTaskRemoveFromUnorderedEventListFromISR( pxListItem, eventLIST_ITEM_VALUE( pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) ) != pdFALSE )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    vTaskRemoveFromUnorderedEventList( pxListItem, eventLIST_ITEM_VALUE( pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) );
                 }
-
-                /* Store the actual event flag value in the task's event list
-                 * item before removing the task from the event list.  The
-                 * eventUNBLOCKED_DUE_TO_BIT_SET bit is set so the task knows
-                 * that is was unblocked due to its required bits matching, rather
-                 * than because it timed out. */
-                vTaskRemoveFromUnorderedEventList( pxListItem, pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET );
             }
-
-            /* Move onto the next list item.  Note pxListItem->pxNext is not
-             * used here as the list item may have been removed from the event list
-             * and inserted into the ready/pending reading list. */
-            pxListItem = pxNext;
+            #else
+            {
+                /* Only called from tasks. */
+                ( void ) pxHigherPriorityTaskWoken;
+                vTaskRemoveFromUnorderedEventList( pxListItem, eventLIST_ITEM_VALUE( pxEventBits->uxEventBits | eventUNBLOCKED_DUE_TO_BIT_SET ) );
+            }
+            #endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
         }
 
-        /* Clear any bits that matched when the eventCLEAR_EVENTS_ON_EXIT_BIT
-         * bit was set in the control word. */
-        pxEventBits->uxEventBits &= ~uxBitsToClear;
+        /* Move onto the next list item.  Note pxListItem->pxNext is not
+         * used here as the list item may have been removed from the event list
+         * and inserted into the ready/pending reading list. */
+        pxListItem = pxNext;
     }
-    ( void ) xTaskResumeAll();
 
-    return pxEventBits->uxEventBits;
+    return uxBitsToClear;
 }
 /*-----------------------------------------------------------*/
 
@@ -642,23 +1012,65 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
 
     vTaskSuspendAll();
     {
-        traceEVENT_GROUP_DELETE( xEventGroup );
-
-        while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+        eventBEGIN_TASK_ACCESS( pxEventBits );
         {
-            /* Unblock the task, returning 0 as the event list is being deleted
-             * and cannot therefore have any bits set. */
-            configASSERT( pxTasksWaitingForBits->xListEnd.pxNext != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
-            vTaskRemoveFromUnorderedEventList( pxTasksWaitingForBits->xListEnd.pxNext, eventUNBLOCKED_DUE_TO_BIT_SET );
+            traceEVENT_GROUP_DELETE( xEventGroup );
+
+            while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+            {
+                /* Unblock the task, returning 0 as the event list is being deleted
+                 * and cannot therefore have any bits set. */
+                configASSERT( listGET_HEAD_ENTRY( pxTasksWaitingForBits ) != ( const ListItem_t * ) &( pxTasksWaitingForBits->xListEnd ) );
+                eventSET_WAITING_TASK_VALUE( listGET_HEAD_ENTRY( pxTasksWaitingForBits ), eventUNBLOCKED_DUE_TO_BIT_SET );
+                vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxTasksWaitingForBits ), eventLIST_ITEM_VALUE( eventUNBLOCKED_DUE_TO_BIT_SET ) );
+            }
+
+            #if ( configUSE_EVENT_GROUP_WAIT_INDEX == 1 )
+            {
+                UBaseType_t uxBit;
+
+                /* Also unblock the tasks waiting in the list of each bit. */
+                for( uxBit = 0; uxBit < ( UBaseType_t ) eventNUM_EVENT_BITS; uxBit++ )
+                {
+                    pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+
+                    while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                    {
+                        eventSET_WAITING_TASK_VALUE( listGET_HEAD_ENTRY( pxTasksWaitingForBits ), eventUNBLOCKED_DUE_TO_BIT_SET );
+                        vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxTasksWaitingForBits ), eventLIST_ITEM_VALUE( eventUNBLOCKED_DUE_TO_BIT_SET ) );
+                    }
+                }
+            }
+            #endif /* configUSE_EVENT_GROUP_WAIT_INDEX */
+
+            #if ( configUSE_EVENT_GROUP_BARRIERS == 1 )
+            {
+                /* Also release the tasks waiting at the barrier. */
+                pxTasksWaitingForBits = &( pxEventBits->xTasksWaitingAtBarrier );
+
+                while( listCURRENT_LIST_LENGTH( pxTasksWaitingForBits ) > ( UBaseType_t ) 0 )
+                {
+                    eventSET_WAITING_TASK_VALUE( listGET_HEAD_ENTRY( pxTasksWaitingForBits ), eventUNBLOCKED_DUE_TO_BIT_SET );
+                    vTaskRemoveFromUnorderedEventList( listGET_HEAD_ENTRY( pxTasksWaitingForBits ), eventLIST_ITEM_VALUE( eventUNBLOCKED_DUE_TO_BIT_SET ) );
+                }
+            }
+            #endif /* configUSE_EVENT_GROUP_BARRIERS */
         }
+        eventEND_TASK_ACCESS( pxEventBits );
     }
     ( void ) xTaskResumeAll();
 
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        vObjectRegistryRemove( &( pxEventBits->xRegistryItem ) );
+    }
+    #endif
+
     #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
     {
         /* The event group can only have been allocated dynamically - free
          * it again. */
-        vPortFree( pxEventBits );
+        vPortFreeObject( portOBJECT_POOL_EVENT_GROUP, pxEventBits );
     }
     #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
     {
@@ -666,7 +1078,7 @@ void vEventGroupDelete( EventGroupHandle_t xEventGroup )
          * dynamically, so check before attempting to free the memory. */
         if( pxEventBits->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
         {
-            vPortFree( pxEventBits );
+            vPortFreeObject( portOBJECT_POOL_EVENT_GROUP, pxEventBits );
         }
         else
         {
@@ -732,7 +1144,156 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
 }
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
+static void prvInitialiseWaitLists( EventGroup_t * pxEventBits )
+{
+    vListInitialise( &( pxEventBits->xTasksWaitingForBits ) );
+
+    #if ( configUSE_EVENT_GROUP_WAIT_INDEX == 1 )
+    {
+        UBaseType_t uxBit;
+
+        for( uxBit = 0; uxBit < ( UBaseType_t ) eventNUM_EVENT_BITS; uxBit++ )
+        {
+            vListInitialise( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+        }
+    }
+    #endif /* configUSE_EVENT_GROUP_WAIT_INDEX */
+
+    #if ( configUSE_EVENT_GROUP_BARRIERS == 1 )
+    {
+        vListInitialise( &( pxEventBits->xTasksWaitingAtBarrier ) );
+        pxEventBits->uxBarrierArrivals = ( UBaseType_t ) 0;
+        pxEventBits->uxBarrierGeneration = ( UBaseType_t ) 0;
+    }
+    #endif /* configUSE_EVENT_GROUP_BARRIERS */
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+    {
+        pxEventBits->xTaskAccessInProgress = pdFALSE;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_WAIT_INDEX == 1 )
+
+    static List_t * prvGetWaitList( EventGroup_t * pxEventBits,
+                                    const EventBits_t uxBitsToWaitFor,
+                                    const BaseType_t xWaitForAllBits )
+    {
+        List_t * pxList;
+        EventBits_t uxBits;
+        UBaseType_t uxBit = 0;
+
+        if( ( xWaitForAllBits != pdFALSE ) || ( ( uxBitsToWaitFor & ( uxBitsToWaitFor - ( EventBits_t ) 1 ) ) == ( EventBits_t ) 0 ) )
+        {
+            /* Find the lowest bit waited for. */
+            for( uxBits = uxBitsToWaitFor; ( uxBits & ( EventBits_t ) 1 ) == ( EventBits_t ) 0; uxBits >>= 1 )
+            {
+                uxBit++;
+            }
+
+            pxList = &( pxEventBits->xTasksWaitingForBit[ uxBit ] );
+        }
+        else
+        {
+            pxList = &( pxEventBits->xTasksWaitingForBits );
+        }
+
+        return pxList;
+    }
+
+#endif /* configUSE_EVENT_GROUP_WAIT_INDEX */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+
+    BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
+                                          const EventBits_t uxBitsToSet,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        EventGroup_t * pxEventBits = xEventGroup;
+        UBaseType_t uxSavedInterruptStatus;
+        UBaseType_t uxWaitingTasks;
+        EventBits_t uxBitsToClear;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        BaseType_t xTasksUnblocked = pdFALSE;
+        BaseType_t xReturn = pdPASS;
+
+        configASSERT( xEventGroup );
+        configASSERT( ( uxBitsToSet & eventEVENT_BITS_CONTROL_BYTES ) == 0 );
+
+        traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            /* The bits are always set here, so tasks see them straight away. */
+            pxEventBits->uxEventBits |= uxBitsToSet;
+
+            /* Count the tasks that would have to be tested, which are those
+             * in the lists prvUnblockWaitingTasks() visits. */
+            uxWaitingTasks = listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBits ) );
+
+            #if ( configUSE_EVENT_GROUP_WAIT_INDEX == 1 )
+            {
+                EventBits_t uxBitsToTest = pxEventBits->uxEventBits;
+                UBaseType_t uxBit;
+
+                for( uxBit = 0; uxBitsToTest != ( EventBits_t ) 0; uxBit++ )
+                {
+                    if( ( uxBitsToTest & ( EventBits_t ) 1 ) != ( EventBits_t ) 0 )
+                    {
+                        uxWaitingTasks += listCURRENT_LIST_LENGTH( &( pxEventBits->xTasksWaitingForBit[ uxBit ] ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    uxBitsToTest >>= 1;
+                }
+            }
+            #endif /* configUSE_EVENT_GROUP_WAIT_INDEX */
+
+            /* The tasks are only unblocked here if no task is using the lists,
+             * and there are few enough of them to keep the time spent in the
+             * critical section bounded. */
+            if( ( pxEventBits->xTaskAccessInProgress == pdFALSE ) &&
+                ( uxWaitingTasks <= ( UBaseType_t ) configEVENT_GROUP_DIRECT_SET_MAX_WAITERS ) )
+            {
+                uxBitsToClear = prvUnblockWaitingTasks( pxEventBits, &xHigherPriorityTaskWoken );
+                pxEventBits->uxEventBits &= ~uxBitsToClear;
+                xTasksUnblocked = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xTasksUnblocked != pdFALSE )
+        {
+            if( ( pxHigherPriorityTaskWoken != NULL ) && ( xHigherPriorityTaskWoken != pdFALSE ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            /* The bits are already set, so the timer task only has to unblock
+             * the tasks, which it does with the scheduler suspended. */
+            xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) 0, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
+        }
+
+        return xReturn;
+    }
+
+#elif ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) )
 
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
@@ -740,13 +1301,20 @@ static BaseType_t prvTestWaitCondition( const EventBits_t uxCurrentEventBits,
     {
         BaseType_t xReturn;
 
+        #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+        {
+            /* Only 32 bits can be passed to the timer task. */
+            configASSERT( ( uxBitsToSet >> 32 ) == ( EventBits_t ) 0 );
+        }
+        #endif
+
         traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet );
         xReturn = xTimerPendFunctionCallFromISR( vEventGroupSetBitsCallback, ( void * ) xEventGroup, ( uint32_t ) uxBitsToSet, pxHigherPriorityTaskWoken ); /*lint !e9087 Can't avoid cast to void* as a generic callback function not specific to this use case. Callback casts back to original type so safe. */
 
         return xReturn;
     }
 
-#endif /* if ( ( configUSE_TRACE_FACILITY == 1 ) && ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 1 ) ) */
+#endif /* if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 ) */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -0,0 +1,73 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The whole kernel as a single translation unit.  Build this file instead of
+ * the individual kernel source files, together with the port and a heap
+ * implementation, so the compiler can inline the list operations and the small
+ * task helpers into queue.c, timers.c and the other modules without link time
+ * optimisation, which many of the toolchains in portable/ do not provide.  The
+ * CMake build does this when FREERTOS_AMALGAMATED is ON.
+ *
+ * Every kernel source file keeps its private functions and variables static,
+ * and no two files use the same private name, so they can share one
+ * translation unit.  The API functions keep external linkage, as the ports,
+ * the MPU wrappers and the application call them.  list.c comes first so the
+ * list operations are defined before the modules that use them.
+ */
+
+#include "list.c"
+#include "tasks.c"
+
+/* tasks.c defines static away for kernel aware debuggers that need its data to
+ * be global.  Do not carry that into the other modules. */
+#ifdef portREMOVE_STATIC_QUALIFIER
+    #undef static
+#endif
+
+#include "queue.c"
+#include "timers.c"
+#include "event_groups.c"
+#include "stream_buffer.c"
+#include "light_mutex.c"
+#include "spsc_queue.c"
+#include "broadcast_ring.c"
+#include "buffer_pool.c"
+#include "elastic_queue.c"
+#include "active_object.c"
+#include "amp_channel.c"
+#include "async_task.c"
+#include "shared_stack.c"
+#include "deferred_interrupt.c"
+#include "task_pool.c"
+#include "static_kernel.c"
+#include "object_registry.c"
+#include "post_mortem.c"
+#include "trace_recorder.c"
+#include "benchmark_hooks.c"
+#include "portable/MemMang/object_pools.c"
@@ -60,6 +60,11 @@
 #define TICK_TYPE_WIDTH_32_BITS    1
 #define TICK_TYPE_WIDTH_64_BITS    2
 
+/* Acceptable values for configTASK_NAME_STORAGE. */
+#define TASK_NAME_STORAGE_COPY         0
+#define TASK_NAME_STORAGE_REFERENCE    1
+#define TASK_NAME_STORAGE_NONE         2
+
 /* Application specific configuration options. */
 #include "FreeRTOSConfig.h"
 
@@ -294,14 +299,38 @@
     #define configNUM_THREAD_LOCAL_STORAGE_POINTERS    0
 #endif
 
+/* Set configUSE_TCB_HOT_LAYOUT to 1 to order the members of each task's TCB so
+ * those read or written by a context switch come first, and share as few
+ * cache lines as possible.  The task name and thread local storage pointers,
+ * which a context switch never touches, are moved from among them to the end
+ * of the TCB, and the run time counter is moved up to join them.  As the
+ * offsets of the moved members change, the kernel then also exports
+ * xTaskControlBlockLayout, from which kernel aware debuggers that do not use
+ * the debug information can find them.  Defaults to 0, which keeps the
+ * original order. */
+#ifndef configUSE_TCB_HOT_LAYOUT
+    #define configUSE_TCB_HOT_LAYOUT    0
+#endif
+
 #ifndef configUSE_RECURSIVE_MUTEXES
     #define configUSE_RECURSIVE_MUTEXES    0
 #endif
 
+#ifndef configUSE_RW_LOCKS
+    #define configUSE_RW_LOCKS    0
+#endif
+
 #ifndef configUSE_MUTEXES
     #define configUSE_MUTEXES    0
 #endif
 
+/* Set configUSE_LIGHT_MUTEXES to 1 to include the light mutexes declared in
+ * light_mutex.h, which a task can take and give without entering the kernel
+ * while no other task is waiting. */
+#ifndef configUSE_LIGHT_MUTEXES
+    #define configUSE_LIGHT_MUTEXES    0
+#endif
+
 #ifndef configUSE_TIMERS
     #define configUSE_TIMERS    0
 #endif
@@ -330,6 +359,23 @@
     #error configMAX_TASK_NAME_LEN must be set to a minimum of 1 in FreeRTOSConfig.h
 #endif
 
+/* How each task's name is held.  TASK_NAME_STORAGE_COPY, the default, copies
+ * up to configMAX_TASK_NAME_LEN - 1 characters of the name into the TCB.
+ * TASK_NAME_STORAGE_REFERENCE only stores a pointer to the name passed to the
+ * task create function, which must remain valid for the life of the task - in
+ * practice a string literal or a constant table held in flash - so names cost
+ * no RAM beyond the pointer.  Names are then compared over at most
+ * configMAX_TASK_NAME_LEN characters.  TASK_NAME_STORAGE_NONE does not store
+ * names at all, and pcTaskGetName() and the task status functions report an
+ * empty name, so xTaskGetHandle() cannot be used. */
+#ifndef configTASK_NAME_STORAGE
+    #define configTASK_NAME_STORAGE    TASK_NAME_STORAGE_COPY
+#endif
+
+#if ( ( configTASK_NAME_STORAGE != TASK_NAME_STORAGE_COPY ) && ( configTASK_NAME_STORAGE != TASK_NAME_STORAGE_REFERENCE ) && ( configTASK_NAME_STORAGE != TASK_NAME_STORAGE_NONE ) )
+    #error configTASK_NAME_STORAGE must be TASK_NAME_STORAGE_COPY, TASK_NAME_STORAGE_REFERENCE or TASK_NAME_STORAGE_NONE
+#endif
+
 #ifndef configASSERT
     #define configASSERT( x )
     #define configASSERT_DEFINED    0
@@ -394,6 +440,13 @@
     #define portSETUP_TCB( pxTCB )    ( void ) ( pxTCB )
 #endif
 
+/* Called by the idle task each time round its loop, with interrupts enabled.
+ * Lets a simulator port that only delivers interrupts at points it controls
+ * deliver them, or wait for one, while no other task is ready. */
+#ifndef portIDLE_LOOP_HOOK
+    #define portIDLE_LOOP_HOOK()
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
     #define configQUEUE_REGISTRY_SIZE    0U
 #endif
@@ -412,6 +465,81 @@
     #define portPOINTER_SIZE_TYPE    uint32_t
 #endif
 
+/* configKERNEL_BUILD_PROFILE selects one of the supported combinations of the
+ * performance options, and is checked against the final configuration below.
+ * The CMake build sets it from the FREERTOS_PROFILE option.
+ *
+ * kernelPROFILE_SPEED - list operations expanded inline, and the hot kernel
+ *                       functions in configKERNEL_FAST_SECTION, without
+ *                       instrumentation on the hot paths.
+ * kernelPROFILE_SIZE  - the smallest footprint, with no inline list
+ *                       operations, instrumentation or stats formatting.
+ * kernelPROFILE_TRACE - the trace recorder built in.
+ *
+ * A profile only provides defaults, so FreeRTOSConfig.h can still set each
+ * option, but a combination that contradicts the profile is rejected. */
+#define kernelPROFILE_NONE     0
+#define kernelPROFILE_SPEED    1
+#define kernelPROFILE_SIZE     2
+#define kernelPROFILE_TRACE    3
+
+#ifndef configKERNEL_BUILD_PROFILE
+    #define configKERNEL_BUILD_PROFILE    kernelPROFILE_NONE
+#endif
+
+#if ( configKERNEL_BUILD_PROFILE == kernelPROFILE_SPEED )
+    #ifndef configUSE_LIST_INLINE_OPERATIONS
+        #define configUSE_LIST_INLINE_OPERATIONS    1
+    #endif
+#elif ( configKERNEL_BUILD_PROFILE == kernelPROFILE_SIZE )
+    #ifndef configUSE_LIST_INLINE_OPERATIONS
+        #define configUSE_LIST_INLINE_OPERATIONS    0
+    #endif
+#elif ( configKERNEL_BUILD_PROFILE == kernelPROFILE_TRACE )
+    #ifndef configUSE_TRACE_RECORDER
+        #define configUSE_TRACE_RECORDER    1
+    #endif
+#elif ( configKERNEL_BUILD_PROFILE != kernelPROFILE_NONE )
+    #error configKERNEL_BUILD_PROFILE must be kernelPROFILE_NONE, kernelPROFILE_SPEED, kernelPROFILE_SIZE or kernelPROFILE_TRACE
+#endif
+
+#ifndef configUSE_TRACE_RECORDER
+
+/* Set to 1 to have the trace macros that are not defined in FreeRTOSConfig.h
+ * write binary records to the ring buffers implemented by trace_recorder.c.
+ * See trace_recorder.h. */
+    #define configUSE_TRACE_RECORDER    0
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+    #include "trace_recorder.h"
+#endif
+
+#ifndef configUSE_BENCHMARK_HOOKS
+
+/* Set to 1 to have the benchmark macros that are not defined in
+ * FreeRTOSConfig.h time interrupts, context switches and API calls into the
+ * latency histograms kept by benchmark_hooks.c.  See benchmark_hooks.h. */
+    #define configUSE_BENCHMARK_HOOKS    0
+#endif
+
+/* The API calls timed by traceBENCHMARK_API_ENTER() and
+ * traceBENCHMARK_API_EXIT(), passed to the macros as uxApi. */
+#define benchmarkAPI_QUEUE_SEND                 ( 0U )
+#define benchmarkAPI_QUEUE_SEND_FROM_ISR        ( 1U )
+#define benchmarkAPI_QUEUE_GIVE_FROM_ISR        ( 2U )
+#define benchmarkAPI_QUEUE_RECEIVE              ( 3U )
+#define benchmarkAPI_QUEUE_RECEIVE_FROM_ISR     ( 4U )
+#define benchmarkAPI_SEMAPHORE_TAKE             ( 5U )
+#define benchmarkAPI_TASK_NOTIFY                ( 6U )
+#define benchmarkAPI_TASK_NOTIFY_FROM_ISR       ( 7U )
+#define benchmarkAPI_EVENT_GROUP_SET_BITS       ( 8U )
+#define benchmarkAPI_COUNT                      ( 9U )
+
+#if ( configUSE_BENCHMARK_HOOKS == 1 )
+    #include "benchmark_hooks.h"
+#endif
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 
@@ -458,6 +586,57 @@
     #define traceTASK_SWITCHED_OUT()
 #endif
 
+#ifndef traceBENCHMARK_ISR_ENTER
+
+/* Called by the port on entry to an interrupt it handles, currently the tick
+ * interrupt, before any kernel code runs. */
+    #define traceBENCHMARK_ISR_ENTER()
+#endif
+
+#ifndef traceBENCHMARK_ISR_EXIT
+
+/* Called by the port when the interrupt that called
+ * traceBENCHMARK_ISR_ENTER() has finished its kernel work, before any
+ * context switch it requested is performed. */
+    #define traceBENCHMARK_ISR_EXIT()
+#endif
+
+#ifndef traceBENCHMARK_TASK_SWITCHED_OUT
+
+/* Called when vTaskSwitchContext() starts to switch out the running task,
+ * before the next task is selected. */
+    #define traceBENCHMARK_TASK_SWITCHED_OUT()
+#endif
+
+#ifndef traceBENCHMARK_TASK_SWITCHED_IN
+
+/* Called at the end of vTaskSwitchContext(), after the next task has been
+ * selected, so the time since traceBENCHMARK_TASK_SWITCHED_OUT() is the time
+ * the kernel took to switch tasks. */
+    #define traceBENCHMARK_TASK_SWITCHED_IN()
+#endif
+
+#ifndef traceBENCHMARK_API_ENTER
+
+/* Called on entry to the API functions listed by the benchmarkAPI_ constants,
+ * with uxApi set to the constant of the function called. */
+    #define traceBENCHMARK_API_ENTER( uxApi )
+#endif
+
+#ifndef traceBENCHMARK_API_EXIT
+
+/* Called immediately before each return from a function that called
+ * traceBENCHMARK_API_ENTER( uxApi ). */
+    #define traceBENCHMARK_API_EXIT( uxApi )
+#endif
+
+#ifndef traceDVFS_LEVEL_CHANGE
+
+/* Called from the tick interrupt when the DVFS governor changes the
+ * performance level, before portSET_PERFORMANCE_LEVEL() is called. */
+    #define traceDVFS_LEVEL_CHANGE( uxOldLevel, uxNewLevel )
+#endif
+
 #ifndef traceTASK_PRIORITY_INHERIT
 
 /* Called when a task attempts to take a mutex that is already held by a
@@ -512,6 +691,36 @@
     #define configRECORD_STACK_HIGH_ADDRESS    0
 #endif
 
+#ifndef configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK
+
+/* Set to 1 to remember the deepest point each task's stack is known to have
+ * reached, so uxTaskGetStackHighWaterMark(), uxTaskGetStackHighWaterMark2() and
+ * vTaskGetInfo() only scan the stack beyond that point instead of the whole of
+ * its unused part.  The stack pointer is also sampled each time a task is
+ * switched out. */
+    #define configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK    0
+#endif
+
+#ifndef configSTACK_HIGH_WATER_MARK_GAP_WORDS
+
+/* When configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK is 1, the number of
+ * consecutive unused words beyond the deepest known point that end a scan.
+ * Larger values see past larger buffers that a task has not written to, at the
+ * cost of scanning further on each call. */
+    #define configSTACK_HIGH_WATER_MARK_GAP_WORDS    16
+#endif
+
+#ifndef configSTACK_FILL_LIMIT_WORDS
+
+/* The most words of a new task's stack that are filled with the known value
+ * used to measure stack use, counted from the end of the stack furthest from
+ * where it starts.  0 fills the whole stack.  Limiting the fill speeds up
+ * creating tasks with large stacks.  The stack high water mark is then exact
+ * while it is below configSTACK_FILL_LIMIT_WORDS, and is reported as at most
+ * configSTACK_FILL_LIMIT_WORDS otherwise. */
+    #define configSTACK_FILL_LIMIT_WORDS    0
+#endif
+
 #ifndef configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H
     #define configINCLUDE_FREERTOS_TASK_C_ADDITIONS_H    0
 #endif
@@ -618,6 +827,22 @@
     #define traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue )
 #endif
 
+#ifndef traceQUEUE_SEND_MULTIPLE
+    #define traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemsSent )
+#endif
+
+#ifndef traceQUEUE_SEND_MULTIPLE_FROM_ISR
+    #define traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxItemsSent )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE
+    #define traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemsReceived )
+#endif
+
+#ifndef traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR
+    #define traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxItemsReceived )
+#endif
+
 #ifndef traceQUEUE_DELETE
     #define traceQUEUE_DELETE( pxQueue )
 #endif
@@ -638,6 +863,26 @@
     #define traceTASK_DELAY_UNTIL( x )
 #endif
 
+#ifndef traceTASK_DEADLINE_MISSED
+    #define traceTASK_DEADLINE_MISSED( pxTCB )
+#endif
+
+#ifndef traceTASK_BUDGET_EXHAUSTED
+    #define traceTASK_BUDGET_EXHAUSTED( pxTCB )
+#endif
+
+#ifndef traceTIME_PARTITION_SWITCH
+    #define traceTIME_PARTITION_SWITCH( uxPartition )
+#endif
+
+#ifndef traceTASK_PERIOD_OVERRUN
+    #define traceTASK_PERIOD_OVERRUN( pxTCB, xLateness )
+#endif
+
+#ifndef traceCRITICALITY_MODE_SWITCH
+    #define traceCRITICALITY_MODE_SWITCH( uxMode )
+#endif
+
 #ifndef traceTASK_DELAY
     #define traceTASK_DELAY()
 #endif
@@ -666,6 +911,178 @@
     #define traceTIMER_CREATE( pxNewTimer )
 #endif
 
+#ifndef traceTASK_POOL_CREATE
+    #define traceTASK_POOL_CREATE( pxPool )
+#endif
+
+#ifndef traceTASK_POOL_SUBMIT
+    #define traceTASK_POOL_SUBMIT( pxPool, pxJobFunction )
+#endif
+
+#ifndef traceTASK_POOL_JOB_START
+    #define traceTASK_POOL_JOB_START( pxPool, pxJobFunction )
+#endif
+
+#ifndef traceTASK_POOL_JOB_END
+    #define traceTASK_POOL_JOB_END( pxPool, pxJobFunction )
+#endif
+
+#ifndef traceASYNC_EXECUTOR_CREATE
+    #define traceASYNC_EXECUTOR_CREATE( pxExecutor )
+#endif
+
+#ifndef traceASYNC_TASK_CREATE
+    #define traceASYNC_TASK_CREATE( pxAsyncTask )
+#endif
+
+#ifndef traceASYNC_TASK_RUN
+    #define traceASYNC_TASK_RUN( pxAsyncTask )
+#endif
+
+#ifndef traceASYNC_TASK_BLOCK
+    #define traceASYNC_TASK_BLOCK( pxAsyncTask )
+#endif
+
+#ifndef traceASYNC_TASK_END
+    #define traceASYNC_TASK_END( pxAsyncTask )
+#endif
+
+#ifndef traceSHARED_STACK_CREATE
+    #define traceSHARED_STACK_CREATE( pxSharedStack )
+#endif
+
+#ifndef traceSHARED_STACK_TASK_CREATE
+    #define traceSHARED_STACK_TASK_CREATE( pxTask )
+#endif
+
+#ifndef traceSHARED_STACK_TASK_START
+    #define traceSHARED_STACK_TASK_START( pxTask )
+#endif
+
+#ifndef traceSHARED_STACK_TASK_END
+    #define traceSHARED_STACK_TASK_END( pxTask )
+#endif
+
+#ifndef traceACTIVE_EVENT_POOL_CREATE
+    #define traceACTIVE_EVENT_POOL_CREATE( pxPool )
+#endif
+
+#ifndef traceACTIVE_DISPATCHER_CREATE
+    #define traceACTIVE_DISPATCHER_CREATE( pxDispatcher )
+#endif
+
+#ifndef traceACTIVE_OBJECT_CREATE
+    #define traceACTIVE_OBJECT_CREATE( pxActiveObject )
+#endif
+
+#ifndef traceACTIVE_OBJECT_POST
+    #define traceACTIVE_OBJECT_POST( pxActiveObject, pxEvent )
+#endif
+
+#ifndef traceACTIVE_OBJECT_DISPATCH
+    #define traceACTIVE_OBJECT_DISPATCH( pxActiveObject, pxEvent )
+#endif
+
+#ifndef traceDEFERRED_INTERRUPT_REGISTER
+    #define traceDEFERRED_INTERRUPT_REGISTER( pxInterrupt )
+#endif
+
+#ifndef traceDEFERRED_INTERRUPT_RAISE
+    #define traceDEFERRED_INTERRUPT_RAISE( pxInterrupt )
+#endif
+
+#ifndef traceDEFERRED_INTERRUPT_HANDLER_START
+    #define traceDEFERRED_INTERRUPT_HANDLER_START( pxInterrupt, ulRaisedCount )
+#endif
+
+#ifndef traceDEFERRED_INTERRUPT_HANDLER_END
+    #define traceDEFERRED_INTERRUPT_HANDLER_END( pxInterrupt )
+#endif
+
+#ifndef traceBROADCAST_RING_CREATE
+    #define traceBROADCAST_RING_CREATE( pxRing )
+#endif
+
+#ifndef traceBROADCAST_RING_PUBLISH
+    #define traceBROADCAST_RING_PUBLISH( pxRing )
+#endif
+
+#ifndef traceBROADCAST_RING_RECEIVE
+    #define traceBROADCAST_RING_RECEIVE( pxSubscriber )
+#endif
+
+#ifndef traceBROADCAST_RING_RECEIVE_FAILED
+    #define traceBROADCAST_RING_RECEIVE_FAILED( pxSubscriber )
+#endif
+
+#ifndef traceBLOCKING_ON_BROADCAST_RING_RECEIVE
+    #define traceBLOCKING_ON_BROADCAST_RING_RECEIVE( pxSubscriber )
+#endif
+
+#ifndef traceBROADCAST_RING_LAPPED
+    #define traceBROADCAST_RING_LAPPED( pxSubscriber, uxMissed )
+#endif
+
+#ifndef traceBUFFER_POOL_CREATE
+    #define traceBUFFER_POOL_CREATE( pxPool )
+#endif
+
+#ifndef traceBUFFER_POOL_ALLOCATE
+    #define traceBUFFER_POOL_ALLOCATE( pxPool, pxBuffer )
+#endif
+
+#ifndef traceBUFFER_POOL_ALLOCATE_FAILED
+    #define traceBUFFER_POOL_ALLOCATE_FAILED( pxPool )
+#endif
+
+#ifndef traceBUFFER_POOL_FREE
+    #define traceBUFFER_POOL_FREE( pxPool, pxBuffer )
+#endif
+
+#ifndef traceELASTIC_QUEUE_CREATE
+    #define traceELASTIC_QUEUE_CREATE( pxQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_SEND
+    #define traceELASTIC_QUEUE_SEND( pxQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_SEND_FAILED
+    #define traceELASTIC_QUEUE_SEND_FAILED( pxQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_RECEIVE
+    #define traceELASTIC_QUEUE_RECEIVE( pxQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_RECEIVE_FAILED
+    #define traceELASTIC_QUEUE_RECEIVE_FAILED( pxQueue )
+#endif
+
+#ifndef traceELASTIC_QUEUE_GROW
+    #define traceELASTIC_QUEUE_GROW( pxQueue, pxSegment )
+#endif
+
+#ifndef traceELASTIC_QUEUE_SHRINK
+    #define traceELASTIC_QUEUE_SHRINK( pxQueue, pxSegment )
+#endif
+
+#ifndef traceAMP_CHANNEL_CREATE
+    #define traceAMP_CHANNEL_CREATE( pxChannel )
+#endif
+
+#ifndef traceAMP_CHANNEL_SEND
+    #define traceAMP_CHANNEL_SEND( pxChannel, xBytesSent )
+#endif
+
+#ifndef traceAMP_CHANNEL_RECEIVE
+    #define traceAMP_CHANNEL_RECEIVE( pxChannel, xBytesReceived )
+#endif
+
+#ifndef traceAMP_CHANNEL_DOORBELL
+    #define traceAMP_CHANNEL_DOORBELL( pxChannel )
+#endif
+
 #ifndef traceTIMER_CREATE_FAILED
     #define traceTIMER_CREATE_FAILED()
 #endif
@@ -690,6 +1107,10 @@
     #define traceFREE( pvAddress, uiSize )
 #endif
 
+#ifndef traceMALLOC_INSTRUMENTATION
+    #define traceMALLOC_INSTRUMENTATION( pvAddress, uiSize, uxBlocksWalked, ulMallocTime )
+#endif
+
 #ifndef traceEVENT_GROUP_CREATE
     #define traceEVENT_GROUP_CREATE( xEventGroup )
 #endif
@@ -774,6 +1195,14 @@
     #define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )
 #endif
 
+#ifndef traceTASK_WAIT_ON_ADDRESS_BLOCK
+    #define traceTASK_WAIT_ON_ADDRESS_BLOCK( pulAddress )
+#endif
+
+#ifndef traceTASK_WAKE_ADDRESS
+    #define traceTASK_WAKE_ADDRESS( pulAddress, uxTasksWoken )
+#endif
+
 #ifndef traceSTREAM_BUFFER_CREATE_FAILED
     #define traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer )
 #endif
@@ -826,6 +1255,10 @@
     #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceSTREAM_BUFFER_MESSAGE_EXPIRED
+    #define traceSTREAM_BUFFER_MESSAGE_EXPIRED( xStreamBuffer, xMessageLength )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
     #define configGENERATE_RUN_TIME_STATS    0
 #endif
@@ -860,6 +1293,52 @@
     #define portYIELD_WITHIN_API    portYIELD
 #endif
 
+#ifndef portWAIT_FOR_EVENT
+
+/* Called each time round a kernel spin-wait loop.  Ports whose cores can wait
+ * for an event, such as with the ARM WFE instruction, define it to do so, and
+ * define portSEND_EVENT() to signal one, so a spinning core sleeps until what
+ * it waits for happens or an interrupt arrives. */
+    #define portWAIT_FOR_EVENT()
+#endif
+
+#ifndef portSEND_EVENT
+    #define portSEND_EVENT()
+#endif
+
+#ifndef portSET_PERFORMANCE_LEVEL
+
+/* Called by the DVFS governor, from the tick interrupt, to change the CPU
+ * clock frequency and voltage to performance level uxLevel.  Ports that cannot
+ * do so themselves leave it to the application. */
+    #define portSET_PERFORMANCE_LEVEL( uxLevel )    vApplicationSetPerformanceLevel( uxLevel )
+#endif
+
+#ifndef portCPU_CLOCK_CHANGED
+
+/* Called after the CPU clock has changed to ulCPUClockHz, so a port whose tick
+ * timer is clocked by the CPU can reload it to keep the tick at
+ * configTICK_RATE_HZ. */
+    #define portCPU_CLOCK_CHANGED( ulCPUClockHz )
+#endif
+
+#ifndef portPEND_YIELD_FROM_ISR
+
+/* Called by the kernel each time it readies a task that has a higher priority
+ * than the running task, which can be from an interrupt or from a task.  Ports
+ * that count the interrupt nesting depth define it to pend a context switch
+ * for the exit from the outermost interrupt when called from an interrupt, so
+ * the one switch decision is made however many nested interrupts ready tasks,
+ * and interrupts can pass NULL as the pxHigherPriorityTaskWoken parameter of
+ * the ISR safe API functions and skip portYIELD_FROM_ISR().  Those ports set
+ * portYIELD_FROM_ISR_IS_AUTOMATIC to 1. */
+    #define portPEND_YIELD_FROM_ISR()
+#endif
+
+#ifndef portYIELD_FROM_ISR_IS_AUTOMATIC
+    #define portYIELD_FROM_ISR_IS_AUTOMATIC    0
+#endif
+
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
     #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )
 #endif
@@ -876,112 +1355,1687 @@
     #define configUSE_TICKLESS_IDLE    0
 #endif
 
-#ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
-    #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
+/* Set configUSE_SLEEP_STATE_GOVERNOR to 1 to let the idle task choose between
+ * the sleep states registered with vTaskSetSleepStates() each time it suppresses
+ * the tick.  The deepest state whose entry latency, exit latency and minimum
+ * residency fit within the predicted idle time is used, where the prediction is
+ * the expected idle time scaled by how long previous sleeps actually lasted. */
+#ifndef configUSE_SLEEP_STATE_GOVERNOR
+    #define configUSE_SLEEP_STATE_GOVERNOR    0
 #endif
 
-#ifndef configPRE_SLEEP_PROCESSING
-    #define configPRE_SLEEP_PROCESSING( x )
+#if ( ( configUSE_SLEEP_STATE_GOVERNOR == 1 ) && ( configUSE_TICKLESS_IDLE == 0 ) )
+    #error configUSE_SLEEP_STATE_GOVERNOR requires configUSE_TICKLESS_IDLE to be set to a value other than 0.
 #endif
 
-#ifndef configPOST_SLEEP_PROCESSING
-    #define configPOST_SLEEP_PROCESSING( x )
+/* Set configUSE_IDLE_WORK to 1 to include xTaskQueueIdleWork(), which queues
+ * background work for the idle task to run in slices, highest priority first,
+ * before it considers suppressing the tick. */
+#ifndef configUSE_IDLE_WORK
+    #define configUSE_IDLE_WORK    0
 #endif
 
-#ifndef configUSE_QUEUE_SETS
-    #define configUSE_QUEUE_SETS    0
+#if ( ( configUSE_IDLE_WORK == 1 ) && ( portUSING_MPU_WRAPPERS == 1 ) )
+    #error configUSE_IDLE_WORK cannot be used with MPU ports as idle work functions are called by the privileged idle task
 #endif
 
-#ifndef portTASK_USES_FLOATING_POINT
-    #define portTASK_USES_FLOATING_POINT()
+/* The number of ticks the idle task spends running idle work slices each time
+ * round its loop before it goes on to consider sleeping.  0 runs one slice
+ * each time round. */
+#ifndef configIDLE_WORK_BUDGET_TICKS
+    #define configIDLE_WORK_BUDGET_TICKS    1
 #endif
 
-#ifndef portALLOCATE_SECURE_CONTEXT
-    #define portALLOCATE_SECURE_CONTEXT( ulSecureStackSize )
+/* Set configUSE_SCHEDULER_EVENT_HOOKS to 1 to have the kernel call
+ * vApplicationTaskReadiedHook() each time a task is added to a ready list, and
+ * vApplicationIdleEntryHook() from the idle task each time a core goes idle,
+ * so an application can balance work between kernel instances, for example
+ * over AMP channels.  uxTaskGetReadyTaskCount() reports the number of ready
+ * tasks. */
+#ifndef configUSE_SCHEDULER_EVENT_HOOKS
+    #define configUSE_SCHEDULER_EVENT_HOOKS    0
 #endif
 
-#ifndef portDONT_DISCARD
-    #define portDONT_DISCARD
+/* Set configUSE_TASK_STATE_COUNTS to 1 to have the kernel keep a count of
+ * suspended tasks, so uxTaskGetNumberOfTasksInState() can report the number of
+ * tasks in each state without walking the task lists, and to include
+ * uxTaskGetNumberOfReadyTasksAtPriority(). */
+#ifndef configUSE_TASK_STATE_COUNTS
+    #define configUSE_TASK_STATE_COUNTS    0
 #endif
 
-#ifndef configUSE_TIME_SLICING
-    #define configUSE_TIME_SLICING    1
+/* Set configUSE_DELAYED_TASK_WHEEL to 1 to hold tasks that block for less than
+ * configDELAYED_TASK_WHEEL_SIZE ticks in a timing wheel instead of the sorted
+ * delayed lists, so blocking with a timeout does not walk the delayed list.
+ * Longer timeouts still use the sorted delayed lists. */
+#ifndef configUSE_DELAYED_TASK_WHEEL
+    #define configUSE_DELAYED_TASK_WHEEL    0
 #endif
 
-#ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
-    #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
+#ifndef configDELAYED_TASK_WHEEL_SIZE
+    #define configDELAYED_TASK_WHEEL_SIZE    64
 #endif
 
-#ifndef configUSE_STATS_FORMATTING_FUNCTIONS
-    #define configUSE_STATS_FORMATTING_FUNCTIONS    0
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    #if ( ( configDELAYED_TASK_WHEEL_SIZE < 2 ) || ( ( configDELAYED_TASK_WHEEL_SIZE & ( configDELAYED_TASK_WHEEL_SIZE - 1 ) ) != 0 ) )
+        #error configDELAYED_TASK_WHEEL_SIZE must be a power of 2 and at least 2.
+    #endif
 #endif
 
-#ifndef portASSERT_IF_INTERRUPT_PRIORITY_INVALID
-    #define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()
+/* Set configUSE_EDF_SCHEDULING to 1 to schedule the tasks created with
+ * xTaskCreateDeadline() earliest deadline first.  They all run at
+ * configEDF_PRIORITY, which should not be used by any other task. */
+#ifndef configUSE_EDF_SCHEDULING
+    #define configUSE_EDF_SCHEDULING    0
 #endif
 
-#ifndef configUSE_TRACE_FACILITY
-    #define configUSE_TRACE_FACILITY    0
+#ifndef configEDF_PRIORITY
+    #define configEDF_PRIORITY    ( configMAX_PRIORITIES - 1 )
 #endif
 
-#ifndef mtCOVERAGE_TEST_MARKER
-    #define mtCOVERAGE_TEST_MARKER()
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #if ( ( configEDF_PRIORITY < 1 ) || ( configEDF_PRIORITY >= configMAX_PRIORITIES ) )
+        #error configEDF_PRIORITY must be above the idle priority and less than configMAX_PRIORITIES.
+    #endif
 #endif
 
-#ifndef mtCOVERAGE_TEST_DELAY
-    #define mtCOVERAGE_TEST_DELAY()
+/* Set configUSE_TASK_BUDGETS to 1 to allow vTaskSetBudget() to limit the
+ * number of ticks a task can run for in each budget period.  A task that
+ * exhausts its budget is throttled until the start of its next period. */
+#ifndef configUSE_TASK_BUDGETS
+    #define configUSE_TASK_BUDGETS    0
 #endif
 
-#ifndef portASSERT_IF_IN_ISR
-    #define portASSERT_IF_IN_ISR()
+#if ( ( configUSE_TASK_BUDGETS == 1 ) && ( configUSE_PREEMPTION == 0 ) )
+    #error configUSE_TASK_BUDGETS requires configUSE_PREEMPTION to be set to 1.
 #endif
 
-#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
-    #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+/* Set configUSE_TIME_PARTITIONS to 1 to divide processor time between
+ * partitions of tasks using the repeating schedule of windows passed to
+ * vTaskSetPartitionSchedule().  Only the tasks of the partition that owns the
+ * current window can run, however the other partitions behave. */
+#ifndef configUSE_TIME_PARTITIONS
+    #define configUSE_TIME_PARTITIONS    0
 #endif
 
-#ifndef configAPPLICATION_ALLOCATED_HEAP
-    #define configAPPLICATION_ALLOCATED_HEAP    0
+/* The number of time partitions, which are numbered from 1.  Partition 0
+ * holds the tasks that are not in any partition, including the idle task. */
+#ifndef configNUMBER_OF_TIME_PARTITIONS
+    #define configNUMBER_OF_TIME_PARTITIONS    2
 #endif
 
-#ifndef configUSE_TASK_NOTIFICATIONS
-    #define configUSE_TASK_NOTIFICATIONS    1
+/* Set configTIME_PARTITION_DONATE_IDLE_TIME to 1 to let the tasks in partition
+ * 0 run in every window, so background tasks at a priority below that of
+ * every partitioned task use the time the window's partition leaves idle.  Set
+ * it to 0 to only let them run in windows that belong to partition 0.  The
+ * idle task can always run. */
+#ifndef configTIME_PARTITION_DONATE_IDLE_TIME
+    #define configTIME_PARTITION_DONATE_IDLE_TIME    1
 #endif
 
-#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
-    #define configTASK_NOTIFICATION_ARRAY_ENTRIES    1
+#if ( configUSE_TIME_PARTITIONS == 1 )
+    #if ( configNUMBER_OF_TIME_PARTITIONS < 1 )
+        #error configNUMBER_OF_TIME_PARTITIONS must be at least 1.
+    #endif
+
+    #if ( ( configUSE_PREEMPTION == 0 ) || ( configNUMBER_OF_CORES > 1 ) )
+        #error configUSE_TIME_PARTITIONS requires configUSE_PREEMPTION to be set to 1 and configNUMBER_OF_CORES to be set to 1.
+    #endif
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #error configUSE_TIME_PARTITIONS cannot be used with tickless idle, as the partition schedule is advanced by the tick interrupt.
+    #endif
 #endif
 
-#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
-    #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+/* Set configUSE_MIXED_CRITICALITY to 1 to let tasks and timers be tagged as
+ * low criticality with vTaskSetCriticality() and vTimerSetCriticality().  When
+ * the kernel switches to high criticality mode, either by a call to
+ * vTaskSetCriticalityMode() or because a high criticality task overran its
+ * budget, low criticality tasks are shed and the callbacks of low criticality
+ * timers are deferred until the kernel returns to low criticality mode. */
+#ifndef configUSE_MIXED_CRITICALITY
+    #define configUSE_MIXED_CRITICALITY    0
 #endif
 
-#ifndef configUSE_POSIX_ERRNO
-    #define configUSE_POSIX_ERRNO    0
+/* The kernel returns to low criticality mode by itself once it has spent at
+ * least configCRITICALITY_RESTORE_TICKS ticks in high criticality mode, counted
+ * from the switch or from the last budget overrun by a high criticality task,
+ * and the idle task has run in that time, showing the load has subsided.  Set
+ * to 0 to only return to low criticality mode when vTaskSetCriticalityMode() is
+ * called. */
+#ifndef configCRITICALITY_RESTORE_TICKS
+    #define configCRITICALITY_RESTORE_TICKS    100
 #endif
 
-#ifndef configUSE_SB_COMPLETED_CALLBACK
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+    #if ( ( configUSE_PREEMPTION == 0 ) || ( configNUMBER_OF_CORES > 1 ) )
+        #error configUSE_MIXED_CRITICALITY requires configUSE_PREEMPTION to be set to 1 and configNUMBER_OF_CORES to be set to 1.
+    #endif
 
-/* By default per-instance callbacks are not enabled for stream buffer or message buffer. */
-    #define configUSE_SB_COMPLETED_CALLBACK    0
+    #if ( configUSE_TIME_PARTITIONS == 1 )
+        #error configUSE_MIXED_CRITICALITY cannot be used with configUSE_TIME_PARTITIONS, as partitions already isolate tasks of different criticality.
+    #endif
 #endif
 
-#ifndef portTICK_TYPE_IS_ATOMIC
-    #define portTICK_TYPE_IS_ATOMIC    0
+/* Set configUSE_TASK_PREEMPTION_DISABLE to 1 to allow a task to call
+ * vTaskPreemptionDisable() to stop itself being switched out while it remains
+ * able to run, without suspending the scheduler. */
+#ifndef configUSE_TASK_PREEMPTION_DISABLE
+    #define configUSE_TASK_PREEMPTION_DISABLE    0
 #endif
 
-#ifndef configSUPPORT_STATIC_ALLOCATION
-    /* Defaults to 0 for backward compatibility. */
-    #define configSUPPORT_STATIC_ALLOCATION    0
+#if ( ( configUSE_TASK_PREEMPTION_DISABLE == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configUSE_TASK_PREEMPTION_DISABLE is not supported when configNUMBER_OF_CORES is set to more than 1.
 #endif
 
-#ifndef configSUPPORT_DYNAMIC_ALLOCATION
-    /* Defaults to 1 for backward compatibility. */
-    #define configSUPPORT_DYNAMIC_ALLOCATION    1
+/* Set configUSE_TICK_COUNT_64 to 1 to have the kernel maintain a 64-bit tick
+ * count that never overflows and that ullTaskGetTickCount64() can read from
+ * tasks and interrupts without entering a critical section. */
+#ifndef configUSE_TICK_COUNT_64
+    #define configUSE_TICK_COUNT_64    0
 #endif
 
-#if ( ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
-    #error configUSE_STATS_FORMATTING_FUNCTIONS cannot be used without dynamic allocation, but configSUPPORT_DYNAMIC_ALLOCATION is not set to 1.
+#if ( ( configUSE_TICK_COUNT_64 == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configUSE_TICK_COUNT_64 is not supported when configNUMBER_OF_CORES is set to more than 1.
+#endif
+
+#ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
+    #define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
+#endif
+
+#if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+
+/* The sleep state governor enters and leaves the selected sleep state from
+ * the hooks the port calls around its wait for interrupt instruction. */
+    #ifndef configPRE_SLEEP_PROCESSING
+        #define configPRE_SLEEP_PROCESSING( x )    vTaskEnterSleepState( &( x ) )
+    #endif
+
+    #ifndef configPOST_SLEEP_PROCESSING
+        #define configPOST_SLEEP_PROCESSING( x )    vTaskExitSleepState( x )
+    #endif
+#endif
+
+#ifndef configPRE_SLEEP_PROCESSING
+    #define configPRE_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configPOST_SLEEP_PROCESSING
+    #define configPOST_SLEEP_PROCESSING( x )
+#endif
+
+#ifndef configUSE_QUEUE_SETS
+    #define configUSE_QUEUE_SETS    0
+#endif
+
+/* Set configUSE_QUEUE_WAIT_FOR_ANY to 1 to include xQueueWaitForAny(), which
+ * blocks a task on several queues and semaphores at once without the storage
+ * of a queue set. */
+#ifndef configUSE_QUEUE_WAIT_FOR_ANY
+    #define configUSE_QUEUE_WAIT_FOR_ANY    0
+#endif
+
+/* Set configUSE_QUEUE_ZERO_COPY to 1 to include xQueueAcquireSlot(),
+ * xQueueCommitSlot(), xQueuePeekSlot() and xQueueReleaseSlot(), which let
+ * tasks write and read queue items in place in the queue storage. */
+#ifndef configUSE_QUEUE_ZERO_COPY
+    #define configUSE_QUEUE_ZERO_COPY    0
+#endif
+
+/* Set configQUEUE_LOW_LATENCY_COPY_BYTES to a non-zero value to have tasks
+ * copy queue items of at least that many bytes into and out of the queue with
+ * the scheduler suspended rather than with interrupts masked, which shortens
+ * the longest time the kernel masks interrupts.  While a task is copying, an
+ * interrupt that writes to or reads from the same queue finds it full or empty.
+ * Leave at 0 to always copy items with interrupts masked. */
+#ifndef configQUEUE_LOW_LATENCY_COPY_BYTES
+    #define configQUEUE_LOW_LATENCY_COPY_BYTES    0
+#endif
+
+#if ( ( configQUEUE_LOW_LATENCY_COPY_BYTES > 0 ) && ( configUSE_QUEUE_ZERO_COPY != 1 ) )
+    #error configUSE_QUEUE_ZERO_COPY must be set to 1 when configQUEUE_LOW_LATENCY_COPY_BYTES is not 0
+#endif
+
+/* The routine used to copy queue items and stream buffer data, which must
+ * behave as memcpy() does.  Define configCOPY_BYTES() in FreeRTOSConfig.h to
+ * use a copy routine tuned for the target instead of the C library's. */
+#ifndef configCOPY_BYTES
+    #define configCOPY_BYTES( pvDestination, pvSource, xBytes )    ( void ) memcpy( ( pvDestination ), ( pvSource ), ( xBytes ) )
+#endif
+
+/* Set configUSE_QUEUE_WORD_COPY to 1 to copy queue items whose size is a
+ * multiple of 4 bytes as 32-bit words, when both the item and the queue
+ * storage are 4 byte aligned, rather than with configCOPY_BYTES(), which may
+ * copy a byte at a time on small targets. */
+#ifndef configUSE_QUEUE_WORD_COPY
+    #define configUSE_QUEUE_WORD_COPY    0
+#endif
+
+/* Set configQUEUE_ASYNC_COPY_BYTES to a non-zero value to have tasks copy queue
+ * items of at least that many bytes into and out of the queue with
+ * configQUEUE_ASYNC_COPY_START( pvDestination, pvSource, xBytes, xTask ), which
+ * the application defines to start a copy by a DMA engine.  It returns pdTRUE
+ * if the copy was started, in which case the copying task blocks until the
+ * copy's completion interrupt gives it the notification at index
+ * configQUEUE_ASYNC_COPY_NOTIFY_INDEX, for example with
+ * vTaskNotifyGiveIndexedFromISR(), or pdFALSE to have the kernel copy the item
+ * itself.  A task that receives the item is only woken once the copy into the
+ * queue completes.  While a copy is in progress the queue behaves as if it is
+ * full to other senders, or empty to other receivers.  Leave at 0 to always
+ * copy items on the CPU. */
+#ifndef configQUEUE_ASYNC_COPY_BYTES
+    #define configQUEUE_ASYNC_COPY_BYTES    0
+#endif
+
+/* The index of the task notification used to wait for an asynchronous copy. */
+#ifndef configQUEUE_ASYNC_COPY_NOTIFY_INDEX
+    #define configQUEUE_ASYNC_COPY_NOTIFY_INDEX    ( configTASK_NOTIFICATION_ARRAY_ENTRIES - 1 )
+#endif
+
+#if ( configQUEUE_ASYNC_COPY_BYTES > 0 )
+    #if ( configUSE_QUEUE_ZERO_COPY != 1 )
+        #error configUSE_QUEUE_ZERO_COPY must be set to 1 when configQUEUE_ASYNC_COPY_BYTES is not 0
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetSchedulerState != 1 ) && ( configUSE_TIMERS != 1 ) )
+        #error INCLUDE_xTaskGetSchedulerState must be set to 1 when configQUEUE_ASYNC_COPY_BYTES is not 0
+    #endif
+
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle != 1 ) && ( configUSE_MUTEXES != 1 ) )
+        #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 when configQUEUE_ASYNC_COPY_BYTES is not 0
+    #endif
+
+    #ifndef configQUEUE_ASYNC_COPY_START
+        #error configQUEUE_ASYNC_COPY_START() must be defined when configQUEUE_ASYNC_COPY_BYTES is not 0
+    #endif
+#endif
+
+/* Set configUSE_QUEUE_STATS to 1 to keep per queue usage statistics - the high
+ * water mark, item and failure counts, blocked times and item residency - which
+ * are read with vQueueGetStats(). */
+#ifndef configUSE_QUEUE_STATS
+    #define configUSE_QUEUE_STATS    0
+#endif
+
+/* Set configUSE_SEMAPHORE_FAST_PATH to 1 to give and take counting semaphores
+ * with a single atomic compare-and-swap of the count, without entering a
+ * critical section, when no task is waiting for the semaphore to be given
+ * or taken.  Only counting semaphores with a maximum count greater than 1 that
+ * are not in a queue set take the fast path.  The fast path relies on no
+ * other task being part way through blocking on the semaphore, which is only
+ * guaranteed with a single core, and it does not update the statistics kept
+ * when configUSE_QUEUE_STATS is 1. */
+#ifndef configUSE_SEMAPHORE_FAST_PATH
+    #define configUSE_SEMAPHORE_FAST_PATH    0
+#endif
+
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_SEMAPHORE_FAST_PATH can only be used when configNUMBER_OF_CORES is 1.
+    #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        #error configUSE_SEMAPHORE_FAST_PATH cannot be used when configUSE_QUEUE_STATS is 1.
+    #endif
+#endif
+
+/* Set configUSE_GRANULAR_LOCKS to 1 to give each queue and semaphore its own
+ * spinlock when configNUMBER_OF_CORES is greater than 1, so cores sending to
+ * and receiving from different queues do not serialise on the kernel's locks.
+ * A send or receive that neither wakes nor blocks a task, on a queue that is
+ * not locked, not a mutex, not in a queue set, not a priority queue and has
+ * no zero-copy slot held, takes only the queue's spinlock.  Everything else
+ * takes the task and ISR locks, then the queue's spinlock, in that order.  The
+ * port must provide portSPINLOCK_TYPE, portINIT_SPINLOCK(),
+ * portGET_SPINLOCK() and portRELEASE_SPINLOCK(). */
+#ifndef configUSE_GRANULAR_LOCKS
+    #define configUSE_GRANULAR_LOCKS    0
+#endif
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    #if ( configNUMBER_OF_CORES < 2 )
+        #error configUSE_GRANULAR_LOCKS can only be used when configNUMBER_OF_CORES is greater than 1.
+    #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        #error configUSE_GRANULAR_LOCKS cannot be used when configUSE_QUEUE_STATS is 1.
+    #endif
+#endif
+
+/* Set configUSE_QUEUE_DIRECT_BLOCKING to 1 to have xQueueReceive() and
+ * xSemaphoreTake() block on an empty queue or unavailable semaphore from
+ * within the critical section that found it empty, instead of suspending the
+ * scheduler, locking the queue and checking the timeout before blocking.  The
+ * remaining block time is then only calculated if the task is woken without
+ * receiving.  Blocking in a critical section is only safe with a single
+ * core. */
+#ifndef configUSE_QUEUE_DIRECT_BLOCKING
+    #define configUSE_QUEUE_DIRECT_BLOCKING    0
+#endif
+
+#if ( ( configUSE_QUEUE_DIRECT_BLOCKING == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configUSE_QUEUE_DIRECT_BLOCKING can only be used when configNUMBER_OF_CORES is 1.
+#endif
+
+/* Set configUSE_QUEUE_DIRECT_HANDOFF to 1 to have xQueueSend() copy an item
+ * straight into the buffer of a task blocked in xQueueReceive() on the empty
+ * queue, instead of copying it into the queue's storage for the receiving task
+ * to copy out again.  Items that are sent with interrupts enabled because they
+ * are at least configQUEUE_LOW_LATENCY_COPY_BYTES long, and items sent from
+ * interrupts, still go through the queue's storage. */
+#ifndef configUSE_QUEUE_DIRECT_HANDOFF
+    #define configUSE_QUEUE_DIRECT_HANDOFF    0
+#endif
+
+/* Set configUSE_QUEUE_RENDEZVOUS to 1 to include rendezvous channels, created
+ * with xQueueCreateRendezvous().  A rendezvous channel has no storage - a
+ * sending task blocks until a receiving task copies the item straight out of
+ * the sender's buffer.  The sender and receiver find each other on the queue's
+ * event lists, which is only safe with a single core. */
+#ifndef configUSE_QUEUE_RENDEZVOUS
+    #define configUSE_QUEUE_RENDEZVOUS    0
+#endif
+
+#if ( ( configUSE_QUEUE_RENDEZVOUS == 1 ) && ( configUSE_QUEUE_DIRECT_HANDOFF != 1 ) )
+    #error configUSE_QUEUE_RENDEZVOUS requires configUSE_QUEUE_DIRECT_HANDOFF to be set to 1
+#endif
+
+#if ( ( configUSE_QUEUE_RENDEZVOUS == 1 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configUSE_QUEUE_RENDEZVOUS can only be used when configNUMBER_OF_CORES is 1.
+#endif
+
+/* Set configUSE_QUEUE_WAIT_ORDER to 1 to include xQueueSetWaitOrder(), which
+ * lets the tasks blocked on a queue or semaphore be woken in the order in
+ * which they blocked rather than in priority order.  Adding a task to the end
+ * of a wait list takes constant time, whereas keeping the list in priority
+ * order takes time proportional to the number of tasks waiting. */
+#ifndef configUSE_QUEUE_WAIT_ORDER
+    #define configUSE_QUEUE_WAIT_ORDER    0
+#endif
+
+/* Set configUSE_OVERFLOW_POLICY to 1 to include xQueueSetOverflowPolicy() and
+ * xStreamBufferSetOverflowPolicy(), which choose what an interrupt that finds a
+ * queue or stream buffer full does with the data, and to count the data each
+ * object drops, which uxQueueGetOverflowCount() and
+ * uxStreamBufferGetOverflowCount() read without a critical section. */
+#ifndef configUSE_OVERFLOW_POLICY
+    #define configUSE_OVERFLOW_POLICY    0
+#endif
+
+/* Set configUSE_TYPED_QUEUES to 1 to include vQueueSetItemCopyFunction() and
+ * the queueDECLARE_TYPED_QUEUE() and queueDEFINE_TYPED_QUEUE() macros, which
+ * generate queue functions for a single item type that copy items with a size
+ * known at compile time. */
+#ifndef configUSE_TYPED_QUEUES
+    #define configUSE_TYPED_QUEUES    0
+#endif
+
+/* Set configQUEUE_MESSAGE_PRIORITIES to the number of message priorities to
+ * include priority ordered queues, created with xQueueCreatePriority() and
+ * written with xQueueSendWithPriority().  Leave at 0 to exclude them. */
+#ifndef configQUEUE_MESSAGE_PRIORITIES
+    #define configQUEUE_MESSAGE_PRIORITIES    0
+#endif
+
+#if ( configQUEUE_MESSAGE_PRIORITIES > 254 )
+    #error configQUEUE_MESSAGE_PRIORITIES must not exceed 254
+#endif
+
+/* Set configUSE_QUEUE_SET_BITMAP to 1 to have queue sets track which members
+ * contain data in a bitmap, rather than queue an event for every item posted
+ * to a member. */
+#ifndef configUSE_QUEUE_SET_BITMAP
+    #define configUSE_QUEUE_SET_BITMAP    0
+#endif
+
+#if ( ( configUSE_QUEUE_SET_BITMAP == 1 ) && ( configUSE_QUEUE_SETS != 1 ) )
+    #error configUSE_QUEUE_SET_BITMAP requires configUSE_QUEUE_SETS to be set to 1
+#endif
+
+/* On multi core parts, set configSEMAPHORE_SPIN_COUNT to the number of times
+ * xQueueSemaphoreTake() polls an unavailable semaphore before it blocks.  A
+ * mutex is only polled while its holder is running on another core.  Has no
+ * effect when configNUMBER_OF_CORES is 1. */
+#ifndef configSEMAPHORE_SPIN_COUNT
+    #define configSEMAPHORE_SPIN_COUNT    0
+#endif
+
+/* Set to 1 to include xTaskGenericNotifyWaitSpin(), which polls for a
+ * notification a bounded number of times, given per call, before blocking. */
+#ifndef configUSE_TASK_NOTIFY_SPIN
+    #define configUSE_TASK_NOTIFY_SPIN    0
+#endif
+
+#ifndef portTASK_USES_FLOATING_POINT
+    #define portTASK_USES_FLOATING_POINT()
+#endif
+
+#ifndef portALLOCATE_SECURE_CONTEXT
+    #define portALLOCATE_SECURE_CONTEXT( ulSecureStackSize )
+#endif
+
+#ifndef portDONT_DISCARD
+    #define portDONT_DISCARD
+#endif
+
+/* Define configKERNEL_FAST_SECTION as the name of a section, for example
+ * ".ramfunc", to place the kernel functions that run on every tick, context
+ * switch, and queue or semaphore operation in that section, so the linker
+ * script can locate them in ITCM or RAM instead of in flash with wait states.
+ * The linker script must also copy the section to its run address during
+ * startup.  GCC and compatible compilers use a section attribute; ports or
+ * FreeRTOSConfig.h can define FREERTOS_FAST_FUNCTION for other compilers. */
+#ifndef FREERTOS_FAST_FUNCTION
+    #if !defined( configKERNEL_FAST_SECTION )
+        #define FREERTOS_FAST_FUNCTION
+    #elif defined( __GNUC__ )
+        #define FREERTOS_FAST_FUNCTION    __attribute__( ( section( configKERNEL_FAST_SECTION ) ) )
+    #else
+        #error configKERNEL_FAST_SECTION is defined but this compiler has no default FREERTOS_FAST_FUNCTION.  Define FREERTOS_FAST_FUNCTION in FreeRTOSConfig.h to place a function in the section.
+    #endif
+#endif
+
+#if ( defined( configKERNEL_FAST_SECTION ) && ( portUSING_MPU_WRAPPERS == 1 ) )
+    #error configKERNEL_FAST_SECTION cannot be used with MPU ports as the kernel functions must be in the privileged_functions section
+#endif
+
+#ifndef configUSE_TIME_SLICING
+    #define configUSE_TIME_SLICING    1
+#endif
+
+/* The number of ticks a task runs for before a task of equal priority is
+ * selected, when configUSE_TIME_SLICING is 1. */
+#ifndef configTIME_SLICE_TICKS
+    #define configTIME_SLICE_TICKS    1
+#endif
+
+#if ( configTIME_SLICE_TICKS < 1 )
+    #error configTIME_SLICE_TICKS must be at least 1.
+#endif
+
+/* The most tasks xTaskResumeAll() moves from the pending ready list to the
+ * ready lists in one critical section.  Tasks readied by interrupts while the
+ * scheduler was suspended are then moved in batches, with interrupts enabled
+ * between them, rather than all at once.  0 moves them all at once. */
+#ifndef configPENDING_READY_BATCH_SIZE
+    #define configPENDING_READY_BATCH_SIZE    0
+#endif
+
+#if ( ( configPENDING_READY_BATCH_SIZE > 0 ) && ( configNUMBER_OF_CORES > 1 ) )
+    #error configPENDING_READY_BATCH_SIZE is only supported when configNUMBER_OF_CORES is 1.
+#endif
+
+/* Set configUSE_TASK_POOLS to 1 to include the task pool API in task_pool.h,
+ * which runs short jobs on a fixed set of pre-created worker tasks. */
+#ifndef configUSE_TASK_POOLS
+    #define configUSE_TASK_POOLS    0
+#endif
+
+/* Set configUSE_ASYNC_TASKS to 1 to include the async task API in
+ * async_task.h, which runs stackless coroutines on the stack of a host task. */
+#ifndef configUSE_ASYNC_TASKS
+    #define configUSE_ASYNC_TASKS    0
+#endif
+
+/* The number of priorities available to the async tasks of each executor. */
+#ifndef configMAX_ASYNC_TASK_PRIORITIES
+    #define configMAX_ASYNC_TASK_PRIORITIES    4
+#endif
+
+#if ( ( configUSE_ASYNC_TASKS == 1 ) && ( configMAX_ASYNC_TASK_PRIORITIES < 1 ) )
+    #error configMAX_ASYNC_TASK_PRIORITIES must be at least 1.
+#endif
+
+/* Set configUSE_SHARED_STACK_TASKS to 1 to include the API in shared_stack.h,
+ * which runs run-to-completion tasks of the same priority on one stack. */
+#ifndef configUSE_SHARED_STACK_TASKS
+    #define configUSE_SHARED_STACK_TASKS    0
+#endif
+
+/* Set configUSE_ACTIVE_OBJECTS to 1 to include the active object API in
+ * active_object.h, which dispatches reference counted events to active
+ * objects that share dispatcher tasks. */
+#ifndef configUSE_ACTIVE_OBJECTS
+    #define configUSE_ACTIVE_OBJECTS    0
+#endif
+
+/* Set configUSE_DEFERRED_INTERRUPTS to 1 to include the API in
+ * deferred_interrupt.h, which calls interrupt handlers registered with a
+ * priority from one service task for each priority. */
+#ifndef configUSE_DEFERRED_INTERRUPTS
+    #define configUSE_DEFERRED_INTERRUPTS    0
+#endif
+
+/* The stack size, in words, of each deferred interrupt service task.  It must
+ * be large enough for the deepest handler of the service task's priority. */
+#ifndef configDEFERRED_INTERRUPT_STACK_DEPTH
+    #define configDEFERRED_INTERRUPT_STACK_DEPTH    configMINIMAL_STACK_SIZE
+#endif
+
+/* Set configUSE_BROADCAST_RINGS to 1 to include the API in broadcast_ring.h,
+ * which passes a stream of items from one writer to any number of subscribers,
+ * each of which has its own read cursor, copying each item into the ring only
+ * once. */
+#ifndef configUSE_BROADCAST_RINGS
+    #define configUSE_BROADCAST_RINGS    0
+#endif
+
+/* Set configUSE_BUFFER_POOLS to 1 to include the buffer pool API in
+ * buffer_pool.h, which passes reference counted data buffers between tasks
+ * without copying them. */
+#ifndef configUSE_BUFFER_POOLS
+    #define configUSE_BUFFER_POOLS    0
+#endif
+
+/* Set configUSE_ELASTIC_QUEUES to 1 to include the elastic queue API in
+ * elastic_queue.h, which holds queued items in segments taken from a buffer
+ * pool as they are needed, instead of allocating each queue's storage for its
+ * maximum length up front. */
+#ifndef configUSE_ELASTIC_QUEUES
+    #define configUSE_ELASTIC_QUEUES    0
+#endif
+
+/* Set configUSE_AMP_CHANNELS to 1 to include the API in amp_channel.h, which
+ * passes messages between cores that run separate instances of the kernel
+ * through shared memory.  The application must then define
+ * configAMP_RING_DOORBELL( uxDoorbell ) to raise the inter-core interrupt
+ * identified by uxDoorbell on the other core. */
+#ifndef configUSE_AMP_CHANNELS
+    #define configUSE_AMP_CHANNELS    0
+#endif
+
+/* The size in bytes of the largest data cache line of either core.  The
+ * control block each core writes is placed in a cache line of its own, so
+ * cache maintenance by one core never discards the other core's updates. */
+#ifndef configAMP_CACHE_LINE_SIZE
+    #define configAMP_CACHE_LINE_SIZE    32
+#endif
+
+#if ( ( configUSE_AMP_CHANNELS == 1 ) && ( ( configAMP_CACHE_LINE_SIZE < 8 ) || ( ( configAMP_CACHE_LINE_SIZE & ( configAMP_CACHE_LINE_SIZE - 1 ) ) != 0 ) ) )
+    #error configAMP_CACHE_LINE_SIZE must be a power of 2 that is at least 8.
+#endif
+
+/* Clean (write back) and invalidate the data cache over a range of shared
+ * memory.  Leave both undefined if the shared memory is not cached, or if the
+ * cores' caches are coherent. */
+#ifndef configAMP_CACHE_CLEAN
+    #define configAMP_CACHE_CLEAN( pvAddress, xLength )
+#endif
+
+#ifndef configAMP_CACHE_INVALIDATE
+    #define configAMP_CACHE_INVALIDATE( pvAddress, xLength )
+#endif
+
+/* Set configUSE_POST_MORTEM_SNAPSHOT to 1 to include the API in
+ * post_mortem.h, which a fault handler can call to save a compact binary
+ * snapshot of the kernel's state for later analysis. */
+#ifndef configUSE_POST_MORTEM_SNAPSHOT
+    #define configUSE_POST_MORTEM_SNAPSHOT    0
+#endif
+
+/* The number of stack words, starting at each task's saved stack pointer,
+ * included in the snapshot. */
+#ifndef configPOST_MORTEM_STACK_WINDOW_WORDS
+    #define configPOST_MORTEM_STACK_WINDOW_WORDS    16
+#endif
+
+/* The most free heap blocks included in the snapshot.  0 leaves the heap out
+ * of the snapshot, in which case the heap need not provide
+ * vPortWalkFreeBlocks(). */
+#ifndef configPOST_MORTEM_MAX_FREE_BLOCKS
+    #define configPOST_MORTEM_MAX_FREE_BLOCKS    32
+#endif
+
+/* The number of the most recent trace recorder records from each core
+ * included in the snapshot when configUSE_TRACE_RECORDER is 1. */
+#ifndef configPOST_MORTEM_TRACE_RECORDS
+    #define configPOST_MORTEM_TRACE_RECORDS    32
+#endif
+
+/* Set configUSE_OBJECT_REGISTRY to 1 to link every queue, semaphore, mutex,
+ * stream buffer, message buffer, event group and timer into a registry from
+ * the time it is created to the time it is deleted, so the API in
+ * object_registry.h can walk them. */
+#ifndef configUSE_OBJECT_REGISTRY
+    #define configUSE_OBJECT_REGISTRY    0
+#endif
+
+/* A barrier that orders accesses to shared memory as seen by the other core,
+ * and completes any preceding cache maintenance.  portMEMORY_BARRIER() is only
+ * a compiler barrier on many ports, in which case this must be defined as the
+ * hardware barrier, for example __DSB() on Cortex-M. */
+#ifndef configAMP_MEMORY_BARRIER
+    #define configAMP_MEMORY_BARRIER()    portMEMORY_BARRIER()
+#endif
+
+/* Set configUSE_TASK_REAPER to 1 to have the scheduler create a reaper task
+ * that frees the TCB and stack of a task that deleted itself as soon as the
+ * reaper task is scheduled, instead of waiting for the idle task to run. */
+#ifndef configUSE_TASK_REAPER
+    #define configUSE_TASK_REAPER    0
+#endif
+
+#ifndef configTASK_REAPER_PRIORITY
+    #define configTASK_REAPER_PRIORITY    ( configMAX_PRIORITIES - 1 )
+#endif
+
+#ifndef configTASK_REAPER_STACK_DEPTH
+    #define configTASK_REAPER_STACK_DEPTH    configMINIMAL_STACK_SIZE
+#endif
+
+#if ( configUSE_TASK_REAPER == 1 )
+    #if ( INCLUDE_vTaskDelete != 1 )
+        #error configUSE_TASK_REAPER requires INCLUDE_vTaskDelete to be set to 1.
+    #endif
+
+    #if ( ( configTASK_REAPER_PRIORITY < 1 ) || ( configTASK_REAPER_PRIORITY >= configMAX_PRIORITIES ) )
+        #error configTASK_REAPER_PRIORITY must be between 1 and ( configMAX_PRIORITIES - 1 ).
+    #endif
+#endif
+
+/* Set configUSE_PER_PRIORITY_TIME_SLICE to 1 to allow the time slice length of
+ * each priority to be set with vTaskSetTimeSliceLength(). */
+#ifndef configUSE_PER_PRIORITY_TIME_SLICE
+    #define configUSE_PER_PRIORITY_TIME_SLICE    0
+#endif
+
+#ifndef configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS
+    #define configINCLUDE_APPLICATION_DEFINED_PRIVILEGED_FUNCTIONS    0
+#endif
+
+/* Set configUSE_MPU_SYSTEM_CALL_TABLE to 1 to have the most frequently used
+ * MPU wrappers enter the kernel through a single SVC that dispatches through a
+ * table of argument checking implementations, instead of raising and then
+ * resetting the privilege level around a direct call.  Only ports that define
+ * portHAS_MPU_SYSTEM_CALL_TABLE to 1 support this. */
+#ifndef configUSE_MPU_SYSTEM_CALL_TABLE
+    #define configUSE_MPU_SYSTEM_CALL_TABLE    0
+#endif
+
+#ifndef portHAS_MPU_SYSTEM_CALL_TABLE
+    #define portHAS_MPU_SYSTEM_CALL_TABLE    0
+#endif
+
+#if ( ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 ) && ( ( portUSING_MPU_WRAPPERS == 0 ) || ( portHAS_MPU_SYSTEM_CALL_TABLE == 0 ) ) )
+    #error configUSE_MPU_SYSTEM_CALL_TABLE can only be set to 1 when using an MPU port that provides a system call table.
+#endif
+
+/* Set configENABLE_ACCESS_CONTROL_LIST to 1 to have the MPU wrappers only let
+ * an unprivileged task use the kernel objects, and act on the other tasks, that
+ * it created or was granted access to with vGrantAccessToKernelObject().
+ * configPROTECTED_KERNEL_OBJECT_POOL_SIZE is the number of tasks and objects
+ * that can take part, and must be a power of 2. */
+#ifndef configENABLE_ACCESS_CONTROL_LIST
+    #define configENABLE_ACCESS_CONTROL_LIST    0
+#endif
+
+#ifndef configPROTECTED_KERNEL_OBJECT_POOL_SIZE
+    #define configPROTECTED_KERNEL_OBJECT_POOL_SIZE    32
+#endif
+
+#if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+    #if ( portUSING_MPU_WRAPPERS == 0 )
+        #error configENABLE_ACCESS_CONTROL_LIST can only be set to 1 when using an MPU port.
+    #endif
+
+    #if ( ( configPROTECTED_KERNEL_OBJECT_POOL_SIZE < 2 ) || ( ( configPROTECTED_KERNEL_OBJECT_POOL_SIZE & ( configPROTECTED_KERNEL_OBJECT_POOL_SIZE - 1 ) ) != 0 ) )
+        #error configPROTECTED_KERNEL_OBJECT_POOL_SIZE must be a power of 2.
+    #endif
+
+    #if ( INCLUDE_xTaskGetCurrentTaskHandle == 0 )
+        #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 when configENABLE_ACCESS_CONTROL_LIST is 1.
+    #endif
+#endif
+
+#ifndef configUSE_STATS_FORMATTING_FUNCTIONS
+    #define configUSE_STATS_FORMATTING_FUNCTIONS    0
+#endif
+
+#ifndef portASSERT_IF_INTERRUPT_PRIORITY_INVALID
+    #define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()
+#endif
+
+#ifndef configUSE_TRACE_FACILITY
+    #define configUSE_TRACE_FACILITY    0
+#endif
+
+#ifndef mtCOVERAGE_TEST_MARKER
+    #define mtCOVERAGE_TEST_MARKER()
+#endif
+
+#ifndef mtCOVERAGE_TEST_DELAY
+    #define mtCOVERAGE_TEST_DELAY()
+#endif
+
+#ifndef portASSERT_IF_IN_ISR
+    #define portASSERT_IF_IN_ISR()
+#endif
+
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+    #define configUSE_PORT_OPTIMISED_TASK_SELECTION    0
+#endif
+
+/* Set configUSE_BITMAP_TASK_SELECTION to 1 to select the highest priority ready
+ * task using a portable two level bitmap and lookup table, rather than by
+ * searching down through the ready lists.  This is intended for architectures
+ * that do not have a count leading zeros instruction, so cannot use
+ * configUSE_PORT_OPTIMISED_TASK_SELECTION, and for more than 32 priorities. */
+#ifndef configUSE_BITMAP_TASK_SELECTION
+    #define configUSE_BITMAP_TASK_SELECTION    0
+#endif
+
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+        #error configUSE_BITMAP_TASK_SELECTION and configUSE_PORT_OPTIMISED_TASK_SELECTION cannot both be set to 1.
+    #endif
+
+    #if ( configMAX_PRIORITIES > 64 )
+        #error configMAX_PRIORITIES cannot be more than 64 when configUSE_BITMAP_TASK_SELECTION is set to 1.
+    #endif
+#endif
+
+/* configNUMBER_OF_CORES defines the number of processor cores the scheduler
+ * runs tasks on.  A value greater than 1 builds the symmetric multiprocessing
+ * (SMP) scheduler, in which a single kernel instance schedules tasks across
+ * all the cores and each core runs the highest priority ready task that is
+ * not already running on another core. */
+#ifndef configNUMBER_OF_CORES
+    #define configNUMBER_OF_CORES    1
+#endif
+
+#if ( configNUMBER_OF_CORES < 1 )
+    #error configNUMBER_OF_CORES must be defined to be greater than or equal to 1.
+#endif
+
+#ifndef portGET_CORE_ID
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define portGET_CORE_ID()    0
+    #else
+        #error configNUMBER_OF_CORES is set to more than 1 then portGET_CORE_ID must also be defined.
+    #endif
+#endif
+
+#ifndef portYIELD_CORE
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define portYIELD_CORE( x )    portYIELD()
+    #else
+        #error configNUMBER_OF_CORES is set to more than 1 then portYIELD_CORE must also be defined.
+    #endif
+#endif
+
+#if ( portSTACK_POOL_GUARD_SIZE > 0 )
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error Stack pool guard regions are only supported when configNUMBER_OF_CORES is 1.  Set configSTACK_POOL_GUARDS to 0.
+    #endif
+
+    #ifndef portSET_STACK_GUARD
+        #error The port sets portSTACK_GUARD_SIZE so must also define portSET_STACK_GUARD().
+    #endif
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* The SMP scheduler serialises access to its data structures using two
+ * spinlocks that must be provided by the port.  The task lock is held while
+ * the scheduler is suspended and while in a task level critical section.  The
+ * ISR lock is held while in any critical section, including the interrupt safe
+ * critical sections used by FromISR() API functions.  The task lock is always
+ * obtained before the ISR lock, and both locks must be recursive as a core that
+ * has suspended the scheduler can also enter a critical section, and the
+ * reverse. */
+    #ifndef portGET_TASK_LOCK
+        #error configNUMBER_OF_CORES is set to more than 1 then portGET_TASK_LOCK must also be defined.
+    #endif
+
+    #ifndef portRELEASE_TASK_LOCK
+        #error configNUMBER_OF_CORES is set to more than 1 then portRELEASE_TASK_LOCK must also be defined.
+    #endif
+
+    #ifndef portGET_ISR_LOCK
+        #error configNUMBER_OF_CORES is set to more than 1 then portGET_ISR_LOCK must also be defined.
+    #endif
+
+    #ifndef portRELEASE_ISR_LOCK
+        #error configNUMBER_OF_CORES is set to more than 1 then portRELEASE_ISR_LOCK must also be defined.
+    #endif
+
+/* Critical section nesting is per core, not per task, so must be held by the
+ * port. */
+    #ifndef portGET_CRITICAL_NESTING_COUNT
+        #error configNUMBER_OF_CORES is set to more than 1 then portGET_CRITICAL_NESTING_COUNT must also be defined.
+    #endif
+
+    #ifndef portINCREMENT_CRITICAL_NESTING_COUNT
+        #error configNUMBER_OF_CORES is set to more than 1 then portINCREMENT_CRITICAL_NESTING_COUNT must also be defined.
+    #endif
+
+    #ifndef portDECREMENT_CRITICAL_NESTING_COUNT
+        #error configNUMBER_OF_CORES is set to more than 1 then portDECREMENT_CRITICAL_NESTING_COUNT must also be defined.
+    #endif
+
+    #ifndef portENTER_CRITICAL_FROM_ISR
+        #error configNUMBER_OF_CORES is set to more than 1 then portENTER_CRITICAL_FROM_ISR must also be defined.
+    #endif
+
+    #ifndef portEXIT_CRITICAL_FROM_ISR
+        #error configNUMBER_OF_CORES is set to more than 1 then portEXIT_CRITICAL_FROM_ISR must also be defined.
+    #endif
+
+    #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+        #error configUSE_PORT_OPTIMISED_TASK_SELECTION is not supported when configNUMBER_OF_CORES is set to more than 1.
+    #endif
+
+    #if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+        #error configUSE_BITMAP_TASK_SELECTION is not supported when configNUMBER_OF_CORES is set to more than 1.
+    #endif
+
+/* With tickless idle an idle core halts in portWAIT_FOR_INTERRUPT() while any
+ * other core is busy, and the last core to go idle suppresses the tick for
+ * all of them with portSUPPRESS_TICKS_AND_SLEEP().  portWAIT_FOR_INTERRUPT() is
+ * called with interrupts masked, and must return once an interrupt is pending
+ * without taking it.  portSUPPRESS_TICKS_AND_SLEEP() must stop the tick on
+ * every core, and end the sleep when its core is interrupted, including by
+ * portYIELD_CORE(), as the first of the other cores to wake does that so the
+ * sleeping core corrects the tick count once.  Idle cores are only woken when
+ * they are sent a task to run if configUSE_PREEMPTION is 1. */
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+        #ifndef portWAIT_FOR_INTERRUPT
+            #error configUSE_TICKLESS_IDLE is not 0 and configNUMBER_OF_CORES is set to more than 1 then portWAIT_FOR_INTERRUPT must also be defined.
+        #endif
+
+        #if ( configUSE_PREEMPTION == 0 )
+            #error configUSE_TICKLESS_IDLE requires configUSE_PREEMPTION to be set to 1 when configNUMBER_OF_CORES is set to more than 1.
+        #endif
+    #endif
+
+    #if ( portCRITICAL_NESTING_IN_TCB == 1 )
+        #error portCRITICAL_NESTING_IN_TCB is not supported when configNUMBER_OF_CORES is set to more than 1.
+    #endif
+
+/* The spinlocks used by configUSE_GRANULAR_LOCKS are not recursive, and are
+ * only ever obtained with interrupts masked, after the task and ISR locks if
+ * those are held at all. */
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        #ifndef portSPINLOCK_TYPE
+            #error configUSE_GRANULAR_LOCKS is set to 1 then portSPINLOCK_TYPE must also be defined.
+        #endif
+
+        #ifndef portINIT_SPINLOCK
+            #error configUSE_GRANULAR_LOCKS is set to 1 then portINIT_SPINLOCK must also be defined.
+        #endif
+
+        #ifndef portGET_SPINLOCK
+            #error configUSE_GRANULAR_LOCKS is set to 1 then portGET_SPINLOCK must also be defined.
+        #endif
+
+        #ifndef portRELEASE_SPINLOCK
+            #error configUSE_GRANULAR_LOCKS is set to 1 then portRELEASE_SPINLOCK must also be defined.
+        #endif
+    #endif
+#endif /* if ( configNUMBER_OF_CORES > 1 ) */
+
+#ifndef configUSE_PASSIVE_IDLE_HOOK
+    #define configUSE_PASSIVE_IDLE_HOOK    0
+#endif
+
+/* Set configUSE_CORE_AFFINITY to 1 to be able to restrict the cores each task
+ * is allowed to run on. */
+#ifndef configUSE_CORE_AFFINITY
+    #define configUSE_CORE_AFFINITY    0
+#endif
+
+#if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+    #error configUSE_CORE_AFFINITY is not supported when configNUMBER_OF_CORES is set to 1.
+#endif
+
+/* Set configUSE_WAKE_AFFINITY to 1 to prefer the calling core when a task made
+ * ready could preempt either it or another core running a task of the same
+ * priority, so the task is started by a pending yield on the core that readied
+ * it instead of by an inter-processor interrupt.  The choice is only between
+ * cores that would already be preempted, so the highest priority ready tasks
+ * are still always the ones running.  The number of yields requested of other
+ * cores is then counted, and can be read with ulTaskGetCrossCoreYieldCount(). */
+#ifndef configUSE_WAKE_AFFINITY
+    #define configUSE_WAKE_AFFINITY    0
+#endif
+
+#if ( ( configUSE_WAKE_AFFINITY == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
+    #error configUSE_WAKE_AFFINITY is not supported when configNUMBER_OF_CORES is set to 1.
+#endif
+
+/* Set configUSE_CORE_RUN_TIME_STATS to 1 to break the run time statistics down
+ * by core.  The time each core spends running an idle task is accumulated, and
+ * read with ulTaskGetIdleRunTimeCounterForCore(), and each task records the
+ * cores it has run on and how many times it has moved between them, which
+ * uxTaskGetSystemState() reports. */
+#ifndef configUSE_CORE_RUN_TIME_STATS
+    #define configUSE_CORE_RUN_TIME_STATS    0
+#endif
+
+#if ( ( configUSE_CORE_RUN_TIME_STATS == 1 ) && ( ( configNUMBER_OF_CORES == 1 ) || ( configGENERATE_RUN_TIME_STATS == 0 ) ) )
+    #error configUSE_CORE_RUN_TIME_STATS requires configNUMBER_OF_CORES to be set to more than 1 and configGENERATE_RUN_TIME_STATS to be set to 1.
+#endif
+
+/* The core affinity mask given to tasks that are not created with one of the
+ * affinity create functions.  The idle tasks can always run on any core. */
+#ifndef configTASK_DEFAULT_CORE_AFFINITY
+    #define configTASK_DEFAULT_CORE_AFFINITY    tskNO_AFFINITY
+#endif
+
+#ifndef configAPPLICATION_ALLOCATED_HEAP
+    #define configAPPLICATION_ALLOCATED_HEAP    0
+#endif
+
+#ifndef configUSE_TASK_NOTIFICATIONS
+    #define configUSE_TASK_NOTIFICATIONS    1
+#endif
+
+#if ( ( configUSE_TASK_NOTIFY_SPIN == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_NOTIFY_SPIN requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+#if ( ( configQUEUE_ASYNC_COPY_BYTES > 0 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 when configQUEUE_ASYNC_COPY_BYTES is not 0
+#endif
+
+#ifndef configTASK_NOTIFICATION_ARRAY_ENTRIES
+    #define configTASK_NOTIFICATION_ARRAY_ENTRIES    1
+#endif
+
+#if configTASK_NOTIFICATION_ARRAY_ENTRIES < 1
+    #error configTASK_NOTIFICATION_ARRAY_ENTRIES must be at least 1
+#endif
+
+/* Set configUSE_TASK_MAILBOXES to 1 to include xTaskGenericMailboxSend() and
+ * xTaskGenericMailboxReceive(), which pass a single pointer to a task through
+ * one of its notification indexes without the overhead of a queue. */
+#ifndef configUSE_TASK_MAILBOXES
+    #define configUSE_TASK_MAILBOXES    0
+#endif
+
+#if ( ( configUSE_TASK_MAILBOXES == 1 ) && ( configUSE_TASK_NOTIFICATIONS != 1 ) )
+    #error configUSE_TASK_MAILBOXES requires configUSE_TASK_NOTIFICATIONS to be set to 1
+#endif
+
+/* Set configUSE_WAIT_ON_ADDRESS to 1 to include xTaskWaitOnAddress() and
+ * vTaskWakeAddress(), which block and wake tasks on the value of a 32-bit
+ * variable so synchronisation objects built by the application can block
+ * without a kernel object of their own.  Waiting tasks are held in one of
+ * configWAIT_ON_ADDRESS_LISTS lists, chosen by a hash of the address. */
+#ifndef configUSE_WAIT_ON_ADDRESS
+    #define configUSE_WAIT_ON_ADDRESS    0
+#endif
+
+#ifndef configWAIT_ON_ADDRESS_LISTS
+    #define configWAIT_ON_ADDRESS_LISTS    8
+#endif
+
+#if ( ( configUSE_WAIT_ON_ADDRESS == 1 ) && ( configWAIT_ON_ADDRESS_LISTS < 1 ) )
+    #error configWAIT_ON_ADDRESS_LISTS must be at least 1 when configUSE_WAIT_ON_ADDRESS is 1
+#endif
+
+#ifndef configUSE_POSIX_ERRNO
+    #define configUSE_POSIX_ERRNO    0
+#endif
+
+#ifndef configUSE_TASK_HEAP_ACCOUNTING
+
+/* Set to 1 to have heap_4.c and heap_5.c record which task allocated each
+ * block, count the heap bytes held by each task, and enforce the limits set by
+ * vTaskSetHeapQuota(). */
+    #define configUSE_TASK_HEAP_ACCOUNTING    0
+#endif
+
+#ifndef configUSE_ISR_WAKE_LATENCY_STATS
+
+/* Set to 1 to measure, for each task, the time from an interrupt unblocking
+ * the task to the task running.  See xTaskGetISRWakeLatencyStats(). */
+    #define configUSE_ISR_WAKE_LATENCY_STATS    0
+#endif
+
+#ifndef configISR_WAKE_LATENCY_BUCKETS
+
+/* The number of histogram buckets kept by each task when
+ * configUSE_ISR_WAKE_LATENCY_STATS is 1.  Bucket n counts latencies of 2^n to
+ * 2^(n+1)-1 run time counter ticks, and the last bucket also counts everything
+ * longer. */
+    #define configISR_WAKE_LATENCY_BUCKETS    16
+#endif
+
+#if ( ( configUSE_ISR_WAKE_LATENCY_STATS == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 ) )
+    #error configUSE_ISR_WAKE_LATENCY_STATS cannot be 1 if configGENERATE_RUN_TIME_STATS is 0 as the latency is measured with the run time counter
+#endif
+
+#if ( configISR_WAKE_LATENCY_BUCKETS < 1 )
+    #error configISR_WAKE_LATENCY_BUCKETS must be at least 1
+#endif
+
+#ifndef configUSE_PERIODIC_TASK_STATS
+
+/* Set to 1 for xTaskDelayUntil() to record, for each task that calls it, how
+ * late each release started and how often the task overran its period.  See
+ * vTaskGetPeriodicStats(). */
+    #define configUSE_PERIODIC_TASK_STATS    0
+#endif
+
+#ifndef configPERIODIC_TASK_STATS_BUCKETS
+
+/* The number of lateness histogram buckets kept by each task when
+ * configUSE_PERIODIC_TASK_STATS is 1.  Bucket n counts lateness of 2^n to
+ * 2^(n+1)-1 ticks, and the last bucket also counts everything later. */
+    #define configPERIODIC_TASK_STATS_BUCKETS    8
+#endif
+
+#ifndef configUSE_PERIODIC_OVERRUN_HOOK
+
+/* Set to 1 to have xTaskDelayUntil() call vApplicationTaskOverrunHook() when a
+ * task finds its next release has already passed. */
+    #define configUSE_PERIODIC_OVERRUN_HOOK    0
+#endif
+
+#if ( ( configUSE_PERIODIC_TASK_STATS == 1 ) && ( INCLUDE_xTaskDelayUntil == 0 ) )
+    #error configUSE_PERIODIC_TASK_STATS cannot be 1 if INCLUDE_xTaskDelayUntil is 0
+#endif
+
+#if ( ( configUSE_PERIODIC_OVERRUN_HOOK == 1 ) && ( configUSE_PERIODIC_TASK_STATS == 0 ) )
+    #error configUSE_PERIODIC_OVERRUN_HOOK cannot be 1 if configUSE_PERIODIC_TASK_STATS is 0
+#endif
+
+#if ( configPERIODIC_TASK_STATS_BUCKETS < 1 )
+    #error configPERIODIC_TASK_STATS_BUCKETS must be at least 1
+#endif
+
+#ifndef configUSE_WINDOWED_RUN_TIME_STATS
+
+/* Set to 1 to also record the run time of each task over a short, a medium
+ * and a long window, so the current CPU load can be reported rather than only
+ * the average since boot.  See ulTaskGetWindowedRunTimeCounter(). */
+    #define configUSE_WINDOWED_RUN_TIME_STATS    0
+#endif
+
+#ifndef configRUN_TIME_WINDOW_PERIOD_TICKS
+
+/* The windows used when configUSE_WINDOWED_RUN_TIME_STATS is 1 are whole
+ * numbers of this period, which defaults to one second. */
+    #define configRUN_TIME_WINDOW_PERIOD_TICKS    ( ( TickType_t ) configTICK_RATE_HZ )
+#endif
+
+#ifndef configRUN_TIME_WINDOW_SHORT_PERIODS
+    #define configRUN_TIME_WINDOW_SHORT_PERIODS    1
+#endif
+
+#ifndef configRUN_TIME_WINDOW_MEDIUM_PERIODS
+    #define configRUN_TIME_WINDOW_MEDIUM_PERIODS    10
+#endif
+
+#ifndef configRUN_TIME_WINDOW_LONG_PERIODS
+    #define configRUN_TIME_WINDOW_LONG_PERIODS    60
+#endif
+
+#if ( ( configUSE_WINDOWED_RUN_TIME_STATS == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 ) )
+    #error configUSE_WINDOWED_RUN_TIME_STATS cannot be 1 if configGENERATE_RUN_TIME_STATS is 0
+#endif
+
+#if ( ( configRUN_TIME_WINDOW_SHORT_PERIODS < 1 ) || ( configRUN_TIME_WINDOW_MEDIUM_PERIODS < 1 ) || ( configRUN_TIME_WINDOW_LONG_PERIODS < 1 ) )
+    #error The configRUN_TIME_WINDOW_..._PERIODS lengths must each be at least 1
+#endif
+
+#ifndef configUSE_DVFS_GOVERNOR
+
+/* Set to 1 to have the tick interrupt measure the CPU load every
+ * configDVFS_PERIOD_TICKS ticks, from the run time of the idle task, and move
+ * between configDVFS_LEVELS performance levels with
+ * portSET_PERFORMANCE_LEVEL().  Level 0 is the slowest.  The highest level is
+ * selected as soon as the load reaches configDVFS_UP_THRESHOLD percent, and the
+ * level is lowered one step at a time while the load is at or below
+ * configDVFS_DOWN_THRESHOLD percent. */
+    #define configUSE_DVFS_GOVERNOR    0
+#endif
+
+#ifndef configDVFS_PERIOD_TICKS
+    #define configDVFS_PERIOD_TICKS    ( ( TickType_t ) ( ( configTICK_RATE_HZ + 19 ) / 20 ) )
+#endif
+
+#ifndef configDVFS_LEVELS
+    #define configDVFS_LEVELS    2
+#endif
+
+#ifndef configDVFS_UP_THRESHOLD
+    #define configDVFS_UP_THRESHOLD    80
+#endif
+
+#ifndef configDVFS_DOWN_THRESHOLD
+    #define configDVFS_DOWN_THRESHOLD    30
+#endif
+
+/* configDVFS_LEVEL_CLOCK_HZ( uxLevel ), if defined, gives the CPU clock
+ * frequency of each level.  The governor then calls portCPU_CLOCK_CHANGED()
+ * after each change, so the tick period is unaffected.  If the run time
+ * counter is also clocked by the CPU, define configDVFS_SCALED_RUN_TIME_COUNTER()
+ * to read it, and portGET_RUN_TIME_COUNTER_VALUE() as
+ * ulTaskGetDvfsRunTimeCounter(), which converts it to counts of the highest
+ * level's clock so run time statistics stay in one unit. */
+
+#if ( ( configUSE_DVFS_GOVERNOR == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 ) )
+    #error configUSE_DVFS_GOVERNOR cannot be 1 if configGENERATE_RUN_TIME_STATS is 0
+#endif
+
+#if ( configDVFS_LEVELS < 2 )
+    #error configDVFS_LEVELS must be at least 2
+#endif
+
+#if ( ( configDVFS_DOWN_THRESHOLD >= configDVFS_UP_THRESHOLD ) || ( configDVFS_UP_THRESHOLD > 100 ) )
+    #error configDVFS_DOWN_THRESHOLD must be below configDVFS_UP_THRESHOLD, which must be at most 100
+#endif
+
+#if ( defined( configDVFS_SCALED_RUN_TIME_COUNTER ) && !defined( configDVFS_LEVEL_CLOCK_HZ ) )
+    #error configDVFS_SCALED_RUN_TIME_COUNTER requires configDVFS_LEVEL_CLOCK_HZ to be defined
+#endif
+
+#ifndef configUSE_CRITICAL_SECTION_PROFILING
+
+/* Set to 1 to time every critical section entered with taskENTER_CRITICAL()
+ * or taskENTER_CRITICAL_FROM_ISR(), and every period for which the scheduler
+ * is suspended.  See vTaskGetCriticalSectionStats(). */
+    #define configUSE_CRITICAL_SECTION_PROFILING    0
+#endif
+
+#ifndef configCRITICAL_SECTION_PROFILING_BUCKETS
+
+/* The number of histogram buckets kept when configUSE_CRITICAL_SECTION_PROFILING
+ * is 1.  Bucket n counts durations of 2^n to 2^(n+1)-1 run time counter ticks,
+ * and the last bucket also counts everything longer. */
+    #define configCRITICAL_SECTION_PROFILING_BUCKETS    16
+#endif
+
+#if ( ( configUSE_CRITICAL_SECTION_PROFILING == 1 ) && ( configGENERATE_RUN_TIME_STATS == 0 ) )
+    #error configUSE_CRITICAL_SECTION_PROFILING cannot be 1 if configGENERATE_RUN_TIME_STATS is 0 as durations are measured with the run time counter
+#endif
+
+#if ( ( configUSE_CRITICAL_SECTION_PROFILING == 1 ) && ( portUSING_MPU_WRAPPERS == 1 ) )
+    #error configUSE_CRITICAL_SECTION_PROFILING cannot be used with MPU ports as unprivileged tasks can enter critical sections
+#endif
+
+#if ( configCRITICAL_SECTION_PROFILING_BUCKETS < 1 )
+    #error configCRITICAL_SECTION_PROFILING_BUCKETS must be at least 1
+#endif
+
+#ifndef configUSE_TASK_ITERATOR
+
+/* Set to 1 to include xTaskIteratorNext(), which reports the state of one
+ * task at a time without allocating memory or suspending the scheduler for a
+ * walk of every task list. */
+    #define configUSE_TASK_ITERATOR    0
+#endif
+
+#if ( ( configUSE_TASK_ITERATOR == 1 ) && ( configUSE_TRACE_FACILITY == 0 ) )
+    #error configUSE_TASK_ITERATOR cannot be 1 if configUSE_TRACE_FACILITY is 0
+#endif
+
+#ifndef configTASK_NAME_HASH_BUCKETS
+
+/* Set to a value above 0 to keep an index of task names, hashed into this
+ * many buckets, so xTaskGetHandle() only compares the names of the tasks in one
+ * bucket rather than walking every task list with the scheduler suspended. */
+    #define configTASK_NAME_HASH_BUCKETS    0
+#endif
+
+#if ( ( configTASK_NAME_HASH_BUCKETS > 0 ) && ( INCLUDE_xTaskGetHandle != 1 ) )
+    #error configTASK_NAME_HASH_BUCKETS requires INCLUDE_xTaskGetHandle to be set to 1
+#endif
+
+#if ( ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_NONE ) && ( INCLUDE_xTaskGetHandle == 1 ) )
+    #error INCLUDE_xTaskGetHandle cannot be 1 when configTASK_NAME_STORAGE is TASK_NAME_STORAGE_NONE.  Use TASK_NAME_STORAGE_REFERENCE to keep names in flash.
+#endif
+
+#ifndef portGET_RETURN_ADDRESS
+
+/* Returns the address to which the calling function will return.  Used to
+ * report where the longest critical section was entered.  GCC and compatible
+ * compilers provide a builtin; other compilers report NULL unless the port or
+ * FreeRTOSConfig.h provides an equivalent. */
+    #ifdef __GNUC__
+        #define portGET_RETURN_ADDRESS()    __builtin_return_address( 0 )
+    #else
+        #define portGET_RETURN_ADDRESS()    NULL
+    #endif
+#endif
+
+#ifndef configUSE_CYCLE_BENCHMARK
+
+/* Set to 1 to include vCycleBenchmarkRun() from portable/Common, which
+ * measures the cycle cost of common kernel operations on the target.  It needs
+ * a cycle counter, read with portGET_CYCLE_COUNT(). */
+    #define configUSE_CYCLE_BENCHMARK    0
+#endif
+
+#if ( configUSE_CYCLE_BENCHMARK == 1 )
+    #ifndef portGET_CYCLE_COUNT
+        #error configUSE_CYCLE_BENCHMARK is 1 but the port does not provide a cycle counter.  Define portGET_CYCLE_COUNT() in FreeRTOSConfig.h to read one.
+    #endif
+
+    #if ( ( INCLUDE_vTaskDelete == 0 ) || ( INCLUDE_vTaskDelay == 0 ) )
+        #error configUSE_CYCLE_BENCHMARK requires INCLUDE_vTaskDelete and INCLUDE_vTaskDelay to be 1
+    #endif
+
+    #if ( ( INCLUDE_uxTaskPriorityGet == 0 ) || ( INCLUDE_xTaskGetCurrentTaskHandle == 0 ) )
+        #error configUSE_CYCLE_BENCHMARK requires INCLUDE_uxTaskPriorityGet and INCLUDE_xTaskGetCurrentTaskHandle to be 1
+    #endif
+#endif
+
+#ifndef configUSE_HEAP_BENCHMARK
+
+/* Set to 1 to include vHeapBenchmarkRun() from portable/Common, which runs
+ * allocation patterns and traces against the heap implementation and reports
+ * their cost in cycles and the fragmentation they leave.  It reads the cycle
+ * counter with portGET_CYCLE_COUNT(). */
+    #define configUSE_HEAP_BENCHMARK    0
+#endif
+
+#ifndef configHEAP_BENCHMARK_MAX_BLOCKS
+
+/* The most blocks a heap benchmark pattern or trace can hold at once. */
+    #define configHEAP_BENCHMARK_MAX_BLOCKS    64
+#endif
+
+#if ( configUSE_HEAP_BENCHMARK == 1 )
+    #ifndef portGET_CYCLE_COUNT
+        #error configUSE_HEAP_BENCHMARK is 1 but the port does not provide a cycle counter.  Define portGET_CYCLE_COUNT() in FreeRTOSConfig.h to read one.
+    #endif
+
+    #if ( ( configHEAP_BENCHMARK_MAX_BLOCKS < 1 ) || ( configHEAP_BENCHMARK_MAX_BLOCKS > 65535 ) )
+        #error configHEAP_BENCHMARK_MAX_BLOCKS must be between 1 and 65535, as trace entries name blocks with a uint16_t
+    #endif
+#endif
+
+#ifndef configUSE_LATENCY_BENCHMARK
+
+/* Set to 1 to include vLatencyBenchmarkRun() from portable/Common, which
+ * measures the latency of an application interrupt, and of the task it wakes,
+ * under a configurable kernel load.  It reads the cycle counter with
+ * portGET_CYCLE_COUNT(). */
+    #define configUSE_LATENCY_BENCHMARK    0
+#endif
+
+#if ( configUSE_LATENCY_BENCHMARK == 1 )
+    #ifndef portGET_CYCLE_COUNT
+        #error configUSE_LATENCY_BENCHMARK is 1 but the port does not provide a cycle counter.  Define portGET_CYCLE_COUNT() in FreeRTOSConfig.h to read one.
+    #endif
+
+    #if ( ( INCLUDE_vTaskDelete == 0 ) || ( INCLUDE_vTaskDelay == 0 ) || ( INCLUDE_uxTaskPriorityGet == 0 ) )
+        #error configUSE_LATENCY_BENCHMARK requires INCLUDE_vTaskDelete, INCLUDE_vTaskDelay and INCLUDE_uxTaskPriorityGet to be 1
+    #endif
+
+    #if ( configUSE_TASK_NOTIFICATIONS == 0 )
+        #error configUSE_LATENCY_BENCHMARK requires configUSE_TASK_NOTIFICATIONS to be 1
+    #endif
+#endif
+
+#ifndef portENABLE_CYCLE_COUNTER
+
+/* Starts the counter read by portGET_CYCLE_COUNT() on ports where it does not
+ * run from reset. */
+    #define portENABLE_CYCLE_COUNTER()
+#endif
+
+#ifndef configUSE_SB_COMPLETED_CALLBACK
+
+/* By default per-instance callbacks are not enabled for stream buffer or message buffer. */
+    #define configUSE_SB_COMPLETED_CALLBACK    0
+#endif
+
+#ifndef configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS
+
+/* By default message buffers only support a single writer. */
+    #define configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_STATS
+
+/* By default stream buffers and message buffers do not keep the usage
+ * statistics read with vStreamBufferGetStats(). */
+    #define configUSE_STREAM_BUFFER_STATS    0
+#endif
+
+#ifndef configUSE_MESSAGE_BUFFER_EXPIRY
+
+/* Set to 1 to allow a message lifetime to be set on a message buffer with
+ * xMessageBufferSetMessageLifetime().  Each message is then stored with the
+ * tick count at which it was sent, messages older than the lifetime are
+ * discarded unread, and a writer that finds the message buffer full discards
+ * expired messages to make room rather than blocking. */
+    #define configUSE_MESSAGE_BUFFER_EXPIRY    0
+#endif
+
+#ifndef configUSE_FIXED_SIZE_MESSAGE_BUFFERS
+
+/* Set to 1 to allow message buffers to be created with
+ * xMessageBufferCreateFixedSize(), which only hold messages of the size given
+ * when the message buffer was created, so store no length with each message. */
+    #define configUSE_FIXED_SIZE_MESSAGE_BUFFERS    0
+#endif
+
+#ifndef configSTREAM_BUFFER_CACHE_LINE_BYTES
+
+/* Set to the size of a data cache line to keep the read and write indexes of
+ * each stream buffer in different cache lines, and to align the storage of
+ * power of two length stream buffers to a cache line.  0 leaves the stream
+ * buffer structure packed. */
+    #define configSTREAM_BUFFER_CACHE_LINE_BYTES    0
+#endif
+
+#ifndef configUSE_STREAM_BUFFER_CACHE_MAINTENANCE
+
+/* Set to 1 to allow stream buffers and message buffers to be created with
+ * sbTYPE_CACHE_MAINTAINED, in which case the kernel cleans and invalidates the
+ * data cache over the bytes it copies into and out of the buffer's storage
+ * area, so the storage area can be shared with a DMA controller while it stays
+ * in cacheable RAM.  Requires configSTREAM_BUFFER_CACHE_LINE_BYTES and a port
+ * that sets portHAS_DCACHE_MAINTENANCE to 1. */
+    #define configUSE_STREAM_BUFFER_CACHE_MAINTENANCE    0
+#endif
+
+#ifndef portHAS_DCACHE_MAINTENANCE
+
+/* Ports for parts with a data cache set this to 1 and define
+ * portCLEAN_DCACHE_BY_ADDRESS() and portINVALIDATE_DCACHE_BY_ADDRESS(). */
+    #define portHAS_DCACHE_MAINTENANCE    0
+#endif
+
+#if ( configUSE_STREAM_BUFFER_CACHE_MAINTENANCE == 1 )
+    #if ( portHAS_DCACHE_MAINTENANCE == 0 )
+        #error configUSE_STREAM_BUFFER_CACHE_MAINTENANCE is set to 1 but the port does not provide data cache maintenance.
+    #endif
+
+    #if ( configSTREAM_BUFFER_CACHE_LINE_BYTES == 0 )
+        #error configUSE_STREAM_BUFFER_CACHE_MAINTENANCE is set to 1 so configSTREAM_BUFFER_CACHE_LINE_BYTES must be set to the size of a data cache line.
+    #endif
+#endif
+
+#ifndef portHAS_NATIVE_ATOMICS
+
+/* Ports built with a compiler that provides the GCC __atomic built-in
+ * functions, for an architecture that has atomic read-modify-write
+ * instructions, set this to 1 so the functions in atomic.h use those
+ * instructions instead of masking interrupts. */
+    #define portHAS_NATIVE_ATOMICS    0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_WAIT_INDEX
+
+/* Set to 1 to give each event group a list of waiting tasks per event bit, so
+ * setting bits only visits tasks that the new bits could unblock.  Costs one
+ * list per event bit in every event group. */
+    #define configUSE_EVENT_GROUP_WAIT_INDEX    0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR
+
+/* Set to 1 to have xEventGroupSetBitsFromISR() set the bits, and unblock the
+ * waiting tasks, from within the interrupt rather than deferring the operation
+ * to the timer task.  The timer task is still used to unblock the tasks if a
+ * task is using the event group at the time, or if more than
+ * configEVENT_GROUP_DIRECT_SET_MAX_WAITERS tasks would have to be tested. */
+    #define configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR    0
+#endif
+
+#ifndef configEVENT_GROUP_DIRECT_SET_MAX_WAITERS
+
+/* The most waiting tasks xEventGroupSetBitsFromISR() tests from within the
+ * interrupt when configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR is 1. */
+    #define configEVENT_GROUP_DIRECT_SET_MAX_WAITERS    4
+#endif
+
+#if ( ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 ) && ( ( configUSE_TIMERS != 1 ) || ( INCLUDE_xTimerPendFunctionCall != 1 ) ) )
+    #error configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR requires configUSE_TIMERS and INCLUDE_xTimerPendFunctionCall to be set to 1
+#endif
+
+#ifndef configUSE_64_BIT_EVENT_GROUPS
+
+/* Set to 1 to make EventBits_t 64 bits wide, giving 56 usable bits in every
+ * event group, when TickType_t is narrower than 64 bits. */
+    #define configUSE_64_BIT_EVENT_GROUPS    0
+#endif
+
+#ifndef configUSE_EVENT_GROUP_BARRIERS
+
+/* Set to 1 to include xEventGroupBarrierWait(), which lets an event group be
+ * used as a reusable barrier for any number of tasks. */
+    #define configUSE_EVENT_GROUP_BARRIERS    0
+#endif
+
+#ifndef configUSE_TIMER_WHEEL
+
+/* Set to 1 to hold active software timers in a hierarchical timing wheel, so
+ * the timer service task starts, resets and stops timers in constant time
+ * rather than in time proportional to the number of active timers. */
+    #define configUSE_TIMER_WHEEL    0
+#endif
+
+#ifndef configTIMER_WHEEL_SLOT_BITS
+
+/* The log2 of the number of slots in each level of the timing wheel.  Each
+ * level covers configTIMER_WHEEL_SLOT_BITS bits of the tick count, so larger
+ * values use more lists (and RAM) but cascade timers between levels less
+ * often. */
+    #define configTIMER_WHEEL_SLOT_BITS    4
+#endif
+
+#ifndef configUSE_TIMER_DIRECT_COMMANDS
+
+/* Set to 1 to have xTimerStart(), xTimerReset(), xTimerStop() and
+ * xTimerChangePeriod() update the active timer lists directly, with the
+ * scheduler suspended, when they are called from a task, instead of sending a
+ * command to the timer service task.  Commands sent from interrupts, and
+ * xTimerDelete(), still go through the timer command queue. */
+    #define configUSE_TIMER_DIRECT_COMMANDS    0
+#endif
+
+#ifndef configUSE_TIMER_TICK_CALLBACKS
+
+/* Set to 1 to include vTimerSetCallbackFromTick(), which makes a software
+ * timer call its callback function from the tick interrupt, instead of from the
+ * timer service task, when it expires. */
+    #define configUSE_TIMER_TICK_CALLBACKS    0
+#endif
+
+#ifndef configUSE_DYNAMIC_TICK
+
+/* Set to 1 to let the port defer the tick while a task is running, not just
+ * while the idle task is.  At the end of each tick interrupt the port calls
+ * xTaskGetDynamicTickPeriod(), and if it returns more than 1 the port may
+ * program its next tick interrupt that many ticks ahead.  The kernel stops the
+ * deferral through portDYNAMIC_TICK_STOP() as soon as the tick count is read,
+ * a task blocks, a context switch is requested, or a task of at least the
+ * running task's priority is readied.  portDYNAMIC_TICK_STOP( xMaxTicks ) must
+ * restart the periodic tick so its next interrupt falls on the next tick
+ * boundary, and return the number of whole ticks, up to xMaxTicks, that have
+ * passed since the last tick interrupt, or 0 if the tick was not deferred.
+ * The tick hook, and anything else that runs on every tick, runs only on the
+ * tick interrupts that are taken. */
+    #define configUSE_DYNAMIC_TICK    0
+#endif
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    #if ( configNUMBER_OF_CORES > 1 )
+        #error configUSE_DYNAMIC_TICK is only supported when configNUMBER_OF_CORES is 1.
+    #endif
+
+    #if ( ( configUSE_TIME_PARTITIONS == 1 ) || ( configUSE_TASK_BUDGETS == 1 ) || ( configUSE_WINDOWED_RUN_TIME_STATS == 1 ) || ( configUSE_DVFS_GOVERNOR == 1 ) )
+        #error configUSE_DYNAMIC_TICK cannot be used with configUSE_TIME_PARTITIONS, configUSE_TASK_BUDGETS, configUSE_WINDOWED_RUN_TIME_STATS or configUSE_DVFS_GOVERNOR as they need every tick.
+    #endif
+
+    #if ( ( configUSE_MIXED_CRITICALITY == 1 ) && ( configCRITICALITY_RESTORE_TICKS > 0 ) )
+        #error configUSE_DYNAMIC_TICK cannot be used with configCRITICALITY_RESTORE_TICKS as it needs every tick.
+    #endif
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) )
+        #error configUSE_DYNAMIC_TICK cannot be used with configUSE_TIMER_TICK_CALLBACKS.
+    #endif
+
+    #ifndef portDYNAMIC_TICK_STOP
+        #error configUSE_DYNAMIC_TICK is set to 1 but the port does not define portDYNAMIC_TICK_STOP().
+    #endif
+#endif /* configUSE_DYNAMIC_TICK */
+
+#ifndef configUSE_TIMER_SLACK
+
+/* Set to 1 to include xTimerCreateWithSlack(), vTimerSetSlack() and
+ * vTaskDelayWithSlack(), which let timer expiries and task delays be deferred
+ * by up to a given number of ticks so they can be handled together with other
+ * expiries and delays, reducing the number of times the tick has to be
+ * resumed when configUSE_TICKLESS_IDLE is used. */
+    #define configUSE_TIMER_SLACK    0
+#endif
+
+#ifndef configTIMER_COMMAND_BATCH_SIZE
+
+/* The maximum number of commands the timer service task receives from its
+ * command queue at once.  Each batch is received with a single queue access and
+ * the tick count is sampled once per batch, at the cost of
+ * configTIMER_COMMAND_BATCH_SIZE commands worth of timer service task stack. */
+    #define configTIMER_COMMAND_BATCH_SIZE    1
+#endif
+
+#ifndef configTIMER_EXPIRED_BATCH_SIZE
+
+/* The maximum number of expired timers the timer service task processes
+ * against one sample of the tick count before it checks its command queue.
+ * Raising it stops timers that expire on the same tick each costing a
+ * scheduler suspend and resume and a time sample, at the cost of commands
+ * waiting until the batch is complete. */
+    #define configTIMER_EXPIRED_BATCH_SIZE    1
+#endif
+
+#ifndef configUSE_TIMER_PENDED_WORK
+
+/* Set to 1 to include xTimerInitialisePendedWork(), xTimerPendWork() and
+ * xTimerPendWorkFromISR(), which defer function calls to the timer service task
+ * using work items owned by the caller rather than by copying each call into
+ * the timer command queue. */
+    #define configUSE_TIMER_PENDED_WORK    0
+#endif
+
+#if ( ( configUSE_TIMER_PENDED_WORK == 1 ) && ( portUSING_MPU_WRAPPERS == 1 ) )
+    #error configUSE_TIMER_PENDED_WORK cannot be used with MPU ports as the function of a work item is executed by the privileged daemon task
+#endif
+
+#ifndef configUSE_HIGH_RESOLUTION_TIMERS
+
+/* Set to 1 to include the high resolution timer API, xHRTimerCreate() and
+ * friends.  High resolution timers have microsecond resolution, independent of
+ * configTICK_RATE_HZ, and are driven by a hardware compare channel provided by
+ * the port or the application through portHR_TIMER_GET_TIME() and
+ * portHR_TIMER_SET_COMPARE(). */
+    #define configUSE_HIGH_RESOLUTION_TIMERS    0
+#endif
+
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    #if ( configUSE_TIMERS == 0 )
+        #error configUSE_TIMERS must be 1 when configUSE_HIGH_RESOLUTION_TIMERS is 1.
+    #endif
+
+    #ifndef portHR_TIMER_GET_TIME
+
+/* Must return the time, in microseconds, from a free running 64-bit counter. */
+        #error portHR_TIMER_GET_TIME() must be defined when configUSE_HIGH_RESOLUTION_TIMERS is 1.
+    #endif
+
+    #ifndef portHR_TIMER_SET_COMPARE
+
+/* Must program the compare channel so the interrupt that calls
+ * xHRTimerCompareHandler() fires when portHR_TIMER_GET_TIME() reaches
+ * ullTime, or straight away if it has already passed ullTime. */
+        #error portHR_TIMER_SET_COMPARE( ullTime ) must be defined when configUSE_HIGH_RESOLUTION_TIMERS is 1.
+    #endif
+
+    #ifndef portHR_TIMER_DISABLE_COMPARE
+
+/* Optionally stops the compare interrupt when no high resolution timer is
+ * active.  Spurious compare interrupts are otherwise harmless. */
+        #define portHR_TIMER_DISABLE_COMPARE()
+    #endif
+#endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
+#if ( configTIMER_COMMAND_BATCH_SIZE < 1 )
+    #error configTIMER_COMMAND_BATCH_SIZE must be at least 1.
+#endif
+
+#if ( configTIMER_EXPIRED_BATCH_SIZE < 1 )
+    #error configTIMER_EXPIRED_BATCH_SIZE must be at least 1.
+#endif
+
+#ifndef configUSE_TIMER_SERVICE_INSTANCES
+
+/* Set to 1 to include xTimerServiceCreate(), which creates additional timer
+ * service tasks, each with its own priority, stack and command queue, and the
+ * functions that bind software timers to them. */
+    #define configUSE_TIMER_SERVICE_INSTANCES    0
+#endif
+
+#if ( ( configUSE_TIMER_SERVICE_INSTANCES == 1 ) && ( portUSING_MPU_WRAPPERS == 1 ) )
+    #error configUSE_TIMER_SERVICE_INSTANCES cannot be used with MPU ports as timer service tasks are privileged and would run the callbacks of timers created by unprivileged tasks
+#endif
+
+#if ( ( configUSE_TIMER_SLACK == 1 ) && ( configUSE_TIMER_WHEEL == 1 ) )
+    #error configUSE_TIMER_SLACK cannot be used when configUSE_TIMER_WHEEL is 1.
+#endif
+
+#ifndef portTICK_TYPE_IS_ATOMIC
+    #define portTICK_TYPE_IS_ATOMIC    0
+#endif
+
+#ifndef configSUPPORT_STATIC_ALLOCATION
+    /* Defaults to 0 for backward compatibility. */
+    #define configSUPPORT_STATIC_ALLOCATION    0
+#endif
+
+#ifndef configSUPPORT_DYNAMIC_ALLOCATION
+    /* Defaults to 1 for backward compatibility. */
+    #define configSUPPORT_DYNAMIC_ALLOCATION    1
+#endif
+
+/* Set configUSE_STATIC_KERNEL to 1 for the static kernel profile, for systems
+ * that create every object before the scheduler starts and never delete one.
+ * The objects listed in the configSTATIC_KERNEL_... tables are then allocated
+ * at build time and created by vTaskStartScheduler() - see static_kernel.h.
+ * The profile allows static allocation only and no task deletion, so no heap
+ * and none of the task deletion paths are built. */
+#ifndef configUSE_STATIC_KERNEL
+    #define configUSE_STATIC_KERNEL    0
+#endif
+
+#if ( configUSE_STATIC_KERNEL == 1 )
+    #if ( ( configSUPPORT_STATIC_ALLOCATION != 1 ) || ( configSUPPORT_DYNAMIC_ALLOCATION != 0 ) )
+        #error configUSE_STATIC_KERNEL requires configSUPPORT_STATIC_ALLOCATION to be 1 and configSUPPORT_DYNAMIC_ALLOCATION to be 0.
+    #endif
+
+    #if ( INCLUDE_vTaskDelete != 0 )
+        #error configUSE_STATIC_KERNEL cannot be used when INCLUDE_vTaskDelete is 1.
+    #endif
+#endif
+
+#if ( ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+    #error configUSE_STATS_FORMATTING_FUNCTIONS cannot be used without dynamic allocation, but configSUPPORT_DYNAMIC_ALLOCATION is not set to 1.
+#endif
+
+#if ( ( configUSE_TASK_HEAP_ACCOUNTING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
+    #error configUSE_TASK_HEAP_ACCOUNTING cannot be 1 if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if ( configUSE_TASK_REAPER == 1 )
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configUSE_TASK_REAPER requires configSUPPORT_DYNAMIC_ALLOCATION to be set to 1.
+    #endif
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_REAPER requires configUSE_TASK_NOTIFICATIONS to be set to 1.
+    #endif
+#endif
+
+/* The benchmarks in portable/Common allocate from the heap. */
+#if ( ( ( configUSE_CYCLE_BENCHMARK == 1 ) || ( configUSE_HEAP_BENCHMARK == 1 ) || ( configUSE_LATENCY_BENCHMARK == 1 ) ) && ( configSUPPORT_DYNAMIC_ALLOCATION != 1 ) )
+    #error configUSE_CYCLE_BENCHMARK, configUSE_HEAP_BENCHMARK and configUSE_LATENCY_BENCHMARK require configSUPPORT_DYNAMIC_ALLOCATION to be 1
 #endif
 
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
@@ -1013,15 +3067,89 @@
     #define configMESSAGE_BUFFER_LENGTH_TYPE    size_t
 #endif
 
+/* Set configUSE_LIST_INLINE_OPERATIONS to 1 to expand the list insert and
+ * remove operations on the kernel's task and timer hot paths inline, which is
+ * faster but larger.  Leave at 0 to call vListInsertEnd() and uxListRemove(). */
+#ifndef configUSE_LIST_INLINE_OPERATIONS
+    #define configUSE_LIST_INLINE_OPERATIONS    0
+#endif
+
+/* Set configUSE_COMPACT_LIST_LINKS to 1 to hold the links inside list items as
+ * 16-bit offsets from configLIST_COMPACT_BASE, scaled down by
+ * configLIST_COMPACT_SHIFT bits, rather than as pointers.  Every list, list item
+ * and list item owner must then lie within ( 65535 << configLIST_COMPACT_SHIFT )
+ * bytes above configLIST_COMPACT_BASE.  See list.h. */
+#ifndef configUSE_COMPACT_LIST_LINKS
+    #define configUSE_COMPACT_LIST_LINKS    0
+#endif
+
+#ifndef configLIST_COMPACT_SHIFT
+    #define configLIST_COMPACT_SHIFT    2
+#endif
+
+/* Set configUSE_SKIP_LISTS to 1 to give each list item
+ * ( configSKIP_LIST_LEVELS - 1 ) levels of express links, so vListInsert()
+ * finds its insertion point in logarithmic rather than linear time.  Worth it
+ * only when many tasks wait on the same queue or delayed list; each list item
+ * grows by ( 2 * ( configSKIP_LIST_LEVELS - 1 ) ) pointers plus a UBaseType_t.
+ * Four levels suit lists of up to a few hundred items.  See list.h. */
+#ifndef configUSE_SKIP_LISTS
+    #define configUSE_SKIP_LISTS    0
+#endif
+
+#ifndef configSKIP_LIST_LEVELS
+    #define configSKIP_LIST_LEVELS    4
+#endif
+
 /* Sanity check the configuration. */
 #if ( ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
     #error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
 
+#if ( ( configUSE_COMPACT_LIST_LINKS == 1 ) && !defined( configLIST_COMPACT_BASE ) )
+    #error configLIST_COMPACT_BASE must be defined to the lowest address of the RAM holding kernel objects when configUSE_COMPACT_LIST_LINKS is set to 1
+#endif
+
+#if ( ( configUSE_SKIP_LISTS == 1 ) && ( configUSE_COMPACT_LIST_LINKS == 1 ) )
+    #error configUSE_SKIP_LISTS and configUSE_COMPACT_LIST_LINKS cannot both be set to 1
+#endif
+
+#if ( ( configUSE_SKIP_LISTS == 1 ) && ( configSKIP_LIST_LEVELS < 2 ) )
+    #error configSKIP_LIST_LEVELS must be at least 2 when configUSE_SKIP_LISTS is set to 1
+#endif
+
 #if ( ( configUSE_RECURSIVE_MUTEXES == 1 ) && ( configUSE_MUTEXES != 1 ) )
     #error configUSE_MUTEXES must be set to 1 to use recursive mutexes
 #endif
 
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use reader writer locks
+#endif
+
+/* configPRIORITY_INHERITANCE_DEPTH is the number of mutex holders, along a
+ * chain of tasks that are each blocked on a mutex held by the next, that
+ * inherit the priority of a task that blocks on the first mutex in the chain.
+ * The default of 1 only raises the priority of the direct holder. */
+#ifndef configPRIORITY_INHERITANCE_DEPTH
+    #define configPRIORITY_INHERITANCE_DEPTH    1
+#endif
+
+#if ( configPRIORITY_INHERITANCE_DEPTH < 1 )
+    #error configPRIORITY_INHERITANCE_DEPTH must be at least 1
+#endif
+
+/* Set configUSE_MUTEX_PRIORITY_CEILING to 1 to include
+ * xSemaphoreCreateMutexWithCeiling(), which creates a mutex that raises the
+ * priority of the task that takes it to a fixed ceiling priority until the
+ * task gives back the mutexes it holds. */
+#ifndef configUSE_MUTEX_PRIORITY_CEILING
+    #define configUSE_MUTEX_PRIORITY_CEILING    0
+#endif
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configUSE_MUTEXES != 1 ) )
+    #error configUSE_MUTEXES must be set to 1 to use priority ceiling mutexes
+#endif
+
 #ifndef configINITIAL_TICK_COUNT
     #define configINITIAL_TICK_COUNT    0
 #endif
@@ -1159,6 +3287,42 @@
     #define configRUN_ADDITIONAL_TESTS    0
 #endif
 
+/* Check the configuration against the build profile, now every option has its
+ * default. */
+#if ( configKERNEL_BUILD_PROFILE == kernelPROFILE_SPEED )
+    #if ( configUSE_LIST_INLINE_OPERATIONS != 1 )
+        #error The speed profile requires configUSE_LIST_INLINE_OPERATIONS to be 1
+    #endif
+
+    #if !defined( configKERNEL_FAST_SECTION )
+        #error The speed profile requires configKERNEL_FAST_SECTION to name the section the linker script places in RAM
+    #endif
+
+    #if ( ( configUSE_TRACE_RECORDER == 1 ) || ( configUSE_BENCHMARK_HOOKS == 1 ) )
+        #error The speed profile cannot be used with configUSE_TRACE_RECORDER or configUSE_BENCHMARK_HOOKS, which add work to the hot paths
+    #endif
+#elif ( configKERNEL_BUILD_PROFILE == kernelPROFILE_SIZE )
+    #if ( configUSE_LIST_INLINE_OPERATIONS != 0 )
+        #error The size profile requires configUSE_LIST_INLINE_OPERATIONS to be 0
+    #endif
+
+    #if defined( configKERNEL_FAST_SECTION )
+        #error The size profile cannot be used with configKERNEL_FAST_SECTION, which keeps a second copy of the hot functions in RAM
+    #endif
+
+    #if ( ( configUSE_TRACE_RECORDER == 1 ) || ( configUSE_BENCHMARK_HOOKS == 1 ) || ( configUSE_CYCLE_BENCHMARK == 1 ) || ( configUSE_HEAP_BENCHMARK == 1 ) || ( configUSE_LATENCY_BENCHMARK == 1 ) )
+        #error The size profile cannot be used with configUSE_TRACE_RECORDER, configUSE_BENCHMARK_HOOKS or the cycle, heap or latency benchmarks
+    #endif
+
+    #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+        #error The size profile requires configUSE_STATS_FORMATTING_FUNCTIONS to be 0
+    #endif
+#elif ( configKERNEL_BUILD_PROFILE == kernelPROFILE_TRACE )
+    #if ( configUSE_TRACE_RECORDER != 1 )
+        #error The trace profile requires configUSE_TRACE_RECORDER to be 1
+    #endif
+#endif
+
 
 /* Sometimes the FreeRTOSConfig.h settings only allow a task to be created using
  * dynamically allocated RAM, in which case when any task is deleted it is known
@@ -1222,7 +3386,14 @@ struct xSTATIC_LIST_ITEM
         TickType_t xDummy1;
     #endif
     TickType_t xDummy2;
-    void * pvDummy3[ 4 ];
+    #if ( configUSE_COMPACT_LIST_LINKS == 1 )
+        uint16_t usDummy3[ 4 ];
+    #elif ( configUSE_SKIP_LISTS == 1 )
+        void * pvDummy3[ 4 + ( 2 * ( configSKIP_LIST_LEVELS - 1 ) ) ];
+        UBaseType_t uxDummy5;
+    #else
+        void * pvDummy3[ 4 ];
+    #endif
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy4;
     #endif
@@ -1237,7 +3408,13 @@ typedef struct xSTATIC_LIST_ITEM StaticListItem_t;
             TickType_t xDummy1;
         #endif
         TickType_t xDummy2;
-        void * pvDummy3[ 2 ];
+        #if ( configUSE_COMPACT_LIST_LINKS == 1 )
+            uint16_t usDummy3[ 2 ];
+        #elif ( configUSE_SKIP_LISTS == 1 )
+            void * pvDummy3[ 2 + ( 2 * ( configSKIP_LIST_LEVELS - 1 ) ) ];
+        #else
+            void * pvDummy3[ 2 ];
+        #endif
     };
     typedef struct xSTATIC_MINI_LIST_ITEM StaticMiniListItem_t;
 #else /* if ( configUSE_MINI_LIST_ITEM == 1 ) */
@@ -1251,13 +3428,26 @@ typedef struct xSTATIC_LIST
         TickType_t xDummy1;
     #endif
     UBaseType_t uxDummy2;
-    void * pvDummy3;
+    #if ( configUSE_COMPACT_LIST_LINKS == 1 )
+        uint16_t usDummy3;
+    #else
+        void * pvDummy3;
+    #endif
     StaticMiniListItem_t xDummy4;
     #if ( configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES == 1 )
         TickType_t xDummy5;
     #endif
 } StaticList_t;
 
+/* See the comments above the struct xSTATIC_LIST_ITEM definition.  Has the
+ * same size and alignment as the ObjectRegistryItem_t each kernel object holds
+ * when configUSE_OBJECT_REGISTRY is 1. */
+typedef struct xSTATIC_OBJECT_REGISTRY_ITEM
+{
+    void * pvDummy1[ 4 ];
+    UBaseType_t uxDummy2[ 2 ];
+} StaticObjectRegistryItem_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1280,7 +3470,40 @@ typedef struct xSTATIC_TCB
     StaticListItem_t xDummy3[ 2 ];
     UBaseType_t uxDummy5;
     void * pxDummy6;
-    uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
+    #if ( configNUMBER_OF_CORES > 1 )
+        BaseType_t xDummy23;
+        UBaseType_t uxDummy24;
+    #endif
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        UBaseType_t uxDummy25;
+    #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xDummy26[ 2 ];
+    #endif
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        TickType_t xDummy27[ 4 ];
+    #endif
+    #if ( configUSE_TIME_PARTITIONS == 1 )
+        UBaseType_t uxDummy43;
+    #endif
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+        UBaseType_t uxDummy46;
+    #endif
+    #if ( ( configTIME_SLICE_TICKS > 1 ) || ( configUSE_PER_PRIORITY_TIME_SLICE == 1 ) )
+        TickType_t xDummy28;
+    #endif
+    #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+        UBaseType_t uxDummy40;
+    #endif
+    #if ( configUSE_TCB_HOT_LAYOUT == 0 )
+        #if ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_COPY )
+            uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
+        #elif ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_REFERENCE )
+            const void * pvDummy7;
+        #endif
+    #elif ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy16;
+    #endif
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         void * pxDummy8;
     #endif
@@ -1293,15 +3516,21 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_MUTEXES == 1 )
         UBaseType_t uxDummy12[ 2 ];
     #endif
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+        void * pxDummy29;
+    #endif
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         void * pxDummy14;
     #endif
-    #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+    #if ( ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 ) && ( configUSE_TCB_HOT_LAYOUT == 0 ) )
         void * pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
     #endif
-    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TCB_HOT_LAYOUT == 0 ) )
         configRUN_TIME_COUNTER_TYPE ulDummy16;
     #endif
+    #if ( configUSE_CORE_RUN_TIME_STATS == 1 )
+        UBaseType_t uxDummy49[ 3 ];
+    #endif
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         configTLS_BLOCK_TYPE xDummy17;
     #endif
@@ -1319,6 +3548,58 @@ typedef struct xSTATIC_TCB
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iDummy22;
     #endif
+    #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+        uint64_t ullDummy30;
+    #endif
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        size_t xDummy31[ 2 ];
+        uint8_t ucDummy32;
+    #endif
+    #if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulDummy33[ 4 ];
+        uint32_t ulDummy34[ configISR_WAKE_LATENCY_BUCKETS + 1 ];
+        uint8_t ucDummy35;
+    #endif
+    #if ( configUSE_PERIODIC_TASK_STATS == 1 )
+        TickType_t xDummy44[ 2 ];
+        uint32_t ulDummy45[ configPERIODIC_TASK_STATS_BUCKETS + 2 ];
+    #endif
+    #if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+        uint32_t ulDummy36;
+        configRUN_TIME_COUNTER_TYPE ulDummy37[ 6 ];
+    #endif
+    #if ( configUSE_TASK_ITERATOR == 1 )
+        void * pxDummy38[ 2 ];
+    #endif
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+        void * pxDummy39;
+    #endif
+    #if ( configUSE_TASK_MAILBOXES == 1 )
+        void * pxDummy40[ configTASK_NOTIFICATION_ARRAY_ENTRIES ];
+    #endif
+    #if ( configTASK_NAME_HASH_BUCKETS > 0 )
+        void * pxDummy41;
+    #endif
+    #if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+        void * pxDummy42[ 2 ];
+    #endif
+    #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+        void * pvDummy47;
+        BaseType_t xDummy48;
+    #endif
+    #if ( configUSE_WAIT_ON_ADDRESS == 1 )
+        const volatile void * pvDummy50;
+    #endif
+    #if ( configUSE_TCB_HOT_LAYOUT == 1 )
+        #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+            void * pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+        #endif
+        #if ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_COPY )
+            uint8_t ucDummy7[ configMAX_TASK_NAME_LEN ];
+        #elif ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_REFERENCE )
+            const void * pvDummy7;
+        #endif
+    #endif
 } StaticTask_t;
 
 /*
@@ -1349,6 +3630,31 @@ typedef struct xSTATIC_QUEUE
     UBaseType_t uxDummy4[ 3 ];
     uint8_t ucDummy5[ 2 ];
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucDummy10;
+    #endif
+
+    #if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+        uint8_t ucDummy11;
+    #endif
+
+    #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+        uint8_t ucDummy12;
+    #endif
+
+    #if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+        uint8_t ucDummy18;
+    #endif
+
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+        uint8_t ucDummy20;
+        UBaseType_t uxDummy21;
+    #endif
+
+    #if ( configUSE_TYPED_QUEUES == 1 )
+        void ( * pvDummy22 )( void *, const void * );
+    #endif
+
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy6;
     #endif
@@ -1361,6 +3667,24 @@ typedef struct xSTATIC_QUEUE
         UBaseType_t uxDummy8;
         uint8_t ucDummy9;
     #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        UBaseType_t uxDummy13;
+        uint32_t ulDummy14[ 4 ];
+        TickType_t xDummy15[ 3 ];
+    #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxDummy16;
+    #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        StaticObjectRegistryItem_t xDummy17;
+    #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xDummy19;
+    #endif
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -1380,9 +3704,30 @@ typedef StaticQueue_t StaticSemaphore_t;
  */
 typedef struct xSTATIC_EVENT_GROUP
 {
-    TickType_t xDummy1;
+    #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+        uint64_t ullDummy1;
+    #else
+        TickType_t xDummy1;
+    #endif
     StaticList_t xDummy2;
 
+    #if ( configUSE_EVENT_GROUP_WAIT_INDEX == 1 )
+        #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+            StaticList_t xDummy5[ 64U - 8U ];
+        #else
+            StaticList_t xDummy5[ ( sizeof( TickType_t ) * 8U ) - 8U ];
+        #endif
+    #endif
+
+    #if ( configUSE_EVENT_GROUP_BARRIERS == 1 )
+        StaticList_t xDummy6;
+        UBaseType_t uxDummy7[ 2 ];
+    #endif
+
+    #if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+        BaseType_t xDummy8;
+    #endif
+
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy3;
     #endif
@@ -1390,6 +3735,10 @@ typedef struct xSTATIC_EVENT_GROUP
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucDummy4;
     #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        StaticObjectRegistryItem_t xDummy9;
+    #endif
 } StaticEventGroup_t;
 
 /*
@@ -1416,9 +3765,51 @@ typedef struct xSTATIC_TIMER
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxDummy7;
     #endif
+    #if ( configUSE_TIMER_SLACK == 1 )
+        TickType_t xDummy9;
+    #endif
+    #if ( configUSE_TIMER_SERVICE_INSTANCES == 1 )
+        void * pvDummy10;
+    #endif
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+        void * pvDummy11;
+    #endif
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        StaticObjectRegistryItem_t xDummy12;
+    #endif
     uint8_t ucDummy8;
 } StaticTimer_t;
 
+/*
+ * In line with software engineering best practice, FreeRTOS implements a strict
+ * data hiding policy, so the real structure used to hold a pended work item is
+ * not accessible to the application.  StaticPendedWork_t has the same size and
+ * alignment, for use with xTimerInitialisePendedWork().  See StaticTimer_t.
+ */
+typedef struct xSTATIC_PENDED_WORK
+{
+    void * pvDummy1;
+    TaskFunction_t pvDummy2;
+    void * pvDummy3;
+    uint32_t ulDummy4;
+    BaseType_t xDummy5;
+} StaticPendedWork_t;
+
+/*
+ * As above, StaticHRTimer_t has the same size and alignment as the structure
+ * used to hold a high resolution timer, for use with xHRTimerCreateStatic().
+ */
+typedef struct xSTATIC_HR_TIMER
+{
+    void * pvDummy1;
+    void * pvDummy2;
+    uint64_t ullDummy3;
+    uint32_t ulDummy4;
+    void * pvDummy5;
+    TaskFunction_t pvDummy6;
+    uint8_t ucDummy7;
+} StaticHRTimer_t;
+
 /*
  * In line with software engineering best practice, especially when supplying a
  * library that is likely to change in future versions, FreeRTOS implements a
@@ -1435,7 +3826,13 @@ typedef struct xSTATIC_TIMER
  */
 typedef struct xSTATIC_STREAM_BUFFER
 {
-    size_t uxDummy1[ 4 ];
+    #if ( configSTREAM_BUFFER_CACHE_LINE_BYTES > 0 )
+        size_t uxDummy0;
+        uint8_t ucDummy0[ configSTREAM_BUFFER_CACHE_LINE_BYTES - sizeof( size_t ) ];
+        size_t uxDummy1[ 4 ];
+    #else
+        size_t uxDummy1[ 5 ];
+    #endif
     void * pvDummy2[ 3 ];
     uint8_t ucDummy3;
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -1444,11 +3841,87 @@ typedef struct xSTATIC_STREAM_BUFFER
     #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
         void * pvDummy5[ 2 ];
     #endif
+    #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+        uint32_t ulDummy6;
+    #endif
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        size_t uxDummy7[ 2 ];
+        uint32_t ulDummy8[ 6 ];
+        TickType_t xDummy9[ 3 ];
+    #endif
+    #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+        TickType_t xDummy11;
+    #endif
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+        uint8_t ucDummy12;
+        UBaseType_t uxDummy13;
+    #endif
+    #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+        size_t uxDummy14;
+    #endif
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        StaticObjectRegistryItem_t xDummy10;
+    #endif
 } StaticStreamBuffer_t;
 
 /* Message buffers are built on stream buffers. */
 typedef StaticStreamBuffer_t StaticMessageBuffer_t;
 
+/*
+ * In line with the strict data hiding policy, the SPSC queue structure used
+ * internally by FreeRTOS is not accessible to application code.  The
+ * StaticSPSCQueue_t structure below is provided so the application writer can
+ * statically allocate the memory required to create an SPSC queue.  Its size
+ * and alignment requirements are guaranteed to match those of the genuine
+ * structure.
+ */
+typedef struct xSTATIC_SPSC_QUEUE
+{
+    UBaseType_t uxDummy1[ 6 ];
+    void * pvDummy2[ 3 ];
+    uint8_t ucDummy3;
+} StaticSPSCQueue_t;
+
+/*
+ * In line with the strict data hiding policy, the light mutex structure used
+ * internally by FreeRTOS is not accessible to application code.  The
+ * StaticLightMutex_t structure below is provided so the application writer can
+ * statically allocate the memory required to create a light mutex.  Its size
+ * and alignment requirements are guaranteed to match those of the genuine
+ * structure.
+ */
+typedef struct xSTATIC_LIGHT_MUTEX
+{
+    void * pvDummy1;
+    StaticList_t xDummy2;
+    uint8_t ucDummy3;
+} StaticLightMutex_t;
+
+/*
+ * In line with the strict data hiding policy, the broadcast ring structures
+ * used internally by FreeRTOS are not accessible to application code.  The
+ * StaticBroadcastRing_t and StaticBroadcastSubscriber_t structures below are
+ * provided so the application writer can statically allocate the memory
+ * required to create a broadcast ring and its subscribers.  Their size and
+ * alignment requirements are guaranteed to match those of the genuine
+ * structures.
+ */
+typedef struct xSTATIC_BROADCAST_RING
+{
+    UBaseType_t uxDummy1[ 4 ];
+    void * pvDummy2;
+    StaticList_t xDummy3;
+    BaseType_t xDummy4;
+    uint8_t ucDummy5;
+} StaticBroadcastRing_t;
+
+typedef struct xSTATIC_BROADCAST_SUBSCRIBER
+{
+    void * pvDummy1;
+    UBaseType_t uxDummy2[ 2 ];
+    uint8_t ucDummy3;
+} StaticBroadcastSubscriber_t;
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -0,0 +1,381 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * An active object is an event driven object that owns an event queue and a
+ * table of event handlers, one for each event signal it handles.  Events
+ * posted to the object are handled one at a time, each handler running to
+ * completion, so the object's state needs no locking.
+ *
+ * Active objects do not each need a task.  Any number of active objects, up
+ * to activeMAX_PRIORITIES, are attached to a dispatcher task, each with a
+ * different priority.  The dispatcher always handles the next event of the
+ * highest priority active object that has one.  Active objects that must
+ * preempt each other are attached to dispatchers of different priorities.
+ *
+ * Events are not copied.  An event is a block allocated from an event pool,
+ * starting with an ActiveEvent_t header, and only a pointer to it is queued.
+ * The header holds a reference count, so the same event can be posted to any
+ * number of active objects and is returned to its pool when the last
+ * reference is released.  Events that never change can instead be declared
+ * statically, with a NULL pxPool, in which case they are never freed.
+ *
+ * configUSE_ACTIVE_OBJECTS must be set to 1 in FreeRTOSConfig.h for this API
+ * to be available.
+ */
+
+#ifndef ACTIVE_OBJECT_H
+#define ACTIVE_OBJECT_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include active_object.h"
+#endif
+
+#include "task.h"
+#include "queue.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The number of active objects that can be attached to one dispatcher, which
+ * is the number of bits in the dispatcher task's notification value. */
+#define activeMAX_PRIORITIES    ( ( UBaseType_t ) 32U )
+
+/**
+ * Types by which event pools, dispatchers and active objects are referenced.
+ */
+struct ActiveEventPoolDefinition;
+typedef struct ActiveEventPoolDefinition * ActiveEventPoolHandle_t;
+
+struct ActiveDispatcherDefinition;
+typedef struct ActiveDispatcherDefinition * ActiveDispatcherHandle_t;
+
+struct ActiveObjectDefinition;
+typedef struct ActiveObjectDefinition * ActiveObjectHandle_t;
+
+/*
+ * The header at the start of every event.  Applications define their events
+ * as structures whose first member is an ActiveEvent_t.
+ */
+typedef struct ActiveEvent
+{
+    UBaseType_t uxSignal;                   /*< Identifies the event, and selects the handler that is called for it. */
+    volatile uint32_t ulReferenceCount;     /*< Managed by the kernel.  The number of references held to a pool event. */
+    struct ActiveEventPoolDefinition * pxPool; /*< The pool the event was allocated from, or NULL for a static event. */
+} ActiveEvent_t;
+
+/*
+ * Defines the prototype to which event handlers must conform.  pvContext is
+ * the value given when the active object was created.  The event is only
+ * valid until the handler returns, unless the handler calls
+ * vActiveEventRetain() to keep it.
+ */
+typedef void (* ActiveEventHandler_t)( void * pvContext,
+                                       const ActiveEvent_t * pxEvent );
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * ActiveEventPoolHandle_t xActiveEventPoolCreate( size_t xEventSize,
+ *                                                 UBaseType_t uxNumberOfEvents );
+ * @endcode
+ *
+ * Creates a pool of equally sized events using dynamically allocated memory.
+ * Allocating and freeing an event takes constant time.
+ *
+ * @param xEventSize The size of the largest event structure allocated from
+ * the pool, including its ActiveEvent_t header.
+ *
+ * @param uxNumberOfEvents The number of events in the pool.
+ *
+ * @return A handle to the created pool, or NULL if there was insufficient heap
+ * memory to create it.
+ *
+ * \defgroup xActiveEventPoolCreate xActiveEventPoolCreate
+ * \ingroup ActiveObjects
+ */
+ActiveEventPoolHandle_t xActiveEventPoolCreate( size_t xEventSize,
+                                                UBaseType_t uxNumberOfEvents ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * ActiveEvent_t * pxActiveEventAllocate( ActiveEventPoolHandle_t xPool,
+ *                                        UBaseType_t uxSignal );
+ * @endcode
+ *
+ * Takes an event from a pool.  The caller holds the one reference to the
+ * event, which it must release with vActiveEventRelease() once it has posted
+ * the event, or if it decides not to post it.
+ *
+ * @param xPool The pool the event is taken from.
+ *
+ * @param uxSignal The signal of the event.
+ *
+ * @return The event, or NULL if every event in the pool is in use.
+ *
+ * Example use:
+ * @code{c}
+ * typedef struct
+ * {
+ *  ActiveEvent_t xHeader;
+ *  uint16_t usReading;
+ * } ReadingEvent_t;
+ *
+ * void vPublishReading( uint16_t usReading )
+ * {
+ * ReadingEvent_t * pxEvent;
+ *
+ *  pxEvent = ( ReadingEvent_t * ) pxActiveEventAllocate( xPool, READING_SIGNAL );
+ *
+ *  if( pxEvent != NULL )
+ *  {
+ *      pxEvent->usReading = usReading;
+ *
+ *      // Both active objects receive the same event, which is freed once
+ *      // both have handled it.
+ *      xActiveObjectPost( xLogger, &( pxEvent->xHeader ), 0 );
+ *      xActiveObjectPost( xController, &( pxEvent->xHeader ), 0 );
+ *      vActiveEventRelease( &( pxEvent->xHeader ) );
+ *  }
+ * }
+ * @endcode
+ * \defgroup pxActiveEventAllocate pxActiveEventAllocate
+ * \ingroup ActiveObjects
+ */
+ActiveEvent_t * pxActiveEventAllocate( ActiveEventPoolHandle_t xPool,
+                                       UBaseType_t uxSignal ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * ActiveEvent_t * pxActiveEventAllocateFromISR( ActiveEventPoolHandle_t xPool,
+ *                                               UBaseType_t uxSignal );
+ * @endcode
+ *
+ * A version of pxActiveEventAllocate() that can be called from an interrupt
+ * service routine.
+ *
+ * \defgroup pxActiveEventAllocateFromISR pxActiveEventAllocateFromISR
+ * \ingroup ActiveObjects
+ */
+ActiveEvent_t * pxActiveEventAllocateFromISR( ActiveEventPoolHandle_t xPool,
+                                              UBaseType_t uxSignal ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * void vActiveEventRetain( const ActiveEvent_t * pxEvent );
+ * @endcode
+ *
+ * Adds a reference to an event, so it is not freed until a matching
+ * vActiveEventRelease().  Used by a handler that keeps an event after it
+ * returns.  Can be called from an interrupt service routine.
+ *
+ * \defgroup vActiveEventRetain vActiveEventRetain
+ * \ingroup ActiveObjects
+ */
+void vActiveEventRetain( const ActiveEvent_t * pxEvent ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * void vActiveEventRelease( const ActiveEvent_t * pxEvent );
+ * @endcode
+ *
+ * Releases a reference to an event, returning the event to its pool if it
+ * was the last reference.  Has no effect on a static event.
+ *
+ * \defgroup vActiveEventRelease vActiveEventRelease
+ * \ingroup ActiveObjects
+ */
+void vActiveEventRelease( const ActiveEvent_t * pxEvent ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * void vActiveEventReleaseFromISR( const ActiveEvent_t * pxEvent );
+ * @endcode
+ *
+ * A version of vActiveEventRelease() that can be called from an interrupt
+ * service routine.
+ *
+ * \defgroup vActiveEventReleaseFromISR vActiveEventReleaseFromISR
+ * \ingroup ActiveObjects
+ */
+void vActiveEventReleaseFromISR( const ActiveEvent_t * pxEvent ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * ActiveDispatcherHandle_t xActiveDispatcherCreate( const char * const pcName,
+ *                                                   configSTACK_DEPTH_TYPE uxStackDepth,
+ *                                                   UBaseType_t uxPriority );
+ * @endcode
+ *
+ * Creates a dispatcher and its task using dynamically allocated memory.
+ * Dispatchers cannot be deleted.
+ *
+ * @param pcName The name given to the dispatcher task.
+ *
+ * @param uxStackDepth The stack size of the dispatcher task, in words.  It
+ * must be large enough for the deepest handler of the attached active
+ * objects.
+ *
+ * @param uxPriority The priority of the dispatcher task.
+ *
+ * @return A handle to the created dispatcher, or NULL if there was
+ * insufficient heap memory to create it.
+ *
+ * \defgroup xActiveDispatcherCreate xActiveDispatcherCreate
+ * \ingroup ActiveObjects
+ */
+ActiveDispatcherHandle_t xActiveDispatcherCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                  configSTACK_DEPTH_TYPE uxStackDepth,
+                                                  UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * ActiveObjectHandle_t xActiveObjectCreate( ActiveDispatcherHandle_t xDispatcher,
+ *                                           UBaseType_t uxPriority,
+ *                                           UBaseType_t uxQueueLength,
+ *                                           const ActiveEventHandler_t * pxHandlers,
+ *                                           UBaseType_t uxNumberOfSignals,
+ *                                           void * pvContext );
+ * @endcode
+ *
+ * Creates an active object and attaches it to a dispatcher, using
+ * dynamically allocated memory.  Active objects cannot be deleted.
+ *
+ * @param xDispatcher The dispatcher whose task handles the object's events.
+ *
+ * @param uxPriority The priority of the object relative to the other objects
+ * of the same dispatcher.  Must be less than activeMAX_PRIORITIES, and not
+ * used by another object of the dispatcher.
+ *
+ * @param uxQueueLength The number of events that can be waiting to be
+ * handled by the object.
+ *
+ * @param pxHandlers A table of handlers indexed by event signal.  A NULL
+ * entry, or a signal of uxNumberOfSignals or above, means events with that
+ * signal are released without being handled.  The table is not copied, so
+ * must remain in scope.
+ *
+ * @param uxNumberOfSignals The number of entries in pxHandlers.
+ *
+ * @param pvContext The value passed to every handler.
+ *
+ * @return A handle to the created active object, or NULL if there was
+ * insufficient heap memory to create it.
+ *
+ * \defgroup xActiveObjectCreate xActiveObjectCreate
+ * \ingroup ActiveObjects
+ */
+ActiveObjectHandle_t xActiveObjectCreate( ActiveDispatcherHandle_t xDispatcher,
+                                          UBaseType_t uxPriority,
+                                          UBaseType_t uxQueueLength,
+                                          const ActiveEventHandler_t * pxHandlers,
+                                          UBaseType_t uxNumberOfSignals,
+                                          void * pvContext ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * BaseType_t xActiveObjectPost( ActiveObjectHandle_t xActiveObject,
+ *                               const ActiveEvent_t * pxEvent,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Posts an event to an active object.  A reference to the event is added for
+ * the object, and released by the dispatcher once the handler returns, so the
+ * caller keeps its own reference.
+ *
+ * A handler must not post with a block time to an object of its own
+ * dispatcher, as the dispatcher would be waiting for itself.
+ *
+ * @param xActiveObject The object the event is posted to.
+ *
+ * @param pxEvent The event.
+ *
+ * @param xTicksToWait The maximum time to wait for space in the object's
+ * event queue.
+ *
+ * @return pdPASS if the event was posted, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xActiveObjectPost xActiveObjectPost
+ * \ingroup ActiveObjects
+ */
+BaseType_t xActiveObjectPost( ActiveObjectHandle_t xActiveObject,
+                              const ActiveEvent_t * pxEvent,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * active_object.h
+ *
+ * @code{c}
+ * BaseType_t xActiveObjectPostFromISR( ActiveObjectHandle_t xActiveObject,
+ *                                      const ActiveEvent_t * pxEvent,
+ *                                      BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xActiveObjectPost() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the event
+ * unblocked the dispatcher task and the dispatcher task has a priority above
+ * that of the currently running task, in which case a context switch should
+ * be requested before the interrupt is exited.
+ *
+ * \defgroup xActiveObjectPostFromISR xActiveObjectPostFromISR
+ * \ingroup ActiveObjects
+ */
+BaseType_t xActiveObjectPostFromISR( ActiveObjectHandle_t xActiveObject,
+                                     const ActiveEvent_t * pxEvent,
+                                     BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( ACTIVE_OBJECT_H ) */
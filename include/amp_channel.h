@@ -0,0 +1,353 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * An AMP channel passes variable length messages in one direction between two
+ * cores that each run their own instance of the kernel, for example the two
+ * cores of a dual core Cortex-M7 and Cortex-M4 part.  Messages are copied
+ * through a ring buffer in memory both cores can access, and an inter-core
+ * interrupt, the doorbell, wakes a task on the other core that is waiting for
+ * a message or for space.  The doorbell is only rung when the other core has a
+ * task waiting, so streaming messages between cores that are both busy does
+ * not interrupt either of them.
+ *
+ * Each core creates its own end of the channel on the same shared memory, one
+ * as the sender and the other as the receiver.  The shared memory starts with
+ * two control blocks, one written only by the sender and one written only by
+ * the receiver, each in a cache line of its own, followed by the ring buffer.
+ * No memory is written by both cores, so the channel works with non-coherent
+ * data caches provided configAMP_CACHE_CLEAN() and configAMP_CACHE_INVALIDATE()
+ * are defined in FreeRTOSConfig.h.
+ *
+ * The doorbell interrupt handler on each core must call
+ * xAMPChannelDoorbellFromISR() for every channel end on that core that uses
+ * the doorbell.  Use one channel in each direction for two way messaging.
+ *
+ * configUSE_AMP_CHANNELS must be set to 1 in FreeRTOSConfig.h for this API to
+ * be available.
+ */
+
+#ifndef AMP_CHANNEL_H
+#define AMP_CHANNEL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include amp_channel.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which AMP channels are referenced.  For example, a call to
+ * xAMPChannelCreate() returns an AMPChannelHandle_t variable that can then be
+ * used as a parameter to xAMPChannelSend().
+ */
+struct AMPChannelDefinition;
+typedef struct AMPChannelDefinition * AMPChannelHandle_t;
+
+/* The ends of a channel, passed to xAMPChannelCreate(). */
+#define ampCHANNEL_SENDER      ( ( BaseType_t ) 0 )
+#define ampCHANNEL_RECEIVER    ( ( BaseType_t ) 1 )
+
+/*
+ * The number of bytes of shared memory needed by a channel with a ring buffer
+ * of xBufferSizeBytes bytes.  The shared memory must be aligned to
+ * configAMP_CACHE_LINE_SIZE.
+ */
+#define ampCHANNEL_SHARED_MEMORY_SIZE( xBufferSizeBytes )    ( ( ( size_t ) 2U * ( size_t ) configAMP_CACHE_LINE_SIZE ) + ( size_t ) ( xBufferSizeBytes ) )
+
+/*
+ * The number of bytes of the ring buffer used by each message in addition to
+ * its data.
+ */
+#define ampCHANNEL_MESSAGE_OVERHEAD    ( sizeof( uint32_t ) )
+
+/**
+ * amp_channel.h
+ *
+ * @code{c}
+ * AMPChannelHandle_t xAMPChannelCreate( void * pvSharedMemory,
+ *                                       size_t xBufferSizeBytes,
+ *                                       BaseType_t xEnd,
+ *                                       UBaseType_t uxDoorbell );
+ * @endcode
+ *
+ * Creates this core's end of an AMP channel.  The other core must create the
+ * other end on the same shared memory with the same buffer size.
+ *
+ * The shared memory must be zeroed before either core creates its end, for
+ * example by placing it in a section that is zeroed by the startup code of the
+ * core that boots first, and before that core starts the other one.  Creating
+ * an end does not write to the shared memory.
+ *
+ * @param pvSharedMemory The ampCHANNEL_SHARED_MEMORY_SIZE( xBufferSizeBytes )
+ * bytes of shared memory, aligned to configAMP_CACHE_LINE_SIZE.  The address
+ * may differ between the cores if they map the memory differently.
+ *
+ * @param xBufferSizeBytes The size of the ring buffer.  Must be a power of 2
+ * that is at least configAMP_CACHE_LINE_SIZE.  Each message takes its length
+ * plus ampCHANNEL_MESSAGE_OVERHEAD bytes of the ring buffer.
+ *
+ * @param xEnd ampCHANNEL_SENDER if this core sends messages on the channel, or
+ * ampCHANNEL_RECEIVER if this core receives them.
+ *
+ * @param uxDoorbell Passed to configAMP_RING_DOORBELL() to interrupt the other
+ * core when a task on it must be woken.  Its meaning is defined by the
+ * application, for example a mailbox or software event number.
+ *
+ * @return A handle to the created channel end, or NULL if there was
+ * insufficient heap memory to create it.
+ *
+ * Example use:
+ * @code{c}
+ * #define mainBUFFER_SIZE    1024
+ *
+ * // Placed in a shared, zero initialised section by the linker scripts of
+ * // both cores.
+ * static uint8_t ucChannelMemory[ ampCHANNEL_SHARED_MEMORY_SIZE( mainBUFFER_SIZE ) ]
+ *     __attribute__( ( aligned( configAMP_CACHE_LINE_SIZE ), section( ".shared" ) ) );
+ *
+ * // On the Cortex-M7.
+ * xToM4 = xAMPChannelCreate( ucChannelMemory, mainBUFFER_SIZE, ampCHANNEL_SENDER, 0 );
+ *
+ * // On the Cortex-M4.
+ * xFromM7 = xAMPChannelCreate( ucChannelMemory, mainBUFFER_SIZE, ampCHANNEL_RECEIVER, 0 );
+ * @endcode
+ * \defgroup xAMPChannelCreate xAMPChannelCreate
+ * \ingroup AMPChannels
+ */
+AMPChannelHandle_t xAMPChannelCreate( void * pvSharedMemory,
+                                      size_t xBufferSizeBytes,
+                                      BaseType_t xEnd,
+                                      UBaseType_t uxDoorbell ) PRIVILEGED_FUNCTION;
+
+/**
+ * amp_channel.h
+ *
+ * @code{c}
+ * void vAMPChannelDelete( AMPChannelHandle_t xChannel );
+ * @endcode
+ *
+ * Frees this core's end of a channel.  The shared memory is not changed.  No
+ * task may be waiting on the end when it is deleted.
+ *
+ * \defgroup vAMPChannelDelete vAMPChannelDelete
+ * \ingroup AMPChannels
+ */
+void vAMPChannelDelete( AMPChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/**
+ * amp_channel.h
+ *
+ * @code{c}
+ * size_t xAMPChannelSend( AMPChannelHandle_t xChannel,
+ *                         const void * pvTxData,
+ *                         size_t xDataLengthBytes,
+ *                         TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies a message into a channel from the sending end, ringing the doorbell
+ * if a task on the receiving core is waiting for a message.  Only one task or
+ * interrupt on the sending core may send on a channel.
+ *
+ * @param xChannel The sending end of the channel.
+ *
+ * @param pvTxData The message to copy into the channel.
+ *
+ * @param xDataLengthBytes The length of the message, which must be greater
+ * than 0.  The message and its overhead must fit in the ring buffer.
+ *
+ * @param xTicksToWait The maximum time to wait for the receiving core to free
+ * enough space for the message.
+ *
+ * @return xDataLengthBytes if the message was sent, or 0 if there was not
+ * enough space before the timeout.
+ *
+ * \defgroup xAMPChannelSend xAMPChannelSend
+ * \ingroup AMPChannels
+ */
+size_t xAMPChannelSend( AMPChannelHandle_t xChannel,
+                        const void * pvTxData,
+                        size_t xDataLengthBytes,
+                        TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * amp_channel.h
+ *
+ * @code{c}
+ * size_t xAMPChannelSendFromISR( AMPChannelHandle_t xChannel,
+ *                                const void * pvTxData,
+ *                                size_t xDataLengthBytes );
+ * @endcode
+ *
+ * A version of xAMPChannelSend() that can be called from an interrupt service
+ * routine.  It never blocks, and never wakes a task on the calling core, so
+ * has no pxHigherPriorityTaskWoken parameter.
+ *
+ * \defgroup xAMPChannelSendFromISR xAMPChannelSendFromISR
+ * \ingroup AMPChannels
+ */
+size_t xAMPChannelSendFromISR( AMPChannelHandle_t xChannel,
+                               const void * pvTxData,
+                               size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * amp_channel.h
+ *
+ * @code{c}
+ * size_t xAMPChannelReceive( AMPChannelHandle_t xChannel,
+ *                            void * pvRxData,
+ *                            size_t xBufferLengthBytes,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the oldest message out of a channel at the receiving end, ringing
+ * the doorbell if a task on the sending core is waiting for space.  Only one
+ * task or interrupt on the receiving core may receive from a channel.
+ *
+ * @param xChannel The receiving end of the channel.
+ *
+ * @param pvRxData The buffer the message is copied into.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by pvRxData.
+ * If the oldest message is longer it is left in the channel and 0 is
+ * returned.
+ *
+ * @param xTicksToWait The maximum time to wait for a message.
+ *
+ * @return The length of the message received, or 0 if no message arrived
+ * before the timeout, or the buffer is too small for the message.
+ *
+ * Example use:
+ * @code{c}
+ * void vM4Task( void * pvParameters )
+ * {
+ * uint8_t ucMessage[ 64 ];
+ * size_t xLength;
+ *
+ *  for( ;; )
+ *  {
+ *      xLength = xAMPChannelReceive( xFromM7, ucMessage, sizeof( ucMessage ), portMAX_DELAY );
+ *      vProcessMessage( ucMessage, xLength );
+ *  }
+ * }
+ *
+ * // The handler for the interrupt that configAMP_RING_DOORBELL() raises on
+ * // the Cortex-M4.
+ * void vM4DoorbellHandler( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  vClearDoorbellInterrupt();
+ *  xAMPChannelDoorbellFromISR( xFromM7, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xAMPChannelReceive xAMPChannelReceive
+ * \ingroup AMPChannels
+ */
+size_t xAMPChannelReceive( AMPChannelHandle_t xChannel,
+                           void * pvRxData,
+                           size_t xBufferLengthBytes,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * amp_channel.h
+ *
+ * @code{c}
+ * size_t xAMPChannelReceiveFromISR( AMPChannelHandle_t xChannel,
+ *                                   void * pvRxData,
+ *                                   size_t xBufferLengthBytes );
+ * @endcode
+ *
+ * A version of xAMPChannelReceive() that can be called from an interrupt
+ * service routine.  It never blocks, and never wakes a task on the calling
+ * core, so has no pxHigherPriorityTaskWoken parameter.
+ *
+ * \defgroup xAMPChannelReceiveFromISR xAMPChannelReceiveFromISR
+ * \ingroup AMPChannels
+ */
+size_t xAMPChannelReceiveFromISR( AMPChannelHandle_t xChannel,
+                                  void * pvRxData,
+                                  size_t xBufferLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * amp_channel.h
+ *
+ * @code{c}
+ * BaseType_t xAMPChannelDoorbellFromISR( AMPChannelHandle_t xChannel,
+ *                                        BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Called from the doorbell interrupt handler for each channel end on this
+ * core that uses the doorbell.  Wakes the task that is waiting on the end, if
+ * any.  This is the AMP channel equivalent of calling
+ * xStreamBufferSendCompletedFromISR() on the receiving core of a stream buffer
+ * that is shared between cores.
+ *
+ * @param xChannel This core's end of the channel.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if waking the task caused a
+ * task to leave the Blocked state that has a priority above the currently
+ * running task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * @return pdTRUE if a task was waiting on the end, otherwise pdFALSE.
+ *
+ * \defgroup xAMPChannelDoorbellFromISR xAMPChannelDoorbellFromISR
+ * \ingroup AMPChannels
+ */
+BaseType_t xAMPChannelDoorbellFromISR( AMPChannelHandle_t xChannel,
+                                       BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * amp_channel.h
+ *
+ * @code{c}
+ * size_t xAMPChannelBytesAvailable( AMPChannelHandle_t xChannel );
+ * @endcode
+ *
+ * Returns the number of bytes of the ring buffer, including the overhead of
+ * each message, that hold messages that have not yet been received.  Can be
+ * called at either end.
+ *
+ * \defgroup xAMPChannelBytesAvailable xAMPChannelBytesAvailable
+ * \ingroup AMPChannels
+ */
+size_t xAMPChannelBytesAvailable( AMPChannelHandle_t xChannel ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( AMP_CHANNEL_H ) */
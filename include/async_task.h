@@ -0,0 +1,607 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Async tasks are stackless coroutines that run on the stack of a single host
+ * task, called an executor.  An async task costs one AsyncTask_t structure
+ * rather than a TCB and a stack, so many state machines that spend most of
+ * their time blocked can share the RAM of one task.
+ *
+ * An async task function is called by its executor each time the async task
+ * is scheduled, and returns when it awaits something that is not available.
+ * The asyncAWAIT_...() macros record where the function returned, and
+ * asyncBEGIN() jumps back to that point the next time the function is called.
+ * This means:
+ *
+ *  + Local variables are not preserved across an await.  Keep state that
+ *    must survive an await in static variables or in the structure passed as
+ *    the pvParameters value.
+ *  + Await macros can only be used in the async task function itself, not in
+ *    functions it calls, and there must be no more than one await on a line.
+ *  + Await macros cannot be used inside a switch statement.
+ *
+ * Async tasks can await data on a queue, a semaphore being available, a
+ * notification, data or space in a stream buffer, and a delay.  A software
+ * timer callback can signal an async task with xAsyncTaskNotify().  Each
+ * executor runs the highest priority ready async task first, and round robins
+ * between ready async tasks of equal priority.  Async tasks never preempt each
+ * other, and the executor itself is preempted by higher priority tasks as
+ * normal.
+ *
+ * configUSE_ASYNC_TASKS must be set to 1 in FreeRTOSConfig.h for this API to
+ * be available.  The executor waits on queues using xQueueWaitForAny(), so
+ * configUSE_QUEUE_WAIT_FOR_ANY must also be set to 1.
+ */
+
+#ifndef ASYNC_TASK_H
+#define ASYNC_TASK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include async_task.h"
+#endif
+
+#include "list.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which executors are referenced.  For example, a call to
+ * xAsyncExecutorCreate() returns an AsyncExecutorHandle_t variable that can
+ * then be used as a parameter to xAsyncTaskCreate().
+ */
+struct AsyncExecutorDefinition;
+typedef struct AsyncExecutorDefinition * AsyncExecutorHandle_t;
+
+/**
+ * Type by which async tasks are referenced.
+ */
+struct AsyncTaskControlBlock;
+typedef struct AsyncTaskControlBlock * AsyncTaskHandle_t;
+
+/*
+ * Defines the prototype to which async task functions must conform.
+ */
+typedef void (* AsyncTaskFunction_t)( AsyncTaskHandle_t xAsyncTask,
+                                      void * pvParameters );
+
+/*
+ * The async task control block.  It is defined here, rather than hidden in
+ * async_task.c, because the await macros read and write uxResumePoint, and so
+ * that applications can allocate async tasks statically.  The other members
+ * must only be accessed through the API functions.
+ */
+typedef struct AsyncTaskControlBlock
+{
+    UBaseType_t uxResumePoint;                 /*< Where the function continues from the next time it is called, or 0 to start at the beginning. */
+    AsyncTaskFunction_t pxFunction;            /*< The async task function. */
+    void * pvParameters;                       /*< The value passed to pxFunction. */
+    struct AsyncExecutorDefinition * pxExecutor; /*< The executor that runs the async task. */
+    ListItem_t xStateListItem;                 /*< References the executor's ready, delayed or wait forever list the async task is in. */
+    ListItem_t xEventListItem;                 /*< References the executor's list of async tasks waiting on a queue or stream buffer. */
+    void * pvWaitObject;                       /*< The queue, semaphore or stream buffer the async task is waiting on. */
+    TimeOut_t xTimeOut;                        /*< The time at which the current await started. */
+    TickType_t xTicksToWait;                   /*< The remaining block time of the current await. */
+    UBaseType_t uxPriority;                    /*< The priority of the async task relative to the other async tasks of the executor. */
+    volatile uint32_t ulNotifiedValue;         /*< Bits set by xAsyncTaskNotify() and not yet received. */
+    volatile uint8_t ucNotifyState;            /*< Whether the async task is waiting for, or has received, a notification. */
+    uint8_t ucStaticallyAllocated;             /*< Set to pdTRUE if the structure was provided by the application, so it is not freed when the async task ends. */
+} AsyncTask_t;
+
+/* The resume point of an async task whose function has reached asyncEND(). */
+#define asyncRESUME_POINT_FINISHED    ( ~( UBaseType_t ) 0U )
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * AsyncExecutorHandle_t xAsyncExecutorCreate( const char * const pcName,
+ *                                             configSTACK_DEPTH_TYPE uxStackDepth,
+ *                                             UBaseType_t uxPriority,
+ *                                             UBaseType_t uxMaxQueueWaits );
+ * @endcode
+ *
+ * Creates an executor and the host task that runs its async tasks, using
+ * dynamically allocated memory.  Executors cannot be deleted, so they are
+ * intended to be created once when the application starts.
+ *
+ * @param pcName The name given to the host task.
+ *
+ * @param uxStackDepth The stack size of the host task, in words.  It must be
+ * large enough for the deepest call made by any of the async tasks.
+ *
+ * @param uxPriority The priority of the host task.
+ *
+ * @param uxMaxQueueWaits The number of different queues and semaphores the
+ * executor can block its host task on at once.  If the async tasks are
+ * waiting on more objects than this, the executor polls the objects that did
+ * not fit once per tick.
+ *
+ * @return A handle to the created executor, or NULL if there was insufficient
+ * heap memory to create it.
+ *
+ * \defgroup xAsyncExecutorCreate xAsyncExecutorCreate
+ * \ingroup AsyncTasks
+ */
+AsyncExecutorHandle_t xAsyncExecutorCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                            configSTACK_DEPTH_TYPE uxStackDepth,
+                                            UBaseType_t uxPriority,
+                                            UBaseType_t uxMaxQueueWaits ) PRIVILEGED_FUNCTION;
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * BaseType_t xAsyncTaskCreate( AsyncExecutorHandle_t xExecutor,
+ *                              AsyncTaskFunction_t pxFunction,
+ *                              void * pvParameters,
+ *                              UBaseType_t uxPriority,
+ *                              AsyncTaskHandle_t * pxCreatedAsyncTask );
+ * @endcode
+ *
+ * Creates an async task that runs on xExecutor, allocating its control block
+ * from the FreeRTOS heap.  The control block is freed when the async task
+ * function reaches asyncEND().
+ *
+ * @param xExecutor The executor that runs the async task.
+ *
+ * @param pxFunction The async task function.  It must start with asyncBEGIN()
+ * and finish with asyncEND().
+ *
+ * @param pvParameters The value passed to pxFunction each time it is called.
+ *
+ * @param uxPriority The priority of the async task relative to the other
+ * async tasks of the same executor.  Must be less than
+ * configMAX_ASYNC_TASK_PRIORITIES.
+ *
+ * @param pxCreatedAsyncTask Used to pass back a handle to the created async
+ * task.  Can be NULL.
+ *
+ * @return pdPASS if the async task was created, otherwise
+ * errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY.
+ *
+ * Example use:
+ * @code{c}
+ * typedef struct
+ * {
+ *  QueueHandle_t xQueue;
+ *  uint32_t ulReceived;
+ * } Receiver_t;
+ *
+ * void vReceiver( AsyncTaskHandle_t xHandle, void * pvParameters )
+ * {
+ * Receiver_t * pxReceiver = pvParameters;
+ * BaseType_t xResult;
+ *
+ *  asyncBEGIN( xHandle );
+ *
+ *  for( ;; )
+ *  {
+ *      // Wait up to 100 ticks for a value.  Other async tasks of the same
+ *      // executor run while this one waits.
+ *      asyncAWAIT_QUEUE_RECEIVE( xHandle, pxReceiver->xQueue, &( pxReceiver->ulReceived ), 100, xResult );
+ *
+ *      if( xResult == pdPASS )
+ *      {
+ *          vProcess( pxReceiver->ulReceived );
+ *      }
+ *  }
+ *
+ *  asyncEND( xHandle );
+ * }
+ * @endcode
+ * \defgroup xAsyncTaskCreate xAsyncTaskCreate
+ * \ingroup AsyncTasks
+ */
+BaseType_t xAsyncTaskCreate( AsyncExecutorHandle_t xExecutor,
+                             AsyncTaskFunction_t pxFunction,
+                             void * pvParameters,
+                             UBaseType_t uxPriority,
+                             AsyncTaskHandle_t * pxCreatedAsyncTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * AsyncTaskHandle_t xAsyncTaskCreateStatic( AsyncExecutorHandle_t xExecutor,
+ *                                           AsyncTaskFunction_t pxFunction,
+ *                                           void * pvParameters,
+ *                                           UBaseType_t uxPriority,
+ *                                           AsyncTask_t * pxAsyncTaskBuffer );
+ * @endcode
+ *
+ * Creates an async task that runs on xExecutor using a control block provided
+ * by the application.  The control block can be reused once the async task
+ * function has reached asyncEND().
+ *
+ * @param pxAsyncTaskBuffer The control block, which must remain in scope
+ * while the async task exists.
+ *
+ * @return A handle to the created async task.
+ *
+ * \defgroup xAsyncTaskCreateStatic xAsyncTaskCreateStatic
+ * \ingroup AsyncTasks
+ */
+AsyncTaskHandle_t xAsyncTaskCreateStatic( AsyncExecutorHandle_t xExecutor,
+                                          AsyncTaskFunction_t pxFunction,
+                                          void * pvParameters,
+                                          UBaseType_t uxPriority,
+                                          AsyncTask_t * pxAsyncTaskBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * BaseType_t xAsyncTaskNotify( AsyncTaskHandle_t xAsyncTask,
+ *                              uint32_t ulBitsToSet );
+ * @endcode
+ *
+ * Sets bits in the notification value of an async task, unblocking it if it
+ * is waiting in asyncAWAIT_NOTIFY().  Can be called from tasks, from software
+ * timer callbacks, and from other async tasks.
+ *
+ * @param xAsyncTask The async task being notified.
+ *
+ * @param ulBitsToSet The bits that are ORed into the notification value.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xAsyncTaskNotify xAsyncTaskNotify
+ * \ingroup AsyncTasks
+ */
+BaseType_t xAsyncTaskNotify( AsyncTaskHandle_t xAsyncTask,
+                             uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * BaseType_t xAsyncTaskNotifyFromISR( AsyncTaskHandle_t xAsyncTask,
+ *                                     uint32_t ulBitsToSet,
+ *                                     BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xAsyncTaskNotify() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the notification
+ * unblocked the executor's host task and the host task has a priority above
+ * that of the currently running task, in which case a context switch should
+ * be requested before the interrupt is exited.
+ *
+ * \defgroup xAsyncTaskNotifyFromISR xAsyncTaskNotifyFromISR
+ * \ingroup AsyncTasks
+ */
+BaseType_t xAsyncTaskNotifyFromISR( AsyncTaskHandle_t xAsyncTask,
+                                    uint32_t ulBitsToSet,
+                                    BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * void vAsyncTaskStreamBufferCallback( StreamBufferHandle_t xStreamBuffer,
+ *                                      BaseType_t xIsInsideISR,
+ *                                      BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * An async task can only await a stream or message buffer that was created
+ * with this function as a completed callback, as the callback is what
+ * unblocks the async task.  Pass it as the send completed callback of a
+ * buffer that async tasks receive from, and as the receive completed
+ * callback of a buffer that async tasks send to.  The other callback must be
+ * NULL, so a task on the other side of the buffer is unblocked as normal.
+ * configUSE_SB_COMPLETED_CALLBACK must be set to 1.
+ *
+ * Example use:
+ * @code{c}
+ * // Data is sent by an interrupt and received by an async task.
+ * xStreamBuffer = xStreamBufferCreateWithCallback( 100, 1,
+ *                                                  vAsyncTaskStreamBufferCallback,
+ *                                                  NULL );
+ * @endcode
+ * \defgroup vAsyncTaskStreamBufferCallback vAsyncTaskStreamBufferCallback
+ * \ingroup AsyncTasks
+ */
+#if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
+    void vAsyncTaskStreamBufferCallback( StreamBufferHandle_t xStreamBuffer,
+                                         BaseType_t xIsInsideISR,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncBEGIN( AsyncTaskHandle_t xHandle );
+ * @endcode
+ *
+ * Must be the first statement of an async task function, after the
+ * declarations.
+ *
+ * \defgroup asyncBEGIN asyncBEGIN
+ * \ingroup AsyncTasks
+ */
+#define asyncBEGIN( xHandle )          \
+    switch( ( xHandle )->uxResumePoint ) \
+    {                                  \
+        case 0:
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncEND( AsyncTaskHandle_t xHandle );
+ * @endcode
+ *
+ * Must be the last statement of an async task function.  An async task ends
+ * when its function reaches asyncEND(), or returns with asyncEXIT(), and is
+ * then removed from its executor.
+ *
+ * \defgroup asyncEND asyncEND
+ * \ingroup AsyncTasks
+ */
+#define asyncEND( xHandle )                                        \
+        ( xHandle )->uxResumePoint = asyncRESUME_POINT_FINISHED; \
+        break;                                                     \
+    default:                                                       \
+        break;                                                     \
+    }
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncEXIT( AsyncTaskHandle_t xHandle );
+ * @endcode
+ *
+ * Ends the async task from anywhere in its function.
+ *
+ * \defgroup asyncEXIT asyncEXIT
+ * \ingroup AsyncTasks
+ */
+#define asyncEXIT( xHandle )                                   \
+    do {                                                       \
+        ( xHandle )->uxResumePoint = asyncRESUME_POINT_FINISHED; \
+        return;                                                \
+    } while( 0 )
+
+/*
+ * The building block of the await macros.  xOperation is evaluated each time
+ * the async task is run until it returns something other than
+ * errQUEUE_BLOCKED, and the async task function returns to the executor in
+ * between.  Not intended to be used directly.
+ */
+#define asyncAWAIT( xHandle, xTicksToWait, xOperation, xResult )    \
+    vAsyncTaskSetTimeOut( ( xHandle ), ( xTicksToWait ) );          \
+    ( xHandle )->uxResumePoint = ( UBaseType_t ) __LINE__;          \
+    /* FALLTHROUGH */                                               \
+    case __LINE__:                                                  \
+    ( xResult ) = ( xOperation );                                   \
+    if( ( xResult ) == errQUEUE_BLOCKED )                           \
+    {                                                               \
+        return;                                                     \
+    }
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncYIELD( AsyncTaskHandle_t xHandle );
+ * @endcode
+ *
+ * Lets the other ready async tasks of the same priority run before the
+ * calling async task continues.
+ *
+ * \defgroup asyncYIELD asyncYIELD
+ * \ingroup AsyncTasks
+ */
+#define asyncYIELD( xHandle )                                   \
+    do {                                                        \
+        ( xHandle )->uxResumePoint = ( UBaseType_t ) __LINE__;  \
+        return;                                                 \
+        /* FALLTHROUGH */                                       \
+        case __LINE__:                                          \
+        ;                                                       \
+    } while( 0 )
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncDELAY( AsyncTaskHandle_t xHandle, TickType_t xTicksToDelay );
+ * @endcode
+ *
+ * Delays the async task for a number of ticks, during which the other async
+ * tasks of the executor run.  A delay of 0 returns immediately.
+ *
+ * \defgroup asyncDELAY asyncDELAY
+ * \ingroup AsyncTasks
+ */
+#define asyncDELAY( xHandle, xTicksToDelay )                                                                   \
+    do {                                                                                                       \
+        BaseType_t xAsyncDelayResult;                                                                          \
+        asyncAWAIT( ( xHandle ), ( xTicksToDelay ), xAsyncTaskDelay( xHandle ), xAsyncDelayResult );           \
+        ( void ) xAsyncDelayResult;                                                                            \
+    } while( 0 )
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncAWAIT_QUEUE_RECEIVE( AsyncTaskHandle_t xHandle,
+ *                           QueueHandle_t xQueue,
+ *                           void * pvBuffer,
+ *                           TickType_t xTicksToWait,
+ *                           BaseType_t xResult );
+ * @endcode
+ *
+ * Receives an item from a queue, waiting up to xTicksToWait ticks for one to
+ * be available.  pvBuffer must not point to a local variable of the async
+ * task function.  xResult is set to pdPASS if an item was received, otherwise
+ * errQUEUE_EMPTY.
+ *
+ * \defgroup asyncAWAIT_QUEUE_RECEIVE asyncAWAIT_QUEUE_RECEIVE
+ * \ingroup AsyncTasks
+ */
+#define asyncAWAIT_QUEUE_RECEIVE( xHandle, xQueue, pvBuffer, xTicksToWait, xResult ) \
+    asyncAWAIT( ( xHandle ), ( xTicksToWait ), xAsyncTaskQueueReceive( ( xHandle ), ( xQueue ), ( pvBuffer ) ), ( xResult ) )
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncAWAIT_SEMAPHORE_TAKE( AsyncTaskHandle_t xHandle,
+ *                            SemaphoreHandle_t xSemaphore,
+ *                            TickType_t xTicksToWait,
+ *                            BaseType_t xResult );
+ * @endcode
+ *
+ * Takes a binary or counting semaphore, waiting up to xTicksToWait ticks for
+ * it to be available.  Mutexes cannot be awaited, as priority inheritance
+ * does not apply to async tasks.  xResult is set to pdPASS if the semaphore
+ * was taken, otherwise pdFAIL.
+ *
+ * \defgroup asyncAWAIT_SEMAPHORE_TAKE asyncAWAIT_SEMAPHORE_TAKE
+ * \ingroup AsyncTasks
+ */
+#define asyncAWAIT_SEMAPHORE_TAKE( xHandle, xSemaphore, xTicksToWait, xResult ) \
+    asyncAWAIT( ( xHandle ), ( xTicksToWait ), xAsyncTaskQueueReceive( ( xHandle ), ( xSemaphore ), NULL ), ( xResult ) )
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncAWAIT_NOTIFY( AsyncTaskHandle_t xHandle,
+ *                    uint32_t * pulNotificationValue,
+ *                    TickType_t xTicksToWait,
+ *                    BaseType_t xResult );
+ * @endcode
+ *
+ * Waits up to xTicksToWait ticks for xAsyncTaskNotify() to be called.  The
+ * bits set since the last notification was received are written to
+ * *pulNotificationValue, which can be NULL, and cleared.  xResult is set to
+ * pdPASS if a notification was received, otherwise pdFAIL.
+ *
+ * \defgroup asyncAWAIT_NOTIFY asyncAWAIT_NOTIFY
+ * \ingroup AsyncTasks
+ */
+#define asyncAWAIT_NOTIFY( xHandle, pulNotificationValue, xTicksToWait, xResult ) \
+    asyncAWAIT( ( xHandle ), ( xTicksToWait ), xAsyncTaskNotifyWait( ( xHandle ), ( pulNotificationValue ) ), ( xResult ) )
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncAWAIT_STREAM_BUFFER_RECEIVE( AsyncTaskHandle_t xHandle,
+ *                                   StreamBufferHandle_t xStreamBuffer,
+ *                                   void * pvRxData,
+ *                                   size_t xBufferLengthBytes,
+ *                                   size_t * pxReceivedBytes,
+ *                                   TickType_t xTicksToWait,
+ *                                   BaseType_t xResult );
+ * @endcode
+ *
+ * Receives from a stream or message buffer created with
+ * vAsyncTaskStreamBufferCallback() as its send completed callback, waiting up
+ * to xTicksToWait ticks for data.  The number of bytes received is written to
+ * *pxReceivedBytes.  xResult is set to pdPASS if data was received, otherwise
+ * pdFAIL.
+ *
+ * \defgroup asyncAWAIT_STREAM_BUFFER_RECEIVE asyncAWAIT_STREAM_BUFFER_RECEIVE
+ * \ingroup AsyncTasks
+ */
+#define asyncAWAIT_STREAM_BUFFER_RECEIVE( xHandle, xStreamBuffer, pvRxData, xBufferLengthBytes, pxReceivedBytes, xTicksToWait, xResult ) \
+    asyncAWAIT( ( xHandle ), ( xTicksToWait ),                                                                                           \
+                xAsyncTaskStreamBufferReceive( ( xHandle ), ( xStreamBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxReceivedBytes ) ), \
+                ( xResult ) )
+
+/**
+ * async_task.h
+ *
+ * @code{c}
+ * asyncAWAIT_STREAM_BUFFER_SEND( AsyncTaskHandle_t xHandle,
+ *                                StreamBufferHandle_t xStreamBuffer,
+ *                                const void * pvTxData,
+ *                                size_t xDataLengthBytes,
+ *                                TickType_t xTicksToWait,
+ *                                BaseType_t xResult );
+ * @endcode
+ *
+ * Sends all xDataLengthBytes bytes to a stream or message buffer created with
+ * vAsyncTaskStreamBufferCallback() as its receive completed callback, waiting
+ * up to xTicksToWait ticks for enough space.  Nothing is sent unless all the
+ * bytes fit.  xResult is set to pdPASS if the data was sent, otherwise
+ * pdFAIL.
+ *
+ * \defgroup asyncAWAIT_STREAM_BUFFER_SEND asyncAWAIT_STREAM_BUFFER_SEND
+ * \ingroup AsyncTasks
+ */
+#define asyncAWAIT_STREAM_BUFFER_SEND( xHandle, xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait, xResult ) \
+    asyncAWAIT( ( xHandle ), ( xTicksToWait ),                                                                      \
+                xAsyncTaskStreamBufferSend( ( xHandle ), ( xStreamBuffer ), ( pvTxData ), ( xDataLengthBytes ) ), \
+                ( xResult ) )
+
+/*
+ * Functions used by the macros above.  Not to be called directly.  Each
+ * operation either completes, fails because the block time set by
+ * vAsyncTaskSetTimeOut() has expired, or returns errQUEUE_BLOCKED after
+ * arranging for the async task to be run again when it might succeed.
+ */
+void vAsyncTaskSetTimeOut( AsyncTaskHandle_t xAsyncTask,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskDelay( AsyncTaskHandle_t xAsyncTask ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskQueueReceive( AsyncTaskHandle_t xAsyncTask,
+                                   QueueHandle_t xQueue,
+                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskNotifyWait( AsyncTaskHandle_t xAsyncTask,
+                                 uint32_t * pulNotificationValue ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskStreamBufferReceive( AsyncTaskHandle_t xAsyncTask,
+                                          StreamBufferHandle_t xStreamBuffer,
+                                          void * pvRxData,
+                                          size_t xBufferLengthBytes,
+                                          size_t * pxReceivedBytes ) PRIVILEGED_FUNCTION;
+BaseType_t xAsyncTaskStreamBufferSend( AsyncTaskHandle_t xAsyncTask,
+                                       StreamBufferHandle_t xStreamBuffer,
+                                       const void * pvTxData,
+                                       size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( ASYNC_TASK_H ) */
@@ -30,9 +30,13 @@
  * @file atomic.h
  * @brief FreeRTOS atomic operation support.
  *
- * This file implements atomic functions by disabling interrupts globally.
- * Implementations with architecture specific atomic instructions can be
- * provided under each compiler directory.
+ * This file implements atomic functions by disabling interrupts globally,
+ * unless the port sets portHAS_NATIVE_ATOMICS to 1, in which case they are
+ * implemented with the compiler's __atomic built-in functions.  These compile
+ * to the architecture's own atomic instructions - for example LDREX/STREX on
+ * ARMv7-M and ARMv8-M, LR/SC or AMO instructions on RISC-V and LDAXR/STLXR on
+ * ARMv8-A - so they do not add to interrupt latency.  Both implementations
+ * are fully ordered.
  */
 
 #ifndef ATOMIC_H
@@ -90,6 +94,78 @@
 #define ATOMIC_COMPARE_AND_SWAP_SUCCESS    0x1U     /**< Compare and swap succeeded, swapped. */
 #define ATOMIC_COMPARE_AND_SWAP_FAILURE    0x0U     /**< Compare and swap failed, did not swap. */
 
+/*
+ * Memory orders for the functions that take one.  The functions without a
+ * memory order parameter are sequentially consistent.  The critical section
+ * implementation always orders fully, so ignores the memory order.
+ */
+#if ( portHAS_NATIVE_ATOMICS == 1 )
+    #define ATOMIC_ORDER_RELAXED    __ATOMIC_RELAXED  /**< Atomicity only, no ordering of other accesses. */
+    #define ATOMIC_ORDER_ACQUIRE    __ATOMIC_ACQUIRE  /**< Later accesses cannot be moved before the operation. */
+    #define ATOMIC_ORDER_RELEASE    __ATOMIC_RELEASE  /**< Earlier accesses cannot be moved after the operation. */
+    #define ATOMIC_ORDER_ACQ_REL    __ATOMIC_ACQ_REL  /**< Both acquire and release. */
+    #define ATOMIC_ORDER_SEQ_CST    __ATOMIC_SEQ_CST  /**< Acquire and release, plus a single total order of all such operations. */
+
+/* The memory order to use when a compare-and-swap fails, which must not be a
+ * release order. */
+    #define atomicFAILURE_ORDER( xMemoryOrder )                                       \
+    ( ( ( xMemoryOrder ) == ATOMIC_ORDER_RELEASE ) ? ATOMIC_ORDER_RELAXED :           \
+      ( ( ( xMemoryOrder ) == ATOMIC_ORDER_ACQ_REL ) ? ATOMIC_ORDER_ACQUIRE : ( xMemoryOrder ) ) )
+#else
+    #define ATOMIC_ORDER_RELAXED    0
+    #define ATOMIC_ORDER_ACQUIRE    2
+    #define ATOMIC_ORDER_RELEASE    3
+    #define ATOMIC_ORDER_ACQ_REL    4
+    #define ATOMIC_ORDER_SEQ_CST    5
+#endif /* portHAS_NATIVE_ATOMICS */
+
+/*
+ * 64-bit operations and the double-width compare-and-swap of a tagged pointer
+ * are only native when the compiler reports the architecture can perform a
+ * compare-and-swap of that width without a lock - for example not on ARMv7-M
+ * and ARMv8-M, which have no 64-bit exclusive access instructions.  The
+ * double-width compare-and-swap uses the __sync built-in, as GCC implements
+ * the 16 byte __atomic built-ins with calls into libatomic.
+ */
+#if ( ( portHAS_NATIVE_ATOMICS == 1 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8 ) )
+    #define atomicHAS_NATIVE_64_BIT    1
+#else
+    #define atomicHAS_NATIVE_64_BIT    0
+#endif
+
+#if ( ( portHAS_NATIVE_ATOMICS == 1 ) && ( __SIZEOF_POINTER__ == 4 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_8 ) )
+    #define atomicHAS_NATIVE_DOUBLE_WIDTH    1
+#elif ( ( portHAS_NATIVE_ATOMICS == 1 ) && ( __SIZEOF_POINTER__ == 8 ) && defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16 ) )
+    #define atomicHAS_NATIVE_DOUBLE_WIDTH    1
+#else
+    #define atomicHAS_NATIVE_DOUBLE_WIDTH    0
+#endif
+
+#if ( atomicHAS_NATIVE_DOUBLE_WIDTH == 1 )
+    #if ( __SIZEOF_POINTER__ == 4 )
+        typedef uint64_t atomicDoubleWidth_t __attribute__( ( may_alias ) );
+    #else
+        typedef unsigned __int128 atomicDoubleWidth_t __attribute__( ( may_alias ) );
+    #endif
+#endif
+
+/*
+ * A pointer paired with a tag, for Atomic_CompareAndSwapTaggedPointer().
+ * Changing the tag each time the pointer is written lets a lock-free
+ * structure detect that a pointer was changed and changed back between its
+ * read and its compare-and-swap (the ABA problem).  Double-width exclusive
+ * accesses need the pair to be aligned to its size.
+ */
+typedef struct AtomicTaggedPointer
+{
+    void * pvPointer;
+    uintptr_t uxTag;
+}
+#if ( atomicHAS_NATIVE_DOUBLE_WIDTH == 1 )
+    __attribute__( ( aligned( 2 * __SIZEOF_POINTER__ ) ) )
+#endif
+AtomicTaggedPointer_t;
+
 /*----------------------------- Swap && CAS ------------------------------*/
 
 /**
@@ -113,11 +189,10 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
 {
     uint32_t ulReturnValue;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
     {
-        if( *pulDestination == ulComparand )
+        if( __atomic_compare_exchange_n( pulDestination, &ulComparand, ulExchange, pdFALSE, ATOMIC_ORDER_SEQ_CST, ATOMIC_ORDER_SEQ_CST ) )
         {
-            *pulDestination = ulExchange;
             ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
         }
         else
@@ -125,7 +200,67 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u32( uint32_t volatile *
             ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
         }
     }
-    ATOMIC_EXIT_CRITICAL();
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            if( *pulDestination == ulComparand )
+            {
+                *pulDestination = ulExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+            else
+            {
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+            }
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+
+    return ulReturnValue;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic compare-and-swap (UBaseType_t)
+ *
+ * @brief As Atomic_CompareAndSwap_u32(), but on a UBaseType_t, which is the
+ *        natural word size of the architecture.
+ *
+ * @param[in, out] puxDestination  Pointer to memory location from where value is
+ *                               to be loaded and checked.
+ * @param[in] uxExchange         If condition meets, write this value to memory.
+ * @param[in] uxComparand        Swap condition.
+ *
+ * @return Unsigned integer of value 1 or 0. 1 for swapped, 0 for not swapped.
+ */
+static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_ux( UBaseType_t volatile * puxDestination,
+                                                           UBaseType_t uxExchange,
+                                                           UBaseType_t uxComparand )
+{
+    uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        if( __atomic_compare_exchange_n( puxDestination, &uxComparand, uxExchange, pdFALSE, ATOMIC_ORDER_SEQ_CST, ATOMIC_ORDER_SEQ_CST ) )
+        {
+            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+        }
+    }
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            if( *puxDestination == uxComparand )
+            {
+                *puxDestination = uxExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulReturnValue;
 }
@@ -148,12 +283,20 @@ static portFORCE_INLINE void * Atomic_SwapPointers_p32( void * volatile * ppvDes
 {
     void * pReturnValue;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
     {
-        pReturnValue = *ppvDestination;
-        *ppvDestination = pvExchange;
+        pReturnValue = __atomic_exchange_n( ppvDestination, pvExchange, ATOMIC_ORDER_SEQ_CST );
     }
-    ATOMIC_EXIT_CRITICAL();
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            pReturnValue = *ppvDestination;
+            *ppvDestination = pvExchange;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return pReturnValue;
 }
@@ -181,15 +324,26 @@ static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointers_p32( void * volat
 {
     uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
     {
-        if( *ppvDestination == pvComparand )
+        if( __atomic_compare_exchange_n( ppvDestination, &pvComparand, pvExchange, pdFALSE, ATOMIC_ORDER_SEQ_CST, ATOMIC_ORDER_SEQ_CST ) )
         {
-            *ppvDestination = pvExchange;
             ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
         }
     }
-    ATOMIC_EXIT_CRITICAL();
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            if( *ppvDestination == pvComparand )
+            {
+                *ppvDestination = pvExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulReturnValue;
 }
@@ -213,12 +367,20 @@ static portFORCE_INLINE uint32_t Atomic_Add_u32( uint32_t volatile * pulAddend,
 {
     uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
     {
-        ulCurrent = *pulAddend;
-        *pulAddend += ulCount;
+        ulCurrent = __atomic_fetch_add( pulAddend, ulCount, ATOMIC_ORDER_SEQ_CST );
     }
-    ATOMIC_EXIT_CRITICAL();
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend += ulCount;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulCurrent;
 }
@@ -241,12 +403,20 @@ static portFORCE_INLINE uint32_t Atomic_Subtract_u32( uint32_t volatile * pulAdd
 {
     uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        ulCurrent = __atomic_fetch_sub( pulAddend, ulCount, ATOMIC_ORDER_SEQ_CST );
+    }
+    #else
     {
-        ulCurrent = *pulAddend;
-        *pulAddend -= ulCount;
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend -= ulCount;
+        }
+        ATOMIC_EXIT_CRITICAL();
     }
-    ATOMIC_EXIT_CRITICAL();
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulCurrent;
 }
@@ -266,12 +436,20 @@ static portFORCE_INLINE uint32_t Atomic_Increment_u32( uint32_t volatile * pulAd
 {
     uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
     {
-        ulCurrent = *pulAddend;
-        *pulAddend += 1;
+        ulCurrent = __atomic_fetch_add( pulAddend, 1U, ATOMIC_ORDER_SEQ_CST );
     }
-    ATOMIC_EXIT_CRITICAL();
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend += 1;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulCurrent;
 }
@@ -291,12 +469,20 @@ static portFORCE_INLINE uint32_t Atomic_Decrement_u32( uint32_t volatile * pulAd
 {
     uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        ulCurrent = __atomic_fetch_sub( pulAddend, 1U, ATOMIC_ORDER_SEQ_CST );
+    }
+    #else
     {
-        ulCurrent = *pulAddend;
-        *pulAddend -= 1;
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulAddend;
+            *pulAddend -= 1;
+        }
+        ATOMIC_EXIT_CRITICAL();
     }
-    ATOMIC_EXIT_CRITICAL();
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulCurrent;
 }
@@ -319,12 +505,20 @@ static portFORCE_INLINE uint32_t Atomic_OR_u32( uint32_t volatile * pulDestinati
 {
     uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        ulCurrent = __atomic_fetch_or( pulDestination, ulValue, ATOMIC_ORDER_SEQ_CST );
+    }
+    #else
     {
-        ulCurrent = *pulDestination;
-        *pulDestination |= ulValue;
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination |= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
     }
-    ATOMIC_EXIT_CRITICAL();
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulCurrent;
 }
@@ -346,12 +540,20 @@ static portFORCE_INLINE uint32_t Atomic_AND_u32( uint32_t volatile * pulDestinat
 {
     uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
     {
-        ulCurrent = *pulDestination;
-        *pulDestination &= ulValue;
+        ulCurrent = __atomic_fetch_and( pulDestination, ulValue, ATOMIC_ORDER_SEQ_CST );
     }
-    ATOMIC_EXIT_CRITICAL();
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination &= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulCurrent;
 }
@@ -373,12 +575,20 @@ static portFORCE_INLINE uint32_t Atomic_NAND_u32( uint32_t volatile * pulDestina
 {
     uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        ulCurrent = __atomic_fetch_nand( pulDestination, ulValue, ATOMIC_ORDER_SEQ_CST );
+    }
+    #else
     {
-        ulCurrent = *pulDestination;
-        *pulDestination = ~( ulCurrent & ulValue );
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination = ~( ulCurrent & ulValue );
+        }
+        ATOMIC_EXIT_CRITICAL();
     }
-    ATOMIC_EXIT_CRITICAL();
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulCurrent;
 }
@@ -400,12 +610,464 @@ static portFORCE_INLINE uint32_t Atomic_XOR_u32( uint32_t volatile * pulDestinat
 {
     uint32_t ulCurrent;
 
-    ATOMIC_ENTER_CRITICAL();
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        ulCurrent = __atomic_fetch_xor( pulDestination, ulValue, ATOMIC_ORDER_SEQ_CST );
+    }
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulCurrent = *pulDestination;
+            *pulDestination ^= ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+
+    return ulCurrent;
+}
+
+/*----------------------------- 64-bit and Double-Width ------------------------------*/
+
+/**
+ * Atomic compare-and-swap (64-bit)
+ *
+ * @brief Performs an atomic compare-and-swap operation on 64-bit values.
+ *
+ * @param[in, out] pullDestination  Pointer to memory location from where value is
+ *                                 to be loaded and checked.
+ * @param[in] ullExchange         If condition meets, write this value to memory.
+ * @param[in] ullComparand        Swap condition.
+ *
+ * @return Unsigned integer of value 1 or 0. 1 for swapped, 0 for not swapped.
+ */
+static portFORCE_INLINE uint32_t Atomic_CompareAndSwap_u64( uint64_t volatile * pullDestination,
+                                                            uint64_t ullExchange,
+                                                            uint64_t ullComparand )
+{
+    uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+
+    #if ( atomicHAS_NATIVE_64_BIT == 1 )
+    {
+        if( __atomic_compare_exchange_n( pullDestination, &ullComparand, ullExchange, pdFALSE, ATOMIC_ORDER_SEQ_CST, ATOMIC_ORDER_SEQ_CST ) )
+        {
+            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+        }
+    }
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            if( *pullDestination == ullComparand )
+            {
+                *pullDestination = ullExchange;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* atomicHAS_NATIVE_64_BIT */
+
+    return ulReturnValue;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic load (64-bit)
+ *
+ * @brief Reads a 64-bit value without the risk of reading half of one write
+ *        and half of another.
+ *
+ * @param[in] pullSource  Pointer to memory location to read.
+ *
+ * @return The value read.
+ */
+static portFORCE_INLINE uint64_t Atomic_Load_u64( uint64_t volatile * pullSource )
+{
+    uint64_t ullValue;
+
+    #if ( atomicHAS_NATIVE_64_BIT == 1 )
+    {
+        ullValue = __atomic_load_n( pullSource, ATOMIC_ORDER_SEQ_CST );
+    }
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ullValue = *pullSource;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* atomicHAS_NATIVE_64_BIT */
+
+    return ullValue;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic add (64-bit)
+ *
+ * @brief Atomically adds ullCount to the value of the specified pointer points to.
+ *
+ * @param[in,out] pullAddend  Pointer to memory location from where value is to be
+ *                          loaded and written back to.
+ * @param[in] ullCount      Value to be added to *pullAddend.
+ *
+ * @return previous *pullAddend value.
+ */
+static portFORCE_INLINE uint64_t Atomic_Add_u64( uint64_t volatile * pullAddend,
+                                                 uint64_t ullCount )
+{
+    uint64_t ullCurrent;
+
+    #if ( atomicHAS_NATIVE_64_BIT == 1 )
+    {
+        ullCurrent = __atomic_fetch_add( pullAddend, ullCount, ATOMIC_ORDER_SEQ_CST );
+    }
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ullCurrent = *pullAddend;
+            *pullAddend += ullCount;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* atomicHAS_NATIVE_64_BIT */
+
+    return ullCurrent;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic compare-and-swap (tagged pointer)
+ *
+ * @brief Performs an atomic compare-and-swap of a pointer and its tag as a
+ *        single double-width value.
+ *
+ * @param[in, out] pxDestination  Pointer to the tagged pointer to be loaded
+ *                              and checked.
+ * @param[in] xExchange         If condition meets, write this pointer and tag
+ *                              to memory.
+ * @param[in] xComparand        Swap condition.  Both the pointer and the tag
+ *                              must match.
+ *
+ * @return Unsigned integer of value 1 or 0. 1 for swapped, 0 for not swapped.
+ */
+static portFORCE_INLINE uint32_t Atomic_CompareAndSwapTaggedPointer( AtomicTaggedPointer_t volatile * pxDestination,
+                                                                     AtomicTaggedPointer_t xExchange,
+                                                                     AtomicTaggedPointer_t xComparand )
+{
+    uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+
+    #if ( atomicHAS_NATIVE_DOUBLE_WIDTH == 1 )
+    {
+        if( __sync_bool_compare_and_swap( ( atomicDoubleWidth_t volatile * ) pxDestination,
+                                          *( ( atomicDoubleWidth_t * ) &xComparand ),
+                                          *( ( atomicDoubleWidth_t * ) &xExchange ) ) )
+        {
+            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+        }
+    }
+    #else
+    {
+        ATOMIC_ENTER_CRITICAL();
+        {
+            if( ( pxDestination->pvPointer == xComparand.pvPointer ) && ( pxDestination->uxTag == xComparand.uxTag ) )
+            {
+                pxDestination->pvPointer = xExchange.pvPointer;
+                pxDestination->uxTag = xExchange.uxTag;
+                ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+            }
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* atomicHAS_NATIVE_DOUBLE_WIDTH */
+
+    return ulReturnValue;
+}
+
+/*----------------------------- Explicit Memory Order ------------------------------*/
+
+/**
+ * Atomic load with memory order
+ *
+ * @brief Reads a 32-bit value atomically.
+ *
+ * @param[in] pulSource     Pointer to memory location to read.
+ * @param[in] xMemoryOrder  ATOMIC_ORDER_RELAXED, ATOMIC_ORDER_ACQUIRE or
+ *                          ATOMIC_ORDER_SEQ_CST.
+ *
+ * @return The value read.
+ */
+static portFORCE_INLINE uint32_t Atomic_Load_u32( uint32_t volatile * pulSource,
+                                                  BaseType_t xMemoryOrder )
+{
+    uint32_t ulValue;
+
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        ulValue = __atomic_load_n( pulSource, xMemoryOrder );
+    }
+    #else
+    {
+        ( void ) xMemoryOrder;
+
+        ATOMIC_ENTER_CRITICAL();
+        {
+            ulValue = *pulSource;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+
+    return ulValue;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic store with memory order
+ *
+ * @brief Writes a 32-bit value atomically.
+ *
+ * @param[out] pulDestination  Pointer to memory location to write.
+ * @param[in] ulValue          The value to write.
+ * @param[in] xMemoryOrder     ATOMIC_ORDER_RELAXED, ATOMIC_ORDER_RELEASE or
+ *                             ATOMIC_ORDER_SEQ_CST.
+ */
+static portFORCE_INLINE void Atomic_Store_u32( uint32_t volatile * pulDestination,
+                                               uint32_t ulValue,
+                                               BaseType_t xMemoryOrder )
+{
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        __atomic_store_n( pulDestination, ulValue, xMemoryOrder );
+    }
+    #else
+    {
+        ( void ) xMemoryOrder;
+
+        ATOMIC_ENTER_CRITICAL();
+        {
+            *pulDestination = ulValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic pointer load with memory order
+ *
+ * @brief Reads a pointer atomically.
+ *
+ * @param[in] ppvSource     Pointer to memory location to read.
+ * @param[in] xMemoryOrder  ATOMIC_ORDER_RELAXED, ATOMIC_ORDER_ACQUIRE or
+ *                          ATOMIC_ORDER_SEQ_CST.
+ *
+ * @return The pointer read.
+ */
+static portFORCE_INLINE void * Atomic_LoadPointer_p32( void * volatile * ppvSource,
+                                                       BaseType_t xMemoryOrder )
+{
+    void * pvValue;
+
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        pvValue = __atomic_load_n( ppvSource, xMemoryOrder );
+    }
+    #else
+    {
+        ( void ) xMemoryOrder;
+
+        ATOMIC_ENTER_CRITICAL();
+        {
+            pvValue = *ppvSource;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+
+    return pvValue;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic pointer store with memory order
+ *
+ * @brief Writes a pointer atomically.
+ *
+ * @param[out] ppvDestination  Pointer to memory location to write.
+ * @param[in] pvValue          The pointer to write.
+ * @param[in] xMemoryOrder     ATOMIC_ORDER_RELAXED, ATOMIC_ORDER_RELEASE or
+ *                             ATOMIC_ORDER_SEQ_CST.
+ */
+static portFORCE_INLINE void Atomic_StorePointer_p32( void * volatile * ppvDestination,
+                                                      void * pvValue,
+                                                      BaseType_t xMemoryOrder )
+{
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        __atomic_store_n( ppvDestination, pvValue, xMemoryOrder );
+    }
+    #else
+    {
+        ( void ) xMemoryOrder;
+
+        ATOMIC_ENTER_CRITICAL();
+        {
+            *ppvDestination = pvValue;
+        }
+        ATOMIC_EXIT_CRITICAL();
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic compare-and-swap with memory order
+ *
+ * @brief As Atomic_CompareAndSwap_u32(), but only orders other memory
+ *        accesses as requested by xMemoryOrder.  A failed compare-and-swap
+ *        has no release semantics.
+ *
+ * @param[in, out] pulDestination  Pointer to memory location from where value is
+ *                               to be loaded and checked.
+ * @param[in] ulExchange         If condition meets, write this value to memory.
+ * @param[in] ulComparand        Swap condition.
+ * @param[in] xMemoryOrder       One of the ATOMIC_ORDER_ values.
+ *
+ * @return Unsigned integer of value 1 or 0. 1 for swapped, 0 for not swapped.
+ */
+static portFORCE_INLINE uint32_t Atomic_CompareAndSwapExplicit_u32( uint32_t volatile * pulDestination,
+                                                                    uint32_t ulExchange,
+                                                                    uint32_t ulComparand,
+                                                                    BaseType_t xMemoryOrder )
+{
+    uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        if( __atomic_compare_exchange_n( pulDestination, &ulComparand, ulExchange, pdFALSE, xMemoryOrder, atomicFAILURE_ORDER( xMemoryOrder ) ) )
+        {
+            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+        }
+    }
+    #else
+    {
+        ( void ) xMemoryOrder;
+        ulReturnValue = Atomic_CompareAndSwap_u32( pulDestination, ulExchange, ulComparand );
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+
+    return ulReturnValue;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic compare-and-swap (pointers) with memory order
+ *
+ * @brief As Atomic_CompareAndSwapPointers_p32(), but only orders other memory
+ *        accesses as requested by xMemoryOrder.  A failed compare-and-swap
+ *        has no release semantics.
+ *
+ * @param[in, out] ppvDestination  The memory location to check and update.
+ * @param[in] pvExchange           If condition meets, write this value to memory.
+ * @param[in] pvComparand          Swap condition.
+ * @param[in] xMemoryOrder         One of the ATOMIC_ORDER_ values.
+ *
+ * @return Unsigned integer of value 1 or 0. 1 for swapped, 0 for not swapped.
+ */
+static portFORCE_INLINE uint32_t Atomic_CompareAndSwapPointersExplicit_p32( void * volatile * ppvDestination,
+                                                                            void * pvExchange,
+                                                                            void * pvComparand,
+                                                                            BaseType_t xMemoryOrder )
+{
+    uint32_t ulReturnValue = ATOMIC_COMPARE_AND_SWAP_FAILURE;
+
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        if( __atomic_compare_exchange_n( ppvDestination, &pvComparand, pvExchange, pdFALSE, xMemoryOrder, atomicFAILURE_ORDER( xMemoryOrder ) ) )
+        {
+            ulReturnValue = ATOMIC_COMPARE_AND_SWAP_SUCCESS;
+        }
+    }
+    #else
+    {
+        ( void ) xMemoryOrder;
+        ulReturnValue = Atomic_CompareAndSwapPointers_p32( ppvDestination, pvExchange, pvComparand );
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+
+    return ulReturnValue;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic add with memory order
+ *
+ * @brief As Atomic_Add_u32(), but only orders other memory accesses as
+ *        requested by xMemoryOrder.
+ *
+ * @param[in,out] pulAddend  Pointer to memory location from where value is to be
+ *                         loaded and written back to.
+ * @param[in] ulCount      Value to be added to *pulAddend.
+ * @param[in] xMemoryOrder One of the ATOMIC_ORDER_ values.
+ *
+ * @return previous *pulAddend value.
+ */
+static portFORCE_INLINE uint32_t Atomic_AddExplicit_u32( uint32_t volatile * pulAddend,
+                                                         uint32_t ulCount,
+                                                         BaseType_t xMemoryOrder )
+{
+    uint32_t ulCurrent;
+
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        ulCurrent = __atomic_fetch_add( pulAddend, ulCount, xMemoryOrder );
+    }
+    #else
+    {
+        ( void ) xMemoryOrder;
+        ulCurrent = Atomic_Add_u32( pulAddend, ulCount );
+    }
+    #endif /* portHAS_NATIVE_ATOMICS */
+
+    return ulCurrent;
+}
+/*-----------------------------------------------------------*/
+
+/**
+ * Atomic subtract with memory order
+ *
+ * @brief As Atomic_Subtract_u32(), but only orders other memory accesses as
+ *        requested by xMemoryOrder.
+ *
+ * @param[in,out] pulAddend  Pointer to memory location from where value is to be
+ *                         loaded and written back to.
+ * @param[in] ulCount      Value to be subtracted from *pulAddend.
+ * @param[in] xMemoryOrder One of the ATOMIC_ORDER_ values.
+ *
+ * @return previous *pulAddend value.
+ */
+static portFORCE_INLINE uint32_t Atomic_SubtractExplicit_u32( uint32_t volatile * pulAddend,
+                                                              uint32_t ulCount,
+                                                              BaseType_t xMemoryOrder )
+{
+    uint32_t ulCurrent;
+
+    #if ( portHAS_NATIVE_ATOMICS == 1 )
+    {
+        ulCurrent = __atomic_fetch_sub( pulAddend, ulCount, xMemoryOrder );
+    }
+    #else
     {
-        ulCurrent = *pulDestination;
-        *pulDestination ^= ulValue;
+        ( void ) xMemoryOrder;
+        ulCurrent = Atomic_Subtract_u32( pulAddend, ulCount );
     }
-    ATOMIC_EXIT_CRITICAL();
+    #endif /* portHAS_NATIVE_ATOMICS */
 
     return ulCurrent;
 }
@@ -0,0 +1,203 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A port neutral benchmark layer.  When configUSE_BENCHMARK_HOOKS is set to 1
+ * in FreeRTOSConfig.h this header is included by FreeRTOS.h and defines the
+ * traceBENCHMARK_ macros, unless FreeRTOSConfig.h has already defined them,
+ * to time the following into latency histograms kept by benchmark_hooks.c:
+ *
+ *   benchmarkMETRIC_ISR             From traceBENCHMARK_ISR_ENTER() to
+ *                                   traceBENCHMARK_ISR_EXIT() - the time the
+ *                                   port's tick interrupt spends in the
+ *                                   kernel.  Only the outermost of nested
+ *                                   interrupts is timed.
+ *   benchmarkMETRIC_CONTEXT_SWITCH  From traceBENCHMARK_TASK_SWITCHED_OUT() to
+ *                                   traceBENCHMARK_TASK_SWITCHED_IN() - the
+ *                                   time vTaskSwitchContext() takes to select
+ *                                   the next task.
+ *   benchmarkMETRIC_API_FIRST + n   From traceBENCHMARK_API_ENTER( n ) to
+ *                                   traceBENCHMARK_API_EXIT( n ) - the time
+ *                                   taken by the API function with benchmarkAPI_
+ *                                   constant n.
+ *
+ * An API call that is interrupted, or that blocks, is not timed, as its time
+ * would include the interrupt or the tasks that ran while it was blocked -
+ * it is counted in ulDiscarded instead.  The API metrics are therefore the
+ * cost of the call itself.
+ *
+ * Every time is the difference between two readings of
+ * configBENCHMARK_TIMESTAMP(), which defaults to the port's cycle counter
+ * where it provides portGET_CYCLE_COUNT(), and otherwise to the run time
+ * stats counter, so every port that provides either reports the same metrics
+ * in the same way.  Ports call traceBENCHMARK_ISR_ENTER() and
+ * traceBENCHMARK_ISR_EXIT() from their tick interrupt handler; the other
+ * macros are called by the kernel.
+ *
+ * Each core keeps its own histograms, updated with interrupts masked on that
+ * core only, so recording never takes a lock.  vBenchmarkGetStats() adds the
+ * cores' histograms together.
+ */
+
+#ifndef BENCHMARK_HOOKS_H
+#define BENCHMARK_HOOKS_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include benchmark_hooks.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The number of buckets in each histogram. */
+#ifndef configBENCHMARK_BUCKETS
+    #define configBENCHMARK_BUCKETS    16
+#endif
+
+/* Reads the clock every time is measured with, which must count up and wrap
+ * at 2^32. */
+#ifndef configBENCHMARK_TIMESTAMP
+    #if defined( portGET_CYCLE_COUNT )
+        #define configBENCHMARK_TIMESTAMP()    ( ( uint32_t ) portGET_CYCLE_COUNT() )
+    #elif ( ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE ) )
+        #define configBENCHMARK_TIMESTAMP()    ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+    #else
+        #error configUSE_BENCHMARK_HOOKS is 1 but the port has no cycle counter or run time stats counter.  Define configBENCHMARK_TIMESTAMP() in FreeRTOSConfig.h to read a clock.
+    #endif
+#endif
+
+/* The metrics, passed to vBenchmarkGetStats() as uxMetric. */
+#define benchmarkMETRIC_ISR               ( 0U )
+#define benchmarkMETRIC_CONTEXT_SWITCH    ( 1U )
+#define benchmarkMETRIC_API_FIRST         ( 2U )
+#define benchmarkMETRIC_COUNT             ( benchmarkMETRIC_API_FIRST + benchmarkAPI_COUNT )
+
+/* Used with the vBenchmarkGetStats() function to return the distribution of
+ * one metric.  All times are in configBENCHMARK_TIMESTAMP() counts. */
+typedef struct xBENCHMARK_STATS
+{
+    uint32_t ulMinimum;                              /* The shortest time measured.  Only valid if ulCount is not 0. */
+    uint32_t ulMaximum;                              /* The longest time measured. */
+    uint64_t ullTotal;                               /* The sum of all the times measured, from which the mean can be calculated. */
+    uint32_t ulCount;                                /* The number of times measured. */
+    uint32_t ulDiscarded;                            /* The number of API calls not timed because they were interrupted or blocked.  Always 0 for the other metrics. */
+    uint32_t ulHistogram[ configBENCHMARK_BUCKETS ]; /* ulHistogram[ n ] counts the times of 2^n to 2^(n+1)-1.  Bucket 0 also counts times of 0, and the last bucket also counts all longer times. */
+} BenchmarkStats_t;
+
+#ifndef traceBENCHMARK_ISR_ENTER
+    #define traceBENCHMARK_ISR_ENTER()    vBenchmarkISREnter()
+#endif
+#ifndef traceBENCHMARK_ISR_EXIT
+    #define traceBENCHMARK_ISR_EXIT()    vBenchmarkISRExit()
+#endif
+#ifndef traceBENCHMARK_TASK_SWITCHED_OUT
+    #define traceBENCHMARK_TASK_SWITCHED_OUT()    vBenchmarkTaskSwitchedOut()
+#endif
+#ifndef traceBENCHMARK_TASK_SWITCHED_IN
+    #define traceBENCHMARK_TASK_SWITCHED_IN()    vBenchmarkTaskSwitchedIn()
+#endif
+#ifndef traceBENCHMARK_API_ENTER
+    #define traceBENCHMARK_API_ENTER( uxApi )    vBenchmarkAPIEnter( uxApi )
+#endif
+#ifndef traceBENCHMARK_API_EXIT
+    #define traceBENCHMARK_API_EXIT( uxApi )    vBenchmarkAPIExit( uxApi )
+#endif
+
+/* Called by the macros above.  Not for use by the application. */
+void vBenchmarkISREnter( void ) PRIVILEGED_FUNCTION;
+void vBenchmarkISRExit( void ) PRIVILEGED_FUNCTION;
+void vBenchmarkTaskSwitchedOut( void ) PRIVILEGED_FUNCTION;
+void vBenchmarkTaskSwitchedIn( void ) PRIVILEGED_FUNCTION;
+void vBenchmarkAPIEnter( UBaseType_t uxApi ) PRIVILEGED_FUNCTION;
+void vBenchmarkAPIExit( UBaseType_t uxApi ) PRIVILEGED_FUNCTION;
+
+/**
+ * benchmark_hooks.h
+ *
+ * @code{c}
+ * void vBenchmarkGetStats( UBaseType_t uxMetric, BenchmarkStats_t * pxStats );
+ * @endcode
+ *
+ * Returns the distribution of one metric, summed over all cores.  Can be
+ * called from a task while measurements continue.
+ *
+ * @param uxMetric benchmarkMETRIC_ISR, benchmarkMETRIC_CONTEXT_SWITCH, or
+ * benchmarkMETRIC_API_FIRST plus one of the benchmarkAPI_ constants.
+ *
+ * @param pxStats The structure the distribution is written to.
+ *
+ * Example use:
+ * @code{c}
+ * void vPrintSwitchTime( void )
+ * {
+ * BenchmarkStats_t xStats;
+ *
+ *  vBenchmarkGetStats( benchmarkMETRIC_CONTEXT_SWITCH, &xStats );
+ *
+ *  if( xStats.ulCount > 0 )
+ *  {
+ *      printf( "switch min %u mean %u max %u\r\n",
+ *              ( unsigned ) xStats.ulMinimum,
+ *              ( unsigned ) ( xStats.ullTotal / xStats.ulCount ),
+ *              ( unsigned ) xStats.ulMaximum );
+ *  }
+ * }
+ * @endcode
+ *
+ * \defgroup vBenchmarkGetStats vBenchmarkGetStats
+ * \ingroup Benchmark
+ */
+void vBenchmarkGetStats( UBaseType_t uxMetric,
+                         BenchmarkStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * benchmark_hooks.h
+ *
+ * @code{c}
+ * void vBenchmarkReset( void );
+ * @endcode
+ *
+ * Clears the distributions of all metrics on all cores.  Also starts the
+ * cycle counter on ports where it does not run from reset, so should be
+ * called once before the scheduler is started.
+ *
+ * \defgroup vBenchmarkReset vBenchmarkReset
+ * \ingroup Benchmark
+ */
+void vBenchmarkReset( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* BENCHMARK_HOOKS_H */
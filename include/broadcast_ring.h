@@ -0,0 +1,400 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A broadcast ring passes a stream of fixed size items from one writer to any
+ * number of subscribers.  Each item is copied into the ring once, however many
+ * subscribers there are, and each subscriber has its own read cursor so
+ * receives every item in the order it was published.  The writer never waits
+ * for the subscribers: when the ring is full the oldest item is overwritten,
+ * and a subscriber that has fallen so far behind that the items it had yet to
+ * read were overwritten - that has been lapped - skips to the oldest item
+ * still in the ring.  The number of items each subscriber missed that way is
+ * returned by uxBroadcastRingGetMissedCount().
+ *
+ * A ring of uxLength items lets each subscriber fall up to uxLength - 1 items
+ * behind the writer without missing any, as the remaining slot is the one the
+ * writer overwrites next.
+ *
+ * The writer only enters the kernel when a subscriber is blocked waiting for
+ * an item, in which case publishing an item unblocks every waiting subscriber.
+ * Subscribers copy items out of the ring without entering a critical section,
+ * and detect an item that was overwritten while it was being copied.
+ *
+ * ***NOTE***:  A broadcast ring assumes there is only one writer, which may be
+ * a task or an interrupt, and that each subscriber is only read by one task
+ * at a time.  Any number of subscribers can read the same ring at once.
+ *
+ * configUSE_BROADCAST_RINGS must be set to 1 in FreeRTOSConfig.h for this API
+ * to be available.
+ */
+
+#ifndef BROADCAST_RING_H
+#define BROADCAST_RING_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include broadcast_ring.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which broadcast rings are referenced.  For example, a call to
+ * xBroadcastRingCreate() returns a BroadcastRingHandle_t variable that can
+ * then be used as a parameter to vBroadcastRingPublish().
+ */
+struct BroadcastRingDefinition;
+typedef struct BroadcastRingDefinition * BroadcastRingHandle_t;
+
+/**
+ * Type by which the subscribers of a broadcast ring are referenced.  For
+ * example, a call to xBroadcastRingSubscribe() returns a
+ * BroadcastSubscriberHandle_t variable that can then be used as a parameter to
+ * xBroadcastRingReceive().
+ */
+struct BroadcastSubscriberDefinition;
+typedef struct BroadcastSubscriberDefinition * BroadcastSubscriberHandle_t;
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * BroadcastRingHandle_t xBroadcastRingCreate( UBaseType_t uxLength,
+ *                                             UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a broadcast ring using dynamically allocated memory.  The ring's
+ * structure and storage area are allocated with a single call to
+ * pvPortMalloc().
+ *
+ * @param uxLength The number of items the ring holds, which must be at least
+ * 2.  A subscriber can fall up to uxLength - 1 items behind the writer without
+ * missing any.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @return A handle to the created ring, or NULL if there was insufficient heap
+ * memory to create it.
+ *
+ * Example use:
+ * @code{c}
+ * static BroadcastRingHandle_t xImuRing;
+ *
+ * void vImuTask( void * pvParameters )
+ * {
+ * ImuSample_t xSample;
+ *
+ *  for( ;; )
+ *  {
+ *      vReadImu( &xSample );
+ *
+ *      // Copied into the ring once, however many tasks subscribe to it.
+ *      vBroadcastRingPublish( xImuRing, &xSample );
+ *  }
+ * }
+ *
+ * void vFusionTask( void * pvParameters )
+ * {
+ * BroadcastSubscriberHandle_t xSubscriber = xBroadcastRingSubscribe( xImuRing );
+ * ImuSample_t xSample;
+ *
+ *  for( ;; )
+ *  {
+ *      if( xBroadcastRingReceive( xSubscriber, &xSample, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          vFuse( &xSample, uxBroadcastRingGetMissedCount( xSubscriber ) );
+ *      }
+ *  }
+ * }
+ *
+ * void vInit( void )
+ * {
+ *  xImuRing = xBroadcastRingCreate( 16, sizeof( ImuSample_t ) );
+ * }
+ * @endcode
+ * \defgroup xBroadcastRingCreate xBroadcastRingCreate
+ * \ingroup BroadcastRings
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    BroadcastRingHandle_t xBroadcastRingCreate( const UBaseType_t uxLength,
+                                                const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * BroadcastRingHandle_t xBroadcastRingCreateStatic( UBaseType_t uxLength,
+ *                                                   UBaseType_t uxItemSize,
+ *                                                   uint8_t * pucRingStorage,
+ *                                                   StaticBroadcastRing_t * pxStaticRing );
+ * @endcode
+ *
+ * Creates a broadcast ring using memory provided by the application.
+ *
+ * @param uxLength The number of items the ring holds, which must be at least
+ * 2.
+ *
+ * @param uxItemSize The size, in bytes, of each item.
+ *
+ * @param pucRingStorage An array of at least uxLength * uxItemSize bytes in
+ * which the items are held.
+ *
+ * @param pxStaticRing A variable of type StaticBroadcastRing_t, which is used
+ * to hold the ring's data structure.
+ *
+ * @return A handle to the created ring, or NULL if either pucRingStorage or
+ * pxStaticRing is NULL.
+ *
+ * \defgroup xBroadcastRingCreateStatic xBroadcastRingCreateStatic
+ * \ingroup BroadcastRings
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    BroadcastRingHandle_t xBroadcastRingCreateStatic( const UBaseType_t uxLength,
+                                                      const UBaseType_t uxItemSize,
+                                                      uint8_t * const pucRingStorage,
+                                                      StaticBroadcastRing_t * const pxStaticRing ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * void vBroadcastRingDelete( BroadcastRingHandle_t xRing );
+ * @endcode
+ *
+ * Deletes a broadcast ring.  No task may be blocked on the ring, and its
+ * subscribers must be deleted with vBroadcastRingUnsubscribe() before it is
+ * deleted.
+ *
+ * @param xRing The ring to delete.
+ *
+ * \defgroup vBroadcastRingDelete vBroadcastRingDelete
+ * \ingroup BroadcastRings
+ */
+void vBroadcastRingDelete( BroadcastRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * BroadcastSubscriberHandle_t xBroadcastRingSubscribe( BroadcastRingHandle_t xRing );
+ * @endcode
+ *
+ * Creates a subscriber of a broadcast ring using dynamically allocated
+ * memory.  The subscriber receives the items published after it was created.
+ * The writer does not need to know about its subscribers, so subscribers can
+ * be created and deleted at any time.
+ *
+ * @param xRing The ring to subscribe to.
+ *
+ * @return A handle to the created subscriber, or NULL if there was
+ * insufficient heap memory to create it.
+ *
+ * \defgroup xBroadcastRingSubscribe xBroadcastRingSubscribe
+ * \ingroup BroadcastRings
+ */
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    BroadcastSubscriberHandle_t xBroadcastRingSubscribe( BroadcastRingHandle_t xRing ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * BroadcastSubscriberHandle_t xBroadcastRingSubscribeStatic( BroadcastRingHandle_t xRing,
+ *                                                           StaticBroadcastSubscriber_t * pxStaticSubscriber );
+ * @endcode
+ *
+ * Creates a subscriber of a broadcast ring using memory provided by the
+ * application.
+ *
+ * @param xRing The ring to subscribe to.
+ *
+ * @param pxStaticSubscriber A variable of type StaticBroadcastSubscriber_t,
+ * which is used to hold the subscriber's data structure.
+ *
+ * @return A handle to the created subscriber, or NULL if pxStaticSubscriber is
+ * NULL.
+ *
+ * \defgroup xBroadcastRingSubscribeStatic xBroadcastRingSubscribeStatic
+ * \ingroup BroadcastRings
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    BroadcastSubscriberHandle_t xBroadcastRingSubscribeStatic( BroadcastRingHandle_t xRing,
+                                                               StaticBroadcastSubscriber_t * const pxStaticSubscriber ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * void vBroadcastRingUnsubscribe( BroadcastSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * Deletes a subscriber.  The task that reads the subscriber must not be
+ * blocked in xBroadcastRingReceive() when it is deleted.
+ *
+ * @param xSubscriber The subscriber to delete.
+ *
+ * \defgroup vBroadcastRingUnsubscribe vBroadcastRingUnsubscribe
+ * \ingroup BroadcastRings
+ */
+void vBroadcastRingUnsubscribe( BroadcastSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * void vBroadcastRingPublish( BroadcastRingHandle_t xRing,
+ *                             const void * pvItem );
+ * @endcode
+ *
+ * Copies an item into a broadcast ring, overwriting the oldest item if the
+ * ring is full, and unblocks every subscriber that is waiting for an item.
+ * Never blocks.  Must only be called by the ring's one writer.
+ *
+ * @param xRing The ring to publish to.
+ *
+ * @param pvItem A pointer to the item to publish.  The ring's item size bytes
+ * are copied from pvItem.
+ *
+ * \defgroup vBroadcastRingPublish vBroadcastRingPublish
+ * \ingroup BroadcastRings
+ */
+void vBroadcastRingPublish( BroadcastRingHandle_t xRing,
+                            const void * const pvItem ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * void vBroadcastRingPublishFromISR( BroadcastRingHandle_t xRing,
+ *                                    const void * pvItem,
+ *                                    BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vBroadcastRingPublish() that can be called from an interrupt
+ * service routine (ISR), for when the ring's writer is an interrupt.
+ *
+ * @param xRing The ring to publish to.
+ *
+ * @param pvItem A pointer to the item to publish.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if publishing the item
+ * unblocked a subscriber's task that has a priority above that of the
+ * currently running task, in which case a context switch should be requested
+ * before the interrupt is exited.
+ *
+ * \defgroup vBroadcastRingPublishFromISR vBroadcastRingPublishFromISR
+ * \ingroup BroadcastRings
+ */
+void vBroadcastRingPublishFromISR( BroadcastRingHandle_t xRing,
+                                   const void * const pvItem,
+                                   BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * BaseType_t xBroadcastRingReceive( BroadcastSubscriberHandle_t xSubscriber,
+ *                                   void * pvBuffer,
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the next item a subscriber has not yet read out of its broadcast
+ * ring, blocking until one is published if the subscriber has read them all.
+ * If the subscriber was lapped, it first skips to the oldest item still in the
+ * ring and adds the number of items it skipped to its missed count.
+ *
+ * @param xSubscriber The subscriber to receive from.
+ *
+ * @param pvBuffer The buffer into which the item is copied, which must be at
+ * least the ring's item size bytes.
+ *
+ * @param xTicksToWait The maximum number of ticks to wait for an item if the
+ * subscriber has read every item already published.
+ *
+ * @return pdPASS if an item was received, otherwise pdFAIL.
+ *
+ * \defgroup xBroadcastRingReceive xBroadcastRingReceive
+ * \ingroup BroadcastRings
+ */
+BaseType_t xBroadcastRingReceive( BroadcastSubscriberHandle_t xSubscriber,
+                                  void * const pvBuffer,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * UBaseType_t uxBroadcastRingItemsAvailable( BroadcastSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * Returns the number of items a subscriber can receive without blocking,
+ * which is never more than the ring's length minus one.
+ *
+ * @param xSubscriber The subscriber being queried.
+ *
+ * @return The number of items available to the subscriber.
+ *
+ * \defgroup uxBroadcastRingItemsAvailable uxBroadcastRingItemsAvailable
+ * \ingroup BroadcastRings
+ */
+UBaseType_t uxBroadcastRingItemsAvailable( BroadcastSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/**
+ * broadcast_ring.h
+ *
+ * @code{c}
+ * UBaseType_t uxBroadcastRingGetMissedCount( BroadcastSubscriberHandle_t xSubscriber );
+ * @endcode
+ *
+ * Returns the number of items a subscriber missed because it was lapped by
+ * the writer, since the subscriber was created.
+ *
+ * @param xSubscriber The subscriber being queried.
+ *
+ * @return The number of items the subscriber missed.
+ *
+ * \defgroup uxBroadcastRingGetMissedCount uxBroadcastRingGetMissedCount
+ * \ingroup BroadcastRings
+ */
+UBaseType_t uxBroadcastRingGetMissedCount( BroadcastSubscriberHandle_t xSubscriber ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( BROADCAST_RING_H ) */
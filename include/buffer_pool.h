@@ -0,0 +1,364 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * A buffer pool is a fixed number of equally sized data buffers that are
+ * passed between tasks and interrupts by pointer, so the data in them is
+ * never copied.  Each buffer has a reference count and is returned to its
+ * pool when the last reference is released.  Buffers can be chained, for
+ * example to hold a packet that is larger than one buffer, or to prepend a
+ * header held in one buffer to a payload held in another.
+ *
+ * A task that allocates from an empty pool can block until another task or
+ * interrupt frees a buffer.
+ *
+ * The xPoolBufferQueue...() and xPoolBufferMessage...() helpers pass a buffer
+ * through a queue or message buffer, which holds only the pointer.  Sending a
+ * buffer transfers the caller's reference to the receiver, so neither side
+ * needs to retain or release the buffer around the transfer.
+ *
+ * configUSE_BUFFER_POOLS must be set to 1 in FreeRTOSConfig.h for this API to
+ * be available.
+ */
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include buffer_pool.h"
+#endif
+
+#include "queue.h"
+#include "message_buffer.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which buffer pools are referenced.  For example, a call to
+ * xBufferPoolCreate() returns a BufferPoolHandle_t variable that can then be
+ * used as a parameter to pxBufferPoolAllocate().
+ */
+struct BufferPoolDefinition;
+typedef struct BufferPoolDefinition * BufferPoolHandle_t;
+
+/*
+ * The header of a buffer.  Applications read and write the data at pucData,
+ * of which there is the buffer size passed to xBufferPoolCreate(), and set
+ * xLength to the number of bytes used.  The other members are managed by the
+ * kernel.
+ */
+typedef struct PoolBuffer
+{
+    struct PoolBuffer * pxNext;              /*< The next buffer in the chain, or NULL.  The chain holds one reference to it. */
+    struct BufferPoolDefinition * pxPool;    /*< The pool the buffer belongs to. */
+    volatile uint32_t ulReferenceCount;      /*< The number of references held to the buffer. */
+    size_t xLength;                          /*< The number of bytes of data in the buffer. */
+    uint8_t * pucData;                       /*< The start of the buffer's data. */
+} PoolBuffer_t;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * BufferPoolHandle_t xBufferPoolCreate( size_t xBufferSize,
+ *                                       UBaseType_t uxNumberOfBuffers );
+ * @endcode
+ *
+ * Creates a buffer pool using dynamically allocated memory.  Buffer pools
+ * cannot be deleted.
+ *
+ * @param xBufferSize The number of data bytes in each buffer.
+ *
+ * @param uxNumberOfBuffers The number of buffers in the pool.
+ *
+ * @return A handle to the created pool, or NULL if there was insufficient heap
+ * memory to create it.
+ *
+ * \defgroup xBufferPoolCreate xBufferPoolCreate
+ * \ingroup BufferPools
+ */
+BufferPoolHandle_t xBufferPoolCreate( size_t xBufferSize,
+                                      UBaseType_t uxNumberOfBuffers ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * PoolBuffer_t * pxBufferPoolAllocate( BufferPoolHandle_t xPool,
+ *                                      TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a buffer from a pool.  The buffer has a reference count of 1, held by
+ * the caller, an xLength of 0, and is not chained.
+ *
+ * @param xPool The pool the buffer is taken from.
+ *
+ * @param xTicksToWait The maximum time to wait for a buffer to be freed if
+ * every buffer in the pool is in use.  Tasks waiting for a buffer are given
+ * one in priority order.
+ *
+ * @return The buffer, or NULL if no buffer became free in time.
+ *
+ * Example use:
+ * @code{c}
+ * void vReceivePacket( void )
+ * {
+ * PoolBuffer_t * pxBuffer;
+ *
+ *  pxBuffer = pxBufferPoolAllocate( xPacketPool, portMAX_DELAY );
+ *  pxBuffer->xLength = xReadPacket( pxBuffer->pucData );
+ *
+ *  // The protocol task now owns the buffer, and releases it when it has
+ *  // finished with it.
+ *  if( xPoolBufferQueueSend( xProtocolQueue, pxBuffer, 0 ) != pdPASS )
+ *  {
+ *      vPoolBufferRelease( pxBuffer );
+ *  }
+ * }
+ * @endcode
+ * \defgroup pxBufferPoolAllocate pxBufferPoolAllocate
+ * \ingroup BufferPools
+ */
+PoolBuffer_t * pxBufferPoolAllocate( BufferPoolHandle_t xPool,
+                                     TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * PoolBuffer_t * pxBufferPoolAllocateFromISR( BufferPoolHandle_t xPool );
+ * @endcode
+ *
+ * A version of pxBufferPoolAllocate() that can be called from an interrupt
+ * service routine.  It never waits.
+ *
+ * \defgroup pxBufferPoolAllocateFromISR pxBufferPoolAllocateFromISR
+ * \ingroup BufferPools
+ */
+PoolBuffer_t * pxBufferPoolAllocateFromISR( BufferPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * UBaseType_t uxBufferPoolGetFreeBuffers( BufferPoolHandle_t xPool );
+ * @endcode
+ *
+ * @return The number of buffers in the pool that are not in use.
+ *
+ * \defgroup uxBufferPoolGetFreeBuffers uxBufferPoolGetFreeBuffers
+ * \ingroup BufferPools
+ */
+UBaseType_t uxBufferPoolGetFreeBuffers( BufferPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * size_t xBufferPoolGetBufferSize( BufferPoolHandle_t xPool );
+ * @endcode
+ *
+ * @return The number of data bytes in each buffer in the pool, as passed to
+ * xBufferPoolCreate().
+ *
+ * \defgroup xBufferPoolGetBufferSize xBufferPoolGetBufferSize
+ * \ingroup BufferPools
+ */
+size_t xBufferPoolGetBufferSize( BufferPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * void vPoolBufferRetain( PoolBuffer_t * pxBuffer );
+ * @endcode
+ *
+ * Adds a reference to a buffer, and so to the buffers chained to it.  Can be
+ * called from an interrupt service routine.
+ *
+ * \defgroup vPoolBufferRetain vPoolBufferRetain
+ * \ingroup BufferPools
+ */
+void vPoolBufferRetain( PoolBuffer_t * pxBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * void vPoolBufferRelease( PoolBuffer_t * pxBuffer );
+ * @endcode
+ *
+ * Releases a reference to a buffer.  If it was the last reference the buffer
+ * is returned to its pool, unblocking a task waiting to allocate from the
+ * pool, and the reference the buffer held to the next buffer in its chain is
+ * released in turn.
+ *
+ * \defgroup vPoolBufferRelease vPoolBufferRelease
+ * \ingroup BufferPools
+ */
+void vPoolBufferRelease( PoolBuffer_t * pxBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * void vPoolBufferReleaseFromISR( PoolBuffer_t * pxBuffer,
+ *                                 BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of vPoolBufferRelease() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if freeing a buffer
+ * unblocked a task that has a priority above that of the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * \defgroup vPoolBufferReleaseFromISR vPoolBufferReleaseFromISR
+ * \ingroup BufferPools
+ */
+void vPoolBufferReleaseFromISR( PoolBuffer_t * pxBuffer,
+                                BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * void vPoolBufferChain( PoolBuffer_t * pxHead,
+ *                        PoolBuffer_t * pxTail );
+ * @endcode
+ *
+ * Appends pxTail, and the buffers chained to it, to the end of the chain that
+ * starts at pxHead.  The caller's reference to pxTail becomes the chain's
+ * reference, so the caller must not release pxTail afterwards.  Buffers from
+ * different pools can be chained.
+ *
+ * \defgroup vPoolBufferChain vPoolBufferChain
+ * \ingroup BufferPools
+ */
+void vPoolBufferChain( PoolBuffer_t * pxHead,
+                       PoolBuffer_t * pxTail ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * size_t xPoolBufferGetChainLength( const PoolBuffer_t * pxHead );
+ * @endcode
+ *
+ * @return The total xLength of the buffers in the chain that starts at
+ * pxHead.
+ *
+ * \defgroup xPoolBufferGetChainLength xPoolBufferGetChainLength
+ * \ingroup BufferPools
+ */
+size_t xPoolBufferGetChainLength( const PoolBuffer_t * pxHead ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * BaseType_t xPoolBufferQueueSend( QueueHandle_t xQueue,
+ *                                  PoolBuffer_t * pxBuffer,
+ *                                  TickType_t xTicksToWait );
+ * BaseType_t xPoolBufferQueueSendFromISR( QueueHandle_t xQueue,
+ *                                         PoolBuffer_t * pxBuffer,
+ *                                         BaseType_t * pxHigherPriorityTaskWoken );
+ * BaseType_t xPoolBufferQueueReceive( QueueHandle_t xQueue,
+ *                                     PoolBuffer_t ** ppxBuffer,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Pass a buffer through a queue created with an item size of
+ * sizeof( PoolBuffer_t * ).  If sending succeeds the caller's reference to the
+ * buffer is transferred to the task that receives it.  If sending fails the
+ * caller still holds its reference.
+ *
+ * @return As xQueueSendToBack(), xQueueSendToBackFromISR() and
+ * xQueueReceive().
+ *
+ * \defgroup xPoolBufferQueueSend xPoolBufferQueueSend
+ * \ingroup BufferPools
+ */
+BaseType_t xPoolBufferQueueSend( QueueHandle_t xQueue,
+                                 PoolBuffer_t * pxBuffer,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xPoolBufferQueueSendFromISR( QueueHandle_t xQueue,
+                                        PoolBuffer_t * pxBuffer,
+                                        BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xPoolBufferQueueReceive( QueueHandle_t xQueue,
+                                    PoolBuffer_t ** ppxBuffer,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * buffer_pool.h
+ *
+ * @code{c}
+ * BaseType_t xPoolBufferMessageSend( MessageBufferHandle_t xMessageBuffer,
+ *                                    PoolBuffer_t * pxBuffer,
+ *                                    TickType_t xTicksToWait );
+ * BaseType_t xPoolBufferMessageSendFromISR( MessageBufferHandle_t xMessageBuffer,
+ *                                           PoolBuffer_t * pxBuffer,
+ *                                           BaseType_t * pxHigherPriorityTaskWoken );
+ * BaseType_t xPoolBufferMessageReceive( MessageBufferHandle_t xMessageBuffer,
+ *                                       PoolBuffer_t ** ppxBuffer,
+ *                                       TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Pass a buffer through a message buffer as a message holding only the
+ * buffer's address, with the same transfer of ownership as
+ * xPoolBufferQueueSend().  Every message in the message buffer must be a
+ * buffer sent this way.
+ *
+ * @return pdPASS if the buffer was sent or received, otherwise pdFAIL.
+ *
+ * \defgroup xPoolBufferMessageSend xPoolBufferMessageSend
+ * \ingroup BufferPools
+ */
+BaseType_t xPoolBufferMessageSend( MessageBufferHandle_t xMessageBuffer,
+                                   PoolBuffer_t * pxBuffer,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xPoolBufferMessageSendFromISR( MessageBufferHandle_t xMessageBuffer,
+                                          PoolBuffer_t * pxBuffer,
+                                          BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xPoolBufferMessageReceive( MessageBufferHandle_t xMessageBuffer,
+                                      PoolBuffer_t ** ppxBuffer,
+                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( BUFFER_POOL_H ) */
@@ -0,0 +1,203 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef CYCLE_BENCHMARK_H
+#define CYCLE_BENCHMARK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include cycle_benchmark.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*
+ * The cycle benchmark measures the cost of common kernel operations in
+ * processor cycles on the target, so that ports, parts and configurations can
+ * be compared with each other.  It is built when configUSE_CYCLE_BENCHMARK is
+ * set to 1 in FreeRTOSConfig.h, and reads the cycle counter with
+ * portGET_CYCLE_COUNT().  The GCC ARMv7-M ports read the DWT cycle counter and
+ * the GCC RISC-V port reads mcycle.  Other ports can define
+ * portGET_CYCLE_COUNT() and, if needed, portENABLE_CYCLE_COUNTER() in
+ * FreeRTOSConfig.h.
+ */
+
+/* Indexes into the results array written by vCycleBenchmarkRun(). */
+#define cyclebenchQUEUE_SEND              ( 0 )
+#define cyclebenchTASK_NOTIFY             ( 1 )
+#define cyclebenchSEMAPHORE_TAKE          ( 2 )
+#define cyclebenchCONTEXT_SWITCH          ( 3 )
+#define cyclebenchTICK_INTERRUPT          ( 4 )
+#define cyclebenchMALLOC                  ( 5 )
+#define cyclebenchNUMBER_OF_BENCHMARKS    ( 6 )
+
+/* The largest number of background load tasks vCycleBenchmarkRun() creates. */
+#define cyclebenchMAX_BACKGROUND_TASKS    ( 8 )
+
+/* Indexes into each row of the results written by vCycleBenchmarkScaling(). */
+#define cyclebenchSCALE_QUEUE_RECEIVE_TIMEOUT     ( 0 )
+#define cyclebenchSCALE_TIMER_RESET               ( 1 )
+#define cyclebenchSCALE_EVENT_GROUP_SET_BITS      ( 2 )
+#define cyclebenchSCALE_TASK_CREATE               ( 3 )
+#define cyclebenchNUMBER_OF_SCALING_BENCHMARKS    ( 4 )
+
+/* The result of one benchmark.  Cycle counts have the cost of reading the
+ * cycle counter removed. */
+typedef struct xCYCLE_BENCHMARK_RESULT
+{
+    const char * pcName;      /*< Name of the benchmark, for example "queue_send". */
+    uint32_t ulSamples;       /*< The number of measurements taken.  0 if the benchmark was not built. */
+    uint32_t ulMinCycles;     /*< The cheapest measurement. */
+    uint32_t ulMaxCycles;     /*< The most expensive measurement. */
+    uint32_t ulAverageCycles; /*< The mean of all the measurements. */
+} CycleBenchmarkResult_t;
+
+/**
+ * cycle_benchmark.h
+ * @code{c}
+ * void vCycleBenchmarkRun( uint32_t ulIterations,
+ *                          UBaseType_t uxBackgroundTasks,
+ *                          size_t xMallocSize,
+ *                          CycleBenchmarkResult_t pxResults[ cyclebenchNUMBER_OF_BENCHMARKS ] );
+ * @endcode
+ *
+ * Measures, ulIterations times each:
+ *
+ *  queue_send      - xQueueSend() to a queue that has space and no waiting
+ *                    receiver.
+ *  task_notify     - xTaskNotify() to a task that is not waiting for the
+ *                    notification.  Only built if configUSE_TASK_NOTIFICATIONS
+ *                    is 1.
+ *  semaphore_take  - xSemaphoreTake() of an available binary semaphore.
+ *  context_switch  - half a taskYIELD() round trip between two tasks of equal
+ *                    priority, which includes the port's context switch
+ *                    handler, for example PendSV.
+ *  tick_interrupt  - the time the tick interrupt takes from a task that is
+ *                    polling the cycle counter at the highest priority.
+ *  malloc          - pvPortMalloc( xMallocSize ) with the heap implementation
+ *                    the application is built with.
+ *
+ * uxBackgroundTasks tasks, up to cyclebenchMAX_BACKGROUND_TASKS, run at the
+ * idle priority during the benchmarks.  Each keeps a few blocks of varying size
+ * allocated, replacing one each time it runs, and blocks for a tick in between.
+ * This fragments the heap and gives the tick interrupt delayed tasks to
+ * process.  The benchmarking task delays for a tick every few samples so the
+ * background tasks run throughout.
+ *
+ * Interrupts are left enabled, so the maximums include any interrupts the
+ * application has running, as they would in the field.  Compare results taken
+ * with the same background load and the same interrupts running.
+ *
+ * Must be called from a task, which on MPU ports must be privileged, after the
+ * scheduler has started.  The calling task's priority must be above the idle
+ * priority and below configMAX_PRIORITIES - 1.  The call blocks for at least
+ * ulIterations ticks while it measures the tick interrupt.
+ *
+ * @param ulIterations The number of measurements to take for each benchmark.
+ *
+ * @param uxBackgroundTasks The number of background load tasks to create.
+ *
+ * @param xMallocSize The size of the block the malloc benchmark allocates.
+ *
+ * @param pxResults An array that receives one result for each benchmark,
+ * indexed by cyclebenchQUEUE_SEND to cyclebenchMALLOC.
+ */
+#if ( configUSE_CYCLE_BENCHMARK == 1 )
+    void vCycleBenchmarkRun( uint32_t ulIterations,
+                             UBaseType_t uxBackgroundTasks,
+                             size_t xMallocSize,
+                             CycleBenchmarkResult_t pxResults[ cyclebenchNUMBER_OF_BENCHMARKS ] ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * cycle_benchmark.h
+ * @code{c}
+ * void vCycleBenchmarkScaling( const UBaseType_t * puxObjectCounts,
+ *                              UBaseType_t uxNumberOfCounts,
+ *                              uint32_t ulIterations,
+ *                              CycleBenchmarkResult_t pxResults[][ cyclebenchNUMBER_OF_SCALING_BENCHMARKS ] );
+ * @endcode
+ *
+ * Measures how the cost of kernel operations grows with the number of kernel
+ * objects, to show where the kernel walks a list whose length depends on the
+ * application.  For each count N in puxObjectCounts, ulIterations times each:
+ *
+ *  queue_receive_timeout - xQueueReceive() with a timeout from an empty queue,
+ *                          up to the point the next task runs, with N tasks
+ *                          blocked with an earlier timeout, so the delayed
+ *                          list holds N tasks ahead of the caller.
+ *  timer_reset           - xTimerReset() of a timer that expires after N
+ *                          active timers, including the timer task
+ *                          processing the command.  Only built if
+ *                          configUSE_TIMERS is 1.
+ *  event_group_set_bits  - xEventGroupSetBits() of a bit that none of the N
+ *                          tasks waiting on the event group are waiting for.
+ *  task_create           - xTaskCreate() of a task that does not preempt the
+ *                          caller, with N other tasks blocked.
+ *
+ * The blocked tasks and the timers are created at the start of each step and
+ * kept for the next, so puxObjectCounts must be in ascending order.  Each
+ * blocked task and timer is allocated from the heap, which must be large
+ * enough for the largest count.  Each row of pxResults, one per count, is one
+ * point on the cost curve of each operation.  On the Posix port the counts
+ * are nanoseconds rather than cycles.
+ *
+ * Must be called from a task, which on MPU ports must be privileged, after the
+ * scheduler has started.  The calling task's priority must be above
+ * tskIDLE_PRIORITY + 1, and below configTIMER_TASK_PRIORITY if configUSE_TIMERS
+ * is 1, so the timer task processes each reset before xTimerReset() returns.
+ *
+ * @param puxObjectCounts The numbers of objects to measure with, in ascending
+ * order.
+ *
+ * @param uxNumberOfCounts The number of entries in puxObjectCounts.
+ *
+ * @param ulIterations The number of measurements to take for each benchmark
+ * at each count.
+ *
+ * @param pxResults An array of uxNumberOfCounts rows that receives one result
+ * for each benchmark, indexed by cyclebenchSCALE_QUEUE_RECEIVE_TIMEOUT to
+ * cyclebenchSCALE_TASK_CREATE.
+ */
+#if ( configUSE_CYCLE_BENCHMARK == 1 )
+    void vCycleBenchmarkScaling( const UBaseType_t * puxObjectCounts,
+                                 UBaseType_t uxNumberOfCounts,
+                                 uint32_t ulIterations,
+                                 CycleBenchmarkResult_t pxResults[][ cyclebenchNUMBER_OF_SCALING_BENCHMARKS ] ) PRIVILEGED_FUNCTION;
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* CYCLE_BENCHMARK_H */
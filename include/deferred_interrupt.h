@@ -0,0 +1,264 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Deferred interrupts move the work of an interrupt out of the interrupt
+ * service routine (ISR) and into a task.  An ISR raises its deferred interrupt,
+ * and the handler registered for it is then called from a service task of the
+ * priority given when the handler was registered.  The kernel creates one
+ * service task for each priority used, so all the handlers of one priority
+ * share a single task and stack, rather than each driver creating a task that
+ * blocks on ulTaskNotifyTake().  Handlers of the same priority run one after
+ * the other, in the order their interrupts were first raised, and are preempted
+ * by higher priority tasks as normal.
+ *
+ * Raising a deferred interrupt that is already waiting for its handler to run
+ * only increments a count, so a burst of interrupts is handled by a single call
+ * to the handler, which is passed the number of times the interrupt was raised.
+ * The number of times each interrupt was raised and handled, and the time from
+ * an interrupt first being raised to its handler being called, are recorded
+ * for each handler and returned by vDeferredInterruptGetStats().  The latency
+ * is measured with the run time counter if configGENERATE_RUN_TIME_STATS is 1,
+ * and in ticks otherwise.
+ *
+ * Handlers must not block, as that would delay every other handler of the same
+ * priority.  The stack of each service task is configDEFERRED_INTERRUPT_STACK_DEPTH
+ * words, so must be large enough for the deepest handler.
+ *
+ * configUSE_DEFERRED_INTERRUPTS must be set to 1 in FreeRTOSConfig.h for this
+ * API to be available.
+ */
+
+#ifndef DEFERRED_INTERRUPT_H
+#define DEFERRED_INTERRUPT_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include deferred_interrupt.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which deferred interrupts are referenced.  For example, a call to
+ * xDeferredInterruptRegister() returns a DeferredInterruptHandle_t variable
+ * that can then be used as a parameter to vDeferredInterruptRaiseFromISR().
+ */
+struct DeferredInterruptDefinition;
+typedef struct DeferredInterruptDefinition * DeferredInterruptHandle_t;
+
+/*
+ * Defines the prototype to which deferred interrupt handlers must conform.
+ * ulRaisedCount is the number of times the interrupt was raised since the
+ * handler was last called, so is at least 1.
+ */
+typedef void (* DeferredInterruptFunction_t)( void * pvParameters,
+                                              uint32_t ulRaisedCount );
+
+/* Used with vDeferredInterruptGetStats() to return the statistics of a
+ * deferred interrupt.  The latency is the time from the interrupt first being
+ * raised to its handler being called, in run time counter ticks if
+ * configGENERATE_RUN_TIME_STATS is 1, and in ticks otherwise. */
+typedef struct xDEFERRED_INTERRUPT_STATS
+{
+    uint32_t ulRaisedCount;                       /* The number of times the interrupt was raised. */
+    uint32_t ulHandledCount;                      /* The number of times the handler was called.  The difference from ulRaisedCount is the number of raises that were coalesced, or are still pending. */
+    configRUN_TIME_COUNTER_TYPE ulLatencyMinimum; /* The shortest latency measured.  Only valid if ulHandledCount is not 0. */
+    configRUN_TIME_COUNTER_TYPE ulLatencyMaximum; /* The longest latency measured. */
+    configRUN_TIME_COUNTER_TYPE ulLatencyTotal;   /* The sum of the latencies measured, from which the mean can be calculated. */
+} DeferredInterruptStats_t;
+
+/**
+ * deferred_interrupt.h
+ *
+ * @code{c}
+ * DeferredInterruptHandle_t xDeferredInterruptRegister( DeferredInterruptFunction_t pxFunction,
+ *                                                       void * pvParameters,
+ *                                                       UBaseType_t uxPriority );
+ * @endcode
+ *
+ * Registers a deferred interrupt handler using dynamically allocated memory,
+ * creating the service task for uxPriority if it does not already exist.
+ * Deferred interrupts cannot be unregistered, so are intended to be registered
+ * once when each driver is initialised, before its interrupt is enabled.
+ *
+ * @param pxFunction The handler called each time the interrupt is raised, or
+ * once for a burst of raises.
+ *
+ * @param pvParameters The value passed to pxFunction.
+ *
+ * @param uxPriority The priority of the task from which pxFunction is called.
+ *
+ * @return A handle to the registered deferred interrupt, or NULL if there was
+ * insufficient heap memory to register it.
+ *
+ * Example use:
+ * @code{c}
+ * static DeferredInterruptHandle_t xUartDeferred;
+ *
+ * static void prvUartHandler( void * pvParameters, uint32_t ulRaisedCount )
+ * {
+ *  // Runs in the service task, so can call any non-blocking API function.
+ *  vDrainRxFifo( ( Uart_t * ) pvParameters );
+ * }
+ *
+ * void UART_IRQHandler( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  vClearUartInterrupt();
+ *  vDeferredInterruptRaiseFromISR( xUartDeferred, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vUartInit( Uart_t * pxUart )
+ * {
+ *  xUartDeferred = xDeferredInterruptRegister( prvUartHandler, pxUart, configMAX_PRIORITIES - 2 );
+ *  vEnableUartInterrupt();
+ * }
+ * @endcode
+ * \defgroup xDeferredInterruptRegister xDeferredInterruptRegister
+ * \ingroup DeferredInterrupts
+ */
+DeferredInterruptHandle_t xDeferredInterruptRegister( DeferredInterruptFunction_t pxFunction,
+                                                      void * pvParameters,
+                                                      UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+
+/**
+ * deferred_interrupt.h
+ *
+ * @code{c}
+ * void vDeferredInterruptRaiseFromISR( DeferredInterruptHandle_t xInterrupt,
+ *                                      BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Raises a deferred interrupt from an interrupt service routine, so its
+ * handler is called from its service task.  If the interrupt is already
+ * waiting for its handler to run, the raise is coalesced with the pending one.
+ *
+ * @param xInterrupt The deferred interrupt to raise.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if raising the interrupt
+ * unblocked a service task that has a priority above that of the currently
+ * running task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * \defgroup vDeferredInterruptRaiseFromISR vDeferredInterruptRaiseFromISR
+ * \ingroup DeferredInterrupts
+ */
+void vDeferredInterruptRaiseFromISR( DeferredInterruptHandle_t xInterrupt,
+                                     BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * deferred_interrupt.h
+ *
+ * @code{c}
+ * void vDeferredInterruptRaise( DeferredInterruptHandle_t xInterrupt );
+ * @endcode
+ *
+ * Version of vDeferredInterruptRaiseFromISR() that is called from a task, for
+ * example to handle events that were missed while a driver's interrupt was
+ * disabled.
+ *
+ * @param xInterrupt The deferred interrupt to raise.
+ *
+ * \defgroup vDeferredInterruptRaise vDeferredInterruptRaise
+ * \ingroup DeferredInterrupts
+ */
+void vDeferredInterruptRaise( DeferredInterruptHandle_t xInterrupt ) PRIVILEGED_FUNCTION;
+
+/**
+ * deferred_interrupt.h
+ *
+ * @code{c}
+ * void vDeferredInterruptGetStats( DeferredInterruptHandle_t xInterrupt,
+ *                                  DeferredInterruptStats_t * pxStats );
+ * @endcode
+ *
+ * Returns the number of times a deferred interrupt was raised and handled,
+ * and the latency from it being raised to its handler being called.  When
+ * raises are coalesced the latency is measured from the first of them.
+ *
+ * @param xInterrupt The deferred interrupt being queried.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vDeferredInterruptGetStats vDeferredInterruptGetStats
+ * \ingroup DeferredInterrupts
+ */
+void vDeferredInterruptGetStats( DeferredInterruptHandle_t xInterrupt,
+                                 DeferredInterruptStats_t * pxStats ) PRIVILEGED_FUNCTION;
+
+/**
+ * deferred_interrupt.h
+ *
+ * @code{c}
+ * void vDeferredInterruptResetStats( DeferredInterruptHandle_t xInterrupt );
+ * @endcode
+ *
+ * Clears the statistics returned by vDeferredInterruptGetStats().
+ *
+ * @param xInterrupt The deferred interrupt whose statistics are cleared.
+ *
+ * \defgroup vDeferredInterruptResetStats vDeferredInterruptResetStats
+ * \ingroup DeferredInterrupts
+ */
+void vDeferredInterruptResetStats( DeferredInterruptHandle_t xInterrupt ) PRIVILEGED_FUNCTION;
+
+/**
+ * deferred_interrupt.h
+ *
+ * @code{c}
+ * TaskHandle_t xDeferredInterruptGetServiceTask( DeferredInterruptHandle_t xInterrupt );
+ * @endcode
+ *
+ * Returns the service task from which the handler of a deferred interrupt is
+ * called, for example so uxTaskGetStackHighWaterMark() can be used to tune
+ * configDEFERRED_INTERRUPT_STACK_DEPTH.
+ *
+ * @param xInterrupt The deferred interrupt being queried.
+ *
+ * @return The handle of the service task.
+ *
+ * \defgroup xDeferredInterruptGetServiceTask xDeferredInterruptGetServiceTask
+ * \ingroup DeferredInterrupts
+ */
+TaskHandle_t xDeferredInterruptGetServiceTask( DeferredInterruptHandle_t xInterrupt ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( DEFERRED_INTERRUPT_H ) */
@@ -0,0 +1,264 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * An elastic queue is a queue of fixed size items whose storage is not
+ * allocated when the queue is created.  Instead the items are held in a chain
+ * of segments taken from a buffer pool, which many elastic queues can share.
+ * A segment is taken from the pool when an item is sent to a queue whose last
+ * segment is full, and returned to the pool when the items in it have all
+ * been received, so a queue only holds the memory its current contents need.
+ * Each queue still has a maximum length, so one queue cannot take every
+ * segment in the pool.
+ *
+ * Sending and receiving copy the item, as with a queue, and take constant
+ * time apart from the occasional segment allocation or free.  A task that
+ * sends to a full queue, or to a queue that needs a segment when the pool is
+ * empty, can block until there is room.
+ *
+ * configUSE_ELASTIC_QUEUES and configUSE_BUFFER_POOLS must both be set to 1
+ * in FreeRTOSConfig.h for this API to be available.
+ */
+
+#ifndef ELASTIC_QUEUE_H
+#define ELASTIC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include elastic_queue.h"
+#endif
+
+#include "buffer_pool.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which elastic queues are referenced.  For example, a call to
+ * xElasticQueueCreate() returns an ElasticQueueHandle_t variable that can then
+ * be used as a parameter to xElasticQueueSend().
+ */
+struct ElasticQueueDefinition;
+typedef struct ElasticQueueDefinition * ElasticQueueHandle_t;
+
+/**
+ * elastic_queue.h
+ *
+ * @code{c}
+ * ElasticQueueHandle_t xElasticQueueCreate( UBaseType_t uxMaxLength,
+ *                                           UBaseType_t uxItemSize,
+ *                                           BufferPoolHandle_t xSegmentPool );
+ * @endcode
+ *
+ * Creates an elastic queue using dynamically allocated memory for its control
+ * structure.  The queue holds no segments until an item is sent to it.
+ *
+ * @param uxMaxLength The maximum number of items the queue can hold.
+ *
+ * @param uxItemSize The size in bytes of each item.  Each segment holds as
+ * many items as fit in one buffer of xSegmentPool, which must be at least one.
+ *
+ * @param xSegmentPool The buffer pool the queue's segments are taken from.
+ * Buffers from the pool can be used for other purposes too.
+ *
+ * @return A handle to the created queue, or NULL if there was insufficient
+ * heap memory to create it.
+ *
+ * Example use:
+ * @code{c}
+ * void vCreateQueues( void )
+ * {
+ * BufferPoolHandle_t xSegments;
+ * UBaseType_t ux;
+ *
+ *  // 64 segments of 16 messages each, shared by all the queues.
+ *  xSegments = xBufferPoolCreate( 16 * sizeof( Message_t ), 64 );
+ *
+ *  for( ux = 0; ux < NUMBER_OF_QUEUES; ux++ )
+ *  {
+ *      // Each queue can hold a burst of up to 200 messages, but only
+ *      // occupies the segments it needs at the time.
+ *      xQueues[ ux ] = xElasticQueueCreate( 200, sizeof( Message_t ), xSegments );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xElasticQueueCreate xElasticQueueCreate
+ * \ingroup ElasticQueues
+ */
+ElasticQueueHandle_t xElasticQueueCreate( UBaseType_t uxMaxLength,
+                                          UBaseType_t uxItemSize,
+                                          BufferPoolHandle_t xSegmentPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * @code{c}
+ * void vElasticQueueDelete( ElasticQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Deletes an elastic queue, returning its segments to their pool and
+ * discarding any items still in it.  No task can be blocked on the queue when
+ * it is deleted.
+ *
+ * \defgroup vElasticQueueDelete vElasticQueueDelete
+ * \ingroup ElasticQueues
+ */
+void vElasticQueueDelete( ElasticQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * @code{c}
+ * BaseType_t xElasticQueueSend( ElasticQueueHandle_t xQueue,
+ *                               const void * pvItemToQueue,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item to the back of an elastic queue, taking a segment from the
+ * pool if the queue's last segment is full.
+ *
+ * @param xQueue The queue the item is sent to.
+ *
+ * @param pvItemToQueue The item to copy into the queue.
+ *
+ * @param xTicksToWait The maximum time to wait for the queue to have room for
+ * the item, and for a segment to be freed if one is needed and the pool is
+ * empty.
+ *
+ * @return pdPASS if the item was sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xElasticQueueSend xElasticQueueSend
+ * \ingroup ElasticQueues
+ */
+BaseType_t xElasticQueueSend( ElasticQueueHandle_t xQueue,
+                              const void * pvItemToQueue,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * @code{c}
+ * BaseType_t xElasticQueueSendFromISR( ElasticQueueHandle_t xQueue,
+ *                                      const void * pvItemToQueue,
+ *                                      BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xElasticQueueSend() that can be called from an interrupt
+ * service routine.  It never waits, so fails if the queue is full or needs a
+ * segment and the pool is empty.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the item unblocked
+ * a task that has a priority above that of the currently running task, in
+ * which case a context switch should be requested before the interrupt is
+ * exited.
+ *
+ * \defgroup xElasticQueueSendFromISR xElasticQueueSendFromISR
+ * \ingroup ElasticQueues
+ */
+BaseType_t xElasticQueueSendFromISR( ElasticQueueHandle_t xQueue,
+                                     const void * pvItemToQueue,
+                                     BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * @code{c}
+ * BaseType_t xElasticQueueReceive( ElasticQueueHandle_t xQueue,
+ *                                  void * pvBuffer,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies the item at the front of an elastic queue into pvBuffer and removes
+ * it from the queue, returning the first segment to the pool if it no longer
+ * holds any items.
+ *
+ * @param xQueue The queue the item is received from.
+ *
+ * @param pvBuffer The buffer the item is copied into.
+ *
+ * @param xTicksToWait The maximum time to wait for an item if the queue is
+ * empty.
+ *
+ * @return pdPASS if an item was received, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xElasticQueueReceive xElasticQueueReceive
+ * \ingroup ElasticQueues
+ */
+BaseType_t xElasticQueueReceive( ElasticQueueHandle_t xQueue,
+                                 void * pvBuffer,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * @code{c}
+ * BaseType_t xElasticQueueReceiveFromISR( ElasticQueueHandle_t xQueue,
+ *                                         void * pvBuffer,
+ *                                         BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xElasticQueueReceive() that can be called from an interrupt
+ * service routine.  It never waits.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the item, or
+ * freeing a segment, unblocked a task that has a priority above that of the
+ * currently running task.
+ *
+ * \defgroup xElasticQueueReceiveFromISR xElasticQueueReceiveFromISR
+ * \ingroup ElasticQueues
+ */
+BaseType_t xElasticQueueReceiveFromISR( ElasticQueueHandle_t xQueue,
+                                        void * pvBuffer,
+                                        BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * elastic_queue.h
+ *
+ * @code{c}
+ * UBaseType_t uxElasticQueueMessagesWaiting( ElasticQueueHandle_t xQueue );
+ * UBaseType_t uxElasticQueueGetSegmentCount( ElasticQueueHandle_t xQueue );
+ * @endcode
+ *
+ * @return The number of items that can be received from the queue, or the
+ * number of segments the queue currently holds.
+ *
+ * \defgroup uxElasticQueueMessagesWaiting uxElasticQueueMessagesWaiting
+ * \ingroup ElasticQueues
+ */
+UBaseType_t uxElasticQueueMessagesWaiting( ElasticQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+UBaseType_t uxElasticQueueGetSegmentCount( ElasticQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( ELASTIC_QUEUE_H ) */
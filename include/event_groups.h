@@ -83,14 +83,20 @@ struct EventGroupDef_t;
 typedef struct EventGroupDef_t   * EventGroupHandle_t;
 
 /*
- * The type that holds event bits always matches TickType_t - therefore the
+ * The type that holds event bits matches TickType_t - therefore the
  * number of bits it holds is set by configTICK_TYPE_WIDTH_IN_BITS (16 bits if set to 0,
- * 32 bits if set to 1, 64 bits if set to 2.
+ * 32 bits if set to 1, 64 bits if set to 2.  If configUSE_64_BIT_EVENT_GROUPS
+ * is set to 1 in FreeRTOSConfig.h then it is always 64 bits, whatever the
+ * width of TickType_t.
  *
  * \defgroup EventBits_t EventBits_t
  * \ingroup EventGroup
  */
-typedef TickType_t               EventBits_t;
+#if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+    typedef uint64_t             EventBits_t;
+#else
+    typedef TickType_t           EventBits_t;
+#endif
 
 /**
  * event_groups.h
@@ -116,8 +122,10 @@ typedef TickType_t               EventBits_t;
  * configTICK_TYPE_WIDTH_IN_BITS is 0 then each event group contains 8 usable bits (bit
  * 0 to bit 7).  If configTICK_TYPE_WIDTH_IN_BITS is set to 1 then each event group has
  * 24 usable bits (bit 0 to bit 23).  If configTICK_TYPE_WIDTH_IN_BITS is set to 2 then
- * each event group has 56 usable bits (bit 0 to bit 53). The EventBits_t type
- * is used to store event bits within an event group.
+ * each event group has 56 usable bits (bit 0 to bit 53).  If
+ * configUSE_64_BIT_EVENT_GROUPS is set to 1 then each event group has 56 usable
+ * bits whatever the setting of configTICK_TYPE_WIDTH_IN_BITS.  The EventBits_t
+ * type is used to store event bits within an event group.
  *
  * @return If the event group was created then a handle to the event group is
  * returned.  If there was insufficient FreeRTOS heap available to create the
@@ -173,8 +181,10 @@ typedef TickType_t               EventBits_t;
  * configTICK_TYPE_WIDTH_IN_BITS is 0 then each event group contains 8 usable bits (bit
  * 0 to bit 7).  If configTICK_TYPE_WIDTH_IN_BITS is set to 1 then each event group has
  * 24 usable bits (bit 0 to bit 23).  If configTICK_TYPE_WIDTH_IN_BITS is set to 2 then
- * each event group has 56 usable bits (bit 0 to bit 53).  The EventBits_t type
- * is used to store event bits within an event group.
+ * each event group has 56 usable bits (bit 0 to bit 53).  If
+ * configUSE_64_BIT_EVENT_GROUPS is set to 1 then each event group has 56 usable
+ * bits whatever the setting of configTICK_TYPE_WIDTH_IN_BITS.  The EventBits_t
+ * type is used to store event bits within an event group.
  *
  * @param pxEventGroupBuffer pxEventGroupBuffer must point to a variable of type
  * StaticEventGroup_t, which will be then be used to hold the event group's data
@@ -378,6 +388,10 @@ EventBits_t xEventGroupClearBits( EventGroupHandle_t xEventGroup,
  * timer task to have the clear operation performed in the context of the timer
  * task.
  *
+ * The message to the timer task carries the bits in a 32-bit parameter, so if
+ * configUSE_64_BIT_EVENT_GROUPS is set to 1 only bits 0 to 31 can be cleared
+ * using this function.
+ *
  * @note If this function returns pdPASS then the timer task is ready to run
  * and a portYIELD_FROM_ISR(pdTRUE) should be executed to perform the needed
  * clear on the event group.  This behavior is different from
@@ -519,6 +533,22 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * context of the timer task - where a scheduler lock is used in place of a
  * critical section.
  *
+ * If configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR is set to 1 in FreeRTOSConfig.h
+ * then the bits are instead set within the interrupt itself, and the tasks
+ * waiting for them are unblocked there too, which removes the latency of going
+ * through the timer task.  So that the time spent in the interrupt is bounded,
+ * the tasks are only unblocked in the interrupt if there are no more than
+ * configEVENT_GROUP_DIRECT_SET_MAX_WAITERS of them to test (counting, if
+ * configUSE_EVENT_GROUP_WAIT_INDEX is also 1, only those waiting on bits that
+ * are set), and no task is using the event group at the time.  Otherwise the
+ * timer task is sent a message to unblock them.
+ *
+ * The message to the timer task carries the bits in a 32-bit parameter, so if
+ * configUSE_64_BIT_EVENT_GROUPS is set to 1 only bits 0 to 31 can be set
+ * through the timer task.  Setting configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR
+ * to 1 removes that restriction, as the bits are always set in the
+ * interrupt.
+ *
  * @param xEventGroup The event group in which the bits are to be set.
  *
  * @param uxBitsToSet A bitwise value that indicates the bit or bits to set.
@@ -575,7 +605,7 @@ EventBits_t xEventGroupSetBits( EventGroupHandle_t xEventGroup,
  * \defgroup xEventGroupSetBitsFromISR xEventGroupSetBitsFromISR
  * \ingroup EventGroup
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 ) )
     BaseType_t xEventGroupSetBitsFromISR( EventGroupHandle_t xEventGroup,
                                           const EventBits_t uxBitsToSet,
                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
@@ -713,6 +743,76 @@ EventBits_t xEventGroupSync( EventGroupHandle_t xEventGroup,
                              const EventBits_t uxBitsToWaitFor,
                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * event_groups.h
+ * @code{c}
+ *  BaseType_t xEventGroupBarrierWait( EventGroupHandle_t xEventGroup,
+ *                                     const UBaseType_t uxParticipants,
+ *                                     TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Use an event group as a reusable barrier for any number of tasks.  Each
+ * task that calls xEventGroupBarrierWait() blocks until uxParticipants tasks
+ * have called it, at which point the last task to arrive unblocks all the
+ * others in a single pass over the tasks waiting at the barrier, and the
+ * barrier resets itself ready to be used again.  Unlike xEventGroupSync(),
+ * no event bits need to be assigned to the tasks, so the number of tasks
+ * taking part can change from one use of the barrier to the next, although
+ * every task taking part in one use must pass the same uxParticipants value.
+ * The barrier does not use or change the event bits of the event group.
+ *
+ * configUSE_EVENT_GROUP_BARRIERS must be set to 1 in FreeRTOSConfig.h for
+ * xEventGroupBarrierWait() to be available.
+ *
+ * This function cannot be called from an interrupt.
+ *
+ * @param xEventGroup The event group used as the barrier.
+ *
+ * @param uxParticipants The number of tasks that must call
+ * xEventGroupBarrierWait() before any of them can continue.
+ *
+ * @param xTicksToWait The maximum amount of time (specified in 'ticks') to
+ * wait for the other tasks to arrive at the barrier.
+ *
+ * @return pdPASS if all uxParticipants tasks arrived at the barrier.  pdFAIL if
+ * the block time expired first, in which case the calling task no longer
+ * counts as having arrived.
+ *
+ * Example usage:
+ * @code{c}
+ * // The event group used as the barrier, which it is assumed has already been
+ * // created by a call to xEventGroupCreate(), and the number of workers in the
+ * // current frame.
+ * EventGroupHandle_t xFrameBarrier;
+ * volatile UBaseType_t uxActiveWorkers;
+ *
+ * void vWorkerTask( void *pvParameters )
+ * {
+ *   for( ;; )
+ *   {
+ *      // Process this worker's share of the frame.
+ *      vProcessFrameSlice( pvParameters );
+ *
+ *      // Wait for all the other workers to finish the frame too.
+ *      if( xEventGroupBarrierWait( xFrameBarrier, uxActiveWorkers, pdMS_TO_TICKS( 10 ) ) == pdPASS )
+ *      {
+ *          // Every worker finished the frame.
+ *      }
+ *      else
+ *      {
+ *          // A worker did not finish the frame in time.
+ *      }
+ *   }
+ * }
+ * @endcode
+ * \defgroup xEventGroupBarrierWait xEventGroupBarrierWait
+ * \ingroup EventGroup
+ */
+#if ( configUSE_EVENT_GROUP_BARRIERS == 1 )
+    BaseType_t xEventGroupBarrierWait( EventGroupHandle_t xEventGroup,
+                                       const UBaseType_t uxParticipants,
+                                       TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
 
 /**
  * event_groups.h
@@ -776,6 +876,14 @@ void vEventGroupClearBitsCallback( void * pvEventGroup,
                                UBaseType_t uxEventGroupNumber ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configENABLE_ACCESS_CONTROL_LIST == 1 ) )
+
+/* Grant or revoke an unprivileged task's access to an event group, see
+ * vGrantAccessToKernelObject(). */
+    #define vGrantAccessToEventGroup( xTask, xEventGroup )     vGrantAccessToKernelObject( ( xTask ), ( xEventGroup ) )
+    #define vRevokeAccessToEventGroup( xTask, xEventGroup )    vRevokeAccessToKernelObject( ( xTask ), ( xEventGroup ) )
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -0,0 +1,148 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef HEAP_BENCHMARK_H
+#define HEAP_BENCHMARK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include heap_benchmark.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*
+ * The heap benchmark runs allocation patterns against whichever heap
+ * implementation the application is built with - heap_1.c to heap_7.c, or the
+ * file FREERTOS_HEAP names - so allocators can be compared on the same work.
+ * It is built when configUSE_HEAP_BENCHMARK is set to 1 in FreeRTOSConfig.h,
+ * and times each call with portGET_CYCLE_COUNT(), as the cycle benchmark does.
+ * Build the same application once per allocator and compare the results.
+ */
+
+/* The allocation patterns, set in HeapBenchmarkParameters_t.uxPattern. */
+#define heapbenchPATTERN_LIFO          ( 0 ) /* Allocate uxBlocks blocks, then free them newest first, repeatedly. */
+#define heapbenchPATTERN_FIFO          ( 1 ) /* Keep uxBlocks blocks allocated, always freeing the oldest to make the next. */
+#define heapbenchPATTERN_RANDOM        ( 2 ) /* Keep uxBlocks blocks allocated, freeing a random one to make the next. */
+#define heapbenchPATTERN_LONG_LIVED    ( 3 ) /* As random, but every other block is allocated once and held until the end. */
+#define heapbenchPATTERN_NO_FREE       ( 4 ) /* Only allocate, and never free - the only pattern heap_1.c can run. */
+#define heapbenchPATTERN_TRACE         ( 5 ) /* Replay the recorded trace pxTrace. */
+
+/* One step of a recorded allocation trace.  Blocks are named by index rather
+ * than address, so a trace recorded against one allocator can be replayed
+ * against any other. */
+typedef struct xHEAP_BENCHMARK_TRACE_ENTRY
+{
+    uint16_t usBlock; /*< The block, below configHEAP_BENCHMARK_MAX_BLOCKS. */
+    size_t xSize;     /*< The number of bytes to allocate to the block, which must be free, or 0 to free the block. */
+} HeapBenchmarkTraceEntry_t;
+
+/* What xHeapBenchmarkRun() does. */
+typedef struct xHEAP_BENCHMARK_PARAMETERS
+{
+    UBaseType_t uxPattern;                    /*< One of the heapbenchPATTERN_ values. */
+    uint32_t ulAllocations;                   /*< The number of allocations the pattern makes.  Not used by heapbenchPATTERN_TRACE. */
+    UBaseType_t uxBlocks;                     /*< The most blocks the pattern holds at once, up to configHEAP_BENCHMARK_MAX_BLOCKS.  Not used by heapbenchPATTERN_TRACE or heapbenchPATTERN_NO_FREE. */
+    size_t xMinimumSize;                      /*< The smallest block the pattern allocates. */
+    size_t xMaximumSize;                      /*< The largest block the pattern allocates.  Sizes are chosen at random between the two. */
+    uint32_t ulSeed;                          /*< Seeds the random sizes and choices, so the same seed gives the same requests with every allocator. */
+    const HeapBenchmarkTraceEntry_t * pxTrace; /*< The trace replayed by heapbenchPATTERN_TRACE. */
+    uint32_t ulTraceLength;                   /*< The number of entries in pxTrace. */
+    uint32_t ulSampleInterval;                /*< The heap is sampled with vPortGetHeapStats() every ulSampleInterval calls. */
+} HeapBenchmarkParameters_t;
+
+/* The result of one run.  Cycle counts have the cost of reading the cycle
+ * counter removed. */
+typedef struct xHEAP_BENCHMARK_RESULT
+{
+    uint32_t ulMallocs;             /*< The number of calls to pvPortMalloc() that returned a block. */
+    uint32_t ulFailedMallocs;       /*< The number of calls to pvPortMalloc() that returned NULL. */
+    uint32_t ulFrees;               /*< The number of calls to vPortFree(). */
+    uint32_t ulAverageMallocCycles; /*< The mean cost of pvPortMalloc(), successful or not. */
+    uint32_t ulMaxMallocCycles;     /*< The worst case cost of pvPortMalloc(). */
+    uint32_t ulAverageFreeCycles;   /*< The mean cost of vPortFree(). */
+    uint32_t ulMaxFreeCycles;       /*< The worst case cost of vPortFree(). */
+    uint64_t ullTotalCycles;        /*< The cost of every call, so the throughput is the calls made over this. */
+    size_t xPeakRequestedBytes;     /*< The most bytes requested by the blocks held at once. */
+    size_t xPeakOverheadBytes;      /*< The most bytes the heap used beyond those requested, at a sample. */
+    uint32_t ulPeakFragmentation;   /*< The worst fragmentation at a sample, in parts per thousand of the free space that is not in the largest free block. */
+    uint32_t ulSamples;             /*< The number of samples taken, which can be more than the timeline holds. */
+} HeapBenchmarkResult_t;
+
+/**
+ * heap_benchmark.h
+ * @code{c}
+ * void vHeapBenchmarkRun( const HeapBenchmarkParameters_t * pxParameters,
+ *                         HeapBenchmarkResult_t * pxResult,
+ *                         HeapStats_t * pxTimeline,
+ *                         uint32_t ulTimelineLength );
+ * @endcode
+ *
+ * Runs the pattern or trace pxParameters describes against the heap, timing
+ * every pvPortMalloc() and vPortFree() call, then frees any blocks the pattern
+ * still holds, except for heapbenchPATTERN_NO_FREE.  A pvPortMalloc() call that
+ * fails is counted and the pattern carries on without the block.
+ *
+ * Every ulSampleInterval calls, and once at the end, vPortGetHeapStats() is
+ * called outside the timed region.  The first ulTimelineLength samples are
+ * written to pxTimeline, giving the free space, largest free block and number
+ * of free blocks over time.  The overhead at a sample is the space the heap
+ * has lost since the run started less the bytes requested by the blocks held,
+ * so includes block headers, alignment padding and any space held by caches.
+ * heap_3.c cannot report its free space, so its overhead and fragmentation
+ * read 0.
+ *
+ * Call from a single task while nothing else uses the heap, or before the
+ * scheduler is started.  Interrupts are left enabled, so compare runs made
+ * with the same interrupts running.
+ *
+ * @param pxParameters The pattern to run.
+ *
+ * @param pxResult Receives the result.
+ *
+ * @param pxTimeline An array that receives the heap samples, or NULL.
+ *
+ * @param ulTimelineLength The number of entries in pxTimeline.
+ */
+#if ( configUSE_HEAP_BENCHMARK == 1 )
+    void vHeapBenchmarkRun( const HeapBenchmarkParameters_t * pxParameters,
+                            HeapBenchmarkResult_t * pxResult,
+                            HeapStats_t * pxTimeline,
+                            uint32_t ulTimelineLength ) PRIVILEGED_FUNCTION;
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* HEAP_BENCHMARK_H */
@@ -0,0 +1,151 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef LATENCY_BENCHMARK_H
+#define LATENCY_BENCHMARK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h" must appear in source files before "include latency_benchmark.h"
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/*
+ * The latency benchmark measures how long the kernel delays a periodic
+ * interrupt, and the task the interrupt wakes, while background tasks load
+ * the queues, the heap and the timers and hold critical sections.  It is
+ * built when configUSE_LATENCY_BENCHMARK is set to 1 in FreeRTOSConfig.h, and
+ * reads the cycle counter with portGET_CYCLE_COUNT().
+ *
+ * The interrupt itself belongs to the application, as only it knows which
+ * timer is free on the part.  Set up a timer to interrupt periodically at
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY - the highest priority that can call
+ * the kernel, so the one the kernel's critical sections delay the most - and
+ * call vLatencyBenchmarkInterrupt() first thing in its handler.  Run the same
+ * test on each port and configuration to compare them.
+ */
+
+/* The background load, set in LatencyBenchmarkParameters_t.uxLoad. */
+#define latencybenchLOAD_QUEUE       ( ( UBaseType_t ) 0x01U ) /* A task filling and emptying a queue. */
+#define latencybenchLOAD_HEAP        ( ( UBaseType_t ) 0x02U ) /* A task allocating and freeing blocks of varying size. */
+#define latencybenchLOAD_TIMER       ( ( UBaseType_t ) 0x04U ) /* A task restarting timers.  Needs configUSE_TIMERS. */
+#define latencybenchLOAD_CRITICAL    ( ( UBaseType_t ) 0x08U ) /* A task holding critical sections of ulCriticalSectionCycles. */
+
+/* The number of buckets in each latency histogram. */
+#define latencybenchHISTOGRAM_BUCKETS    ( 16 )
+
+/* The distribution of one latency.  Cycle counts have the cost of reading
+ * the cycle counter removed. */
+typedef struct xLATENCY_HISTOGRAM
+{
+    uint32_t ulSamples;                                    /*< The number of measurements taken. */
+    uint32_t ulMinCycles;                                  /*< The shortest latency. */
+    uint32_t ulMaxCycles;                                  /*< The longest latency. */
+    uint32_t ulAverageCycles;                              /*< The mean of all the latencies. */
+    uint32_t ulBuckets[ latencybenchHISTOGRAM_BUCKETS ];   /*< Bucket n counts latencies from n * ulBucketCycles up to (n + 1) * ulBucketCycles.  The last bucket also counts all longer latencies. */
+} LatencyHistogram_t;
+
+/* What vLatencyBenchmarkRun() does. */
+typedef struct xLATENCY_BENCHMARK_PARAMETERS
+{
+    uint32_t ulSamples;               /*< The number of task wake latencies to measure before returning. */
+    UBaseType_t uxLoad;               /*< The background load - any of the latencybenchLOAD_ bits. */
+    uint32_t ulCriticalSectionCycles; /*< How long latencybenchLOAD_CRITICAL holds each critical section. */
+    uint32_t ulBucketCycles;          /*< The width of each histogram bucket. */
+} LatencyBenchmarkParameters_t;
+
+/* The result of one run. */
+typedef struct xLATENCY_BENCHMARK_RESULT
+{
+    LatencyHistogram_t xEntry; /*< From the interrupt being raised to vLatencyBenchmarkInterrupt() being called. */
+    LatencyHistogram_t xWake;  /*< From vLatencyBenchmarkInterrupt() to the task it woke running. */
+    uint32_t ulMissedWakes;    /*< Interrupts that arrived before the task woken by the one before had run, so had no wake latency measured. */
+} LatencyBenchmarkResult_t;
+
+/**
+ * latency_benchmark.h
+ * @code{c}
+ * void vLatencyBenchmarkRun( const LatencyBenchmarkParameters_t * pxParameters,
+ *                            LatencyBenchmarkResult_t * pxResult );
+ * @endcode
+ *
+ * Starts the background load, then measures the latencies of the
+ * application's periodic interrupt until ulSamples task wakes have been
+ * measured.  The interrupt wakes a task at configMAX_PRIORITIES - 1, and the
+ * load runs at tskIDLE_PRIORITY + 1 without blocking, so the kernel is always
+ * busy when the interrupt arrives.
+ *
+ * Must be called from a task, which on MPU ports must be privileged, after the
+ * scheduler has started and with the application's interrupt running.  The
+ * calling task's priority must be above tskIDLE_PRIORITY + 1 and below
+ * configMAX_PRIORITIES - 1, and tasks below it will not run until the call
+ * returns.
+ *
+ * @param pxParameters The load to run and the samples to take.
+ *
+ * @param pxResult Receives the latency distributions.
+ */
+#if ( configUSE_LATENCY_BENCHMARK == 1 )
+    void vLatencyBenchmarkRun( const LatencyBenchmarkParameters_t * pxParameters,
+                               LatencyBenchmarkResult_t * pxResult ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * latency_benchmark.h
+ * @code{c}
+ * void vLatencyBenchmarkInterrupt( uint32_t ulRaisedCycles,
+ *                                  BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Called first thing in the application's periodic interrupt handler.  Does
+ * nothing unless vLatencyBenchmarkRun() is running.
+ *
+ * @param ulRaisedCycles The value portGET_CYCLE_COUNT() had when the interrupt
+ * was raised - for a timer compare interrupt, the cycle count at which the
+ * compare matched, which the application works out from the timer.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the woken task should run
+ * when the interrupt exits, in which case the handler must request a context
+ * switch with portYIELD_FROM_ISR().
+ */
+#if ( configUSE_LATENCY_BENCHMARK == 1 )
+    void vLatencyBenchmarkInterrupt( uint32_t ulRaisedCycles,
+                                     BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* LATENCY_BENCHMARK_H */
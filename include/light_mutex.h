@@ -0,0 +1,226 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Light mutexes provide mutual exclusion between tasks without the overhead of
+ * the queue based mutexes created by xSemaphoreCreateMutex().  Taking a light
+ * mutex that is available, and giving back a light mutex that no other task
+ * is waiting for, is a single atomic compare and swap of the mutex owner - the
+ * scheduler is only involved when tasks contend for the mutex.  Light mutexes
+ * implement the same priority inheritance mechanism as queue based mutexes.
+ *
+ * The compare and swap is implemented by atomic.h, so it only avoids a critical
+ * section on ports that provide native atomic instructions.
+ *
+ * ***NOTE***:  Light mutexes cannot be used from interrupt service routines,
+ * cannot be taken recursively, and cannot be added to queue sets.
+ */
+
+#ifndef LIGHT_MUTEX_H
+#define LIGHT_MUTEX_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include light_mutex.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which light mutexes are referenced.  For example, a call to
+ * xLightMutexCreate() returns a LightMutexHandle_t variable that can then be
+ * used as a parameter to xLightMutexTake(), xLightMutexGive(), etc.
+ */
+struct LightMutexDefinition;
+typedef struct LightMutexDefinition * LightMutexHandle_t;
+
+/**
+ * light_mutex.h
+ *
+ * @code{c}
+ * LightMutexHandle_t xLightMutexCreate( void );
+ * @endcode
+ *
+ * Creates a new light mutex using dynamically allocated memory.  See
+ * xLightMutexCreateStatic() for a version that uses statically allocated
+ * memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xLightMutexCreate() to be available.
+ *
+ * @return If the mutex is successfully created then a handle to the created
+ * mutex is returned.  If there is insufficient heap memory available to create
+ * the mutex then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ * LightMutexHandle_t xBusMutex;
+ *
+ * void vATask( void * pvParameters )
+ * {
+ *  xBusMutex = xLightMutexCreate();
+ *  configASSERT( xBusMutex );
+ *
+ *  for( ;; )
+ *  {
+ *      if( xLightMutexTake( xBusMutex, pdMS_TO_TICKS( 10 ) ) == pdPASS )
+ *      {
+ *          // Access the bus here, then give the mutex back.
+ *          xLightMutexGive( xBusMutex );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xLightMutexCreate xLightMutexCreate
+ * \ingroup LightMutexManagement
+ */
+LightMutexHandle_t xLightMutexCreate( void ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_mutex.h
+ *
+ * @code{c}
+ * LightMutexHandle_t xLightMutexCreateStatic( StaticLightMutex_t *pxMutexBuffer );
+ * @endcode
+ *
+ * Creates a new light mutex using statically allocated memory.  See
+ * xLightMutexCreate() for a version that uses dynamically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xLightMutexCreateStatic() to be available.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticLightMutex_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return If pxMutexBuffer is not NULL then a handle to the created mutex is
+ * returned, otherwise NULL is returned.
+ *
+ * \defgroup xLightMutexCreateStatic xLightMutexCreateStatic
+ * \ingroup LightMutexManagement
+ */
+LightMutexHandle_t xLightMutexCreateStatic( StaticLightMutex_t * const pxMutexBuffer ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_mutex.h
+ *
+ * @code{c}
+ * void vLightMutexDelete( LightMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Deletes a light mutex that was previously created using a call to
+ * xLightMutexCreate() or xLightMutexCreateStatic().  If the mutex was created
+ * using dynamic memory then the memory is freed.
+ *
+ * A mutex must not be deleted while it is held or while a task is blocked on
+ * it.
+ *
+ * @param xMutex The handle of the mutex to be deleted.
+ *
+ * \defgroup vLightMutexDelete vLightMutexDelete
+ * \ingroup LightMutexManagement
+ */
+void vLightMutexDelete( LightMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_mutex.h
+ *
+ * @code{c}
+ * BaseType_t xLightMutexTake( LightMutexHandle_t xMutex, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Takes a light mutex.  If the mutex is held by another task then the calling
+ * task blocks until the mutex is given back or xTicksToWait ticks pass, and
+ * the task holding the mutex inherits the priority of the calling task if the
+ * calling task has the higher priority.
+ *
+ * @param xMutex The handle of the mutex being taken.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for the mutex.  Setting xTicksToWait to 0 will cause the function to return
+ * immediately if the mutex is not available.  Setting xTicksToWait to
+ * portMAX_DELAY will cause the task to wait indefinitely (provided
+ * INCLUDE_vTaskSuspend is set to 1 in FreeRTOSConfig.h).
+ *
+ * @return pdPASS if the mutex was obtained, otherwise pdFAIL.
+ *
+ * \defgroup xLightMutexTake xLightMutexTake
+ * \ingroup LightMutexManagement
+ */
+BaseType_t xLightMutexTake( LightMutexHandle_t xMutex,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_mutex.h
+ *
+ * @code{c}
+ * BaseType_t xLightMutexGive( LightMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Gives back a light mutex.  Must only be called by the task that holds the
+ * mutex.  If other tasks are blocked waiting for the mutex then the highest
+ * priority of them is unblocked, and if the calling task had inherited a
+ * priority then its base priority is restored once it holds no more mutexes.
+ *
+ * @param xMutex The handle of the mutex being given.
+ *
+ * @return pdPASS if the mutex was given back, otherwise pdFAIL if the calling
+ * task did not hold the mutex.
+ *
+ * \defgroup xLightMutexGive xLightMutexGive
+ * \ingroup LightMutexManagement
+ */
+BaseType_t xLightMutexGive( LightMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/**
+ * light_mutex.h
+ *
+ * @code{c}
+ * TaskHandle_t xLightMutexGetHolder( LightMutexHandle_t xMutex );
+ * @endcode
+ *
+ * Returns the handle of the task that holds the mutex, or NULL if the mutex is
+ * not held.  The value returned could be out of date by the time the caller
+ * uses it, so it should only be used for diagnostics.
+ *
+ * @param xMutex The handle of the mutex being queried.
+ *
+ * \defgroup xLightMutexGetHolder xLightMutexGetHolder
+ * \ingroup LightMutexManagement
+ */
+TaskHandle_t xLightMutexGetHolder( LightMutexHandle_t xMutex ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( LIGHT_MUTEX_H ) */
@@ -49,6 +49,28 @@
  * effectively a two way link between the object containing the list item and
  * the list item itself.
  *
+ * If configUSE_COMPACT_LIST_LINKS is 1 each of those pointers is instead held
+ * as a 16-bit link, being the offset of the object it references from
+ * configLIST_COMPACT_BASE in units of ( 1 << configLIST_COMPACT_SHIFT ) bytes,
+ * plus one so a link of 0 can represent NULL.  That halves the size of the
+ * links on a 32-bit part, but every list, list item and list item owner must
+ * then be within the ( 0xFFFF << configLIST_COMPACT_SHIFT ) bytes above
+ * configLIST_COMPACT_BASE and aligned to ( 1 << configLIST_COMPACT_SHIFT )
+ * bytes.  The links are always accessed through the macros below, such as
+ * listGET_NEXT() and listSET_NEXT(), so code using them works with either
+ * representation.
+ *
+ * If configUSE_SKIP_LISTS is 1 each list item also carries up to
+ * ( configSKIP_LIST_LEVELS - 1 ) levels of express links, making each sorted
+ * list a skip list.  vListInsert() uses the express links to find the insertion
+ * point in a time that grows with the logarithm of the list length rather than
+ * with the list length itself, which matters when many tasks block on the same
+ * queue or are delayed at the same time.  Each item is linked onto a randomly
+ * chosen number of express levels when vListInsert() places it, and onto none
+ * when it is placed by vListInsertEnd(), so lists that are never sorted do not
+ * pay for the links beyond their size.  Reading the head of a list, and every
+ * other list operation, is unchanged.
+ *
  *
  * \page ListIntroduction List Implementation
  * \ingroup FreeRTOSIntro
@@ -141,16 +163,36 @@
  * Definition of the only type of object that a list can contain.
  */
 struct xLIST;
-struct xLIST_ITEM
-{
-    listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE           /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
-    configLIST_VOLATILE TickType_t xItemValue;          /*< The value being listed.  In most cases this is used to sort the list in ascending order. */
-    struct xLIST_ITEM * configLIST_VOLATILE pxNext;     /*< Pointer to the next ListItem_t in the list. */
-    struct xLIST_ITEM * configLIST_VOLATILE pxPrevious; /*< Pointer to the previous ListItem_t in the list. */
-    void * pvOwner;                                     /*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
-    struct xLIST * configLIST_VOLATILE pxContainer;     /*< Pointer to the list in which this list item is placed (if any). */
-    listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE          /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
-};
+#if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    struct xLIST_ITEM
+    {
+        listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE  /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+        configLIST_VOLATILE TickType_t xItemValue; /*< The value being listed.  In most cases this is used to sort the list in ascending order. */
+        configLIST_VOLATILE uint16_t usNext;       /*< Link to the next ListItem_t in the list. */
+        configLIST_VOLATILE uint16_t usPrevious;   /*< Link to the previous ListItem_t in the list. */
+        uint16_t usOwner;                          /*< Link to the object (normally a TCB) that contains the list item. */
+        configLIST_VOLATILE uint16_t usContainer;  /*< Link to the list in which this list item is placed (if any). */
+        listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+    };
+#else
+    struct xLIST_ITEM
+    {
+        listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE           /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+        configLIST_VOLATILE TickType_t xItemValue;          /*< The value being listed.  In most cases this is used to sort the list in ascending order. */
+        struct xLIST_ITEM * configLIST_VOLATILE pxNext;     /*< Pointer to the next ListItem_t in the list. */
+        struct xLIST_ITEM * configLIST_VOLATILE pxPrevious; /*< Pointer to the previous ListItem_t in the list. */
+        #if ( configUSE_SKIP_LISTS == 1 )
+            struct xLIST_ITEM * configLIST_VOLATILE pxSkipNext[ configSKIP_LIST_LEVELS - 1 ];     /*< Express links to later items in a sorted list.  Must follow pxPrevious so they are at the same offset as in MiniListItem_t. */
+            struct xLIST_ITEM * configLIST_VOLATILE pxSkipPrevious[ configSKIP_LIST_LEVELS - 1 ]; /*< Express links to earlier items in a sorted list. */
+        #endif
+        void * pvOwner;                                     /*< Pointer to the object (normally a TCB) that contains the list item.  There is therefore a two way link between the object containing the list item and the list item itself. */
+        struct xLIST * configLIST_VOLATILE pxContainer;     /*< Pointer to the list in which this list item is placed (if any). */
+        #if ( configUSE_SKIP_LISTS == 1 )
+            UBaseType_t uxSkipLevels;                       /*< The number of express levels the item is linked onto. */
+        #endif
+        listSECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE          /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+    };
+#endif /* configUSE_COMPACT_LIST_LINKS */
 typedef struct xLIST_ITEM ListItem_t;                   /* For some reason lint wants this as two separate definitions. */
 
 #if ( configUSE_MINI_LIST_ITEM == 1 )
@@ -158,8 +200,17 @@ typedef struct xLIST_ITEM ListItem_t;                   /* For some reason lint
     {
         listFIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
         configLIST_VOLATILE TickType_t xItemValue;
-        struct xLIST_ITEM * configLIST_VOLATILE pxNext;
-        struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;
+        #if ( configUSE_COMPACT_LIST_LINKS == 1 )
+            configLIST_VOLATILE uint16_t usNext;
+            configLIST_VOLATILE uint16_t usPrevious;
+        #else
+            struct xLIST_ITEM * configLIST_VOLATILE pxNext;
+            struct xLIST_ITEM * configLIST_VOLATILE pxPrevious;
+            #if ( configUSE_SKIP_LISTS == 1 )
+                struct xLIST_ITEM * configLIST_VOLATILE pxSkipNext[ configSKIP_LIST_LEVELS - 1 ];
+                struct xLIST_ITEM * configLIST_VOLATILE pxSkipPrevious[ configSKIP_LIST_LEVELS - 1 ];
+            #endif
+        #endif
     };
     typedef struct xMINI_LIST_ITEM MiniListItem_t;
 #else
@@ -171,13 +222,76 @@ typedef struct xLIST_ITEM ListItem_t;                   /* For some reason lint
  */
 typedef struct xLIST
 {
-    listFIRST_LIST_INTEGRITY_CHECK_VALUE      /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+    listFIRST_LIST_INTEGRITY_CHECK_VALUE          /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
     volatile UBaseType_t uxNumberOfItems;
-    ListItem_t * configLIST_VOLATILE pxIndex; /*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
-    MiniListItem_t xListEnd;                  /*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
-    listSECOND_LIST_INTEGRITY_CHECK_VALUE     /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
+    #if ( configUSE_COMPACT_LIST_LINKS == 1 )
+        configLIST_VOLATILE uint16_t usIndex;     /*< Link to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
+    #else
+        ListItem_t * configLIST_VOLATILE pxIndex; /*< Used to walk through the list.  Points to the last item returned by a call to listGET_OWNER_OF_NEXT_ENTRY (). */
+    #endif
+    MiniListItem_t xListEnd;                      /*< List item that contains the maximum possible item value meaning it is always at the end of the list and is therefore used as a marker. */
+    listSECOND_LIST_INTEGRITY_CHECK_VALUE         /*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
+/*
+ * Convert between a pointer and the 16-bit link that represents it when
+ * configUSE_COMPACT_LIST_LINKS is 1.  The argument is evaluated more than once.
+ */
+#if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    #define listLINK_FROM_POINTER( pv ) \
+    ( ( ( pv ) == NULL ) ? ( uint16_t ) 0U : ( uint16_t ) ( ( ( ( portPOINTER_SIZE_TYPE ) ( pv ) - ( portPOINTER_SIZE_TYPE ) ( configLIST_COMPACT_BASE ) ) >> configLIST_COMPACT_SHIFT ) + 1U ) )
+    #define listLINK_TO_POINTER( usLink ) \
+    ( ( ( usLink ) == 0U ) ? NULL : ( void * ) ( ( portPOINTER_SIZE_TYPE ) ( configLIST_COMPACT_BASE ) + ( ( ( portPOINTER_SIZE_TYPE ) ( usLink ) - 1U ) << configLIST_COMPACT_SHIFT ) ) )
+#endif
+
+/*
+ * Access macros for the links between list items, and between a list item
+ * and the list that contains it.  Other than in list.c and this file they are
+ * only needed by code that walks a list itself.
+ *
+ * \page listSET_NEXT listSET_NEXT
+ * \ingroup LinkedList
+ */
+#if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    #define listGET_PREVIOUS( pxListItem )                         ( ( ListItem_t * ) listLINK_TO_POINTER( ( pxListItem )->usPrevious ) )
+    #define listSET_NEXT( pxListItem, pxNextItem )                 ( ( pxListItem )->usNext = listLINK_FROM_POINTER( pxNextItem ) )
+    #define listSET_PREVIOUS( pxListItem, pxPreviousItem )         ( ( pxListItem )->usPrevious = listLINK_FROM_POINTER( pxPreviousItem ) )
+    #define listSET_LIST_ITEM_CONTAINER( pxListItem, pxList )      ( ( pxListItem )->usContainer = listLINK_FROM_POINTER( pxList ) )
+    #define listGET_INDEX( pxList )                                ( ( ListItem_t * ) listLINK_TO_POINTER( ( pxList )->usIndex ) )
+    #define listSET_INDEX( pxList, pxListItem )                    ( ( pxList )->usIndex = listLINK_FROM_POINTER( pxListItem ) )
+#else
+    #define listGET_PREVIOUS( pxListItem )                         ( ( pxListItem )->pxPrevious )
+    #define listSET_NEXT( pxListItem, pxNextItem )                 ( ( pxListItem )->pxNext = ( pxNextItem ) )
+    #define listSET_PREVIOUS( pxListItem, pxPreviousItem )         ( ( pxListItem )->pxPrevious = ( pxPreviousItem ) )
+    #define listSET_LIST_ITEM_CONTAINER( pxListItem, pxList )      ( ( pxListItem )->pxContainer = ( pxList ) )
+    #define listGET_INDEX( pxList )                                ( ( pxList )->pxIndex )
+    #define listSET_INDEX( pxList, pxListItem )                    ( ( pxList )->pxIndex = ( pxListItem ) )
+#endif /* configUSE_COMPACT_LIST_LINKS */
+
+/*
+ * Unlink a list item from the express levels of a skip list, and mark a list
+ * item as not being on any express level.  Both do nothing unless
+ * configUSE_SKIP_LISTS is 1.
+ */
+#if ( configUSE_SKIP_LISTS == 1 )
+    #define listSKIP_UNLINK( pxListItem )                                                                                           \
+    {                                                                                                                               \
+        UBaseType_t uxSkipLevel;                                                                                                    \
+                                                                                                                                    \
+        for( uxSkipLevel = ( UBaseType_t ) 0U; uxSkipLevel < ( pxListItem )->uxSkipLevels; uxSkipLevel++ )                         \
+        {                                                                                                                           \
+            ( pxListItem )->pxSkipNext[ uxSkipLevel ]->pxSkipPrevious[ uxSkipLevel ] = ( pxListItem )->pxSkipPrevious[ uxSkipLevel ]; \
+            ( pxListItem )->pxSkipPrevious[ uxSkipLevel ]->pxSkipNext[ uxSkipLevel ] = ( pxListItem )->pxSkipNext[ uxSkipLevel ];     \
+        }                                                                                                                           \
+                                                                                                                                    \
+        ( pxListItem )->uxSkipLevels = ( UBaseType_t ) 0U;                                                                          \
+    }
+    #define listSKIP_RESET( pxListItem )    ( ( pxListItem )->uxSkipLevels = ( UBaseType_t ) 0U )
+#else
+    #define listSKIP_UNLINK( pxListItem )
+    #define listSKIP_RESET( pxListItem )
+#endif /* configUSE_SKIP_LISTS */
+
 /*
  * Access macro to set the owner of a list item.  The owner of a list item
  * is the object (usually a TCB) that contains the list item.
@@ -185,7 +299,11 @@ typedef struct xLIST
  * \page listSET_LIST_ITEM_OWNER listSET_LIST_ITEM_OWNER
  * \ingroup LinkedList
  */
-#define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )    ( ( pxListItem )->pvOwner = ( void * ) ( pxOwner ) )
+#if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    #define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )    ( ( pxListItem )->usOwner = listLINK_FROM_POINTER( pxOwner ) )
+#else
+    #define listSET_LIST_ITEM_OWNER( pxListItem, pxOwner )    ( ( pxListItem )->pvOwner = ( void * ) ( pxOwner ) )
+#endif
 
 /*
  * Access macro to get the owner of a list item.  The owner of a list item
@@ -194,7 +312,11 @@ typedef struct xLIST
  * \page listGET_LIST_ITEM_OWNER listSET_LIST_ITEM_OWNER
  * \ingroup LinkedList
  */
-#define listGET_LIST_ITEM_OWNER( pxListItem )             ( ( pxListItem )->pvOwner )
+#if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    #define listGET_LIST_ITEM_OWNER( pxListItem )    listLINK_TO_POINTER( ( pxListItem )->usOwner )
+#else
+    #define listGET_LIST_ITEM_OWNER( pxListItem )    ( ( pxListItem )->pvOwner )
+#endif
 
 /*
  * Access macro to set the value of the list item.  In most cases the value is
@@ -222,7 +344,7 @@ typedef struct xLIST
  * \page listGET_LIST_ITEM_VALUE listGET_LIST_ITEM_VALUE
  * \ingroup LinkedList
  */
-#define listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxList )        ( ( ( pxList )->xListEnd ).pxNext->xItemValue )
+#define listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxList )        ( listGET_HEAD_ENTRY( pxList )->xItemValue )
 
 /*
  * Return the list item at the head of the list.
@@ -230,7 +352,7 @@ typedef struct xLIST
  * \page listGET_HEAD_ENTRY listGET_HEAD_ENTRY
  * \ingroup LinkedList
  */
-#define listGET_HEAD_ENTRY( pxList )                      ( ( ( pxList )->xListEnd ).pxNext )
+#define listGET_HEAD_ENTRY( pxList )                      listGET_NEXT( &( ( pxList )->xListEnd ) )
 
 /*
  * Return the next list item.
@@ -238,7 +360,11 @@ typedef struct xLIST
  * \page listGET_NEXT listGET_NEXT
  * \ingroup LinkedList
  */
-#define listGET_NEXT( pxListItem )                        ( ( pxListItem )->pxNext )
+#if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    #define listGET_NEXT( pxListItem )    ( ( ListItem_t * ) listLINK_TO_POINTER( ( pxListItem )->usNext ) )
+#else
+    #define listGET_NEXT( pxListItem )    ( ( pxListItem )->pxNext )
+#endif
 
 /*
  * Return the list item that marks the end of the list
@@ -287,12 +413,12 @@ typedef struct xLIST
         List_t * const pxConstList = ( pxList );                                               \
         /* Increment the index to the next item and return the item, ensuring */               \
         /* we don't return the marker used at the end of the list.  */                         \
-        ( pxConstList )->pxIndex = ( pxConstList )->pxIndex->pxNext;                           \
-        if( ( void * ) ( pxConstList )->pxIndex == ( void * ) &( ( pxConstList )->xListEnd ) ) \
+        listSET_INDEX( pxConstList, listGET_NEXT( listGET_INDEX( pxConstList ) ) );            \
+        if( ( void * ) listGET_INDEX( pxConstList ) == ( void * ) &( ( pxConstList )->xListEnd ) ) \
         {                                                                                      \
-            ( pxConstList )->pxIndex = ( pxConstList )->xListEnd.pxNext;                       \
+            listSET_INDEX( pxConstList, listGET_HEAD_ENTRY( pxConstList ) );                   \
         }                                                                                      \
-        ( pxTCB ) = ( pxConstList )->pxIndex->pvOwner;                                         \
+        ( pxTCB ) = listGET_LIST_ITEM_OWNER( listGET_INDEX( pxConstList ) );                   \
     }
 
 /*
@@ -315,17 +441,18 @@ typedef struct xLIST
     {                                     \
         /* The list item knows which list it is in.  Obtain the list from the list \
          * item. */                                                              \
-        List_t * const pxList = ( pxItemToRemove )->pxContainer;                 \
+        List_t * const pxList = listLIST_ITEM_CONTAINER( pxItemToRemove );       \
                                                                                  \
-        ( pxItemToRemove )->pxNext->pxPrevious = ( pxItemToRemove )->pxPrevious; \
-        ( pxItemToRemove )->pxPrevious->pxNext = ( pxItemToRemove )->pxNext;     \
+        listSET_PREVIOUS( listGET_NEXT( pxItemToRemove ), listGET_PREVIOUS( pxItemToRemove ) ); \
+        listSET_NEXT( listGET_PREVIOUS( pxItemToRemove ), listGET_NEXT( pxItemToRemove ) );     \
+        listSKIP_UNLINK( pxItemToRemove );                                       \
         /* Make sure the index is left pointing to a valid item. */              \
-        if( pxList->pxIndex == ( pxItemToRemove ) )                              \
+        if( listGET_INDEX( pxList ) == ( pxItemToRemove ) )                      \
         {                                                                        \
-            pxList->pxIndex = ( pxItemToRemove )->pxPrevious;                    \
+            listSET_INDEX( pxList, listGET_PREVIOUS( pxItemToRemove ) );         \
         }                                                                        \
                                                                                  \
-        ( pxItemToRemove )->pxContainer = NULL;                                  \
+        listSET_LIST_ITEM_CONTAINER( ( pxItemToRemove ), NULL );                 \
         ( pxList->uxNumberOfItems )--;                                           \
     }
 
@@ -353,7 +480,7 @@ typedef struct xLIST
  */
 #define listINSERT_END( pxList, pxNewListItem )           \
     {                                                     \
-        ListItem_t * const pxIndex = ( pxList )->pxIndex; \
+        ListItem_t * const pxIndex = listGET_INDEX( pxList ); \
                                                           \
         /* Only effective when configASSERT() is also defined, these tests may catch \
          * the list data structures being overwritten in memory.  They will not catch \
@@ -364,18 +491,54 @@ typedef struct xLIST
         /* Insert a new list item into ( pxList ), but rather than sort the list, \
          * makes the new list item the last item to be removed by a call to \
          * listGET_OWNER_OF_NEXT_ENTRY(). */                 \
-        ( pxNewListItem )->pxNext = pxIndex;                 \
-        ( pxNewListItem )->pxPrevious = pxIndex->pxPrevious; \
-                                                             \
-        pxIndex->pxPrevious->pxNext = ( pxNewListItem );     \
-        pxIndex->pxPrevious = ( pxNewListItem );             \
-                                                             \
-        /* Remember which list the item is in. */            \
-        ( pxNewListItem )->pxContainer = ( pxList );         \
+        listSET_NEXT( ( pxNewListItem ), pxIndex );                               \
+        listSET_PREVIOUS( ( pxNewListItem ), listGET_PREVIOUS( pxIndex ) );       \
+                                                                                  \
+        listSET_NEXT( listGET_PREVIOUS( pxIndex ), ( pxNewListItem ) );           \
+        listSET_PREVIOUS( pxIndex, ( pxNewListItem ) );                           \
+        listSKIP_RESET( pxNewListItem );                                          \
+                                                                                  \
+        /* Remember which list the item is in. */                                 \
+        listSET_LIST_ITEM_CONTAINER( ( pxNewListItem ), ( pxList ) );             \
                                                              \
         ( ( pxList )->uxNumberOfItems )++;                   \
     }
 
+/*
+ * Insert a list item into a list immediately before pxPosition, which is
+ * either an item already in the list or the list end marker.  Used where the
+ * order of the list is maintained by the caller rather than by the item
+ * values.  The position of pxIndex is not considered.
+ *
+ * @param pxList The list into which the item is to be inserted.
+ *
+ * @param pxPosition The item, or end marker, to insert the new item before.
+ *
+ * @param pxNewListItem The list item to be inserted into the list.
+ *
+ * \page listINSERT_BEFORE listINSERT_BEFORE
+ * \ingroup LinkedList
+ */
+#define listINSERT_BEFORE( pxList, pxPosition, pxNewListItem )      \
+    {                                                             \
+        ListItem_t * const pxNextItem = ( ListItem_t * ) ( pxPosition ); \
+                                                                  \
+        listTEST_LIST_INTEGRITY( ( pxList ) );                    \
+        listTEST_LIST_ITEM_INTEGRITY( ( pxNewListItem ) );        \
+                                                                  \
+        listSET_NEXT( ( pxNewListItem ), pxNextItem );                        \
+        listSET_PREVIOUS( ( pxNewListItem ), listGET_PREVIOUS( pxNextItem ) ); \
+                                                                              \
+        listSET_NEXT( listGET_PREVIOUS( pxNextItem ), ( pxNewListItem ) );    \
+        listSET_PREVIOUS( pxNextItem, ( pxNewListItem ) );                    \
+        listSKIP_RESET( pxNewListItem );                                      \
+                                                                              \
+        /* Remember which list the item is in. */                             \
+        listSET_LIST_ITEM_CONTAINER( ( pxNewListItem ), ( pxList ) );         \
+                                                                  \
+        ( ( pxList )->uxNumberOfItems )++;                        \
+    }
+
 /*
  * Access function to obtain the owner of the first entry in a list.  Lists
  * are normally sorted in ascending item value order.
@@ -392,7 +555,7 @@ typedef struct xLIST
  * \page listGET_OWNER_OF_HEAD_ENTRY listGET_OWNER_OF_HEAD_ENTRY
  * \ingroup LinkedList
  */
-#define listGET_OWNER_OF_HEAD_ENTRY( pxList )            ( ( &( ( pxList )->xListEnd ) )->pxNext->pvOwner )
+#define listGET_OWNER_OF_HEAD_ENTRY( pxList )            listGET_LIST_ITEM_OWNER( listGET_HEAD_ENTRY( pxList ) )
 
 /*
  * Check to see if a list item is within a list.  The list item maintains a
@@ -403,7 +566,11 @@ typedef struct xLIST
  * @param pxListItem The list item we want to know if is in the list.
  * @return pdTRUE if the list item is in the list, otherwise pdFALSE.
  */
-#define listIS_CONTAINED_WITHIN( pxList, pxListItem )    ( ( ( pxListItem )->pxContainer == ( pxList ) ) ? ( pdTRUE ) : ( pdFALSE ) )
+#if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    #define listIS_CONTAINED_WITHIN( pxList, pxListItem )    ( ( ( pxListItem )->usContainer == listLINK_FROM_POINTER( pxList ) ) ? ( pdTRUE ) : ( pdFALSE ) )
+#else
+    #define listIS_CONTAINED_WITHIN( pxList, pxListItem )    ( ( ( pxListItem )->pxContainer == ( pxList ) ) ? ( pdTRUE ) : ( pdFALSE ) )
+#endif
 
 /*
  * Return the list a list item is contained within (referenced from).
@@ -411,7 +578,11 @@ typedef struct xLIST
  * @param pxListItem The list item being queried.
  * @return A pointer to the List_t object that references the pxListItem
  */
-#define listLIST_ITEM_CONTAINER( pxListItem )            ( ( pxListItem )->pxContainer )
+#if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    #define listLIST_ITEM_CONTAINER( pxListItem )    ( ( List_t * ) listLINK_TO_POINTER( ( pxListItem )->usContainer ) )
+#else
+    #define listLIST_ITEM_CONTAINER( pxListItem )    ( ( pxListItem )->pxContainer )
+#endif
 
 /*
  * This provides a crude means of knowing if a list has been initialised, as
@@ -455,7 +626,7 @@ void vListInitialiseItem( ListItem_t * const pxItem ) PRIVILEGED_FUNCTION;
  * \ingroup LinkedList
  */
 void vListInsert( List_t * const pxList,
-                  ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+                  ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /*
  * Insert a list item into a list.  The item will be inserted in a position
@@ -477,7 +648,7 @@ void vListInsert( List_t * const pxList,
  * \ingroup LinkedList
  */
 void vListInsertEnd( List_t * const pxList,
-                     ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+                     ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /*
  * Remove an item from a list.  The list item has a pointer to the list that
@@ -492,7 +663,36 @@ void vListInsertEnd( List_t * const pxList,
  * \page uxListRemove uxListRemove
  * \ingroup LinkedList
  */
-UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
+UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+/*
+ * The insert and remove operations used on the kernel's hot paths - moving
+ * tasks between the ready, delayed, suspended and pending ready lists, and
+ * moving timers in and out of the active timer lists.  If
+ * configUSE_LIST_INLINE_OPERATIONS is 1 they expand to listINSERT_END() and
+ * listREMOVE_ITEM(), otherwise they call vListInsertEnd() and uxListRemove().
+ *
+ * listFAST_REMOVE_COUNT() also sets uxItemsRemaining to the number of items
+ * left in the list the item was removed from, as returned by uxListRemove().
+ *
+ * \page listFAST_INSERT_END listFAST_INSERT_END
+ * \ingroup LinkedList
+ */
+#if ( configUSE_LIST_INLINE_OPERATIONS == 1 )
+    #define listFAST_INSERT_END( pxList, pxNewListItem )    listINSERT_END( ( pxList ), ( pxNewListItem ) )
+    #define listFAST_REMOVE( pxItemToRemove )               listREMOVE_ITEM( ( pxItemToRemove ) )
+    #define listFAST_REMOVE_COUNT( pxItemToRemove, uxItemsRemaining )                \
+    {                                                                                \
+        List_t * const pxListRemovedFrom = listLIST_ITEM_CONTAINER( pxItemToRemove ); \
+                                                                                     \
+        listREMOVE_ITEM( ( pxItemToRemove ) );                                       \
+        ( uxItemsRemaining ) = pxListRemovedFrom->uxNumberOfItems;                   \
+    }
+#else
+    #define listFAST_INSERT_END( pxList, pxNewListItem )                 vListInsertEnd( ( pxList ), ( pxNewListItem ) )
+    #define listFAST_REMOVE( pxItemToRemove )                            ( void ) uxListRemove( ( pxItemToRemove ) )
+    #define listFAST_REMOVE_COUNT( pxItemToRemove, uxItemsRemaining )    ( uxItemsRemaining ) = uxListRemove( ( pxItemToRemove ) )
+#endif /* configUSE_LIST_INLINE_OPERATIONS */
 
 /* *INDENT-OFF* */
 #ifdef __cplusplus
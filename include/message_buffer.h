@@ -48,7 +48,8 @@
  * block time to 0.  Likewise, if there are to be multiple different readers
  * then the application writer must place each call to a reading API function
  * (such as xMessageBufferRead()) inside a critical section and set the receive
- * timeout to 0.
+ * timeout to 0.  Alternatively, a message buffer created using
+ * xMessageBufferCreateMultiProducer() can have multiple different writers.
  *
  * Message buffers hold variable length messages.  To enable that, when a
  * message is written to the message buffer an additional sizeof( size_t ) bytes
@@ -85,6 +86,12 @@
  */
 typedef StreamBufferHandle_t MessageBufferHandle_t;
 
+/**
+ * Type used to describe one of the fragments of a message passed to
+ * xMessageBufferSendV().
+ */
+typedef StreamBufferFragment_t MessageBufferFragment_t;
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -156,11 +163,11 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
  * \ingroup MessageBufferManagement
  */
 #define xMessageBufferCreate( xBufferSizeBytes ) \
-    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE, NULL, NULL )
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, sbTYPE_MESSAGE_BUFFER, NULL, NULL )
 
 #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
     #define xMessageBufferCreateWithCallback( xBufferSizeBytes, pxSendCompletedCallback, pxReceiveCompletedCallback ) \
-    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, pdTRUE, ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, sbTYPE_MESSAGE_BUFFER, ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
 /**
@@ -238,11 +245,172 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
  * \ingroup MessageBufferManagement
  */
 #define xMessageBufferCreateStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) \
-    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, pdTRUE, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), NULL, NULL )
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, sbTYPE_MESSAGE_BUFFER, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), NULL, NULL )
 
 #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
     #define xMessageBufferCreateStaticWithCallback( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer, pxSendCompletedCallback, pxReceiveCompletedCallback ) \
-    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, pdTRUE, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, sbTYPE_MESSAGE_BUFFER, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
+#endif
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * MessageBufferHandle_t xMessageBufferCreateWithLengthBytes( size_t xBufferSizeBytes,
+ *                                                            size_t xLengthBytes );
+ *
+ * MessageBufferHandle_t xMessageBufferCreateStaticWithLengthBytes( size_t xBufferSizeBytes,
+ *                                                                  size_t xLengthBytes,
+ *                                                                  uint8_t *pucMessageBufferStorageArea,
+ *                                                                  StaticMessageBuffer_t *pxStaticMessageBuffer );
+ * @endcode
+ *
+ * Versions of xMessageBufferCreate() and xMessageBufferCreateStatic() that
+ * choose how many bytes are used to store the length of each message in the
+ * message buffer being created, rather than always using
+ * sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) bytes.  A message buffer that only
+ * holds short messages can use a 1 byte length, so it holds more messages in
+ * the same amount of RAM, while a different message buffer in the same
+ * application uses a 4 byte length to hold long messages.
+ *
+ * @param xBufferSizeBytes The total number of bytes (not messages) the message
+ * buffer will be able to hold at any one time.
+ *
+ * @param xLengthBytes The number of bytes used to store the length of each
+ * message.  Must be 1, 2 or 4.  A message can be at most 255 bytes long if
+ * xLengthBytes is 1, and at most 65535 bytes long if xLengthBytes is 2.
+ *
+ * The remaining parameters and the return value are the same as those of
+ * xMessageBufferCreate() and xMessageBufferCreateStatic().
+ *
+ * Example use:
+ * @code{c}
+ * // Each 8 byte CAN frame only uses 9 bytes of the message buffer.
+ * MessageBufferHandle_t xCANMessageBuffer = xMessageBufferCreateWithLengthBytes( 9 * 32, 1 );
+ * @endcode
+ * \defgroup xMessageBufferCreateWithLengthBytes xMessageBufferCreateWithLengthBytes
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferCreateWithLengthBytes( xBufferSizeBytes, xLengthBytes ) \
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, sbTYPE_MESSAGE_BUFFER | sbTYPE_MESSAGE_LENGTH_BYTES( xLengthBytes ), NULL, NULL )
+
+#define xMessageBufferCreateStaticWithLengthBytes( xBufferSizeBytes, xLengthBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) \
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, sbTYPE_MESSAGE_BUFFER | sbTYPE_MESSAGE_LENGTH_BYTES( xLengthBytes ), ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), NULL, NULL )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * MessageBufferHandle_t xMessageBufferCreateMultiProducer( size_t xBufferSizeBytes );
+ *
+ * MessageBufferHandle_t xMessageBufferCreateMultiProducerStatic( size_t xBufferSizeBytes,
+ *                                                                uint8_t *pucMessageBufferStorageArea,
+ *                                                                StaticMessageBuffer_t *pxStaticMessageBuffer );
+ * @endcode
+ *
+ * Creates a message buffer that any number of tasks and interrupts can write
+ * to at the same time using xMessageBufferSend() and
+ * xMessageBufferSendFromISR(), without the writes having to be serialised by a
+ * mutex or critical section.  There must still only be one reader.
+ *
+ * Each writer atomically reserves space for its message, copies the message
+ * into the reserved space, then commits it.  Messages are received in the
+ * order their space was reserved, and the reader only sees a message once it
+ * and all the messages reserved before it have been committed.
+ *
+ * Differences from a message buffer created by xMessageBufferCreate():
+ *
+ * - Writers never block.  The xTicksToWait parameter of xMessageBufferSend()
+ *   is ignored and the send returns 0 if there is not enough space.
+ *
+ * - Zero length messages cannot be sent.
+ *
+ * - Received messages are zeroed before their space is freed, which adds a
+ *   memset() of each message to the receive.
+ *
+ * - The buffer must not be reset while a send is in progress.
+ *
+ * configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS must be set to 1 in
+ * FreeRTOSConfig.h for these functions to be available.  The parameters and
+ * return values are otherwise the same as those of xMessageBufferCreate() and
+ * xMessageBufferCreateStatic().
+ *
+ * \defgroup xMessageBufferCreateMultiProducer xMessageBufferCreateMultiProducer
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+    #define xMessageBufferCreateMultiProducer( xBufferSizeBytes ) \
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( size_t ) 0, sbTYPE_MULTI_PRODUCER_MESSAGE_BUFFER, NULL, NULL )
+
+    #define xMessageBufferCreateMultiProducerStatic( xBufferSizeBytes, pucMessageBufferStorageArea, pxStaticMessageBuffer ) \
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), 0, sbTYPE_MULTI_PRODUCER_MESSAGE_BUFFER, ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), NULL, NULL )
+#endif
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * MessageBufferHandle_t xMessageBufferCreateFixedSize( size_t xMaxMessages,
+ *                                                      size_t xMessageSize );
+ *
+ * MessageBufferHandle_t xMessageBufferCreateFixedSizeStatic( size_t xMaxMessages,
+ *                                                            size_t xMessageSize,
+ *                                                            uint8_t *pucMessageBufferStorageArea,
+ *                                                            StaticMessageBuffer_t *pxStaticMessageBuffer );
+ * @endcode
+ *
+ * Creates a message buffer that holds up to xMaxMessages messages that are
+ * all exactly xMessageSize bytes long, such as fixed size sample records.
+ * Because every message is the same size, no length is stored with each
+ * message, and the storage area is divided into whole message slots, so a
+ * message never wraps from the end of the storage area back to the start and
+ * is copied in and out with a single memcpy().
+ *
+ * Differences from a message buffer created by xMessageBufferCreate():
+ *
+ * - xMessageBufferSend() and xMessageBufferSendFromISR() return 0, without
+ *   writing anything, if xDataLengthBytes is not xMessageSize.
+ *
+ * - One slot of the storage area is always left empty to tell a full message
+ *   buffer from an empty one, so the storage area passed to
+ *   xMessageBufferCreateFixedSizeStatic() must be
+ *   ( xMaxMessages + 1 ) * xMessageSize bytes.
+ *
+ * - A message lifetime cannot be set with xMessageBufferSetMessageLifetime().
+ *
+ * xMessageSize is held in the buffer type passed to
+ * xStreamBufferGenericCreate(), so it must be less than 2^( N - 5 ) on a port
+ * whose BaseType_t is N bits wide.
+ *
+ * configUSE_FIXED_SIZE_MESSAGE_BUFFERS must be set to 1 in FreeRTOSConfig.h
+ * for these functions to be available.
+ *
+ * @param xMaxMessages The number of messages the message buffer can hold.
+ *
+ * @param xMessageSize The size of every message, in bytes.
+ *
+ * The remaining parameters and the return value are the same as those of
+ * xMessageBufferCreate() and xMessageBufferCreateStatic().
+ *
+ * Example use:
+ * @code{c}
+ * typedef struct { uint32_t ulTimestamp; int16_t sChannel[ 4 ]; } Sample_t;
+ *
+ * // Holds 64 samples in 64 * sizeof( Sample_t ) bytes, plus one spare slot.
+ * MessageBufferHandle_t xSamples = xMessageBufferCreateFixedSize( 64, sizeof( Sample_t ) );
+ * @endcode
+ * \defgroup xMessageBufferCreateFixedSize xMessageBufferCreateFixedSize
+ * \ingroup MessageBufferManagement
+ */
+#if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+    #define xMessageBufferCreateFixedSize( xMaxMessages, xMessageSize )                                                         \
+    xStreamBufferGenericCreate( ( ( xMaxMessages ) + ( size_t ) 1 ) * ( xMessageSize ), ( size_t ) 0,                           \
+                                sbTYPE_FIXED_SIZE_MESSAGE_BUFFER | sbTYPE_FIXED_MESSAGE_SIZE( xMessageSize ), NULL, NULL )
+
+    #define xMessageBufferCreateFixedSizeStatic( xMaxMessages, xMessageSize, pucMessageBufferStorageArea, pxStaticMessageBuffer ) \
+    xStreamBufferGenericCreateStatic( ( ( xMaxMessages ) + ( size_t ) 1 ) * ( xMessageSize ), 0,                                \
+                                      sbTYPE_FIXED_SIZE_MESSAGE_BUFFER | sbTYPE_FIXED_MESSAGE_SIZE( xMessageSize ),             \
+                                      ( pucMessageBufferStorageArea ), ( pxStaticMessageBuffer ), NULL, NULL )
 #endif
 
 /**
@@ -345,6 +513,48 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferSend( xMessageBuffer, pvTxData, xDataLengthBytes, xTicksToWait ) \
     xStreamBufferSend( ( xMessageBuffer ), ( pvTxData ), ( xDataLengthBytes ), ( xTicksToWait ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferSendV( MessageBufferHandle_t xMessageBuffer,
+ *                             const MessageBufferFragment_t *pxFragments,
+ *                             size_t xFragmentCount,
+ *                             TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Sends a single discrete message, made of the xFragmentCount fragments
+ * pointed to by pxFragments, to the message buffer.  The fragments are
+ * copied into the message buffer one after another, so a message that is
+ * assembled from separate buffers, such as a packet header, payload and
+ * trailer, does not first have to be copied into a staging buffer.  The
+ * message is stored with a single length, just as if it had been sent with
+ * xMessageBufferSend(), and a task waiting to receive from the message buffer
+ * is only notified once.
+ *
+ * The same single writer restrictions, and the same blocking behaviour, apply
+ * as for xMessageBufferSend().
+ *
+ * @param xMessageBuffer The handle of the message buffer to which a message is
+ * being sent.
+ *
+ * @param pxFragments A pointer to an array of fragments that together make up
+ * the message.  Fragments with a length of zero are skipped.
+ *
+ * @param xFragmentCount The number of fragments in the pxFragments array.
+ *
+ * @param xTicksToWait As for xMessageBufferSend().
+ *
+ * @return The length of the message written to the message buffer, which is
+ * the total length of all the fragments, or 0 if the message could not be
+ * written.
+ *
+ * \defgroup xMessageBufferSendV xMessageBufferSendV
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSendV( xMessageBuffer, pxFragments, xFragmentCount, xTicksToWait ) \
+    xStreamBufferSendV( ( xMessageBuffer ), ( pxFragments ), ( xFragmentCount ), ( xTicksToWait ) )
+
 /**
  * message_buffer.h
  *
@@ -641,6 +851,153 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveFromISR( xMessageBuffer, pvRxData, xBufferLengthBytes, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveFromISR( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * size_t xMessageBufferReceiveBatch( MessageBufferHandle_t xMessageBuffer,
+ *                                    void *pvRxData,
+ *                                    size_t xBufferLengthBytes,
+ *                                    size_t * const pxMessageLengths,
+ *                                    size_t xMaxMessages,
+ *                                    TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives as many complete messages as possible from a message buffer in a
+ * single call.  The messages are copied into pvRxData back to back, in the
+ * order they were sent, and the length of each is written to the
+ * pxMessageLengths array.  A task blocked waiting for space in the message
+ * buffer is notified once for the whole batch, rather than once per message as
+ * happens when xMessageBufferReceive() is called in a loop.
+ *
+ * The same single reader restriction described for xMessageBufferReceive()
+ * applies.  There is no interrupt safe version - use
+ * xMessageBufferReceiveFromISR() to read messages one at a time from an
+ * interrupt service routine (ISR).
+ *
+ * @param xMessageBuffer The handle of the message buffer from which messages
+ * are being received.
+ *
+ * @param pvRxData A pointer to the buffer into which the received messages are
+ * to be copied.
+ *
+ * @param xBufferLengthBytes The length of the buffer pointed to by the pvRxData
+ * parameter.  Messages stop being received when the next message will not fit
+ * in the remaining space, in which case that message is left in the message
+ * buffer.
+ *
+ * @param pxMessageLengths A pointer to an array that receives the length, in
+ * bytes, of each message copied into pvRxData.
+ *
+ * @param xMaxMessages The number of entries in the pxMessageLengths array,
+ * which is the maximum number of messages received by one call.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for a message, should the message buffer
+ * be empty.  Once at least one message is available all the messages that fit
+ * are received without further blocking.  Passing 0 means the function will
+ * return immediately.
+ *
+ * @return The number of messages copied into pvRxData, which is also the
+ * number of entries written to pxMessageLengths.
+ *
+ * Example use:
+ * @code{c}
+ * void vAFunction( MessageBuffer_t xMessageBuffer )
+ * {
+ * uint8_t ucRxData[ 256 ];
+ * size_t xLengths[ 32 ], xMessages, x, xOffset = 0;
+ *
+ *  // Receive every queued message that fits into ucRxData and xLengths.
+ *  xMessages = xMessageBufferReceiveBatch( xMessageBuffer,
+ *                                          ( void * ) ucRxData,
+ *                                          sizeof( ucRxData ),
+ *                                          xLengths,
+ *                                          sizeof( xLengths ) / sizeof( xLengths[ 0 ] ),
+ *                                          portMAX_DELAY );
+ *
+ *  for( x = 0; x < xMessages; x++ )
+ *  {
+ *      // Message x is xLengths[ x ] bytes long and starts at
+ *      // ucRxData[ xOffset ].  Process the message here....
+ *      xOffset += xLengths[ x ];
+ *  }
+ * }
+ * @endcode
+ * \defgroup xMessageBufferReceiveBatch xMessageBufferReceiveBatch
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferReceiveBatch( xMessageBuffer, pvRxData, xBufferLengthBytes, pxMessageLengths, xMaxMessages, xTicksToWait ) \
+    xStreamBufferReceiveBatch( ( xMessageBuffer ), ( pvRxData ), ( xBufferLengthBytes ), ( pxMessageLengths ), ( xMaxMessages ), ( xTicksToWait ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xMessageBufferSetMessageLifetime( MessageBufferHandle_t xMessageBuffer,
+ *                                              TickType_t xLifetime );
+ * @endcode
+ *
+ * Sets the number of ticks a message can be held in a message buffer before
+ * it is discarded unread, for data such as sensor readings that is worthless
+ * once it is stale.  Each message is stored with the tick count at which it
+ * was sent, which adds sizeof( TickType_t ) bytes to the space it uses.  The
+ * receive functions silently discard expired messages and return the oldest
+ * message that has not expired, and a writer that finds there is not enough
+ * space discards expired messages to make room rather than blocking or failing.
+ * Messages that have not expired are never discarded.
+ *
+ * A message that expires while it is being received may be discarded by a
+ * writer that is short of space before the read completes, in which case the
+ * receive function returns 0 as though no message was available.
+ *
+ * configUSE_MESSAGE_BUFFER_EXPIRY must be set to 1 in FreeRTOSConfig.h for
+ * xMessageBufferSetMessageLifetime() to be available.  The lifetime can only
+ * be changed while the message buffer is empty and no tasks are blocked on it,
+ * cannot be set on a multi producer message buffer, and is retained when the
+ * message buffer is reset.
+ *
+ * @param xMessageBuffer The handle of the message buffer being updated.
+ *
+ * @param xLifetime The number of ticks after which a message is discarded.
+ * Passing 0 stops messages expiring, and stops the time each message was sent
+ * being stored.
+ *
+ * @return pdPASS if the lifetime was set, otherwise pdFAIL.
+ *
+ * \defgroup xMessageBufferSetMessageLifetime xMessageBufferSetMessageLifetime
+ * \ingroup MessageBufferManagement
+ */
+#define xMessageBufferSetMessageLifetime( xMessageBuffer, xLifetime ) \
+    xStreamBufferSetMessageLifetime( ( xMessageBuffer ), ( xLifetime ) )
+
+/**
+ * message_buffer.h
+ *
+ * @code{c}
+ * UBaseType_t uxMessageBufferGetOverflowCount( MessageBufferHandle_t xMessageBuffer );
+ * @endcode
+ *
+ * Returns the number of messages xMessageBufferSendFromISR() has dropped
+ * because there was not enough space in the message buffer.  Messages are
+ * never partly written, so a message that does not fit is always dropped.
+ * The count can be read from any task or interrupt without a critical section,
+ * and wraps to zero on overflow.
+ *
+ * configUSE_OVERFLOW_POLICY must be set to 1 in FreeRTOSConfig.h for
+ * uxMessageBufferGetOverflowCount() to be available.
+ *
+ * @param xMessageBuffer The handle of the message buffer being queried.
+ *
+ * @return The number of messages dropped since the message buffer was created
+ * or last reset.
+ *
+ * \defgroup uxMessageBufferGetOverflowCount uxMessageBufferGetOverflowCount
+ * \ingroup MessageBufferManagement
+ */
+#define uxMessageBufferGetOverflowCount( xMessageBuffer ) \
+    uxStreamBufferGetOverflowCount( xMessageBuffer )
+
 /**
  * message_buffer.h
  *
@@ -847,6 +1204,14 @@ typedef StreamBufferHandle_t MessageBufferHandle_t;
 #define xMessageBufferReceiveCompletedFromISR( xMessageBuffer, pxHigherPriorityTaskWoken ) \
     xStreamBufferReceiveCompletedFromISR( ( xMessageBuffer ), ( pxHigherPriorityTaskWoken ) )
 
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configENABLE_ACCESS_CONTROL_LIST == 1 ) )
+
+/* Grant or revoke an unprivileged task's access to a message buffer, see
+ * vGrantAccessToKernelObject(). */
+    #define vGrantAccessToMessageBuffer( xTask, xMessageBuffer )     vGrantAccessToKernelObject( ( xTask ), ( xMessageBuffer ) )
+    #define vRevokeAccessToMessageBuffer( xTask, xMessageBuffer )    vRevokeAccessToKernelObject( ( xTask ), ( xMessageBuffer ) )
+#endif
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     } /* extern "C" */
@@ -54,6 +54,8 @@ TaskHandle_t MPU_xTaskCreateStatic( TaskFunction_t pxTaskCode,
                                     StaticTask_t * const pxTaskBuffer ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskDelete( TaskHandle_t xTaskToDelete ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskDelay( const TickType_t xTicksToDelay ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskDelayWithSlack( const TickType_t xTicksToDelay,
+                              const TickType_t xSlackInTicks ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
                                 const TickType_t xTimeIncrement ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskAbortDelay( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
@@ -65,17 +67,29 @@ void MPU_vTaskGetInfo( TaskHandle_t xTask,
                        eTaskState eState ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskPrioritySet( TaskHandle_t xTask,
                            UBaseType_t uxNewPriority ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskSetBudget( TaskHandle_t xTask,
+                         TickType_t xBudgetTicks,
+                         TickType_t xPeriodTicks ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskSuspend( TaskHandle_t xTaskToSuspend ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskResume( TaskHandle_t xTaskToResume ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskStartScheduler( void ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskSuspendAll( void ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskResumeAll( void ) FREERTOS_SYSTEM_CALL;
 TickType_t MPU_xTaskGetTickCount( void ) FREERTOS_SYSTEM_CALL;
+uint64_t MPU_ullTaskGetTickCount64( void ) FREERTOS_SYSTEM_CALL;
 UBaseType_t MPU_uxTaskGetNumberOfTasks( void ) FREERTOS_SYSTEM_CALL;
+UBaseType_t MPU_uxTaskGetNumberOfTasksInState( eTaskState eState ) FREERTOS_SYSTEM_CALL;
+UBaseType_t MPU_uxTaskGetNumberOfReadyTasksAtPriority( UBaseType_t uxPriority ) FREERTOS_SYSTEM_CALL;
 char * MPU_pcTaskGetName( TaskHandle_t xTaskToQuery ) FREERTOS_SYSTEM_CALL;
 TaskHandle_t MPU_xTaskGetHandle( const char * pcNameToQuery ) FREERTOS_SYSTEM_CALL;
 UBaseType_t MPU_uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
 configSTACK_DEPTH_TYPE MPU_uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xTaskGetHeapBytesAllocated( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskSetHeapQuota( TaskHandle_t xTask,
+                            size_t xQuota ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskGetISRWakeLatencyStats( TaskHandle_t xTask,
+                                      ISRWakeLatencyStats_t * pxStats ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskResetISRWakeLatencyStats( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskSetApplicationTaskTag( TaskHandle_t xTask,
                                      TaskHookFunction_t pxHookFunction ) FREERTOS_SYSTEM_CALL;
 TaskHookFunction_t MPU_xTaskGetApplicationTaskTag( TaskHandle_t xTask ) FREERTOS_SYSTEM_CALL;
@@ -92,6 +106,8 @@ UBaseType_t MPU_uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                       configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) FREERTOS_SYSTEM_CALL;
 configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleRunTimeCounter( void ) FREERTOS_SYSTEM_CALL;
 configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleRunTimePercent( void ) FREERTOS_SYSTEM_CALL;
+configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleWindowedRunTimeCounter( eRunTimeWindow eWindow ) FREERTOS_SYSTEM_CALL;
+configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleWindowedRunTimePercent( eRunTimeWindow eWindow ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskList( char * pcWriteBuffer ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskGetRunTimeStats( char * pcWriteBuffer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify,
@@ -99,11 +115,28 @@ BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify,
                                    uint32_t ulValue,
                                    eNotifyAction eAction,
                                    uint32_t * pulPreviousNotificationValue ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xTaskGenericNotifyGroup( TaskHandle_t const * pxTasksToNotify,
+                                        UBaseType_t uxNumberOfTasks,
+                                        UBaseType_t uxIndexToNotify,
+                                        uint32_t ulValue,
+                                        eNotifyAction eAction ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
                                        uint32_t ulBitsToClearOnEntry,
                                        uint32_t ulBitsToClearOnExit,
                                        uint32_t * pulNotificationValue,
                                        TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xTaskGenericNotifyWaitSpin( UBaseType_t uxIndexToWaitOn,
+                                           uint32_t ulBitsToClearOnEntry,
+                                           uint32_t ulBitsToClearOnExit,
+                                           uint32_t * pulNotificationValue,
+                                           UBaseType_t uxSpinCount,
+                                           TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xTaskNotifyWaitAny( UBaseType_t uxIndexMask,
+                                   uint32_t ulBitsToClearOnEntry,
+                                   uint32_t ulBitsToClearOnExit,
+                                   uint32_t * pulNotificationValue,
+                                   UBaseType_t * puxIndexNotified,
+                                   TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 uint32_t MPU_ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
                                       BaseType_t xClearCountOnExit,
                                       TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
@@ -112,6 +145,13 @@ BaseType_t MPU_xTaskGenericNotifyStateClear( TaskHandle_t xTask,
 uint32_t MPU_ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
                                             UBaseType_t uxIndexToClear,
                                             uint32_t ulBitsToClear ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xTaskGenericMailboxSend( TaskHandle_t xTaskToNotify,
+                                        UBaseType_t uxIndexToNotify,
+                                        void * pvMessage,
+                                        BaseType_t xOverwrite ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xTaskGenericMailboxReceive( UBaseType_t uxIndexToWaitOn,
+                                           void ** ppvMessage,
+                                           TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskIncrementTick( void ) FREERTOS_SYSTEM_CALL;
 TaskHandle_t MPU_xTaskGetCurrentTaskHandle( void ) FREERTOS_SYSTEM_CALL;
 void MPU_vTaskSetTimeOutState( TimeOut_t * const pxTimeOut ) FREERTOS_SYSTEM_CALL;
@@ -120,6 +160,14 @@ BaseType_t MPU_xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
 void MPU_vTaskMissedYield( void ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskGetSchedulerState( void ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xTaskWaitOnAddress( const volatile uint32_t * pulAddress,
+                                   uint32_t ulExpectedValue,
+                                   TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskWakeAddress( const volatile uint32_t * pulAddress,
+                           UBaseType_t uxTasksToWake ) FREERTOS_SYSTEM_CALL;
+void MPU_vTaskSetTimeSliceLength( UBaseType_t uxPriority,
+                                  TickType_t xTicks ) FREERTOS_SYSTEM_CALL;
+TickType_t MPU_xTaskGetTimeSliceLength( UBaseType_t uxPriority ) FREERTOS_SYSTEM_CALL;
 
 /* MPU versions of queue.h API functions. */
 BaseType_t MPU_xQueueGenericSend( QueueHandle_t xQueue,
@@ -134,12 +182,42 @@ BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
                            TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xQueueSemaphoreTake( QueueHandle_t xQueue,
                                     TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue,
+                                   const void * const pvItems,
+                                   UBaseType_t uxItemCount,
+                                   TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                      void * const pvBuffer,
+                                      UBaseType_t uxItemCount,
+                                      TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueAcquireSlot( QueueHandle_t xQueue,
+                                  void ** const ppvSlot,
+                                  TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueCommitSlot( QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueuePeekSlot( QueueHandle_t xQueue,
+                               void ** const ppvSlot,
+                               TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueReleaseSlot( QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueSetWaitOrder( QueueHandle_t xQueue,
+                                   BaseType_t xWaitOrder ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueSetOverflowPolicy( QueueHandle_t xQueue,
+                                        BaseType_t xPolicy ) FREERTOS_SYSTEM_CALL;
+#if ( configUSE_QUEUE_STATS == 1 )
+    void MPU_vQueueGetStats( QueueHandle_t xQueue,
+                             QueueStats_t * pxQueueStats ) FREERTOS_SYSTEM_CALL;
+    void MPU_vQueueResetStats( QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
+#endif
 UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
 UBaseType_t MPU_uxQueueSpacesAvailable( const QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
 void MPU_vQueueDelete( QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
 QueueHandle_t MPU_xQueueCreateMutex( const uint8_t ucQueueType ) FREERTOS_SYSTEM_CALL;
 QueueHandle_t MPU_xQueueCreateMutexStatic( const uint8_t ucQueueType,
                                            StaticQueue_t * pxStaticQueue ) FREERTOS_SYSTEM_CALL;
+QueueHandle_t MPU_xQueueCreateMutexWithCeiling( const uint8_t ucQueueType,
+                                                UBaseType_t uxCeilingPriority ) FREERTOS_SYSTEM_CALL;
+QueueHandle_t MPU_xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType,
+                                                      UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue ) FREERTOS_SYSTEM_CALL;
 QueueHandle_t MPU_xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                                  const UBaseType_t uxInitialCount ) FREERTOS_SYSTEM_CALL;
 QueueHandle_t MPU_xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
@@ -149,6 +227,13 @@ TaskHandle_t MPU_xQueueGetMutexHolder( QueueHandle_t xSemaphore ) FREERTOS_SYSTE
 BaseType_t MPU_xQueueTakeMutexRecursive( QueueHandle_t xMutex,
                                          TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xQueueGiveMutexRecursive( QueueHandle_t pxMutex ) FREERTOS_SYSTEM_CALL;
+QueueHandle_t MPU_xQueueCreateRWLock( void ) FREERTOS_SYSTEM_CALL;
+QueueHandle_t MPU_xQueueCreateRWLockStatic( StaticQueue_t * pxStaticQueue ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueTakeRWLock( QueueHandle_t xRWLock,
+                                 BaseType_t xWrite,
+                                 TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xQueueGiveRWLock( QueueHandle_t xRWLock,
+                                 BaseType_t xWrite ) FREERTOS_SYSTEM_CALL;
 void MPU_vQueueAddToRegistry( QueueHandle_t xQueue,
                               const char * pcName ) FREERTOS_SYSTEM_CALL;
 void MPU_vQueueUnregisterQueue( QueueHandle_t xQueue ) FREERTOS_SYSTEM_CALL;
@@ -168,6 +253,9 @@ BaseType_t MPU_xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
                                     QueueSetHandle_t xQueueSet ) FREERTOS_SYSTEM_CALL;
 QueueSetMemberHandle_t MPU_xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
                                                 const TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+QueueSetMemberHandle_t MPU_xQueueWaitForAny( QueueWaitRecord_t * const pxWaitRecords,
+                                             const UBaseType_t uxNumberOfRecords,
+                                             TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xQueueGenericReset( QueueHandle_t xQueue,
                                    BaseType_t xNewQueue ) FREERTOS_SYSTEM_CALL;
 void MPU_vQueueSetQueueNumber( QueueHandle_t xQueue,
@@ -200,6 +288,14 @@ const char * MPU_pcTimerGetName( TimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
 void MPU_vTimerSetReloadMode( TimerHandle_t xTimer,
                               const UBaseType_t uxAutoReload ) FREERTOS_SYSTEM_CALL;
 UBaseType_t MPU_uxTimerGetReloadMode( TimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
+void MPU_vTimerSetCallbackFromTick( TimerHandle_t xTimer,
+                                    const BaseType_t xCallbackFromTick ) FREERTOS_SYSTEM_CALL;
+void MPU_vTimerSetSlack( TimerHandle_t xTimer,
+                         const TickType_t xSlackInTicks ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xHRTimerStart( HRTimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xHRTimerStop( HRTimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xHRTimerIsTimerActive( HRTimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
+void * MPU_pvHRTimerGetTimerID( const HRTimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
 TickType_t MPU_xTimerGetPeriod( TimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
 TickType_t MPU_xTimerGetExpiryTime( TimerHandle_t xTimer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xTimerCreateTimerTask( void ) FREERTOS_SYSTEM_CALL;
@@ -225,6 +321,9 @@ EventBits_t MPU_xEventGroupSync( EventGroupHandle_t xEventGroup,
                                  const EventBits_t uxBitsToSet,
                                  const EventBits_t uxBitsToWaitFor,
                                  TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xEventGroupBarrierWait( EventGroupHandle_t xEventGroup,
+                                       const UBaseType_t uxParticipants,
+                                       TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 void MPU_vEventGroupDelete( EventGroupHandle_t xEventGroup ) FREERTOS_SYSTEM_CALL;
 UBaseType_t MPU_uxEventGroupGetNumber( void * xEventGroup ) FREERTOS_SYSTEM_CALL;
 
@@ -233,11 +332,32 @@ size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                               const void * pvTxData,
                               size_t xDataLengthBytes,
                               TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                               const StreamBufferFragment_t * pxFragments,
+                               size_t xFragmentCount,
+                               TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 size_t MPU_xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
                                  void * pvRxData,
                                  size_t xBufferLengthBytes,
                                  TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferReceiveBatch( StreamBufferHandle_t xStreamBuffer,
+                                      void * pvRxData,
+                                      size_t xBufferLengthBytes,
+                                      size_t * const pxMessageLengths,
+                                      size_t xMaxMessages,
+                                      TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+                              void * pvRxData,
+                              size_t xBufferLengthBytes ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferSkip( StreamBufferHandle_t xStreamBuffer,
+                              size_t xBytesToSkip ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferSplice( StreamBufferHandle_t xDestination,
+                                StreamBufferHandle_t xSource,
+                                size_t xMaxBytes,
+                                TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
 size_t MPU_xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xStreamBufferSetMessageLifetime( StreamBufferHandle_t xStreamBuffer,
+                                                TickType_t xLifetime ) FREERTOS_SYSTEM_CALL;
 void MPU_vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer ) FREERTOS_SYSTEM_CALL;
@@ -246,14 +366,31 @@ size_t MPU_xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer ) FR
 size_t MPU_xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) FREERTOS_SYSTEM_CALL;
 BaseType_t MPU_xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
                                              size_t xTriggerLevel ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xStreamBufferSetSendTriggerLevel( StreamBufferHandle_t xStreamBuffer,
+                                                 size_t xTriggerLevel ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                      uint8_t ** ppucData,
+                                      TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                         size_t xBytesWritten ) FREERTOS_SYSTEM_CALL;
+size_t MPU_xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                     uint8_t ** ppucData,
+                                     TickType_t xTicksToWait ) FREERTOS_SYSTEM_CALL;
+BaseType_t MPU_xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+                                         size_t xBytesRead ) FREERTOS_SYSTEM_CALL;
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+    void MPU_vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer,
+                                    StreamBufferStats_t * pxStreamBufferStats ) FREERTOS_SYSTEM_CALL;
+    void MPU_vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer ) FREERTOS_SYSTEM_CALL;
+#endif
 StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                      size_t xTriggerLevelBytes,
-                                                     BaseType_t xIsMessageBuffer,
+                                                     BaseType_t xStreamBufferType,
                                                      StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                                      StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) FREERTOS_SYSTEM_CALL;
 StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
                                                            size_t xTriggerLevelBytes,
-                                                           BaseType_t xIsMessageBuffer,
+                                                           BaseType_t xStreamBufferType,
                                                            uint8_t * const pucStreamBufferStorageArea,
                                                            StaticStreamBuffer_t * const pxStaticStreamBuffer,
                                                            StreamBufferCallbackFunction_t pxSendCompletedCallback,
@@ -0,0 +1,53 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Numbers of the system calls that the MPU wrappers make through the port's
+ * system call table when configUSE_MPU_SYSTEM_CALL_TABLE is 1.  Each number
+ * indexes the table of implementations in mpu_wrappers.c, so the two must be
+ * kept in step.
+ */
+
+#ifndef MPU_SYSCALL_NUMBERS_H
+#define MPU_SYSCALL_NUMBERS_H
+
+#define SYSTEM_CALL_xTaskGetTickCount           0
+#define SYSTEM_CALL_vTaskDelay                  1
+#define SYSTEM_CALL_xTaskDelayUntil             2
+#define SYSTEM_CALL_xQueueGenericSend           3
+#define SYSTEM_CALL_xQueueReceive               4
+#define SYSTEM_CALL_xQueuePeek                  5
+#define SYSTEM_CALL_xQueueSemaphoreTake         6
+#define SYSTEM_CALL_uxQueueMessagesWaiting      7
+#define SYSTEM_CALL_xEventGroupSetBits          8
+#define SYSTEM_CALL_xStreamBufferSend           9
+#define SYSTEM_CALL_xStreamBufferReceive        10
+
+#define NUM_SYSTEM_CALLS                        11
+
+#endif /* MPU_SYSCALL_NUMBERS_H */
@@ -51,22 +51,31 @@
         #define xTaskCreateStatic                      MPU_xTaskCreateStatic
         #define vTaskDelete                            MPU_vTaskDelete
         #define vTaskDelay                             MPU_vTaskDelay
+        #define vTaskDelayWithSlack                    MPU_vTaskDelayWithSlack
         #define xTaskDelayUntil                        MPU_xTaskDelayUntil
         #define xTaskAbortDelay                        MPU_xTaskAbortDelay
         #define uxTaskPriorityGet                      MPU_uxTaskPriorityGet
         #define eTaskGetState                          MPU_eTaskGetState
         #define vTaskGetInfo                           MPU_vTaskGetInfo
         #define vTaskPrioritySet                       MPU_vTaskPrioritySet
+        #define vTaskSetBudget                         MPU_vTaskSetBudget
         #define vTaskSuspend                           MPU_vTaskSuspend
         #define vTaskResume                            MPU_vTaskResume
         #define vTaskSuspendAll                        MPU_vTaskSuspendAll
         #define xTaskResumeAll                         MPU_xTaskResumeAll
         #define xTaskGetTickCount                      MPU_xTaskGetTickCount
+        #define ullTaskGetTickCount64                  MPU_ullTaskGetTickCount64
         #define uxTaskGetNumberOfTasks                 MPU_uxTaskGetNumberOfTasks
+        #define uxTaskGetNumberOfTasksInState          MPU_uxTaskGetNumberOfTasksInState
+        #define uxTaskGetNumberOfReadyTasksAtPriority  MPU_uxTaskGetNumberOfReadyTasksAtPriority
         #define pcTaskGetName                          MPU_pcTaskGetName
         #define xTaskGetHandle                         MPU_xTaskGetHandle
         #define uxTaskGetStackHighWaterMark            MPU_uxTaskGetStackHighWaterMark
         #define uxTaskGetStackHighWaterMark2           MPU_uxTaskGetStackHighWaterMark2
+        #define xTaskGetHeapBytesAllocated             MPU_xTaskGetHeapBytesAllocated
+        #define vTaskSetHeapQuota                      MPU_vTaskSetHeapQuota
+        #define vTaskGetISRWakeLatencyStats            MPU_vTaskGetISRWakeLatencyStats
+        #define vTaskResetISRWakeLatencyStats          MPU_vTaskResetISRWakeLatencyStats
         #define vTaskSetApplicationTaskTag             MPU_vTaskSetApplicationTaskTag
         #define xTaskGetApplicationTaskTag             MPU_xTaskGetApplicationTaskTag
         #define vTaskSetThreadLocalStoragePointer      MPU_vTaskSetThreadLocalStoragePointer
@@ -78,12 +87,23 @@
         #define vTaskGetRunTimeStats                   MPU_vTaskGetRunTimeStats
         #define ulTaskGetIdleRunTimeCounter            MPU_ulTaskGetIdleRunTimeCounter
         #define ulTaskGetIdleRunTimePercent            MPU_ulTaskGetIdleRunTimePercent
+        #define ulTaskGetIdleWindowedRunTimeCounter    MPU_ulTaskGetIdleWindowedRunTimeCounter
+        #define ulTaskGetIdleWindowedRunTimePercent    MPU_ulTaskGetIdleWindowedRunTimePercent
         #define xTaskGenericNotify                     MPU_xTaskGenericNotify
+        #define xTaskGenericNotifyGroup                MPU_xTaskGenericNotifyGroup
         #define xTaskGenericNotifyWait                 MPU_xTaskGenericNotifyWait
+        #define xTaskGenericNotifyWaitSpin             MPU_xTaskGenericNotifyWaitSpin
+        #define xTaskNotifyWaitAny                     MPU_xTaskNotifyWaitAny
         #define ulTaskGenericNotifyTake                MPU_ulTaskGenericNotifyTake
         #define xTaskGenericNotifyStateClear           MPU_xTaskGenericNotifyStateClear
         #define ulTaskGenericNotifyValueClear          MPU_ulTaskGenericNotifyValueClear
+        #define xTaskGenericMailboxSend                MPU_xTaskGenericMailboxSend
+        #define xTaskGenericMailboxReceive             MPU_xTaskGenericMailboxReceive
         #define xTaskCatchUpTicks                      MPU_xTaskCatchUpTicks
+        #define xTaskWaitOnAddress                     MPU_xTaskWaitOnAddress
+        #define vTaskWakeAddress                       MPU_vTaskWakeAddress
+        #define vTaskSetTimeSliceLength                MPU_vTaskSetTimeSliceLength
+        #define xTaskGetTimeSliceLength                MPU_xTaskGetTimeSliceLength
 
         #define xTaskGetCurrentTaskHandle              MPU_xTaskGetCurrentTaskHandle
         #define vTaskSetTimeOutState                   MPU_vTaskSetTimeOutState
@@ -95,22 +115,39 @@
         #define xQueueReceive                          MPU_xQueueReceive
         #define xQueuePeek                             MPU_xQueuePeek
         #define xQueueSemaphoreTake                    MPU_xQueueSemaphoreTake
+        #define xQueueSendMultiple                     MPU_xQueueSendMultiple
+        #define xQueueReceiveMultiple                  MPU_xQueueReceiveMultiple
+        #define xQueueAcquireSlot                      MPU_xQueueAcquireSlot
+        #define xQueueCommitSlot                       MPU_xQueueCommitSlot
+        #define xQueuePeekSlot                         MPU_xQueuePeekSlot
+        #define xQueueReleaseSlot                      MPU_xQueueReleaseSlot
+        #define xQueueSetWaitOrder                     MPU_xQueueSetWaitOrder
+        #define xQueueSetOverflowPolicy                MPU_xQueueSetOverflowPolicy
+        #define vQueueGetStats                         MPU_vQueueGetStats
+        #define vQueueResetStats                       MPU_vQueueResetStats
         #define uxQueueMessagesWaiting                 MPU_uxQueueMessagesWaiting
         #define uxQueueSpacesAvailable                 MPU_uxQueueSpacesAvailable
         #define vQueueDelete                           MPU_vQueueDelete
         #define xQueueCreateMutex                      MPU_xQueueCreateMutex
         #define xQueueCreateMutexStatic                MPU_xQueueCreateMutexStatic
+        #define xQueueCreateMutexWithCeiling           MPU_xQueueCreateMutexWithCeiling
+        #define xQueueCreateMutexWithCeilingStatic     MPU_xQueueCreateMutexWithCeilingStatic
         #define xQueueCreateCountingSemaphore          MPU_xQueueCreateCountingSemaphore
         #define xQueueCreateCountingSemaphoreStatic    MPU_xQueueCreateCountingSemaphoreStatic
         #define xQueueGetMutexHolder                   MPU_xQueueGetMutexHolder
         #define xQueueTakeMutexRecursive               MPU_xQueueTakeMutexRecursive
         #define xQueueGiveMutexRecursive               MPU_xQueueGiveMutexRecursive
+        #define xQueueCreateRWLock                     MPU_xQueueCreateRWLock
+        #define xQueueCreateRWLockStatic               MPU_xQueueCreateRWLockStatic
+        #define xQueueTakeRWLock                       MPU_xQueueTakeRWLock
+        #define xQueueGiveRWLock                       MPU_xQueueGiveRWLock
         #define xQueueGenericCreate                    MPU_xQueueGenericCreate
         #define xQueueGenericCreateStatic              MPU_xQueueGenericCreateStatic
         #define xQueueCreateSet                        MPU_xQueueCreateSet
         #define xQueueAddToSet                         MPU_xQueueAddToSet
         #define xQueueRemoveFromSet                    MPU_xQueueRemoveFromSet
         #define xQueueSelectFromSet                    MPU_xQueueSelectFromSet
+        #define xQueueWaitForAny                       MPU_xQueueWaitForAny
         #define xQueueGenericReset                     MPU_xQueueGenericReset
 
         #if ( configQUEUE_REGISTRY_SIZE > 0 )
@@ -127,6 +164,12 @@
         #define pcTimerGetName                         MPU_pcTimerGetName
         #define vTimerSetReloadMode                    MPU_vTimerSetReloadMode
         #define uxTimerGetReloadMode                   MPU_uxTimerGetReloadMode
+        #define vTimerSetCallbackFromTick              MPU_vTimerSetCallbackFromTick
+        #define vTimerSetSlack                         MPU_vTimerSetSlack
+        #define xHRTimerStart                          MPU_xHRTimerStart
+        #define xHRTimerStop                           MPU_xHRTimerStop
+        #define xHRTimerIsTimerActive                  MPU_xHRTimerIsTimerActive
+        #define pvHRTimerGetTimerID                    MPU_pvHRTimerGetTimerID
         #define xTimerGetPeriod                        MPU_xTimerGetPeriod
         #define xTimerGetExpiryTime                    MPU_xTimerGetExpiryTime
         #define xTimerGenericCommand                   MPU_xTimerGenericCommand
@@ -138,13 +181,20 @@
         #define xEventGroupClearBits                   MPU_xEventGroupClearBits
         #define xEventGroupSetBits                     MPU_xEventGroupSetBits
         #define xEventGroupSync                        MPU_xEventGroupSync
+        #define xEventGroupBarrierWait                 MPU_xEventGroupBarrierWait
         #define vEventGroupDelete                      MPU_vEventGroupDelete
 
 /* Map standard message/stream_buffer.h API functions to the MPU
  * equivalents. */
         #define xStreamBufferSend                      MPU_xStreamBufferSend
+        #define xStreamBufferSendV                     MPU_xStreamBufferSendV
         #define xStreamBufferReceive                   MPU_xStreamBufferReceive
+        #define xStreamBufferReceiveBatch              MPU_xStreamBufferReceiveBatch
+        #define xStreamBufferPeek                      MPU_xStreamBufferPeek
+        #define xStreamBufferSkip                      MPU_xStreamBufferSkip
+        #define xStreamBufferSplice                    MPU_xStreamBufferSplice
         #define xStreamBufferNextMessageLengthBytes    MPU_xStreamBufferNextMessageLengthBytes
+        #define xStreamBufferSetMessageLifetime        MPU_xStreamBufferSetMessageLifetime
         #define vStreamBufferDelete                    MPU_vStreamBufferDelete
         #define xStreamBufferIsFull                    MPU_xStreamBufferIsFull
         #define xStreamBufferIsEmpty                   MPU_xStreamBufferIsEmpty
@@ -152,6 +202,13 @@
         #define xStreamBufferSpacesAvailable           MPU_xStreamBufferSpacesAvailable
         #define xStreamBufferBytesAvailable            MPU_xStreamBufferBytesAvailable
         #define xStreamBufferSetTriggerLevel           MPU_xStreamBufferSetTriggerLevel
+        #define xStreamBufferSetSendTriggerLevel       MPU_xStreamBufferSetSendTriggerLevel
+        #define xStreamBufferAcquireWrite              MPU_xStreamBufferAcquireWrite
+        #define xStreamBufferCommitWrite               MPU_xStreamBufferCommitWrite
+        #define xStreamBufferAcquireRead               MPU_xStreamBufferAcquireRead
+        #define xStreamBufferReleaseRead               MPU_xStreamBufferReleaseRead
+        #define vStreamBufferGetStats                  MPU_vStreamBufferGetStats
+        #define vStreamBufferResetStats                MPU_vStreamBufferResetStats
         #define xStreamBufferGenericCreate             MPU_xStreamBufferGenericCreate
         #define xStreamBufferGenericCreateStatic       MPU_xStreamBufferGenericCreateStatic
 
@@ -0,0 +1,207 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The object registry links every queue, semaphore, mutex, stream buffer,
+ * message buffer, event group and software timer into one list from the time
+ * it is created to the time it is deleted, so a debugger, monitoring agent or
+ * run time statistics collector can find every kernel object without being
+ * told about each one.  Unlike the queue registry, objects do not have to be
+ * added by the application and there is no fixed limit on their number.
+ *
+ * Each object holds its own ObjectRegistryItem_t, so adding and removing an
+ * object takes constant time and uses no additional memory allocation.
+ * Objects are kept in the order in which they were created.
+ *
+ * configUSE_OBJECT_REGISTRY must be set to 1 in FreeRTOSConfig.h for this API
+ * to be available.
+ */
+
+#ifndef OBJECT_REGISTRY_H
+#define OBJECT_REGISTRY_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include object_registry.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The kinds of object held in the registry. */
+typedef enum
+{
+    eObjectQueue = 0,     /* A queue, including a priority queue. */
+    eObjectQueueSet,      /* A queue set. */
+    eObjectSemaphore,     /* A binary or counting semaphore. */
+    eObjectMutex,         /* A mutex, recursive mutex or reader/writer lock. */
+    eObjectStreamBuffer,  /* A stream buffer. */
+    eObjectMessageBuffer, /* A message buffer. */
+    eObjectEventGroup,    /* An event group. */
+    eObjectTimer,         /* A software timer. */
+    eObjectNumberOfTypes  /* Not a type - the number of types above. */
+} eObjectType;
+
+/*
+ * Used internally only.  Links an object into the registry.  The item is a
+ * member of the object's own structure, so StaticObjectRegistryItem_t in
+ * FreeRTOS.h must be kept the same size.
+ */
+typedef struct xOBJECT_REGISTRY_ITEM
+{
+    struct xOBJECT_REGISTRY_ITEM * pxNext;     /*< The next object in creation order. */
+    struct xOBJECT_REGISTRY_ITEM * pxPrevious; /*< The previous object in creation order. */
+    void * pvObject;                           /*< The object's handle. */
+    const char * pcName;                       /*< The object's name, or NULL. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    UBaseType_t uxObjectNumber;                /*< Increases with every object registered, so gives the order of the objects in the registry. */
+    UBaseType_t uxType;                        /*< The object's eObjectType. */
+} ObjectRegistryItem_t;
+
+/*
+ * Used with vObjectIteratorInit() and xObjectIteratorNext().  The members are
+ * used by the kernel to track the position of the iterator.
+ */
+typedef struct xOBJECT_ITERATOR
+{
+    void * pvNextItem;
+    UBaseType_t uxLastObjectNumber;
+    UBaseType_t uxGeneration;
+} ObjectIterator_t;
+
+/* The description of an object returned by xObjectIteratorNext(). */
+typedef struct xOBJECT_STATUS
+{
+    void * pvObject;            /* The object's handle, which can be cast to the handle type of eType. */
+    eObjectType eType;          /* The kind of object. */
+    const char * pcName;        /* The name of a timer, or of a queue, semaphore or mutex added to the queue registry, otherwise NULL. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    UBaseType_t uxObjectNumber; /* Unique to the object, and larger for objects created later. */
+} ObjectStatus_t;
+
+/**
+ * object_registry.h
+ * @code{c}
+ * void vObjectIteratorInit( ObjectIterator_t * pxIterator );
+ * BaseType_t xObjectIteratorNext( ObjectIterator_t * pxIterator, ObjectStatus_t * pxObjectStatus );
+ * @endcode
+ *
+ * Return the objects in the registry one at a time, in the order in which
+ * they were created.  Each call to xObjectIteratorNext() holds a critical
+ * section only long enough to copy one object's ObjectStatus_t, so the
+ * registry can be walked by a low priority task without disturbing the real
+ * time work.
+ *
+ * An object created during the iteration is returned if it is created before
+ * the iteration reaches the end, and an object deleted during the iteration
+ * is not returned once it has been deleted.  Finding the position again after
+ * an object has been created or deleted walks the registry from the start,
+ * but otherwise each step takes constant time.
+ *
+ * The handle returned in pxObjectStatus is only valid for as long as the
+ * object exists, so the application must make sure an object cannot be
+ * deleted while its handle is being used.
+ *
+ * @param pxIterator The iterator, which must be initialised by
+ * vObjectIteratorInit() before it is passed to xObjectIteratorNext().
+ *
+ * @param pxObjectStatus The structure into which the next object's
+ * description is written.
+ *
+ * @return pdTRUE if pxObjectStatus holds the next object, or pdFALSE if there
+ * are no more objects.
+ *
+ * Example usage:
+ * @code{c}
+ * void vReportQueues( void )
+ * {
+ * ObjectIterator_t xIterator;
+ * ObjectStatus_t xStatus;
+ *
+ *  vObjectIteratorInit( &xIterator );
+ *
+ *  while( xObjectIteratorNext( &xIterator, &xStatus ) != pdFALSE )
+ *  {
+ *      if( xStatus.eType == eObjectQueue )
+ *      {
+ *          vSendTelemetry( xStatus.pcName, uxQueueMessagesWaiting( ( QueueHandle_t ) xStatus.pvObject ) );
+ *      }
+ *  }
+ * }
+ * @endcode
+ *
+ * \defgroup xObjectIteratorNext xObjectIteratorNext
+ * \ingroup ObjectRegistry
+ */
+void vObjectIteratorInit( ObjectIterator_t * pxIterator ) PRIVILEGED_FUNCTION;
+BaseType_t xObjectIteratorNext( ObjectIterator_t * pxIterator,
+                                ObjectStatus_t * pxObjectStatus ) PRIVILEGED_FUNCTION;
+
+/**
+ * object_registry.h
+ * @code{c}
+ * UBaseType_t uxObjectRegistryGetCount( eObjectType eType );
+ * @endcode
+ *
+ * @param eType The kind of object to count, or eObjectNumberOfTypes to count
+ * every object in the registry.
+ *
+ * @return The number of objects of type eType that currently exist.
+ *
+ * \defgroup uxObjectRegistryGetCount uxObjectRegistryGetCount
+ * \ingroup ObjectRegistry
+ */
+UBaseType_t uxObjectRegistryGetCount( eObjectType eType ) PRIVILEGED_FUNCTION;
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY INTENDED
+ * FOR USE WHEN IMPLEMENTING A KERNEL OBJECT.
+ *
+ * Add the object pvObject, which holds pxItem, to the end of the registry.
+ */
+void vObjectRegistryAdd( ObjectRegistryItem_t * pxItem,
+                         void * pvObject,
+                         eObjectType eType,
+                         const char * pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY INTENDED
+ * FOR USE WHEN IMPLEMENTING A KERNEL OBJECT.
+ *
+ * Remove the object that holds pxItem from the registry.  Must be called
+ * before the object's memory is freed or reused.
+ */
+void vObjectRegistryRemove( ObjectRegistryItem_t * pxItem ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* OBJECT_REGISTRY_H */
@@ -81,6 +81,20 @@
     #define portHAS_STACK_OVERFLOW_CHECKING    0
 #endif
 
+/* Set to 1 by ports that program a hardware stack limit with the end of each
+ * task's stack, so that a stack overflow faults as it happens.  See
+ * configCHECK_FOR_STACK_OVERFLOW in stack_macros.h. */
+#ifndef portHAS_STACK_LIMIT_REGISTER
+    #define portHAS_STACK_LIMIT_REGISTER    0
+#endif
+
+/* Set by ports that can make a region of portSTACK_GUARD_SIZE bytes, aligned
+ * to its size, inaccessible with portSET_STACK_GUARD().  See
+ * configSTACK_POOL_GUARDS. */
+#ifndef portSTACK_GUARD_SIZE
+    #define portSTACK_GUARD_SIZE    0
+#endif
+
 #ifndef portARCH_NAME
     #define portARCH_NAME    NULL
 #endif
@@ -90,6 +104,148 @@
     #define configSTACK_ALLOCATION_FROM_SEPARATE_HEAP    0
 #endif
 
+/* Set configUSE_KERNEL_OBJECT_POOLS to 1 to take task control blocks, queues,
+ * software timers and event groups that are created dynamically from fixed size
+ * block pools rather than from the heap.  The number of blocks in each pool is
+ * set by the corresponding configXXX_POOL_LENGTH setting. */
+#ifndef configUSE_KERNEL_OBJECT_POOLS
+    #define configUSE_KERNEL_OBJECT_POOLS    0
+#endif
+
+#ifndef configTASK_POOL_LENGTH
+    #define configTASK_POOL_LENGTH    0
+#endif
+
+#ifndef configQUEUE_POOL_LENGTH
+    #define configQUEUE_POOL_LENGTH    0
+#endif
+
+/* The number of bytes of queue storage area held in each queue pool block.
+ * Queues (including semaphores, which have no storage area) whose storage area
+ * fits are created from the queue pool, larger queues are created from the
+ * heap. */
+#ifndef configQUEUE_POOL_STORAGE_SIZE
+    #define configQUEUE_POOL_STORAGE_SIZE    0
+#endif
+
+#ifndef configTIMER_POOL_LENGTH
+    #define configTIMER_POOL_LENGTH    0
+#endif
+
+#ifndef configEVENT_GROUP_POOL_LENGTH
+    #define configEVENT_GROUP_POOL_LENGTH    0
+#endif
+
+/* Set configOBJECT_POOL_HEAP_FALLBACK to 0 to make object creation fail,
+ * rather than use the heap, when the pool for the object is empty. */
+#ifndef configOBJECT_POOL_HEAP_FALLBACK
+    #define configOBJECT_POOL_HEAP_FALLBACK    1
+#endif
+
+/* Set configISR_POOL_LENGTH to a non-zero value to make pvPortMallocFromISR()
+ * and vPortFreeFromISR() available.  They allocate from a pool of
+ * configISR_POOL_LENGTH blocks, each configISR_POOL_BLOCK_SIZE bytes, that is
+ * separate from the heap. */
+#ifndef configISR_POOL_LENGTH
+    #define configISR_POOL_LENGTH    0
+#endif
+
+#ifndef configISR_POOL_BLOCK_SIZE
+    #define configISR_POOL_BLOCK_SIZE    0
+#endif
+
+#if ( ( configISR_POOL_LENGTH > 0 ) && ( configISR_POOL_BLOCK_SIZE == 0 ) )
+    #error configISR_POOL_BLOCK_SIZE must be set when configISR_POOL_LENGTH is not 0
+#endif
+
+/* Set configSTACK_POOL_LENGTH to a non-zero value to take the stacks of tasks
+ * that are created dynamically from a pool of configSTACK_POOL_LENGTH slots,
+ * each able to hold a stack of configSTACK_POOL_SLOT_SIZE bytes, rather than
+ * from the heap.  Stacks that are too large for a slot, and stacks needed while
+ * every slot is in use, come from the heap unless
+ * configSTACK_POOL_HEAP_FALLBACK is 0. */
+#ifndef configSTACK_POOL_LENGTH
+    #define configSTACK_POOL_LENGTH    0
+#endif
+
+#ifndef configSTACK_POOL_SLOT_SIZE
+    #define configSTACK_POOL_SLOT_SIZE    0
+#endif
+
+#ifndef configSTACK_POOL_HEAP_FALLBACK
+    #define configSTACK_POOL_HEAP_FALLBACK    1
+#endif
+
+/* On ports that set portSTACK_GUARD_SIZE, each stack pool slot sits next to a
+ * guard region that the port makes inaccessible while the task using the slot
+ * runs, so the task faults as soon as it overflows its stack.  Set
+ * configSTACK_POOL_GUARDS to 0 to leave the guard regions out.  Stacks from the
+ * heap, and the stacks of statically allocated tasks, are not guarded. */
+#ifndef configSTACK_POOL_GUARDS
+    #define configSTACK_POOL_GUARDS    1
+#endif
+
+#if ( ( configSTACK_POOL_LENGTH > 0 ) && ( configSTACK_POOL_GUARDS == 1 ) && ( portSTACK_GUARD_SIZE > 0 ) )
+    #define portSTACK_POOL_GUARD_SIZE    portSTACK_GUARD_SIZE
+#else
+    #define portSTACK_POOL_GUARD_SIZE    0
+#endif
+
+#if ( configSTACK_POOL_LENGTH > 0 )
+    #if ( configSTACK_POOL_SLOT_SIZE == 0 )
+        #error configSTACK_POOL_SLOT_SIZE must be set when configSTACK_POOL_LENGTH is not 0
+    #endif
+
+    #if ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
+        #error configSTACK_POOL_LENGTH cannot be used with configSTACK_ALLOCATION_FROM_SEPARATE_HEAP as both provide pvPortMallocStack()
+    #endif
+
+    #if ( ( portSTACK_POOL_GUARD_SIZE % portBYTE_ALIGNMENT ) != 0 )
+        #error portSTACK_GUARD_SIZE must be a multiple of portBYTE_ALIGNMENT
+    #endif
+#endif
+
+/* Set configUSE_HEAP_REGION_CAPS to 1 to add a capabilities member to
+ * HeapRegion_t, and to make pvPortMallocCaps() and xPortGetHeapRegionStats()
+ * available.  Only heap_5.c implements them. */
+#ifndef configUSE_HEAP_REGION_CAPS
+    #define configUSE_HEAP_REGION_CAPS    0
+#endif
+
+/* Set configSUPPORT_HEAP_REALLOC to 1 to make pvPortRealloc() available, and
+ * configSUPPORT_HEAP_ALIGNED_ALLOC to 1 to make pvPortMallocAligned()
+ * available.  Only heap_4.c and heap_5.c implement them. */
+#ifndef configSUPPORT_HEAP_REALLOC
+    #define configSUPPORT_HEAP_REALLOC    0
+#endif
+
+#ifndef configSUPPORT_HEAP_ALIGNED_ALLOC
+    #define configSUPPORT_HEAP_ALIGNED_ALLOC    0
+#endif
+
+/* Set configSUPPORT_HEAP_RELOCATABLE to 1 to make the relocatable allocation
+ * functions, such as xPortMallocRelocatable(), available.  Up to
+ * configHEAP_RELOCATABLE_HANDLES relocatable blocks can be allocated at once.
+ * Only heap_4.c implements them. */
+#ifndef configSUPPORT_HEAP_RELOCATABLE
+    #define configSUPPORT_HEAP_RELOCATABLE    0
+#endif
+
+#ifndef configHEAP_RELOCATABLE_HANDLES
+    #define configHEAP_RELOCATABLE_HANDLES    16
+#endif
+
+/* Set configUSE_HEAP_INSTRUMENTATION to 1 to have heap_2.c, heap_4.c and
+ * heap_5.c record the histograms returned by vPortGetHeapInstrumentation(),
+ * each of which has configHEAP_INSTRUMENTATION_BUCKETS buckets. */
+#ifndef configUSE_HEAP_INSTRUMENTATION
+    #define configUSE_HEAP_INSTRUMENTATION    0
+#endif
+
+#ifndef configHEAP_INSTRUMENTATION_BUCKETS
+    #define configHEAP_INSTRUMENTATION_BUCKETS    16
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     extern "C" {
@@ -136,8 +292,17 @@ typedef struct HeapRegion
 {
     uint8_t * pucStartAddress;
     size_t xSizeInBytes;
+    #if ( configUSE_HEAP_REGION_CAPS == 1 )
+        uint32_t ulCaps; /* A bitwise OR of portHEAP_CAP_XXX values describing the memory in the region. */
+    #endif
 } HeapRegion_t;
 
+/* Capabilities that can be given to a heap region.  Bits not used here are
+ * free for the application to give its own meaning. */
+#define portHEAP_CAP_FAST        ( ( uint32_t ) 0x01U ) /* Tightly coupled or otherwise zero wait state memory. */
+#define portHEAP_CAP_DMA         ( ( uint32_t ) 0x02U ) /* Memory that DMA controllers can access. */
+#define portHEAP_CAP_EXTERNAL    ( ( uint32_t ) 0x04U ) /* Memory on an external bus, such as SDRAM. */
+
 /* Used to pass information about the heap out of vPortGetHeapStats(). */
 typedef struct xHeapStats
 {
@@ -150,6 +315,24 @@ typedef struct xHeapStats
     size_t xNumberOfSuccessfulFrees;        /* The number of calls to vPortFree() that has successfully freed a block of memory. */
 } HeapStats_t;
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* Used to pass information about the use of the heap out of
+ * vPortGetHeapInstrumentation().  Each array is a histogram in which bucket n
+ * counts the values from 2^n up to, but not including, 2^(n+1) - except that
+ * bucket 0 also counts zero and the last bucket also counts all larger
+ * values. */
+    typedef struct xHeapInstrumentation
+    {
+        size_t xAllocationSizes[ configHEAP_INSTRUMENTATION_BUCKETS ]; /* The sizes, in bytes, passed to pvPortMalloc(). */
+        size_t xFreeBlockSizes[ configHEAP_INSTRUMENTATION_BUCKETS ];  /* The sizes, in bytes, of the free blocks at the time vPortGetHeapInstrumentation() is called. */
+        size_t xMallocTimes[ configHEAP_INSTRUMENTATION_BUCKETS ];     /* The time pvPortMalloc() spent with the scheduler suspended, in run time stats counter ticks.  Only recorded if configGENERATE_RUN_TIME_STATS is 1. */
+        size_t xNumberOfFailedAllocations;                             /* The number of calls to pvPortMalloc() that returned NULL. */
+        size_t xLongestFreeListWalk;                                   /* The most free blocks pvPortMalloc() has stepped over in a single call. */
+    } HeapInstrumentation_t;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*
  * Used to define multiple heap regions for use by heap_5.c.  This function
  * must be called before any calls to pvPortMalloc() - not creating a task,
@@ -165,10 +348,73 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEG
 
 /*
  * Returns a HeapStats_t structure filled with information about the current
- * heap state.
+ * heap state.  heap_1.c reports the unallocated end of the heap as its only
+ * free block.  heap_3.c can only report the allocation and free counts, so
+ * reports 0 for the sizes of the C library's free space.
  */
 void vPortGetHeapStats( HeapStats_t * pxHeapStats );
 
+/*
+ * Calls pxFunction with the address and size of each free block in the heap,
+ * stopping early if pxFunction returns pdFALSE.  Nothing is locked, so the walk
+ * is only safe once nothing else can use the heap - it is used by the
+ * post-mortem snapshot, which is taken from fault handlers.  Only provided when
+ * configUSE_POST_MORTEM_SNAPSHOT is 1.  heap_1.c and heap_3.c have no free list
+ * of their own, so never call pxFunction.
+ */
+typedef BaseType_t ( * HeapFreeBlockFunction_t )( const void * pvBlock,
+                                                  size_t xBlockSize,
+                                                  void * pvContext );
+void vPortWalkFreeBlocks( HeapFreeBlockFunction_t pxFunction,
+                          void * pvContext ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/*
+ * Returns the histograms recorded since the system booted, or since
+ * vPortResetHeapInstrumentation() was last called, and a histogram of the
+ * current free block sizes.  The free list is walked with the scheduler
+ * suspended.  Each pvPortMalloc() call is also reported to the
+ * traceMALLOC_INSTRUMENTATION() trace macro as it is recorded.
+ */
+    void vPortGetHeapInstrumentation( HeapInstrumentation_t * pxHeapInstrumentation ) PRIVILEGED_FUNCTION;
+
+/*
+ * Clears the recorded histograms, the failed allocation count and the longest
+ * free list walk.
+ */
+    void vPortResetHeapInstrumentation( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+#if ( configUSE_HEAP_REGION_CAPS == 1 )
+
+/*
+ * Allocates xSize bytes from a heap region that has all the capabilities set
+ * in ulCaps, for example pvPortMallocCaps( xSize, portHEAP_CAP_FAST ) to place
+ * a buffer that is used on a hot path in tightly coupled memory.  Returns NULL
+ * if no region with the capabilities has a large enough free block, even if a
+ * region without them does.  An ulCaps value of 0 matches every region, so
+ * pvPortMalloc( xSize ) is equivalent to pvPortMallocCaps( xSize, 0 ).  The
+ * memory is returned with vPortFree().
+ *
+ * An application that defines configSTACK_ALLOCATION_FROM_SEPARATE_HEAP as 1
+ * can implement pvPortMallocStack() with pvPortMallocCaps() to place task
+ * stacks in a particular region.
+ */
+    void * pvPortMallocCaps( size_t xSize,
+                             uint32_t ulCaps ) PRIVILEGED_FUNCTION;
+
+/*
+ * As vPortGetHeapStats(), but only reports the free blocks in, and the
+ * allocations from, the heap region at index xRegion of the array passed to
+ * vPortDefineHeapRegions().  Returns pdFAIL if there is no such region.
+ */
+    BaseType_t xPortGetHeapRegionStats( BaseType_t xRegion,
+                                        HeapStats_t * pxHeapStats ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_REGION_CAPS */
+
 /*
  * Map to the memory management routines required for the port.
  */
@@ -180,7 +426,93 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
-#if ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
+#if ( configSUPPORT_HEAP_REALLOC == 1 )
+
+/*
+ * Changes the size of the block pv, which must have been returned by one of
+ * the heap allocation functions, to xSize bytes.  The block is shrunk in place,
+ * and grown in place if the block that follows it is free and large enough.
+ * Otherwise a new block is allocated, the contents copied, and pv freed.
+ * Returns NULL, leaving pv allocated, if the size cannot be met.  A NULL pv
+ * allocates a new block and an xSize of 0 frees pv.
+ */
+    void * pvPortRealloc( void * pv,
+                          size_t xSize ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configSUPPORT_HEAP_ALIGNED_ALLOC == 1 )
+
+/*
+ * Allocates xSize bytes starting on an xAlignment byte boundary, for example
+ * for a buffer that must occupy whole cache lines.  xAlignment must be a power
+ * of two.  The space skipped to reach the boundary remains free, and the block
+ * is freed with vPortFree() as usual.
+ */
+    void * pvPortMallocAligned( size_t xSize,
+                                size_t xAlignment ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configSUPPORT_HEAP_RELOCATABLE == 1 )
+
+/* Refers to a block allocated by xPortMallocRelocatable(). */
+    struct xHEAP_RELOCATABLE;
+    typedef struct xHEAP_RELOCATABLE * RelocatableHandle_t;
+
+/*
+ * Allocates xSize bytes that the heap is free to move while they are not
+ * locked, so long lived buffers and caches do not pin the free space around
+ * them.  Returns NULL if the heap has no room, or all
+ * configHEAP_RELOCATABLE_HANDLES handles are in use.  The memory is only
+ * accessed through the address returned by pvPortLockRelocatable(), which
+ * remains valid until the matching vPortUnlockRelocatable() call.  Locks
+ * nest.  The block is freed with vPortFreeRelocatable(), not vPortFree(), and
+ * must not be locked when it is freed.
+ */
+    RelocatableHandle_t xPortMallocRelocatable( size_t xSize ) PRIVILEGED_FUNCTION;
+    void vPortFreeRelocatable( RelocatableHandle_t xHandle ) PRIVILEGED_FUNCTION;
+    void * pvPortLockRelocatable( RelocatableHandle_t xHandle ) PRIVILEGED_FUNCTION;
+    void vPortUnlockRelocatable( RelocatableHandle_t xHandle ) PRIVILEGED_FUNCTION;
+
+/*
+ * Compacts the heap by moving unlocked relocatable blocks down into the free
+ * space below them, so the free space they separated is merged.  Stops once
+ * xMaxBytesToMove bytes have been moved - possibly more, as blocks are moved
+ * whole - so the heap can be compacted a little at a time, for example as idle
+ * work queued with xTaskQueueIdleWork().  Returns pdTRUE if it stopped early
+ * and there may be more to do.  pvPortMalloc() also compacts the whole heap
+ * before failing a request that there is enough free memory for.
+ */
+    BaseType_t xPortCompactHeap( size_t xMaxBytesToMove ) PRIVILEGED_FUNCTION;
+
+#endif /* configSUPPORT_HEAP_RELOCATABLE */
+
+#if ( configSTACK_POOL_LENGTH > 0 )
+
+/*
+ * Used by the kernel to allocate and free task stacks when the stack pool is
+ * in use.  A request is satisfied from a free slot if xSize fits within a
+ * slot, otherwise it is passed to pvPortMalloc() (unless
+ * configSTACK_POOL_HEAP_FALLBACK is 0).  vPortFreeStack() returns the memory
+ * to whichever of the pool or the heap it came from.
+ */
+    void * pvPortMallocStack( size_t xSize ) PRIVILEGED_FUNCTION;
+    void vPortFreeStack( void * pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of stack pool slots that are not currently in use.
+ */
+    UBaseType_t uxPortGetStackPoolFreeSlots( void ) PRIVILEGED_FUNCTION;
+
+    #if ( portSTACK_POOL_GUARD_SIZE > 0 )
+
+/*
+ * Returns the start of the guard region next to the stack that starts at
+ * pvStack, or NULL if the stack did not come from the stack pool.  Called on
+ * every context switch, so it does no more than a range check.
+ */
+        void * pvPortGetStackGuard( const void * pvStack ) PRIVILEGED_FUNCTION;
+    #endif
+#elif ( configSTACK_ALLOCATION_FROM_SEPARATE_HEAP == 1 )
     void * pvPortMallocStack( size_t xSize ) PRIVILEGED_FUNCTION;
     void vPortFreeStack( void * pv ) PRIVILEGED_FUNCTION;
 #else
@@ -188,6 +520,60 @@ size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
     #define vPortFreeStack       vPortFree
 #endif
 
+/* Identifies the pools used by pvPortMallocObject() and vPortFreeObject(). */
+#define portOBJECT_POOL_TASK           ( ( BaseType_t ) 0 )
+#define portOBJECT_POOL_QUEUE          ( ( BaseType_t ) 1 )
+#define portOBJECT_POOL_TIMER          ( ( BaseType_t ) 2 )
+#define portOBJECT_POOL_EVENT_GROUP    ( ( BaseType_t ) 3 )
+#define portOBJECT_POOL_COUNT          ( ( BaseType_t ) 4 )
+
+#if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+
+/*
+ * Used by the kernel to allocate and free the memory for dynamically created
+ * kernel objects.  xPool is one of the portOBJECT_POOL_XXX constants.  A
+ * request is satisfied from the pool in constant time if the pool has a free
+ * block and xSize fits within a block, otherwise it is passed to pvPortMalloc()
+ * (unless configOBJECT_POOL_HEAP_FALLBACK is 0).  vPortFreeObject() returns the
+ * memory to whichever of the pool or the heap it came from.
+ */
+    void * pvPortMallocObject( BaseType_t xPool,
+                               size_t xSize ) PRIVILEGED_FUNCTION;
+    void vPortFreeObject( BaseType_t xPool,
+                          void * pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of blocks in pool xPool that are not currently in use.
+ */
+    UBaseType_t uxPortGetObjectPoolFreeBlocks( BaseType_t xPool ) PRIVILEGED_FUNCTION;
+#else
+    #define pvPortMallocObject( xPool, xSize )    pvPortMalloc( xSize )
+    #define vPortFreeObject( xPool, pv )          vPortFree( pv )
+#endif
+
+#if ( configISR_POOL_LENGTH > 0 )
+
+/*
+ * Allocates and frees blocks of the interrupt safe pool.  Unlike
+ * pvPortMalloc() these functions can be called from interrupts as well as
+ * tasks - they neither suspend the scheduler nor enter a critical section, but
+ * claim and release blocks using atomic operations on a bitmap.
+ * pvPortMallocFromISR() returns NULL if xSize is larger than
+ * configISR_POOL_BLOCK_SIZE or every block is in use.  A block allocated by
+ * pvPortMallocFromISR() must be freed using vPortFreeFromISR(), which can also
+ * be called from a task - for example, once a task has finished with a buffer
+ * that an interrupt allocated and passed to it.
+ */
+    void * pvPortMallocFromISR( size_t xSize ) PRIVILEGED_FUNCTION;
+    void vPortFreeFromISR( void * pv ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of blocks in the interrupt safe pool that are not
+ * currently in use.
+ */
+    UBaseType_t uxPortGetISRPoolFreeBlocks( void ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
 
 /**
@@ -0,0 +1,200 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The post-mortem snapshot saves a compact binary description of the kernel's
+ * state, for analysis after a crash.  It is intended to be called from a hard
+ * fault or assert handler, so it takes no locks, allocates no memory, does not
+ * need the scheduler to be running, and writes nothing to kernel data - it only
+ * reads.  The snapshot is written either into a buffer, for example a region
+ * of RAM that is not initialised at reset, or through a function the
+ * application provides, for example one that programs it into flash.
+ *
+ * The snapshot holds, as one record each:
+ *  - the tick count, scheduler state and the task running on each core;
+ *  - every task's name, state, priorities, saved stack pointer, stack base and
+ *    the configPOST_MORTEM_STACK_WINDOW_WORDS stack words nearest its saved
+ *    stack pointer;
+ *  - the occupancy of each queue, semaphore and mutex in the queue registry;
+ *  - up to configPOST_MORTEM_MAX_FREE_BLOCKS blocks of the heap's free list;
+ *  - the configPOST_MORTEM_TRACE_RECORDS most recent trace recorder records
+ *    of each core, when configUSE_TRACE_RECORDER is 1;
+ *  - any data the caller passes in, such as the stacked exception frame.
+ *
+ * Every record starts with a one byte tag.  Integers are written as unsigned
+ * LEB128 variable length integers - seven bits per byte, least significant
+ * first, with the top bit set on all bytes but the last - so small values take
+ * one byte.  Heap block addresses are written as the difference from the
+ * previous block's address (the first from 0), zigzag encoded
+ * ( ( n << 1 ) ^ ( n >> 63 ) ) so small negative differences are small too.
+ * Trace record timestamps are written as the difference, modulo 2^32, from the
+ * previous record of the same core (the first from 0).  Names are a length
+ * followed by that many characters, without a terminator.
+ *
+ * Header:  'F' 'R' 'P' 'M', version (1), sizeof( StackType_t ).
+ * Records:
+ *  pmTAG_KERNEL:     tick count, number of tasks, scheduler state, top ready
+ *                    priority, number of cores, then the handle of the task
+ *                    running on each core.
+ *  pmTAG_TASK:       handle, name, state (an eTaskState value), running core
+ *                    + 1 (0 if not running), priority, base priority, saved
+ *                    stack pointer, stack base, window word count, then the
+ *                    window words from the lowest address up.
+ *  pmTAG_QUEUE:      handle, name, items waiting, length, item size, tasks
+ *                    waiting to send, tasks waiting to receive.
+ *  pmTAG_FREE_BLOCK: address difference, size in bytes.
+ *  pmTAG_HEAP_MORE:  no fields - the heap has more free blocks than were
+ *                    written.
+ *  pmTAG_TRACE:      core, timestamp difference, event ID, object, value,
+ *                    sequence - oldest record first.
+ *  pmTAG_USER:       length, then that many bytes passed by the caller.
+ *  pmTAG_END:        no fields, followed by the two byte Fletcher-16 checksum
+ *                    of every byte before it, least significant byte first.
+ *
+ * Tasks, queues and free blocks are read while the system may be corrupt, so
+ * every walk is bounded - but a snapshot taken while another core is still
+ * running can be inconsistent.  Stop the other cores first where possible.
+ *
+ * configUSE_POST_MORTEM_SNAPSHOT must be set to 1 in FreeRTOSConfig.h for this
+ * API to be available.
+ */
+
+#ifndef POST_MORTEM_H
+#define POST_MORTEM_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include post_mortem.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The snapshot format version, written after the header's magic bytes. */
+#define pmVERSION             ( ( uint8_t ) 1U )
+
+/* Record tags. */
+#define pmTAG_END             ( ( uint8_t ) 0U )
+#define pmTAG_KERNEL          ( ( uint8_t ) 1U )
+#define pmTAG_TASK            ( ( uint8_t ) 2U )
+#define pmTAG_QUEUE           ( ( uint8_t ) 3U )
+#define pmTAG_FREE_BLOCK      ( ( uint8_t ) 4U )
+#define pmTAG_HEAP_MORE       ( ( uint8_t ) 5U )
+#define pmTAG_TRACE           ( ( uint8_t ) 6U )
+#define pmTAG_USER            ( ( uint8_t ) 7U )
+
+/*
+ * The type of function used by xPostMortemCaptureToFunction() to write the
+ * snapshot.  It is called with consecutive pieces of the snapshot, of no more
+ * than 32 bytes each, in order.  It is called from the same context as
+ * xPostMortemCaptureToFunction(), so must not call FreeRTOS API functions.
+ */
+typedef void ( * PostMortemWriteFunction_t )( const uint8_t * pucData,
+                                              size_t xLength,
+                                              void * pvContext );
+
+/**
+ * post_mortem.h
+ *
+ * @code{c}
+ * size_t xPostMortemCapture( const void *pvUserData, size_t xUserDataLength, uint8_t *pucBuffer, size_t xBufferLength );
+ * @endcode
+ *
+ * Writes a snapshot of the kernel's state into a buffer.  Can be called from
+ * any context, including a fault handler, with the scheduler in any state.
+ *
+ * @param pvUserData Data to include in the snapshot as a pmTAG_USER record,
+ * for example the registers stacked by the fault.  Can be NULL.
+ *
+ * @param xUserDataLength The number of bytes at pvUserData.
+ *
+ * @param pucBuffer The buffer the snapshot is written into.
+ *
+ * @param xBufferLength The size of pucBuffer in bytes.
+ *
+ * @return The size of the whole snapshot in bytes.  If this is larger than
+ * xBufferLength then only the first xBufferLength bytes were written, and the
+ * snapshot has no pmTAG_END record.
+ *
+ * Example use:
+ * @code{c}
+ * // Not cleared at reset, so it survives until the next boot.
+ * __attribute__( ( section( ".noinit" ) ) ) static uint8_t ucCrashRecord[ 2048 ];
+ *
+ * void HardFault_Handler_C( uint32_t *pulStackedRegisters )
+ * {
+ *  ( void ) xPostMortemCapture( pulStackedRegisters, 8 * sizeof( uint32_t ), ucCrashRecord, sizeof( ucCrashRecord ) );
+ *  NVIC_SystemReset();
+ * }
+ * @endcode
+ * \defgroup xPostMortemCapture xPostMortemCapture
+ * \ingroup PostMortem
+ */
+size_t xPostMortemCapture( const void * pvUserData,
+                           size_t xUserDataLength,
+                           uint8_t * pucBuffer,
+                           size_t xBufferLength ) PRIVILEGED_FUNCTION;
+
+/**
+ * post_mortem.h
+ *
+ * @code{c}
+ * size_t xPostMortemCaptureToFunction( const void *pvUserData, size_t xUserDataLength, PostMortemWriteFunction_t pxWrite, void *pvContext );
+ * @endcode
+ *
+ * As xPostMortemCapture(), but passes the snapshot to pxWrite, for example to
+ * program it into flash, instead of writing it into a buffer.
+ *
+ * @param pvUserData Data to include in the snapshot as a pmTAG_USER record.
+ * Can be NULL.
+ *
+ * @param xUserDataLength The number of bytes at pvUserData.
+ *
+ * @param pxWrite The function the snapshot is passed to.
+ *
+ * @param pvContext Passed into pxWrite.
+ *
+ * @return The size of the snapshot in bytes.
+ *
+ * \defgroup xPostMortemCaptureToFunction xPostMortemCaptureToFunction
+ * \ingroup PostMortem
+ */
+size_t xPostMortemCaptureToFunction( const void * pvUserData,
+                                     size_t xUserDataLength,
+                                     PostMortemWriteFunction_t pxWrite,
+                                     void * pvContext ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* POST_MORTEM_H */
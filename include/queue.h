@@ -64,10 +64,31 @@ typedef struct QueueDefinition   * QueueSetHandle_t;
  */
 typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 
+/**
+ * Type passed to xQueueWaitForAny(), one for each queue or semaphore waited
+ * on.  Only xQueueOrSemaphore is set by the application.  xWaitRecord is used
+ * by the kernel while the calling task is blocked, so the records must remain
+ * in scope until xQueueWaitForAny() returns.
+ */
+typedef struct xQUEUE_WAIT_RECORD
+{
+    QueueSetMemberHandle_t xQueueOrSemaphore;
+    TaskWaitRecord_t xWaitRecord;
+} QueueWaitRecord_t;
+
+/**
+ * Type of the functions passed to vQueueSetItemCopyFunction(), which copy
+ * exactly one item of a queue from pvSource to pvDestination.
+ */
+typedef void (* QueueItemCopyFunction_t)( void * pvDestination,
+                                          const void * pvSource );
+
 /* For internal use only. */
-#define queueSEND_TO_BACK                     ( ( BaseType_t ) 0 )
-#define queueSEND_TO_FRONT                    ( ( BaseType_t ) 1 )
-#define queueOVERWRITE                        ( ( BaseType_t ) 2 )
+#define queueSEND_TO_BACK                         ( ( BaseType_t ) 0 )
+#define queueSEND_TO_FRONT                        ( ( BaseType_t ) 1 )
+#define queueOVERWRITE                            ( ( BaseType_t ) 2 )
+#define queueOVERWRITE_OLDEST                     ( ( BaseType_t ) 3 )
+#define queueSEND_WITH_PRIORITY( uxPriority )     ( ( BaseType_t ) 4 + ( BaseType_t ) ( uxPriority ) )
 
 /* For internal use only.  These definitions *must* match those in queue.c. */
 #define queueQUEUE_TYPE_BASE                  ( ( uint8_t ) 0U )
@@ -76,6 +97,10 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE    ( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE      ( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX       ( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_PRIORITY              ( ( uint8_t ) 5U )
+#define queueQUEUE_TYPE_SET_BITMAP            ( ( uint8_t ) 6U )
+#define queueQUEUE_TYPE_RW_LOCK               ( ( uint8_t ) 7U )
+#define queueQUEUE_TYPE_RENDEZVOUS            ( ( uint8_t ) 8U )
 
 /**
  * queue. h
@@ -235,6 +260,187 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
     #define xQueueCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_BASE ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriority(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize
+ *                        );
+ * @endcode
+ *
+ * Creates a new priority ordered queue and returns a handle by which the queue
+ * can be referenced.
+ *
+ * Items are written to a priority queue using xQueueSendWithPriority(), which
+ * tags each item with a message priority from 0 (the lowest) to
+ * ( configQUEUE_MESSAGE_PRIORITIES - 1 ) (the highest).  Receiving from or
+ * peeking a priority queue always returns the oldest item of the highest
+ * message priority present, so urgent messages are not held up behind a
+ * backlog of less urgent messages.  Both sending and receiving take constant
+ * time.  xQueueSend() and xQueueSendToBack() send at the lowest message
+ * priority, and xQueueSendToFront() places the item ahead of all others.
+ * Priority queues cannot be used with xQueueOverwrite() or the zero copy slot
+ * functions.
+ *
+ * configQUEUE_MESSAGE_PRIORITIES must be set to the number of message
+ * priorities in FreeRTOSConfig.h for xQueueCreatePriority() to be available.
+ * A priority queue can hold at most 254 items.
+ *
+ * @param uxQueueLength The maximum number of items that the queue can contain.
+ *
+ * @param uxItemSize The number of bytes each item in the queue will require.
+ * Must not be zero.
+ *
+ * @return If the queue is successfully created then a handle to the newly
+ * created queue is returned.  If the queue cannot be created then 0 is
+ * returned.
+ *
+ * \defgroup xQueueCreatePriority xQueueCreatePriority
+ * \ingroup QueueManagement
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configQUEUE_MESSAGE_PRIORITIES > 0 ) )
+    #define xQueueCreatePriority( uxQueueLength, uxItemSize )    xQueueGenericCreate( ( uxQueueLength ), ( uxItemSize ), ( queueQUEUE_TYPE_PRIORITY ) )
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreatePriorityStatic(
+ *                            UBaseType_t uxQueueLength,
+ *                            UBaseType_t uxItemSize,
+ *                            uint8_t *pucQueueStorage,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a new priority ordered queue using statically allocated memory.  See
+ * xQueueCreatePriority() for a description of priority queues.
+ *
+ * @param pucQueueStorage Must point to a uint8_t array that is at least
+ * queuePRIORITY_QUEUE_STORAGE_SIZE( uxQueueLength, uxItemSize ) bytes long.
+ * As well as the items, the array holds the lists that order the items.
+ *
+ * Other parameters and return value are as for xQueueCreateStatic().
+ *
+ * \defgroup xQueueCreatePriorityStatic xQueueCreatePriorityStatic
+ * \ingroup QueueManagement
+ */
+#if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+    #define queuePRIORITY_QUEUE_STORAGE_SIZE( uxQueueLength, uxItemSize ) \
+    ( ( ( uxQueueLength ) * ( uxItemSize ) ) + ( uxQueueLength ) + ( 2U * ( configQUEUE_MESSAGE_PRIORITIES ) ) + 1U )
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        #define xQueueCreatePriorityStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxQueueBuffer )    xQueueGenericCreateStatic( ( uxQueueLength ), ( uxItemSize ), ( pucQueueStorage ), ( pxQueueBuffer ), ( queueQUEUE_TYPE_PRIORITY ) )
+    #endif
+#endif /* configQUEUE_MESSAGE_PRIORITIES */
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateRendezvous(
+ *                            UBaseType_t uxItemSize
+ *                        );
+ * @endcode
+ *
+ * Creates a new rendezvous channel and returns a handle by which the channel
+ * can be referenced.
+ *
+ * A rendezvous channel is a queue of length zero.  It has no storage, so an
+ * item is only sent when a task receives it: xQueueSend() blocks the sending
+ * task until a task calling xQueueReceive() copies the item straight out of
+ * the sender's buffer, and xQueueReceive() blocks the receiving task until a
+ * task sends to it.  Whichever task arrives second completes the transfer
+ * and unblocks the other, so a request is handed over, and the sender knows
+ * it has been taken, without a second queue or semaphore to acknowledge it.
+ * uxQueueMessagesWaiting() always returns 0.
+ *
+ * As interrupts cannot block, xQueueSendFromISR() and xQueueReceiveFromISR()
+ * always fail on a rendezvous channel.  A rendezvous channel can only be
+ * written with xQueueSend(), xQueueSendToBack() and xQueueSendToFront(), which
+ * are equivalent, and read with xQueueReceive().  It cannot be peeked,
+ * overwritten, used with the multiple item or zero copy slot functions, added
+ * to a queue set or passed to xQueueWaitForAny().
+ *
+ * configUSE_QUEUE_RENDEZVOUS must be set to 1 in FreeRTOSConfig.h for
+ * xQueueCreateRendezvous() to be available.
+ *
+ * @param uxItemSize The number of bytes each item passed through the channel
+ * will require.  Must not be zero.
+ *
+ * @return If the channel is successfully created then a handle to the newly
+ * created channel is returned.  If the channel cannot be created then 0 is
+ * returned.
+ *
+ * Example usage:
+ * @code{c}
+ * struct ARequest
+ * {
+ *  char ucCommand;
+ *  uint32_t ulArgument;
+ * };
+ *
+ * QueueHandle_t xRequests;
+ *
+ * void vClientTask( void *pvParameters )
+ * {
+ * struct ARequest xRequest = { 'R', 42 };
+ *
+ *  // Returns once the server task has taken the request.
+ *  xQueueSend( xRequests, &xRequest, portMAX_DELAY );
+ * }
+ *
+ * void vServerTask( void *pvParameters )
+ * {
+ * struct ARequest xRequest;
+ *
+ *  xRequests = xQueueCreateRendezvous( sizeof( struct ARequest ) );
+ *
+ *  for( ;; )
+ *  {
+ *      if( xQueueReceive( xRequests, &xRequest, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          // Serve the request.
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueCreateRendezvous xQueueCreateRendezvous
+ * \ingroup QueueManagement
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_QUEUE_RENDEZVOUS == 1 ) )
+    #define xQueueCreateRendezvous( uxItemSize )    xQueueGenericCreate( ( UBaseType_t ) 0U, ( uxItemSize ), ( queueQUEUE_TYPE_RENDEZVOUS ) )
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * QueueHandle_t xQueueCreateRendezvousStatic(
+ *                            UBaseType_t uxItemSize,
+ *                            StaticQueue_t *pxQueueBuffer
+ *                        );
+ * @endcode
+ *
+ * Creates a new rendezvous channel using statically allocated memory.  See
+ * xQueueCreateRendezvous() for a description of rendezvous channels.  No
+ * storage area is needed as the channel holds no items.
+ *
+ * @param uxItemSize The number of bytes each item passed through the channel
+ * will require.  Must not be zero.
+ *
+ * @param pxQueueBuffer Must point to a variable of type StaticQueue_t, which
+ * will be used to hold the channel's data structure.
+ *
+ * @return If the channel is created then a handle to the created channel is
+ * returned.  If pxQueueBuffer is NULL then NULL is returned.
+ *
+ * \defgroup xQueueCreateRendezvousStatic xQueueCreateRendezvousStatic
+ * \ingroup QueueManagement
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_QUEUE_RENDEZVOUS == 1 ) )
+    #define xQueueCreateRendezvousStatic( uxItemSize, pxQueueBuffer )    xQueueGenericCreateStatic( ( UBaseType_t ) 0U, ( uxItemSize ), NULL, ( pxQueueBuffer ), ( queueQUEUE_TYPE_RENDEZVOUS ) )
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -568,6 +774,62 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 #define xQueueOverwrite( xQueue, pvItemToQueue ) \
     xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE )
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueOverwriteOldest(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue
+ *                       );
+ * @endcode
+ *
+ * Post an item to the back of a queue of any length.  If the queue is already
+ * full then the oldest item in the queue is discarded to make room, so the
+ * queue always holds the most recently posted items.  The item is queued by
+ * copy, not by reference.  The oldest item is discarded in constant time,
+ * without a receive and an extra critical section.  Cannot be used with
+ * queues created by xQueueCreatePriority().
+ *
+ * This function must not be called from an interrupt service routine.
+ * See xQueueOverwriteOldestFromISR() for an alternative which may be used in
+ * an ISR.
+ *
+ * @param xQueue The handle of the queue to which the data is being sent.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @return xQueueOverwriteOldest() is a macro that calls xQueueGenericSend().
+ * pdPASS is the only value that can be returned because
+ * xQueueOverwriteOldest() will write to the queue even when the queue is
+ * already full.
+ *
+ * Example usage:
+ * @code{c}
+ * void vSampleTask( void *pvParameters )
+ * {
+ * QueueHandle_t xLatestSamples;
+ * uint16_t usSample;
+ *
+ *  // Holds the 16 most recent samples.
+ *  xLatestSamples = xQueueCreate( 16, sizeof( uint16_t ) );
+ *
+ *  for( ;; )
+ *  {
+ *      usSample = usReadSensor();
+ *
+ *      // Never blocks.  Once 16 samples are queued each new sample
+ *      // replaces the oldest.
+ *      xQueueOverwriteOldest( xLatestSamples, &usSample );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueOverwriteOldest xQueueOverwriteOldest
+ * \ingroup QueueManagement
+ */
+#define xQueueOverwriteOldest( xQueue, pvItemToQueue ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), 0, queueOVERWRITE_OLDEST )
+
 
 /**
  * queue. h
@@ -657,7 +919,7 @@ typedef struct QueueDefinition   * QueueSetMemberHandle_t;
 BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
                               const void * const pvItemToQueue,
                               TickType_t xTicksToWait,
-                              const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+                              const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /**
  * queue. h
@@ -883,7 +1145,141 @@ BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
  */
 BaseType_t xQueueReceive( QueueHandle_t xQueue,
                           void * const pvBuffer,
-                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+                          TickType_t xTicksToWait ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueAcquireSlot(
+ *                               QueueHandle_t xQueue,
+ *                               void ** const ppvSlot,
+ *                               TickType_t xTicksToWait
+ *                             );
+ * @endcode
+ *
+ * Obtain a pointer to the free slot at the back of a queue, so an item can be
+ * written straight into the queue storage instead of being copied in by
+ * xQueueSend().  The item is not in the queue, and cannot be received, until
+ * it is added by a call to xQueueCommitSlot().
+ *
+ * Only one slot can be acquired from a queue at a time.  While it is held any
+ * other attempt to send to the queue behaves as if the queue is full.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  This function must not be used in an interrupt
+ * service routine, or on a semaphore.
+ *
+ * @param xQueue The handle to the queue to acquire the slot from.
+ *
+ * @param ppvSlot Set to point to the slot, which is as many bytes as the size
+ * of the items the queue was created to hold.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for a slot to become free should the queue be full at the time of
+ * the call.
+ *
+ * @return pdPASS if a slot was acquired, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * void vSensorTask( void *pvParameters )
+ * {
+ * struct SensorFrame *pxFrame;
+ *
+ *  for( ;; )
+ *  {
+ *      if( xQueueAcquireSlot( xFrameQueue, ( void ** ) &pxFrame, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          // Fill the frame in place, then make it available to the reader.
+ *          vReadSensor( pxFrame );
+ *          xQueueCommitSlot( xFrameQueue );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xQueueAcquireSlot xQueueAcquireSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueAcquireSlot( QueueHandle_t xQueue,
+                              void ** const ppvSlot,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueCommitSlot( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Add the item written into the slot obtained from xQueueAcquireSlot() to the
+ * back of the queue.  Tasks waiting to receive from the queue, or the queue
+ * set the queue is a member of, are notified as they would be by
+ * xQueueSend().  The slot must not be accessed after this call.
+ *
+ * @param xQueue The handle to the queue the slot was acquired from.
+ *
+ * @return pdPASS if the item was added, or pdFAIL if no slot was held.
+ *
+ * \defgroup xQueueCommitSlot xQueueCommitSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueCommitSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueuePeekSlot(
+ *                            QueueHandle_t xQueue,
+ *                            void ** const ppvSlot,
+ *                            TickType_t xTicksToWait
+ *                          );
+ * @endcode
+ *
+ * Obtain a pointer to the item at the front of a queue, so it can be read in
+ * place instead of being copied out by xQueueReceive().  The item remains in
+ * the queue until xQueueReleaseSlot() is called.
+ *
+ * Only one item can be peeked this way at a time.  While it is held any other
+ * attempt to receive from the queue behaves as if the queue is empty, and any
+ * attempt to send to the front of or overwrite the queue behaves as if the
+ * queue is full.
+ *
+ * configUSE_QUEUE_ZERO_COPY must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  This function must not be used in an interrupt
+ * service routine, or on a semaphore.
+ *
+ * @param xQueue The handle to the queue to peek the item from.
+ *
+ * @param ppvSlot Set to point to the item in the queue storage.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item should the queue be empty at the time of the call.
+ *
+ * @return pdPASS if an item was obtained, otherwise errQUEUE_EMPTY.
+ *
+ * \defgroup xQueuePeekSlot xQueuePeekSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueuePeekSlot( QueueHandle_t xQueue,
+                           void ** const ppvSlot,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReleaseSlot( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Remove the item obtained from xQueuePeekSlot() from the queue, freeing its
+ * slot for new items.  The slot must not be accessed after this call.
+ *
+ * @param xQueue The handle to the queue the item was peeked from.
+ *
+ * @return pdPASS if the item was removed, or pdFAIL if no item was held.
+ *
+ * \defgroup xQueueReleaseSlot xQueueReleaseSlot
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReleaseSlot( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
 /**
  * queue. h
@@ -921,6 +1317,399 @@ UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue ) PRIVILEGED_FUNC
  */
 UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
+/* Orders in which the tasks blocked on a queue are woken, see
+ * xQueueSetWaitOrder(). */
+#define queueWAIT_ORDER_PRIORITY    ( ( BaseType_t ) 0 )
+#define queueWAIT_ORDER_FIFO        ( ( BaseType_t ) 1 )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSetWaitOrder( QueueHandle_t xQueue, BaseType_t xWaitOrder );
+ * @endcode
+ *
+ * Set the order in which tasks blocked sending to or receiving from a queue
+ * are woken.  By default the highest priority waiting task is woken first, and
+ * tasks of equal priority are woken in the order in which they blocked.  With
+ * queueWAIT_ORDER_FIFO tasks are woken strictly in the order in which they
+ * blocked, whatever their priorities, and blocking takes constant time instead
+ * of time proportional to the number of tasks already waiting.  That suits a
+ * job queue served by many workers of the same priority.
+ *
+ * Call xQueueSetWaitOrder() after creating the queue and before any task
+ * blocks on it.  It can be used with semaphores too, but a mutex can only use
+ * priority order, as priority inheritance relies on it.  The order does not
+ * apply to tasks waiting in xQueueWaitForAny().
+ *
+ * configUSE_QUEUE_WAIT_ORDER must be set to 1 in FreeRTOSConfig.h for
+ * xQueueSetWaitOrder() to be available.
+ *
+ * @param xQueue A handle to the queue or semaphore.
+ *
+ * @param xWaitOrder queueWAIT_ORDER_PRIORITY or queueWAIT_ORDER_FIFO.
+ *
+ * @return pdPASS if the order was set.  pdFAIL if a task is already blocked
+ * on the queue, or xQueue is a mutex and xWaitOrder is queueWAIT_ORDER_FIFO.
+ *
+ * \defgroup xQueueSetWaitOrder xQueueSetWaitOrder
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+    BaseType_t xQueueSetWaitOrder( QueueHandle_t xQueue,
+                                   BaseType_t xWaitOrder ) PRIVILEGED_FUNCTION;
+#endif
+
+/* What an interrupt that sends to the back of a full queue does with the item,
+ * see xQueueSetOverflowPolicy(). */
+#define queueOVERFLOW_DROP_NEWEST    ( ( BaseType_t ) 0 )
+#define queueOVERFLOW_DROP_OLDEST    ( ( BaseType_t ) 1 )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSetOverflowPolicy( QueueHandle_t xQueue, BaseType_t xPolicy );
+ * @endcode
+ *
+ * Set what xQueueSendFromISR() and xQueueSendToBackFromISR() do when they find
+ * the queue full.  By default, queueOVERFLOW_DROP_NEWEST, the item being sent
+ * is dropped and errQUEUE_FULL is returned.  With queueOVERFLOW_DROP_OLDEST the
+ * item at the front of the queue is dropped to make room, as if
+ * xQueueOverwriteOldestFromISR() had been called, and pdPASS is returned, so
+ * the queue always holds the most recent items.  Sends to the front of the
+ * queue and sends from tasks are not affected.
+ *
+ * Either way the item dropped is counted, see uxQueueGetOverflowCount(), so
+ * interrupt handlers do not need to keep their own count.
+ *
+ * configUSE_OVERFLOW_POLICY must be set to 1 in FreeRTOSConfig.h for
+ * xQueueSetOverflowPolicy() to be available.
+ *
+ * @param xQueue A handle to the queue.
+ *
+ * @param xPolicy queueOVERFLOW_DROP_NEWEST or queueOVERFLOW_DROP_OLDEST.
+ *
+ * @return pdPASS if the policy was set.  pdFAIL if xPolicy is
+ * queueOVERFLOW_DROP_OLDEST and xQueue is a priority queue or a rendezvous
+ * queue, which cannot drop their oldest item.
+ *
+ * \defgroup xQueueSetOverflowPolicy xQueueSetOverflowPolicy
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+    BaseType_t xQueueSetOverflowPolicy( QueueHandle_t xQueue,
+                                        BaseType_t xPolicy ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * UBaseType_t uxQueueGetOverflowCount( const QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Returns the number of items dropped because the queue was full - items an
+ * interrupt could not send, and items removed from the front of the queue to
+ * make room, whether because of the queueOVERFLOW_DROP_OLDEST policy or by
+ * xQueueOverwriteOldest() or xQueueOverwriteOldestFromISR().  The count is a
+ * single word so can be read from any task or interrupt without a critical
+ * section.  It wraps to zero on overflow, so take the difference of two
+ * readings to find the number dropped in between.
+ *
+ * configUSE_OVERFLOW_POLICY must be set to 1 in FreeRTOSConfig.h for
+ * uxQueueGetOverflowCount() to be available.
+ *
+ * @param xQueue A handle to the queue.
+ *
+ * @return The number of items dropped since the queue was created.
+ *
+ * \defgroup uxQueueGetOverflowCount uxQueueGetOverflowCount
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+    UBaseType_t uxQueueGetOverflowCount( const QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueSetItemCopyFunction( QueueHandle_t xQueue, QueueItemCopyFunction_t pxCopyItem );
+ * @endcode
+ *
+ * Give a queue a function that copies exactly one of its items, to be used
+ * in place of a copy of a variable number of bytes whenever an item is
+ * written to or read from the queue.  A function written for one item type
+ * copies a size known at compile time, so the compiler can reduce the copy of
+ * a small item to one or two loads and stores.  The function is normally
+ * generated by queueDEFINE_TYPED_QUEUE() rather than written by hand.
+ *
+ * Call vQueueSetItemCopyFunction() after creating the queue and before it is
+ * used.  Items larger than configQUEUE_ASYNC_COPY_BYTES, if that is set, are
+ * still copied by configQUEUE_ASYNC_COPY_START().
+ *
+ * configUSE_TYPED_QUEUES must be set to 1 in FreeRTOSConfig.h for
+ * vQueueSetItemCopyFunction() to be available.
+ *
+ * @param xQueue A handle to the queue.  Must not be a semaphore, mutex or
+ * queue set.
+ *
+ * @param pxCopyItem The function that copies one item from pvSource to
+ * pvDestination, or NULL to copy the number of bytes given when the queue was
+ * created.
+ *
+ * \defgroup vQueueSetItemCopyFunction vQueueSetItemCopyFunction
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_TYPED_QUEUES == 1 )
+    void vQueueSetItemCopyFunction( QueueHandle_t xQueue,
+                                    QueueItemCopyFunction_t pxCopyItem ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * queueDECLARE_TYPED_QUEUE( Name, Type );
+ *
+ * queueDEFINE_TYPED_QUEUE( Name, Type )
+ * @endcode
+ *
+ * Generate a set of queue functions for a queue that only holds items of
+ * type Type.  The functions take pointers to Type, so passing an item of the
+ * wrong type is a compile time error, and queues created by them copy items
+ * with a copy of sizeof( Type ) bytes that the compiler generates inline.
+ * The blocking, timeouts and wake ups are those of the underlying queue
+ * functions, which are called to do the work.
+ *
+ * queueDECLARE_TYPED_QUEUE() declares the functions, so is used, followed by
+ * a semicolon, in a header file.  queueDEFINE_TYPED_QUEUE() defines them, so
+ * is used at file scope, without a trailing semicolon, in exactly one source
+ * file, which must include string.h.  The functions are:
+ *
+ * @code{c}
+ * QueueHandle_t xNameCreate( UBaseType_t uxQueueLength );
+ * QueueHandle_t xNameCreateStatic( UBaseType_t uxQueueLength, Type * pxQueueStorage, StaticQueue_t * pxQueueBuffer );
+ * BaseType_t xNameSend( QueueHandle_t xQueue, const Type * pxItem, TickType_t xTicksToWait );
+ * BaseType_t xNameSendFromISR( QueueHandle_t xQueue, const Type * pxItem, BaseType_t * pxHigherPriorityTaskWoken );
+ * BaseType_t xNameReceive( QueueHandle_t xQueue, Type * pxItem, TickType_t xTicksToWait );
+ * BaseType_t xNameReceiveFromISR( QueueHandle_t xQueue, Type * pxItem, BaseType_t * pxHigherPriorityTaskWoken );
+ * BaseType_t xNamePeek( QueueHandle_t xQueue, Type * pxItem, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * which behave as xQueueCreate(), xQueueCreateStatic(), xQueueSendToBack(),
+ * xQueueSendToBackFromISR(), xQueueReceive(), xQueueReceiveFromISR() and
+ * xQueuePeek() respectively.  xNameCreate() is only defined if
+ * configSUPPORT_DYNAMIC_ALLOCATION is 1, and xNameCreateStatic() if
+ * configSUPPORT_STATIC_ALLOCATION is 1.  Queues created some other way can be
+ * used with the functions, but copy items byte by byte.
+ *
+ * configUSE_TYPED_QUEUES must be set to 1 in FreeRTOSConfig.h for the macros
+ * to be available.
+ *
+ * Example usage:
+ * @code{c}
+ * typedef struct
+ * {
+ *  uint16_t usChannel;
+ *  uint16_t usReading;
+ * } SensorReading_t;
+ *
+ * // In sensor.h.
+ * queueDECLARE_TYPED_QUEUE( SensorQueue, SensorReading_t );
+ *
+ * // In sensor.c.
+ * queueDEFINE_TYPED_QUEUE( SensorQueue, SensorReading_t )
+ *
+ * void vSensorTask( void * pvParameters )
+ * {
+ *  QueueHandle_t xQueue = xSensorQueueCreate( 10 );
+ *  SensorReading_t xReading;
+ *
+ *  for( ;; )
+ *  {
+ *      if( xSensorQueueReceive( xQueue, &xReading, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          // Process xReading - it was copied with a single 32-bit load and
+ *          // store.
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup queueDEFINE_TYPED_QUEUE queueDEFINE_TYPED_QUEUE
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_TYPED_QUEUES == 1 )
+    #define queueDECLARE_TYPED_QUEUE( Name, Type )                                    \
+        QueueHandle_t x##Name##Create( UBaseType_t uxQueueLength );                   \
+        QueueHandle_t x##Name##CreateStatic( UBaseType_t uxQueueLength,               \
+                                             Type * pxQueueStorage,                   \
+                                             StaticQueue_t * pxQueueBuffer );         \
+        BaseType_t x##Name##Send( QueueHandle_t xQueue,                               \
+                                  const Type * pxItem,                                \
+                                  TickType_t xTicksToWait );                          \
+        BaseType_t x##Name##SendFromISR( QueueHandle_t xQueue,                        \
+                                         const Type * pxItem,                         \
+                                         BaseType_t * pxHigherPriorityTaskWoken );    \
+        BaseType_t x##Name##Receive( QueueHandle_t xQueue,                            \
+                                     Type * pxItem,                                   \
+                                     TickType_t xTicksToWait );                       \
+        BaseType_t x##Name##ReceiveFromISR( QueueHandle_t xQueue,                     \
+                                            Type * pxItem,                            \
+                                            BaseType_t * pxHigherPriorityTaskWoken ); \
+        BaseType_t x##Name##Peek( QueueHandle_t xQueue,                               \
+                                  Type * pxItem,                                      \
+                                  TickType_t xTicksToWait )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        #define queueDEFINE_TYPED_QUEUE_CREATE( Name, Type )                          \
+            QueueHandle_t x##Name##Create( UBaseType_t uxQueueLength )                \
+            {                                                                         \
+                QueueHandle_t xQueue = xQueueCreate( uxQueueLength, sizeof( Type ) ); \
+                                                                                      \
+                if( xQueue != NULL )                                                  \
+                {                                                                     \
+                    vQueueSetItemCopyFunction( xQueue, prv##Name##CopyItem );         \
+                }                                                                     \
+                                                                                      \
+                return xQueue;                                                        \
+            }
+    #else
+        #define queueDEFINE_TYPED_QUEUE_CREATE( Name, Type )
+    #endif
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        #define queueDEFINE_TYPED_QUEUE_CREATE_STATIC( Name, Type )                                                                      \
+            QueueHandle_t x##Name##CreateStatic( UBaseType_t uxQueueLength,                                                              \
+                                                 Type * pxQueueStorage,                                                                  \
+                                                 StaticQueue_t * pxQueueBuffer )                                                         \
+            {                                                                                                                            \
+                QueueHandle_t xQueue = xQueueCreateStatic( uxQueueLength, sizeof( Type ), ( uint8_t * ) pxQueueStorage, pxQueueBuffer ); \
+                                                                                                                                         \
+                if( xQueue != NULL )                                                                                                     \
+                {                                                                                                                        \
+                    vQueueSetItemCopyFunction( xQueue, prv##Name##CopyItem );                                                            \
+                }                                                                                                                        \
+                                                                                                                                         \
+                return xQueue;                                                                                                           \
+            }
+    #else
+        #define queueDEFINE_TYPED_QUEUE_CREATE_STATIC( Name, Type )
+    #endif
+
+    #define queueDEFINE_TYPED_QUEUE( Name, Type )                                        \
+        static void prv##Name##CopyItem( void * pvDestination,                           \
+                                         const void * pvSource )                         \
+        {                                                                                \
+            ( void ) memcpy( pvDestination, pvSource, sizeof( Type ) );                  \
+        }                                                                                \
+        queueDEFINE_TYPED_QUEUE_CREATE( Name, Type )                                     \
+        queueDEFINE_TYPED_QUEUE_CREATE_STATIC( Name, Type )                              \
+        BaseType_t x##Name##Send( QueueHandle_t xQueue,                                  \
+                                  const Type * pxItem,                                   \
+                                  TickType_t xTicksToWait )                              \
+        {                                                                                \
+            return xQueueSendToBack( xQueue, pxItem, xTicksToWait );                     \
+        }                                                                                \
+        BaseType_t x##Name##SendFromISR( QueueHandle_t xQueue,                           \
+                                         const Type * pxItem,                            \
+                                         BaseType_t * pxHigherPriorityTaskWoken )        \
+        {                                                                                \
+            return xQueueSendToBackFromISR( xQueue, pxItem, pxHigherPriorityTaskWoken ); \
+        }                                                                                \
+        BaseType_t x##Name##Receive( QueueHandle_t xQueue,                               \
+                                     Type * pxItem,                                      \
+                                     TickType_t xTicksToWait )                           \
+        {                                                                                \
+            return xQueueReceive( xQueue, pxItem, xTicksToWait );                        \
+        }                                                                                \
+        BaseType_t x##Name##ReceiveFromISR( QueueHandle_t xQueue,                        \
+                                            Type * pxItem,                               \
+                                            BaseType_t * pxHigherPriorityTaskWoken )     \
+        {                                                                                \
+            return xQueueReceiveFromISR( xQueue, pxItem, pxHigherPriorityTaskWoken );    \
+        }                                                                                \
+        BaseType_t x##Name##Peek( QueueHandle_t xQueue,                                  \
+                                  Type * pxItem,                                         \
+                                  TickType_t xTicksToWait )                              \
+        {                                                                                \
+            return xQueuePeek( xQueue, pxItem, xTicksToWait );                           \
+        }
+#endif /* configUSE_TYPED_QUEUES */
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+/**
+ * Used with vQueueGetStats() to obtain the usage statistics of a queue or
+ * semaphore.  All times are in ticks.
+ */
+    typedef struct xQUEUE_STATS
+    {
+        UBaseType_t uxQueueNumber;              /* The number set by vQueueSetQueueNumber(), so the statistics can be matched to trace output.  Always 0 if configUSE_TRACE_FACILITY is not 1. */
+        UBaseType_t uxLength;                   /* The number of items the queue can hold. */
+        UBaseType_t uxMessagesWaiting;          /* The number of items in the queue now. */
+        UBaseType_t uxMessagesWaitingHighWater; /* The most items the queue has held.  A queue that never comes close to uxLength can be made shorter. */
+        uint32_t ulItemsSent;                   /* The number of items written to the queue, or semaphore gives. */
+        uint32_t ulItemsReceived;               /* The number of items read from the queue, or semaphore takes. */
+        uint32_t ulSendsFailed;                 /* The number of writes that failed because the queue was full. */
+        TickType_t xSendBlockedTicks;           /* The total time writers have spent blocked waiting for space. */
+        TickType_t xReceiveBlockedTicks;        /* The total time readers have spent blocked waiting for items. */
+        uint32_t ulOccupancyTicks;              /* The number of items in the queue summed over every tick. */
+        TickType_t xAverageResidencyTicks;      /* ulOccupancyTicks divided by ulItemsReceived - the average time an item spent in the queue. */
+    } QueueStats_t;
+
+#endif /* configUSE_QUEUE_STATS */
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueGetStats( QueueHandle_t xQueue, QueueStats_t *pxQueueStats );
+ * @endcode
+ *
+ * Obtain the usage statistics of a queue, semaphore or mutex.  The statistics
+ * accumulate from when the queue was created, or from the last call to
+ * vQueueResetStats(), and are intended to help size queues: a queue whose
+ * high water mark never approaches its length wastes RAM, while one with
+ * send failures or a large send blocked time is too short or is not being
+ * read often enough.
+ *
+ * The counters are 32 bits and wrap.  The occupancy sum grows by the number
+ * of items in the queue every tick, so on a busy queue it should be reset
+ * periodically.  Residency is measured in whole ticks, so it is only accurate
+ * when averaged over many items.
+ *
+ * configUSE_QUEUE_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xQueue The handle of the queue being queried.
+ *
+ * @param pxQueueStats The structure into which the statistics are written.
+ *
+ * \defgroup vQueueGetStats vQueueGetStats
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    void vQueueGetStats( QueueHandle_t xQueue,
+                         QueueStats_t * pxQueueStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * queue. h
+ * @code{c}
+ * void vQueueResetStats( QueueHandle_t xQueue );
+ * @endcode
+ *
+ * Clear the statistics returned by vQueueGetStats().  The high water mark is
+ * set to the number of items in the queue at the time of the call.
+ *
+ * configUSE_QUEUE_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xQueue The handle of the queue whose statistics are cleared.
+ *
+ * \defgroup vQueueResetStats vQueueResetStats
+ * \ingroup QueueManagement
+ */
+#if ( configUSE_QUEUE_STATS == 1 )
+    void vQueueResetStats( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * queue. h
  * @code{c}
@@ -1080,6 +1869,93 @@ void vQueueDelete( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 #define xQueueSendToBackFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
     xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_TO_BACK )
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithPriority(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue,
+ *                            UBaseType_t uxPriority,
+ *                            TickType_t xTicksToWait
+ *                       );
+ * @endcode
+ *
+ * Post an item to a queue created by xQueueCreatePriority().  The item is
+ * received after any items of a higher message priority, and after any items
+ * of the same message priority that were posted before it.  The item is
+ * queued by copy, not by reference.  This function must not be called from an
+ * interrupt service routine.  See xQueueSendWithPriorityFromISR() for an
+ * alternative which may be used in an ISR.
+ *
+ * @param xQueue The handle to the priority queue on which the item is to be
+ * posted.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param uxPriority The message priority of the item, from 0 (the lowest) to
+ * ( configQUEUE_MESSAGE_PRIORITIES - 1 ) (the highest).
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space to become available on the queue, should it already
+ * be full.  The call will return immediately if this is set to 0 and the
+ * queue is full.
+ *
+ * @return pdTRUE if the item was successfully posted, otherwise errQUEUE_FULL.
+ *
+ * Example usage:
+ * @code{c}
+ * #define PRIORITY_TELEMETRY    0
+ * #define PRIORITY_CONTROL      3
+ *
+ * void vATask( void *pvParameters )
+ * {
+ * QueueHandle_t xQueue;
+ * uint32_t ulMessage;
+ *
+ *  xQueue = xQueueCreatePriority( 20, sizeof( uint32_t ) );
+ *
+ *  // ...
+ *
+ *  // The control message is received before any queued telemetry.
+ *  xQueueSendWithPriority( xQueue, &ulMessage, PRIORITY_TELEMETRY, 0 );
+ *  xQueueSendWithPriority( xQueue, &ulMessage, PRIORITY_CONTROL, portMAX_DELAY );
+ * }
+ * @endcode
+ * \defgroup xQueueSendWithPriority xQueueSendWithPriority
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithPriority( xQueue, pvItemToQueue, uxPriority, xTicksToWait ) \
+    xQueueGenericSend( ( xQueue ), ( pvItemToQueue ), ( xTicksToWait ), queueSEND_WITH_PRIORITY( uxPriority ) )
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendWithPriorityFromISR(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue,
+ *                            UBaseType_t uxPriority,
+ *                            BaseType_t *pxHigherPriorityTaskWoken
+ *                       );
+ * @endcode
+ *
+ * A version of xQueueSendWithPriority() that can be used in an interrupt
+ * service routine (ISR).
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendWithPriorityFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending to the queue caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xQueueSendWithPriorityFromISR() sets this value to pdTRUE
+ * then a context switch should be requested before the interrupt is exited.
+ *
+ * Other parameters and return value are as for xQueueSendWithPriority().
+ *
+ * \defgroup xQueueSendWithPriorityFromISR xQueueSendWithPriorityFromISR
+ * \ingroup QueueManagement
+ */
+#define xQueueSendWithPriorityFromISR( xQueue, pvItemToQueue, uxPriority, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueSEND_WITH_PRIORITY( uxPriority ) )
+
 /**
  * queue. h
  * @code{c}
@@ -1168,6 +2044,38 @@ void vQueueDelete( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 #define xQueueOverwriteFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
     xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueOVERWRITE )
 
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueOverwriteOldestFromISR(
+ *                            QueueHandle_t xQueue,
+ *                            const void * pvItemToQueue,
+ *                            BaseType_t *pxHigherPriorityTaskWoken
+ *                       );
+ * @endcode
+ *
+ * A version of xQueueOverwriteOldest() that can be used in an interrupt
+ * service routine (ISR).
+ *
+ * @param xQueue The handle of the queue to which the data is being sent.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueOverwriteOldestFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending to the queue caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xQueueOverwriteOldestFromISR() sets this value to pdTRUE
+ * then a context switch should be requested before the interrupt is exited.
+ *
+ * @return pdPASS is the only value that can be returned.
+ *
+ * \defgroup xQueueOverwriteOldestFromISR xQueueOverwriteOldestFromISR
+ * \ingroup QueueManagement
+ */
+#define xQueueOverwriteOldestFromISR( xQueue, pvItemToQueue, pxHigherPriorityTaskWoken ) \
+    xQueueGenericSendFromISR( ( xQueue ), ( pvItemToQueue ), ( pxHigherPriorityTaskWoken ), queueOVERWRITE_OLDEST )
+
 /**
  * queue. h
  * @code{c}
@@ -1323,9 +2231,12 @@ void vQueueDelete( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                                      const void * const pvItemToQueue,
                                      BaseType_t * const pxHigherPriorityTaskWoken,
-                                     const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+                                     const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
-                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+                              BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+BaseType_t xQueueGiveMultipleFromISR( QueueHandle_t xQueue,
+                                      UBaseType_t uxCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /**
  * queue. h
@@ -1416,7 +2327,182 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
                                  void * const pvBuffer,
-                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendMultiple(
+ *                                QueueHandle_t xQueue,
+ *                                const void * const pvItems,
+ *                                UBaseType_t uxItemCount,
+ *                                TickType_t xTicksToWait
+ *                              );
+ * @endcode
+ *
+ * Post up to uxItemCount items to the back of a queue in a single operation.
+ * This is more efficient than calling xQueueSend() once per item, as the
+ * queue is only accessed once and tasks waiting for data are only unblocked
+ * once.  The items are queued by copy.
+ *
+ * If there is space for fewer than uxItemCount items then as many items as
+ * fit are posted.  The calling task only blocks if there is no space for any
+ * items at all.
+ *
+ * This function must not be used in an interrupt service routine, or on a
+ * semaphore.  See xQueueSendMultipleFromISR() for an alternative which may be
+ * used in an ISR.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to an array of uxItemCount items, each the size of
+ * the items the queue was created to hold.
+ *
+ * @param uxItemCount The number of items in the pvItems array.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space should the queue be full at the time of the call.
+ *
+ * @return The number of items posted, or errQUEUE_FULL (0) if no items could
+ * be posted.
+ *
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItems,
+                               UBaseType_t uxItemCount,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueSendMultipleFromISR(
+ *                                       QueueHandle_t xQueue,
+ *                                       const void * const pvItems,
+ *                                       UBaseType_t uxItemCount,
+ *                                       BaseType_t *pxHigherPriorityTaskWoken
+ *                                     );
+ * @endcode
+ *
+ * A version of xQueueSendMultiple() that can be used in an interrupt service
+ * routine.  As many of the items as fit are posted, without blocking.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems A pointer to an array of uxItemCount items.
+ *
+ * @param uxItemCount The number of items in the pvItems array.
+ *
+ * @param pxHigherPriorityTaskWoken xQueueSendMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending to the queue caused a task
+ * to unblock, and the unblocked task has a priority higher than the currently
+ * running task.  If xQueueSendMultipleFromISR() sets this value to pdTRUE then
+ * a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted, or errQUEUE_FULL (0) if the queue was
+ * full.
+ *
+ * Example usage:
+ * @code{c}
+ * void vADCDMAHandler( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  // Post the whole block of samples in one go.
+ *  xQueueSendMultipleFromISR( xSampleQueue, usDMABuffer, 32, &xHigherPriorityTaskWoken );
+ *
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItems,
+                                      UBaseType_t uxItemCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMultiple(
+ *                                   QueueHandle_t xQueue,
+ *                                   void * const pvBuffer,
+ *                                   UBaseType_t uxItemCount,
+ *                                   TickType_t xTicksToWait
+ *                                 );
+ * @endcode
+ *
+ * Receive up to uxItemCount items from a queue in a single operation.  This
+ * is more efficient than calling xQueueReceive() once per item, as the queue
+ * is only accessed once and tasks waiting for space are only unblocked once.
+ *
+ * If fewer than uxItemCount items are available then all the available items
+ * are received.  The calling task only blocks if the queue is empty.
+ *
+ * This function must not be used in an interrupt service routine, or on a
+ * semaphore.  See xQueueReceiveMultipleFromISR() for an alternative which may
+ * be used in an ISR.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxItemCount items.
+ *
+ * @param uxItemCount The maximum number of items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item should the queue be empty at the time of the call.
+ *
+ * @return The number of items received, or errQUEUE_EMPTY (0) if no items
+ * were received.
+ *
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  UBaseType_t uxItemCount,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * @code{c}
+ * BaseType_t xQueueReceiveMultipleFromISR(
+ *                                          QueueHandle_t xQueue,
+ *                                          void * const pvBuffer,
+ *                                          UBaseType_t uxItemCount,
+ *                                          BaseType_t *pxHigherPriorityTaskWoken
+ *                                        );
+ * @endcode
+ *
+ * A version of xQueueReceiveMultiple() that can be used in an interrupt
+ * service routine.  As many of the items as are available are received,
+ * without blocking.
+ *
+ * @param xQueue The handle to the queue from which the items are to be
+ * received.
+ *
+ * @param pvBuffer Pointer to a buffer large enough to hold uxItemCount items.
+ *
+ * @param uxItemCount The maximum number of items to receive.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving from the queue
+ * caused a task waiting to post to the queue to unblock, and the unblocked
+ * task has a priority higher than the currently running task.
+ *
+ * @return The number of items received, or errQUEUE_EMPTY (0) if the queue
+ * was empty.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         UBaseType_t uxItemCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
@@ -1434,13 +2520,18 @@ UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue ) PRIVILEG
 QueueHandle_t xQueueCreateMutex( const uint8_t ucQueueType ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateMutexStatic( const uint8_t ucQueueType,
                                        StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType,
+                                            UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType,
+                                                  UBaseType_t uxCeilingPriority,
+                                                  StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
                                              const UBaseType_t uxInitialCount ) PRIVILEGED_FUNCTION;
 QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
                                                    const UBaseType_t uxInitialCount,
                                                    StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+                                TickType_t xTicksToWait ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 TaskHandle_t xQueueGetMutexHolderFromISR( QueueHandle_t xSemaphore ) PRIVILEGED_FUNCTION;
 
@@ -1452,6 +2543,19 @@ BaseType_t xQueueTakeMutexRecursive( QueueHandle_t xMutex,
                                      TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Use xSemaphoreCreateRWLock(), xSemaphoreTakeRead(),
+ * xSemaphoreTakeWrite(), xSemaphoreGiveRead() or xSemaphoreGiveWrite() instead
+ * of calling these functions directly.
+ */
+QueueHandle_t xQueueCreateRWLock( void ) PRIVILEGED_FUNCTION;
+QueueHandle_t xQueueCreateRWLockStatic( StaticQueue_t * pxStaticQueue ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueTakeRWLock( QueueHandle_t xRWLock,
+                             BaseType_t xWrite,
+                             TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueGiveRWLock( QueueHandle_t xRWLock,
+                             BaseType_t xWrite ) PRIVILEGED_FUNCTION;
+
 /*
  * Reset a queue back to its original empty state.  The return value is now
  * obsolete and is always set to pdPASS.
@@ -1518,6 +2622,35 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
     const char * pcQueueGetName( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 #endif
 
+/*
+ * Calls pxFunction once for each queue, semaphore and mutex in the queue
+ * registry, passing a QueueWalkInfo_t that describes it.  Nothing is locked,
+ * so this can be called from a fault handler - it is used by the post-mortem
+ * snapshot in post_mortem.c.  Only available when configUSE_POST_MORTEM_SNAPSHOT
+ * is 1 and configQUEUE_REGISTRY_SIZE is greater than 0.
+ *
+ * @param pxFunction The function called for each registered queue.
+ * @param pvContext Passed into pxFunction.
+ */
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_POST_MORTEM_SNAPSHOT == 1 ) )
+    typedef struct xQUEUE_WALK_INFO
+    {
+        QueueHandle_t xHandle;               /* The handle of the queue to which the rest of the information in the structure relates. */
+        const char * pcQueueName;            /* The name the queue was registered with. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        UBaseType_t uxMessagesWaiting;       /* The number of items in the queue, or the count of a semaphore. */
+        UBaseType_t uxLength;                /* The number of items the queue can hold. */
+        UBaseType_t uxItemSize;              /* The size of each item, which is 0 for semaphores and mutexes. */
+        UBaseType_t uxTasksWaitingToSend;    /* The number of tasks blocked waiting to send to the queue. */
+        UBaseType_t uxTasksWaitingToReceive; /* The number of tasks blocked waiting to receive from the queue. */
+    } QueueWalkInfo_t;
+
+    typedef void ( * QueueWalkFunction_t )( const QueueWalkInfo_t * pxInfo,
+                                            void * pvContext );
+
+    void vQueueWalkRegistry( QueueWalkFunction_t pxFunction,
+                             void * pvContext ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Generic version of the function used to create a queue using dynamic memory
  * allocation.  This is called by other functions and macros that create other
@@ -1571,6 +2704,14 @@ BaseType_t xQueueGiveMutexRecursive( QueueHandle_t xMutex ) PRIVILEGED_FUNCTION;
  * semaphore) operation must not be performed on a member of a queue set unless
  * a call to xQueueSelectFromSet() has first returned a handle to that set member.
  *
+ * Note 5:  If configUSE_QUEUE_SET_BITMAP is set to 1 in FreeRTOSConfig.h then
+ * queue sets do not store an event per item.  Instead a set records which of
+ * its members contain data in a bitmap, and xQueueSelectFromSet() returns each
+ * member that contains data in turn until that member is empty.  Posting to a
+ * member that already contains data does not touch the set at all.
+ * uxEventQueueLength is then the maximum number of members the set can hold,
+ * up to 254, and the additional RAM described in note 3 is not required.
+ *
  * @param uxEventQueueLength Queue sets store events that occur on
  * the queues and semaphores contained in the set.  uxEventQueueLength specifies
  * the maximum number of events that can be queued at once.  To be absolutely
@@ -1679,6 +2820,42 @@ QueueSetMemberHandle_t xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
  */
 QueueSetMemberHandle_t xQueueSelectFromSetFromISR( QueueSetHandle_t xQueueSet ) PRIVILEGED_FUNCTION;
 
+/*
+ * xQueueWaitForAny() waits for any one of several queues or semaphores to
+ * contain data (in the case of a queue) or be available to take (in the case
+ * of a semaphore).  Unlike a queue set, no storage is needed beyond the
+ * caller's array of records and nothing is posted to an intermediate queue
+ * when an object is written.  The calling task is placed on the event list of
+ * every object through its records, and the first object written unblocks it.
+ *
+ * configUSE_QUEUE_WAIT_FOR_ANY must be set to 1 in FreeRTOSConfig.h for
+ * xQueueWaitForAny() to be available.
+ *
+ * Note 1:  The objects must not be mutexes, and must not be members of a queue
+ * set, as writing to a queue set member does not unblock tasks waiting to
+ * read the member.
+ *
+ * Note 2:  xQueueWaitForAny() does not read from the object it returns.  The
+ * caller does that with a block time of 0, and must allow for the read to
+ * fail if another task or interrupt reads the object first.
+ *
+ * @param pxWaitRecords An array with one record for each object, each with
+ * its xQueueOrSemaphore member set.
+ *
+ * @param uxNumberOfRecords The number of records in pxWaitRecords.
+ *
+ * @param xTicksToWait The maximum time, in ticks, that the calling task will
+ * remain in the Blocked state to wait for one of the objects to become ready.
+ *
+ * @return The handle of an object that contains data or is available.  If
+ * the wait was ended by an object being written, that object is returned in
+ * preference to the others if it is still ready.  NULL is returned if no
+ * object became ready before the block time expired.
+ */
+QueueSetMemberHandle_t xQueueWaitForAny( QueueWaitRecord_t * const pxWaitRecords,
+                                         const UBaseType_t uxNumberOfRecords,
+                                         TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /* Not public API functions. */
 void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
                                      TickType_t xTicksToWait,
@@ -1689,8 +2866,17 @@ void vQueueSetQueueNumber( QueueHandle_t xQueue,
                            UBaseType_t uxQueueNumber ) PRIVILEGED_FUNCTION;
 UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 uint8_t ucQueueGetQueueType( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
 
 
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configENABLE_ACCESS_CONTROL_LIST == 1 ) )
+
+/* Grant or revoke an unprivileged task's access to a queue, see
+ * vGrantAccessToKernelObject(). */
+    #define vGrantAccessToQueue( xTask, xQueue )     vGrantAccessToKernelObject( ( xTask ), ( xQueue ) )
+    #define vRevokeAccessToQueue( xTask, xQueue )    vRevokeAccessToKernelObject( ( xTask ), ( xQueue ) )
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -639,6 +639,55 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define xSemaphoreGiveFromISR( xSemaphore, pxHigherPriorityTaskWoken )    xQueueGiveFromISR( ( QueueHandle_t ) ( xSemaphore ), ( pxHigherPriorityTaskWoken ) )
 
+/**
+ * semphr. h
+ * @code{c}
+ * xSemaphoreGiveMultipleFromISR(
+ *                                SemaphoreHandle_t xSemaphore,
+ *                                UBaseType_t uxCount,
+ *                                BaseType_t *pxHigherPriorityTaskWoken
+ *                            );
+ * @endcode
+ *
+ * <i>Macro</i> to release a counting semaphore uxCount times in one call, for
+ * example from an interrupt that reports several completed events at once.
+ * Up to uxCount tasks blocked on the semaphore are unblocked, highest
+ * priority first.  This is equivalent to, but faster than, calling
+ * xSemaphoreGiveFromISR() uxCount times.
+ *
+ * Mutex type semaphores must not be used with this macro.
+ *
+ * This macro can be used from an ISR.
+ *
+ * @param xSemaphore A handle to the semaphore being released.
+ *
+ * @param uxCount The number of times to give the semaphore.
+ *
+ * @param pxHigherPriorityTaskWoken xSemaphoreGiveMultipleFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if giving the semaphore caused a task
+ * with a priority higher than the currently running task to unblock.
+ *
+ * @return pdTRUE if the semaphore was given uxCount times.  errQUEUE_FULL if
+ * that would take the count above its maximum, in which case the semaphore is
+ * not given at all.
+ *
+ * Example usage:
+ * @code{c}
+ * void vDMAISR( void )
+ * {
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ * UBaseType_t uxCompleted = prvCountCompletedDescriptors();
+ *
+ *  xSemaphoreGiveMultipleFromISR( xDescriptorsDone, uxCompleted, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ * @endcode
+ * \defgroup xSemaphoreGiveMultipleFromISR xSemaphoreGiveMultipleFromISR
+ * \ingroup Semaphores
+ */
+#define xSemaphoreGiveMultipleFromISR( xSemaphore, uxCount, pxHigherPriorityTaskWoken ) \
+    xQueueGiveMultipleFromISR( ( QueueHandle_t ) ( xSemaphore ), ( uxCount ), ( pxHigherPriorityTaskWoken ) )
+
 /**
  * semphr. h
  * @code{c}
@@ -798,6 +847,88 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateMutexStatic( pxMutexBuffer )    xQueueCreateMutexStatic( queueQUEUE_TYPE_MUTEX, ( pxMutexBuffer ) )
 #endif
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeiling( UBaseType_t uxCeilingPriority );
+ * @endcode
+ *
+ * Creates a mutex that uses the immediate priority ceiling protocol, and
+ * returns a handle by which the new mutex can be referenced.
+ *
+ * configUSE_MUTEX_PRIORITY_CEILING must be set to 1 in FreeRTOSConfig.h for
+ * this macro to be available.
+ *
+ * A task that takes the mutex is raised to uxCeilingPriority straight away,
+ * rather than only when a higher priority task blocks on the mutex, so no task
+ * whose priority is at or below the ceiling can preempt the holder and then
+ * block on the mutex.  uxCeilingPriority should therefore be set to the
+ * priority of the highest priority task that takes the mutex.  The task
+ * returns to its base priority once it has given back all the mutexes it
+ * holds.
+ *
+ * Priority inheritance still applies should a task with a priority above the
+ * ceiling block on the mutex.
+ *
+ * Mutexes created using this function are accessed using the xSemaphoreTake()
+ * and xSemaphoreGive() macros.
+ *
+ * @param uxCeilingPriority The priority a task taking the mutex runs at while
+ * it holds the mutex.  Must be less than configMAX_PRIORITIES.  A ceiling of
+ * tskIDLE_PRIORITY creates an ordinary priority inheritance mutex.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If there was not enough heap to allocate the mutex data
+ * structures then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xSemaphore;
+ *
+ * void vATask( void * pvParameters )
+ * {
+ *  // The highest priority task that uses the mutex runs at priority 3.
+ *  xSemaphore = xSemaphoreCreateMutexWithCeiling( 3 );
+ *
+ *  if( xSemaphore != NULL )
+ *  {
+ *      // The mutex was created successfully.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateMutexWithCeiling xSemaphoreCreateMutexWithCeiling
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeiling( uxCeilingPriority )    xQueueCreateMutexWithCeiling( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateMutexWithCeilingStatic( UBaseType_t uxCeilingPriority,
+ *                                                          StaticSemaphore_t *pxMutexBuffer );
+ * @endcode
+ *
+ * As xSemaphoreCreateMutexWithCeiling(), but the memory used to hold the
+ * mutex is provided by the application writer.
+ *
+ * @param uxCeilingPriority The priority a task taking the mutex runs at while
+ * it holds the mutex.
+ *
+ * @param pxMutexBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will be used to hold the mutex's data structure.
+ *
+ * @return If the mutex was successfully created then a handle to the created
+ * mutex is returned.  If pxMutexBuffer was NULL then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateMutexWithCeilingStatic xSemaphoreCreateMutexWithCeilingStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) )
+    #define xSemaphoreCreateMutexWithCeilingStatic( uxCeilingPriority, pxMutexBuffer )    xQueueCreateMutexWithCeilingStatic( queueQUEUE_TYPE_MUTEX, ( uxCeilingPriority ), ( pxMutexBuffer ) )
+#endif
+
 
 /**
  * semphr. h
@@ -943,6 +1074,212 @@ typedef QueueHandle_t SemaphoreHandle_t;
     #define xSemaphoreCreateRecursiveMutexStatic( pxStaticSemaphore )    xQueueCreateMutexStatic( queueQUEUE_TYPE_RECURSIVE_MUTEX, ( pxStaticSemaphore ) )
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateRWLock( void );
+ * @endcode
+ *
+ * Creates a new reader writer lock, and returns a handle by which the new lock
+ * can be referenced.  Any number of reader tasks can hold a reader writer lock
+ * at the same time, but a writer task holds it exclusively.  This removes the
+ * contention a mutex would cause between tasks that only read the data the
+ * lock protects.
+ *
+ * Internally, within the FreeRTOS implementation, reader writer locks use a
+ * block of memory, in which the lock structure is stored.  If a lock is created
+ * using xSemaphoreCreateRWLock() then the required memory is automatically
+ * dynamically allocated inside the xSemaphoreCreateRWLock() function.  (see
+ * https://www.FreeRTOS.org/a00111.html).  If a lock is created using
+ * xSemaphoreCreateRWLockStatic() then the application writer must provide the
+ * memory that will get used by the lock.
+ *
+ * Locks created using this macro can be accessed using the
+ * xSemaphoreTakeRead(), xSemaphoreGiveRead(), xSemaphoreTakeWrite() and
+ * xSemaphoreGiveWrite() macros.  The xSemaphoreTake() and xSemaphoreGive()
+ * macros must not be used.
+ *
+ * Writers take preference over readers - a reader cannot take the lock while
+ * a writer is waiting for it, so a steady stream of readers cannot starve the
+ * writers.  As a consequence a task must not take the read lock recursively.
+ *
+ * A writer that holds the lock inherits the priority of any higher priority
+ * task that is waiting for the lock.  Readers that hold the lock do not
+ * inherit priorities.
+ *
+ * Reader writer locks cannot be used from within interrupt service routines.
+ *
+ * configUSE_RW_LOCKS must be set to 1 in FreeRTOSConfig.h for reader writer
+ * locks to be available.
+ *
+ * @return If the lock was successfully created then a handle to the created
+ * lock is returned.  If there was not enough heap to allocate the lock's data
+ * structures then NULL is returned.
+ *
+ * Example usage:
+ * @code{c}
+ * SemaphoreHandle_t xTableLock;
+ *
+ * void vReaderTask( void * pvParameters )
+ * {
+ *  for( ;; )
+ *  {
+ *      if( xSemaphoreTakeRead( xTableLock, portMAX_DELAY ) == pdTRUE )
+ *      {
+ *          // Other readers can access the table at the same time.
+ *          xSemaphoreGiveRead( xTableLock );
+ *      }
+ *  }
+ * }
+ *
+ * void vWriterTask( void * pvParameters )
+ * {
+ *  for( ;; )
+ *  {
+ *      if( xSemaphoreTakeWrite( xTableLock, portMAX_DELAY ) == pdTRUE )
+ *      {
+ *          // No other task can access the table.
+ *          xSemaphoreGiveWrite( xTableLock );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSemaphoreCreateRWLock xSemaphoreCreateRWLock
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_RW_LOCKS == 1 ) )
+    #define xSemaphoreCreateRWLock()    xQueueCreateRWLock()
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * SemaphoreHandle_t xSemaphoreCreateRWLockStatic( StaticSemaphore_t *pxLockBuffer );
+ * @endcode
+ *
+ * Creates a new reader writer lock using statically allocated memory.  See
+ * xSemaphoreCreateRWLock() for a description of reader writer locks.
+ *
+ * @param pxLockBuffer Must point to a variable of type StaticSemaphore_t,
+ * which will then be used to hold the lock's data structure, removing the need
+ * for the memory to be allocated dynamically.
+ *
+ * @return If the lock was successfully created then a handle to the created
+ * lock is returned.  If pxLockBuffer was NULL then NULL is returned.
+ *
+ * \defgroup xSemaphoreCreateRWLockStatic xSemaphoreCreateRWLockStatic
+ * \ingroup Semaphores
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_RW_LOCKS == 1 ) )
+    #define xSemaphoreCreateRWLockStatic( pxStaticSemaphore )    xQueueCreateRWLockStatic( ( pxStaticSemaphore ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * xSemaphoreTakeRead(
+ *                     SemaphoreHandle_t xRWLock,
+ *                     TickType_t xBlockTime
+ *                   );
+ * @endcode
+ *
+ * <i>Macro</i> to take a reader writer lock for reading.  The lock can be
+ * taken for reading by any number of tasks at once, provided no writer holds
+ * the lock or is waiting for it.
+ *
+ * @param xRWLock A handle to the lock being taken, as returned by
+ * xSemaphoreCreateRWLock() or xSemaphoreCreateRWLockStatic().
+ *
+ * @param xBlockTime The time in ticks to wait for the lock to become
+ * available.  The macro portTICK_PERIOD_MS can be used to convert this to a
+ * real time.  A block time of zero can be used to poll the lock.
+ *
+ * @return pdTRUE if the lock was obtained.  pdFALSE if xBlockTime expired
+ * without the lock becoming available.
+ *
+ * \defgroup xSemaphoreTakeRead xSemaphoreTakeRead
+ * \ingroup Semaphores
+ */
+#if ( configUSE_RW_LOCKS == 1 )
+    #define xSemaphoreTakeRead( xRWLock, xBlockTime )    xQueueTakeRWLock( ( xRWLock ), pdFALSE, ( xBlockTime ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * xSemaphoreGiveRead( SemaphoreHandle_t xRWLock );
+ * @endcode
+ *
+ * <i>Macro</i> to give back a reader writer lock that was taken for reading
+ * using xSemaphoreTakeRead().  When the last reader gives back the lock the
+ * highest priority waiting writer, if any, is unblocked.
+ *
+ * @param xRWLock A handle to the lock being given back.
+ *
+ * @return pdTRUE if the lock was given back.  pdFALSE if no reader held the
+ * lock.
+ *
+ * \defgroup xSemaphoreGiveRead xSemaphoreGiveRead
+ * \ingroup Semaphores
+ */
+#if ( configUSE_RW_LOCKS == 1 )
+    #define xSemaphoreGiveRead( xRWLock )    xQueueGiveRWLock( ( xRWLock ), pdFALSE )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * xSemaphoreTakeWrite(
+ *                      SemaphoreHandle_t xRWLock,
+ *                      TickType_t xBlockTime
+ *                    );
+ * @endcode
+ *
+ * <i>Macro</i> to take a reader writer lock for writing.  A writer has
+ * exclusive access, so the lock is only obtained once all the readers, and any
+ * other writer, have given it back.  While the writer is waiting no new
+ * readers can take the lock.
+ *
+ * @param xRWLock A handle to the lock being taken, as returned by
+ * xSemaphoreCreateRWLock() or xSemaphoreCreateRWLockStatic().
+ *
+ * @param xBlockTime The time in ticks to wait for the lock to become
+ * available.  The macro portTICK_PERIOD_MS can be used to convert this to a
+ * real time.  A block time of zero can be used to poll the lock.
+ *
+ * @return pdTRUE if the lock was obtained.  pdFALSE if xBlockTime expired
+ * without the lock becoming available.
+ *
+ * \defgroup xSemaphoreTakeWrite xSemaphoreTakeWrite
+ * \ingroup Semaphores
+ */
+#if ( configUSE_RW_LOCKS == 1 )
+    #define xSemaphoreTakeWrite( xRWLock, xBlockTime )    xQueueTakeRWLock( ( xRWLock ), pdTRUE, ( xBlockTime ) )
+#endif
+
+/**
+ * semphr. h
+ * @code{c}
+ * xSemaphoreGiveWrite( SemaphoreHandle_t xRWLock );
+ * @endcode
+ *
+ * <i>Macro</i> to give back a reader writer lock that was taken for writing
+ * using xSemaphoreTakeWrite().  Must only be called by the writer that holds
+ * the lock.  If another writer is waiting then the highest priority waiting
+ * writer is unblocked, otherwise all the waiting readers are unblocked.
+ *
+ * @param xRWLock A handle to the lock being given back.
+ *
+ * @return pdTRUE if the lock was given back.  pdFALSE if the calling task did
+ * not hold the lock for writing.
+ *
+ * \defgroup xSemaphoreGiveWrite xSemaphoreGiveWrite
+ * \ingroup Semaphores
+ */
+#if ( configUSE_RW_LOCKS == 1 )
+    #define xSemaphoreGiveWrite( xRWLock )    xQueueGiveRWLock( ( xRWLock ), pdTRUE )
+#endif
+
 /**
  * semphr. h
  * @code{c}
@@ -1176,6 +1513,23 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define uxSemaphoreGetCount( xSemaphore )           uxQueueMessagesWaiting( ( QueueHandle_t ) ( xSemaphore ) )
 
+/**
+ * semphr.h
+ * @code{c}
+ * BaseType_t xSemaphoreSetWaitOrder( SemaphoreHandle_t xSemaphore, BaseType_t xWaitOrder );
+ * @endcode
+ *
+ * Set the order in which tasks blocked taking the semaphore are woken to
+ * queueWAIT_ORDER_PRIORITY (the default) or queueWAIT_ORDER_FIFO.  Must be
+ * called before any task blocks on the semaphore.  A mutex can only use
+ * priority order.  See xQueueSetWaitOrder().
+ *
+ * @return pdPASS if the order was set, otherwise pdFAIL.
+ */
+#if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+    #define xSemaphoreSetWaitOrder( xSemaphore, xWaitOrder )    xQueueSetWaitOrder( ( QueueHandle_t ) ( xSemaphore ), ( xWaitOrder ) )
+#endif
+
 /**
  * semphr.h
  * @code{c}
@@ -1190,4 +1544,12 @@ typedef QueueHandle_t SemaphoreHandle_t;
  */
 #define uxSemaphoreGetCountFromISR( xSemaphore )    uxQueueMessagesWaitingFromISR( ( QueueHandle_t ) ( xSemaphore ) )
 
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configENABLE_ACCESS_CONTROL_LIST == 1 ) )
+
+/* Grant or revoke an unprivileged task's access to a semaphore or mutex, see
+ * vGrantAccessToKernelObject(). */
+    #define vGrantAccessToSemaphore( xTask, xSemaphore )     vGrantAccessToKernelObject( ( xTask ), ( xSemaphore ) )
+    #define vRevokeAccessToSemaphore( xTask, xSemaphore )    vRevokeAccessToKernelObject( ( xTask ), ( xSemaphore ) )
+#endif
+
 #endif /* SEMAPHORE_H */
@@ -0,0 +1,250 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+
+/*
+ * Shared stack tasks are run-to-completion tasks: each activation calls the
+ * task's function, which returns without blocking.  Because a shared stack
+ * task never holds a stack frame between activations, all the shared stack
+ * tasks of one priority run on the stack of a single host task created for
+ * that priority, called a shared stack.  Activations at a priority run one
+ * after the other, in the order they were made, and are preempted by the
+ * shared stacks and ordinary tasks of higher priority as normal.
+ *
+ * As in the stack resource policy (SRP), tasks of the same priority never
+ * preempt each other, so the worst case RAM needed by a set of shared stack
+ * tasks is the sum, over the priorities used, of the deepest task at each
+ * priority, rather than the sum of the stacks of every task.
+ *
+ * A shared stack task is activated by xSharedStackTaskNotify(), which also
+ * passes it a set of bits, or by data arriving on a queue or semaphore that
+ * was given to it when it was created.
+ *
+ * The function of a shared stack task must not call an API function with a
+ * non-zero block time, or delay, as that would block every other task of the
+ * shared stack.
+ *
+ * configUSE_SHARED_STACK_TASKS must be set to 1 in FreeRTOSConfig.h for this
+ * API to be available.  Shared stacks wait on activation queues using
+ * xQueueWaitForAny(), so configUSE_QUEUE_WAIT_FOR_ANY must also be set to 1.
+ */
+
+#ifndef SHARED_STACK_H
+#define SHARED_STACK_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include shared_stack.h"
+#endif
+
+#include "task.h"
+#include "queue.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which shared stacks are referenced.  For example, a call to
+ * xSharedStackCreate() returns a SharedStackHandle_t variable that can then be
+ * used as a parameter to xSharedStackTaskCreate().
+ */
+struct SharedStackDefinition;
+typedef struct SharedStackDefinition * SharedStackHandle_t;
+
+/**
+ * Type by which shared stack tasks are referenced.
+ */
+struct SharedStackTaskDefinition;
+typedef struct SharedStackTaskDefinition * SharedStackTaskHandle_t;
+
+/*
+ * Defines the prototype to which shared stack task functions must conform.
+ * ulNotifiedValue holds the bits set by xSharedStackTaskNotify() since the
+ * previous activation, and is 0 if the task was activated by its queue.
+ */
+typedef void (* SharedStackTaskFunction_t)( void * pvParameters,
+                                            uint32_t ulNotifiedValue );
+
+/**
+ * shared_stack.h
+ *
+ * @code{c}
+ * SharedStackHandle_t xSharedStackCreate( const char * const pcName,
+ *                                         configSTACK_DEPTH_TYPE uxStackDepth,
+ *                                         UBaseType_t uxPriority,
+ *                                         UBaseType_t uxMaxQueues );
+ * @endcode
+ *
+ * Creates a shared stack and its host task using dynamically allocated
+ * memory.  Shared stacks cannot be deleted, so they are intended to be
+ * created once when the application starts.
+ *
+ * @param pcName The name given to the host task.
+ *
+ * @param uxStackDepth The stack size of the host task, in words.  It must be
+ * large enough for the deepest of the shared stack tasks that run on it.
+ *
+ * @param uxPriority The priority at which the shared stack tasks run.
+ *
+ * @param uxMaxQueues The number of shared stack tasks that can be created on
+ * the shared stack with an activation queue.
+ *
+ * @return A handle to the created shared stack, or NULL if there was
+ * insufficient heap memory to create it.
+ *
+ * \defgroup xSharedStackCreate xSharedStackCreate
+ * \ingroup SharedStackTasks
+ */
+SharedStackHandle_t xSharedStackCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        configSTACK_DEPTH_TYPE uxStackDepth,
+                                        UBaseType_t uxPriority,
+                                        UBaseType_t uxMaxQueues ) PRIVILEGED_FUNCTION;
+
+/**
+ * shared_stack.h
+ *
+ * @code{c}
+ * SharedStackTaskHandle_t xSharedStackTaskCreate( SharedStackHandle_t xSharedStack,
+ *                                                 SharedStackTaskFunction_t pxFunction,
+ *                                                 void * pvParameters,
+ *                                                 QueueHandle_t xActivationQueue );
+ * @endcode
+ *
+ * Creates a shared stack task using dynamically allocated memory.  Shared
+ * stack tasks cannot be deleted.
+ *
+ * @param xSharedStack The shared stack the task runs on, which sets its
+ * priority.
+ *
+ * @param pxFunction The function called for each activation.
+ *
+ * @param pvParameters The value passed to pxFunction.
+ *
+ * @param xActivationQueue If not NULL, a queue or semaphore that activates
+ * the task whenever it contains data or is available.  pxFunction must then
+ * read from it with a block time of 0, and is activated again if it leaves
+ * data behind.  A queue or semaphore can activate only one shared stack task,
+ * and must not be a mutex or a member of a queue set.
+ *
+ * @return A handle to the created task, or NULL if there was insufficient
+ * heap memory, or the shared stack already has uxMaxQueues tasks with an
+ * activation queue.
+ *
+ * Example use:
+ * @code{c}
+ * void vControlStep( void * pvParameters, uint32_t ulNotifiedValue )
+ * {
+ * Loop_t * pxLoop = pvParameters;
+ * Sample_t xSample;
+ *
+ *  // Runs to completion for every sample received.
+ *  while( xQueueReceive( pxLoop->xSamples, &xSample, 0 ) == pdPASS )
+ *  {
+ *      vUpdateLoop( pxLoop, &xSample );
+ *  }
+ * }
+ *
+ * void vCreateLoops( void )
+ * {
+ * SharedStackHandle_t xControl;
+ * UBaseType_t ux;
+ *
+ *  xControl = xSharedStackCreate( "Control", 256, tskIDLE_PRIORITY + 3, NUM_LOOPS );
+ *
+ *  for( ux = 0; ux < NUM_LOOPS; ux++ )
+ *  {
+ *      xSharedStackTaskCreate( xControl, vControlStep, &( xLoops[ ux ] ), xLoops[ ux ].xSamples );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSharedStackTaskCreate xSharedStackTaskCreate
+ * \ingroup SharedStackTasks
+ */
+SharedStackTaskHandle_t xSharedStackTaskCreate( SharedStackHandle_t xSharedStack,
+                                                SharedStackTaskFunction_t pxFunction,
+                                                void * pvParameters,
+                                                QueueHandle_t xActivationQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * shared_stack.h
+ *
+ * @code{c}
+ * BaseType_t xSharedStackTaskNotify( SharedStackTaskHandle_t xTask,
+ *                                    uint32_t ulBitsToSet );
+ * @endcode
+ *
+ * Activates a shared stack task, ORing ulBitsToSet into the value passed to
+ * its function.  Notifying a task that is already waiting to run only adds
+ * to the bits, so the task runs once for all the notifications.  A task that
+ * is notified while it is running runs again after it returns.
+ *
+ * @param xTask The shared stack task to activate.
+ *
+ * @param ulBitsToSet The bits to set in the task's notification value.
+ *
+ * @return pdPASS.
+ *
+ * \defgroup xSharedStackTaskNotify xSharedStackTaskNotify
+ * \ingroup SharedStackTasks
+ */
+BaseType_t xSharedStackTaskNotify( SharedStackTaskHandle_t xTask,
+                                   uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
+
+/**
+ * shared_stack.h
+ *
+ * @code{c}
+ * BaseType_t xSharedStackTaskNotifyFromISR( SharedStackTaskHandle_t xTask,
+ *                                           uint32_t ulBitsToSet,
+ *                                           BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xSharedStackTaskNotify() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if the activation unblocked
+ * the host task of the shared stack and the host task has a priority above
+ * that of the currently running task, in which case a context switch should
+ * be requested before the interrupt is exited.
+ *
+ * \defgroup xSharedStackTaskNotifyFromISR xSharedStackTaskNotifyFromISR
+ * \ingroup SharedStackTasks
+ */
+BaseType_t xSharedStackTaskNotifyFromISR( SharedStackTaskHandle_t xTask,
+                                          uint32_t ulBitsToSet,
+                                          BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SHARED_STACK_H ) */
@@ -0,0 +1,337 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Single producer single consumer (SPSC) queues pass fixed size items, by copy,
+ * from one task or interrupt to another.  They are intended for interrupt to
+ * task hand off where the data path must not disable interrupts.  Sending to or
+ * receiving from an SPSC queue never enters a critical section - the kernel is
+ * only entered when the other side is blocked on the queue and must be woken.
+ *
+ * ***NOTE***:  As with stream buffers, the SPSC queue implementation assumes
+ * there is only one task or interrupt that will write to the queue (the
+ * writer), and only one task or interrupt that will read from the queue (the
+ * reader).  It is safe for the writer and reader to be different tasks or
+ * interrupts, but it is not safe to have multiple different writers or multiple
+ * different readers.  Use a normal queue (see queue.h) if there are to be
+ * multiple writers or multiple readers.
+ *
+ * ***NOTE***:  A task that blocks on an SPSC queue is woken using its direct to
+ * task notification.  Tasks must not call xTaskNotifyWait() or
+ * ulTaskNotifyTake() on the same notification while they are blocked on an SPSC
+ * queue.
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include spsc_queue.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which SPSC queues are referenced.  For example, a call to
+ * xSPSCQueueCreate() returns an SPSCQueueHandle_t variable that can then be
+ * used as a parameter to xSPSCQueueSend(), xSPSCQueueReceive(), etc.
+ */
+struct SPSCQueueDefinition;
+typedef struct SPSCQueueDefinition * SPSCQueueHandle_t;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * SPSCQueueHandle_t xSPSCQueueCreate( UBaseType_t uxQueueLength, UBaseType_t uxItemSize );
+ * @endcode
+ *
+ * Creates a new SPSC queue using dynamically allocated memory.  See
+ * xSPSCQueueCreateStatic() for a version that uses statically allocated memory.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 or left undefined in
+ * FreeRTOSConfig.h for xSPSCQueueCreate() to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold at any
+ * one time.
+ *
+ * @param uxItemSize The size, in bytes, of each item in the queue.
+ *
+ * @return If the queue is successfully created then a handle to the created
+ * queue is returned.  If there is insufficient heap memory available to create
+ * the queue then NULL is returned.
+ *
+ * Example use:
+ * @code{c}
+ * SPSCQueueHandle_t xRxQueue;
+ *
+ * void vUARTRxISR( void )
+ * {
+ * uint8_t ucByte = UART_RX_REG;
+ * BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+ *
+ *  // Does not disable interrupts, only notifies the task if it is waiting.
+ *  xSPSCQueueSendFromISR( xRxQueue, &ucByte, &xHigherPriorityTaskWoken );
+ *  portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+ * }
+ *
+ * void vRxTask( void *pvParameters )
+ * {
+ * uint8_t ucByte;
+ *
+ *  xRxQueue = xSPSCQueueCreate( 32, sizeof( uint8_t ) );
+ *  configASSERT( xRxQueue );
+ *
+ *  for( ;; )
+ *  {
+ *      if( xSPSCQueueReceive( xRxQueue, &ucByte, portMAX_DELAY ) == pdPASS )
+ *      {
+ *          // Process ucByte here.
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xSPSCQueueCreate xSPSCQueueCreate
+ * \ingroup SPSCQueueManagement
+ */
+SPSCQueueHandle_t xSPSCQueueCreate( const UBaseType_t uxQueueLength,
+                                    const UBaseType_t uxItemSize ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * SPSCQueueHandle_t xSPSCQueueCreateStatic( UBaseType_t uxQueueLength,
+ *                                           UBaseType_t uxItemSize,
+ *                                           uint8_t *pucQueueStorage,
+ *                                           StaticSPSCQueue_t *pxStaticQueue );
+ * @endcode
+ *
+ * Creates a new SPSC queue using statically allocated memory.  See
+ * xSPSCQueueCreate() for a version that uses dynamically allocated memory.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 in FreeRTOSConfig.h for
+ * xSPSCQueueCreateStatic() to be available.
+ *
+ * @param uxQueueLength The maximum number of items the queue can hold at any
+ * one time.
+ *
+ * @param uxItemSize The size, in bytes, of each item in the queue.
+ *
+ * @param pucQueueStorage Must point to a uint8_t array that is at least
+ * ( uxQueueLength * uxItemSize ) bytes big.  Items are copied into this array.
+ *
+ * @param pxStaticQueue Must point to a variable of type StaticSPSCQueue_t,
+ * which will be used to hold the queue's data structure.
+ *
+ * @return If the queue is created successfully then a handle to the created
+ * queue is returned.  If either pucQueueStorage or pxStaticQueue are NULL then
+ * NULL is returned.
+ *
+ * \defgroup xSPSCQueueCreateStatic xSPSCQueueCreateStatic
+ * \ingroup SPSCQueueManagement
+ */
+SPSCQueueHandle_t xSPSCQueueCreateStatic( const UBaseType_t uxQueueLength,
+                                          const UBaseType_t uxItemSize,
+                                          uint8_t * const pucQueueStorage,
+                                          StaticSPSCQueue_t * const pxStaticQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * void vSPSCQueueDelete( SPSCQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Deletes a queue that was previously created using a call to
+ * xSPSCQueueCreate() or xSPSCQueueCreateStatic().  If the queue was created
+ * using dynamic memory then the memory is freed.
+ *
+ * A queue must not be deleted while a task is blocked on it.
+ *
+ * @param xQueue The handle of the queue to be deleted.
+ *
+ * \defgroup vSPSCQueueDelete vSPSCQueueDelete
+ * \ingroup SPSCQueueManagement
+ */
+void vSPSCQueueDelete( SPSCQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSPSCQueueSend( SPSCQueueHandle_t xQueue,
+ *                            const void *pvItemToQueue,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item onto the back of an SPSC queue.  Must only be called by the
+ * writer.  See xSPSCQueueSendFromISR() for a version that can be called from an
+ * interrupt service routine.
+ *
+ * @param xQueue The handle of the queue to which the item is to be sent.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.  uxItemSize bytes are copied from pvItemToQueue into the queue.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for space to become available on the queue, should it already be full.  The
+ * call will return immediately if this is set to 0.
+ *
+ * @return pdPASS if the item was successfully sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xSPSCQueueSend xSPSCQueueSend
+ * \ingroup SPSCQueueManagement
+ */
+BaseType_t xSPSCQueueSend( SPSCQueueHandle_t xQueue,
+                           const void * const pvItemToQueue,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSPSCQueueSendFromISR( SPSCQueueHandle_t xQueue,
+ *                                   const void *pvItemToQueue,
+ *                                   BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSPSCQueueSend().  Must only be called by the
+ * writer.
+ *
+ * @param xQueue The handle of the queue to which the item is to be sent.
+ *
+ * @param pvItemToQueue A pointer to the item that is to be placed on the
+ * queue.
+ *
+ * @param pxHigherPriorityTaskWoken xSPSCQueueSendFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if sending to the queue unblocked a
+ * task that has a priority higher than the currently running task.  If
+ * xSPSCQueueSendFromISR() sets this value to pdTRUE then a context switch
+ * should be requested before the interrupt is exited.
+ *
+ * @return pdPASS if the item was successfully sent, otherwise errQUEUE_FULL.
+ *
+ * \defgroup xSPSCQueueSendFromISR xSPSCQueueSendFromISR
+ * \ingroup SPSCQueueManagement
+ */
+BaseType_t xSPSCQueueSendFromISR( SPSCQueueHandle_t xQueue,
+                                  const void * const pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSPSCQueueReceive( SPSCQueueHandle_t xQueue,
+ *                               void *pvBuffer,
+ *                               TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Copies an item from the front of an SPSC queue and removes it from the
+ * queue.  Must only be called by the reader.  See xSPSCQueueReceiveFromISR()
+ * for a version that can be called from an interrupt service routine.
+ *
+ * @param xQueue The handle of the queue from which the item is to be received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received item will be
+ * copied.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block waiting
+ * for an item to receive should the queue be empty.  The call will return
+ * immediately if this is set to 0.
+ *
+ * @return pdPASS if an item was successfully received, otherwise
+ * errQUEUE_EMPTY.
+ *
+ * \defgroup xSPSCQueueReceive xSPSCQueueReceive
+ * \ingroup SPSCQueueManagement
+ */
+BaseType_t xSPSCQueueReceive( SPSCQueueHandle_t xQueue,
+                              void * const pvBuffer,
+                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * BaseType_t xSPSCQueueReceiveFromISR( SPSCQueueHandle_t xQueue,
+ *                                      void *pvBuffer,
+ *                                      BaseType_t *pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * Interrupt safe version of xSPSCQueueReceive().  Must only be called by the
+ * reader.
+ *
+ * @param xQueue The handle of the queue from which the item is to be received.
+ *
+ * @param pvBuffer Pointer to the buffer into which the received item will be
+ * copied.
+ *
+ * @param pxHigherPriorityTaskWoken xSPSCQueueReceiveFromISR() will set
+ * *pxHigherPriorityTaskWoken to pdTRUE if receiving from the queue unblocked a
+ * task that has a priority higher than the currently running task.
+ *
+ * @return pdPASS if an item was successfully received, otherwise
+ * errQUEUE_EMPTY.
+ *
+ * \defgroup xSPSCQueueReceiveFromISR xSPSCQueueReceiveFromISR
+ * \ingroup SPSCQueueManagement
+ */
+BaseType_t xSPSCQueueReceiveFromISR( SPSCQueueHandle_t xQueue,
+                                     void * const pvBuffer,
+                                     BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * spsc_queue.h
+ *
+ * @code{c}
+ * UBaseType_t uxSPSCQueueMessagesWaiting( const SPSCQueueHandle_t xQueue );
+ * @endcode
+ *
+ * Returns the number of items stored in an SPSC queue.  Can be called by the
+ * writer, the reader, or an interrupt.
+ *
+ * @param xQueue The handle of the queue being queried.
+ *
+ * \defgroup uxSPSCQueueMessagesWaiting uxSPSCQueueMessagesWaiting
+ * \ingroup SPSCQueueManagement
+ */
+UBaseType_t uxSPSCQueueMessagesWaiting( const SPSCQueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( SPSC_QUEUE_H ) */
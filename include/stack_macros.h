@@ -41,10 +41,26 @@
  * to which the bytes were set when the task was created have not been
  * overwritten.  Note this second test does not guarantee that an overflowed
  * stack will always be recognised.
+ *
+ * Ports that set portHAS_STACK_LIMIT_REGISTER to 1 program a stack limit
+ * register, such as PSPLIM on ARMv8-M, with the end of each task's stack, so
+ * an overflow faults as it happens.  On those ports setting
+ * configCHECK_FOR_STACK_OVERFLOW to 3 relies on that fault alone, and removes
+ * the software check from the context switch.  vApplicationStackOverflowHook()
+ * is then not called; the overflow is reported through the processor's fault
+ * handler instead, for example a UsageFault with the STKOF bit set on ARMv8-M,
+ * or a HardFault if UsageFault is not enabled.  On other ports 3 behaves as 2,
+ * plus any checks the port adds for 3, such as the RISC-V ISR stack check.
  */
 
 /*-----------------------------------------------------------*/
 
+#if ( ( configCHECK_FOR_STACK_OVERFLOW == 3 ) && ( portHAS_STACK_LIMIT_REGISTER == 1 ) )
+    #define taskSTACK_OVERFLOW_CHECKED_IN_HARDWARE    1
+#else
+    #define taskSTACK_OVERFLOW_CHECKED_IN_HARDWARE    0
+#endif
+
 /*
  * portSTACK_LIMIT_PADDING is a number of extra words to consider to be in
  * use on the stack.
@@ -56,13 +72,13 @@
 #if ( ( configCHECK_FOR_STACK_OVERFLOW == 1 ) && ( portSTACK_GROWTH < 0 ) )
 
 /* Only the current stack state is to be checked. */
-    #define taskCHECK_FOR_STACK_OVERFLOW()                                                            \
-    {                                                                                                 \
-        /* Is the currently saved stack pointer within the stack limit? */                            \
-        if( pxCurrentTCB->pxTopOfStack <= pxCurrentTCB->pxStack + portSTACK_LIMIT_PADDING )           \
-        {                                                                                             \
-            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName ); \
-        }                                                                                             \
+    #define taskCHECK_FOR_STACK_OVERFLOW()                                                                     \
+    {                                                                                                          \
+        /* Is the currently saved stack pointer within the stack limit? */                                     \
+        if( pxCurrentTCB->pxTopOfStack <= pxCurrentTCB->pxStack + portSTACK_LIMIT_PADDING )                    \
+        {                                                                                                      \
+            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, taskGET_TASK_NAME( pxCurrentTCB ) ); \
+        }                                                                                                      \
     }
 
 #endif /* configCHECK_FOR_STACK_OVERFLOW == 1 */
@@ -71,39 +87,39 @@
 #if ( ( configCHECK_FOR_STACK_OVERFLOW == 1 ) && ( portSTACK_GROWTH > 0 ) )
 
 /* Only the current stack state is to be checked. */
-    #define taskCHECK_FOR_STACK_OVERFLOW()                                                            \
-    {                                                                                                 \
-                                                                                                      \
-        /* Is the currently saved stack pointer within the stack limit? */                            \
-        if( pxCurrentTCB->pxTopOfStack >= pxCurrentTCB->pxEndOfStack - portSTACK_LIMIT_PADDING )      \
-        {                                                                                             \
-            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName ); \
-        }                                                                                             \
+    #define taskCHECK_FOR_STACK_OVERFLOW()                                                                     \
+    {                                                                                                          \
+                                                                                                               \
+        /* Is the currently saved stack pointer within the stack limit? */                                     \
+        if( pxCurrentTCB->pxTopOfStack >= pxCurrentTCB->pxEndOfStack - portSTACK_LIMIT_PADDING )               \
+        {                                                                                                      \
+            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, taskGET_TASK_NAME( pxCurrentTCB ) ); \
+        }                                                                                                      \
     }
 
 #endif /* configCHECK_FOR_STACK_OVERFLOW == 1 */
 /*-----------------------------------------------------------*/
 
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH < 0 ) )
-
-    #define taskCHECK_FOR_STACK_OVERFLOW()                                                            \
-    {                                                                                                 \
-        const uint32_t * const pulStack = ( uint32_t * ) pxCurrentTCB->pxStack;                       \
-        const uint32_t ulCheckValue = ( uint32_t ) 0xa5a5a5a5;                                        \
-                                                                                                      \
-        if( ( pulStack[ 0 ] != ulCheckValue ) ||                                                      \
-            ( pulStack[ 1 ] != ulCheckValue ) ||                                                      \
-            ( pulStack[ 2 ] != ulCheckValue ) ||                                                      \
-            ( pulStack[ 3 ] != ulCheckValue ) )                                                       \
-        {                                                                                             \
-            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName ); \
-        }                                                                                             \
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( taskSTACK_OVERFLOW_CHECKED_IN_HARDWARE == 0 ) && ( portSTACK_GROWTH < 0 ) )
+
+    #define taskCHECK_FOR_STACK_OVERFLOW()                                                                     \
+    {                                                                                                          \
+        const uint32_t * const pulStack = ( uint32_t * ) pxCurrentTCB->pxStack;                                \
+        const uint32_t ulCheckValue = ( uint32_t ) 0xa5a5a5a5;                                                 \
+                                                                                                               \
+        if( ( pulStack[ 0 ] != ulCheckValue ) ||                                                               \
+            ( pulStack[ 1 ] != ulCheckValue ) ||                                                               \
+            ( pulStack[ 2 ] != ulCheckValue ) ||                                                               \
+            ( pulStack[ 3 ] != ulCheckValue ) )                                                                \
+        {                                                                                                      \
+            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, taskGET_TASK_NAME( pxCurrentTCB ) ); \
+        }                                                                                                      \
     }
 
 #endif /* #if( configCHECK_FOR_STACK_OVERFLOW > 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( portSTACK_GROWTH > 0 ) )
+#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( taskSTACK_OVERFLOW_CHECKED_IN_HARDWARE == 0 ) && ( portSTACK_GROWTH > 0 ) )
 
     #define taskCHECK_FOR_STACK_OVERFLOW()                                                                                                \
     {                                                                                                                                     \
@@ -120,7 +136,7 @@
         /* Has the extremity of the task stack ever been written over? */                                                                 \
         if( memcmp( ( void * ) pcEndOfStack, ( void * ) ucExpectedStackBytes, sizeof( ucExpectedStackBytes ) ) != 0 )                     \
         {                                                                                                                                 \
-            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, pxCurrentTCB->pcTaskName );                                     \
+            vApplicationStackOverflowHook( ( TaskHandle_t ) pxCurrentTCB, taskGET_TASK_NAME( pxCurrentTCB ) );                            \
         }                                                                                                                                 \
     }
 
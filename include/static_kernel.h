@@ -0,0 +1,197 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * The static kernel profile is for systems that create all their kernel
+ * objects during initialisation and never delete them.  Instead of calling the
+ * xTaskCreateStatic() family of functions, the application lists its objects
+ * in tables in FreeRTOSConfig.h.  The memory for every object is then
+ * allocated at build time, the objects are created by vTaskStartScheduler()
+ * before the idle task, and each object's handle is the constant address of
+ * its memory, so there are no handle variables to store or load.  The memory
+ * for the idle and timer service tasks is provided too, so the application
+ * does not define vApplicationGetIdleTaskMemory() or
+ * vApplicationGetTimerTaskMemory().
+ *
+ * Each table is a macro that takes the name of another macro, and calls it
+ * once for each object.  Object names must be valid C identifiers, and each
+ * name is also used as the name of the task or timer and, when
+ * configQUEUE_REGISTRY_SIZE is greater than 0, to add the queue or semaphore
+ * to the queue registry.  Semaphores and mutexes share one set of names.
+ * Tables that are not defined are empty.
+ *
+ *  configSTATIC_KERNEL_TASKS( X ):
+ *      X( Name, pxTaskCode, uxStackDepth, pvParameters, uxPriority )
+ *  configSTATIC_KERNEL_QUEUES( X ):
+ *      X( Name, uxQueueLength, uxItemSize )
+ *  configSTATIC_KERNEL_BINARY_SEMAPHORES( X ):
+ *      X( Name )
+ *  configSTATIC_KERNEL_COUNTING_SEMAPHORES( X ):
+ *      X( Name, uxMaxCount, uxInitialCount )
+ *  configSTATIC_KERNEL_MUTEXES( X ):
+ *      X( Name )
+ *  configSTATIC_KERNEL_EVENT_GROUPS( X ):
+ *      X( Name )
+ *  configSTATIC_KERNEL_TIMERS( X ):
+ *      X( Name, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction )
+ *
+ * The tables are expanded in static_kernel.c, which declares each task and
+ * timer callback function itself - so they must not be static - and which
+ * cannot see the application's declarations, so the other values must be
+ * constant expressions that only use the types and macros available in
+ * FreeRTOSConfig.h.  uxItemSize must not be 0.
+ *
+ * For example, in FreeRTOSConfig.h:
+ * @code{c}
+ * #define configUSE_STATIC_KERNEL                  1
+ * #define configSUPPORT_STATIC_ALLOCATION          1
+ * #define configSUPPORT_DYNAMIC_ALLOCATION         0
+ *
+ * #define configSTATIC_KERNEL_TASKS( X )                \
+ *     X( Control, vControlTask, 256, NULL, 3 )          \
+ *     X( Logger, vLoggerTask, 128, NULL, 1 )
+ *
+ * #define configSTATIC_KERNEL_QUEUES( X )               \
+ *     X( Commands, 8, sizeof( uint32_t ) )
+ *
+ * #define configSTATIC_KERNEL_MUTEXES( X )              \
+ *     X( UartLock )
+ * @endcode
+ *
+ * And in the application:
+ * @code{c}
+ * #include "static_kernel.h"
+ *
+ * void vControlTask( void * pvParameters )
+ * {
+ * uint32_t ulCommand;
+ *
+ *  for( ;; )
+ *  {
+ *      xQueueReceive( skQUEUE( Commands ), &ulCommand, portMAX_DELAY );
+ *      ...
+ *  }
+ * }
+ *
+ * int main( void )
+ * {
+ *  prvSetupHardware();
+ *  vTaskStartScheduler();
+ * }
+ * @endcode
+ *
+ * configUSE_STATIC_KERNEL must be set to 1 in FreeRTOSConfig.h for this API to
+ * be available.
+ */
+
+#ifndef STATIC_KERNEL_H
+#define STATIC_KERNEL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include static_kernel.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+#ifndef configSTATIC_KERNEL_TASKS
+    #define configSTATIC_KERNEL_TASKS( X )
+#endif
+
+#ifndef configSTATIC_KERNEL_QUEUES
+    #define configSTATIC_KERNEL_QUEUES( X )
+#endif
+
+#ifndef configSTATIC_KERNEL_BINARY_SEMAPHORES
+    #define configSTATIC_KERNEL_BINARY_SEMAPHORES( X )
+#endif
+
+#ifndef configSTATIC_KERNEL_COUNTING_SEMAPHORES
+    #define configSTATIC_KERNEL_COUNTING_SEMAPHORES( X )
+#endif
+
+#ifndef configSTATIC_KERNEL_MUTEXES
+    #define configSTATIC_KERNEL_MUTEXES( X )
+#endif
+
+#ifndef configSTATIC_KERNEL_EVENT_GROUPS
+    #define configSTATIC_KERNEL_EVENT_GROUPS( X )
+#endif
+
+#ifndef configSTATIC_KERNEL_TIMERS
+    #define configSTATIC_KERNEL_TIMERS( X )
+#endif
+
+/* The handles of the objects in the tables.  Each is a constant, so can be
+ * used in static initialisers. */
+#define skTASK( xName )           ( ( TaskHandle_t ) &( xStaticKernelTask_##xName ) )
+#define skQUEUE( xName )          ( ( QueueHandle_t ) &( xStaticKernelQueue_##xName ) )
+#define skSEMAPHORE( xName )      ( ( SemaphoreHandle_t ) &( xStaticKernelSemaphore_##xName ) )
+#define skEVENT_GROUP( xName )    ( ( EventGroupHandle_t ) &( xStaticKernelEventGroup_##xName ) )
+#define skTIMER( xName )          ( ( TimerHandle_t ) &( xStaticKernelTimer_##xName ) )
+
+/* Declare the memory of each object, which is defined in static_kernel.c. */
+#define skDECLARE_TASK( xName, pxTaskCode, uxStackDepth, pvParameters, uxPriority ) \
+    extern StaticTask_t xStaticKernelTask_##xName;
+#define skDECLARE_QUEUE( xName, uxQueueLength, uxItemSize ) \
+    extern StaticQueue_t xStaticKernelQueue_##xName;
+#define skDECLARE_SEMAPHORE( xName ) \
+    extern StaticSemaphore_t xStaticKernelSemaphore_##xName;
+#define skDECLARE_COUNTING_SEMAPHORE( xName, uxMaxCount, uxInitialCount ) \
+    extern StaticSemaphore_t xStaticKernelSemaphore_##xName;
+#define skDECLARE_EVENT_GROUP( xName ) \
+    extern StaticEventGroup_t xStaticKernelEventGroup_##xName;
+#define skDECLARE_TIMER( xName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction ) \
+    extern StaticTimer_t xStaticKernelTimer_##xName;
+
+configSTATIC_KERNEL_TASKS( skDECLARE_TASK )
+configSTATIC_KERNEL_QUEUES( skDECLARE_QUEUE )
+configSTATIC_KERNEL_BINARY_SEMAPHORES( skDECLARE_SEMAPHORE )
+configSTATIC_KERNEL_COUNTING_SEMAPHORES( skDECLARE_COUNTING_SEMAPHORE )
+configSTATIC_KERNEL_MUTEXES( skDECLARE_SEMAPHORE )
+configSTATIC_KERNEL_EVENT_GROUPS( skDECLARE_EVENT_GROUP )
+configSTATIC_KERNEL_TIMERS( skDECLARE_TIMER )
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY INTENDED
+ * FOR USE BY vTaskStartScheduler().
+ *
+ * Create the objects in the static kernel tables.
+ */
+void vStaticKernelCreateObjects( void ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* STATIC_KERNEL_H */
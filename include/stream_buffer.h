@@ -78,6 +78,41 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
                                                  BaseType_t xIsInsideISR,
                                                  BaseType_t * const pxHigherPriorityTaskWoken );
 
+/**
+ *  Type used to describe one of the fragments of data passed to
+ *  xStreamBufferSendV().
+ */
+typedef struct xSTREAM_BUFFER_FRAGMENT
+{
+    const void * pvData;     /* The start of the fragment's data. */
+    size_t xDataLengthBytes; /* The number of bytes in the fragment, which can be 0. */
+} StreamBufferFragment_t;
+
+/* The kinds of buffer that can be created by xStreamBufferGenericCreate() and
+ * xStreamBufferGenericCreateStatic(). */
+#define sbTYPE_STREAM_BUFFER                    ( ( BaseType_t ) 0 )
+#define sbTYPE_MESSAGE_BUFFER                   ( ( BaseType_t ) 1 )
+#define sbTYPE_MULTI_PRODUCER_MESSAGE_BUFFER    ( ( BaseType_t ) 2 )
+#define sbTYPE_FIXED_SIZE_MESSAGE_BUFFER        ( ( BaseType_t ) 3 )
+
+/* ORed into the buffer type to create a buffer whose length is a power of two,
+ * so indexes into it can be wrapped with a mask. */
+#define sbTYPE_POWER_OF_TWO_LENGTH              ( ( BaseType_t ) 0x08 )
+
+/* ORed into sbTYPE_MESSAGE_BUFFER or sbTYPE_MULTI_PRODUCER_MESSAGE_BUFFER to
+ * store the length of each message in xLengthBytes bytes, which must be 1, 2 or
+ * 4, rather than in sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) bytes. */
+#define sbTYPE_MESSAGE_LENGTH_BYTES( xLengthBytes )    ( ( BaseType_t ) ( xLengthBytes ) << 4 )
+
+/* ORed into sbTYPE_FIXED_SIZE_MESSAGE_BUFFER to set the size of every message
+ * the message buffer holds. */
+#define sbTYPE_FIXED_MESSAGE_SIZE( xMessageSize )      ( ( BaseType_t ) ( xMessageSize ) << 4 )
+
+/* ORed into the buffer type to have the kernel maintain the data cache over
+ * the buffer's storage area - see xStreamBufferCreateCacheMaintained().
+ * Requires configUSE_STREAM_BUFFER_CACHE_MAINTENANCE. */
+#define sbTYPE_CACHE_MAINTAINED                 ( ( BaseType_t ) 0x04 )
+
 /**
  * stream_buffer.h
  *
@@ -155,11 +190,11 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
  */
 
 #define xStreamBufferCreate( xBufferSizeBytes, xTriggerLevelBytes ) \
-    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE, NULL, NULL )
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER, NULL, NULL )
 
 #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
     #define xStreamBufferCreateWithCallback( xBufferSizeBytes, xTriggerLevelBytes, pxSendCompletedCallback, pxReceiveCompletedCallback ) \
-    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE, ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER, ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
 /**
@@ -253,13 +288,123 @@ typedef void (* StreamBufferCallbackFunction_t)( StreamBufferHandle_t xStreamBuf
  */
 
 #define xStreamBufferCreateStatic( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) \
-    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), NULL, NULL )
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), NULL, NULL )
 
 #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
     #define xStreamBufferCreateStaticWithCallback( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer, pxSendCompletedCallback, pxReceiveCompletedCallback ) \
-    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), pdFALSE, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), ( pxSendCompletedCallback ), ( pxReceiveCompletedCallback ) )
 #endif
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * StreamBufferHandle_t xStreamBufferCreatePowerOfTwo( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ *
+ * StreamBufferHandle_t xStreamBufferCreateStaticPowerOfTwo( size_t xBufferSizeBytes,
+ *                                                           size_t xTriggerLevelBytes,
+ *                                                           uint8_t *pucStreamBufferStorageArea,
+ *                                                           StaticStreamBuffer_t *pxStaticStreamBuffer );
+ * @endcode
+ *
+ * Versions of xStreamBufferCreate() and xStreamBufferCreateStatic() that create
+ * a stream buffer whose storage area is exactly xBufferSizeBytes long, which
+ * must be a power of two.  Indexes into the storage area are then wrapped with
+ * a mask rather than a compare and subtract, which reduces the cost of each
+ * send and receive on high throughput streams.
+ *
+ * As one byte of the storage area is always left empty, a power of two length
+ * stream buffer can hold at most xBufferSizeBytes - 1 bytes at any one time.
+ *
+ * If configSTREAM_BUFFER_CACHE_LINE_BYTES is set to the size of a data cache
+ * line then xStreamBufferCreatePowerOfTwo() starts the storage area on a cache
+ * line, and the storage area passed to xStreamBufferCreateStaticPowerOfTwo()
+ * must also start on a cache line.  Setting configSTREAM_BUFFER_CACHE_LINE_BYTES
+ * also keeps the read and write indexes of every stream buffer in different
+ * cache lines, so a reader and a writer running on different cores do not
+ * contend for the same line.
+ *
+ * The parameters and return values are otherwise as for xStreamBufferCreate()
+ * and xStreamBufferCreateStatic().
+ *
+ * Example use:
+ * @code{c}
+ *
+ * #define STORAGE_SIZE_BYTES 1024
+ *
+ * static uint8_t ucStorageBuffer[ STORAGE_SIZE_BYTES ] __attribute__( ( aligned( 32 ) ) );
+ * static StaticStreamBuffer_t xStreamBufferStruct;
+ *
+ * void vAFunction( void )
+ * {
+ * StreamBufferHandle_t xStreamBuffer;
+ *
+ *  // Samples are read in blocks of 64 bytes.
+ *  xStreamBuffer = xStreamBufferCreateStaticPowerOfTwo( sizeof( ucStorageBuffer ),
+ *                                                       64,
+ *                                                       ucStorageBuffer,
+ *                                                       &xStreamBufferStruct );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferCreatePowerOfTwo xStreamBufferCreatePowerOfTwo
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreatePowerOfTwo( xBufferSizeBytes, xTriggerLevelBytes ) \
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER | sbTYPE_POWER_OF_TWO_LENGTH, NULL, NULL )
+
+#define xStreamBufferCreateStaticPowerOfTwo( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) \
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER | sbTYPE_POWER_OF_TWO_LENGTH, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), NULL, NULL )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * StreamBufferHandle_t xStreamBufferCreateCacheMaintained( size_t xBufferSizeBytes, size_t xTriggerLevelBytes );
+ *
+ * StreamBufferHandle_t xStreamBufferCreateStaticCacheMaintained( size_t xBufferSizeBytes,
+ *                                                                size_t xTriggerLevelBytes,
+ *                                                                uint8_t *pucStreamBufferStorageArea,
+ *                                                                StaticStreamBuffer_t *pxStaticStreamBuffer );
+ * @endcode
+ *
+ * Versions of xStreamBufferCreate() and xStreamBufferCreateStatic() that create
+ * a stream buffer whose storage area can be shared with a DMA controller while
+ * it remains in cacheable RAM.  configUSE_STREAM_BUFFER_CACHE_MAINTENANCE must
+ * be set to 1 for these macros to be available.
+ *
+ * xStreamBufferSend() cleans the data cache over the bytes it writes into the
+ * storage area, so a DMA controller that reads them from memory, for example
+ * through xStreamBufferAcquireRead(), sees the data just sent.
+ * xStreamBufferReceive() invalidates the data cache over the bytes it reads out
+ * of the storage area before copying them, so it sees data a DMA controller
+ * wrote to memory, for example through xStreamBufferAcquireWrite().  Only the
+ * cache lines that hold the bytes copied are maintained.  Data written or read
+ * in place by the processor through the acquire functions is not maintained by
+ * the kernel.
+ *
+ * Cache lines at either end of the storage area must not be shared with other
+ * data that a DMA controller writes.  xStreamBufferCreateCacheMaintained()
+ * therefore starts and ends the storage area on a
+ * configSTREAM_BUFFER_CACHE_LINE_BYTES boundary, and the storage area passed to
+ * xStreamBufferCreateStaticCacheMaintained() must start on a cache line and
+ * should be a whole number of cache lines long.
+ *
+ * Message buffers are created with the same behaviour by ORing
+ * sbTYPE_CACHE_MAINTAINED into the buffer type passed to
+ * xStreamBufferGenericCreate() or xStreamBufferGenericCreateStatic().
+ *
+ * The parameters and return values are otherwise as for xStreamBufferCreate()
+ * and xStreamBufferCreateStatic().
+ *
+ * \defgroup xStreamBufferCreateCacheMaintained xStreamBufferCreateCacheMaintained
+ * \ingroup StreamBufferManagement
+ */
+#define xStreamBufferCreateCacheMaintained( xBufferSizeBytes, xTriggerLevelBytes ) \
+    xStreamBufferGenericCreate( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER | sbTYPE_CACHE_MAINTAINED, NULL, NULL )
+
+#define xStreamBufferCreateStaticCacheMaintained( xBufferSizeBytes, xTriggerLevelBytes, pucStreamBufferStorageArea, pxStaticStreamBuffer ) \
+    xStreamBufferGenericCreateStatic( ( xBufferSizeBytes ), ( xTriggerLevelBytes ), sbTYPE_STREAM_BUFFER | sbTYPE_CACHE_MAINTAINED, ( pucStreamBufferStorageArea ), ( pxStaticStreamBuffer ), NULL, NULL )
+
 /**
  * stream_buffer.h
  *
@@ -357,6 +502,76 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                           size_t xDataLengthBytes,
                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+ *                            const StreamBufferFragment_t *pxFragments,
+ *                            size_t xFragmentCount,
+ *                            TickType_t xTicksToWait );
+ * @endcode
+ *
+ * A version of xStreamBufferSend() that gathers the data to send from
+ * xFragmentCount separate fragments, so data that is assembled from several
+ * buffers, such as a packet header, payload and trailer, does not first have to
+ * be copied into a single buffer.  The fragments are written to the stream
+ * buffer one after another, exactly as if their contents had been passed to a
+ * single call to xStreamBufferSend().  When used with a message buffer the
+ * fragments form a single message, with a single length, and a task waiting
+ * for data is only notified once.
+ *
+ * Uniquely among FreeRTOS objects, the stream buffer implementation (so also
+ * the message buffer implementation, as message buffers are built on top of
+ * stream buffers) assumes there is only one task or interrupt that will write
+ * to the buffer (the writer) - see xStreamBufferSend().
+ *
+ * @param xStreamBuffer The handle of the stream buffer to which the data is
+ * being sent.
+ *
+ * @param pxFragments A pointer to an array of xFragmentCount fragments that
+ * describe the data to send.  Fragments with a length of zero are skipped.
+ *
+ * @param xFragmentCount The number of fragments in the pxFragments array.
+ *
+ * @param xTicksToWait As for xStreamBufferSend().
+ *
+ * @return The number of bytes written to the stream buffer, which is at most
+ * the total length of all the fragments.  Fewer bytes are only written to a
+ * stream buffer, as for xStreamBufferSend().
+ *
+ * Example use:
+ * @code{c}
+ * void vSendPacket( StreamBufferHandle_t xMessageBuffer,
+ *                   const HeaderType_t *pxHeader,
+ *                   const uint8_t *pucPayload,
+ *                   size_t xPayloadLength )
+ * {
+ * StreamBufferFragment_t xFragments[ 2 ];
+ * size_t xBytesSent;
+ *
+ *  xFragments[ 0 ].pvData = pxHeader;
+ *  xFragments[ 0 ].xDataLengthBytes = sizeof( HeaderType_t );
+ *  xFragments[ 1 ].pvData = pucPayload;
+ *  xFragments[ 1 ].xDataLengthBytes = xPayloadLength;
+ *
+ *  // Send the header and payload as a single message.
+ *  xBytesSent = xStreamBufferSendV( xMessageBuffer, xFragments, 2, pdMS_TO_TICKS( 100 ) );
+ *
+ *  if( xBytesSent != ( sizeof( HeaderType_t ) + xPayloadLength ) )
+ *  {
+ *      // The message could not be sent before the block time expired.
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSendV xStreamBufferSendV
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                           const StreamBufferFragment_t * pxFragments,
+                           size_t xFragmentCount,
+                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -760,6 +975,86 @@ size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVIL
  */
 size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+
+/**
+ * Used with vStreamBufferGetStats() to obtain the usage statistics of a stream
+ * or message buffer.  All times are in ticks.  The byte counts of a message
+ * buffer include the bytes used to store each message's length.
+ */
+    typedef struct xSTREAM_BUFFER_STATS
+    {
+        UBaseType_t uxStreamBufferNumber;  /* The number set by vStreamBufferSetStreamBufferNumber(), so the statistics can be matched to trace output.  Always 0 if configUSE_TRACE_FACILITY is not 1. */
+        size_t xLength;                    /* The size of the buffer's storage area. */
+        size_t xBytesAvailable;            /* The number of bytes in the buffer now. */
+        size_t xBytesHighWater;            /* The most bytes the buffer has held. */
+        uint32_t ulSends;                  /* The number of sends that wrote data. */
+        uint32_t ulSendsFailed;            /* The number of sends that wrote nothing because the buffer was full. */
+        uint32_t ulBytesSent;              /* The number of bytes written. */
+        uint32_t ulReceives;               /* The number of receives that read data. */
+        uint32_t ulBytesReceived;          /* The number of bytes read. */
+        TickType_t xSendBlockedTicks;      /* The total time the writer has spent blocked waiting for space. */
+        TickType_t xReceiveBlockedTicks;   /* The total time the reader has spent blocked waiting for data. */
+        uint32_t ulOccupancyTicks;         /* The number of bytes in the buffer summed over every tick. */
+        TickType_t xAverageResidencyTicks; /* ulOccupancyTicks divided by ulBytesReceived - the average time a byte spent in the buffer. */
+    } StreamBufferStats_t;
+
+#endif /* configUSE_STREAM_BUFFER_STATS */
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer, StreamBufferStats_t * pxStreamBufferStats );
+ * @endcode
+ *
+ * Obtain the usage statistics of a stream buffer or message buffer.  The
+ * statistics accumulate from when the buffer was created, or from the last
+ * call to vStreamBufferResetStats() or xStreamBufferReset(), and are intended
+ * to help size buffers in the same way as vQueueGetStats() helps size queues.
+ *
+ * The counters are 32 bits and wrap.  The number of bytes in the buffer is
+ * only sampled when data is sent or received, so the occupancy sum, and the
+ * residency calculated from it, are estimates.
+ *
+ * configUSE_STREAM_BUFFER_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xStreamBuffer The handle of the buffer being queried.
+ *
+ * @param pxStreamBufferStats The structure into which the statistics are
+ * written.
+ *
+ * \defgroup vStreamBufferGetStats vStreamBufferGetStats
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+    void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer,
+                                StreamBufferStats_t * pxStreamBufferStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Clear the statistics returned by vStreamBufferGetStats().  The high water
+ * mark is set to the number of bytes in the buffer at the time of the call.
+ *
+ * configUSE_STREAM_BUFFER_STATS must be defined as 1 for this function to be
+ * available.
+ *
+ * @param xStreamBuffer The handle of the buffer whose statistics are cleared.
+ *
+ * \defgroup vStreamBufferResetStats vStreamBufferResetStats
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+    void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * stream_buffer.h
  *
@@ -798,6 +1093,470 @@ size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) PRIVILE
 BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
                                          size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
 
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferSetSendTriggerLevel( StreamBufferHandle_t xStreamBuffer, size_t xTriggerLevel );
+ * @endcode
+ *
+ * A stream buffer's send trigger level is the number of bytes that must be
+ * free in the stream buffer before a task that is blocked on the stream buffer
+ * to wait for space is moved out of the blocked state.  It is the writer side
+ * equivalent of the trigger level set by xStreamBufferSetTriggerLevel().  For
+ * example, if a task is blocked on a write to a full stream buffer that has a
+ * send trigger level of 1 then the task will be unblocked as soon as a single
+ * byte is read from the buffer.  If the send trigger level is 64 then the task
+ * will not be unblocked until reads have freed at least 64 bytes, or the task's
+ * block time expires, which avoids waking the writer for every small read.
+ * Setting a send trigger level of 0 will result in a send trigger level of 1
+ * being used.  It is not valid to specify a send trigger level that is greater
+ * than or equal to the buffer's length, as that much space can never be free.
+ *
+ * The send trigger level is 1 when the stream buffer is created, and is
+ * retained when the stream buffer is reset.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being updated.
+ *
+ * @param xTriggerLevel The new send trigger level for the stream buffer.
+ *
+ * @return If xTriggerLevel was less than the stream buffer's length then the
+ * send trigger level will be updated and pdTRUE is returned.  Otherwise
+ * pdFALSE is returned.
+ *
+ * \defgroup xStreamBufferSetSendTriggerLevel xStreamBufferSetSendTriggerLevel
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferSetSendTriggerLevel( StreamBufferHandle_t xStreamBuffer,
+                                             size_t xTriggerLevel ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+ *                                   uint8_t ** ppucData,
+ *                                   TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains a pointer into the stream buffer's own storage area so data can be
+ * written to the buffer in place - for example by a DMA engine - rather than
+ * being copied in by xStreamBufferSend().  The data only becomes visible to
+ * the reader once it has been committed with xStreamBufferCommitWrite() or
+ * xStreamBufferCommitWriteFromISR().
+ *
+ * The free space in a stream buffer may wrap around the end of its storage
+ * area, in which case only the part up to the end of the storage area is
+ * returned.  Once that part has been committed the next call returns the
+ * remaining space at the start of the storage area.
+ *
+ * Can only be used with stream buffers, not message buffers.  The same
+ * single writer restriction that applies to xStreamBufferSend() applies
+ * between the acquire and commit calls.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to write to.
+ *
+ * @param ppucData Set to point to the first free byte in the stream buffer.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for at least one byte of space to become
+ * available if the stream buffer is full.  Passing 0 means the function will
+ * return immediately.
+ *
+ * @return The number of contiguous bytes that can be written starting at
+ * *ppucData.  Zero is returned if the stream buffer is full.
+ *
+ * Example use:
+ * @code{c}
+ *
+ * void vStartRxDMA( StreamBufferHandle_t xStreamBuffer )
+ * {
+ * uint8_t *pucDMADestination;
+ * size_t xFreeSpace;
+ *
+ *  // Find where the next received bytes can be placed without blocking.
+ *  xFreeSpace = xStreamBufferAcquireWrite( xStreamBuffer, &pucDMADestination, 0 );
+ *
+ *  if( xFreeSpace > 0 )
+ *  {
+ *      // Start the DMA transfer.  The DMA complete interrupt calls
+ *      // xStreamBufferCommitWriteFromISR() with the number of bytes received.
+ *      vStartDMA( pucDMADestination, xFreeSpace );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferAcquireWrite xStreamBufferAcquireWrite
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                  uint8_t ** ppucData,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+ *                                      size_t xBytesWritten );
+ * @endcode
+ *
+ * Makes xBytesWritten bytes that were written in place, starting at the
+ * pointer obtained from xStreamBufferAcquireWrite(), available to the reader.
+ * As with xStreamBufferSend(), a task blocked waiting to receive from the
+ * stream buffer is unblocked once the number of bytes in the buffer reaches
+ * the buffer's trigger level.
+ *
+ * Use xStreamBufferCommitWriteFromISR() to commit data from an interrupt
+ * service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xBytesWritten The number of bytes written, which must not be more
+ * than the number returned by the preceding call to
+ * xStreamBufferAcquireWrite().
+ *
+ * @return pdPASS if the bytes were committed.  pdFAIL if xBytesWritten is
+ * larger than the contiguous free space, in which case the stream buffer is
+ * not changed.
+ *
+ * \defgroup xStreamBufferCommitWrite xStreamBufferCommitWrite
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesWritten ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                             size_t xBytesWritten,
+ *                                             BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferCommitWrite() that can be called from an
+ * interrupt service routine (ISR), such as a DMA complete interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was written to.
+ *
+ * @param xBytesWritten The number of bytes written, which must not be more
+ * than the number returned by the preceding call to
+ * xStreamBufferAcquireWrite().
+ *
+ * @param pxHigherPriorityTaskWoken It is possible that a stream buffer will
+ * have a task blocked on it waiting for data.  Committing data can cause that
+ * task to leave the Blocked state, in which case *pxHigherPriorityTaskWoken
+ * will be set to pdTRUE if the unblocked task has a priority higher than the
+ * currently executing task.  *pxHigherPriorityTaskWoken should be set to
+ * pdFALSE before it is passed into the function.
+ *
+ * @return pdPASS if the bytes were committed.  pdFAIL if xBytesWritten is
+ * larger than the contiguous free space, in which case the stream buffer is
+ * not changed.
+ *
+ * \defgroup xStreamBufferCommitWriteFromISR xStreamBufferCommitWriteFromISR
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xBytesWritten,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+ *                                  uint8_t ** ppucData,
+ *                                  TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Obtains a pointer to the data held in the stream buffer's own storage area
+ * so it can be processed, or handed to a DMA engine, in place rather than being
+ * copied out by xStreamBufferReceive().  The space used by the data is only
+ * returned to the writer once it has been released with
+ * xStreamBufferReleaseRead() or xStreamBufferReleaseReadFromISR().
+ *
+ * The data in a stream buffer may wrap around the end of its storage area, in
+ * which case only the part up to the end of the storage area is returned.
+ * Once that part has been released the next call returns the remaining data at
+ * the start of the storage area.
+ *
+ * Can only be used with stream buffers, not message buffers.  The same single
+ * reader restriction that applies to xStreamBufferReceive() applies between
+ * the acquire and release calls.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to read from.
+ *
+ * @param ppucData Set to point to the oldest byte held in the stream buffer.
+ *
+ * @param xTicksToWait The maximum amount of time the calling task should
+ * remain in the Blocked state to wait for data to become available if the
+ * stream buffer is empty.  As with xStreamBufferReceive(), the task is
+ * unblocked once the buffer's trigger level is reached.  Passing 0 means the
+ * function will return immediately.
+ *
+ * @return The number of contiguous bytes that can be read starting at
+ * *ppucData.  Zero is returned if the stream buffer is empty.
+ *
+ * \defgroup xStreamBufferAcquireRead xStreamBufferAcquireRead
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                 uint8_t ** ppucData,
+                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+ *                                      size_t xBytesRead );
+ * @endcode
+ *
+ * Returns the space used by xBytesRead bytes, starting at the pointer
+ * obtained from xStreamBufferAcquireRead(), to the writer.  As with
+ * xStreamBufferReceive(), a task blocked waiting for space in the stream
+ * buffer is unblocked.
+ *
+ * Use xStreamBufferReleaseReadFromISR() to release data from an interrupt
+ * service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was read from.
+ *
+ * @param xBytesRead The number of bytes consumed, which must not be more than
+ * the number returned by the preceding call to xStreamBufferAcquireRead().
+ *
+ * @return pdPASS if the bytes were released.  pdFAIL if xBytesRead is larger
+ * than the contiguous data, in which case the stream buffer is not changed.
+ *
+ * \defgroup xStreamBufferReleaseRead xStreamBufferReleaseRead
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesRead ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                             size_t xBytesRead,
+ *                                             BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferReleaseRead() that can be called from an
+ * interrupt service routine (ISR), such as a DMA complete interrupt.
+ *
+ * @param xStreamBuffer The handle of the stream buffer that was read from.
+ *
+ * @param xBytesRead The number of bytes consumed, which must not be more than
+ * the number returned by the preceding call to xStreamBufferAcquireRead().
+ *
+ * @param pxHigherPriorityTaskWoken It is possible that a stream buffer will
+ * have a task blocked on it waiting for space.  Releasing data can cause that
+ * task to leave the Blocked state, in which case *pxHigherPriorityTaskWoken
+ * will be set to pdTRUE if the unblocked task has a priority higher than the
+ * currently executing task.  *pxHigherPriorityTaskWoken should be set to
+ * pdFALSE before it is passed into the function.
+ *
+ * @return pdPASS if the bytes were released.  pdFAIL if xBytesRead is larger
+ * than the contiguous data, in which case the stream buffer is not changed.
+ *
+ * \defgroup xStreamBufferReleaseReadFromISR xStreamBufferReleaseReadFromISR
+ * \ingroup StreamBufferManagement
+ */
+BaseType_t xStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xBytesRead,
+                                            BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+ *                           void *pvRxData,
+ *                           size_t xBufferLengthBytes );
+ * @endcode
+ *
+ * Copies up to xBufferLengthBytes bytes from the front of a stream buffer into
+ * pvRxData without removing them from the stream buffer, so a parser can
+ * inspect the start of the stream, for example to find the length of the next
+ * frame, before deciding how much to receive.  The bytes remain available to
+ * the next call to xStreamBufferPeek(), xStreamBufferReceive() or
+ * xStreamBufferSkip().
+ *
+ * xStreamBufferPeek() does not block, and can be called from both tasks and
+ * interrupts.  Use xStreamBufferAcquireRead() with a block time to wait for
+ * data to arrive before peeking at it.  Only the reader of a stream buffer can
+ * peek at it.
+ *
+ * This function cannot be used with message buffers.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to peek at.
+ *
+ * @param pvRxData A pointer to the buffer into which the bytes are copied.
+ *
+ * @param xBufferLengthBytes The maximum number of bytes to copy.
+ *
+ * @return The number of bytes copied, which is the smaller of
+ * xBufferLengthBytes and the number of bytes in the stream buffer.
+ *
+ * \defgroup xStreamBufferPeek xStreamBufferPeek
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+                          void * pvRxData,
+                          size_t xBufferLengthBytes ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSkip( StreamBufferHandle_t xStreamBuffer,
+ *                           size_t xBytesToSkip );
+ * @endcode
+ *
+ * Removes up to xBytesToSkip bytes from the front of a stream buffer without
+ * copying them, for example to discard a frame header that has already been
+ * inspected with xStreamBufferPeek().  As with xStreamBufferReceive(), a task
+ * blocked waiting for space in the stream buffer is unblocked once enough
+ * space is free.  xStreamBufferSkip() does not block.
+ *
+ * Use xStreamBufferSkipFromISR() to skip data from an interrupt service
+ * routine (ISR).
+ *
+ * This function cannot be used with message buffers.
+ *
+ * @param xStreamBuffer The handle of the stream buffer to remove bytes from.
+ *
+ * @param xBytesToSkip The maximum number of bytes to remove.
+ *
+ * @return The number of bytes removed, which is the smaller of xBytesToSkip
+ * and the number of bytes in the stream buffer.
+ *
+ * Example use:
+ * @code{c}
+ * // Frames start with a two byte little endian length.
+ * size_t xReceiveFrame( StreamBufferHandle_t xStreamBuffer, uint8_t *pucFrame, size_t xFrameBufferLength )
+ * {
+ * uint8_t ucHeader[ 2 ];
+ * size_t xFrameLength;
+ *
+ *  if( xStreamBufferPeek( xStreamBuffer, ucHeader, sizeof( ucHeader ) ) != sizeof( ucHeader ) )
+ *  {
+ *      return 0;
+ *  }
+ *
+ *  xFrameLength = ( size_t ) ucHeader[ 0 ] | ( ( size_t ) ucHeader[ 1 ] << 8 );
+ *
+ *  if( xFrameLength > xFrameBufferLength )
+ *  {
+ *      // The frame is too big to receive, so drop it.
+ *      ( void ) xStreamBufferSkip( xStreamBuffer, sizeof( ucHeader ) + xFrameLength );
+ *      return 0;
+ *  }
+ *
+ *  ( void ) xStreamBufferSkip( xStreamBuffer, sizeof( ucHeader ) );
+ *
+ *  return xStreamBufferReceive( xStreamBuffer, pucFrame, xFrameLength, portMAX_DELAY );
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSkip xStreamBufferSkip
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSkip( StreamBufferHandle_t xStreamBuffer,
+                          size_t xBytesToSkip ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSkipFromISR( StreamBufferHandle_t xStreamBuffer,
+ *                                  size_t xBytesToSkip,
+ *                                  BaseType_t * const pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xStreamBufferSkip() that can be called from an interrupt
+ * service routine (ISR).
+ *
+ * @param xStreamBuffer The handle of the stream buffer to remove bytes from.
+ *
+ * @param xBytesToSkip The maximum number of bytes to remove.
+ *
+ * @param pxHigherPriorityTaskWoken It is possible that a stream buffer will
+ * have a task blocked on it waiting for space.  Removing bytes can cause that
+ * task to leave the Blocked state, in which case *pxHigherPriorityTaskWoken
+ * will be set to pdTRUE if the unblocked task has a priority higher than the
+ * currently executing task.  *pxHigherPriorityTaskWoken should be set to
+ * pdFALSE before it is passed into the function.
+ *
+ * @return The number of bytes removed.
+ *
+ * \defgroup xStreamBufferSkipFromISR xStreamBufferSkipFromISR
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSkipFromISR( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xBytesToSkip,
+                                 BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * size_t xStreamBufferSplice( StreamBufferHandle_t xDestination,
+ *                             StreamBufferHandle_t xSource,
+ *                             size_t xMaxBytes,
+ *                             TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Moves up to xMaxBytes bytes from the front of one stream buffer to the back
+ * of another, copying them directly from the source's storage area to the
+ * destination's.  Forwarding data by receiving it into a local array and then
+ * sending it copies every byte twice.
+ *
+ * The calling task acts as the reader of xSource and the writer of
+ * xDestination, so the single reader and single writer restrictions described
+ * for xStreamBufferReceive() and xStreamBufferSend() apply to it on each.  As
+ * with a send, a task waiting for data in the destination is unblocked once
+ * the destination's trigger level is reached, and as with a receive, a task
+ * waiting for space in the source is unblocked once the source's send trigger
+ * level of space is free.
+ *
+ * This function cannot be used with message buffers, and there is no interrupt
+ * safe version.
+ *
+ * @param xDestination The handle of the stream buffer the bytes are moved to.
+ *
+ * @param xSource The handle of the stream buffer the bytes are moved from.
+ *
+ * @param xMaxBytes The maximum number of bytes to move.
+ *
+ * @param xTicksToWait The maximum amount of time the task should remain in the
+ * Blocked state to wait for data in xSource and then for space in
+ * xDestination.  Passing 0 means the function will return immediately.
+ *
+ * @return The number of bytes moved, which is the smallest of xMaxBytes, the
+ * number of bytes in xSource and the free space in xDestination.
+ *
+ * Example use:
+ * @code{c}
+ * void vBridgeTask( void * pvParameters )
+ * {
+ *  for( ;; )
+ *  {
+ *      // Forward whatever the UART has received to the USB endpoint.
+ *      ( void ) xStreamBufferSplice( xUsbTxStreamBuffer, xUartRxStreamBuffer, 512, portMAX_DELAY );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xStreamBufferSplice xStreamBufferSplice
+ * \ingroup StreamBufferManagement
+ */
+size_t xStreamBufferSplice( StreamBufferHandle_t xDestination,
+                            StreamBufferHandle_t xSource,
+                            size_t xMaxBytes,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 /**
  * stream_buffer.h
  *
@@ -879,24 +1638,111 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer,
                                                  BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/* What xStreamBufferSendFromISR() does with data that does not all fit in a
+ * stream buffer, see xStreamBufferSetOverflowPolicy(). */
+#define sbOVERFLOW_PARTIAL_WRITE    ( ( BaseType_t ) 0 )
+#define sbOVERFLOW_DROP_NEWEST      ( ( BaseType_t ) 1 )
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * BaseType_t xStreamBufferSetOverflowPolicy( StreamBufferHandle_t xStreamBuffer,
+ *                                            BaseType_t xPolicy );
+ * @endcode
+ *
+ * Set what xStreamBufferSendFromISR() does when there is not enough space in
+ * the stream buffer for all the data being sent.  By default,
+ * sbOVERFLOW_PARTIAL_WRITE, as many bytes as fit are written and the rest are
+ * dropped.  With sbOVERFLOW_DROP_NEWEST nothing is written unless all the
+ * data fits, so a reader never sees a record an interrupt only partly wrote.
+ * Sends from tasks are not affected.
+ *
+ * Either way the bytes dropped are counted, see
+ * uxStreamBufferGetOverflowCount(), so interrupt handlers do not need to keep
+ * their own count.  The oldest data cannot be dropped to make room, as only
+ * the reader moves through the buffer - use a message buffer with a message
+ * lifetime, see xMessageBufferSetMessageLifetime(), for data that is worthless
+ * once newer data arrives.
+ *
+ * configUSE_OVERFLOW_POLICY must be set to 1 in FreeRTOSConfig.h for
+ * xStreamBufferSetOverflowPolicy() to be available.  The policy is retained
+ * when the stream buffer is reset.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being updated.
+ *
+ * @param xPolicy sbOVERFLOW_PARTIAL_WRITE or sbOVERFLOW_DROP_NEWEST.
+ *
+ * @return pdPASS if the policy was set.  pdFAIL if xStreamBuffer is a message
+ * buffer, which never writes part of a message.
+ *
+ * \defgroup xStreamBufferSetOverflowPolicy xStreamBufferSetOverflowPolicy
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+    BaseType_t xStreamBufferSetOverflowPolicy( StreamBufferHandle_t xStreamBuffer,
+                                               BaseType_t xPolicy ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * stream_buffer.h
+ *
+ * @code{c}
+ * UBaseType_t uxStreamBufferGetOverflowCount( StreamBufferHandle_t xStreamBuffer );
+ * @endcode
+ *
+ * Returns the number of bytes xStreamBufferSendFromISR() has dropped because
+ * there was not enough space in the stream buffer, or, for a message buffer,
+ * the number of messages dropped.  The count is a single word so can be read
+ * from any task or interrupt without a critical section.  It wraps to zero on
+ * overflow, so take the difference of two readings to find the amount dropped
+ * in between.
+ *
+ * configUSE_OVERFLOW_POLICY must be set to 1 in FreeRTOSConfig.h for
+ * uxStreamBufferGetOverflowCount() to be available.
+ *
+ * @param xStreamBuffer The handle of the stream buffer being queried.
+ *
+ * @return The number of bytes, or messages, dropped since the stream buffer
+ * was created or last reset.
+ *
+ * \defgroup uxStreamBufferGetOverflowCount uxStreamBufferGetOverflowCount
+ * \ingroup StreamBufferManagement
+ */
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+    UBaseType_t uxStreamBufferGetOverflowCount( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                  size_t xTriggerLevelBytes,
-                                                 BaseType_t xIsMessageBuffer,
+                                                 BaseType_t xStreamBufferType,
                                                  StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                                  StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) PRIVILEGED_FUNCTION;
 
 
 StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
                                                        size_t xTriggerLevelBytes,
-                                                       BaseType_t xIsMessageBuffer,
+                                                       BaseType_t xStreamBufferType,
                                                        uint8_t * const pucStreamBufferStorageArea,
                                                        StaticStreamBuffer_t * const pxStaticStreamBuffer,
                                                        StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                                        StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) PRIVILEGED_FUNCTION;
 
+size_t xStreamBufferReceiveBatch( StreamBufferHandle_t xStreamBuffer,
+                                  void * pvRxData,
+                                  size_t xBufferLengthBytes,
+                                  size_t * const pxMessageLengths,
+                                  size_t xMaxMessages,
+                                  TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
 size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+    BaseType_t xStreamBufferSetMessageLifetime( StreamBufferHandle_t xStreamBuffer,
+                                                TickType_t xLifetime ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_TRACE_FACILITY == 1 )
     void vStreamBufferSetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer,
                                              UBaseType_t uxStreamBufferNumber ) PRIVILEGED_FUNCTION;
@@ -904,6 +1750,14 @@ size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
     uint8_t ucStreamBufferGetStreamBufferType( StreamBufferHandle_t xStreamBuffer ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configENABLE_ACCESS_CONTROL_LIST == 1 ) )
+
+/* Grant or revoke an unprivileged task's access to a stream buffer, see
+ * vGrantAccessToKernelObject(). */
+    #define vGrantAccessToStreamBuffer( xTask, xStreamBuffer )     vGrantAccessToKernelObject( ( xTask ), ( xStreamBuffer ) )
+    #define vRevokeAccessToStreamBuffer( xTask, xStreamBuffer )    vRevokeAccessToKernelObject( ( xTask ), ( xStreamBuffer ) )
+#endif
+
 /* *INDENT-OFF* */
 #if defined( __cplusplus )
     }
@@ -73,6 +73,14 @@
  * array. */
 #define tskDEFAULT_INDEX_TO_NOTIFY     ( 0 )
 
+/* The bit that represents notification index uxIndex in the uxIndexMask
+ * parameter of xTaskNotifyWaitAny(). */
+#define tskNOTIFY_INDEX_BIT( uxIndex )    ( ( UBaseType_t ) 1U << ( uxIndex ) )
+
+/* Passed as the uxTasksToWake parameter of vTaskWakeAddress() to wake every
+ * task waiting on the address. */
+#define tskWAKE_ALL_TASKS                 ( ~( UBaseType_t ) 0U )
+
 /**
  * task. h
  *
@@ -122,6 +130,30 @@ typedef struct xTIME_OUT
     TickType_t xTimeOnEntering;
 } TimeOut_t;
 
+/*
+ * Used internally only.  Links a task into the event list of one of the
+ * objects it waits on with xQueueWaitForAny(), in place of the task's own event
+ * list item.
+ */
+typedef struct xTASK_WAIT_RECORD
+{
+    ListItem_t xEventListItem;
+    struct xTASK_WAIT_RECORD * pxNext;
+} TaskWaitRecord_t;
+
+/*
+ * Used with vTaskIteratorInit() and xTaskIteratorNext().  Only ulTotalRunTime
+ * is for use by the application.  The other members are used by the kernel to
+ * track the position of the iterator.
+ */
+typedef struct xTASK_ITERATOR
+{
+    void * pvNextTask;
+    UBaseType_t uxLastTCBNumber;
+    UBaseType_t uxTaskNumber;
+    configRUN_TIME_COUNTER_TYPE ulTotalRunTime; /* The run time counter value when vTaskIteratorInit() was called, for calculating percentages.  0 if configGENERATE_RUN_TIME_STATS is 0. */
+} TaskIterator_t;
+
 /*
  * Defines the memory ranges allocated to the task when an MPU is used.
  */
@@ -149,6 +181,19 @@ typedef struct xTASK_PARAMETERS
     #endif
 } TaskParameters_t;
 
+/* Describes one task to be created by xTaskCreateStaticBatch().  The members
+ * are the parameters of xTaskCreateStatic(). */
+typedef struct xTASK_STATIC_PARAMETERS
+{
+    TaskFunction_t pxTaskCode;
+    const char * pcName; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    uint32_t ulStackDepth;
+    void * pvParameters;
+    UBaseType_t uxPriority;
+    StackType_t * puxStackBuffer;
+    StaticTask_t * pxTaskBuffer;
+} TaskStaticParameters_t;
+
 /* Used with the uxTaskGetSystemState() function to return the state of each task
  * in the system. */
 typedef struct xTASK_STATUS
@@ -166,8 +211,85 @@ typedef struct xTASK_STATUS
         StackType_t * pxEndOfStack;               /* Points to the end address of the task's stack area. */
     #endif
     configSTACK_DEPTH_TYPE usStackHighWaterMark;  /* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        size_t xHeapBytesAllocated;               /* The heap memory, including block headers, held by blocks the task allocated and has not yet freed. */
+    #endif
+    #if ( configUSE_CORE_RUN_TIME_STATS == 1 )
+        UBaseType_t uxCoresRunOn;                 /* Bit N is set if the task has run on core N. */
+        UBaseType_t uxMigrations;                 /* The number of times the task has started running on a different core from the one it last ran on. */
+    #endif
 } TaskStatus_t;
 
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+/* Used with the vTaskWalkTasks() function to pass the state of each task to
+ * the function it calls. */
+    typedef struct xTASK_WALK_INFO
+    {
+        TaskHandle_t xHandle;                  /* The handle of the task to which the rest of the information in the structure relates. */
+        const char * pcTaskName;               /* A pointer to the task's name. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        eTaskState eCurrentState;              /* The state of the list the task was found on - a running task is reported as eReady, with xRunningOnCore set. */
+        BaseType_t xRunningOnCore;             /* The core the task was running on, or -1 if it was not running. */
+        UBaseType_t uxCurrentPriority;         /* The priority of the task, which may be inherited. */
+        UBaseType_t uxBasePriority;            /* The priority the task will return to once it has disinherited any priority.  The same as uxCurrentPriority if configUSE_MUTEXES is 0. */
+        StackType_t * pxTopOfStack;            /* The stack pointer saved when the task last stopped running. */
+        StackType_t * pxStackBase;             /* Points to the lowest address of the task's stack area. */
+        const StackType_t * pxStackWindow;     /* The lowest address of the stack window - the stack words nearest pxTopOfStack that are within the task's stack area. */
+        UBaseType_t uxStackWindowWords;        /* The number of words in the stack window, at most configPOST_MORTEM_STACK_WINDOW_WORDS.  0 if pxTopOfStack is outside the task's stack area. */
+    } TaskWalkInfo_t;
+
+    typedef void ( * TaskWalkFunction_t )( const TaskWalkInfo_t * pxInfo,
+                                           void * pvContext );
+
+/* Used with the vTaskGetKernelState() function to return the state of the
+ * scheduler. */
+    typedef struct xTASK_KERNEL_STATE
+    {
+        TickType_t xTickCount;                 /* The tick count. */
+        UBaseType_t uxNumberOfTasks;           /* The number of tasks that exist, including those waiting to be cleaned up by the idle task. */
+        BaseType_t xSchedulerState;            /* One of taskSCHEDULER_NOT_STARTED, taskSCHEDULER_RUNNING or taskSCHEDULER_SUSPENDED. */
+        UBaseType_t uxTopReadyPriority;        /* The highest priority that may have a ready task. */
+        TaskHandle_t xCurrentTasks[ configNUMBER_OF_CORES ]; /* The task running on each core. */
+    } TaskKernelState_t;
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
+
+/* Used with the xTaskGetISRWakeLatencyStats() function to return the time
+ * taken for a task to run after being unblocked by an interrupt.  All times are
+ * in run time counter ticks. */
+typedef struct xISR_WAKE_LATENCY_STATS
+{
+    configRUN_TIME_COUNTER_TYPE ulMinimum;                  /* The shortest latency measured.  Only valid if ulCount is not 0. */
+    configRUN_TIME_COUNTER_TYPE ulMaximum;                  /* The longest latency measured. */
+    configRUN_TIME_COUNTER_TYPE ulTotal;                    /* The sum of all the latencies measured, from which the mean can be calculated. */
+    uint32_t ulCount;                                       /* The number of latencies measured. */
+    uint32_t ulHistogram[ configISR_WAKE_LATENCY_BUCKETS ]; /* ulHistogram[ n ] counts the latencies of 2^n to 2^(n+1)-1 ticks.  Bucket 0 also counts latencies of 0, and the last bucket also counts all longer latencies. */
+} ISRWakeLatencyStats_t;
+
+/* Used with the vTaskGetCriticalSectionStats() and
+ * vTaskGetSchedulerSuspendStats() functions to return how long interrupts or
+ * the scheduler were held off.  All times are in run time counter ticks. */
+typedef struct xCRITICAL_SECTION_STATS
+{
+    configRUN_TIME_COUNTER_TYPE ulMaximum;                            /* The longest duration measured. */
+    void * pvMaximumCaller;                                           /* The return address of the call to taskENTER_CRITICAL(), taskENTER_CRITICAL_FROM_ISR() or vTaskSuspendAll() that started the longest duration, or NULL if portGET_RETURN_ADDRESS() is not available. */
+    uint32_t ulCount;                                                 /* The number of durations measured. */
+    uint32_t ulHistogram[ configCRITICAL_SECTION_PROFILING_BUCKETS ]; /* ulHistogram[ n ] counts the durations of 2^n to 2^(n+1)-1 ticks.  Bucket 0 also counts durations of 0, and the last bucket also counts all longer durations. */
+} CriticalSectionStats_t;
+
+/* Used with the vTaskGetPeriodicStats() function to return how punctually a
+ * task that calls xTaskDelayUntil() ran.  A release is each return from
+ * xTaskDelayUntil(), and its lateness is the number of ticks between the wake
+ * time passed to xTaskDelayUntil() and the task running again. */
+typedef struct xTASK_PERIODIC_STATS
+{
+    TickType_t xLatenessMin;                                  /* The smallest lateness measured.  Only valid if ulReleases is not 0. */
+    TickType_t xLatenessMax;                                  /* The largest lateness measured. */
+    uint32_t ulReleases;                                      /* The number of releases measured. */
+    uint32_t ulOverruns;                                      /* The number of calls to xTaskDelayUntil() that returned pdFALSE because the next release had already passed, meaning the task missed its period. */
+    uint32_t ulHistogram[ configPERIODIC_TASK_STATS_BUCKETS ]; /* ulHistogram[ n ] counts the lateness of 2^n to 2^(n+1)-1 ticks.  Bucket 0 also counts lateness of 0, and the last bucket also counts all greater lateness. */
+} TaskPeriodicStats_t;
+
 /* Possible return values for eTaskConfirmSleepModeStatus(). */
 typedef enum
 {
@@ -178,6 +300,45 @@ typedef enum
     #endif /* INCLUDE_vTaskSuspend */
 } eSleepModeStatus;
 
+/* A low power state that the sleep state governor can select when the idle
+ * task suppresses the tick.  Used with vTaskSetSleepStates(). */
+typedef struct xSLEEP_STATE
+{
+    TickType_t xEntryLatency;                                  /* The time taken to enter the state, in ticks. */
+    TickType_t xExitLatency;                                   /* The time taken to resume execution after the wake up event, in ticks. */
+    TickType_t xMinimumResidency;                              /* The shortest time the state must be held for its entry and exit to save energy, in ticks. */
+    void ( * pxEnterState )( TickType_t * pxExpectedIdleTime ); /* Called from configPRE_SLEEP_PROCESSING() to prepare the state.  May set *pxExpectedIdleTime to 0 to skip the wait for interrupt, as described for configPRE_SLEEP_PROCESSING(). */
+    void ( * pxExitState )( TickType_t xExpectedIdleTime );     /* Called from configPOST_SLEEP_PROCESSING() to leave the state. */
+} SleepState_t;
+
+#if ( configUSE_IDLE_WORK == 1 )
+
+/* The function called by the idle task to run one slice of an item of idle
+ * work.  Returns pdTRUE if the item has more work to do, or pdFALSE if it is
+ * complete. */
+    typedef BaseType_t ( * IdleWorkFunction_t )( void * pvParameter );
+
+/* An item of background work queued with xTaskQueueIdleWork().  The memory is
+ * provided by the caller, but the members are private to the kernel. */
+    typedef struct xIDLE_WORK
+    {
+        ListItem_t xListItem;          /* Links the item into the idle work list, highest priority first. */
+        IdleWorkFunction_t pxFunction; /* Runs one slice of the work. */
+        void * pvParameter;            /* Passed to pxFunction. */
+    } IdleWork_t;
+#endif
+
+/* Selects the window queried by ulTaskGetWindowedRunTimeCounter() and the
+ * related functions.  The window lengths are set by
+ * configRUN_TIME_WINDOW_SHORT_PERIODS, configRUN_TIME_WINDOW_MEDIUM_PERIODS and
+ * configRUN_TIME_WINDOW_LONG_PERIODS, which default to 1, 10 and 60 seconds. */
+typedef enum
+{
+    eRunTimeWindowShort = 0,
+    eRunTimeWindowMedium,
+    eRunTimeWindowLong
+} eRunTimeWindow;
+
 /**
  * Defines the priority used by the idle task.  This must not be modified.
  *
@@ -185,6 +346,30 @@ typedef enum
  */
 #define tskIDLE_PRIORITY    ( ( UBaseType_t ) 0U )
 
+/**
+ * Defines the affinity mask that allows a task to run on any core.  Used with
+ * the core affinity API when configUSE_CORE_AFFINITY is set to 1.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskNO_AFFINITY      ( ( UBaseType_t ) -1 )
+
+/**
+ * The number of windows selectable by eRunTimeWindow.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskRUN_TIME_WINDOWS    3
+
+/**
+ * The criticality levels of tasks and timers, and the criticality modes of
+ * the kernel, used when configUSE_MIXED_CRITICALITY is set to 1.
+ *
+ * \ingroup TaskUtils
+ */
+#define tskCRITICALITY_LOW     ( ( UBaseType_t ) 0U )
+#define tskCRITICALITY_HIGH    ( ( UBaseType_t ) 1U )
+
 /**
  * task. h
  *
@@ -207,8 +392,17 @@ typedef enum
  * \defgroup taskENTER_CRITICAL taskENTER_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskENTER_CRITICAL()               portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR()      portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+    #define taskENTER_CRITICAL()             vTaskProfiledEnterCritical()
+    #define taskENTER_CRITICAL_FROM_ISR()    uxTaskProfiledEnterCriticalFromISR()
+#else
+    #define taskENTER_CRITICAL()             portENTER_CRITICAL()
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define taskENTER_CRITICAL_FROM_ISR()    portSET_INTERRUPT_MASK_FROM_ISR()
+    #else
+        #define taskENTER_CRITICAL_FROM_ISR()    portENTER_CRITICAL_FROM_ISR()
+    #endif
+#endif
 
 /**
  * task. h
@@ -222,8 +416,17 @@ typedef enum
  * \defgroup taskEXIT_CRITICAL taskEXIT_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+    #define taskEXIT_CRITICAL()                vTaskProfiledExitCritical()
+    #define taskEXIT_CRITICAL_FROM_ISR( x )    vTaskProfiledExitCriticalFromISR( x )
+#else
+    #define taskEXIT_CRITICAL()                portEXIT_CRITICAL()
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define taskEXIT_CRITICAL_FROM_ISR( x )    portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+    #else
+        #define taskEXIT_CRITICAL_FROM_ISR( x )    portEXIT_CRITICAL_FROM_ISR( x )
+    #endif
+#endif
 
 /**
  * task. h
@@ -295,7 +498,7 @@ typedef enum
  *
  * @param pcName A descriptive name for the task.  This is mainly used to
  * facilitate debugging.  Max length defined by configMAX_TASK_NAME_LEN - default
- * is 16.
+ * is 16.  See configTASK_NAME_STORAGE for how the name is held.
  *
  * @param usStackDepth The size of the task stack specified as the number of
  * variables the stack can hold - not the number of bytes.  For example, if
@@ -360,6 +563,104 @@ typedef enum
                             TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
+ *                                    const char * const pcName,
+ *                                    const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                    void * const pvParameters,
+ *                                    UBaseType_t uxPriority,
+ *                                    UBaseType_t uxCoreAffinityMask,
+ *                                    TaskHandle_t * const pxCreatedTask );
+ * @endcode
+ *
+ * The same as xTaskCreate(), but the core affinity of the task is set before
+ * the task can be selected to run.  configUSE_CORE_AFFINITY must be set to 1
+ * for this function to be available.
+ *
+ * @param uxCoreAffinityMask Bit N of the mask is set if the task is allowed to
+ * run on core N.  Use tskNO_AFFINITY to allow the task to run on any core.
+ *
+ * \defgroup xTaskCreateAffinitySet xTaskCreateAffinitySet
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
+                                       const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                       const configSTACK_DEPTH_TYPE usStackDepth,
+                                       void * const pvParameters,
+                                       UBaseType_t uxPriority,
+                                       UBaseType_t uxCoreAffinityMask,
+                                       TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskCreateDeadline( TaskFunction_t pxTaskCode,
+ *                                 const char * const pcName,
+ *                                 const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                 void * const pvParameters,
+ *                                 TickType_t xPeriod,
+ *                                 TickType_t xRelativeDeadline,
+ *                                 TaskHandle_t * const pxCreatedTask );
+ * @endcode
+ *
+ * Create a task that is scheduled earliest deadline first.  The task runs at
+ * priority configEDF_PRIORITY, and among the tasks at that priority the ready
+ * task with the earliest absolute deadline always runs.  Tasks at higher
+ * priorities still preempt it.  configUSE_EDF_SCHEDULING must be set to 1 for
+ * this function to be available.
+ *
+ * The first release of the task is the time it is created.  Each call the task
+ * makes to xTaskDelayUntil() marks the end of the current release and sets its
+ * deadline to xRelativeDeadline ticks after the wake time, which is the next
+ * release.  traceTASK_DEADLINE_MISSED() is called if a release ends after its
+ * deadline.  A deadline is not inherited through a mutex.
+ *
+ * @param xPeriod The minimum time, in ticks, between the releases of the
+ * task.  Pass the same value to xTaskDelayUntil().
+ *
+ * @param xRelativeDeadline The deadline of each release, in ticks after the
+ * release.  Must be greater than 0 and not greater than xPeriod.
+ *
+ * Other parameters and the return value are as for xTaskCreate().
+ *
+ * Example usage:
+ * @code{c}
+ * void vControlLoop( void * pvParameters )
+ * {
+ * TickType_t xLastRelease = xTaskGetTickCount();
+ *
+ *   for( ;; )
+ *   {
+ *       // Run one iteration of the control loop, which must complete
+ *       // within 4 ticks of its release.
+ *       vRunControlLoop();
+ *
+ *       xTaskDelayUntil( &xLastRelease, 10 );
+ *   }
+ * }
+ *
+ * void vAFunction( void )
+ * {
+ *   xTaskCreateDeadline( vControlLoop, "CTRL", STACK_SIZE, NULL, 10, 4, NULL );
+ * }
+ * @endcode
+ * \defgroup xTaskCreateDeadline xTaskCreateDeadline
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+    BaseType_t xTaskCreateDeadline( TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const configSTACK_DEPTH_TYPE usStackDepth,
+                                    void * const pvParameters,
+                                    TickType_t xPeriod,
+                                    TickType_t xRelativeDeadline,
+                                    TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -478,6 +779,110 @@ typedef enum
                                     StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
 #endif /* configSUPPORT_STATIC_ALLOCATION */
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t xTaskCreateStaticBatch( const TaskStaticParameters_t * const pxTaskTable,
+ *                                     UBaseType_t uxNumberOfTasks,
+ *                                     TaskHandle_t * const pxCreatedTasks );
+ * @endcode
+ *
+ * Creates every task described by a table, as if xTaskCreateStatic() had been
+ * called for each entry in turn, for use when the application starts.  Each
+ * task is initialised first, then all the tasks are added to the ready lists
+ * within a single critical section, so none can run until all are ready.
+ *
+ * configSUPPORT_STATIC_ALLOCATION must be set to 1 for this function to be
+ * available.  It must be called before the scheduler is started.
+ * Setting configSTACK_FILL_LIMIT_WORDS also reduces the time taken to
+ * initialise tasks with large stacks.
+ *
+ * @param pxTaskTable An array of uxNumberOfTasks task descriptions.  See
+ * xTaskCreateStatic() for a description of each member.  An entry with a NULL
+ * puxStackBuffer or pxTaskBuffer is not created.
+ *
+ * @param uxNumberOfTasks The number of entries in pxTaskTable.
+ *
+ * @param pxCreatedTasks If not NULL, an array of uxNumberOfTasks handles that
+ * is filled with the handle of the task created from the matching entry of
+ * pxTaskTable, or NULL if the entry was not created.
+ *
+ * @return The number of tasks created.
+ *
+ * \defgroup xTaskCreateStaticBatch xTaskCreateStaticBatch
+ * \ingroup Tasks
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    UBaseType_t xTaskCreateStaticBatch( const TaskStaticParameters_t * const pxTaskTable,
+                                        UBaseType_t uxNumberOfTasks,
+                                        TaskHandle_t * const pxCreatedTasks ) PRIVILEGED_FUNCTION;
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+/**
+ * task. h
+ * @code{c}
+ * TaskHandle_t xTaskCreateStaticAffinitySet( TaskFunction_t pxTaskCode,
+ *                                            const char * const pcName,
+ *                                            const uint32_t ulStackDepth,
+ *                                            void * const pvParameters,
+ *                                            UBaseType_t uxPriority,
+ *                                            StackType_t * const puxStackBuffer,
+ *                                            StaticTask_t * const pxTaskBuffer,
+ *                                            UBaseType_t uxCoreAffinityMask );
+ * @endcode
+ *
+ * The same as xTaskCreateStatic(), but the core affinity of the task is set
+ * before the task can be selected to run.  configUSE_CORE_AFFINITY must be set
+ * to 1 for this function to be available.
+ *
+ * @param uxCoreAffinityMask Bit N of the mask is set if the task is allowed to
+ * run on core N.  Use tskNO_AFFINITY to allow the task to run on any core.
+ *
+ * \defgroup xTaskCreateStaticAffinitySet xTaskCreateStaticAffinitySet
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_CORE_AFFINITY == 1 ) )
+    TaskHandle_t xTaskCreateStaticAffinitySet( TaskFunction_t pxTaskCode,
+                                               const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                               const uint32_t ulStackDepth,
+                                               void * const pvParameters,
+                                               UBaseType_t uxPriority,
+                                               StackType_t * const puxStackBuffer,
+                                               StaticTask_t * const pxTaskBuffer,
+                                               UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TaskHandle_t xTaskCreateStaticDeadline( TaskFunction_t pxTaskCode,
+ *                                         const char * const pcName,
+ *                                         const uint32_t ulStackDepth,
+ *                                         void * const pvParameters,
+ *                                         TickType_t xPeriod,
+ *                                         TickType_t xRelativeDeadline,
+ *                                         StackType_t * const puxStackBuffer,
+ *                                         StaticTask_t * const pxTaskBuffer );
+ * @endcode
+ *
+ * The same as xTaskCreateDeadline(), but the memory used by the task is
+ * provided as for xTaskCreateStatic().  configUSE_EDF_SCHEDULING must be set
+ * to 1 for this function to be available.
+ *
+ * \defgroup xTaskCreateStaticDeadline xTaskCreateStaticDeadline
+ * \ingroup Tasks
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_EDF_SCHEDULING == 1 ) )
+    TaskHandle_t xTaskCreateStaticDeadline( TaskFunction_t pxTaskCode,
+                                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                            const uint32_t ulStackDepth,
+                                            void * const pvParameters,
+                                            TickType_t xPeriod,
+                                            TickType_t xRelativeDeadline,
+                                            StackType_t * const puxStackBuffer,
+                                            StaticTask_t * const pxTaskBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -696,6 +1101,41 @@ typedef enum
 void vTaskAllocateMPURegions( TaskHandle_t xTask,
                               const MemoryRegion_t * const pxRegions ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vGrantAccessToKernelObject( TaskHandle_t xTask, const void * pvObject );
+ * void vRevokeAccessToKernelObject( TaskHandle_t xTask, const void * pvObject );
+ * @endcode
+ *
+ * Only available when configENABLE_ACCESS_CONTROL_LIST is set to 1, and can
+ * only be called from privileged code.
+ *
+ * Grants or revokes an unprivileged task's access to a kernel object - a
+ * queue, semaphore, event group, stream or message buffer, timer, or another
+ * task.  The MPU wrappers fail any call an unprivileged task makes on an
+ * object it has no access to.  A task always has access to itself and to the
+ * objects it creates.  The vGrantAccessToQueue(), vGrantAccessToTask() and
+ * similar macros in each object's header call these functions.
+ *
+ * @param xTask The task to grant or revoke access for.  Passing NULL uses the
+ * calling task.
+ *
+ * @param pvObject The handle of the kernel object.
+ *
+ * \defgroup vGrantAccessToKernelObject vGrantAccessToKernelObject
+ * \ingroup Tasks
+ */
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configENABLE_ACCESS_CONTROL_LIST == 1 ) )
+    void vGrantAccessToKernelObject( TaskHandle_t xTask,
+                                     const void * pvObject ) PRIVILEGED_FUNCTION;
+    void vRevokeAccessToKernelObject( TaskHandle_t xTask,
+                                      const void * pvObject ) PRIVILEGED_FUNCTION;
+
+    #define vGrantAccessToTask( xTask, xTaskToAccess )     vGrantAccessToKernelObject( ( xTask ), ( xTaskToAccess ) )
+    #define vRevokeAccessToTask( xTask, xTaskToAccess )    vRevokeAccessToKernelObject( ( xTask ), ( xTaskToAccess ) )
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -793,6 +1233,50 @@ void vTaskDelete( TaskHandle_t xTaskToDelete ) PRIVILEGED_FUNCTION;
  */
 void vTaskDelay( const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskDelayWithSlack( const TickType_t xTicksToDelay, const TickType_t xSlackInTicks );
+ * @endcode
+ *
+ * Delay a task for at least xTicksToDelay ticks, and at most xTicksToDelay
+ * plus xSlackInTicks ticks.  If another task is already due to leave the
+ * Blocked state within that window then the calling task is delayed until the
+ * same tick, otherwise it is delayed for exactly xTicksToDelay ticks, as if
+ * vTaskDelay() had been called.  Waking tasks together in this way reduces the
+ * number of times the tick has to be resumed when configUSE_TICKLESS_IDLE is
+ * used.
+ *
+ * INCLUDE_vTaskDelay and configUSE_TIMER_SLACK must be defined as 1 for this
+ * function to be available.
+ *
+ * @param xTicksToDelay The minimum amount of time, in tick periods, that the
+ * calling task should block.
+ *
+ * @param xSlackInTicks The maximum number of ticks by which the delay can be
+ * extended.
+ *
+ * Example usage:
+ *
+ * void vSensorTask( void * pvParameters )
+ * {
+ *   for( ;; )
+ *   {
+ *       // Sample roughly once a second, but it does not matter if the sample
+ *       // is up to 100ms late.
+ *       vSampleSensor();
+ *       vTaskDelayWithSlack( pdMS_TO_TICKS( 1000 ), pdMS_TO_TICKS( 100 ) );
+ *   }
+ * }
+ *
+ * \defgroup vTaskDelayWithSlack vTaskDelayWithSlack
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIMER_SLACK == 1 )
+    void vTaskDelayWithSlack( const TickType_t xTicksToDelay,
+                              const TickType_t xSlackInTicks ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1091,72 +1575,114 @@ void vTaskPrioritySet( TaskHandle_t xTask,
 /**
  * task. h
  * @code{c}
- * void vTaskSuspend( TaskHandle_t xTaskToSuspend );
+ * void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask );
  * @endcode
  *
- * INCLUDE_vTaskSuspend must be defined as 1 for this function to be available.
- * See the configuration section for more information.
+ * configUSE_CORE_AFFINITY must be defined as 1 for this function to be
+ * available.
  *
- * Suspend any task.  When suspended a task will never get any microcontroller
- * processing time, no matter what its priority.
+ * Sets the core affinity mask of a task, which controls the cores the task
+ * can run on.  If the task is running on a core it is no longer allowed to run
+ * on then that core is made to select another task.
  *
- * Calls to vTaskSuspend are not accumulative -
- * i.e. calling vTaskSuspend () twice on the same task still only requires one
- * call to vTaskResume () to ready the suspended task.
+ * @param xTask The handle of the task to set the core affinity mask for.
+ * Passing NULL sets the core affinity mask of the calling task.
  *
- * @param xTaskToSuspend Handle to the task being suspended.  Passing a NULL
- * handle will cause the calling task to be suspended.
+ * @param uxCoreAffinityMask Bit N of the mask is set if the task is allowed to
+ * run on core N.  For example, to allow a task to run on core 0 and core 1 set
+ * uxCoreAffinityMask to 0x03.  Use tskNO_AFFINITY to allow the task to run on
+ * any core.
  *
  * Example usage:
  * @code{c}
+ * // The network RX task is only allowed to run on core 1.
  * void vAFunction( void )
  * {
  * TaskHandle_t xHandle;
  *
- *   // Create a task, storing the handle.
- *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
+ *   xTaskCreate( vNetworkRxTask, "NetRX", STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, &xHandle );
+ *   vTaskCoreAffinitySet( xHandle, ( 1 << 1 ) );
+ * }
+ * @endcode
+ * \defgroup vTaskCoreAffinitySet vTaskCoreAffinitySet
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_CORE_AFFINITY == 1 )
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask );
+ * @endcode
  *
- *   // ...
+ * configUSE_CORE_AFFINITY must be defined as 1 for this function to be
+ * available.
  *
- *   // Use the handle to suspend the created task.
- *   vTaskSuspend( xHandle );
+ * @param xTask The handle of the task to get the core affinity mask for.
+ * Passing NULL gets the core affinity mask of the calling task.
  *
- *   // ...
+ * @return The core affinity mask of the task.  Bit N of the mask is set if
+ * the task is allowed to run on core N.
  *
- *   // The created task will not run during this period, unless
- *   // another task calls vTaskResume( xHandle ).
+ * \defgroup vTaskCoreAffinityGet vTaskCoreAffinityGet
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_CORE_AFFINITY == 1 )
+    UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * uint32_t ulTaskGetCrossCoreYieldCount( void );
+ * @endcode
  *
- *   //...
+ * configUSE_WAKE_AFFINITY must be defined as 1 for this function to be
+ * available.
  *
+ * Returns the number of times the scheduler has interrupted another core to
+ * make it select a new task, for example because a task readied on one core
+ * had to preempt a task running on another.  Comparing the count over a period
+ * with the number of context switches shows how many of them cost an
+ * inter-processor interrupt.  The count wraps on overflow.
  *
- *   // Suspend ourselves.
- *   vTaskSuspend( NULL );
+ * @return The number of cross-core yields since the scheduler was started.
  *
- *   // We cannot get here unless another task calls vTaskResume
- *   // with our handle as the parameter.
- * }
- * @endcode
- * \defgroup vTaskSuspend vTaskSuspend
+ * \defgroup ulTaskGetCrossCoreYieldCount ulTaskGetCrossCoreYieldCount
  * \ingroup TaskCtrl
  */
-void vTaskSuspend( TaskHandle_t xTaskToSuspend ) PRIVILEGED_FUNCTION;
+#if ( configUSE_WAKE_AFFINITY == 1 )
+    uint32_t ulTaskGetCrossCoreYieldCount( void ) PRIVILEGED_FUNCTION;
+#endif
 
 /**
  * task. h
  * @code{c}
- * void vTaskResume( TaskHandle_t xTaskToResume );
+ * void vTaskSetBudget( TaskHandle_t xTask, TickType_t xBudgetTicks, TickType_t xPeriodTicks );
  * @endcode
  *
- * INCLUDE_vTaskSuspend must be defined as 1 for this function to be available.
- * See the configuration section for more information.
+ * Limit the time a task can run for to xBudgetTicks ticks in every
+ * xPeriodTicks ticks.  configUSE_TASK_BUDGETS must be defined as 1 for this
+ * function to be available.
  *
- * Resumes a suspended task.
+ * The task that is running when a tick interrupt occurs is charged for that
+ * tick.  A task that uses all of its budget is throttled - it is placed in the
+ * Blocked state until the start of its next budget period, so it cannot
+ * starve lower priority tasks however it misbehaves.  xTaskAbortDelay() cannot
+ * release a throttled task.  traceTASK_BUDGET_EXHAUSTED() is called when a
+ * task is throttled.
  *
- * A task that has been suspended by one or more calls to vTaskSuspend ()
- * will be made available for running again by a single call to
- * vTaskResume ().
+ * @param xTask The handle of the task to set the budget of.  Passing NULL sets
+ * the budget of the calling task.  Idle tasks cannot be given a budget.
  *
- * @param xTaskToResume Handle to the task being readied.
+ * @param xBudgetTicks The number of ticks the task can run for in each budget
+ * period.  Passing 0 removes the budget of the task.
+ *
+ * @param xPeriodTicks The length of the budget period in ticks, which must not
+ * be less than xBudgetTicks.  The first period starts when the budget is set.
  *
  * Example usage:
  * @code{c}
@@ -1164,38 +1690,420 @@ void vTaskSuspend( TaskHandle_t xTaskToSuspend ) PRIVILEGED_FUNCTION;
  * {
  * TaskHandle_t xHandle;
  *
- *   // Create a task, storing the handle.
- *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
- *
- *   // ...
- *
- *   // Use the handle to suspend the created task.
- *   vTaskSuspend( xHandle );
- *
- *   // ...
- *
- *   // The created task will not run during this period, unless
- *   // another task calls vTaskResume( xHandle ).
- *
- *   //...
- *
- *
- *   // Resume the suspended task ourselves.
- *   vTaskResume( xHandle );
+ *   xTaskCreate( vLoggingTask, "LOG", STACK_SIZE, NULL, tskIDLE_PRIORITY + 3, &xHandle );
  *
- *   // The created task will once again get microcontroller processing
- *   // time in accordance with its priority within the system.
+ *   // Allow the logging task at most 10ms of every 100ms.
+ *   vTaskSetBudget( xHandle, pdMS_TO_TICKS( 10 ), pdMS_TO_TICKS( 100 ) );
  * }
  * @endcode
- * \defgroup vTaskResume vTaskResume
+ * \defgroup vTaskSetBudget vTaskSetBudget
  * \ingroup TaskCtrl
  */
-void vTaskResume( TaskHandle_t xTaskToResume ) PRIVILEGED_FUNCTION;
+#if ( configUSE_TASK_BUDGETS == 1 )
+    void vTaskSetBudget( TaskHandle_t xTask,
+                         TickType_t xBudgetTicks,
+                         TickType_t xPeriodTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * One window of a partition schedule, see vTaskSetPartitionSchedule().
+ */
+typedef struct xTIME_PARTITION_WINDOW
+{
+    UBaseType_t uxPartition;   /* The partition whose tasks can run during the window, or 0 for a window in which only tasks that are not in a partition can run. */
+    TickType_t xDurationTicks; /* The length of the window in ticks. */
+} TimePartitionWindow_t;
 
 /**
  * task. h
  * @code{c}
- * void xTaskResumeFromISR( TaskHandle_t xTaskToResume );
+ * void vTaskSetPartitionSchedule( const TimePartitionWindow_t * const pxWindows, UBaseType_t uxNumberOfWindows );
+ * @endcode
+ *
+ * Set the schedule that divides processor time between time partitions.
+ * configUSE_TIME_PARTITIONS must be defined as 1 for this function to be
+ * available.
+ *
+ * The windows run one after the other, and the schedule repeats once the last
+ * window ends, so the sum of the window durations is the major frame.  During
+ * each window only the tasks of the window's partition, and the tasks that
+ * are not in a partition, can run.  Tasks of other partitions that become
+ * ready to run wait for a window of their own partition, however high their
+ * priority, so a partition always receives its windows whatever the other
+ * partitions do.  Within a window tasks are scheduled by priority as normal.
+ *
+ * Tasks that are not in a partition, which includes the idle and timer
+ * tasks, can run in every window if configTIME_PARTITION_DONATE_IDLE_TIME is
+ * 1, otherwise only in windows of partition 0 (the idle task can always run).
+ * Their time is not isolated from the partitions, so they should be given a
+ * priority below every partitioned task unless they only run briefly.
+ *
+ * Tasks in different partitions should not share mutexes, as a task that
+ * inherits priority cannot run outside its partition's windows.
+ *
+ * If called before the scheduler is started the first window starts with the
+ * scheduler, otherwise it starts immediately.  Switching partitions takes
+ * time proportional to the number of ready tasks.
+ *
+ * @param pxWindows The windows of the schedule.  The array is used in place,
+ * so must remain valid while it is the schedule.
+ *
+ * @param uxNumberOfWindows The number of windows in pxWindows.
+ *
+ * Example usage:
+ * @code{c}
+ * // Partition 1 gets 4ms in every 10ms, partition 2 gets 5ms, and 1ms is
+ * // left for the tasks that are not in a partition.
+ * static const TimePartitionWindow_t xSchedule[] =
+ * {
+ *  { 1, pdMS_TO_TICKS( 4 ) },
+ *  { 2, pdMS_TO_TICKS( 5 ) },
+ *  { 0, pdMS_TO_TICKS( 1 ) }
+ * };
+ *
+ * void main( void )
+ * {
+ * TaskHandle_t xControl, xLogging;
+ *
+ *   xTaskCreate( vControlTask, "CTL", STACK_SIZE, NULL, tskIDLE_PRIORITY + 2, &xControl );
+ *   xTaskCreate( vLoggingTask, "LOG", STACK_SIZE, NULL, tskIDLE_PRIORITY + 3, &xLogging );
+ *   vTaskSetPartition( xControl, 1 );
+ *   vTaskSetPartition( xLogging, 2 );
+ *
+ *   vTaskSetPartitionSchedule( xSchedule, sizeof( xSchedule ) / sizeof( xSchedule[ 0 ] ) );
+ *   vTaskStartScheduler();
+ * }
+ * @endcode
+ * \defgroup vTaskSetPartitionSchedule vTaskSetPartitionSchedule
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_PARTITIONS == 1 )
+    void vTaskSetPartitionSchedule( const TimePartitionWindow_t * const pxWindows,
+                                    UBaseType_t uxNumberOfWindows ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetPartition( TaskHandle_t xTask, UBaseType_t uxPartition );
+ * @endcode
+ *
+ * Move a task to a time partition.  configUSE_TIME_PARTITIONS must be defined
+ * as 1 for this function to be available.  Tasks are created outside of any
+ * partition, so are best moved to their partition before the scheduler is
+ * started.
+ *
+ * @param xTask The handle of the task to move.  Passing NULL moves the calling
+ * task.  The idle task cannot be moved.
+ *
+ * @param uxPartition The partition, from 1 to configNUMBER_OF_TIME_PARTITIONS,
+ * or 0 to remove the task from its partition.
+ *
+ * \defgroup vTaskSetPartition vTaskSetPartition
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_PARTITIONS == 1 )
+    void vTaskSetPartition( TaskHandle_t xTask,
+                            UBaseType_t uxPartition ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetPartition( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * Returns the time partition of a task, or 0 if it is not in a partition.
+ * Passing NULL returns the partition of the calling task.
+ *
+ * \defgroup uxTaskGetPartition uxTaskGetPartition
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_PARTITIONS == 1 )
+    UBaseType_t uxTaskGetPartition( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetActivePartition( void );
+ * @endcode
+ *
+ * Returns the partition that owns the current window of the partition
+ * schedule, or 0 if no schedule has been started.
+ *
+ * \defgroup uxTaskGetActivePartition uxTaskGetActivePartition
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_TIME_PARTITIONS == 1 )
+    UBaseType_t uxTaskGetActivePartition( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetCriticality( TaskHandle_t xTask, UBaseType_t uxCriticality );
+ * @endcode
+ *
+ * Set the criticality of a task.  configUSE_MIXED_CRITICALITY must be defined
+ * as 1 for this function to be available.  Tasks are created with
+ * tskCRITICALITY_HIGH, so only the tasks that can be shed under overload need
+ * to be tagged.
+ *
+ * While the kernel is in high criticality mode, see vTaskSetCriticalityMode(),
+ * a tskCRITICALITY_LOW task that is ready to run is held back from its ready
+ * list, so it does not run until the kernel returns to low criticality mode.
+ * Blocked low criticality tasks stay blocked, and are held back if they are
+ * unblocked while the kernel is in high criticality mode.
+ *
+ * If configUSE_TASK_BUDGETS is 1, the budget of a tskCRITICALITY_HIGH task set
+ * by vTaskSetBudget() is the time it is expected to need in low criticality
+ * mode.  Exhausting it switches the kernel to high criticality mode instead of
+ * throttling the task, and the budgets of high criticality tasks are not
+ * enforced in high criticality mode.
+ *
+ * @param xTask The handle of the task.  Passing NULL sets the criticality of
+ * the calling task.  The idle task cannot be made low criticality.
+ *
+ * @param uxCriticality tskCRITICALITY_LOW or tskCRITICALITY_HIGH.
+ *
+ * \defgroup vTaskSetCriticality vTaskSetCriticality
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+    void vTaskSetCriticality( TaskHandle_t xTask,
+                              UBaseType_t uxCriticality ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetCriticality( const TaskHandle_t xTask );
+ * @endcode
+ *
+ * Returns the criticality of a task.  Passing NULL returns the criticality of
+ * the calling task.
+ *
+ * \defgroup uxTaskGetCriticality uxTaskGetCriticality
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+    UBaseType_t uxTaskGetCriticality( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetCriticalityMode( UBaseType_t uxMode );
+ * @endcode
+ *
+ * Switch the kernel to high or low criticality mode.  In high criticality mode
+ * low criticality tasks are shed, and the callbacks of low criticality timers
+ * are deferred until the kernel returns to low criticality mode.  The kernel
+ * also switches to high criticality mode when a high criticality task overruns
+ * its budget, and returns to low criticality mode by itself once the load has
+ * subsided, as described for configCRITICALITY_RESTORE_TICKS.
+ *
+ * Example usage:
+ * @code{c}
+ * void vOnSensorFault( void )
+ * {
+ *   // Give the control loop all the processor time while the fault is
+ *   // handled.  Logging and display tasks resume once it is cleared.
+ *   vTaskSetCriticalityMode( tskCRITICALITY_HIGH );
+ * }
+ * @endcode
+ *
+ * @param uxMode tskCRITICALITY_HIGH or tskCRITICALITY_LOW.
+ *
+ * \defgroup vTaskSetCriticalityMode vTaskSetCriticalityMode
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+    void vTaskSetCriticalityMode( UBaseType_t uxMode ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetCriticalityMode( void );
+ * @endcode
+ *
+ * Returns the current criticality mode of the kernel, tskCRITICALITY_LOW or
+ * tskCRITICALITY_HIGH.  Can be called from an interrupt.
+ *
+ * \defgroup uxTaskGetCriticalityMode uxTaskGetCriticalityMode
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+    UBaseType_t uxTaskGetCriticalityMode( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetTimeSliceLength( UBaseType_t uxPriority, TickType_t xTicks );
+ * @endcode
+ *
+ * Set the number of ticks a task of priority uxPriority runs for before
+ * another ready task of the same priority is selected.  Longer time slices
+ * mean fewer context switches between CPU bound tasks that share a priority.
+ * configUSE_PER_PRIORITY_TIME_SLICE must be defined as 1 for this function to
+ * be available, and time slicing only takes place when configUSE_PREEMPTION
+ * and configUSE_TIME_SLICING are both 1.
+ *
+ * A task that is preempted by a higher priority task completes its time slice
+ * when it next runs.  In SMP builds it starts a new time slice instead.
+ *
+ * @param uxPriority The priority to set the time slice length of.
+ *
+ * @param xTicks The time slice length in ticks.  Passing 0 restores the
+ * default of configTIME_SLICE_TICKS.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( void )
+ * {
+ *   // Let the batch workers at priority 1 run for 20 ticks at a time.
+ *   vTaskSetTimeSliceLength( tskIDLE_PRIORITY + 1, 20 );
+ * }
+ * @endcode
+ * \defgroup vTaskSetTimeSliceLength vTaskSetTimeSliceLength
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 )
+    void vTaskSetTimeSliceLength( UBaseType_t uxPriority,
+                                  TickType_t xTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * TickType_t xTaskGetTimeSliceLength( UBaseType_t uxPriority );
+ * @endcode
+ *
+ * configUSE_PER_PRIORITY_TIME_SLICE must be defined as 1 for this function to
+ * be available.
+ *
+ * @param uxPriority The priority to get the time slice length of.
+ *
+ * @return The time slice length of the priority in ticks.
+ *
+ * \defgroup xTaskGetTimeSliceLength xTaskGetTimeSliceLength
+ * \ingroup TaskCtrl
+ */
+#if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 )
+    TickType_t xTaskGetTimeSliceLength( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSuspend( TaskHandle_t xTaskToSuspend );
+ * @endcode
+ *
+ * INCLUDE_vTaskSuspend must be defined as 1 for this function to be available.
+ * See the configuration section for more information.
+ *
+ * Suspend any task.  When suspended a task will never get any microcontroller
+ * processing time, no matter what its priority.
+ *
+ * Calls to vTaskSuspend are not accumulative -
+ * i.e. calling vTaskSuspend () twice on the same task still only requires one
+ * call to vTaskResume () to ready the suspended task.
+ *
+ * @param xTaskToSuspend Handle to the task being suspended.  Passing a NULL
+ * handle will cause the calling task to be suspended.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( void )
+ * {
+ * TaskHandle_t xHandle;
+ *
+ *   // Create a task, storing the handle.
+ *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
+ *
+ *   // ...
+ *
+ *   // Use the handle to suspend the created task.
+ *   vTaskSuspend( xHandle );
+ *
+ *   // ...
+ *
+ *   // The created task will not run during this period, unless
+ *   // another task calls vTaskResume( xHandle ).
+ *
+ *   //...
+ *
+ *
+ *   // Suspend ourselves.
+ *   vTaskSuspend( NULL );
+ *
+ *   // We cannot get here unless another task calls vTaskResume
+ *   // with our handle as the parameter.
+ * }
+ * @endcode
+ * \defgroup vTaskSuspend vTaskSuspend
+ * \ingroup TaskCtrl
+ */
+void vTaskSuspend( TaskHandle_t xTaskToSuspend ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskResume( TaskHandle_t xTaskToResume );
+ * @endcode
+ *
+ * INCLUDE_vTaskSuspend must be defined as 1 for this function to be available.
+ * See the configuration section for more information.
+ *
+ * Resumes a suspended task.
+ *
+ * A task that has been suspended by one or more calls to vTaskSuspend ()
+ * will be made available for running again by a single call to
+ * vTaskResume ().
+ *
+ * @param xTaskToResume Handle to the task being readied.
+ *
+ * Example usage:
+ * @code{c}
+ * void vAFunction( void )
+ * {
+ * TaskHandle_t xHandle;
+ *
+ *   // Create a task, storing the handle.
+ *   xTaskCreate( vTaskCode, "NAME", STACK_SIZE, NULL, tskIDLE_PRIORITY, &xHandle );
+ *
+ *   // ...
+ *
+ *   // Use the handle to suspend the created task.
+ *   vTaskSuspend( xHandle );
+ *
+ *   // ...
+ *
+ *   // The created task will not run during this period, unless
+ *   // another task calls vTaskResume( xHandle ).
+ *
+ *   //...
+ *
+ *
+ *   // Resume the suspended task ourselves.
+ *   vTaskResume( xHandle );
+ *
+ *   // The created task will once again get microcontroller processing
+ *   // time in accordance with its priority within the system.
+ * }
+ * @endcode
+ * \defgroup vTaskResume vTaskResume
+ * \ingroup TaskCtrl
+ */
+void vTaskResume( TaskHandle_t xTaskToResume ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void xTaskResumeFromISR( TaskHandle_t xTaskToResume );
  * @endcode
  *
  * INCLUDE_xTaskResumeFromISR must be defined as 1 for this function to be
@@ -1367,7 +2275,7 @@ void vTaskEndScheduler( void ) PRIVILEGED_FUNCTION;
  * \defgroup vTaskSuspendAll vTaskSuspendAll
  * \ingroup SchedulerControl
  */
-void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
+void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /**
  * task. h
@@ -1423,7 +2331,66 @@ void vTaskSuspendAll( void ) PRIVILEGED_FUNCTION;
  * \defgroup xTaskResumeAll xTaskResumeAll
  * \ingroup SchedulerControl
  */
-BaseType_t xTaskResumeAll( void ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskResumeAll( void ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskPreemptionDisable( void );
+ * @endcode
+ *
+ * Stops the calling task being switched out while it remains able to run,
+ * until a matching call to vTaskPreemptionEnable() is made.  Calls can be
+ * nested.  configUSE_TASK_PREEMPTION_DISABLE must be defined as 1 for this
+ * function to be available.
+ *
+ * Unlike vTaskSuspendAll(), interrupts and other tasks can still unblock
+ * tasks as normal, and the scheduler does not have to process a pending ready
+ * list afterwards - the only cost is a counter in the task's TCB.  A switch to
+ * a higher priority task that becomes ready, or to another task of the same
+ * priority when the time slice ends, is held until preemption is enabled
+ * again.  A task that blocks, suspends or deletes itself with preemption
+ * disabled is still switched out, and its preemption is still disabled when it
+ * runs again.
+ *
+ * Example usage:
+ * @code{c}
+ * void vTask1( void * pvParameters )
+ * {
+ *   for( ;; )
+ *   {
+ *       vTaskPreemptionDisable();
+ *       {
+ *           // Update the fields of a structure shared with a lower priority
+ *           // task without being switched out part way through.
+ *       }
+ *       vTaskPreemptionEnable();
+ *   }
+ * }
+ * @endcode
+ * \defgroup vTaskPreemptionDisable vTaskPreemptionDisable
+ * \ingroup SchedulerControl
+ */
+#if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+    void vTaskPreemptionDisable( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskPreemptionEnable( void );
+ * @endcode
+ *
+ * Ends a region started by vTaskPreemptionDisable().  If a context switch was
+ * held while preemption was disabled, it is performed when the outermost
+ * region ends.
+ *
+ * \defgroup vTaskPreemptionEnable vTaskPreemptionEnable
+ * \ingroup SchedulerControl
+ */
+#if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+    void vTaskPreemptionEnable( void ) PRIVILEGED_FUNCTION;
+#endif
 
 /*-----------------------------------------------------------
 * TASK UTILITIES
@@ -1460,6 +2427,30 @@ TickType_t xTaskGetTickCount( void ) PRIVILEGED_FUNCTION;
  */
 TickType_t xTaskGetTickCountFromISR( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * uint64_t ullTaskGetTickCount64( void );
+ * @endcode
+ *
+ * configUSE_TICK_COUNT_64 must be set to 1 in FreeRTOSConfig.h for
+ * ullTaskGetTickCount64() to be available.
+ *
+ * @return The count of ticks since vTaskStartScheduler was called, held in 64
+ * bits so it does not overflow when the tick count wraps.
+ *
+ * The count is read without entering a critical section or masking
+ * interrupts, so ullTaskGetTickCount64() can be called from tasks and from
+ * interrupts of any priority, including interrupts above
+ * configMAX_SYSCALL_INTERRUPT_PRIORITY.
+ *
+ * \defgroup ullTaskGetTickCount64 ullTaskGetTickCount64
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TICK_COUNT_64 == 1 )
+    uint64_t ullTaskGetTickCount64( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1476,6 +2467,39 @@ TickType_t xTaskGetTickCountFromISR( void ) PRIVILEGED_FUNCTION;
  */
 UBaseType_t uxTaskGetNumberOfTasks( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetNumberOfTasksInState( eTaskState eState );
+ * UBaseType_t uxTaskGetNumberOfReadyTasksAtPriority( UBaseType_t uxPriority );
+ * @endcode
+ *
+ * configUSE_TASK_STATE_COUNTS must be defined as 1 for these functions to be
+ * available.
+ *
+ * uxTaskGetNumberOfTasksInState() returns the number of tasks that
+ * eTaskGetState() would report as being in state eState, without walking the
+ * task lists as uxTaskGetSystemState() does.  Its cost depends on
+ * configMAX_PRIORITIES, not on the number of tasks, so it is cheap enough to
+ * call from a health monitor that polls frequently.  eRunning returns the number
+ * of cores running a task once the scheduler has started, and eReady excludes
+ * the running tasks.  Tasks that have been readied while the scheduler was
+ * suspended are counted as blocked until the scheduler is resumed, as they are
+ * by eTaskGetState().  The idle tasks are included in the counts.
+ *
+ * uxTaskGetNumberOfReadyTasksAtPriority() returns the number of tasks in the
+ * ready list for priority uxPriority, including any that are running, or 0 if
+ * uxPriority is not a valid priority.  Tasks held out of the ready lists by
+ * time partitions or mixed criticality shedding are not included.
+ *
+ * \defgroup uxTaskGetNumberOfTasksInState uxTaskGetNumberOfTasksInState
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_STATE_COUNTS == 1 )
+    UBaseType_t uxTaskGetNumberOfTasksInState( eTaskState eState ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxTaskGetNumberOfReadyTasksAtPriority( UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1484,7 +2508,10 @@ UBaseType_t uxTaskGetNumberOfTasks( void ) PRIVILEGED_FUNCTION;
  *
  * @return The text (human readable) name of the task referenced by the handle
  * xTaskToQuery.  A task can query its own name by either passing in its own
- * handle, or by setting xTaskToQuery to NULL.
+ * handle, or by setting xTaskToQuery to NULL.  If configTASK_NAME_STORAGE is
+ * TASK_NAME_STORAGE_REFERENCE the string passed to the task create function
+ * is returned, which must not be written to, and if it is
+ * TASK_NAME_STORAGE_NONE an empty string is returned.
  *
  * \defgroup pcTaskGetName pcTaskGetName
  * \ingroup TaskUtils
@@ -1498,7 +2525,10 @@ char * pcTaskGetName( TaskHandle_t xTaskToQuery ) PRIVILEGED_FUNCTION; /*lint !e
  * @endcode
  *
  * NOTE:  This function takes a relatively long time to complete and should be
- * used sparingly.
+ * used sparingly, unless configTASK_NAME_HASH_BUCKETS is above 0.  In that case
+ * the names are kept in an index, so only the tasks whose names share a hash
+ * bucket with pcNameToQuery are compared, and a task is no longer found once
+ * vTaskDelete() has been called on it.
  *
  * @return The handle of the task that has the human readable name pcNameToQuery.
  * NULL is returned if no matching name is found.  INCLUDE_xTaskGetHandle
@@ -1529,6 +2559,18 @@ TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) PRIVILEGED_FUNCTION; /
  * overflowing on 8-bit types without breaking backward compatibility for
  * applications that expect an 8-bit return type.
  *
+ * Each call scans the whole unused part of the stack, which takes a while for
+ * large stacks.  If configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK is 1 the
+ * deepest point reached is remembered, so each call only scans the part of the
+ * stack used since the previous call.  The scan then stops at the first run of
+ * configSTACK_HIGH_WATER_MARK_GAP_WORDS words that have never been written, so
+ * a larger buffer that was never written can hide use beyond it until the task
+ * is switched out while using that deeper part of its stack.
+ *
+ * If configSTACK_FILL_LIMIT_WORDS is not 0 then only that many words at the
+ * end of the stack are filled when the task is created, and the value returned
+ * is at most configSTACK_FILL_LIMIT_WORDS.
+ *
  * @param xTask Handle of the task associated with the stack to be checked.
  * Set xTask to NULL to check the stack of the calling task.
  *
@@ -1558,14 +2600,272 @@ UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) PRIVILEGED_FUNCTIO
  * overflowing on 8-bit types without breaking backward compatibility for
  * applications that expect an 8-bit return type.
  *
+ * Each call scans the whole unused part of the stack, which takes a while for
+ * large stacks.  If configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK is 1 the
+ * deepest point reached is remembered, so each call only scans the part of the
+ * stack used since the previous call.  The scan then stops at the first run of
+ * configSTACK_HIGH_WATER_MARK_GAP_WORDS words that have never been written, so
+ * a larger buffer that was never written can hide use beyond it until the task
+ * is switched out while using that deeper part of its stack.
+ *
+ * If configSTACK_FILL_LIMIT_WORDS is not 0 then only that many words at the
+ * end of the stack are filled when the task is created, and the value returned
+ * is at most configSTACK_FILL_LIMIT_WORDS.
+ *
  * @param xTask Handle of the task associated with the stack to be checked.
  * Set xTask to NULL to check the stack of the calling task.
  *
- * @return The smallest amount of free stack space there has been (in words, so
- * actual spaces on the stack rather than bytes) since the task referenced by
- * xTask was created.
+ * @return The smallest amount of free stack space there has been (in words, so
+ * actual spaces on the stack rather than bytes) since the task referenced by
+ * xTask was created.
+ */
+configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * @code{c}
+ * size_t xTaskGetHeapBytesAllocated( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_TASK_HEAP_ACCOUNTING must be set to 1 for this function to be
+ * available, and the heap must be implemented by heap_4.c or heap_5.c.
+ *
+ * Returns the number of heap bytes, including the header of each block, held
+ * by blocks that xTask allocated and that have not been freed yet.  Blocks are
+ * charged to the task that allocates them, whichever task frees them, and
+ * blocks allocated before the scheduler is started are not charged to any
+ * task.  Watching the value over time shows which task is leaking memory.
+ *
+ * @param xTask Handle of the task being queried.  Passing NULL queries the
+ * calling task.
+ *
+ * \defgroup xTaskGetHeapBytesAllocated xTaskGetHeapBytesAllocated
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+    size_t xTaskGetHeapBytesAllocated( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskSetHeapQuota( TaskHandle_t xTask, size_t xQuota );
+ * @endcode
+ *
+ * configUSE_TASK_HEAP_ACCOUNTING must be set to 1 for this function to be
+ * available, and the heap must be implemented by heap_4.c or heap_5.c.
+ *
+ * Limits the heap memory xTask can hold, as reported by
+ * xTaskGetHeapBytesAllocated(), to xQuota bytes.  Once the limit is reached
+ * the task's calls to pvPortMalloc() fail, even if the heap has free memory.
+ * A leaking task therefore cannot starve the rest of the system.  Objects
+ * such as queues and tasks that the task creates count against its quota.
+ *
+ * @param xTask Handle of the task being limited.  Passing NULL limits the
+ * calling task.
+ *
+ * @param xQuota The most heap memory, in bytes, the task can hold, or 0 for no
+ * limit, which is the default.
+ *
+ * \defgroup vTaskSetHeapQuota vTaskSetHeapQuota
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+    void vTaskSetHeapQuota( TaskHandle_t xTask,
+                            size_t xQuota ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskGetISRWakeLatencyStats( TaskHandle_t xTask, ISRWakeLatencyStats_t * pxStats );
+ * @endcode
+ *
+ * configUSE_ISR_WAKE_LATENCY_STATS must be set to 1 for this function to be
+ * available.
+ *
+ * Returns the interrupt to task latency measured for xTask.  When an interrupt
+ * unblocks the task, by sending to or receiving from a queue or semaphore the
+ * task is blocked on, notifying the task, or resuming it, the run time counter
+ * is read and stored in the task.  The time that elapses before the scheduler
+ * next switches the task in is then added to the task's statistics.
+ *
+ * Example usage:
+ * @code{c}
+ * void vReportLatency( TaskHandle_t xHandlerTask )
+ * {
+ * ISRWakeLatencyStats_t xStats;
+ *
+ *   vTaskGetISRWakeLatencyStats( xHandlerTask, &xStats );
+ *
+ *   if( xStats.ulCount > 0 )
+ *   {
+ *       printf( "min %u max %u mean %u\n",
+ *               ( unsigned ) xStats.ulMinimum,
+ *               ( unsigned ) xStats.ulMaximum,
+ *               ( unsigned ) ( xStats.ulTotal / xStats.ulCount ) );
+ *   }
+ * }
+ * @endcode
+ *
+ * @param xTask Handle of the task being queried.  Passing NULL queries the
+ * calling task.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vTaskGetISRWakeLatencyStats vTaskGetISRWakeLatencyStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+    void vTaskGetISRWakeLatencyStats( TaskHandle_t xTask,
+                                      ISRWakeLatencyStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskResetISRWakeLatencyStats( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_ISR_WAKE_LATENCY_STATS must be set to 1 for this function to be
+ * available.
+ *
+ * Clears the statistics returned by vTaskGetISRWakeLatencyStats() so a new
+ * measurement period can be started.
+ *
+ * @param xTask Handle of the task whose statistics are cleared.  Passing NULL
+ * clears the statistics of the calling task.
+ *
+ * \defgroup vTaskResetISRWakeLatencyStats vTaskResetISRWakeLatencyStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+    void vTaskResetISRWakeLatencyStats( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskGetPeriodicStats( TaskHandle_t xTask, TaskPeriodicStats_t * pxStats );
+ * @endcode
+ *
+ * configUSE_PERIODIC_TASK_STATS must be set to 1 for this function to be
+ * available.
+ *
+ * Returns the periodic statistics recorded for xTask by xTaskDelayUntil().
+ * Each time the task returns from xTaskDelayUntil() the number of ticks by
+ * which it started after its wake time is added to the lateness minimum,
+ * maximum and histogram.  A call that finds the wake time has already passed
+ * is also counted as an overrun, and if configUSE_PERIODIC_OVERRUN_HOOK is 1
+ * vApplicationTaskOverrunHook() is called.  A rising maximum or overrun count
+ * shows a task is getting close to missing its deadlines before it does.
+ *
+ * Example usage:
+ * @code{c}
+ * void vCheckControlLoop( TaskHandle_t xControlTask )
+ * {
+ * TaskPeriodicStats_t xStats;
+ *
+ *   vTaskGetPeriodicStats( xControlTask, &xStats );
+ *
+ *   printf( "releases %u overruns %u lateness %u to %u ticks\n",
+ *           ( unsigned ) xStats.ulReleases,
+ *           ( unsigned ) xStats.ulOverruns,
+ *           ( unsigned ) xStats.xLatenessMin,
+ *           ( unsigned ) xStats.xLatenessMax );
+ * }
+ * @endcode
+ *
+ * @param xTask Handle of the task being queried.  Passing NULL queries the
+ * calling task.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vTaskGetPeriodicStats vTaskGetPeriodicStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_PERIODIC_TASK_STATS == 1 )
+    void vTaskGetPeriodicStats( TaskHandle_t xTask,
+                                TaskPeriodicStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskResetPeriodicStats( TaskHandle_t xTask );
+ * @endcode
+ *
+ * configUSE_PERIODIC_TASK_STATS must be set to 1 for this function to be
+ * available.
+ *
+ * Clears the statistics returned by vTaskGetPeriodicStats() so a new
+ * measurement period can be started.
+ *
+ * @param xTask Handle of the task whose statistics are cleared.  Passing NULL
+ * clears the statistics of the calling task.
+ *
+ * \defgroup vTaskResetPeriodicStats vTaskResetPeriodicStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_PERIODIC_TASK_STATS == 1 )
+    void vTaskResetPeriodicStats( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskGetCriticalSectionStats( CriticalSectionStats_t * pxStats );
+ * void vTaskGetSchedulerSuspendStats( CriticalSectionStats_t * pxStats );
+ * @endcode
+ *
+ * configUSE_CRITICAL_SECTION_PROFILING must be set to 1 for these functions to
+ * be available.
+ *
+ * The worst case interrupt latency of a system is bounded by its longest
+ * critical section, and the worst case task latency by the longest period for
+ * which the scheduler is suspended.  vTaskGetCriticalSectionStats() returns
+ * the durations of the outermost critical sections entered with
+ * taskENTER_CRITICAL() or taskENTER_CRITICAL_FROM_ISR(), by the kernel or the
+ * application, since the statistics were last reset.
+ * vTaskGetSchedulerSuspendStats() returns the durations from the outermost
+ * vTaskSuspendAll() to the matching xTaskResumeAll().  Each reports the return
+ * address of the call that began the longest duration, which can be looked up
+ * in the map file to find the code responsible.
+ *
+ * Critical sections entered by calling portENTER_CRITICAL() or
+ * portSET_INTERRUPT_MASK_FROM_ISR() directly are not measured.  On ports that
+ * switch context immediately when a task yields inside a critical section the
+ * measured duration includes the time the task was switched out.
+ *
+ * @param pxStats The structure into which the statistics are written.
+ *
+ * \defgroup vTaskGetCriticalSectionStats vTaskGetCriticalSectionStats
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+    void vTaskGetCriticalSectionStats( CriticalSectionStats_t * pxStats ) PRIVILEGED_FUNCTION;
+    void vTaskGetSchedulerSuspendStats( CriticalSectionStats_t * pxStats ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task.h
+ * @code{c}
+ * void vTaskResetCriticalSectionStats( void );
+ * @endcode
+ *
+ * configUSE_CRITICAL_SECTION_PROFILING must be set to 1 for this function to
+ * be available.
+ *
+ * Clears the statistics returned by both vTaskGetCriticalSectionStats() and
+ * vTaskGetSchedulerSuspendStats(), for example once start up has completed so
+ * only the critical sections of the running system are reported.
+ *
+ * \defgroup vTaskResetCriticalSectionStats vTaskResetCriticalSectionStats
+ * \ingroup TaskUtils
  */
-configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+    void vTaskResetCriticalSectionStats( void ) PRIVILEGED_FUNCTION;
+#endif
 
 /* When using trace macros it is sometimes necessary to include task.h before
  * FreeRTOS.h.  When this is done TaskHookFunction_t will not yet have been defined,
@@ -1681,6 +2981,71 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
 
 #endif
 
+#if ( configUSE_DVFS_GOVERNOR == 1 )
+
+/**
+ *  task.h
+ * @code{c}
+ * void vApplicationSetPerformanceLevel( UBaseType_t uxLevel );
+ * @endcode
+ *
+ * Called from the tick interrupt, unless the port defines
+ * portSET_PERFORMANCE_LEVEL(), when the DVFS governor selects a new
+ * performance level.  It must change the CPU clock and voltage to suit uxLevel,
+ * from 0 (the slowest) to configDVFS_LEVELS - 1, raising the voltage before
+ * the clock and lowering it after.  If configDVFS_LEVEL_CLOCK_HZ() is defined
+ * the kernel then calls portCPU_CLOCK_CHANGED() to keep the tick rate.
+ */
+    void vApplicationSetPerformanceLevel( UBaseType_t uxLevel ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
+#if ( configUSE_SCHEDULER_EVENT_HOOKS == 1 )
+
+/**
+ *  task.h
+ * @code{c}
+ * void vApplicationTaskReadiedHook( TaskHandle_t xTask );
+ * void vApplicationIdleEntryHook( void );
+ * @endcode
+ *
+ * vApplicationTaskReadiedHook() is called each time xTask is added to a ready
+ * list - when it is created, unblocked, resumed or has its priority changed.
+ * It is called from within a critical section, possibly from an interrupt, so
+ * must be short and can only call interrupt safe API functions and
+ * uxTaskGetReadyTaskCount().
+ *
+ * vApplicationIdleEntryHook() is called from the idle task the first time
+ * round its loop after any other task has run on the core, so once each time
+ * the core goes idle.  Like vApplicationIdleHook() it must not block, but it
+ * can call the non-blocking API, for example to ask another kernel instance
+ * for work.
+ */
+    void vApplicationTaskReadiedHook( TaskHandle_t xTask ); /*lint !e526 Symbol not defined as it is an application callback. */
+    void vApplicationIdleEntryHook( void );                 /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
+#if ( configUSE_PERIODIC_OVERRUN_HOOK == 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationTaskOverrunHook( TaskHandle_t xTask, TickType_t xLateness );
+ * @endcode
+ *
+ * Called by xTaskDelayUntil() when the calling task finds its next wake time
+ * has already passed, so it has overrun its period.  The hook runs in the
+ * context of the task that overran, after the scheduler has been resumed.
+ *
+ * @param xTask The task that overran.
+ * @param xLateness The number of ticks by which the wake time had passed.
+ */
+    void vApplicationTaskOverrunHook( TaskHandle_t xTask,
+                                      TickType_t xLateness ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+#endif
+
 #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
 /**
@@ -1699,6 +3064,45 @@ configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) PRIVIL
     void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
                                         StackType_t ** ppxIdleTaskStackBuffer,
                                         uint32_t * pulIdleTaskStackSize ); /*lint !e526 Symbol not defined as it is an application callback. */
+
+    #if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer, StackType_t ** ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xPassiveIdleTaskIndex )
+ * @endcode
+ *
+ * This function is used to provide a statically allocated block of memory to
+ * FreeRTOS to hold the passive Idle Task TCBs used when configNUMBER_OF_CORES
+ * is greater than 1.  One passive idle task is created for each core other
+ * than the first, and this function is called once for each of them.
+ *
+ * @param ppxIdleTaskTCBBuffer A handle to a statically allocated TCB buffer
+ * @param ppxIdleTaskStackBuffer A handle to a statically allocated Stack buffer for the passive idle task
+ * @param pulIdleTaskStackSize A pointer to the number of elements that will fit in the allocated stack buffer
+ * @param xPassiveIdleTaskIndex The index of the passive idle task, from 0 to ( configNUMBER_OF_CORES - 2 )
+ */
+        void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                                   StackType_t ** ppxIdleTaskStackBuffer,
+                                                   uint32_t * pulIdleTaskStackSize,
+                                                   BaseType_t xPassiveIdleTaskIndex ); /*lint !e526 Symbol not defined as it is an application callback. */
+    #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+#endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PASSIVE_IDLE_HOOK == 1 ) )
+
+/**
+ * task.h
+ * @code{c}
+ * void vApplicationPassiveIdleHook( void );
+ * @endcode
+ *
+ * The application passive idle hook is called by the passive idle tasks that
+ * run on the cores other than the first when configNUMBER_OF_CORES is greater
+ * than 1.  The main idle task continues to call vApplicationIdleHook().
+ */
+    void vApplicationPassiveIdleHook( void ); /*lint !e526 Symbol not defined as it is an application callback. */
 #endif
 
 /**
@@ -1726,6 +3130,20 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/**
+ * xTaskGetIdleTaskHandleForCore() is only available if
+ * INCLUDE_xTaskGetIdleTaskHandle is set to 1 in FreeRTOSConfig.h and
+ * configNUMBER_OF_CORES is greater than 1.
+ *
+ * Returns the handle of the idle task that runs on the core xCoreID.  It is
+ * not valid to call xTaskGetIdleTaskHandleForCore() before the scheduler has
+ * been started.
+ */
+    TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1827,6 +3245,142 @@ UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
                                   const UBaseType_t uxArraySize,
                                   configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskWalkTasks( TaskWalkFunction_t pxFunction, void *pvContext );
+ * void vTaskGetKernelState( TaskKernelState_t *pxKernelState );
+ * @endcode
+ *
+ * configUSE_POST_MORTEM_SNAPSHOT must be defined as 1 for these functions to be
+ * available.  They are used by the post-mortem snapshot in post_mortem.c.
+ *
+ * vTaskWalkTasks() calls pxFunction once for each task in the system, passing
+ * a TaskWalkInfo_t that describes the task.  vTaskGetKernelState() fills in
+ * the state of the scheduler.  Unlike uxTaskGetSystemState(), neither function
+ * suspends the scheduler, enters a critical section or writes to any kernel
+ * data, so they can be called from a fault handler, with the scheduler in any
+ * state - but the information they return is only consistent if nothing else
+ * can run while they are called.  The walk of each list is limited to the
+ * number of items the list claims to hold, and ends early at a NULL link, so
+ * a corrupt list cannot make it loop forever.
+ *
+ * @param pxFunction The function called for each task.
+ *
+ * @param pvContext Passed into pxFunction.
+ *
+ * @param pxKernelState The structure to fill in.
+ */
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+    void vTaskWalkTasks( TaskWalkFunction_t pxFunction,
+                         void * pvContext ) PRIVILEGED_FUNCTION;
+    void vTaskGetKernelState( TaskKernelState_t * pxKernelState ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskIteratorInit( TaskIterator_t * pxIterator );
+ * BaseType_t xTaskIteratorNext( TaskIterator_t * pxIterator, TaskStatus_t * pxTaskStatus, BaseType_t xGetFreeStackSpace );
+ * @endcode
+ *
+ * configUSE_TASK_ITERATOR must be defined as 1 for these functions to be
+ * available, which in turn requires configUSE_TRACE_FACILITY.
+ *
+ * uxTaskGetSystemState() suspends the scheduler while it walks every task list
+ * and needs an array large enough for every task, so calling it periodically
+ * on a loaded system can delay other tasks.  These functions instead return
+ * one task at a time.  Each call to xTaskIteratorNext() holds a critical
+ * section only long enough to copy a single task's TaskStatus_t, and uses no
+ * heap memory, so a telemetry task can poll the system without disturbing the
+ * real time work.
+ *
+ * Tasks are returned in the order in which they were created.  A task created
+ * during the iteration is returned if it is created before the iteration
+ * reaches the end, and a task deleted during the iteration is not returned
+ * once it has been deleted.  Finding the position again after a task has
+ * been created or deleted walks the tasks from the start, but otherwise each
+ * step takes constant time.
+ *
+ * @param pxIterator The iterator, which must be initialised by
+ * vTaskIteratorInit() before it is passed to xTaskIteratorNext().
+ *
+ * @param pxTaskStatus The structure into which the next task's state is
+ * written.
+ *
+ * @param xGetFreeStackSpace As for vTaskGetInfo().  Checking the stack high
+ * water mark takes time, so is done with the scheduler suspended but
+ * interrupts enabled.
+ *
+ * @return pdTRUE if pxTaskStatus holds the next task, or pdFALSE if there are
+ * no more tasks.
+ *
+ * Example usage:
+ * @code{c}
+ * void vPrintTasks( void )
+ * {
+ * TaskIterator_t xIterator;
+ * TaskStatus_t xStatus;
+ * char cLine[ 80 ];
+ *
+ *  vTaskIteratorInit( &xIterator );
+ *
+ *  while( xTaskIteratorNext( &xIterator, &xStatus, pdTRUE ) != pdFALSE )
+ *  {
+ *      ( void ) xTaskFormatTaskStatus( &xStatus, xIterator.ulTotalRunTime, cLine, sizeof( cLine ) );
+ *      vSendTelemetry( cLine );
+ *  }
+ * }
+ * @endcode
+ *
+ * \defgroup xTaskIteratorNext xTaskIteratorNext
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_TASK_ITERATOR == 1 )
+    void vTaskIteratorInit( TaskIterator_t * pxIterator ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskIteratorNext( TaskIterator_t * pxIterator,
+                                  TaskStatus_t * pxTaskStatus,
+                                  BaseType_t xGetFreeStackSpace ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * size_t xTaskFormatTaskStatus( const TaskStatus_t * pxTaskStatus, configRUN_TIME_COUNTER_TYPE ulTotalRunTime, char * pcWriteBuffer, size_t xBufferLength );
+ * @endcode
+ *
+ * configUSE_TASK_ITERATOR must be defined as 1, and
+ * configUSE_STATS_FORMATTING_FUNCTIONS as 1 or 2, for this function to be
+ * available.
+ *
+ * Writes one line describing a task into pcWriteBuffer, holding the columns
+ * of vTaskList() followed, if configGENERATE_RUN_TIME_STATS is 1, by those of
+ * vTaskGetRunTimeStats().  Unlike those functions the output is limited to
+ * xBufferLength bytes, including the terminating null, and is truncated if it
+ * does not fit.  The function depends on snprintf().
+ *
+ * @param pxTaskStatus The task's state, as returned by xTaskIteratorNext().
+ *
+ * @param ulTotalRunTime The run time counter value against which the task's
+ * percentage is calculated, normally the ulTotalRunTime member of the iterator.
+ *
+ * @param pcWriteBuffer The buffer into which the line is written.
+ *
+ * @param xBufferLength The size of pcWriteBuffer in bytes.
+ *
+ * @return The number of characters written, not counting the terminating
+ * null.
+ *
+ * \defgroup xTaskFormatTaskStatus xTaskFormatTaskStatus
+ * \ingroup TaskUtils
+ */
+#if ( ( configUSE_TASK_ITERATOR == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+    size_t xTaskFormatTaskStatus( const TaskStatus_t * pxTaskStatus,
+                                  configRUN_TIME_COUNTER_TYPE ulTotalRunTime,
+                                  char * pcWriteBuffer,
+                                  size_t xBufferLength ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -1901,7 +3455,8 @@ void vTaskList( char * pcWriteBuffer ) PRIVILEGED_FUNCTION; /*lint !e971 Unquali
  * configured by the portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() macro.
  * Calling vTaskGetRunTimeStats() writes the total execution time of each
  * task into a buffer, both as an absolute count value and as a percentage
- * of the total system execution time.
+ * of the total system execution time.  If configUSE_CORE_RUN_TIME_STATS is 1
+ * the tasks are followed by a line giving the idle time of each core.
  *
  * NOTE 2:
  *
@@ -2010,6 +3565,166 @@ configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimePercent( const TaskHandle_t xTask )
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void ) PRIVILEGED_FUNCTION;
 configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounterForCore( BaseType_t xCoreID );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercentForCore( BaseType_t xCoreID );
+ * @endcode
+ *
+ * configUSE_CORE_RUN_TIME_STATS must be defined as 1 for these functions to be
+ * available.
+ *
+ * The idle tasks are not tied to a core, so the run time of one idle task is
+ * not the idle time of any one core.  These functions instead return the time
+ * core xCoreID has spent running any idle task, as a total or as a percentage
+ * of the total run time, so 100 minus the percentage is the utilisation of
+ * that core.  As with ulTaskGetIdleRunTimeCounter(), the time is added when the
+ * core switches away from the idle task.
+ *
+ * @param xCoreID The core to get the idle time of.
+ *
+ * @return The total time core xCoreID has spent idle, or the percentage of the
+ * total run time it has spent idle.
+ *
+ * \defgroup ulTaskGetIdleRunTimeCounterForCore ulTaskGetIdleRunTimeCounterForCore
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_CORE_RUN_TIME_STATS == 1 )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounterForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercentForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetWindowedRunTimeCounter( const TaskHandle_t xTask, eRunTimeWindow eWindow );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetWindowedRunTimePercent( const TaskHandle_t xTask, eRunTimeWindow eWindow );
+ * @endcode
+ *
+ * configUSE_WINDOWED_RUN_TIME_STATS must be defined as 1 for these functions to
+ * be available, which in turn requires configGENERATE_RUN_TIME_STATS.
+ *
+ * ulTaskGetRunTimeCounter() returns the run time accumulated since the task
+ * was created, so its percentage is an average over the device's whole
+ * uptime.  These functions instead report the most recently completed
+ * short, medium or long window, by default the last whole 1, 10 or 60
+ * seconds.  Windows start at multiples of configRUN_TIME_WINDOW_PERIOD_TICKS
+ * since the scheduler was started.  The accounting is done incrementally as
+ * tasks are switched out and once per period in the tick interrupt, so
+ * reading the values is cheap.  As a window is much shorter than the run time
+ * counter's wrap period, the values stay valid however long the device runs.
+ *
+ * @param xTask Handle of the task being queried.  Passing NULL queries the
+ * calling task.
+ *
+ * @param eWindow The window to report.
+ *
+ * @return The run time of the task in the window, in run time counter ticks,
+ * or the percentage of the window's duration for which the task ran.  Both are
+ * 0 until the window has completed once.
+ *
+ * \defgroup ulTaskGetWindowedRunTimeCounter ulTaskGetWindowedRunTimeCounter
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetWindowedRunTimeCounter( const TaskHandle_t xTask,
+                                                                 eRunTimeWindow eWindow ) PRIVILEGED_FUNCTION;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetWindowedRunTimePercent( const TaskHandle_t xTask,
+                                                                 eRunTimeWindow eWindow ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetIdleWindowedRunTimeCounter( eRunTimeWindow eWindow );
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetIdleWindowedRunTimePercent( eRunTimeWindow eWindow );
+ * @endcode
+ *
+ * configUSE_WINDOWED_RUN_TIME_STATS must be defined as 1 for these functions to
+ * be available.
+ *
+ * The windowed equivalents of ulTaskGetIdleRunTimeCounter() and
+ * ulTaskGetIdleRunTimePercent(), so 100 minus the value returned by
+ * ulTaskGetIdleWindowedRunTimePercent() is the current CPU load.  The same
+ * caveats about idle time as a measure of slack apply.
+ *
+ * @param eWindow The window to report.
+ *
+ * \defgroup ulTaskGetIdleWindowedRunTimeCounter ulTaskGetIdleWindowedRunTimeCounter
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleWindowedRunTimeCounter( eRunTimeWindow eWindow ) PRIVILEGED_FUNCTION;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleWindowedRunTimePercent( eRunTimeWindow eWindow ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetReadyTaskCount( void );
+ * @endcode
+ *
+ * configUSE_SCHEDULER_EVENT_HOOKS must be defined as 1 for this function to be
+ * available.
+ *
+ * Returns the number of tasks, other than the idle tasks, that are in the
+ * Ready or Running state - the depth of this kernel's run queue.  The lists
+ * are read without a critical section, so the value can be momentarily stale.
+ *
+ * \defgroup uxTaskGetReadyTaskCount uxTaskGetReadyTaskCount
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_SCHEDULER_EVENT_HOOKS == 1 )
+    UBaseType_t uxTaskGetReadyTaskCount( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * UBaseType_t uxTaskGetPerformanceLevel( void );
+ * UBaseType_t uxTaskGetCpuLoad( void );
+ * @endcode
+ *
+ * configUSE_DVFS_GOVERNOR must be defined as 1 for these functions to be
+ * available.
+ *
+ * uxTaskGetPerformanceLevel() returns the performance level last selected by
+ * the DVFS governor, from 0 (the slowest) to configDVFS_LEVELS - 1.
+ * uxTaskGetCpuLoad() returns the CPU load, as a percentage, that the governor
+ * measured over its last completed period of configDVFS_PERIOD_TICKS ticks.
+ *
+ * \defgroup uxTaskGetPerformanceLevel uxTaskGetPerformanceLevel
+ * \ingroup TaskUtils
+ */
+#if ( configUSE_DVFS_GOVERNOR == 1 )
+    UBaseType_t uxTaskGetPerformanceLevel( void ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxTaskGetCpuLoad( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * configRUN_TIME_COUNTER_TYPE ulTaskGetDvfsRunTimeCounter( void );
+ * @endcode
+ *
+ * configUSE_DVFS_GOVERNOR must be defined as 1, and configDVFS_LEVEL_CLOCK_HZ()
+ * and configDVFS_SCALED_RUN_TIME_COUNTER() must be defined, for this function
+ * to be available.
+ *
+ * Returns the value of configDVFS_SCALED_RUN_TIME_COUNTER(), a counter clocked
+ * by the CPU, converted to counts of the clock of the highest performance
+ * level, so its rate does not change when the governor changes level.  Define
+ * portGET_RUN_TIME_COUNTER_VALUE() as ulTaskGetDvfsRunTimeCounter() so the run
+ * time statistics are not distorted by level changes.
+ *
+ * \defgroup ulTaskGetDvfsRunTimeCounter ulTaskGetDvfsRunTimeCounter
+ * \ingroup TaskUtils
+ */
+#if ( ( configUSE_DVFS_GOVERNOR == 1 ) && defined( configDVFS_SCALED_RUN_TIME_COUNTER ) )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetDvfsRunTimeCounter( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * task. h
  * @code{c}
@@ -2157,6 +3872,50 @@ BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
 #define xTaskNotifyAndQueryIndexed( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotifyValue ) \
     xTaskGenericNotify( ( xTaskToNotify ), ( uxIndexToNotify ), ( ulValue ), ( eAction ), ( pulPreviousNotifyValue ) )
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyGroupIndexed( TaskHandle_t const * pxTasksToNotify, UBaseType_t uxNumberOfTasks, UBaseType_t uxIndexToNotify, uint32_t ulValue, eNotifyAction eAction );
+ * BaseType_t xTaskNotifyGroup( TaskHandle_t const * pxTasksToNotify, UBaseType_t uxNumberOfTasks, uint32_t ulValue, eNotifyAction eAction );
+ * @endcode
+ *
+ * xTaskNotifyGroupIndexed() performs the same operation as
+ * xTaskNotifyIndexed() on each of the uxNumberOfTasks tasks in the
+ * pxTasksToNotify array.  All the tasks are notified within a single critical
+ * section and a single decision on whether to yield is made once every task
+ * has been notified, so broadcasting an event is cheaper than calling
+ * xTaskNotifyIndexed() once per task and no notified task runs before the
+ * others have been notified.  The critical section length grows with
+ * uxNumberOfTasks.
+ *
+ * xTaskNotifyGroup() is equivalent to calling xTaskNotifyGroupIndexed() with
+ * the uxIndexToNotify parameter set to 0.
+ *
+ * @param pxTasksToNotify An array of the handles of the tasks to notify.  Each
+ * handle must be valid - NULL cannot be used to mean the calling task.
+ *
+ * @param uxNumberOfTasks The number of handles in pxTasksToNotify.
+ *
+ * See xTaskNotifyIndexed() for a description of the uxIndexToNotify, ulValue
+ * and eAction parameters.
+ *
+ * @return pdFAIL if eAction is eSetValueWithoutOverwrite and the value could
+ * not be written to at least one of the tasks, otherwise pdPASS.  Every task in
+ * the array is notified in either case.
+ *
+ * \defgroup xTaskNotifyGroupIndexed xTaskNotifyGroupIndexed
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskGenericNotifyGroup( TaskHandle_t const * pxTasksToNotify,
+                                    UBaseType_t uxNumberOfTasks,
+                                    UBaseType_t uxIndexToNotify,
+                                    uint32_t ulValue,
+                                    eNotifyAction eAction ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyGroup( pxTasksToNotify, uxNumberOfTasks, ulValue, eAction ) \
+    xTaskGenericNotifyGroup( ( pxTasksToNotify ), ( uxNumberOfTasks ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ulValue ), ( eAction ) )
+#define xTaskNotifyGroupIndexed( pxTasksToNotify, uxNumberOfTasks, uxIndexToNotify, ulValue, eAction ) \
+    xTaskGenericNotifyGroup( ( pxTasksToNotify ), ( uxNumberOfTasks ), ( uxIndexToNotify ), ( ulValue ), ( eAction ) )
+
 /**
  * task. h
  * @code{c}
@@ -2395,34 +4154,133 @@ BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
  * when the function exits (in which case the value passed out in
  * pulNotificationValue will match the task's notification value).
  *
- * @param pulNotificationValue Used to pass the task's notification value out
- * of the function.  Note the value passed out will not be effected by the
- * clearing of any bits caused by ulBitsToClearOnExit being non-zero.
+ * @param pulNotificationValue Used to pass the task's notification value out
+ * of the function.  Note the value passed out will not be effected by the
+ * clearing of any bits caused by ulBitsToClearOnExit being non-zero.
+ *
+ * @param xTicksToWait The maximum amount of time that the task should wait in
+ * the Blocked state for a notification to be received, should a notification
+ * not already be pending when xTaskNotifyWait() was called.  The task
+ * will not consume any processing time while it is in the Blocked state.  This
+ * is specified in kernel ticks, the macro pdMS_TO_TICKS( value_in_ms ) can be
+ * used to convert a time specified in milliseconds to a time specified in
+ * ticks.
+ *
+ * @return If a notification was received (including notifications that were
+ * already pending when xTaskNotifyWait was called) then pdPASS is
+ * returned.  Otherwise pdFAIL is returned.
+ *
+ * \defgroup xTaskNotifyWaitIndexed xTaskNotifyWaitIndexed
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
+                                   uint32_t ulBitsToClearOnEntry,
+                                   uint32_t ulBitsToClearOnExit,
+                                   uint32_t * pulNotificationValue,
+                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) \
+    xTaskGenericNotifyWait( tskDEFAULT_INDEX_TO_NOTIFY, ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) \
+    xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyWaitSpinIndexed( UBaseType_t uxIndexToWaitOn, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, UBaseType_t uxSpinCount, TickType_t xTicksToWait );
+ * BaseType_t xTaskNotifyWaitSpin( uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, UBaseType_t uxSpinCount, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * configUSE_TASK_NOTIFICATIONS and configUSE_TASK_NOTIFY_SPIN must both be
+ * set to 1 for these functions to be available.
+ *
+ * xTaskNotifyWaitSpinIndexed() performs the same operation as
+ * xTaskNotifyWaitIndexed(), but if a notification is not already pending it
+ * first polls for one up to uxSpinCount times before entering the Blocked
+ * state.  A notification sent from another core, or from an interrupt, while
+ * the task is polling is then received without the cost of blocking and being
+ * unblocked, which matters when the expected wait is shorter than a context
+ * switch.  The task remains Ready, and can be preempted, while it polls.
+ *
+ * On ports that define portWAIT_FOR_EVENT(), such as the ARM ports, each poll
+ * waits for an event (WFE) and notifying a polling task sends one (SEV), so a
+ * polling core sleeps rather than busy waits.  Otherwise each poll just reads
+ * the notification state, so uxSpinCount should be kept small.
+ *
+ * ulBitsToClearOnEntry is applied once, before polling starts.  A
+ * uxSpinCount of zero makes the function equivalent to
+ * xTaskNotifyWaitIndexed().
+ *
+ * See xTaskNotifyWaitIndexed() for a description of the other parameters and
+ * the return value.
+ *
+ * \defgroup xTaskNotifyWaitSpinIndexed xTaskNotifyWaitSpinIndexed
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskGenericNotifyWaitSpin( UBaseType_t uxIndexToWaitOn,
+                                       uint32_t ulBitsToClearOnEntry,
+                                       uint32_t ulBitsToClearOnExit,
+                                       uint32_t * pulNotificationValue,
+                                       UBaseType_t uxSpinCount,
+                                       TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskNotifyWaitSpin( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, uxSpinCount, xTicksToWait ) \
+    xTaskGenericNotifyWaitSpin( tskDEFAULT_INDEX_TO_NOTIFY, ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( uxSpinCount ), ( xTicksToWait ) )
+#define xTaskNotifyWaitSpinIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, uxSpinCount, xTicksToWait ) \
+    xTaskGenericNotifyWaitSpin( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( uxSpinCount ), ( xTicksToWait ) )
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskNotifyWaitAny( UBaseType_t uxIndexMask, uint32_t ulBitsToClearOnEntry, uint32_t ulBitsToClearOnExit, uint32_t *pulNotificationValue, UBaseType_t *puxIndexNotified, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * configUSE_TASK_NOTIFICATIONS must be undefined or defined as 1 for this
+ * function to be available.
+ *
+ * xTaskNotifyWaitAny() performs the same operation as
+ * xTaskNotifyWaitIndexed(), but waits on every notification index that has its
+ * bit set in uxIndexMask, and returns as soon as a notification is pending at
+ * any of them.  A task that serves several sources can give each source its own
+ * index, so it can tell them apart without a queue set or an event group.
+ *
+ * If notifications are pending at more than one of the indexes, the lowest
+ * index is returned and the others remain pending, to be returned by later
+ * calls.  Only the returned index leaves the pending state, and only its
+ * notification value is affected by ulBitsToClearOnExit.
+ *
+ * @param uxIndexMask The indexes to wait on, built with tskNOTIFY_INDEX_BIT(),
+ * for example tskNOTIFY_INDEX_BIT( 1 ) | tskNOTIFY_INDEX_BIT( 2 ).  Must not
+ * be zero.  configTASK_NOTIFICATION_ARRAY_ENTRIES must not exceed the number of
+ * bits in a UBaseType_t.
+ *
+ * @param ulBitsToClearOnEntry Bits that are cleared in the notification value
+ * at every index in uxIndexMask if no notification is pending at any of them
+ * when the function is called.
+ *
+ * @param ulBitsToClearOnExit Bits that are cleared in the notification value
+ * at the returned index before the function exits.
+ *
+ * @param pulNotificationValue Used to pass the notification value at the
+ * returned index out of the function, before ulBitsToClearOnExit is applied.
+ * Not written if no notification was received.  Can be NULL.
+ *
+ * @param puxIndexNotified Used to pass the returned index out of the function.
+ * Not written if no notification was received.  Can be NULL.
  *
  * @param xTicksToWait The maximum amount of time that the task should wait in
- * the Blocked state for a notification to be received, should a notification
- * not already be pending when xTaskNotifyWait() was called.  The task
- * will not consume any processing time while it is in the Blocked state.  This
- * is specified in kernel ticks, the macro pdMS_TO_TICKS( value_in_ms ) can be
- * used to convert a time specified in milliseconds to a time specified in
- * ticks.
+ * the Blocked state for a notification at any of the indexes.
  *
- * @return If a notification was received (including notifications that were
- * already pending when xTaskNotifyWait was called) then pdPASS is
- * returned.  Otherwise pdFAIL is returned.
+ * @return pdPASS if a notification was received at one of the indexes,
+ * otherwise pdFAIL.
  *
- * \defgroup xTaskNotifyWaitIndexed xTaskNotifyWaitIndexed
+ * \defgroup xTaskNotifyWaitAny xTaskNotifyWaitAny
  * \ingroup TaskNotifications
  */
-BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
-                                   uint32_t ulBitsToClearOnEntry,
-                                   uint32_t ulBitsToClearOnExit,
-                                   uint32_t * pulNotificationValue,
-                                   TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
-#define xTaskNotifyWait( ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) \
-    xTaskGenericNotifyWait( tskDEFAULT_INDEX_TO_NOTIFY, ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
-#define xTaskNotifyWaitIndexed( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait ) \
-    xTaskGenericNotifyWait( ( uxIndexToWaitOn ), ( ulBitsToClearOnEntry ), ( ulBitsToClearOnExit ), ( pulNotificationValue ), ( xTicksToWait ) )
+BaseType_t xTaskNotifyWaitAny( UBaseType_t uxIndexMask,
+                               uint32_t ulBitsToClearOnEntry,
+                               uint32_t ulBitsToClearOnExit,
+                               uint32_t * pulNotificationValue,
+                               UBaseType_t * puxIndexNotified,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -2824,6 +4682,212 @@ uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
 #define ulTaskNotifyValueClearIndexed( xTask, uxIndexToClear, ulBitsToClear ) \
     ulTaskGenericNotifyValueClear( ( xTask ), ( uxIndexToClear ), ( ulBitsToClear ) )
 
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskMailboxSendIndexed( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, void * pvMessage, BaseType_t xOverwrite );
+ *
+ * BaseType_t xTaskMailboxSend( TaskHandle_t xTaskToNotify, void * pvMessage, BaseType_t xOverwrite );
+ * @endcode
+ *
+ * configUSE_TASK_MAILBOXES must be defined as 1 for these functions to be
+ * available.
+ *
+ * A task mailbox is a single slot channel that carries a pointer to a task
+ * using one of the task's notification indexes, giving a lightweight
+ * alternative to a queue of length one holding a pointer.  No queue is
+ * created - the pointer is held in the receiving task's TCB and the
+ * notification state at the same index records whether a message is pending.
+ *
+ * A notification index used as a mailbox must not also be used by the other
+ * task notification API functions, as they would consume or fake the
+ * notification that signals a pending message.
+ *
+ * @param xTaskToNotify The handle of the task that receives the message.
+ *
+ * @param uxIndexToNotify The notification index used as the mailbox.
+ * uxIndexToNotify must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ * xTaskMailboxSend() does not have this parameter and always uses index 0.
+ *
+ * @param pvMessage The pointer to send.  Only the pointer is copied, so the
+ * object it points to must remain valid until the receiver is done with it.
+ *
+ * @param xOverwrite If xOverwrite is pdTRUE then a message that has not yet
+ * been received is replaced by pvMessage.  If xOverwrite is pdFALSE and a
+ * message is already pending then the mailbox is left unchanged.
+ *
+ * @return pdFAIL if xOverwrite is pdFALSE and a message was already pending,
+ * otherwise pdPASS.
+ *
+ * \defgroup xTaskMailboxSend xTaskMailboxSend
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskGenericMailboxSend( TaskHandle_t xTaskToNotify,
+                                    UBaseType_t uxIndexToNotify,
+                                    void * pvMessage,
+                                    BaseType_t xOverwrite ) PRIVILEGED_FUNCTION;
+#define xTaskMailboxSend( xTaskToNotify, pvMessage, xOverwrite ) \
+    xTaskGenericMailboxSend( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pvMessage ), ( xOverwrite ) )
+#define xTaskMailboxSendIndexed( xTaskToNotify, uxIndexToNotify, pvMessage, xOverwrite ) \
+    xTaskGenericMailboxSend( ( xTaskToNotify ), ( uxIndexToNotify ), ( pvMessage ), ( xOverwrite ) )
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskMailboxSendIndexedFromISR( TaskHandle_t xTaskToNotify, UBaseType_t uxIndexToNotify, void * pvMessage, BaseType_t xOverwrite, BaseType_t * pxHigherPriorityTaskWoken );
+ *
+ * BaseType_t xTaskMailboxSendFromISR( TaskHandle_t xTaskToNotify, void * pvMessage, BaseType_t xOverwrite, BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xTaskMailboxSendIndexed() that can be used from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if sending the message
+ * unblocked a task that has a priority above that of the currently running
+ * task, in which case a context switch should be requested before the
+ * interrupt is exited.  Must be initialised to pdFALSE.
+ *
+ * See xTaskMailboxSendIndexed() for a description of the other parameters and
+ * the return value.
+ *
+ * \defgroup xTaskMailboxSendFromISR xTaskMailboxSendFromISR
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskGenericMailboxSendFromISR( TaskHandle_t xTaskToNotify,
+                                           UBaseType_t uxIndexToNotify,
+                                           void * pvMessage,
+                                           BaseType_t xOverwrite,
+                                           BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#define xTaskMailboxSendFromISR( xTaskToNotify, pvMessage, xOverwrite, pxHigherPriorityTaskWoken ) \
+    xTaskGenericMailboxSendFromISR( ( xTaskToNotify ), ( tskDEFAULT_INDEX_TO_NOTIFY ), ( pvMessage ), ( xOverwrite ), ( pxHigherPriorityTaskWoken ) )
+#define xTaskMailboxSendIndexedFromISR( xTaskToNotify, uxIndexToNotify, pvMessage, xOverwrite, pxHigherPriorityTaskWoken ) \
+    xTaskGenericMailboxSendFromISR( ( xTaskToNotify ), ( uxIndexToNotify ), ( pvMessage ), ( xOverwrite ), ( pxHigherPriorityTaskWoken ) )
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskMailboxReceiveIndexed( UBaseType_t uxIndexToWaitOn, void ** ppvMessage, TickType_t xTicksToWait );
+ *
+ * BaseType_t xTaskMailboxReceive( void ** ppvMessage, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Receives the message posted to the calling task's mailbox by
+ * xTaskMailboxSendIndexed() or xTaskMailboxSendIndexedFromISR(), blocking for
+ * up to xTicksToWait ticks if no message is pending.  Receiving a message
+ * empties the mailbox.
+ *
+ * @param uxIndexToWaitOn The notification index used as the mailbox.
+ * uxIndexToWaitOn must be less than configTASK_NOTIFICATION_ARRAY_ENTRIES.
+ * xTaskMailboxReceive() does not have this parameter and always uses index 0.
+ *
+ * @param ppvMessage Used to pass out the received pointer.  Left unchanged if
+ * no message was received.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state for a
+ * message, specified in ticks.
+ *
+ * @return pdTRUE if a message was received, otherwise pdFALSE.
+ *
+ * \defgroup xTaskMailboxReceive xTaskMailboxReceive
+ * \ingroup TaskNotifications
+ */
+BaseType_t xTaskGenericMailboxReceive( UBaseType_t uxIndexToWaitOn,
+                                       void ** ppvMessage,
+                                       TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#define xTaskMailboxReceive( ppvMessage, xTicksToWait ) \
+    xTaskGenericMailboxReceive( ( tskDEFAULT_INDEX_TO_NOTIFY ), ( ppvMessage ), ( xTicksToWait ) )
+#define xTaskMailboxReceiveIndexed( uxIndexToWaitOn, ppvMessage, xTicksToWait ) \
+    xTaskGenericMailboxReceive( ( uxIndexToWaitOn ), ( ppvMessage ), ( xTicksToWait ) )
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskWaitOnAddress( const volatile uint32_t * pulAddress, uint32_t ulExpectedValue, TickType_t xTicksToWait );
+ * @endcode
+ *
+ * configUSE_WAIT_ON_ADDRESS must be defined as 1 for this function to be
+ * available.
+ *
+ * Blocks the calling task until another task calls vTaskWakeAddress() with
+ * the same address, but only if the variable at pulAddress still holds
+ * ulExpectedValue.  The value is checked and the task blocked atomically, so
+ * a task that changes the variable and then calls vTaskWakeAddress() cannot
+ * slip in between the two.  This is the building block for synchronisation
+ * objects, such as once flags or sequence locks, whose state is a variable
+ * updated with atomic operations: a task only enters the kernel when it must
+ * wait, and no kernel object is created per synchronisation object.
+ *
+ * The function can return without the variable having changed, for example
+ * if the wait timed out, so the caller should re-read the variable and wait
+ * again if required.
+ *
+ * @param pulAddress The variable to wait on.  Must be 4 byte aligned.
+ *
+ * @param ulExpectedValue The value the variable must hold for the task to
+ * block.
+ *
+ * @param xTicksToWait The maximum time to wait in the Blocked state, specified
+ * in ticks.
+ *
+ * @return pdTRUE if the task was woken by vTaskWakeAddress(), otherwise
+ * pdFALSE - either because the variable did not hold ulExpectedValue or
+ * because the wait timed out.
+ *
+ * Example usage:
+ * @code{c}
+ * static volatile uint32_t ulInitialised = 0;
+ *
+ * void vCallOnce( void )
+ * {
+ *  uint32_t ulState;
+ *
+ *  // 0 - not run, 1 - running, 2 - done.
+ *  if( Atomic_CompareAndSwap_u32( &ulInitialised, 1, 0 ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+ *  {
+ *      prvInitialise();
+ *      ulInitialised = 2;
+ *      vTaskWakeAddress( &ulInitialised, tskWAKE_ALL_TASKS );
+ *  }
+ *  else
+ *  {
+ *      while( ( ulState = ulInitialised ) != 2 )
+ *      {
+ *          ( void ) xTaskWaitOnAddress( &ulInitialised, ulState, portMAX_DELAY );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup xTaskWaitOnAddress xTaskWaitOnAddress
+ * \ingroup TaskCtrl
+ */
+BaseType_t xTaskWaitOnAddress( const volatile uint32_t * pulAddress,
+                               uint32_t ulExpectedValue,
+                               TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task. h
+ * @code{c}
+ * void vTaskWakeAddress( const volatile uint32_t * pulAddress, UBaseType_t uxTasksToWake );
+ * @endcode
+ *
+ * configUSE_WAIT_ON_ADDRESS must be defined as 1 for this function to be
+ * available.
+ *
+ * Wakes up to uxTasksToWake of the tasks blocked in xTaskWaitOnAddress() on
+ * pulAddress, highest priority first.  The variable should be updated before
+ * this function is called.  Must not be called from an interrupt.
+ *
+ * @param pulAddress The variable the tasks are waiting on.
+ *
+ * @param uxTasksToWake The maximum number of tasks to wake.  Use
+ * tskWAKE_ALL_TASKS to wake all the tasks waiting on the address.
+ *
+ * \defgroup vTaskWakeAddress vTaskWakeAddress
+ * \ingroup TaskCtrl
+ */
+void vTaskWakeAddress( const volatile uint32_t * pulAddress,
+                       UBaseType_t uxTasksToWake ) PRIVILEGED_FUNCTION;
+
 /**
  * task.h
  * @code{c}
@@ -2924,7 +4988,7 @@ void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
  * \ingroup TaskCtrl
  */
 BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait ) PRIVILEGED_FUNCTION;
+                                 TickType_t * const pxTicksToWait ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /**
  * task.h
@@ -2954,6 +5018,62 @@ BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
  */
 BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
 
+/**
+ * task.h
+ * @code{c}
+ * BaseType_t xTaskCatchUpTicksFromISR( TickType_t xTicksToCatchUp );
+ * @endcode
+ *
+ * A version of xTaskCatchUpTicks() that can be called from an interrupt
+ * service routine, intended for ports that process several elapsed ticks in
+ * one tick interrupt rather than taking an interrupt for every tick.
+ *
+ * Ticks that cannot unblock a task are added to the tick count in one step,
+ * so the cost of the call does not grow with xTicksToCatchUp unless tasks are
+ * unblocked part way through.  The tick hook and the time slice check are
+ * performed once for each group of stepped ticks rather than once per tick.
+ * If the scheduler is suspended the ticks are held pending and processed when
+ * the scheduler is resumed, as with ticks reported one at a time.
+ *
+ * @param xTicksToCatchUp The number of ticks that have elapsed since the tick
+ * count was last updated.
+ *
+ * @return pdTRUE if a context switch should be requested before the interrupt
+ * exits, otherwise pdFALSE.
+ *
+ * \defgroup xTaskCatchUpTicksFromISR xTaskCatchUpTicksFromISR
+ * \ingroup TaskCtrl
+ */
+BaseType_t xTaskCatchUpTicksFromISR( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
+
+/**
+ * task.h
+ * @code{c}
+ * TickType_t xTaskGetDynamicTickPeriod( void );
+ * @endcode
+ *
+ * Only available when configUSE_DYNAMIC_TICK is set to 1.  Called by the port
+ * at the end of its tick interrupt, after the tick has been processed and
+ * only if no context switch is required, to find how far ahead it can program
+ * the next tick interrupt.
+ *
+ * More than 1 is returned only when the scheduler has no need of the tick
+ * before a task next unblocks: the scheduler is not suspended, no tick, yield
+ * or readied task is pending, and the running task is not time sliced with
+ * another task of the same priority.  The kernel then calls
+ * portDYNAMIC_TICK_STOP() if anything happens that needs the tick before then,
+ * so the port need not check itself.  When the next interrupt is taken the
+ * port reports all the ticks that have passed, for example with
+ * xTaskCatchUpTicksFromISR().
+ *
+ * @return The number of ticks until the next tick interrupt is needed, which
+ * is 1 if the tick must not be deferred.
+ *
+ * \defgroup xTaskGetDynamicTickPeriod xTaskGetDynamicTickPeriod
+ * \ingroup TaskCtrl
+ */
+TickType_t xTaskGetDynamicTickPeriod( void ) PRIVILEGED_FUNCTION;
+
 
 /*-----------------------------------------------------------
 * SCHEDULER INTERNALS AVAILABLE FOR PORTING PURPOSES
@@ -2974,7 +5094,7 @@ BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp ) PRIVILEGED_FUNCTION;
  *   + Time slicing is in use and there is a task of equal priority to the
  *     currently running task.
  */
-BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
@@ -3008,11 +5128,24 @@ BaseType_t xTaskIncrementTick( void ) PRIVILEGED_FUNCTION;
  * period.
  */
 void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+                            const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
                                      const TickType_t xItemValue,
                                      const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Same as vTaskPlaceOnEventList(), but places the calling task at the end of
+ * the event list so tasks are woken in the order in which they blocked.  Used
+ * by queues whose wait order is queueWAIT_ORDER_FIFO.
+ */
+#if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+    void vTaskPlaceOnEventListFifo( List_t * const pxEventList,
+                                    const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
  * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
@@ -3052,10 +5185,86 @@ void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
  * @return pdTRUE if the task being removed has a higher priority than the task
  * making the call, otherwise pdFALSE.
  */
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
 
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Used by xQueueWaitForAny() to block the calling task on the event lists of
+ * several objects at once.  vTaskPlaceWaitRecordOnEventList() is called once
+ * for each object, with the scheduler suspended and the object locked, to
+ * insert pxWaitRecord into the object's event list in task priority order.
+ * vTaskBlockOnWaitRecords() then blocks the task for up to xTicksToWait.
+ *
+ * The first event list from which xTaskRemoveFromEventList() removes the task
+ * unblocks it and removes all of its records from their event lists.  Once the
+ * task runs again pxTaskGetSignalledWaitRecord() returns the record that was
+ * at the head of that event list, or NULL if the wait ended for any other
+ * reason.
+ */
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+    void vTaskPlaceWaitRecordOnEventList( List_t * const pxEventList,
+                                          TaskWaitRecord_t * const pxWaitRecord ) PRIVILEGED_FUNCTION;
+    void vTaskBlockOnWaitRecords( const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+    TaskWaitRecord_t * pxTaskGetSignalledWaitRecord( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Used by the queue implementation to hand an item directly to a blocked
+ * receiver.  vTaskSetHandoffBuffer() records the buffer the calling task is
+ * receiving into, just before it is placed on the queue's event list.  From a
+ * critical section, pvTaskClaimHandoffBuffer() returns the buffer of the task
+ * at the head of pxEventList, or NULL if it did not record one, and marks the
+ * item as handed off, after which the caller copies the item into the buffer
+ * and removes the task from the event list.  Once the task runs again
+ * xTaskEndHandoff() returns pdTRUE if an item was handed off to it, and
+ * forgets the buffer.
+ */
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+    void vTaskSetHandoffBuffer( void * pvBuffer ) PRIVILEGED_FUNCTION;
+    void * pvTaskClaimHandoffBuffer( const List_t * const pxEventList ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskEndHandoff( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.
+ *
+ * A version of vTaskRemoveFromUnorderedEventList() that can be called from an
+ * interrupt, or from a task with the scheduler running.  It is used by event
+ * groups when configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR is 1.
+ *
+ * @return pdTRUE if the task being removed has a higher priority than the task
+ * making the call, otherwise pdFALSE.
+ */
+#if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.
+ *
+ * Called by the timers module when a timer that calls its callback from the
+ * tick interrupt is started, so the tick at which the timer expires, which
+ * must be after the current tick count and before the tick count overflows, is
+ * neither suppressed by tickless idle nor skipped when ticks are caught up.
+ */
+#if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) )
+    void vTaskSetTickTimerExpiry( const TickType_t xExpiryTime ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS ONLY
  * INTENDED FOR USE WHEN IMPLEMENTING A PORT OF THE SCHEDULER AND IS
@@ -3064,7 +5273,11 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
  * Sets the pointer to the current TCB to the TCB of the highest priority task
  * that is ready to run.
  */
-portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+#else
+    portDONT_DISCARD void vTaskSwitchContext( BaseType_t xCoreID ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+#endif
 
 /*
  * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
@@ -3072,16 +5285,73 @@ portDONT_DISCARD void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
  */
 TickType_t uxTaskResetEventItemValue( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * A task's event list item value is only as wide as TickType_t, so when
+ * configUSE_64_BIT_EVENT_GROUPS is 1 the event bits module keeps the bits a
+ * task is waiting for, and the bits that unblocked it, in the task's TCB
+ * instead.  Passing NULL as xTask accesses the calling task.
+ * ullTaskResetEventItemBits() resets the calling task's event list item value,
+ * as uxTaskResetEventItemValue() does, and returns the calling task's bits.
+ */
+#if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+    void vTaskSetEventItemBits( TaskHandle_t xTask,
+                                uint64_t ullEventItemBits ) PRIVILEGED_FUNCTION;
+    uint64_t ullTaskGetEventItemBits( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+    uint64_t ullTaskResetEventItemBits( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THESE FUNCTIONS MUST NOT BE USED FROM APPLICATION CODE.  THEY ARE USED BY
+ * THE HEAP IMPLEMENTATIONS WHEN configUSE_TASK_HEAP_ACCOUNTING IS 1.
+ *
+ * xTaskHeapQuotaAllows() returns pdFALSE if charging xBytes more to the
+ * calling task would take it over its heap quota.  xTaskHeapCharge() charges
+ * xBytes to the calling task and returns the handle the heap must store with
+ * the block, which is NULL if the scheduler has not been started.
+ * vTaskHeapRelease() takes xBytes off the task that was returned by
+ * xTaskHeapCharge() when the block is freed.  The TCB of a task that was
+ * deleted while it still held heap memory is kept until then, so the stored
+ * handle remains valid.
+ */
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+    BaseType_t xTaskHeapQuotaAllows( size_t xBytes ) PRIVILEGED_FUNCTION;
+    TaskHandle_t xTaskHeapCharge( size_t xBytes ) PRIVILEGED_FUNCTION;
+    void vTaskHeapRelease( TaskHandle_t xOwner,
+                           size_t xBytes ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * THIS FUNCTION MUST NOT BE USED FROM APPLICATION CODE.  IT IS AN
+ * INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
+ *
+ * Used in place of xTaskRemoveFromEventList() by the FromISR queue functions.
+ * When configUSE_ISR_WAKE_LATENCY_STATS is 1 it also timestamps the task being
+ * unblocked, so the time it takes to start running can be measured.
+ */
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+    BaseType_t xTaskRemoveFromEventListFromISR( const List_t * const pxEventList ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+#else
+    #define xTaskRemoveFromEventListFromISR( pxEventList )    xTaskRemoveFromEventList( pxEventList )
+#endif
+
 /*
  * Return the handle of the calling task.
  */
 TaskHandle_t xTaskGetCurrentTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Return the handle of the task running on the core xCoreID.
+ */
+    TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Shortcut used by the queue implementation to prevent unnecessary call to
  * taskYIELD();
  */
-void vTaskMissedYield( void ) PRIVILEGED_FUNCTION;
+void vTaskMissedYield( void ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /*
  * Returns the scheduler state as taskSCHEDULER_RUNNING,
@@ -3095,6 +5365,13 @@ BaseType_t xTaskGetSchedulerState( void ) PRIVILEGED_FUNCTION;
  */
 BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder ) PRIVILEGED_FUNCTION;
 
+/*
+ * Raises the priority of the calling task, which has just taken a mutex that
+ * has a priority ceiling, to uxCeilingPriority should the task be running at a
+ * lower priority.  Must be called from a critical section.
+ */
+void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority ) PRIVILEGED_FUNCTION;
+
 /*
  * Set the priority of a task back to its proper priority in the case that it
  * inherited a higher priority while it was holding a semaphore.
@@ -3112,6 +5389,16 @@ BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder ) PRIVILEGE
 void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
                                           UBaseType_t uxHighestPriorityWaitingTask ) PRIVILEGED_FUNCTION;
 
+/*
+ * Returns pdTRUE if xTask is running on a core other than the calling core,
+ * otherwise pdFALSE.  Must be called from a critical section.  Used by
+ * xQueueSemaphoreTake() to decide if it is worth spinning while a mutex is
+ * held.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    BaseType_t xTaskIsRunningOnOtherCore( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Get the uxTaskNumber assigned to the task referenced by the xTask parameter.
  */
@@ -3150,17 +5437,170 @@ void vTaskStepTick( TickType_t xTicksToJump ) PRIVILEGED_FUNCTION;
  */
 eSleepModeStatus eTaskConfirmSleepModeStatus( void ) PRIVILEGED_FUNCTION;
 
+/**
+ * task. h
+ * @code{c}
+ * void vTaskSetSleepStates( const SleepState_t * pxStates, UBaseType_t uxNumberOfStates );
+ * @endcode
+ *
+ * Only available when configUSE_SLEEP_STATE_GOVERNOR is set to 1.
+ *
+ * Registers the low power states the idle task can choose between each time
+ * it suppresses the tick.  The states must be ordered from the shallowest to
+ * the deepest.  Before calling portSUPPRESS_TICKS_AND_SLEEP() the idle task
+ * predicts how long the processor will actually sleep, which is the expected
+ * idle time scaled down by how much shorter than expected previous sleeps
+ * turned out to be, and selects the deepest state for which the prediction is
+ * at least the sum of the entry latency, the exit latency and the minimum
+ * residency.  The sleep is then shortened by the exit latency of the selected
+ * state so the processor is running again when the next task must unblock.
+ * If no state fits, the port's default sleep is used.
+ *
+ * The array is referenced rather than copied, so it must remain valid.  Pass
+ * NULL to remove the states.
+ *
+ * @param pxStates An array of uxNumberOfStates sleep states.
+ *
+ * @param uxNumberOfStates The number of states in pxStates.
+ */
+#if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+    void vTaskSetSleepStates( const SleepState_t * pxStates,
+                              UBaseType_t uxNumberOfStates ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * task. h
+ * @code{c}
+ * BaseType_t xTaskQueueIdleWork( IdleWork_t * pxWork, IdleWorkFunction_t pxFunction, void * pvParameter, UBaseType_t uxPriority );
+ * BaseType_t xTaskCancelIdleWork( IdleWork_t * pxWork );
+ * @endcode
+ *
+ * Only available when configUSE_IDLE_WORK is set to 1, and not available in
+ * builds that use the MPU wrappers, as the item, including the pointer to its
+ * function, is held in the caller's memory and the function is called by the
+ * privileged idle task.
+ *
+ * xTaskQueueIdleWork() queues background work, such as flash wear levelling or
+ * log compression, for the idle task to run when there is nothing else to do.
+ * Each time round its loop the idle task calls the function of the highest
+ * priority queued item to run one slice of its work, and keeps doing so for up
+ * to configIDLE_WORK_BUDGET_TICKS ticks before it goes on to consider
+ * suppressing the tick, so pending work does not stop the processor sleeping.
+ * Items of equal priority take turns a slice at a time.  A slice should be
+ * short, as it delays everything else the idle task does, including freeing
+ * the memory of deleted tasks.
+ *
+ * The function returns pdTRUE if the item has more work to do, in which case
+ * it stays queued, or pdFALSE once the work is complete, in which case the
+ * item is removed and can be queued again.  With more than one core the work
+ * is only run by the idle task of the core that started the scheduler.
+ *
+ * xTaskCancelIdleWork() removes a queued item.  If the item's function is
+ * running it is not called again, but the slice in progress is not
+ * interrupted.
+ *
+ * @param pxWork The item, which must remain valid while it is queued.
+ *
+ * @param pxFunction The function that runs one slice of the work.
+ *
+ * @param pvParameter The value passed to pxFunction.
+ *
+ * @param uxPriority The priority of the work relative to other idle work.
+ * Higher values run first.  Unrelated to task priorities.
+ *
+ * @return xTaskQueueIdleWork() returns pdPASS if the item was queued, or
+ * pdFAIL if it was already queued.  xTaskCancelIdleWork() returns pdPASS if
+ * the item was queued or running, otherwise pdFAIL.
+ */
+#if ( configUSE_IDLE_WORK == 1 )
+    BaseType_t xTaskQueueIdleWork( IdleWork_t * pxWork,
+                                   IdleWorkFunction_t pxFunction,
+                                   void * pvParameter,
+                                   UBaseType_t uxPriority ) PRIVILEGED_FUNCTION;
+    BaseType_t xTaskCancelIdleWork( IdleWork_t * pxWork ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Only available when configUSE_SLEEP_STATE_GOVERNOR is set to 1.
+ * Called by the default configPRE_SLEEP_PROCESSING() and
+ * configPOST_SLEEP_PROCESSING() to enter and leave the sleep state selected by
+ * the idle task.  Do not call directly from application code.
+ */
+#if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+    void vTaskEnterSleepState( TickType_t * pxExpectedIdleTime ) PRIVILEGED_FUNCTION;
+    void vTaskExitSleepState( TickType_t xExpectedIdleTime ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * For internal use only.  Increment the mutex held count when a mutex is
  * taken and return the handle of the task that has taken the mutex.
  */
 TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * For internal use only.  Same as vTaskPlaceOnEventList(), but used when the
+ * calling task blocks to wait for a mutex.  pxMutexHolder points to the
+ * mutex's record of its holder, which is followed to pass inherited priorities
+ * along chains of mutexes when configPRIORITY_INHERITANCE_DEPTH is greater
+ * than 1.
+ */
+void vTaskPlaceOnMutexEventList( List_t * const pxEventList,
+                                 TaskHandle_t * const pxMutexHolder,
+                                 const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * For internal use only.  Decrement the mutex held count of the calling task
+ * when it gives back a mutex that no other task was waiting for.  If that was
+ * the last mutex held by the task and the task had inherited a priority then
+ * its base priority is restored and pdTRUE is returned to indicate that a
+ * context switch is required.
+ */
+BaseType_t xTaskDecrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Same as vTaskSetTimeOutState(), but without a critical
  * section.
  */
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+/*
+ * For internal use only.  Returns the MPU settings of the task, or of the
+ * calling task if xTask is NULL, so the port can check the buffers that are
+ * passed to a system call against the regions the task may access.
+ */
+    xMPU_SETTINGS * xTaskGetMPUSettings( TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * For internal use only.  When configNUMBER_OF_CORES is greater than 1 the
+ * port maps portENTER_CRITICAL()/portEXIT_CRITICAL() onto vTaskEnterCritical()
+ * and vTaskExitCritical(), and portENTER_CRITICAL_FROM_ISR() and
+ * portEXIT_CRITICAL_FROM_ISR() onto vTaskEnterCriticalFromISR() and
+ * vTaskExitCriticalFromISR(), so critical sections also obtain the kernel
+ * locks that protect the scheduler's data structures from the other cores.
+ */
+    void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+    UBaseType_t vTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * For internal use only.  When configUSE_CRITICAL_SECTION_PROFILING is 1
+ * taskENTER_CRITICAL(), taskEXIT_CRITICAL(), taskENTER_CRITICAL_FROM_ISR() and
+ * taskEXIT_CRITICAL_FROM_ISR() call these functions, which enter and exit the
+ * critical section using the port macros and time the outermost section.
+ */
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+    void vTaskProfiledEnterCritical( void ) PRIVILEGED_FUNCTION;
+    void vTaskProfiledExitCritical( void ) PRIVILEGED_FUNCTION;
+    UBaseType_t uxTaskProfiledEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+    void vTaskProfiledExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+#endif
 
 
 /* *INDENT-OFF* */
@@ -0,0 +1,229 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A task pool is a fixed set of worker tasks, created once, that run short
+ * jobs submitted to the pool.  A job is a function and a parameter.  Submitting
+ * a job copies the pair to the pool's job queue, and the next free worker calls
+ * the function.  This avoids creating and deleting a task for every job, so the
+ * request path does not allocate a TCB and stack, fill the stack, or leave
+ * memory for the idle task to free.
+ *
+ * A job can optionally increment a direct to task notification of a chosen
+ * task when it completes, so the submitter can wait for completion with
+ * ulTaskNotifyTakeIndexed().
+ *
+ * configUSE_TASK_POOLS must be set to 1 in FreeRTOSConfig.h for this API to be
+ * available.
+ */
+
+#ifndef TASK_POOL_H
+#define TASK_POOL_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include task_pool.h"
+#endif
+
+#include "task.h"
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/**
+ * Type by which task pools are referenced.  For example, a call to
+ * xTaskPoolCreate() returns a TaskPoolHandle_t variable that can then be used
+ * as a parameter to xTaskPoolSubmit().
+ */
+struct TaskPoolDefinition;
+typedef struct TaskPoolDefinition * TaskPoolHandle_t;
+
+/*
+ * Defines the prototype to which job functions submitted to a task pool must
+ * conform.
+ */
+typedef void (* TaskPoolJobFunction_t)( void * pvParameter );
+
+/**
+ * task_pool.h
+ *
+ * @code{c}
+ * TaskPoolHandle_t xTaskPoolCreate( const char * const pcName,
+ *                                   UBaseType_t uxNumberOfWorkers,
+ *                                   configSTACK_DEPTH_TYPE uxStackDepth,
+ *                                   UBaseType_t uxPriority,
+ *                                   UBaseType_t uxMaxPendingJobs );
+ * @endcode
+ *
+ * Creates a task pool and its worker tasks using dynamically allocated memory.
+ * Task pools cannot be deleted, so they are intended to be created once when
+ * the application starts.
+ *
+ * @param pcName The name given to each worker task.
+ *
+ * @param uxNumberOfWorkers The number of worker tasks, which is the number of
+ * jobs that can run at once.
+ *
+ * @param uxStackDepth The stack size of each worker task, in words.  It must
+ * be large enough for the deepest job that is submitted to the pool.
+ *
+ * @param uxPriority The priority at which the worker tasks run jobs.
+ *
+ * @param uxMaxPendingJobs The number of jobs that can be waiting for a free
+ * worker at any one time.
+ *
+ * @return A handle to the created pool, or NULL if there was insufficient heap
+ * memory to create the pool and all its workers.
+ *
+ * \defgroup xTaskPoolCreate xTaskPoolCreate
+ * \ingroup TaskPools
+ */
+TaskPoolHandle_t xTaskPoolCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                  UBaseType_t uxNumberOfWorkers,
+                                  configSTACK_DEPTH_TYPE uxStackDepth,
+                                  UBaseType_t uxPriority,
+                                  UBaseType_t uxMaxPendingJobs ) PRIVILEGED_FUNCTION;
+
+/**
+ * task_pool.h
+ *
+ * @code{c}
+ * BaseType_t xTaskPoolSubmit( TaskPoolHandle_t xPool,
+ *                             TaskPoolJobFunction_t pxJobFunction,
+ *                             void * pvParameter,
+ *                             TaskHandle_t xTaskToNotify,
+ *                             UBaseType_t uxIndexToNotify,
+ *                             TickType_t xTicksToWait );
+ * @endcode
+ *
+ * Submits a job to a task pool.  pxJobFunction( pvParameter ) is called by the
+ * next worker task that is free.  Jobs are started in the order they were
+ * submitted.
+ *
+ * @param xPool The pool to which the job is submitted.
+ *
+ * @param pxJobFunction The function the worker calls to run the job.
+ *
+ * @param pvParameter The value passed to pxJobFunction.
+ *
+ * @param xTaskToNotify If not NULL, the task whose notification value at
+ * index uxIndexToNotify is incremented, as by xTaskNotifyGiveIndexed(), when
+ * pxJobFunction returns.
+ *
+ * @param uxIndexToNotify The notification index used to signal completion.
+ * Not used if xTaskToNotify is NULL.
+ *
+ * @param xTicksToWait The maximum time to wait for space to become available
+ * if uxMaxPendingJobs jobs are already waiting for a worker.
+ *
+ * @return pdPASS if the job was submitted, otherwise errQUEUE_FULL.
+ *
+ * Example use:
+ * @code{c}
+ * static TaskPoolHandle_t xPool;
+ *
+ * void vHandleRequests( Request_t * pxRequests, UBaseType_t uxCount )
+ * {
+ * UBaseType_t ux;
+ *
+ *  for( ux = 0; ux < uxCount; ux++ )
+ *  {
+ *      xTaskPoolSubmit( xPool, vHandleRequest, &( pxRequests[ ux ] ),
+ *                       xTaskGetCurrentTaskHandle(), 1, portMAX_DELAY );
+ *  }
+ *
+ *  // Wait for all the requests to be handled.
+ *  for( ux = 0; ux < uxCount; ux++ )
+ *  {
+ *      ulTaskNotifyTakeIndexed( 1, pdFALSE, portMAX_DELAY );
+ *  }
+ * }
+ * @endcode
+ * \defgroup xTaskPoolSubmit xTaskPoolSubmit
+ * \ingroup TaskPools
+ */
+BaseType_t xTaskPoolSubmit( TaskPoolHandle_t xPool,
+                            TaskPoolJobFunction_t pxJobFunction,
+                            void * pvParameter,
+                            TaskHandle_t xTaskToNotify,
+                            UBaseType_t uxIndexToNotify,
+                            TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * task_pool.h
+ *
+ * @code{c}
+ * BaseType_t xTaskPoolSubmitFromISR( TaskPoolHandle_t xPool,
+ *                                    TaskPoolJobFunction_t pxJobFunction,
+ *                                    void * pvParameter,
+ *                                    TaskHandle_t xTaskToNotify,
+ *                                    UBaseType_t uxIndexToNotify,
+ *                                    BaseType_t * pxHigherPriorityTaskWoken );
+ * @endcode
+ *
+ * A version of xTaskPoolSubmit() that can be called from an interrupt service
+ * routine.  It does not wait for space if the job queue is full.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if submitting the job
+ * unblocked a worker task that has a priority above that of the currently
+ * running task, in which case a context switch should be requested before the
+ * interrupt is exited.
+ *
+ * \defgroup xTaskPoolSubmitFromISR xTaskPoolSubmitFromISR
+ * \ingroup TaskPools
+ */
+BaseType_t xTaskPoolSubmitFromISR( TaskPoolHandle_t xPool,
+                                   TaskPoolJobFunction_t pxJobFunction,
+                                   void * pvParameter,
+                                   TaskHandle_t xTaskToNotify,
+                                   UBaseType_t uxIndexToNotify,
+                                   BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * task_pool.h
+ *
+ * @code{c}
+ * UBaseType_t uxTaskPoolGetPendingJobs( TaskPoolHandle_t xPool );
+ * @endcode
+ *
+ * @return The number of jobs submitted to the pool that no worker has started.
+ *
+ * \defgroup uxTaskPoolGetPendingJobs uxTaskPoolGetPendingJobs
+ * \ingroup TaskPools
+ */
+UBaseType_t uxTaskPoolGetPendingJobs( TaskPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* !defined( TASK_POOL_H ) */
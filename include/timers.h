@@ -54,6 +54,7 @@
  * as defined below.  The commands that are sent from interrupts must use the
  * highest numbers as tmrFIRST_FROM_ISR_COMMAND is used to determine if the task
  * or interrupt version of the queue send function should be used. */
+#define tmrCOMMAND_WAKE_TIMER_TASK              ( ( BaseType_t ) -3 )
 #define tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR    ( ( BaseType_t ) -2 )
 #define tmrCOMMAND_EXECUTE_CALLBACK             ( ( BaseType_t ) -1 )
 #define tmrCOMMAND_START_DONT_TRACE             ( ( BaseType_t ) 0 )
@@ -79,11 +80,42 @@
 struct tmrTimerControl; /* The old naming convention is used to prevent breaking kernel aware debuggers. */
 typedef struct tmrTimerControl * TimerHandle_t;
 
+/**
+ * Type by which timer services created by xTimerServiceCreate() are
+ * referenced.
+ */
+struct tmrTimerService;
+typedef struct tmrTimerService * TimerServiceHandle_t;
+
+/**
+ * Type by which high resolution timers created by xHRTimerCreate() or
+ * xHRTimerCreateStatic() are referenced.
+ */
+struct tmrHRTimerControl;
+typedef struct tmrHRTimerControl * HRTimerHandle_t;
+
+/**
+ * Type by which work items initialised by xTimerInitialisePendedWork() are
+ * referenced.
+ */
+struct tmrPendedWork;
+typedef struct tmrPendedWork * PendedWorkHandle_t;
+
 /*
  * Defines the prototype to which timer callback functions must conform.
  */
 typedef void (* TimerCallbackFunction_t)( TimerHandle_t xTimer );
 
+/*
+ * Defines the prototype to which high resolution timer callback functions must
+ * conform.  The callback is called from an interrupt, so must set
+ * *pxHigherPriorityTaskWoken to pdTRUE if it unblocks a task that has a higher
+ * priority than the interrupted task, in the same way as the FromISR API
+ * functions.
+ */
+typedef void (* HRTimerCallbackFunction_t)( HRTimerHandle_t xTimer,
+                                            BaseType_t * const pxHigherPriorityTaskWoken );
+
 /*
  * Defines the prototype to which functions used with the
  * xTimerPendFunctionCallFromISR() function must conform.
@@ -236,6 +268,126 @@ typedef void (* PendedFunction_t)( void *,
                                 TimerCallbackFunction_t pxCallbackFunction ) PRIVILEGED_FUNCTION;
 #endif
 
+/**
+ * TimerHandle_t xTimerCreateWithSlack( const char * const pcTimerName,
+ *                                      const TickType_t xTimerPeriodInTicks,
+ *                                      const BaseType_t xAutoReload,
+ *                                      void * const pvTimerID,
+ *                                      TimerCallbackFunction_t pxCallbackFunction,
+ *                                      const TickType_t xSlackInTicks );
+ *
+ * Creates a new software timer as per xTimerCreate(), but with a slack of
+ * xSlackInTicks ticks.  The callback of a timer with slack can be called up to
+ * xSlackInTicks ticks after the timer expires, which lets the timer service
+ * task call the callbacks of timers that expire close together in one go,
+ * rather than unblocking once for each of them.  This reduces the number of
+ * times the tick has to be resumed when configUSE_TICKLESS_IDLE is used.  The
+ * next expiry time of an auto-reload timer is calculated from the time it
+ * expired, not from the time its callback was called, so the slack does not
+ * accumulate.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION and configUSE_TIMER_SLACK must both be set
+ * to 1 in FreeRTOSConfig.h for this function to be available.  The slack of a
+ * timer created by other means can be set with vTimerSetSlack().
+ *
+ * @param xSlackInTicks The maximum number of ticks by which a call to the
+ * timer's callback function can be deferred.  All the other parameters are as
+ * per xTimerCreate().
+ *
+ * @return As per xTimerCreate().
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+    TimerHandle_t xTimerCreateWithSlack( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                         const TickType_t xTimerPeriodInTicks,
+                                         const BaseType_t xAutoReload,
+                                         void * const pvTimerID,
+                                         TimerCallbackFunction_t pxCallbackFunction,
+                                         const TickType_t xSlackInTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TimerServiceHandle_t xTimerServiceCreate( const char * const pcName,
+ *                                           const configSTACK_DEPTH_TYPE usStackDepth,
+ *                                           const UBaseType_t uxPriority,
+ *                                           const UBaseType_t uxQueueLength );
+ *
+ * Creates an additional timer service: a timer service task, and the command
+ * queue used to send commands to it, that manage the timers bound to the
+ * service.  Timers are bound to the default timer service, the task of which is
+ * created when the scheduler starts, unless they are created with
+ * xTimerCreateForService() or moved with vTimerSetService().  The callbacks of
+ * the timers bound to a service are called from that service's task, so giving
+ * latency sensitive timers a service of their own, at a higher priority than
+ * the default timer service task, stops them being delayed by slow callbacks of
+ * other timers.
+ *
+ * Pended function calls, see xTimerPendFunctionCall(), are always executed by
+ * the default timer service task, and configUSE_DAEMON_TASK_STARTUP_HOOK only
+ * applies to the default timer service task.  Timer services cannot be deleted.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION and configUSE_TIMER_SERVICE_INSTANCES must
+ * both be set to 1 in FreeRTOSConfig.h for this function to be available.  It
+ * can be called before or after the scheduler has been started.  Timer services
+ * are not available in builds that use the MPU wrappers, as each service task
+ * runs privileged and so would call the callbacks of unprivileged tasks' timers
+ * with privilege.
+ *
+ * @param pcName A descriptive name for the timer service task, which is also
+ * used to register the service's command queue if configQUEUE_REGISTRY_SIZE is
+ * greater than 0.
+ *
+ * @param usStackDepth The size of the timer service task's stack, as per
+ * xTaskCreate().
+ *
+ * @param uxPriority The priority of the timer service task.
+ *
+ * @param uxQueueLength The maximum number of commands that can be waiting in
+ * the service's command queue at any one time.
+ *
+ * @return If the service was created then its handle is returned.  If there
+ * was insufficient FreeRTOS heap to create the task or the queue then NULL is
+ * returned.
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SERVICE_INSTANCES == 1 ) )
+    TimerServiceHandle_t xTimerServiceCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                              const configSTACK_DEPTH_TYPE usStackDepth,
+                                              const UBaseType_t uxPriority,
+                                              const UBaseType_t uxQueueLength ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * TimerHandle_t xTimerCreateForService( const char * const pcTimerName,
+ *                                       const TickType_t xTimerPeriodInTicks,
+ *                                       const BaseType_t xAutoReload,
+ *                                       void * const pvTimerID,
+ *                                       TimerCallbackFunction_t pxCallbackFunction,
+ *                                       TimerServiceHandle_t xService );
+ *
+ * Creates a new software timer as per xTimerCreate(), but bound to the timer
+ * service xService instead of to the default timer service, so the timer's
+ * commands are sent to, and its callback is called from, that service's task.
+ * See xTimerServiceCreate().
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION and configUSE_TIMER_SERVICE_INSTANCES must
+ * both be set to 1 in FreeRTOSConfig.h for this function to be available.  A
+ * timer created by other means can be bound to a service with
+ * vTimerSetService().
+ *
+ * @param xService The handle of the timer service that will manage the timer,
+ * as returned by xTimerServiceCreate(), or NULL to use the default timer
+ * service.  All the other parameters are as per xTimerCreate().
+ *
+ * @return As per xTimerCreate().
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SERVICE_INSTANCES == 1 ) )
+    TimerHandle_t xTimerCreateForService( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                          const TickType_t xTimerPeriodInTicks,
+                                          const BaseType_t xAutoReload,
+                                          void * const pvTimerID,
+                                          TimerCallbackFunction_t pxCallbackFunction,
+                                          TimerServiceHandle_t xService ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * TimerHandle_t xTimerCreateStatic(const char * const pcTimerName,
  *                                  TickType_t xTimerPeriodInTicks,
@@ -1240,6 +1392,74 @@ BaseType_t xTimerPendFunctionCall( PendedFunction_t xFunctionToPend,
                                    uint32_t ulParameter2,
                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+/**
+ * PendedWorkHandle_t xTimerInitialisePendedWork( StaticPendedWork_t * pxPendedWorkBuffer,
+ *                                                PendedFunction_t xFunctionToPend,
+ *                                                void * pvParameter1 );
+ *
+ * Initialises a work item, in memory provided by the caller, that can then be
+ * passed to xTimerPendWork() or xTimerPendWorkFromISR() any number of times to
+ * have xFunctionToPend executed by the RTOS daemon task.
+ *
+ * Unlike xTimerPendFunctionCall(), pending a work item does not copy a command
+ * into the timer command queue.  The work item itself is linked into a list
+ * that the daemon task processes in first in, first out order, and a command is
+ * only sent to wake the daemon task when that list was empty.  A work item that
+ * is already pending is not added to the list a second time, so work pended
+ * repeatedly before the daemon task runs results in a single call.
+ *
+ * configUSE_TIMER_PENDED_WORK must be set to 1 in FreeRTOSConfig.h for this
+ * function to be available.  Pended work is not available in builds that use
+ * the MPU wrappers, as the work item, including the pointer to its function,
+ * is held in the caller's memory and the function is executed by the
+ * privileged daemon task.
+ *
+ * @param pxPendedWorkBuffer Memory that holds the work item.  It must remain
+ * valid, and must not be initialised again, while the work item is pending.
+ *
+ * @param xFunctionToPend The function to execute from the timer service/daemon
+ * task.  The function must conform to the PendedFunction_t type definition.
+ *
+ * @param pvParameter1 The value of the callback function's first parameter.
+ *
+ * @return The handle of the work item.
+ */
+#if ( configUSE_TIMER_PENDED_WORK == 1 )
+    PendedWorkHandle_t xTimerInitialisePendedWork( StaticPendedWork_t * pxPendedWorkBuffer,
+                                                   PendedFunction_t xFunctionToPend,
+                                                   void * pvParameter1 ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xTimerPendWork( PendedWorkHandle_t xWork, uint32_t ulParameter2 );
+ *
+ * Adds a work item initialised by xTimerInitialisePendedWork() to the end of the
+ * list of work items that the RTOS daemon task processes, so its function is
+ * executed by the daemon task.  xTimerPendWorkFromISR() is the version that can
+ * be called from an interrupt.  Neither function blocks.
+ *
+ * configUSE_TIMER_PENDED_WORK must be set to 1 in FreeRTOSConfig.h for these
+ * functions to be available.
+ *
+ * @param xWork The work item being pended.
+ *
+ * @param ulParameter2 The value of the callback function's second parameter.
+ * It is ignored if the work item is already pending.
+ *
+ * @param pxHigherPriorityTaskWoken As per xTimerPendFunctionCallFromISR().
+ *
+ * @return pdPASS if the work item was added to the list, or pdFALSE if it was
+ * already pending, in which case its function is still executed, but only
+ * once.
+ */
+#if ( configUSE_TIMER_PENDED_WORK == 1 )
+    BaseType_t xTimerPendWork( PendedWorkHandle_t xWork,
+                               uint32_t ulParameter2 ) PRIVILEGED_FUNCTION;
+    BaseType_t xTimerPendWorkFromISR( PendedWorkHandle_t xWork,
+                                      uint32_t ulParameter2,
+                                      BaseType_t * pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * const char * const pcTimerGetName( TimerHandle_t xTimer );
  *
@@ -1297,6 +1517,315 @@ BaseType_t xTimerGetReloadMode( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
  */
 UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
 
+/**
+ * void vTimerSetCallbackFromTick( TimerHandle_t xTimer, const BaseType_t xCallbackFromTick );
+ *
+ * Updates a timer so its callback function is called directly from the tick
+ * interrupt, on the tick at which the timer expires, instead of from the timer
+ * service task.  The callback of such a timer is therefore not delayed by the
+ * priority of the timer service task or by the other commands and callbacks it
+ * is processing, but it executes in the context of an interrupt, so it must be
+ * short, must not block, and must only use API functions that end in
+ * "FromISR".  NULL can be passed as the pxHigherPriorityTaskWoken parameter of
+ * those functions, as a context switch is requested at the end of the tick
+ * interrupt if one is needed.
+ *
+ * xTimerStart(), xTimerReset(), xTimerStop() and xTimerChangePeriod(), and
+ * their FromISR versions, update such a timer immediately instead of sending a
+ * command to the timer service task, and the time at which they are called is
+ * used as the time at which the command was issued.  Like the tick count
+ * itself, the callbacks are not called while the scheduler is suspended, but
+ * are called as soon as the scheduler is resumed.
+ *
+ * configUSE_TIMER_TICK_CALLBACKS must be set to 1 in FreeRTOSConfig.h for
+ * vTimerSetCallbackFromTick() to be available.  It must only be called while
+ * the timer is dormant and no commands for the timer are waiting to be
+ * processed by the timer service task, for example before the timer is first
+ * started.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xCallbackFromTick If xCallbackFromTick is set to pdTRUE then the
+ * timer's callback function will be called from the tick interrupt.  If
+ * xCallbackFromTick is set to pdFALSE then the timer's callback function will
+ * be called from the timer service task.
+ */
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+    void vTimerSetCallbackFromTick( TimerHandle_t xTimer,
+                                    const BaseType_t xCallbackFromTick ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerSetSlack( TimerHandle_t xTimer, const TickType_t xSlackInTicks );
+ *
+ * Sets the number of ticks by which a call to the timer's callback function
+ * can be deferred after the timer expires, so it can be called together with
+ * the callbacks of other timers.  See xTimerCreateWithSlack().  Timers are
+ * created with no slack.  Slack has no effect on timers that call their
+ * callback from the tick interrupt.
+ *
+ * configUSE_TIMER_SLACK must be set to 1 in FreeRTOSConfig.h for
+ * vTimerSetSlack() to be available.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xSlackInTicks The new slack of the timer, in ticks.
+ */
+#if ( configUSE_TIMER_SLACK == 1 )
+    void vTimerSetSlack( TimerHandle_t xTimer,
+                         const TickType_t xSlackInTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerSetService( TimerHandle_t xTimer, TimerServiceHandle_t xService );
+ *
+ * Binds a timer to the timer service xService, so the timer's commands are sent
+ * to, and its callback is called from, that service's task.  See
+ * xTimerServiceCreate().  The timer must be dormant, and no commands for it can
+ * still be waiting in the command queue of the service it was bound to before.
+ *
+ * configUSE_TIMER_SERVICE_INSTANCES must be set to 1 in FreeRTOSConfig.h for
+ * vTimerSetService() to be available.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param xService The handle of the timer service that will manage the timer,
+ * or NULL to use the default timer service.
+ */
+#if ( configUSE_TIMER_SERVICE_INSTANCES == 1 )
+    void vTimerSetService( TimerHandle_t xTimer,
+                           TimerServiceHandle_t xService ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vTimerSetCriticality( TimerHandle_t xTimer, const UBaseType_t uxCriticality );
+ *
+ * Sets the criticality of a timer.  Timers are created with
+ * tskCRITICALITY_HIGH.  While the kernel is in high criticality mode, see
+ * vTaskSetCriticalityMode(), the callback of a tskCRITICALITY_LOW timer that
+ * expires is not called, but deferred until the kernel returns to low
+ * criticality mode.  An auto-reload timer that expires several times while its
+ * callback is deferred has its callback called once.  A deferred callback is
+ * still called if the timer is stopped, but not if it is deleted.
+ *
+ * The default timer service task is woken as soon as the kernel returns to low
+ * criticality mode.  The deferred callbacks of timers managed by other timer
+ * service instances are called the next time their service task wakes.
+ * Callbacks called from the tick interrupt are never deferred.
+ *
+ * configUSE_MIXED_CRITICALITY must be set to 1 in FreeRTOSConfig.h for
+ * vTimerSetCriticality() to be available.
+ *
+ * @param xTimer The handle of the timer being updated.
+ *
+ * @param uxCriticality tskCRITICALITY_LOW or tskCRITICALITY_HIGH.
+ */
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+    void vTimerSetCriticality( TimerHandle_t xTimer,
+                               const UBaseType_t uxCriticality ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * UBaseType_t uxTimerGetCriticality( TimerHandle_t xTimer );
+ *
+ * Queries the criticality of a timer, tskCRITICALITY_LOW or
+ * tskCRITICALITY_HIGH.
+ *
+ * configUSE_MIXED_CRITICALITY must be set to 1 in FreeRTOSConfig.h for
+ * uxTimerGetCriticality() to be available.
+ *
+ * @param xTimer The handle of the timer being queried.
+ */
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+    UBaseType_t uxTimerGetCriticality( TimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * HRTimerHandle_t xHRTimerCreate( const char * const pcTimerName,
+ *                                 const uint32_t ulPeriodInMicroseconds,
+ *                                 const BaseType_t xAutoReload,
+ *                                 void * const pvTimerID,
+ *                                 HRTimerCallbackFunction_t pxCallbackFunction );
+ *
+ * Creates a high resolution timer, the period of which is specified in
+ * microseconds rather than in ticks.  High resolution timers do not use the
+ * tick or the timer service task.  Instead they are driven by a hardware
+ * compare channel that the port or application provides by defining
+ * portHR_TIMER_GET_TIME() and portHR_TIMER_SET_COMPARE(), and by calling
+ * xHRTimerCompareHandler() from the channel's interrupt.  Their callbacks are
+ * called from that interrupt, so they must be short and can only use the
+ * FromISR API functions.  As the expiry times are not tied to the tick,
+ * configTICK_RATE_HZ does not need to be raised to obtain timers shorter than a
+ * tick.
+ *
+ * High resolution timers are created in the dormant state.  Unlike software
+ * timers, commands sent to them take effect immediately.
+ *
+ * configSUPPORT_DYNAMIC_ALLOCATION and configUSE_HIGH_RESOLUTION_TIMERS must
+ * both be set to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * @param pcTimerName A text name that is assigned to the timer.  This is done
+ * purely to assist debugging.
+ *
+ * @param ulPeriodInMicroseconds The period of the timer, in microseconds.  It
+ * must be greater than 0.
+ *
+ * @param xAutoReload If set to pdTRUE the timer expires repeatedly with a
+ * frequency set by ulPeriodInMicroseconds.  If set to pdFALSE the timer is a
+ * one-shot timer and enters the dormant state after it expires.
+ *
+ * @param pvTimerID An identifier that is assigned to the timer, see
+ * pvHRTimerGetTimerID().
+ *
+ * @param pxCallbackFunction The function to call when the timer expires.
+ *
+ * @return If the timer is successfully created then a handle to the newly
+ * created timer is returned.  If the timer cannot be created because there is
+ * insufficient FreeRTOS heap remaining to allocate the timer structure then
+ * NULL is returned.
+ */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) )
+    HRTimerHandle_t xHRTimerCreate( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const uint32_t ulPeriodInMicroseconds,
+                                    const BaseType_t xAutoReload,
+                                    void * const pvTimerID,
+                                    HRTimerCallbackFunction_t pxCallbackFunction ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * HRTimerHandle_t xHRTimerCreateStatic( const char * const pcTimerName,
+ *                                       const uint32_t ulPeriodInMicroseconds,
+ *                                       const BaseType_t xAutoReload,
+ *                                       void * const pvTimerID,
+ *                                       HRTimerCallbackFunction_t pxCallbackFunction,
+ *                                       StaticHRTimer_t * pxTimerBuffer );
+ *
+ * As xHRTimerCreate(), but the memory that holds the timer is provided by the
+ * application in pxTimerBuffer.
+ *
+ * configSUPPORT_STATIC_ALLOCATION and configUSE_HIGH_RESOLUTION_TIMERS must
+ * both be set to 1 in FreeRTOSConfig.h for this function to be available.
+ *
+ * @return If pxTimerBuffer is not NULL then a handle to the timer is returned,
+ * otherwise NULL is returned.
+ */
+#if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) )
+    HRTimerHandle_t xHRTimerCreateStatic( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                          const uint32_t ulPeriodInMicroseconds,
+                                          const BaseType_t xAutoReload,
+                                          void * const pvTimerID,
+                                          HRTimerCallbackFunction_t pxCallbackFunction,
+                                          StaticHRTimer_t * pxTimerBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xHRTimerStart( HRTimerHandle_t xTimer );
+ *
+ * Starts a high resolution timer so it expires ulPeriodInMicroseconds
+ * microseconds after the call, as per the period passed to xHRTimerCreate().
+ * Starting a timer that is already active restarts it.  xHRTimerStartFromISR()
+ * is the version that can be called from an interrupt.
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * these functions to be available.
+ *
+ * @param xTimer The handle of the timer being started.
+ *
+ * @return pdPASS.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    BaseType_t xHRTimerStart( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+    BaseType_t xHRTimerStartFromISR( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xHRTimerStop( HRTimerHandle_t xTimer );
+ *
+ * Stops a high resolution timer, which then enters the dormant state.
+ * Stopping a dormant timer has no effect.  xHRTimerStopFromISR() is the version
+ * that can be called from an interrupt.
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * these functions to be available.
+ *
+ * @param xTimer The handle of the timer being stopped.
+ *
+ * @return pdPASS.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    BaseType_t xHRTimerStop( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+    BaseType_t xHRTimerStopFromISR( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void vHRTimerDelete( HRTimerHandle_t xTimer );
+ *
+ * Stops a high resolution timer, then frees the memory that holds it if it was
+ * created with xHRTimerCreate().  Must not be called from an interrupt or from
+ * a high resolution timer callback.
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * vHRTimerDelete() to be available.
+ *
+ * @param xTimer The handle of the timer being deleted.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    void vHRTimerDelete( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer );
+ *
+ * Queries a high resolution timer to see if it is active or dormant.  See
+ * xTimerIsTimerActive().
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * xHRTimerIsTimerActive() to be available.
+ *
+ * @param xTimer The timer being queried.
+ *
+ * @return pdFALSE will be returned if the timer is dormant.  A value other
+ * than pdFALSE will be returned if the timer is active.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * void * pvHRTimerGetTimerID( const HRTimerHandle_t xTimer );
+ *
+ * Returns the ID assigned to a high resolution timer when it was created.
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * pvHRTimerGetTimerID() to be available.
+ *
+ * @param xTimer The timer being queried.
+ *
+ * @return The ID assigned to the timer being queried.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    void * pvHRTimerGetTimerID( const HRTimerHandle_t xTimer ) PRIVILEGED_FUNCTION;
+#endif
+
+/**
+ * BaseType_t xHRTimerCompareHandler( void );
+ *
+ * Must be called by the port, or the application, from the interrupt
+ * generated by the compare channel programmed by portHR_TIMER_SET_COMPARE().
+ * Calls the callback function of each high resolution timer that has expired,
+ * then programs the compare channel for the next expiry time.
+ *
+ * configUSE_HIGH_RESOLUTION_TIMERS must be set to 1 in FreeRTOSConfig.h for
+ * xHRTimerCompareHandler() to be available.
+ *
+ * @return pdTRUE if a callback unblocked a task that has a priority higher than
+ * the interrupted task, in which case the interrupt should request a context
+ * switch before it exits, otherwise pdFALSE.
+ */
+#if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+    BaseType_t xHRTimerCompareHandler( void ) PRIVILEGED_FUNCTION;
+#endif
+
 /**
  * TickType_t xTimerGetPeriod( TimerHandle_t xTimer );
  *
@@ -1334,6 +1863,28 @@ BaseType_t xTimerGenericCommand( TimerHandle_t xTimer,
                                  BaseType_t * const pxHigherPriorityTaskWoken,
                                  const TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+/*
+ * Called from xTaskIncrementTick() to call the callback function of each timer
+ * that calls its callback from the tick interrupt and expires at xTimeNow.
+ * Returns the time at which the next such timer expires, or portMAX_DELAY if
+ * none is due before the tick count overflows.
+ */
+    TickType_t xTimerProcessTickCallbacks( const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+/*
+ * Called by the kernel when it returns to low criticality mode, from a
+ * critical section or the tick interrupt, to wake the default timer service
+ * task so it calls the timer callbacks that were deferred.  Returns pdTRUE if
+ * waking the task requires a context switch.
+ */
+    BaseType_t xTimerReleaseDeferredCallbacks( void ) PRIVILEGED_FUNCTION;
+#endif
+
 #if ( configUSE_TRACE_FACILITY == 1 )
     void vTimerSetTimerNumber( TimerHandle_t xTimer,
                                UBaseType_t uxTimerNumber ) PRIVILEGED_FUNCTION;
@@ -1361,6 +1912,14 @@ BaseType_t xTimerGenericCommand( TimerHandle_t xTimer,
 
 #endif
 
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configENABLE_ACCESS_CONTROL_LIST == 1 ) )
+
+/* Grant or revoke an unprivileged task's access to a timer, see
+ * vGrantAccessToKernelObject(). */
+    #define vGrantAccessToTimer( xTask, xTimer )     vGrantAccessToKernelObject( ( xTask ), ( xTimer ) )
+    #define vRevokeAccessToTimer( xTask, xTimer )    vRevokeAccessToKernelObject( ( xTask ), ( xTimer ) )
+#endif
+
 /* *INDENT-OFF* */
 #ifdef __cplusplus
     }
@@ -0,0 +1,568 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A binary recorder for the kernel's trace macros.  When configUSE_TRACE_RECORDER
+ * is set to 1 in FreeRTOSConfig.h this header is included by FreeRTOS.h and
+ * defines the trace macros listed below, unless FreeRTOSConfig.h has already
+ * defined them, to write a fixed size TraceRecord_t into a ring buffer.
+ *
+ * Each core has its own ring buffer that only that core writes, so recording
+ * an event never takes a lock - interrupts are masked on the recording core
+ * for the few instructions it takes to fill in one record.  Events are
+ * dropped, and counted, while a buffer is full.  A task drains the buffers by
+ * calling uxTraceRecorderRead(), for example to stream them out over a UART or
+ * to a file, and the optional stream hook tells the application when a buffer
+ * is filling up.
+ *
+ * Events are grouped into classes, and only the classes set in
+ * configTRACE_RECORDER_EVENT_CLASSES are compiled in - the trace macros of the
+ * other classes are left empty so they cost nothing.
+ *
+ * The object recorded with an event is the address of the task, queue, timer,
+ * event group, stream buffer or heap block the event refers to, truncated to
+ * 32 bits.  Events recorded by the application with vTraceRecorderEvent()
+ * must use event IDs from traceRECORDER_EVENT_USER_FIRST upwards.
+ *
+ * On Cortex-M ports that provide ITM access, setting
+ * configTRACE_RECORDER_TRANSPORT to traceRECORDER_TRANSPORT_ITM streams each
+ * event out of ITM stimulus port configTRACE_RECORDER_ITM_PORT as it is
+ * recorded, for capture over SWO by a debug probe, instead of writing it to a
+ * ring buffer.  Capture length is then unbounded and the recorder uses no RAM
+ * for records.  If the port's FIFO is full when an event would start, the
+ * event is dropped rather than stalling the core.  Nothing is written unless
+ * the debugger has enabled the ITM and the stimulus port.
+ *
+ * Each event is streamed as a compact variable length record, written as
+ * 32-bit ITM packets, and zero bytes pad the last packet of a record:
+ *
+ *   byte 0:  the number of bytes that follow, excluding the padding, in bits 0
+ *            to 4, bit 6 set if a core ID byte is present, and bit 7 set if a
+ *            dropped event count is present.
+ *   byte 1:  the event ID.
+ *   then:    the core ID, if bit 6 is set.
+ *   then:    the number of events dropped since the previous record, if bit 7
+ *            is set.
+ *   then:    the timestamp less the timestamp of the core's previous record.
+ *   then:    the object exclusive-ORed with the object of the core's previous
+ *            record.
+ *   then:    the value.
+ *
+ * Every field after the core ID is an unsigned LEB128 varint, so a typical
+ * event takes one or two packets.  The previous timestamp and object start at
+ * 0.
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#ifndef INC_FREERTOS_H
+    #error "include FreeRTOS.h must appear in source files before include trace_recorder.h"
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* The classes events are grouped into, for use in
+ * configTRACE_RECORDER_EVENT_CLASSES. */
+#define traceRECORDER_CLASS_TASK             ( 0x01U ) /* Task switches, creation, deletion, delays and changes of state or priority. */
+#define traceRECORDER_CLASS_TICK             ( 0x02U ) /* Every tick interrupt. */
+#define traceRECORDER_CLASS_QUEUE            ( 0x04U ) /* Queues, semaphores and mutexes. */
+#define traceRECORDER_CLASS_HEAP             ( 0x08U ) /* pvPortMalloc() and vPortFree(). */
+#define traceRECORDER_CLASS_TIMER            ( 0x10U ) /* Software timers. */
+#define traceRECORDER_CLASS_EVENT_GROUP      ( 0x20U ) /* Event groups. */
+#define traceRECORDER_CLASS_STREAM_BUFFER    ( 0x40U ) /* Stream and message buffers. */
+#define traceRECORDER_CLASS_NOTIFY           ( 0x80U ) /* Direct to task notifications. */
+#define traceRECORDER_CLASS_ALL              ( 0xFFU )
+
+/* The number of records each core's ring buffer can hold.  Must be a power of
+ * two. */
+#ifndef configTRACE_RECORDER_BUFFER_LENGTH
+    #define configTRACE_RECORDER_BUFFER_LENGTH    256U
+#endif
+
+#if ( ( configTRACE_RECORDER_BUFFER_LENGTH & ( configTRACE_RECORDER_BUFFER_LENGTH - 1U ) ) != 0U )
+    #error configTRACE_RECORDER_BUFFER_LENGTH must be a power of two
+#endif
+
+/* The classes of event that are recorded. */
+#ifndef configTRACE_RECORDER_EVENT_CLASSES
+    #define configTRACE_RECORDER_EVENT_CLASSES    traceRECORDER_CLASS_ALL
+#endif
+
+/* Set configUSE_TRACE_RECORDER_STREAM_HOOK to 1 to have
+ * vApplicationTraceRecorderStreamHook() called each time the number of records
+ * in a core's buffer reaches configTRACE_RECORDER_STREAM_THRESHOLD. */
+#ifndef configUSE_TRACE_RECORDER_STREAM_HOOK
+    #define configUSE_TRACE_RECORDER_STREAM_HOOK    0
+#endif
+
+#ifndef configTRACE_RECORDER_STREAM_THRESHOLD
+    #define configTRACE_RECORDER_STREAM_THRESHOLD    ( configTRACE_RECORDER_BUFFER_LENGTH / 2U )
+#endif
+
+/* The transports configTRACE_RECORDER_TRANSPORT can select. */
+#define traceRECORDER_TRANSPORT_RAM    0 /* Per-core ring buffers, read with uxTraceRecorderRead(). */
+#define traceRECORDER_TRANSPORT_ITM    1 /* Stream out of an ITM stimulus port. */
+
+#ifndef configTRACE_RECORDER_TRANSPORT
+    #define configTRACE_RECORDER_TRANSPORT    traceRECORDER_TRANSPORT_RAM
+#endif
+
+/* The ITM stimulus port the ITM transport writes to.  Port 0 is often used for
+ * printf() style output, so port 1 is used by default. */
+#ifndef configTRACE_RECORDER_ITM_PORT
+    #define configTRACE_RECORDER_ITM_PORT    1U
+#endif
+
+#if ( configTRACE_RECORDER_TRANSPORT == traceRECORDER_TRANSPORT_ITM )
+    #ifndef portITM_PORT_WRITE
+        #error configTRACE_RECORDER_TRANSPORT is traceRECORDER_TRANSPORT_ITM but the port does not provide ITM access.
+    #endif
+
+    #if ( configUSE_TRACE_RECORDER_STREAM_HOOK == 1 )
+        #error configUSE_TRACE_RECORDER_STREAM_HOOK cannot be used with the ITM transport, which has no buffer to fill.
+    #endif
+#elif ( configTRACE_RECORDER_TRANSPORT != traceRECORDER_TRANSPORT_RAM )
+    #error configTRACE_RECORDER_TRANSPORT must be traceRECORDER_TRANSPORT_RAM or traceRECORDER_TRANSPORT_ITM
+#endif
+
+/* configTRACE_RECORDER_TIMESTAMP() can be defined to return the time stamp of
+ * each record.  With the ITM transport, a cycle counter such as
+ * portGET_CYCLE_COUNT() gives the finest latency measurements.  If it is not defined then the run time stats counter is used
+ * when configGENERATE_RUN_TIME_STATS is 1, otherwise the tick count. */
+
+/* The IDs of the events recorded by the kernel. */
+#define traceRECORDER_EVENT_TASK_SWITCHED_IN                1U
+#define traceRECORDER_EVENT_TASK_SWITCHED_OUT               2U
+#define traceRECORDER_EVENT_TASK_CREATE                     3U
+#define traceRECORDER_EVENT_TASK_DELETE                     4U
+#define traceRECORDER_EVENT_TASK_DELAY                      5U
+#define traceRECORDER_EVENT_TASK_DELAY_UNTIL                6U  /* The value is the tick count the task will wake at. */
+#define traceRECORDER_EVENT_TASK_PRIORITY_SET               7U  /* The value is the new priority. */
+#define traceRECORDER_EVENT_TASK_SUSPEND                    8U
+#define traceRECORDER_EVENT_TASK_RESUME                     9U
+#define traceRECORDER_EVENT_TASK_RESUME_FROM_ISR            10U
+#define traceRECORDER_EVENT_TASK_READY                      11U
+#define traceRECORDER_EVENT_TASK_PRIORITY_INHERIT           12U /* The value is the inherited priority. */
+#define traceRECORDER_EVENT_TASK_PRIORITY_DISINHERIT        13U /* The value is the priority returned to. */
+#define traceRECORDER_EVENT_TICK                            16U /* The value is the tick count. */
+#define traceRECORDER_EVENT_QUEUE_CREATE                    32U
+#define traceRECORDER_EVENT_QUEUE_DELETE                    33U
+#define traceRECORDER_EVENT_QUEUE_SEND                      34U /* For all queue events the value is the number of items in the queue. */
+#define traceRECORDER_EVENT_QUEUE_SEND_FAILED               35U
+#define traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR             36U
+#define traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR_FAILED      37U
+#define traceRECORDER_EVENT_QUEUE_RECEIVE                   38U
+#define traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED            39U
+#define traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR          40U
+#define traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR_FAILED   41U
+#define traceRECORDER_EVENT_QUEUE_PEEK                      42U
+#define traceRECORDER_EVENT_QUEUE_BLOCKING_ON_SEND          43U
+#define traceRECORDER_EVENT_QUEUE_BLOCKING_ON_RECEIVE       44U
+#define traceRECORDER_EVENT_MALLOC                          64U /* The object is the block, the value is the size requested. */
+#define traceRECORDER_EVENT_FREE                            65U /* The object is the block, the value is the size of the block. */
+#define traceRECORDER_EVENT_TIMER_CREATE                    80U
+#define traceRECORDER_EVENT_TIMER_COMMAND_SEND              81U /* The value is the command ID. */
+#define traceRECORDER_EVENT_TIMER_EXPIRED                   82U
+#define traceRECORDER_EVENT_EVENT_GROUP_SET_BITS            96U /* For all event group events the value is the bits. */
+#define traceRECORDER_EVENT_EVENT_GROUP_SET_BITS_FROM_ISR   97U
+#define traceRECORDER_EVENT_EVENT_GROUP_CLEAR_BITS          98U
+#define traceRECORDER_EVENT_EVENT_GROUP_WAIT_BITS_BLOCK     99U
+#define traceRECORDER_EVENT_EVENT_GROUP_SYNC_BLOCK          100U
+#define traceRECORDER_EVENT_STREAM_BUFFER_SEND              112U /* For sends and receives the value is the number of bytes. */
+#define traceRECORDER_EVENT_STREAM_BUFFER_SEND_FROM_ISR     113U
+#define traceRECORDER_EVENT_STREAM_BUFFER_RECEIVE           114U
+#define traceRECORDER_EVENT_STREAM_BUFFER_RECEIVE_FROM_ISR  115U
+#define traceRECORDER_EVENT_STREAM_BUFFER_BLOCKING_ON_SEND  116U
+#define traceRECORDER_EVENT_STREAM_BUFFER_BLOCKING_ON_RECV  117U
+#define traceRECORDER_EVENT_TASK_NOTIFY                     128U /* For all notification events the value is the notification index. */
+#define traceRECORDER_EVENT_TASK_NOTIFY_FROM_ISR            129U
+#define traceRECORDER_EVENT_TASK_NOTIFY_GIVE_FROM_ISR       130U
+#define traceRECORDER_EVENT_TASK_NOTIFY_TAKE_BLOCK          131U
+#define traceRECORDER_EVENT_TASK_NOTIFY_TAKE                132U
+#define traceRECORDER_EVENT_TASK_NOTIFY_WAIT_BLOCK          133U
+#define traceRECORDER_EVENT_TASK_NOTIFY_WAIT                134U
+#define traceRECORDER_EVENT_USER_FIRST                      192U
+
+/*
+ * The record written for each event.  ulTimestamp, ulObject and ulValue are
+ * described above.  usSequence is the low 16 bits of the number of events the
+ * core has recorded or dropped, so gaps in the sequence show where events were
+ * dropped.
+ */
+typedef struct xTRACE_RECORD
+{
+    uint32_t ulTimestamp;
+    uint32_t ulObject;
+    uint32_t ulValue;
+    uint16_t usSequence;
+    uint8_t ucEventID;
+    uint8_t ucCoreID;
+} TraceRecord_t;
+
+/* Records an event - used by the trace macros below. */
+#define traceRECORDER_RECORD( ucEventID, pvObject, xValue ) \
+    vTraceRecorderEvent( ( uint8_t ) ( ucEventID ), ( uint32_t ) ( portPOINTER_SIZE_TYPE ) ( pvObject ), ( uint32_t ) ( xValue ) )
+
+#if ( ( configTRACE_RECORDER_EVENT_CLASSES & traceRECORDER_CLASS_TASK ) != 0U )
+    #ifndef traceTASK_SWITCHED_IN
+        #define traceTASK_SWITCHED_IN()    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_SWITCHED_IN, pxCurrentTCB, 0U )
+    #endif
+    #ifndef traceTASK_SWITCHED_OUT
+        #define traceTASK_SWITCHED_OUT()    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_SWITCHED_OUT, pxCurrentTCB, 0U )
+    #endif
+    #ifndef traceTASK_CREATE
+        #define traceTASK_CREATE( pxNewTCB )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_CREATE, ( pxNewTCB ), ( pxNewTCB )->uxPriority )
+    #endif
+    #ifndef traceTASK_DELETE
+        #define traceTASK_DELETE( pxTaskToDelete )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_DELETE, ( pxTaskToDelete ), 0U )
+    #endif
+    #ifndef traceTASK_DELAY
+        #define traceTASK_DELAY()    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_DELAY, pxCurrentTCB, 0U )
+    #endif
+    #ifndef traceTASK_DELAY_UNTIL
+        #define traceTASK_DELAY_UNTIL( x )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_DELAY_UNTIL, pxCurrentTCB, ( x ) )
+    #endif
+    #ifndef traceTASK_PRIORITY_SET
+        #define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_PRIORITY_SET, ( pxTask ), ( uxNewPriority ) )
+    #endif
+    #ifndef traceTASK_SUSPEND
+        #define traceTASK_SUSPEND( pxTaskToSuspend )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_SUSPEND, ( pxTaskToSuspend ), 0U )
+    #endif
+    #ifndef traceTASK_RESUME
+        #define traceTASK_RESUME( pxTaskToResume )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_RESUME, ( pxTaskToResume ), 0U )
+    #endif
+    #ifndef traceTASK_RESUME_FROM_ISR
+        #define traceTASK_RESUME_FROM_ISR( pxTaskToResume )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_RESUME_FROM_ISR, ( pxTaskToResume ), 0U )
+    #endif
+    #ifndef traceMOVED_TASK_TO_READY_STATE
+        #define traceMOVED_TASK_TO_READY_STATE( pxTCB )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_READY, ( pxTCB ), 0U )
+    #endif
+    #ifndef traceTASK_PRIORITY_INHERIT
+        #define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_PRIORITY_INHERIT, ( pxTCBOfMutexHolder ), ( uxInheritedPriority ) )
+    #endif
+    #ifndef traceTASK_PRIORITY_DISINHERIT
+        #define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_PRIORITY_DISINHERIT, ( pxTCBOfMutexHolder ), ( uxOriginalPriority ) )
+    #endif
+#endif /* traceRECORDER_CLASS_TASK */
+
+#if ( ( configTRACE_RECORDER_EVENT_CLASSES & traceRECORDER_CLASS_TICK ) != 0U )
+    #ifndef traceTASK_INCREMENT_TICK
+        #define traceTASK_INCREMENT_TICK( xTickCount )    traceRECORDER_RECORD( traceRECORDER_EVENT_TICK, NULL, ( xTickCount ) )
+    #endif
+#endif /* traceRECORDER_CLASS_TICK */
+
+#if ( ( configTRACE_RECORDER_EVENT_CLASSES & traceRECORDER_CLASS_QUEUE ) != 0U )
+    #ifndef traceQUEUE_CREATE
+        #define traceQUEUE_CREATE( pxNewQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_CREATE, ( pxNewQueue ), ( pxNewQueue )->uxLength )
+    #endif
+    #ifndef traceQUEUE_DELETE
+        #define traceQUEUE_DELETE( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_DELETE, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_SEND
+        #define traceQUEUE_SEND( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_SEND, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_SEND_FAILED
+        #define traceQUEUE_SEND_FAILED( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_SEND_FAILED, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_SEND_FROM_ISR
+        #define traceQUEUE_SEND_FROM_ISR( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_SEND_FROM_ISR_FAILED
+        #define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_SEND_FROM_ISR_FAILED, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_RECEIVE
+        #define traceQUEUE_RECEIVE( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_RECEIVE, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_RECEIVE_FAILED
+        #define traceQUEUE_RECEIVE_FAILED( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_RECEIVE_FAILED, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_RECEIVE_FROM_ISR
+        #define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_RECEIVE_FROM_ISR_FAILED
+        #define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_RECEIVE_FROM_ISR_FAILED, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceQUEUE_PEEK
+        #define traceQUEUE_PEEK( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_PEEK, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceBLOCKING_ON_QUEUE_SEND
+        #define traceBLOCKING_ON_QUEUE_SEND( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_BLOCKING_ON_SEND, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+    #ifndef traceBLOCKING_ON_QUEUE_RECEIVE
+        #define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )    traceRECORDER_RECORD( traceRECORDER_EVENT_QUEUE_BLOCKING_ON_RECEIVE, ( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+    #endif
+#endif /* traceRECORDER_CLASS_QUEUE */
+
+#if ( ( configTRACE_RECORDER_EVENT_CLASSES & traceRECORDER_CLASS_HEAP ) != 0U )
+    #ifndef traceMALLOC
+        #define traceMALLOC( pvAddress, uiSize )    traceRECORDER_RECORD( traceRECORDER_EVENT_MALLOC, ( pvAddress ), ( uiSize ) )
+    #endif
+    #ifndef traceFREE
+        #define traceFREE( pvAddress, uiSize )    traceRECORDER_RECORD( traceRECORDER_EVENT_FREE, ( pvAddress ), ( uiSize ) )
+    #endif
+#endif /* traceRECORDER_CLASS_HEAP */
+
+#if ( ( configTRACE_RECORDER_EVENT_CLASSES & traceRECORDER_CLASS_TIMER ) != 0U )
+    #ifndef traceTIMER_CREATE
+        #define traceTIMER_CREATE( pxNewTimer )    traceRECORDER_RECORD( traceRECORDER_EVENT_TIMER_CREATE, ( pxNewTimer ), 0U )
+    #endif
+    #ifndef traceTIMER_COMMAND_SEND
+        #define traceTIMER_COMMAND_SEND( xTimer, xMessageID, xMessageValueValue, xReturn )    traceRECORDER_RECORD( traceRECORDER_EVENT_TIMER_COMMAND_SEND, ( xTimer ), ( xMessageID ) )
+    #endif
+    #ifndef traceTIMER_EXPIRED
+        #define traceTIMER_EXPIRED( pxTimer )    traceRECORDER_RECORD( traceRECORDER_EVENT_TIMER_EXPIRED, ( pxTimer ), 0U )
+    #endif
+#endif /* traceRECORDER_CLASS_TIMER */
+
+#if ( ( configTRACE_RECORDER_EVENT_CLASSES & traceRECORDER_CLASS_EVENT_GROUP ) != 0U )
+    #ifndef traceEVENT_GROUP_SET_BITS
+        #define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )    traceRECORDER_RECORD( traceRECORDER_EVENT_EVENT_GROUP_SET_BITS, ( xEventGroup ), ( uxBitsToSet ) )
+    #endif
+    #ifndef traceEVENT_GROUP_SET_BITS_FROM_ISR
+        #define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )    traceRECORDER_RECORD( traceRECORDER_EVENT_EVENT_GROUP_SET_BITS_FROM_ISR, ( xEventGroup ), ( uxBitsToSet ) )
+    #endif
+    #ifndef traceEVENT_GROUP_CLEAR_BITS
+        #define traceEVENT_GROUP_CLEAR_BITS( xEventGroup, uxBitsToClear )    traceRECORDER_RECORD( traceRECORDER_EVENT_EVENT_GROUP_CLEAR_BITS, ( xEventGroup ), ( uxBitsToClear ) )
+    #endif
+    #ifndef traceEVENT_GROUP_WAIT_BITS_BLOCK
+        #define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )    traceRECORDER_RECORD( traceRECORDER_EVENT_EVENT_GROUP_WAIT_BITS_BLOCK, ( xEventGroup ), ( uxBitsToWaitFor ) )
+    #endif
+    #ifndef traceEVENT_GROUP_SYNC_BLOCK
+        #define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )    traceRECORDER_RECORD( traceRECORDER_EVENT_EVENT_GROUP_SYNC_BLOCK, ( xEventGroup ), ( uxBitsToWaitFor ) )
+    #endif
+#endif /* traceRECORDER_CLASS_EVENT_GROUP */
+
+#if ( ( configTRACE_RECORDER_EVENT_CLASSES & traceRECORDER_CLASS_STREAM_BUFFER ) != 0U )
+    #ifndef traceSTREAM_BUFFER_SEND
+        #define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )    traceRECORDER_RECORD( traceRECORDER_EVENT_STREAM_BUFFER_SEND, ( xStreamBuffer ), ( xBytesSent ) )
+    #endif
+    #ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+        #define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )    traceRECORDER_RECORD( traceRECORDER_EVENT_STREAM_BUFFER_SEND_FROM_ISR, ( xStreamBuffer ), ( xBytesSent ) )
+    #endif
+    #ifndef traceSTREAM_BUFFER_RECEIVE
+        #define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )    traceRECORDER_RECORD( traceRECORDER_EVENT_STREAM_BUFFER_RECEIVE, ( xStreamBuffer ), ( xReceivedLength ) )
+    #endif
+    #ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+        #define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )    traceRECORDER_RECORD( traceRECORDER_EVENT_STREAM_BUFFER_RECEIVE_FROM_ISR, ( xStreamBuffer ), ( xReceivedLength ) )
+    #endif
+    #ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+        #define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )    traceRECORDER_RECORD( traceRECORDER_EVENT_STREAM_BUFFER_BLOCKING_ON_SEND, ( xStreamBuffer ), 0U )
+    #endif
+    #ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+        #define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )    traceRECORDER_RECORD( traceRECORDER_EVENT_STREAM_BUFFER_BLOCKING_ON_RECV, ( xStreamBuffer ), 0U )
+    #endif
+#endif /* traceRECORDER_CLASS_STREAM_BUFFER */
+
+#if ( ( configTRACE_RECORDER_EVENT_CLASSES & traceRECORDER_CLASS_NOTIFY ) != 0U )
+    #ifndef traceTASK_NOTIFY
+        #define traceTASK_NOTIFY( uxIndexToNotify )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_NOTIFY, pxTCB, ( uxIndexToNotify ) )
+    #endif
+    #ifndef traceTASK_NOTIFY_FROM_ISR
+        #define traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_NOTIFY_FROM_ISR, pxTCB, ( uxIndexToNotify ) )
+    #endif
+    #ifndef traceTASK_NOTIFY_GIVE_FROM_ISR
+        #define traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_NOTIFY_GIVE_FROM_ISR, pxTCB, ( uxIndexToNotify ) )
+    #endif
+    #ifndef traceTASK_NOTIFY_TAKE_BLOCK
+        #define traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_NOTIFY_TAKE_BLOCK, pxCurrentTCB, ( uxIndexToWait ) )
+    #endif
+    #ifndef traceTASK_NOTIFY_TAKE
+        #define traceTASK_NOTIFY_TAKE( uxIndexToWait )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_NOTIFY_TAKE, pxCurrentTCB, ( uxIndexToWait ) )
+    #endif
+    #ifndef traceTASK_NOTIFY_WAIT_BLOCK
+        #define traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_NOTIFY_WAIT_BLOCK, pxCurrentTCB, ( uxIndexToWait ) )
+    #endif
+    #ifndef traceTASK_NOTIFY_WAIT
+        #define traceTASK_NOTIFY_WAIT( uxIndexToWait )    traceRECORDER_RECORD( traceRECORDER_EVENT_TASK_NOTIFY_WAIT, pxCurrentTCB, ( uxIndexToWait ) )
+    #endif
+#endif /* traceRECORDER_CLASS_NOTIFY */
+
+/**
+ * trace_recorder.h
+ *
+ * @code{c}
+ * void vTraceRecorderEvent( uint8_t ucEventID, uint32_t ulObject, uint32_t ulValue );
+ * @endcode
+ *
+ * Writes a record to the calling core's ring buffer, or streams it out of the
+ * ITM.  Called by the trace macros, and can be called by the application, from
+ * a task or an interrupt, to record its own events with IDs from
+ * traceRECORDER_EVENT_USER_FIRST upwards.  The event is dropped if the buffer
+ * or ITM FIFO is full, and discarded if the recorder has been stopped.
+ *
+ * @param ucEventID The ID of the event.
+ *
+ * @param ulObject The object the event refers to.
+ *
+ * @param ulValue A value that depends on the event.
+ *
+ * \defgroup vTraceRecorderEvent vTraceRecorderEvent
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderEvent( uint8_t ucEventID,
+                          uint32_t ulObject,
+                          uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ *
+ * @code{c}
+ * UBaseType_t uxTraceRecorderRead( BaseType_t xCoreID, TraceRecord_t * pxRecords, UBaseType_t uxMaxRecords );
+ * @endcode
+ *
+ * Moves the oldest records out of a core's ring buffer, making space for new
+ * records.  Each core's buffer must only be read by one task at a time.  The
+ * task can run on any core.  Always returns 0 with the ITM transport, which
+ * does not keep records.
+ *
+ * @param xCoreID The core whose buffer is read.
+ *
+ * @param pxRecords The array the records are copied into.
+ *
+ * @param uxMaxRecords The number of records pxRecords can hold.
+ *
+ * @return The number of records copied into pxRecords, which is 0 if the
+ * buffer is empty.
+ *
+ * Example use:
+ * @code{c}
+ * void vTraceStreamTask( void *pvParameters )
+ * {
+ * TraceRecord_t xRecords[ 32 ];
+ * UBaseType_t uxCount;
+ *
+ *  for( ;; )
+ *  {
+ *      uxCount = uxTraceRecorderRead( 0, xRecords, 32 );
+ *
+ *      if( uxCount > 0 )
+ *      {
+ *          vSendToHost( xRecords, uxCount * sizeof( TraceRecord_t ) );
+ *      }
+ *      else
+ *      {
+ *          vTaskDelay( pdMS_TO_TICKS( 10 ) );
+ *      }
+ *  }
+ * }
+ * @endcode
+ * \defgroup uxTraceRecorderRead uxTraceRecorderRead
+ * \ingroup TraceRecorder
+ */
+UBaseType_t uxTraceRecorderRead( BaseType_t xCoreID,
+                                 TraceRecord_t * pxRecords,
+                                 UBaseType_t uxMaxRecords ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ *
+ * @code{c}
+ * uint32_t ulTraceRecorderGetDroppedCount( BaseType_t xCoreID );
+ * @endcode
+ *
+ * Returns the number of events that were dropped because a core's buffer, or
+ * the ITM FIFO, was full.
+ *
+ * @param xCoreID The core whose count is returned.
+ *
+ * \defgroup ulTraceRecorderGetDroppedCount ulTraceRecorderGetDroppedCount
+ * \ingroup TraceRecorder
+ */
+uint32_t ulTraceRecorderGetDroppedCount( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ *
+ * @code{c}
+ * const TraceRecord_t * pxTraceRecorderGetRecentRecord( BaseType_t xCoreID, UBaseType_t uxAge );
+ * @endcode
+ *
+ * Returns one of the most recent records written to a core's buffer without
+ * removing it.  Records stay in the buffer after they have been read until the
+ * slot they occupy is reused, so this returns read records too.  It takes no
+ * lock, so is intended for use when the system has stopped, for example from a
+ * fault handler - the record returned can otherwise be overwritten at any time.
+ *
+ * @param xCoreID The core whose buffer is accessed.
+ *
+ * @param uxAge 0 to return the newest record, 1 the record before that, and so
+ * on.
+ *
+ * @return A pointer to the record, or NULL if the core has not written that
+ * many records or the record has been overwritten.  Always NULL with the ITM
+ * transport.
+ *
+ * \defgroup pxTraceRecorderGetRecentRecord pxTraceRecorderGetRecentRecord
+ * \ingroup TraceRecorder
+ */
+const TraceRecord_t * pxTraceRecorderGetRecentRecord( BaseType_t xCoreID,
+                                                      UBaseType_t uxAge ) PRIVILEGED_FUNCTION;
+
+/**
+ * trace_recorder.h
+ *
+ * @code{c}
+ * void vTraceRecorderStart( void );
+ * void vTraceRecorderStop( void );
+ * @endcode
+ *
+ * Starts or stops recording on all cores.  The recorder starts out running,
+ * so events are recorded from the first trace macro called.  Events are
+ * discarded, without being counted as dropped, while the recorder is stopped.
+ *
+ * \defgroup vTraceRecorderStart vTraceRecorderStart
+ * \ingroup TraceRecorder
+ */
+void vTraceRecorderStart( void ) PRIVILEGED_FUNCTION;
+void vTraceRecorderStop( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The stream hook.  Called when the number of records in a core's buffer
+ * reaches configTRACE_RECORDER_STREAM_THRESHOLD, on the core that recorded the
+ * event, from whatever context recorded it - which can be an interrupt, a
+ * critical section, or the middle of a context switch.  It must therefore not
+ * call any FreeRTOS API function, but it can, for example, set a flag, start a
+ * DMA transfer, or pend a software interrupt that wakes the task that reads the
+ * buffer.
+ */
+#if ( configUSE_TRACE_RECORDER_STREAM_HOOK == 1 )
+    void vApplicationTraceRecorderStreamHook( BaseType_t xCoreID );
+#endif
+
+/* *INDENT-OFF* */
+#if defined( __cplusplus )
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* TRACE_RECORDER_H */
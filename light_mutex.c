@@ -0,0 +1,473 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+#include "light_mutex.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include light mutex functionality.  This #if is closed at the very bottom
+ * of this file.  If you want to include light mutexes then ensure
+ * configUSE_LIGHT_MUTEXES is set to 1 in FreeRTOSConfig.h. */
+#if ( configUSE_LIGHT_MUTEXES == 1 )
+
+#if ( configUSE_MUTEXES != 1 )
+    #error configUSE_MUTEXES must be set to 1 to use light mutexes
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to use light mutexes
+#endif
+
+#if ( configUSE_PREEMPTION == 0 )
+
+/* If the cooperative scheduler is being used then a yield should not be
+ * performed just because a higher priority task has been woken. */
+    #define lightmutexYIELD_IF_USING_PREEMPTION()
+#else
+    #define lightmutexYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+#endif
+
+/* The owner of a light mutex is the handle of the task that holds it, or NULL
+ * if the mutex is available.  Task control blocks are always at least word
+ * aligned, so the least significant bit of the owner is free to record that
+ * one or more tasks are blocked waiting for the mutex. */
+#define lightmutexWAITERS_BIT    ( ( portPOINTER_SIZE_TYPE ) 1 )
+#define lightmutexGET_HOLDER( pvOwner )      ( ( TaskHandle_t ) ( ( portPOINTER_SIZE_TYPE ) ( pvOwner ) & ~lightmutexWAITERS_BIT ) )                /*lint !e923 !e9078 Pointer is aligned so the bit is not part of the address. */
+#define lightmutexHAS_WAITERS( pvOwner )     ( ( ( portPOINTER_SIZE_TYPE ) ( pvOwner ) & lightmutexWAITERS_BIT ) != ( portPOINTER_SIZE_TYPE ) 0 ) /*lint !e923 !e9078 Pointer is aligned so the bit is not part of the address. */
+#define lightmutexSET_WAITERS( pvOwner )     ( ( void * ) ( ( portPOINTER_SIZE_TYPE ) ( pvOwner ) | lightmutexWAITERS_BIT ) )                       /*lint !e923 !e9078 Pointer is aligned so the bit is not part of the address. */
+
+/*
+ * While the waiters bit is clear the owner is only ever changed by an atomic
+ * compare and swap, so a task can take an available mutex, and give back a
+ * mutex no other task is waiting for, without entering the kernel.  A task that
+ * has to wait sets the waiters bit from within a critical section, so the
+ * holder's compare and swap fails when it gives the mutex back and it also
+ * enters a critical section to unblock the waiting task.
+ */
+typedef struct LightMutexDefinition
+{
+    void * volatile pvOwner;       /*< The handle of the holding task, with lightmutexWAITERS_BIT set if tasks are waiting, or NULL if the mutex is available. */
+    List_t xTasksWaitingToTake;    /*< List of tasks that are blocked waiting for the mutex.  Stored in priority order. */
+    uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the memory used by the mutex was statically allocated so no attempt is made to free it. */
+} LightMutex_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the dynamic and static create functions to fill in the
+ * members of a newly created mutex.
+ */
+static void prvInitialiseNewLightMutex( LightMutex_t * const pxMutex,
+                                        const uint8_t ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*
+ * The slow path of xLightMutexTake(), used when the mutex is not available.
+ */
+static BaseType_t prvTakeContended( LightMutex_t * const pxMutex,
+                                    TaskHandle_t xCurrentTask,
+                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * If a task waiting for a mutex causes the holder to inherit a priority, but
+ * the waiting task times out, then the holder should disinherit the priority -
+ * but only down to the highest priority of any other tasks that are waiting for
+ * the same mutex.  This function returns that priority.
+ */
+static UBaseType_t prvLightMutexDisinheritPriority( const LightMutex_t * const pxMutex ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewLightMutex( LightMutex_t * const pxMutex,
+                                        const uint8_t ucStaticallyAllocated )
+{
+    pxMutex->pvOwner = NULL;
+    vListInitialise( &( pxMutex->xTasksWaitingToTake ) );
+    pxMutex->ucStaticallyAllocated = ucStaticallyAllocated;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    LightMutexHandle_t xLightMutexCreate( void )
+    {
+        LightMutex_t * pxMutex;
+
+        pxMutex = ( LightMutex_t * ) pvPortMalloc( sizeof( LightMutex_t ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxMutex != NULL )
+        {
+            prvInitialiseNewLightMutex( pxMutex, ( uint8_t ) pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxMutex;
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    LightMutexHandle_t xLightMutexCreateStatic( StaticLightMutex_t * const pxMutexBuffer )
+    {
+        LightMutex_t * const pxMutex = ( LightMutex_t * ) pxMutexBuffer; /*lint !e740 !e9087 Safe cast as StaticLightMutex_t is opaque LightMutex_t. */
+
+        configASSERT( pxMutexBuffer );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticLightMutex_t equals the size of the real
+             * mutex structure. */
+            volatile size_t xSize = sizeof( StaticLightMutex_t );
+            configASSERT( xSize == sizeof( LightMutex_t ) );
+        } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( pxMutex != NULL )
+        {
+            prvInitialiseNewLightMutex( pxMutex, ( uint8_t ) pdTRUE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxMutex;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vLightMutexDelete( LightMutexHandle_t xMutex )
+{
+    LightMutex_t * const pxMutex = xMutex;
+
+    configASSERT( pxMutex );
+    configASSERT( pxMutex->pvOwner == NULL );
+    configASSERT( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) != pdFALSE );
+
+    if( pxMutex->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            vPortFree( ( void * ) pxMutex ); /*lint !e9087 Standard free() semantics require void *. */
+        }
+        #else
+        {
+            /* Should not be possible to get here, the flag must be corrupt.
+             * Force an assert. */
+            configASSERT( xMutex == ( LightMutexHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure was not allocated dynamically and cannot be freed -
+         * just scrub it so future use will assert. */
+        ( void ) memset( ( void * ) pxMutex, 0x00, sizeof( LightMutex_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightMutexTake( LightMutexHandle_t xMutex,
+                            TickType_t xTicksToWait )
+{
+    LightMutex_t * const pxMutex = xMutex;
+    TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    BaseType_t xReturn;
+
+    configASSERT( pxMutex );
+
+    /* Light mutexes cannot be taken recursively. */
+    configASSERT( lightmutexGET_HOLDER( pxMutex->pvOwner ) != xCurrentTask );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /* The mutex is available if there is no owner, in which case it is taken
+     * by swapping in the handle of the calling task. */
+    if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvOwner ), ( void * ) xCurrentTask, NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+    {
+        ( void ) pvTaskIncrementMutexHeldCount();
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = prvTakeContended( pxMutex, xCurrentTask, xTicksToWait );
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvTakeContended( LightMutex_t * const pxMutex,
+                                    TaskHandle_t xCurrentTask,
+                                    TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE;
+    BaseType_t xReturn = pdFAIL, xComplete = pdFALSE;
+    TimeOut_t xTimeOut;
+    void * pvOwner;
+
+    while( xComplete == pdFALSE )
+    {
+        taskENTER_CRITICAL();
+        {
+            pvOwner = pxMutex->pvOwner;
+
+            if( pvOwner == NULL )
+            {
+                /* The mutex has been given back.  Record that tasks are still
+                 * waiting if there are any, so the holder enters the kernel to
+                 * unblock one of them when it gives the mutex back.  A task
+                 * on another core may take the mutex without entering a
+                 * critical section, hence the compare and swap. */
+                if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) == pdFALSE )
+                {
+                    pvOwner = lightmutexSET_WAITERS( xCurrentTask );
+                }
+                else
+                {
+                    pvOwner = ( void * ) xCurrentTask;
+                }
+
+                if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvOwner ), pvOwner, NULL ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                {
+                    ( void ) pvTaskIncrementMutexHeldCount();
+                    xReturn = pdPASS;
+                    xComplete = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( xTicksToWait == ( TickType_t ) 0 )
+            {
+                /* The mutex is held and no block time was specified (or the
+                 * block time has expired) so leave now. */
+                xComplete = pdTRUE;
+            }
+            else if( xEntryTimeSet == pdFALSE )
+            {
+                /* The mutex was held and a block time was specified, so
+                 * configure the timeout structure before blocking for the first
+                 * time. */
+                vTaskInternalSetTimeOutState( &xTimeOut );
+                xEntryTimeSet = pdTRUE;
+            }
+            else if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+            {
+                xComplete = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( ( xComplete == pdFALSE ) && ( xEntryTimeSet != pdFALSE ) && ( pvOwner != NULL ) )
+            {
+                /* Set the waiters bit.  If the holder gave the mutex back
+                 * without entering a critical section since the owner was read
+                 * then the compare and swap fails and the loop tries again. */
+                if( ( lightmutexHAS_WAITERS( pvOwner ) != pdFALSE ) ||
+                    ( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvOwner ), lightmutexSET_WAITERS( pvOwner ), pvOwner ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS ) )
+                {
+                    xInheritanceOccurred = xTaskPriorityInherit( lightmutexGET_HOLDER( pvOwner ) );
+                    vTaskPlaceOnEventList( &( pxMutex->xTasksWaitingToTake ), xTicksToWait );
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until
+                     * the critical section exits). */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( ( xReturn == pdFAIL ) && ( xComplete != pdFALSE ) && ( xInheritanceOccurred != pdFALSE ) )
+            {
+                /* This task timed out after causing the holder to inherit its
+                 * priority, so the holder's priority can drop back to the
+                 * highest priority of any tasks that are still waiting.  If
+                 * no tasks are still waiting then clear the waiters bit so the
+                 * holder does not enter the kernel when it gives the mutex
+                 * back. */
+                if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) != pdFALSE )
+                {
+                    pxMutex->pvOwner = ( void * ) lightmutexGET_HOLDER( pvOwner );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                vTaskPriorityDisinheritAfterTimeout( lightmutexGET_HOLDER( pvOwner ), prvLightMutexDisinheritPriority( pxMutex ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xLightMutexGive( LightMutexHandle_t xMutex )
+{
+    LightMutex_t * const pxMutex = xMutex;
+    TaskHandle_t xCurrentTask = xTaskGetCurrentTaskHandle();
+    BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+
+    configASSERT( pxMutex );
+
+    if( Atomic_CompareAndSwapPointers_p32( &( pxMutex->pvOwner ), NULL, ( void * ) xCurrentTask ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+    {
+        /* No tasks were waiting for the mutex, so only the held count needs
+         * updating, unless this was the last mutex held by a task that had
+         * inherited a priority through a different mutex. */
+        xYieldRequired = xTaskDecrementMutexHeldCount();
+    }
+    else
+    {
+        /* Either tasks are waiting, in which case the kernel must unblock the
+         * highest priority of them, or the calling task does not hold the
+         * mutex.  While the calling task holds the mutex no other task can
+         * change the owner without first entering a critical section. */
+        taskENTER_CRITICAL();
+        {
+            if( lightmutexGET_HOLDER( pxMutex->pvOwner ) == xCurrentTask )
+            {
+                pxMutex->pvOwner = NULL;
+
+                if( xTaskPriorityDisinherit( xCurrentTask ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( listLIST_IS_EMPTY( &( pxMutex->xTasksWaitingToTake ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxMutex->xTasksWaitingToTake ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    if( xYieldRequired != pdFALSE )
+    {
+        lightmutexYIELD_IF_USING_PREEMPTION();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+TaskHandle_t xLightMutexGetHolder( LightMutexHandle_t xMutex )
+{
+    const LightMutex_t * const pxMutex = xMutex;
+
+    configASSERT( pxMutex );
+
+    return lightmutexGET_HOLDER( pxMutex->pvOwner );
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvLightMutexDisinheritPriority( const LightMutex_t * const pxMutex )
+{
+    UBaseType_t uxHighestPriorityOfWaitingTasks;
+
+    if( listCURRENT_LIST_LENGTH( &( pxMutex->xTasksWaitingToTake ) ) > 0U )
+    {
+        uxHighestPriorityOfWaitingTasks = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxMutex->xTasksWaitingToTake ) );
+    }
+    else
+    {
+        uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
+    }
+
+    return uxHighestPriorityOfWaitingTasks;
+}
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include light mutex functionality.  If you want to include light mutexes
+ * then ensure configUSE_LIGHT_MUTEXES is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_LIGHT_MUTEXES == 1 */
@@ -43,6 +43,22 @@
  * generate the correct privileged Vs unprivileged linkage and placement. */
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
 
+#if ( configUSE_SKIP_LISTS == 1 )
+
+/* State of the generator used to choose how many express levels a list item
+ * inserted by vListInsert() is linked onto.  It is only accessed with the
+ * scheduler suspended or from within a critical section, as are the lists. */
+    static uint32_t ulSkipListSeed = 0x2545F491UL;
+
+/*
+ * Return the number of express levels, between 0 and
+ * ( configSKIP_LIST_LEVELS - 1 ), to link a newly sorted item onto.  Each level
+ * is used by a quarter of the items on the level below it.
+ */
+    static UBaseType_t prvSkipListLevels( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_SKIP_LISTS */
+
 /*-----------------------------------------------------------
 * PUBLIC LIST API documented in list.h
 *----------------------------------------------------------*/
@@ -52,7 +68,7 @@ void vListInitialise( List_t * const pxList )
     /* The list structure contains a list item which is used to mark the
      * end of the list.  To initialise the list the list end is inserted
      * as the only list entry. */
-    pxList->pxIndex = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    listSET_INDEX( pxList, ( ListItem_t * ) &( pxList->xListEnd ) ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
 
     listSET_FIRST_LIST_ITEM_INTEGRITY_CHECK_VALUE( &( pxList->xListEnd ) );
 
@@ -62,20 +78,41 @@ void vListInitialise( List_t * const pxList )
 
     /* The list end next and previous pointers point to itself so we know
      * when the list is empty. */
-    pxList->xListEnd.pxNext = ( ListItem_t * ) &( pxList->xListEnd );     /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
-    pxList->xListEnd.pxPrevious = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    listSET_NEXT( &( pxList->xListEnd ), ( ListItem_t * ) &( pxList->xListEnd ) );     /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+    listSET_PREVIOUS( &( pxList->xListEnd ), ( ListItem_t * ) &( pxList->xListEnd ) ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+    #if ( configUSE_SKIP_LISTS == 1 )
+    {
+        UBaseType_t uxSkipLevel;
+
+        /* The list end is on every express level. */
+        for( uxSkipLevel = ( UBaseType_t ) 0U; uxSkipLevel < ( UBaseType_t ) ( configSKIP_LIST_LEVELS - 1 ); uxSkipLevel++ )
+        {
+            pxList->xListEnd.pxSkipNext[ uxSkipLevel ] = ( ListItem_t * ) &( pxList->xListEnd );     /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+            pxList->xListEnd.pxSkipPrevious[ uxSkipLevel ] = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+        }
+    }
+    #endif /* configUSE_SKIP_LISTS */
 
     /* Initialize the remaining fields of xListEnd when it is a proper ListItem_t */
     #if ( configUSE_MINI_LIST_ITEM == 0 )
     {
-        pxList->xListEnd.pvOwner = NULL;
-        pxList->xListEnd.pxContainer = NULL;
+        listSET_LIST_ITEM_OWNER( &( pxList->xListEnd ), NULL );
+        listSET_LIST_ITEM_CONTAINER( &( pxList->xListEnd ), NULL );
         listSET_SECOND_LIST_ITEM_INTEGRITY_CHECK_VALUE( &( pxList->xListEnd ) );
     }
     #endif
 
     pxList->uxNumberOfItems = ( UBaseType_t ) 0U;
 
+    #if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    {
+        /* The list must lie inside the window of memory that can be reached
+         * from configLIST_COMPACT_BASE by a 16-bit link. */
+        configASSERT( listLINK_TO_POINTER( listLINK_FROM_POINTER( pxList ) ) == ( void * ) pxList );
+    }
+    #endif
+
     /* Write known values into the list if
      * configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
     listSET_LIST_INTEGRITY_CHECK_1_VALUE( pxList );
@@ -86,7 +123,15 @@ void vListInitialise( List_t * const pxList )
 void vListInitialiseItem( ListItem_t * const pxItem )
 {
     /* Make sure the list item is not recorded as being on a list. */
-    pxItem->pxContainer = NULL;
+    listSET_LIST_ITEM_CONTAINER( pxItem, NULL );
+    listSKIP_RESET( pxItem );
+
+    #if ( configUSE_COMPACT_LIST_LINKS == 1 )
+    {
+        /* As for the list in vListInitialise(). */
+        configASSERT( listLINK_TO_POINTER( listLINK_FROM_POINTER( pxItem ) ) == ( void * ) pxItem );
+    }
+    #endif
 
     /* Write known values into the list item if
      * configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
@@ -98,7 +143,7 @@ void vListInitialiseItem( ListItem_t * const pxItem )
 void vListInsertEnd( List_t * const pxList,
                      ListItem_t * const pxNewListItem )
 {
-    ListItem_t * const pxIndex = pxList->pxIndex;
+    ListItem_t * const pxIndex = listGET_INDEX( pxList );
 
     /* Only effective when configASSERT() is also defined, these tests may catch
      * the list data structures being overwritten in memory.  They will not catch
@@ -109,17 +154,18 @@ void vListInsertEnd( List_t * const pxList,
     /* Insert a new list item into pxList, but rather than sort the list,
      * makes the new list item the last item to be removed by a call to
      * listGET_OWNER_OF_NEXT_ENTRY(). */
-    pxNewListItem->pxNext = pxIndex;
-    pxNewListItem->pxPrevious = pxIndex->pxPrevious;
+    listSET_NEXT( pxNewListItem, pxIndex );
+    listSET_PREVIOUS( pxNewListItem, listGET_PREVIOUS( pxIndex ) );
 
     /* Only used during decision coverage testing. */
     mtCOVERAGE_TEST_DELAY();
 
-    pxIndex->pxPrevious->pxNext = pxNewListItem;
-    pxIndex->pxPrevious = pxNewListItem;
+    listSET_NEXT( listGET_PREVIOUS( pxIndex ), pxNewListItem );
+    listSET_PREVIOUS( pxIndex, pxNewListItem );
+    listSKIP_RESET( pxNewListItem );
 
     /* Remember which list the item is in. */
-    pxNewListItem->pxContainer = pxList;
+    listSET_LIST_ITEM_CONTAINER( pxNewListItem, pxList );
 
     ( pxList->uxNumberOfItems )++;
 }
@@ -131,6 +177,12 @@ void vListInsert( List_t * const pxList,
     ListItem_t * pxIterator;
     const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
 
+    #if ( configUSE_SKIP_LISTS == 1 )
+        ListItem_t * pxSkipPredecessor[ configSKIP_LIST_LEVELS - 1 ];
+        UBaseType_t uxSkipLevel;
+        UBaseType_t uxSkipLevels = ( UBaseType_t ) 0U;
+    #endif
+
     /* Only effective when configASSERT() is also defined, these tests may catch
      * the list data structures being overwritten in memory.  They will not catch
      * data errors caused by incorrect configuration or use of FreeRTOS. */
@@ -147,8 +199,37 @@ void vListInsert( List_t * const pxList,
      * first, and the algorithm slightly modified if necessary. */
     if( xValueOfInsertion == portMAX_DELAY )
     {
-        pxIterator = pxList->xListEnd.pxPrevious;
+        pxIterator = listGET_PREVIOUS( &( pxList->xListEnd ) );
     }
+    #if ( configUSE_SKIP_LISTS == 1 )
+        else
+        {
+            /* Descend the express levels, on each moving forward to the last
+             * item that is to remain before the new item.  The item found on
+             * one level is on all the levels below it, so the search continues
+             * from there.  The list end has the highest possible value so
+             * stops the search on every level. */
+            pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. */
+
+            for( uxSkipLevel = ( UBaseType_t ) ( configSKIP_LIST_LEVELS - 1 ); uxSkipLevel > ( UBaseType_t ) 0U; uxSkipLevel-- )
+            {
+                while( pxIterator->pxSkipNext[ uxSkipLevel - 1U ]->xItemValue <= xValueOfInsertion )
+                {
+                    pxIterator = pxIterator->pxSkipNext[ uxSkipLevel - 1U ];
+                }
+
+                pxSkipPredecessor[ uxSkipLevel - 1U ] = pxIterator;
+            }
+
+            /* Finish on the list itself. */
+            while( listGET_NEXT( pxIterator )->xItemValue <= xValueOfInsertion )
+            {
+                pxIterator = listGET_NEXT( pxIterator );
+            }
+
+            uxSkipLevels = prvSkipListLevels();
+        }
+    #else /* if ( configUSE_SKIP_LISTS == 1 ) */
     else
     {
         /* *** NOTE ***********************************************************
@@ -176,21 +257,36 @@ void vListInsert( List_t * const pxList,
         *      configMAX_SYSCALL_INTERRUPT_PRIORITY.
         **********************************************************************/
 
-        for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); pxIterator->pxNext->xItemValue <= xValueOfInsertion; pxIterator = pxIterator->pxNext ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. *//*lint !e440 The iterator moves to a different value, not xValueOfInsertion. */
+        for( pxIterator = ( ListItem_t * ) &( pxList->xListEnd ); listGET_NEXT( pxIterator )->xItemValue <= xValueOfInsertion; pxIterator = listGET_NEXT( pxIterator ) ) /*lint !e826 !e740 !e9087 The mini list structure is used as the list end to save RAM.  This is checked and valid. *//*lint !e440 The iterator moves to a different value, not xValueOfInsertion. */
         {
             /* There is nothing to do here, just iterating to the wanted
              * insertion position. */
         }
     }
+    #endif /* configUSE_SKIP_LISTS */
+
+    listSET_NEXT( pxNewListItem, listGET_NEXT( pxIterator ) );
+    listSET_PREVIOUS( listGET_NEXT( pxNewListItem ), pxNewListItem );
+    listSET_PREVIOUS( pxNewListItem, pxIterator );
+    listSET_NEXT( pxIterator, pxNewListItem );
+
+    #if ( configUSE_SKIP_LISTS == 1 )
+    {
+        for( uxSkipLevel = ( UBaseType_t ) 0U; uxSkipLevel < uxSkipLevels; uxSkipLevel++ )
+        {
+            pxNewListItem->pxSkipNext[ uxSkipLevel ] = pxSkipPredecessor[ uxSkipLevel ]->pxSkipNext[ uxSkipLevel ];
+            pxNewListItem->pxSkipPrevious[ uxSkipLevel ] = pxSkipPredecessor[ uxSkipLevel ];
+            pxSkipPredecessor[ uxSkipLevel ]->pxSkipNext[ uxSkipLevel ]->pxSkipPrevious[ uxSkipLevel ] = pxNewListItem;
+            pxSkipPredecessor[ uxSkipLevel ]->pxSkipNext[ uxSkipLevel ] = pxNewListItem;
+        }
 
-    pxNewListItem->pxNext = pxIterator->pxNext;
-    pxNewListItem->pxNext->pxPrevious = pxNewListItem;
-    pxNewListItem->pxPrevious = pxIterator;
-    pxIterator->pxNext = pxNewListItem;
+        pxNewListItem->uxSkipLevels = uxSkipLevels;
+    }
+    #endif /* configUSE_SKIP_LISTS */
 
     /* Remember which list the item is in.  This allows fast removal of the
      * item later. */
-    pxNewListItem->pxContainer = pxList;
+    listSET_LIST_ITEM_CONTAINER( pxNewListItem, pxList );
 
     ( pxList->uxNumberOfItems )++;
 }
@@ -200,27 +296,53 @@ UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove )
 {
 /* The list item knows which list it is in.  Obtain the list from the list
  * item. */
-    List_t * const pxList = pxItemToRemove->pxContainer;
+    List_t * const pxList = listLIST_ITEM_CONTAINER( pxItemToRemove );
 
-    pxItemToRemove->pxNext->pxPrevious = pxItemToRemove->pxPrevious;
-    pxItemToRemove->pxPrevious->pxNext = pxItemToRemove->pxNext;
+    listSET_PREVIOUS( listGET_NEXT( pxItemToRemove ), listGET_PREVIOUS( pxItemToRemove ) );
+    listSET_NEXT( listGET_PREVIOUS( pxItemToRemove ), listGET_NEXT( pxItemToRemove ) );
+    listSKIP_UNLINK( pxItemToRemove );
 
     /* Only used during decision coverage testing. */
     mtCOVERAGE_TEST_DELAY();
 
     /* Make sure the index is left pointing to a valid item. */
-    if( pxList->pxIndex == pxItemToRemove )
+    if( listGET_INDEX( pxList ) == pxItemToRemove )
     {
-        pxList->pxIndex = pxItemToRemove->pxPrevious;
+        listSET_INDEX( pxList, listGET_PREVIOUS( pxItemToRemove ) );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    pxItemToRemove->pxContainer = NULL;
+    listSET_LIST_ITEM_CONTAINER( pxItemToRemove, NULL );
     ( pxList->uxNumberOfItems )--;
 
     return pxList->uxNumberOfItems;
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_SKIP_LISTS == 1 )
+
+    static UBaseType_t prvSkipListLevels( void )
+    {
+        UBaseType_t uxLevels = ( UBaseType_t ) 0U;
+        uint32_t ulBits;
+
+        /* xorshift32 - only needs to be cheap and well spread, not secure. */
+        ulSkipListSeed ^= ulSkipListSeed << 13;
+        ulSkipListSeed ^= ulSkipListSeed >> 17;
+        ulSkipListSeed ^= ulSkipListSeed << 5;
+        ulBits = ulSkipListSeed;
+
+        while( ( uxLevels < ( UBaseType_t ) ( configSKIP_LIST_LEVELS - 1 ) ) && ( ( ulBits & 0x03UL ) == 0UL ) )
+        {
+            uxLevels++;
+            ulBits >>= 2;
+        }
+
+        return uxLevels;
+    }
+
+#endif /* configUSE_SKIP_LISTS */
+/*-----------------------------------------------------------*/
@@ -0,0 +1,234 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "object_registry.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the object registry.  This #if is closed at the very bottom of
+ * this file. */
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+/* The first and last objects in the registry, in creation order. */
+    PRIVILEGED_DATA static ObjectRegistryItem_t * pxRegistryHead = NULL;
+    PRIVILEGED_DATA static ObjectRegistryItem_t * pxRegistryTail = NULL;
+
+/* The number given to the next object added to the registry. */
+    PRIVILEGED_DATA static UBaseType_t uxNextObjectNumber = ( UBaseType_t ) 1U;
+
+/* Changes whenever an object is added or removed, so an iterator can tell if
+ * the item it remembers might have been freed. */
+    PRIVILEGED_DATA static UBaseType_t uxRegistryGeneration = ( UBaseType_t ) 0U;
+
+/* The number of objects of each type in the registry. */
+    PRIVILEGED_DATA static UBaseType_t uxObjectCounts[ eObjectNumberOfTypes ] = { 0 };
+
+/*-----------------------------------------------------------*/
+
+    void vObjectRegistryAdd( ObjectRegistryItem_t * pxItem,
+                             void * pvObject,
+                             eObjectType eType,
+                             const char * pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        configASSERT( pxItem );
+        configASSERT( eType < eObjectNumberOfTypes );
+
+        pxItem->pvObject = pvObject;
+        pxItem->pcName = pcName;
+        pxItem->uxType = ( UBaseType_t ) eType;
+
+        taskENTER_CRITICAL();
+        {
+            pxItem->uxObjectNumber = uxNextObjectNumber;
+            uxNextObjectNumber++;
+
+            pxItem->pxNext = NULL;
+            pxItem->pxPrevious = pxRegistryTail;
+
+            if( pxRegistryTail != NULL )
+            {
+                pxRegistryTail->pxNext = pxItem;
+            }
+            else
+            {
+                pxRegistryHead = pxItem;
+            }
+
+            pxRegistryTail = pxItem;
+            uxObjectCounts[ eType ]++;
+            uxRegistryGeneration++;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vObjectRegistryRemove( ObjectRegistryItem_t * pxItem )
+    {
+        configASSERT( pxItem );
+        configASSERT( pxItem->uxType < ( UBaseType_t ) eObjectNumberOfTypes );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxItem->pxPrevious != NULL )
+            {
+                pxItem->pxPrevious->pxNext = pxItem->pxNext;
+            }
+            else
+            {
+                pxRegistryHead = pxItem->pxNext;
+            }
+
+            if( pxItem->pxNext != NULL )
+            {
+                pxItem->pxNext->pxPrevious = pxItem->pxPrevious;
+            }
+            else
+            {
+                pxRegistryTail = pxItem->pxPrevious;
+            }
+
+            pxItem->pxNext = NULL;
+            pxItem->pxPrevious = NULL;
+            uxObjectCounts[ pxItem->uxType ]--;
+            uxRegistryGeneration++;
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    void vObjectIteratorInit( ObjectIterator_t * pxIterator )
+    {
+        configASSERT( pxIterator );
+
+        pxIterator->pvNextItem = NULL;
+        pxIterator->uxLastObjectNumber = ( UBaseType_t ) 0U;
+
+        /* uxRegistryGeneration never matches this value after the first
+         * object has been added, so the first call to xObjectIteratorNext()
+         * starts from the first object. */
+        pxIterator->uxGeneration = ( UBaseType_t ) 0U;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xObjectIteratorNext( ObjectIterator_t * pxIterator,
+                                    ObjectStatus_t * pxObjectStatus )
+    {
+        const ObjectRegistryItem_t * pxItem;
+        BaseType_t xReturn = pdFALSE;
+
+        configASSERT( pxIterator );
+        configASSERT( pxObjectStatus );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxIterator->uxGeneration == uxRegistryGeneration )
+            {
+                /* No object has been added or removed since the last call, so
+                 * the item that followed the last one returned is still
+                 * valid. */
+                pxItem = ( const ObjectRegistryItem_t * ) pxIterator->pvNextItem;
+            }
+            else
+            {
+                /* The remembered item might belong to an object that has since
+                 * been deleted.  Find the position again from the object
+                 * numbers, which increase along the list. */
+                pxItem = pxRegistryHead;
+
+                while( ( pxItem != NULL ) && ( pxItem->uxObjectNumber <= pxIterator->uxLastObjectNumber ) )
+                {
+                    pxItem = pxItem->pxNext;
+                }
+            }
+
+            if( pxItem != NULL )
+            {
+                pxObjectStatus->pvObject = pxItem->pvObject;
+                pxObjectStatus->eType = ( eObjectType ) pxItem->uxType;
+                pxObjectStatus->pcName = pxItem->pcName;
+                pxObjectStatus->uxObjectNumber = pxItem->uxObjectNumber;
+
+                pxIterator->uxLastObjectNumber = pxItem->uxObjectNumber;
+                pxIterator->pvNextItem = pxItem->pxNext;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                pxIterator->pvNextItem = NULL;
+            }
+
+            pxIterator->uxGeneration = uxRegistryGeneration;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxObjectRegistryGetCount( eObjectType eType )
+    {
+        UBaseType_t uxReturn = ( UBaseType_t ) 0U;
+        UBaseType_t ux;
+
+        taskENTER_CRITICAL();
+        {
+            if( eType < eObjectNumberOfTypes )
+            {
+                uxReturn = uxObjectCounts[ eType ];
+            }
+            else
+            {
+                for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) eObjectNumberOfTypes; ux++ )
+                {
+                    uxReturn += uxObjectCounts[ ux ];
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the object registry.  If you want to include it then ensure
+ * configUSE_OBJECT_REGISTRY is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_OBJECT_REGISTRY == 1 */
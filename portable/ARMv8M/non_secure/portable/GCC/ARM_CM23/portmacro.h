@@ -55,6 +55,10 @@
 #if( configTOTAL_MPU_REGIONS == 16 )
     #error 16 MPU regions are not yet supported for this port.
 #endif
+
+#if( configCHECK_FOR_STACK_OVERFLOW == 3 )
+    #error configCHECK_FOR_STACK_OVERFLOW 3 relies on the PSPLIM stack limit register, which Cortex-M23 does not implement for the non-secure state.
+#endif
 /*-----------------------------------------------------------*/
 
 /**
@@ -37,8 +37,8 @@ files (__ICCARM__ is defined by the IAR C compiler but not by the IAR assembler.
     EXTERN xSecureContext
     EXTERN vTaskSwitchContext
     EXTERN vPortSVCHandler_C
-    EXTERN SecureContext_SaveContext
-    EXTERN SecureContext_LoadContext
+    EXTERN vPortSaveSecureContext
+    EXTERN vPortLoadSecureContext
 
     PUBLIC xIsPrivileged
     PUBLIC vResetPrivilege
@@ -208,12 +208,13 @@ PendSV_Handler:
     mrs r2, psp                             /* Read PSP in r2. */
 
     cbz r0, save_ns_context                 /* No secure context to save. */
+    mov r3, lr                              /* r3 = LR/EXC_RETURN. */
+    lsls r3, r3, #25                        /* r3 = r3 << 25. Bit[6] of EXC_RETURN is 1 if secure stack was used, 0 if non-secure stack was used to store stack frame. */
+    bpl save_ns_context                     /* The task is not running secure code, so its secure context is left loaded - see vPortLoadSecureContext(). */
     push {r0-r2, r14}
-    bl SecureContext_SaveContext            /* Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
+    bl vPortSaveSecureContext               /* Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
     pop {r0-r3}                             /* LR is now in r3. */
     mov lr, r3                              /* LR = r3. */
-    lsls r1, r3, #25                        /* r1 = r3 << 25. Bit[6] of EXC_RETURN is 1 if secure stack was used, 0 if non-secure stack was used to store stack frame. */
-    bpl save_ns_context                     /* bpl - branch if positive or zero. If r1 >= 0 ==> Bit[6] in EXC_RETURN is 0 i.e. non-secure stack was used. */
     ldr r3, =pxCurrentTCB                   /* Read the location of pxCurrentTCB i.e. &( pxCurrentTCB ). */
     ldr r1, [r3]                            /* Read pxCurrentTCB. */
 #if ( configENABLE_MPU == 1 )
@@ -322,11 +323,10 @@ PendSV_Handler:
         mov lr, r4                          /* LR = r4. */
         ldr r3, =xSecureContext             /* Read the location of xSecureContext i.e. &( xSecureContext ). */
         str r0, [r3]                        /* Restore the task's xSecureContext. */
-        cbz r0, restore_ns_context          /* If there is no secure context for the task, restore the non-secure context. */
         ldr r3, =pxCurrentTCB               /* Read the location of pxCurrentTCB i.e. &( pxCurrentTCB ). */
         ldr r1, [r3]                        /* Read pxCurrentTCB. */
         push {r2, r4}
-        bl SecureContext_LoadContext        /* Restore the secure context. Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
+        bl vPortLoadSecureContext           /* Load the secure context of the task, or save the one left loaded if the task has none. Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
         pop {r2, r4}
         mov lr, r4                          /* LR = r4. */
         lsls r1, r4, #25                    /* r1 = r4 << 25. Bit[6] of EXC_RETURN is 1 if secure stack was used, 0 if non-secure stack was used to store stack frame. */
@@ -339,11 +339,10 @@ PendSV_Handler:
         mov lr, r4                          /* LR = r4. */
         ldr r3, =xSecureContext             /* Read the location of xSecureContext i.e. &( xSecureContext ). */
         str r0, [r3]                        /* Restore the task's xSecureContext. */
-        cbz r0, restore_ns_context          /* If there is no secure context for the task, restore the non-secure context. */
         ldr r3, =pxCurrentTCB               /* Read the location of pxCurrentTCB i.e. &( pxCurrentTCB ). */
         ldr r1, [r3]                        /* Read pxCurrentTCB. */
         push {r2, r4}
-        bl SecureContext_LoadContext        /* Restore the secure context. Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
+        bl vPortLoadSecureContext           /* Load the secure context of the task, or save the one left loaded if the task has none. Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
         pop {r2, r4}
         mov lr, r4                          /* LR = r4. */
         lsls r1, r4, #25                    /* r1 = r4 << 25. Bit[6] of EXC_RETURN is 1 if secure stack was used, 0 if non-secure stack was used to store stack frame. */
@@ -0,0 +1,811 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * On-target cycle benchmark.  See cycle_benchmark.h.
+ */
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "event_groups.h"
+#include "cycle_benchmark.h"
+
+#if ( configUSE_CYCLE_BENCHMARK == 1 )
+
+    #define cyclebenchSTACK_SIZE           ( configMINIMAL_STACK_SIZE * 2 )
+
+/* The number of samples taken between the delays that let the background
+ * tasks run. */
+    #define cyclebenchLOAD_INTERVAL        ( 32UL )
+
+/* The number of blocks each background task keeps allocated. */
+    #define cyclebenchBACKGROUND_BLOCKS    ( 4 )
+
+/* The event group bits the scaling benchmark's blocked tasks wait for, and the
+ * bit it sets that none of them wait for. */
+    #define cyclebenchLOAD_BIT             ( ( EventBits_t ) 0x01U )
+    #define cyclebenchMEASURED_BIT         ( ( EventBits_t ) 0x02U )
+
+/* The timeout of the operation measured by the scaling benchmark, and the
+ * slightly shorter timeout of the blocked tasks and timers, so the measured
+ * operation is sorted after all of them in the delayed or timer list. */
+    #define cyclebenchMEASURED_TIMEOUT     ( portMAX_DELAY / ( TickType_t ) 2 )
+    #define cyclebenchLOAD_TIMEOUT         ( cyclebenchMEASURED_TIMEOUT - ( TickType_t ) 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Find the cost of reading the cycle counter.
+ */
+    static void prvMeasureReadOverhead( void );
+
+/*
+ * Start a result, and the total used to average its samples.
+ */
+    static void prvStartResult( CycleBenchmarkResult_t * pxResult,
+                                const char * pcName );
+
+/*
+ * Add the measurement ulEnd - ulStart to the current result, less the cost of
+ * reading the cycle counter.
+ */
+    static void prvAddSample( CycleBenchmarkResult_t * pxResult,
+                              uint32_t ulStart,
+                              uint32_t ulEnd );
+
+/*
+ * Complete the current result.
+ */
+    static void prvEndResult( CycleBenchmarkResult_t * pxResult );
+
+/*
+ * Delay for a tick every cyclebenchLOAD_INTERVAL samples so the background
+ * tasks run.
+ */
+    static void prvLetLoadRun( uint32_t ulSample );
+
+/*
+ * Create a task, asserting that it was created.
+ */
+    static TaskHandle_t prvCreateTask( TaskFunction_t pxTaskCode,
+                                       const char * pcName,
+                                       void * pvParameters,
+                                       UBaseType_t uxPriority );
+
+/*
+ * The benchmarks, and the tasks they run against.
+ */
+    static void prvBenchmarkQueueSend( CycleBenchmarkResult_t * pxResult );
+    static void prvBenchmarkTaskNotify( CycleBenchmarkResult_t * pxResult );
+    static void prvBenchmarkSemaphoreTake( CycleBenchmarkResult_t * pxResult );
+    static void prvBenchmarkContextSwitch( CycleBenchmarkResult_t * pxResult );
+    static void prvBenchmarkTickInterrupt( CycleBenchmarkResult_t * pxResult );
+    static void prvBenchmarkMalloc( CycleBenchmarkResult_t * pxResult );
+
+    static void prvYieldTask( void * pvParameters );
+    static void prvTickTask( void * pvParameters );
+    static void prvBackgroundTask( void * pvParameters );
+
+/*
+ * The scaling benchmarks, and the tasks and timers they run against.
+ */
+    static void prvScaleQueueReceiveTimeout( CycleBenchmarkResult_t * pxResult );
+    static void prvScaleTimerReset( CycleBenchmarkResult_t * pxResult );
+    static void prvScaleEventGroupSetBits( CycleBenchmarkResult_t * pxResult );
+    static void prvScaleTaskCreate( CycleBenchmarkResult_t * pxResult );
+
+    static void prvScaleLoadTask( void * pvParameters );
+    static void prvScaleCatchTask( void * pvParameters );
+    static void prvScaleTimerCallback( TimerHandle_t xTimer );
+
+/*-----------------------------------------------------------*/
+
+/* The parameters of the current run. */
+    static uint32_t ulBenchmarkIterations = 0;
+    static size_t xBenchmarkMallocSize = 0;
+
+/* The cost of back to back reads of the cycle counter, which is removed from
+ * every measurement. */
+    static uint32_t ulReadOverhead = 0;
+
+/* The sum of the samples of the current result. */
+    static uint64_t ullSampleTotal = 0;
+
+/* Given by prvTickTask() when it has finished measuring. */
+    static SemaphoreHandle_t xTickDone = NULL;
+
+/* The blocks held by each background task.  They are held here, rather than on
+ * the background task's stack, so they can be freed after the task is
+ * deleted. */
+    static void * pvBackgroundBlocks[ cyclebenchMAX_BACKGROUND_TASKS ][ cyclebenchBACKGROUND_BLOCKS ];
+
+/* The event group the scaling benchmark's blocked tasks wait on. */
+    static EventGroupHandle_t xScaleEventGroup = NULL;
+
+/* The number of the scaling benchmark's blocked tasks that have started. */
+    static volatile UBaseType_t uxScaleTasksStarted = 0;
+
+/* Written by prvScaleCatchTask() when it runs after the benchmarking task
+ * blocks. */
+    static volatile uint32_t ulScaleCatchCycles = 0;
+
+/*-----------------------------------------------------------*/
+
+    void vCycleBenchmarkRun( uint32_t ulIterations,
+                             UBaseType_t uxBackgroundTasks,
+                             size_t xMallocSize,
+                             CycleBenchmarkResult_t pxResults[ cyclebenchNUMBER_OF_BENCHMARKS ] )
+    {
+        TaskHandle_t xBackgroundTasks[ cyclebenchMAX_BACKGROUND_TASKS ];
+        UBaseType_t uxTask, uxBlock;
+
+        configASSERT( ulIterations > 0UL );
+        configASSERT( uxBackgroundTasks <= ( UBaseType_t ) cyclebenchMAX_BACKGROUND_TASKS );
+        configASSERT( pxResults != NULL );
+        configASSERT( uxTaskPriorityGet( NULL ) > tskIDLE_PRIORITY );
+        configASSERT( uxTaskPriorityGet( NULL ) < ( UBaseType_t ) ( configMAX_PRIORITIES - 1 ) );
+
+        ulBenchmarkIterations = ulIterations;
+        xBenchmarkMallocSize = xMallocSize;
+
+        portENABLE_CYCLE_COUNTER();
+        prvMeasureReadOverhead();
+
+        for( uxTask = 0; uxTask < uxBackgroundTasks; uxTask++ )
+        {
+            for( uxBlock = 0; uxBlock < ( UBaseType_t ) cyclebenchBACKGROUND_BLOCKS; uxBlock++ )
+            {
+                pvBackgroundBlocks[ uxTask ][ uxBlock ] = NULL;
+            }
+
+            xBackgroundTasks[ uxTask ] = prvCreateTask( prvBackgroundTask, "BenchLoad", ( void * ) uxTask, tskIDLE_PRIORITY );
+        }
+
+        /* Let the background tasks fill the heap before measuring. */
+        vTaskDelay( 2 );
+
+        prvBenchmarkQueueSend( &( pxResults[ cyclebenchQUEUE_SEND ] ) );
+        prvBenchmarkTaskNotify( &( pxResults[ cyclebenchTASK_NOTIFY ] ) );
+        prvBenchmarkSemaphoreTake( &( pxResults[ cyclebenchSEMAPHORE_TAKE ] ) );
+        prvBenchmarkContextSwitch( &( pxResults[ cyclebenchCONTEXT_SWITCH ] ) );
+        prvBenchmarkTickInterrupt( &( pxResults[ cyclebenchTICK_INTERRUPT ] ) );
+        prvBenchmarkMalloc( &( pxResults[ cyclebenchMALLOC ] ) );
+
+        for( uxTask = 0; uxTask < uxBackgroundTasks; uxTask++ )
+        {
+            vTaskDelete( xBackgroundTasks[ uxTask ] );
+
+            for( uxBlock = 0; uxBlock < ( UBaseType_t ) cyclebenchBACKGROUND_BLOCKS; uxBlock++ )
+            {
+                vPortFree( pvBackgroundBlocks[ uxTask ][ uxBlock ] );
+                pvBackgroundBlocks[ uxTask ][ uxBlock ] = NULL;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vCycleBenchmarkScaling( const UBaseType_t * puxObjectCounts,
+                                 UBaseType_t uxNumberOfCounts,
+                                 uint32_t ulIterations,
+                                 CycleBenchmarkResult_t pxResults[][ cyclebenchNUMBER_OF_SCALING_BENCHMARKS ] )
+    {
+        TaskHandle_t * pxLoadTasks;
+        UBaseType_t uxCount, uxObject, uxObjects = 0, uxMaxObjects;
+
+        #if ( configUSE_TIMERS == 1 )
+            TimerHandle_t * pxLoadTimers;
+        #endif
+
+        configASSERT( puxObjectCounts != NULL );
+        configASSERT( uxNumberOfCounts > ( UBaseType_t ) 0 );
+        configASSERT( ulIterations > 0UL );
+        configASSERT( pxResults != NULL );
+        configASSERT( uxTaskPriorityGet( NULL ) > ( tskIDLE_PRIORITY + 1U ) );
+
+        #if ( configUSE_TIMERS == 1 )
+        {
+            configASSERT( uxTaskPriorityGet( NULL ) < ( UBaseType_t ) configTIMER_TASK_PRIORITY );
+        }
+        #endif
+
+        ulBenchmarkIterations = ulIterations;
+
+        portENABLE_CYCLE_COUNTER();
+        prvMeasureReadOverhead();
+
+        /* The counts are ascending, so the last is the most objects that are
+         * held at once.  One extra entry keeps the allocation non-zero. */
+        uxMaxObjects = puxObjectCounts[ uxNumberOfCounts - 1U ];
+        pxLoadTasks = ( TaskHandle_t * ) pvPortMalloc( ( uxMaxObjects + 1U ) * sizeof( TaskHandle_t ) );
+        configASSERT( pxLoadTasks != NULL );
+
+        #if ( configUSE_TIMERS == 1 )
+        {
+            pxLoadTimers = ( TimerHandle_t * ) pvPortMalloc( ( uxMaxObjects + 1U ) * sizeof( TimerHandle_t ) );
+            configASSERT( pxLoadTimers != NULL );
+        }
+        #endif
+
+        xScaleEventGroup = xEventGroupCreate();
+        configASSERT( xScaleEventGroup != NULL );
+        uxScaleTasksStarted = 0;
+
+        for( uxCount = 0; uxCount < uxNumberOfCounts; uxCount++ )
+        {
+            configASSERT( puxObjectCounts[ uxCount ] >= uxObjects );
+
+            /* Add to the objects left by the previous count.  The blocked
+             * tasks run below this task, so start once it delays. */
+            while( uxObjects < puxObjectCounts[ uxCount ] )
+            {
+                pxLoadTasks[ uxObjects ] = prvCreateTask( prvScaleLoadTask, "BenchBlock", NULL, uxTaskPriorityGet( NULL ) - 1U );
+
+                #if ( configUSE_TIMERS == 1 )
+                {
+                    pxLoadTimers[ uxObjects ] = xTimerCreate( "BenchTimer", cyclebenchLOAD_TIMEOUT, pdFALSE, NULL, prvScaleTimerCallback );
+                    configASSERT( pxLoadTimers[ uxObjects ] != NULL );
+                    ( void ) xTimerStart( pxLoadTimers[ uxObjects ], portMAX_DELAY );
+                }
+                #endif
+
+                uxObjects++;
+            }
+
+            while( uxScaleTasksStarted < uxObjects )
+            {
+                vTaskDelay( 1 );
+            }
+
+            prvScaleQueueReceiveTimeout( &( pxResults[ uxCount ][ cyclebenchSCALE_QUEUE_RECEIVE_TIMEOUT ] ) );
+            prvScaleTimerReset( &( pxResults[ uxCount ][ cyclebenchSCALE_TIMER_RESET ] ) );
+            prvScaleEventGroupSetBits( &( pxResults[ uxCount ][ cyclebenchSCALE_EVENT_GROUP_SET_BITS ] ) );
+            prvScaleTaskCreate( &( pxResults[ uxCount ][ cyclebenchSCALE_TASK_CREATE ] ) );
+        }
+
+        for( uxObject = 0; uxObject < uxObjects; uxObject++ )
+        {
+            vTaskDelete( pxLoadTasks[ uxObject ] );
+
+            #if ( configUSE_TIMERS == 1 )
+            {
+                ( void ) xTimerDelete( pxLoadTimers[ uxObject ], portMAX_DELAY );
+            }
+            #endif
+        }
+
+        vEventGroupDelete( xScaleEventGroup );
+        xScaleEventGroup = NULL;
+        vPortFree( pxLoadTasks );
+
+        #if ( configUSE_TIMERS == 1 )
+        {
+            vPortFree( pxLoadTimers );
+        }
+        #endif
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvMeasureReadOverhead( void )
+    {
+        uint32_t ulStart, ulEnd, ul;
+
+        /* Take the minimum of a few attempts in case an interrupt lands
+         * between the reads. */
+        ulReadOverhead = 0xffffffffUL;
+
+        for( ul = 0; ul < 16UL; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            ulEnd = portGET_CYCLE_COUNT();
+
+            if( ( ulEnd - ulStart ) < ulReadOverhead )
+            {
+                ulReadOverhead = ulEnd - ulStart;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStartResult( CycleBenchmarkResult_t * pxResult,
+                                const char * pcName )
+    {
+        pxResult->pcName = pcName;
+        pxResult->ulSamples = 0;
+        pxResult->ulMinCycles = 0;
+        pxResult->ulMaxCycles = 0;
+        pxResult->ulAverageCycles = 0;
+        ullSampleTotal = 0;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddSample( CycleBenchmarkResult_t * pxResult,
+                              uint32_t ulStart,
+                              uint32_t ulEnd )
+    {
+        uint32_t ulCycles = ulEnd - ulStart;
+
+        if( ulCycles > ulReadOverhead )
+        {
+            ulCycles -= ulReadOverhead;
+        }
+        else
+        {
+            ulCycles = 0;
+        }
+
+        if( ( pxResult->ulSamples == 0UL ) || ( ulCycles < pxResult->ulMinCycles ) )
+        {
+            pxResult->ulMinCycles = ulCycles;
+        }
+
+        if( ulCycles > pxResult->ulMaxCycles )
+        {
+            pxResult->ulMaxCycles = ulCycles;
+        }
+
+        ullSampleTotal += ulCycles;
+        pxResult->ulSamples++;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvEndResult( CycleBenchmarkResult_t * pxResult )
+    {
+        if( pxResult->ulSamples > 0UL )
+        {
+            pxResult->ulAverageCycles = ( uint32_t ) ( ullSampleTotal / pxResult->ulSamples );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvLetLoadRun( uint32_t ulSample )
+    {
+        if( ( ulSample % cyclebenchLOAD_INTERVAL ) == ( cyclebenchLOAD_INTERVAL - 1UL ) )
+        {
+            vTaskDelay( 1 );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TaskHandle_t prvCreateTask( TaskFunction_t pxTaskCode,
+                                       const char * pcName,
+                                       void * pvParameters,
+                                       UBaseType_t uxPriority )
+    {
+        TaskHandle_t xTask = NULL;
+        BaseType_t xReturned;
+
+        xReturned = xTaskCreate( pxTaskCode, pcName, cyclebenchSTACK_SIZE, pvParameters, uxPriority, &xTask );
+        configASSERT( xReturned == pdPASS );
+        ( void ) xReturned;
+
+        return xTask;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchmarkQueueSend( CycleBenchmarkResult_t * pxResult )
+    {
+        QueueHandle_t xQueue;
+        uint32_t ul, ulValue, ulStart, ulEnd;
+
+        prvStartResult( pxResult, "queue_send" );
+
+        xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+        configASSERT( xQueue != NULL );
+
+        for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            ( void ) xQueueSend( xQueue, &ul, 0 );
+            ulEnd = portGET_CYCLE_COUNT();
+
+            prvAddSample( pxResult, ulStart, ulEnd );
+            ( void ) xQueueReceive( xQueue, &ulValue, 0 );
+            prvLetLoadRun( ul );
+        }
+
+        vQueueDelete( xQueue );
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchmarkTaskNotify( CycleBenchmarkResult_t * pxResult )
+    {
+        prvStartResult( pxResult, "task_notify" );
+
+        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        {
+            TaskHandle_t xThisTask = xTaskGetCurrentTaskHandle();
+            uint32_t ul, ulStart, ulEnd;
+
+            for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+            {
+                ulStart = portGET_CYCLE_COUNT();
+                ( void ) xTaskNotify( xThisTask, 0, eIncrement );
+                ulEnd = portGET_CYCLE_COUNT();
+
+                prvAddSample( pxResult, ulStart, ulEnd );
+                ( void ) xTaskNotifyStateClear( xThisTask );
+                prvLetLoadRun( ul );
+            }
+
+            ( void ) ulTaskNotifyValueClear( xThisTask, 0xffffffffUL );
+        }
+        #endif /* configUSE_TASK_NOTIFICATIONS */
+
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchmarkSemaphoreTake( CycleBenchmarkResult_t * pxResult )
+    {
+        SemaphoreHandle_t xSemaphore;
+        uint32_t ul, ulStart, ulEnd;
+
+        prvStartResult( pxResult, "semaphore_take" );
+
+        xSemaphore = xSemaphoreCreateBinary();
+        configASSERT( xSemaphore != NULL );
+
+        for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+        {
+            ( void ) xSemaphoreGive( xSemaphore );
+
+            ulStart = portGET_CYCLE_COUNT();
+            ( void ) xSemaphoreTake( xSemaphore, 0 );
+            ulEnd = portGET_CYCLE_COUNT();
+
+            prvAddSample( pxResult, ulStart, ulEnd );
+            prvLetLoadRun( ul );
+        }
+
+        vSemaphoreDelete( xSemaphore );
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchmarkContextSwitch( CycleBenchmarkResult_t * pxResult )
+    {
+        TaskHandle_t xYieldTask;
+        uint32_t ul, ulStart, ulEnd;
+
+        prvStartResult( pxResult, "context_switch" );
+
+        /* The yield task shares this task's priority, so it takes all the
+         * time this task leaves.  The background tasks are therefore starved
+         * for the duration of this benchmark, and there is no delay to let
+         * them run. */
+        xYieldTask = prvCreateTask( prvYieldTask, "BenchYield", NULL, uxTaskPriorityGet( NULL ) );
+        taskYIELD();
+
+        for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            taskYIELD();
+            ulEnd = portGET_CYCLE_COUNT();
+
+            /* The yield task yields straight back, so the time is that of two
+             * switches. */
+            prvAddSample( pxResult, ulStart, ulStart + ( ( ulEnd - ulStart ) / 2UL ) );
+        }
+
+        vTaskDelete( xYieldTask );
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvYieldTask( void * pvParameters )
+    {
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            taskYIELD();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchmarkTickInterrupt( CycleBenchmarkResult_t * pxResult )
+    {
+        TaskHandle_t xTickTask;
+
+        prvStartResult( pxResult, "tick_interrupt" );
+
+        xTickDone = xSemaphoreCreateBinary();
+        configASSERT( xTickDone != NULL );
+
+        /* The measuring task runs above everything else, so only interrupts
+         * interrupt it.  It gives xTickDone when it has finished. */
+        xTickTask = prvCreateTask( prvTickTask, "BenchTick", ( void * ) pxResult, ( UBaseType_t ) ( configMAX_PRIORITIES - 1 ) );
+        ( void ) xSemaphoreTake( xTickDone, portMAX_DELAY );
+
+        vTaskDelete( xTickTask );
+        vSemaphoreDelete( xTickDone );
+        xTickDone = NULL;
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTickTask( void * pvParameters )
+    {
+        CycleBenchmarkResult_t * pxResult = ( CycleBenchmarkResult_t * ) pvParameters;
+        TickType_t xTick, xLastTick;
+        uint32_t ulNow, ulLast, ulDelta, ulLoopMin = 0xffffffffUL, ulWindowMax = 0;
+        BaseType_t xFirstTick = pdTRUE;
+
+        /* Poll the cycle counter.  The longest gap between two reads in each
+         * tick period is the one the tick interrupt made, and the shortest gap
+         * seen is the cost of the loop itself. */
+        xLastTick = xTaskGetTickCount();
+        ulLast = portGET_CYCLE_COUNT();
+
+        while( pxResult->ulSamples < ulBenchmarkIterations )
+        {
+            xTick = xTaskGetTickCount();
+            ulNow = portGET_CYCLE_COUNT();
+            ulDelta = ulNow - ulLast;
+            ulLast = ulNow;
+
+            if( ulDelta < ulLoopMin )
+            {
+                ulLoopMin = ulDelta;
+            }
+
+            if( ulDelta > ulWindowMax )
+            {
+                ulWindowMax = ulDelta;
+            }
+
+            if( xTick != xLastTick )
+            {
+                /* The interrupt that changed the tick count fell in this pass
+                 * of the loop or the one before, both of which are in the
+                 * window.  The first window may have started part way through
+                 * a tick period, so is not used.  The cost of the loop replaces
+                 * the read overhead as the correction. */
+                if( xFirstTick == pdFALSE )
+                {
+                    prvAddSample( pxResult, ulLoopMin, ulWindowMax + ulReadOverhead );
+                }
+
+                xFirstTick = pdFALSE;
+                xLastTick = xTick;
+                ulWindowMax = 0;
+            }
+        }
+
+        ( void ) xSemaphoreGive( xTickDone );
+
+        for( ; ; )
+        {
+            vTaskDelay( portMAX_DELAY );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBenchmarkMalloc( CycleBenchmarkResult_t * pxResult )
+    {
+        void * pvBlock;
+        uint32_t ul, ulStart, ulEnd;
+
+        prvStartResult( pxResult, "malloc" );
+
+        for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            pvBlock = pvPortMalloc( xBenchmarkMallocSize );
+            ulEnd = portGET_CYCLE_COUNT();
+
+            configASSERT( pvBlock != NULL );
+            prvAddSample( pxResult, ulStart, ulEnd );
+            vPortFree( pvBlock );
+            prvLetLoadRun( ul );
+        }
+
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBackgroundTask( void * pvParameters )
+    {
+        void ** ppvBlocks = pvBackgroundBlocks[ ( UBaseType_t ) pvParameters ];
+        uint32_t ulSeed = ( uint32_t ) ( UBaseType_t ) pvParameters;
+        UBaseType_t uxBlock;
+
+        for( ; ; )
+        {
+            /* Replace one block with a block of a different size, so the heap
+             * stays fragmented.  The scheduler is suspended so the task is not
+             * deleted while ppvBlocks does not match what is allocated. */
+            ulSeed = ( ulSeed * 1103515245UL ) + 12345UL;
+            uxBlock = ( UBaseType_t ) ( ( ulSeed >> 16 ) % ( uint32_t ) cyclebenchBACKGROUND_BLOCKS );
+
+            vTaskSuspendAll();
+            {
+                vPortFree( ppvBlocks[ uxBlock ] );
+                ppvBlocks[ uxBlock ] = pvPortMalloc( ( size_t ) 16U + ( size_t ) ( ( ulSeed >> 8 ) & 0xffUL ) );
+            }
+            ( void ) xTaskResumeAll();
+
+            /* Leave a delayed task for the tick interrupt to process. */
+            vTaskDelay( 1 );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvScaleQueueReceiveTimeout( CycleBenchmarkResult_t * pxResult )
+    {
+        QueueHandle_t xQueue;
+        TaskHandle_t xCatchTask;
+        uint32_t ul, ulValue, ulStart;
+
+        prvStartResult( pxResult, "queue_receive_timeout" );
+
+        xQueue = xQueueCreate( 1, sizeof( uint32_t ) );
+        configASSERT( xQueue != NULL );
+
+        /* The catch task runs as soon as this task blocks, notes the time,
+         * then sends to the queue to unblock this task again. */
+        xCatchTask = prvCreateTask( prvScaleCatchTask, "BenchCatch", ( void * ) xQueue, uxTaskPriorityGet( NULL ) - 1U );
+
+        /* The first receive starts the catch task, so is not measured. */
+        ( void ) xQueueReceive( xQueue, &ulValue, cyclebenchMEASURED_TIMEOUT );
+
+        for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            ( void ) xQueueReceive( xQueue, &ulValue, cyclebenchMEASURED_TIMEOUT );
+            prvAddSample( pxResult, ulStart, ulScaleCatchCycles );
+        }
+
+        vTaskDelete( xCatchTask );
+        vQueueDelete( xQueue );
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvScaleCatchTask( void * pvParameters )
+    {
+        QueueHandle_t xQueue = ( QueueHandle_t ) pvParameters;
+        uint32_t ulValue = 0;
+
+        for( ; ; )
+        {
+            ulScaleCatchCycles = portGET_CYCLE_COUNT();
+            ( void ) xQueueSend( xQueue, &ulValue, portMAX_DELAY );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvScaleTimerReset( CycleBenchmarkResult_t * pxResult )
+    {
+        prvStartResult( pxResult, "timer_reset" );
+
+        #if ( configUSE_TIMERS == 1 )
+        {
+            TimerHandle_t xTimer;
+            uint32_t ul, ulStart, ulEnd;
+
+            xTimer = xTimerCreate( "BenchReset", cyclebenchMEASURED_TIMEOUT, pdFALSE, NULL, prvScaleTimerCallback );
+            configASSERT( xTimer != NULL );
+            ( void ) xTimerStart( xTimer, portMAX_DELAY );
+
+            /* The timer task runs above this task, so has processed the
+             * command when xTimerReset() returns. */
+            for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+            {
+                ulStart = portGET_CYCLE_COUNT();
+                ( void ) xTimerReset( xTimer, portMAX_DELAY );
+                ulEnd = portGET_CYCLE_COUNT();
+
+                prvAddSample( pxResult, ulStart, ulEnd );
+            }
+
+            ( void ) xTimerDelete( xTimer, portMAX_DELAY );
+        }
+        #endif /* configUSE_TIMERS */
+
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvScaleTimerCallback( TimerHandle_t xTimer )
+    {
+        ( void ) xTimer;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvScaleEventGroupSetBits( CycleBenchmarkResult_t * pxResult )
+    {
+        uint32_t ul, ulStart, ulEnd;
+
+        prvStartResult( pxResult, "event_group_set_bits" );
+
+        for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            ( void ) xEventGroupSetBits( xScaleEventGroup, cyclebenchMEASURED_BIT );
+            ulEnd = portGET_CYCLE_COUNT();
+
+            prvAddSample( pxResult, ulStart, ulEnd );
+            ( void ) xEventGroupClearBits( xScaleEventGroup, cyclebenchMEASURED_BIT );
+        }
+
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvScaleTaskCreate( CycleBenchmarkResult_t * pxResult )
+    {
+        TaskHandle_t xTask = NULL;
+        BaseType_t xReturned;
+        uint32_t ul, ulStart, ulEnd;
+
+        prvStartResult( pxResult, "task_create" );
+
+        /* The created task is below this task, so is deleted before it
+         * runs, which frees it at once. */
+        for( ul = 0; ul < ulBenchmarkIterations; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            xReturned = xTaskCreate( prvYieldTask, "BenchCreate", cyclebenchSTACK_SIZE, NULL, tskIDLE_PRIORITY, &xTask );
+            ulEnd = portGET_CYCLE_COUNT();
+
+            configASSERT( xReturned == pdPASS );
+            ( void ) xReturned;
+            prvAddSample( pxResult, ulStart, ulEnd );
+            vTaskDelete( xTask );
+        }
+
+        prvEndResult( pxResult );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvScaleLoadTask( void * pvParameters )
+    {
+        ( void ) pvParameters;
+
+        taskENTER_CRITICAL();
+        {
+            uxScaleTasksStarted++;
+        }
+        taskEXIT_CRITICAL();
+
+        /* Wait for a bit that is never set, with a timeout that sorts this
+         * task before the benchmarking task in the delayed list. */
+        for( ; ; )
+        {
+            ( void ) xEventGroupWaitBits( xScaleEventGroup, cyclebenchLOAD_BIT, pdFALSE, pdFALSE, cyclebenchLOAD_TIMEOUT );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_CYCLE_BENCHMARK */
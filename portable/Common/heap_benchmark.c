@@ -0,0 +1,536 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Heap allocator benchmark.  See heap_benchmark.h.
+ */
+
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "heap_benchmark.h"
+
+#if ( configUSE_HEAP_BENCHMARK == 1 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Find the cost of reading the cycle counter.
+ */
+    static void prvMeasureReadOverhead( void );
+
+/*
+ * The cycles between ulStart and ulEnd, less the cost of reading the cycle
+ * counter.
+ */
+    static uint32_t prvCycles( uint32_t ulStart,
+                               uint32_t ulEnd );
+
+/*
+ * The next random number, and a random size between the run's minimum and
+ * maximum.
+ */
+    static uint32_t prvRandom( void );
+    static size_t prvRandomSize( void );
+
+/*
+ * Time pvPortMalloc( xSize ) and count the result.
+ */
+    static void * prvMalloc( size_t xSize );
+
+/*
+ * Allocate xSize bytes to a block that is free, or free a block if it is
+ * allocated, keeping count of the bytes requested by the blocks held.
+ */
+    static void prvAllocateBlock( UBaseType_t uxBlock,
+                                  size_t xSize );
+    static void prvFreeBlock( UBaseType_t uxBlock );
+
+/*
+ * Count a call to the heap, sampling the heap every ulSampleInterval calls.
+ */
+    static void prvCountCall( void );
+
+/*
+ * Sample the heap with vPortGetHeapStats().
+ */
+    static void prvSample( void );
+
+/*
+ * The patterns.
+ */
+    static void prvRunLifo( void );
+    static void prvRunFifo( void );
+    static void prvRunRandom( BaseType_t xHoldEvenBlocks );
+    static void prvRunNoFree( void );
+    static void prvRunTrace( void );
+
+/*-----------------------------------------------------------*/
+
+/* The blocks held by the pattern, and the size requested for each. */
+    static void * pvBlocks[ configHEAP_BENCHMARK_MAX_BLOCKS ];
+    static size_t xBlockSizes[ configHEAP_BENCHMARK_MAX_BLOCKS ];
+
+/* The parameters, result and timeline of the current run. */
+    static const HeapBenchmarkParameters_t * pxRunParameters = NULL;
+    static HeapBenchmarkResult_t * pxRunResult = NULL;
+    static HeapStats_t * pxRunTimeline = NULL;
+    static uint32_t ulRunTimelineLength = 0;
+
+/* The cost of back to back reads of the cycle counter, which is removed from
+ * every measurement. */
+    static uint32_t ulReadOverhead = 0;
+
+/* The sums of the malloc and free measurements. */
+    static uint64_t ullMallocCycles = 0;
+    static uint64_t ullFreeCycles = 0;
+
+/* The free space when the run started, and the bytes requested by the blocks
+ * held now. */
+    static size_t xInitialFreeBytes = 0;
+    static size_t xRequestedBytes = 0;
+
+/* The calls made since the heap was last sampled. */
+    static uint32_t ulCallsSinceSample = 0;
+
+/* The state of the random number generator. */
+    static uint32_t ulRandomState = 1;
+
+/*-----------------------------------------------------------*/
+
+    void vHeapBenchmarkRun( const HeapBenchmarkParameters_t * pxParameters,
+                            HeapBenchmarkResult_t * pxResult,
+                            HeapStats_t * pxTimeline,
+                            uint32_t ulTimelineLength )
+    {
+        HeapStats_t xStats;
+        UBaseType_t uxBlock;
+        void * pv;
+
+        configASSERT( pxParameters != NULL );
+        configASSERT( pxResult != NULL );
+        configASSERT( ( pxTimeline != NULL ) || ( ulTimelineLength == 0UL ) );
+        configASSERT( pxParameters->ulSampleInterval > 0UL );
+        configASSERT( pxParameters->xMinimumSize <= pxParameters->xMaximumSize );
+
+        if( ( pxParameters->uxPattern != heapbenchPATTERN_TRACE ) && ( pxParameters->uxPattern != heapbenchPATTERN_NO_FREE ) )
+        {
+            configASSERT( pxParameters->uxBlocks > ( UBaseType_t ) 0 );
+            configASSERT( pxParameters->uxBlocks <= ( UBaseType_t ) configHEAP_BENCHMARK_MAX_BLOCKS );
+        }
+
+        pxRunParameters = pxParameters;
+        pxRunResult = pxResult;
+        pxRunTimeline = pxTimeline;
+        ulRunTimelineLength = ulTimelineLength;
+
+        ( void ) memset( pxResult, 0x00, sizeof( HeapBenchmarkResult_t ) );
+        ( void ) memset( pvBlocks, 0x00, sizeof( pvBlocks ) );
+        ullMallocCycles = 0;
+        ullFreeCycles = 0;
+        xRequestedBytes = 0;
+        ulCallsSinceSample = 0;
+        ulRandomState = ( pxParameters->ulSeed != 0UL ) ? pxParameters->ulSeed : 1UL;
+
+        portENABLE_CYCLE_COUNTER();
+        prvMeasureReadOverhead();
+
+        /* Most allocators only set up the heap on the first allocation, so
+         * make one first if need be to find the free space.  heap_1.c always
+         * reports its free space, so is never asked to free the block. */
+        vPortGetHeapStats( &xStats );
+
+        if( ( xStats.xAvailableHeapSpaceInBytes == ( size_t ) 0 ) && ( xStats.xNumberOfSuccessfulAllocations == ( size_t ) 0 ) )
+        {
+            pv = pvPortMalloc( 1 );
+            vPortFree( pv );
+            vPortGetHeapStats( &xStats );
+        }
+
+        xInitialFreeBytes = xStats.xAvailableHeapSpaceInBytes;
+
+        switch( pxParameters->uxPattern )
+        {
+            case heapbenchPATTERN_LIFO:
+                prvRunLifo();
+                break;
+
+            case heapbenchPATTERN_FIFO:
+                prvRunFifo();
+                break;
+
+            case heapbenchPATTERN_RANDOM:
+                prvRunRandom( pdFALSE );
+                break;
+
+            case heapbenchPATTERN_LONG_LIVED:
+                prvRunRandom( pdTRUE );
+                break;
+
+            case heapbenchPATTERN_NO_FREE:
+                prvRunNoFree();
+                break;
+
+            case heapbenchPATTERN_TRACE:
+                prvRunTrace();
+                break;
+
+            default:
+                configASSERT( pdFALSE );
+                break;
+        }
+
+        /* Free whatever the pattern still holds, then sample the heap it
+         * leaves behind. */
+        for( uxBlock = 0; uxBlock < ( UBaseType_t ) configHEAP_BENCHMARK_MAX_BLOCKS; uxBlock++ )
+        {
+            prvFreeBlock( uxBlock );
+        }
+
+        prvSample();
+
+        if( ( pxResult->ulMallocs + pxResult->ulFailedMallocs ) > 0UL )
+        {
+            pxResult->ulAverageMallocCycles = ( uint32_t ) ( ullMallocCycles / ( uint64_t ) ( pxResult->ulMallocs + pxResult->ulFailedMallocs ) );
+        }
+
+        if( pxResult->ulFrees > 0UL )
+        {
+            pxResult->ulAverageFreeCycles = ( uint32_t ) ( ullFreeCycles / ( uint64_t ) pxResult->ulFrees );
+        }
+
+        pxResult->ullTotalCycles = ullMallocCycles + ullFreeCycles;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvMeasureReadOverhead( void )
+    {
+        uint32_t ulStart, ulEnd, ul;
+
+        /* Take the minimum of a few attempts in case an interrupt lands
+         * between the reads. */
+        ulReadOverhead = 0xffffffffUL;
+
+        for( ul = 0; ul < 16UL; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            ulEnd = portGET_CYCLE_COUNT();
+
+            if( ( ulEnd - ulStart ) < ulReadOverhead )
+            {
+                ulReadOverhead = ulEnd - ulStart;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvCycles( uint32_t ulStart,
+                               uint32_t ulEnd )
+    {
+        uint32_t ulCycles = ulEnd - ulStart;
+
+        if( ulCycles > ulReadOverhead )
+        {
+            ulCycles -= ulReadOverhead;
+        }
+        else
+        {
+            ulCycles = 0;
+        }
+
+        return ulCycles;
+    }
+/*-----------------------------------------------------------*/
+
+    static uint32_t prvRandom( void )
+    {
+        /* xorshift32, which is never 0 if it is not seeded with 0. */
+        ulRandomState ^= ulRandomState << 13;
+        ulRandomState ^= ulRandomState >> 17;
+        ulRandomState ^= ulRandomState << 5;
+
+        return ulRandomState;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvRandomSize( void )
+    {
+        size_t xRange = pxRunParameters->xMaximumSize - pxRunParameters->xMinimumSize;
+        size_t xSize = pxRunParameters->xMinimumSize;
+
+        if( xRange > ( size_t ) 0 )
+        {
+            xSize += ( size_t ) prvRandom() % ( xRange + ( size_t ) 1 );
+        }
+
+        return xSize;
+    }
+/*-----------------------------------------------------------*/
+
+    static void * prvMalloc( size_t xSize )
+    {
+        void * pv;
+        uint32_t ulStart, ulEnd, ulCycles;
+
+        ulStart = portGET_CYCLE_COUNT();
+        pv = pvPortMalloc( xSize );
+        ulEnd = portGET_CYCLE_COUNT();
+
+        ulCycles = prvCycles( ulStart, ulEnd );
+        ullMallocCycles += ulCycles;
+
+        if( ulCycles > pxRunResult->ulMaxMallocCycles )
+        {
+            pxRunResult->ulMaxMallocCycles = ulCycles;
+        }
+
+        if( pv != NULL )
+        {
+            pxRunResult->ulMallocs++;
+            xRequestedBytes += xSize;
+
+            if( xRequestedBytes > pxRunResult->xPeakRequestedBytes )
+            {
+                pxRunResult->xPeakRequestedBytes = xRequestedBytes;
+            }
+        }
+        else
+        {
+            pxRunResult->ulFailedMallocs++;
+        }
+
+        return pv;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAllocateBlock( UBaseType_t uxBlock,
+                                  size_t xSize )
+    {
+        configASSERT( uxBlock < ( UBaseType_t ) configHEAP_BENCHMARK_MAX_BLOCKS );
+        configASSERT( pvBlocks[ uxBlock ] == NULL );
+
+        pvBlocks[ uxBlock ] = prvMalloc( xSize );
+        xBlockSizes[ uxBlock ] = xSize;
+        prvCountCall();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFreeBlock( UBaseType_t uxBlock )
+    {
+        uint32_t ulStart, ulEnd, ulCycles;
+
+        configASSERT( uxBlock < ( UBaseType_t ) configHEAP_BENCHMARK_MAX_BLOCKS );
+
+        /* The block is not held if it was never allocated, or if its
+         * allocation failed. */
+        if( pvBlocks[ uxBlock ] != NULL )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            vPortFree( pvBlocks[ uxBlock ] );
+            ulEnd = portGET_CYCLE_COUNT();
+
+            ulCycles = prvCycles( ulStart, ulEnd );
+            ullFreeCycles += ulCycles;
+
+            if( ulCycles > pxRunResult->ulMaxFreeCycles )
+            {
+                pxRunResult->ulMaxFreeCycles = ulCycles;
+            }
+
+            pxRunResult->ulFrees++;
+            pvBlocks[ uxBlock ] = NULL;
+            xRequestedBytes -= xBlockSizes[ uxBlock ];
+            prvCountCall();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCountCall( void )
+    {
+        ulCallsSinceSample++;
+
+        if( ulCallsSinceSample >= pxRunParameters->ulSampleInterval )
+        {
+            ulCallsSinceSample = 0;
+            prvSample();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSample( void )
+    {
+        HeapStats_t xStats;
+        size_t xUsedBytes;
+        uint32_t ulFragmentation;
+
+        vPortGetHeapStats( &xStats );
+
+        if( pxRunResult->ulSamples < ulRunTimelineLength )
+        {
+            pxRunTimeline[ pxRunResult->ulSamples ] = xStats;
+        }
+
+        pxRunResult->ulSamples++;
+
+        /* The space lost since the run started that the blocks held do not
+         * account for.  heap_3.c reports no free space, so no overhead. */
+        if( xInitialFreeBytes >= xStats.xAvailableHeapSpaceInBytes )
+        {
+            xUsedBytes = xInitialFreeBytes - xStats.xAvailableHeapSpaceInBytes;
+
+            if( ( xUsedBytes > xRequestedBytes ) && ( ( xUsedBytes - xRequestedBytes ) > pxRunResult->xPeakOverheadBytes ) )
+            {
+                pxRunResult->xPeakOverheadBytes = xUsedBytes - xRequestedBytes;
+            }
+        }
+
+        if( ( xStats.xAvailableHeapSpaceInBytes > ( size_t ) 0 ) && ( xStats.xSizeOfLargestFreeBlockInBytes <= xStats.xAvailableHeapSpaceInBytes ) )
+        {
+            ulFragmentation = 1000UL - ( uint32_t ) ( ( ( uint64_t ) xStats.xSizeOfLargestFreeBlockInBytes * 1000U ) / ( uint64_t ) xStats.xAvailableHeapSpaceInBytes );
+
+            if( ulFragmentation > pxRunResult->ulPeakFragmentation )
+            {
+                pxRunResult->ulPeakFragmentation = ulFragmentation;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunLifo( void )
+    {
+        uint32_t ulAllocations = 0;
+        UBaseType_t uxBlock;
+
+        while( ulAllocations < pxRunParameters->ulAllocations )
+        {
+            for( uxBlock = 0; ( uxBlock < pxRunParameters->uxBlocks ) && ( ulAllocations < pxRunParameters->ulAllocations ); uxBlock++ )
+            {
+                prvAllocateBlock( uxBlock, prvRandomSize() );
+                ulAllocations++;
+            }
+
+            for( uxBlock = pxRunParameters->uxBlocks; uxBlock > ( UBaseType_t ) 0; uxBlock-- )
+            {
+                prvFreeBlock( uxBlock - ( UBaseType_t ) 1 );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunFifo( void )
+    {
+        uint32_t ulAllocation;
+        UBaseType_t uxBlock;
+
+        /* The blocks are used in turn, so the block reused is always the
+         * oldest. */
+        for( ulAllocation = 0; ulAllocation < pxRunParameters->ulAllocations; ulAllocation++ )
+        {
+            uxBlock = ( UBaseType_t ) ( ulAllocation % ( uint32_t ) pxRunParameters->uxBlocks );
+            prvFreeBlock( uxBlock );
+            prvAllocateBlock( uxBlock, prvRandomSize() );
+        }
+
+        /* Free the rest oldest first too. */
+        for( uxBlock = 0; uxBlock < pxRunParameters->uxBlocks; uxBlock++ )
+        {
+            prvFreeBlock( ( UBaseType_t ) ( ( ulAllocation + ( uint32_t ) uxBlock ) % ( uint32_t ) pxRunParameters->uxBlocks ) );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunRandom( BaseType_t xHoldEvenBlocks )
+    {
+        uint32_t ulAllocation;
+        UBaseType_t uxBlock;
+
+        configASSERT( ( xHoldEvenBlocks == pdFALSE ) || ( pxRunParameters->uxBlocks >= ( UBaseType_t ) 2 ) );
+
+        for( ulAllocation = 0; ulAllocation < pxRunParameters->ulAllocations; ulAllocation++ )
+        {
+            if( ulAllocation < ( uint32_t ) pxRunParameters->uxBlocks )
+            {
+                /* Fill every block first. */
+                uxBlock = ( UBaseType_t ) ulAllocation;
+            }
+            else if( xHoldEvenBlocks == pdFALSE )
+            {
+                uxBlock = ( UBaseType_t ) ( prvRandom() % ( uint32_t ) pxRunParameters->uxBlocks );
+            }
+            else
+            {
+                /* Only replace the odd blocks, so the long lived even blocks
+                 * are left spread through the heap between them. */
+                uxBlock = ( ( UBaseType_t ) ( prvRandom() % ( uint32_t ) ( pxRunParameters->uxBlocks / ( UBaseType_t ) 2 ) ) * ( UBaseType_t ) 2 ) + ( UBaseType_t ) 1;
+            }
+
+            prvFreeBlock( uxBlock );
+            prvAllocateBlock( uxBlock, prvRandomSize() );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunNoFree( void )
+    {
+        uint32_t ulAllocation;
+
+        /* The blocks are never freed, so are not recorded. */
+        for( ulAllocation = 0; ulAllocation < pxRunParameters->ulAllocations; ulAllocation++ )
+        {
+            ( void ) prvMalloc( prvRandomSize() );
+            prvCountCall();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunTrace( void )
+    {
+        const HeapBenchmarkTraceEntry_t * pxEntry;
+        uint32_t ulEntry;
+
+        configASSERT( ( pxRunParameters->pxTrace != NULL ) || ( pxRunParameters->ulTraceLength == 0UL ) );
+
+        for( ulEntry = 0; ulEntry < pxRunParameters->ulTraceLength; ulEntry++ )
+        {
+            pxEntry = &( pxRunParameters->pxTrace[ ulEntry ] );
+
+            if( pxEntry->xSize == ( size_t ) 0 )
+            {
+                prvFreeBlock( ( UBaseType_t ) pxEntry->usBlock );
+            }
+            else
+            {
+                prvAllocateBlock( ( UBaseType_t ) pxEntry->usBlock, pxEntry->xSize );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_BENCHMARK */
@@ -0,0 +1,526 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Interrupt latency benchmark.  See latency_benchmark.h.
+ */
+
+#include <string.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "timers.h"
+#include "latency_benchmark.h"
+
+#if ( configUSE_LATENCY_BENCHMARK == 1 )
+
+    #define latencybenchSTACK_SIZE       ( configMINIMAL_STACK_SIZE * 2 )
+
+/* The number of background load tasks, one for each latencybenchLOAD_ bit. */
+    #define latencybenchLOAD_TASKS       ( 4 )
+
+/* The length of the queue the queue load fills and empties. */
+    #define latencybenchQUEUE_LENGTH     ( 8 )
+
+/* The number of blocks the heap load keeps allocated. */
+    #define latencybenchHEAP_BLOCKS      ( 4 )
+
+/* The number of timers the timer load restarts. */
+    #define latencybenchLOAD_TIMERS      ( 4 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Find the cost of reading the cycle counter.
+ */
+    static void prvMeasureReadOverhead( void );
+
+/*
+ * Add the measurement ulEnd - ulStart to a histogram, less the cost of reading
+ * the cycle counter.
+ */
+    static void prvAddSample( LatencyHistogram_t * pxHistogram,
+                              uint64_t * pullTotal,
+                              uint32_t ulStart,
+                              uint32_t ulEnd );
+
+/*
+ * Create a task, asserting that it was created.
+ */
+    static TaskHandle_t prvCreateTask( TaskFunction_t pxTaskCode,
+                                       const char * pcName,
+                                       UBaseType_t uxPriority );
+
+/*
+ * Count a load task as stopped, then wait to be deleted.
+ */
+    static void prvLoadStopped( void );
+
+/*
+ * The task woken by the interrupt, and the background load.
+ */
+    static void prvWakeTask( void * pvParameters );
+    static void prvQueueLoadTask( void * pvParameters );
+    static void prvHeapLoadTask( void * pvParameters );
+    static void prvTimerLoadTask( void * pvParameters );
+    static void prvCriticalLoadTask( void * pvParameters );
+
+    #if ( configUSE_TIMERS == 1 )
+        static void prvLoadTimerCallback( TimerHandle_t xTimer );
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/* The parameters and result of the current run. */
+    static const LatencyBenchmarkParameters_t * pxRunParameters = NULL;
+    static LatencyBenchmarkResult_t * pxRunResult = NULL;
+
+/* The cost of back to back reads of the cycle counter, which is removed from
+ * every measurement. */
+    static uint32_t ulReadOverhead = 0;
+
+/* The sums of the samples in each histogram. */
+    static uint64_t ullEntryTotal = 0;
+    static uint64_t ullWakeTotal = 0;
+
+/* Set while the interrupt is being measured. */
+    static volatile BaseType_t xMeasuring = pdFALSE;
+
+/* Set by the interrupt when it wakes prvWakeTask(), and cleared by
+ * prvWakeTask() when it has run, along with the time the interrupt woke it. */
+    static volatile BaseType_t xWakePending = pdFALSE;
+    static volatile uint32_t ulWakeCycles = 0;
+
+/* The task the interrupt wakes, and the semaphore it gives when enough wakes
+ * have been measured. */
+    static TaskHandle_t xWakeTask = NULL;
+    static SemaphoreHandle_t xDone = NULL;
+
+/* The load, which is stopped by setting xStopLoad then waiting for every load
+ * task to count itself stopped, so none is deleted part way through using
+ * the heap. */
+    static TaskHandle_t xLoadTasks[ latencybenchLOAD_TASKS ];
+    static volatile BaseType_t xStopLoad = pdFALSE;
+    static volatile UBaseType_t uxLoadTasksStopped = 0;
+    static QueueHandle_t xLoadQueue = NULL;
+
+    #if ( configUSE_TIMERS == 1 )
+        static TimerHandle_t xLoadTimers[ latencybenchLOAD_TIMERS ];
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    void vLatencyBenchmarkRun( const LatencyBenchmarkParameters_t * pxParameters,
+                               LatencyBenchmarkResult_t * pxResult )
+    {
+        UBaseType_t uxTask, uxLoadTasks = 0;
+
+        #if ( configUSE_TIMERS == 1 )
+            UBaseType_t uxTimer;
+        #endif
+
+        configASSERT( pxParameters != NULL );
+        configASSERT( pxResult != NULL );
+        configASSERT( pxParameters->ulSamples > 0UL );
+        configASSERT( pxParameters->ulBucketCycles > 0UL );
+        configASSERT( uxTaskPriorityGet( NULL ) > ( tskIDLE_PRIORITY + 1U ) );
+        configASSERT( uxTaskPriorityGet( NULL ) < ( UBaseType_t ) ( configMAX_PRIORITIES - 1 ) );
+
+        #if ( configUSE_TIMERS == 0 )
+        {
+            configASSERT( ( pxParameters->uxLoad & latencybenchLOAD_TIMER ) == 0U );
+        }
+        #endif
+
+        pxRunParameters = pxParameters;
+        pxRunResult = pxResult;
+        ( void ) memset( pxResult, 0x00, sizeof( LatencyBenchmarkResult_t ) );
+        ullEntryTotal = 0;
+        ullWakeTotal = 0;
+        xWakePending = pdFALSE;
+        xStopLoad = pdFALSE;
+        uxLoadTasksStopped = 0;
+
+        portENABLE_CYCLE_COUNTER();
+        prvMeasureReadOverhead();
+
+        xDone = xSemaphoreCreateBinary();
+        configASSERT( xDone != NULL );
+
+        xWakeTask = prvCreateTask( prvWakeTask, "LatWake", ( UBaseType_t ) ( configMAX_PRIORITIES - 1 ) );
+
+        if( ( pxParameters->uxLoad & latencybenchLOAD_QUEUE ) != 0U )
+        {
+            xLoadQueue = xQueueCreate( latencybenchQUEUE_LENGTH, sizeof( uint32_t ) );
+            configASSERT( xLoadQueue != NULL );
+            xLoadTasks[ uxLoadTasks++ ] = prvCreateTask( prvQueueLoadTask, "LatQueue", tskIDLE_PRIORITY + 1U );
+        }
+
+        if( ( pxParameters->uxLoad & latencybenchLOAD_HEAP ) != 0U )
+        {
+            xLoadTasks[ uxLoadTasks++ ] = prvCreateTask( prvHeapLoadTask, "LatHeap", tskIDLE_PRIORITY + 1U );
+        }
+
+        #if ( configUSE_TIMERS == 1 )
+        {
+            if( ( pxParameters->uxLoad & latencybenchLOAD_TIMER ) != 0U )
+            {
+                for( uxTimer = 0; uxTimer < ( UBaseType_t ) latencybenchLOAD_TIMERS; uxTimer++ )
+                {
+                    xLoadTimers[ uxTimer ] = xTimerCreate( "LatTimer", ( TickType_t ) ( uxTimer + 1U ), pdTRUE, NULL, prvLoadTimerCallback );
+                    configASSERT( xLoadTimers[ uxTimer ] != NULL );
+                }
+
+                xLoadTasks[ uxLoadTasks++ ] = prvCreateTask( prvTimerLoadTask, "LatTimer", tskIDLE_PRIORITY + 1U );
+            }
+        }
+        #endif /* configUSE_TIMERS */
+
+        if( ( pxParameters->uxLoad & latencybenchLOAD_CRITICAL ) != 0U )
+        {
+            xLoadTasks[ uxLoadTasks++ ] = prvCreateTask( prvCriticalLoadTask, "LatCrit", tskIDLE_PRIORITY + 1U );
+        }
+
+        /* Measure until prvWakeTask() has enough samples. */
+        taskENTER_CRITICAL();
+        {
+            xMeasuring = pdTRUE;
+        }
+        taskEXIT_CRITICAL();
+
+        ( void ) xSemaphoreTake( xDone, portMAX_DELAY );
+
+        /* Stop the load.  It runs below this task, so this task delays to let
+         * it see xStopLoad. */
+        xStopLoad = pdTRUE;
+
+        while( uxLoadTasksStopped < uxLoadTasks )
+        {
+            vTaskDelay( 1 );
+        }
+
+        for( uxTask = 0; uxTask < uxLoadTasks; uxTask++ )
+        {
+            vTaskDelete( xLoadTasks[ uxTask ] );
+        }
+
+        vTaskDelete( xWakeTask );
+        xWakeTask = NULL;
+        vSemaphoreDelete( xDone );
+        xDone = NULL;
+
+        if( xLoadQueue != NULL )
+        {
+            vQueueDelete( xLoadQueue );
+            xLoadQueue = NULL;
+        }
+
+        #if ( configUSE_TIMERS == 1 )
+        {
+            if( ( pxParameters->uxLoad & latencybenchLOAD_TIMER ) != 0U )
+            {
+                for( uxTimer = 0; uxTimer < ( UBaseType_t ) latencybenchLOAD_TIMERS; uxTimer++ )
+                {
+                    ( void ) xTimerDelete( xLoadTimers[ uxTimer ], portMAX_DELAY );
+                }
+            }
+        }
+        #endif /* configUSE_TIMERS */
+
+        if( pxResult->xEntry.ulSamples > 0UL )
+        {
+            pxResult->xEntry.ulAverageCycles = ( uint32_t ) ( ullEntryTotal / ( uint64_t ) pxResult->xEntry.ulSamples );
+        }
+
+        if( pxResult->xWake.ulSamples > 0UL )
+        {
+            pxResult->xWake.ulAverageCycles = ( uint32_t ) ( ullWakeTotal / ( uint64_t ) pxResult->xWake.ulSamples );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vLatencyBenchmarkInterrupt( uint32_t ulRaisedCycles,
+                                     BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        uint32_t ulEntryCycles = portGET_CYCLE_COUNT();
+
+        if( xMeasuring != pdFALSE )
+        {
+            prvAddSample( &( pxRunResult->xEntry ), &ullEntryTotal, ulRaisedCycles, ulEntryCycles );
+
+            if( xWakePending == pdFALSE )
+            {
+                xWakePending = pdTRUE;
+                ulWakeCycles = portGET_CYCLE_COUNT();
+                vTaskNotifyGiveFromISR( xWakeTask, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                pxRunResult->ulMissedWakes++;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvMeasureReadOverhead( void )
+    {
+        uint32_t ulStart, ulEnd, ul;
+
+        /* Take the minimum of a few attempts in case an interrupt lands
+         * between the reads. */
+        ulReadOverhead = 0xffffffffUL;
+
+        for( ul = 0; ul < 16UL; ul++ )
+        {
+            ulStart = portGET_CYCLE_COUNT();
+            ulEnd = portGET_CYCLE_COUNT();
+
+            if( ( ulEnd - ulStart ) < ulReadOverhead )
+            {
+                ulReadOverhead = ulEnd - ulStart;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddSample( LatencyHistogram_t * pxHistogram,
+                              uint64_t * pullTotal,
+                              uint32_t ulStart,
+                              uint32_t ulEnd )
+    {
+        uint32_t ulCycles = ulEnd - ulStart;
+        uint32_t ulBucket;
+
+        if( ulCycles > ulReadOverhead )
+        {
+            ulCycles -= ulReadOverhead;
+        }
+        else
+        {
+            ulCycles = 0;
+        }
+
+        if( ( pxHistogram->ulSamples == 0UL ) || ( ulCycles < pxHistogram->ulMinCycles ) )
+        {
+            pxHistogram->ulMinCycles = ulCycles;
+        }
+
+        if( ulCycles > pxHistogram->ulMaxCycles )
+        {
+            pxHistogram->ulMaxCycles = ulCycles;
+        }
+
+        ulBucket = ulCycles / pxRunParameters->ulBucketCycles;
+
+        if( ulBucket >= ( uint32_t ) latencybenchHISTOGRAM_BUCKETS )
+        {
+            ulBucket = ( uint32_t ) latencybenchHISTOGRAM_BUCKETS - 1UL;
+        }
+
+        pxHistogram->ulBuckets[ ulBucket ]++;
+        pxHistogram->ulSamples++;
+        *pullTotal += ( uint64_t ) ulCycles;
+    }
+/*-----------------------------------------------------------*/
+
+    static TaskHandle_t prvCreateTask( TaskFunction_t pxTaskCode,
+                                       const char * pcName,
+                                       UBaseType_t uxPriority )
+    {
+        TaskHandle_t xTask = NULL;
+        BaseType_t xReturned;
+
+        xReturned = xTaskCreate( pxTaskCode, pcName, latencybenchSTACK_SIZE, NULL, uxPriority, &xTask );
+        configASSERT( xReturned == pdPASS );
+        ( void ) xReturned;
+
+        return xTask;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvLoadStopped( void )
+    {
+        taskENTER_CRITICAL();
+        {
+            uxLoadTasksStopped++;
+        }
+        taskEXIT_CRITICAL();
+
+        for( ; ; )
+        {
+            vTaskDelay( portMAX_DELAY );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWakeTask( void * pvParameters )
+    {
+        uint32_t ulNow;
+
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            ulNow = portGET_CYCLE_COUNT();
+
+            if( xMeasuring != pdFALSE )
+            {
+                prvAddSample( &( pxRunResult->xWake ), &ullWakeTotal, ulWakeCycles, ulNow );
+
+                if( pxRunResult->xWake.ulSamples >= pxRunParameters->ulSamples )
+                {
+                    xMeasuring = pdFALSE;
+                    ( void ) xSemaphoreGive( xDone );
+                }
+
+                xWakePending = pdFALSE;
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvQueueLoadTask( void * pvParameters )
+    {
+        uint32_t ulValue = 0;
+        UBaseType_t uxItem;
+
+        ( void ) pvParameters;
+
+        while( xStopLoad == pdFALSE )
+        {
+            for( uxItem = 0; uxItem < ( UBaseType_t ) latencybenchQUEUE_LENGTH; uxItem++ )
+            {
+                ( void ) xQueueSend( xLoadQueue, &ulValue, 0 );
+            }
+
+            for( uxItem = 0; uxItem < ( UBaseType_t ) latencybenchQUEUE_LENGTH; uxItem++ )
+            {
+                ( void ) xQueueReceive( xLoadQueue, &ulValue, 0 );
+            }
+
+            taskYIELD();
+        }
+
+        prvLoadStopped();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvHeapLoadTask( void * pvParameters )
+    {
+        void * pvBlocks[ latencybenchHEAP_BLOCKS ] = { NULL };
+        uint32_t ulCount = 0;
+        UBaseType_t uxBlock;
+
+        ( void ) pvParameters;
+
+        while( xStopLoad == pdFALSE )
+        {
+            /* Replace the blocks in turn with blocks of varying size, so the
+             * heap fragments. */
+            uxBlock = ( UBaseType_t ) ( ulCount % ( uint32_t ) latencybenchHEAP_BLOCKS );
+            vPortFree( pvBlocks[ uxBlock ] );
+            pvBlocks[ uxBlock ] = pvPortMalloc( ( size_t ) ( 16U + ( ( ulCount * 40U ) % 256U ) ) );
+            ulCount++;
+
+            taskYIELD();
+        }
+
+        for( uxBlock = 0; uxBlock < ( UBaseType_t ) latencybenchHEAP_BLOCKS; uxBlock++ )
+        {
+            vPortFree( pvBlocks[ uxBlock ] );
+        }
+
+        prvLoadStopped();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTimerLoadTask( void * pvParameters )
+    {
+        ( void ) pvParameters;
+
+        #if ( configUSE_TIMERS == 1 )
+        {
+            UBaseType_t uxTimer = 0;
+
+            /* The timers auto-reload every few ticks, so the timer task also
+             * processes expiries, and are restarted with changing periods. */
+            while( xStopLoad == pdFALSE )
+            {
+                ( void ) xTimerChangePeriod( xLoadTimers[ uxTimer ], ( TickType_t ) ( ( uxTimer % 3U ) + 1U ), 0 );
+                uxTimer = ( uxTimer + 1U ) % ( UBaseType_t ) latencybenchLOAD_TIMERS;
+
+                taskYIELD();
+            }
+        }
+        #endif /* configUSE_TIMERS */
+
+        prvLoadStopped();
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+
+        static void prvLoadTimerCallback( TimerHandle_t xTimer )
+        {
+            ( void ) xTimer;
+        }
+
+    #endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+    static void prvCriticalLoadTask( void * pvParameters )
+    {
+        uint32_t ulStart;
+
+        ( void ) pvParameters;
+
+        while( xStopLoad == pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                ulStart = portGET_CYCLE_COUNT();
+
+                while( ( portGET_CYCLE_COUNT() - ulStart ) < pxRunParameters->ulCriticalSectionCycles )
+                {
+                    /* Hold the critical section. */
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            taskYIELD();
+        }
+
+        prvLoadStopped();
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_LATENCY_BENCHMARK */
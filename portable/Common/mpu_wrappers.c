@@ -45,11 +45,293 @@
 #include "stream_buffer.h"
 #include "mpu_prototypes.h"
 
+#if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 )
+    #include "mpu_syscall_numbers.h"
+#endif
+
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 /*-----------------------------------------------------------*/
 
 #if ( portUSING_MPU_WRAPPERS == 1 )
 
+    #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+
+/* With configENABLE_ACCESS_CONTROL_LIST set to 1 an unprivileged task can only
+ * use a kernel object, or act on another task, that it has been granted access
+ * to.  The objects and tasks that take part are held in a hash table indexed by
+ * their address.  The index of an object's entry selects its bit in the access
+ * control lists, and the index of a task's entry selects its own access control
+ * list, so a handle is checked in constant time without walking any list. */
+        #define mpuKERNEL_OBJECT_POOL_MASK    ( ( UBaseType_t ) configPROTECTED_KERNEL_OBJECT_POOL_SIZE - ( UBaseType_t ) 1U )
+        #define mpuACCESS_CONTROL_LIST_WORDS  ( ( configPROTECTED_KERNEL_OBJECT_POOL_SIZE + 31U ) / 32U )
+
+/* Marks an entry whose object was removed, so lookups keep probing past it. */
+        #define mpuREMOVED_KERNEL_OBJECT      ( ( const void * ) 1 )
+
+/* Kernel objects are at least 8 byte aligned, so the low address bits carry no
+ * information. */
+        #define mpuHASH_KERNEL_OBJECT( pvObject )                          \
+    ( ( UBaseType_t ) ( ( ( portPOINTER_SIZE_TYPE ) ( pvObject ) >> 3 ) ^   \
+                        ( ( portPOINTER_SIZE_TYPE ) ( pvObject ) >> 11 ) ) & mpuKERNEL_OBJECT_POOL_MASK )
+
+        #define mpuIS_KERNEL_OBJECT_ACCESSIBLE( pvObject )                 prvIsKernelObjectAccessible( pvObject )
+        #define mpuIS_TASK_ACCESSIBLE( xTask )                             ( ( ( xTask ) == NULL ) ? pdTRUE : prvIsKernelObjectAccessible( xTask ) )
+        #define mpuARE_TASKS_ACCESSIBLE( pxTasks, uxNumberOfTasks )        prvAreTasksAccessible( pxTasks, uxNumberOfTasks )
+        #define mpuGRANT_CALLING_TASK_ACCESS( pvObject )                   prvGrantCallingTaskAccess( pvObject )
+        #define mpuREMOVE_KERNEL_OBJECT( pvObject )                        prvRemoveKernelObject( pvObject )
+        #define mpuREMOVE_TASK( xTask )                                    prvRemoveKernelObject( ( ( xTask ) == NULL ) ? xTaskGetCurrentTaskHandle() : ( xTask ) )
+
+        PRIVILEGED_DATA static const void * pvKernelObjects[ configPROTECTED_KERNEL_OBJECT_POOL_SIZE ] = { NULL };
+        PRIVILEGED_DATA static uint32_t ulAccessControlLists[ configPROTECTED_KERNEL_OBJECT_POOL_SIZE ][ mpuACCESS_CONTROL_LIST_WORDS ];
+
+/*
+ * Find the entry for pvObject, returning pdTRUE and its index in *puxIndex if
+ * there is one.
+ */
+        static BaseType_t prvFindKernelObject( const void * pvObject,
+                                               UBaseType_t * puxIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Find the entry for pvObject, adding one if there is none.  Returns pdFALSE
+ * if the table is full.
+ */
+        static BaseType_t prvAddKernelObject( const void * pvObject,
+                                              UBaseType_t * puxIndex ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove the entry for pvObject, if there is one, along with every task's
+ * access to it.  Called before an object is deleted, as its memory could be
+ * reused for a new object.
+ */
+        static void prvRemoveKernelObject( const void * pvObject ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the calling task is the object, or has been granted access
+ * to it.
+ */
+        static BaseType_t prvIsKernelObjectAccessible( const void * pvObject ) PRIVILEGED_FUNCTION;
+
+        static BaseType_t prvAreTasksAccessible( TaskHandle_t const * pxTasks,
+                                                 UBaseType_t uxNumberOfTasks ) PRIVILEGED_FUNCTION;
+
+        static void prvGrantCallingTaskAccess( const void * pvObject ) PRIVILEGED_FUNCTION;
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvFindKernelObject( const void * pvObject,
+                                               UBaseType_t * puxIndex )
+        {
+            UBaseType_t uxIndex, uxProbes;
+            BaseType_t xFound = pdFALSE;
+
+            uxIndex = mpuHASH_KERNEL_OBJECT( pvObject );
+
+            for( uxProbes = 0; ( uxProbes < ( UBaseType_t ) configPROTECTED_KERNEL_OBJECT_POOL_SIZE ) && ( pvObject != NULL ) && ( pvObject != mpuREMOVED_KERNEL_OBJECT ); uxProbes++ )
+            {
+                if( pvKernelObjects[ uxIndex ] == pvObject )
+                {
+                    *puxIndex = uxIndex;
+                    xFound = pdTRUE;
+                    break;
+                }
+                else if( pvKernelObjects[ uxIndex ] == NULL )
+                {
+                    /* The object would have been added here or earlier. */
+                    break;
+                }
+                else
+                {
+                    uxIndex = ( uxIndex + 1U ) & mpuKERNEL_OBJECT_POOL_MASK;
+                }
+            }
+
+            return xFound;
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvAddKernelObject( const void * pvObject,
+                                              UBaseType_t * puxIndex )
+        {
+            UBaseType_t uxIndex, uxProbes;
+            BaseType_t xAdded = pdFALSE;
+
+            taskENTER_CRITICAL();
+            {
+                if( prvFindKernelObject( pvObject, puxIndex ) == pdTRUE )
+                {
+                    xAdded = pdTRUE;
+                }
+                else
+                {
+                    uxIndex = mpuHASH_KERNEL_OBJECT( pvObject );
+
+                    for( uxProbes = 0; uxProbes < ( UBaseType_t ) configPROTECTED_KERNEL_OBJECT_POOL_SIZE; uxProbes++ )
+                    {
+                        if( ( pvKernelObjects[ uxIndex ] == NULL ) ||
+                            ( pvKernelObjects[ uxIndex ] == mpuREMOVED_KERNEL_OBJECT ) )
+                        {
+                            /* The access control list of a free entry, and the
+                             * entry's bit in every other list, were cleared when
+                             * it was last removed. */
+                            pvKernelObjects[ uxIndex ] = pvObject;
+                            *puxIndex = uxIndex;
+                            xAdded = pdTRUE;
+                            break;
+                        }
+
+                        uxIndex = ( uxIndex + 1U ) & mpuKERNEL_OBJECT_POOL_MASK;
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            return xAdded;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvRemoveKernelObject( const void * pvObject )
+        {
+            UBaseType_t uxIndex, uxTask, uxWord;
+
+            taskENTER_CRITICAL();
+            {
+                if( prvFindKernelObject( pvObject, &uxIndex ) == pdTRUE )
+                {
+                    for( uxTask = 0; uxTask < ( UBaseType_t ) configPROTECTED_KERNEL_OBJECT_POOL_SIZE; uxTask++ )
+                    {
+                        ulAccessControlLists[ uxTask ][ uxIndex / 32U ] &= ~( 1UL << ( uxIndex % 32U ) );
+                    }
+
+                    for( uxWord = 0; uxWord < ( UBaseType_t ) mpuACCESS_CONTROL_LIST_WORDS; uxWord++ )
+                    {
+                        ulAccessControlLists[ uxIndex ][ uxWord ] = 0UL;
+                    }
+
+                    pvKernelObjects[ uxIndex ] = mpuREMOVED_KERNEL_OBJECT;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvIsKernelObjectAccessible( const void * pvObject )
+        {
+            TaskHandle_t xCallingTask = xTaskGetCurrentTaskHandle();
+            UBaseType_t uxObject, uxTask;
+            BaseType_t xAccessible = pdFALSE;
+
+            if( pvObject == ( const void * ) xCallingTask )
+            {
+                xAccessible = pdTRUE;
+            }
+            else if( ( pvObject != NULL ) &&
+                     ( prvFindKernelObject( pvObject, &uxObject ) == pdTRUE ) &&
+                     ( prvFindKernelObject( xCallingTask, &uxTask ) == pdTRUE ) )
+            {
+                if( ( ulAccessControlLists[ uxTask ][ uxObject / 32U ] & ( 1UL << ( uxObject % 32U ) ) ) != 0UL )
+                {
+                    xAccessible = pdTRUE;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xAccessible;
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t prvAreTasksAccessible( TaskHandle_t const * pxTasks,
+                                                 UBaseType_t uxNumberOfTasks )
+        {
+            UBaseType_t uxTask;
+            BaseType_t xAccessible = pdTRUE;
+
+            for( uxTask = 0; ( uxTask < uxNumberOfTasks ) && ( xAccessible == pdTRUE ); uxTask++ )
+            {
+                xAccessible = mpuIS_TASK_ACCESSIBLE( pxTasks[ uxTask ] );
+            }
+
+            return xAccessible;
+        }
+/*-----------------------------------------------------------*/
+
+        static void prvGrantCallingTaskAccess( const void * pvObject )
+        {
+            if( pvObject != NULL )
+            {
+                vGrantAccessToKernelObject( NULL, pvObject );
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        void vGrantAccessToKernelObject( TaskHandle_t xTask,
+                                         const void * pvObject ) /* PRIVILEGED_FUNCTION */
+        {
+            UBaseType_t uxTask, uxObject;
+            BaseType_t xAdded;
+
+            if( xTask == NULL )
+            {
+                xTask = xTaskGetCurrentTaskHandle();
+            }
+
+            taskENTER_CRITICAL();
+            {
+                xAdded = prvAddKernelObject( xTask, &uxTask );
+
+                if( xAdded == pdTRUE )
+                {
+                    xAdded = prvAddKernelObject( pvObject, &uxObject );
+                }
+
+                if( xAdded == pdTRUE )
+                {
+                    ulAccessControlLists[ uxTask ][ uxObject / 32U ] |= ( 1UL << ( uxObject % 32U ) );
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            /* configPROTECTED_KERNEL_OBJECT_POOL_SIZE is too small for the
+             * number of tasks and objects that take part. */
+            configASSERT( xAdded == pdTRUE );
+        }
+/*-----------------------------------------------------------*/
+
+        void vRevokeAccessToKernelObject( TaskHandle_t xTask,
+                                          const void * pvObject ) /* PRIVILEGED_FUNCTION */
+        {
+            UBaseType_t uxTask, uxObject;
+
+            if( xTask == NULL )
+            {
+                xTask = xTaskGetCurrentTaskHandle();
+            }
+
+            taskENTER_CRITICAL();
+            {
+                if( ( prvFindKernelObject( xTask, &uxTask ) == pdTRUE ) &&
+                    ( prvFindKernelObject( pvObject, &uxObject ) == pdTRUE ) )
+                {
+                    ulAccessControlLists[ uxTask ][ uxObject / 32U ] &= ~( 1UL << ( uxObject % 32U ) );
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+/*-----------------------------------------------------------*/
+
+    #else /* if ( configENABLE_ACCESS_CONTROL_LIST == 1 ) */
+
+        #define mpuIS_KERNEL_OBJECT_ACCESSIBLE( pvObject )             pdTRUE
+        #define mpuIS_TASK_ACCESSIBLE( xTask )                         pdTRUE
+        #define mpuARE_TASKS_ACCESSIBLE( pxTasks, uxNumberOfTasks )    pdTRUE
+        #define mpuGRANT_CALLING_TASK_ACCESS( pvObject )
+        #define mpuREMOVE_KERNEL_OBJECT( pvObject )
+        #define mpuREMOVE_TASK( xTask )
+
+    #endif /* if ( configENABLE_ACCESS_CONTROL_LIST == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
         BaseType_t MPU_xTaskCreate( TaskFunction_t pvTaskCode,
                                     const char * const pcName,
@@ -69,6 +351,12 @@
                 portMEMORY_BARRIER();
 
                 xReturn = xTaskCreate( pvTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask );
+                #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+                    if( ( xReturn == pdPASS ) && ( pxCreatedTask != NULL ) )
+                    {
+                        mpuGRANT_CALLING_TASK_ACCESS( *pxCreatedTask );
+                    }
+                #endif
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -104,6 +392,7 @@
                 portMEMORY_BARRIER();
 
                 xReturn = xTaskCreateStatic( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -127,7 +416,12 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTaskDelete( pxTaskToDelete );
+                if( mpuIS_TASK_ACCESSIBLE( pxTaskToDelete ) == pdTRUE )
+                {
+                    mpuREMOVE_TASK( pxTaskToDelete );
+                    vTaskDelete( pxTaskToDelete );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -135,13 +429,14 @@
             }
             else
             {
+                mpuREMOVE_TASK( pxTaskToDelete );
                 vTaskDelete( pxTaskToDelete );
             }
         }
     #endif /* if ( INCLUDE_vTaskDelete == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( INCLUDE_xTaskDelayUntil == 1 )
+    #if ( ( INCLUDE_xTaskDelayUntil == 1 ) && ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) )
         BaseType_t MPU_xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
                                         TickType_t xTimeIncrement ) /* FREERTOS_SYSTEM_CALL */
         {
@@ -178,7 +473,15 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTaskAbortDelay( xTask );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    xReturn = xTaskAbortDelay( xTask );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -194,7 +497,7 @@
     #endif /* if ( INCLUDE_xTaskAbortDelay == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( INCLUDE_vTaskDelay == 1 )
+    #if ( ( INCLUDE_vTaskDelay == 1 ) && ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) )
         void MPU_vTaskDelay( TickType_t xTicksToDelay ) /* FREERTOS_SYSTEM_CALL */
         {
             if( portIS_PRIVILEGED() == pdFALSE )
@@ -216,6 +519,29 @@
     #endif /* if ( INCLUDE_vTaskDelay == 1 ) */
 /*-----------------------------------------------------------*/
 
+    #if ( ( INCLUDE_vTaskDelay == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+        void MPU_vTaskDelayWithSlack( TickType_t xTicksToDelay,
+                                      TickType_t xSlackInTicks ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                vTaskDelayWithSlack( xTicksToDelay, xSlackInTicks );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTaskDelayWithSlack( xTicksToDelay, xSlackInTicks );
+            }
+        }
+    #endif /* if ( ( INCLUDE_vTaskDelay == 1 ) && ( configUSE_TIMER_SLACK == 1 ) ) */
+/*-----------------------------------------------------------*/
+
     #if ( INCLUDE_uxTaskPriorityGet == 1 )
         UBaseType_t MPU_uxTaskPriorityGet( const TaskHandle_t pxTask ) /* FREERTOS_SYSTEM_CALL */
         {
@@ -226,7 +552,15 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                uxReturn = uxTaskPriorityGet( pxTask );
+                if( mpuIS_TASK_ACCESSIBLE( pxTask ) == pdTRUE )
+                {
+                    uxReturn = uxTaskPriorityGet( pxTask );
+                }
+                else
+                {
+                    uxReturn = 0;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -251,7 +585,11 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTaskPrioritySet( pxTask, uxNewPriority );
+                if( mpuIS_TASK_ACCESSIBLE( pxTask ) == pdTRUE )
+                {
+                    vTaskPrioritySet( pxTask, uxNewPriority );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -265,6 +603,34 @@
     #endif /* if ( INCLUDE_vTaskPrioritySet == 1 ) */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        void MPU_vTaskSetBudget( TaskHandle_t xTask,
+                                 TickType_t xBudgetTicks,
+                                 TickType_t xPeriodTicks ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    vTaskSetBudget( xTask, xBudgetTicks, xPeriodTicks );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTaskSetBudget( xTask, xBudgetTicks, xPeriodTicks );
+            }
+        }
+    #endif /* if ( configUSE_TASK_BUDGETS == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( INCLUDE_eTaskGetState == 1 )
         eTaskState MPU_eTaskGetState( TaskHandle_t pxTask ) /* FREERTOS_SYSTEM_CALL */
         {
@@ -275,7 +641,15 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                eReturn = eTaskGetState( pxTask );
+                if( mpuIS_TASK_ACCESSIBLE( pxTask ) == pdTRUE )
+                {
+                    eReturn = eTaskGetState( pxTask );
+                }
+                else
+                {
+                    eReturn = eInvalid;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -302,7 +676,11 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTaskGetInfo( xTask, pxTaskStatus, xGetFreeStackSpace, eState );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    vTaskGetInfo( xTask, pxTaskStatus, xGetFreeStackSpace, eState );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -349,7 +727,11 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTaskSuspend( pxTaskToSuspend );
+                if( mpuIS_TASK_ACCESSIBLE( pxTaskToSuspend ) == pdTRUE )
+                {
+                    vTaskSuspend( pxTaskToSuspend );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -371,7 +753,11 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTaskResume( pxTaskToResume );
+                if( mpuIS_TASK_ACCESSIBLE( pxTaskToResume ) == pdTRUE )
+                {
+                    vTaskResume( pxTaskToResume );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -429,28 +815,56 @@
     }
 /*-----------------------------------------------------------*/
 
-    TickType_t MPU_xTaskGetTickCount( void ) /* FREERTOS_SYSTEM_CALL */
-    {
-        TickType_t xReturn;
-
-        if( portIS_PRIVILEGED() == pdFALSE )
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        TickType_t MPU_xTaskGetTickCount( void ) /* FREERTOS_SYSTEM_CALL */
         {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
+            TickType_t xReturn;
 
-            xReturn = xTaskGetTickCount();
-            portMEMORY_BARRIER();
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
 
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
+                xReturn = xTaskGetTickCount();
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTaskGetTickCount();
+            }
+
+            return xReturn;
         }
-        else
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TICK_COUNT_64 == 1 )
+        uint64_t MPU_ullTaskGetTickCount64( void ) /* FREERTOS_SYSTEM_CALL */
         {
-            xReturn = xTaskGetTickCount();
-        }
+            uint64_t ullReturn;
 
-        return xReturn;
-    }
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                ullReturn = ullTaskGetTickCount64();
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                ullReturn = ullTaskGetTickCount64();
+            }
+
+            return ullReturn;
+        }
+    #endif /* if ( configUSE_TICK_COUNT_64 == 1 ) */
 /*-----------------------------------------------------------*/
 
     UBaseType_t MPU_uxTaskGetNumberOfTasks( void ) /* FREERTOS_SYSTEM_CALL */
@@ -477,17 +891,77 @@
     }
 /*-----------------------------------------------------------*/
 
-    char * MPU_pcTaskGetName( TaskHandle_t xTaskToQuery ) /* FREERTOS_SYSTEM_CALL */
-    {
-        char * pcReturn;
-
-        if( portIS_PRIVILEGED() == pdFALSE )
+    #if ( configUSE_TASK_STATE_COUNTS == 1 )
+        UBaseType_t MPU_uxTaskGetNumberOfTasksInState( eTaskState eState ) /* FREERTOS_SYSTEM_CALL */
         {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
+            UBaseType_t uxReturn;
 
-            pcReturn = pcTaskGetName( xTaskToQuery );
-            portMEMORY_BARRIER();
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                uxReturn = uxTaskGetNumberOfTasksInState( eState );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                uxReturn = uxTaskGetNumberOfTasksInState( eState );
+            }
+
+            return uxReturn;
+        }
+    #endif /* if ( configUSE_TASK_STATE_COUNTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TASK_STATE_COUNTS == 1 )
+        UBaseType_t MPU_uxTaskGetNumberOfReadyTasksAtPriority( UBaseType_t uxPriority ) /* FREERTOS_SYSTEM_CALL */
+        {
+            UBaseType_t uxReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                uxReturn = uxTaskGetNumberOfReadyTasksAtPriority( uxPriority );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                uxReturn = uxTaskGetNumberOfReadyTasksAtPriority( uxPriority );
+            }
+
+            return uxReturn;
+        }
+    #endif /* if ( configUSE_TASK_STATE_COUNTS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    char * MPU_pcTaskGetName( TaskHandle_t xTaskToQuery ) /* FREERTOS_SYSTEM_CALL */
+    {
+        char * pcReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_TASK_ACCESSIBLE( xTaskToQuery ) == pdTRUE )
+            {
+                pcReturn = pcTaskGetName( xTaskToQuery );
+            }
+            else
+            {
+                pcReturn = NULL;
+            }
+
+            portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
             portMEMORY_BARRIER();
@@ -623,6 +1097,58 @@
     #endif /* if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( INCLUDE_xTaskGetIdleTaskHandle == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleWindowedRunTimePercent( eRunTimeWindow eWindow ) /* FREERTOS_SYSTEM_CALL */
+        {
+            configRUN_TIME_COUNTER_TYPE xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = ulTaskGetIdleWindowedRunTimePercent( eWindow );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = ulTaskGetIdleWindowedRunTimePercent( eWindow );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE MPU_ulTaskGetIdleWindowedRunTimeCounter( eRunTimeWindow eWindow ) /* FREERTOS_SYSTEM_CALL */
+        {
+            configRUN_TIME_COUNTER_TYPE xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = ulTaskGetIdleWindowedRunTimeCounter( eWindow );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = ulTaskGetIdleWindowedRunTimeCounter( eWindow );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         void MPU_vTaskSetApplicationTaskTag( TaskHandle_t xTask,
                                              TaskHookFunction_t pxTagValue ) /* FREERTOS_SYSTEM_CALL */
@@ -632,7 +1158,11 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTaskSetApplicationTaskTag( xTask, pxTagValue );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    vTaskSetApplicationTaskTag( xTask, pxTagValue );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -656,7 +1186,15 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTaskGetApplicationTaskTag( xTask );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    xReturn = xTaskGetApplicationTaskTag( xTask );
+                }
+                else
+                {
+                    xReturn = NULL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -682,7 +1220,11 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTaskSetThreadLocalStoragePointer( xTaskToSet, xIndex, pvValue );
+                if( mpuIS_TASK_ACCESSIBLE( xTaskToSet ) == pdTRUE )
+                {
+                    vTaskSetThreadLocalStoragePointer( xTaskToSet, xIndex, pvValue );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -707,7 +1249,15 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                pvReturn = pvTaskGetThreadLocalStoragePointer( xTaskToQuery, xIndex );
+                if( mpuIS_TASK_ACCESSIBLE( xTaskToQuery ) == pdTRUE )
+                {
+                    pvReturn = pvTaskGetThreadLocalStoragePointer( xTaskToQuery, xIndex );
+                }
+                else
+                {
+                    pvReturn = NULL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -734,7 +1284,15 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTaskCallApplicationTaskHook( xTask, pvParameter );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    xReturn = xTaskCallApplicationTaskHook( xTask, pvParameter );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -802,17 +1360,19 @@
     }
 /*-----------------------------------------------------------*/
 
-    #if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
-        UBaseType_t MPU_uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_WAIT_ON_ADDRESS == 1 )
+        BaseType_t MPU_xTaskWaitOnAddress( const volatile uint32_t * pulAddress,
+                                           uint32_t ulExpectedValue,
+                                           TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            UBaseType_t uxReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                uxReturn = uxTaskGetStackHighWaterMark( xTask );
+                xReturn = xTaskWaitOnAddress( pulAddress, ulExpectedValue, xTicksToWait );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -820,25 +1380,24 @@
             }
             else
             {
-                uxReturn = uxTaskGetStackHighWaterMark( xTask );
+                xReturn = xTaskWaitOnAddress( pulAddress, ulExpectedValue, xTicksToWait );
             }
 
-            return uxReturn;
+            return xReturn;
         }
-    #endif /* if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) */
+    #endif /* if ( configUSE_WAIT_ON_ADDRESS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
-        configSTACK_DEPTH_TYPE MPU_uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_WAIT_ON_ADDRESS == 1 )
+        void MPU_vTaskWakeAddress( const volatile uint32_t * pulAddress,
+                                   UBaseType_t uxTasksToWake ) /* FREERTOS_SYSTEM_CALL */
         {
-            configSTACK_DEPTH_TYPE uxReturn;
-
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                uxReturn = uxTaskGetStackHighWaterMark2( xTask );
+                vTaskWakeAddress( pulAddress, uxTasksToWake );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -846,24 +1405,22 @@
             }
             else
             {
-                uxReturn = uxTaskGetStackHighWaterMark2( xTask );
+                vTaskWakeAddress( pulAddress, uxTasksToWake );
             }
-
-            return uxReturn;
         }
-    #endif /* if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) */
+    #endif /* if ( configUSE_WAIT_ON_ADDRESS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
-        TaskHandle_t MPU_xTaskGetCurrentTaskHandle( void ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 )
+        void MPU_vTaskSetTimeSliceLength( UBaseType_t uxPriority,
+                                          TickType_t xTicks ) /* FREERTOS_SYSTEM_CALL */
         {
-            TaskHandle_t xReturn;
-
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
-                xReturn = xTaskGetCurrentTaskHandle();
+
+                vTaskSetTimeSliceLength( uxPriority, xTicks );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -871,25 +1428,23 @@
             }
             else
             {
-                xReturn = xTaskGetCurrentTaskHandle();
+                vTaskSetTimeSliceLength( uxPriority, xTicks );
             }
-
-            return xReturn;
         }
-    #endif /* if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+    #endif /* if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
-        BaseType_t MPU_xTaskGetSchedulerState( void ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 )
+        TickType_t MPU_xTaskGetTimeSliceLength( UBaseType_t uxPriority ) /* FREERTOS_SYSTEM_CALL */
         {
-            BaseType_t xReturn;
+            TickType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTaskGetSchedulerState();
+                xReturn = xTaskGetTimeSliceLength( uxPriority );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -897,74 +1452,67 @@
             }
             else
             {
-                xReturn = xTaskGetSchedulerState();
+                xReturn = xTaskGetTimeSliceLength( uxPriority );
             }
 
             return xReturn;
         }
-    #endif /* if ( INCLUDE_xTaskGetSchedulerState == 1 ) */
+    #endif /* if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 ) */
 /*-----------------------------------------------------------*/
 
-    void MPU_vTaskSetTimeOutState( TimeOut_t * const pxTimeOut ) /* FREERTOS_SYSTEM_CALL */
-    {
-        if( portIS_PRIVILEGED() == pdFALSE )
+    #if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+        UBaseType_t MPU_uxTaskGetStackHighWaterMark( TaskHandle_t xTask ) /* FREERTOS_SYSTEM_CALL */
         {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
-
-            vTaskSetTimeOutState( pxTimeOut );
-            portMEMORY_BARRIER();
+            UBaseType_t uxReturn;
 
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
-        }
-        else
-        {
-            vTaskSetTimeOutState( pxTimeOut );
-        }
-    }
-/*-----------------------------------------------------------*/
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
 
-    BaseType_t MPU_xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                         TickType_t * const pxTicksToWait ) /* FREERTOS_SYSTEM_CALL */
-    {
-        BaseType_t xReturn;
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    uxReturn = uxTaskGetStackHighWaterMark( xTask );
+                }
+                else
+                {
+                    uxReturn = 0;
+                }
 
-        if( portIS_PRIVILEGED() == pdFALSE )
-        {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
+                portMEMORY_BARRIER();
 
-            xReturn = xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait );
-            portMEMORY_BARRIER();
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                uxReturn = uxTaskGetStackHighWaterMark( xTask );
+            }
 
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
-        }
-        else
-        {
-            xReturn = xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait );
+            return uxReturn;
         }
-
-        return xReturn;
-    }
+    #endif /* if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-        BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify,
-                                           UBaseType_t uxIndexToNotify,
-                                           uint32_t ulValue,
-                                           eNotifyAction eAction,
-                                           uint32_t * pulPreviousNotificationValue ) /* FREERTOS_SYSTEM_CALL */
+    #if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+        configSTACK_DEPTH_TYPE MPU_uxTaskGetStackHighWaterMark2( TaskHandle_t xTask ) /* FREERTOS_SYSTEM_CALL */
         {
-            BaseType_t xReturn;
+            configSTACK_DEPTH_TYPE uxReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    uxReturn = uxTaskGetStackHighWaterMark2( xTask );
+                }
+                else
+                {
+                    uxReturn = 0;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -972,29 +1520,33 @@
             }
             else
             {
-                xReturn = xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
+                uxReturn = uxTaskGetStackHighWaterMark2( xTask );
             }
 
-            return xReturn;
+            return uxReturn;
         }
-    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+    #endif /* if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-        BaseType_t MPU_xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
-                                               uint32_t ulBitsToClearOnEntry,
-                                               uint32_t ulBitsToClearOnExit,
-                                               uint32_t * pulNotificationValue,
-                                               TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        size_t MPU_xTaskGetHeapBytesAllocated( TaskHandle_t xTask ) /* FREERTOS_SYSTEM_CALL */
         {
-            BaseType_t xReturn;
+            size_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    xReturn = xTaskGetHeapBytesAllocated( xTask );
+                }
+                else
+                {
+                    xReturn = 0;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1002,27 +1554,28 @@
             }
             else
             {
-                xReturn = xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait );
+                xReturn = xTaskGetHeapBytesAllocated( xTask );
             }
 
             return xReturn;
         }
-    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+    #endif /* if ( configUSE_TASK_HEAP_ACCOUNTING == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-        uint32_t MPU_ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
-                                              BaseType_t xClearCountOnExit,
-                                              TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        void MPU_vTaskSetHeapQuota( TaskHandle_t xTask,
+                                    size_t xQuota ) /* FREERTOS_SYSTEM_CALL */
         {
-            uint32_t ulReturn;
-
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                ulReturn = ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    vTaskSetHeapQuota( xTask, xQuota );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1030,26 +1583,26 @@
             }
             else
             {
-                ulReturn = ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait );
+                vTaskSetHeapQuota( xTask, xQuota );
             }
-
-            return ulReturn;
         }
-    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+    #endif /* if ( configUSE_TASK_HEAP_ACCOUNTING == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-        BaseType_t MPU_xTaskGenericNotifyStateClear( TaskHandle_t xTask,
-                                                     UBaseType_t uxIndexToClear ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+        void MPU_vTaskGetISRWakeLatencyStats( TaskHandle_t xTask,
+                                              ISRWakeLatencyStats_t * pxStats ) /* FREERTOS_SYSTEM_CALL */
         {
-            BaseType_t xReturn;
-
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTaskGenericNotifyStateClear( xTask, uxIndexToClear );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    vTaskGetISRWakeLatencyStats( xTask, pxStats );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1057,27 +1610,25 @@
             }
             else
             {
-                xReturn = xTaskGenericNotifyStateClear( xTask, uxIndexToClear );
+                vTaskGetISRWakeLatencyStats( xTask, pxStats );
             }
-
-            return xReturn;
         }
-    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+    #endif /* if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-        uint32_t MPU_ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
-                                                    UBaseType_t uxIndexToClear,
-                                                    uint32_t ulBitsToClear ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+        void MPU_vTaskResetISRWakeLatencyStats( TaskHandle_t xTask ) /* FREERTOS_SYSTEM_CALL */
         {
-            uint32_t ulReturn;
-
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                ulReturn = ulTaskGenericNotifyValueClear( xTask, uxIndexToClear, ulBitsToClear );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    vTaskResetISRWakeLatencyStats( xTask );
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1085,27 +1636,22 @@
             }
             else
             {
-                ulReturn = ulTaskGenericNotifyValueClear( xTask, uxIndexToClear, ulBitsToClear );
+                vTaskResetISRWakeLatencyStats( xTask );
             }
-
-            return ulReturn;
         }
-    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+    #endif /* if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-        QueueHandle_t MPU_xQueueGenericCreate( UBaseType_t uxQueueLength,
-                                               UBaseType_t uxItemSize,
-                                               uint8_t ucQueueType ) /* FREERTOS_SYSTEM_CALL */
+    #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+        TaskHandle_t MPU_xTaskGetCurrentTaskHandle( void ) /* FREERTOS_SYSTEM_CALL */
         {
-            QueueHandle_t xReturn;
+            TaskHandle_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
-
-                xReturn = xQueueGenericCreate( uxQueueLength, uxItemSize, ucQueueType );
+                xReturn = xTaskGetCurrentTaskHandle();
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1113,29 +1659,25 @@
             }
             else
             {
-                xReturn = xQueueGenericCreate( uxQueueLength, uxItemSize, ucQueueType );
+                xReturn = xTaskGetCurrentTaskHandle();
             }
 
             return xReturn;
         }
-    #endif /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+    #endif /* if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-        QueueHandle_t MPU_xQueueGenericCreateStatic( const UBaseType_t uxQueueLength,
-                                                     const UBaseType_t uxItemSize,
-                                                     uint8_t * pucQueueStorage,
-                                                     StaticQueue_t * pxStaticQueue,
-                                                     const uint8_t ucQueueType ) /* FREERTOS_SYSTEM_CALL */
+    #if ( INCLUDE_xTaskGetSchedulerState == 1 )
+        BaseType_t MPU_xTaskGetSchedulerState( void ) /* FREERTOS_SYSTEM_CALL */
         {
-            QueueHandle_t xReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueGenericCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue, ucQueueType );
+                xReturn = xTaskGetSchedulerState();
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1143,25 +1685,22 @@
             }
             else
             {
-                xReturn = xQueueGenericCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue, ucQueueType );
+                xReturn = xTaskGetSchedulerState();
             }
 
             return xReturn;
         }
-    #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+    #endif /* if ( INCLUDE_xTaskGetSchedulerState == 1 ) */
 /*-----------------------------------------------------------*/
 
-    BaseType_t MPU_xQueueGenericReset( QueueHandle_t pxQueue,
-                                       BaseType_t xNewQueue ) /* FREERTOS_SYSTEM_CALL */
+    void MPU_vTaskSetTimeOutState( TimeOut_t * const pxTimeOut ) /* FREERTOS_SYSTEM_CALL */
     {
-        BaseType_t xReturn;
-
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xQueueGenericReset( pxQueue, xNewQueue );
+            vTaskSetTimeOutState( pxTimeOut );
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -1169,17 +1708,13 @@
         }
         else
         {
-            xReturn = xQueueGenericReset( pxQueue, xNewQueue );
+            vTaskSetTimeOutState( pxTimeOut );
         }
-
-        return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    BaseType_t MPU_xQueueGenericSend( QueueHandle_t xQueue,
-                                      const void * const pvItemToQueue,
-                                      TickType_t xTicksToWait,
-                                      BaseType_t xCopyPosition ) /* FREERTOS_SYSTEM_CALL */
+    BaseType_t MPU_xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                         TickType_t * const pxTicksToWait ) /* FREERTOS_SYSTEM_CALL */
     {
         BaseType_t xReturn;
 
@@ -1188,7 +1723,7 @@
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+            xReturn = xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait );
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -1196,149 +1731,104 @@
         }
         else
         {
-            xReturn = xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+            xReturn = xTaskCheckForTimeOut( pxTimeOut, pxTicksToWait );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t pxQueue ) /* FREERTOS_SYSTEM_CALL */
-    {
-        UBaseType_t uxReturn;
-
-        if( portIS_PRIVILEGED() == pdFALSE )
-        {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
-
-            uxReturn = uxQueueMessagesWaiting( pxQueue );
-            portMEMORY_BARRIER();
-
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
-        }
-        else
-        {
-            uxReturn = uxQueueMessagesWaiting( pxQueue );
-        }
-
-        return uxReturn;
-    }
-/*-----------------------------------------------------------*/
-
-    UBaseType_t MPU_uxQueueSpacesAvailable( const QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
-    {
-        UBaseType_t uxReturn;
-
-        if( portIS_PRIVILEGED() == pdFALSE )
-        {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
-
-            uxReturn = uxQueueSpacesAvailable( xQueue );
-            portMEMORY_BARRIER();
-
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
-        }
-        else
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        BaseType_t MPU_xTaskGenericNotify( TaskHandle_t xTaskToNotify,
+                                           UBaseType_t uxIndexToNotify,
+                                           uint32_t ulValue,
+                                           eNotifyAction eAction,
+                                           uint32_t * pulPreviousNotificationValue ) /* FREERTOS_SYSTEM_CALL */
         {
-            uxReturn = uxQueueSpacesAvailable( xQueue );
-        }
+            BaseType_t xReturn;
 
-        return uxReturn;
-    }
-/*-----------------------------------------------------------*/
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
 
-    BaseType_t MPU_xQueueReceive( QueueHandle_t pxQueue,
-                                  void * const pvBuffer,
-                                  TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
-    {
-        BaseType_t xReturn;
+                if( mpuIS_TASK_ACCESSIBLE( xTaskToNotify ) == pdTRUE )
+                {
+                    xReturn = xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
 
-        if( portIS_PRIVILEGED() == pdFALSE )
-        {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
+                portMEMORY_BARRIER();
 
-            xReturn = xQueueReceive( pxQueue, pvBuffer, xTicksToWait );
-            portMEMORY_BARRIER();
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, ulValue, eAction, pulPreviousNotificationValue );
+            }
 
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
-        }
-        else
-        {
-            xReturn = xQueueReceive( pxQueue, pvBuffer, xTicksToWait );
+            return xReturn;
         }
-
-        return xReturn;
-    }
+    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
-                               void * const pvBuffer,
-                               TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
-    {
-        BaseType_t xReturn;
-
-        if( portIS_PRIVILEGED() == pdFALSE )
-        {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
-
-            xReturn = xQueuePeek( xQueue, pvBuffer, xTicksToWait );
-            portMEMORY_BARRIER();
-
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
-        }
-        else
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        BaseType_t MPU_xTaskGenericNotifyGroup( TaskHandle_t const * pxTasksToNotify,
+                                                UBaseType_t uxNumberOfTasks,
+                                                UBaseType_t uxIndexToNotify,
+                                                uint32_t ulValue,
+                                                eNotifyAction eAction ) /* FREERTOS_SYSTEM_CALL */
         {
-            xReturn = xQueuePeek( xQueue, pvBuffer, xTicksToWait );
-        }
+            BaseType_t xReturn;
 
-        return xReturn;
-    }
-/*-----------------------------------------------------------*/
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
 
-    BaseType_t MPU_xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                        TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
-    {
-        BaseType_t xReturn;
+                if( mpuARE_TASKS_ACCESSIBLE( pxTasksToNotify, uxNumberOfTasks ) == pdTRUE )
+                {
+                    xReturn = xTaskGenericNotifyGroup( pxTasksToNotify, uxNumberOfTasks, uxIndexToNotify, ulValue, eAction );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
 
-        if( portIS_PRIVILEGED() == pdFALSE )
-        {
-            portRAISE_PRIVILEGE();
-            portMEMORY_BARRIER();
+                portMEMORY_BARRIER();
 
-            xReturn = xQueueSemaphoreTake( xQueue, xTicksToWait );
-            portMEMORY_BARRIER();
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTaskGenericNotifyGroup( pxTasksToNotify, uxNumberOfTasks, uxIndexToNotify, ulValue, eAction );
+            }
 
-            portRESET_PRIVILEGE();
-            portMEMORY_BARRIER();
-        }
-        else
-        {
-            xReturn = xQueueSemaphoreTake( xQueue, xTicksToWait );
+            return xReturn;
         }
-
-        return xReturn;
-    }
+    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
-        TaskHandle_t MPU_xQueueGetMutexHolder( QueueHandle_t xSemaphore ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        BaseType_t MPU_xTaskGenericNotifyWait( UBaseType_t uxIndexToWaitOn,
+                                               uint32_t ulBitsToClearOnEntry,
+                                               uint32_t ulBitsToClearOnExit,
+                                               uint32_t * pulNotificationValue,
+                                               TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            void * xReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueGetMutexHolder( xSemaphore );
+                xReturn = xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1346,25 +1836,30 @@
             }
             else
             {
-                xReturn = xQueueGetMutexHolder( xSemaphore );
+                xReturn = xTaskGenericNotifyWait( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait );
             }
 
             return xReturn;
         }
-    #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
-        QueueHandle_t MPU_xQueueCreateMutex( const uint8_t ucQueueType ) /* FREERTOS_SYSTEM_CALL */
+    #if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_TASK_NOTIFY_SPIN == 1 ) )
+        BaseType_t MPU_xTaskGenericNotifyWaitSpin( UBaseType_t uxIndexToWaitOn,
+                                                   uint32_t ulBitsToClearOnEntry,
+                                                   uint32_t ulBitsToClearOnExit,
+                                                   uint32_t * pulNotificationValue,
+                                                   UBaseType_t uxSpinCount,
+                                                   TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            QueueHandle_t xReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueCreateMutex( ucQueueType );
+                xReturn = xTaskGenericNotifyWaitSpin( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, uxSpinCount, xTicksToWait );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1372,26 +1867,30 @@
             }
             else
             {
-                xReturn = xQueueCreateMutex( ucQueueType );
+                xReturn = xTaskGenericNotifyWaitSpin( uxIndexToWaitOn, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, uxSpinCount, xTicksToWait );
             }
 
             return xReturn;
         }
-    #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+    #endif /* if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_TASK_NOTIFY_SPIN == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-        QueueHandle_t MPU_xQueueCreateMutexStatic( const uint8_t ucQueueType,
-                                                   StaticQueue_t * pxStaticQueue ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        BaseType_t MPU_xTaskNotifyWaitAny( UBaseType_t uxIndexMask,
+                                           uint32_t ulBitsToClearOnEntry,
+                                           uint32_t ulBitsToClearOnExit,
+                                           uint32_t * pulNotificationValue,
+                                           UBaseType_t * puxIndexNotified,
+                                           TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            QueueHandle_t xReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+                xReturn = xTaskNotifyWaitAny( uxIndexMask, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, puxIndexNotified, xTicksToWait );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1399,26 +1898,27 @@
             }
             else
             {
-                xReturn = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+                xReturn = xTaskNotifyWaitAny( uxIndexMask, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, puxIndexNotified, xTicksToWait );
             }
 
             return xReturn;
         }
-    #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
-        QueueHandle_t MPU_xQueueCreateCountingSemaphore( UBaseType_t uxCountValue,
-                                                         UBaseType_t uxInitialCount ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        uint32_t MPU_ulTaskGenericNotifyTake( UBaseType_t uxIndexToWaitOn,
+                                              BaseType_t xClearCountOnExit,
+                                              TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            QueueHandle_t xReturn;
+            uint32_t ulReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueCreateCountingSemaphore( uxCountValue, uxInitialCount );
+                ulReturn = ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1426,28 +1926,34 @@
             }
             else
             {
-                xReturn = xQueueCreateCountingSemaphore( uxCountValue, uxInitialCount );
+                ulReturn = ulTaskGenericNotifyTake( uxIndexToWaitOn, xClearCountOnExit, xTicksToWait );
             }
 
-            return xReturn;
+            return ulReturn;
         }
-    #endif /* if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
-
-        QueueHandle_t MPU_xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
-                                                               const UBaseType_t uxInitialCount,
-                                                               StaticQueue_t * pxStaticQueue ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        BaseType_t MPU_xTaskGenericNotifyStateClear( TaskHandle_t xTask,
+                                                     UBaseType_t uxIndexToClear ) /* FREERTOS_SYSTEM_CALL */
         {
-            QueueHandle_t xReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    xReturn = xTaskGenericNotifyStateClear( xTask, uxIndexToClear );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1455,26 +1961,35 @@
             }
             else
             {
-                xReturn = xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+                xReturn = xTaskGenericNotifyStateClear( xTask, uxIndexToClear );
             }
 
             return xReturn;
         }
-    #endif /* if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_RECURSIVE_MUTEXES == 1 )
-        BaseType_t MPU_xQueueTakeMutexRecursive( QueueHandle_t xMutex,
-                                                 TickType_t xBlockTime ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+        uint32_t MPU_ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
+                                                    UBaseType_t uxIndexToClear,
+                                                    uint32_t ulBitsToClear ) /* FREERTOS_SYSTEM_CALL */
         {
-            BaseType_t xReturn;
+            uint32_t ulReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueTakeMutexRecursive( xMutex, xBlockTime );
+                if( mpuIS_TASK_ACCESSIBLE( xTask ) == pdTRUE )
+                {
+                    ulReturn = ulTaskGenericNotifyValueClear( xTask, uxIndexToClear, ulBitsToClear );
+                }
+                else
+                {
+                    ulReturn = 0;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1482,16 +1997,19 @@
             }
             else
             {
-                xReturn = xQueueTakeMutexRecursive( xMutex, xBlockTime );
+                ulReturn = ulTaskGenericNotifyValueClear( xTask, uxIndexToClear, ulBitsToClear );
             }
 
-            return xReturn;
+            return ulReturn;
         }
-    #endif /* if ( configUSE_RECURSIVE_MUTEXES == 1 ) */
+    #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_RECURSIVE_MUTEXES == 1 )
-        BaseType_t MPU_xQueueGiveMutexRecursive( QueueHandle_t xMutex ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_MAILBOXES == 1 )
+        BaseType_t MPU_xTaskGenericMailboxSend( TaskHandle_t xTaskToNotify,
+                                                UBaseType_t uxIndexToNotify,
+                                                void * pvMessage,
+                                                BaseType_t xOverwrite ) /* FREERTOS_SYSTEM_CALL */
         {
             BaseType_t xReturn;
 
@@ -1500,7 +2018,15 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueGiveMutexRecursive( xMutex );
+                if( mpuIS_TASK_ACCESSIBLE( xTaskToNotify ) == pdTRUE )
+                {
+                    xReturn = xTaskGenericMailboxSend( xTaskToNotify, uxIndexToNotify, pvMessage, xOverwrite );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1508,25 +2034,27 @@
             }
             else
             {
-                xReturn = xQueueGiveMutexRecursive( xMutex );
+                xReturn = xTaskGenericMailboxSend( xTaskToNotify, uxIndexToNotify, pvMessage, xOverwrite );
             }
 
             return xReturn;
         }
-    #endif /* if ( configUSE_RECURSIVE_MUTEXES == 1 ) */
+    #endif /* if ( configUSE_TASK_MAILBOXES == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
-        QueueSetHandle_t MPU_xQueueCreateSet( UBaseType_t uxEventQueueLength ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_TASK_MAILBOXES == 1 )
+        BaseType_t MPU_xTaskGenericMailboxReceive( UBaseType_t uxIndexToWaitOn,
+                                                   void ** ppvMessage,
+                                                   TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            QueueSetHandle_t xReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueCreateSet( uxEventQueueLength );
+                xReturn = xTaskGenericMailboxReceive( uxIndexToWaitOn, ppvMessage, xTicksToWait );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1534,26 +2062,28 @@
             }
             else
             {
-                xReturn = xQueueCreateSet( uxEventQueueLength );
+                xReturn = xTaskGenericMailboxReceive( uxIndexToWaitOn, ppvMessage, xTicksToWait );
             }
 
             return xReturn;
         }
-    #endif /* if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+    #endif /* if ( configUSE_TASK_MAILBOXES == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_QUEUE_SETS == 1 )
-        QueueSetMemberHandle_t MPU_xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
-                                                        TickType_t xBlockTimeTicks ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        QueueHandle_t MPU_xQueueGenericCreate( UBaseType_t uxQueueLength,
+                                               UBaseType_t uxItemSize,
+                                               uint8_t ucQueueType ) /* FREERTOS_SYSTEM_CALL */
         {
-            QueueSetMemberHandle_t xReturn;
+            QueueHandle_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueSelectFromSet( xQueueSet, xBlockTimeTicks );
+                xReturn = xQueueGenericCreate( uxQueueLength, uxItemSize, ucQueueType );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1561,26 +2091,30 @@
             }
             else
             {
-                xReturn = xQueueSelectFromSet( xQueueSet, xBlockTimeTicks );
+                xReturn = xQueueGenericCreate( uxQueueLength, uxItemSize, ucQueueType );
             }
 
             return xReturn;
         }
-    #endif /* if ( configUSE_QUEUE_SETS == 1 ) */
+    #endif /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_QUEUE_SETS == 1 )
-        BaseType_t MPU_xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
-                                       QueueSetHandle_t xQueueSet ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        QueueHandle_t MPU_xQueueGenericCreateStatic( const UBaseType_t uxQueueLength,
+                                                     const UBaseType_t uxItemSize,
+                                                     uint8_t * pucQueueStorage,
+                                                     StaticQueue_t * pxStaticQueue,
+                                                     const uint8_t ucQueueType ) /* FREERTOS_SYSTEM_CALL */
         {
-            BaseType_t xReturn;
+            QueueHandle_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
+                xReturn = xQueueGenericCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue, ucQueueType );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1588,73 +2122,69 @@
             }
             else
             {
-                xReturn = xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
+                xReturn = xQueueGenericCreateStatic( uxQueueLength, uxItemSize, pucQueueStorage, pxStaticQueue, ucQueueType );
             }
 
             return xReturn;
         }
-    #endif /* if ( configUSE_QUEUE_SETS == 1 ) */
+    #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_QUEUE_SETS == 1 )
-        BaseType_t MPU_xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
-                                            QueueSetHandle_t xQueueSet ) /* FREERTOS_SYSTEM_CALL */
+    BaseType_t MPU_xQueueGenericReset( QueueHandle_t pxQueue,
+                                       BaseType_t xNewQueue ) /* FREERTOS_SYSTEM_CALL */
+    {
+        BaseType_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
         {
-            BaseType_t xReturn;
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
 
-            if( portIS_PRIVILEGED() == pdFALSE )
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( pxQueue ) == pdTRUE )
             {
-                portRAISE_PRIVILEGE();
-                portMEMORY_BARRIER();
-
-                xReturn = xQueueRemoveFromSet( xQueueOrSemaphore, xQueueSet );
-                portMEMORY_BARRIER();
-
-                portRESET_PRIVILEGE();
-                portMEMORY_BARRIER();
+                xReturn = xQueueGenericReset( pxQueue, xNewQueue );
             }
             else
             {
-                xReturn = xQueueRemoveFromSet( xQueueOrSemaphore, xQueueSet );
+                xReturn = pdFAIL;
             }
 
-            return xReturn;
-        }
-    #endif /* if ( configUSE_QUEUE_SETS == 1 ) */
-/*-----------------------------------------------------------*/
+            portMEMORY_BARRIER();
 
-    #if configQUEUE_REGISTRY_SIZE > 0
-        void MPU_vQueueAddToRegistry( QueueHandle_t xQueue,
-                                      const char * pcName ) /* FREERTOS_SYSTEM_CALL */
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
         {
-            if( portIS_PRIVILEGED() == pdFALSE )
-            {
-                portRAISE_PRIVILEGE();
-                portMEMORY_BARRIER();
-
-                vQueueAddToRegistry( xQueue, pcName );
-                portMEMORY_BARRIER();
-
-                portRESET_PRIVILEGE();
-                portMEMORY_BARRIER();
-            }
-            else
-            {
-                vQueueAddToRegistry( xQueue, pcName );
-            }
+            xReturn = xQueueGenericReset( pxQueue, xNewQueue );
         }
-    #endif /* if configQUEUE_REGISTRY_SIZE > 0 */
+
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-    #if configQUEUE_REGISTRY_SIZE > 0
-        void MPU_vQueueUnregisterQueue( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        BaseType_t MPU_xQueueGenericSend( QueueHandle_t xQueue,
+                                          const void * const pvItemToQueue,
+                                          TickType_t xTicksToWait,
+                                          BaseType_t xCopyPosition ) /* FREERTOS_SYSTEM_CALL */
         {
+            BaseType_t xReturn;
+
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vQueueUnregisterQueue( xQueue );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1662,23 +2192,33 @@
             }
             else
             {
-                vQueueUnregisterQueue( xQueue );
+                xReturn = xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
             }
+
+            return xReturn;
         }
-    #endif /* if configQUEUE_REGISTRY_SIZE > 0 */
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if configQUEUE_REGISTRY_SIZE > 0
-        const char * MPU_pcQueueGetName( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t pxQueue ) /* FREERTOS_SYSTEM_CALL */
         {
-            const char * pcReturn;
+            UBaseType_t uxReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                pcReturn = pcQueueGetName( xQueue );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( pxQueue ) == pdTRUE )
+                {
+                    uxReturn = uxQueueMessagesWaiting( pxQueue );
+                }
+                else
+                {
+                    uxReturn = 0;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1686,22 +2226,32 @@
             }
             else
             {
-                pcReturn = pcQueueGetName( xQueue );
+                uxReturn = uxQueueMessagesWaiting( pxQueue );
             }
 
-            return pcReturn;
+            return uxReturn;
         }
-    #endif /* if configQUEUE_REGISTRY_SIZE > 0 */
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
 /*-----------------------------------------------------------*/
 
-    void MPU_vQueueDelete( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+    UBaseType_t MPU_uxQueueSpacesAvailable( const QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
     {
+        UBaseType_t uxReturn;
+
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            vQueueDelete( xQueue );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+            {
+                uxReturn = uxQueueSpacesAvailable( xQueue );
+            }
+            else
+            {
+                uxReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -1709,22 +2259,34 @@
         }
         else
         {
-            vQueueDelete( xQueue );
+            uxReturn = uxQueueSpacesAvailable( xQueue );
         }
+
+        return uxReturn;
     }
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
-        void * MPU_pvTimerGetTimerID( const TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        BaseType_t MPU_xQueueReceive( QueueHandle_t pxQueue,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            void * pvReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                pvReturn = pvTimerGetTimerID( xTimer );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( pxQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueReceive( pxQueue, pvBuffer, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1732,24 +2294,35 @@
             }
             else
             {
-                pvReturn = pvTimerGetTimerID( xTimer );
+                xReturn = xQueueReceive( pxQueue, pvBuffer, xTicksToWait );
             }
 
-            return pvReturn;
+            return xReturn;
         }
-    #endif /* if ( configUSE_TIMERS == 1 ) */
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
-        void MPU_vTimerSetTimerID( TimerHandle_t xTimer,
-                                   void * pvNewID ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
+                                   void * const pvBuffer,
+                                   TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
+            BaseType_t xReturn;
+
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTimerSetTimerID( xTimer, pvNewID );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueuePeek( xQueue, pvBuffer, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1757,14 +2330,17 @@
             }
             else
             {
-                vTimerSetTimerID( xTimer, pvNewID );
+                xReturn = xQueuePeek( xQueue, pvBuffer, xTicksToWait );
             }
+
+            return xReturn;
         }
-    #endif /* if ( configUSE_TIMERS == 1 ) */
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
-        BaseType_t MPU_xTimerIsTimerActive( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        BaseType_t MPU_xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                            TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
             BaseType_t xReturn;
 
@@ -1773,7 +2349,15 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTimerIsTimerActive( xTimer );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueSemaphoreTake( xQueue, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1781,17 +2365,1133 @@
             }
             else
             {
-                xReturn = xTimerIsTimerActive( xTimer );
+                xReturn = xQueueSemaphoreTake( xQueue, xTicksToWait );
             }
 
             return xReturn;
         }
-    #endif /* if ( configUSE_TIMERS == 1 ) */
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
-        TaskHandle_t MPU_xTimerGetTimerDaemonTaskHandle( void ) /* FREERTOS_SYSTEM_CALL */
-        {
+    BaseType_t MPU_xQueueSendMultiple( QueueHandle_t xQueue,
+                                       const void * const pvItems,
+                                       UBaseType_t uxItemCount,
+                                       TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        BaseType_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+            {
+                xReturn = xQueueSendMultiple( xQueue, pvItems, uxItemCount, xTicksToWait );
+            }
+            else
+            {
+                xReturn = errQUEUE_FULL;
+            }
+
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xQueueSendMultiple( xQueue, pvItems, uxItemCount, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t MPU_xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                          void * const pvBuffer,
+                                          UBaseType_t uxItemCount,
+                                          TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        BaseType_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+            {
+                xReturn = xQueueReceiveMultiple( xQueue, pvBuffer, uxItemCount, xTicksToWait );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xQueueReceiveMultiple( xQueue, pvBuffer, uxItemCount, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        BaseType_t MPU_xQueueAcquireSlot( QueueHandle_t xQueue,
+                                          void ** const ppvSlot,
+                                          TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueAcquireSlot( xQueue, ppvSlot, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = errQUEUE_FULL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueAcquireSlot( xQueue, ppvSlot, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_ZERO_COPY == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        BaseType_t MPU_xQueueCommitSlot( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueCommitSlot( xQueue );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCommitSlot( xQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_ZERO_COPY == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        BaseType_t MPU_xQueuePeekSlot( QueueHandle_t xQueue,
+                                       void ** const ppvSlot,
+                                       TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueuePeekSlot( xQueue, ppvSlot, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = errQUEUE_EMPTY;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueuePeekSlot( xQueue, ppvSlot, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_ZERO_COPY == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        BaseType_t MPU_xQueueReleaseSlot( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueReleaseSlot( xQueue );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueReleaseSlot( xQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_ZERO_COPY == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+        BaseType_t MPU_xQueueSetWaitOrder( QueueHandle_t xQueue,
+                                           BaseType_t xWaitOrder ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueSetWaitOrder( xQueue, xWaitOrder );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueSetWaitOrder( xQueue, xWaitOrder );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_WAIT_ORDER == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+        BaseType_t MPU_xQueueSetOverflowPolicy( QueueHandle_t xQueue,
+                                                BaseType_t xPolicy ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueSetOverflowPolicy( xQueue, xPolicy );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueSetOverflowPolicy( xQueue, xPolicy );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_OVERFLOW_POLICY == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        void MPU_vQueueGetStats( QueueHandle_t xQueue,
+                                 QueueStats_t * pxQueueStats ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    vQueueGetStats( xQueue, pxQueueStats );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vQueueGetStats( xQueue, pxQueueStats );
+            }
+        }
+    #endif /* if ( configUSE_QUEUE_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        void MPU_vQueueResetStats( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    vQueueResetStats( xQueue );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vQueueResetStats( xQueue );
+            }
+        }
+    #endif /* if ( configUSE_QUEUE_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
+        TaskHandle_t MPU_xQueueGetMutexHolder( QueueHandle_t xSemaphore ) /* FREERTOS_SYSTEM_CALL */
+        {
+            void * xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xSemaphore ) == pdTRUE )
+                {
+                    xReturn = xQueueGetMutexHolder( xSemaphore );
+                }
+                else
+                {
+                    xReturn = NULL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueGetMutexHolder( xSemaphore );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateMutex( const uint8_t ucQueueType ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateMutex( ucQueueType );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateMutex( ucQueueType );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateMutexStatic( const uint8_t ucQueueType,
+                                                   StaticQueue_t * pxStaticQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_MUTEXES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateMutexWithCeiling( const uint8_t ucQueueType,
+                                                        UBaseType_t uxCeilingPriority ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateMutexWithCeiling( ucQueueType, uxCeilingPriority );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateMutexWithCeiling( ucQueueType, uxCeilingPriority );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType,
+                                                              UBaseType_t uxCeilingPriority,
+                                                              StaticQueue_t * pxStaticQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateMutexWithCeilingStatic( ucQueueType, uxCeilingPriority, pxStaticQueue );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateMutexWithCeilingStatic( ucQueueType, uxCeilingPriority, pxStaticQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateCountingSemaphore( UBaseType_t uxCountValue,
+                                                         UBaseType_t uxInitialCount ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateCountingSemaphore( uxCountValue, uxInitialCount );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateCountingSemaphore( uxCountValue, uxInitialCount );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+        QueueHandle_t MPU_xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
+                                                               const UBaseType_t uxInitialCount,
+                                                               StaticQueue_t * pxStaticQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateCountingSemaphoreStatic( uxMaxCount, uxInitialCount, pxStaticQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RECURSIVE_MUTEXES == 1 )
+        BaseType_t MPU_xQueueTakeMutexRecursive( QueueHandle_t xMutex,
+                                                 TickType_t xBlockTime ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xMutex ) == pdTRUE )
+                {
+                    xReturn = xQueueTakeMutexRecursive( xMutex, xBlockTime );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueTakeMutexRecursive( xMutex, xBlockTime );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RECURSIVE_MUTEXES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RECURSIVE_MUTEXES == 1 )
+        BaseType_t MPU_xQueueGiveMutexRecursive( QueueHandle_t xMutex ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xMutex ) == pdTRUE )
+                {
+                    xReturn = xQueueGiveMutexRecursive( xMutex );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueGiveMutexRecursive( xMutex );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RECURSIVE_MUTEXES == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateRWLock( void ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateRWLock();
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateRWLock();
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+        QueueHandle_t MPU_xQueueCreateRWLockStatic( StaticQueue_t * pxStaticQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateRWLockStatic( pxStaticQueue );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateRWLockStatic( pxStaticQueue );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        BaseType_t MPU_xQueueTakeRWLock( QueueHandle_t xRWLock,
+                                         BaseType_t xWrite,
+                                         TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xRWLock ) == pdTRUE )
+                {
+                    xReturn = xQueueTakeRWLock( xRWLock, xWrite, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueTakeRWLock( xRWLock, xWrite, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_RW_LOCKS == 1 )
+        BaseType_t MPU_xQueueGiveRWLock( QueueHandle_t xRWLock,
+                                         BaseType_t xWrite ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xRWLock ) == pdTRUE )
+                {
+                    xReturn = xQueueGiveRWLock( xRWLock, xWrite );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueGiveRWLock( xRWLock, xWrite );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_RW_LOCKS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+        QueueSetHandle_t MPU_xQueueCreateSet( UBaseType_t uxEventQueueLength ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueSetHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xQueueCreateSet( uxEventQueueLength );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueCreateSet( uxEventQueueLength );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_QUEUE_SETS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        QueueSetMemberHandle_t MPU_xQueueSelectFromSet( QueueSetHandle_t xQueueSet,
+                                                        TickType_t xBlockTimeTicks ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueSetMemberHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueueSet ) == pdTRUE )
+                {
+                    xReturn = xQueueSelectFromSet( xQueueSet, xBlockTimeTicks );
+                }
+                else
+                {
+                    xReturn = NULL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueSelectFromSet( xQueueSet, xBlockTimeTicks );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_SETS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+        QueueSetMemberHandle_t MPU_xQueueWaitForAny( QueueWaitRecord_t * const pxWaitRecords,
+                                                     const UBaseType_t uxNumberOfRecords,
+                                                     TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            QueueSetMemberHandle_t xReturn = NULL;
+            BaseType_t xAccessible = pdTRUE;
+            UBaseType_t x;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                for( x = 0U; x < uxNumberOfRecords; x++ )
+                {
+                    if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( pxWaitRecords[ x ].xQueueOrSemaphore ) == pdFALSE )
+                    {
+                        xAccessible = pdFALSE;
+                        break;
+                    }
+                }
+
+                if( xAccessible == pdTRUE )
+                {
+                    xReturn = xQueueWaitForAny( pxWaitRecords, uxNumberOfRecords, xTicksToWait );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueWaitForAny( pxWaitRecords, uxNumberOfRecords, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        BaseType_t MPU_xQueueAddToSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                                       QueueSetHandle_t xQueueSet ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueueOrSemaphore ) == pdTRUE ) &&
+                    ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueueSet ) == pdTRUE ) )
+                {
+                    xReturn = xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueAddToSet( xQueueOrSemaphore, xQueueSet );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_SETS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        BaseType_t MPU_xQueueRemoveFromSet( QueueSetMemberHandle_t xQueueOrSemaphore,
+                                            QueueSetHandle_t xQueueSet ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueueOrSemaphore ) == pdTRUE ) &&
+                    ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueueSet ) == pdTRUE ) )
+                {
+                    xReturn = xQueueRemoveFromSet( xQueueOrSemaphore, xQueueSet );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xQueueRemoveFromSet( xQueueOrSemaphore, xQueueSet );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_QUEUE_SETS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if configQUEUE_REGISTRY_SIZE > 0
+        void MPU_vQueueAddToRegistry( QueueHandle_t xQueue,
+                                      const char * pcName ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    vQueueAddToRegistry( xQueue, pcName );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vQueueAddToRegistry( xQueue, pcName );
+            }
+        }
+    #endif /* if configQUEUE_REGISTRY_SIZE > 0 */
+/*-----------------------------------------------------------*/
+
+    #if configQUEUE_REGISTRY_SIZE > 0
+        void MPU_vQueueUnregisterQueue( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    vQueueUnregisterQueue( xQueue );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vQueueUnregisterQueue( xQueue );
+            }
+        }
+    #endif /* if configQUEUE_REGISTRY_SIZE > 0 */
+/*-----------------------------------------------------------*/
+
+    #if configQUEUE_REGISTRY_SIZE > 0
+        const char * MPU_pcQueueGetName( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+        {
+            const char * pcReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    pcReturn = pcQueueGetName( xQueue );
+                }
+                else
+                {
+                    pcReturn = NULL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                pcReturn = pcQueueGetName( xQueue );
+            }
+
+            return pcReturn;
+        }
+    #endif /* if configQUEUE_REGISTRY_SIZE > 0 */
+/*-----------------------------------------------------------*/
+
+    void MPU_vQueueDelete( QueueHandle_t xQueue ) /* FREERTOS_SYSTEM_CALL */
+    {
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+            {
+                mpuREMOVE_KERNEL_OBJECT( xQueue );
+                vQueueDelete( xQueue );
+            }
+
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            mpuREMOVE_KERNEL_OBJECT( xQueue );
+            vQueueDelete( xQueue );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        void * MPU_pvTimerGetTimerID( const TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            void * pvReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    pvReturn = pvTimerGetTimerID( xTimer );
+                }
+                else
+                {
+                    pvReturn = NULL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                pvReturn = pvTimerGetTimerID( xTimer );
+            }
+
+            return pvReturn;
+        }
+    #endif /* if ( configUSE_TIMERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        void MPU_vTimerSetTimerID( TimerHandle_t xTimer,
+                                   void * pvNewID ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    vTimerSetTimerID( xTimer, pvNewID );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTimerSetTimerID( xTimer, pvNewID );
+            }
+        }
+    #endif /* if ( configUSE_TIMERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        BaseType_t MPU_xTimerIsTimerActive( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    xReturn = xTimerIsTimerActive( xTimer );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTimerIsTimerActive( xTimer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_TIMERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        TaskHandle_t MPU_xTimerGetTimerDaemonTaskHandle( void ) /* FREERTOS_SYSTEM_CALL */
+        {
             TaskHandle_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
@@ -1799,7 +3499,284 @@
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTimerGetTimerDaemonTaskHandle();
+                xReturn = xTimerGetTimerDaemonTaskHandle();
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTimerGetTimerDaemonTaskHandle();
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_TIMERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        void MPU_vTimerSetReloadMode( TimerHandle_t xTimer,
+                                      const UBaseType_t uxAutoReload ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    vTimerSetReloadMode( xTimer, uxAutoReload );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTimerSetReloadMode( xTimer, uxAutoReload );
+            }
+        }
+    #endif /* if ( configUSE_TIMERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) )
+        void MPU_vTimerSetCallbackFromTick( TimerHandle_t xTimer,
+                                            const BaseType_t xCallbackFromTick ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    vTimerSetCallbackFromTick( xTimer, xCallbackFromTick );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTimerSetCallbackFromTick( xTimer, xCallbackFromTick );
+            }
+        }
+    #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+        void MPU_vTimerSetSlack( TimerHandle_t xTimer,
+                                 const TickType_t xSlackInTicks ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    vTimerSetSlack( xTimer, xSlackInTicks );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vTimerSetSlack( xTimer, xSlackInTicks );
+            }
+        }
+    #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_SLACK == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) )
+        BaseType_t MPU_xHRTimerStart( HRTimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    xReturn = xHRTimerStart( xTimer );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xHRTimerStart( xTimer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) )
+        BaseType_t MPU_xHRTimerStop( HRTimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    xReturn = xHRTimerStop( xTimer );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xHRTimerStop( xTimer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) )
+        BaseType_t MPU_xHRTimerIsTimerActive( HRTimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            BaseType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    xReturn = xHRTimerIsTimerActive( xTimer );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xHRTimerIsTimerActive( xTimer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) )
+        void * MPU_pvHRTimerGetTimerID( const HRTimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            void * pvReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    pvReturn = pvHRTimerGetTimerID( xTimer );
+                }
+                else
+                {
+                    pvReturn = NULL;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                pvReturn = pvHRTimerGetTimerID( xTimer );
+            }
+
+            return pvReturn;
+        }
+    #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        UBaseType_t MPU_uxTimerGetReloadMode( TimerHandle_t xTimer )
+        {
+            UBaseType_t uxReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                uxReturn = uxTimerGetReloadMode( xTimer );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                uxReturn = uxTimerGetReloadMode( xTimer );
+            }
+
+            return uxReturn;
+        }
+    #endif /* if ( configUSE_TIMERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        const char * MPU_pcTimerGetName( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            const char * pcReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    pcReturn = pcTimerGetName( xTimer );
+                }
+                else
+                {
+                    pcReturn = NULL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1807,7 +3784,41 @@
             }
             else
             {
-                xReturn = xTimerGetTimerDaemonTaskHandle();
+                pcReturn = pcTimerGetName( xTimer );
+            }
+
+            return pcReturn;
+        }
+    #endif /* if ( configUSE_TIMERS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+        TickType_t MPU_xTimerGetPeriod( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            TickType_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    xReturn = xTimerGetPeriod( xTimer );
+                }
+                else
+                {
+                    xReturn = 0;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xTimerGetPeriod( xTimer );
             }
 
             return xReturn;
@@ -1816,15 +3827,24 @@
 /*-----------------------------------------------------------*/
 
     #if ( configUSE_TIMERS == 1 )
-        void MPU_vTimerSetReloadMode( TimerHandle_t xTimer,
-                                      const UBaseType_t uxAutoReload ) /* FREERTOS_SYSTEM_CALL */
+        TickType_t MPU_xTimerGetExpiryTime( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
         {
+            TickType_t xReturn;
+
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                vTimerSetReloadMode( xTimer, uxAutoReload );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    xReturn = xTimerGetExpiryTime( xTimer );
+                }
+                else
+                {
+                    xReturn = 0;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1832,23 +3852,44 @@
             }
             else
             {
-                vTimerSetReloadMode( xTimer, uxAutoReload );
+                xReturn = xTimerGetExpiryTime( xTimer );
             }
+
+            return xReturn;
         }
     #endif /* if ( configUSE_TIMERS == 1 ) */
 /*-----------------------------------------------------------*/
 
     #if ( configUSE_TIMERS == 1 )
-        UBaseType_t MPU_uxTimerGetReloadMode( TimerHandle_t xTimer )
+        BaseType_t MPU_xTimerGenericCommand( TimerHandle_t xTimer,
+                                             const BaseType_t xCommandID,
+                                             const TickType_t xOptionalValue,
+                                             BaseType_t * const pxHigherPriorityTaskWoken,
+                                             const TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            UBaseType_t uxReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                uxReturn = uxTimerGetReloadMode( xTimer );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xTimer ) == pdTRUE )
+                {
+                    #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+                        if( xCommandID == tmrCOMMAND_DELETE )
+                        {
+                            mpuREMOVE_KERNEL_OBJECT( xTimer );
+                        }
+                    #endif
+
+                    xReturn = xTimerGenericCommand( xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1856,25 +3897,235 @@
             }
             else
             {
-                uxReturn = uxTimerGetReloadMode( xTimer );
+                #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+                    if( xCommandID == tmrCOMMAND_DELETE )
+                    {
+                        mpuREMOVE_KERNEL_OBJECT( xTimer );
+                    }
+                #endif
+
+                xReturn = xTimerGenericCommand( xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken, xTicksToWait );
             }
 
-            return uxReturn;
+            return xReturn;
         }
     #endif /* if ( configUSE_TIMERS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
-        const char * MPU_pcTimerGetName( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        EventGroupHandle_t MPU_xEventGroupCreate( void ) /* FREERTOS_SYSTEM_CALL */
+        {
+            EventGroupHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xEventGroupCreate();
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xEventGroupCreate();
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        EventGroupHandle_t MPU_xEventGroupCreateStatic( StaticEventGroup_t * pxEventGroupBuffer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            EventGroupHandle_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                xReturn = xEventGroupCreateStatic( pxEventGroupBuffer );
+                mpuGRANT_CALLING_TASK_ACCESS( xReturn );
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xEventGroupCreateStatic( pxEventGroupBuffer );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
+
+    EventBits_t MPU_xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
+                                         const EventBits_t uxBitsToWaitFor,
+                                         const BaseType_t xClearOnExit,
+                                         const BaseType_t xWaitForAllBits,
+                                         TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        EventBits_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xEventGroup ) == pdTRUE )
+            {
+                xReturn = xEventGroupWaitBits( xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xEventGroupWaitBits( xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    EventBits_t MPU_xEventGroupClearBits( EventGroupHandle_t xEventGroup,
+                                          const EventBits_t uxBitsToClear ) /* FREERTOS_SYSTEM_CALL */
+    {
+        EventBits_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xEventGroup ) == pdTRUE )
+            {
+                xReturn = xEventGroupClearBits( xEventGroup, uxBitsToClear );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xEventGroupClearBits( xEventGroup, uxBitsToClear );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        EventBits_t MPU_xEventGroupSetBits( EventGroupHandle_t xEventGroup,
+                                            const EventBits_t uxBitsToSet ) /* FREERTOS_SYSTEM_CALL */
+        {
+            EventBits_t xReturn;
+
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xEventGroup ) == pdTRUE )
+                {
+                    xReturn = xEventGroupSetBits( xEventGroup, uxBitsToSet );
+                }
+                else
+                {
+                    xReturn = 0;
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                xReturn = xEventGroupSetBits( xEventGroup, uxBitsToSet );
+            }
+
+            return xReturn;
+        }
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
+/*-----------------------------------------------------------*/
+
+    EventBits_t MPU_xEventGroupSync( EventGroupHandle_t xEventGroup,
+                                     const EventBits_t uxBitsToSet,
+                                     const EventBits_t uxBitsToWaitFor,
+                                     TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        EventBits_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xEventGroup ) == pdTRUE )
+            {
+                xReturn = xEventGroupSync( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTicksToWait );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xEventGroupSync( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTicksToWait );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EVENT_GROUP_BARRIERS == 1 )
+        BaseType_t MPU_xEventGroupBarrierWait( EventGroupHandle_t xEventGroup,
+                                               const UBaseType_t uxParticipants,
+                                               TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            const char * pcReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                pcReturn = pcTimerGetName( xTimer );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xEventGroup ) == pdTRUE )
+                {
+                    xReturn = xEventGroupBarrierWait( xEventGroup, uxParticipants, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1882,25 +4133,62 @@
             }
             else
             {
-                pcReturn = pcTimerGetName( xTimer );
+                xReturn = xEventGroupBarrierWait( xEventGroup, uxParticipants, xTicksToWait );
             }
 
-            return pcReturn;
+            return xReturn;
         }
-    #endif /* if ( configUSE_TIMERS == 1 ) */
+    #endif /* if ( configUSE_EVENT_GROUP_BARRIERS == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
-        TickType_t MPU_xTimerGetPeriod( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+    void MPU_vEventGroupDelete( EventGroupHandle_t xEventGroup ) /* FREERTOS_SYSTEM_CALL */
+    {
+        if( portIS_PRIVILEGED() == pdFALSE )
         {
-            TickType_t xReturn;
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xEventGroup ) == pdTRUE )
+            {
+                mpuREMOVE_KERNEL_OBJECT( xEventGroup );
+                vEventGroupDelete( xEventGroup );
+            }
+
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            mpuREMOVE_KERNEL_OBJECT( xEventGroup );
+            vEventGroupDelete( xEventGroup );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
+                                      const void * pvTxData,
+                                      size_t xDataLengthBytes,
+                                      TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+        {
+            size_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xTimerGetPeriod( xTimer );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+                {
+                    xReturn = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = 0;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1908,81 +4196,101 @@
             }
             else
             {
-                xReturn = xTimerGetPeriod( xTimer );
+                xReturn = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
             }
 
             return xReturn;
         }
-    #endif /* if ( configUSE_TIMERS == 1 ) */
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
-        TickType_t MPU_xTimerGetExpiryTime( TimerHandle_t xTimer ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                                   const StreamBufferFragment_t * pxFragments,
+                                   size_t xFragmentCount,
+                                   TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    {
+        size_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
         {
-            TickType_t xReturn;
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
 
-            if( portIS_PRIVILEGED() == pdFALSE )
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
             {
-                portRAISE_PRIVILEGE();
-                portMEMORY_BARRIER();
-
-                xReturn = xTimerGetExpiryTime( xTimer );
-                portMEMORY_BARRIER();
-
-                portRESET_PRIVILEGE();
-                portMEMORY_BARRIER();
+                xReturn = xStreamBufferSendV( xStreamBuffer, pxFragments, xFragmentCount, xTicksToWait );
             }
             else
             {
-                xReturn = xTimerGetExpiryTime( xTimer );
+                xReturn = 0;
             }
 
-            return xReturn;
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
         }
-    #endif /* if ( configUSE_TIMERS == 1 ) */
+        else
+        {
+            xReturn = xStreamBufferSendV( xStreamBuffer, pxFragments, xFragmentCount, xTicksToWait );
+        }
+
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-    #if ( configUSE_TIMERS == 1 )
-        BaseType_t MPU_xTimerGenericCommand( TimerHandle_t xTimer,
-                                             const BaseType_t xCommandID,
-                                             const TickType_t xOptionalValue,
-                                             BaseType_t * const pxHigherPriorityTaskWoken,
-                                             const TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    {
+        size_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
         {
-            BaseType_t xReturn;
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
 
-            if( portIS_PRIVILEGED() == pdFALSE )
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
             {
-                portRAISE_PRIVILEGE();
-                portMEMORY_BARRIER();
-
-                xReturn = xTimerGenericCommand( xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken, xTicksToWait );
-                portMEMORY_BARRIER();
-
-                portRESET_PRIVILEGE();
-                portMEMORY_BARRIER();
+                xReturn = xStreamBufferNextMessageLengthBytes( xStreamBuffer );
             }
             else
             {
-                xReturn = xTimerGenericCommand( xTimer, xCommandID, xOptionalValue, pxHigherPriorityTaskWoken, xTicksToWait );
+                xReturn = 0;
             }
 
-            return xReturn;
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
         }
-    #endif /* if ( configUSE_TIMERS == 1 ) */
+        else
+        {
+            xReturn = xStreamBufferNextMessageLengthBytes( xStreamBuffer );
+        }
+
+        return xReturn;
+    }
 /*-----------------------------------------------------------*/
 
-    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-        EventGroupHandle_t MPU_xEventGroupCreate( void ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+        BaseType_t MPU_xStreamBufferSetMessageLifetime( StreamBufferHandle_t xStreamBuffer,
+                                                        TickType_t xLifetime ) /* FREERTOS_SYSTEM_CALL */
         {
-            EventGroupHandle_t xReturn;
+            BaseType_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xEventGroupCreate();
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+                {
+                    xReturn = xStreamBufferSetMessageLifetime( xStreamBuffer, xLifetime );
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -1990,25 +4298,36 @@
             }
             else
             {
-                xReturn = xEventGroupCreate();
+                xReturn = xStreamBufferSetMessageLifetime( xStreamBuffer, xLifetime );
             }
 
             return xReturn;
         }
-    #endif /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+    #endif /* if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 ) */
 /*-----------------------------------------------------------*/
 
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-        EventGroupHandle_t MPU_xEventGroupCreateStatic( StaticEventGroup_t * pxEventGroupBuffer ) /* FREERTOS_SYSTEM_CALL */
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 )
+        size_t MPU_xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
+                                         void * pvRxData,
+                                         size_t xBufferLengthBytes,
+                                         TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
         {
-            EventGroupHandle_t xReturn;
+            size_t xReturn;
 
             if( portIS_PRIVILEGED() == pdFALSE )
             {
                 portRAISE_PRIVILEGE();
                 portMEMORY_BARRIER();
 
-                xReturn = xEventGroupCreateStatic( pxEventGroupBuffer );
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+                {
+                    xReturn = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
+                }
+                else
+                {
+                    xReturn = 0;
+                }
+
                 portMEMORY_BARRIER();
 
                 portRESET_PRIVILEGE();
@@ -2016,28 +4335,37 @@
             }
             else
             {
-                xReturn = xEventGroupCreateStatic( pxEventGroupBuffer );
+                xReturn = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
             }
 
             return xReturn;
         }
-    #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+    #endif /* if ( configUSE_MPU_SYSTEM_CALL_TABLE == 0 ) */
 /*-----------------------------------------------------------*/
 
-    EventBits_t MPU_xEventGroupWaitBits( EventGroupHandle_t xEventGroup,
-                                         const EventBits_t uxBitsToWaitFor,
-                                         const BaseType_t xClearOnExit,
-                                         const BaseType_t xWaitForAllBits,
-                                         TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferReceiveBatch( StreamBufferHandle_t xStreamBuffer,
+                                          void * pvRxData,
+                                          size_t xBufferLengthBytes,
+                                          size_t * const pxMessageLengths,
+                                          size_t xMaxMessages,
+                                          TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
     {
-        EventBits_t xReturn;
+        size_t xReturn;
 
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xEventGroupWaitBits( xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferReceiveBatch( xStreamBuffer, pvRxData, xBufferLengthBytes, pxMessageLengths, xMaxMessages, xTicksToWait );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2045,24 +4373,33 @@
         }
         else
         {
-            xReturn = xEventGroupWaitBits( xEventGroup, uxBitsToWaitFor, xClearOnExit, xWaitForAllBits, xTicksToWait );
+            xReturn = xStreamBufferReceiveBatch( xStreamBuffer, pvRxData, xBufferLengthBytes, pxMessageLengths, xMaxMessages, xTicksToWait );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    EventBits_t MPU_xEventGroupClearBits( EventGroupHandle_t xEventGroup,
-                                          const EventBits_t uxBitsToClear ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+                                  void * pvRxData,
+                                  size_t xBufferLengthBytes ) /* FREERTOS_SYSTEM_CALL */
     {
-        EventBits_t xReturn;
+        size_t xReturn;
 
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xEventGroupClearBits( xEventGroup, uxBitsToClear );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferPeek( xStreamBuffer, pvRxData, xBufferLengthBytes );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2070,24 +4407,32 @@
         }
         else
         {
-            xReturn = xEventGroupClearBits( xEventGroup, uxBitsToClear );
+            xReturn = xStreamBufferPeek( xStreamBuffer, pvRxData, xBufferLengthBytes );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    EventBits_t MPU_xEventGroupSetBits( EventGroupHandle_t xEventGroup,
-                                        const EventBits_t uxBitsToSet ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferSkip( StreamBufferHandle_t xStreamBuffer,
+                                  size_t xBytesToSkip ) /* FREERTOS_SYSTEM_CALL */
     {
-        EventBits_t xReturn;
+        size_t xReturn;
 
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xEventGroupSetBits( xEventGroup, uxBitsToSet );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferSkip( xStreamBuffer, xBytesToSkip );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2095,26 +4440,35 @@
         }
         else
         {
-            xReturn = xEventGroupSetBits( xEventGroup, uxBitsToSet );
+            xReturn = xStreamBufferSkip( xStreamBuffer, xBytesToSkip );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    EventBits_t MPU_xEventGroupSync( EventGroupHandle_t xEventGroup,
-                                     const EventBits_t uxBitsToSet,
-                                     const EventBits_t uxBitsToWaitFor,
-                                     TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferSplice( StreamBufferHandle_t xDestination,
+                                    StreamBufferHandle_t xSource,
+                                    size_t xMaxBytes,
+                                    TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
     {
-        EventBits_t xReturn;
+        size_t xReturn;
 
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xEventGroupSync( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTicksToWait );
+            if( ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xDestination ) == pdTRUE ) &&
+                ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xSource ) == pdTRUE ) )
+            {
+                xReturn = xStreamBufferSplice( xDestination, xSource, xMaxBytes, xTicksToWait );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2122,21 +4476,26 @@
         }
         else
         {
-            xReturn = xEventGroupSync( xEventGroup, uxBitsToSet, uxBitsToWaitFor, xTicksToWait );
+            xReturn = xStreamBufferSplice( xDestination, xSource, xMaxBytes, xTicksToWait );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    void MPU_vEventGroupDelete( EventGroupHandle_t xEventGroup ) /* FREERTOS_SYSTEM_CALL */
+    void MPU_vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
     {
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            vEventGroupDelete( xEventGroup );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                mpuREMOVE_KERNEL_OBJECT( xStreamBuffer );
+                vStreamBufferDelete( xStreamBuffer );
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2144,24 +4503,30 @@
         }
         else
         {
-            vEventGroupDelete( xEventGroup );
+            mpuREMOVE_KERNEL_OBJECT( xStreamBuffer );
+            vStreamBufferDelete( xStreamBuffer );
         }
     }
 /*-----------------------------------------------------------*/
 
-    size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
-                                  const void * pvTxData,
-                                  size_t xDataLengthBytes,
-                                  TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    BaseType_t MPU_xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
     {
-        size_t xReturn;
+        BaseType_t xReturn;
 
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferIsFull( xStreamBuffer );
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2169,23 +4534,31 @@
         }
         else
         {
-            xReturn = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
+            xReturn = xStreamBufferIsFull( xStreamBuffer );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    size_t MPU_xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    BaseType_t MPU_xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
     {
-        size_t xReturn;
+        BaseType_t xReturn;
 
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xStreamBufferNextMessageLengthBytes( xStreamBuffer );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferIsEmpty( xStreamBuffer );
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2193,17 +4566,46 @@
         }
         else
         {
-            xReturn = xStreamBufferNextMessageLengthBytes( xStreamBuffer );
+            xReturn = xStreamBufferIsEmpty( xStreamBuffer );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t MPU_xStreamBufferReset( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    {
+        BaseType_t xReturn;
+
+        if( portIS_PRIVILEGED() == pdFALSE )
+        {
+            portRAISE_PRIVILEGE();
+            portMEMORY_BARRIER();
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferReset( xStreamBuffer );
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+
+            portMEMORY_BARRIER();
+
+            portRESET_PRIVILEGE();
+            portMEMORY_BARRIER();
+        }
+        else
+        {
+            xReturn = xStreamBufferReset( xStreamBuffer );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    size_t MPU_xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
-                                     void * pvRxData,
-                                     size_t xBufferLengthBytes,
-                                     TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
     {
         size_t xReturn;
 
@@ -2212,7 +4614,15 @@
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferSpacesAvailable( xStreamBuffer );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2220,21 +4630,31 @@
         }
         else
         {
-            xReturn = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
+            xReturn = xStreamBufferSpacesAvailable( xStreamBuffer );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    void MPU_vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
     {
+        size_t xReturn;
+
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            vStreamBufferDelete( xStreamBuffer );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferBytesAvailable( xStreamBuffer );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2242,12 +4662,15 @@
         }
         else
         {
-            vStreamBufferDelete( xStreamBuffer );
+            xReturn = xStreamBufferBytesAvailable( xStreamBuffer );
         }
+
+        return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    BaseType_t MPU_xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    BaseType_t MPU_xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
+                                                 size_t xTriggerLevel ) /* FREERTOS_SYSTEM_CALL */
     {
         BaseType_t xReturn;
 
@@ -2256,7 +4679,15 @@
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xStreamBufferIsFull( xStreamBuffer );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferSetTriggerLevel( xStreamBuffer, xTriggerLevel );
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2264,14 +4695,15 @@
         }
         else
         {
-            xReturn = xStreamBufferIsFull( xStreamBuffer );
+            xReturn = xStreamBufferSetTriggerLevel( xStreamBuffer, xTriggerLevel );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    BaseType_t MPU_xStreamBufferIsEmpty( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    BaseType_t MPU_xStreamBufferSetSendTriggerLevel( StreamBufferHandle_t xStreamBuffer,
+                                                     size_t xTriggerLevel ) /* FREERTOS_SYSTEM_CALL */
     {
         BaseType_t xReturn;
 
@@ -2280,7 +4712,15 @@
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xStreamBufferIsEmpty( xStreamBuffer );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferSetSendTriggerLevel( xStreamBuffer, xTriggerLevel );
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2288,23 +4728,33 @@
         }
         else
         {
-            xReturn = xStreamBufferIsEmpty( xStreamBuffer );
+            xReturn = xStreamBufferSetSendTriggerLevel( xStreamBuffer, xTriggerLevel );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    BaseType_t MPU_xStreamBufferReset( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                          uint8_t ** ppucData,
+                                          TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
     {
-        BaseType_t xReturn;
+        size_t xReturn;
 
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xStreamBufferReset( xStreamBuffer );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferAcquireWrite( xStreamBuffer, ppucData, xTicksToWait );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2312,22 +4762,32 @@
         }
         else
         {
-            xReturn = xStreamBufferReset( xStreamBuffer );
+            xReturn = xStreamBufferAcquireWrite( xStreamBuffer, ppucData, xTicksToWait );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    size_t MPU_xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    BaseType_t MPU_xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                             size_t xBytesWritten ) /* FREERTOS_SYSTEM_CALL */
     {
-        size_t xReturn;
+        BaseType_t xReturn;
 
         if( portIS_PRIVILEGED() == pdFALSE )
         {
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
-            xReturn = xStreamBufferSpacesAvailable( xStreamBuffer );
+
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferCommitWrite( xStreamBuffer, xBytesWritten );
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2335,14 +4795,16 @@
         }
         else
         {
-            xReturn = xStreamBufferSpacesAvailable( xStreamBuffer );
+            xReturn = xStreamBufferCommitWrite( xStreamBuffer, xBytesWritten );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    size_t MPU_xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+    size_t MPU_xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                         uint8_t ** ppucData,
+                                         TickType_t xTicksToWait ) /* FREERTOS_SYSTEM_CALL */
     {
         size_t xReturn;
 
@@ -2351,7 +4813,15 @@
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xStreamBufferBytesAvailable( xStreamBuffer );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferAcquireRead( xStreamBuffer, ppucData, xTicksToWait );
+            }
+            else
+            {
+                xReturn = 0;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2359,15 +4829,15 @@
         }
         else
         {
-            xReturn = xStreamBufferBytesAvailable( xStreamBuffer );
+            xReturn = xStreamBufferAcquireRead( xStreamBuffer, ppucData, xTicksToWait );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
-    BaseType_t MPU_xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
-                                                 size_t xTriggerLevel ) /* FREERTOS_SYSTEM_CALL */
+    BaseType_t MPU_xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+                                             size_t xBytesRead ) /* FREERTOS_SYSTEM_CALL */
     {
         BaseType_t xReturn;
 
@@ -2376,7 +4846,15 @@
             portRAISE_PRIVILEGE();
             portMEMORY_BARRIER();
 
-            xReturn = xStreamBufferSetTriggerLevel( xStreamBuffer, xTriggerLevel );
+            if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+            {
+                xReturn = xStreamBufferReleaseRead( xStreamBuffer, xBytesRead );
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+
             portMEMORY_BARRIER();
 
             portRESET_PRIVILEGE();
@@ -2384,17 +4862,70 @@
         }
         else
         {
-            xReturn = xStreamBufferSetTriggerLevel( xStreamBuffer, xTriggerLevel );
+            xReturn = xStreamBufferReleaseRead( xStreamBuffer, xBytesRead );
         }
 
         return xReturn;
     }
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        void MPU_vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer,
+                                        StreamBufferStats_t * pxStreamBufferStats ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+                {
+                    vStreamBufferGetStats( xStreamBuffer, pxStreamBufferStats );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vStreamBufferGetStats( xStreamBuffer, pxStreamBufferStats );
+            }
+        }
+    #endif /* if ( configUSE_STREAM_BUFFER_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        void MPU_vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer ) /* FREERTOS_SYSTEM_CALL */
+        {
+            if( portIS_PRIVILEGED() == pdFALSE )
+            {
+                portRAISE_PRIVILEGE();
+                portMEMORY_BARRIER();
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE )
+                {
+                    vStreamBufferResetStats( xStreamBuffer );
+                }
+
+                portMEMORY_BARRIER();
+
+                portRESET_PRIVILEGE();
+                portMEMORY_BARRIER();
+            }
+            else
+            {
+                vStreamBufferResetStats( xStreamBuffer );
+            }
+        }
+    #endif /* if ( configUSE_STREAM_BUFFER_STATS == 1 ) */
+/*-----------------------------------------------------------*/
+
     #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
         StreamBufferHandle_t MPU_xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                              size_t xTriggerLevelBytes,
-                                                             BaseType_t xIsMessageBuffer,
+                                                             BaseType_t xStreamBufferType,
                                                              StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                                              StreamBufferCallbackFunction_t pxReceiveCompletedCallback ) /* FREERTOS_SYSTEM_CALL */
         {
@@ -2417,9 +4948,10 @@
 
                     xReturn = xStreamBufferGenericCreate( xBufferSizeBytes,
                                                           xTriggerLevelBytes,
-                                                          xIsMessageBuffer,
+                                                          xStreamBufferType,
                                                           NULL,
                                                           NULL );
+                    mpuGRANT_CALLING_TASK_ACCESS( xReturn );
                     portMEMORY_BARRIER();
 
                     portRESET_PRIVILEGE();
@@ -2429,14 +4961,14 @@
                 {
                     xReturn = xStreamBufferGenericCreate( xBufferSizeBytes,
                                                           xTriggerLevelBytes,
-                                                          xIsMessageBuffer,
+                                                          xStreamBufferType,
                                                           NULL,
                                                           NULL );
                 }
             }
             else
             {
-                traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+                traceSTREAM_BUFFER_CREATE_FAILED( xStreamBufferType );
                 xReturn = NULL;
             }
 
@@ -2448,7 +4980,7 @@
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
         StreamBufferHandle_t MPU_xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
                                                                    size_t xTriggerLevelBytes,
-                                                                   BaseType_t xIsMessageBuffer,
+                                                                   BaseType_t xStreamBufferType,
                                                                    uint8_t * const pucStreamBufferStorageArea,
                                                                    StaticStreamBuffer_t * const pxStaticStreamBuffer,
                                                                    StreamBufferCallbackFunction_t pxSendCompletedCallback,
@@ -2473,11 +5005,12 @@
 
                     xReturn = xStreamBufferGenericCreateStatic( xBufferSizeBytes,
                                                                 xTriggerLevelBytes,
-                                                                xIsMessageBuffer,
+                                                                xStreamBufferType,
                                                                 pucStreamBufferStorageArea,
                                                                 pxStaticStreamBuffer,
                                                                 NULL,
                                                                 NULL );
+                    mpuGRANT_CALLING_TASK_ACCESS( xReturn );
                     portMEMORY_BARRIER();
 
                     portRESET_PRIVILEGE();
@@ -2487,7 +5020,7 @@
                 {
                     xReturn = xStreamBufferGenericCreateStatic( xBufferSizeBytes,
                                                                 xTriggerLevelBytes,
-                                                                xIsMessageBuffer,
+                                                                xStreamBufferType,
                                                                 pucStreamBufferStorageArea,
                                                                 pxStaticStreamBuffer,
                                                                 NULL,
@@ -2496,7 +5029,7 @@
             }
             else
             {
-                traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xIsMessageBuffer );
+                traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xStreamBufferType );
                 xReturn = NULL;
             }
 
@@ -2505,6 +5038,343 @@
     #endif /* configSUPPORT_STATIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 )
+
+/* With configUSE_MPU_SYSTEM_CALL_TABLE set to 1 the most frequently used
+ * wrappers make a single SVC that the port dispatches through
+ * uxSystemCallImplementations[] below, rather than raising and then resetting
+ * the privilege level around a direct call.  Functions that are passed a
+ * buffer are dispatched to an implementation that first checks the calling
+ * task is allowed to access that buffer. */
+
+        static BaseType_t MPU_xTaskDelayUntilImpl( TickType_t * const pxPreviousWakeTime,
+                                                   TickType_t xTimeIncrement ) PRIVILEGED_FUNCTION;
+        static BaseType_t MPU_xQueueGenericSendImpl( QueueHandle_t xQueue,
+                                                     const void * const pvItemToQueue,
+                                                     TickType_t xTicksToWait,
+                                                     BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+        static BaseType_t MPU_xQueueReceiveImpl( QueueHandle_t pxQueue,
+                                                 void * const pvBuffer,
+                                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+        static BaseType_t MPU_xQueuePeekImpl( QueueHandle_t xQueue,
+                                              void * const pvBuffer,
+                                              TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+        static size_t MPU_xStreamBufferSendImpl( StreamBufferHandle_t xStreamBuffer,
+                                                 const void * pvTxData,
+                                                 size_t xDataLengthBytes,
+                                                 TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+        static size_t MPU_xStreamBufferReceiveImpl( StreamBufferHandle_t xStreamBuffer,
+                                                    void * pvRxData,
+                                                    size_t xBufferLengthBytes,
+                                                    TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+        #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+            static BaseType_t MPU_xQueueSemaphoreTakeImpl( QueueHandle_t xQueue,
+                                                           TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+            static UBaseType_t MPU_uxQueueMessagesWaitingImpl( const QueueHandle_t pxQueue ) PRIVILEGED_FUNCTION;
+            static EventBits_t MPU_xEventGroupSetBitsImpl( EventGroupHandle_t xEventGroup,
+                                                           const EventBits_t uxBitsToSet ) PRIVILEGED_FUNCTION;
+        #endif /* #if ( configENABLE_ACCESS_CONTROL_LIST == 1 ) */
+
+        TickType_t MPU_xTaskGetTickCount( void ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+        BaseType_t MPU_xQueueGenericSend( QueueHandle_t xQueue,
+                                          const void * const pvItemToQueue,
+                                          TickType_t xTicksToWait,
+                                          BaseType_t xCopyPosition ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+        UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t pxQueue ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+        BaseType_t MPU_xQueueReceive( QueueHandle_t pxQueue,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+        BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
+                                   void * const pvBuffer,
+                                   TickType_t xTicksToWait ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+        BaseType_t MPU_xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                            TickType_t xTicksToWait ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+        EventBits_t MPU_xEventGroupSetBits( EventGroupHandle_t xEventGroup,
+                                            const EventBits_t uxBitsToSet ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+        size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
+                                      const void * pvTxData,
+                                      size_t xDataLengthBytes,
+                                      TickType_t xTicksToWait ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+        size_t MPU_xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
+                                         void * pvRxData,
+                                         size_t xBufferLengthBytes,
+                                         TickType_t xTicksToWait ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+/*-----------------------------------------------------------*/
+
+        TickType_t MPU_xTaskGetTickCount( void ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_xTaskGetTickCount, xTaskGetTickCount );
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( INCLUDE_vTaskDelay == 1 )
+            void MPU_vTaskDelay( TickType_t xTicksToDelay ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+
+            void MPU_vTaskDelay( TickType_t xTicksToDelay ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+            {
+                portSYSTEM_CALL( SYSTEM_CALL_vTaskDelay, vTaskDelay );
+            }
+        #endif /* if ( INCLUDE_vTaskDelay == 1 ) */
+/*-----------------------------------------------------------*/
+
+        #if ( INCLUDE_xTaskDelayUntil == 1 )
+            BaseType_t MPU_xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
+                                            TickType_t xTimeIncrement ) __attribute__( ( naked ) ) FREERTOS_SYSTEM_CALL;
+
+            BaseType_t MPU_xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
+                                            TickType_t xTimeIncrement ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+            {
+                portSYSTEM_CALL( SYSTEM_CALL_xTaskDelayUntil, xTaskDelayUntil );
+            }
+/*-----------------------------------------------------------*/
+
+            static BaseType_t MPU_xTaskDelayUntilImpl( TickType_t * const pxPreviousWakeTime,
+                                                       TickType_t xTimeIncrement ) /* PRIVILEGED_FUNCTION */
+            {
+                BaseType_t xReturn = pdFALSE;
+
+                if( xPortIsAuthorizedToAccessBuffer( pxPreviousWakeTime, sizeof( TickType_t ), portMPU_BUFFER_READ | portMPU_BUFFER_WRITE ) == pdTRUE )
+                {
+                    xReturn = xTaskDelayUntil( pxPreviousWakeTime, xTimeIncrement );
+                }
+
+                return xReturn;
+            }
+        #endif /* if ( INCLUDE_xTaskDelayUntil == 1 ) */
+/*-----------------------------------------------------------*/
+
+        BaseType_t MPU_xQueueGenericSend( QueueHandle_t xQueue,
+                                          const void * const pvItemToQueue,
+                                          TickType_t xTicksToWait,
+                                          BaseType_t xCopyPosition ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_xQueueGenericSend, xQueueGenericSend );
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t MPU_xQueueGenericSendImpl( QueueHandle_t xQueue,
+                                                     const void * const pvItemToQueue,
+                                                     TickType_t xTicksToWait,
+                                                     BaseType_t xCopyPosition ) /* PRIVILEGED_FUNCTION */
+        {
+            BaseType_t xReturn = pdFAIL;
+
+            if( ( xQueue != NULL ) &&
+                ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE ) &&
+                ( xPortIsAuthorizedToAccessBuffer( pvItemToQueue, ( uint32_t ) uxQueueGetQueueItemSize( xQueue ), portMPU_BUFFER_READ ) == pdTRUE ) )
+            {
+                xReturn = xQueueGenericSend( xQueue, pvItemToQueue, xTicksToWait, xCopyPosition );
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        UBaseType_t MPU_uxQueueMessagesWaiting( const QueueHandle_t pxQueue ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_uxQueueMessagesWaiting, uxQueueMessagesWaiting );
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+            static UBaseType_t MPU_uxQueueMessagesWaitingImpl( const QueueHandle_t pxQueue ) /* PRIVILEGED_FUNCTION */
+            {
+                UBaseType_t uxReturn = 0;
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( pxQueue ) == pdTRUE )
+                {
+                    uxReturn = uxQueueMessagesWaiting( pxQueue );
+                }
+
+                return uxReturn;
+            }
+        #endif /* #if ( configENABLE_ACCESS_CONTROL_LIST == 1 ) */
+/*-----------------------------------------------------------*/
+
+        BaseType_t MPU_xQueueReceive( QueueHandle_t pxQueue,
+                                      void * const pvBuffer,
+                                      TickType_t xTicksToWait ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_xQueueReceive, xQueueReceive );
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t MPU_xQueueReceiveImpl( QueueHandle_t pxQueue,
+                                                 void * const pvBuffer,
+                                                 TickType_t xTicksToWait ) /* PRIVILEGED_FUNCTION */
+        {
+            BaseType_t xReturn = pdFAIL;
+
+            if( ( pxQueue != NULL ) &&
+                ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( pxQueue ) == pdTRUE ) &&
+                ( xPortIsAuthorizedToAccessBuffer( pvBuffer, ( uint32_t ) uxQueueGetQueueItemSize( pxQueue ), portMPU_BUFFER_WRITE ) == pdTRUE ) )
+            {
+                xReturn = xQueueReceive( pxQueue, pvBuffer, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t MPU_xQueuePeek( QueueHandle_t xQueue,
+                                   void * const pvBuffer,
+                                   TickType_t xTicksToWait ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_xQueuePeek, xQueuePeek );
+        }
+/*-----------------------------------------------------------*/
+
+        static BaseType_t MPU_xQueuePeekImpl( QueueHandle_t xQueue,
+                                              void * const pvBuffer,
+                                              TickType_t xTicksToWait ) /* PRIVILEGED_FUNCTION */
+        {
+            BaseType_t xReturn = pdFAIL;
+
+            if( ( xQueue != NULL ) &&
+                ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE ) &&
+                ( xPortIsAuthorizedToAccessBuffer( pvBuffer, ( uint32_t ) uxQueueGetQueueItemSize( xQueue ), portMPU_BUFFER_WRITE ) == pdTRUE ) )
+            {
+                xReturn = xQueuePeek( xQueue, pvBuffer, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        BaseType_t MPU_xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                            TickType_t xTicksToWait ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_xQueueSemaphoreTake, xQueueSemaphoreTake );
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+            static BaseType_t MPU_xQueueSemaphoreTakeImpl( QueueHandle_t xQueue,
+                                                           TickType_t xTicksToWait ) /* PRIVILEGED_FUNCTION */
+            {
+                BaseType_t xReturn = pdFAIL;
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xQueue ) == pdTRUE )
+                {
+                    xReturn = xQueueSemaphoreTake( xQueue, xTicksToWait );
+                }
+
+                return xReturn;
+            }
+        #endif /* #if ( configENABLE_ACCESS_CONTROL_LIST == 1 ) */
+/*-----------------------------------------------------------*/
+
+        EventBits_t MPU_xEventGroupSetBits( EventGroupHandle_t xEventGroup,
+                                            const EventBits_t uxBitsToSet ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_xEventGroupSetBits, xEventGroupSetBits );
+        }
+/*-----------------------------------------------------------*/
+
+        #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+            static EventBits_t MPU_xEventGroupSetBitsImpl( EventGroupHandle_t xEventGroup,
+                                                           const EventBits_t uxBitsToSet ) /* PRIVILEGED_FUNCTION */
+            {
+                EventBits_t xReturn = 0;
+
+                if( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xEventGroup ) == pdTRUE )
+                {
+                    xReturn = xEventGroupSetBits( xEventGroup, uxBitsToSet );
+                }
+
+                return xReturn;
+            }
+        #endif /* #if ( configENABLE_ACCESS_CONTROL_LIST == 1 ) */
+/*-----------------------------------------------------------*/
+
+        size_t MPU_xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
+                                      const void * pvTxData,
+                                      size_t xDataLengthBytes,
+                                      TickType_t xTicksToWait ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_xStreamBufferSend, xStreamBufferSend );
+        }
+/*-----------------------------------------------------------*/
+
+        static size_t MPU_xStreamBufferSendImpl( StreamBufferHandle_t xStreamBuffer,
+                                                 const void * pvTxData,
+                                                 size_t xDataLengthBytes,
+                                                 TickType_t xTicksToWait ) /* PRIVILEGED_FUNCTION */
+        {
+            size_t xReturn = 0;
+
+            if( ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE ) &&
+                ( xPortIsAuthorizedToAccessBuffer( pvTxData, ( uint32_t ) xDataLengthBytes, portMPU_BUFFER_READ ) == pdTRUE ) )
+            {
+                xReturn = xStreamBufferSend( xStreamBuffer, pvTxData, xDataLengthBytes, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        size_t MPU_xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
+                                         void * pvRxData,
+                                         size_t xBufferLengthBytes,
+                                         TickType_t xTicksToWait ) /* __attribute__ (( naked )) FREERTOS_SYSTEM_CALL */
+        {
+            portSYSTEM_CALL( SYSTEM_CALL_xStreamBufferReceive, xStreamBufferReceive );
+        }
+/*-----------------------------------------------------------*/
+
+        static size_t MPU_xStreamBufferReceiveImpl( StreamBufferHandle_t xStreamBuffer,
+                                                    void * pvRxData,
+                                                    size_t xBufferLengthBytes,
+                                                    TickType_t xTicksToWait ) /* PRIVILEGED_FUNCTION */
+        {
+            size_t xReturn = 0;
+
+            if( ( mpuIS_KERNEL_OBJECT_ACCESSIBLE( xStreamBuffer ) == pdTRUE ) &&
+                ( xPortIsAuthorizedToAccessBuffer( pvRxData, ( uint32_t ) xBufferLengthBytes, portMPU_BUFFER_WRITE ) == pdTRUE ) )
+            {
+                xReturn = xStreamBufferReceive( xStreamBuffer, pvRxData, xBufferLengthBytes, xTicksToWait );
+            }
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+/* The implementations that the port's SVC handler returns into, indexed by
+ * the numbers in mpu_syscall_numbers.h.  Calls that are not passed a buffer go
+ * straight to the API function unless access control lists must be checked.  A NULL entry fails the call. */
+        const UBaseType_t uxSystemCallImplementations[ NUM_SYSTEM_CALLS ] =
+        {
+            ( UBaseType_t ) xTaskGetTickCount,            /* SYSTEM_CALL_xTaskGetTickCount. */
+            #if ( INCLUDE_vTaskDelay == 1 )
+                ( UBaseType_t ) vTaskDelay,               /* SYSTEM_CALL_vTaskDelay. */
+            #else
+                ( UBaseType_t ) 0,
+            #endif
+            #if ( INCLUDE_xTaskDelayUntil == 1 )
+                ( UBaseType_t ) MPU_xTaskDelayUntilImpl,  /* SYSTEM_CALL_xTaskDelayUntil. */
+            #else
+                ( UBaseType_t ) 0,
+            #endif
+            ( UBaseType_t ) MPU_xQueueGenericSendImpl,    /* SYSTEM_CALL_xQueueGenericSend. */
+            ( UBaseType_t ) MPU_xQueueReceiveImpl,        /* SYSTEM_CALL_xQueueReceive. */
+            ( UBaseType_t ) MPU_xQueuePeekImpl,           /* SYSTEM_CALL_xQueuePeek. */
+            #if ( configENABLE_ACCESS_CONTROL_LIST == 1 )
+                ( UBaseType_t ) MPU_xQueueSemaphoreTakeImpl,    /* SYSTEM_CALL_xQueueSemaphoreTake. */
+                ( UBaseType_t ) MPU_uxQueueMessagesWaitingImpl, /* SYSTEM_CALL_uxQueueMessagesWaiting. */
+                ( UBaseType_t ) MPU_xEventGroupSetBitsImpl,     /* SYSTEM_CALL_xEventGroupSetBits. */
+            #else
+                ( UBaseType_t ) xQueueSemaphoreTake,            /* SYSTEM_CALL_xQueueSemaphoreTake. */
+                ( UBaseType_t ) uxQueueMessagesWaiting,         /* SYSTEM_CALL_uxQueueMessagesWaiting. */
+                ( UBaseType_t ) xEventGroupSetBits,             /* SYSTEM_CALL_xEventGroupSetBits. */
+            #endif
+            ( UBaseType_t ) MPU_xStreamBufferSendImpl,    /* SYSTEM_CALL_xStreamBufferSend. */
+            ( UBaseType_t ) MPU_xStreamBufferReceiveImpl  /* SYSTEM_CALL_xStreamBufferReceive. */
+        };
+
+    #endif /* #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 ) */
+/*-----------------------------------------------------------*/
+
 
 /* Functions that the application writer wants to execute in privileged mode
  * can be defined in application_defined_privileged_functions.h.  The functions
@@ -143,23 +143,27 @@ extern void vPortRestoreTaskContext( void );
 
 /*-----------------------------------------------------------*/
 
+/* The variables below hold per core state, so are arrays indexed by core ID,
+each of which has a single element when configNUMBER_OF_CORES is 1.  The
+assembly code indexes them using ullPortCoreIDMask. */
+
 /* A variable is used to keep track of the critical section nesting.  This
 variable has to be stored as part of the task context and must be initialised to
 a non zero value to ensure interrupts don't inadvertently become unmasked before
 the scheduler starts.  As it is stored as part of the task context it will
 automatically be set to 0 when the first task is started. */
-volatile uint64_t ullCriticalNesting = 9999ULL;
+volatile uint64_t ullCriticalNesting[ configNUMBER_OF_CORES ] = { [ 0 ... ( configNUMBER_OF_CORES - 1 ) ] = 9999ULL };
 
 /* Saved as part of the task context.  If ullPortTaskHasFPUContext is non-zero
 then floating point context must be saved and restored for the task. */
-uint64_t ullPortTaskHasFPUContext = pdFALSE;
+uint64_t ullPortTaskHasFPUContext[ configNUMBER_OF_CORES ] = { pdFALSE };
 
 /* Set to 1 to pend a context switch from an ISR. */
-uint64_t ullPortYieldRequired = pdFALSE;
+uint64_t ullPortYieldRequired[ configNUMBER_OF_CORES ] = { pdFALSE };
 
 /* Counts the interrupt nesting depth.  A context switch is only performed if
 if the nesting depth is 0. */
-uint64_t ullPortInterruptNesting = 0;
+uint64_t ullPortInterruptNesting[ configNUMBER_OF_CORES ] = { 0 };
 
 /* Used in the ASM code. */
 __attribute__(( used )) const uint64_t ullICCEOIR = portICCEOIR_END_OF_INTERRUPT_REGISTER_ADDRESS;
@@ -167,6 +171,31 @@ __attribute__(( used )) const uint64_t ullICCIAR = portICCIAR_INTERRUPT_ACKNOWLE
 __attribute__(( used )) const uint64_t ullICCPMR = portICCPMR_PRIORITY_MASK_REGISTER_ADDRESS;
 __attribute__(( used )) const uint64_t ullMaxAPIPriorityMask = ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
 
+#if( configNUMBER_OF_CORES > 1 )
+    /* The current TCB of each core, and the mask that extracts the core ID
+    from MPIDR_EL1. */
+    extern void * volatile pxCurrentTCBs[];
+    __attribute__(( used )) void * volatile * const pxPortCurrentTCBs = pxCurrentTCBs;
+    __attribute__(( used )) const uint64_t ullPortCoreIDMask = 0xFFULL;
+
+    /* The SGI that makes a core yield.  The IRQ handler handles it without
+    calling vApplicationIRQHandler(). */
+    __attribute__(( used )) const uint64_t ullPortYieldCoreSGIID = configYIELD_CORE_SGI_ID;
+
+    /* Interrupt stacks for the secondary cores, used from
+    vPortSecondaryCoreEntry().  Core 0 continues to use the stack main() was
+    using. */
+    __attribute__(( used, aligned( 16 ) )) StackType_t xPortSecondaryCoreStacks[ configNUMBER_OF_CORES - 1 ][ configSECONDARY_CORE_STACK_SIZE_WORDS ];
+    __attribute__(( used )) const uint64_t ullPortSecondaryCoreStackSize = sizeof( xPortSecondaryCoreStacks[ 0 ] );
+#else
+    extern void * volatile pxCurrentTCB;
+    __attribute__(( used )) void * volatile * const pxPortCurrentTCBs = &pxCurrentTCB;
+    __attribute__(( used )) const uint64_t ullPortCoreIDMask = 0ULL;
+
+    /* Not a valid interrupt ID, so never matches. */
+    __attribute__(( used )) const uint64_t ullPortYieldCoreSGIID = 0xFFFFFFFFULL;
+#endif /* configNUMBER_OF_CORES */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -264,6 +293,177 @@ StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t px
 }
 /*-----------------------------------------------------------*/
 
+#if( configNUMBER_OF_CORES > 1 )
+
+    /* Distributor registers used to send and configure the yield SGI.  The
+    priority and enable registers for SGIs are banked per core. */
+    #define portGICD_ISENABLER0                 ( *( ( volatile uint32_t * ) ( configINTERRUPT_CONTROLLER_BASE_ADDRESS + 0x100UL ) ) )
+    #define portGICD_SGIR                       ( *( ( volatile uint32_t * ) ( configINTERRUPT_CONTROLLER_BASE_ADDRESS + 0xF00UL ) ) )
+    #define portGICD_SGIR_TARGET_LIST_SHIFT     16UL
+
+    /* Set when core 0 has started the scheduler, to release the other cores. */
+    static volatile uint64_t ullSchedulerStarted = pdFALSE;
+
+    /* The task and ISR locks.  Both are recursive, so record the owning core
+    and how many times it has taken the lock. */
+    static volatile uint32_t ulLocks[ 2 ] = { 0 };
+    static volatile BaseType_t xLockOwner[ 2 ] = { -1, -1 };
+    static uint32_t ulLockCount[ 2 ] = { 0 };
+
+    static void prvSetupYieldCoreInterrupt( void )
+    {
+    volatile uint8_t * const pucSGIPriorityRegister = ( volatile uint8_t * const ) ( configINTERRUPT_CONTROLLER_BASE_ADDRESS + portINTERRUPT_PRIORITY_REGISTER_OFFSET + configYIELD_CORE_SGI_ID );
+
+        /* The yield SGI uses the kernel, so must run at the same priority as
+        the tick. */
+        *pucSGIPriorityRegister = ( uint8_t ) ( portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+        portGICD_ISENABLER0 = 1UL << configYIELD_CORE_SGI_ID;
+        __asm volatile ( "DSB SY" ::: "memory" );
+    }
+    /*-----------------------------------------------------------*/
+
+    void vPortRecursiveLock( BaseType_t xLockNum, BaseType_t xAcquire )
+    {
+    const BaseType_t xCoreID = portGET_CORE_ID();
+    uint32_t ulStatus;
+
+        /* Called with interrupts masked, so the owner cannot change to or
+        from this core while it is being checked. */
+        if( xAcquire != pdFALSE )
+        {
+            if( xLockOwner[ xLockNum ] != xCoreID )
+            {
+                /* Wait for the lock to be free, sleeping in WFE until the
+                store that releases it clears this core's exclusive monitor,
+                then claim it with a store exclusive. */
+                __asm volatile (
+                    "   SEVL                    \n"
+                    "1: WFE                     \n"
+                    "2: LDAXR   %w0, [%1]       \n"
+                    "   CBNZ    %w0, 1b         \n"
+                    "   STXR    %w0, %w2, [%1]  \n"
+                    "   CBNZ    %w0, 2b         \n"
+                    : "=&r" ( ulStatus )
+                    : "r" ( &( ulLocks[ xLockNum ] ) ), "r" ( 1UL )
+                    : "memory"
+                );
+
+                xLockOwner[ xLockNum ] = xCoreID;
+            }
+
+            ulLockCount[ xLockNum ]++;
+        }
+        else
+        {
+            configASSERT( xLockOwner[ xLockNum ] == xCoreID );
+            configASSERT( ulLockCount[ xLockNum ] > 0UL );
+
+            ulLockCount[ xLockNum ]--;
+
+            if( ulLockCount[ xLockNum ] == 0UL )
+            {
+                xLockOwner[ xLockNum ] = -1;
+
+                /* Store-release, so all writes made while holding the lock are
+                visible before it is seen as free. */
+                __asm volatile ( "STLR %w0, [%1]" :: "r" ( 0UL ), "r" ( &( ulLocks[ xLockNum ] ) ) : "memory" );
+            }
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    void vPortGetSpinlock( volatile uint32_t *pulLock )
+    {
+    uint32_t ulStatus;
+
+        /* As vPortRecursiveLock(), but the lock is not recursive so the owner
+        is not recorded. */
+        __asm volatile (
+            "   SEVL                    \n"
+            "1: WFE                     \n"
+            "2: LDAXR   %w0, [%1]       \n"
+            "   CBNZ    %w0, 1b         \n"
+            "   STXR    %w0, %w2, [%1]  \n"
+            "   CBNZ    %w0, 2b         \n"
+            : "=&r" ( ulStatus )
+            : "r" ( pulLock ), "r" ( 1UL )
+            : "memory"
+        );
+    }
+    /*-----------------------------------------------------------*/
+
+    void vPortReleaseSpinlock( volatile uint32_t *pulLock )
+    {
+        configASSERT( *pulLock != 0UL );
+        __asm volatile ( "STLR %w0, [%1]" :: "r" ( 0UL ), "r" ( pulLock ) : "memory" );
+    }
+    /*-----------------------------------------------------------*/
+
+    void vPortWaitForInterrupt( void )
+    {
+    uint32_t ulMaskValue;
+
+        /* Interrupts masked by the ICCPMR are not signalled to the core so
+        would not end the WFI.  Mask them in the core instead while waiting, so
+        a pending interrupt ends the WFI but is not taken until the caller
+        unmasks interrupts again. */
+        portDISABLE_INTERRUPTS();
+        ulMaskValue = portICCPMR_PRIORITY_MASK_REGISTER;
+        portICCPMR_PRIORITY_MASK_REGISTER = portUNMASK_VALUE;
+        __asm volatile (    "DSB SY     \n"
+                            "ISB SY     \n"
+                            "WFI        \n" ::: "memory" );
+        portICCPMR_PRIORITY_MASK_REGISTER = ulMaskValue;
+        __asm volatile (    "DSB SY     \n"
+                            "ISB SY     \n" ::: "memory" );
+        portENABLE_INTERRUPTS();
+    }
+    /*-----------------------------------------------------------*/
+
+    void vPortYieldCore( BaseType_t xCoreID )
+    {
+        if( xCoreID == portGET_CORE_ID() )
+        {
+            if( ullPortInterruptNesting[ xCoreID ] == 0 )
+            {
+                portYIELD();
+            }
+            else
+            {
+                ullPortYieldRequired[ xCoreID ] = pdTRUE;
+            }
+        }
+        else
+        {
+            /* Make the scheduler's updates visible before the other core
+            handles the interrupt. */
+            __asm volatile ( "DSB SY" ::: "memory" );
+            portGICD_SGIR = ( 1UL << ( portGICD_SGIR_TARGET_LIST_SHIFT + ( uint32_t ) xCoreID ) ) | configYIELD_CORE_SGI_ID;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    /* Called from vPortSecondaryCoreEntry() once the core's interrupt stack is
+    set up. */
+    void vPortStartSecondaryCore( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        /* Wait for core 0 to start the scheduler. */
+        while( __atomic_load_n( &ullSchedulerStarted, __ATOMIC_ACQUIRE ) == pdFALSE )
+        {
+            __asm volatile ( "WFE" ::: "memory" );
+        }
+
+        prvSetupYieldCoreInterrupt();
+
+        /* Start the idle task the kernel assigned to this core. */
+        vPortRestoreTaskContext();
+    }
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 BaseType_t xPortStartScheduler( void )
 {
 uint32_t ulAPSR;
@@ -334,6 +534,22 @@ uint32_t ulAPSR;
             /* Start the timer that generates the tick ISR. */
             configSETUP_TICK_INTERRUPT();
 
+            #if( configNUMBER_OF_CORES > 1 )
+            {
+                /* The tick interrupt is only taken by core 0, and the
+                scheduler must be started from core 0. */
+                configASSERT( portGET_CORE_ID() == 0 );
+
+                prvSetupYieldCoreInterrupt();
+
+                /* Release the other cores, which are waiting in
+                vPortStartSecondaryCore(). */
+                __atomic_store_n( &ullSchedulerStarted, pdTRUE, __ATOMIC_RELEASE );
+                __asm volatile ( "DSB SY    \n"
+                                 "SEV       \n" ::: "memory" );
+            }
+            #endif /* configNUMBER_OF_CORES */
+
             /* Start the first task executing. */
             vPortRestoreTaskContext();
         }
@@ -347,7 +563,7 @@ void vPortEndScheduler( void )
 {
     /* Not implemented in ports where there is nothing to return to.
     Artificially force an assert. */
-    configASSERT( ullCriticalNesting == 1000ULL );
+    configASSERT( ullCriticalNesting[ 0 ] == 1000ULL );
 }
 /*-----------------------------------------------------------*/
 
@@ -359,31 +575,31 @@ void vPortEnterCritical( void )
     /* Now interrupts are disabled ullCriticalNesting can be accessed
     directly.  Increment ullCriticalNesting to keep a count of how many times
     portENTER_CRITICAL() has been called. */
-    ullCriticalNesting++;
+    ullCriticalNesting[ 0 ]++;
 
     /* This is not the interrupt safe version of the enter critical function so
     assert() if it is being called from an interrupt context.  Only API
     functions that end in "FromISR" can be used in an interrupt.  Only assert if
     the critical nesting count is 1 to protect against recursive calls if the
     assert function also uses a critical section. */
-    if( ullCriticalNesting == 1ULL )
+    if( ullCriticalNesting[ 0 ] == 1ULL )
     {
-        configASSERT( ullPortInterruptNesting == 0 );
+        configASSERT( ullPortInterruptNesting[ 0 ] == 0 );
     }
 }
 /*-----------------------------------------------------------*/
 
 void vPortExitCritical( void )
 {
-    if( ullCriticalNesting > portNO_CRITICAL_NESTING )
+    if( ullCriticalNesting[ 0 ] > portNO_CRITICAL_NESTING )
     {
         /* Decrement the nesting count as the critical section is being
         exited. */
-        ullCriticalNesting--;
+        ullCriticalNesting[ 0 ]--;
 
         /* If the nesting level has reached zero then all interrupt
         priorities must be re-enabled. */
-        if( ullCriticalNesting == portNO_CRITICAL_NESTING )
+        if( ullCriticalNesting[ 0 ] == portNO_CRITICAL_NESTING )
         {
             /* Critical nesting has reached zero so all interrupt priorities
             should be unmasked. */
@@ -428,7 +644,7 @@ void FreeRTOS_Tick_Handler( void )
     /* Increment the RTOS tick. */
     if( xTaskIncrementTick() != pdFALSE )
     {
-        ullPortYieldRequired = pdTRUE;
+        portPER_CORE_VARIABLE( ullPortYieldRequired ) = pdTRUE;
     }
 
     /* Ensure all interrupt priorities are active again. */
@@ -440,7 +656,7 @@ void vPortTaskUsesFPU( void )
 {
     /* A task is registering the fact that it needs an FPU context.  Set the
     FPU flag (which is saved as part of the task context). */
-    ullPortTaskHasFPUContext = pdTRUE;
+    portPER_CORE_VARIABLE( ullPortTaskHasFPUContext ) = pdTRUE;
 
     /* Consider initialising the FPSR here - but probably not necessary in
     AArch64. */
@@ -73,16 +73,85 @@ not need to be guarded with a critical section. */
 
 /*-----------------------------------------------------------*/
 
+/* Symmetric multiprocessing.  Set configNUMBER_OF_CORES to the number of
+cores in the cluster to run one kernel image across all of them.  The core that
+calls vTaskStartScheduler() must be core 0, and the startup code must release
+the other cores into vPortSecondaryCoreEntry() with their MMU and caches
+enabled, so the spinlocks below are coherent.  The core ID is the affinity level
+0 field of MPIDR_EL1, which must also be the core's GIC CPU interface number.
+Other cores are made to yield by sending them the software generated interrupt
+(SGI) configYIELD_CORE_SGI_ID. */
+#if defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 )
+
+    #ifndef configYIELD_CORE_SGI_ID
+        #define configYIELD_CORE_SGI_ID                 0
+    #endif
+
+    /* Size of the stack each secondary core uses for interrupts. */
+    #ifndef configSECONDARY_CORE_STACK_SIZE_WORDS
+        #define configSECONDARY_CORE_STACK_SIZE_WORDS   1024
+    #endif
+
+    /* Per core state, indexed by core ID. */
+    extern volatile uint64_t ullCriticalNesting[];
+    extern uint64_t ullPortInterruptNesting[];
+
+    static inline BaseType_t xPortGetCoreID( void )
+    {
+    uint64_t ullMPIDR;
+
+        __asm volatile ( "MRS %0, MPIDR_EL1" : "=r" ( ullMPIDR ) );
+        return ( BaseType_t ) ( ullMPIDR & 0xFFULL );
+    }
+
+    extern void vPortYieldCore( BaseType_t xCoreID );
+    extern void vPortRecursiveLock( BaseType_t xLockNum, BaseType_t xAcquire );
+    extern void vPortSecondaryCoreEntry( void );
+
+    #define portGET_CORE_ID()                       xPortGetCoreID()
+    #define portYIELD_CORE( xCoreID )               vPortYieldCore( xCoreID )
+
+    #define portRTOS_LOCK_TASK                      0
+    #define portRTOS_LOCK_ISR                       1
+    #define portGET_TASK_LOCK()                     vPortRecursiveLock( portRTOS_LOCK_TASK, pdTRUE )
+    #define portRELEASE_TASK_LOCK()                 vPortRecursiveLock( portRTOS_LOCK_TASK, pdFALSE )
+    #define portGET_ISR_LOCK()                      vPortRecursiveLock( portRTOS_LOCK_ISR, pdTRUE )
+    #define portRELEASE_ISR_LOCK()                  vPortRecursiveLock( portRTOS_LOCK_ISR, pdFALSE )
+
+    /* The spinlocks held by queues when configUSE_GRANULAR_LOCKS is 1.  These
+    are not recursive, and are only obtained with interrupts masked. */
+    extern void vPortGetSpinlock( volatile uint32_t *pulLock );
+    extern void vPortReleaseSpinlock( volatile uint32_t *pulLock );
+    #define portSPINLOCK_TYPE                       volatile uint32_t
+    #define portINIT_SPINLOCK( pxLock )             ( *( pxLock ) = 0UL )
+    #define portGET_SPINLOCK( pxLock )              vPortGetSpinlock( pxLock )
+    #define portRELEASE_SPINLOCK( pxLock )          vPortReleaseSpinlock( pxLock )
+
+    /* Halts an idle core when configUSE_TICKLESS_IDLE is not 0. */
+    extern void vPortWaitForInterrupt( void );
+    #define portWAIT_FOR_INTERRUPT()                vPortWaitForInterrupt()
+
+    #define portGET_CRITICAL_NESTING_COUNT()        ( ullCriticalNesting[ portGET_CORE_ID() ] )
+    #define portINCREMENT_CRITICAL_NESTING_COUNT()  ( ullCriticalNesting[ portGET_CORE_ID() ]++ )
+    #define portDECREMENT_CRITICAL_NESTING_COUNT()  ( ullCriticalNesting[ portGET_CORE_ID() ]-- )
+
+    #define portASSERT_IF_IN_ISR()                  configASSERT( ullPortInterruptNesting[ portGET_CORE_ID() ] == 0 )
+
+    #define portPER_CORE_VARIABLE( x )              ( x[ portGET_CORE_ID() ] )
+#else
+    #define portPER_CORE_VARIABLE( x )              ( x[ 0 ] )
+#endif /* configNUMBER_OF_CORES */
+
 /* Task utilities. */
 
 /* Called at the end of an ISR that can cause a context switch. */
 #define portEND_SWITCHING_ISR( xSwitchRequired )\
 {                                               \
-extern uint64_t ullPortYieldRequired;           \
+extern uint64_t ullPortYieldRequired[];         \
                                                 \
     if( xSwitchRequired != pdFALSE )            \
     {                                           \
-        ullPortYieldRequired = pdTRUE;          \
+        portPER_CORE_VARIABLE( ullPortYieldRequired ) = pdTRUE; \
     }                                           \
 }
 
@@ -115,8 +184,17 @@ extern void vPortInstallFreeRTOSVectorTable( void );
 
 /* These macros do not globally disable/enable interrupts.  They do mask off
 interrupts that have a priority below configMAX_API_CALL_INTERRUPT_PRIORITY. */
-#define portENTER_CRITICAL()        vPortEnterCritical();
-#define portEXIT_CRITICAL()         vPortExitCritical();
+#if defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 )
+    /* The kernel's critical sections also take the locks that are shared
+    between the cores. */
+    #define portENTER_CRITICAL()                vTaskEnterCritical()
+    #define portEXIT_CRITICAL()                 vTaskExitCritical()
+    #define portENTER_CRITICAL_FROM_ISR()       vTaskEnterCriticalFromISR()
+    #define portEXIT_CRITICAL_FROM_ISR( x )     vTaskExitCriticalFromISR( x )
+#else
+    #define portENTER_CRITICAL()        vPortEnterCritical();
+    #define portEXIT_CRITICAL()         vPortExitCritical();
+#endif
 #define portSET_INTERRUPT_MASK_FROM_ISR()       uxPortSetInterruptMask()
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)    vPortClearInterruptMask(x)
 
@@ -140,9 +218,14 @@ void vPortTaskUsesFPU( void );
 #define portLOWEST_INTERRUPT_PRIORITY ( ( ( uint32_t ) configUNIQUE_INTERRUPT_PRIORITIES ) - 1UL )
 #define portLOWEST_USABLE_INTERRUPT_PRIORITY ( portLOWEST_INTERRUPT_PRIORITY - 1UL )
 
-/* Architecture specific optimisations. */
+/* Architecture specific optimisations.  The SMP scheduler does not support
+port optimised task selection. */
 #ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
-    #define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+    #if defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 )
+        #define configUSE_PORT_OPTIMISED_TASK_SELECTION 0
+    #else
+        #define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+    #endif
 #endif
 
 #if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
@@ -208,4 +291,8 @@ number of bits implemented by the interrupt controller. */
 
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
+/* The __atomic built-in functions compile to LDAXR/STLXR, so atomic.h does not
+ * need to mask interrupts. */
+#define portHAS_NATIVE_ATOMICS 1
+
 #endif /* PORTMACRO_H */
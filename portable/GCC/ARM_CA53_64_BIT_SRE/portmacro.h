@@ -193,4 +193,8 @@ number of bits implemented by the interrupt controller. */
 
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
+/* The __atomic built-in functions compile to LDAXR/STLXR, so atomic.h does not
+ * need to mask interrupts. */
+#define portHAS_NATIVE_ATOMICS 1
+
 #endif /* PORTMACRO_H */
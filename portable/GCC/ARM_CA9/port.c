@@ -126,11 +126,15 @@ the CPU itself before modifying certain hardware registers. */
     __asm volatile ( "ISB" );
 
 
+/* The ICCPMR value that masks interrupts up to the max API call priority. */
+#define portAPI_PRIORITY_MASK_VALUE     ( ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT ) )
+
 /* Macro to unmask all interrupt priorities. */
 #define portCLEAR_INTERRUPT_MASK()                                  \
 {                                                                   \
     portCPU_IRQ_DISABLE();                                          \
     portICCPMR_PRIORITY_MASK_REGISTER = portUNMASK_VALUE;           \
+    ulPortPriorityMask = portUNMASK_VALUE;                          \
     __asm volatile (    "DSB        \n"                             \
                         "ISB        \n" );                          \
     portCPU_IRQ_ENABLE();                                           \
@@ -187,6 +191,15 @@ static void prvTaskExitError( void );
  */
 void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR ) __attribute__((weak) );
 
+/*
+ * FreeRTOS_FIQ_Handler() in portASM.S calls vApplicationFIQHandler().  This
+ * weak implementation is provided to remove linkage errors when the
+ * application does not use the FIQ path - it should never actually get called
+ * so its implementation contains a call to configASSERT() that will always
+ * fail.
+ */
+void vApplicationFIQHandler( uint32_t ulICCIAR ) __attribute__((weak) );
+
 /*-----------------------------------------------------------*/
 
 /* A variable is used to keep track of the critical section nesting.  This
@@ -207,11 +220,20 @@ volatile uint32_t ulPortYieldRequired = pdFALSE;
 if the nesting depth is 0. */
 volatile uint32_t ulPortInterruptNesting = 0UL;
 
+/* The value last written to ICCPMR.  Reading ICCPMR itself is a slow access
+to the GIC, so ulPortSetInterruptMask() reads this copy instead, and does not
+touch ICCPMR or execute any barriers when interrupts are already masked - as
+they are each time critical sections nest.  Updated wherever ICCPMR is
+written, including by portRESTORE_CONTEXT in portASM.S.  Starts at 0, a value
+it is never compared against, so the first ulPortSetInterruptMask() call
+always writes ICCPMR. */
+volatile uint32_t ulPortPriorityMask = 0UL;
+
 /* Used in the asm file. */
 __attribute__(( used )) const uint32_t ulICCIAR = portICCIAR_INTERRUPT_ACKNOWLEDGE_REGISTER_ADDRESS;
 __attribute__(( used )) const uint32_t ulICCEOIR = portICCEOIR_END_OF_INTERRUPT_REGISTER_ADDRESS;
 __attribute__(( used )) const uint32_t ulICCPMR = portICCPMR_PRIORITY_MASK_REGISTER_ADDRESS;
-__attribute__(( used )) const uint32_t ulMaxAPIPriorityMask = ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+__attribute__(( used )) const uint32_t ulMaxAPIPriorityMask = portAPI_PRIORITY_MASK_VALUE;
 
 /*-----------------------------------------------------------*/
 
@@ -459,7 +481,8 @@ void FreeRTOS_Tick_Handler( void )
     necessary to turn off interrupts in the CPU itself while the ICCPMR is being
     updated. */
     portCPU_IRQ_DISABLE();
-    portICCPMR_PRIORITY_MASK_REGISTER = ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+    portICCPMR_PRIORITY_MASK_REGISTER = portAPI_PRIORITY_MASK_VALUE;
+    ulPortPriorityMask = portAPI_PRIORITY_MASK_VALUE;
     __asm volatile (    "dsb        \n"
                         "isb        \n" ::: "memory" );
     portCPU_IRQ_ENABLE();
@@ -495,7 +518,8 @@ void FreeRTOS_Tick_Handler( void )
 
 void vPortClearInterruptMask( uint32_t ulNewMaskValue )
 {
-    if( ulNewMaskValue == pdFALSE )
+    /* There is nothing to do if interrupts are already unmasked. */
+    if( ( ulNewMaskValue == pdFALSE ) && ( ulPortPriorityMask != portUNMASK_VALUE ) )
     {
         portCLEAR_INTERRUPT_MASK();
     }
@@ -506,22 +530,27 @@ uint32_t ulPortSetInterruptMask( void )
 {
 uint32_t ulReturn;
 
-    /* Interrupt in the CPU must be turned off while the ICCPMR is being
-    updated. */
-    portCPU_IRQ_DISABLE();
-    if( portICCPMR_PRIORITY_MASK_REGISTER == ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT ) )
+    /* If interrupts are already masked then no interrupt that could change
+    the mask can run, so the copy can be checked without turning interrupts
+    off in the CPU, and the mask, and the barriers that make it take effect,
+    are left alone. */
+    if( ulPortPriorityMask == portAPI_PRIORITY_MASK_VALUE )
     {
         /* Interrupts were already masked. */
         ulReturn = pdTRUE;
     }
     else
     {
+        /* Interrupt in the CPU must be turned off while the ICCPMR is being
+        updated. */
+        portCPU_IRQ_DISABLE();
         ulReturn = pdFALSE;
-        portICCPMR_PRIORITY_MASK_REGISTER = ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+        portICCPMR_PRIORITY_MASK_REGISTER = portAPI_PRIORITY_MASK_VALUE;
+        ulPortPriorityMask = portAPI_PRIORITY_MASK_VALUE;
         __asm volatile (    "dsb        \n"
                             "isb        \n" ::: "memory" );
+        portCPU_IRQ_ENABLE();
     }
-    portCPU_IRQ_ENABLE();
 
     return ulReturn;
 }
@@ -568,3 +597,10 @@ void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR )
     ( void ) ulICCIAR;
     configASSERT( ( volatile void * ) NULL );
 }
+/*-----------------------------------------------------------*/
+
+void vApplicationFIQHandler( uint32_t ulICCIAR )
+{
+    ( void ) ulICCIAR;
+    configASSERT( ( volatile void * ) NULL );
+}
@@ -245,6 +245,14 @@
  */
 #define portCONTROL_PRIVILEGED_MASK         ( 1UL << 0UL )
 
+/**
+ * @brief CONTROL register floating point context active bit mask.
+ *
+ * Bit[2] in CONTROL register is set while the floating point and MVE
+ * registers hold state belonging to the current context.
+ */
+#define portCONTROL_FPCA_MASK               ( 1UL << 2UL )
+
 /**
  * @brief Initial CONTROL register values.
  */
@@ -304,13 +312,16 @@ static void prvTaskExitError( void );
     static void prvSetupMPU( void ) PRIVILEGED_FUNCTION;
 #endif /* configENABLE_MPU */
 
-#if ( configENABLE_FPU == 1 )
+#if ( ( configENABLE_FPU == 1 ) || ( configENABLE_MVE == 1 ) )
 
 /**
  * @brief Setup the Floating Point Unit (FPU).
+ *
+ * MVE uses the floating point registers and coprocessor access controls, so
+ * this is also needed when only MVE is enabled.
  */
     static void prvSetupFPU( void ) PRIVILEGED_FUNCTION;
-#endif /* configENABLE_FPU */
+#endif /* configENABLE_FPU || configENABLE_MVE */
 
 /**
  * @brief Setup the timer to generate the tick interrupts.
@@ -352,6 +363,24 @@ void SysTick_Handler( void ) PRIVILEGED_FUNCTION;
  * @brief C part of SVC handler.
  */
 portDONT_DISCARD void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) PRIVILEGED_FUNCTION;
+
+#if ( configENABLE_TRUSTZONE == 1 )
+
+/**
+ * @brief Save the secure context of a task that is switched out while it is
+ * running secure code.  Called from the PendSV handler.
+ */
+    portDONT_DISCARD void vPortSaveSecureContext( SecureContextHandle_t xSecureContextHandle,
+                                                  void * pvTaskHandle ) PRIVILEGED_FUNCTION;
+
+/**
+ * @brief Load the secure context of the task being switched in, unless it is
+ * still loaded from when the task last ran.  If the task has no secure context,
+ * save the one left loaded instead.  Called from the PendSV handler.
+ */
+    portDONT_DISCARD void vPortLoadSecureContext( SecureContextHandle_t xSecureContextHandle,
+                                                  void * pvTaskHandle ) PRIVILEGED_FUNCTION;
+#endif /* configENABLE_TRUSTZONE */
 /*-----------------------------------------------------------*/
 
 /**
@@ -367,6 +396,18 @@ PRIVILEGED_DATA static volatile uint32_t ulCriticalNesting = 0xaaaaaaaaUL;
  * task is using on the secure side.
  */
     PRIVILEGED_DATA portDONT_DISCARD volatile SecureContextHandle_t xSecureContext = portNO_SECURE_CONTEXT;
+
+/**
+ * @brief The secure context that is loaded on the secure side, and the task it
+ * belongs to.  A task that is switched out while running non-secure code leaves
+ * its secure context loaded, as the secure stack pointer is then the same as
+ * when the context was loaded.  The context is saved when any other task is
+ * switched in, including a task without a secure context, so that task faults
+ * if it calls a secure function rather than running on another task's secure
+ * stack.  Switching back to the same task does not cross into the secure side.
+ */
+    PRIVILEGED_DATA static SecureContextHandle_t xLoadedSecureContext = portNO_SECURE_CONTEXT;
+    PRIVILEGED_DATA static void * pvLoadedSecureContextTask = NULL;
 #endif /* configENABLE_TRUSTZONE */
 
 #if ( configUSE_TICKLESS_IDLE == 1 )
@@ -747,7 +788,7 @@ static void prvTaskExitError( void )
 #endif /* configENABLE_MPU */
 /*-----------------------------------------------------------*/
 
-#if ( configENABLE_FPU == 1 )
+#if ( ( configENABLE_FPU == 1 ) || ( configENABLE_MVE == 1 ) )
     static void prvSetupFPU( void ) /* PRIVILEGED_FUNCTION */
     {
         #if ( configENABLE_TRUSTZONE == 1 )
@@ -769,7 +810,24 @@ static void prvTaskExitError( void )
          * LSPEN = 1 ==> Enable lazy context save of FP state. */
         *( portFPCCR ) |= ( portFPCCR_ASPEN_MASK | portFPCCR_LSPEN_MASK );
     }
-#endif /* configENABLE_FPU */
+#endif /* configENABLE_FPU || configENABLE_MVE */
+/*-----------------------------------------------------------*/
+
+#if ( ( configENABLE_FPU == 1 ) || ( configENABLE_MVE == 1 ) )
+    void vPortTaskReleaseFPUContext( void ) /* PRIVILEGED_FUNCTION */
+    {
+        uint32_t ulControl;
+
+        /* Clearing CONTROL.FPCA makes the next exception entry stack a basic
+         * frame, so the PendSV handler also skips s16-s31 when switching the
+         * task out.  Executing a floating point or MVE instruction again sets
+         * FPCA and gives the task a new floating point context. */
+        __asm volatile ( "mrs %0, control" : "=r" ( ulControl ) );
+        ulControl &= ~portCONTROL_FPCA_MASK;
+        __asm volatile ( "msr control, %0" : : "r" ( ulControl ) : "memory" );
+        __asm volatile ( "isb" );
+    }
+#endif /* configENABLE_FPU || configENABLE_MVE */
 /*-----------------------------------------------------------*/
 
 void vPortYield( void ) /* PRIVILEGED_FUNCTION */
@@ -825,6 +883,43 @@ void SysTick_Handler( void ) /* PRIVILEGED_FUNCTION */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configENABLE_TRUSTZONE == 1 )
+    void vPortSaveSecureContext( SecureContextHandle_t xSecureContextHandle,
+                                 void * pvTaskHandle ) /* PRIVILEGED_FUNCTION portDONT_DISCARD */
+    {
+        SecureContext_SaveContext( xSecureContextHandle, pvTaskHandle );
+
+        xLoadedSecureContext = portNO_SECURE_CONTEXT;
+        pvLoadedSecureContextTask = NULL;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortLoadSecureContext( SecureContextHandle_t xSecureContextHandle,
+                                 void * pvTaskHandle ) /* PRIVILEGED_FUNCTION portDONT_DISCARD */
+    {
+        if( ( xSecureContextHandle != xLoadedSecureContext ) || ( pvTaskHandle != pvLoadedSecureContextTask ) )
+        {
+            /* Save the context left loaded by the last task that ran with one.
+             * The secure side only loads a context when none is loaded, and a
+             * task without a secure context must not run with another task's
+             * secure stack. */
+            if( xLoadedSecureContext != portNO_SECURE_CONTEXT )
+            {
+                vPortSaveSecureContext( xLoadedSecureContext, pvLoadedSecureContextTask );
+            }
+
+            if( xSecureContextHandle != portNO_SECURE_CONTEXT )
+            {
+                SecureContext_LoadContext( xSecureContextHandle, pvTaskHandle );
+
+                xLoadedSecureContext = xSecureContextHandle;
+                pvLoadedSecureContextTask = pvTaskHandle;
+            }
+        }
+    }
+#endif /* configENABLE_TRUSTZONE */
+/*-----------------------------------------------------------*/
+
 void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTION portDONT_DISCARD */
 {
     #if ( configENABLE_MPU == 1 )
@@ -866,6 +961,13 @@ void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTIO
                  * vPortAllocateSecureContext function. */
                 ulR0 = pulCallerStackAddress[ 0 ];
 
+                /* The secure side only allocates a context when none is
+                 * loaded, so save any context that is still loaded first. */
+                if( xLoadedSecureContext != portNO_SECURE_CONTEXT )
+                {
+                    vPortSaveSecureContext( xLoadedSecureContext, pvLoadedSecureContextTask );
+                }
+
                 #if ( configENABLE_MPU == 1 )
                 {
                     /* Read the CONTROL register value. */
@@ -886,7 +988,7 @@ void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTIO
                 #endif /* configENABLE_MPU */
 
                 configASSERT( xSecureContext != securecontextINVALID_CONTEXT_ID );
-                SecureContext_LoadContext( xSecureContext, pxCurrentTCB );
+                vPortLoadSecureContext( xSecureContext, pxCurrentTCB );
                 break;
 
             case portSVC_FREE_SECURE_CONTEXT:
@@ -896,6 +998,13 @@ void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTIO
                 ulR0 = pulCallerStackAddress[ 0 ];
                 ulR1 = pulCallerStackAddress[ 1 ];
 
+                /* The secure side only loads a context when none is loaded, so
+                 * a context that is still loaded is saved before it is freed. */
+                if( ( ( SecureContextHandle_t ) ulR1 == xLoadedSecureContext ) && ( ( void * ) ulR0 == pvLoadedSecureContextTask ) )
+                {
+                    vPortSaveSecureContext( xLoadedSecureContext, pvLoadedSecureContextTask );
+                }
+
                 /* Free the secure context. */
                 SecureContext_FreeContext( ( SecureContextHandle_t ) ulR1, ( void * ) ulR0 );
                 break;
@@ -913,12 +1022,12 @@ void vPortSVCHandler_C( uint32_t * pulCallerStackAddress ) /* PRIVILEGED_FUNCTIO
             }
             #endif /* configENABLE_TRUSTZONE */
 
-            #if ( configENABLE_FPU == 1 )
+            #if ( ( configENABLE_FPU == 1 ) || ( configENABLE_MVE == 1 ) )
             {
                 /* Setup the Floating Point Unit (FPU). */
                 prvSetupFPU();
             }
-            #endif /* configENABLE_FPU */
+            #endif /* configENABLE_FPU || configENABLE_MVE */
 
             /* Setup the context of the first task so that the first task starts
              * executing. */
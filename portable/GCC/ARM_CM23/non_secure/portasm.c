@@ -242,8 +242,8 @@ void PendSV_Handler( void ) /* __attribute__ (( naked )) PRIVILEGED_FUNCTION */
     __asm volatile
     (
         "   .syntax unified                                 \n"
-        "   .extern SecureContext_SaveContext               \n"
-        "   .extern SecureContext_LoadContext               \n"
+        "   .extern vPortSaveSecureContext                  \n"
+        "   .extern vPortLoadSecureContext                  \n"
         "                                                   \n"
         "   ldr r3, xSecureContextConst                     \n"/* Read the location of xSecureContext i.e. &( xSecureContext ). */
         "   ldr r0, [r3]                                    \n"/* Read xSecureContext - Value of xSecureContext must be in r0 as it is used as a parameter later. */
@@ -252,12 +252,13 @@ void PendSV_Handler( void ) /* __attribute__ (( naked )) PRIVILEGED_FUNCTION */
         "   mrs r2, psp                                     \n"/* Read PSP in r2. */
         "                                                   \n"
         "   cbz r0, save_ns_context                         \n"/* No secure context to save. */
+        "   mov r3, lr                                      \n"/* r3 = LR/EXC_RETURN. */
+        "   lsls r3, r3, #25                                \n"/* r3 = r3 << 25. Bit[6] of EXC_RETURN is 1 if secure stack was used, 0 if non-secure stack was used to store stack frame. */
+        "   bpl save_ns_context                             \n"/* The task is not running secure code, so its secure context is left loaded - see vPortLoadSecureContext(). */
         "   push {r0-r2, r14}                               \n"
-        "   bl SecureContext_SaveContext                    \n"/* Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
+        "   bl vPortSaveSecureContext                       \n"/* Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
         "   pop {r0-r3}                                     \n"/* LR is now in r3. */
         "   mov lr, r3                                      \n"/* LR = r3. */
-        "   lsls r1, r3, #25                                \n"/* r1 = r3 << 25. Bit[6] of EXC_RETURN is 1 if secure stack was used, 0 if non-secure stack was used to store stack frame. */
-        "   bpl save_ns_context                             \n"/* bpl - branch if positive or zero. If r1 >= 0 ==> Bit[6] in EXC_RETURN is 0 i.e. non-secure stack was used. */
         "   ldr r3, pxCurrentTCBConst                       \n"/* Read the location of pxCurrentTCB i.e. &( pxCurrentTCB ). */
         "   ldr r1, [r3]                                    \n"/* Read pxCurrentTCB. */
         #if ( configENABLE_MPU == 1 )
@@ -366,11 +367,10 @@ void PendSV_Handler( void ) /* __attribute__ (( naked )) PRIVILEGED_FUNCTION */
             "   mov lr, r4                                  \n"/* LR = r4. */
             "   ldr r3, xSecureContextConst                 \n"/* Read the location of xSecureContext i.e. &( xSecureContext ). */
             "   str r0, [r3]                                \n"/* Restore the task's xSecureContext. */
-            "   cbz r0, restore_ns_context                  \n"/* If there is no secure context for the task, restore the non-secure context. */
              "  ldr r3, pxCurrentTCBConst                   \n"/* Read the location of pxCurrentTCB i.e. &( pxCurrentTCB ). */
             "   ldr r1, [r3]                                \n"/* Read pxCurrentTCB. */
             "   push {r2, r4}                               \n"
-            "   bl SecureContext_LoadContext                \n"/* Restore the secure context. Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
+            "   bl vPortLoadSecureContext                   \n"/* Load the secure context of the task, or save the one left loaded if the task has none. Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
             "   pop {r2, r4}                                \n"
             "   mov lr, r4                                  \n"/* LR = r4. */
             "   lsls r1, r4, #25                            \n"/* r1 = r4 << 25. Bit[6] of EXC_RETURN is 1 if secure stack was used, 0 if non-secure stack was used to store stack frame. */
@@ -383,11 +383,10 @@ void PendSV_Handler( void ) /* __attribute__ (( naked )) PRIVILEGED_FUNCTION */
             "   mov lr, r4                                  \n"/* LR = r4. */
             "   ldr r3, xSecureContextConst                 \n"/* Read the location of xSecureContext i.e. &( xSecureContext ). */
             "   str r0, [r3]                                \n"/* Restore the task's xSecureContext. */
-            "   cbz r0, restore_ns_context                  \n"/* If there is no secure context for the task, restore the non-secure context. */
             "   ldr r3, pxCurrentTCBConst                   \n"/* Read the location of pxCurrentTCB i.e. &( pxCurrentTCB ). */
             "   ldr r1, [r3]                                \n"/* Read pxCurrentTCB. */
             "   push {r2, r4}                               \n"
-            "   bl SecureContext_LoadContext                \n"/* Restore the secure context. Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
+            "   bl vPortLoadSecureContext                   \n"/* Load the secure context of the task, or save the one left loaded if the task has none. Params are in r0 and r1. r0 = xSecureContext and r1 = pxCurrentTCB. */
             "   pop {r2, r4}                                \n"
             "   mov lr, r4                                  \n"/* LR = r4. */
             "   lsls r1, r4, #25                            \n"/* r1 = r4 << 25. Bit[6] of EXC_RETURN is 1 if secure stack was used, 0 if non-secure stack was used to store stack frame. */
@@ -50,11 +50,19 @@
  */
 #define portARCH_NAME                       "Cortex-M23"
 #define portDONT_DISCARD                    __attribute__( ( used ) )
+
+/* The __atomic built-in functions compile to LDREX/STREX, so atomic.h does not
+ * need to mask interrupts. */
+#define portHAS_NATIVE_ATOMICS              1
 /*-----------------------------------------------------------*/
 
 #if( configTOTAL_MPU_REGIONS == 16 )
     #error 16 MPU regions are not yet supported for this port.
 #endif
+
+#if( configCHECK_FOR_STACK_OVERFLOW == 3 )
+    #error configCHECK_FOR_STACK_OVERFLOW 3 relies on the PSPLIM stack limit register, which Cortex-M23 does not implement for the non-secure state.
+#endif
 /*-----------------------------------------------------------*/
 
 /**
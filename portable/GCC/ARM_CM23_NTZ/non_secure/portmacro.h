@@ -50,6 +50,10 @@
  */
 #define portARCH_NAME                       "Cortex-M23"
 #define portDONT_DISCARD                    __attribute__( ( used ) )
+
+/* The __atomic built-in functions compile to LDREX/STREX, so atomic.h does not
+ * need to mask interrupts. */
+#define portHAS_NATIVE_ATOMICS              1
 /*-----------------------------------------------------------*/
 
 #if( configTOTAL_MPU_REGIONS == 16 )
@@ -165,12 +165,36 @@
 /* portNOP() is not required by this port. */
     #define portNOP()
 
+/* Used by the kernel's spin-wait loops.  WFE also returns when an interrupt
+ * is taken, so a spinning task still sees notifications sent from interrupts
+ * that do not execute SEV. */
+    #define portWAIT_FOR_EVENT()    __asm volatile ( "wfe" ::: "memory" )
+    #define portSEND_EVENT()        __asm volatile ( "sev" ::: "memory" )
+
+/* Reloads the SysTick after the DVFS governor changes the CPU clock. */
+    #if ( configUSE_DVFS_GOVERNOR == 1 )
+        extern void vPortSetCPUClockHz( uint32_t ulCPUClockHz );
+        #define portCPU_CLOCK_CHANGED( ulCPUClockHz )    vPortSetCPUClockHz( ulCPUClockHz )
+    #endif
+
+/* Stack pool guard regions.  On each context switch one MPU region is moved
+ * to the guard next to the stack of the task being switched in and made
+ * inaccessible, so overflowing a stack pool stack causes a MemManage fault.
+ * The core must implement the MPU, or configSTACK_POOL_GUARDS must be 0. */
+    #define portSTACK_GUARD_SIZE    32
+    extern void vPortSetStackGuard( void * pvGuard );
+    #define portSET_STACK_GUARD( pvGuard )    vPortSetStackGuard( pvGuard )
+
     #define portINLINE              __inline
 
     #ifndef portFORCE_INLINE
         #define portFORCE_INLINE    inline __attribute__( ( always_inline ) )
     #endif
 
+/* The __atomic built-in functions compile to LDREX/STREX, so atomic.h does not
+ * need to mask interrupts. */
+    #define portHAS_NATIVE_ATOMICS    1
+
 /*-----------------------------------------------------------*/
 
     portFORCE_INLINE static BaseType_t xPortIsInsideInterrupt( void )
@@ -240,6 +264,44 @@
     }
 /*-----------------------------------------------------------*/
 
+/* Cycle counter, read by the cycle benchmark (configUSE_CYCLE_BENCHMARK).  The
+ * DWT cycle counter is optional in ARMv7-M, so it is only started on parts that
+ * implement it.  Elsewhere portGET_CYCLE_COUNT() reads 0. */
+    #define portDEMCR_REG                    ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+    #define portDEMCR_TRCENA_BIT             ( 1UL << 24UL )
+    #define portDWT_CTRL_REG                 ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+    #define portDWT_CYCCNT_REG               ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+    #define portDWT_CTRL_NOCYCCNT_BIT        ( 1UL << 25UL )
+    #define portDWT_CTRL_CYCCNTENA_BIT       ( 1UL << 0UL )
+
+    #define portENABLE_CYCLE_COUNTER()                                          \
+    do {                                                                        \
+        portDEMCR_REG |= portDEMCR_TRCENA_BIT;                                  \
+        if( ( portDWT_CTRL_REG & portDWT_CTRL_NOCYCCNT_BIT ) == 0UL )           \
+        {                                                                       \
+            portDWT_CYCCNT_REG = 0UL;                                           \
+            portDWT_CTRL_REG |= portDWT_CTRL_CYCCNTENA_BIT;                     \
+        }                                                                       \
+    } while( 0 )
+
+    #define portGET_CYCLE_COUNT()    ( portDWT_CYCCNT_REG )
+/*-----------------------------------------------------------*/
+
+/* ITM stimulus port access, used by the trace recorder's ITM transport
+ * (configTRACE_RECORDER_TRANSPORT).  The ITM and the port must have been
+ * enabled, normally by the debugger capturing the SWO output, for a write to
+ * go anywhere, and a port only accepts a write while its FIFO is ready. */
+    #define portITM_TCR_REG                       ( *( ( volatile uint32_t * ) 0xe0000e80 ) )
+    #define portITM_TER_REG                       ( *( ( volatile uint32_t * ) 0xe0000e00 ) )
+    #define portITM_TCR_ITMENA_BIT                ( 1UL << 0UL )
+    #define portITM_STIM_REG( ulPort )            ( *( ( volatile uint32_t * ) ( 0xe0000000UL + ( 4UL * ( uint32_t ) ( ulPort ) ) ) ) )
+    #define portITM_STIM_FIFOREADY_BIT            ( 1UL << 0UL )
+
+    #define portITM_PORT_ENABLED( ulPort )        ( ( ( portITM_TCR_REG & portITM_TCR_ITMENA_BIT ) != 0UL ) && ( ( portITM_TER_REG & ( 1UL << ( ulPort ) ) ) != 0UL ) )
+    #define portITM_PORT_READY( ulPort )          ( ( portITM_STIM_REG( ulPort ) & portITM_STIM_FIFOREADY_BIT ) != 0UL )
+    #define portITM_PORT_WRITE( ulPort, ulWord )  ( portITM_STIM_REG( ulPort ) = ( ulWord ) )
+/*-----------------------------------------------------------*/
+
     #define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
 
     #ifdef __cplusplus
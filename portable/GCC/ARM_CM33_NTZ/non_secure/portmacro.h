@@ -50,6 +50,10 @@
  */
 #define portARCH_NAME                       "Cortex-M33"
 #define portDONT_DISCARD                    __attribute__( ( used ) )
+
+/* The __atomic built-in functions compile to LDREX/STREX, so atomic.h does not
+ * need to mask interrupts. */
+#define portHAS_NATIVE_ATOMICS              1
 /*-----------------------------------------------------------*/
 
 /**
@@ -59,6 +63,21 @@
 #define portENABLE_INTERRUPTS()             vClearInterruptMask( 0 )
 /*-----------------------------------------------------------*/
 
+/* ITM stimulus port access, used by the trace recorder's ITM transport
+ * (configTRACE_RECORDER_TRANSPORT).  The ITM and the port must have been
+ * enabled, normally by the debugger capturing the SWO output, for a write to
+ * go anywhere, and a port only accepts a write while its FIFO is ready. */
+#define portITM_TCR_REG                       ( *( ( volatile uint32_t * ) 0xe0000e80 ) )
+#define portITM_TER_REG                       ( *( ( volatile uint32_t * ) 0xe0000e00 ) )
+#define portITM_TCR_ITMENA_BIT                ( 1UL << 0UL )
+#define portITM_STIM_REG( ulPort )            ( *( ( volatile uint32_t * ) ( 0xe0000000UL + ( 4UL * ( uint32_t ) ( ulPort ) ) ) ) )
+#define portITM_STIM_FIFOREADY_BIT            ( 1UL << 0UL )
+
+#define portITM_PORT_ENABLED( ulPort )        ( ( ( portITM_TCR_REG & portITM_TCR_ITMENA_BIT ) != 0UL ) && ( ( portITM_TER_REG & ( 1UL << ( ulPort ) ) ) != 0UL ) )
+#define portITM_PORT_READY( ulPort )          ( ( portITM_STIM_REG( ulPort ) & portITM_STIM_FIFOREADY_BIT ) != 0UL )
+#define portITM_PORT_WRITE( ulPort, ulWord )  ( portITM_STIM_REG( ulPort ) = ( ulWord ) )
+/*-----------------------------------------------------------*/
+
 #ifdef __cplusplus
     }
 #endif
@@ -188,6 +188,12 @@ void vResetPrivilege( void ) __attribute__( ( naked ) );
  * switches can only occur when uxCriticalNesting is zero. */
 static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 
+/* The MPU settings of the task whose regions are currently programmed into the
+ * MPU.  The PendSV handler does not reprogram the MPU when it resumes that same
+ * task, and vPortStoreTaskMPUSettings() clears this so changed settings are
+ * always programmed on the next context switch. */
+PRIVILEGED_DATA portDONT_DISCARD xMPU_SETTINGS * pxProgrammedMPUSettings = NULL;
+
 /*
  * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID() macro to ensure
  * FreeRTOS API functions are not called from interrupts that have been assigned
@@ -590,6 +596,12 @@ void xPortPendSVHandler( void )
         "   ldr r0, [r1]                        \n"/* The first item in the TCB is the task top of stack. */
         "   add r1, r1, #4                      \n"/* Move onto the second item in the TCB... */
         "                                       \n"
+        "   ldr r2, pxProgrammedMPUSettingsConst \n"/* Are this task's regions already programmed? */
+        "   ldr r3, [r2]                        \n"
+        "   cmp r1, r3                          \n"
+        "   beq 1f                              \n"/* If so there is no need to reprogram the MPU. */
+        "   str r1, [r2]                        \n"
+        "                                       \n"
         "   dmb                                 \n"/* Complete outstanding transfers before disabling MPU. */
         "   ldr r2, =0xe000ed94                 \n"/* MPU_CTRL register. */
         "   ldr r3, [r2]                        \n"/* Read the value of MPU_CTRL. */
@@ -605,7 +617,7 @@ void xPortPendSVHandler( void )
         "   orr r3, #1                          \n"/* r3 = r3 | 1 i.e. Set the bit 0 in r3. */
         "   str r3, [r2]                        \n"/* Enable MPU. */
         "   dsb                                 \n"/* Force memory writes before continuing. */
-        "                                       \n"
+        "1:                                     \n"
         "   ldmia r0!, {r3, r4-r11}             \n"/* Pop the registers that are not automatically saved on exception entry. */
         "   msr control, r3                     \n"
         "                                       \n"
@@ -615,6 +627,7 @@ void xPortPendSVHandler( void )
         "   .ltorg                              \n"/* Assemble current literal pool to avoid offset-out-of-bound errors with lto. */
         "   .align 4                            \n"
         "pxCurrentTCBConst: .word pxCurrentTCB  \n"
+        "pxProgrammedMPUSettingsConst: .word pxProgrammedMPUSettings \n"
         ::"i" ( configMAX_SYSCALL_INTERRUPT_PRIORITY )
     );
 }
@@ -626,12 +639,16 @@ void xPortSysTickHandler( void )
 
     ulDummy = portSET_INTERRUPT_MASK_FROM_ISR();
     {
+        traceBENCHMARK_ISR_ENTER();
+
         /* Increment the RTOS tick. */
         if( xTaskIncrementTick() != pdFALSE )
         {
             /* Pend a context switch. */
             portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
         }
+
+        traceBENCHMARK_ISR_EXIT();
     }
     portCLEAR_INTERRUPT_MASK_FROM_ISR( ulDummy );
 }
@@ -856,6 +873,8 @@ void vPortStoreTaskMPUSettings( xMPU_SETTINGS * xMPUSettings,
             lIndex++;
         }
     }
+
+    pxProgrammedMPUSettings = NULL;
 }
 /*-----------------------------------------------------------*/
 
@@ -74,6 +74,30 @@
 /* Masks off all bits but the VECTACTIVE bits in the ICSR register. */
 #define portVECTACTIVE_MASK                   ( 0xFFUL )
 
+/* Constants required to program the stack pool guard region. */
+#define portMPU_TYPE_REG                      ( *( ( volatile uint32_t * ) 0xe000ed90 ) )
+#define portMPU_CTRL_REG                      ( *( ( volatile uint32_t * ) 0xe000ed94 ) )
+#define portMPU_RNR_REG                       ( *( ( volatile uint32_t * ) 0xe000ed98 ) )
+#define portMPU_RBAR_REG                      ( *( ( volatile uint32_t * ) 0xe000ed9c ) )
+#define portMPU_RASR_REG                      ( *( ( volatile uint32_t * ) 0xe000eda0 ) )
+#define portSCB_SHCSR_REG                     ( *( ( volatile uint32_t * ) 0xe000ed24 ) )
+#define portMPU_TYPE_DREGION_MASK             ( 0xFFUL << 8UL )
+#define portMPU_TYPE_DREGION_SHIFT            ( 8UL )
+#define portMPU_ENABLE_BIT                    ( 1UL << 0UL )
+#define portMPU_PRIVDEFENA_BIT                ( 1UL << 2UL )
+#define portMPU_RBAR_VALID_BIT                ( 1UL << 4UL )
+#define portMPU_RASR_ENABLE_BIT               ( 1UL << 0UL )
+#define portMPU_RASR_GUARD_SIZE               ( 4UL << 1UL ) /* 2 ^ ( 4 + 1 ) = portSTACK_GUARD_SIZE bytes. */
+#define portMPU_RASR_XN_BIT                   ( 1UL << 28UL ) /* AP bits left at 0 for no access. */
+#define portSCB_MEMFAULTENA_BIT               ( 1UL << 16UL )
+
+/* The MPU region used for the stack guard.  Higher numbered regions take
+ * priority where regions overlap, so the default is the last region of an
+ * eight region MPU. */
+#ifndef configSTACK_GUARD_MPU_REGION
+    #define configSTACK_GUARD_MPU_REGION       ( 7UL )
+#endif
+
 /* Constants required to manipulate the VFP. */
 #define portFPCCR                             ( ( volatile uint32_t * ) 0xe000ef34 ) /* Floating point context control register. */
 #define portASPEN_AND_LSPEN_BITS              ( 0x3UL << 30UL )
@@ -125,8 +149,8 @@ void vPortSetupTimerInterrupt( void );
 /*
  * Exception handlers.
  */
-void xPortPendSVHandler( void ) __attribute__( ( naked ) );
-void xPortSysTickHandler( void );
+void xPortPendSVHandler( void ) __attribute__( ( naked ) ) FREERTOS_FAST_FUNCTION;
+void xPortSysTickHandler( void ) FREERTOS_FAST_FUNCTION;
 void vPortSVCHandler( void ) __attribute__( ( naked ) );
 
 /*
@@ -139,6 +163,12 @@ static void prvPortStartFirstTask( void ) __attribute__( ( naked ) );
  */
 static void vPortEnableVFP( void ) __attribute__( ( naked ) );
 
+/*
+ * See portTASK_RELEASE_FPU_CONTEXT() in portmacro.h.  This must not itself use
+ * any floating point instructions, so is naked.
+ */
+void vPortTaskReleaseFPUContext( void ) __attribute__( ( naked ) );
+
 /*
  * Used to catch tasks that attempt to return from their implementing function.
  */
@@ -379,6 +409,20 @@ BaseType_t xPortStartScheduler( void )
     /* Initialise the critical nesting count ready for the first task. */
     uxCriticalNesting = 0;
 
+    #if ( portSTACK_POOL_GUARD_SIZE > 0 )
+    {
+        /* The kernel has already placed the guard for the first task.  Check
+         * the MPU implements the guard region, then enable it with the default
+         * memory map as the background for everything outside the guard, and
+         * report guard hits as MemManage faults. */
+        configASSERT( ( ( portMPU_TYPE_REG & portMPU_TYPE_DREGION_MASK ) >> portMPU_TYPE_DREGION_SHIFT ) > configSTACK_GUARD_MPU_REGION );
+        portSCB_SHCSR_REG |= portSCB_MEMFAULTENA_BIT;
+        portMPU_CTRL_REG |= ( portMPU_ENABLE_BIT | portMPU_PRIVDEFENA_BIT );
+        __asm volatile ( "dsb \n"
+                         "isb \n" ::: "memory" );
+    }
+    #endif /* portSTACK_POOL_GUARD_SIZE */
+
     /* Ensure the VFP is enabled - it should be anyway. */
     vPortEnableVFP();
 
@@ -504,6 +548,8 @@ void xPortSysTickHandler( void )
      * known. */
     portDISABLE_INTERRUPTS();
     {
+        traceBENCHMARK_ISR_ENTER();
+
         /* Increment the RTOS tick. */
         if( xTaskIncrementTick() != pdFALSE )
         {
@@ -511,6 +557,8 @@ void xPortSysTickHandler( void )
              * the PendSV interrupt.  Pend the PendSV interrupt. */
             portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
         }
+
+        traceBENCHMARK_ISR_EXIT();
     }
     portENABLE_INTERRUPTS();
 }
@@ -737,6 +785,27 @@ void xPortSysTickHandler( void )
 #endif /* #if configUSE_TICKLESS_IDLE */
 /*-----------------------------------------------------------*/
 
+#if ( portSTACK_POOL_GUARD_SIZE > 0 )
+
+    void vPortSetStackGuard( void * pvGuard )
+    {
+        if( pvGuard != NULL )
+        {
+            /* Writing RBAR with the VALID bit set also selects the region. */
+            portMPU_RBAR_REG = ( ( uint32_t ) pvGuard ) | portMPU_RBAR_VALID_BIT | ( uint32_t ) configSTACK_GUARD_MPU_REGION;
+            portMPU_RASR_REG = portMPU_RASR_XN_BIT | portMPU_RASR_GUARD_SIZE | portMPU_RASR_ENABLE_BIT;
+        }
+        else
+        {
+            /* The task's stack did not come from the stack pool. */
+            portMPU_RNR_REG = ( uint32_t ) configSTACK_GUARD_MPU_REGION;
+            portMPU_RASR_REG = 0UL;
+        }
+    }
+
+#endif /* portSTACK_POOL_GUARD_SIZE */
+/*-----------------------------------------------------------*/
+
 /*
  * Setup the systick timer to generate the tick interrupts at the required
  * frequency.
@@ -762,6 +831,30 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DVFS_GOVERNOR == 1 )
+
+    void vPortSetCPUClockHz( uint32_t ulCPUClockHz )
+    {
+        /* A SysTick clocked by the external reference is not affected by a
+         * change to the CPU clock. */
+        if( portNVIC_SYSTICK_CLK_BIT_CONFIG != 0UL )
+        {
+            #if ( configUSE_TICKLESS_IDLE == 1 )
+            {
+                ulTimerCountsForOneTick = ( ulCPUClockHz / configTICK_RATE_HZ );
+                xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
+            }
+            #endif /* configUSE_TICKLESS_IDLE */
+
+            /* The new reload value is used from the end of the tick period in
+             * progress, so that one period is a mix of the two clocks. */
+            portNVIC_SYSTICK_LOAD_REG = ( ulCPUClockHz / configTICK_RATE_HZ ) - 1UL;
+        }
+    }
+
+#endif /* configUSE_DVFS_GOVERNOR */
+/*-----------------------------------------------------------*/
+
 /* This is a naked function. */
 static void vPortEnableVFP( void )
 {
@@ -778,6 +871,20 @@ static void vPortEnableVFP( void )
 }
 /*-----------------------------------------------------------*/
 
+/* This is a naked function. */
+void vPortTaskReleaseFPUContext( void )
+{
+    __asm volatile
+    (
+        "   mrs r0, control             \n"
+        "   bic r0, r0, #4              \n"/* Clear CONTROL.FPCA so the next exception entry stacks a basic frame, and xPortPendSVHandler() skips s16-s31. */
+        "   msr control, r0             \n"
+        "   isb                         \n"
+        "   bx r14                      \n"
+    );
+}
+/*-----------------------------------------------------------*/
+
 #if ( configASSERT_DEFINED == 1 )
 
     void vPortValidateInterruptPriority( void )
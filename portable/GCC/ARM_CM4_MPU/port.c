@@ -39,6 +39,10 @@
 #include "FreeRTOS.h"
 #include "task.h"
 
+#if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 )
+    #include "mpu_syscall_numbers.h"
+#endif
+
 #ifndef __VFP_FP__
     #error This port can only be used when the project options are configured to enable hardware floating point support.
 #endif
@@ -118,8 +122,19 @@
 #define portPRIGROUP_SHIFT                        ( 8UL )
 
 /* Offsets in the stack to the parameters when inside the SVC handler. */
+#define portOFFSET_TO_R0                          ( 0 )
+#define portOFFSET_TO_R12                         ( 4 )
+#define portOFFSET_TO_LR                          ( 5 )
 #define portOFFSET_TO_PC                          ( 6 )
 
+/* Constants required to decode the MPU settings stored in a task's TCB. */
+#define portMPU_RBAR_ADDRESS_MASK                 ( 0xFFFFFFE0UL )
+#define portMPU_RASR_SIZE_BITS_MASK               ( 0x3EUL )
+#define portMPU_RASR_SIZE_BITS_LOCATION           ( 1UL )
+#define portMPU_RASR_SRD_MASK                     ( 0xFFUL << 8UL )
+#define portMPU_RASR_AP_MASK                      ( 0x07UL << 24UL )
+#define portMPU_REGION_READ_ONLY_ALIAS            ( 0x07UL << 24UL )
+
 /* For strict compliance with the Cortex-M spec the task start address should
  * have bit-0 clear, as it is loaded into the PC on exit from an ISR. */
 #define portSTART_ADDRESS_MASK                    ( ( StackType_t ) 0xfffffffeUL )
@@ -161,6 +176,17 @@ static void prvRestoreContextOfFirstTask( void ) __attribute__( ( naked ) ) PRIV
  */
 static void prvSVCHandler( uint32_t * pulRegisters ) __attribute__( ( noinline ) ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 )
+
+/*
+ * Used by the system call implementations to check the buffers passed to them
+ * against the calling task's MPU regions.
+ */
+    BaseType_t xPortIsAuthorizedToAccessBuffer( const void * pvBuffer,
+                                                uint32_t ulBufferLength,
+                                                uint32_t ulAccessRequested ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Function to enable the VFP.
  */
@@ -207,6 +233,12 @@ void vResetPrivilege( void ) __attribute__( ( naked ) );
  * switches can only occur when uxCriticalNesting is zero. */
 static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 
+/* The MPU settings of the task whose regions are currently programmed into the
+ * MPU.  The PendSV handler does not reprogram the MPU when it resumes that same
+ * task, and vPortStoreTaskMPUSettings() clears this so changed settings are
+ * always programmed on the next context switch. */
+PRIVILEGED_DATA portDONT_DISCARD xMPU_SETTINGS * pxProgrammedMPUSettings = NULL;
+
 /*
  * Used by the portASSERT_IF_INTERRUPT_PRIORITY_INVALID() macro to ensure
  * FreeRTOS API functions are not called from interrupts that have been assigned
@@ -283,6 +315,11 @@ static void prvSVCHandler( uint32_t * pulParam )
     uint8_t ucSVCNumber;
     uint32_t ulPC;
 
+    #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 )
+        extern const UBaseType_t uxSystemCallImplementations[ NUM_SYSTEM_CALLS ];
+        uint32_t ulSystemCallNumber;
+    #endif
+
     #if ( configENFORCE_SYSTEM_CALLS_FROM_KERNEL_ONLY == 1 )
         #if defined( __ARMCC_VERSION )
 
@@ -321,6 +358,45 @@ static void prvSVCHandler( uint32_t * pulParam )
 
             break;
 
+            #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 )
+                case portSVC_SYSTEM_CALL: /* The system call number is in r12.
+                                           * Return into its implementation in
+                                           * privileged thread mode, with lr
+                                           * pointing back into the wrapper,
+                                           * which drops the privilege again. */
+                    ulSystemCallNumber = pulParam[ portOFFSET_TO_R12 ];
+
+                    #if ( configENFORCE_SYSTEM_CALLS_FROM_KERNEL_ONLY == 1 )
+                        if( ( ulPC < ( uint32_t ) __syscalls_flash_start__ ) ||
+                            ( ulPC > ( uint32_t ) __syscalls_flash_end__ ) )
+                        {
+                            ulSystemCallNumber = NUM_SYSTEM_CALLS;
+                        }
+                    #endif
+
+                    if( ( ulSystemCallNumber < NUM_SYSTEM_CALLS ) &&
+                        ( uxSystemCallImplementations[ ulSystemCallNumber ] != ( UBaseType_t ) 0 ) )
+                    {
+                        pulParam[ portOFFSET_TO_LR ] = ulPC | 1UL;
+                        pulParam[ portOFFSET_TO_PC ] = ( uint32_t ) uxSystemCallImplementations[ ulSystemCallNumber ] & portSTART_ADDRESS_MASK;
+
+                        __asm volatile
+                        (
+                            "   mrs r1, control     \n"/* Obtain current control value. */
+                            "   bic r1, #1          \n"/* Set privilege bit. */
+                            "   msr control, r1     \n"/* Write back new control value. */
+                            ::: "r1", "memory"
+                        );
+                    }
+                    else
+                    {
+                        /* Fail the call, without raising the privilege. */
+                        pulParam[ portOFFSET_TO_R0 ] = 0UL;
+                    }
+
+                    break;
+            #endif /* #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 ) */
+
             #if ( configENFORCE_SYSTEM_CALLS_FROM_KERNEL_ONLY == 1 )
                 case portSVC_RAISE_PRIVILEGE: /* Only raise the privilege, if the
                                                * svc was raised from any of the
@@ -655,6 +731,12 @@ void xPortPendSVHandler( void )
         "   ldr r0, [r1]                        \n"/* The first item in the TCB is the task top of stack. */
         "   add r1, r1, #4                      \n"/* Move onto the second item in the TCB... */
         "                                       \n"
+        "   ldr r2, pxProgrammedMPUSettingsConst \n"/* Are this task's regions already programmed? */
+        "   ldr r3, [r2]                        \n"
+        "   cmp r1, r3                          \n"
+        "   beq 1f                              \n"/* If so there is no need to reprogram the MPU. */
+        "   str r1, [r2]                        \n"
+        "                                       \n"
         "   dmb                                 \n"/* Complete outstanding transfers before disabling MPU. */
         "   ldr r2, =0xe000ed94                 \n"/* MPU_CTRL register. */
         "   ldr r3, [r2]                        \n"/* Read the value of MPU_CTRL. */
@@ -677,7 +759,7 @@ void xPortPendSVHandler( void )
         "   orr r3, #1                          \n"/* r3 = r3 | 1 i.e. Set the bit 0 in r3. */
         "   str r3, [r2]                        \n"/* Enable MPU. */
         "   dsb                                 \n"/* Force memory writes before continuing. */
-        "                                       \n"
+        "1:                                     \n"
         "   ldmia r0!, {r3-r11, r14}            \n"/* Pop the registers that are not automatically saved on exception entry. */
         "   msr control, r3                     \n"
         "                                       \n"
@@ -691,6 +773,7 @@ void xPortPendSVHandler( void )
         "   .ltorg                              \n"/* Assemble the current literal pool to avoid offset-out-of-bound errors with lto. */
         "   .align 4                            \n"
         "pxCurrentTCBConst: .word pxCurrentTCB  \n"
+        "pxProgrammedMPUSettingsConst: .word pxProgrammedMPUSettings \n"
         ::"i" ( configMAX_SYSCALL_INTERRUPT_PRIORITY )
     );
 }
@@ -702,12 +785,16 @@ void xPortSysTickHandler( void )
 
     ulDummy = portSET_INTERRUPT_MASK_FROM_ISR();
     {
+        traceBENCHMARK_ISR_ENTER();
+
         /* Increment the RTOS tick. */
         if( xTaskIncrementTick() != pdFALSE )
         {
             /* Pend a context switch. */
             portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
         }
+
+        traceBENCHMARK_ISR_EXIT();
     }
     portCLEAR_INTERRUPT_MASK_FROM_ISR( ulDummy );
 }
@@ -979,9 +1066,113 @@ void vPortStoreTaskMPUSettings( xMPU_SETTINGS * xMPUSettings,
             lIndex++;
         }
     }
+
+    pxProgrammedMPUSettings = NULL;
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 )
+
+    BaseType_t xPortIsAuthorizedToAccessBuffer( const void * pvBuffer,
+                                                uint32_t ulBufferLength,
+                                                uint32_t ulAccessRequested ) /* PRIVILEGED_FUNCTION */
+    {
+        #if defined( __ARMCC_VERSION )
+
+            /* Declaration when these variable are defined in code instead of being
+             * exported from linker scripts. */
+            extern uint32_t * __FLASH_segment_start__;
+            extern uint32_t * __FLASH_segment_end__;
+            extern uint32_t * __privileged_functions_start__;
+            extern uint32_t * __privileged_functions_end__;
+            extern uint32_t * __privileged_data_start__;
+            extern uint32_t * __privileged_data_end__;
+        #else
+            /* Declaration when these variable are exported from linker scripts. */
+            extern uint32_t __FLASH_segment_start__[];
+            extern uint32_t __FLASH_segment_end__[];
+            extern uint32_t __privileged_functions_start__[];
+            extern uint32_t __privileged_functions_end__[];
+            extern uint32_t __privileged_data_start__[];
+            extern uint32_t __privileged_data_end__[];
+        #endif /* if defined( __ARMCC_VERSION ) */
+
+        const xMPU_SETTINGS * pxMPUSettings;
+        uint32_t ulBufferStartAddress, ulBufferEndAddress;
+        uint32_t ulRegionStartAddress, ulRegionEndAddress, ulRegionAccess;
+        UBaseType_t uxRegion;
+        BaseType_t xAccessGranted = pdFALSE;
+
+        ulBufferStartAddress = ( uint32_t ) pvBuffer;
+        ulBufferEndAddress = ulBufferStartAddress + ulBufferLength - 1UL;
+
+        if( ulBufferLength == 0UL )
+        {
+            xAccessGranted = pdTRUE;
+        }
+        else if( ( ulBufferEndAddress < ulBufferStartAddress ) ||
+                 ( ( ulBufferStartAddress < ( uint32_t ) __privileged_data_end__ ) &&
+                   ( ulBufferEndAddress >= ( uint32_t ) __privileged_data_start__ ) ) ||
+                 ( ( ulBufferStartAddress < ( uint32_t ) __privileged_functions_end__ ) &&
+                   ( ulBufferEndAddress >= ( uint32_t ) __privileged_functions_start__ ) ) )
+        {
+            /* The buffer wraps around the address space, or overlaps one of
+             * the privileged regions.  Those use higher region numbers than a
+             * task's regions so are never accessible from unprivileged code. */
+            xAccessGranted = pdFALSE;
+        }
+        else if( ( ( ulAccessRequested & portMPU_BUFFER_WRITE ) == 0UL ) &&
+                 ( ulBufferStartAddress >= ( uint32_t ) __FLASH_segment_start__ ) &&
+                 ( ulBufferEndAddress < ( uint32_t ) __FLASH_segment_end__ ) )
+        {
+            /* Unprivileged flash is readable by all tasks. */
+            xAccessGranted = pdTRUE;
+        }
+        else
+        {
+            pxMPUSettings = xTaskGetMPUSettings( NULL );
+
+            for( uxRegion = 0; ( uxRegion < portTOTAL_NUM_REGIONS_IN_TCB ) && ( xAccessGranted == pdFALSE ); uxRegion++ )
+            {
+                /* Regions that are disabled, or that use sub-region disable
+                 * bits, are conservatively treated as granting no access. */
+                if( ( ( pxMPUSettings->xRegion[ uxRegion ].ulRegionAttribute & portMPU_REGION_ENABLE ) != 0UL ) &&
+                    ( ( pxMPUSettings->xRegion[ uxRegion ].ulRegionAttribute & portMPU_RASR_SRD_MASK ) == 0UL ) )
+                {
+                    ulRegionStartAddress = pxMPUSettings->xRegion[ uxRegion ].ulRegionBaseAddress & portMPU_RBAR_ADDRESS_MASK;
+                    ulRegionEndAddress = ulRegionStartAddress +
+                                         ( 2UL << ( ( pxMPUSettings->xRegion[ uxRegion ].ulRegionAttribute & portMPU_RASR_SIZE_BITS_MASK ) >> portMPU_RASR_SIZE_BITS_LOCATION ) ) - 1UL;
+                    ulRegionAccess = pxMPUSettings->xRegion[ uxRegion ].ulRegionAttribute & portMPU_RASR_AP_MASK;
+
+                    if( ( ulBufferStartAddress >= ulRegionStartAddress ) &&
+                        ( ulBufferEndAddress <= ulRegionEndAddress ) )
+                    {
+                        if( ulRegionAccess == portMPU_REGION_READ_WRITE )
+                        {
+                            xAccessGranted = pdTRUE;
+                        }
+                        else if( ( ( ulAccessRequested & portMPU_BUFFER_WRITE ) == 0UL ) &&
+                                 ( ( ulRegionAccess == portMPU_REGION_READ_ONLY ) ||
+                                   ( ulRegionAccess == portMPU_REGION_READ_ONLY_ALIAS ) ||
+                                   ( ulRegionAccess == portMPU_REGION_PRIVILEGED_READ_WRITE_UNPRIV_READ_ONLY ) ) )
+                        {
+                            xAccessGranted = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+            }
+        }
+
+        return xAccessGranted;
+    }
+
+#endif /* #if ( configUSE_MPU_SYSTEM_CALL_TABLE == 1 ) */
+/*-----------------------------------------------------------*/
+
 #if ( configASSERT_DEFINED == 1 )
 
     void vPortValidateInterruptPriority( void )
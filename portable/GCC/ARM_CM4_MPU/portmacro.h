@@ -209,6 +209,7 @@ typedef struct MPU_SETTINGS
 #define portSVC_START_SCHEDULER    0
 #define portSVC_YIELD              1
 #define portSVC_RAISE_PRIVILEGE    2
+#define portSVC_SYSTEM_CALL        3
 
 /* Scheduler utilities. */
 
@@ -291,11 +292,21 @@ extern void vPortExitCritical( void );
 /* portNOP() is not required by this port. */
 #define portNOP()
 
+/* Used by the kernel's spin-wait loops.  WFE also returns when an interrupt
+ * is taken, so a spinning task still sees notifications sent from interrupts
+ * that do not execute SEV. */
+#define portWAIT_FOR_EVENT()    __asm volatile ( "wfe" ::: "memory" )
+#define portSEND_EVENT()        __asm volatile ( "sev" ::: "memory" )
+
 #define portINLINE              __inline
 
 #ifndef portFORCE_INLINE
     #define portFORCE_INLINE    inline __attribute__( ( always_inline ) )
 #endif
+
+/* The __atomic built-in functions compile to LDREX/STREX, so atomic.h does not
+ * need to mask interrupts. */
+#define portHAS_NATIVE_ATOMICS    1
 /*-----------------------------------------------------------*/
 
 extern BaseType_t xIsPrivileged( void );
@@ -320,6 +331,54 @@ extern void vResetPrivilege( void );
 #define portRESET_PRIVILEGE()    vResetPrivilege()
 /*-----------------------------------------------------------*/
 
+/* This port can enter the kernel through a table of system calls, see
+ * configUSE_MPU_SYSTEM_CALL_TABLE. */
+#define portHAS_MPU_SYSTEM_CALL_TABLE    1
+
+#define portMPU_BUFFER_READ              ( 1UL )
+#define portMPU_BUFFER_WRITE             ( 2UL )
+
+/**
+ * @brief Checks that the calling task's MPU regions grant the requested
+ * unprivileged access to every byte of a buffer.
+ *
+ * @return pdTRUE if the task may access the buffer, pdFALSE otherwise.
+ */
+extern BaseType_t xPortIsAuthorizedToAccessBuffer( const void * pvBuffer,
+                                                   uint32_t ulBufferLength,
+                                                   uint32_t ulAccessRequested );
+
+/**
+ * @brief The body of a naked MPU wrapper that makes system call
+ * ulSystemCallNumber.
+ *
+ * A privileged caller branches straight to pxPrivilegedFunction, with its
+ * arguments still in r0-r3.  An unprivileged caller passes the system call
+ * number to the SVC handler in r12.  The handler returns into the
+ * implementation from the system call table in privileged thread mode, with
+ * lr pointing back here, after which the privilege is dropped again without a
+ * second exception.
+ */
+#define portSYSTEM_CALL( ulSystemCallNumber, pxPrivilegedFunction ) \
+    __asm volatile                                                  \
+    (                                                               \
+        "   mrs r12, control                \n"                     \
+        "   tst r12, #1                     \n"                     \
+        "   beq 1f                          \n"                     \
+        "   push {r4, lr}                   \n"                     \
+        "   mov r12, %0                     \n"                     \
+        "   svc %1                          \n"                     \
+        "   mrs r12, control                \n"                     \
+        "   orr r12, r12, #1                \n"                     \
+        "   msr control, r12                \n"                     \
+        "   isb                             \n"                     \
+        "   pop {r4, pc}                    \n"                     \
+        "1:                                 \n"                     \
+        "   b %2                            \n"                     \
+        ::"i" ( ulSystemCallNumber ), "i" ( portSVC_SYSTEM_CALL ), "i" ( pxPrivilegedFunction ) : "memory" \
+    )
+/*-----------------------------------------------------------*/
+
 portFORCE_INLINE static BaseType_t xPortIsInsideInterrupt( void )
 {
     uint32_t ulCurrentInterrupt;
@@ -399,6 +458,44 @@ portFORCE_INLINE static void vPortSetBASEPRI( uint32_t ulNewMaskValue )
 }
 /*-----------------------------------------------------------*/
 
+/* Cycle counter, read by the cycle benchmark (configUSE_CYCLE_BENCHMARK).  The
+ * DWT cycle counter is optional in ARMv7-M, so it is only started on parts that
+ * implement it.  Elsewhere portGET_CYCLE_COUNT() reads 0. */
+#define portDEMCR_REG                    ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+#define portDEMCR_TRCENA_BIT             ( 1UL << 24UL )
+#define portDWT_CTRL_REG                 ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+#define portDWT_CYCCNT_REG               ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+#define portDWT_CTRL_NOCYCCNT_BIT        ( 1UL << 25UL )
+#define portDWT_CTRL_CYCCNTENA_BIT       ( 1UL << 0UL )
+
+#define portENABLE_CYCLE_COUNTER()                                          \
+do {                                                                        \
+    portDEMCR_REG |= portDEMCR_TRCENA_BIT;                                  \
+    if( ( portDWT_CTRL_REG & portDWT_CTRL_NOCYCCNT_BIT ) == 0UL )           \
+    {                                                                       \
+        portDWT_CYCCNT_REG = 0UL;                                           \
+        portDWT_CTRL_REG |= portDWT_CTRL_CYCCNTENA_BIT;                     \
+    }                                                                       \
+} while( 0 )
+
+#define portGET_CYCLE_COUNT()    ( portDWT_CYCCNT_REG )
+/*-----------------------------------------------------------*/
+
+/* ITM stimulus port access, used by the trace recorder's ITM transport
+ * (configTRACE_RECORDER_TRANSPORT).  The ITM and the port must have been
+ * enabled, normally by the debugger capturing the SWO output, for a write to
+ * go anywhere, and a port only accepts a write while its FIFO is ready. */
+#define portITM_TCR_REG                       ( *( ( volatile uint32_t * ) 0xe0000e80 ) )
+#define portITM_TER_REG                       ( *( ( volatile uint32_t * ) 0xe0000e00 ) )
+#define portITM_TCR_ITMENA_BIT                ( 1UL << 0UL )
+#define portITM_STIM_REG( ulPort )            ( *( ( volatile uint32_t * ) ( 0xe0000000UL + ( 4UL * ( uint32_t ) ( ulPort ) ) ) ) )
+#define portITM_STIM_FIFOREADY_BIT            ( 1UL << 0UL )
+
+#define portITM_PORT_ENABLED( ulPort )        ( ( ( portITM_TCR_REG & portITM_TCR_ITMENA_BIT ) != 0UL ) && ( ( portITM_TER_REG & ( 1UL << ( ulPort ) ) ) != 0UL ) )
+#define portITM_PORT_READY( ulPort )          ( ( portITM_STIM_REG( ulPort ) & portITM_STIM_FIFOREADY_BIT ) != 0UL )
+#define portITM_PORT_WRITE( ulPort, ulWord )  ( portITM_STIM_REG( ulPort ) = ( ulWord ) )
+/*-----------------------------------------------------------*/
+
 #define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
 
 #ifndef configENFORCE_SYSTEM_CALLS_FROM_KERNEL_ONLY
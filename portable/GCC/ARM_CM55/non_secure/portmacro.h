@@ -55,6 +55,10 @@
  */
 #define portARCH_NAME                       "Cortex-M55"
 #define portDONT_DISCARD                    __attribute__( ( used ) )
+
+/* The __atomic built-in functions compile to LDREX/STREX, so atomic.h does not
+ * need to mask interrupts. */
+#define portHAS_NATIVE_ATOMICS              1
 /*-----------------------------------------------------------*/
 
 /**
@@ -119,8 +119,8 @@ void vPortSetupTimerInterrupt( void );
 /*
  * Exception handlers.
  */
-void xPortPendSVHandler( void ) __attribute__( ( naked ) );
-void xPortSysTickHandler( void );
+void xPortPendSVHandler( void ) __attribute__( ( naked ) ) FREERTOS_FAST_FUNCTION;
+void xPortSysTickHandler( void ) FREERTOS_FAST_FUNCTION;
 void vPortSVCHandler( void ) __attribute__( ( naked ) );
 
 /*
@@ -494,6 +494,8 @@ void xPortSysTickHandler( void )
      * known. */
     portDISABLE_INTERRUPTS();
     {
+        traceBENCHMARK_ISR_ENTER();
+
         /* Increment the RTOS tick. */
         if( xTaskIncrementTick() != pdFALSE )
         {
@@ -501,6 +503,8 @@ void xPortSysTickHandler( void )
              * the PendSV interrupt.  Pend the PendSV interrupt. */
             portNVIC_INT_CTRL_REG = portNVIC_PENDSVSET_BIT;
         }
+
+        traceBENCHMARK_ISR_EXIT();
     }
     portENABLE_INTERRUPTS();
 }
@@ -752,6 +756,30 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DVFS_GOVERNOR == 1 )
+
+    void vPortSetCPUClockHz( uint32_t ulCPUClockHz )
+    {
+        /* A SysTick clocked by the external reference is not affected by a
+         * change to the CPU clock. */
+        if( portNVIC_SYSTICK_CLK_BIT_CONFIG != 0UL )
+        {
+            #if ( configUSE_TICKLESS_IDLE == 1 )
+            {
+                ulTimerCountsForOneTick = ( ulCPUClockHz / configTICK_RATE_HZ );
+                xMaximumPossibleSuppressedTicks = portMAX_24_BIT_NUMBER / ulTimerCountsForOneTick;
+            }
+            #endif /* configUSE_TICKLESS_IDLE */
+
+            /* The new reload value is used from the end of the tick period in
+             * progress, so that one period is a mix of the two clocks. */
+            portNVIC_SYSTICK_LOAD_REG = ( ulCPUClockHz / configTICK_RATE_HZ ) - 1UL;
+        }
+    }
+
+#endif /* configUSE_DVFS_GOVERNOR */
+/*-----------------------------------------------------------*/
+
 /* This is a naked function. */
 static void vPortEnableVFP( void )
 {
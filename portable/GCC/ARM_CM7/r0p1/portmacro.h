@@ -165,12 +165,28 @@
 /* portNOP() is not required by this port. */
     #define portNOP()
 
+/* Used by the kernel's spin-wait loops.  WFE also returns when an interrupt
+ * is taken, so a spinning task still sees notifications sent from interrupts
+ * that do not execute SEV. */
+    #define portWAIT_FOR_EVENT()    __asm volatile ( "wfe" ::: "memory" )
+    #define portSEND_EVENT()        __asm volatile ( "sev" ::: "memory" )
+
+/* Reloads the SysTick after the DVFS governor changes the CPU clock. */
+    #if ( configUSE_DVFS_GOVERNOR == 1 )
+        extern void vPortSetCPUClockHz( uint32_t ulCPUClockHz );
+        #define portCPU_CLOCK_CHANGED( ulCPUClockHz )    vPortSetCPUClockHz( ulCPUClockHz )
+    #endif
+
     #define portINLINE              __inline
 
     #ifndef portFORCE_INLINE
         #define portFORCE_INLINE    inline __attribute__( ( always_inline ) )
     #endif
 
+/* The __atomic built-in functions compile to LDREX/STREX, so atomic.h does not
+ * need to mask interrupts. */
+    #define portHAS_NATIVE_ATOMICS    1
+
     portFORCE_INLINE static BaseType_t xPortIsInsideInterrupt( void )
     {
         uint32_t ulCurrentInterrupt;
@@ -242,6 +258,108 @@
     }
 /*-----------------------------------------------------------*/
 
+/* Cycle counter, read by the cycle benchmark (configUSE_CYCLE_BENCHMARK).  The
+ * DWT cycle counter is optional in ARMv7-M, so it is only started on parts that
+ * implement it, after unlocking the DWT on parts that lock it.  Elsewhere
+ * portGET_CYCLE_COUNT() reads 0. */
+    #define portDEMCR_REG                    ( *( ( volatile uint32_t * ) 0xe000edfc ) )
+    #define portDEMCR_TRCENA_BIT             ( 1UL << 24UL )
+    #define portDWT_CTRL_REG                 ( *( ( volatile uint32_t * ) 0xe0001000 ) )
+    #define portDWT_CYCCNT_REG               ( *( ( volatile uint32_t * ) 0xe0001004 ) )
+    #define portDWT_LAR_REG                  ( *( ( volatile uint32_t * ) 0xe0001fb0 ) )
+    #define portDWT_LAR_UNLOCK_KEY           ( 0xc5acce55UL )
+    #define portDWT_CTRL_NOCYCCNT_BIT        ( 1UL << 25UL )
+    #define portDWT_CTRL_CYCCNTENA_BIT       ( 1UL << 0UL )
+
+    #define portENABLE_CYCLE_COUNTER()                                          \
+    do {                                                                        \
+        portDEMCR_REG |= portDEMCR_TRCENA_BIT;                                  \
+        portDWT_LAR_REG = portDWT_LAR_UNLOCK_KEY;                               \
+        if( ( portDWT_CTRL_REG & portDWT_CTRL_NOCYCCNT_BIT ) == 0UL )           \
+        {                                                                       \
+            portDWT_CYCCNT_REG = 0UL;                                           \
+            portDWT_CTRL_REG |= portDWT_CTRL_CYCCNTENA_BIT;                     \
+        }                                                                       \
+    } while( 0 )
+
+    #define portGET_CYCLE_COUNT()    ( portDWT_CYCCNT_REG )
+/*-----------------------------------------------------------*/
+
+/* ITM stimulus port access, used by the trace recorder's ITM transport
+ * (configTRACE_RECORDER_TRANSPORT).  The ITM and the port must have been
+ * enabled, normally by the debugger capturing the SWO output, for a write to
+ * go anywhere, and a port only accepts a write while its FIFO is ready. */
+    #define portITM_TCR_REG                       ( *( ( volatile uint32_t * ) 0xe0000e80 ) )
+    #define portITM_TER_REG                       ( *( ( volatile uint32_t * ) 0xe0000e00 ) )
+    #define portITM_TCR_ITMENA_BIT                ( 1UL << 0UL )
+    #define portITM_STIM_REG( ulPort )            ( *( ( volatile uint32_t * ) ( 0xe0000000UL + ( 4UL * ( uint32_t ) ( ulPort ) ) ) ) )
+    #define portITM_STIM_FIFOREADY_BIT            ( 1UL << 0UL )
+
+    #define portITM_PORT_ENABLED( ulPort )        ( ( ( portITM_TCR_REG & portITM_TCR_ITMENA_BIT ) != 0UL ) && ( ( portITM_TER_REG & ( 1UL << ( ulPort ) ) ) != 0UL ) )
+    #define portITM_PORT_READY( ulPort )          ( ( portITM_STIM_REG( ulPort ) & portITM_STIM_FIFOREADY_BIT ) != 0UL )
+    #define portITM_PORT_WRITE( ulPort, ulWord )  ( portITM_STIM_REG( ulPort ) = ( ulWord ) )
+/*-----------------------------------------------------------*/
+
+/* Data cache maintenance by address, used by stream buffers created with
+ * sbTYPE_CACHE_MAINTAINED (configUSE_STREAM_BUFFER_CACHE_MAINTENANCE).  Cleaning
+ * writes back every line that overlaps the range.  Invalidating discards the
+ * lines that lie wholly inside the range, but cleans as well as invalidates a
+ * line the range only partly covers so data outside the range that shares the
+ * line is not lost. */
+    #define portHAS_DCACHE_MAINTENANCE    1
+    #define portDCACHE_LINE_BYTES         ( 32UL )
+    #define portSCB_DCIMVAC_REG           ( *( ( volatile uint32_t * ) 0xe000ef5c ) )
+    #define portSCB_DCCMVAC_REG           ( *( ( volatile uint32_t * ) 0xe000ef68 ) )
+    #define portSCB_DCCIMVAC_REG          ( *( ( volatile uint32_t * ) 0xe000ef70 ) )
+
+    portFORCE_INLINE static void vPortCleanDCacheByAddress( const void * pvAddress,
+                                                            uint32_t ulLength )
+    {
+        const uint32_t ulEnd = ( uint32_t ) pvAddress + ulLength;
+        uint32_t ulLine = ( uint32_t ) pvAddress & ~( portDCACHE_LINE_BYTES - 1UL );
+
+        __asm volatile ( "dsb" ::: "memory" );
+
+        while( ulLine < ulEnd )
+        {
+            portSCB_DCCMVAC_REG = ulLine;
+            ulLine += portDCACHE_LINE_BYTES;
+        }
+
+        __asm volatile ( "dsb" ::: "memory" );
+    }
+
+    portFORCE_INLINE static void vPortInvalidateDCacheByAddress( const void * pvAddress,
+                                                                 uint32_t ulLength )
+    {
+        const uint32_t ulStart = ( uint32_t ) pvAddress;
+        const uint32_t ulEnd = ulStart + ulLength;
+        uint32_t ulLine = ulStart & ~( portDCACHE_LINE_BYTES - 1UL );
+
+        __asm volatile ( "dsb" ::: "memory" );
+
+        while( ulLine < ulEnd )
+        {
+            if( ( ulLine < ulStart ) || ( ( ulEnd - ulLine ) < portDCACHE_LINE_BYTES ) )
+            {
+                portSCB_DCCIMVAC_REG = ulLine;
+            }
+            else
+            {
+                portSCB_DCIMVAC_REG = ulLine;
+            }
+
+            ulLine += portDCACHE_LINE_BYTES;
+        }
+
+        __asm volatile ( "dsb" ::: "memory" );
+        __asm volatile ( "isb" );
+    }
+
+    #define portCLEAN_DCACHE_BY_ADDRESS( pvAddress, xLength )         vPortCleanDCacheByAddress( ( pvAddress ), ( uint32_t ) ( xLength ) )
+    #define portINVALIDATE_DCACHE_BY_ADDRESS( pvAddress, xLength )    vPortInvalidateDCacheByAddress( ( pvAddress ), ( uint32_t ) ( xLength ) )
+/*-----------------------------------------------------------*/
+
     #define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
 
     #ifdef __cplusplus
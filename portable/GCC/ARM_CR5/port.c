@@ -126,11 +126,15 @@
     __asm volatile ( "ISB" );
 
 
+/* The ICCPMR value that masks interrupts up to the max API call priority. */
+#define portAPI_PRIORITY_MASK_VALUE    ( ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT ) )
+
 /* Macro to unmask all interrupt priorities. */
 #define portCLEAR_INTERRUPT_MASK()                            \
     {                                                         \
         portCPU_IRQ_DISABLE();                                \
         portICCPMR_PRIORITY_MASK_REGISTER = portUNMASK_VALUE; \
+        ulPortPriorityMask = portUNMASK_VALUE;                \
         __asm volatile ( "DSB       \n"                       \
                          "ISB       \n");                         \
         portCPU_IRQ_ENABLE();                                 \
@@ -196,6 +200,15 @@ static void prvTaskExitError( void );
  */
 void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR ) __attribute__((weak) );
 
+/*
+ * FreeRTOS_FIQ_Handler() in portASM.S calls vApplicationFIQHandler().  This
+ * weak implementation is provided to remove linkage errors when the
+ * application does not use the FIQ path - it should never actually get called
+ * so its implementation contains a call to configASSERT() that will always
+ * fail.
+ */
+void vApplicationFIQHandler( uint32_t ulICCIAR ) __attribute__((weak) );
+
 /*-----------------------------------------------------------*/
 
 /* A variable is used to keep track of the critical section nesting.  This
@@ -216,11 +229,20 @@ uint32_t ulPortYieldRequired = pdFALSE;
  * if the nesting depth is 0. */
 uint32_t ulPortInterruptNesting = 0UL;
 
+/* The value last written to ICCPMR.  Reading ICCPMR itself is a slow access
+ * to the GIC, so ulPortSetInterruptMask() reads this copy instead, and does not
+ * touch ICCPMR or execute any barriers when interrupts are already masked - as
+ * they are each time critical sections nest.  Updated wherever ICCPMR is
+ * written, including by portRESTORE_CONTEXT in portASM.S.  Starts at 0, a value
+ * it is never compared against, so the first ulPortSetInterruptMask() call
+ * always writes ICCPMR. */
+volatile uint32_t ulPortPriorityMask = 0UL;
+
 /* Used in asm code. */
 __attribute__( ( used ) ) const uint32_t ulICCIAR = portICCIAR_INTERRUPT_ACKNOWLEDGE_REGISTER_ADDRESS;
 __attribute__( ( used ) ) const uint32_t ulICCEOIR = portICCEOIR_END_OF_INTERRUPT_REGISTER_ADDRESS;
 __attribute__( ( used ) ) const uint32_t ulICCPMR = portICCPMR_PRIORITY_MASK_REGISTER_ADDRESS;
-__attribute__( ( used ) ) const uint32_t ulMaxAPIPriorityMask = ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+__attribute__( ( used ) ) const uint32_t ulMaxAPIPriorityMask = portAPI_PRIORITY_MASK_VALUE;
 
 /*-----------------------------------------------------------*/
 
@@ -344,6 +366,13 @@ void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR )
 }
 /*-----------------------------------------------------------*/
 
+void vApplicationFIQHandler( uint32_t ulICCIAR )
+{
+    ( void ) ulICCIAR;
+    configASSERT( ( volatile void * ) NULL );
+}
+/*-----------------------------------------------------------*/
+
 BaseType_t xPortStartScheduler( void )
 {
     uint32_t ulAPSR, ulCycles = 8; /* 8 bits per byte. */
@@ -488,7 +517,8 @@ void FreeRTOS_Tick_Handler( void )
      * necessary to turn off interrupts in the CPU itself while the ICCPMR is being
      * updated. */
     portCPU_IRQ_DISABLE();
-    portICCPMR_PRIORITY_MASK_REGISTER = ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+    portICCPMR_PRIORITY_MASK_REGISTER = portAPI_PRIORITY_MASK_VALUE;
+    ulPortPriorityMask = portAPI_PRIORITY_MASK_VALUE;
     __asm volatile ( "dsb       \n"
                      "isb       \n"::: "memory" );
     portCPU_IRQ_ENABLE();
@@ -524,7 +554,8 @@ void FreeRTOS_Tick_Handler( void )
 
 void vPortClearInterruptMask( uint32_t ulNewMaskValue )
 {
-    if( ulNewMaskValue == pdFALSE )
+    /* There is nothing to do if interrupts are already unmasked. */
+    if( ( ulNewMaskValue == pdFALSE ) && ( ulPortPriorityMask != portUNMASK_VALUE ) )
     {
         portCLEAR_INTERRUPT_MASK();
     }
@@ -535,25 +566,28 @@ uint32_t ulPortSetInterruptMask( void )
 {
     uint32_t ulReturn;
 
-    /* Interrupt in the CPU must be turned off while the ICCPMR is being
-     * updated. */
-    portCPU_IRQ_DISABLE();
-
-    if( portICCPMR_PRIORITY_MASK_REGISTER == ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT ) )
+    /* If interrupts are already masked then no interrupt that could change
+     * the mask can run, so the copy can be checked without turning interrupts
+     * off in the CPU, and the mask, and the barriers that make it take effect,
+     * are left alone. */
+    if( ulPortPriorityMask == portAPI_PRIORITY_MASK_VALUE )
     {
         /* Interrupts were already masked. */
         ulReturn = pdTRUE;
     }
     else
     {
+        /* Interrupt in the CPU must be turned off while the ICCPMR is being
+         * updated. */
+        portCPU_IRQ_DISABLE();
         ulReturn = pdFALSE;
-        portICCPMR_PRIORITY_MASK_REGISTER = ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+        portICCPMR_PRIORITY_MASK_REGISTER = portAPI_PRIORITY_MASK_VALUE;
+        ulPortPriorityMask = portAPI_PRIORITY_MASK_VALUE;
         __asm volatile ( "dsb       \n"
                          "isb       \n"::: "memory" );
+        portCPU_IRQ_ENABLE();
     }
 
-    portCPU_IRQ_ENABLE();
-
     return ulReturn;
 }
 /*-----------------------------------------------------------*/
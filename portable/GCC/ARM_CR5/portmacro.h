@@ -82,6 +82,23 @@
     }
 
     #define portYIELD_FROM_ISR( x )    portEND_SWITCHING_ISR( x )
+
+/* Called by the kernel when it readies a task that should preempt the running
+ * task.  From an interrupt, the context switch is pended for the exit from the
+ * outermost interrupt, which is where FreeRTOS_IRQ_Handler makes its one switch
+ * decision, so interrupts do not need to use portYIELD_FROM_ISR(). */
+    #define portPEND_YIELD_FROM_ISR()                \
+    {                                                \
+        extern uint32_t ulPortInterruptNesting;      \
+        extern uint32_t ulPortYieldRequired;         \
+                                                     \
+        if( ulPortInterruptNesting != 0UL )          \
+        {                                            \
+            ulPortYieldRequired = pdTRUE;            \
+        }                                            \
+    }
+
+    #define portYIELD_FROM_ISR_IS_AUTOMATIC    1
     #define portYIELD()                __asm volatile ( "SWI 0" ::: "memory" );
 
 
@@ -116,6 +133,11 @@
  * handler for whichever peripheral is used to generate the RTOS tick. */
     void FreeRTOS_Tick_Handler( void );
 
+/* Called by FreeRTOS_FIQ_Handler(), the optional fast interrupt path in
+ * portASM.S that bypasses the kernel, with the value read from ICCIAR.  Must not
+ * call any FreeRTOS API function or use the FPU.  See portASM.S. */
+    void vApplicationFIQHandler( uint32_t ulICCIAR );
+
 /* If configUSE_TASK_FPU_SUPPORT is set to 1 (or left undefined) then tasks are
 created without an FPU context and must call vPortTaskUsesFPU() to give
 themselves an FPU context before using any FPU instructions. If
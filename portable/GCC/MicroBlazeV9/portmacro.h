@@ -157,6 +157,7 @@ extern volatile uint32_t ulTaskSwitchRequested;
 
 #if( XPAR_MICROBLAZE_USE_STACK_PROTECTION )
 #define portHAS_STACK_OVERFLOW_CHECKING 1
+#define portHAS_STACK_LIMIT_REGISTER 1 /* SLR and SHR. */
 #endif
 /*-----------------------------------------------------------*/
 
@@ -84,6 +84,24 @@
  */
 void vPortSetupTimerInterrupt( void ) __attribute__(( weak ));
 
+#if( configUSE_TICKLESS_IDLE == 1 ) && ( configMTIME_BASE_ADDRESS != 0 ) && ( configMTIMECMP_BASE_ADDRESS != 0 )
+
+    /*
+     * Read the 64-bit mtime register, and write the 64-bit mtimecmp register of
+     * this hart, in a way that is safe on RV32 where each takes two accesses.
+     */
+    static uint64_t prvReadMachineTime( void );
+    static void prvWriteMachineTimerCompare( uint64_t ullCompare );
+
+    /*
+     * The maximum number of tick periods that can be suppressed.  mtime is 64
+     * bits so this only limits a 64-bit TickType_t, keeping the calculations in
+     * vPortSuppressTicksAndSleep() from overflowing.
+     */
+    static const uint64_t ullMaximumPossibleSuppressedTicks = ( UINT64_MAX >> 1 ) / ( uint64_t ) ( ( configCPU_CLOCK_HZ ) / ( configTICK_RATE_HZ ) );
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /*-----------------------------------------------------------*/
 
 /* Used to program the machine timer compare register. */
@@ -101,6 +119,15 @@ size_t *pxCriticalNesting = &xCriticalNesting;
 /* Used to catch tasks that attempt to return from their implementing function. */
 size_t xTaskReturnAddress = ( size_t ) portTASK_RETURN_ADDRESS;
 
+#if( configUSE_CLIC == 1 )
+    /* The mintthresh value the trap handling code uses to mask interrupts that
+     * can use the FreeRTOS API while it runs, or while it returns to a task
+     * that is in a critical section.  The assembly code references it, so
+     * building the assembly code for CLIC mode without also setting
+     * configUSE_CLIC to 1 fails to link. */
+    const size_t uxPortClicSyscallThreshold = ( size_t ) configMAX_SYSCALL_INTERRUPT_PRIORITY;
+#endif
+
 /* Set configCHECK_FOR_STACK_OVERFLOW to 3 to add ISR stack checking to task
  * stack checking.  A problem in the ISR stack will trigger an assert, not call
  * the stack overflow hook function (because the stack overflow hook is specific
@@ -154,6 +181,127 @@ size_t xTaskReturnAddress = ( size_t ) portTASK_RETURN_ADDRESS;
 #endif /* ( configMTIME_BASE_ADDRESS != 0 ) && ( configMTIME_BASE_ADDRESS != 0 ) */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TICKLESS_IDLE == 1 ) && ( configMTIME_BASE_ADDRESS != 0 ) && ( configMTIMECMP_BASE_ADDRESS != 0 )
+
+    static uint64_t prvReadMachineTime( void )
+    {
+    uint32_t ulCurrentTimeHigh, ulCurrentTimeLow;
+    volatile uint32_t * const pulTimeHigh = ( volatile uint32_t * const ) ( ( configMTIME_BASE_ADDRESS ) + 4UL ); /* 8-byte type so high 32-bit word is 4 bytes up. */
+    volatile uint32_t * const pulTimeLow = ( volatile uint32_t * const ) ( configMTIME_BASE_ADDRESS );
+
+        do
+        {
+            ulCurrentTimeHigh = *pulTimeHigh;
+            ulCurrentTimeLow = *pulTimeLow;
+        } while( ulCurrentTimeHigh != *pulTimeHigh );
+
+        return ( ( ( uint64_t ) ulCurrentTimeHigh ) << 32ULL ) | ( uint64_t ) ulCurrentTimeLow;
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvWriteMachineTimerCompare( uint64_t ullCompare )
+    {
+    volatile uint32_t * const pulCompareLow = ( volatile uint32_t * ) pullMachineTimerCompareRegister;
+    volatile uint32_t * const pulCompareHigh = pulCompareLow + 1;
+
+        /* As portUPDATE_MTIMER_COMPARE_REGISTER in portASM.S - the low word is
+         * first set to its maximum so the compare value never passes through a
+         * value below both the old and the new one. */
+        *pulCompareLow = UINT32_MAX;
+        *pulCompareHigh = ( uint32_t ) ( ullCompare >> 32ULL );
+        *pulCompareLow = ( uint32_t ) ullCompare;
+    }
+    /*-----------------------------------------------------------*/
+
+    __attribute__(( weak )) void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+    uint64_t ullLastTickTime, ullSleepCompare, ullNow;
+    TickType_t xCompleteTickPeriods, xModifiableIdleTime;
+
+        if( ( uint64_t ) xExpectedIdleTime > ullMaximumPossibleSuppressedTicks )
+        {
+            xExpectedIdleTime = ( TickType_t ) ullMaximumPossibleSuppressedTicks;
+        }
+
+        /* Enter a critical section but don't use the taskENTER_CRITICAL() method
+         * as that will mask interrupts that should exit sleep mode.  wfi still
+         * returns when an interrupt that is enabled in mie becomes pending while
+         * mstatus.MIE is clear.  mstatus.MIE is used directly, rather than
+         * portDISABLE_INTERRUPTS(), because in CLIC mode that raises mintthresh,
+         * which would stop the tick interrupt waking the core. */
+        __asm volatile( "csrc mstatus, 8" ::: "memory" );
+
+        /* If a context switch is pending or a task is waiting for the scheduler
+         * to be unsuspended then abandon the low power entry. */
+        if( eTaskConfirmSleepModeStatus() == eAbortSleep )
+        {
+            __asm volatile( "csrs mstatus, 8" ::: "memory" );
+        }
+        else
+        {
+            /* mtime keeps counting while the core sleeps, so unlike SysTick it
+             * is never stopped and no time is lost to stopping it.  ullNextTime
+             * is always one tick period after the value in mtimecmp, so the
+             * tick period now in progress started one period before that. */
+            ullLastTickTime = ullNextTime - ( 2ULL * ( uint64_t ) uxTimerIncrementsForOneTick );
+            ullSleepCompare = ullLastTickTime + ( ( uint64_t ) xExpectedIdleTime * ( uint64_t ) uxTimerIncrementsForOneTick );
+            prvWriteMachineTimerCompare( ullSleepCompare );
+
+            /* Allow the application to define some pre-sleep processing.  This
+             * is the standard configPRE_SLEEP_PROCESSING() macro as described on
+             * the FreeRTOS.org website. */
+            xModifiableIdleTime = xExpectedIdleTime;
+            configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+            /* configPRE_SLEEP_PROCESSING() can set xModifiableIdleTime to 0 to
+             * indicate that its implementation contains its own wait for
+             * interrupt or wait for event instruction, and so wfi should not be
+             * executed again. */
+            if( xModifiableIdleTime > 0 )
+            {
+                __asm volatile( "fence" ::: "memory" );
+                __asm volatile( "wfi" );
+            }
+
+            configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+            ullNow = prvReadMachineTime();
+
+            if( ullNow >= ullSleepCompare )
+            {
+                /* The tick interrupt ended the sleep, or is now pending.  It
+                 * will program mtimecmp from ullNextTime and process one tick as
+                 * soon as interrupts are enabled, so step the tick count forward
+                 * by one less than the time spent waiting. */
+                ullNextTime = ullSleepCompare + ( uint64_t ) uxTimerIncrementsForOneTick;
+                xCompleteTickPeriods = xExpectedIdleTime - ( TickType_t ) 1;
+            }
+            else
+            {
+                /* Something other than the tick interrupt ended the sleep.
+                 * Work out how many complete tick periods passed while asleep,
+                 * and move mtimecmp back to the end of the period now in
+                 * progress.  This cannot reach ullSleepCompare so the kernel's
+                 * next unblock time cannot be passed. */
+                xCompleteTickPeriods = ( TickType_t ) ( ( ullNow - ullLastTickTime ) / ( uint64_t ) uxTimerIncrementsForOneTick );
+                ullSleepCompare = ullLastTickTime + ( ( uint64_t ) ( xCompleteTickPeriods + ( TickType_t ) 1 ) * ( uint64_t ) uxTimerIncrementsForOneTick );
+                prvWriteMachineTimerCompare( ullSleepCompare );
+                ullNextTime = ullSleepCompare + ( uint64_t ) uxTimerIncrementsForOneTick;
+            }
+
+            /* Correct the kernel's tick count before any interrupt that is
+             * pending runs and reads it. */
+            vTaskStepTick( xCompleteTickPeriods );
+
+            /* Exit with interrupts enabled so the interrupt that woke the core
+             * runs now. */
+            __asm volatile( "csrs mstatus, 8" ::: "memory" );
+        }
+    }
+
+#endif /* ( configUSE_TICKLESS_IDLE == 1 ) && ( configMTIME_BASE_ADDRESS != 0 ) && ( configMTIMECMP_BASE_ADDRESS != 0 ) */
+/*-----------------------------------------------------------*/
+
 BaseType_t xPortStartScheduler( void )
 {
 extern void xPortStartFirstTask( void );
@@ -58,12 +58,334 @@
     #define portMSTATUS_OFFSET  30
 #endif
 
+/* Floating point (F/D extension) and vector (V extension) register state.  By
+ * default the state is saved whenever the code is built for a core that has
+ * the extension, as indicated by the compiler - a chip specific extensions
+ * header can define portasmHAS_FPU or portasmHAS_VPU to 0 to opt out.
+ *
+ * The state is saved lazily using the mstatus.FS and mstatus.VS fields.  Tasks
+ * start with the fields set to Initial, and the hardware moves a field to Dirty
+ * when the task first writes to a register of that extension.  The registers
+ * are then saved and restored on each context switch of that task only, so
+ * tasks that never use the FPU or vector unit do not pay for it.  When present,
+ * the saved state sits below the integer frame, 16-byte aligned, and below that
+ * is a header recording what was saved and where the integer frame starts:
+ *
+ * [integer frame, as described in portASM.S]
+ * [alignment padding, 0 to 15 bytes]
+ * [FPU state, if saved: f0-f31 then fcsr]
+ * [vector state, if saved: vstart, vcsr, vl, vtype then v0-v31]
+ * [header: slot 0 (for mepc or chip specific registers), saved flags, integer frame address]
+ * [chip specific registers]
+ * mepc
+ *
+ * Interrupt service routines must not use floating point or vector
+ * instructions, as the state of the interrupted task is saved only for the
+ * task, not for the interrupt. */
+#ifndef portasmHAS_FPU
+    #ifdef __riscv_flen
+        #define portasmHAS_FPU 1
+    #else
+        #define portasmHAS_FPU 0
+    #endif
+#endif
+
+#ifndef portasmHAS_VPU
+    #ifdef __riscv_vector
+        #define portasmHAS_VPU 1
+    #else
+        #define portasmHAS_VPU 0
+    #endif
+#endif
+
+#if ( portasmHAS_FPU != 0 ) || ( portasmHAS_VPU != 0 )
+    #define portasmHAS_EXTENDED_CONTEXT 1
+#else
+    #define portasmHAS_EXTENDED_CONTEXT 0
+#endif
+
+/* mstatus.FS and mstatus.VS each hold 0 (Off), 1 (Initial), 2 (Clean) or 3
+ * (Dirty).  Clean is treated as Dirty - it only means the registers are
+ * unchanged since they were restored, and another task may since have used
+ * them. */
+#define portMSTATUS_FS_SHIFT        13
+#define portMSTATUS_FS_MASK         0x6000
+#define portMSTATUS_FS_INITIAL      0x2000
+#define portMSTATUS_FS_DIRTY        0x6000
+#define portMSTATUS_VS_SHIFT        9
+#define portMSTATUS_VS_MASK         0x0600
+#define portMSTATUS_VS_INITIAL      0x0200
+#define portMSTATUS_VS_DIRTY        0x0600
+#define portMSTATUS_XS_CLEAN        2
+
+#define portEXTENDED_HEADER_SIZE    ( 4 * portWORD_SIZE )
+#define portEXTENDED_FPU_SAVED      1
+#define portEXTENDED_VPU_SAVED      2
+
+#if( portasmHAS_FPU != 0 )
+    #if( __riscv_flen == 64 )
+        #define store_f fsd
+        #define load_f fld
+        #define portFPREG_SIZE 8
+    #else
+        #define store_f fsw
+        #define load_f flw
+        #define portFPREG_SIZE 4
+    #endif
+    #define portFPU_CONTEXT_SIZE    ( ( 32 * portFPREG_SIZE ) + 16 ) /* f0-f31 then fcsr, padded to keep 16-byte alignment. */
+#endif
+
+#if( portasmHAS_VPU != 0 )
+    #define portVPU_CSR_SIZE        ( 4 * portWORD_SIZE ) /* vstart, vcsr, vl and vtype. */
+#endif
+
+/* Core local interrupt controller (CLIC) support.  A chip specific extensions
+ * header defines portasmHAS_CLIC to 1 when the core runs in CLIC mode, in
+ * which case configUSE_CLIC must also be set to 1 in FreeRTOSConfig.h.  Each
+ * interrupt then has a level, and:
+ *
+ * + Interrupts with a level at or below configMAX_SYSCALL_INTERRUPT_PRIORITY
+ *   are handled by the kernel's trap handling code below, either through the
+ *   common trap handler or by pointing their mtvt entry at one of the
+ *   freertos_risc_v_*_handler entry points.  They can use the FreeRTOS API,
+ *   and are masked by critical sections, which raise mintthresh rather than
+ *   clearing mstatus.MIE.  They do not nest with each other.
+ *
+ * + Interrupts with a level above configMAX_SYSCALL_INTERRUPT_PRIORITY are
+ *   never masked by the kernel and nest within the kernel's own trap handling.
+ *   They are vectored (selective hardware vectoring) directly to a handler
+ *   that saves only what it uses - for example a function with GCC's
+ *   __attribute__(( interrupt )) - on whatever stack is in use, and must not
+ *   call the FreeRTOS API.
+ *
+ * In CLIC mode mcause also carries the previous interrupt level, so the
+ * kernel passes only the exception code (the low 12 bits of mcause) to
+ * freertos_risc_v_application_interrupt_handler() and
+ * freertos_risc_v_application_exception_handler(). */
+#ifndef portasmHAS_CLIC
+    #define portasmHAS_CLIC 0
+#endif
+
+#if( portasmHAS_CLIC != 0 )
+    #define portCLIC_MINTTHRESH     0x347
+    #define portMCAUSE_MPIL_MASK    0x00FF0000
+    #define portMCAUSE_CODE_SHIFT   ( __riscv_xlen - 12 )
+#endif
+
 /*-----------------------------------------------------------*/
 
 .extern pxCurrentTCB
 .extern xISRStackTop
 .extern xCriticalNesting
 .extern pxCriticalNesting
+#if( portasmHAS_CLIC != 0 )
+    .extern uxPortClicSyscallThreshold
+#endif
+/*-----------------------------------------------------------*/
+
+/* Reduce the mcause value in reg to its exception code when in CLIC mode. */
+.macro portcontextGET_CAUSE_CODE reg
+#if( portasmHAS_CLIC != 0 )
+    slli \reg, \reg, portMCAUSE_CODE_SHIFT
+    srli \reg, \reg, portMCAUSE_CODE_SHIFT
+#endif
+    .endm
+/*-----------------------------------------------------------*/
+
+/* Once the task context is saved and sp is on the ISR stack, let interrupts
+ * above configMAX_SYSCALL_INTERRUPT_PRIORITY preempt the rest of the trap
+ * handling.  Interrupts at or below it stay masked by mintthresh, so the ISR
+ * stack is never re-entered.  Uses t0. */
+.macro portcontextENABLE_INTERRUPT_NESTING
+#if( portasmHAS_CLIC != 0 )
+    load_x t0, uxPortClicSyscallThreshold
+    csrw portCLIC_MINTTHRESH, t0
+    csrsi mstatus, 8
+#endif
+    .endm
+/*-----------------------------------------------------------*/
+
+.macro portcontextSAVE_EXTENDED_CONTEXT
+#if( portasmHAS_EXTENDED_CONTEXT != 0 )
+    /* On entry t0 holds the task's mstatus.  x5-x31 are already saved so t1-t6
+     * are free. */
+    mv t5, sp                            /* Remember where the integer frame starts. */
+    andi sp, sp, -16                     /* The extended state is kept 16-byte aligned. */
+    li t6, 0                             /* Records which state is saved. */
+
+#if( portasmHAS_FPU != 0 )
+    srli t1, t0, portMSTATUS_FS_SHIFT
+    andi t1, t1, 3
+    li t2, portMSTATUS_XS_CLEAN
+    blt t1, t2, 1f                       /* FS is Off or Initial, so the task has not used the FPU. */
+    addi sp, sp, -portFPU_CONTEXT_SIZE
+    store_f f0, 0 * portFPREG_SIZE( sp )
+    store_f f1, 1 * portFPREG_SIZE( sp )
+    store_f f2, 2 * portFPREG_SIZE( sp )
+    store_f f3, 3 * portFPREG_SIZE( sp )
+    store_f f4, 4 * portFPREG_SIZE( sp )
+    store_f f5, 5 * portFPREG_SIZE( sp )
+    store_f f6, 6 * portFPREG_SIZE( sp )
+    store_f f7, 7 * portFPREG_SIZE( sp )
+    store_f f8, 8 * portFPREG_SIZE( sp )
+    store_f f9, 9 * portFPREG_SIZE( sp )
+    store_f f10, 10 * portFPREG_SIZE( sp )
+    store_f f11, 11 * portFPREG_SIZE( sp )
+    store_f f12, 12 * portFPREG_SIZE( sp )
+    store_f f13, 13 * portFPREG_SIZE( sp )
+    store_f f14, 14 * portFPREG_SIZE( sp )
+    store_f f15, 15 * portFPREG_SIZE( sp )
+    store_f f16, 16 * portFPREG_SIZE( sp )
+    store_f f17, 17 * portFPREG_SIZE( sp )
+    store_f f18, 18 * portFPREG_SIZE( sp )
+    store_f f19, 19 * portFPREG_SIZE( sp )
+    store_f f20, 20 * portFPREG_SIZE( sp )
+    store_f f21, 21 * portFPREG_SIZE( sp )
+    store_f f22, 22 * portFPREG_SIZE( sp )
+    store_f f23, 23 * portFPREG_SIZE( sp )
+    store_f f24, 24 * portFPREG_SIZE( sp )
+    store_f f25, 25 * portFPREG_SIZE( sp )
+    store_f f26, 26 * portFPREG_SIZE( sp )
+    store_f f27, 27 * portFPREG_SIZE( sp )
+    store_f f28, 28 * portFPREG_SIZE( sp )
+    store_f f29, 29 * portFPREG_SIZE( sp )
+    store_f f30, 30 * portFPREG_SIZE( sp )
+    store_f f31, 31 * portFPREG_SIZE( sp )
+    csrr t1, fcsr
+    sw t1, 32 * portFPREG_SIZE( sp )
+    ori t6, t6, portEXTENDED_FPU_SAVED
+1:
+#endif /* portasmHAS_FPU */
+
+#if( portasmHAS_VPU != 0 )
+    srli t1, t0, portMSTATUS_VS_SHIFT
+    andi t1, t1, 3
+    li t2, portMSTATUS_XS_CLEAN
+    blt t1, t2, 2f                       /* VS is Off or Initial, so the task has not used the vector unit. */
+    csrr t3, vlenb
+    slli t3, t3, 3                       /* Bytes in a group of eight vector registers. */
+    slli t4, t3, 2                       /* Bytes in all 32 vector registers. */
+    addi t4, t4, portVPU_CSR_SIZE
+    sub sp, sp, t4
+    csrr t1, vstart
+    store_x t1, 0 * portWORD_SIZE( sp )
+    csrr t1, vcsr
+    store_x t1, 1 * portWORD_SIZE( sp )
+    csrr t1, vl
+    store_x t1, 2 * portWORD_SIZE( sp )
+    csrr t1, vtype
+    store_x t1, 3 * portWORD_SIZE( sp )
+    csrw vstart, x0                      /* Whole register stores only start from vstart. */
+    addi t1, sp, portVPU_CSR_SIZE
+    vs8r.v v0, ( t1 )                    /* Whole register stores do not depend on vl or vtype. */
+    add t1, t1, t3
+    vs8r.v v8, ( t1 )
+    add t1, t1, t3
+    vs8r.v v16, ( t1 )
+    add t1, t1, t3
+    vs8r.v v24, ( t1 )
+    ori t6, t6, portEXTENDED_VPU_SAVED
+2:
+#endif /* portasmHAS_VPU */
+
+    addi sp, sp, -portEXTENDED_HEADER_SIZE
+    store_x t6, 1 * portWORD_SIZE( sp )  /* Slot 0 is left for mepc or the chip specific registers. */
+    store_x t5, 2 * portWORD_SIZE( sp )
+#endif /* portasmHAS_EXTENDED_CONTEXT */
+    .endm
+/*-----------------------------------------------------------*/
+
+.macro portcontextRESTORE_EXTENDED_CONTEXT
+#if( portasmHAS_EXTENDED_CONTEXT != 0 )
+    /* On entry sp points to the header written by
+     * portcontextSAVE_EXTENDED_CONTEXT or pxPortInitialiseStack().  mstatus is
+     * written from the task's saved value afterwards, so the FS and VS fields
+     * set here to access the registers do not leak into the task. */
+    load_x t6, 1 * portWORD_SIZE( sp )   /* Which state was saved. */
+    load_x t5, 2 * portWORD_SIZE( sp )   /* Where the integer frame starts. */
+    andi t4, t5, -16
+
+#if( portasmHAS_FPU != 0 )
+    li t1, portMSTATUS_FS_DIRTY
+    csrs mstatus, t1
+    andi t1, t6, portEXTENDED_FPU_SAVED
+    bnez t1, 3f
+    csrw fcsr, x0                        /* The task has not used the FPU, so do not let it inherit another task's rounding mode or flags. */
+    j 4f
+3:
+    addi t4, t4, -portFPU_CONTEXT_SIZE
+    load_f  f0, 0 * portFPREG_SIZE( t4 )
+    load_f  f1, 1 * portFPREG_SIZE( t4 )
+    load_f  f2, 2 * portFPREG_SIZE( t4 )
+    load_f  f3, 3 * portFPREG_SIZE( t4 )
+    load_f  f4, 4 * portFPREG_SIZE( t4 )
+    load_f  f5, 5 * portFPREG_SIZE( t4 )
+    load_f  f6, 6 * portFPREG_SIZE( t4 )
+    load_f  f7, 7 * portFPREG_SIZE( t4 )
+    load_f  f8, 8 * portFPREG_SIZE( t4 )
+    load_f  f9, 9 * portFPREG_SIZE( t4 )
+    load_f  f10, 10 * portFPREG_SIZE( t4 )
+    load_f  f11, 11 * portFPREG_SIZE( t4 )
+    load_f  f12, 12 * portFPREG_SIZE( t4 )
+    load_f  f13, 13 * portFPREG_SIZE( t4 )
+    load_f  f14, 14 * portFPREG_SIZE( t4 )
+    load_f  f15, 15 * portFPREG_SIZE( t4 )
+    load_f  f16, 16 * portFPREG_SIZE( t4 )
+    load_f  f17, 17 * portFPREG_SIZE( t4 )
+    load_f  f18, 18 * portFPREG_SIZE( t4 )
+    load_f  f19, 19 * portFPREG_SIZE( t4 )
+    load_f  f20, 20 * portFPREG_SIZE( t4 )
+    load_f  f21, 21 * portFPREG_SIZE( t4 )
+    load_f  f22, 22 * portFPREG_SIZE( t4 )
+    load_f  f23, 23 * portFPREG_SIZE( t4 )
+    load_f  f24, 24 * portFPREG_SIZE( t4 )
+    load_f  f25, 25 * portFPREG_SIZE( t4 )
+    load_f  f26, 26 * portFPREG_SIZE( t4 )
+    load_f  f27, 27 * portFPREG_SIZE( t4 )
+    load_f  f28, 28 * portFPREG_SIZE( t4 )
+    load_f  f29, 29 * portFPREG_SIZE( t4 )
+    load_f  f30, 30 * portFPREG_SIZE( t4 )
+    load_f  f31, 31 * portFPREG_SIZE( t4 )
+    lw t1, 32 * portFPREG_SIZE( t4 )
+    csrw fcsr, t1
+4:
+#endif /* portasmHAS_FPU */
+
+#if( portasmHAS_VPU != 0 )
+    li t1, portMSTATUS_VS_DIRTY
+    csrs mstatus, t1
+    andi t1, t6, portEXTENDED_VPU_SAVED
+    bnez t1, 5f
+    csrw vcsr, x0                        /* As for fcsr above. */
+    j 6f
+5:
+    csrr t3, vlenb
+    slli t3, t3, 3
+    slli t2, t3, 2
+    addi t2, t2, portVPU_CSR_SIZE
+    sub t4, t4, t2
+    csrw vstart, x0
+    addi t1, t4, portVPU_CSR_SIZE
+    vl8re8.v v0, ( t1 )
+    add t1, t1, t3
+    vl8re8.v v8, ( t1 )
+    add t1, t1, t3
+    vl8re8.v v16, ( t1 )
+    add t1, t1, t3
+    vl8re8.v v24, ( t1 )
+    load_x t1, 2 * portWORD_SIZE( t4 )   /* vl. */
+    load_x t2, 3 * portWORD_SIZE( t4 )   /* vtype. */
+    vsetvl x0, t1, t2                    /* The saved vl is within VLMAX for the saved vtype so is restored exactly. */
+    load_x t1, 1 * portWORD_SIZE( t4 )
+    csrw vcsr, t1
+    load_x t1, 0 * portWORD_SIZE( t4 )
+    csrw vstart, t1                      /* Last, as vsetvl clears vstart. */
+6:
+#endif /* portasmHAS_VPU */
+
+    mv sp, t5
+#endif /* portasmHAS_EXTENDED_CONTEXT */
+    .endm
 /*-----------------------------------------------------------*/
 
 .macro portcontextSAVE_CONTEXT_INTERNAL
@@ -106,6 +428,7 @@
     csrr t0, mstatus                     /* Required for MPIE bit. */
     store_x t0, portMSTATUS_OFFSET * portWORD_SIZE( sp )
 
+    portcontextSAVE_EXTENDED_CONTEXT     /* Save any floating point and vector state the task is using. */
 
     portasmSAVE_ADDITIONAL_REGISTERS     /* Defined in freertos_risc_v_chip_specific_extensions.h to save any registers unique to the RISC-V implementation. */
 
@@ -122,6 +445,8 @@
     addi a1, a1, 4                      /* Synchronous so update exception return address to the instruction after the instruction that generated the exception. */
     store_x a1, 0( sp )                 /* Save updated exception return address. */
     load_x sp, xISRStackTop             /* Switch to ISR stack. */
+    portcontextGET_CAUSE_CODE a0
+    portcontextENABLE_INTERRUPT_NESTING
     .endm
 /*-----------------------------------------------------------*/
 
@@ -131,10 +456,15 @@
     csrr a1, mepc
     store_x a1, 0( sp )                 /* Asynchronous interrupt so save unmodified exception return address. */
     load_x sp, xISRStackTop             /* Switch to ISR stack. */
+    portcontextGET_CAUSE_CODE a0
+    portcontextENABLE_INTERRUPT_NESTING
     .endm
 /*-----------------------------------------------------------*/
 
 .macro portcontextRESTORE_CONTEXT
+#if( portasmHAS_CLIC != 0 )
+    csrci mstatus, 8                        /* No nesting from here, as mepc is about to be written. */
+#endif
     load_x  t1, pxCurrentTCB                /* Load pxCurrentTCB. */
         load_x  sp, 0( t1 )                 /* Read sp from first TCB member. */
 
@@ -145,6 +475,9 @@
     /* Defined in freertos_risc_v_chip_specific_extensions.h to restore any registers unique to the RISC-V implementation. */
     portasmRESTORE_ADDITIONAL_REGISTERS
 
+    /* Restore any floating point and vector state, leaving sp at the integer frame. */
+    portcontextRESTORE_EXTENDED_CONTEXT
+
     /* Load mstatus with the interrupt enable bits used by the task. */
     load_x  t0, portMSTATUS_OFFSET * portWORD_SIZE( sp )
     csrw mstatus, t0                        /* Required for MPIE bit. */
@@ -153,6 +486,19 @@
     load_x  t1, pxCriticalNesting           /* Load the address of xCriticalNesting into t1. */
     store_x t0, 0( t1 )                     /* Restore the critical nesting value for this task. */
 
+#if( portasmHAS_CLIC != 0 )
+    /* Critical sections mask interrupts with mintthresh, so set it from the
+     * task's critical nesting count.  Tasks run at interrupt level 0, so make
+     * mret return to level 0 whichever trap is being returned from. */
+    mv t2, x0
+    beqz t0, 7f
+    load_x t2, uxPortClicSyscallThreshold
+7:
+    csrw portCLIC_MINTTHRESH, t2
+    li t2, portMCAUSE_MPIL_MASK
+    csrc mcause, t2
+#endif
+
     load_x  x1, 1 * portWORD_SIZE( sp )
     load_x  x5, 2 * portWORD_SIZE( sp )
     load_x  x6, 3 * portWORD_SIZE( sp )
@@ -94,14 +94,45 @@ extern void vTaskSwitchContext( void );
 #define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
 /*-----------------------------------------------------------*/
 
+/* Tickless idle/low power functionality.  port.c implements
+ * vPortSuppressTicksAndSleep() using mtimecmp when configMTIME_BASE_ADDRESS and
+ * configMTIMECMP_BASE_ADDRESS are non-zero.  Chips without an mtime clock must
+ * provide their own implementation. */
+#if( configUSE_TICKLESS_IDLE == 1 )
+    #ifndef portSUPPRESS_TICKS_AND_SLEEP
+        extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+        #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+    #endif
+#endif
+/*-----------------------------------------------------------*/
+
 /* Critical section management. */
 #define portCRITICAL_NESTING_IN_TCB                             0
 
 #define portSET_INTERRUPT_MASK_FROM_ISR()                       0
 #define portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedStatusValue ) ( void ) uxSavedStatusValue
 
-#define portDISABLE_INTERRUPTS()    __asm volatile( "csrc mstatus, 8" )
-#define portENABLE_INTERRUPTS()     __asm volatile( "csrs mstatus, 8" )
+/* Set configUSE_CLIC to 1 when the core runs its interrupt controller in CLIC
+ * mode, and use a chip specific extensions header that sets portasmHAS_CLIC to
+ * 1 (such as RV32I_CLIC_no_extensions).  Critical sections then only mask
+ * interrupts at or below configMAX_SYSCALL_INTERRUPT_PRIORITY, by raising the
+ * mintthresh CSR, so higher level interrupts are never delayed by the kernel.
+ * Such interrupts must not call the FreeRTOS API - see portContext.h. */
+#ifndef configUSE_CLIC
+    #define configUSE_CLIC 0
+#endif
+
+#if( configUSE_CLIC == 1 )
+    #ifndef configMAX_SYSCALL_INTERRUPT_PRIORITY
+        #error configMAX_SYSCALL_INTERRUPT_PRIORITY must be set to the highest CLIC interrupt level that can use the FreeRTOS API when configUSE_CLIC is 1.
+    #endif
+
+    #define portDISABLE_INTERRUPTS()    __asm volatile( "csrw 0x347, %0" :: "r"( configMAX_SYSCALL_INTERRUPT_PRIORITY ) : "memory" )
+    #define portENABLE_INTERRUPTS()     __asm volatile( "csrw 0x347, x0" ::: "memory" )
+#else
+    #define portDISABLE_INTERRUPTS()    __asm volatile( "csrc mstatus, 8" )
+    #define portENABLE_INTERRUPTS()     __asm volatile( "csrs mstatus, 8" )
+#endif
 
 extern size_t xCriticalNesting;
 #define portENTER_CRITICAL()            \
@@ -162,6 +193,26 @@ extern size_t xCriticalNesting;
 #endif
 
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
+
+/* With the A extension the __atomic built-in functions compile to AMO and
+ * LR/SC instructions, so atomic.h does not need to mask interrupts. */
+#ifdef __riscv_atomic
+    #define portHAS_NATIVE_ATOMICS 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Cycle counter, read by the cycle benchmark (configUSE_CYCLE_BENCHMARK).  Only
+ * the low word of mcycle is read on RV32, which is enough for the differences
+ * the benchmark takes.  mcycle runs from reset unless the application has
+ * inhibited it in mcountinhibit. */
+portFORCE_INLINE static UBaseType_t uxPortGetCycleCount( void )
+{
+UBaseType_t uxCycles;
+
+    __asm volatile( "csrr %0, mcycle" : "=r"( uxCycles ) );
+    return uxCycles;
+}
+#define portGET_CYCLE_COUNT() ( ( uint32_t ) uxPortGetCycleCount() )
 /*-----------------------------------------------------------*/
 
 /* configCLINT_BASE_ADDRESS is a legacy definition that was replaced by the
@@ -99,6 +99,7 @@
         #define portFORCE_INLINE               inline __attribute__( ( always_inline ) )
     #endif
     #define portHAS_STACK_OVERFLOW_CHECKING    1
+    #define portHAS_STACK_LIMIT_REGISTER       1 /* PSPLIM. */
 /*-----------------------------------------------------------*/
 
 /**
@@ -123,6 +124,10 @@
         extern BaseType_t xIsPrivileged( void ) /* __attribute__ (( naked )) */;
         extern void vResetPrivilege( void ) /* __attribute__ (( naked )) */;
     #endif /* configENABLE_MPU */
+
+    #if ( ( configENABLE_FPU == 1 ) || ( configENABLE_MVE == 1 ) )
+        extern void vPortTaskReleaseFPUContext( void ) /* PRIVILEGED_FUNCTION */;
+    #endif /* configENABLE_FPU || configENABLE_MVE */
 /*-----------------------------------------------------------*/
 
 /**
@@ -270,6 +275,29 @@
     #endif /* configENABLE_TRUSTZONE */
 /*-----------------------------------------------------------*/
 
+    #if ( ( configENABLE_FPU == 1 ) || ( configENABLE_MVE == 1 ) )
+
+/**
+ * @brief Release the floating point and MVE (Helium) context of the calling
+ * task.
+ *
+ * The MVE vector registers are the floating point registers, so a task has a
+ * single floating point context covering both.  A task starts without one and
+ * gains one the first time it executes a floating point or MVE instruction.
+ * From then on the extended exception frame and s16-s31 are saved and
+ * restored each time the task is switched out and in.  Tasks that never use
+ * the FPU or MVE therefore never pay for the extended frame, but a task that
+ * only used them for a while - or called a library function, such as an MVE
+ * optimised memcpy(), that did - keeps paying.  Calling
+ * portTASK_RELEASE_FPU_CONTEXT() once the task no longer needs the registers
+ * stops that.  The register values are not preserved, so it must not be
+ * called while the calling function holds floating point or vector values in
+ * registers.  Must be called from a privileged task, never from an interrupt.
+ */
+        #define portTASK_RELEASE_FPU_CONTEXT()    vPortTaskReleaseFPUContext()
+    #endif /* configENABLE_FPU || configENABLE_MVE */
+/*-----------------------------------------------------------*/
+
     #if ( configENABLE_MPU == 1 )
 
 /**
@@ -49,10 +49,11 @@
 #define portTASK_THREAD_PRIORITY                 THREAD_PRIORITY_ABOVE_NORMAL
 
 /*
- * Created as a high priority thread, this function uses a timer to simulate
- * a tick interrupt being generated on an embedded target.  In this Windows
- * environment the timer does not achieve anything approaching real time
- * performance though.
+ * Created as a high priority thread, this function uses a waitable timer to
+ * simulate a tick interrupt being generated on an embedded target.  Where the
+ * host supports it (Windows 10 version 1803 onwards) the timer is a high
+ * resolution timer, so tick rates of 1KHz and above can be simulated in real
+ * time.  Otherwise tick timing is limited by the Windows timer resolution.
  */
 static DWORD WINAPI prvSimulatedPeripheralTimer( LPVOID lpParameter );
 
@@ -100,6 +101,18 @@ typedef struct
     between the call to SuspendThread() to suspend the thread and the
     asynchronous SuspendThread() operation actually being performed. */
     void *pvYieldEvent;
+
+    /* Set when the thread has committed to waiting on pvYieldEvent.  Such a
+    thread cannot run any further until the simulated interrupt thread signals
+    pvYieldEvent, which it only does once the task is selected to run again, so
+    switching away from it does not need SuspendThread().  Only accessed while
+    holding pvInterruptEventMutex. */
+    BaseType_t xWaitingForYield;
+
+    /* Set when the thread was switched out with SuspendThread(), so must be
+    resumed with ResumeThread().  Only accessed by the simulated interrupt
+    thread. */
+    BaseType_t xSuspended;
 } ThreadState_t;
 
 /* Simulated interrupts waiting to be processed.  This is a bit mask where each
@@ -139,42 +152,68 @@ static BaseType_t xPortRunning = pdFALSE;
 
 static DWORD WINAPI prvSimulatedPeripheralTimer( LPVOID lpParameter )
 {
-TickType_t xMinimumWindowsBlockTime;
 TIMECAPS xTimeCaps;
+void *pvTimer = NULL;
+LARGE_INTEGER xFrequency, xNow, xDueTime;
+LONGLONG llTickPeriod, llNextTick, llRemaining;
 
-    /* Set the timer resolution to the maximum possible. */
+    /* Set the timer resolution to the maximum possible.  This is still needed
+    if a high resolution waitable timer is not available. */
     if( timeGetDevCaps( &xTimeCaps, sizeof( xTimeCaps ) ) == MMSYSERR_NOERROR )
     {
-        xMinimumWindowsBlockTime = ( TickType_t ) xTimeCaps.wPeriodMin;
         timeBeginPeriod( xTimeCaps.wPeriodMin );
 
         /* Register an exit handler so the timeBeginPeriod() function can be
         matched with a timeEndPeriod() when the application exits. */
         SetConsoleCtrlHandler( prvEndProcess, TRUE );
     }
-    else
+
+    #ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
     {
-        xMinimumWindowsBlockTime = ( TickType_t ) 20;
+        /* Fails on hosts that predate high resolution timers. */
+        pvTimer = CreateWaitableTimerEx( NULL, NULL, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS );
     }
+    #endif
+
+    if( pvTimer == NULL )
+    {
+        pvTimer = CreateWaitableTimer( NULL, FALSE, NULL );
+    }
+
+    configASSERT( pvTimer );
 
     /* Just to prevent compiler warnings. */
     ( void ) lpParameter;
 
+    /* Tick times are calculated from the performance counter so the tick does
+    not drift by the time taken to process each tick. */
+    QueryPerformanceFrequency( &xFrequency );
+    llTickPeriod = xFrequency.QuadPart / configTICK_RATE_HZ;
+    QueryPerformanceCounter( &xNow );
+    llNextTick = xNow.QuadPart;
+
     while( xPortRunning == pdTRUE )
     {
-        /* Wait until the timer expires and we can access the simulated interrupt
-        variables.  *NOTE* this is not a 'real time' way of generating tick
-        events as the next wake time should be relative to the previous wake
-        time, not the time that Sleep() is called.  It is done this way to
-        prevent overruns in this very non real time simulated/emulated
-        environment. */
-        if( portTICK_PERIOD_MS < xMinimumWindowsBlockTime )
+        /* Wait until the next tick is due and we can access the simulated
+        interrupt variables. */
+        llNextTick += llTickPeriod;
+        QueryPerformanceCounter( &xNow );
+        llRemaining = llNextTick - xNow.QuadPart;
+
+        if( llRemaining < -llTickPeriod )
         {
-            Sleep( xMinimumWindowsBlockTime );
+            /* More than a tick period behind, for example because the host
+            was busy.  Don't try to catch up by generating ticks back to back,
+            as doing so would just cause overruns in this very non real time
+            simulated/emulated environment. */
+            llNextTick = xNow.QuadPart;
         }
-        else
+        else if( llRemaining > 0 )
         {
-            Sleep( portTICK_PERIOD_MS );
+            /* A negative due time is relative, in 100ns units. */
+            xDueTime.QuadPart = -( ( llRemaining * 10000000LL ) / xFrequency.QuadPart );
+            SetWaitableTimer( pvTimer, &xDueTime, 0, NULL, NULL, FALSE );
+            WaitForSingleObject( pvTimer, INFINITE );
         }
 
         if( xPortRunning == pdTRUE )
@@ -201,6 +240,7 @@ TIMECAPS xTimeCaps;
         }
     }
 
+    CloseHandle( pvTimer );
 
     return 0;
 }
@@ -244,6 +284,10 @@ const SIZE_T xStackSize = 1024; /* Set the size to a small number which will get
                                                 FALSE, /* Auto reset. */
                                                 FALSE, /* Start not signalled. */
                                                 NULL );/* No name. */
+    pxThreadState->xWaitingForYield = pdFALSE;
+
+    /* The thread is created suspended. */
+    pxThreadState->xSuspended = pdTRUE;
 
     /* Create the thread itself. */
     pxThreadState->pvThread = CreateThread( NULL, xStackSize, ( LPTHREAD_START_ROUTINE ) pxCode, pvParameters, CREATE_SUSPENDED | STACK_SIZE_PARAM_IS_A_RESERVATION, NULL );
@@ -338,6 +382,7 @@ SYSTEM_INFO xSystemInfo;
         ulCriticalNesting = portNO_CRITICAL_NESTING;
 
         /* Start the first task. */
+        pxThreadState->xSuspended = pdFALSE;
         ResumeThread( pxThreadState->pvThread );
 
         /* Handle all simulated interrupts - including yield requests and
@@ -443,27 +488,33 @@ CONTEXT xContext;
             that is already in the running state. */
             if( pvOldCurrentTCB != pxCurrentTCB )
             {
-                /* Suspend the old thread.  In the cases where the (simulated)
-                interrupt is asynchronous (tick event swapping a task out rather
-                than a task blocking or yielding) it doesn't matter if the
-                'suspend' operation doesn't take effect immediately - if it
-                doesn't it would just be like the interrupt occurring slightly
-                later.  In cases where the yield was caused by a task blocking
-                or yielding then the task will block on a yield event after the
-                yield operation in case the 'suspend' operation doesn't take
-                effect immediately.  */
                 pxThreadState = ( ThreadState_t *) *( ( size_t * ) pvOldCurrentTCB );
-                SuspendThread( pxThreadState->pvThread );
-
-                /* Ensure the thread is actually suspended by performing a
-                synchronous operation that can only complete when the thread is
-                actually suspended.  The below code asks for dummy register
-                data.  Experimentation shows that these two lines don't appear
-                to do anything now, but according to
-                https://devblogs.microsoft.com/oldnewthing/20150205-00/?p=44743
-                they do - so as they do not harm (slight run-time hit). */
-                xContext.ContextFlags = CONTEXT_INTEGER;
-                ( void ) GetThreadContext( pxThreadState->pvThread, &xContext );
+
+                /* A task that blocked or yielded is already committed to
+                waiting on its yield event, which is not signalled again until
+                the task is next selected to run, so it does not need to be
+                suspended. */
+                if( pxThreadState->xWaitingForYield == pdFALSE )
+                {
+                    /* Suspend the old thread.  The (simulated) interrupt is
+                    asynchronous (tick event swapping a task out rather than a
+                    task blocking or yielding), so it doesn't matter if the
+                    'suspend' operation doesn't take effect immediately - if it
+                    doesn't it would just be like the interrupt occurring
+                    slightly later. */
+                    SuspendThread( pxThreadState->pvThread );
+                    pxThreadState->xSuspended = pdTRUE;
+
+                    /* Ensure the thread is actually suspended by performing a
+                    synchronous operation that can only complete when the thread
+                    is actually suspended.  The below code asks for dummy
+                    register data.  Experimentation shows that these two lines
+                    don't appear to do anything now, but according to
+                    https://devblogs.microsoft.com/oldnewthing/20150205-00/?p=44743
+                    they do - so as they do not harm (slight run-time hit). */
+                    xContext.ContextFlags = CONTEXT_INTEGER;
+                    ( void ) GetThreadContext( pxThreadState->pvThread, &xContext );
+                }
 
                 /* Obtain the state of the task now selected to enter the
                 Running state. */
@@ -472,7 +523,12 @@ CONTEXT xContext;
                 /* pxThreadState->pvThread can be NULL if the task deleted
                 itself - but a deleted task should never be resumed here. */
                 configASSERT( pxThreadState->pvThread != NULL );
-                ResumeThread( pxThreadState->pvThread );
+
+                if( pxThreadState->xSuspended != pdFALSE )
+                {
+                    pxThreadState->xSuspended = pdFALSE;
+                    ResumeThread( pxThreadState->pvThread );
+                }
             }
         }
 
@@ -485,6 +541,7 @@ CONTEXT xContext;
         the task was switched out asynchronously by an interrupt as the event
         is reset before the task blocks on it. */
         pxThreadState = ( ThreadState_t * ) ( *( size_t *) pxCurrentTCB );
+        pxThreadState->xWaitingForYield = pdFALSE;
         SetEvent( pxThreadState->pvYieldEvent );
         ReleaseMutex( pvInterruptEventMutex );
     }
@@ -594,6 +651,7 @@ ThreadState_t *pxThreadState = ( ThreadState_t *) *( ( size_t * ) pxCurrentTCB )
             /* Going to wait for an event - make sure the event is not already
             signaled. */
             ResetEvent( pxThreadState->pvYieldEvent );
+            pxThreadState->xWaitingForYield = pdTRUE;
         }
 
         ReleaseMutex( pvInterruptEventMutex );
@@ -677,6 +735,7 @@ int32_t lMutexNeedsReleasing;
                 critical section is exited - so make sure the event is not
                 already signaled. */
                 ResetEvent( pxThreadState->pvYieldEvent );
+                pxThreadState->xWaitingForYield = pdTRUE;
 
                 /* Mutex will be released now so the (simulated) interrupt can
                 execute, so does not require releasing on function exit. */
@@ -66,6 +66,9 @@
 /* Index into the ucHeap array. */
 static size_t xNextFreeByte = ( size_t ) 0;
 
+/* Reported by vPortGetHeapStats(). */
+static size_t xNumberOfSuccessfulAllocations = 0;
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
@@ -108,6 +111,7 @@ void * pvPortMalloc( size_t xWantedSize )
              * block. */
             pvReturn = pucAlignedHeap + xNextFreeByte;
             xNextFreeByte += xWantedSize;
+            xNumberOfSuccessfulAllocations++;
         }
 
         traceMALLOC( pvReturn, xWantedSize );
@@ -150,3 +154,39 @@ size_t xPortGetFreeHeapSize( void )
 {
     return( configADJUSTED_HEAP_SIZE - xNextFreeByte );
 }
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    size_t xFreeBytes;
+
+    vTaskSuspendAll();
+    {
+        xFreeBytes = configADJUSTED_HEAP_SIZE - xNextFreeByte;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+    }
+    ( void ) xTaskResumeAll();
+
+    /* The unallocated end of the heap is the only free block, and as memory is
+     * never freed the free space only ever goes down. */
+    pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytes;
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xFreeBytes;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xFreeBytes;
+    pxHeapStats->xNumberOfFreeBlocks = ( xFreeBytes > ( size_t ) 0 ) ? ( size_t ) 1 : ( size_t ) 0;
+    pxHeapStats->xMinimumEverFreeBytesRemaining = xFreeBytes;
+    pxHeapStats->xNumberOfSuccessfulFrees = 0;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    void vPortWalkFreeBlocks( HeapFreeBlockFunction_t pxFunction,
+                              void * pvContext )
+    {
+        /* Memory is never freed using this scheme, so there is no free list to
+         * walk - the unallocated space is reported by xPortGetFreeHeapSize(). */
+        ( void ) pxFunction;
+        ( void ) pvContext;
+    }
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
@@ -81,6 +81,25 @@
 #define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
 #define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* Reads the run time stats counter into ulTime, if there is one. */
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+        #else
+            #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+        #endif
+    #else
+        #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    ( ulTime ) = 0
+    #endif
+
+/* Counts the free blocks pvPortMalloc() steps over. */
+    #define heapCOUNT_BLOCK_WALKED()    ( xBlocksWalked++ )
+#else
+    #define heapCOUNT_BLOCK_WALKED()
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*-----------------------------------------------------------*/
 
 /* Allocate the memory for the heap. */
@@ -113,6 +132,19 @@ PRIVILEGED_DATA static BlockLink_t xStart, xEnd;
  * fragmentation. */
 PRIVILEGED_DATA static size_t xFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
 
+/* Reported by vPortGetHeapStats(). */
+PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
+PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* The histograms recorded by pvPortMalloc().  xFreeBlockSizes is only filled
+ * in when the histograms are read. */
+    PRIVILEGED_DATA static HeapInstrumentation_t xInstrumentation;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -120,6 +152,25 @@ PRIVILEGED_DATA static size_t xFreeBytesRemaining = configADJUSTED_HEAP_SIZE;
  */
 static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/*
+ * Returns the histogram bucket that xValue falls into.
+ */
+    static UBaseType_t prvInstrumentationBucket( size_t xValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records a call to pvPortMalloc() that was passed xRequestedSize, returned
+ * pvReturn, stepped over xBlocksWalked free blocks and took ulMallocTime run
+ * time counter ticks.  Must be called with the scheduler suspended.
+ */
+    static void prvInstrumentMalloc( size_t xRequestedSize,
+                                     const void * pvReturn,
+                                     size_t xBlocksWalked,
+                                     configRUN_TIME_COUNTER_TYPE ulMallocTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*-----------------------------------------------------------*/
 
 /* STATIC FUNCTIONS ARE DEFINED AS MACROS TO MINIMIZE THE FUNCTION CALL DEPTH. */
@@ -159,8 +210,19 @@ void * pvPortMalloc( size_t xWantedSize )
     void * pvReturn = NULL;
     size_t xAdditionalRequiredSize;
 
+    #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        size_t xRequestedSize = xWantedSize;
+        size_t xBlocksWalked = 0;
+        configRUN_TIME_COUNTER_TYPE ulStartTime, ulEndTime;
+    #endif
+
     vTaskSuspendAll();
     {
+        #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        {
+            heapGET_RUN_TIME_COUNTER_VALUE( ulStartTime );
+        }
+        #endif
         /* If this is the first call to malloc then the heap will require
          * initialisation to setup the list of free blocks. */
         if( xHeapHasBeenInitialised == pdFALSE )
@@ -203,6 +265,7 @@ void * pvPortMalloc( size_t xWantedSize )
                 {
                     pxPreviousBlock = pxBlock;
                     pxBlock = pxBlock->pxNextFreeBlock;
+                    heapCOUNT_BLOCK_WALKED();
                 }
 
                 /* If we found the end marker then a block of adequate size was not found. */
@@ -235,6 +298,13 @@ void * pvPortMalloc( size_t xWantedSize )
 
                     xFreeBytesRemaining -= pxBlock->xBlockSize;
 
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+
+                    xNumberOfSuccessfulAllocations++;
+
                     /* The block is being returned - it is allocated and owned
                      * by the application and has no "next" block. */
                     heapALLOCATE_BLOCK( pxBlock );
@@ -243,6 +313,13 @@ void * pvPortMalloc( size_t xWantedSize )
             }
         }
 
+        #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        {
+            heapGET_RUN_TIME_COUNTER_VALUE( ulEndTime );
+            prvInstrumentMalloc( xRequestedSize, pvReturn, xBlocksWalked, ulEndTime - ulStartTime );
+        }
+        #endif
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -296,6 +373,7 @@ void vPortFree( void * pv )
                     /* Add this block to the list of free blocks. */
                     prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
                     xFreeBytesRemaining += pxLink->xBlockSize;
+                    xNumberOfSuccessfulFrees++;
                     traceFREE( pv, pxLink->xBlockSize );
                 }
                 ( void ) xTaskResumeAll();
@@ -311,6 +389,64 @@ size_t xPortGetFreeHeapSize( void )
 }
 /*-----------------------------------------------------------*/
 
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    const BlockLink_t * pxBlock;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* pxBlock will be NULL if the heap has not been initialised.  The heap
+         * is initialised automatically when the first allocation is made. */
+        for( pxBlock = xStart.pxNextFreeBlock; ( pxBlock != NULL ) && ( pxBlock != &xEnd ); pxBlock = pxBlock->pxNextFreeBlock )
+        {
+            xBlocks++;
+
+            if( pxBlock->xBlockSize > xMaxSize )
+            {
+                xMaxSize = pxBlock->xBlockSize;
+            }
+
+            if( pxBlock->xBlockSize < xMinSize )
+            {
+                xMinSize = pxBlock->xBlockSize;
+            }
+        }
+
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    void vPortWalkFreeBlocks( HeapFreeBlockFunction_t pxFunction,
+                              void * pvContext )
+    {
+        const BlockLink_t * pxBlock;
+
+        /* pxBlock will be NULL if the heap has not been initialised.  The NULL
+         * check also ends the walk if a corrupt link is found. */
+        for( pxBlock = xStart.pxNextFreeBlock; ( pxBlock != NULL ) && ( pxBlock != &xEnd ); pxBlock = pxBlock->pxNextFreeBlock )
+        {
+            if( pxFunction( pxBlock, pxBlock->xBlockSize, pvContext ) == pdFALSE )
+            {
+                break;
+            }
+        }
+    }
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
     /* This just exists to keep the linker quiet. */
@@ -360,3 +496,90 @@ static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
     pxFirstFreeBlock->pxNextFreeBlock = &xEnd;
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+    static UBaseType_t prvInstrumentationBucket( size_t xValue ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxBucket = 0;
+
+        while( ( xValue > ( size_t ) 1U ) && ( uxBucket < ( ( UBaseType_t ) configHEAP_INSTRUMENTATION_BUCKETS - 1U ) ) )
+        {
+            xValue >>= 1;
+            uxBucket++;
+        }
+
+        return uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInstrumentMalloc( size_t xRequestedSize,
+                                     const void * pvReturn,
+                                     size_t xBlocksWalked,
+                                     configRUN_TIME_COUNTER_TYPE ulMallocTime ) /* PRIVILEGED_FUNCTION */
+    {
+        xInstrumentation.xAllocationSizes[ prvInstrumentationBucket( xRequestedSize ) ]++;
+
+        if( pvReturn == NULL )
+        {
+            xInstrumentation.xNumberOfFailedAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBlocksWalked > xInstrumentation.xLongestFreeListWalk )
+        {
+            xInstrumentation.xLongestFreeListWalk = xBlocksWalked;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            xInstrumentation.xMallocTimes[ prvInstrumentationBucket( ( size_t ) ulMallocTime ) ]++;
+        }
+        #endif
+
+        traceMALLOC_INSTRUMENTATION( pvReturn, xRequestedSize, xBlocksWalked, ulMallocTime );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapInstrumentation( HeapInstrumentation_t * pxHeapInstrumentation )
+    {
+        BlockLink_t * pxBlock;
+
+        vTaskSuspendAll();
+        {
+            *pxHeapInstrumentation = xInstrumentation;
+
+            /* pxBlock will be NULL if the heap has not been initialised. */
+            pxBlock = xStart.pxNextFreeBlock;
+
+            if( pxBlock != NULL )
+            {
+                while( pxBlock != &xEnd )
+                {
+                    pxHeapInstrumentation->xFreeBlockSizes[ prvInstrumentationBucket( pxBlock->xBlockSize ) ]++;
+                    pxBlock = pxBlock->pxNextFreeBlock;
+                }
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortResetHeapInstrumentation( void )
+    {
+        vTaskSuspendAll();
+        {
+            ( void ) memset( &xInstrumentation, 0, sizeof( xInstrumentation ) );
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+/*-----------------------------------------------------------*/
@@ -54,6 +54,10 @@
     #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
 
+/* Reported by vPortGetHeapStats(). */
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
@@ -63,6 +67,12 @@ void * pvPortMalloc( size_t xWantedSize )
     vTaskSuspendAll();
     {
         pvReturn = malloc( xWantedSize );
+
+        if( pvReturn != NULL )
+        {
+            xNumberOfSuccessfulAllocations++;
+        }
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -87,8 +97,42 @@ void vPortFree( void * pv )
         vTaskSuspendAll();
         {
             free( pv );
+            xNumberOfSuccessfulFrees++;
             traceFREE( pv, 0 );
         }
         ( void ) xTaskResumeAll();
     }
 }
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    /* The free space belongs to the C library's malloc(), so only the calls
+     * made through this file can be reported. */
+    pxHeapStats->xAvailableHeapSpaceInBytes = 0;
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = 0;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = 0;
+    pxHeapStats->xNumberOfFreeBlocks = 0;
+    pxHeapStats->xMinimumEverFreeBytesRemaining = 0;
+
+    vTaskSuspendAll();
+    {
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+    }
+    ( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    void vPortWalkFreeBlocks( HeapFreeBlockFunction_t pxFunction,
+                              void * pvContext )
+    {
+        /* The free list belongs to the C library's malloc(), so cannot be
+         * walked. */
+        ( void ) pxFunction;
+        ( void ) pvContext;
+    }
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
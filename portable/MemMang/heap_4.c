@@ -55,6 +55,44 @@
     #define configHEAP_CLEAR_MEMORY_ON_FREE    0
 #endif
 
+/* Set configHEAP_SIZE_CLASS_COUNT to a non-zero value to keep freed small
+ * blocks on per size class lists, from which later requests of the same size
+ * class are served without searching the free list.  Class n (counting from
+ * 0) holds blocks that can hold ( n + 1 ) * configHEAP_SIZE_CLASS_GRANULARITY
+ * bytes, and at most configHEAP_SIZE_CLASS_CACHE_LENGTH blocks are kept per
+ * class - further blocks are returned to the free list as normal.  If a request
+ * cannot be met from the free list, the blocks held by every class are
+ * returned to the free list, so they are merged with their neighbours, and the
+ * free list is searched again. */
+#ifndef configHEAP_SIZE_CLASS_COUNT
+    #define configHEAP_SIZE_CLASS_COUNT    0
+#endif
+
+#ifndef configHEAP_SIZE_CLASS_GRANULARITY
+    #define configHEAP_SIZE_CLASS_GRANULARITY    16
+#endif
+
+#ifndef configHEAP_SIZE_CLASS_CACHE_LENGTH
+    #define configHEAP_SIZE_CLASS_CACHE_LENGTH    16
+#endif
+
+#if ( ( configHEAP_SIZE_CLASS_COUNT > 0 ) && ( ( configHEAP_SIZE_CLASS_GRANULARITY % portBYTE_ALIGNMENT ) != 0 ) )
+    #error configHEAP_SIZE_CLASS_GRANULARITY must be a multiple of portBYTE_ALIGNMENT
+#endif
+
+/* Set configHEAP_SEGREGATED_FREE_LISTS to 1 to also keep each free block on
+ * one of a set of bucket lists, where bucket n holds the free blocks whose size
+ * is at least 2^n bytes but less than 2^(n+1) bytes.  pvPortMalloc() then takes
+ * a block from the first non-empty bucket that only holds large enough blocks
+ * instead of walking the free list, so the time it takes no longer grows with
+ * the number of free blocks.  The address ordered free list is still kept, so
+ * freed blocks are merged with their neighbours as before, and the memory
+ * layout and BlockLink_t structure are unchanged.  The extra links are held in
+ * the body of each free block. */
+#ifndef configHEAP_SEGREGATED_FREE_LISTS
+    #define configHEAP_SEGREGATED_FREE_LISTS    0
+#endif
+
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
 
@@ -80,6 +118,59 @@
 #define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
 #define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
 
+#if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+
+/* One bucket for each power of two a block size can be. */
+    #define heapFREE_LIST_BUCKETS    ( sizeof( size_t ) * heapBITS_PER_BYTE )
+
+/* The links a free block holds in its body, just after its BlockLink_t. */
+    #define heapFREE_BLOCK_LINKS( pxBlock )    ( ( FreeBlockLinks_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + xHeapStructSize ) )
+
+/* Removes pxBlock, which follows pxPreviousBlock, from the free lists, or adds
+ * pxBlock to the free lists after pxPreviousBlock when neither of the blocks
+ * either side of it are free. */
+    #define heapUNLINK_FREE_BLOCK( pxPreviousBlock, pxBlock )    prvUnlinkFreeBlock( ( pxPreviousBlock ), ( pxBlock ) )
+    #define heapLINK_FREE_BLOCK( pxPreviousBlock, pxBlock )      prvLinkFreeBlock( ( pxPreviousBlock ), ( pxBlock ) )
+#else
+    #define heapUNLINK_FREE_BLOCK( pxPreviousBlock, pxBlock )    ( ( pxPreviousBlock )->pxNextFreeBlock = ( pxBlock )->pxNextFreeBlock )
+    #define heapLINK_FREE_BLOCK( pxPreviousBlock, pxBlock )      prvInsertBlockIntoFreeList( pxBlock )
+#endif /* configHEAP_SEGREGATED_FREE_LISTS */
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* Reads the run time stats counter into ulTime, if there is one. */
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+        #else
+            #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+        #endif
+    #else
+        #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    ( ulTime ) = 0
+    #endif
+
+/* Counts the free blocks pvPortMalloc() steps over. */
+    #define heapCOUNT_BLOCK_WALKED()    ( xBlocksWalked++ )
+#else
+    #define heapCOUNT_BLOCK_WALKED()
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+#if ( configSUPPORT_HEAP_RELOCATABLE == 1 )
+
+/* An allocated block has no next free block, so the pxNextFreeBlock member of
+ * a relocatable block points to its handle instead. */
+    #define heapBLOCK_IS_RELOCATABLE( pxBlock )    ( ( heapBLOCK_IS_ALLOCATED( pxBlock ) != 0 ) && ( ( pxBlock )->pxNextFreeBlock != NULL ) )
+    #define heapBLOCK_HANDLE( pxBlock )            ( ( RelocatableHandle_t ) ( void * ) ( pxBlock )->pxNextFreeBlock )
+#endif
+
+/* Evaluates to pdFALSE if allocating xBytes would take the calling task over
+ * the quota set by vTaskSetHeapQuota(). */
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+    #define heapQUOTA_ALLOWS( xBytes )    xTaskHeapQuotaAllows( xBytes )
+#else
+    #define heapQUOTA_ALLOWS( xBytes )    pdTRUE
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Allocate the memory for the heap. */
@@ -98,8 +189,34 @@ typedef struct A_BLOCK_LINK
 {
     struct A_BLOCK_LINK * pxNextFreeBlock; /*<< The next free block in the list. */
     size_t xBlockSize;                     /*<< The size of the free block. */
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        TaskHandle_t xOwner;               /*<< The task the block is charged to while it is allocated. */
+    #endif
 } BlockLink_t;
 
+#if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+
+/* Held in the body of each free block. */
+    typedef struct A_FREE_BLOCK_LINKS
+    {
+        BlockLink_t * pxPreviousFreeBlock; /*<< The previous block in the address ordered free list. */
+        BlockLink_t * pxNextInBucket;      /*<< The next free block in the same bucket. */
+    } FreeBlockLinks_t;
+
+#endif /* configHEAP_SEGREGATED_FREE_LISTS */
+
+#if ( configSUPPORT_HEAP_RELOCATABLE == 1 )
+
+/* The handle of a relocatable block is an entry in a fixed table, so the
+ * handles themselves never fragment the heap. */
+    struct xHEAP_RELOCATABLE
+    {
+        void * pvData;           /*<< The block's memory, or NULL if the handle is not in use. */
+        UBaseType_t uxLockCount; /*<< The block is not moved while this is non-zero. */
+    };
+
+#endif /* configSUPPORT_HEAP_RELOCATABLE */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -110,12 +227,100 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
 
+#if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+
+/*
+ * Returns the bucket that holds free blocks of xBlockSize bytes.
+ */
+    static UBaseType_t prvBucketIndex( size_t xBlockSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a free block to, or remove a free block from, the list of its bucket.
+ */
+    static void prvBucketInsert( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+    static void prvBucketRemove( BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove pxBlock, which follows pxPreviousBlock in the address ordered free
+ * list, from the free lists.
+ */
+    static void prvUnlinkFreeBlock( BlockLink_t * pxPreviousBlock,
+                                    BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add pxBlock to the free lists immediately after pxPreviousBlock without
+ * searching the free list.  Used for the space split off the end of a block
+ * that was free, which cannot be merged with anything.
+ */
+    static void prvLinkFreeBlock( BlockLink_t * pxPreviousBlock,
+                                  BlockLink_t * pxBlock ) PRIVILEGED_FUNCTION;
+
+#endif /* configHEAP_SEGREGATED_FREE_LISTS */
+
+#if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+
+/*
+ * If *pxWantedSize (which includes the BlockLink_t structure) falls within a
+ * size class then round it up to the size of the class, and return a block
+ * from the class's list if the list is not empty.  Returns NULL if the
+ * request must be satisfied from the free list.
+ */
+    static void * prvSizeClassMalloc( size_t * pxWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Keeps a block that is being freed on the list of its size class.  Returns
+ * pdFALSE if the block is not the size of a size class, or the list of its
+ * size class is full, in which case the block must be returned to the free
+ * list.
+ */
+    static BaseType_t prvSizeClassFree( BlockLink_t * pxLink ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns every block held by the size classes to the free list, where it is
+ * merged with its free neighbours.  Returns pdFALSE if the size classes held
+ * no blocks.
+ */
+    static BaseType_t prvSizeClassFlush( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configHEAP_SIZE_CLASS_COUNT */
+
+#if ( configSUPPORT_HEAP_RELOCATABLE == 1 )
+
+/*
+ * Moves unlocked relocatable blocks down into the free block below them,
+ * lowest address first, until at least xMaxBytesToMove bytes have been moved
+ * or there are no more blocks that can be moved.  Returns the number of bytes
+ * moved.  Must be called with the scheduler suspended.
+ */
+    static size_t prvCompactHeap( size_t xMaxBytesToMove ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Called automatically to setup the required heap structures the first time
  * pvPortMalloc() is called.
  */
 static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/*
+ * Returns the histogram bucket that xValue falls into.
+ */
+    static UBaseType_t prvInstrumentationBucket( size_t xValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Records a call to pvPortMalloc() that was passed xRequestedSize, returned
+ * pvReturn, stepped over xBlocksWalked free blocks and took ulMallocTime run
+ * time counter ticks.  Must be called with the scheduler suspended.
+ */
+    static void prvInstrumentMalloc( size_t xRequestedSize,
+                                     const void * pvReturn,
+                                     size_t xBlocksWalked,
+                                     configRUN_TIME_COUNTER_TYPE ulMallocTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -133,6 +338,40 @@ PRIVILEGED_DATA static size_t xMinimumEverFreeBytesRemaining = 0U;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulAllocations = 0;
 PRIVILEGED_DATA static size_t xNumberOfSuccessfulFrees = 0;
 
+#if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+
+/* The first free block in each bucket, and a bit map with bit n set when
+ * bucket n is not empty. */
+    PRIVILEGED_DATA static BlockLink_t * pxBucketLists[ heapFREE_LIST_BUCKETS ];
+    PRIVILEGED_DATA static size_t xNonEmptyBuckets = 0U;
+
+#endif /* configHEAP_SEGREGATED_FREE_LISTS */
+
+#if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+
+/* Freed blocks kept for reuse, and the number of blocks on each list.  The
+ * blocks are linked through their pxNextFreeBlock members, and count as free
+ * memory in xFreeBytesRemaining. */
+    PRIVILEGED_DATA static BlockLink_t * pxSizeClassLists[ configHEAP_SIZE_CLASS_COUNT ];
+    PRIVILEGED_DATA static UBaseType_t uxSizeClassListLengths[ configHEAP_SIZE_CLASS_COUNT ];
+
+#endif /* configHEAP_SIZE_CLASS_COUNT */
+
+#if ( configSUPPORT_HEAP_RELOCATABLE == 1 )
+
+/* The handles of the relocatable blocks. */
+    PRIVILEGED_DATA static struct xHEAP_RELOCATABLE xRelocatableHandles[ configHEAP_RELOCATABLE_HANDLES ];
+
+#endif /* configSUPPORT_HEAP_RELOCATABLE */
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* The histograms recorded by pvPortMalloc().  xFreeBlockSizes is only filled
+ * in when the histograms are read. */
+    PRIVILEGED_DATA static HeapInstrumentation_t xInstrumentation;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
@@ -143,8 +382,28 @@ void * pvPortMalloc( size_t xWantedSize )
     void * pvReturn = NULL;
     size_t xAdditionalRequiredSize;
 
+    #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+        UBaseType_t uxBucket;
+        size_t xLargerBuckets;
+    #endif
+
+    #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        size_t xRequestedSize = xWantedSize;
+        size_t xBlocksWalked = 0;
+        configRUN_TIME_COUNTER_TYPE ulStartTime, ulEndTime;
+    #endif
+
+    #if ( ( configHEAP_SIZE_CLASS_COUNT > 0 ) || ( configSUPPORT_HEAP_RELOCATABLE == 1 ) )
+        BaseType_t xSearchAgain;
+    #endif
+
     vTaskSuspendAll();
     {
+        #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        {
+            heapGET_RUN_TIME_COUNTER_VALUE( ulStartTime );
+        }
+        #endif
         /* If this is the first call to malloc then the heap will require
          * initialisation to setup the list of free blocks. */
         if( pxEnd == NULL )
@@ -166,35 +425,175 @@ void * pvPortMalloc( size_t xWantedSize )
             if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
             {
                 xWantedSize += xAdditionalRequiredSize;
+
+                #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+                {
+                    /* The block must be able to hold its free list links once
+                     * it is freed. */
+                    if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+                    {
+                        xWantedSize = heapMINIMUM_BLOCK_SIZE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
             }
             else
             {
                 xWantedSize = 0;
             }
+
+            /* A task that is over its quota cannot allocate, whether or not
+             * the heap has space. */
+            if( heapQUOTA_ALLOWS( xWantedSize ) == pdFALSE )
+            {
+                xWantedSize = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+        {
+            /* Small requests are first offered to their size class. */
+            pvReturn = prvSizeClassMalloc( &xWantedSize );
+        }
+        #endif
+
         /* Check the block size we are trying to allocate is not so large that the
          * top bit is set.  The top bit of the block size member of the BlockLink_t
          * structure is used to determine who owns the block - the application or
          * the kernel, so it must be free. */
         if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
         {
-            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            if( ( pvReturn == NULL ) && ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
             {
-                /* Traverse the list from the start (lowest address) block until
-                 * one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = xStart.pxNextFreeBlock;
+                #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+                {
+                    /* Use the first block in the request's own bucket if it
+                     * is large enough, otherwise the first block in the
+                     * smallest non-empty bucket of larger blocks.  The
+                     * request's own bucket is only searched when no larger
+                     * block is free. */
+                    uxBucket = prvBucketIndex( xWantedSize );
+                    pxBlock = pxBucketLists[ uxBucket ];
+
+                    if( ( pxBlock == NULL ) || ( pxBlock->xBlockSize < xWantedSize ) )
+                    {
+                        xLargerBuckets = xNonEmptyBuckets & ~( ( ( ( size_t ) 2U ) << uxBucket ) - 1U );
+
+                        if( xLargerBuckets != 0U )
+                        {
+                            while( ( xLargerBuckets & ( ( ( size_t ) 1U ) << uxBucket ) ) == 0U )
+                            {
+                                uxBucket++;
+                            }
+
+                            pxBlock = pxBucketLists[ uxBucket ];
+                        }
+                        else
+                        {
+                            while( ( pxBlock != NULL ) && ( pxBlock->xBlockSize < xWantedSize ) )
+                            {
+                                pxBlock = heapFREE_BLOCK_LINKS( pxBlock )->pxNextInBucket;
+                                heapCOUNT_BLOCK_WALKED();
+                            }
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( pxBlock != NULL )
+                    {
+                        pxPreviousBlock = heapFREE_BLOCK_LINKS( pxBlock )->pxPreviousFreeBlock;
+                    }
+                    else
+                    {
+                        pxPreviousBlock = NULL;
+                        pxBlock = pxEnd;
+                    }
+                }
+                #else /* if ( configHEAP_SEGREGATED_FREE_LISTS == 1 ) */
+                {
+                    /* Traverse the list from the start (lowest address) block
+                     * until one of adequate size is found. */
+                    pxPreviousBlock = &xStart;
+                    pxBlock = xStart.pxNextFreeBlock;
+
+                    while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+                    {
+                        pxPreviousBlock = pxBlock;
+                        pxBlock = pxBlock->pxNextFreeBlock;
+                        heapCOUNT_BLOCK_WALKED();
+                    }
+                }
+                #endif /* configHEAP_SEGREGATED_FREE_LISTS */
 
-                while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+                #if ( ( configHEAP_SIZE_CLASS_COUNT > 0 ) || ( configSUPPORT_HEAP_RELOCATABLE == 1 ) )
                 {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = pxBlock->pxNextFreeBlock;
+                    /* There is enough free memory, but not in one block.  The
+                     * blocks held by the size classes are never merged with
+                     * their neighbours, and moving the relocatable blocks down
+                     * merges the free space between them, so search again if
+                     * either frees up any space.  The address ordered free
+                     * list is kept whether or not the segregated lists are in
+                     * use. */
+                    xSearchAgain = pdFALSE;
+
+                    if( pxBlock == pxEnd )
+                    {
+                        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+                        {
+                            xSearchAgain = prvSizeClassFlush();
+                        }
+                        #endif
+
+                        #if ( configSUPPORT_HEAP_RELOCATABLE == 1 )
+                        {
+                            if( prvCompactHeap( heapSIZE_MAX ) > 0U )
+                            {
+                                xSearchAgain = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xSearchAgain != pdFALSE )
+                    {
+                        pxPreviousBlock = &xStart;
+                        pxBlock = xStart.pxNextFreeBlock;
+
+                        while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+                        {
+                            pxPreviousBlock = pxBlock;
+                            pxBlock = pxBlock->pxNextFreeBlock;
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
                 }
+                #endif /* if ( ( configHEAP_SIZE_CLASS_COUNT > 0 ) || ( configSUPPORT_HEAP_RELOCATABLE == 1 ) ) */
 
                 /* If the end marker was reached then a block of adequate size
                  * was not found. */
@@ -206,7 +605,7 @@ void * pvPortMalloc( size_t xWantedSize )
 
                     /* This block is being returned for use so must be taken out
                      * of the list of free blocks. */
-                    pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+                    heapUNLINK_FREE_BLOCK( pxPreviousBlock, pxBlock );
 
                     /* If the block is larger than required it can be split into
                      * two. */
@@ -224,8 +623,10 @@ void * pvPortMalloc( size_t xWantedSize )
                         pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
                         pxBlock->xBlockSize = xWantedSize;
 
-                        /* Insert the new block into the list of free blocks. */
-                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                        /* Insert the new block into the list of free blocks,
+                         * where it takes the place of the block it was split
+                         * from. */
+                        heapLINK_FREE_BLOCK( pxPreviousBlock, pxNewBlockLink );
                     }
                     else
                     {
@@ -264,6 +665,27 @@ void * pvPortMalloc( size_t xWantedSize )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        {
+            if( pvReturn != NULL )
+            {
+                pxBlock = ( void * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize );
+                pxBlock->xOwner = xTaskHeapCharge( pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        {
+            heapGET_RUN_TIME_COUNTER_VALUE( ulEndTime );
+            prvInstrumentMalloc( xRequestedSize, pvReturn, xBlocksWalked, ulEndTime - ulStartTime );
+        }
+        #endif
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -291,6 +713,11 @@ void vPortFree( void * pv )
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
 
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        TaskHandle_t xOwner;
+        size_t xBlockSize;
+    #endif
+
     if( pv != NULL )
     {
         /* The memory being freed will have an BlockLink_t structure immediately
@@ -318,11 +745,43 @@ void vPortFree( void * pv )
 
                 vTaskSuspendAll();
                 {
+                    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                    {
+                        /* Inserting the block can merge it with its
+                         * neighbours, so take a copy of what the release
+                         * needs first. */
+                        xOwner = pxLink->xOwner;
+                        xBlockSize = pxLink->xBlockSize;
+                    }
+                    #endif
+
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE( pv, pxLink->xBlockSize );
-                    prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+
+                    #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+                    {
+                        if( prvSizeClassFree( pxLink ) == pdFALSE )
+                        {
+                            prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else
+                    {
+                        prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+                    }
+                    #endif
                     xNumberOfSuccessfulFrees++;
+
+                    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                    {
+                        vTaskHeapRelease( xOwner, xBlockSize );
+                    }
+                    #endif
                 }
                 ( void ) xTaskResumeAll();
             }
@@ -376,78 +835,666 @@ void * pvPortCalloc( size_t xNum,
 }
 /*-----------------------------------------------------------*/
 
-static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
-{
-    BlockLink_t * pxFirstFreeBlock;
-    uint8_t * pucAlignedHeap;
-    portPOINTER_SIZE_TYPE uxAddress;
-    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
-
-    /* Ensure the heap starts on a correctly aligned boundary. */
-    uxAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+#if ( configSUPPORT_HEAP_REALLOC == 1 )
 
-    if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    void * pvPortRealloc( void * pv,
+                          size_t xWantedSize )
     {
-        uxAddress += ( portBYTE_ALIGNMENT - 1 );
-        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
-        xTotalHeapSize -= uxAddress - ( portPOINTER_SIZE_TYPE ) ucHeap;
-    }
-
-    pucAlignedHeap = ( uint8_t * ) uxAddress;
+        BlockLink_t * pxLink;
+        BlockLink_t * pxIterator;
+        BlockLink_t * pxNextBlock;
+        BlockLink_t * pxNewBlockLink;
+        void * pvReturn = NULL;
+        size_t xBlockSize;
+        size_t xRequiredSize = 0;
+        size_t xAdditionalRequiredSize;
+
+        #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+            TaskHandle_t xOriginalOwner;
+            size_t xOriginalSize;
+        #endif
+
+        if( pv == NULL )
+        {
+            /* As realloc(), a NULL block means allocate a new block. */
+            pvReturn = pvPortMalloc( xWantedSize );
+        }
+        else if( xWantedSize == 0 )
+        {
+            /* As realloc(), a zero size means free the block. */
+            vPortFree( pv );
+        }
+        else
+        {
+            pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
 
-    /* xStart is used to hold a pointer to the first item in the list of free
-     * blocks.  The void cast is used to prevent compiler warnings. */
-    xStart.pxNextFreeBlock = ( void * ) pucAlignedHeap;
-    xStart.xBlockSize = ( size_t ) 0;
+            configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+            configASSERT( pxLink->pxNextFreeBlock == NULL );
 
-    /* pxEnd is used to mark the end of the list of free blocks and is inserted
-     * at the end of the heap space. */
-    uxAddress = ( ( portPOINTER_SIZE_TYPE ) pucAlignedHeap ) + xTotalHeapSize;
-    uxAddress -= xHeapStructSize;
-    uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
-    pxEnd = ( BlockLink_t * ) uxAddress;
-    pxEnd->xBlockSize = 0;
-    pxEnd->pxNextFreeBlock = NULL;
+            /* Work out the size of block needed in the same way as
+             * pvPortMalloc(). */
+            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
 
-    /* To start with there is a single free block that is sized to take up the
-     * entire heap space, minus the space taken by pxEnd. */
-    pxFirstFreeBlock = ( BlockLink_t * ) pucAlignedHeap;
-    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlock );
-    pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xRequiredSize = xWantedSize + xAdditionalRequiredSize;
 
-    /* Only one block exists - and it covers the entire usable heap space. */
-    xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
-    xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
-}
-/*-----------------------------------------------------------*/
+                #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+                {
+                    if( xRequiredSize < heapMINIMUM_BLOCK_SIZE )
+                    {
+                        xRequiredSize = heapMINIMUM_BLOCK_SIZE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
-{
-    BlockLink_t * pxIterator;
-    uint8_t * puc;
+            vTaskSuspendAll();
+            {
+                xBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
 
-    /* Iterate through the list until a block is found that has a higher address
-     * than the block being inserted. */
-    for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
-    {
-        /* Nothing to do here, just iterate to the right position. */
-    }
+                #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                {
+                    xOriginalOwner = pxLink->xOwner;
+                    xOriginalSize = xBlockSize;
+                }
+                #endif
 
-    /* Do the block being inserted, and the block it is being inserted after
-     * make a contiguous block of memory? */
-    puc = ( uint8_t * ) pxIterator;
+                if( ( xRequiredSize > xBlockSize ) && ( heapBLOCK_SIZE_IS_VALID( xRequiredSize ) != 0 ) )
+                {
+                    /* Growing, which can be done in place only if the block
+                     * that follows is free and large enough.  Find the first
+                     * free block after this one. */
+                    for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxLink; pxIterator = pxIterator->pxNextFreeBlock )
+                    {
+                        /* Nothing to do here, just iterate to the right position. */
+                    }
 
-    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
-    {
-        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
-        pxBlockToInsert = pxIterator;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+                    pxNextBlock = pxIterator->pxNextFreeBlock;
 
-    /* Do the block being inserted, and the block it is being inserted before
+                    if( ( pxNextBlock != pxEnd ) &&
+                        ( ( ( ( uint8_t * ) pxLink ) + xBlockSize ) == ( uint8_t * ) pxNextBlock ) &&
+                        ( ( xRequiredSize - xBlockSize ) <= pxNextBlock->xBlockSize ) &&
+                        ( heapQUOTA_ALLOWS( xRequiredSize - xBlockSize ) != pdFALSE ) )
+                    {
+                        /* Take the following block out of the free list and
+                         * join it to this one. */
+                        heapUNLINK_FREE_BLOCK( pxIterator, pxNextBlock );
+                        xFreeBytesRemaining -= pxNextBlock->xBlockSize;
+                        xBlockSize += pxNextBlock->xBlockSize;
+                        pvReturn = pv;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( xRequiredSize != 0 )
+                {
+                    /* Shrinking, or the block is already large enough. */
+                    pvReturn = pv;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( pvReturn != NULL )
+                {
+                    /* Return anything beyond the required size to the free
+                     * list, where it is merged with the block that follows if
+                     * that block is also free. */
+                    if( ( xBlockSize - xRequiredSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxLink ) + xRequiredSize );
+                        pxNewBlockLink->xBlockSize = xBlockSize - xRequiredSize;
+                        xBlockSize = xRequiredSize;
+
+                        #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                        {
+                            ( void ) memset( ( ( uint8_t * ) pxNewBlockLink ) + xHeapStructSize, 0, pxNewBlockLink->xBlockSize - xHeapStructSize );
+                        }
+                        #endif
+
+                        xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxLink->xBlockSize = xBlockSize;
+                    heapALLOCATE_BLOCK( pxLink );
+
+                    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                    {
+                        /* The resized block is charged to the calling task,
+                         * as it would be had the block been moved. */
+                        pxLink->xOwner = xTaskHeapCharge( xBlockSize );
+                        vTaskHeapRelease( xOriginalOwner, xOriginalSize );
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( ( pvReturn == NULL ) && ( xRequiredSize != 0 ) )
+            {
+                /* The block could not be resized in place so move it.  The
+                 * original block is left untouched if that fails. */
+                pvReturn = pvPortMalloc( xWantedSize );
+
+                if( pvReturn != NULL )
+                {
+                    ( void ) memcpy( pvReturn, pv, xBlockSize - xHeapStructSize );
+                    vPortFree( pv );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pvReturn;
+    }
+
+#endif /* configSUPPORT_HEAP_REALLOC */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_HEAP_ALIGNED_ALLOC == 1 )
+
+    void * pvPortMallocAligned( size_t xWantedSize,
+                                size_t xAlignment )
+    {
+        BlockLink_t * pxBlock;
+        BlockLink_t * pxPreviousBlock;
+        BlockLink_t * pxNewBlockLink;
+        void * pvReturn = NULL;
+        size_t xAdditionalRequiredSize;
+        size_t xLeadingSize = 0;
+        portPOINTER_SIZE_TYPE xAddress;
+
+        /* The alignment must be a power of two. */
+        configASSERT( ( xAlignment != 0 ) && ( ( xAlignment & ( xAlignment - 1U ) ) == 0 ) );
+
+        if( xAlignment <= ( size_t ) portBYTE_ALIGNMENT )
+        {
+            /* Every block is aligned to portBYTE_ALIGNMENT anyway. */
+            pvReturn = pvPortMalloc( xWantedSize );
+        }
+        else
+        {
+            vTaskSuspendAll();
+            {
+                if( pxEnd == NULL )
+                {
+                    prvHeapInit();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xWantedSize > 0 )
+                {
+                    xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                    if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                    {
+                        xWantedSize += xAdditionalRequiredSize;
+
+                        #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+                        {
+                            if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+                            {
+                                xWantedSize = heapMINIMUM_BLOCK_SIZE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        xWantedSize = 0;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 ) && ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) &&
+                    ( heapQUOTA_ALLOWS( xWantedSize ) != pdFALSE ) )
+                {
+                    pxPreviousBlock = &xStart;
+                    pxBlock = xStart.pxNextFreeBlock;
+
+                    while( pxBlock != pxEnd )
+                    {
+                        /* Find the first suitably aligned address in the block
+                         * that leaves room for the BlockLink_t structure, and
+                         * that leaves either nothing or a whole free block in
+                         * front of it. */
+                        xAddress = ( ( portPOINTER_SIZE_TYPE ) pxBlock ) + xHeapStructSize;
+                        xAddress = ( xAddress + ( xAlignment - 1U ) ) & ~( ( portPOINTER_SIZE_TYPE ) xAlignment - 1U );
+                        xLeadingSize = ( size_t ) ( xAddress - ( ( portPOINTER_SIZE_TYPE ) pxBlock ) ) - xHeapStructSize;
+
+                        while( ( xLeadingSize != 0 ) && ( xLeadingSize < heapMINIMUM_BLOCK_SIZE ) )
+                        {
+                            xLeadingSize += xAlignment;
+                        }
+
+                        if( ( xLeadingSize < pxBlock->xBlockSize ) && ( xWantedSize <= ( pxBlock->xBlockSize - xLeadingSize ) ) )
+                        {
+                            break;
+                        }
+
+                        pxPreviousBlock = pxBlock;
+                        pxBlock = pxBlock->pxNextFreeBlock;
+                    }
+
+                    if( pxBlock != pxEnd )
+                    {
+                        /* This block is being returned for use so must be taken
+                         * out of the list of free blocks. */
+                        heapUNLINK_FREE_BLOCK( pxPreviousBlock, pxBlock );
+
+                        if( xLeadingSize != 0 )
+                        {
+                            /* Return the space in front of the aligned block
+                             * to the free list. */
+                            pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xLeadingSize );
+                            pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xLeadingSize;
+                            pxBlock->xBlockSize = xLeadingSize;
+                            prvInsertBlockIntoFreeList( pxBlock );
+                            pxBlock = pxNewBlockLink;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+                        {
+                            pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                            pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                            pxBlock->xBlockSize = xWantedSize;
+                            prvInsertBlockIntoFreeList( pxNewBlockLink );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                        if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                        {
+                            xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                        {
+                            pxBlock->xOwner = xTaskHeapCharge( pxBlock->xBlockSize );
+                        }
+                        #endif
+
+                        heapALLOCATE_BLOCK( pxBlock );
+                        pxBlock->pxNextFreeBlock = NULL;
+                        xNumberOfSuccessfulAllocations++;
+
+                        pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceMALLOC( pvReturn, xWantedSize );
+            }
+            ( void ) xTaskResumeAll();
+
+            #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+            {
+                if( pvReturn == NULL )
+                {
+                    vApplicationMallocFailedHook();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+        }
+
+        return pvReturn;
+    }
+
+#endif /* configSUPPORT_HEAP_ALIGNED_ALLOC */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_HEAP_RELOCATABLE == 1 )
+
+    RelocatableHandle_t xPortMallocRelocatable( size_t xSize )
+    {
+        RelocatableHandle_t xHandle = NULL;
+        BlockLink_t * pxLink;
+        void * pv;
+        UBaseType_t ux;
+
+        vTaskSuspendAll();
+        {
+            for( ux = 0; ux < ( UBaseType_t ) configHEAP_RELOCATABLE_HANDLES; ux++ )
+            {
+                if( xRelocatableHandles[ ux ].pvData == NULL )
+                {
+                    xHandle = &( xRelocatableHandles[ ux ] );
+                    break;
+                }
+            }
+
+            if( xHandle != NULL )
+            {
+                pv = pvPortMalloc( xSize );
+
+                if( pv != NULL )
+                {
+                    pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+                    pxLink->pxNextFreeBlock = ( void * ) xHandle;
+                    xHandle->pvData = pv;
+                    xHandle->uxLockCount = 0;
+                }
+                else
+                {
+                    xHandle = NULL;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xHandle;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortFreeRelocatable( RelocatableHandle_t xHandle )
+    {
+        BlockLink_t * pxLink;
+        void * pv = NULL;
+
+        if( xHandle != NULL )
+        {
+            configASSERT( xHandle->pvData != NULL );
+            configASSERT( xHandle->uxLockCount == 0U );
+
+            vTaskSuspendAll();
+            {
+                /* Once it no longer points to its handle the block is an
+                 * ordinary allocated block, so is not moved again. */
+                pv = xHandle->pvData;
+                pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
+                pxLink->pxNextFreeBlock = NULL;
+                xHandle->pvData = NULL;
+            }
+            ( void ) xTaskResumeAll();
+
+            vPortFree( pv );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPortLockRelocatable( RelocatableHandle_t xHandle )
+    {
+        void * pvReturn;
+
+        configASSERT( xHandle );
+        configASSERT( xHandle->pvData != NULL );
+
+        vTaskSuspendAll();
+        {
+            xHandle->uxLockCount++;
+            pvReturn = xHandle->pvData;
+        }
+        ( void ) xTaskResumeAll();
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortUnlockRelocatable( RelocatableHandle_t xHandle )
+    {
+        configASSERT( xHandle );
+        configASSERT( xHandle->uxLockCount > 0U );
+
+        vTaskSuspendAll();
+        {
+            xHandle->uxLockCount--;
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPortCompactHeap( size_t xMaxBytesToMove )
+    {
+        size_t xBytesMoved = 0;
+
+        vTaskSuspendAll();
+        {
+            if( pxEnd != NULL )
+            {
+                xBytesMoved = prvCompactHeap( xMaxBytesToMove );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        /* prvCompactHeap() only stops short of its budget once there is
+         * nothing left that it can move. */
+        return ( ( xBytesMoved > 0U ) && ( xBytesMoved >= xMaxBytesToMove ) ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    static size_t prvCompactHeap( size_t xMaxBytesToMove ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxPreviousBlock = &xStart;
+        BlockLink_t * pxFreeBlock = xStart.pxNextFreeBlock;
+        BlockLink_t * pxBlock;
+        BlockLink_t * pxNewBlockLink;
+        RelocatableHandle_t xHandle;
+        size_t xBlockSize;
+        size_t xFreeSize;
+        size_t xBytesMoved = 0;
+
+        while( ( pxFreeBlock != pxEnd ) && ( xBytesMoved < xMaxBytesToMove ) )
+        {
+            /* Adjacent free blocks are always merged, so the block that
+             * follows a free block is allocated, a block held by a size class
+             * list, or the end marker. */
+            pxBlock = ( void * ) ( ( ( uint8_t * ) pxFreeBlock ) + pxFreeBlock->xBlockSize );
+
+            if( ( pxBlock != pxEnd ) &&
+                ( heapBLOCK_IS_RELOCATABLE( pxBlock ) ) &&
+                ( heapBLOCK_HANDLE( pxBlock )->uxLockCount == 0U ) )
+            {
+                xHandle = heapBLOCK_HANDLE( pxBlock );
+                xBlockSize = pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
+                xFreeSize = pxFreeBlock->xBlockSize;
+
+                /* Swap the two blocks over, so the free space moves up to sit
+                 * in front of whatever follows.  The block's BlockLink_t moves
+                 * with it, so it keeps its size, owner and handle. */
+                heapUNLINK_FREE_BLOCK( pxPreviousBlock, pxFreeBlock );
+                ( void ) memmove( pxFreeBlock, pxBlock, xBlockSize );
+                xHandle->pvData = ( ( uint8_t * ) pxFreeBlock ) + xHeapStructSize;
+
+                pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxFreeBlock ) + xBlockSize );
+                pxNewBlockLink->xBlockSize = xFreeSize;
+
+                #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                {
+                    ( void ) memset( ( ( uint8_t * ) pxNewBlockLink ) + xHeapStructSize, 0, xFreeSize - xHeapStructSize );
+                }
+                #endif
+
+                /* The free space is merged with the block that follows if that
+                 * is also free.  It cannot be merged with pxPreviousBlock, so
+                 * takes the place of the block that was moved into. */
+                prvInsertBlockIntoFreeList( pxNewBlockLink );
+                pxFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+                xBytesMoved += xBlockSize;
+            }
+            else
+            {
+                pxPreviousBlock = pxFreeBlock;
+                pxFreeBlock = pxFreeBlock->pxNextFreeBlock;
+            }
+        }
+
+        return xBytesMoved;
+    }
+
+#endif /* configSUPPORT_HEAP_RELOCATABLE */
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlock;
+    uint8_t * pucAlignedHeap;
+    portPOINTER_SIZE_TYPE uxAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+
+    /* Ensure the heap starts on a correctly aligned boundary. */
+    uxAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+    if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+    {
+        uxAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+        xTotalHeapSize -= uxAddress - ( portPOINTER_SIZE_TYPE ) ucHeap;
+    }
+
+    pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+    /* xStart is used to hold a pointer to the first item in the list of free
+     * blocks.  The void cast is used to prevent compiler warnings. */
+    xStart.pxNextFreeBlock = ( void * ) pucAlignedHeap;
+    xStart.xBlockSize = ( size_t ) 0;
+
+    /* pxEnd is used to mark the end of the list of free blocks and is inserted
+     * at the end of the heap space. */
+    uxAddress = ( ( portPOINTER_SIZE_TYPE ) pucAlignedHeap ) + xTotalHeapSize;
+    uxAddress -= xHeapStructSize;
+    uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+    pxEnd = ( BlockLink_t * ) uxAddress;
+    pxEnd->xBlockSize = 0;
+    pxEnd->pxNextFreeBlock = NULL;
+
+    /* To start with there is a single free block that is sized to take up the
+     * entire heap space, minus the space taken by pxEnd. */
+    pxFirstFreeBlock = ( BlockLink_t * ) pucAlignedHeap;
+    pxFirstFreeBlock->xBlockSize = ( size_t ) ( uxAddress - ( portPOINTER_SIZE_TYPE ) pxFirstFreeBlock );
+    pxFirstFreeBlock->pxNextFreeBlock = pxEnd;
+
+    #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+    {
+        /* The smallest free block must be able to hold the links. */
+        configASSERT( xHeapStructSize >= sizeof( FreeBlockLinks_t ) );
+
+        heapFREE_BLOCK_LINKS( pxFirstFreeBlock )->pxPreviousFreeBlock = &xStart;
+        prvBucketInsert( pxFirstFreeBlock );
+    }
+    #endif
+
+    /* Only one block exists - and it covers the entire usable heap space. */
+    xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+    xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxIterator;
+    uint8_t * puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+     * than the block being inserted. */
+    for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+    {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxIterator;
+
+    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    {
+        #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+        {
+            /* The block in front grows, so may belong in another bucket. */
+            prvBucketRemove( pxIterator );
+        }
+        #endif
+
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Do the block being inserted, and the block it is being inserted before
      * make a contiguous block of memory? */
     puc = ( uint8_t * ) pxBlockToInsert;
 
@@ -455,6 +1502,12 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVI
     {
         if( pxIterator->pxNextFreeBlock != pxEnd )
         {
+            #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+            {
+                prvBucketRemove( pxIterator->pxNextFreeBlock );
+            }
+            #endif
+
             /* Form one big block from the two blocks. */
             pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
             pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
@@ -481,14 +1534,359 @@ static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert ) /* PRIVI
     {
         mtCOVERAGE_TEST_MARKER();
     }
+
+    #if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+    {
+        if( pxIterator != pxBlockToInsert )
+        {
+            heapFREE_BLOCK_LINKS( pxBlockToInsert )->pxPreviousFreeBlock = pxIterator;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxBlockToInsert->pxNextFreeBlock != pxEnd )
+        {
+            heapFREE_BLOCK_LINKS( pxBlockToInsert->pxNextFreeBlock )->pxPreviousFreeBlock = pxBlockToInsert;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvBucketInsert( pxBlockToInsert );
+    }
+    #endif /* configHEAP_SEGREGATED_FREE_LISTS */
 }
 /*-----------------------------------------------------------*/
 
+#if ( configHEAP_SEGREGATED_FREE_LISTS == 1 )
+
+    static UBaseType_t prvBucketIndex( size_t xBlockSize ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxBucket = 0;
+
+        while( xBlockSize > ( size_t ) 1U )
+        {
+            xBlockSize >>= 1;
+            uxBucket++;
+        }
+
+        return uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBucketInsert( BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxBucket = prvBucketIndex( pxBlock->xBlockSize );
+
+        heapFREE_BLOCK_LINKS( pxBlock )->pxNextInBucket = pxBucketLists[ uxBucket ];
+        pxBucketLists[ uxBucket ] = pxBlock;
+        xNonEmptyBuckets |= ( ( size_t ) 1U ) << uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvBucketRemove( BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxBucket = prvBucketIndex( pxBlock->xBlockSize );
+        BlockLink_t ** ppxIterator = &( pxBucketLists[ uxBucket ] );
+
+        /* The buckets are singly linked, so find the link that points to the
+         * block.  Blocks are normally removed from the front of a bucket. */
+        while( *ppxIterator != pxBlock )
+        {
+            configASSERT( *ppxIterator != NULL );
+            ppxIterator = &( heapFREE_BLOCK_LINKS( *ppxIterator )->pxNextInBucket );
+        }
+
+        *ppxIterator = heapFREE_BLOCK_LINKS( pxBlock )->pxNextInBucket;
+
+        if( pxBucketLists[ uxBucket ] == NULL )
+        {
+            xNonEmptyBuckets &= ~( ( ( size_t ) 1U ) << uxBucket );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUnlinkFreeBlock( BlockLink_t * pxPreviousBlock,
+                                    BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock != pxEnd )
+        {
+            heapFREE_BLOCK_LINKS( pxBlock->pxNextFreeBlock )->pxPreviousFreeBlock = pxPreviousBlock;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvBucketRemove( pxBlock );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvLinkFreeBlock( BlockLink_t * pxPreviousBlock,
+                                  BlockLink_t * pxBlock ) /* PRIVILEGED_FUNCTION */
+    {
+        pxBlock->pxNextFreeBlock = pxPreviousBlock->pxNextFreeBlock;
+        pxPreviousBlock->pxNextFreeBlock = pxBlock;
+        heapFREE_BLOCK_LINKS( pxBlock )->pxPreviousFreeBlock = pxPreviousBlock;
+
+        if( pxBlock->pxNextFreeBlock != pxEnd )
+        {
+            heapFREE_BLOCK_LINKS( pxBlock->pxNextFreeBlock )->pxPreviousFreeBlock = pxBlock;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvBucketInsert( pxBlock );
+    }
+
+#endif /* configHEAP_SEGREGATED_FREE_LISTS */
+/*-----------------------------------------------------------*/
+
+#if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+
+    static void * prvSizeClassMalloc( size_t * pxWantedSize ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock;
+        void * pvReturn = NULL;
+        size_t xClass;
+
+        /* Sizes that are zero or too large to be in a size class are left for
+         * the free list to deal with. */
+        if( ( *pxWantedSize > xHeapStructSize ) &&
+            ( *pxWantedSize <= ( xHeapStructSize + ( ( size_t ) configHEAP_SIZE_CLASS_COUNT * ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY ) ) ) )
+        {
+            /* Round the request up to the size of its class so the block can
+             * be reused for any request in the same class once it is freed. */
+            xClass = ( *pxWantedSize - xHeapStructSize - 1U ) / ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY;
+            *pxWantedSize = xHeapStructSize + ( ( xClass + 1U ) * ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY );
+
+            pxBlock = pxSizeClassLists[ xClass ];
+
+            if( pxBlock != NULL )
+            {
+                pxSizeClassLists[ xClass ] = pxBlock->pxNextFreeBlock;
+                uxSizeClassListLengths[ xClass ]--;
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application and has no "next" block. */
+                heapALLOCATE_BLOCK( pxBlock );
+                pxBlock->pxNextFreeBlock = NULL;
+                xNumberOfSuccessfulAllocations++;
+
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSizeClassFree( BlockLink_t * pxLink ) /* PRIVILEGED_FUNCTION */
+    {
+        BaseType_t xReturn = pdFALSE;
+        size_t xClass;
+
+        /* Only blocks that are exactly the size of a size class are kept - a
+         * larger block may have been allocated when the remainder was too small
+         * to split off. */
+        if( ( pxLink->xBlockSize > xHeapStructSize ) &&
+            ( ( ( pxLink->xBlockSize - xHeapStructSize ) % ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY ) == 0U ) )
+        {
+            xClass = ( ( pxLink->xBlockSize - xHeapStructSize ) / ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY ) - 1U;
+
+            if( ( xClass < ( size_t ) configHEAP_SIZE_CLASS_COUNT ) &&
+                ( uxSizeClassListLengths[ xClass ] < ( UBaseType_t ) configHEAP_SIZE_CLASS_CACHE_LENGTH ) )
+            {
+                pxLink->pxNextFreeBlock = pxSizeClassLists[ xClass ];
+                pxSizeClassLists[ xClass ] = pxLink;
+                uxSizeClassListLengths[ xClass ]++;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSizeClassFlush( void ) /* PRIVILEGED_FUNCTION */
+    {
+        BlockLink_t * pxBlock;
+        BaseType_t xReturn = pdFALSE;
+        size_t xClass;
+
+        /* The blocks already count as free memory, so only their place in
+         * the heap changes. */
+        for( xClass = 0; xClass < ( size_t ) configHEAP_SIZE_CLASS_COUNT; xClass++ )
+        {
+            while( pxSizeClassLists[ xClass ] != NULL )
+            {
+                pxBlock = pxSizeClassLists[ xClass ];
+                pxSizeClassLists[ xClass ] = pxBlock->pxNextFreeBlock;
+                prvInsertBlockIntoFreeList( pxBlock );
+                xReturn = pdTRUE;
+            }
+
+            uxSizeClassListLengths[ xClass ] = 0;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configHEAP_SIZE_CLASS_COUNT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+    static UBaseType_t prvInstrumentationBucket( size_t xValue ) /* PRIVILEGED_FUNCTION */
+    {
+        UBaseType_t uxBucket = 0;
+
+        while( ( xValue > ( size_t ) 1U ) && ( uxBucket < ( ( UBaseType_t ) configHEAP_INSTRUMENTATION_BUCKETS - 1U ) ) )
+        {
+            xValue >>= 1;
+            uxBucket++;
+        }
+
+        return uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInstrumentMalloc( size_t xRequestedSize,
+                                     const void * pvReturn,
+                                     size_t xBlocksWalked,
+                                     configRUN_TIME_COUNTER_TYPE ulMallocTime ) /* PRIVILEGED_FUNCTION */
+    {
+        xInstrumentation.xAllocationSizes[ prvInstrumentationBucket( xRequestedSize ) ]++;
+
+        if( pvReturn == NULL )
+        {
+            xInstrumentation.xNumberOfFailedAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBlocksWalked > xInstrumentation.xLongestFreeListWalk )
+        {
+            xInstrumentation.xLongestFreeListWalk = xBlocksWalked;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            xInstrumentation.xMallocTimes[ prvInstrumentationBucket( ( size_t ) ulMallocTime ) ]++;
+        }
+        #endif
+
+        traceMALLOC_INSTRUMENTATION( pvReturn, xRequestedSize, xBlocksWalked, ulMallocTime );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapInstrumentation( HeapInstrumentation_t * pxHeapInstrumentation )
+    {
+        BlockLink_t * pxBlock;
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+            UBaseType_t uxClass;
+        #endif
+
+        vTaskSuspendAll();
+        {
+            *pxHeapInstrumentation = xInstrumentation;
+
+            /* pxBlock will be NULL if the heap has not been initialised. */
+            pxBlock = xStart.pxNextFreeBlock;
+
+            if( pxBlock != NULL )
+            {
+                while( pxBlock != pxEnd )
+                {
+                    pxHeapInstrumentation->xFreeBlockSizes[ prvInstrumentationBucket( pxBlock->xBlockSize ) ]++;
+                    pxBlock = pxBlock->pxNextFreeBlock;
+                }
+            }
+
+            #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+            {
+                /* Blocks held by the size classes are free blocks too. */
+                for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT; uxClass++ )
+                {
+                    for( pxBlock = pxSizeClassLists[ uxClass ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                    {
+                        pxHeapInstrumentation->xFreeBlockSizes[ prvInstrumentationBucket( pxBlock->xBlockSize ) ]++;
+                    }
+                }
+            }
+            #endif /* configHEAP_SIZE_CLASS_COUNT */
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortResetHeapInstrumentation( void )
+    {
+        vTaskSuspendAll();
+        {
+            ( void ) memset( &xInstrumentation, 0, sizeof( xInstrumentation ) );
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+/*-----------------------------------------------------------*/
+
 void vPortGetHeapStats( HeapStats_t * pxHeapStats )
 {
     BlockLink_t * pxBlock;
     size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
 
+    #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+        UBaseType_t uxClass;
+        size_t xClassBlockSize;
+    #endif
+
     vTaskSuspendAll();
     {
         pxBlock = xStart.pxNextFreeBlock;
@@ -518,6 +1916,30 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
                 pxBlock = pxBlock->pxNextFreeBlock;
             }
         }
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+        {
+            /* Blocks held by the size classes are free blocks too. */
+            for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT; uxClass++ )
+            {
+                if( uxSizeClassListLengths[ uxClass ] > ( UBaseType_t ) 0U )
+                {
+                    xClassBlockSize = xHeapStructSize + ( ( ( size_t ) uxClass + 1U ) * ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY );
+                    xBlocks += ( size_t ) uxSizeClassListLengths[ uxClass ];
+
+                    if( xClassBlockSize > xMaxSize )
+                    {
+                        xMaxSize = xClassBlockSize;
+                    }
+
+                    if( xClassBlockSize < xMinSize )
+                    {
+                        xMinSize = xClassBlockSize;
+                    }
+                }
+            }
+        }
+        #endif /* configHEAP_SIZE_CLASS_COUNT */
     }
     ( void ) xTaskResumeAll();
 
@@ -535,3 +1957,42 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    void vPortWalkFreeBlocks( HeapFreeBlockFunction_t pxFunction,
+                              void * pvContext )
+    {
+        const BlockLink_t * pxBlock;
+        BaseType_t xContinue = pdTRUE;
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+            UBaseType_t uxClass;
+            size_t xClassBlockSize;
+        #endif
+
+        /* pxBlock will be NULL if the heap has not been initialised.  The NULL
+         * check also ends the walk if a corrupt link is found. */
+        for( pxBlock = xStart.pxNextFreeBlock; ( pxBlock != NULL ) && ( pxBlock != pxEnd ) && ( xContinue != pdFALSE ); pxBlock = pxBlock->pxNextFreeBlock )
+        {
+            xContinue = pxFunction( pxBlock, pxBlock->xBlockSize, pvContext );
+        }
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+        {
+            /* Blocks held by the size classes are free blocks too. */
+            for( uxClass = 0; ( uxClass < ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT ) && ( xContinue != pdFALSE ); uxClass++ )
+            {
+                xClassBlockSize = xHeapStructSize + ( ( ( size_t ) uxClass + 1U ) * ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY );
+
+                for( pxBlock = pxSizeClassLists[ uxClass ]; ( pxBlock != NULL ) && ( xContinue != pdFALSE ); pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xContinue = pxFunction( pxBlock, xClassBlockSize, pvContext );
+                }
+            }
+        }
+        #endif /* configHEAP_SIZE_CLASS_COUNT */
+    }
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
+/*-----------------------------------------------------------*/
@@ -67,6 +67,12 @@
  *
  * Note 0x80000000 is the lower address so appears in the array first.
  *
+ * If configUSE_HEAP_REGION_CAPS is set to 1 then HeapRegion_t has a third
+ * member, ulCaps, that describes the memory in the region using the
+ * portHEAP_CAP_XXX bits.  pvPortMallocCaps() only allocates from regions that
+ * have all the requested capabilities, while pvPortMalloc() allocates from any
+ * region.  At most configHEAP_MAX_REGIONS regions can be defined in this case.
+ *
  */
 #include <stdlib.h>
 #include <string.h>
@@ -89,6 +95,37 @@
     #define configHEAP_CLEAR_MEMORY_ON_FREE    0
 #endif
 
+/* Set configHEAP_SIZE_CLASS_COUNT to a non-zero value to keep freed small
+ * blocks on per size class lists, from which later requests of the same size
+ * class are served without searching the free list.  Class n (counting from
+ * 0) holds blocks that can hold ( n + 1 ) * configHEAP_SIZE_CLASS_GRANULARITY
+ * bytes, and at most configHEAP_SIZE_CLASS_CACHE_LENGTH blocks are kept per
+ * class - further blocks are returned to the free list as normal.  If a request
+ * cannot be met from the free list, the blocks held by every class are
+ * returned to the free list, so they are merged with their neighbours, and the
+ * free list is searched again. */
+#ifndef configHEAP_SIZE_CLASS_COUNT
+    #define configHEAP_SIZE_CLASS_COUNT    0
+#endif
+
+#ifndef configHEAP_SIZE_CLASS_GRANULARITY
+    #define configHEAP_SIZE_CLASS_GRANULARITY    16
+#endif
+
+#ifndef configHEAP_SIZE_CLASS_CACHE_LENGTH
+    #define configHEAP_SIZE_CLASS_CACHE_LENGTH    16
+#endif
+
+#if ( ( configHEAP_SIZE_CLASS_COUNT > 0 ) && ( ( configHEAP_SIZE_CLASS_GRANULARITY % portBYTE_ALIGNMENT ) != 0 ) )
+    #error configHEAP_SIZE_CLASS_GRANULARITY must be a multiple of portBYTE_ALIGNMENT
+#endif
+
+/* The number of heap regions for which capabilities and statistics are kept
+ * when configUSE_HEAP_REGION_CAPS is 1. */
+#ifndef configHEAP_MAX_REGIONS
+    #define configHEAP_MAX_REGIONS    8
+#endif
+
 /* Block sizes must not get too small. */
 #define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
 
@@ -114,6 +151,41 @@
 #define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
 #define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* Reads the run time stats counter into ulTime, if there is one. */
+    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime )
+        #else
+            #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    ( ulTime ) = portGET_RUN_TIME_COUNTER_VALUE()
+        #endif
+    #else
+        #define heapGET_RUN_TIME_COUNTER_VALUE( ulTime )    ( ulTime ) = 0
+    #endif
+
+/* Counts the free blocks pvPortMalloc() steps over. */
+    #define heapCOUNT_BLOCK_WALKED()    ( xBlocksWalked++ )
+#else
+    #define heapCOUNT_BLOCK_WALKED()
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+/* Evaluates to pdFALSE if allocating xBytes would take the calling task over
+ * the quota set by vTaskSetHeapQuota(). */
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+    #define heapQUOTA_ALLOWS( xBytes )    xTaskHeapQuotaAllows( xBytes )
+#else
+    #define heapQUOTA_ALLOWS( xBytes )    pdTRUE
+#endif
+
+/* Returns the blocks held by the size classes to the free list, evaluating to
+ * pdFALSE if there were none. */
+#if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+    #define heapFLUSH_SIZE_CLASSES()    prvSizeClassFlush()
+#else
+    #define heapFLUSH_SIZE_CLASSES()    pdFALSE
+#endif
+
 /*-----------------------------------------------------------*/
 
 /* Define the linked list structure.  This is used to link free blocks in order
@@ -122,8 +194,28 @@ typedef struct A_BLOCK_LINK
 {
     struct A_BLOCK_LINK * pxNextFreeBlock; /*<< The next free block in the list. */
     size_t xBlockSize;                     /*<< The size of the free block. */
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        TaskHandle_t xOwner;               /*<< The task the block is charged to while it is allocated. */
+    #endif
 } BlockLink_t;
 
+#if ( configUSE_HEAP_REGION_CAPS == 1 )
+
+/* What is known about each heap region.  The region holds the addresses from
+ * xStartAddress up to, but not including, xEndAddress. */
+    typedef struct HeapRegionInfo
+    {
+        portPOINTER_SIZE_TYPE xStartAddress;
+        portPOINTER_SIZE_TYPE xEndAddress;
+        uint32_t ulCaps;
+        size_t xFreeBytesRemaining;
+        size_t xMinimumEverFreeBytesRemaining;
+        size_t xNumberOfSuccessfulAllocations;
+        size_t xNumberOfSuccessfulFrees;
+    } HeapRegionInfo_t;
+
+#endif /* configUSE_HEAP_REGION_CAPS */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -134,6 +226,84 @@ typedef struct A_BLOCK_LINK
  */
 static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert );
 
+/*
+ * Allocates a block from a region that has all the capabilities in ulCaps.
+ * ulCaps is ignored unless configUSE_HEAP_REGION_CAPS is 1.
+ */
+static void * prvHeapMalloc( size_t xWantedSize,
+                             uint32_t ulCaps );
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/*
+ * Returns the histogram bucket that xValue falls into.
+ */
+    static UBaseType_t prvInstrumentationBucket( size_t xValue );
+
+/*
+ * Records a call to pvPortMalloc() that was passed xRequestedSize, returned
+ * pvReturn, stepped over xBlocksWalked free blocks and took ulMallocTime run
+ * time counter ticks.  Must be called with the scheduler suspended.
+ */
+    static void prvInstrumentMalloc( size_t xRequestedSize,
+                                     const void * pvReturn,
+                                     size_t xBlocksWalked,
+                                     configRUN_TIME_COUNTER_TYPE ulMallocTime );
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
+#if ( configUSE_HEAP_REGION_CAPS == 1 )
+
+/*
+ * Returns the index of the region that holds pv.
+ */
+    static UBaseType_t prvRegionIndex( const void * pv );
+
+/*
+ * Moves *puxRegion forward, if necessary, to the region that holds pxBlock,
+ * then returns pdTRUE if that region is missing any of the capabilities in
+ * ulCaps.  Used while walking the free list, which is in address order, so
+ * *puxRegion never needs to move back.
+ */
+    static BaseType_t prvBlockLacksCaps( const BlockLink_t * pxBlock,
+                                         uint32_t ulCaps,
+                                         UBaseType_t * puxRegion );
+
+/*
+ * Updates the statistics of region uxRegion when pxBlock is allocated.
+ */
+    static void prvRegionBlockAllocated( UBaseType_t uxRegion,
+                                         const BlockLink_t * pxBlock );
+
+#endif /* configUSE_HEAP_REGION_CAPS */
+
+#if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+
+/*
+ * If *pxWantedSize (which includes the BlockLink_t structure) falls within a
+ * size class then round it up to the size of the class, and return a block
+ * from the class's list if the list is not empty.  Returns NULL if the
+ * request must be satisfied from the free list.
+ */
+    static void * prvSizeClassMalloc( size_t * pxWantedSize );
+
+/*
+ * Keeps a block that is being freed on the list of its size class.  Returns
+ * pdFALSE if the block is not the size of a size class, or the list of its
+ * size class is full, in which case the block must be returned to the free
+ * list.
+ */
+    static BaseType_t prvSizeClassFree( BlockLink_t * pxLink );
+
+/*
+ * Returns every block held by the size classes to the free list, where it is
+ * merged with its free neighbours.  Returns pdFALSE if the size classes held
+ * no blocks.
+ */
+    static BaseType_t prvSizeClassFlush( void );
+
+#endif /* configHEAP_SIZE_CLASS_COUNT */
+
 /*-----------------------------------------------------------*/
 
 /* The size of the structure placed at the beginning of each allocated memory
@@ -151,9 +321,53 @@ static size_t xMinimumEverFreeBytesRemaining = 0U;
 static size_t xNumberOfSuccessfulAllocations = 0;
 static size_t xNumberOfSuccessfulFrees = 0;
 
+#if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+
+/* Freed blocks kept for reuse, and the number of blocks on each list.  The
+ * blocks are linked through their pxNextFreeBlock members, and count as free
+ * memory in xFreeBytesRemaining. */
+    static BlockLink_t * pxSizeClassLists[ configHEAP_SIZE_CLASS_COUNT ];
+    static UBaseType_t uxSizeClassListLengths[ configHEAP_SIZE_CLASS_COUNT ];
+
+#endif /* configHEAP_SIZE_CLASS_COUNT */
+
+#if ( configUSE_HEAP_REGION_CAPS == 1 )
+
+/* The regions in address order, as passed to vPortDefineHeapRegions(). */
+    static HeapRegionInfo_t xRegionInfo[ configHEAP_MAX_REGIONS ];
+    static UBaseType_t uxNumberOfRegions = 0;
+
+#endif /* configUSE_HEAP_REGION_CAPS */
+
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+/* The histograms recorded by pvPortMalloc().  xFreeBlockSizes is only filled
+ * in when the histograms are read. */
+    static HeapInstrumentation_t xInstrumentation;
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+
 /*-----------------------------------------------------------*/
 
 void * pvPortMalloc( size_t xWantedSize )
+{
+    return prvHeapMalloc( xWantedSize, 0U );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_REGION_CAPS == 1 )
+
+    void * pvPortMallocCaps( size_t xWantedSize,
+                             uint32_t ulCaps )
+    {
+        return prvHeapMalloc( xWantedSize, ulCaps );
+    }
+
+#endif /* configUSE_HEAP_REGION_CAPS */
+/*-----------------------------------------------------------*/
+
+static void * prvHeapMalloc( size_t xWantedSize,
+                             uint32_t ulCaps )
 {
     BlockLink_t * pxBlock;
     BlockLink_t * pxPreviousBlock;
@@ -161,12 +375,29 @@ void * pvPortMalloc( size_t xWantedSize )
     void * pvReturn = NULL;
     size_t xAdditionalRequiredSize;
 
+    #if ( configUSE_HEAP_REGION_CAPS == 1 )
+        UBaseType_t uxRegion = 0;
+    #else
+        ( void ) ulCaps;
+    #endif
+
+    #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        size_t xRequestedSize = xWantedSize;
+        size_t xBlocksWalked = 0;
+        configRUN_TIME_COUNTER_TYPE ulStartTime, ulEndTime;
+    #endif
+
     /* The heap must be initialised before the first call to
      * prvPortMalloc(). */
     configASSERT( pxEnd );
 
     vTaskSuspendAll();
     {
+        #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        {
+            heapGET_RUN_TIME_COUNTER_VALUE( ulStartTime );
+        }
+        #endif
         if( xWantedSize > 0 )
         {
             /* The wanted size must be increased so it can contain a BlockLink_t
@@ -182,30 +413,81 @@ void * pvPortMalloc( size_t xWantedSize )
             {
                 xWantedSize = 0;
             }
+
+            /* A task that is over its quota cannot allocate, whether or not
+             * the heap has space. */
+            if( heapQUOTA_ALLOWS( xWantedSize ) == pdFALSE )
+            {
+                xWantedSize = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+        {
+            /* Small requests are first offered to their size class.  The
+             * blocks kept by the size classes can be in any region, so they
+             * are not offered to requests that need particular capabilities. */
+            if( ulCaps == 0U )
+            {
+                pvReturn = prvSizeClassMalloc( &xWantedSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
         /* Check the block size we are trying to allocate is not so large that the
          * top bit is set.  The top bit of the block size member of the BlockLink_t
          * structure is used to determine who owns the block - the application or
          * the kernel, so it must be free. */
         if( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 )
         {
-            if( ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
+            if( ( pvReturn == NULL ) && ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) )
             {
                 /* Traverse the list from the start (lowest address) block until
-                 * one of adequate size is found. */
-                pxPreviousBlock = &xStart;
-                pxBlock = xStart.pxNextFreeBlock;
-
-                while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+                 * one of adequate size is found.  If there is none, the blocks
+                 * held by the size classes, which are never merged with their
+                 * neighbours, are returned to the free list and the list is
+                 * searched again. */
+                do
                 {
-                    pxPreviousBlock = pxBlock;
-                    pxBlock = pxBlock->pxNextFreeBlock;
-                }
+                    pxPreviousBlock = &xStart;
+                    pxBlock = xStart.pxNextFreeBlock;
+
+                    #if ( configUSE_HEAP_REGION_CAPS == 1 )
+                    {
+                        uxRegion = 0;
+
+                        /* Blocks in regions without the requested capabilities
+                         * are passed over as if they were too small. */
+                        while( ( ( pxBlock->xBlockSize < xWantedSize ) || ( prvBlockLacksCaps( pxBlock, ulCaps, &uxRegion ) != pdFALSE ) ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+                        {
+                            pxPreviousBlock = pxBlock;
+                            pxBlock = pxBlock->pxNextFreeBlock;
+                            heapCOUNT_BLOCK_WALKED();
+                        }
+                    }
+                    #else
+                    {
+                        while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+                        {
+                            pxPreviousBlock = pxBlock;
+                            pxBlock = pxBlock->pxNextFreeBlock;
+                            heapCOUNT_BLOCK_WALKED();
+                        }
+                    }
+                    #endif /* configUSE_HEAP_REGION_CAPS */
+                } while( ( pxBlock == pxEnd ) && ( heapFLUSH_SIZE_CLASSES() != pdFALSE ) );
 
                 /* If the end marker was reached then a block of adequate size
                  * was not found. */
@@ -258,6 +540,12 @@ void * pvPortMalloc( size_t xWantedSize )
                     heapALLOCATE_BLOCK( pxBlock );
                     pxBlock->pxNextFreeBlock = NULL;
                     xNumberOfSuccessfulAllocations++;
+
+                    #if ( configUSE_HEAP_REGION_CAPS == 1 )
+                    {
+                        prvRegionBlockAllocated( uxRegion, pxBlock );
+                    }
+                    #endif
                 }
                 else
                 {
@@ -274,6 +562,27 @@ void * pvPortMalloc( size_t xWantedSize )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        {
+            if( pvReturn != NULL )
+            {
+                pxBlock = ( void * ) ( ( ( uint8_t * ) pvReturn ) - xHeapStructSize );
+                pxBlock->xOwner = xTaskHeapCharge( pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
+        #if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+        {
+            heapGET_RUN_TIME_COUNTER_VALUE( ulEndTime );
+            prvInstrumentMalloc( xRequestedSize, pvReturn, xBlocksWalked, ulEndTime - ulStartTime );
+        }
+        #endif
+
         traceMALLOC( pvReturn, xWantedSize );
     }
     ( void ) xTaskResumeAll();
@@ -300,6 +609,11 @@ void vPortFree( void * pv )
     uint8_t * puc = ( uint8_t * ) pv;
     BlockLink_t * pxLink;
 
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        TaskHandle_t xOwner;
+        size_t xBlockSize;
+    #endif
+
     if( pv != NULL )
     {
         /* The memory being freed will have an BlockLink_t structure immediately
@@ -327,11 +641,52 @@ void vPortFree( void * pv )
 
                 vTaskSuspendAll();
                 {
+                    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                    {
+                        /* Inserting the block can merge it with its
+                         * neighbours, so take a copy of what the release
+                         * needs first. */
+                        xOwner = pxLink->xOwner;
+                        xBlockSize = pxLink->xBlockSize;
+                    }
+                    #endif
+
                     /* Add this block to the list of free blocks. */
                     xFreeBytesRemaining += pxLink->xBlockSize;
                     traceFREE( pv, pxLink->xBlockSize );
-                    prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+
+                    #if ( configUSE_HEAP_REGION_CAPS == 1 )
+                    {
+                        UBaseType_t uxRegion = prvRegionIndex( pxLink );
+
+                        xRegionInfo[ uxRegion ].xFreeBytesRemaining += pxLink->xBlockSize;
+                        xRegionInfo[ uxRegion ].xNumberOfSuccessfulFrees++;
+                    }
+                    #endif
+
+                    #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+                    {
+                        if( prvSizeClassFree( pxLink ) == pdFALSE )
+                        {
+                            prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else
+                    {
+                        prvInsertBlockIntoFreeList( ( ( BlockLink_t * ) pxLink ) );
+                    }
+                    #endif
                     xNumberOfSuccessfulFrees++;
+
+                    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                    {
+                        vTaskHeapRelease( xOwner, xBlockSize );
+                    }
+                    #endif
                 }
                 ( void ) xTaskResumeAll();
             }
@@ -379,113 +734,781 @@ void * pvPortCalloc( size_t xNum,
 }
 /*-----------------------------------------------------------*/
 
-static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert )
-{
-    BlockLink_t * pxIterator;
-    uint8_t * puc;
-
-    /* Iterate through the list until a block is found that has a higher address
-     * than the block being inserted. */
-    for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
-    {
-        /* Nothing to do here, just iterate to the right position. */
-    }
-
-    /* Do the block being inserted, and the block it is being inserted after
-     * make a contiguous block of memory? */
-    puc = ( uint8_t * ) pxIterator;
-
-    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
-    {
-        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
-        pxBlockToInsert = pxIterator;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-
-    /* Do the block being inserted, and the block it is being inserted before
-     * make a contiguous block of memory? */
-    puc = ( uint8_t * ) pxBlockToInsert;
+#if ( configSUPPORT_HEAP_REALLOC == 1 )
 
-    if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+    void * pvPortRealloc( void * pv,
+                          size_t xWantedSize )
     {
-        if( pxIterator->pxNextFreeBlock != pxEnd )
+        BlockLink_t * pxLink;
+        BlockLink_t * pxIterator;
+        BlockLink_t * pxNextBlock;
+        BlockLink_t * pxNewBlockLink;
+        void * pvReturn = NULL;
+        size_t xBlockSize;
+        size_t xRequiredSize = 0;
+        size_t xAdditionalRequiredSize;
+
+        #if ( configUSE_HEAP_REGION_CAPS == 1 )
+            UBaseType_t uxRegion;
+            size_t xOriginalBlockSize;
+        #endif
+
+        #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+            TaskHandle_t xOriginalOwner;
+            size_t xOriginalSize;
+        #endif
+
+        if( pv == NULL )
         {
-            /* Form one big block from the two blocks. */
-            pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
-            pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+            /* As realloc(), a NULL block means allocate a new block. */
+            pvReturn = pvPortMalloc( xWantedSize );
         }
-        else
+        else if( xWantedSize == 0 )
         {
-            pxBlockToInsert->pxNextFreeBlock = pxEnd;
+            /* As realloc(), a zero size means free the block. */
+            vPortFree( pv );
         }
-    }
-    else
-    {
-        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
-    }
+        else
+        {
+            pxLink = ( void * ) ( ( ( uint8_t * ) pv ) - xHeapStructSize );
 
-    /* If the block being inserted plugged a gab, so was merged with the block
-     * before and the block after, then it's pxNextFreeBlock pointer will have
-     * already been set, and should not be set here as that would make it point
-     * to itself. */
-    if( pxIterator != pxBlockToInsert )
-    {
-        pxIterator->pxNextFreeBlock = pxBlockToInsert;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-}
-/*-----------------------------------------------------------*/
+            configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+            configASSERT( pxLink->pxNextFreeBlock == NULL );
 
-void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
-{
-    BlockLink_t * pxFirstFreeBlockInRegion = NULL;
-    BlockLink_t * pxPreviousFreeBlock;
-    portPOINTER_SIZE_TYPE xAlignedHeap;
-    size_t xTotalRegionSize, xTotalHeapSize = 0;
-    BaseType_t xDefinedRegions = 0;
-    portPOINTER_SIZE_TYPE xAddress;
-    const HeapRegion_t * pxHeapRegion;
+            /* Work out the size of block needed in the same way as
+             * pvPortMalloc(). */
+            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
 
-    /* Can only call once! */
-    configASSERT( pxEnd == NULL );
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xRequiredSize = xWantedSize + xAdditionalRequiredSize;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+            vTaskSuspendAll();
+            {
+                xBlockSize = pxLink->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK;
 
-    while( pxHeapRegion->xSizeInBytes > 0 )
-    {
-        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+                #if ( configUSE_HEAP_REGION_CAPS == 1 )
+                {
+                    uxRegion = prvRegionIndex( pxLink );
+                    xOriginalBlockSize = xBlockSize;
+                }
+                #endif
 
-        /* Ensure the heap region starts on a correctly aligned boundary. */
-        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+                #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                {
+                    xOriginalOwner = pxLink->xOwner;
+                    xOriginalSize = xBlockSize;
+                }
+                #endif
 
-        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
-        {
-            xAddress += ( portBYTE_ALIGNMENT - 1 );
-            xAddress &= ~portBYTE_ALIGNMENT_MASK;
+                if( ( xRequiredSize > xBlockSize ) && ( heapBLOCK_SIZE_IS_VALID( xRequiredSize ) != 0 ) )
+                {
+                    /* Growing, which can be done in place only if the block
+                     * that follows is free and large enough.  Find the first
+                     * free block after this one. */
+                    for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxLink; pxIterator = pxIterator->pxNextFreeBlock )
+                    {
+                        /* Nothing to do here, just iterate to the right position. */
+                    }
 
-            /* Adjust the size for the bytes lost to alignment. */
-            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
-        }
+                    pxNextBlock = pxIterator->pxNextFreeBlock;
 
-        xAlignedHeap = xAddress;
+                    if( ( pxNextBlock != pxEnd ) &&
+                        ( ( ( ( uint8_t * ) pxLink ) + xBlockSize ) == ( uint8_t * ) pxNextBlock ) &&
+                        ( ( xRequiredSize - xBlockSize ) <= pxNextBlock->xBlockSize ) &&
+                        ( heapQUOTA_ALLOWS( xRequiredSize - xBlockSize ) != pdFALSE ) )
+                    {
+                        /* Take the following block out of the free list and
+                         * join it to this one. */
+                        pxIterator->pxNextFreeBlock = pxNextBlock->pxNextFreeBlock;
+                        xFreeBytesRemaining -= pxNextBlock->xBlockSize;
+                        xBlockSize += pxNextBlock->xBlockSize;
+                        pvReturn = pv;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else if( xRequiredSize != 0 )
+                {
+                    /* Shrinking, or the block is already large enough. */
+                    pvReturn = pv;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
 
-        /* Set xStart if it has not already been set. */
-        if( xDefinedRegions == 0 )
-        {
-            /* xStart is used to hold a pointer to the first item in the list of
-             *  free blocks.  The void cast is used to prevent compiler warnings. */
-            xStart.pxNextFreeBlock = ( BlockLink_t * ) xAlignedHeap;
-            xStart.xBlockSize = ( size_t ) 0;
-        }
-        else
-        {
-            /* Should only get here if one region has already been added to the
+                if( pvReturn != NULL )
+                {
+                    /* Return anything beyond the required size to the free
+                     * list, where it is merged with the block that follows if
+                     * that block is also free. */
+                    if( ( xBlockSize - xRequiredSize ) > heapMINIMUM_BLOCK_SIZE )
+                    {
+                        pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxLink ) + xRequiredSize );
+                        pxNewBlockLink->xBlockSize = xBlockSize - xRequiredSize;
+                        xBlockSize = xRequiredSize;
+
+                        #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                        {
+                            ( void ) memset( ( ( uint8_t * ) pxNewBlockLink ) + xHeapStructSize, 0, pxNewBlockLink->xBlockSize - xHeapStructSize );
+                        }
+                        #endif
+
+                        xFreeBytesRemaining += pxNewBlockLink->xBlockSize;
+                        prvInsertBlockIntoFreeList( pxNewBlockLink );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                    {
+                        xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxLink->xBlockSize = xBlockSize;
+                    heapALLOCATE_BLOCK( pxLink );
+
+                    #if ( configUSE_HEAP_REGION_CAPS == 1 )
+                    {
+                        /* The block only grows into, or shrinks back to, its
+                         * own region. */
+                        xRegionInfo[ uxRegion ].xFreeBytesRemaining += xOriginalBlockSize;
+                        xRegionInfo[ uxRegion ].xFreeBytesRemaining -= xBlockSize;
+
+                        if( xRegionInfo[ uxRegion ].xFreeBytesRemaining < xRegionInfo[ uxRegion ].xMinimumEverFreeBytesRemaining )
+                        {
+                            xRegionInfo[ uxRegion ].xMinimumEverFreeBytesRemaining = xRegionInfo[ uxRegion ].xFreeBytesRemaining;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configUSE_HEAP_REGION_CAPS */
+
+                    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                    {
+                        /* The resized block is charged to the calling task,
+                         * as it would be had the block been moved. */
+                        pxLink->xOwner = xTaskHeapCharge( xBlockSize );
+                        vTaskHeapRelease( xOriginalOwner, xOriginalSize );
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            if( ( pvReturn == NULL ) && ( xRequiredSize != 0 ) )
+            {
+                /* The block could not be resized in place so move it.  The
+                 * original block is left untouched if that fails. */
+                #if ( configUSE_HEAP_REGION_CAPS == 1 )
+                {
+                    /* Keep the block in memory with the same capabilities. */
+                    pvReturn = prvHeapMalloc( xWantedSize, xRegionInfo[ uxRegion ].ulCaps );
+                }
+                #else
+                {
+                    pvReturn = pvPortMalloc( xWantedSize );
+                }
+                #endif
+
+                if( pvReturn != NULL )
+                {
+                    ( void ) memcpy( pvReturn, pv, xBlockSize - xHeapStructSize );
+                    vPortFree( pv );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return pvReturn;
+    }
+
+#endif /* configSUPPORT_HEAP_REALLOC */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_HEAP_ALIGNED_ALLOC == 1 )
+
+    void * pvPortMallocAligned( size_t xWantedSize,
+                                size_t xAlignment )
+    {
+        BlockLink_t * pxBlock;
+        BlockLink_t * pxPreviousBlock;
+        BlockLink_t * pxNewBlockLink;
+        void * pvReturn = NULL;
+        size_t xAdditionalRequiredSize;
+        size_t xLeadingSize = 0;
+        portPOINTER_SIZE_TYPE xAddress;
+
+        /* The alignment must be a power of two. */
+        configASSERT( ( xAlignment != 0 ) && ( ( xAlignment & ( xAlignment - 1U ) ) == 0 ) );
+
+        if( xAlignment <= ( size_t ) portBYTE_ALIGNMENT )
+        {
+            /* Every block is aligned to portBYTE_ALIGNMENT anyway. */
+            pvReturn = pvPortMalloc( xWantedSize );
+        }
+        else
+        {
+            /* The heap must be initialised before the first call to
+             * pvPortMallocAligned(). */
+            configASSERT( pxEnd );
+
+            vTaskSuspendAll();
+            {
+                if( xWantedSize > 0 )
+                {
+                    xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+                    if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+                    {
+                        xWantedSize += xAdditionalRequiredSize;
+                    }
+                    else
+                    {
+                        xWantedSize = 0;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( ( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 ) && ( xWantedSize > 0 ) && ( xWantedSize <= xFreeBytesRemaining ) &&
+                    ( heapQUOTA_ALLOWS( xWantedSize ) != pdFALSE ) )
+                {
+                    pxPreviousBlock = &xStart;
+                    pxBlock = xStart.pxNextFreeBlock;
+
+                    while( pxBlock != pxEnd )
+                    {
+                        /* Find the first suitably aligned address in the block
+                         * that leaves room for the BlockLink_t structure, and
+                         * that leaves either nothing or a whole free block in
+                         * front of it. */
+                        xAddress = ( ( portPOINTER_SIZE_TYPE ) pxBlock ) + xHeapStructSize;
+                        xAddress = ( xAddress + ( xAlignment - 1U ) ) & ~( ( portPOINTER_SIZE_TYPE ) xAlignment - 1U );
+                        xLeadingSize = ( size_t ) ( xAddress - ( ( portPOINTER_SIZE_TYPE ) pxBlock ) ) - xHeapStructSize;
+
+                        while( ( xLeadingSize != 0 ) && ( xLeadingSize < heapMINIMUM_BLOCK_SIZE ) )
+                        {
+                            xLeadingSize += xAlignment;
+                        }
+
+                        if( ( xLeadingSize < pxBlock->xBlockSize ) && ( xWantedSize <= ( pxBlock->xBlockSize - xLeadingSize ) ) )
+                        {
+                            break;
+                        }
+
+                        pxPreviousBlock = pxBlock;
+                        pxBlock = pxBlock->pxNextFreeBlock;
+                    }
+
+                    if( pxBlock != pxEnd )
+                    {
+                        /* This block is being returned for use so must be taken
+                         * out of the list of free blocks. */
+                        pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+                        if( xLeadingSize != 0 )
+                        {
+                            /* Return the space in front of the aligned block
+                             * to the free list. */
+                            pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xLeadingSize );
+                            pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xLeadingSize;
+                            pxBlock->xBlockSize = xLeadingSize;
+                            prvInsertBlockIntoFreeList( pxBlock );
+                            pxBlock = pxNewBlockLink;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+                        {
+                            pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                            pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                            pxBlock->xBlockSize = xWantedSize;
+                            prvInsertBlockIntoFreeList( pxNewBlockLink );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                        if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                        {
+                            xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                        {
+                            pxBlock->xOwner = xTaskHeapCharge( pxBlock->xBlockSize );
+                        }
+                        #endif
+
+                        heapALLOCATE_BLOCK( pxBlock );
+                        pxBlock->pxNextFreeBlock = NULL;
+                        xNumberOfSuccessfulAllocations++;
+
+                        #if ( configUSE_HEAP_REGION_CAPS == 1 )
+                        {
+                            prvRegionBlockAllocated( prvRegionIndex( pxBlock ), pxBlock );
+                        }
+                        #endif
+
+                        pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceMALLOC( pvReturn, xWantedSize );
+            }
+            ( void ) xTaskResumeAll();
+
+            #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+            {
+                if( pvReturn == NULL )
+                {
+                    vApplicationMallocFailedHook();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+        }
+
+        return pvReturn;
+    }
+
+#endif /* configSUPPORT_HEAP_ALIGNED_ALLOC */
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( BlockLink_t * pxBlockToInsert )
+{
+    BlockLink_t * pxIterator;
+    uint8_t * puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+     * than the block being inserted. */
+    for( pxIterator = &xStart; pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+    {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxIterator;
+
+    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    {
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Do the block being inserted, and the block it is being inserted before
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxBlockToInsert;
+
+    if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+    {
+        if( pxIterator->pxNextFreeBlock != pxEnd )
+        {
+            /* Form one big block from the two blocks. */
+            pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+            pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+        }
+        else
+        {
+            pxBlockToInsert->pxNextFreeBlock = pxEnd;
+        }
+    }
+    else
+    {
+        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+    }
+
+    /* If the block being inserted plugged a gab, so was merged with the block
+     * before and the block after, then it's pxNextFreeBlock pointer will have
+     * already been set, and should not be set here as that would make it point
+     * to itself. */
+    if( pxIterator != pxBlockToInsert )
+    {
+        pxIterator->pxNextFreeBlock = pxBlockToInsert;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+
+    static void * prvSizeClassMalloc( size_t * pxWantedSize )
+    {
+        BlockLink_t * pxBlock;
+        void * pvReturn = NULL;
+        size_t xClass;
+
+        /* Sizes that are zero or too large to be in a size class are left for
+         * the free list to deal with. */
+        if( ( *pxWantedSize > xHeapStructSize ) &&
+            ( *pxWantedSize <= ( xHeapStructSize + ( ( size_t ) configHEAP_SIZE_CLASS_COUNT * ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY ) ) ) )
+        {
+            /* Round the request up to the size of its class so the block can
+             * be reused for any request in the same class once it is freed. */
+            xClass = ( *pxWantedSize - xHeapStructSize - 1U ) / ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY;
+            *pxWantedSize = xHeapStructSize + ( ( xClass + 1U ) * ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY );
+
+            pxBlock = pxSizeClassLists[ xClass ];
+
+            if( pxBlock != NULL )
+            {
+                pxSizeClassLists[ xClass ] = pxBlock->pxNextFreeBlock;
+                uxSizeClassListLengths[ xClass ]--;
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application and has no "next" block. */
+                heapALLOCATE_BLOCK( pxBlock );
+                pxBlock->pxNextFreeBlock = NULL;
+                xNumberOfSuccessfulAllocations++;
+
+                #if ( configUSE_HEAP_REGION_CAPS == 1 )
+                {
+                    prvRegionBlockAllocated( prvRegionIndex( pxBlock ), pxBlock );
+                }
+                #endif
+
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSizeClassFree( BlockLink_t * pxLink )
+    {
+        BaseType_t xReturn = pdFALSE;
+        size_t xClass;
+
+        /* Only blocks that are exactly the size of a size class are kept - a
+         * larger block may have been allocated when the remainder was too small
+         * to split off. */
+        if( ( pxLink->xBlockSize > xHeapStructSize ) &&
+            ( ( ( pxLink->xBlockSize - xHeapStructSize ) % ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY ) == 0U ) )
+        {
+            xClass = ( ( pxLink->xBlockSize - xHeapStructSize ) / ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY ) - 1U;
+
+            if( ( xClass < ( size_t ) configHEAP_SIZE_CLASS_COUNT ) &&
+                ( uxSizeClassListLengths[ xClass ] < ( UBaseType_t ) configHEAP_SIZE_CLASS_CACHE_LENGTH ) )
+            {
+                pxLink->pxNextFreeBlock = pxSizeClassLists[ xClass ];
+                pxSizeClassLists[ xClass ] = pxLink;
+                uxSizeClassListLengths[ xClass ]++;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSizeClassFlush( void )
+    {
+        BlockLink_t * pxBlock;
+        BaseType_t xReturn = pdFALSE;
+        size_t xClass;
+
+        /* The blocks already count as free memory, so only their place in
+         * the heap changes. */
+        for( xClass = 0; xClass < ( size_t ) configHEAP_SIZE_CLASS_COUNT; xClass++ )
+        {
+            while( pxSizeClassLists[ xClass ] != NULL )
+            {
+                pxBlock = pxSizeClassLists[ xClass ];
+                pxSizeClassLists[ xClass ] = pxBlock->pxNextFreeBlock;
+                prvInsertBlockIntoFreeList( pxBlock );
+                xReturn = pdTRUE;
+            }
+
+            uxSizeClassListLengths[ xClass ] = 0;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configHEAP_SIZE_CLASS_COUNT */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_HEAP_REGION_CAPS == 1 )
+
+    static UBaseType_t prvRegionIndex( const void * pv )
+    {
+        UBaseType_t uxRegion = 0;
+
+        /* Anything beyond the second to last region must be in the last. */
+        while( ( ( uxRegion + 1U ) < uxNumberOfRegions ) &&
+               ( ( portPOINTER_SIZE_TYPE ) pv >= xRegionInfo[ uxRegion ].xEndAddress ) )
+        {
+            uxRegion++;
+        }
+
+        return uxRegion;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvBlockLacksCaps( const BlockLink_t * pxBlock,
+                                         uint32_t ulCaps,
+                                         UBaseType_t * puxRegion )
+    {
+        while( ( ( *puxRegion + 1U ) < uxNumberOfRegions ) &&
+               ( ( portPOINTER_SIZE_TYPE ) pxBlock >= xRegionInfo[ *puxRegion ].xEndAddress ) )
+        {
+            ( *puxRegion )++;
+        }
+
+        return ( ( xRegionInfo[ *puxRegion ].ulCaps & ulCaps ) != ulCaps ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRegionBlockAllocated( UBaseType_t uxRegion,
+                                         const BlockLink_t * pxBlock )
+    {
+        HeapRegionInfo_t * pxRegion = &( xRegionInfo[ uxRegion ] );
+
+        /* The allocated bit is already set, so mask it out of the size. */
+        pxRegion->xFreeBytesRemaining -= ( pxBlock->xBlockSize & ~heapBLOCK_ALLOCATED_BITMASK );
+
+        if( pxRegion->xFreeBytesRemaining < pxRegion->xMinimumEverFreeBytesRemaining )
+        {
+            pxRegion->xMinimumEverFreeBytesRemaining = pxRegion->xFreeBytesRemaining;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxRegion->xNumberOfSuccessfulAllocations++;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xPortGetHeapRegionStats( BaseType_t xRegion,
+                                        HeapStats_t * pxHeapStats )
+    {
+        BlockLink_t * pxBlock;
+        HeapRegionInfo_t * pxRegion;
+        size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+        BaseType_t xReturn = pdFAIL;
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+            UBaseType_t uxClass;
+        #endif
+
+        if( ( xRegion >= 0 ) && ( ( UBaseType_t ) xRegion < uxNumberOfRegions ) )
+        {
+            pxRegion = &( xRegionInfo[ xRegion ] );
+
+            vTaskSuspendAll();
+            {
+                /* The free list is in address order, so the blocks in the
+                 * region are found together. */
+                pxBlock = xStart.pxNextFreeBlock;
+
+                while( ( pxBlock != NULL ) && ( ( portPOINTER_SIZE_TYPE ) pxBlock < pxRegion->xEndAddress ) )
+                {
+                    /* Skip blocks in earlier regions, and the zero sized
+                     * markers at the end of each region. */
+                    if( ( ( portPOINTER_SIZE_TYPE ) pxBlock >= pxRegion->xStartAddress ) && ( pxBlock->xBlockSize != 0 ) )
+                    {
+                        xBlocks++;
+
+                        if( pxBlock->xBlockSize > xMaxSize )
+                        {
+                            xMaxSize = pxBlock->xBlockSize;
+                        }
+
+                        if( pxBlock->xBlockSize < xMinSize )
+                        {
+                            xMinSize = pxBlock->xBlockSize;
+                        }
+                    }
+
+                    pxBlock = pxBlock->pxNextFreeBlock;
+                }
+
+                #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+                {
+                    /* Blocks held by the size classes are free blocks too. */
+                    for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT; uxClass++ )
+                    {
+                        for( pxBlock = pxSizeClassLists[ uxClass ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                        {
+                            if( ( ( portPOINTER_SIZE_TYPE ) pxBlock >= pxRegion->xStartAddress ) && ( ( portPOINTER_SIZE_TYPE ) pxBlock < pxRegion->xEndAddress ) )
+                            {
+                                xBlocks++;
+
+                                if( pxBlock->xBlockSize > xMaxSize )
+                                {
+                                    xMaxSize = pxBlock->xBlockSize;
+                                }
+
+                                if( pxBlock->xBlockSize < xMinSize )
+                                {
+                                    xMinSize = pxBlock->xBlockSize;
+                                }
+                            }
+                        }
+                    }
+                }
+                #endif /* configHEAP_SIZE_CLASS_COUNT */
+            }
+            ( void ) xTaskResumeAll();
+
+            pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+            pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+            pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+            taskENTER_CRITICAL();
+            {
+                pxHeapStats->xAvailableHeapSpaceInBytes = pxRegion->xFreeBytesRemaining;
+                pxHeapStats->xNumberOfSuccessfulAllocations = pxRegion->xNumberOfSuccessfulAllocations;
+                pxHeapStats->xNumberOfSuccessfulFrees = pxRegion->xNumberOfSuccessfulFrees;
+                pxHeapStats->xMinimumEverFreeBytesRemaining = pxRegion->xMinimumEverFreeBytesRemaining;
+            }
+            taskEXIT_CRITICAL();
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_HEAP_REGION_CAPS */
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+    BlockLink_t * pxFirstFreeBlockInRegion = NULL;
+    BlockLink_t * pxPreviousFreeBlock;
+    portPOINTER_SIZE_TYPE xAlignedHeap;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( pxEnd == NULL );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            xAddress += ( portBYTE_ALIGNMENT - 1 );
+            xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* Set xStart if it has not already been set. */
+        if( xDefinedRegions == 0 )
+        {
+            /* xStart is used to hold a pointer to the first item in the list of
+             *  free blocks.  The void cast is used to prevent compiler warnings. */
+            xStart.pxNextFreeBlock = ( BlockLink_t * ) xAlignedHeap;
+            xStart.xBlockSize = ( size_t ) 0;
+        }
+        else
+        {
+            /* Should only get here if one region has already been added to the
              * heap. */
             configASSERT( pxEnd != NULL );
 
@@ -522,6 +1545,27 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
 
         xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
 
+        #if ( configUSE_HEAP_REGION_CAPS == 1 )
+        {
+            configASSERT( xDefinedRegions < configHEAP_MAX_REGIONS );
+
+            if( xDefinedRegions < configHEAP_MAX_REGIONS )
+            {
+                /* The end marker is part of the region. */
+                xRegionInfo[ xDefinedRegions ].xStartAddress = xAlignedHeap;
+                xRegionInfo[ xDefinedRegions ].xEndAddress = xAddress + xHeapStructSize;
+                xRegionInfo[ xDefinedRegions ].ulCaps = pxHeapRegion->ulCaps;
+                xRegionInfo[ xDefinedRegions ].xFreeBytesRemaining = pxFirstFreeBlockInRegion->xBlockSize;
+                xRegionInfo[ xDefinedRegions ].xMinimumEverFreeBytesRemaining = pxFirstFreeBlockInRegion->xBlockSize;
+                uxNumberOfRegions = ( UBaseType_t ) xDefinedRegions + 1U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_HEAP_REGION_CAPS */
+
         /* Move onto the next HeapRegion_t structure. */
         xDefinedRegions++;
         pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
@@ -535,11 +1579,125 @@ void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_HEAP_INSTRUMENTATION == 1 )
+
+    static UBaseType_t prvInstrumentationBucket( size_t xValue )
+    {
+        UBaseType_t uxBucket = 0;
+
+        while( ( xValue > ( size_t ) 1U ) && ( uxBucket < ( ( UBaseType_t ) configHEAP_INSTRUMENTATION_BUCKETS - 1U ) ) )
+        {
+            xValue >>= 1;
+            uxBucket++;
+        }
+
+        return uxBucket;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvInstrumentMalloc( size_t xRequestedSize,
+                                     const void * pvReturn,
+                                     size_t xBlocksWalked,
+                                     configRUN_TIME_COUNTER_TYPE ulMallocTime )
+    {
+        xInstrumentation.xAllocationSizes[ prvInstrumentationBucket( xRequestedSize ) ]++;
+
+        if( pvReturn == NULL )
+        {
+            xInstrumentation.xNumberOfFailedAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xBlocksWalked > xInstrumentation.xLongestFreeListWalk )
+        {
+            xInstrumentation.xLongestFreeListWalk = xBlocksWalked;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            xInstrumentation.xMallocTimes[ prvInstrumentationBucket( ( size_t ) ulMallocTime ) ]++;
+        }
+        #endif
+
+        traceMALLOC_INSTRUMENTATION( pvReturn, xRequestedSize, xBlocksWalked, ulMallocTime );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortGetHeapInstrumentation( HeapInstrumentation_t * pxHeapInstrumentation )
+    {
+        BlockLink_t * pxBlock;
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+            UBaseType_t uxClass;
+        #endif
+
+        vTaskSuspendAll();
+        {
+            *pxHeapInstrumentation = xInstrumentation;
+
+            /* pxBlock will be NULL if the heap has not been defined. */
+            pxBlock = xStart.pxNextFreeBlock;
+
+            if( pxBlock != NULL )
+            {
+                while( pxBlock != pxEnd )
+                {
+                    /* Skip the zero sized markers at the end of each region. */
+                    if( pxBlock->xBlockSize != 0 )
+                    {
+                        pxHeapInstrumentation->xFreeBlockSizes[ prvInstrumentationBucket( pxBlock->xBlockSize ) ]++;
+                    }
+
+                    pxBlock = pxBlock->pxNextFreeBlock;
+                }
+            }
+
+            #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+            {
+                /* Blocks held by the size classes are free blocks too. */
+                for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT; uxClass++ )
+                {
+                    for( pxBlock = pxSizeClassLists[ uxClass ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                    {
+                        pxHeapInstrumentation->xFreeBlockSizes[ prvInstrumentationBucket( pxBlock->xBlockSize ) ]++;
+                    }
+                }
+            }
+            #endif /* configHEAP_SIZE_CLASS_COUNT */
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortResetHeapInstrumentation( void )
+    {
+        vTaskSuspendAll();
+        {
+            ( void ) memset( &xInstrumentation, 0, sizeof( xInstrumentation ) );
+        }
+        ( void ) xTaskResumeAll();
+    }
+
+#endif /* configUSE_HEAP_INSTRUMENTATION */
+/*-----------------------------------------------------------*/
+
 void vPortGetHeapStats( HeapStats_t * pxHeapStats )
 {
     BlockLink_t * pxBlock;
     size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
 
+    #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+        UBaseType_t uxClass;
+        size_t xClassBlockSize;
+    #endif
+
     vTaskSuspendAll();
     {
         pxBlock = xStart.pxNextFreeBlock;
@@ -575,6 +1733,30 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
                 pxBlock = pxBlock->pxNextFreeBlock;
             }
         }
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+        {
+            /* Blocks held by the size classes are free blocks too. */
+            for( uxClass = 0; uxClass < ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT; uxClass++ )
+            {
+                if( uxSizeClassListLengths[ uxClass ] > ( UBaseType_t ) 0U )
+                {
+                    xClassBlockSize = xHeapStructSize + ( ( ( size_t ) uxClass + 1U ) * ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY );
+                    xBlocks += ( size_t ) uxSizeClassListLengths[ uxClass ];
+
+                    if( xClassBlockSize > xMaxSize )
+                    {
+                        xMaxSize = xClassBlockSize;
+                    }
+
+                    if( xClassBlockSize < xMinSize )
+                    {
+                        xMinSize = xClassBlockSize;
+                    }
+                }
+            }
+        }
+        #endif /* configHEAP_SIZE_CLASS_COUNT */
     }
     ( void ) xTaskResumeAll();
 
@@ -592,3 +1774,42 @@ void vPortGetHeapStats( HeapStats_t * pxHeapStats )
     taskEXIT_CRITICAL();
 }
 /*-----------------------------------------------------------*/
+
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    void vPortWalkFreeBlocks( HeapFreeBlockFunction_t pxFunction,
+                              void * pvContext )
+    {
+        const BlockLink_t * pxBlock;
+        BaseType_t xContinue = pdTRUE;
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+            UBaseType_t uxClass;
+            size_t xClassBlockSize;
+        #endif
+
+        /* pxBlock will be NULL if the heap has not been initialised.  The NULL
+         * check also ends the walk if a corrupt link is found. */
+        for( pxBlock = xStart.pxNextFreeBlock; ( pxBlock != NULL ) && ( pxBlock != pxEnd ) && ( xContinue != pdFALSE ); pxBlock = pxBlock->pxNextFreeBlock )
+        {
+            xContinue = pxFunction( pxBlock, pxBlock->xBlockSize, pvContext );
+        }
+
+        #if ( configHEAP_SIZE_CLASS_COUNT > 0 )
+        {
+            /* Blocks held by the size classes are free blocks too. */
+            for( uxClass = 0; ( uxClass < ( UBaseType_t ) configHEAP_SIZE_CLASS_COUNT ) && ( xContinue != pdFALSE ); uxClass++ )
+            {
+                xClassBlockSize = xHeapStructSize + ( ( ( size_t ) uxClass + 1U ) * ( size_t ) configHEAP_SIZE_CLASS_GRANULARITY );
+
+                for( pxBlock = pxSizeClassLists[ uxClass ]; ( pxBlock != NULL ) && ( xContinue != pdFALSE ); pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xContinue = pxFunction( pxBlock, xClassBlockSize, pvContext );
+                }
+            }
+        }
+        #endif /* configHEAP_SIZE_CLASS_COUNT */
+    }
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
+/*-----------------------------------------------------------*/
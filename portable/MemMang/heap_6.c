@@ -0,0 +1,822 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() that executes in
+ * constant time, independent of the number of blocks in the heap or how
+ * fragmented it has become.  It uses a two-level segregated fit (TLSF)
+ * arrangement of free lists: free blocks are sorted into lists by size, a
+ * first level indexed by the power of two of the block size and a second level
+ * that linearly subdivides each power of two range.  A bitmap per level records
+ * which lists are non-empty so a suitable free block is found with a fixed
+ * number of bit operations rather than by walking a list.  Physically adjacent
+ * free blocks are combined (coalesced) as they are freed, again in constant
+ * time.
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c and heap_5.c for alternative
+ * implementations, and the memory management pages of https://www.FreeRTOS.org
+ * for more information.
+ *
+ * Usage notes:
+ *
+ * As with heap_5.c the heap can span multiple non-contiguous blocks of memory,
+ * and vPortDefineHeapRegions() ***must*** be called before pvPortMalloc().
+ * pvPortMalloc() will be called if any task objects (tasks, queues, event
+ * groups, etc.) are created, therefore vPortDefineHeapRegions() ***must*** be
+ * called before any other objects are defined.  See the usage notes at the top
+ * of heap_5.c for a description of the HeapRegion_t array that is passed into
+ * vPortDefineHeapRegions().
+ *
+ * The constant time guarantee comes at the cost of some internal
+ * fragmentation: a request is rounded up to the smallest size that is
+ * guaranteed to be satisfied by any block in the list it searches, so up to
+ * 1 / ( 2 ^ configHEAP_TLSF_SL_INDEX_COUNT_LOG2 ) of a request may be unused.
+ *
+ */
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* The log2 of the number of second level free lists each first level (power
+ * of two) size range is divided into.  Larger values reduce the memory wasted
+ * by rounding requests up, at the cost of a larger free list table. */
+#ifndef configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+    #define configHEAP_TLSF_SL_INDEX_COUNT_LOG2    4
+#endif
+
+/* The log2 of the size above which a single free block cannot be held.
+ * Regions larger than this are trimmed when they are added to the heap. */
+#ifndef configHEAP_TLSF_FL_INDEX_MAX
+    #define configHEAP_TLSF_FL_INDEX_MAX    30
+#endif
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* Block sizes are always a multiple of portBYTE_ALIGNMENT, so the bottom
+ * log2( portBYTE_ALIGNMENT ) bits of a size carry no information. */
+#if portBYTE_ALIGNMENT == 32
+    #define heapALIGNMENT_LOG2    5
+#elif portBYTE_ALIGNMENT == 16
+    #define heapALIGNMENT_LOG2    4
+#elif portBYTE_ALIGNMENT == 8
+    #define heapALIGNMENT_LOG2    3
+#elif portBYTE_ALIGNMENT == 4
+    #define heapALIGNMENT_LOG2    2
+#elif portBYTE_ALIGNMENT == 2
+    #define heapALIGNMENT_LOG2    1
+#elif portBYTE_ALIGNMENT == 1
+    #define heapALIGNMENT_LOG2    0
+#else
+    #error "Invalid portBYTE_ALIGNMENT definition"
+#endif
+
+/* Blocks smaller than heapSMALL_BLOCK_SIZE all live in first level list 0,
+ * which is divided linearly into second level lists portBYTE_ALIGNMENT bytes
+ * apart.  Above that every first level list covers one power of two. */
+#define heapSL_INDEX_COUNT        ( 1U << configHEAP_TLSF_SL_INDEX_COUNT_LOG2 )
+#define heapFL_INDEX_SHIFT        ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapFL_INDEX_COUNT        ( configHEAP_TLSF_FL_INDEX_MAX - heapFL_INDEX_SHIFT + 1 )
+#define heapSMALL_BLOCK_SIZE      ( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+#define heapMAX_BLOCK_SIZE        ( ( size_t ) 1 << configHEAP_TLSF_FL_INDEX_MAX )
+
+#if ( configHEAP_TLSF_SL_INDEX_COUNT_LOG2 > 5 )
+    #error configHEAP_TLSF_SL_INDEX_COUNT_LOG2 must not exceed 5 as each second level bitmap is 32 bits.
+#endif
+
+#if ( ( heapFL_INDEX_COUNT < 1 ) || ( heapFL_INDEX_COUNT > 31 ) )
+    #error configHEAP_TLSF_FL_INDEX_MAX is out of range for the first level bitmap.
+#endif
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+#define heapBLOCK_SIZE( pxBlock )                ( ( pxBlock->xBlockSize ) & ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* The block that physically follows pxBlock in memory. */
+#define heapNEXT_PHYSICAL_BLOCK( pxBlock )       ( ( BlockLink_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/*-----------------------------------------------------------*/
+
+/* Define the structure placed at the start of every block.  The first two
+ * members form the header that is present on every block.  The free list links
+ * are only valid while the block is free, and overlay the start of the
+ * application's memory while the block is allocated. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxPreviousPhysicalBlock; /*<< The block immediately below this one in memory, or NULL if this is the first block in its region. */
+    size_t xBlockSize;                             /*<< The size of the block, including the header. */
+    struct A_BLOCK_LINK * pxNextFreeBlock;         /*<< The next free block in the same size list. */
+    struct A_BLOCK_LINK * pxPreviousFreeBlock;     /*<< The previous free block in the same size list. */
+} BlockLink_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Returns the index of the most significant set bit in xValue, which must not
+ * be zero.  Always takes the same number of steps.
+ */
+static UBaseType_t prvFindLastSet( size_t xValue );
+
+/*
+ * Returns the first and second level indexes of the list that a free block of
+ * xBlockSize bytes is stored in.
+ */
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel );
+
+/*
+ * Finds a free block of at least xWantedSize bytes and removes it from its
+ * free list, or returns NULL if there is no such block.
+ */
+static BlockLink_t * prvFindSuitableBlock( size_t xWantedSize );
+
+/*
+ * Add a free block to, or remove a free block from, the list for its size.
+ */
+static void prvInsertFreeBlock( BlockLink_t * pxBlock );
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock );
+
+/*-----------------------------------------------------------*/
+
+/* The size of the header placed at the beginning of each allocated memory
+ * block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Block sizes must not get too small - a free block must be able to hold the
+ * free list links. */
+static const size_t xHeapMinimumBlockSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* Bit n of ulFirstLevelBitmap is set when any list in first level n is not
+ * empty.  Bit m of ulSecondLevelBitmaps[ n ] is set when list [ n ][ m ] is
+ * not empty. */
+static uint32_t ulFirstLevelBitmap = 0U;
+static uint32_t ulSecondLevelBitmaps[ heapFL_INDEX_COUNT ];
+
+/* The heads of the segregated free lists. */
+static BlockLink_t * pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+/* Set once vPortDefineHeapRegions() has been called. */
+static BaseType_t xHeapHasBeenInitialised = pdFALSE;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+ * number of free bytes remaining, but says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+
+    /* The heap must be initialised before the first call to
+     * prvPortMalloc(). */
+    configASSERT( xHeapHasBeenInitialised );
+
+    vTaskSuspendAll();
+    {
+        if( xWantedSize > 0 )
+        {
+            /* The wanted size must be increased so it can contain the block
+             * header in addition to the requested amount of bytes. Some
+             * additional increment may also be needed for alignment. */
+            xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+            if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+            {
+                xWantedSize += xAdditionalRequiredSize;
+
+                /* The block must be able to hold the free list links once it
+                 * is returned to the heap. */
+                if( xWantedSize < xHeapMinimumBlockSize )
+                {
+                    xWantedSize = xHeapMinimumBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                xWantedSize = 0;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Check the block size we are trying to allocate is not so large that
+         * it cannot be held in a free list.  That also guarantees the top bit,
+         * which is used to determine who owns the block, is clear. */
+        if( ( xWantedSize > 0 ) && ( xWantedSize < heapMAX_BLOCK_SIZE ) && ( xWantedSize <= xFreeBytesRemaining ) )
+        {
+            pxBlock = prvFindSuitableBlock( xWantedSize );
+
+            if( pxBlock != NULL )
+            {
+                /* If the block is larger than required it can be split into
+                 * two. */
+                if( ( pxBlock->xBlockSize - xWantedSize ) >= xHeapMinimumBlockSize )
+                {
+                    /* This block is to be split into two.  Create a new
+                     * block following the number of bytes requested. The void
+                     * cast is used to prevent byte alignment warnings from the
+                     * compiler. */
+                    pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+
+                    /* Calculate the sizes of two blocks split from the
+                     * single block, and keep the physical chain intact. */
+                    pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                    pxNewBlockLink->pxPreviousPhysicalBlock = pxBlock;
+                    heapNEXT_PHYSICAL_BLOCK( pxNewBlockLink )->pxPreviousPhysicalBlock = pxNewBlockLink;
+                    pxBlock->xBlockSize = xWantedSize;
+
+                    /* The block following the remainder is allocated (free
+                     * blocks are always coalesced) so the remainder can go
+                     * straight into a free list. */
+                    prvInsertFreeBlock( pxNewBlockLink );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+                if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+                {
+                    xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* The block is being returned - it is allocated and owned
+                 * by the application. */
+                heapALLOCATE_BLOCK( pxBlock );
+                xNumberOfSuccessfulAllocations++;
+
+                /* Return the memory space pointed to - jumping over the
+                 * block header at its start. */
+                pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    ( void ) xTaskResumeAll();
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    BlockLink_t * pxNeighbour;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have a block header immediately before
+         * it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            /* The block is being returned to the heap - it is no longer
+             * allocated. */
+            heapFREE_BLOCK( pxLink );
+            #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+            {
+                ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+            }
+            #endif
+
+            vTaskSuspendAll();
+            {
+                xFreeBytesRemaining += pxLink->xBlockSize;
+                traceFREE( pv, pxLink->xBlockSize );
+
+                /* Merge with the block physically above this one if it is
+                 * free.  The end of region marker is always marked as
+                 * allocated so is never merged. */
+                pxNeighbour = heapNEXT_PHYSICAL_BLOCK( pxLink );
+
+                if( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxLink->xBlockSize += pxNeighbour->xBlockSize;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Merge with the block physically below this one if it is
+                 * free. */
+                pxNeighbour = pxLink->pxPreviousPhysicalBlock;
+
+                if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_ALLOCATED( pxNeighbour ) == 0 ) )
+                {
+                    prvRemoveFreeBlock( pxNeighbour );
+                    pxNeighbour->xBlockSize += pxLink->xBlockSize;
+                    pxLink = pxNeighbour;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                heapNEXT_PHYSICAL_BLOCK( pxLink )->pxPreviousPhysicalBlock = pxLink;
+
+                /* Add this block to the list of free blocks. */
+                prvInsertFreeBlock( pxLink );
+                xNumberOfSuccessfulFrees++;
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvFindLastSet( size_t xValue )
+{
+    UBaseType_t uxBit = 0;
+    UBaseType_t uxShift;
+
+    /* Binary search for the top bit.  The loop always runs log2 of the width
+     * of size_t times, so the execution time does not depend on xValue. */
+    for( uxShift = ( UBaseType_t ) ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) >> 1 ); uxShift > 0U; uxShift >>= 1 )
+    {
+        if( xValue >= ( ( size_t ) 1 << uxShift ) )
+        {
+            xValue >>= uxShift;
+            uxBit += uxShift;
+        }
+    }
+
+    return uxBit;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize,
+                              UBaseType_t * puxFirstLevel,
+                              UBaseType_t * puxSecondLevel )
+{
+    UBaseType_t uxTopBit;
+
+    if( xBlockSize < heapSMALL_BLOCK_SIZE )
+    {
+        /* Small blocks are spread linearly across the first list. */
+        *puxFirstLevel = 0;
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+    }
+    else
+    {
+        /* The first level is the power of two range the size falls in, the
+         * second level is given by the next configHEAP_TLSF_SL_INDEX_COUNT_LOG2
+         * bits below the top bit. */
+        uxTopBit = prvFindLastSet( xBlockSize );
+        *puxSecondLevel = ( UBaseType_t ) ( xBlockSize >> ( uxTopBit - configHEAP_TLSF_SL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT;
+        *puxFirstLevel = uxTopBit - ( heapFL_INDEX_SHIFT - 1 );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t * prvFindSuitableBlock( size_t xWantedSize )
+{
+    BlockLink_t * pxBlock = NULL;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    uint32_t ulBitmap;
+
+    /* Round the size up to the start of the next list so that any block in
+     * the list that is searched is large enough, removing the need to search
+     * within a list. */
+    if( xWantedSize >= heapSMALL_BLOCK_SIZE )
+    {
+        xWantedSize += ( ( size_t ) 1 << ( prvFindLastSet( xWantedSize ) - configHEAP_TLSF_SL_INDEX_COUNT_LOG2 ) ) - 1U;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    prvMappingInsert( xWantedSize, &uxFirstLevel, &uxSecondLevel );
+
+    if( uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT )
+    {
+        /* Look for a non-empty list in the same first level range, starting
+         * from the computed second level list. */
+        ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ] & ( ~( uint32_t ) 0U << uxSecondLevel );
+
+        if( ulBitmap == 0U )
+        {
+            /* Nothing suitable in that range, so move up to the next
+             * non-empty first level range - any block in it is large
+             * enough. */
+            ulBitmap = ulFirstLevelBitmap & ( ~( uint32_t ) 0U << ( uxFirstLevel + 1U ) );
+
+            if( ulBitmap != 0U )
+            {
+                uxFirstLevel = prvFindLastSet( ( size_t ) ( ulBitmap & ( ~ulBitmap + 1U ) ) );
+                ulBitmap = ulSecondLevelBitmaps[ uxFirstLevel ];
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( ulBitmap != 0U )
+        {
+            /* Take the lowest set bit, which is the smallest suitable list. */
+            uxSecondLevel = prvFindLastSet( ( size_t ) ( ulBitmap & ( ~ulBitmap + 1U ) ) );
+            pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+            configASSERT( pxBlock != NULL );
+            prvRemoveFreeBlock( pxBlock );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+    /* Blocks are added to the front of their list. */
+    pxBlock->pxPreviousFreeBlock = NULL;
+    pxBlock->pxNextFreeBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ];
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock;
+    ulFirstLevelBitmap |= ( uint32_t ) 1U << uxFirstLevel;
+    ulSecondLevelBitmaps[ uxFirstLevel ] |= ( uint32_t ) 1U << uxSecondLevel;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( BlockLink_t * pxBlock )
+{
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+
+    prvMappingInsert( pxBlock->xBlockSize, &uxFirstLevel, &uxSecondLevel );
+
+    if( pxBlock->pxNextFreeBlock != NULL )
+    {
+        pxBlock->pxNextFreeBlock->pxPreviousFreeBlock = pxBlock->pxPreviousFreeBlock;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( pxBlock->pxPreviousFreeBlock != NULL )
+    {
+        pxBlock->pxPreviousFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+    }
+    else
+    {
+        /* The block was at the head of its list. */
+        pxFreeLists[ uxFirstLevel ][ uxSecondLevel ] = pxBlock->pxNextFreeBlock;
+
+        if( pxBlock->pxNextFreeBlock == NULL )
+        {
+            /* The list is now empty, as may be the whole first level
+             * range. */
+            ulSecondLevelBitmaps[ uxFirstLevel ] &= ~( ( uint32_t ) 1U << uxSecondLevel );
+
+            if( ulSecondLevelBitmaps[ uxFirstLevel ] == 0U )
+            {
+                ulFirstLevelBitmap &= ~( ( uint32_t ) 1U << uxFirstLevel );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+{
+    BlockLink_t * pxFirstFreeBlockInRegion;
+    BlockLink_t * pxEndOfRegion;
+    size_t xTotalRegionSize, xTotalHeapSize = 0;
+    BaseType_t xDefinedRegions = 0;
+    portPOINTER_SIZE_TYPE xAddress, xAlignedHeap;
+    const HeapRegion_t * pxHeapRegion;
+
+    /* Can only call once! */
+    configASSERT( xHeapHasBeenInitialised == pdFALSE );
+
+    pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+
+    while( pxHeapRegion->xSizeInBytes > 0 )
+    {
+        xTotalRegionSize = pxHeapRegion->xSizeInBytes;
+
+        /* Ensure the heap region starts on a correctly aligned boundary. */
+        xAddress = ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress;
+
+        if( ( xAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            xAddress += ( portBYTE_ALIGNMENT - 1 );
+            xAddress &= ~portBYTE_ALIGNMENT_MASK;
+
+            /* Adjust the size for the bytes lost to alignment. */
+            xTotalRegionSize -= ( size_t ) ( xAddress - ( portPOINTER_SIZE_TYPE ) pxHeapRegion->pucStartAddress );
+        }
+
+        xAlignedHeap = xAddress;
+
+        /* A single free block cannot be larger than the largest size the free
+         * lists can hold, so any excess at the top of the region is unused. */
+        if( xTotalRegionSize >= heapMAX_BLOCK_SIZE )
+        {
+            xTotalRegionSize = heapMAX_BLOCK_SIZE - portBYTE_ALIGNMENT;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Regions too small to hold a single block and the end marker are
+         * ignored. */
+        if( xTotalRegionSize >= ( xHeapMinimumBlockSize + ( xHeapStructSize << 1 ) ) )
+        {
+            /* pxEndOfRegion marks the end of the region.  It is a header-only
+             * block that is permanently marked as allocated so it is never
+             * merged with the last real block of the region. */
+            xAddress = xAlignedHeap + xTotalRegionSize;
+            xAddress -= xHeapStructSize;
+            xAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+            pxEndOfRegion = ( BlockLink_t * ) xAddress;
+
+            /* To start with there is a single free block in this region that
+             * is sized to take up the entire heap region minus the space taken
+             * by the end marker. */
+            pxFirstFreeBlockInRegion = ( BlockLink_t * ) xAlignedHeap;
+            pxFirstFreeBlockInRegion->xBlockSize = ( size_t ) ( xAddress - xAlignedHeap );
+            pxFirstFreeBlockInRegion->pxPreviousPhysicalBlock = NULL;
+
+            pxEndOfRegion->xBlockSize = 0;
+            heapALLOCATE_BLOCK( pxEndOfRegion );
+            pxEndOfRegion->pxPreviousPhysicalBlock = pxFirstFreeBlockInRegion;
+
+            prvInsertFreeBlock( pxFirstFreeBlockInRegion );
+            xTotalHeapSize += pxFirstFreeBlockInRegion->xBlockSize;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Move onto the next HeapRegion_t structure. */
+        xDefinedRegions++;
+        pxHeapRegion = &( pxHeapRegions[ xDefinedRegions ] );
+    }
+
+    xMinimumEverFreeBytesRemaining = xTotalHeapSize;
+    xFreeBytesRemaining = xTotalHeapSize;
+    xHeapHasBeenInitialised = pdTRUE;
+
+    /* Check something was actually defined before it is accessed. */
+    configASSERT( xTotalHeapSize );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    UBaseType_t uxFirstLevel, uxSecondLevel;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+
+    vTaskSuspendAll();
+    {
+        /* Unlike allocation and freeing this does walk every free block, but
+         * only lists the bitmaps mark as non-empty are visited. */
+        for( uxFirstLevel = 0; uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT; uxFirstLevel++ )
+        {
+            if( ( ulFirstLevelBitmap & ( ( uint32_t ) 1U << uxFirstLevel ) ) != 0U )
+            {
+                for( uxSecondLevel = 0; uxSecondLevel < ( UBaseType_t ) heapSL_INDEX_COUNT; uxSecondLevel++ )
+                {
+                    for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+                    {
+                        /* Increment the number of blocks and record the
+                         * largest and smallest blocks seen so far. */
+                        xBlocks++;
+
+                        if( pxBlock->xBlockSize > xMaxSize )
+                        {
+                            xMaxSize = pxBlock->xBlockSize;
+                        }
+
+                        if( pxBlock->xBlockSize < xMinSize )
+                        {
+                            xMinSize = pxBlock->xBlockSize;
+                        }
+                    }
+                }
+            }
+        }
+    }
+    ( void ) xTaskResumeAll();
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+
+    taskENTER_CRITICAL();
+    {
+        pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+        pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+        pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+        pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    void vPortWalkFreeBlocks( HeapFreeBlockFunction_t pxFunction,
+                              void * pvContext )
+    {
+        const BlockLink_t * pxBlock;
+        UBaseType_t uxFirstLevel, uxSecondLevel;
+        BaseType_t xContinue = pdTRUE;
+
+        /* The lists are walked whatever the bitmaps say, as the bitmaps may be
+         * the thing that was corrupted. */
+        for( uxFirstLevel = 0; ( uxFirstLevel < ( UBaseType_t ) heapFL_INDEX_COUNT ) && ( xContinue != pdFALSE ); uxFirstLevel++ )
+        {
+            for( uxSecondLevel = 0; ( uxSecondLevel < ( UBaseType_t ) heapSL_INDEX_COUNT ) && ( xContinue != pdFALSE ); uxSecondLevel++ )
+            {
+                for( pxBlock = pxFreeLists[ uxFirstLevel ][ uxSecondLevel ]; ( pxBlock != NULL ) && ( xContinue != pdFALSE ); pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xContinue = pxFunction( pxBlock, pxBlock->xBlockSize, pvContext );
+                }
+            }
+        }
+    }
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
+/*-----------------------------------------------------------*/
@@ -0,0 +1,858 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * A sample implementation of pvPortMalloc() and vPortFree() for multi core
+ * (configNUMBER_OF_CORES > 1) builds.  The heap array is divided into
+ * configHEAP_ARENA_COUNT arenas (one per core by default), each managed in the
+ * same way as heap_4.c - a free list in address order with adjacent free
+ * blocks combined as they are freed.
+ *
+ * heap_4.c protects the heap by suspending the scheduler, which on a multi core
+ * build stops every core from switching context until the allocation completes.
+ * Here each arena has its own lock instead, and a task allocates from the arena
+ * of the core it is running on, so allocations on different cores proceed in
+ * parallel.  Interrupts are masked on the calling core (only) while it holds
+ * an arena lock, so the holder cannot be switched out, and another core that
+ * finds the lock taken only ever waits for the holder to finish.  The locks rely
+ * on the atomic instructions of the port, so multi core builds need a port that
+ * sets portHAS_NATIVE_ATOMICS to 1.
+ *
+ * Memory freed on a core other than the one that owns its arena is not put
+ * into the arena's free list directly.  It is pushed onto the arena's free-back
+ * list with a single atomic compare and swap, and moved into the free list the
+ * next time the owning arena is locked.  Freeing memory therefore never waits
+ * for another core.  If its own arena cannot satisfy a request the calling core
+ * tries the other arenas in turn before the request fails.
+ *
+ * Statistics are kept per arena and summed when they are read.  Memory on a
+ * free-back list is not counted as free until it has been moved to the free
+ * list, and xMinimumEverFreeBytesRemaining is the sum of the minimums of the
+ * individual arenas.
+ *
+ * When configNUMBER_OF_CORES is 1 the behaviour matches heap_4.c, including
+ * the use of vTaskSuspendAll().
+ *
+ * See heap_1.c, heap_2.c, heap_3.c, heap_4.c, heap_5.c and heap_6.c for
+ * alternative implementations, and the memory management pages of
+ * https://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+    #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#ifndef configHEAP_CLEAR_MEMORY_ON_FREE
+    #define configHEAP_CLEAR_MEMORY_ON_FREE    0
+#endif
+
+/* The number of arenas the heap is divided into.  Core n allocates from arena
+ * ( n % configHEAP_ARENA_COUNT ) first. */
+#ifndef configHEAP_ARENA_COUNT
+    #define configHEAP_ARENA_COUNT    configNUMBER_OF_CORES
+#endif
+
+#if ( configHEAP_ARENA_COUNT < 1 )
+    #error configHEAP_ARENA_COUNT must be at least 1
+#endif
+
+/* The arena locks must exclude the other cores, which the critical section
+ * implementation of atomic.h does not do - it only masks interrupts on the
+ * calling core. */
+#if ( ( configNUMBER_OF_CORES > 1 ) && ( portHAS_NATIVE_ATOMICS != 1 ) )
+    #error heap_7.c requires portHAS_NATIVE_ATOMICS to be 1 when configNUMBER_OF_CORES is greater than 1
+#endif
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE    ( ( size_t ) ( xHeapStructSize << 1 ) )
+
+/* Assumes 8bit bytes! */
+#define heapBITS_PER_BYTE         ( ( size_t ) 8 )
+
+/* Max value that fits in a size_t type. */
+#define heapSIZE_MAX              ( ~( ( size_t ) 0 ) )
+
+/* Check if multiplying a and b will result in overflow. */
+#define heapMULTIPLY_WILL_OVERFLOW( a, b )    ( ( ( a ) > 0 ) && ( ( b ) > ( heapSIZE_MAX / ( a ) ) ) )
+
+/* Check if adding a and b will result in overflow. */
+#define heapADD_WILL_OVERFLOW( a, b )         ( ( a ) > ( heapSIZE_MAX - ( b ) ) )
+
+/* MSB of the xBlockSize member of an BlockLink_t structure is used to track
+ * the allocation status of a block.  When MSB of the xBlockSize member of
+ * an BlockLink_t structure is set then the block belongs to the application.
+ * When the bit is free the block is still part of the free heap space. */
+#define heapBLOCK_ALLOCATED_BITMASK    ( ( ( size_t ) 1 ) << ( ( sizeof( size_t ) * heapBITS_PER_BYTE ) - 1 ) )
+#define heapBLOCK_SIZE_IS_VALID( xBlockSize )    ( ( ( xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) == 0 )
+#define heapBLOCK_IS_ALLOCATED( pxBlock )        ( ( ( pxBlock->xBlockSize ) & heapBLOCK_ALLOCATED_BITMASK ) != 0 )
+#define heapALLOCATE_BLOCK( pxBlock )            ( ( pxBlock->xBlockSize ) |= heapBLOCK_ALLOCATED_BITMASK )
+#define heapFREE_BLOCK( pxBlock )                ( ( pxBlock->xBlockSize ) &= ~heapBLOCK_ALLOCATED_BITMASK )
+
+/* Values of the ulLock member of an arena. */
+#define heapARENA_UNLOCKED                       ( ( uint32_t ) 0U )
+#define heapARENA_LOCKED                         ( ( uint32_t ) 1U )
+
+/* Stops the calling task from being switched out while it uses the arenas.  On
+ * a single core the scheduler is suspended, exactly as in heap_4.c.  On multi
+ * core builds only the calling core's interrupts are masked - the other cores
+ * carry on running. */
+#if ( configNUMBER_OF_CORES == 1 )
+    #define heapENTER_ARENAS( uxSavedInterruptStatus )    do { ( void ) ( uxSavedInterruptStatus ); vTaskSuspendAll(); } while( 0 )
+    #define heapEXIT_ARENAS( uxSavedInterruptStatus )     ( void ) xTaskResumeAll()
+#else
+    #define heapENTER_ARENAS( uxSavedInterruptStatus )    ( uxSavedInterruptStatus ) = portSET_INTERRUPT_MASK_FROM_ISR()
+    #define heapEXIT_ARENAS( uxSavedInterruptStatus )     portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* Allocate the memory for the heap. */
+#if ( configAPPLICATION_ALLOCATED_HEAP == 1 )
+
+/* The application writer has already defined the array used for the RTOS
+* heap - probably so it can be placed in a special segment or address. */
+    extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+    PRIVILEGED_DATA static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Define the linked list structure.  This is used to link free blocks in order
+ * of their memory address. */
+typedef struct A_BLOCK_LINK
+{
+    struct A_BLOCK_LINK * pxNextFreeBlock; /*<< The next free block in the list. */
+    size_t xBlockSize;                     /*<< The size of the free block. */
+} BlockLink_t;
+
+/* Each arena is managed as an independent heap_4 style heap. */
+typedef struct A_HEAP_ARENA
+{
+    BlockLink_t xStart;                     /*<< Marks the start of the arena's free list. */
+    BlockLink_t * pxEnd;                    /*<< Marks the end of the arena's free list, which is also the end of the arena's memory. */
+    uint8_t * pucArenaStart;                /*<< The first byte of the arena's memory. */
+    void * volatile pvFreeBackList;         /*<< Blocks that have been freed by other cores, linked through pxNextFreeBlock. */
+    volatile uint32_t ulLock;               /*<< heapARENA_LOCKED while a core is using the free list. */
+    size_t xFreeBytesRemaining;             /*<< The number of bytes on the free list. */
+    size_t xMinimumEverFreeBytesRemaining;  /*<< The lowest value xFreeBytesRemaining has had. */
+    size_t xNumberOfSuccessfulAllocations;  /*<< The number of blocks allocated from this arena. */
+    size_t xNumberOfSuccessfulFrees;        /*<< The number of blocks returned to this arena's free list. */
+} HeapArena_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Inserts a block of memory that is being freed into the correct position in
+ * the arena's list of free memory blocks.  The block being freed will be
+ * merged with the block in front it and/or the block behind it if the memory
+ * blocks are adjacent to each other.
+ */
+static void prvInsertBlockIntoFreeList( HeapArena_t * pxArena,
+                                        BlockLink_t * pxBlockToInsert ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.  Does nothing if another core initialised the heap
+ * first.
+ */
+static void prvHeapInit( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Take and give back an arena's lock.  The caller must already have called
+ * heapENTER_ARENAS().
+ */
+static void prvLockArena( HeapArena_t * pxArena ) PRIVILEGED_FUNCTION;
+static void prvUnlockArena( HeapArena_t * pxArena ) PRIVILEGED_FUNCTION;
+
+/*
+ * Moves the blocks on an arena's free-back list into its free list.  The
+ * arena must be locked.
+ */
+static void prvDrainFreeBackList( HeapArena_t * pxArena ) PRIVILEGED_FUNCTION;
+
+/*
+ * First fit allocation of xWantedSize bytes (which includes the BlockLink_t
+ * structure) from a locked arena.  Returns NULL if the arena does not have a
+ * large enough free block.
+ */
+static void * prvAllocateFromArena( HeapArena_t * pxArena,
+                                    size_t xWantedSize ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the arena that the memory at pucAddress belongs to.
+ */
+static HeapArena_t * prvGetArena( const uint8_t * pucAddress ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+/* The size of the structure placed at the beginning of each allocated memory
+ * block must by correctly byte aligned. */
+static const size_t xHeapStructSize = ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The arenas, and the number of bytes given to each one.  Every arena is the
+ * same size, so the arena an address belongs to can be calculated directly. */
+PRIVILEGED_DATA static HeapArena_t xArenas[ configHEAP_ARENA_COUNT ];
+PRIVILEGED_DATA static size_t xArenaSize = 0U;
+PRIVILEGED_DATA static uint8_t * pucAlignedHeap = NULL;
+
+/* Held by the core that is initialising the heap, so two cores that make their
+ * first allocation at the same time do not both initialise it. */
+PRIVILEGED_DATA static volatile uint32_t ulHeapInitLock = heapARENA_UNLOCKED;
+
+/*-----------------------------------------------------------*/
+
+void * pvPortMalloc( size_t xWantedSize )
+{
+    HeapArena_t * pxArena;
+    void * pvReturn = NULL;
+    size_t xAdditionalRequiredSize;
+    UBaseType_t uxSavedInterruptStatus = 0;
+    UBaseType_t uxFirstArena, uxOffset;
+
+    if( xWantedSize > 0 )
+    {
+        /* The wanted size must be increased so it can contain a BlockLink_t
+         * structure in addition to the requested amount of bytes. Some
+         * additional increment may also be needed for alignment. */
+        xAdditionalRequiredSize = xHeapStructSize + portBYTE_ALIGNMENT - ( xWantedSize & portBYTE_ALIGNMENT_MASK );
+
+        if( heapADD_WILL_OVERFLOW( xWantedSize, xAdditionalRequiredSize ) == 0 )
+        {
+            xWantedSize += xAdditionalRequiredSize;
+        }
+        else
+        {
+            xWantedSize = 0;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    heapENTER_ARENAS( uxSavedInterruptStatus );
+    {
+        /* If this is the first call to malloc then the heap will require
+         * initialisation to setup the list of free blocks. */
+        if( pucAlignedHeap == NULL )
+        {
+            prvHeapInit();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Check the block size we are trying to allocate is not so large that the
+         * top bit is set.  The top bit of the block size member of the BlockLink_t
+         * structure is used to determine who owns the block - the application or
+         * the kernel, so it must be free. */
+        if( ( xWantedSize > 0 ) && ( heapBLOCK_SIZE_IS_VALID( xWantedSize ) != 0 ) )
+        {
+            /* Start with the arena that belongs to this core, then try the
+             * others in turn. */
+            uxFirstArena = ( UBaseType_t ) portGET_CORE_ID() % ( UBaseType_t ) configHEAP_ARENA_COUNT;
+
+            for( uxOffset = 0; ( uxOffset < ( UBaseType_t ) configHEAP_ARENA_COUNT ) && ( pvReturn == NULL ); uxOffset++ )
+            {
+                pxArena = &( xArenas[ ( uxFirstArena + uxOffset ) % ( UBaseType_t ) configHEAP_ARENA_COUNT ] );
+
+                prvLockArena( pxArena );
+                {
+                    prvDrainFreeBackList( pxArena );
+                    pvReturn = prvAllocateFromArena( pxArena, xWantedSize );
+                }
+                prvUnlockArena( pxArena );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceMALLOC( pvReturn, xWantedSize );
+    }
+    heapEXIT_ARENAS( uxSavedInterruptStatus );
+
+    #if ( configUSE_MALLOC_FAILED_HOOK == 1 )
+    {
+        if( pvReturn == NULL )
+        {
+            vApplicationMallocFailedHook();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configUSE_MALLOC_FAILED_HOOK == 1 ) */
+
+    configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void * pv )
+{
+    uint8_t * puc = ( uint8_t * ) pv;
+    BlockLink_t * pxLink;
+    HeapArena_t * pxArena;
+    void * pvHead;
+    UBaseType_t uxSavedInterruptStatus = 0;
+
+    if( pv != NULL )
+    {
+        /* The memory being freed will have an BlockLink_t structure immediately
+         * before it. */
+        puc -= xHeapStructSize;
+
+        /* This casting is to keep the compiler from issuing warnings. */
+        pxLink = ( void * ) puc;
+
+        configASSERT( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 );
+        configASSERT( pxLink->pxNextFreeBlock == NULL );
+
+        if( heapBLOCK_IS_ALLOCATED( pxLink ) != 0 )
+        {
+            if( pxLink->pxNextFreeBlock == NULL )
+            {
+                /* The block is being returned to the heap - it is no longer
+                 * allocated. */
+                heapFREE_BLOCK( pxLink );
+                #if ( configHEAP_CLEAR_MEMORY_ON_FREE == 1 )
+                {
+                    ( void ) memset( puc + xHeapStructSize, 0, pxLink->xBlockSize - xHeapStructSize );
+                }
+                #endif
+
+                pxArena = prvGetArena( puc );
+                traceFREE( pv, pxLink->xBlockSize );
+
+                heapENTER_ARENAS( uxSavedInterruptStatus );
+                {
+                    if( pxArena == &( xArenas[ ( UBaseType_t ) portGET_CORE_ID() % ( UBaseType_t ) configHEAP_ARENA_COUNT ] ) )
+                    {
+                        /* The block belongs to this core's arena, so add it
+                         * to the list of free blocks. */
+                        prvLockArena( pxArena );
+                        {
+                            prvDrainFreeBackList( pxArena );
+
+                            pxArena->xFreeBytesRemaining += pxLink->xBlockSize;
+                            prvInsertBlockIntoFreeList( pxArena, pxLink );
+                            pxArena->xNumberOfSuccessfulFrees++;
+                        }
+                        prvUnlockArena( pxArena );
+                    }
+                    else
+                    {
+                        /* The block belongs to another core's arena.  Push it
+                         * onto that arena's free-back list rather than wait
+                         * for the arena's lock. */
+                        do
+                        {
+                            pvHead = pxArena->pvFreeBackList;
+                            pxLink->pxNextFreeBlock = ( BlockLink_t * ) pvHead;
+                        } while( Atomic_CompareAndSwapPointers_p32( &( pxArena->pvFreeBackList ), ( void * ) pxLink, pvHead ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+                    }
+                }
+                heapEXIT_ARENAS( uxSavedInterruptStatus );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+    UBaseType_t uxArena;
+    size_t xFreeBytes = 0;
+
+    for( uxArena = 0; uxArena < ( UBaseType_t ) configHEAP_ARENA_COUNT; uxArena++ )
+    {
+        xFreeBytes += xArenas[ uxArena ].xFreeBytesRemaining;
+    }
+
+    return xFreeBytes;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+    UBaseType_t uxArena;
+    size_t xMinimumFreeBytes = 0;
+
+    for( uxArena = 0; uxArena < ( UBaseType_t ) configHEAP_ARENA_COUNT; uxArena++ )
+    {
+        xMinimumFreeBytes += xArenas[ uxArena ].xMinimumEverFreeBytesRemaining;
+    }
+
+    return xMinimumFreeBytes;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+    /* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortCalloc( size_t xNum,
+                     size_t xSize )
+{
+    void * pv = NULL;
+
+    if( heapMULTIPLY_WILL_OVERFLOW( xNum, xSize ) == 0 )
+    {
+        pv = pvPortMalloc( xNum * xSize );
+
+        if( pv != NULL )
+        {
+            ( void ) memset( pv, 0, xNum * xSize );
+        }
+    }
+
+    return pv;
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxFirstFreeBlock;
+    HeapArena_t * pxArena;
+    portPOINTER_SIZE_TYPE uxAddress;
+    size_t xTotalHeapSize = configTOTAL_HEAP_SIZE;
+    UBaseType_t uxArena;
+
+    /* heapENTER_ARENAS() only masks interrupts on the calling core, so another
+     * core can get here at the same time.  The first to take the lock
+     * initialises the heap, and the others find it done once they have it. */
+    while( Atomic_CompareAndSwap_u32( &ulHeapInitLock, heapARENA_LOCKED, heapARENA_UNLOCKED ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+    {
+        /* Spin until the other core has initialised the heap. */
+    }
+
+    if( pucAlignedHeap == NULL )
+    {
+        /* Ensure the heap starts on a correctly aligned boundary. */
+        uxAddress = ( portPOINTER_SIZE_TYPE ) ucHeap;
+
+        if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+        {
+            uxAddress += ( portBYTE_ALIGNMENT - 1 );
+            uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+            xTotalHeapSize -= uxAddress - ( portPOINTER_SIZE_TYPE ) ucHeap;
+        }
+
+        /* Every arena is given the same aligned number of bytes. */
+        xArenaSize = ( xTotalHeapSize / ( size_t ) configHEAP_ARENA_COUNT ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+        configASSERT( xArenaSize > ( heapMINIMUM_BLOCK_SIZE + xHeapStructSize ) );
+
+        for( uxArena = 0; uxArena < ( UBaseType_t ) configHEAP_ARENA_COUNT; uxArena++ )
+        {
+            pxArena = &( xArenas[ uxArena ] );
+
+            /* Set the arena up with its lock held, so a core that locks it
+             * after seeing pucAlignedHeap set also sees the arena set up. */
+            prvLockArena( pxArena );
+            pxArena->pucArenaStart = ( uint8_t * ) ( uxAddress + ( ( portPOINTER_SIZE_TYPE ) uxArena * xArenaSize ) );
+
+            /* xStart is used to hold a pointer to the first item in the list of
+             * free blocks.  The void cast is used to prevent compiler warnings. */
+            pxArena->xStart.pxNextFreeBlock = ( void * ) pxArena->pucArenaStart;
+            pxArena->xStart.xBlockSize = ( size_t ) 0;
+
+            /* pxEnd is used to mark the end of the list of free blocks and is
+             * inserted at the end of the arena's space. */
+            pxArena->pxEnd = ( BlockLink_t * ) ( pxArena->pucArenaStart + xArenaSize - xHeapStructSize );
+            pxArena->pxEnd->xBlockSize = 0;
+            pxArena->pxEnd->pxNextFreeBlock = NULL;
+
+            /* To start with there is a single free block that is sized to take up
+             * the entire arena space, minus the space taken by pxEnd. */
+            pxFirstFreeBlock = ( BlockLink_t * ) pxArena->pucArenaStart;
+            pxFirstFreeBlock->xBlockSize = ( size_t ) ( ( ( uint8_t * ) pxArena->pxEnd ) - pxArena->pucArenaStart );
+            pxFirstFreeBlock->pxNextFreeBlock = pxArena->pxEnd;
+
+            pxArena->pvFreeBackList = NULL;
+
+            /* Only one block exists - and it covers the entire usable arena
+             * space. */
+            pxArena->xMinimumEverFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+            pxArena->xFreeBytesRemaining = pxFirstFreeBlock->xBlockSize;
+            prvUnlockArena( pxArena );
+        }
+
+        /* Marks the heap as initialised - set last as it is checked without the
+         * lock of any arena. */
+        pucAlignedHeap = ( uint8_t * ) uxAddress;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    ( void ) Atomic_CompareAndSwap_u32( &ulHeapInitLock, heapARENA_UNLOCKED, heapARENA_LOCKED );
+}
+/*-----------------------------------------------------------*/
+
+static void prvLockArena( HeapArena_t * pxArena ) /* PRIVILEGED_FUNCTION */
+{
+    /* The holder of the lock has interrupts masked on its own core, so it
+     * will give the lock back without being switched out. */
+    while( Atomic_CompareAndSwap_u32( &( pxArena->ulLock ), heapARENA_LOCKED, heapARENA_UNLOCKED ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+    {
+        /* Spin until the other core gives the lock back. */
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvUnlockArena( HeapArena_t * pxArena ) /* PRIVILEGED_FUNCTION */
+{
+    ( void ) Atomic_CompareAndSwap_u32( &( pxArena->ulLock ), heapARENA_UNLOCKED, heapARENA_LOCKED );
+}
+/*-----------------------------------------------------------*/
+
+static void prvDrainFreeBackList( HeapArena_t * pxArena ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxNextBlock;
+
+    if( pxArena->pvFreeBackList != NULL )
+    {
+        /* Take the whole list in one go - other cores can carry on pushing
+         * blocks onto the now empty list. */
+        pxBlock = ( BlockLink_t * ) Atomic_SwapPointers_p32( &( pxArena->pvFreeBackList ), NULL );
+
+        while( pxBlock != NULL )
+        {
+            pxNextBlock = pxBlock->pxNextFreeBlock;
+
+            pxArena->xFreeBytesRemaining += pxBlock->xBlockSize;
+            prvInsertBlockIntoFreeList( pxArena, pxBlock );
+            pxArena->xNumberOfSuccessfulFrees++;
+
+            pxBlock = pxNextBlock;
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void * prvAllocateFromArena( HeapArena_t * pxArena,
+                                    size_t xWantedSize ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxBlock;
+    BlockLink_t * pxPreviousBlock;
+    BlockLink_t * pxNewBlockLink;
+    void * pvReturn = NULL;
+
+    if( xWantedSize <= pxArena->xFreeBytesRemaining )
+    {
+        /* Traverse the list from the start (lowest address) block until
+         * one of adequate size is found. */
+        pxPreviousBlock = &( pxArena->xStart );
+        pxBlock = pxArena->xStart.pxNextFreeBlock;
+
+        while( ( pxBlock->xBlockSize < xWantedSize ) && ( pxBlock->pxNextFreeBlock != NULL ) )
+        {
+            pxPreviousBlock = pxBlock;
+            pxBlock = pxBlock->pxNextFreeBlock;
+        }
+
+        /* If the end marker was reached then a block of adequate size
+         * was not found. */
+        if( pxBlock != pxArena->pxEnd )
+        {
+            /* Return the memory space pointed to - jumping over the
+             * BlockLink_t structure at its start. */
+            pvReturn = ( void * ) ( ( ( uint8_t * ) pxPreviousBlock->pxNextFreeBlock ) + xHeapStructSize );
+
+            /* This block is being returned for use so must be taken out
+             * of the list of free blocks. */
+            pxPreviousBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+
+            /* If the block is larger than required it can be split into
+             * two. */
+            if( ( pxBlock->xBlockSize - xWantedSize ) > heapMINIMUM_BLOCK_SIZE )
+            {
+                /* This block is to be split into two.  Create a new
+                 * block following the number of bytes requested. The void
+                 * cast is used to prevent byte alignment warnings from the
+                 * compiler. */
+                pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+                configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+                /* Calculate the sizes of two blocks split from the
+                 * single block. */
+                pxNewBlockLink->xBlockSize = pxBlock->xBlockSize - xWantedSize;
+                pxBlock->xBlockSize = xWantedSize;
+
+                /* Insert the new block into the list of free blocks. */
+                prvInsertBlockIntoFreeList( pxArena, pxNewBlockLink );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxArena->xFreeBytesRemaining -= pxBlock->xBlockSize;
+
+            if( pxArena->xFreeBytesRemaining < pxArena->xMinimumEverFreeBytesRemaining )
+            {
+                pxArena->xMinimumEverFreeBytesRemaining = pxArena->xFreeBytesRemaining;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The block is being returned - it is allocated and owned
+             * by the application and has no "next" block. */
+            heapALLOCATE_BLOCK( pxBlock );
+            pxBlock->pxNextFreeBlock = NULL;
+            pxArena->xNumberOfSuccessfulAllocations++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+static HeapArena_t * prvGetArena( const uint8_t * pucAddress ) /* PRIVILEGED_FUNCTION */
+{
+    size_t xArena;
+
+    configASSERT( pucAddress >= pucAlignedHeap );
+
+    xArena = ( size_t ) ( pucAddress - pucAlignedHeap ) / xArenaSize;
+    configASSERT( xArena < ( size_t ) configHEAP_ARENA_COUNT );
+
+    return &( xArenas[ xArena ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertBlockIntoFreeList( HeapArena_t * pxArena,
+                                        BlockLink_t * pxBlockToInsert ) /* PRIVILEGED_FUNCTION */
+{
+    BlockLink_t * pxIterator;
+    uint8_t * puc;
+
+    /* Iterate through the list until a block is found that has a higher address
+     * than the block being inserted. */
+    for( pxIterator = &( pxArena->xStart ); pxIterator->pxNextFreeBlock < pxBlockToInsert; pxIterator = pxIterator->pxNextFreeBlock )
+    {
+        /* Nothing to do here, just iterate to the right position. */
+    }
+
+    /* Do the block being inserted, and the block it is being inserted after
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxIterator;
+
+    if( ( puc + pxIterator->xBlockSize ) == ( uint8_t * ) pxBlockToInsert )
+    {
+        pxIterator->xBlockSize += pxBlockToInsert->xBlockSize;
+        pxBlockToInsert = pxIterator;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Do the block being inserted, and the block it is being inserted before
+     * make a contiguous block of memory? */
+    puc = ( uint8_t * ) pxBlockToInsert;
+
+    if( ( puc + pxBlockToInsert->xBlockSize ) == ( uint8_t * ) pxIterator->pxNextFreeBlock )
+    {
+        if( pxIterator->pxNextFreeBlock != pxArena->pxEnd )
+        {
+            /* Form one big block from the two blocks. */
+            pxBlockToInsert->xBlockSize += pxIterator->pxNextFreeBlock->xBlockSize;
+            pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock->pxNextFreeBlock;
+        }
+        else
+        {
+            pxBlockToInsert->pxNextFreeBlock = pxArena->pxEnd;
+        }
+    }
+    else
+    {
+        pxBlockToInsert->pxNextFreeBlock = pxIterator->pxNextFreeBlock;
+    }
+
+    /* If the block being inserted plugged a gap, so was merged with the block
+     * before and the block after, then it's pxNextFreeBlock pointer will have
+     * already been set, and should not be set here as that would make it point
+     * to itself. */
+    if( pxIterator != pxBlockToInsert )
+    {
+        pxIterator->pxNextFreeBlock = pxBlockToInsert;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t * pxHeapStats )
+{
+    BlockLink_t * pxBlock;
+    HeapArena_t * pxArena;
+    size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+    size_t xFreeBytes = 0, xMinimumEverFreeBytes = 0, xAllocations = 0, xFrees = 0;
+    UBaseType_t uxSavedInterruptStatus = 0;
+    UBaseType_t uxArena;
+
+    /* pucAlignedHeap will be NULL if the heap has not been initialised.  The
+     * heap is initialised automatically when the first allocation is made. */
+    if( pucAlignedHeap != NULL )
+    {
+        for( uxArena = 0; uxArena < ( UBaseType_t ) configHEAP_ARENA_COUNT; uxArena++ )
+        {
+            pxArena = &( xArenas[ uxArena ] );
+
+            heapENTER_ARENAS( uxSavedInterruptStatus );
+            prvLockArena( pxArena );
+            {
+                /* Count memory freed by other cores too. */
+                prvDrainFreeBackList( pxArena );
+
+                pxBlock = pxArena->xStart.pxNextFreeBlock;
+
+                while( pxBlock != pxArena->pxEnd )
+                {
+                    /* Increment the number of blocks and record the largest
+                     * block seen so far. */
+                    xBlocks++;
+
+                    if( pxBlock->xBlockSize > xMaxSize )
+                    {
+                        xMaxSize = pxBlock->xBlockSize;
+                    }
+
+                    if( pxBlock->xBlockSize < xMinSize )
+                    {
+                        xMinSize = pxBlock->xBlockSize;
+                    }
+
+                    /* Move to the next block in the chain until the last block
+                     * is reached. */
+                    pxBlock = pxBlock->pxNextFreeBlock;
+                }
+
+                xFreeBytes += pxArena->xFreeBytesRemaining;
+                xMinimumEverFreeBytes += pxArena->xMinimumEverFreeBytesRemaining;
+                xAllocations += pxArena->xNumberOfSuccessfulAllocations;
+                xFrees += pxArena->xNumberOfSuccessfulFrees;
+            }
+            prvUnlockArena( pxArena );
+            heapEXIT_ARENAS( uxSavedInterruptStatus );
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+    pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+    pxHeapStats->xNumberOfFreeBlocks = xBlocks;
+    pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytes;
+    pxHeapStats->xNumberOfSuccessfulAllocations = xAllocations;
+    pxHeapStats->xNumberOfSuccessfulFrees = xFrees;
+    pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytes;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    void vPortWalkFreeBlocks( HeapFreeBlockFunction_t pxFunction,
+                              void * pvContext )
+    {
+        const BlockLink_t * pxBlock;
+        const HeapArena_t * pxArena;
+        UBaseType_t uxArena;
+        BaseType_t xContinue = pdTRUE;
+
+        /* pucAlignedHeap will be NULL if the heap has not been initialised.
+         * Blocks waiting on an arena's free back list are still counted as
+         * allocated, as they are by the rest of this file until the list is
+         * drained. */
+        if( pucAlignedHeap != NULL )
+        {
+            for( uxArena = 0; ( uxArena < ( UBaseType_t ) configHEAP_ARENA_COUNT ) && ( xContinue != pdFALSE ); uxArena++ )
+            {
+                pxArena = &( xArenas[ uxArena ] );
+
+                for( pxBlock = pxArena->xStart.pxNextFreeBlock; ( pxBlock != NULL ) && ( pxBlock != pxArena->pxEnd ) && ( xContinue != pdFALSE ); pxBlock = pxBlock->pxNextFreeBlock )
+                {
+                    xContinue = pxFunction( pxBlock, pxBlock->xBlockSize, pvContext );
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
+/*-----------------------------------------------------------*/
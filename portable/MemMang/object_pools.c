@@ -0,0 +1,582 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Fixed size block pools for the kernel objects that are created dynamically.
+ *
+ * Unlike the heap_n.c files this file is not an alternative to the other memory
+ * managers - it is built alongside whichever heap is in use, and only provides
+ * pvPortMallocObject() and vPortFreeObject() when configUSE_KERNEL_OBJECT_POOLS
+ * is 1.  Each pool is a statically allocated array of blocks sized to hold one
+ * object of its type, so taking and returning a block is a constant time list
+ * operation and the pools cannot fragment.  The number of blocks in each pool
+ * is set by configTASK_POOL_LENGTH, configQUEUE_POOL_LENGTH,
+ * configTIMER_POOL_LENGTH and configEVENT_GROUP_POOL_LENGTH.
+ *
+ * Only task control blocks are taken from the task pool.  Task stacks are
+ * allocated using pvPortMallocStack(), which this file provides when
+ * configSTACK_POOL_LENGTH is not 0.  The stack pool is a statically allocated
+ * array of configSTACK_POOL_SLOT_SIZE byte slots, each next to a guard region
+ * of portSTACK_GUARD_SIZE bytes on ports that can make the guard inaccessible,
+ * so stacks are reused without fragmenting the heap and overflows fault as
+ * they happen.
+ *
+ * This file also provides pvPortMallocFromISR() and vPortFreeFromISR() when
+ * configISR_POOL_LENGTH is not 0.  The interrupt safe pool records which blocks
+ * are in use in a bitmap that is only ever updated with atomic operations, so
+ * it can be used from interrupts without a critical section, and does not
+ * suffer from the ABA problem a lock-free linked list would.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "atomic.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* A block or stack slot that is not in use holds a pointer to the next unused
+ * one. */
+typedef struct A_POOL_BLOCK_LINK
+{
+    struct A_POOL_BLOCK_LINK * pxNextFreeBlock;
+} PoolBlockLink_t;
+
+#if ( configUSE_KERNEL_OBJECT_POOLS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+        #error configUSE_KERNEL_OBJECT_POOLS cannot be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/* The control structure of a single pool.  Blocks that have never been used
+ * are taken in order from the end of the array, so the pools do not need to be
+ * initialised before use.  Blocks that have been used and returned are kept on
+ * pxFreeBlocks. */
+    typedef struct A_OBJECT_POOL
+    {
+        PoolBlockLink_t * pxFreeBlocks;  /*<< Blocks that have been returned to the pool. */
+        uint8_t * const pucBlocks;       /*<< The start of the block array, or NULL if the pool has no blocks. */
+        const size_t xBlockSize;         /*<< The size of each block, which is the largest object the pool can hold. */
+        const UBaseType_t uxLength;      /*<< The number of blocks in the array. */
+        UBaseType_t uxNeverUsed;         /*<< The number of blocks at the end of the array that have never been used. */
+        UBaseType_t uxFreeBlocks;        /*<< The number of blocks that are not in use. */
+    } ObjectPool_t;
+
+/* A queue pool block holds the queue structure followed by its storage
+ * area, exactly as pvPortMalloc() would have been asked to provide. */
+    typedef struct A_QUEUE_POOL_BLOCK
+    {
+        StaticQueue_t xQueue;
+        #if ( configQUEUE_POOL_STORAGE_SIZE > 0 )
+            uint8_t ucStorage[ configQUEUE_POOL_STORAGE_SIZE ];
+        #endif
+    } QueuePoolBlock_t;
+
+/*-----------------------------------------------------------*/
+
+/* The block arrays.  The StaticXXX_t types have the same size and alignment
+ * as the kernel's private structures. */
+    #if ( configTASK_POOL_LENGTH > 0 )
+        PRIVILEGED_DATA static StaticTask_t xTaskPoolBlocks[ configTASK_POOL_LENGTH ];
+        #define poolTASK_BLOCKS    ( ( uint8_t * ) xTaskPoolBlocks )
+    #else
+        #define poolTASK_BLOCKS    NULL
+    #endif
+
+    #if ( configQUEUE_POOL_LENGTH > 0 )
+        PRIVILEGED_DATA static QueuePoolBlock_t xQueuePoolBlocks[ configQUEUE_POOL_LENGTH ];
+        #define poolQUEUE_BLOCKS    ( ( uint8_t * ) xQueuePoolBlocks )
+    #else
+        #define poolQUEUE_BLOCKS    NULL
+    #endif
+
+    #if ( configTIMER_POOL_LENGTH > 0 )
+        PRIVILEGED_DATA static StaticTimer_t xTimerPoolBlocks[ configTIMER_POOL_LENGTH ];
+        #define poolTIMER_BLOCKS    ( ( uint8_t * ) xTimerPoolBlocks )
+    #else
+        #define poolTIMER_BLOCKS    NULL
+    #endif
+
+    #if ( configEVENT_GROUP_POOL_LENGTH > 0 )
+        PRIVILEGED_DATA static StaticEventGroup_t xEventGroupPoolBlocks[ configEVENT_GROUP_POOL_LENGTH ];
+        #define poolEVENT_GROUP_BLOCKS    ( ( uint8_t * ) xEventGroupPoolBlocks )
+    #else
+        #define poolEVENT_GROUP_BLOCKS    NULL
+    #endif
+
+/* Indexed by the portOBJECT_POOL_XXX constants. */
+    PRIVILEGED_DATA static ObjectPool_t xObjectPools[ portOBJECT_POOL_COUNT ] =
+    {
+        { NULL, poolTASK_BLOCKS,        sizeof( StaticTask_t ),       configTASK_POOL_LENGTH,        configTASK_POOL_LENGTH,        configTASK_POOL_LENGTH        },
+        { NULL, poolQUEUE_BLOCKS,       sizeof( QueuePoolBlock_t ),   configQUEUE_POOL_LENGTH,       configQUEUE_POOL_LENGTH,       configQUEUE_POOL_LENGTH       },
+        { NULL, poolTIMER_BLOCKS,       sizeof( StaticTimer_t ),      configTIMER_POOL_LENGTH,       configTIMER_POOL_LENGTH,       configTIMER_POOL_LENGTH       },
+        { NULL, poolEVENT_GROUP_BLOCKS, sizeof( StaticEventGroup_t ), configEVENT_GROUP_POOL_LENGTH, configEVENT_GROUP_POOL_LENGTH, configEVENT_GROUP_POOL_LENGTH }
+    };
+
+/*-----------------------------------------------------------*/
+
+    void * pvPortMallocObject( BaseType_t xPool,
+                               size_t xSize )
+    {
+        ObjectPool_t * pxPool;
+        void * pvReturn = NULL;
+
+        configASSERT( ( xPool >= 0 ) && ( xPool < portOBJECT_POOL_COUNT ) );
+        pxPool = &( xObjectPools[ xPool ] );
+
+        if( xSize <= pxPool->xBlockSize )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( pxPool->pxFreeBlocks != NULL )
+                {
+                    /* Reuse the block that was returned most recently. */
+                    pvReturn = ( void * ) pxPool->pxFreeBlocks;
+                    pxPool->pxFreeBlocks = pxPool->pxFreeBlocks->pxNextFreeBlock;
+                    pxPool->uxFreeBlocks--;
+                }
+                else if( pxPool->uxNeverUsed > ( UBaseType_t ) 0U )
+                {
+                    pxPool->uxNeverUsed--;
+                    pvReturn = ( void * ) &( pxPool->pucBlocks[ pxPool->uxNeverUsed * pxPool->xBlockSize ] );
+                    pxPool->uxFreeBlocks--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pvReturn == NULL )
+        {
+            #if ( configOBJECT_POOL_HEAP_FALLBACK == 1 )
+            {
+                /* The pool is empty, or the object is too large for it, so use
+                 * the heap instead. */
+                pvReturn = pvPortMalloc( xSize );
+            }
+            #elif ( configUSE_MALLOC_FAILED_HOOK == 1 )
+            {
+                vApplicationMallocFailedHook();
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortFreeObject( BaseType_t xPool,
+                          void * pv )
+    {
+        ObjectPool_t * pxPool;
+        uint8_t * puc = ( uint8_t * ) pv;
+
+        configASSERT( ( xPool >= 0 ) && ( xPool < portOBJECT_POOL_COUNT ) );
+        pxPool = &( xObjectPools[ xPool ] );
+
+        if( pv != NULL )
+        {
+            /* Memory that does not lie within the pool's block array came from
+             * the heap. */
+            if( ( pxPool->pucBlocks != NULL ) &&
+                ( puc >= pxPool->pucBlocks ) &&
+                ( puc < &( pxPool->pucBlocks[ pxPool->uxLength * pxPool->xBlockSize ] ) ) )
+            {
+                configASSERT( ( ( size_t ) ( puc - pxPool->pucBlocks ) % pxPool->xBlockSize ) == 0U );
+
+                taskENTER_CRITICAL();
+                {
+                    ( ( PoolBlockLink_t * ) pv )->pxNextFreeBlock = pxPool->pxFreeBlocks;
+                    pxPool->pxFreeBlocks = ( PoolBlockLink_t * ) pv;
+                    pxPool->uxFreeBlocks++;
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                vPortFree( pv );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetObjectPoolFreeBlocks( BaseType_t xPool )
+    {
+        configASSERT( ( xPool >= 0 ) && ( xPool < portOBJECT_POOL_COUNT ) );
+
+        return xObjectPools[ xPool ].uxFreeBlocks;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_KERNEL_OBJECT_POOLS */
+
+#if ( configISR_POOL_LENGTH > 0 )
+
+/* Blocks are rounded up so every block is correctly aligned. */
+    #define poolISR_BLOCK_SIZE        ( ( ( size_t ) configISR_POOL_BLOCK_SIZE + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* The number of 32-bit words in the bitmap. */
+    #define poolISR_BITMAP_WORDS      ( ( configISR_POOL_LENGTH + 31 ) / 32 )
+    #define poolBITS_PER_WORD         ( ( UBaseType_t ) 32U )
+
+/* The memory for the blocks.  portBYTE_ALIGNMENT extra bytes are allocated so
+ * the first block can be aligned. */
+    PRIVILEGED_DATA static uint8_t ucISRPoolMemory[ ( configISR_POOL_LENGTH * poolISR_BLOCK_SIZE ) + portBYTE_ALIGNMENT ];
+
+/* Bit n is set while block n is in use. */
+    PRIVILEGED_DATA static volatile uint32_t ulISRPoolBitmap[ poolISR_BITMAP_WORDS ];
+
+/*
+ * Returns the address of the first, correctly aligned, block.
+ */
+    static uint8_t * prvISRPoolBlocks( void ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static uint8_t * prvISRPoolBlocks( void )
+    {
+        portPOINTER_SIZE_TYPE uxAddress = ( portPOINTER_SIZE_TYPE ) ucISRPoolMemory;
+
+        uxAddress += ( portBYTE_ALIGNMENT - 1 );
+        uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK );
+
+        return ( uint8_t * ) uxAddress;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPortMallocFromISR( size_t xSize )
+    {
+        void * pvReturn = NULL;
+        UBaseType_t uxWord, uxBit, uxBlock;
+        uint32_t ulCurrent;
+
+        if( xSize <= ( size_t ) configISR_POOL_BLOCK_SIZE )
+        {
+            for( uxWord = 0; ( uxWord < ( UBaseType_t ) poolISR_BITMAP_WORDS ) && ( pvReturn == NULL ); uxWord++ )
+            {
+                ulCurrent = ulISRPoolBitmap[ uxWord ];
+                uxBit = 0;
+
+                while( uxBit < poolBITS_PER_WORD )
+                {
+                    uxBlock = ( uxWord * poolBITS_PER_WORD ) + uxBit;
+
+                    if( uxBlock >= ( UBaseType_t ) configISR_POOL_LENGTH )
+                    {
+                        /* Past the last block in a partly used final word. */
+                        break;
+                    }
+
+                    if( ( ulCurrent & ( ( uint32_t ) 1U << uxBit ) ) == 0U )
+                    {
+                        /* The block looks free - claim it, unless something
+                         * else changed the word since it was read. */
+                        if( Atomic_CompareAndSwap_u32( &( ulISRPoolBitmap[ uxWord ] ), ulCurrent | ( ( uint32_t ) 1U << uxBit ), ulCurrent ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                        {
+                            pvReturn = ( void * ) &( prvISRPoolBlocks()[ ( size_t ) uxBlock * poolISR_BLOCK_SIZE ] );
+                            break;
+                        }
+                        else
+                        {
+                            /* Read the word again and rescan it from the
+                             * start. */
+                            ulCurrent = ulISRPoolBitmap[ uxWord ];
+                            uxBit = 0;
+                        }
+                    }
+                    else
+                    {
+                        uxBit++;
+                    }
+                }
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortFreeFromISR( void * pv )
+    {
+        size_t xBlock;
+        uint8_t * pucBlocks = prvISRPoolBlocks();
+
+        if( pv != NULL )
+        {
+            configASSERT( ( ( uint8_t * ) pv >= pucBlocks ) && ( ( uint8_t * ) pv < &( pucBlocks[ ( size_t ) configISR_POOL_LENGTH * poolISR_BLOCK_SIZE ] ) ) );
+
+            xBlock = ( size_t ) ( ( uint8_t * ) pv - pucBlocks ) / poolISR_BLOCK_SIZE;
+
+            /* The block must be in use, or this is a double free. */
+            configASSERT( ( ulISRPoolBitmap[ xBlock / poolBITS_PER_WORD ] & ( ( uint32_t ) 1U << ( xBlock % poolBITS_PER_WORD ) ) ) != 0U );
+
+            ( void ) Atomic_AND_u32( &( ulISRPoolBitmap[ xBlock / poolBITS_PER_WORD ] ), ~( ( uint32_t ) 1U << ( xBlock % poolBITS_PER_WORD ) ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetISRPoolFreeBlocks( void )
+    {
+        UBaseType_t uxBlock, uxFreeBlocks = 0;
+
+        for( uxBlock = 0; uxBlock < ( UBaseType_t ) configISR_POOL_LENGTH; uxBlock++ )
+        {
+            if( ( ulISRPoolBitmap[ uxBlock / poolBITS_PER_WORD ] & ( ( uint32_t ) 1U << ( uxBlock % poolBITS_PER_WORD ) ) ) == 0U )
+            {
+                uxFreeBlocks++;
+            }
+        }
+
+        return uxFreeBlocks;
+    }
+/*-----------------------------------------------------------*/
+
+#endif /* configISR_POOL_LENGTH */
+
+#if ( configSTACK_POOL_LENGTH > 0 )
+
+/* Slots and guards are aligned to the larger of the guard size and the stack
+ * alignment, as memory protection units need regions aligned to their size. */
+    #if ( portSTACK_POOL_GUARD_SIZE > portBYTE_ALIGNMENT )
+        #define poolSTACK_ALIGNMENT    ( ( size_t ) portSTACK_POOL_GUARD_SIZE )
+    #else
+        #define poolSTACK_ALIGNMENT    ( ( size_t ) portBYTE_ALIGNMENT )
+    #endif
+
+    #define poolSTACK_SLOT_SIZE        ( ( ( size_t ) configSTACK_POOL_SLOT_SIZE + poolSTACK_ALIGNMENT - ( size_t ) 1 ) & ~( poolSTACK_ALIGNMENT - ( size_t ) 1 ) )
+    #define poolSTACK_SLOT_STRIDE      ( poolSTACK_SLOT_SIZE + ( size_t ) portSTACK_POOL_GUARD_SIZE )
+
+/* The memory for the slots.  Each slot is preceded by its guard region if the
+ * stack grows down, and followed by it if the stack grows up, so an overflow
+ * runs into the guard rather than into the neighbouring stack.
+ * poolSTACK_ALIGNMENT extra bytes are allocated so the first slot can be
+ * aligned. */
+    PRIVILEGED_DATA static uint8_t ucStackPoolMemory[ ( ( size_t ) configSTACK_POOL_LENGTH * poolSTACK_SLOT_STRIDE ) + poolSTACK_ALIGNMENT ];
+
+/* The start of the aligned slot array, set on first use. */
+    PRIVILEGED_DATA static uint8_t * pucStackPoolBase = NULL;
+
+/* Slots that have been used and returned, linked through their first word, and
+ * the number of slots at the end of the array that have never been used. */
+    PRIVILEGED_DATA static PoolBlockLink_t * pxFreeStackSlots = NULL;
+    PRIVILEGED_DATA static UBaseType_t uxStackSlotsNeverUsed = ( UBaseType_t ) configSTACK_POOL_LENGTH;
+    PRIVILEGED_DATA static UBaseType_t uxFreeStackSlots = ( UBaseType_t ) configSTACK_POOL_LENGTH;
+
+/*
+ * Returns the start of the stack in slot uxSlot.
+ */
+    static uint8_t * prvStackPoolSlot( UBaseType_t uxSlot ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static uint8_t * prvStackPoolSlot( UBaseType_t uxSlot )
+    {
+        uint8_t * pucSlot = &( pucStackPoolBase[ ( size_t ) uxSlot * poolSTACK_SLOT_STRIDE ] );
+
+        #if ( portSTACK_GROWTH < 0 )
+        {
+            pucSlot += portSTACK_POOL_GUARD_SIZE;
+        }
+        #endif
+
+        return pucSlot;
+    }
+/*-----------------------------------------------------------*/
+
+    void * pvPortMallocStack( size_t xSize )
+    {
+        portPOINTER_SIZE_TYPE uxAddress;
+        void * pvReturn = NULL;
+
+        if( xSize <= poolSTACK_SLOT_SIZE )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( pucStackPoolBase == NULL )
+                {
+                    uxAddress = ( portPOINTER_SIZE_TYPE ) ucStackPoolMemory;
+                    uxAddress += ( portPOINTER_SIZE_TYPE ) ( poolSTACK_ALIGNMENT - ( size_t ) 1 );
+                    uxAddress &= ~( ( portPOINTER_SIZE_TYPE ) ( poolSTACK_ALIGNMENT - ( size_t ) 1 ) );
+                    pucStackPoolBase = ( uint8_t * ) uxAddress;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( pxFreeStackSlots != NULL )
+                {
+                    /* Reuse the slot that was returned most recently. */
+                    pvReturn = ( void * ) pxFreeStackSlots;
+                    pxFreeStackSlots = pxFreeStackSlots->pxNextFreeBlock;
+                    uxFreeStackSlots--;
+                }
+                else if( uxStackSlotsNeverUsed > ( UBaseType_t ) 0U )
+                {
+                    uxStackSlotsNeverUsed--;
+                    pvReturn = ( void * ) prvStackPoolSlot( uxStackSlotsNeverUsed );
+                    uxFreeStackSlots--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pvReturn == NULL )
+        {
+            #if ( configSTACK_POOL_HEAP_FALLBACK == 1 )
+            {
+                /* The pool is empty, or the stack is too large for a slot, so
+                 * use the heap instead. */
+                pvReturn = pvPortMalloc( xSize );
+            }
+            #elif ( configUSE_MALLOC_FAILED_HOOK == 1 )
+            {
+                vApplicationMallocFailedHook();
+            }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortFreeStack( void * pv )
+    {
+        uint8_t * puc = ( uint8_t * ) pv;
+
+        if( pv != NULL )
+        {
+            /* Memory that does not lie within the slot array came from the
+             * heap. */
+            if( ( puc >= ucStackPoolMemory ) &&
+                ( puc < &( ucStackPoolMemory[ sizeof( ucStackPoolMemory ) ] ) ) )
+            {
+                configASSERT( ( ( size_t ) ( puc - prvStackPoolSlot( 0 ) ) % poolSTACK_SLOT_STRIDE ) == 0U );
+
+                taskENTER_CRITICAL();
+                {
+                    ( ( PoolBlockLink_t * ) pv )->pxNextFreeBlock = pxFreeStackSlots;
+                    pxFreeStackSlots = ( PoolBlockLink_t * ) pv;
+                    uxFreeStackSlots++;
+                }
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                vPortFree( pv );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxPortGetStackPoolFreeSlots( void )
+    {
+        return uxFreeStackSlots;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( portSTACK_POOL_GUARD_SIZE > 0 )
+
+        void * pvPortGetStackGuard( const void * pvStack )
+        {
+            const uint8_t * puc = ( const uint8_t * ) pvStack;
+            void * pvReturn = NULL;
+
+            /* Pool stacks always start at the start of their slot, so the
+             * guard is at a fixed offset from the stack. */
+            if( ( puc >= ucStackPoolMemory ) &&
+                ( puc < &( ucStackPoolMemory[ sizeof( ucStackPoolMemory ) ] ) ) )
+            {
+                #if ( portSTACK_GROWTH < 0 )
+                {
+                    pvReturn = ( void * ) ( puc - portSTACK_POOL_GUARD_SIZE );
+                }
+                #else
+                {
+                    pvReturn = ( void * ) ( puc + poolSTACK_SLOT_SIZE );
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pvReturn;
+        }
+
+    #endif /* portSTACK_POOL_GUARD_SIZE */
+/*-----------------------------------------------------------*/
+
+#endif /* configSTACK_POOL_LENGTH */
@@ -119,6 +119,12 @@
  * switches can only occur when uxCriticalNesting is zero. */
 static UBaseType_t uxCriticalNesting = 0xaaaaaaaa;
 
+/* The MPU settings of the task whose regions are currently programmed into the
+ * MPU.  The PendSV handler does not reprogram the MPU when it resumes that same
+ * task, and vPortStoreTaskMPUSettings() clears this so changed settings are
+ * always programmed on the next context switch. */
+PRIVILEGED_DATA xMPU_SETTINGS * pxProgrammedMPUSettings = NULL;
+
 /*
  * Setup the timer to generate the tick interrupts.
  */
@@ -621,6 +627,7 @@ __asm void xPortPendSVHandler( void )
 {
     extern uxCriticalNesting;
     extern pxCurrentTCB;
+    extern pxProgrammedMPUSettings;
     extern vTaskSwitchContext;
 
 /* *INDENT-OFF* */
@@ -659,6 +666,12 @@ __asm void xPortPendSVHandler( void )
     ldr r0, [ r1 ]           /* The first item in the TCB is the task top of stack. */
     add r1, r1, #4          /* Move onto the second item in the TCB... */
 
+    ldr r2, =pxProgrammedMPUSettings /* Are this task's regions already programmed? */
+    ldr r3, [ r2 ]
+    cmp r1, r3
+    beq RegionsProgrammed    /* If so there is no need to reprogram the MPU. */
+    str r1, [ r2 ]
+
     dmb                      /* Complete outstanding transfers before disabling MPU. */
     ldr r2, =0xe000ed94     /* MPU_CTRL register. */
     ldr r3, [ r2 ] /* Read the value of MPU_CTRL. */
@@ -682,6 +695,7 @@ __asm void xPortPendSVHandler( void )
     str r3, [ r2 ]           /* Enable MPU. */
     dsb                      /* Force memory writes before continuing. */
 
+RegionsProgrammed
     ldmia r0 !, { r3 - r11, r14 }                               /* Pop the registers that are not automatically saved on exception entry. */
     msr control, r3
 
@@ -968,6 +982,8 @@ void vPortStoreTaskMPUSettings( xMPU_SETTINGS * xMPUSettings,
             lIndex++;
         }
     }
+
+    pxProgrammedMPUSettings = NULL;
 }
 /*-----------------------------------------------------------*/
 
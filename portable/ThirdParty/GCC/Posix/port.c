@@ -40,6 +40,16 @@
 * The timer interrupt uses SIGALRM and care is taken to ensure that
 * the signal handler runs only on the thread for the current task.
 *
+* With configUSE_TICKLESS_IDLE set to 1 the idle task stops the SIGALRM
+* timer and sleeps in pselect() until the next task unblock time, and with
+* configPOSIX_VIRTUAL_TIME also set to 1 it instead steps the tick count
+* straight to the next unblock time.
+*
+* With configUSE_DYNAMIC_TICK set to 1 the SIGALRM timer is also reprogrammed
+* to the next task unblock time while a task runs alone at its priority, and
+* the tick count is corrected from the elapsed time when the tick is needed
+* again.
+*
 * Use of part of the standard C library requires care as some
 * functions can take pthread mutexes internally which can result in
 * deadlocks as the FreeRTOS kernel can switch tasks while they're
@@ -48,15 +58,17 @@
 * stdio (printf() and friends) should be called from a single task
 * only or serialized with a FreeRTOS primitive such as a binary
 * semaphore or mutex.
+*
+* With configPOSIX_DETERMINISTIC set to 1 this file is not used, and
+* port_deterministic.c implements the port instead.
 *----------------------------------------------------------*/
-#include "portmacro.h"
-
 #include <errno.h>
 #include <pthread.h>
 #include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/select.h>
 #include <sys/time.h>
 #include <sys/times.h>
 #include <time.h>
@@ -68,6 +80,8 @@
 #include "utils/wait_for_event.h"
 /*-----------------------------------------------------------*/
 
+#if ( configPOSIX_DETERMINISTIC == 0 )
+
 #define SIG_RESUME    SIGUSR1
 
 typedef struct THREAD
@@ -114,6 +128,12 @@ static void vPortStartFirstTask( void );
 static void prvPortYieldFromISR( void );
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    static volatile BaseType_t xTickDeferred = pdFALSE; /* pdTRUE while the next SIGALRM is more than one tick away. */
+    static uint64_t ullDeferredFromNs;                   /* The time of the tick interrupt that deferred the tick. */
+#endif
+/*-----------------------------------------------------------*/
+
 static void prvFatalError( const char * pcCall,
                            int iErrno )
 {
@@ -322,15 +342,41 @@ void vPortEnableInterrupts( void )
 
 portBASE_TYPE xPortSetInterruptMask( void )
 {
-    /* Interrupts are always disabled inside ISRs (signals
-     * handlers). */
-    return pdTRUE;
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        sigset_t xPreviousSignals;
+
+        /* The kernel stops a deferred tick from task code as well as from
+         * interrupts, so the mask has to be real.  Report whether the signals
+         * were already blocked, as they are inside signal handlers. */
+        ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+
+        return ( sigismember( &xPreviousSignals, SIGALRM ) == 1 ) ? pdTRUE : pdFALSE;
+    }
+    #else
+    {
+        /* Interrupts are always disabled inside ISRs (signals
+         * handlers). */
+        return pdTRUE;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
 void vPortClearInterruptMask( portBASE_TYPE xMask )
 {
-    ( void ) xMask;
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        if( xMask == pdFALSE )
+        {
+            vPortEnableInterrupts();
+        }
+    }
+    #else
+    {
+        ( void ) xMask;
+    }
+    #endif
 }
 /*-----------------------------------------------------------*/
 
@@ -386,10 +432,200 @@ void prvSetupTimerInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_TICKLESS_IDLE == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) )
+
+/* The longest idle period that can be suppressed, or that the tick can be
+ * deferred for.  A longer expected idle time means no task is waiting on a
+ * timeout. */
+    static const TickType_t xMaximumPossibleSuppressedTicks = portMAX_DELAY >> 1;
+
+    static void prvSetTimerInterrupt( uint64_t ullFirstTickNs )
+    {
+        struct itimerval itimer;
+
+        itimer.it_interval.tv_sec = 0;
+        itimer.it_interval.tv_usec = portTICK_RATE_MICROSECONDS;
+
+        /* A zero it_value disarms the timer, so never round down to zero. */
+        itimer.it_value.tv_sec = ( time_t ) ( ullFirstTickNs / 1000000000ULL );
+        itimer.it_value.tv_usec = ( suseconds_t ) ( ( ullFirstTickNs % 1000000000ULL ) / 1000ULL );
+
+        if( ( itimer.it_value.tv_sec == 0 ) && ( itimer.it_value.tv_usec == 0 ) )
+        {
+            itimer.it_value.tv_usec = 1;
+        }
+
+        if( setitimer( ITIMER_REAL, &itimer, NULL ) == -1 )
+        {
+            prvFatalError( "setitimer", errno );
+        }
+    }
+
+#endif /* ( configUSE_TICKLESS_IDLE == 1 ) || ( configUSE_DYNAMIC_TICK == 1 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+
+    void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+    {
+        const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+        struct itimerval itimer;
+        struct timespec xSleepTime;
+        sigset_t xPendingSignals, xSleepSignals;
+        uint64_t ullSleepStartNs, ullElapsedNs, ullSleepNs;
+        TickType_t xCompleteTickPeriods, xModifiableIdleTime;
+
+        if( xExpectedIdleTime > xMaximumPossibleSuppressedTicks )
+        {
+            xExpectedIdleTime = xMaximumPossibleSuppressedTicks;
+        }
+
+        /* Block all signals, the equivalent of disabling interrupts. */
+        vPortDisableInterrupts();
+
+        /* Abandon the sleep if a tick is already waiting to be handled, or if
+         * a context switch is pending or a task is waiting for the scheduler
+         * to be unsuspended. */
+        ( void ) sigpending( &xPendingSignals );
+
+        if( ( sigismember( &xPendingSignals, SIGALRM ) == 1 ) ||
+            ( eTaskConfirmSleepModeStatus() == eAbortSleep ) )
+        {
+            vPortEnableInterrupts();
+            return;
+        }
+
+        #if ( configPOSIX_VIRTUAL_TIME == 1 )
+        {
+            if( xExpectedIdleTime < xMaximumPossibleSuppressedTicks )
+            {
+                /* Every task is blocked and one is due to unblock, so no time
+                 * needs to pass on the host.  Jump to the unblock time - the
+                 * tick itself is pended, so the task unblocks as soon as the
+                 * idle task resumes the scheduler. */
+                vTaskStepTick( xExpectedIdleTime );
+                vPortEnableInterrupts();
+                return;
+            }
+
+            /* Otherwise nothing will unblock until a signal arrives, so sleep
+             * until one does. */
+        }
+        #endif /* configPOSIX_VIRTUAL_TIME */
+
+        /* Stop the tick.  The time until the next tick was due is not
+         * recorded, so the tick count is corrected from whole periods of
+         * elapsed time on waking. */
+        memset( &itimer, 0, sizeof( itimer ) );
+        ( void ) setitimer( ITIMER_REAL, &itimer, NULL );
+
+        ullSleepStartNs = prvGetTimeNs();
+        ullSleepNs = ( uint64_t ) xExpectedIdleTime * ullTickPeriodNs;
+
+        /* pselect() with no descriptors only returns when the time expires or
+         * a signal handler runs.  Unblock every signal other than SIGALRM
+         * while sleeping so signals emulating other interrupts still wake the
+         * idle task. */
+        xSleepTime.tv_sec = ( time_t ) ( ullSleepNs / 1000000000ULL );
+        xSleepTime.tv_nsec = ( long ) ( ullSleepNs % 1000000000ULL );
+        sigemptyset( &xSleepSignals );
+        sigaddset( &xSleepSignals, SIGALRM );
+
+        /* configPRE_SLEEP_PROCESSING() can set xModifiableIdleTime to 0 to
+         * indicate that its implementation has already waited. */
+        xModifiableIdleTime = xExpectedIdleTime;
+        configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+
+        if( xModifiableIdleTime > 0 )
+        {
+            ( void ) pselect( 0, NULL, NULL, NULL, &xSleepTime, &xSleepSignals );
+        }
+
+        configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+        ullElapsedNs = prvGetTimeNs() - ullSleepStartNs;
+
+        if( ullElapsedNs >= ullSleepNs )
+        {
+            /* Slept for the whole period.  Stepping to the unblock time pends
+             * the tick that unblocks the task. */
+            xCompleteTickPeriods = xExpectedIdleTime;
+            ullElapsedNs = ullSleepNs;
+        }
+        else
+        {
+            xCompleteTickPeriods = ( TickType_t ) ( ullElapsedNs / ullTickPeriodNs );
+        }
+
+        if( xCompleteTickPeriods > 0 )
+        {
+            vTaskStepTick( xCompleteTickPeriods );
+        }
+
+        /* Restart the tick so the next one falls at the end of the tick
+         * period that is now in progress. */
+        prvSetTimerInterrupt( ullTickPeriodNs - ( ullElapsedNs % ullTickPeriodNs ) );
+
+        vPortEnableInterrupts();
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    TickType_t xPortDynamicTickStop( TickType_t xMaxTicks )
+    {
+        const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+        uint64_t ullElapsedNs;
+        TickType_t xElapsedTicks = 0;
+        sigset_t xPreviousSignals;
+
+        ( void ) pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+
+        if( xTickDeferred != pdFALSE )
+        {
+            xTickDeferred = pdFALSE;
+
+            ullElapsedNs = prvGetTimeNs() - ullDeferredFromNs;
+
+            if( ( ullElapsedNs / ullTickPeriodNs ) < ( uint64_t ) xMaxTicks )
+            {
+                xElapsedTicks = ( TickType_t ) ( ullElapsedNs / ullTickPeriodNs );
+            }
+            else
+            {
+                xElapsedTicks = xMaxTicks;
+            }
+
+            /* Restart the tick so the next one falls at the end of the tick
+             * period that is now in progress, or straight away if the ticks
+             * were capped. */
+            ullElapsedNs -= ( uint64_t ) xElapsedTicks * ullTickPeriodNs;
+
+            if( ullElapsedNs < ullTickPeriodNs )
+            {
+                prvSetTimerInterrupt( ullTickPeriodNs - ullElapsedNs );
+            }
+            else
+            {
+                prvSetTimerInterrupt( 0 );
+            }
+        }
+
+        ( void ) pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+
+        return xElapsedTicks;
+    }
+
+#endif /* configUSE_DYNAMIC_TICK */
+/*-----------------------------------------------------------*/
+
 static void vPortSystemTickHandler( int sig )
 {
     Thread_t * pxThreadToSuspend;
     Thread_t * pxThreadToResume;
+    BaseType_t xSwitchRequired;
 
     ( void ) sig;
 
@@ -397,6 +633,8 @@ static void vPortSystemTickHandler( int sig )
 
     uxCriticalNesting++; /* Signals are blocked in this signal handler. */
 
+    traceBENCHMARK_ISR_ENTER();
+
     #if ( configUSE_PREEMPTION == 1 )
         pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
     #endif
@@ -409,19 +647,79 @@ static void vPortSystemTickHandler( int sig )
  *      xExpectedTicks = (prvGetTimeNs() - prvStartTimeNs)
  *        / (portTICK_RATE_MICROSECONDS * 1000);
  * do { */
-    xTaskIncrementTick();
+    #if ( configUSE_DYNAMIC_TICK == 1 )
+    {
+        const uint64_t ullTickPeriodNs = ( uint64_t ) portTICK_RATE_MICROSECONDS * 1000ULL;
+        uint64_t ullNowNs = prvGetTimeNs();
+        TickType_t xTicks;
+
+        if( xTickDeferred != pdFALSE )
+        {
+            /* Report every tick that passed while the tick was deferred,
+             * rounding to the nearest as the signal is never early by more
+             * than the timer's resolution. */
+            xTickDeferred = pdFALSE;
+            xTicks = ( TickType_t ) ( ( ullNowNs - ullDeferredFromNs + ( ullTickPeriodNs / 2ULL ) ) / ullTickPeriodNs );
+
+            if( xTicks == 0 )
+            {
+                xTicks = 1;
+            }
+
+            xSwitchRequired = xTaskCatchUpTicksFromISR( xTicks );
+        }
+        else
+        {
+            xSwitchRequired = xTaskIncrementTick();
+        }
+
+        /* The timer keeps its one tick interval, so a deferral only moves
+         * the next signal. */
+        if( xSwitchRequired == pdFALSE )
+        {
+            xTicks = xTaskGetDynamicTickPeriod();
+
+            if( xTicks > 1 )
+            {
+                if( xTicks > xMaximumPossibleSuppressedTicks )
+                {
+                    xTicks = xMaximumPossibleSuppressedTicks;
+                }
+
+                ullDeferredFromNs = ullNowNs;
+                xTickDeferred = pdTRUE;
+                prvSetTimerInterrupt( ( uint64_t ) xTicks * ullTickPeriodNs );
+            }
+        }
+    }
+    #else
+    {
+        xSwitchRequired = xTaskIncrementTick();
+    }
+    #endif
 
 /*        prvTickCount++;
  *    } while (prvTickCount < xExpectedTicks);
  */
 
+    /* The interrupt's kernel work ends here, as prvSwitchThread() suspends
+     * this thread until the task it interrupted runs again. */
+    traceBENCHMARK_ISR_EXIT();
+
     #if ( configUSE_PREEMPTION == 1 )
-        /* Select Next Task. */
-        vTaskSwitchContext();
+        /* Only select the next task when the tick requires it, so a task is
+         * not switched out before the end of its time slice. */
+        if( xSwitchRequired != pdFALSE )
+        {
+            /* Select Next Task. */
+            vTaskSwitchContext();
 
-        pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+            pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
 
-        prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+            prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+        }
+    #else
+        ( void ) xSwitchRequired;
     #endif
 
     uxCriticalNesting--;
@@ -581,3 +879,11 @@ unsigned long ulPortGetRunTime( void )
     return ( unsigned long ) xTimes.tms_utime;
 }
 /*-----------------------------------------------------------*/
+
+uint32_t ulPortGetCycleCount( void )
+{
+    return ( uint32_t ) prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configPOSIX_DETERMINISTIC == 0 */
@@ -0,0 +1,1045 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*-----------------------------------------------------------
+* Deterministic implementation of the functions defined in portable.h for the
+* Posix port, used when configPOSIX_DETERMINISTIC is set to 1.
+*
+* Every task runs on the host thread that starts the scheduler, with its own
+* ucontext on its FreeRTOS stack, and a task switch is a swapcontext().
+* Interrupts are never asynchronous: "disabling interrupts" clears a flag, and
+* the tick and the simulated interrupts raised by vPortRaiseInterrupt() are
+* only delivered at interrupt points, which are each time interrupts are
+* enabled outside a critical section and each time round the idle task's loop.
+*
+* A run therefore depends only on the interrupt point at which each tick and
+* interrupt was delivered.  xPortSimulationRecord() writes those to a text
+* file, one line per delivery:
+*
+*     <point> <tick count> T <running task name>
+*     <point> <tick count> I <interrupt number> <running task name>
+*
+* and xPortSimulationReplay() delivers the ticks and interrupts in a file at
+* exactly the same points, checking the tick count and running task against
+* those recorded, so the run can be repeated as many times as needed.
+*
+* Only the events snapshotted when a point is reached are delivered at that
+* point, whichever task's point handling delivers them, so an event raised by
+* the host while a point's events are being delivered is recorded against the
+* next point, exactly where a replay delivers it.
+*
+* With configPOSIX_NODES set to 1 a node's process maps a POSIX shared memory
+* segment that starts with a header and a state block for each node, followed
+* by the memory shared by the application.  Doorbells are bits in the state
+* block of the node they are rung on, which the node collects at each point
+* along with its other raised interrupts, and each node publishes the number of
+* ticks it has delivered, so a tick is only delivered once no other running
+* node is behind.
+*----------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configPOSIX_NODES == 1 )
+    #include <errno.h>
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configPOSIX_DETERMINISTIC == 1 )
+
+#define portNS_PER_TICK        ( 1000000000ULL / configTICK_RATE_HZ )
+#define portMAX_LOG_NAME_LEN   ( configMAX_TASK_NAME_LEN + 1 )
+
+typedef struct THREAD
+{
+    ucontext_t xContext;
+    pdTASK_CODE pxCode;
+    void * pvParams;
+    BaseType_t xDying;
+} Thread_t;
+
+/* A tick or interrupt read from the replay file. */
+typedef struct LOG_ENTRY
+{
+    unsigned long ulPoint;
+    unsigned long ulTickCount;
+    char cType;
+    unsigned long ulInterrupt;
+    char cTaskName[ portMAX_LOG_NAME_LEN ];
+} LogEntry_t;
+
+/*
+ * The additional per-thread data is stored at the beginning of the
+ * task's stack.
+ */
+static inline Thread_t * prvGetThreadFromTask( TaskHandle_t xTask )
+{
+    StackType_t * pxTopOfStack = *( StackType_t ** ) xTask;
+
+    return ( Thread_t * ) ( pxTopOfStack + 1 );
+}
+/*-----------------------------------------------------------*/
+
+static ucontext_t xSchedulerContext;
+static volatile portBASE_TYPE uxCriticalNesting;
+static BaseType_t xInterruptsEnabled = pdFALSE;
+static BaseType_t xSchedulerStarted = pdFALSE;
+
+/* Interrupts raised but not yet snapshotted by a point.  Written from any
+ * host thread or signal handler. */
+static uint32_t ulRaisedInterrupts = 0;
+
+/* The events snapshotted by the last point and not yet delivered. */
+static BaseType_t xTickToDeliver = pdFALSE;
+static uint32_t ulInterruptsToDeliver = 0;
+
+static void ( * pxInterruptHandlers[ portPOSIX_INTERRUPT_COUNT ] )( void );
+
+static unsigned long ulPoints = 0;
+static unsigned long ulLastTickPoint = 0;
+static uint64_t ullNextTickNs = 0;
+
+#if ( configPOSIX_DETERMINISTIC_TICK_POINTS > 0 )
+    static BaseType_t xIdleTickRequested = pdFALSE;
+#endif
+
+static FILE * pxRecordFile = NULL;
+static FILE * pxReplayFile = NULL;
+static LogEntry_t xNextEntry;
+
+#if ( configPOSIX_NODES == 1 )
+
+    #define portNODE_MAGIC          ( 0x4E4F4445UL )
+    #define portNODE_ALIGNMENT      ( 64U )
+    #define portNODE_POLL_NS        ( 20000L )
+
+/* The node states, in ulState. */
+    #define portNODE_NOT_STARTED    ( 0U )
+    #define portNODE_RUNNING        ( 1U )
+    #define portNODE_ENDED          ( 2U )
+
+/* The state of one node, in a cache line of its own. */
+    typedef struct NODE_STATE
+    {
+        uint32_t ulDoorbells; /* Interrupts raised on the node by vPortNodeRingDoorbell() and not yet collected. */
+        uint32_t ulState;     /* portNODE_NOT_STARTED, portNODE_RUNNING or portNODE_ENDED. */
+        uint64_t ullTicks;    /* The number of ticks the node has delivered. */
+        uint8_t ucPadding[ portNODE_ALIGNMENT - 16U ];
+    } NodeState_t;
+
+/* The start of the shared memory segment, followed by the memory shared by
+ * the application. */
+    typedef struct NODE_SEGMENT
+    {
+        uint32_t ulMagic;     /* Set to portNODE_MAGIC by node 0 once the rest of the header is written. */
+        uint32_t ulNodeCount;
+        uint64_t ullSharedBytes;
+        uint8_t ucPadding[ portNODE_ALIGNMENT - 16U ];
+        NodeState_t xNodes[];
+    } NodeSegment_t;
+
+    static NodeSegment_t * pxNodeSegment = NULL;
+    static NodeState_t * pxThisNode = NULL;
+    static UBaseType_t uxThisNode = 0;
+    static char * pcNodeSegmentName = NULL;
+
+/* The node found holding the clock back last time, which is checked first
+ * next time. */
+    static UBaseType_t uxNodeClockHolder = 0;
+
+#endif /* configPOSIX_NODES */
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char * pcMessage );
+static uint64_t prvGetTimeNs( void );
+static void prvTaskEntry( void );
+static void prvSwitchThread( Thread_t * pxThreadToResume,
+                             Thread_t * pxThreadToSuspend );
+static void prvInterruptPoint( void );
+static void prvDeliver( char cType,
+                        UBaseType_t uxInterrupt );
+static void prvReadNextEntry( void );
+
+#if ( configPOSIX_NODES == 1 )
+    static void prvNodeStart( void );
+    static void prvNodeLeave( void );
+    static BaseType_t prvNodeClockAllowsTick( void );
+#else
+
+/* Without nodes the clock is never held back. */
+    #define prvNodeClockAllowsTick()    pdTRUE
+#endif
+/*-----------------------------------------------------------*/
+
+static void prvFatalError( const char * pcMessage )
+{
+    fprintf( stderr, "%s\n", pcMessage );
+    abort();
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec t;
+
+    clock_gettime( CLOCK_MONOTONIC, &t );
+
+    return t.tv_sec * 1000000000ULL + t.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portSTACK_TYPE * pxPortInitialiseStack( portSTACK_TYPE * pxTopOfStack,
+                                        portSTACK_TYPE * pxEndOfStack,
+                                        pdTASK_CODE pxCode,
+                                        void * pvParameters )
+{
+    Thread_t * thread;
+    uintptr_t uxThreadAddress;
+
+    /*
+     * Store the additional thread data at the start of the stack, aligned
+     * for the ucontext_t it holds.  The rest of the stack is the task's
+     * stack.
+     */
+    uxThreadAddress = ( ( uintptr_t ) ( pxTopOfStack + 1 ) - sizeof( Thread_t ) ) & ~( ( uintptr_t ) 15 );
+    thread = ( Thread_t * ) uxThreadAddress;
+    pxTopOfStack = ( portSTACK_TYPE * ) thread - 1;
+
+    thread->pxCode = pxCode;
+    thread->pvParams = pvParameters;
+    thread->xDying = pdFALSE;
+
+    if( getcontext( &thread->xContext ) != 0 )
+    {
+        prvFatalError( "getcontext failed" );
+    }
+
+    thread->xContext.uc_stack.ss_sp = pxEndOfStack;
+    thread->xContext.uc_stack.ss_size = uxThreadAddress - ( uintptr_t ) pxEndOfStack;
+    thread->xContext.uc_link = NULL;
+    makecontext( &thread->xContext, prvTaskEntry, 0 );
+
+    return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void prvTaskEntry( void )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    /* Started for the first time, so enable interrupts. */
+    uxCriticalNesting = 0;
+    vPortEnableInterrupts();
+
+    /* Call the task's entry point. */
+    pxThread->pxCode( pxThread->pvParams );
+
+    /* A function that implements a task must not exit or attempt to return to
+     * its caller as there is nothing to return to. If a task wants to exit it
+     * should instead call vTaskDelete( NULL ). Artificially force an assert()
+     * to be triggered if configASSERT() is defined, so application writers can
+     * catch the error. */
+    configASSERT( pdFALSE );
+
+    prvFatalError( "Task function returned" );
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portBASE_TYPE xPortStartScheduler( void )
+{
+    Thread_t * pxFirstThread = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    #if ( configPOSIX_NODES == 1 )
+    {
+        /* Wait for the other nodes, so the clocks start together. */
+        prvNodeStart();
+    }
+    #endif
+
+    ulLastTickPoint = ulPoints;
+    ullNextTickNs = prvGetTimeNs() + portNS_PER_TICK;
+    xSchedulerStarted = pdTRUE;
+
+    /* Start the first task, and continue from here when vPortEndScheduler()
+     * is called. */
+    if( swapcontext( &xSchedulerContext, &pxFirstThread->xContext ) != 0 )
+    {
+        prvFatalError( "swapcontext failed" );
+    }
+
+    xSchedulerStarted = pdFALSE;
+    xInterruptsEnabled = pdFALSE;
+
+    return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+    #if ( configPOSIX_NODES == 1 )
+    {
+        prvNodeLeave();
+    }
+    #endif
+
+    if( pxRecordFile != NULL )
+    {
+        ( void ) fclose( pxRecordFile );
+        pxRecordFile = NULL;
+    }
+
+    if( pxReplayFile != NULL )
+    {
+        ( void ) fclose( pxReplayFile );
+        pxReplayFile = NULL;
+    }
+
+    /* Return from xPortStartScheduler() on the thread that called it. */
+    ( void ) setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+    if( uxCriticalNesting == 0 )
+    {
+        vPortDisableInterrupts();
+    }
+
+    uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+    uxCriticalNesting--;
+
+    /* If we have reached 0 then re-enable the interrupts. */
+    if( uxCriticalNesting == 0 )
+    {
+        vPortEnableInterrupts();
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+
+    vPortEnterCritical();
+
+    pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    vTaskSwitchContext();
+
+    pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+    prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+
+    vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+    xInterruptsEnabled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+    xInterruptsEnabled = pdTRUE;
+
+    /* Interrupts that became pending while they were disabled are taken
+     * now. */
+    prvInterruptPoint();
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortSetInterruptMask( void )
+{
+    /* Interrupts are always disabled inside ISRs, which are only run from
+     * interrupt points. */
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( portBASE_TYPE xMask )
+{
+    ( void ) xMask;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortSimulationRecord( const char * pcFileName )
+{
+    configASSERT( ( pxRecordFile == NULL ) && ( pxReplayFile == NULL ) );
+
+    pxRecordFile = fopen( pcFileName, "w" );
+
+    if( pxRecordFile == NULL )
+    {
+        return pdFAIL;
+    }
+
+    /* Line buffered, so the recording is complete up to the last delivery if
+     * the simulation crashes. */
+    ( void ) setvbuf( pxRecordFile, NULL, _IOLBF, 0 );
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortSimulationReplay( const char * pcFileName )
+{
+    configASSERT( ( pxRecordFile == NULL ) && ( pxReplayFile == NULL ) );
+
+    pxReplayFile = fopen( pcFileName, "r" );
+
+    if( pxReplayFile == NULL )
+    {
+        return pdFAIL;
+    }
+
+    prvReadNextEntry();
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReadNextEntry( void )
+{
+    char cLine[ 64 + portMAX_LOG_NAME_LEN ];
+    int iNameStart = 0;
+    int iFields;
+    size_t xLength;
+
+    if( fgets( cLine, sizeof( cLine ), pxReplayFile ) == NULL )
+    {
+        /* The recording is exhausted, so continue live from here, with the
+         * tick following on from the last point. */
+        ( void ) fclose( pxReplayFile );
+        pxReplayFile = NULL;
+        ulLastTickPoint = ulPoints;
+        ullNextTickNs = prvGetTimeNs() + portNS_PER_TICK;
+        return;
+    }
+
+    xLength = strlen( cLine );
+
+    if( ( xLength > 0 ) && ( cLine[ xLength - 1 ] == '\n' ) )
+    {
+        cLine[ xLength - 1 ] = '\0';
+    }
+
+    iFields = sscanf( cLine, "%lu %lu %c", &xNextEntry.ulPoint, &xNextEntry.ulTickCount, &xNextEntry.cType );
+
+    if( ( iFields == 3 ) && ( xNextEntry.cType == 'T' ) )
+    {
+        ( void ) sscanf( cLine, "%*u %*u %*c %n", &iNameStart );
+        xNextEntry.ulInterrupt = 0;
+    }
+    else if( ( iFields == 3 ) && ( xNextEntry.cType == 'I' ) &&
+             ( sscanf( cLine, "%*u %*u %*c %lu %n", &xNextEntry.ulInterrupt, &iNameStart ) == 1 ) &&
+             ( xNextEntry.ulInterrupt < portPOSIX_INTERRUPT_COUNT ) )
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+    else
+    {
+        prvFatalError( "Replay: malformed recording" );
+    }
+
+    xLength = strlen( &cLine[ iNameStart ] );
+
+    if( xLength >= sizeof( xNextEntry.cTaskName ) )
+    {
+        xLength = sizeof( xNextEntry.cTaskName ) - 1;
+    }
+
+    ( void ) memcpy( xNextEntry.cTaskName, &cLine[ iNameStart ], xLength );
+    xNextEntry.cTaskName[ xLength ] = '\0';
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetInterruptHandler( UBaseType_t uxInterrupt,
+                               void ( * pxHandler )( void ) )
+{
+    configASSERT( uxInterrupt < portPOSIX_INTERRUPT_COUNT );
+
+    pxInterruptHandlers[ uxInterrupt ] = pxHandler;
+}
+/*-----------------------------------------------------------*/
+
+void vPortRaiseInterrupt( UBaseType_t uxInterrupt )
+{
+    configASSERT( uxInterrupt < portPOSIX_INTERRUPT_COUNT );
+
+    /* A replay delivers the interrupts that were raised when recording. */
+    if( pxReplayFile != NULL )
+    {
+        return;
+    }
+
+    ( void ) __atomic_fetch_or( &ulRaisedInterrupts, ( uint32_t ) 1 << uxInterrupt, __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+void vPortInterruptPoint( void )
+{
+    prvInterruptPoint();
+}
+/*-----------------------------------------------------------*/
+
+void vPortIdleLoop( void )
+{
+    if( pxReplayFile == NULL )
+    {
+        #if ( configPOSIX_NODES == 1 )
+        {
+            /* While another node holds the clock back, only a doorbell can
+             * unblock a task, so wait a little for either rather than spinning
+             * on the host CPU. */
+            if( prvNodeClockAllowsTick() == pdFALSE )
+            {
+                struct timespec xPoll = { 0, portNODE_POLL_NS };
+
+                ( void ) nanosleep( &xPoll, NULL );
+            }
+        }
+        #endif
+
+        #if ( configPOSIX_DETERMINISTIC_TICK_POINTS > 0 )
+        {
+            /* Nothing else can run, so complete the current tick now. */
+            xIdleTickRequested = pdTRUE;
+        }
+        #else
+        {
+            /* Nothing else can run, so sleep until the next tick is due
+             * rather than spinning on the host CPU. */
+            uint64_t ullNow = prvGetTimeNs();
+            struct timespec xSleep;
+
+            if( ullNow < ullNextTickNs )
+            {
+                xSleep.tv_sec = ( time_t ) ( ( ullNextTickNs - ullNow ) / 1000000000ULL );
+                xSleep.tv_nsec = ( long ) ( ( ullNextTickNs - ullNow ) % 1000000000ULL );
+                ( void ) nanosleep( &xSleep, NULL );
+            }
+        }
+        #endif /* if ( configPOSIX_DETERMINISTIC_TICK_POINTS > 0 ) */
+    }
+
+    prvInterruptPoint();
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptPoint( void )
+{
+    UBaseType_t uxInterrupt;
+
+    /* Interrupts enabled before the scheduler starts, by creating tasks and
+     * the like, are not points. */
+    if( ( xSchedulerStarted == pdFALSE ) || ( xInterruptsEnabled == pdFALSE ) || ( uxCriticalNesting != 0 ) )
+    {
+        return;
+    }
+
+    ulPoints++;
+
+    if( pxReplayFile != NULL )
+    {
+        /* Deliver what was delivered at this point when recording.  The
+         * next entry is read before delivering, as a delivery can switch to
+         * a task that reaches further points before this one resumes. */
+        while( ( pxReplayFile != NULL ) && ( xNextEntry.ulPoint == ulPoints ) )
+        {
+            char cType = xNextEntry.cType;
+            UBaseType_t uxEntryInterrupt = ( UBaseType_t ) xNextEntry.ulInterrupt;
+
+            prvDeliver( cType, uxEntryInterrupt );
+        }
+
+        if( ( pxReplayFile != NULL ) && ( xNextEntry.ulPoint < ulPoints ) )
+        {
+            prvFatalError( "Replay: diverged from the recording (event not delivered)" );
+        }
+
+        return;
+    }
+
+    /* Snapshot the events to deliver at this point. */
+    #if ( configPOSIX_DETERMINISTIC_TICK_POINTS > 0 )
+    {
+        if( ( ( xIdleTickRequested != pdFALSE ) || ( ( ulPoints - ulLastTickPoint ) >= configPOSIX_DETERMINISTIC_TICK_POINTS ) ) &&
+            ( prvNodeClockAllowsTick() != pdFALSE ) )
+        {
+            xIdleTickRequested = pdFALSE;
+            ulLastTickPoint = ulPoints;
+            xTickToDeliver = pdTRUE;
+        }
+    }
+    #else
+    {
+        uint64_t ullNow = prvGetTimeNs();
+
+        if( ( ullNow >= ullNextTickNs ) && ( prvNodeClockAllowsTick() != pdFALSE ) )
+        {
+            /* Ticks missed while the host was busy are dropped, as they are
+             * by the signal based port. */
+            ullNextTickNs += portNS_PER_TICK;
+
+            if( ullNow >= ullNextTickNs )
+            {
+                ullNextTickNs = ullNow + portNS_PER_TICK;
+            }
+
+            xTickToDeliver = pdTRUE;
+        }
+    }
+    #endif /* if ( configPOSIX_DETERMINISTIC_TICK_POINTS > 0 ) */
+
+    ulInterruptsToDeliver |= __atomic_exchange_n( &ulRaisedInterrupts, 0, __ATOMIC_SEQ_CST );
+
+    #if ( configPOSIX_NODES == 1 )
+    {
+        if( pxThisNode != NULL )
+        {
+            ulInterruptsToDeliver |= __atomic_exchange_n( &pxThisNode->ulDoorbells, 0, __ATOMIC_SEQ_CST );
+        }
+    }
+    #endif
+
+    /* Deliver the tick first, then the interrupts in number order.  Another
+     * task's point may deliver some of them if a delivery switches task. */
+    for( ; ; )
+    {
+        if( xTickToDeliver != pdFALSE )
+        {
+            xTickToDeliver = pdFALSE;
+            prvDeliver( 'T', 0 );
+        }
+        else if( ulInterruptsToDeliver != 0 )
+        {
+            uxInterrupt = ( UBaseType_t ) __builtin_ctz( ulInterruptsToDeliver );
+            ulInterruptsToDeliver &= ~( ( uint32_t ) 1 << uxInterrupt );
+            prvDeliver( 'I', uxInterrupt );
+        }
+        else
+        {
+            break;
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvDeliver( char cType,
+                        UBaseType_t uxInterrupt )
+{
+    Thread_t * pxThreadToSuspend;
+    Thread_t * pxThreadToResume;
+    BaseType_t xSwitchRequired;
+    const char * pcTaskName;
+    TickType_t xTickCount;
+
+    /* Interrupts are disabled in an ISR. */
+    xInterruptsEnabled = pdFALSE;
+    uxCriticalNesting++;
+
+    pcTaskName = pcTaskGetName( NULL );
+    xTickCount = xTaskGetTickCount();
+
+    if( pxReplayFile != NULL )
+    {
+        if( ( xNextEntry.ulTickCount != ( unsigned long ) xTickCount ) ||
+            ( strncmp( xNextEntry.cTaskName, pcTaskName, configMAX_TASK_NAME_LEN ) != 0 ) )
+        {
+            fprintf( stderr, "Replay: diverged from the recording at point %lu: tick %lu in %s, recorded tick %lu in %s\n",
+                     ulPoints, ( unsigned long ) xTickCount, pcTaskName, xNextEntry.ulTickCount, xNextEntry.cTaskName );
+            abort();
+        }
+
+        prvReadNextEntry();
+    }
+    else if( pxRecordFile != NULL )
+    {
+        if( cType == 'T' )
+        {
+            fprintf( pxRecordFile, "%lu %lu T %s\n", ulPoints, ( unsigned long ) xTickCount, pcTaskName );
+        }
+        else
+        {
+            fprintf( pxRecordFile, "%lu %lu I %lu %s\n", ulPoints, ( unsigned long ) xTickCount, ( unsigned long ) uxInterrupt, pcTaskName );
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( cType == 'T' )
+    {
+        pxThreadToSuspend = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+        traceBENCHMARK_ISR_ENTER();
+        xSwitchRequired = xTaskIncrementTick();
+        traceBENCHMARK_ISR_EXIT();
+
+        #if ( configPOSIX_NODES == 1 )
+        {
+            /* Publish the tick, which may let the other nodes deliver
+             * theirs. */
+            if( pxThisNode != NULL )
+            {
+                ( void ) __atomic_fetch_add( &pxThisNode->ullTicks, 1, __ATOMIC_SEQ_CST );
+            }
+        }
+        #endif
+
+        #if ( configUSE_PREEMPTION == 1 )
+            /* Only select the next task when the tick requires it, so a task
+             * is not switched out before the end of its time slice. */
+            if( xSwitchRequired != pdFALSE )
+            {
+                vTaskSwitchContext();
+
+                pxThreadToResume = prvGetThreadFromTask( xTaskGetCurrentTaskHandle() );
+
+                prvSwitchThread( pxThreadToResume, pxThreadToSuspend );
+            }
+        #else
+            ( void ) xSwitchRequired;
+            ( void ) pxThreadToResume;
+            ( void ) pxThreadToSuspend;
+        #endif
+    }
+    else if( pxInterruptHandlers[ uxInterrupt ] != NULL )
+    {
+        pxInterruptHandlers[ uxInterrupt ]();
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    uxCriticalNesting--;
+    xInterruptsEnabled = ( uxCriticalNesting == 0 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchThread( Thread_t * pxThreadToResume,
+                             Thread_t * pxThreadToSuspend )
+{
+    BaseType_t uxSavedCriticalNesting;
+
+    if( pxThreadToSuspend != pxThreadToResume )
+    {
+        /*
+         * Switch tasks.
+         *
+         * The critical section nesting is per-task, so save it on the
+         * stack of the current (suspending) task, restoring it when
+         * we switch back to this task.
+         */
+        uxSavedCriticalNesting = uxCriticalNesting;
+
+        if( pxThreadToSuspend->xDying == pdTRUE )
+        {
+            /* The task deleted itself, so is never resumed. */
+            ( void ) setcontext( &pxThreadToResume->xContext );
+        }
+        else if( swapcontext( &pxThreadToSuspend->xContext, &pxThreadToResume->xContext ) != 0 )
+        {
+            prvFatalError( "swapcontext failed" );
+        }
+
+        uxCriticalNesting = uxSavedCriticalNesting;
+    }
+}
+/*-----------------------------------------------------------*/
+
+void vPortThreadDying( void * pxTaskToDelete,
+                       volatile BaseType_t * pxPendYield )
+{
+    Thread_t * pxThread = prvGetThreadFromTask( pxTaskToDelete );
+
+    ( void ) pxPendYield;
+
+    pxThread->xDying = pdTRUE;
+}
+
+void vPortCancelThread( void * pxTaskToDelete )
+{
+    /* Nothing to release: the context lives on the task's stack, which the
+     * kernel frees. */
+    ( void ) pxTaskToDelete;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configPOSIX_NODES == 1 )
+
+BaseType_t xPortNodeJoin( const char * pcName,
+                          UBaseType_t uxNode,
+                          UBaseType_t uxNodeCount,
+                          size_t xSharedBytes )
+{
+    const size_t xHeaderBytes = sizeof( NodeSegment_t ) + ( ( size_t ) uxNodeCount * sizeof( NodeState_t ) );
+    const size_t xSegmentBytes = xHeaderBytes + ( ( xSharedBytes + portNODE_ALIGNMENT - 1U ) & ~( ( size_t ) portNODE_ALIGNMENT - 1U ) );
+    const struct timespec xPoll = { 0, portNODE_POLL_NS };
+    struct stat xStat;
+    NodeSegment_t * pxSegment;
+    int iFile;
+
+    configASSERT( ( pxNodeSegment == NULL ) && ( xSchedulerStarted == pdFALSE ) );
+    configASSERT( uxNode < uxNodeCount );
+
+    if( uxNode == 0 )
+    {
+        /* Node 0 creates the segment, which is zero filled, replacing one
+         * left behind by an earlier run that did not end. */
+        iFile = shm_open( pcName, O_RDWR | O_CREAT | O_EXCL, 0600 );
+
+        if( ( iFile < 0 ) && ( errno == EEXIST ) )
+        {
+            ( void ) shm_unlink( pcName );
+            iFile = shm_open( pcName, O_RDWR | O_CREAT | O_EXCL, 0600 );
+        }
+
+        if( ( iFile < 0 ) || ( ftruncate( iFile, ( off_t ) xSegmentBytes ) != 0 ) )
+        {
+            if( iFile >= 0 )
+            {
+                ( void ) close( iFile );
+            }
+
+            return pdFAIL;
+        }
+    }
+    else
+    {
+        /* The other nodes wait for node 0 to create the segment and set its
+         * size. */
+        for( ; ; )
+        {
+            iFile = shm_open( pcName, O_RDWR, 0 );
+
+            if( iFile >= 0 )
+            {
+                if( ( fstat( iFile, &xStat ) == 0 ) && ( ( size_t ) xStat.st_size >= xSegmentBytes ) )
+                {
+                    break;
+                }
+
+                ( void ) close( iFile );
+            }
+            else if( errno != ENOENT )
+            {
+                return pdFAIL;
+            }
+
+            ( void ) nanosleep( &xPoll, NULL );
+        }
+    }
+
+    pxSegment = ( NodeSegment_t * ) mmap( NULL, xSegmentBytes, PROT_READ | PROT_WRITE, MAP_SHARED, iFile, 0 );
+    ( void ) close( iFile );
+
+    if( pxSegment == ( NodeSegment_t * ) MAP_FAILED )
+    {
+        return pdFAIL;
+    }
+
+    if( uxNode == 0 )
+    {
+        pxSegment->ulNodeCount = ( uint32_t ) uxNodeCount;
+        pxSegment->ullSharedBytes = ( uint64_t ) xSharedBytes;
+        __atomic_store_n( &pxSegment->ulMagic, portNODE_MAGIC, __ATOMIC_SEQ_CST );
+    }
+    else
+    {
+        while( __atomic_load_n( &pxSegment->ulMagic, __ATOMIC_SEQ_CST ) != portNODE_MAGIC )
+        {
+            ( void ) nanosleep( &xPoll, NULL );
+        }
+
+        if( ( pxSegment->ulNodeCount != ( uint32_t ) uxNodeCount ) || ( pxSegment->ullSharedBytes != ( uint64_t ) xSharedBytes ) )
+        {
+            ( void ) munmap( ( void * ) pxSegment, xSegmentBytes );
+            return pdFAIL;
+        }
+    }
+
+    pcNodeSegmentName = strdup( pcName );
+    pxNodeSegment = pxSegment;
+    pxThisNode = &( pxSegment->xNodes[ uxNode ] );
+    uxThisNode = uxNode;
+
+    /* A node that exits without ending its scheduler must not hold the clock
+     * back. */
+    ( void ) atexit( prvNodeLeave );
+
+    return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void * pvPortNodeGetSharedMemory( void )
+{
+    configASSERT( pxNodeSegment != NULL );
+
+    return ( void * ) &( pxNodeSegment->xNodes[ pxNodeSegment->ulNodeCount ] );
+}
+/*-----------------------------------------------------------*/
+
+void vPortNodeRingDoorbell( UBaseType_t uxDoorbell )
+{
+    const UBaseType_t uxNode = uxDoorbell / ( UBaseType_t ) portPOSIX_INTERRUPT_COUNT;
+    const UBaseType_t uxInterrupt = uxDoorbell % ( UBaseType_t ) portPOSIX_INTERRUPT_COUNT;
+
+    configASSERT( pxNodeSegment != NULL );
+    configASSERT( uxNode < ( UBaseType_t ) pxNodeSegment->ulNodeCount );
+
+    ( void ) __atomic_fetch_or( &( pxNodeSegment->xNodes[ uxNode ].ulDoorbells ), ( uint32_t ) 1 << uxInterrupt, __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+static void prvNodeStart( void )
+{
+    const struct timespec xPoll = { 0, portNODE_POLL_NS };
+    UBaseType_t uxNode;
+
+    if( pxThisNode == NULL )
+    {
+        return;
+    }
+
+    __atomic_store_n( &pxThisNode->ulState, portNODE_RUNNING, __ATOMIC_SEQ_CST );
+
+    for( uxNode = 0; uxNode < ( UBaseType_t ) pxNodeSegment->ulNodeCount; uxNode++ )
+    {
+        while( __atomic_load_n( &( pxNodeSegment->xNodes[ uxNode ].ulState ), __ATOMIC_SEQ_CST ) == portNODE_NOT_STARTED )
+        {
+            ( void ) nanosleep( &xPoll, NULL );
+        }
+    }
+
+    /* Every node has the segment mapped, so its name is no longer needed and
+     * the segment is freed when the last node exits. */
+    if( uxThisNode == 0 )
+    {
+        ( void ) shm_unlink( pcNodeSegmentName );
+    }
+
+    free( pcNodeSegmentName );
+    pcNodeSegmentName = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvNodeLeave( void )
+{
+    if( pxThisNode != NULL )
+    {
+        __atomic_store_n( &pxThisNode->ulState, portNODE_ENDED, __ATOMIC_SEQ_CST );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvNodeClockAllowsTick( void )
+{
+    NodeState_t * pxNode;
+    uint64_t ullTicks;
+    UBaseType_t uxNode, uxChecked, uxNodeCount;
+
+    if( pxThisNode == NULL )
+    {
+        return pdTRUE;
+    }
+
+    uxNodeCount = ( UBaseType_t ) pxNodeSegment->ulNodeCount;
+    ullTicks = __atomic_load_n( &pxThisNode->ullTicks, __ATOMIC_SEQ_CST );
+
+    /* Start with the node that held the clock back last time, as it is the
+     * most likely to still be behind. */
+    uxNode = uxNodeClockHolder;
+
+    for( uxChecked = 0; uxChecked < uxNodeCount; uxChecked++ )
+    {
+        pxNode = &( pxNodeSegment->xNodes[ uxNode ] );
+
+        if( ( pxNode != pxThisNode ) &&
+            ( __atomic_load_n( &pxNode->ulState, __ATOMIC_SEQ_CST ) == portNODE_RUNNING ) &&
+            ( __atomic_load_n( &pxNode->ullTicks, __ATOMIC_SEQ_CST ) < ullTicks ) )
+        {
+            uxNodeClockHolder = uxNode;
+            return pdFALSE;
+        }
+
+        uxNode++;
+
+        if( uxNode == uxNodeCount )
+        {
+            uxNode = 0;
+        }
+    }
+
+    return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configPOSIX_NODES */
+
+unsigned long ulPortGetRunTime( void )
+{
+    return ulPoints;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetCycleCount( void )
+{
+    return ( uint32_t ) prvGetTimeNs();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configPOSIX_DETERMINISTIC == 1 */
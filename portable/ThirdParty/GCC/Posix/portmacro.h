@@ -63,7 +63,68 @@ typedef unsigned long UBaseType_t;
 typedef unsigned long TickType_t;
 #define portMAX_DELAY ( TickType_t ) ULONG_MAX
 
-#define portTICK_TYPE_IS_ATOMIC 1
+/* Deterministic simulation.  Set configPOSIX_DETERMINISTIC to 1 to run every
+ * task on the host thread that starts the scheduler, switching between them
+ * with swapcontext(), instead of giving each task a pthread and emulating
+ * interrupts with signals.  The tick and simulated interrupts are then only
+ * delivered at interrupt points - each time a task leaves its outermost
+ * critical section or otherwise enables interrupts, and each time round the
+ * idle task's loop - so a run depends only on which points the interrupts
+ * were delivered at.
+ *
+ * The tick follows the host clock, as checked at each point, unless
+ * configPOSIX_DETERMINISTIC_TICK_POINTS is non-zero, in which case a tick is
+ * delivered after every configPOSIX_DETERMINISTIC_TICK_POINTS points, and the
+ * idle task completes the current tick at once, so the whole run is
+ * reproducible.  xPortSimulationRecord() writes the point at which each tick
+ * and interrupt is delivered to a file, and xPortSimulationReplay() delivers
+ * them at exactly the same points on a later run - ignoring the host clock and
+ * interrupts raised by the host - so a run driven by real time and real input
+ * can be replayed exactly, for example to bisect a latency regression.
+ *
+ * A task that loops without calling the kernel never reaches a point, so is
+ * never preempted - call vPortInterruptPoint() in such loops.  Reading the
+ * tick count is a point, as the tick count is read in a critical section in
+ * this mode. */
+#ifndef configPOSIX_DETERMINISTIC
+    #define configPOSIX_DETERMINISTIC 0
+#endif
+
+#ifndef configPOSIX_DETERMINISTIC_TICK_POINTS
+    #define configPOSIX_DETERMINISTIC_TICK_POINTS 0
+#endif
+
+/* Distributed simulation.  Set configPOSIX_NODES to 1, as well as
+ * configPOSIX_DETERMINISTIC, to run a network of simulated devices as separate
+ * processes, each running its own instance of the kernel, that exchange data
+ * through POSIX shared memory.  Each process calls xPortNodeJoin() before
+ * starting its scheduler, giving the same segment name, node count and shared
+ * memory size, and its own node number.  pvPortNodeGetSharedMemory() then
+ * returns the zero initialised memory the nodes share, in which AMP channels
+ * (amp_channel.h) can be created, and vPortNodeRingDoorbell() raises a
+ * simulated interrupt on another node - so defining
+ *
+ *     #define configAMP_RING_DOORBELL( uxDoorbell )    vPortNodeRingDoorbell( uxDoorbell )
+ *
+ * and creating each channel end with portNODE_DOORBELL( uxOtherNode,
+ * uxInterrupt ) as its doorbell connects the channels between processes.
+ *
+ * The nodes share a virtual clock: the schedulers start together, once every
+ * node has joined, and no node delivers a tick until every other node still
+ * running has delivered as many ticks as it has, so the tick counts of the
+ * nodes never differ by more than one however unevenly the host runs them.
+ * A node that ends its scheduler or exits no longer holds the clock back. */
+#ifndef configPOSIX_NODES
+    #define configPOSIX_NODES 0
+#endif
+
+#if ( ( configPOSIX_NODES == 1 ) && ( configPOSIX_DETERMINISTIC != 1 ) )
+    #error configPOSIX_NODES requires configPOSIX_DETERMINISTIC to be set to 1.
+#endif
+
+#if ( configPOSIX_DETERMINISTIC == 0 )
+    #define portTICK_TYPE_IS_ATOMIC 1
+#endif
 
 /*-----------------------------------------------------------*/
 
@@ -104,6 +165,100 @@ extern void vPortExitCritical( void );
 
 /*-----------------------------------------------------------*/
 
+/* Tickless idle.  With configUSE_TICKLESS_IDLE set to 1 the idle task stops
+ * the SIGALRM tick and sleeps the host thread until the next task is due to
+ * unblock, or until another signal arrives, so an idle simulation uses no host
+ * CPU time.
+ *
+ * Set configPOSIX_VIRTUAL_TIME to 1 as well to run in virtual time: when every
+ * task is blocked the tick count jumps straight to the next unblock time
+ * instead of sleeping, so delays and timeouts complete as fast as the host can
+ * execute the tasks.  Time still advances in real time while any task other
+ * than the idle task is running. */
+#ifndef configPOSIX_VIRTUAL_TIME
+    #define configPOSIX_VIRTUAL_TIME 0
+#endif
+
+#if ( ( configPOSIX_DETERMINISTIC == 1 ) && ( configUSE_TICKLESS_IDLE != 0 ) )
+    #error configUSE_TICKLESS_IDLE cannot be used with configPOSIX_DETERMINISTIC, which completes or sleeps out idle ticks itself.
+#endif
+
+#if ( configUSE_TICKLESS_IDLE == 1 )
+    extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+    #define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#elif ( configPOSIX_VIRTUAL_TIME == 1 )
+    #error configPOSIX_VIRTUAL_TIME requires configUSE_TICKLESS_IDLE to be set to 1.
+#endif
+
+/* Dynamic tick.  With configUSE_DYNAMIC_TICK set to 1 the SIGALRM timer is
+ * reprogrammed to the next task unblock time while a task runs alone, rather
+ * than only while the idle task runs. */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    #if ( configPOSIX_DETERMINISTIC == 1 )
+        #error configUSE_DYNAMIC_TICK cannot be used with configPOSIX_DETERMINISTIC, which delivers every tick from its own schedule.
+    #endif
+
+    extern TickType_t xPortDynamicTickStop( TickType_t xMaxTicks );
+    #define portDYNAMIC_TICK_STOP( xMaxTicks ) xPortDynamicTickStop( xMaxTicks )
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( configPOSIX_DETERMINISTIC == 1 )
+
+/* The number of simulated interrupts, which are numbered from 0. */
+    #define portPOSIX_INTERRUPT_COUNT 32
+
+/* Record the ticks and interrupts delivered to pcFileName, or replay them
+ * from it.  Must be called before the scheduler is started.  Returns pdFAIL if
+ * the file cannot be opened.  A replay stops with an error if the run diverges
+ * from the recording, and the run continues as if live once the recording is
+ * exhausted. */
+    extern BaseType_t xPortSimulationRecord( const char *pcFileName );
+    extern BaseType_t xPortSimulationReplay( const char *pcFileName );
+
+/* Install the handler called when simulated interrupt uxInterrupt is
+ * delivered.  The handler runs with interrupts disabled and can call the
+ * FromISR() API functions and portYIELD_FROM_ISR(). */
+    extern void vPortSetInterruptHandler( UBaseType_t uxInterrupt, void ( *pxHandler )( void ) );
+
+/* Raise simulated interrupt uxInterrupt, which is delivered at the next
+ * point.  Can be called from any host thread or signal handler, as well as
+ * from tasks.  Ignored during a replay, when the recording raises the
+ * interrupts instead. */
+    extern void vPortRaiseInterrupt( UBaseType_t uxInterrupt );
+
+/* An interrupt point, for tasks that loop without calling the kernel. */
+    extern void vPortInterruptPoint( void );
+
+    extern void vPortIdleLoop( void );
+    #define portIDLE_LOOP_HOOK() vPortIdleLoop()
+
+#endif /* configPOSIX_DETERMINISTIC */
+
+#if ( configPOSIX_NODES == 1 )
+
+/* The doorbell that raises simulated interrupt uxInterrupt on node uxNode. */
+    #define portNODE_DOORBELL( uxNode, uxInterrupt ) ( ( ( UBaseType_t ) ( uxNode ) * ( UBaseType_t ) portPOSIX_INTERRUPT_COUNT ) + ( UBaseType_t ) ( uxInterrupt ) )
+
+/* Join node uxNode of uxNodeCount to the shared memory segment pcName, which
+ * is created by node 0 with xSharedBytes of memory for the application - the
+ * other nodes wait for it.  The name must be unique to the run, for example by
+ * including the process ID of the launcher, as a segment left by an earlier
+ * run could otherwise be joined.  Must be called before the scheduler is
+ * started.  Returns pdFAIL if the segment cannot be created or mapped. */
+    extern BaseType_t xPortNodeJoin( const char *pcName, UBaseType_t uxNode, UBaseType_t uxNodeCount, size_t xSharedBytes );
+
+/* The xSharedBytes of memory shared by the nodes, aligned to 64 bytes.  Its
+ * address differs between the processes. */
+    extern void *pvPortNodeGetSharedMemory( void );
+
+/* Raise the simulated interrupt identified by uxDoorbell, created with
+ * portNODE_DOORBELL(), on its node.  It is delivered at the node's next
+ * interrupt point.  Can be called from tasks and interrupt handlers. */
+    extern void vPortNodeRingDoorbell( UBaseType_t uxDoorbell );
+
+#endif /* configPOSIX_NODES */
+
 extern void vPortThreadDying( void *pxTaskToDelete, volatile BaseType_t *pxPendYield );
 extern void vPortCancelThread( void *pxTaskToDelete );
 #define portPRE_TASK_DELETE_HOOK( pvTaskToDelete, pxPendYield ) vPortThreadDying( ( pvTaskToDelete ), ( pxPendYield ) )
@@ -124,10 +279,28 @@ extern void vPortCancelThread( void *pxTaskToDelete );
  */
 #define portMEMORY_BARRIER() __asm volatile( "" ::: "memory" )
 
+/* The __atomic built-in functions are atomic with respect to the signals that
+ * emulate interrupts, so atomic.h does not need to block them. */
+#define portHAS_NATIVE_ATOMICS 1
+
+/* The atomic.h functions are static, so must be inline to not be reported as
+ * unused by files that only use some of them. */
+#ifndef portFORCE_INLINE
+    #define portFORCE_INLINE inline __attribute__( ( always_inline ) )
+#endif
+
+/* In deterministic mode the run time counter is the number of interrupt
+ * points passed, so run time stats are reproducible too. */
 extern unsigned long ulPortGetRunTime( void );
 #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() /* no-op */
 #define portGET_RUN_TIME_COUNTER_VALUE()         ulPortGetRunTime()
 
+/* The cycle counter read by the cycle benchmark counts nanoseconds of the
+ * host's monotonic clock, so the benchmark can be run on the host to compare
+ * configurations, though the counts are not target cycles. */
+extern uint32_t ulPortGetCycleCount( void );
+#define portGET_CYCLE_COUNT()                    ulPortGetCycleCount()
+
 #ifdef __cplusplus
 }
 #endif
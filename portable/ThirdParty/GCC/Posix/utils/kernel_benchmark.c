@@ -0,0 +1,436 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/*
+ * Kernel self-benchmark for the POSIX simulator.  See kernel_benchmark.h.
+ */
+
+#include <stdio.h>
+#include <time.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+#include "timers.h"
+#include "kernel_benchmark.h"
+
+/* The benchmark is built into the port library, so it is compiled out, rather
+ * than raising an error, when the application's configuration does not provide
+ * the functions it needs. */
+#if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_vTaskDelete == 1 ) && \
+    ( INCLUDE_uxTaskPriorityGet == 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) )
+
+#define benchSTACK_SIZE             ( configMINIMAL_STACK_SIZE * 2 )
+#define benchSTREAM_BUFFER_SIZE     ( ( size_t ) 1024 )
+#define benchSTREAM_CHUNK_SIZE      ( ( size_t ) 64 )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The monotonic host time in nanoseconds.
+ */
+static uint64_t prvGetTimeNs( void );
+
+/*
+ * Write the result of one benchmark as a line of JSON.
+ */
+static void prvReport( const char * pcName,
+                       uint32_t ulIterations,
+                       uint64_t ullTotalNs );
+
+/*
+ * Create a helper task, asserting that it was created.
+ */
+static TaskHandle_t prvCreateHelper( TaskFunction_t pxTaskCode,
+                                     const char * pcName,
+                                     void * pvParameters,
+                                     UBaseType_t uxPriority );
+
+/*
+ * The benchmarks, and the helper tasks they run against.
+ */
+static void prvBenchmarkYield( uint32_t ulIterations );
+static void prvYieldTask( void * pvParameters );
+
+static void prvBenchmarkQueue( uint32_t ulIterations );
+static void prvQueueEchoTask( void * pvParameters );
+
+static void prvBenchmarkSemaphore( uint32_t ulIterations );
+static void prvSemaphoreEchoTask( void * pvParameters );
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    static void prvBenchmarkNotify( uint32_t ulIterations );
+    static void prvNotifyEchoTask( void * pvParameters );
+#endif
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    static void prvBenchmarkStreamBuffer( uint32_t ulIterations );
+    static void prvStreamBufferReaderTask( void * pvParameters );
+#endif
+
+#if ( configUSE_TIMERS == 1 )
+    static void prvBenchmarkTimer( uint32_t ulIterations );
+    static void prvTimerCallback( TimerHandle_t xTimer );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The pair of queues or semaphores used by the echo tasks.  The first is
+ * written by the benchmarking task, the second by the echo task. */
+static QueueHandle_t xPingPong[ 2 ] = { NULL, NULL };
+
+/* The benchmarking task, which prvNotifyEchoTask() notifies. */
+static TaskHandle_t xBenchmarkTask = NULL;
+
+/*-----------------------------------------------------------*/
+
+void vKernelBenchmarkRun( uint32_t ulIterations )
+{
+    configASSERT( ulIterations > 0U );
+    configASSERT( uxTaskPriorityGet( NULL ) < ( UBaseType_t ) ( configMAX_PRIORITIES - 1 ) );
+
+    xBenchmarkTask = xTaskGetCurrentTaskHandle();
+
+    prvBenchmarkYield( ulIterations );
+    prvBenchmarkQueue( ulIterations );
+    prvBenchmarkSemaphore( ulIterations );
+
+    #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    {
+        prvBenchmarkNotify( ulIterations );
+        prvBenchmarkStreamBuffer( ulIterations );
+    }
+    #endif
+
+    #if ( configUSE_TIMERS == 1 )
+    {
+        prvBenchmarkTimer( ulIterations );
+    }
+    #endif
+
+    xBenchmarkTask = NULL;
+}
+/*-----------------------------------------------------------*/
+
+static uint64_t prvGetTimeNs( void )
+{
+    struct timespec xNow;
+
+    ( void ) clock_gettime( CLOCK_MONOTONIC, &xNow );
+
+    return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReport( const char * pcName,
+                       uint32_t ulIterations,
+                       uint64_t ullTotalNs )
+{
+    printf( "{\"benchmark\":\"%s\",\"iterations\":%lu,\"total_ns\":%llu,\"ns_per_op\":%llu}\n",
+            pcName,
+            ( unsigned long ) ulIterations,
+            ( unsigned long long ) ullTotalNs,
+            ( unsigned long long ) ( ullTotalNs / ulIterations ) );
+    fflush( stdout );
+}
+/*-----------------------------------------------------------*/
+
+static TaskHandle_t prvCreateHelper( TaskFunction_t pxTaskCode,
+                                     const char * pcName,
+                                     void * pvParameters,
+                                     UBaseType_t uxPriority )
+{
+    TaskHandle_t xTask = NULL;
+    BaseType_t xReturned;
+
+    xReturned = xTaskCreate( pxTaskCode, pcName, benchSTACK_SIZE, pvParameters, uxPriority, &xTask );
+    configASSERT( xReturned == pdPASS );
+    ( void ) xReturned;
+
+    return xTask;
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkYield( uint32_t ulIterations )
+{
+    TaskHandle_t xHelper;
+    uint32_t ul;
+    uint64_t ullStart;
+
+    xHelper = prvCreateHelper( prvYieldTask, "BenchYield", NULL, uxTaskPriorityGet( NULL ) );
+
+    /* Let the helper start so the first yield is not timed alone. */
+    taskYIELD();
+
+    ullStart = prvGetTimeNs();
+
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        /* Switches to the helper, which yields straight back. */
+        taskYIELD();
+    }
+
+    prvReport( "task_yield", ulIterations, prvGetTimeNs() - ullStart );
+
+    vTaskDelete( xHelper );
+}
+/*-----------------------------------------------------------*/
+
+static void prvYieldTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        taskYIELD();
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkQueue( uint32_t ulIterations )
+{
+    TaskHandle_t xHelper;
+    uint32_t ul, ulReceived;
+    uint64_t ullStart;
+
+    xPingPong[ 0 ] = xQueueCreate( 1, sizeof( uint32_t ) );
+    xPingPong[ 1 ] = xQueueCreate( 1, sizeof( uint32_t ) );
+    configASSERT( ( xPingPong[ 0 ] != NULL ) && ( xPingPong[ 1 ] != NULL ) );
+
+    /* The echo task runs at a higher priority, so each send switches to it
+     * and each receive waits for it to send the item back. */
+    xHelper = prvCreateHelper( prvQueueEchoTask, "BenchQueue", NULL, uxTaskPriorityGet( NULL ) + 1U );
+
+    ullStart = prvGetTimeNs();
+
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        ( void ) xQueueSend( xPingPong[ 0 ], &ul, portMAX_DELAY );
+        ( void ) xQueueReceive( xPingPong[ 1 ], &ulReceived, portMAX_DELAY );
+        configASSERT( ulReceived == ul );
+    }
+
+    prvReport( "queue_ping_pong", ulIterations, prvGetTimeNs() - ullStart );
+
+    vTaskDelete( xHelper );
+    vQueueDelete( xPingPong[ 0 ] );
+    vQueueDelete( xPingPong[ 1 ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvQueueEchoTask( void * pvParameters )
+{
+    uint32_t ulValue;
+
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xQueueReceive( xPingPong[ 0 ], &ulValue, portMAX_DELAY );
+        ( void ) xQueueSend( xPingPong[ 1 ], &ulValue, portMAX_DELAY );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvBenchmarkSemaphore( uint32_t ulIterations )
+{
+    TaskHandle_t xHelper;
+    uint32_t ul;
+    uint64_t ullStart;
+
+    xPingPong[ 0 ] = xSemaphoreCreateBinary();
+    xPingPong[ 1 ] = xSemaphoreCreateBinary();
+    configASSERT( ( xPingPong[ 0 ] != NULL ) && ( xPingPong[ 1 ] != NULL ) );
+
+    xHelper = prvCreateHelper( prvSemaphoreEchoTask, "BenchSem", NULL, uxTaskPriorityGet( NULL ) + 1U );
+
+    ullStart = prvGetTimeNs();
+
+    for( ul = 0; ul < ulIterations; ul++ )
+    {
+        ( void ) xSemaphoreGive( xPingPong[ 0 ] );
+        ( void ) xSemaphoreTake( xPingPong[ 1 ], portMAX_DELAY );
+    }
+
+    prvReport( "semaphore_ping_pong", ulIterations, prvGetTimeNs() - ullStart );
+
+    vTaskDelete( xHelper );
+    vSemaphoreDelete( xPingPong[ 0 ] );
+    vSemaphoreDelete( xPingPong[ 1 ] );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSemaphoreEchoTask( void * pvParameters )
+{
+    ( void ) pvParameters;
+
+    for( ; ; )
+    {
+        ( void ) xSemaphoreTake( xPingPong[ 0 ], portMAX_DELAY );
+        ( void ) xSemaphoreGive( xPingPong[ 1 ] );
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    static void prvBenchmarkNotify( uint32_t ulIterations )
+    {
+        TaskHandle_t xHelper;
+        uint32_t ul;
+        uint64_t ullStart;
+
+        xHelper = prvCreateHelper( prvNotifyEchoTask, "BenchNotify", NULL, uxTaskPriorityGet( NULL ) + 1U );
+
+        ullStart = prvGetTimeNs();
+
+        for( ul = 0; ul < ulIterations; ul++ )
+        {
+            ( void ) xTaskNotifyGive( xHelper );
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+        }
+
+        prvReport( "notify_ping_pong", ulIterations, prvGetTimeNs() - ullStart );
+
+        vTaskDelete( xHelper );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvNotifyEchoTask( void * pvParameters )
+    {
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            ( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+            ( void ) xTaskNotifyGive( xBenchmarkTask );
+        }
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    static void prvBenchmarkStreamBuffer( uint32_t ulIterations )
+    {
+        StreamBufferHandle_t xStreamBuffer;
+        TaskHandle_t xHelper;
+        uint8_t ucChunk[ benchSTREAM_CHUNK_SIZE ] = { 0 };
+        uint32_t ul;
+        uint64_t ullStart;
+
+        /* A stream buffer has a single reader and a single writer, which are
+         * of equal priority so the writer fills the buffer before the reader
+         * runs, as it would when streaming data. */
+        xStreamBuffer = xStreamBufferCreate( benchSTREAM_BUFFER_SIZE, benchSTREAM_CHUNK_SIZE );
+        configASSERT( xStreamBuffer != NULL );
+
+        xHelper = prvCreateHelper( prvStreamBufferReaderTask, "BenchStream", ( void * ) xStreamBuffer, uxTaskPriorityGet( NULL ) );
+
+        ullStart = prvGetTimeNs();
+
+        for( ul = 0; ul < ulIterations; ul++ )
+        {
+            ( void ) xStreamBufferSend( xStreamBuffer, ucChunk, sizeof( ucChunk ), portMAX_DELAY );
+        }
+
+        /* Wait for the reader to drain the buffer. */
+        while( xStreamBufferIsEmpty( xStreamBuffer ) == pdFALSE )
+        {
+            taskYIELD();
+        }
+
+        prvReport( "stream_buffer_send", ulIterations, prvGetTimeNs() - ullStart );
+
+        vTaskDelete( xHelper );
+        vStreamBufferDelete( xStreamBuffer );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStreamBufferReaderTask( void * pvParameters )
+    {
+        StreamBufferHandle_t xStreamBuffer = ( StreamBufferHandle_t ) pvParameters;
+        uint8_t ucBuffer[ benchSTREAM_BUFFER_SIZE / 4 ];
+
+        for( ; ; )
+        {
+            ( void ) xStreamBufferReceive( xStreamBuffer, ucBuffer, sizeof( ucBuffer ), portMAX_DELAY );
+        }
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    static void prvBenchmarkTimer( uint32_t ulIterations )
+    {
+        TimerHandle_t xTimer;
+        uint32_t ul;
+        uint64_t ullStart;
+
+        /* The period is long enough that the timer never expires, so only the
+         * cost of sending the commands to, and processing them in, the timer
+         * task is measured. */
+        xTimer = xTimerCreate( "BenchTimer", portMAX_DELAY / 2U, pdFALSE, NULL, prvTimerCallback );
+        configASSERT( xTimer != NULL );
+
+        ullStart = prvGetTimeNs();
+
+        for( ul = 0; ul < ulIterations; ul++ )
+        {
+            ( void ) xTimerStart( xTimer, portMAX_DELAY );
+            ( void ) xTimerStop( xTimer, portMAX_DELAY );
+        }
+
+        /* Wait for the timer task to process the last command, assuming it
+         * runs at a higher priority than the calling task. */
+        while( xTimerIsTimerActive( xTimer ) != pdFALSE )
+        {
+            taskYIELD();
+        }
+
+        prvReport( "timer_start_stop", ulIterations, prvGetTimeNs() - ullStart );
+
+        ( void ) xTimerDelete( xTimer, portMAX_DELAY );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvTimerCallback( TimerHandle_t xTimer )
+    {
+        ( void ) xTimer;
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+#endif /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( INCLUDE_vTaskDelete == 1 ) && ( INCLUDE_uxTaskPriorityGet == 1 ) && ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) ) */
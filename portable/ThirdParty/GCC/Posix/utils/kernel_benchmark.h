@@ -0,0 +1,66 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+#ifndef KERNEL_BENCHMARK_H
+#define KERNEL_BENCHMARK_H
+
+#include <stdint.h>
+
+/*
+ * Measures the cost of the most frequently used kernel paths on the POSIX
+ * simulator so that changes to tasks.c, queue.c, stream_buffer.c and timers.c
+ * can be checked for performance regressions before they reach hardware:
+ *
+ *  task_yield           - a taskYIELD() round trip between two tasks of
+ *                         equal priority.
+ *  queue_ping_pong      - an item sent to a higher priority task and sent
+ *                         back on a second queue.
+ *  semaphore_ping_pong  - the same with two binary semaphores.
+ *  notify_ping_pong     - the same with direct to task notifications.
+ *  stream_buffer_send   - a 64 byte write to a stream buffer drained by a
+ *                         task of equal priority.
+ *  timer_start_stop     - xTimerStart() followed by xTimerStop().
+ *
+ * Each benchmark runs ulIterations times and writes one line of JSON to
+ * stdout, for example:
+ *
+ * {"benchmark":"queue_ping_pong","iterations":10000,"total_ns":51234567,"ns_per_op":5123}
+ *
+ * The host's scheduling makes absolute numbers noisy, so compare the median of
+ * several runs rather than single results.  Benchmarks whose features are
+ * excluded by FreeRTOSConfig.h are skipped.
+ *
+ * vKernelBenchmarkRun() must be called from a task after the scheduler has
+ * been started.  It creates helper tasks one priority above the calling task,
+ * so the calling task's priority must be less than configMAX_PRIORITIES - 1.
+ * It is only built when configSUPPORT_DYNAMIC_ALLOCATION, INCLUDE_vTaskDelete,
+ * INCLUDE_uxTaskPriorityGet and INCLUDE_xTaskGetCurrentTaskHandle are all 1.
+ */
+void vKernelBenchmarkRun( uint32_t ulIterations );
+
+#endif /* KERNEL_BENCHMARK_H */
@@ -30,8 +30,164 @@
 #include <stdlib.h>
 #include <errno.h>
 
+#if defined( __linux__ )
+    #include <linux/futex.h>
+    #include <stdatomic.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
 #include "wait_for_event.h"
 
+#if defined( __linux__ )
+
+/*
+ * On Linux an event is a single futex word, so handing the processor from one
+ * task thread to another costs one FUTEX_WAKE in the signalling thread and one
+ * FUTEX_WAIT in the waiting thread, rather than the mutex and condition
+ * variable operations below.  The word is:
+ *
+ *  EVENT_CLEAR     - not triggered and nobody waiting.
+ *  EVENT_TRIGGERED - triggered, the next wait returns immediately.
+ *  EVENT_WAITING   - not triggered and a thread is (about to be) asleep in
+ *                    the kernel, so event_signal() must wake it.
+ */
+#define EVENT_CLEAR        0
+#define EVENT_TRIGGERED    1
+#define EVENT_WAITING      2
+
+struct event
+{
+    atomic_int state;
+};
+
+static int prvFutex( atomic_int * state,
+                     int op,
+                     int val,
+                     const struct timespec * timeout )
+{
+    return ( int ) syscall( SYS_futex, state, op | FUTEX_PRIVATE_FLAG, val, timeout, NULL, 0 );
+}
+
+/* Unlike pthread_cond_wait(), a raw futex wait is not a cancellation point,
+ * but vPortCancelThread() cancels threads that are suspended in event_wait().
+ * Allow asynchronous cancellation while asleep - the event holds no resources
+ * that need releasing. */
+static void prvFutexWait( atomic_int * state,
+                          const struct timespec * timeout )
+{
+    int oldtype;
+
+    pthread_setcanceltype( PTHREAD_CANCEL_ASYNCHRONOUS, &oldtype );
+    ( void ) prvFutex( state, FUTEX_WAIT, EVENT_WAITING, timeout );
+    pthread_setcanceltype( oldtype, NULL );
+}
+
+struct event * event_create( void )
+{
+    struct event * ev = malloc( sizeof( struct event ) );
+
+    atomic_init( &ev->state, EVENT_CLEAR );
+    return ev;
+}
+
+void event_delete( struct event * ev )
+{
+    free( ev );
+}
+
+/* Consume the event if it is triggered, otherwise mark a thread as waiting.
+ * Returns true if the event was consumed. */
+static bool prvEventTryConsume( struct event * ev )
+{
+    int expected = EVENT_TRIGGERED;
+
+    if( atomic_compare_exchange_strong( &ev->state, &expected, EVENT_CLEAR ) )
+    {
+        return true;
+    }
+
+    if( expected == EVENT_CLEAR )
+    {
+        /* If this fails the event was triggered in between, in which case the
+         * futex wait returns immediately and the event is consumed on the next
+         * attempt. */
+        ( void ) atomic_compare_exchange_strong( &ev->state, &expected, EVENT_WAITING );
+    }
+
+    return false;
+}
+
+bool event_wait( struct event * ev )
+{
+    while( prvEventTryConsume( ev ) == false )
+    {
+        prvFutexWait( &ev->state, NULL );
+    }
+
+    return true;
+}
+
+bool event_wait_timed( struct event * ev,
+                       time_t ms )
+{
+    struct timespec ts, now, remaining;
+    int expected;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    ts.tv_sec += ms / 1000;
+    ts.tv_nsec += ( ( ms % 1000 ) * 1000000 );
+
+    if( ts.tv_nsec >= 1000000000 )
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000;
+    }
+
+    while( prvEventTryConsume( ev ) == false )
+    {
+        /* FUTEX_WAIT takes a relative timeout. */
+        clock_gettime( CLOCK_MONOTONIC, &now );
+        remaining.tv_sec = ts.tv_sec - now.tv_sec;
+        remaining.tv_nsec = ts.tv_nsec - now.tv_nsec;
+
+        if( remaining.tv_nsec < 0 )
+        {
+            remaining.tv_sec--;
+            remaining.tv_nsec += 1000000000;
+        }
+
+        if( remaining.tv_sec < 0 )
+        {
+            /* Timed out, so stop waiting unless the event was triggered
+             * meanwhile. */
+            expected = EVENT_WAITING;
+
+            if( atomic_compare_exchange_strong( &ev->state, &expected, EVENT_CLEAR ) ||
+                ( expected == EVENT_CLEAR ) )
+            {
+                return false;
+            }
+        }
+        else
+        {
+            prvFutexWait( &ev->state, &remaining );
+        }
+    }
+
+    return true;
+}
+
+void event_signal( struct event * ev )
+{
+    if( atomic_exchange( &ev->state, EVENT_TRIGGERED ) == EVENT_WAITING )
+    {
+        ( void ) prvFutex( &ev->state, FUTEX_WAKE, 1, NULL );
+    }
+}
+
+#else /* if defined( __linux__ ) */
+
 struct event
 {
     pthread_mutex_t mutex;
@@ -102,3 +258,5 @@ void event_signal( struct event * ev )
     pthread_cond_signal( &ev->cond );
     pthread_mutex_unlock( &ev->mutex );
 }
+
+#endif /* if defined( __linux__ ) */
@@ -98,6 +98,35 @@
 
 /*-----------------------------------------------------------*/
 
+/* Multi-core support.  The kernel's task and ISR locks are built on two of the
+ * SIO hardware spin locks, and the other core is made to yield by writing to
+ * its SIO FIFO. */
+    #if defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 )
+        #include "rp2040_config.h"
+
+        /* Reads the SIO CPUID register. */
+        #define portGET_CORE_ID()                        get_core_num()
+
+        extern void vPortYieldCore( BaseType_t xCoreID );
+        #define portYIELD_CORE( xCoreID )                vPortYieldCore( xCoreID )
+
+        #define portRTOS_SPINLOCK_COUNT                  2
+        extern void vPortRecursiveLock( uint32_t ulLockNum, uint32_t ulSpinLockNum, BaseType_t xAcquire );
+        #define portGET_ISR_LOCK()                       vPortRecursiveLock( 0, configSMP_SPINLOCK_0, pdTRUE )
+        #define portRELEASE_ISR_LOCK()                   vPortRecursiveLock( 0, configSMP_SPINLOCK_0, pdFALSE )
+        #define portGET_TASK_LOCK()                      vPortRecursiveLock( 1, configSMP_SPINLOCK_1, pdTRUE )
+        #define portRELEASE_TASK_LOCK()                  vPortRecursiveLock( 1, configSMP_SPINLOCK_1, pdFALSE )
+
+        extern UBaseType_t uxCriticalNestings[ configNUMBER_OF_CORES ];
+        #define portGET_CRITICAL_NESTING_COUNT()         ( uxCriticalNestings[ portGET_CORE_ID() ] )
+        #define portINCREMENT_CRITICAL_NESTING_COUNT()   ( uxCriticalNestings[ portGET_CORE_ID() ]++ )
+        #define portDECREMENT_CRITICAL_NESTING_COUNT()   ( uxCriticalNestings[ portGET_CORE_ID() ]-- )
+
+        #define portASSERT_IF_IN_ISR()                   configASSERT( portCHECK_IF_IN_ISR() == 0 )
+    #endif /* configNUMBER_OF_CORES */
+
+/*-----------------------------------------------------------*/
+
 /* Exception handlers */
     #if (configUSE_DYNAMIC_EXCEPTION_HANDLERS == 0)
         /* We only need to override the SDK's weak functions if we want to replace them at compile time */
@@ -124,10 +153,21 @@
     extern void vPortEnableInterrupts();
     #define portENABLE_INTERRUPTS()                   vPortEnableInterrupts()
 
-    extern void vPortEnterCritical( void );
-    extern void vPortExitCritical( void );
-    #define portENTER_CRITICAL()                      vPortEnterCritical()
-    #define portEXIT_CRITICAL()                       vPortExitCritical()
+    #if defined( configNUMBER_OF_CORES ) && ( configNUMBER_OF_CORES > 1 )
+        extern void vTaskEnterCritical( void );
+        extern void vTaskExitCritical( void );
+        extern UBaseType_t vTaskEnterCriticalFromISR( void );
+        extern void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus );
+        #define portENTER_CRITICAL()                      vTaskEnterCritical()
+        #define portEXIT_CRITICAL()                       vTaskExitCritical()
+        #define portENTER_CRITICAL_FROM_ISR()             vTaskEnterCriticalFromISR()
+        #define portEXIT_CRITICAL_FROM_ISR( x )           vTaskExitCriticalFromISR( x )
+    #else
+        extern void vPortEnterCritical( void );
+        extern void vPortExitCritical( void );
+        #define portENTER_CRITICAL()                      vPortEnterCritical()
+        #define portEXIT_CRITICAL()                       vPortExitCritical()
+    #endif /* configNUMBER_OF_CORES */
 
 /*-----------------------------------------------------------*/
 
@@ -144,6 +184,11 @@
 
     #define portNOP()
 
+/* Used by the kernel's spin-wait loops, so a core waiting for the other core
+ * to notify it sleeps until the other core executes SEV. */
+    #define portWAIT_FOR_EVENT()    __asm volatile ( "wfe" ::: "memory" )
+    #define portSEND_EVENT()        __asm volatile ( "sev" ::: "memory" )
+
     #define portMEMORY_BARRIER()    __asm volatile ( "" ::: "memory" )
 
     #ifdef __cplusplus
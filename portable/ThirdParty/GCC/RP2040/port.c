@@ -46,6 +46,29 @@
     #include "pico/multicore.h"
 #endif /* LIB_PICO_MULTICORE */
 
+/*
+ * portRUNNING_ON_BOTH_CORES == 1 if FreeRTOS tasks are scheduled on both cores
+ * by the SMP kernel, in which case the SIO FIFO is used to make the other core
+ * yield.  Otherwise FreeRTOS runs on whichever core started the scheduler, and
+ * the SIO FIFO is used by the SDK sync interop to signal that core from code
+ * running on the other core.
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+    #if ( LIB_PICO_MULTICORE != 1 )
+        #error configNUMBER_OF_CORES > 1 requires the application to link pico_multicore.
+    #endif
+    #if ( configNUMBER_OF_CORES != 2 )
+        #error The RP2040 has two cores, so configNUMBER_OF_CORES must be 1 or 2.
+    #endif
+    #include "hardware/sync.h"
+    #include "hardware/irq.h"
+    #define portRUNNING_ON_BOTH_CORES    1
+#else
+    #define portRUNNING_ON_BOTH_CORES    0
+#endif /* configNUMBER_OF_CORES */
+
+#define portUSE_CROSS_CORE_EVENTS        ( ( LIB_PICO_MULTICORE == 1 ) && ( portRUNNING_ON_BOTH_CORES == 0 ) )
+
 /* Constants required to manipulate the NVIC. */
 #define portNVIC_SYSTICK_CTRL_REG             ( *( ( volatile uint32_t * ) 0xe000e010 ) )
 #define portNVIC_SYSTICK_LOAD_REG             ( *( ( volatile uint32_t * ) 0xe000e014 ) )
@@ -109,10 +132,21 @@ static void prvTaskExitError( void );
 
 /*-----------------------------------------------------------*/
 
-/* Each task maintains its own interrupt status in the critical nesting
- * variable. This is initialized to 0 to allow vPortEnter/ExitCritical
- * to be called before the scheduler is started */
-static UBaseType_t uxCriticalNesting;
+#if ( portRUNNING_ON_BOTH_CORES == 1 )
+    /* The critical nesting count of each core, maintained by the kernel
+     * through the portGET/INCREMENT/DECREMENT_CRITICAL_NESTING_COUNT() macros. */
+    UBaseType_t uxCriticalNestings[ configNUMBER_OF_CORES ] = { 0 };
+
+    /* Which of the kernel's locks each core holds, as a bitmap indexed by the
+     * lock number, and how many times the holder has taken each lock. */
+    static uint8_t ucOwnedByCore[ configNUMBER_OF_CORES ];
+    static uint8_t ucRecursionCountByLock[ portRTOS_SPINLOCK_COUNT ];
+#else
+    /* Each task maintains its own interrupt status in the critical nesting
+     * variable. This is initialized to 0 to allow vPortEnter/ExitCritical
+     * to be called before the scheduler is started */
+    static UBaseType_t uxCriticalNesting;
+#endif /* portRUNNING_ON_BOTH_CORES */
 
 /*-----------------------------------------------------------*/
 
@@ -125,13 +159,15 @@ static UBaseType_t uxCriticalNesting;
         #define pEventGroup (&xStaticEventGroup)
     #endif /* configSUPPORT_STATIC_ALLOCATION */
     static EventGroupHandle_t xEventGroup;
-    #if ( LIB_PICO_MULTICORE == 1 )
+    #if portUSE_CROSS_CORE_EVENTS
         static EventBits_t uxCrossCoreEventBits;
         static spin_lock_t * pxCrossCoreSpinLock;
-    #endif /* LIB_PICO_MULTICORE */
+    #endif /* portUSE_CROSS_CORE_EVENTS */
 
-    static spin_lock_t * pxYieldSpinLock;
-    static uint32_t ulYieldSpinLockSaveValue;
+    /* The spin lock, if any, a task on each core has deferred releasing until
+     * interrupts are next enabled. */
+    static spin_lock_t * pxYieldSpinLock[ configNUMBER_OF_CORES ];
+    static uint32_t ulYieldSpinLockSaveValue[ configNUMBER_OF_CORES ];
 #endif /* configSUPPORT_PICO_SYNC_INTEROP */
 
 /*
@@ -159,9 +195,13 @@ static UBaseType_t uxCriticalNesting;
 
 /*-----------------------------------------------------------*/
 
-#define INVALID_LAUNCH_CORE_NUM 0xffu
-static uint8_t ucLaunchCoreNum = INVALID_LAUNCH_CORE_NUM;
-#define portIS_FREE_RTOS_CORE() ( ucLaunchCoreNum == get_core_num() )
+#if ( portRUNNING_ON_BOTH_CORES == 1 )
+    #define portIS_FREE_RTOS_CORE() ( pdTRUE )
+#else
+    #define INVALID_LAUNCH_CORE_NUM 0xffu
+    static uint8_t ucLaunchCoreNum = INVALID_LAUNCH_CORE_NUM;
+    #define portIS_FREE_RTOS_CORE() ( ucLaunchCoreNum == get_core_num() )
+#endif /* portRUNNING_ON_BOTH_CORES */
 
 /*
  * See header file for description.
@@ -206,8 +246,16 @@ void vPortStartFirstTask( void )
 {
     __asm volatile (
         "   .syntax unified             \n"
-        "   ldr  r2, pxCurrentTCBConst1 \n"/* Obtain location of pxCurrentTCB. */
-        "   ldr  r3, [r2]               \n"
+        #if ( portRUNNING_ON_BOTH_CORES == 1 )
+            "   adr  r1, ulAsmLocals1   \n"/* Obtain location of pxCurrentTCBs[ core ]. */
+            "   ldmia r1!, {r2, r3}     \n"
+            "   ldr  r2, [r2]           \n"/* r2 = core number. */
+            "   lsls r2, r2, #2         \n"
+            "   ldr  r3, [r3, r2]       \n"
+        #else
+            "   ldr  r2, pxCurrentTCBConst1 \n"/* Obtain location of pxCurrentTCB. */
+            "   ldr  r3, [r2]               \n"
+        #endif /* portRUNNING_ON_BOTH_CORES */
         "   ldr  r0, [r3]               \n"/* The first item in pxCurrentTCB is the task top of stack. */
         "   adds r0, #32                \n"/* Discard everything up to r0. */
         "   msr  psp, r0                \n"/* This is now the new top of stack to use in the task. */
@@ -221,12 +269,27 @@ void vPortStartFirstTask( void )
         "   cpsie i                     \n"/* The first task has its context and interrupts can be enabled. */
         "   bx   r3                     \n"/* Finally, jump to the user defined task code. */
     "   .align 4                       \n"
-    "pxCurrentTCBConst1: .word pxCurrentTCB\n"
+    #if ( portRUNNING_ON_BOTH_CORES == 1 )
+        "ulAsmLocals1:                 \n"
+        "   .word 0xd0000000           \n"/* SIO_BASE + SIO_CPUID_OFFSET */
+        "   .word pxCurrentTCBs        \n"
+    #else
+        "pxCurrentTCBConst1: .word pxCurrentTCB\n"
+    #endif /* portRUNNING_ON_BOTH_CORES */
     );
 }
 /*-----------------------------------------------------------*/
 
-#if ( LIB_PICO_MULTICORE == 1 ) && ( configSUPPORT_PICO_SYNC_INTEROP == 1)
+#if ( portRUNNING_ON_BOTH_CORES == 1 )
+    static void prvFIFOInterruptHandler()
+    {
+        /* The other core wrote to the FIFO to make this core yield.  The value
+         * written is not used, but must be removed to clear the IRQ. */
+        multicore_fifo_drain();
+        multicore_fifo_clear_irq();
+        portYIELD_FROM_ISR( pdTRUE );
+    }
+#elif portUSE_CROSS_CORE_EVENTS && ( configSUPPORT_PICO_SYNC_INTEROP == 1 )
     static void prvFIFOInterruptHandler()
     {
         /* We must remove the contents (which we don't care about)
@@ -244,9 +307,11 @@ void vPortStartFirstTask( void )
 #endif
 
 /*
- * See header file for description.
+ * Prepare the calling core to run tasks.  The exception priorities and, if
+ * used, the FIFO interrupt belong to each core, so this runs on both cores
+ * when FreeRTOS is running on both.
  */
-BaseType_t xPortStartScheduler( void )
+static void prvSetupCore( void )
 {
     /* Make PendSV, CallSV and SysTick the same priority as the kernel. */
     portNVIC_SHPR3_REG |= portNVIC_PENDSV_PRI;
@@ -258,23 +323,59 @@ BaseType_t xPortStartScheduler( void )
         exception_set_exclusive_handler( SVCALL_EXCEPTION, vPortSVCHandler );
     #endif
 
+    #if ( portRUNNING_ON_BOTH_CORES == 1 ) || ( portUSE_CROSS_CORE_EVENTS && ( configSUPPORT_PICO_SYNC_INTEROP == 1 ) )
+        multicore_fifo_clear_irq();
+        #if ( portRUNNING_ON_BOTH_CORES == 0 )
+            /* Anything already in the FIFO is a yield request when running
+             * on both cores, so is only discarded here otherwise. */
+            multicore_fifo_drain();
+        #endif
+        uint32_t irq_num = 15 + get_core_num();
+        irq_set_priority( irq_num, portMIN_INTERRUPT_PRIORITY );
+        irq_set_exclusive_handler( irq_num, prvFIFOInterruptHandler );
+        irq_set_enabled( irq_num, 1 );
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( portRUNNING_ON_BOTH_CORES == 1 )
+    static void prvStartSchedulerOnCore1( void )
+    {
+        /* As on core 0, interrupts remain disabled until the first task is
+         * started. */
+        portDISABLE_INTERRUPTS();
+        prvSetupCore();
+        vPortStartFirstTask();
+    }
+#endif /* portRUNNING_ON_BOTH_CORES */
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+BaseType_t xPortStartScheduler( void )
+{
+    #if ( portRUNNING_ON_BOTH_CORES == 1 )
+        /* The kernel has already given each core an idle task to start.  Core
+         * 0 takes the tick interrupt, so must be the core starting the
+         * scheduler.  Core 1 is launched before core 0 enables its FIFO
+         * interrupt, as launching it uses the FIFO. */
+        configASSERT( get_core_num() == 0 );
+        multicore_reset_core1();
+        multicore_launch_core1( prvStartSchedulerOnCore1 );
+    #else
+        ucLaunchCoreNum = get_core_num();
+    #endif /* portRUNNING_ON_BOTH_CORES */
+
+    prvSetupCore();
+
     /* Start the timer that generates the tick ISR.  Interrupts are disabled
      * here already. */
     vPortSetupTimerInterrupt();
 
-    /* Initialise the critical nesting count ready for the first task. */
-    uxCriticalNesting = 0;
-
-    ucLaunchCoreNum = get_core_num();
-    #if (LIB_PICO_MULTICORE == 1)
-        #if ( configSUPPORT_PICO_SYNC_INTEROP == 1)
-            multicore_fifo_clear_irq();
-            multicore_fifo_drain();
-            uint32_t irq_num = 15 + get_core_num();
-            irq_set_priority( irq_num, portMIN_INTERRUPT_PRIORITY );
-            irq_set_exclusive_handler( irq_num, prvFIFOInterruptHandler );
-            irq_set_enabled( irq_num, 1 );
-        #endif
+    #if ( portRUNNING_ON_BOTH_CORES == 0 )
+        /* Initialise the critical nesting count ready for the first task. */
+        uxCriticalNesting = 0;
     #endif
 
     /* Start the first task. */
@@ -286,7 +387,11 @@ BaseType_t xPortStartScheduler( void )
      * functionality by defining configTASK_RETURN_ADDRESS.  Call
      * vTaskSwitchContext() so link time optimisation does not remove the
      * symbol. */
-    vTaskSwitchContext();
+    #if ( portRUNNING_ON_BOTH_CORES == 1 )
+        vTaskSwitchContext( portGET_CORE_ID() );
+    #else
+        vTaskSwitchContext();
+    #endif
     prvTaskExitError();
 
     /* Should not get here! */
@@ -306,7 +411,7 @@ void vPortYield( void )
     #if ( configSUPPORT_PICO_SYNC_INTEROP == 1 )
         /* We are not in an ISR, and pxYieldSpinLock is always dealt with and
          * cleared interrupts are re-enabled, so should be NULL */
-        configASSERT( pxYieldSpinLock == NULL );
+        configASSERT( pxYieldSpinLock[ portGET_CORE_ID() ] == NULL );
     #endif /* configSUPPORT_PICO_SYNC_INTEROP */
 
     /* Set a PendSV to request a context switch. */
@@ -320,31 +425,94 @@ void vPortYield( void )
 
 /*-----------------------------------------------------------*/
 
-void vPortEnterCritical( void )
-{
-    portDISABLE_INTERRUPTS();
-    uxCriticalNesting++;
-    __asm volatile ( "dsb" ::: "memory" );
-    __asm volatile ( "isb" );
-}
+#if ( portRUNNING_ON_BOTH_CORES == 1 )
+    void vPortYieldCore( BaseType_t xCoreID )
+    {
+        /* The kernel only uses this to interrupt the other core. */
+        configASSERT( xCoreID != ( BaseType_t ) portGET_CORE_ID() );
+        ( void ) xCoreID;
+
+        /* Make the scheduler's updates visible before the other core takes
+         * the interrupt.  The write does not block: if the FIFO is full then
+         * the other core already has its FIFO interrupt pending. */
+        __mem_fence_release();
+        sio_hw->fifo_wr = 0;
+    }
 /*-----------------------------------------------------------*/
 
-void vPortExitCritical( void )
-{
-    configASSERT( uxCriticalNesting );
-    uxCriticalNesting--;
-    if( uxCriticalNesting == 0 )
+    void vPortRecursiveLock( uint32_t ulLockNum, uint32_t ulSpinLockNum, BaseType_t xAcquire )
     {
-        portENABLE_INTERRUPTS();
+        /* Reading a hardware spin lock claims it, returning zero if it was
+         * already claimed.  Writing any value releases it. */
+        spin_lock_t * const pxSpinLock = spin_lock_instance( ulSpinLockNum );
+        const uint32_t ulCoreNum = get_core_num();
+        const uint8_t ucLockBit = ( uint8_t ) ( 1u << ulLockNum );
+
+        /* Called with interrupts disabled, so the ownership recorded for this
+         * core cannot change while it is being checked. */
+        if( xAcquire != pdFALSE )
+        {
+            if( __builtin_expect( !*pxSpinLock, 0 ) )
+            {
+                if( ( ucOwnedByCore[ ulCoreNum ] & ucLockBit ) != 0 )
+                {
+                    configASSERT( ucRecursionCountByLock[ ulLockNum ] != 255u );
+                    ucRecursionCountByLock[ ulLockNum ]++;
+                    return;
+                }
+
+                while( __builtin_expect( !*pxSpinLock, 0 ) )
+                {
+                }
+            }
+
+            __mem_fence_acquire();
+            configASSERT( ucRecursionCountByLock[ ulLockNum ] == 0 );
+            ucRecursionCountByLock[ ulLockNum ] = 1;
+            ucOwnedByCore[ ulCoreNum ] |= ucLockBit;
+        }
+        else
+        {
+            configASSERT( ( ucOwnedByCore[ ulCoreNum ] & ucLockBit ) != 0 );
+            configASSERT( ucRecursionCountByLock[ ulLockNum ] != 0 );
+
+            if( --ucRecursionCountByLock[ ulLockNum ] == 0 )
+            {
+                ucOwnedByCore[ ulCoreNum ] &= ( uint8_t ) ~ucLockBit;
+                __mem_fence_release();
+                *pxSpinLock = 1;
+            }
+        }
     }
-}
+#else /* portRUNNING_ON_BOTH_CORES */
+    void vPortEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+        uxCriticalNesting++;
+        __asm volatile ( "dsb" ::: "memory" );
+        __asm volatile ( "isb" );
+    }
+/*-----------------------------------------------------------*/
+
+    void vPortExitCritical( void )
+    {
+        configASSERT( uxCriticalNesting );
+        uxCriticalNesting--;
+        if( uxCriticalNesting == 0 )
+        {
+            portENABLE_INTERRUPTS();
+        }
+    }
+#endif /* portRUNNING_ON_BOTH_CORES */
 
 void vPortEnableInterrupts() {
     #if ( configSUPPORT_PICO_SYNC_INTEROP == 1 )
-        if( pxYieldSpinLock )
+        const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+        if( pxYieldSpinLock[ xCoreID ] )
         {
-            spin_unlock(pxYieldSpinLock, ulYieldSpinLockSaveValue);
-            pxYieldSpinLock = NULL;
+            spin_lock_t * const pxToRelease = pxYieldSpinLock[ xCoreID ];
+            pxYieldSpinLock[ xCoreID ] = NULL;
+            spin_unlock( pxToRelease, ulYieldSpinLockSaveValue[ xCoreID ] );
         }
     #endif
     __asm volatile ( " cpsie i " ::: "memory" );
@@ -382,7 +550,15 @@ void xPortPendSVHandler( void )
         "   .syntax unified                     \n"
         "   mrs r0, psp                         \n"
         "                                       \n"
-        "   ldr r3, pxCurrentTCBConst2          \n"/* Get the location of the current TCB. */
+        #if ( portRUNNING_ON_BOTH_CORES == 1 )
+            "   adr r3, ulAsmLocals2            \n"/* Get the location of the current TCB for this core. */
+            "   ldmia r3!, {r1, r2}             \n"
+            "   ldr r1, [r1]                    \n"/* r1 = core number. */
+            "   lsls r1, r1, #2                 \n"
+            "   adds r3, r2, r1                 \n"/* r3 = &pxCurrentTCBs[ core ]. */
+        #else
+            "   ldr r3, pxCurrentTCBConst2      \n"/* Get the location of the current TCB. */
+        #endif /* portRUNNING_ON_BOTH_CORES */
         "   ldr r2, [r3]                        \n"
         "                                       \n"
         "   subs r0, r0, #32                    \n"/* Make space for the remaining low registers. */
@@ -418,6 +594,10 @@ void xPortPendSVHandler( void )
         #endif /* portUSE_DIVIDER_SAVE_RESTORE */
         "   push {r3, r14}                      \n"
         "   cpsid i                             \n"
+        #if ( portRUNNING_ON_BOTH_CORES == 1 )
+            "   ldr r0, ulAsmLocals2            \n"/* Pass the core number to vTaskSwitchContext(). */
+            "   ldr r0, [r0]                    \n"
+        #endif /* portRUNNING_ON_BOTH_CORES */
         "   bl vTaskSwitchContext               \n"
         "   cpsie i                             \n"
         "   pop {r2, r3}                        \n"/* lr goes in r3. r2 now holds tcb pointer. */
@@ -453,7 +633,13 @@ void xPortPendSVHandler( void )
         "                                       \n"
         "   bx r3                               \n"
     "   .align 4                            \n"
-    "pxCurrentTCBConst2: .word pxCurrentTCB \n"
+    #if ( portRUNNING_ON_BOTH_CORES == 1 )
+        "ulAsmLocals2:                      \n"
+        "   .word 0xd0000000                \n"/* SIO_BASE + SIO_CPUID_OFFSET */
+        "   .word pxCurrentTCBs             \n"
+    #else
+        "pxCurrentTCBConst2: .word pxCurrentTCB \n"
+    #endif /* portRUNNING_ON_BOTH_CORES */
     );
 }
 /*-----------------------------------------------------------*/
@@ -736,14 +922,15 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
         }
         else
         {
-            configASSERT( pxYieldSpinLock == NULL );
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+            configASSERT( pxYieldSpinLock[ xCoreID ] == NULL );
 
             // we want to hold the lock until the event bits have been set; since interrupts are currently disabled
             // by the spinlock, we can defer until portENABLE_INTERRUPTS is called which is always called when
             // the scheduler is unlocked during this call
             configASSERT(pxLock->spin_lock);
-            pxYieldSpinLock = pxLock->spin_lock;
-            ulYieldSpinLockSaveValue = ulSave;
+            pxYieldSpinLock[ xCoreID ] = pxLock->spin_lock;
+            ulYieldSpinLockSaveValue[ xCoreID ] = ulSave;
             xEventGroupWaitBits( xEventGroup, prvGetEventGroupBit(pxLock->spin_lock),
                                  pdTRUE, pdFALSE, portMAX_DELAY);
         }
@@ -771,7 +958,7 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
         else
         {
             __sev();
-            #if ( LIB_PICO_MULTICORE == 1)
+            #if portUSE_CROSS_CORE_EVENTS
                 /* We could sent the bits across the FIFO which would have required us to block here if the FIFO was full,
                  * or we could have just set all bits on the other side, however it seems reasonable instead to take
                  * the hit of another spin lock to protect an accurate bit set. */
@@ -787,7 +974,7 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
                 }
                 /* This causes fifo irq on the other (FreeRTOS) core which will do the set the event bits */
                 sio_hw->fifo_wr = 0;
-            #endif /* LIB_PICO_MULTICORE */
+            #endif /* portUSE_CROSS_CORE_EVENTS */
             spin_unlock(pxLock->spin_lock, ulSave);
         }
     }
@@ -803,7 +990,8 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
         }
         else
         {
-            configASSERT( pxYieldSpinLock == NULL );
+            const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+            configASSERT( pxYieldSpinLock[ xCoreID ] == NULL );
 
             TickType_t uxTicksToWait = prvGetTicksToWaitBefore( uxUntil );
             if( uxTicksToWait )
@@ -812,14 +1000,14 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
                  * by the spinlock, we can defer until portENABLE_INTERRUPTS is called which is always called when
                  * the scheduler is unlocked during this call */
                 configASSERT(pxLock->spin_lock);
-                pxYieldSpinLock = pxLock->spin_lock;
-                ulYieldSpinLockSaveValue = ulSave;
+                pxYieldSpinLock[ xCoreID ] = pxLock->spin_lock;
+                ulYieldSpinLockSaveValue[ xCoreID ] = ulSave;
                 xEventGroupWaitBits( xEventGroup,
                                      prvGetEventGroupBit(pxLock->spin_lock), pdTRUE,
                                      pdFALSE, uxTicksToWait );
                 /* sanity check that interrupts were disabled, then re-enabled during the call, which will have
                  * taken care of the yield */
-                configASSERT( pxYieldSpinLock == NULL );
+                configASSERT( pxYieldSpinLock[ xCoreID ] == NULL );
             }
             else
             {
@@ -845,9 +1033,9 @@ __attribute__( ( weak ) ) void vPortSetupTimerInterrupt( void )
         {
             /* This must be done even before the scheduler is started, as the spin lock
              * is used by the overrides of the SDK wait/notify primitives */
-            #if ( LIB_PICO_MULTICORE == 1 )
+            #if portUSE_CROSS_CORE_EVENTS
                 pxCrossCoreSpinLock = spin_lock_instance( next_striped_spin_lock_num() );
-            #endif /* portRUNNING_ON_BOTH_CORES */
+            #endif /* portUSE_CROSS_CORE_EVENTS */
 
             /* The event group is not used prior to scheduler init, but is initialized
              * here to since it logically belongs with the spin lock */
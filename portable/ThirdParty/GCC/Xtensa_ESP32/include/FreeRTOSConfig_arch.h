@@ -131,4 +131,17 @@ extern uint32_t port_switch_flag[];
 #endif
 #endif
 
+/* configSYSTICK_TICK_CORE_ONLY == 1 means only core configTICK_CORE takes the tick interrupt and calls
+   xTaskIncrementTick(). The other cores do not enable a tick interrupt. Instead the tick core sends them a
+   cross-core yield each tick so that time slicing continues, and they no longer contend with it for the kernel's
+   tick processing at the same instant. With 0, every core takes the tick, and when the tick comes from the
+   SYSTIMER the alarms of the cores are spread evenly across the tick period. */
+#ifndef configSYSTICK_TICK_CORE_ONLY
+#define configSYSTICK_TICK_CORE_ONLY                    0
+#endif
+
+#ifndef configTICK_CORE
+#define configTICK_CORE                                 0
+#endif
+
 #endif // FREERTOS_CONFIG_XTENSA_H
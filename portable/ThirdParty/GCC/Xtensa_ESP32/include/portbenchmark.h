@@ -33,6 +33,10 @@
  * In order to enable it, set configBENCHMARK to 1 in FreeRTOSConfig.h.
  * You will also need to download the FreeRTOS_trace patch that contains
  * portbenchmark.c and the complete version of portbenchmark.h
+ *
+ * The kernel's own benchmark layer, enabled by setting
+ * configUSE_BENCHMARK_HOOKS to 1, reports the same metrics on every port
+ * without the patch - see include/benchmark_hooks.h.
  */
 
 #ifndef PORTBENCHMARK_H
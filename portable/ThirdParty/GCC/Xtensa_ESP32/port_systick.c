@@ -26,6 +26,17 @@
 
 BaseType_t xPortSysTickHandler(void);
 
+#if !CONFIG_FREERTOS_UNICORE && configSYSTICK_TICK_CORE_ONLY
+_Static_assert(configTICK_CORE < portNUM_PROCESSORS, "configTICK_CORE must be the ID of a core running FreeRTOS");
+
+extern volatile unsigned port_xSchedulerRunning[portNUM_PROCESSORS];
+
+/* True if the calling core takes the tick interrupt */
+#define SYSTICK_ON_THIS_CORE(cpuid)     ((cpuid) == configTICK_CORE)
+#else
+#define SYSTICK_ON_THIS_CORE(cpuid)     (true)
+#endif
+
 #ifdef CONFIG_FREERTOS_SYSTICK_USES_CCOUNT
 extern void _frxt_tick_timer_init(void);
 extern void _xt_tick_divisor_init(void);
@@ -43,6 +54,12 @@ extern void _xt_tick_divisor_init(void);
  */
 void vPortSetupTimer(void)
 {
+    /* Each core's CCOUNT runs independently from when the core started, so the
+     * phases of the cores' ticks cannot be staggered deliberately here. */
+    if (!SYSTICK_ON_THIS_CORE(xPortGetCoreID())) {
+        return;
+    }
+
     /* Init the tick divisor value */
     _xt_tick_divisor_init();
 
@@ -63,9 +80,11 @@ static uint32_t s_handled_systicks[portNUM_PROCESSORS] = { 0 };
 /**
  * @brief Set up the systimer peripheral to generate the tick interrupt
  *
- * Both timer alarms are configured in periodic mode.
- * It is done at the same time so SysTicks for both CPUs occur at the same time or very close.
- * Shifts a time of triggering interrupts for core 0 and core 1.
+ * The timer alarms of all cores are configured in periodic mode at the same time.
+ * The alarm of each core is shifted by period / portNUM_PROCESSORS from that of
+ * the previous core, so the cores do not process their ticks at the same instant.
+ * With configSYSTICK_TICK_CORE_ONLY only the alarm of configTICK_CORE raises an
+ * interrupt.
  */
 void vPortSetupTimer(void)
 {
@@ -78,7 +97,9 @@ void vPortSetupTimer(void)
     /* Systimer HAL layer object */
     static systimer_hal_context_t systimer_hal;
     /* set system timer interrupt vector */
-    ESP_ERROR_CHECK(esp_intr_alloc(ETS_SYSTIMER_TARGET0_EDGE_INTR_SOURCE + cpuid, ESP_INTR_FLAG_IRAM | level, SysTickIsrHandler, &systimer_hal, NULL));
+    if (SYSTICK_ON_THIS_CORE(cpuid)) {
+        ESP_ERROR_CHECK(esp_intr_alloc(ETS_SYSTIMER_TARGET0_EDGE_INTR_SOURCE + cpuid, ESP_INTR_FLAG_IRAM | level, SysTickIsrHandler, &systimer_hal, NULL));
+    }
 
     if (cpuid == 0) {
         systimer_hal_init(&systimer_hal);
@@ -98,15 +119,19 @@ void vPortSetupTimer(void)
             systimer_hal_select_alarm_mode(&systimer_hal, alarm_id, SYSTIMER_ALARM_MODE_PERIOD);
             systimer_hal_counter_can_stall_by_cpu(&systimer_hal, SYSTIMER_LL_COUNTER_OS_TICK, cpuid, true);
             if (cpuid == 0) {
-                systimer_hal_enable_alarm_int(&systimer_hal, alarm_id);
+                if (SYSTICK_ON_THIS_CORE(cpuid)) {
+                    systimer_hal_enable_alarm_int(&systimer_hal, alarm_id);
+                }
                 systimer_hal_enable_counter(&systimer_hal, SYSTIMER_LL_COUNTER_OS_TICK);
+            }
 #ifndef CONFIG_FREERTOS_UNICORE
-                // SysTick of core 0 and core 1 are shifted by half of period
-                systimer_hal_counter_value_advance(&systimer_hal, SYSTIMER_LL_COUNTER_OS_TICK, 1000000UL / CONFIG_FREERTOS_HZ / 2);
-#endif
+            // SysTick of each core is shifted from the previous core's by an equal share of the period
+            if (cpuid + 1 < portNUM_PROCESSORS) {
+                systimer_hal_counter_value_advance(&systimer_hal, SYSTIMER_LL_COUNTER_OS_TICK, 1000000UL / CONFIG_FREERTOS_HZ / portNUM_PROCESSORS);
             }
+#endif
         }
-    } else {
+    } else if (SYSTICK_ON_THIS_CORE(cpuid)) {
         uint32_t alarm_id = SYSTIMER_LL_ALARM_OS_TICK_CORE0 + cpuid;
         systimer_hal_enable_alarm_int(&systimer_hal, alarm_id);
     }
@@ -163,8 +188,19 @@ IRAM_ATTR void SysTickIsrHandler(void *arg)
 BaseType_t xPortSysTickHandler(void)
 {
     portbenchmarkIntLatency();
+    traceBENCHMARK_ISR_ENTER();
     traceISR_ENTER(SYSTICK_INTR_ID);
     BaseType_t ret = xTaskIncrementTick();
+#if !CONFIG_FREERTOS_UNICORE && configSYSTICK_TICK_CORE_ONLY && ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 )
+    /* The other cores take no tick of their own, so ask them to yield to give
+     * tasks of equal priority their time slice. */
+    for (BaseType_t xCoreID = 0; xCoreID < portNUM_PROCESSORS; xCoreID++) {
+        if (xCoreID != configTICK_CORE && port_xSchedulerRunning[xCoreID]) {
+            vPortYieldOtherCore(xCoreID);
+        }
+    }
+#endif
+    traceBENCHMARK_ISR_EXIT();
     if(ret != pdFALSE) {
         portYIELD_FROM_ISR();
     } else {
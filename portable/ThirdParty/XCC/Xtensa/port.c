@@ -170,6 +170,7 @@ BaseType_t xPortSysTickHandler( void )
     uint32_t interruptMask;
 
     portbenchmarkIntLatency();
+    traceBENCHMARK_ISR_ENTER();
 
     /* Interrupts upto configMAX_SYSCALL_INTERRUPT_PRIORITY must be
      * disabled before calling xTaskIncrementTick as it access the
@@ -180,6 +181,8 @@ BaseType_t xPortSysTickHandler( void )
     }
     portCLEAR_INTERRUPT_MASK_FROM_ISR( interruptMask );
 
+    traceBENCHMARK_ISR_EXIT();
+
     portYIELD_FROM_ISR( ret );
 
     return ret;
@@ -0,0 +1,472 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "post_mortem.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the post-mortem snapshot.  This #if is closed at the very bottom
+ * of this file. */
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+/* The most bytes passed to the write function at once. */
+    #define pmSTAGE_SIZE    ( ( size_t ) 32U )
+
+/*
+ * The state of a snapshot being written.  Bytes are collected in ucStage and
+ * passed to pxWrite when it fills, so the write function is not called for
+ * every byte.  The checksum is a Fletcher-16 of every byte written.
+ */
+    typedef struct PostMortemWriter
+    {
+        PostMortemWriteFunction_t pxWrite;
+        void * pvContext;
+        size_t xTotalLength;                   /*< The number of bytes written so far. */
+        size_t xStaged;                        /*< The number of bytes in ucStage. */
+        uint16_t usSum1;
+        uint16_t usSum2;
+        uint64_t ullPreviousBlock;             /*< The address of the last free block written. */
+        UBaseType_t uxFreeBlocks;              /*< The number of free blocks written. */
+        uint8_t ucStage[ pmSTAGE_SIZE ];
+    } PostMortemWriter_t;
+
+/*
+ * The context of the write function used by xPostMortemCapture().
+ */
+    typedef struct PostMortemBuffer
+    {
+        uint8_t * pucBuffer;
+        size_t xLength;
+        size_t xUsed;
+    } PostMortemBuffer_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Add one byte to the snapshot.
+ */
+    static void prvWriteByte( PostMortemWriter_t * pxWriter,
+                              uint8_t ucByte ) PRIVILEGED_FUNCTION;
+
+/*
+ * Pass any staged bytes to the write function.
+ */
+    static void prvFlush( PostMortemWriter_t * pxWriter ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add an unsigned LEB128 integer to the snapshot.
+ */
+    static void prvWriteVarint( PostMortemWriter_t * pxWriter,
+                                uint64_t ullValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Add a name, truncated to configMAX_TASK_NAME_LEN characters, to the
+ * snapshot.
+ */
+    static void prvWriteName( PostMortemWriter_t * pxWriter,
+                              const char * pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+/*
+ * The functions called for each task, queue and free block.
+ */
+    static void prvWriteTask( const TaskWalkInfo_t * pxInfo,
+                              void * pvContext ) PRIVILEGED_FUNCTION;
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        static void prvWriteQueue( const QueueWalkInfo_t * pxInfo,
+                                   void * pvContext ) PRIVILEGED_FUNCTION;
+    #endif
+
+    #if ( configPOST_MORTEM_MAX_FREE_BLOCKS > 0 )
+        static BaseType_t prvWriteFreeBlock( const void * pvBlock,
+                                             size_t xBlockSize,
+                                             void * pvContext ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Writes the whole snapshot, returning its length.
+ */
+    static size_t prvCapture( const void * pvUserData,
+                              size_t xUserDataLength,
+                              PostMortemWriter_t * pxWriter ) PRIVILEGED_FUNCTION;
+
+/*
+ * The write function used by xPostMortemCapture().
+ */
+    static void prvWriteToBuffer( const uint8_t * pucData,
+                                  size_t xLength,
+                                  void * pvContext ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static void prvWriteByte( PostMortemWriter_t * pxWriter,
+                              uint8_t ucByte )
+    {
+        pxWriter->usSum1 = ( uint16_t ) ( ( pxWriter->usSum1 + ( uint16_t ) ucByte ) % 255U );
+        pxWriter->usSum2 = ( uint16_t ) ( ( pxWriter->usSum2 + pxWriter->usSum1 ) % 255U );
+        pxWriter->ucStage[ pxWriter->xStaged ] = ucByte;
+        pxWriter->xStaged++;
+        pxWriter->xTotalLength++;
+
+        if( pxWriter->xStaged == pmSTAGE_SIZE )
+        {
+            prvFlush( pxWriter );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvFlush( PostMortemWriter_t * pxWriter )
+    {
+        if( pxWriter->xStaged > ( size_t ) 0U )
+        {
+            pxWriter->pxWrite( pxWriter->ucStage, pxWriter->xStaged, pxWriter->pvContext );
+            pxWriter->xStaged = 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWriteVarint( PostMortemWriter_t * pxWriter,
+                                uint64_t ullValue )
+    {
+        while( ullValue > ( uint64_t ) 0x7FU )
+        {
+            prvWriteByte( pxWriter, ( uint8_t ) ( ( ullValue & ( uint64_t ) 0x7FU ) | ( uint64_t ) 0x80U ) );
+            ullValue >>= 7;
+        }
+
+        prvWriteByte( pxWriter, ( uint8_t ) ullValue );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWriteName( PostMortemWriter_t * pxWriter,
+                              const char * pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        size_t xLength = 0;
+        size_t x;
+
+        if( pcName != NULL )
+        {
+            while( ( xLength < ( size_t ) configMAX_TASK_NAME_LEN ) && ( pcName[ xLength ] != ( char ) 0x00 ) )
+            {
+                xLength++;
+            }
+        }
+
+        prvWriteVarint( pxWriter, ( uint64_t ) xLength );
+
+        for( x = 0; x < xLength; x++ )
+        {
+            prvWriteByte( pxWriter, ( uint8_t ) pcName[ x ] );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWriteTask( const TaskWalkInfo_t * pxInfo,
+                              void * pvContext )
+    {
+        PostMortemWriter_t * pxWriter = ( PostMortemWriter_t * ) pvContext;
+        UBaseType_t ux;
+
+        prvWriteByte( pxWriter, pmTAG_TASK );
+        prvWriteVarint( pxWriter, ( uint64_t ) ( portPOINTER_SIZE_TYPE ) pxInfo->xHandle );
+        prvWriteName( pxWriter, pxInfo->pcTaskName );
+        prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->eCurrentState );
+        prvWriteVarint( pxWriter, ( uint64_t ) ( pxInfo->xRunningOnCore + 1 ) );
+        prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->uxCurrentPriority );
+        prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->uxBasePriority );
+        prvWriteVarint( pxWriter, ( uint64_t ) ( portPOINTER_SIZE_TYPE ) pxInfo->pxTopOfStack );
+        prvWriteVarint( pxWriter, ( uint64_t ) ( portPOINTER_SIZE_TYPE ) pxInfo->pxStackBase );
+        prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->uxStackWindowWords );
+
+        for( ux = 0; ux < pxInfo->uxStackWindowWords; ux++ )
+        {
+            prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->pxStackWindow[ ux ] );
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+
+        static void prvWriteQueue( const QueueWalkInfo_t * pxInfo,
+                                   void * pvContext )
+        {
+            PostMortemWriter_t * pxWriter = ( PostMortemWriter_t * ) pvContext;
+
+            prvWriteByte( pxWriter, pmTAG_QUEUE );
+            prvWriteVarint( pxWriter, ( uint64_t ) ( portPOINTER_SIZE_TYPE ) pxInfo->xHandle );
+            prvWriteName( pxWriter, pxInfo->pcQueueName );
+            prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->uxMessagesWaiting );
+            prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->uxLength );
+            prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->uxItemSize );
+            prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->uxTasksWaitingToSend );
+            prvWriteVarint( pxWriter, ( uint64_t ) pxInfo->uxTasksWaitingToReceive );
+        }
+
+    #endif /* configQUEUE_REGISTRY_SIZE */
+/*-----------------------------------------------------------*/
+
+    #if ( configPOST_MORTEM_MAX_FREE_BLOCKS > 0 )
+
+        static BaseType_t prvWriteFreeBlock( const void * pvBlock,
+                                             size_t xBlockSize,
+                                             void * pvContext )
+        {
+            PostMortemWriter_t * pxWriter = ( PostMortemWriter_t * ) pvContext;
+            uint64_t ullAddress = ( uint64_t ) ( portPOINTER_SIZE_TYPE ) pvBlock;
+            uint64_t ullDifference;
+            BaseType_t xReturn = pdTRUE;
+
+            if( pxWriter->uxFreeBlocks < ( UBaseType_t ) configPOST_MORTEM_MAX_FREE_BLOCKS )
+            {
+                /* Zigzag encode the difference, so blocks just before the
+                 * previous one are written in as few bytes as those just
+                 * after it. */
+                ullDifference = ullAddress - pxWriter->ullPreviousBlock;
+
+                if( ( ullDifference & ( ( uint64_t ) 1U << 63 ) ) != ( uint64_t ) 0U )
+                {
+                    ullDifference = ( ( ~ullDifference ) << 1 ) | ( uint64_t ) 1U;
+                }
+                else
+                {
+                    ullDifference <<= 1;
+                }
+
+                prvWriteByte( pxWriter, pmTAG_FREE_BLOCK );
+                prvWriteVarint( pxWriter, ullDifference );
+                prvWriteVarint( pxWriter, ( uint64_t ) xBlockSize );
+
+                pxWriter->ullPreviousBlock = ullAddress;
+                pxWriter->uxFreeBlocks++;
+            }
+            else
+            {
+                prvWriteByte( pxWriter, pmTAG_HEAP_MORE );
+                xReturn = pdFALSE;
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configPOST_MORTEM_MAX_FREE_BLOCKS */
+/*-----------------------------------------------------------*/
+
+    static size_t prvCapture( const void * pvUserData,
+                              size_t xUserDataLength,
+                              PostMortemWriter_t * pxWriter )
+    {
+        TaskKernelState_t xKernelState;
+        uint16_t usChecksum;
+        size_t x;
+        BaseType_t xCoreID;
+
+        #if ( configUSE_TRACE_RECORDER == 1 )
+            const TraceRecord_t * pxRecord;
+            UBaseType_t uxAge;
+            uint32_t ulPreviousTimestamp;
+        #endif
+
+        pxWriter->xTotalLength = 0;
+        pxWriter->xStaged = 0;
+        pxWriter->usSum1 = 0;
+        pxWriter->usSum2 = 0;
+        pxWriter->ullPreviousBlock = 0;
+        pxWriter->uxFreeBlocks = 0;
+
+        prvWriteByte( pxWriter, ( uint8_t ) 'F' );
+        prvWriteByte( pxWriter, ( uint8_t ) 'R' );
+        prvWriteByte( pxWriter, ( uint8_t ) 'P' );
+        prvWriteByte( pxWriter, ( uint8_t ) 'M' );
+        prvWriteByte( pxWriter, pmVERSION );
+        prvWriteByte( pxWriter, ( uint8_t ) sizeof( StackType_t ) );
+
+        vTaskGetKernelState( &xKernelState );
+        prvWriteByte( pxWriter, pmTAG_KERNEL );
+        prvWriteVarint( pxWriter, ( uint64_t ) xKernelState.xTickCount );
+        prvWriteVarint( pxWriter, ( uint64_t ) xKernelState.uxNumberOfTasks );
+        prvWriteVarint( pxWriter, ( uint64_t ) xKernelState.xSchedulerState );
+        prvWriteVarint( pxWriter, ( uint64_t ) xKernelState.uxTopReadyPriority );
+        prvWriteVarint( pxWriter, ( uint64_t ) configNUMBER_OF_CORES );
+
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            prvWriteVarint( pxWriter, ( uint64_t ) ( portPOINTER_SIZE_TYPE ) xKernelState.xCurrentTasks[ xCoreID ] );
+        }
+
+        vTaskWalkTasks( prvWriteTask, pxWriter );
+
+        #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        {
+            vQueueWalkRegistry( prvWriteQueue, pxWriter );
+        }
+        #endif
+
+        #if ( configPOST_MORTEM_MAX_FREE_BLOCKS > 0 )
+        {
+            vPortWalkFreeBlocks( prvWriteFreeBlock, pxWriter );
+        }
+        #endif
+
+        #if ( configUSE_TRACE_RECORDER == 1 )
+        {
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                ulPreviousTimestamp = 0U;
+
+                /* Oldest first, so the timestamp differences are positive. */
+                for( uxAge = ( UBaseType_t ) configPOST_MORTEM_TRACE_RECORDS; uxAge > ( UBaseType_t ) 0U; uxAge-- )
+                {
+                    pxRecord = pxTraceRecorderGetRecentRecord( xCoreID, uxAge - ( UBaseType_t ) 1U );
+
+                    if( pxRecord != NULL )
+                    {
+                        prvWriteByte( pxWriter, pmTAG_TRACE );
+                        prvWriteVarint( pxWriter, ( uint64_t ) xCoreID );
+                        prvWriteVarint( pxWriter, ( uint64_t ) ( uint32_t ) ( pxRecord->ulTimestamp - ulPreviousTimestamp ) );
+                        prvWriteVarint( pxWriter, ( uint64_t ) pxRecord->ucEventID );
+                        prvWriteVarint( pxWriter, ( uint64_t ) pxRecord->ulObject );
+                        prvWriteVarint( pxWriter, ( uint64_t ) pxRecord->ulValue );
+                        prvWriteVarint( pxWriter, ( uint64_t ) pxRecord->usSequence );
+                        ulPreviousTimestamp = pxRecord->ulTimestamp;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+        #endif /* configUSE_TRACE_RECORDER */
+
+        if( pvUserData != NULL )
+        {
+            prvWriteByte( pxWriter, pmTAG_USER );
+            prvWriteVarint( pxWriter, ( uint64_t ) xUserDataLength );
+
+            for( x = 0; x < xUserDataLength; x++ )
+            {
+                prvWriteByte( pxWriter, ( ( const uint8_t * ) pvUserData )[ x ] );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        prvWriteByte( pxWriter, pmTAG_END );
+
+        /* The checksum covers everything up to and including the end tag. */
+        usChecksum = ( uint16_t ) ( ( uint16_t ) ( pxWriter->usSum2 << 8 ) | pxWriter->usSum1 );
+        prvWriteByte( pxWriter, ( uint8_t ) ( usChecksum & 0xFFU ) );
+        prvWriteByte( pxWriter, ( uint8_t ) ( usChecksum >> 8 ) );
+        prvFlush( pxWriter );
+
+        return pxWriter->xTotalLength;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvWriteToBuffer( const uint8_t * pucData,
+                                  size_t xLength,
+                                  void * pvContext )
+    {
+        PostMortemBuffer_t * pxBuffer = ( PostMortemBuffer_t * ) pvContext;
+        size_t x;
+
+        /* Anything that does not fit is dropped, but still counted by the
+         * writer, so the caller can tell how large a buffer was needed. */
+        for( x = 0; ( x < xLength ) && ( pxBuffer->xUsed < pxBuffer->xLength ); x++ )
+        {
+            pxBuffer->pucBuffer[ pxBuffer->xUsed ] = pucData[ x ];
+            pxBuffer->xUsed++;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xPostMortemCapture( const void * pvUserData,
+                               size_t xUserDataLength,
+                               uint8_t * pucBuffer,
+                               size_t xBufferLength )
+    {
+        PostMortemWriter_t xWriter;
+        PostMortemBuffer_t xBuffer;
+
+        configASSERT( ( pucBuffer != NULL ) || ( xBufferLength == ( size_t ) 0U ) );
+
+        xBuffer.pucBuffer = pucBuffer;
+        xBuffer.xLength = xBufferLength;
+        xBuffer.xUsed = 0;
+
+        xWriter.pxWrite = prvWriteToBuffer;
+        xWriter.pvContext = &xBuffer;
+
+        return prvCapture( pvUserData, xUserDataLength, &xWriter );
+    }
+/*-----------------------------------------------------------*/
+
+    size_t xPostMortemCaptureToFunction( const void * pvUserData,
+                                         size_t xUserDataLength,
+                                         PostMortemWriteFunction_t pxWrite,
+                                         void * pvContext )
+    {
+        PostMortemWriter_t xWriter;
+
+        configASSERT( pxWrite != NULL );
+
+        xWriter.pxWrite = pxWrite;
+        xWriter.pvContext = pvContext;
+
+        return prvCapture( pvUserData, xUserDataLength, &xWriter );
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the post-mortem snapshot.  If you want to include it then ensure
+ * configUSE_POST_MORTEM_SNAPSHOT is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_POST_MORTEM_SNAPSHOT == 1 */
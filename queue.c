@@ -38,6 +38,14 @@
 #include "task.h"
 #include "queue.h"
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+    #include "object_registry.h"
+#endif
+
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+    #include "atomic.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -79,6 +87,122 @@ typedef struct SemaphoreData
 #define queueSEMAPHORE_QUEUE_ITEM_LENGTH    ( ( UBaseType_t ) 0 )
 #define queueMUTEX_GIVE_BLOCK_TIME          ( ( TickType_t ) 0U )
 
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/* Bits set in ucSlotsHeld while a task holds a slot of the queue storage
+ * obtained from xQueueAcquireSlot() or xQueuePeekSlot(). */
+    #define queueWRITE_SLOT_HELD    ( ( uint8_t ) 0x01U )
+    #define queueREAD_SLOT_HELD     ( ( uint8_t ) 0x02U )
+
+/* While the write slot is held, which is the slot at pcWriteTo, nothing else
+ * can be added to the queue.  While the read slot is held, which is the slot
+ * after pcReadFrom, nothing can be added to the front of the queue as that
+ * would move the held item away from the front, the oldest item cannot be
+ * dropped to make room, and nothing can be removed. */
+    #define queueCAN_SEND( pxQueue, xPosition )                                                                      \
+    ( ( ( ( pxQueue )->ucSlotsHeld & queueWRITE_SLOT_HELD ) == 0U ) &&                                               \
+      ( ( ( xPosition ) == queueSEND_TO_BACK ) ?                                                                     \
+        ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) :                                                 \
+        ( ( xPosition ) == queueOVERWRITE_OLDEST ) ?                                                                 \
+        ( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) ||                                              \
+          ( ( ( pxQueue )->ucSlotsHeld & queueREAD_SLOT_HELD ) == 0U ) ) :                                           \
+        ( ( ( ( pxQueue )->ucSlotsHeld & queueREAD_SLOT_HELD ) == 0U ) &&                                            \
+          ( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) || ( ( xPosition ) == queueOVERWRITE ) ) ) ) )
+    #define queueCAN_RECEIVE( pxQueue ) \
+    ( ( ( pxQueue )->uxMessagesWaiting > ( UBaseType_t ) 0 ) && ( ( ( pxQueue )->ucSlotsHeld & queueREAD_SLOT_HELD ) == 0U ) )
+#else
+    #define queueCAN_SEND( pxQueue, xPosition ) \
+    ( ( ( pxQueue )->uxMessagesWaiting < ( pxQueue )->uxLength ) || ( ( xPosition ) == queueOVERWRITE ) || ( ( xPosition ) == queueOVERWRITE_OLDEST ) )
+    #define queueCAN_RECEIVE( pxQueue )            ( ( pxQueue )->uxMessagesWaiting > ( UBaseType_t ) 0 )
+#endif /* configUSE_QUEUE_ZERO_COPY */
+
+#if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+
+/* A priority queue keeps each message priority's items in a FIFO list of
+ * storage slots, so items are added and removed in constant time.  The lists
+ * are held as uint8_t slot indexes in the bytes that follow the item storage
+ * (see queuePRIORITY_QUEUE_STORAGE_SIZE()), which limits the length of a
+ * priority queue to 254 items:
+ *  ucNext[ uxLength ] - the slot that follows each slot in its list.
+ *  ucHead[ configQUEUE_MESSAGE_PRIORITIES ] - the first slot of each list.
+ *  ucTail[ configQUEUE_MESSAGE_PRIORITIES ] - the last slot of each list.
+ *  ucFree - the first slot of the list of unused slots. */
+    #define queuePRIORITY_NO_SLOT                ( ( uint8_t ) 0xFFU )
+    #define queuePRIORITY_MAX_LENGTH             ( ( UBaseType_t ) 254U )
+    #define queueIS_PRIORITY_QUEUE( pxQueue )    ( ( pxQueue )->ucIsPriorityQueue != ( uint8_t ) pdFALSE )
+    #define queuePRIORITY_NEXT( pxQueue )        ( ( uint8_t * ) ( pxQueue )->u.xQueue.pcTail )
+    #define queuePRIORITY_HEAD( pxQueue )        ( queuePRIORITY_NEXT( pxQueue ) + ( pxQueue )->uxLength )
+    #define queuePRIORITY_TAIL( pxQueue )        ( queuePRIORITY_HEAD( pxQueue ) + configQUEUE_MESSAGE_PRIORITIES )
+    #define queuePRIORITY_FREE( pxQueue )        ( queuePRIORITY_TAIL( pxQueue ) + configQUEUE_MESSAGE_PRIORITIES )
+#else
+    #define queueIS_PRIORITY_QUEUE( pxQueue )    ( pdFALSE )
+#endif /* configQUEUE_MESSAGE_PRIORITIES */
+
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+/* A queue set's storage holds its members rather than events: the handles of
+ * the member queues and semaphores, followed by a bitmap with a bit set for
+ * each member that contains data, followed by the index at which the next
+ * search of the bitmap starts.  The set's uxMessagesWaiting is the number of
+ * bits set, so tasks block on the set exactly as they would on a queue.
+ * ucQueueSetIndex holds a member's index within its set's storage, or
+ * queueSET_INDEX_IS_SET if the queue is itself a queue set, which limits a
+ * set to 254 members. */
+    #define queueSET_INDEX_IS_SET                        ( ( uint8_t ) 0xFFU )
+    #define queueSET_MAX_MEMBERS                         ( ( UBaseType_t ) 254U )
+    #define queueSET_BITMAP_BYTES( uxLength )            ( ( ( uxLength ) + ( UBaseType_t ) 7U ) / ( UBaseType_t ) 8U )
+    #define queueSET_STORAGE_SIZE( uxLength )            ( ( ( uxLength ) * sizeof( Queue_t * ) ) + queueSET_BITMAP_BYTES( uxLength ) + ( UBaseType_t ) 1U )
+    #define queueIS_BITMAP_SET( pxQueue )                ( ( pxQueue )->ucQueueSetIndex == queueSET_INDEX_IS_SET )
+    #define queueSET_MEMBERS( pxQueue )                  ( ( Queue_t ** ) ( pxQueue )->pcHead )
+    #define queueSET_READY_BITS( pxQueue )               ( ( uint8_t * ) ( pxQueue )->u.xQueue.pcTail )
+    #define queueSET_NEXT_INDEX( pxQueue )               ( queueSET_READY_BITS( pxQueue ) + queueSET_BITMAP_BYTES( ( pxQueue )->uxLength ) )
+    #define queueSET_MEMBER_IS_READY( pxQueue, uxIndex ) ( ( queueSET_READY_BITS( pxQueue )[ ( uxIndex ) >> 3 ] & ( uint8_t ) ( 1U << ( ( uxIndex ) & 7U ) ) ) != 0U )
+
+/* Called after items have been removed from a queue.  A member that has
+ * become empty no longer counts as ready in its set. */
+    #define queueSET_MEMBER_RECEIVED( pxQueue )                                                                                  \
+    {                                                                                                                            \
+        if( ( ( pxQueue )->pxQueueSetContainer != NULL ) && ( ( pxQueue )->uxMessagesWaiting == ( UBaseType_t ) 0 ) )           \
+        {                                                                                                                        \
+            prvClearQueueSetMemberReady( pxQueue );                                                                              \
+        }                                                                                                                        \
+    }
+#else
+    #define queueSET_MEMBER_RECEIVED( pxQueue )
+#endif /* configUSE_QUEUE_SET_BITMAP */
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+/* queueRECORD_LEVEL() is called, from a critical section, just before the
+ * number of items in a queue changes to uxNewLevel.  The time a task spends
+ * blocked on a queue is measured from just before the scheduler is resumed,
+ * as the tick count cannot change while the scheduler is suspended, to when
+ * the task runs again. */
+    #define queueSTATS_SENDER                                                pdTRUE
+    #define queueSTATS_RECEIVER                                              pdFALSE
+    #define queueRECORD_LEVEL( pxQueue, uxNewLevel, uxSent, uxReceived )    prvRecordQueueLevel( ( pxQueue ), ( uxNewLevel ), ( uxSent ), ( uxReceived ) )
+    #define queueRECORD_SEND_FAILED( pxQueue )                               prvRecordQueueSendFailed( pxQueue )
+    #define queueRECORD_SEND_FAILED_FROM_ISR( pxQueue )                      ( ( pxQueue )->ulSendsFailed++ )
+    #define queueBLOCK_START( xBlockStart )                                  ( xBlockStart ) = xTaskGetTickCount()
+    #define queueBLOCK_END( pxQueue, xBlockStart, xSender )                  prvAddQueueBlockedTime( ( pxQueue ), ( xBlockStart ), ( xSender ) )
+#else
+    #define queueRECORD_LEVEL( pxQueue, uxNewLevel, uxSent, uxReceived )
+    #define queueRECORD_SEND_FAILED( pxQueue )
+    #define queueRECORD_SEND_FAILED_FROM_ISR( pxQueue )
+    #define queueBLOCK_START( xBlockStart )
+    #define queueBLOCK_END( pxQueue, xBlockStart, xSender )
+#endif /* configUSE_QUEUE_STATS */
+
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+
+/* Counts an item dropped because the queue was full.  Called from a critical
+ * section, so the count is only ever written by one core or interrupt at a
+ * time and can be read without one. */
+    #define queueRECORD_OVERFLOW( pxQueue )    ( ( pxQueue )->uxOverflowCount )++
+#else
+    #define queueRECORD_OVERFLOW( pxQueue )
+#endif /* configUSE_OVERFLOW_POLICY */
+
 #if ( configUSE_PREEMPTION == 0 )
 
 /* If the cooperative scheduler is being used then a yield should not be
@@ -88,6 +212,73 @@ typedef struct SemaphoreData
     #define queueYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
 #endif
 
+#if ( configUSE_QUEUE_WORD_COPY == 1 )
+    #define queueCOPY_BYTES( pvDestination, pvSource, xBytes )    prvCopyItem( ( pvDestination ), ( pvSource ), ( xBytes ) )
+#else
+    #define queueCOPY_BYTES( pvDestination, pvSource, xBytes )    configCOPY_BYTES( ( pvDestination ), ( pvSource ), ( xBytes ) )
+#endif
+
+/* Copies one item of pxQueue, with the fixed size copy function the queue was
+ * given by vQueueSetItemCopyFunction() if it has one. */
+#if ( configUSE_TYPED_QUEUES == 1 )
+    #define queueCOPY_ITEM( pxQueue, pvDestination, pvSource )                                          \
+    do {                                                                                                \
+        if( ( pxQueue )->pxCopyItem != NULL )                                                           \
+        {                                                                                               \
+            ( pxQueue )->pxCopyItem( ( pvDestination ), ( pvSource ) );                                 \
+        }                                                                                               \
+        else                                                                                            \
+        {                                                                                               \
+            queueCOPY_BYTES( ( pvDestination ), ( pvSource ), ( size_t ) ( pxQueue )->uxItemSize );     \
+        }                                                                                               \
+    } while( 0 )
+#else
+    #define queueCOPY_ITEM( pxQueue, pvDestination, pvSource )    queueCOPY_BYTES( ( pvDestination ), ( pvSource ), ( size_t ) ( pxQueue )->uxItemSize )
+#endif
+
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+/* A task blocking in xQueueReceive() records its buffer so a sender can copy
+ * the item straight into it, and checks whether one did once it runs again. */
+    #define queueSET_HANDOFF_BUFFER( pvBuffer )    vTaskSetHandoffBuffer( pvBuffer )
+    #define queueHANDOFF_RECEIVED()                xTaskEndHandoff()
+#else
+    #define queueSET_HANDOFF_BUFFER( pvBuffer )
+    #define queueHANDOFF_RECEIVED()                ( pdFALSE )
+#endif
+
+#if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+
+/* Tasks block on the event lists of a queue in priority order, or in the order
+ * in which they block if the queue's wait order is queueWAIT_ORDER_FIFO. */
+    #define queuePLACE_ON_EVENT_LIST( pxQueue, pxEventList, xTicksToWait )  \
+    do {                                                                    \
+        if( ( pxQueue )->ucWaitOrder == ( uint8_t ) queueWAIT_ORDER_FIFO )  \
+        {                                                                   \
+            vTaskPlaceOnEventListFifo( ( pxEventList ), ( xTicksToWait ) ); \
+        }                                                                   \
+        else                                                                \
+        {                                                                   \
+            vTaskPlaceOnEventList( ( pxEventList ), ( xTicksToWait ) );     \
+        }                                                                   \
+    } while( 0 )
+#else
+    #define queuePLACE_ON_EVENT_LIST( pxQueue, pxEventList, xTicksToWait )    vTaskPlaceOnEventList( ( pxEventList ), ( xTicksToWait ) )
+#endif
+
+#if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+
+/* A rendezvous channel is the only queue with a length of 0.  Having no
+ * storage, it holds an item only while the sending task is blocked on
+ * xTasksWaitingToSend with the item as its handoff buffer. */
+    #define queueIS_RENDEZVOUS( pxQueue )    ( ( pxQueue )->uxLength == ( UBaseType_t ) 0U )
+    #define queueIS_VALID_RENDEZVOUS( uxQueueLength, uxItemSize, ucQueueType ) \
+    ( ( ( uxQueueLength ) == ( UBaseType_t ) 0U ) && ( ( uxItemSize ) > ( UBaseType_t ) 0U ) && ( ( ucQueueType ) == queueQUEUE_TYPE_RENDEZVOUS ) )
+#else
+    #define queueIS_RENDEZVOUS( pxQueue )                                         ( pdFALSE )
+    #define queueIS_VALID_RENDEZVOUS( uxQueueLength, uxItemSize, ucQueueType )    ( pdFALSE )
+#endif
+
 /*
  * Definition of the queue used by the scheduler.
  * Items are queued by copy, not reference.  See the following link for the
@@ -114,6 +305,31 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
     volatile int8_t cRxLock;                /*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
     volatile int8_t cTxLock;                /*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        uint8_t ucSlotsHeld; /*< queueWRITE_SLOT_HELD and/or queueREAD_SLOT_HELD while a task is accessing the queue storage in place. */
+    #endif
+
+    #if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+        uint8_t ucIsPriorityQueue; /*< Set to pdTRUE if the queue was created by xQueueCreatePriority() so items are ordered by message priority. */
+    #endif
+
+    #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+        uint8_t ucQueueSetIndex; /*< The index of the queue within its queue set, or queueSET_INDEX_IS_SET if the queue is a queue set. */
+    #endif
+
+    #if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+        uint8_t ucWaitOrder; /*< queueWAIT_ORDER_PRIORITY or queueWAIT_ORDER_FIFO, as set by xQueueSetWaitOrder(). */
+    #endif
+
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+        uint8_t ucOverflowPolicy;             /*< queueOVERFLOW_DROP_NEWEST or queueOVERFLOW_DROP_OLDEST, as set by xQueueSetOverflowPolicy(). */
+        volatile UBaseType_t uxOverflowCount; /*< The number of items dropped because the queue was full. */
+    #endif
+
+    #if ( configUSE_TYPED_QUEUES == 1 )
+        QueueItemCopyFunction_t pxCopyItem; /*< Copies one item with a size known at compile time, as set by vQueueSetItemCopyFunction(), or NULL to copy uxItemSize bytes. */
+    #endif
+
     #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
         uint8_t ucStaticallyAllocated; /*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
     #endif
@@ -126,6 +342,29 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
         UBaseType_t uxQueueNumber;
         uint8_t ucQueueType;
     #endif
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        UBaseType_t uxMessagesWaitingHighWater; /*< The most items the queue has held since the statistics were reset. */
+        uint32_t ulItemsSent;                   /*< The number of items written to the queue. */
+        uint32_t ulItemsReceived;               /*< The number of items removed from the queue. */
+        uint32_t ulSendsFailed;                 /*< The number of writes that failed because the queue was full. */
+        uint32_t ulOccupancyTicks;              /*< The number of items in the queue summed over every tick, from which the average time an item spends in the queue is calculated. */
+        TickType_t xSendBlockedTicks;           /*< The total time tasks have spent blocked waiting to write to the queue. */
+        TickType_t xReceiveBlockedTicks;        /*< The total time tasks have spent blocked waiting to read from the queue. */
+        TickType_t xLastLevelChange;            /*< The tick count when uxMessagesWaiting last changed. */
+    #endif
+
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        UBaseType_t uxCeilingPriority; /*< The priority a task taking the mutex is raised to, or 0 if the mutex has no ceiling. */
+    #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        ObjectRegistryItem_t xRegistryItem; /*< Links the queue into the object registry. */
+    #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+        portSPINLOCK_TYPE xObjectLock; /*< Held while the queue's state is read or written, after the kernel's locks if those are held at all. */
+    #endif
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -169,21 +408,181 @@ typedef xQUEUE Queue_t;
  * to indicate that a task may require unblocking.  When the queue in unlocked
  * these lock counts are inspected, and the appropriate action taken.
  */
-static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+/*
+ * Functions that maintain the statistics returned by vQueueGetStats().
+ */
+    static void prvResetQueueStats( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvRecordQueueLevel( Queue_t * const pxQueue,
+                                     UBaseType_t uxNewLevel,
+                                     UBaseType_t uxItemsSent,
+                                     UBaseType_t uxItemsReceived ) PRIVILEGED_FUNCTION;
+    static void prvRecordQueueSendFailed( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvAddQueueBlockedTime( Queue_t * const pxQueue,
+                                        TickType_t xBlockStart,
+                                        BaseType_t xSender ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_QUEUE_STATS */
 
 /*
  * Uses a critical section to determine if there is any data in a queue.
  *
  * @return pdTRUE if the queue contains no items, otherwise pdFALSE.
  */
-static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+/*
+ * Lock, unlock, and check for data in, every queue referenced by the records
+ * passed to xQueueWaitForAny().
+ */
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+    static void prvLockWaitQueues( QueueWaitRecord_t * const pxWaitRecords,
+                                   const UBaseType_t uxNumberOfRecords ) PRIVILEGED_FUNCTION;
+    static void prvUnlockWaitQueues( QueueWaitRecord_t * const pxWaitRecords,
+                                     const UBaseType_t uxNumberOfRecords ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvAreWaitQueuesEmpty( QueueWaitRecord_t * const pxWaitRecords,
+                                             const UBaseType_t uxNumberOfRecords ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * Uses a critical section to determine if there is any space in a queue.
  *
  * @return pdTRUE if there is no space, otherwise pdFALSE;
  */
-static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
+static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+/*
+ * Copy an item directly into the buffer of the highest priority task blocked
+ * receiving from an empty queue, and unblock the task.  Returns pdTRUE if the
+ * item was handed off, or pdFALSE if it must be copied into the queue's
+ * storage.  Must be called from a critical section.
+ */
+    static BaseType_t prvHandoffToReceiver( Queue_t * const pxQueue,
+                                            const void * pvItemToQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+
+/*
+ * Copy the item of the highest priority task blocked sending to a rendezvous
+ * channel into pvBuffer, and unblock the task.  Returns pdTRUE if an item was
+ * received, or pdFALSE if no task is waiting to send.  Must be called from a
+ * critical section.
+ */
+    static BaseType_t prvTakeFromSender( Queue_t * const pxQueue,
+                                         void * const pvBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+
+/*
+ * Give or take a counting semaphore with a compare-and-swap of its count,
+ * without a critical section, if no task is waiting for the semaphore to be
+ * given or taken.  Return pdTRUE if the semaphore was given or taken, or
+ * pdFALSE if the caller must use the normal path.
+ */
+    static BaseType_t prvSemaphoreFastGive( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+    static BaseType_t prvSemaphoreFastTake( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+/*
+ * Called after the fast path has changed the count of a semaphore.  If a task
+ * started waiting on pxWaitingList after the fast path found it empty, unblock
+ * the highest priority task on the list, as the normal path would have done.
+ */
+    static void prvSemaphoreFastWake( List_t * const pxWaitingList ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+/*
+ * Enter and exit a critical section that also holds the queue's own
+ * spinlock.  The kernel's locks are always obtained first.
+ */
+    static void prvEnterQueueCritical( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvExitQueueCritical( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static UBaseType_t prvEnterQueueCriticalFromISR( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static void prvExitQueueCriticalFromISR( const Queue_t * const pxQueue,
+                                             UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
+/*
+ * Send an item to, or receive an item from, a queue holding only the queue's
+ * own spinlock, if doing so can neither unblock a task nor need the calling
+ * task to block.  Return pdTRUE if the item was sent or received, or pdFALSE
+ * if the caller must use the normal path.  Can be called from tasks and
+ * interrupts.
+ */
+    static BaseType_t prvObjectLockedSend( Queue_t * const pxQueue,
+                                           const void * const pvItemToQueue,
+                                           const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+    static BaseType_t prvObjectLockedReceive( Queue_t * const pxQueue,
+                                              void * const pvBuffer ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+/*
+ * Add the item in the held write slot to the back of the queue, or remove the
+ * item in the held read slot from the front of the queue, and unblock any task
+ * that can now proceed.  Must be called from a critical section.  Return pdTRUE
+ * if a task that was unblocked has a priority above the calling task.
+ */
+    static BaseType_t prvCommitWriteSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvReleaseReadSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configQUEUE_LOW_LATENCY_COPY_BYTES > 0 )
+
+/*
+ * Send an item to the back of the queue, or receive the item at its front,
+ * copying the item with the scheduler suspended rather than with interrupts
+ * masked.  Return pdFALSE without blocking if the queue is full or empty, or
+ * its slot is held by another task, in which case the caller falls back to
+ * the normal path.
+ */
+    static BaseType_t prvSendWithInterruptsEnabled( Queue_t * const pxQueue,
+                                                    const void * const pvItemToQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvReceiveWithInterruptsEnabled( Queue_t * const pxQueue,
+                                                       void * const pvBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configQUEUE_ASYNC_COPY_BYTES > 0 )
+
+/*
+ * Send an item to the back of the queue, or receive the item at its front,
+ * holding its slot while the item is copied by prvCopyAsync().  Return pdFALSE
+ * without blocking if the queue is full or empty, or its slot is held by
+ * another task, in which case the caller falls back to the normal path.
+ */
+    static BaseType_t prvSendWithAsyncCopy( Queue_t * const pxQueue,
+                                            const void * const pvItemToQueue ) PRIVILEGED_FUNCTION;
+    static BaseType_t prvReceiveWithAsyncCopy( Queue_t * const pxQueue,
+                                               void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Start a copy with configQUEUE_ASYNC_COPY_START() and block until it
+ * completes, or copy the item with queueCOPY_BYTES() if the copy was not
+ * started.
+ */
+    static void prvCopyAsync( void * pvDestination,
+                              const void * pvSource,
+                              size_t xBytes ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configUSE_QUEUE_WORD_COPY == 1 )
+
+/*
+ * Copy an item as 32-bit words if its size and both addresses are multiples of
+ * 4, otherwise with configCOPY_BYTES().
+ */
+    static void prvCopyItem( void * pvDestination,
+                             const void * pvSource,
+                             size_t xBytes ) PRIVILEGED_FUNCTION;
+#endif
 
 /*
  * Copies an item into the queue, either at the front of the queue or the
@@ -191,14 +590,60 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue ) PRIVILEGED_FUNCTION;
  */
 static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
                                       const void * pvItemToQueue,
-                                      const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+                                      const BaseType_t xPosition ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
 
 /*
  * Copies an item out of a queue.
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+/*
+ * Copies the item at the front of the queue into the buffer without removing
+ * it from the queue.
+ */
+static void prvPeekDataFromQueue( Queue_t * const pxQueue,
                                   void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+
+/*
+ * The priority queue equivalents of prvCopyDataToQueue() and
+ * prvCopyDataFromQueue().  Sending to the back of the queue uses the lowest
+ * message priority and sending to the front places the item ahead of all
+ * others at the highest message priority.  The item is only removed from the
+ * queue if xRemove is not pdFALSE.
+ */
+    static void prvCopyDataToPriorityQueue( Queue_t * const pxQueue,
+                                            const void * pvItemToQueue,
+                                            const BaseType_t xPosition ) PRIVILEGED_FUNCTION;
+    static void prvCopyDataFromPriorityQueue( Queue_t * const pxQueue,
+                                              void * const pvBuffer,
+                                              const BaseType_t xRemove ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Copies as many of the uxItemCount items at pvItems into the back of the
+ * queue as there is space for, or out of the front of the queue into pvBuffer
+ * as there are items available.  Returns the number of items copied.
+ */
+static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                        const void * pvItems,
+                                        UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                          void * const pvBuffer,
+                                          UBaseType_t uxItemCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks tasks waiting for the items just added to, or the space just freed
+ * in, an unlocked queue, at most one task per item.  Returns pdTRUE if an
+ * unblocked task has a priority above that of the running task.
+ */
+static BaseType_t prvUnblockTasksWaitingToReceive( Queue_t * const pxQueue,
+                                                   UBaseType_t uxItemsAdded ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockTasksWaitingToSend( Queue_t * const pxQueue,
+                                                UBaseType_t uxItemsRemoved ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
 /*
@@ -208,6 +653,22 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue,
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
 
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+/*
+ * Clears the ready bit of a queue set member that has become empty.
+ */
+    static void prvClearQueueSetMemberReady( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies the handle of a ready member of a queue set into pvBuffer.  Each
+ * search starts after the member last returned so every ready member is
+ * eventually selected.
+ */
+    static void prvSelectQueueSetMember( Queue_t * const pxQueueSet,
+                                         void * const pvBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Called after a Queue_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -238,14 +699,64 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
  */
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 #endif
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+/*
+ * Reader writer locks are also a special type of queue.  prvInitialiseRWLock()
+ * configures a newly created queue as a reader writer lock.
+ */
+    static void prvInitialiseRWLock( Queue_t * pxNewQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns pdTRUE if the reader writer lock can be taken by a writer
+ * (xWrite != pdFALSE) or a reader (xWrite == pdFALSE), otherwise pdFALSE.
+ * Readers cannot take the lock while a writer is waiting for it.
+ */
+    static BaseType_t prvIsRWLockAvailable( const Queue_t * pxQueue,
+                                            const BaseType_t xWrite ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the tasks that are waiting for a reader writer lock that can now
+ * take it - either the highest priority waiting writer, or, if no writers are
+ * waiting, all the waiting readers.  Must be called from within a critical
+ * section.  Returns pdTRUE if a task that has a priority higher than the
+ * calling task was unblocked.
+ */
+    static BaseType_t prvUnblockRWLockWaiters( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+#endif
 /*-----------------------------------------------------------*/
 
+/*
+ * With configUSE_GRANULAR_LOCKS set to 1 each queue also has a spinlock of its
+ * own.  The spinlock is obtained after the kernel's task and ISR locks, and
+ * nothing else is obtained while it is held, except that a queue set's
+ * spinlock is obtained while holding the spinlock of a member - which is only
+ * done while holding the ISR lock, so cannot deadlock.  A send or receive
+ * that holds only the spinlock never waits for a second lock.
+ */
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+    #define queueGET_OBJECT_LOCK( pxQueue )                                      portGET_SPINLOCK( ( portSPINLOCK_TYPE * ) &( ( pxQueue )->xObjectLock ) )
+    #define queueRELEASE_OBJECT_LOCK( pxQueue )                                  portRELEASE_SPINLOCK( ( portSPINLOCK_TYPE * ) &( ( pxQueue )->xObjectLock ) )
+    #define queueENTER_CRITICAL( pxQueue )                                       prvEnterQueueCritical( pxQueue )
+    #define queueEXIT_CRITICAL( pxQueue )                                        prvExitQueueCritical( pxQueue )
+    #define queueENTER_CRITICAL_FROM_ISR( pxQueue )                              prvEnterQueueCriticalFromISR( pxQueue )
+    #define queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus )       prvExitQueueCriticalFromISR( ( pxQueue ), ( uxSavedInterruptStatus ) )
+#else
+    #define queueGET_OBJECT_LOCK( pxQueue )
+    #define queueRELEASE_OBJECT_LOCK( pxQueue )
+    #define queueENTER_CRITICAL( pxQueue )                                       taskENTER_CRITICAL()
+    #define queueEXIT_CRITICAL( pxQueue )                                        taskEXIT_CRITICAL()
+    #define queueENTER_CRITICAL_FROM_ISR( pxQueue )                              taskENTER_CRITICAL_FROM_ISR()
+    #define queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus )       taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus )
+#endif /* configUSE_GRANULAR_LOCKS */
+
 /*
  * Macro to mark a queue as locked.  Locking a queue prevents an ISR from
  * accessing the queue event lists.
  */
 #define prvLockQueue( pxQueue )                            \
-    taskENTER_CRITICAL();                                  \
+    queueENTER_CRITICAL( pxQueue );                        \
     {                                                      \
         if( ( pxQueue )->cRxLock == queueUNLOCKED )        \
         {                                                  \
@@ -256,7 +767,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
             ( pxQueue )->cTxLock = queueLOCKED_UNMODIFIED; \
         }                                                  \
     }                                                      \
-    taskEXIT_CRITICAL()
+    queueEXIT_CRITICAL( pxQueue )
 
 /*
  * Macro to increment cTxLock member of the queue data structure. It is
@@ -298,19 +809,115 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
     configASSERT( pxQueue );
 
     if( ( pxQueue != NULL ) &&
-        ( pxQueue->uxLength >= 1U ) &&
-        /* Check for multiplication overflow. */
-        ( ( SIZE_MAX / pxQueue->uxLength ) >= pxQueue->uxItemSize ) )
+        ( ( ( pxQueue->uxLength >= 1U ) &&
+            /* Check for multiplication overflow. */
+            ( ( SIZE_MAX / pxQueue->uxLength ) >= pxQueue->uxItemSize ) ) ||
+          queueIS_RENDEZVOUS( pxQueue ) ) )
     {
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( pxQueue );
         {
+            #if ( configUSE_QUEUE_STATS == 1 )
+            {
+                if( xNewQueue != pdFALSE )
+                {
+                    pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
+                    prvResetQueueStats( pxQueue );
+                }
+                else
+                {
+                    queueRECORD_LEVEL( pxQueue, ( UBaseType_t ) 0U, ( UBaseType_t ) 0U, ( UBaseType_t ) 0U );
+                }
+            }
+            #endif /* configUSE_QUEUE_STATS */
+
             pxQueue->u.xQueue.pcTail = pxQueue->pcHead + ( pxQueue->uxLength * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
             pxQueue->uxMessagesWaiting = ( UBaseType_t ) 0U;
             pxQueue->pcWriteTo = pxQueue->pcHead;
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( ( pxQueue->uxLength - 1U ) * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+
+            #if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+                if( queueIS_RENDEZVOUS( pxQueue ) )
+                {
+                    /* There is no storage to read from. */
+                    pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+                }
+                else
+            #endif
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead + ( ( pxQueue->uxLength - 1U ) * pxQueue->uxItemSize ); /*lint !e9016 Pointer arithmetic allowed on char types, especially when it assists conveying intent. */
+            }
+
             pxQueue->cRxLock = queueUNLOCKED;
             pxQueue->cTxLock = queueUNLOCKED;
 
+            #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            {
+                pxQueue->ucSlotsHeld = 0U;
+            }
+            #endif
+
+            #if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+            {
+                if( queueIS_PRIORITY_QUEUE( pxQueue ) )
+                {
+                    uint8_t * const pucNext = queuePRIORITY_NEXT( pxQueue );
+                    UBaseType_t uxIndex;
+
+                    /* Every slot is on the free list and every priority's
+                     * list is empty. */
+                    for( uxIndex = ( UBaseType_t ) 0U; uxIndex < pxQueue->uxLength; uxIndex++ )
+                    {
+                        pucNext[ uxIndex ] = ( uint8_t ) ( uxIndex + ( UBaseType_t ) 1U );
+                    }
+
+                    pucNext[ pxQueue->uxLength - 1U ] = queuePRIORITY_NO_SLOT;
+                    ( void ) memset( ( void * ) queuePRIORITY_HEAD( pxQueue ), ( int ) queuePRIORITY_NO_SLOT, ( size_t ) ( 2U * configQUEUE_MESSAGE_PRIORITIES ) );
+                    *queuePRIORITY_FREE( pxQueue ) = ( uint8_t ) 0U;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configQUEUE_MESSAGE_PRIORITIES */
+
+            #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+            {
+                if( queueIS_BITMAP_SET( pxQueue ) )
+                {
+                    Queue_t ** const ppxMembers = queueSET_MEMBERS( pxQueue );
+                    UBaseType_t uxIndex;
+
+                    ( void ) memset( ( void * ) queueSET_READY_BITS( pxQueue ), 0x00, ( size_t ) queueSET_BITMAP_BYTES( pxQueue->uxLength ) + 1U );
+
+                    for( uxIndex = ( UBaseType_t ) 0U; uxIndex < pxQueue->uxLength; uxIndex++ )
+                    {
+                        if( xNewQueue != pdFALSE )
+                        {
+                            ppxMembers[ uxIndex ] = NULL;
+                        }
+                        else if( ( ppxMembers[ uxIndex ] != NULL ) && ( ppxMembers[ uxIndex ]->uxMessagesWaiting != ( UBaseType_t ) 0 ) )
+                        {
+                            /* Members that still hold data remain ready. */
+                            queueSET_READY_BITS( pxQueue )[ uxIndex >> 3 ] |= ( uint8_t ) ( 1U << ( uxIndex & 7U ) );
+                            pxQueue->uxMessagesWaiting++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else if( xNewQueue == pdFALSE )
+                {
+                    queueSET_MEMBER_RECEIVED( pxQueue );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_QUEUE_SET_BITMAP */
+
             if( xNewQueue == pdFALSE )
             {
                 /* If there are tasks blocked waiting to read from the queue, then
@@ -341,7 +948,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
                 vListInitialise( &( pxQueue->xTasksWaitingToReceive ) );
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
     }
     else
     {
@@ -370,13 +977,14 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
          * supplied. */
         configASSERT( pxStaticQueue );
 
-        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+        if( ( ( uxQueueLength > ( UBaseType_t ) 0 ) || queueIS_VALID_RENDEZVOUS( uxQueueLength, uxItemSize, ucQueueType ) ) &&
             ( pxStaticQueue != NULL ) &&
 
             /* A queue storage area should be provided if the item size is not 0, and
-             * should not be provided if the item size is 0. */
-            ( !( ( pucQueueStorage != NULL ) && ( uxItemSize == 0 ) ) ) &&
-            ( !( ( pucQueueStorage == NULL ) && ( uxItemSize != 0 ) ) ) )
+             * should not be provided if the item size is 0.  A rendezvous channel
+             * has no storage area. */
+            ( !( ( pucQueueStorage != NULL ) && ( ( uxItemSize == 0 ) || ( uxQueueLength == 0 ) ) ) ) &&
+            ( !( ( pucQueueStorage == NULL ) && ( uxItemSize != 0 ) && ( uxQueueLength != 0 ) ) ) )
         {
             #if ( configASSERT_DEFINED == 1 )
             {
@@ -429,17 +1037,49 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
         size_t xQueueSizeInBytes;
         uint8_t * pucQueueStorage;
 
-        if( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
-            /* Check for multiplication overflow. */
-            ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
-            /* Check for addition overflow. */
-            ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * uxItemSize ) ) )
+        if( ( ( uxQueueLength > ( UBaseType_t ) 0 ) &&
+              /* Check for multiplication overflow. */
+              ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
+              /* Check for addition overflow. */
+              ( ( SIZE_MAX - sizeof( Queue_t ) ) >= ( uxQueueLength * uxItemSize ) ) ) ||
+            queueIS_VALID_RENDEZVOUS( uxQueueLength, uxItemSize, ucQueueType ) )
         {
             /* Allocate enough space to hold the maximum number of items that
              * can be in the queue at any time.  It is valid for uxItemSize to be
-             * zero in the case the queue is used as a semaphore. */
+             * zero in the case the queue is used as a semaphore, and for
+             * uxQueueLength to be zero in the case of a rendezvous channel. */
             xQueueSizeInBytes = ( size_t ) ( uxQueueLength * uxItemSize ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
+            #if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+            {
+                if( ucQueueType == queueQUEUE_TYPE_PRIORITY )
+                {
+                    /* Also allocate the lists that order the items. */
+                    configASSERT( uxQueueLength <= queuePRIORITY_MAX_LENGTH );
+                    xQueueSizeInBytes = ( size_t ) queuePRIORITY_QUEUE_STORAGE_SIZE( uxQueueLength, uxItemSize );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configQUEUE_MESSAGE_PRIORITIES */
+
+            #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+            {
+                if( ucQueueType == queueQUEUE_TYPE_SET_BITMAP )
+                {
+                    /* Also allocate the ready bitmap. */
+                    configASSERT( uxQueueLength <= queueSET_MAX_MEMBERS );
+                    xQueueSizeInBytes = ( size_t ) queueSET_STORAGE_SIZE( uxQueueLength );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_QUEUE_SET_BITMAP */
+
             /* Allocate the queue and storage area.  Justification for MISRA
              * deviation as follows:  pvPortMalloc() always ensures returned memory
              * blocks are aligned per the requirements of the MCU stack.  In this case
@@ -449,7 +1089,7 @@ BaseType_t xQueueGenericReset( QueueHandle_t xQueue,
              * are greater than or equal to the pointer to char requirements the cast
              * is safe.  In other cases alignment requirements are not strict (one or
              * two bytes). */
-            pxNewQueue = ( Queue_t * ) pvPortMalloc( sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
+            pxNewQueue = ( Queue_t * ) pvPortMallocObject( portOBJECT_POOL_QUEUE, sizeof( Queue_t ) + xQueueSizeInBytes ); /*lint !e9087 !e9079 see comment above. */
 
             if( pxNewQueue != NULL )
             {
@@ -497,12 +1137,13 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
      * configUSE_TRACE_FACILITY not be set to 1. */
     ( void ) ucQueueType;
 
-    if( uxItemSize == ( UBaseType_t ) 0 )
+    if( ( uxItemSize == ( UBaseType_t ) 0 ) || ( uxQueueLength == ( UBaseType_t ) 0 ) )
     {
         /* No RAM was allocated for the queue storage area, but PC head cannot
          * be set to NULL because NULL is used as a key to say the queue is used as
          * a mutex.  Therefore just set pcHead to point to the queue as a benign
-         * value that is known to be within the memory map. */
+         * value that is known to be within the memory map.  A queue of length 0
+         * is a rendezvous channel, which has no storage either. */
         pxNewQueue->pcHead = ( int8_t * ) pxNewQueue;
     }
     else
@@ -515,6 +1156,63 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
      * defined. */
     pxNewQueue->uxLength = uxQueueLength;
     pxNewQueue->uxItemSize = uxItemSize;
+
+    #if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+    {
+        /* Must be set before the queue is reset so the lists that order the
+         * items get initialised. */
+        if( ucQueueType == queueQUEUE_TYPE_PRIORITY )
+        {
+            configASSERT( uxQueueLength <= queuePRIORITY_MAX_LENGTH );
+            configASSERT( uxItemSize > ( UBaseType_t ) 0U );
+            pxNewQueue->ucIsPriorityQueue = ( uint8_t ) pdTRUE;
+        }
+        else
+        {
+            pxNewQueue->ucIsPriorityQueue = ( uint8_t ) pdFALSE;
+        }
+    }
+    #endif /* configQUEUE_MESSAGE_PRIORITIES */
+
+    #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+    {
+        if( ucQueueType == queueQUEUE_TYPE_SET_BITMAP )
+        {
+            pxNewQueue->ucQueueSetIndex = queueSET_INDEX_IS_SET;
+        }
+        else
+        {
+            pxNewQueue->ucQueueSetIndex = ( uint8_t ) 0U;
+        }
+    }
+    #endif /* configUSE_QUEUE_SET_BITMAP */
+
+    #if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+    {
+        pxNewQueue->ucWaitOrder = ( uint8_t ) queueWAIT_ORDER_PRIORITY;
+    }
+    #endif
+
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+    {
+        pxNewQueue->ucOverflowPolicy = ( uint8_t ) queueOVERFLOW_DROP_NEWEST;
+        pxNewQueue->uxOverflowCount = ( UBaseType_t ) 0U;
+    }
+    #endif
+
+    #if ( configUSE_TYPED_QUEUES == 1 )
+    {
+        pxNewQueue->pxCopyItem = NULL;
+    }
+    #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        /* Must be initialised before the queue is reset. */
+        portINIT_SPINLOCK( &( pxNewQueue->xObjectLock ) );
+    }
+    #endif
+
     ( void ) xQueueGenericReset( pxNewQueue, pdTRUE );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -529,11 +1227,151 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
     }
     #endif /* configUSE_QUEUE_SETS */
 
-    traceQUEUE_CREATE( pxNewQueue );
-}
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_MUTEXES == 1 )
+    #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+    {
+        pxNewQueue->uxCeilingPriority = tskIDLE_PRIORITY;
+    }
+    #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        eObjectType eType;
+
+        switch( ucQueueType )
+        {
+            case queueQUEUE_TYPE_MUTEX:
+            case queueQUEUE_TYPE_RECURSIVE_MUTEX:
+            case queueQUEUE_TYPE_RW_LOCK:
+                eType = eObjectMutex;
+                break;
+
+            case queueQUEUE_TYPE_COUNTING_SEMAPHORE:
+            case queueQUEUE_TYPE_BINARY_SEMAPHORE:
+                eType = eObjectSemaphore;
+                break;
+
+            case queueQUEUE_TYPE_SET_BITMAP:
+                eType = eObjectQueueSet;
+                break;
+
+            default:
+
+                /* queueQUEUE_TYPE_SET has the same value as
+                 * queueQUEUE_TYPE_BASE, so a queue set created by
+                 * xQueueCreateSet() is registered as a queue. */
+                eType = eObjectQueue;
+                break;
+        }
+
+        vObjectRegistryAdd( &( pxNewQueue->xRegistryItem ), pxNewQueue, eType, NULL );
+    }
+    #endif /* configUSE_OBJECT_REGISTRY */
+
+    traceQUEUE_CREATE( pxNewQueue );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+
+    BaseType_t xQueueSetWaitOrder( QueueHandle_t xQueue,
+                                   BaseType_t xWaitOrder )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( ( xWaitOrder == queueWAIT_ORDER_PRIORITY ) || ( xWaitOrder == queueWAIT_ORDER_FIFO ) );
+
+        taskENTER_CRITICAL();
+        {
+            if( ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) ||
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+            {
+                /* The tasks already waiting were ordered by the old policy. */
+                xReturn = pdFAIL;
+            }
+            else if( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( xWaitOrder == queueWAIT_ORDER_FIFO ) )
+            {
+                /* Priority inheritance relies on the task at the head of a
+                 * mutex's wait list having the highest priority. */
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                pxQueue->ucWaitOrder = ( uint8_t ) xWaitOrder;
+                xReturn = pdPASS;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_WAIT_ORDER */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+
+    BaseType_t xQueueSetOverflowPolicy( QueueHandle_t xQueue,
+                                        BaseType_t xPolicy )
+    {
+        BaseType_t xReturn;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( ( xPolicy == queueOVERFLOW_DROP_NEWEST ) || ( xPolicy == queueOVERFLOW_DROP_OLDEST ) );
+
+        /* The items in a priority queue are not held in the order they were
+         * sent, and a rendezvous queue holds no items, so neither has an
+         * oldest item to drop. */
+        if( ( xPolicy == queueOVERFLOW_DROP_OLDEST ) && ( queueIS_PRIORITY_QUEUE( pxQueue ) || queueIS_RENDEZVOUS( pxQueue ) ) )
+        {
+            xReturn = pdFAIL;
+        }
+        else
+        {
+            /* A single byte write, so an interrupt sees either the old or the
+             * new policy. */
+            pxQueue->ucOverflowPolicy = ( uint8_t ) xPolicy;
+            xReturn = pdPASS;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxQueueGetOverflowCount( const QueueHandle_t xQueue )
+    {
+        const Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        return pxQueue->uxOverflowCount;
+    }
+
+#endif /* configUSE_OVERFLOW_POLICY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TYPED_QUEUES == 1 )
+
+    void vQueueSetItemCopyFunction( QueueHandle_t xQueue,
+                                    QueueItemCopyFunction_t pxCopyItem )
+    {
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        /* Semaphores hold no items, and a queue set holds queue handles that
+         * are copied by the kernel itself. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+        pxQueue->pxCopyItem = pxCopyItem;
+    }
+
+#endif /* configUSE_TYPED_QUEUES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
 
     static void prvInitialiseMutex( Queue_t * pxNewQueue )
     {
@@ -600,6 +1438,59 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeiling( const uint8_t ucQueueType,
+                                                UBaseType_t uxCeilingPriority )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        xNewQueue = xQueueCreateMutex( ucQueueType );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateMutexWithCeilingStatic( const uint8_t ucQueueType,
+                                                      UBaseType_t uxCeilingPriority,
+                                                      StaticQueue_t * pxStaticQueue )
+    {
+        QueueHandle_t xNewQueue;
+
+        configASSERT( uxCeilingPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        xNewQueue = xQueueCreateMutexStatic( ucQueueType, pxStaticQueue );
+
+        if( xNewQueue != NULL )
+        {
+            ( ( Queue_t * ) xNewQueue )->uxCeilingPriority = uxCeilingPriority;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xNewQueue;
+    }
+
+#endif /* ( ( configUSE_MUTEX_PRIORITY_CEILING == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_MUTEXES == 1 ) && ( INCLUDE_xSemaphoreGetMutexHolder == 1 ) )
 
     TaskHandle_t xQueueGetMutexHolder( QueueHandle_t xSemaphore )
@@ -757,367 +1648,2354 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength,
 #endif /* configUSE_RECURSIVE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+#if ( configUSE_RW_LOCKS == 1 )
 
-    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
-                                                       const UBaseType_t uxInitialCount,
-                                                       StaticQueue_t * pxStaticQueue )
+    static void prvInitialiseRWLock( Queue_t * pxNewQueue )
     {
-        QueueHandle_t xHandle = NULL;
-
-        if( ( uxMaxCount != 0 ) &&
-            ( uxInitialCount <= uxMaxCount ) )
+        if( pxNewQueue != NULL )
         {
-            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
-
-            if( xHandle != NULL )
-            {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+            /* A reader writer lock is a mutex type queue where
+             * uxMessagesWaiting counts the readers that hold the lock and
+             * xMutexHolder is the writer that holds the lock, if any.  Readers
+             * wait on xTasksWaitingToReceive and writers wait on
+             * xTasksWaitingToSend.  The lock starts available so, unlike a
+             * mutex, it is not given here. */
+            pxNewQueue->u.xSemaphore.xMutexHolder = NULL;
+            pxNewQueue->u.xSemaphore.uxRecursiveCallCount = 0;
+            pxNewQueue->uxQueueType = queueQUEUE_IS_MUTEX;
 
-                traceCREATE_COUNTING_SEMAPHORE();
-            }
-            else
-            {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
-            }
+            traceCREATE_MUTEX( pxNewQueue );
         }
         else
         {
-            configASSERT( xHandle );
-            mtCOVERAGE_TEST_MARKER();
+            traceCREATE_MUTEX_FAILED();
         }
-
-        return xHandle;
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* configUSE_RW_LOCKS */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
-                                                 const UBaseType_t uxInitialCount )
+    QueueHandle_t xQueueCreateRWLock( void )
     {
-        QueueHandle_t xHandle = NULL;
-
-        if( ( uxMaxCount != 0 ) &&
-            ( uxInitialCount <= uxMaxCount ) )
-        {
-            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
-
-            if( xHandle != NULL )
-            {
-                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxLockLength = ( UBaseType_t ) 1, uxLockSize = ( UBaseType_t ) 0;
 
-                traceCREATE_COUNTING_SEMAPHORE();
-            }
-            else
-            {
-                traceCREATE_COUNTING_SEMAPHORE_FAILED();
-            }
-        }
-        else
-        {
-            configASSERT( xHandle );
-            mtCOVERAGE_TEST_MARKER();
-        }
+        xNewQueue = xQueueGenericCreate( uxLockLength, uxLockSize, queueQUEUE_TYPE_RW_LOCK );
+        prvInitialiseRWLock( ( Queue_t * ) xNewQueue );
 
-        return xHandle;
+        return xNewQueue;
     }
 
-#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+#endif /* ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
-                              const void * const pvItemToQueue,
-                              TickType_t xTicksToWait,
-                              const BaseType_t xCopyPosition )
-{
-    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
-    TimeOut_t xTimeOut;
-    Queue_t * const pxQueue = xQueue;
+#if ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    QueueHandle_t xQueueCreateRWLockStatic( StaticQueue_t * pxStaticQueue )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        QueueHandle_t xNewQueue;
+        const UBaseType_t uxLockLength = ( UBaseType_t ) 1, uxLockSize = ( UBaseType_t ) 0;
+
+        xNewQueue = xQueueGenericCreateStatic( uxLockLength, uxLockSize, NULL, pxStaticQueue, queueQUEUE_TYPE_RW_LOCK );
+        prvInitialiseRWLock( ( Queue_t * ) xNewQueue );
+
+        return xNewQueue;
     }
-    #endif
 
-    /*lint -save -e904 This function relaxes the coding standard somewhat to
-     * allow return statements within the function itself.  This is done in the
-     * interest of execution time efficiency. */
-    for( ; ; )
+#endif /* ( ( configUSE_RW_LOCKS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+    BaseType_t xQueueTakeRWLock( QueueHandle_t xRWLock,
+                                 BaseType_t xWrite,
+                                 TickType_t xTicksToWait )
     {
-        taskENTER_CRITICAL();
+        BaseType_t xEntryTimeSet = pdFALSE, xInheritanceOccurred = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xRWLock;
+        List_t * const pxWaitingList = ( xWrite != pdFALSE ) ? &( pxQueue->xTasksWaitingToSend ) : &( pxQueue->xTasksWaitingToReceive );
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX );
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            /* Is there room on the queue now?  The running task must be the
-             * highest priority task wanting to access the queue.  If the head item
-             * in the queue is to be overwritten then it does not matter if the
-             * queue is full. */
-            if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in
+         * the interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
             {
-                traceQUEUE_SEND( pxQueue );
+                if( prvIsRWLockAvailable( pxQueue, xWrite ) != pdFALSE )
+                {
+                    if( xWrite != pdFALSE )
+                    {
+                        /* Record the information required to implement
+                         * priority inheritance should it become necessary. */
+                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                    }
+                    else
+                    {
+                        ( pxQueue->uxMessagesWaiting )++;
+                    }
 
-                #if ( configUSE_QUEUE_SETS == 1 )
+                    traceQUEUE_RECEIVE( pxQueue );
+                    taskEXIT_CRITICAL();
+                    return pdPASS;
+                }
+                else
                 {
-                    const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+                    if( xTicksToWait == ( TickType_t ) 0 )
+                    {
+                        /* The lock is not available and no block time is
+                         * specified (or the block time has expired) so leave
+                         * now. */
+                        taskEXIT_CRITICAL();
+                        traceQUEUE_RECEIVE_FAILED( pxQueue );
+                        return pdFAIL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The lock is not available and a block time was
+                         * specified so configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
+                    }
+                    else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            taskEXIT_CRITICAL();
 
-                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+            /* Interrupts and other tasks can give back the lock now the
+             * critical section has been exited. */
 
-                    if( pxQueue->pxQueueSetContainer != NULL )
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                /* A block time is specified and not expired.  If the lock is
+                 * still not available then enter the Blocked state to wait
+                 * for it. */
+                if( prvIsRWLockAvailable( pxQueue, xWrite ) == pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                    /* Only a writer can inherit a priority, as the readers
+                     * that hold the lock are not recorded. */
+                    if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
                     {
-                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
+                        taskENTER_CRITICAL();
                         {
-                            /* Do not notify the queue set as an existing item
-                             * was overwritten in the queue so the number of items
-                             * in the queue has not changed. */
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
-                        {
-                            /* The queue is a member of a queue set, and posting
-                             * to the queue set caused a higher priority task to
-                             * unblock. A context switch is required. */
-                            queueYIELD_IF_USING_PREEMPTION();
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
+                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
                         }
+                        taskEXIT_CRITICAL();
                     }
                     else
                     {
-                        /* If there was a task waiting for data to arrive on the
-                         * queue then unblock it now. */
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    vTaskPlaceOnMutexEventList( pxWaitingList, &( pxQueue->u.xSemaphore.xMutexHolder ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The lock became available.  Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                /* If the lock is not available then exit now as the timeout
+                 * has expired.  Otherwise return to attempt to take the lock
+                 * that is known to be available. */
+                if( prvIsRWLockAvailable( pxQueue, xWrite ) == pdFALSE )
+                {
+                    BaseType_t xYieldRequired = pdFALSE;
+
+                    taskENTER_CRITICAL();
+                    {
+                        /* If this task caused the writer that holds the lock
+                         * to inherit its priority then the writer should drop
+                         * back to the highest priority of any other waiting
+                         * task. */
+                        if( xInheritanceOccurred != pdFALSE )
                         {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            UBaseType_t uxHighestWaitingPriority, uxHighestWaitingWriterPriority;
+
+                            uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
+
+                            if( listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToSend ) ) > 0U )
                             {
-                                /* The unblocked task has a priority higher than
-                                 * our own so yield immediately.  Yes it is ok to
-                                 * do this from within the critical section - the
-                                 * kernel takes care of that. */
-                                queueYIELD_IF_USING_PREEMPTION();
+                                uxHighestWaitingWriterPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxQueue->xTasksWaitingToSend ) );
+
+                                if( uxHighestWaitingWriterPriority > uxHighestWaitingPriority )
+                                {
+                                    uxHighestWaitingPriority = uxHighestWaitingWriterPriority;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
                             }
                             else
                             {
                                 mtCOVERAGE_TEST_MARKER();
                             }
-                        }
-                        else if( xYieldRequired != pdFALSE )
-                        {
-                            /* This path is a special case that will only get
-                             * executed if the task was holding multiple mutexes
-                             * and the mutexes were given back in an order that is
-                             * different to that in which they were taken. */
-                            queueYIELD_IF_USING_PREEMPTION();
+
+                            vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
-                    }
-                }
-                #else /* configUSE_QUEUE_SETS */
-                {
-                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
 
-                    /* If there was a task waiting for data to arrive on the
-                     * queue then unblock it now. */
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                    {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        /* Readers that were only waiting because this writer
+                         * was waiting can now take the lock. */
+                        if( xWrite != pdFALSE )
                         {
-                            /* The unblocked task has a priority higher than
-                             * our own so yield immediately.  Yes it is ok to do
-                             * this from within the critical section - the kernel
-                             * takes care of that. */
-                            queueYIELD_IF_USING_PREEMPTION();
+                            xYieldRequired = prvUnblockRWLockWaiters( pxQueue );
                         }
                         else
                         {
                             mtCOVERAGE_TEST_MARKER();
                         }
                     }
-                    else if( xYieldRequired != pdFALSE )
+                    taskEXIT_CRITICAL();
+
+                    if( xYieldRequired != pdFALSE )
                     {
-                        /* This path is a special case that will only get
-                         * executed if the task was holding multiple mutexes and
-                         * the mutexes were given back in an order that is
-                         * different to that in which they were taken. */
                         queueYIELD_IF_USING_PREEMPTION();
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    return pdFAIL;
                 }
-                #endif /* configUSE_QUEUE_SETS */
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
 
-                taskEXIT_CRITICAL();
-                return pdPASS;
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+    BaseType_t xQueueGiveRWLock( QueueHandle_t xRWLock,
+                                 BaseType_t xWrite )
+    {
+        BaseType_t xReturn = pdPASS, xYieldRequired = pdFALSE;
+        Queue_t * const pxQueue = xRWLock;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX );
+
+        taskENTER_CRITICAL();
+        {
+            if( xWrite != pdFALSE )
+            {
+                if( pxQueue->u.xSemaphore.xMutexHolder == xTaskGetCurrentTaskHandle() )
+                {
+                    /* The writer is giving back the lock so should
+                     * disinherit any priority it inherited while holding it. */
+                    xYieldRequired = xTaskPriorityDisinherit( pxQueue->u.xSemaphore.xMutexHolder );
+                    pxQueue->u.xSemaphore.xMutexHolder = NULL;
+                }
+                else
+                {
+                    /* The calling task is not the writer that holds the
+                     * lock. */
+                    xReturn = pdFAIL;
+                }
             }
             else
             {
-                if( xTicksToWait == ( TickType_t ) 0 )
+                if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
                 {
-                    /* The queue was full and no block time is specified (or
-                     * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
-
-                    /* Return to the original privilege level before exiting
-                     * the function. */
-                    traceQUEUE_SEND_FAILED( pxQueue );
-                    return errQUEUE_FULL;
+                    ( pxQueue->uxMessagesWaiting )--;
                 }
-                else if( xEntryTimeSet == pdFALSE )
+                else
                 {
-                    /* The queue was full and a block time was specified so
-                     * configure the timeout structure. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
+                    /* No readers hold the lock. */
+                    xReturn = pdFAIL;
+                }
+            }
+
+            if( xReturn != pdFAIL )
+            {
+                traceQUEUE_SEND( pxQueue );
+
+                if( prvUnblockRWLockWaiters( pxQueue ) != pdFALSE )
+                {
+                    xYieldRequired = pdTRUE;
                 }
                 else
                 {
-                    /* Entry time was already set. */
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            else
+            {
+                traceQUEUE_SEND_FAILED( pxQueue );
+            }
         }
         taskEXIT_CRITICAL();
 
-        /* Interrupts and other tasks can send to and receive from the queue
-         * now the critical section has been exited. */
+        if( xYieldRequired != pdFALSE )
+        {
+            queueYIELD_IF_USING_PREEMPTION();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+        return xReturn;
+    }
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+    static BaseType_t prvIsRWLockAvailable( const Queue_t * pxQueue,
+                                            const BaseType_t xWrite )
+    {
+        BaseType_t xReturn;
+
+        taskENTER_CRITICAL();
         {
-            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            if( pxQueue->u.xSemaphore.xMutexHolder != NULL )
             {
-                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                xReturn = pdFALSE;
+            }
+            else if( xWrite != pdFALSE )
+            {
+                /* A writer needs exclusive access. */
+                xReturn = ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) ? pdTRUE : pdFALSE;
+            }
+            else
+            {
+                /* Writers take preference over readers. */
+                xReturn = ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) ? pdTRUE : pdFALSE;
+            }
+        }
+        taskEXIT_CRITICAL();
 
-                /* Unlocking the queue means queue events can effect the
-                 * event list. It is possible that interrupts occurring now
-                 * remove this task from the event list again - but as the
-                 * scheduler is suspended the task will go onto the pending
-                 * ready list instead of the actual ready list. */
-                prvUnlockQueue( pxQueue );
+        return xReturn;
+    }
 
-                /* Resuming the scheduler will move tasks from the pending
-                 * ready list into the ready list - so it is feasible that this
-                 * task is already in the ready list before it yields - in which
-                 * case the yield will not cause a context switch unless there
-                 * is also a higher priority task in the pending ready list. */
-                if( xTaskResumeAll() == pdFALSE )
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_RW_LOCKS == 1 )
+
+    static BaseType_t prvUnblockRWLockWaiters( Queue_t * const pxQueue )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+
+        if( pxQueue->u.xSemaphore.xMutexHolder == NULL )
+        {
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            {
+                /* Writers take preference, but can only take the lock once
+                 * the last reader has given it back. */
+                if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
                 {
-                    portYIELD_WITHIN_API();
+                    xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
             else
             {
-                /* Try again. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
+                /* No writers are waiting so all the waiting readers can take
+                 * the lock at once. */
+                while( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
             }
         }
         else
         {
-            /* The timeout has expired. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
-
-            traceQUEUE_SEND_FAILED( pxQueue );
-            return errQUEUE_FULL;
+            mtCOVERAGE_TEST_MARKER();
         }
-    } /*lint -restore */
-}
-/*-----------------------------------------------------------*/
 
-BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
-                                     const void * const pvItemToQueue,
-                                     BaseType_t * const pxHigherPriorityTaskWoken,
-                                     const BaseType_t xCopyPosition )
-{
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    Queue_t * const pxQueue = xQueue;
+        return xYieldRequired;
+    }
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+#endif /* configUSE_RW_LOCKS */
+/*-----------------------------------------------------------*/
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
 
-    /* Similar to xQueueGenericSend, except without blocking if there is no room
-     * in the queue.  Also don't directly wake a task that was blocked on a queue
-     * read, instead return a flag to say whether a context switch is required or
-     * not (i.e. has a task with a higher priority than us been woken by this
-     * post). */
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    QueueHandle_t xQueueCreateCountingSemaphoreStatic( const UBaseType_t uxMaxCount,
+                                                       const UBaseType_t uxInitialCount,
+                                                       StaticQueue_t * pxStaticQueue )
     {
-        if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
-        {
-            const int8_t cTxLock = pxQueue->cTxLock;
-            const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+        QueueHandle_t xHandle = NULL;
+
+        if( ( uxMaxCount != 0 ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreateStatic( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, NULL, pxStaticQueue, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+
+                #if ( configUSE_QUEUE_STATS == 1 )
+                {
+                    ( ( Queue_t * ) xHandle )->uxMessagesWaitingHighWater = uxInitialCount;
+                }
+                #endif
+
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount,
+                                                 const UBaseType_t uxInitialCount )
+    {
+        QueueHandle_t xHandle = NULL;
+
+        if( ( uxMaxCount != 0 ) &&
+            ( uxInitialCount <= uxMaxCount ) )
+        {
+            xHandle = xQueueGenericCreate( uxMaxCount, queueSEMAPHORE_QUEUE_ITEM_LENGTH, queueQUEUE_TYPE_COUNTING_SEMAPHORE );
+
+            if( xHandle != NULL )
+            {
+                ( ( Queue_t * ) xHandle )->uxMessagesWaiting = uxInitialCount;
+
+                #if ( configUSE_QUEUE_STATS == 1 )
+                {
+                    ( ( Queue_t * ) xHandle )->uxMessagesWaitingHighWater = uxInitialCount;
+                }
+                #endif
+
+                traceCREATE_COUNTING_SEMAPHORE();
+            }
+            else
+            {
+                traceCREATE_COUNTING_SEMAPHORE_FAILED();
+            }
+        }
+        else
+        {
+            configASSERT( xHandle );
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xHandle;
+    }
+
+#endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSend( QueueHandle_t xQueue,
+                              const void * const pvItemToQueue,
+                              TickType_t xTicksToWait,
+                              const BaseType_t xCopyPosition )
+{
+    BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
+    traceBENCHMARK_API_ENTER( benchmarkAPI_QUEUE_SEND );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    configASSERT( !( ( ( xCopyPosition == queueOVERWRITE ) || ( xCopyPosition == queueOVERWRITE_OLDEST ) ) && ( queueIS_PRIORITY_QUEUE( pxQueue ) || queueIS_RENDEZVOUS( pxQueue ) ) ) );
+    configASSERT( ( xCopyPosition < queueSEND_WITH_PRIORITY( 0 ) ) || ( queueIS_PRIORITY_QUEUE( pxQueue ) && ( xCopyPosition < queueSEND_WITH_PRIORITY( configQUEUE_MESSAGE_PRIORITIES ) ) ) );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    #if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+    {
+        if( ( xCopyPosition == queueSEND_TO_BACK ) && ( prvSemaphoreFastGive( pxQueue ) != pdFALSE ) )
+        {
+            /* No task was waiting, so none was unblocked. */
+            traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_SEMAPHORE_FAST_PATH */
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvObjectLockedSend( pxQueue, pvItemToQueue, xCopyPosition ) != pdFALSE )
+        {
+            /* No task was waiting, so none was unblocked. */
+            traceQUEUE_SEND( pxQueue );
+            traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    #if ( configQUEUE_ASYNC_COPY_BYTES > 0 )
+    {
+        /* Items large enough to be worth offloading are copied by the
+         * application's DMA engine when a slot is free now, which requires
+         * the task to block until the copy completes.  Otherwise the item is
+         * sent below. */
+        if( ( xCopyPosition == queueSEND_TO_BACK ) &&
+            ( pxQueue->uxItemSize >= ( UBaseType_t ) configQUEUE_ASYNC_COPY_BYTES ) &&
+            ( !queueIS_PRIORITY_QUEUE( pxQueue ) ) &&
+            ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) )
+        {
+            if( prvSendWithAsyncCopy( pxQueue, pvItemToQueue ) != pdFALSE )
+            {
+                traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+                return pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configQUEUE_ASYNC_COPY_BYTES */
+
+    #if ( configQUEUE_LOW_LATENCY_COPY_BYTES > 0 )
+    {
+        /* Large items added to the back of the queue are copied with interrupts
+         * enabled when a slot is free now.  Otherwise the item is sent below. */
+        if( ( xCopyPosition == queueSEND_TO_BACK ) &&
+            ( pxQueue->uxItemSize >= ( UBaseType_t ) configQUEUE_LOW_LATENCY_COPY_BYTES ) &&
+            ( !queueIS_PRIORITY_QUEUE( pxQueue ) ) )
+        {
+            if( prvSendWithInterruptsEnabled( pxQueue, pvItemToQueue ) != pdFALSE )
+            {
+                traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+                return pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configQUEUE_LOW_LATENCY_COPY_BYTES */
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            /* Is there room on the queue now?  The running task must be the
+             * highest priority task wanting to access the queue.  If the head item
+             * in the queue is to be overwritten then it does not matter if the
+             * queue is full. */
+            if( queueCAN_SEND( pxQueue, xCopyPosition ) )
+            {
+                traceQUEUE_SEND( pxQueue );
+
+                #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+                {
+                    if( prvHandoffToReceiver( pxQueue, pvItemToQueue ) != pdFALSE )
+                    {
+                        queueEXIT_CRITICAL( pxQueue );
+                        traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+                        return pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        if( pxQueue->uxMessagesWaiting == uxPreviousMessagesWaiting )
+                        {
+                            /* Do not notify the queue set as an existing item
+                             * was overwritten in the queue so the number of items
+                             * in the queue has not changed. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The queue is a member of a queue set, and posting
+                             * to the queue set caused a higher priority task to
+                             * unblock. A context switch is required. */
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        /* If there was a task waiting for data to arrive on the
+                         * queue then unblock it now. */
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The unblocked task has a priority higher than
+                                 * our own so yield immediately.  Yes it is ok to
+                                 * do this from within the critical section - the
+                                 * kernel takes care of that. */
+                                queueYIELD_IF_USING_PREEMPTION();
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else if( xYieldRequired != pdFALSE )
+                        {
+                            /* This path is a special case that will only get
+                             * executed if the task was holding multiple mutexes
+                             * and the mutexes were given back in an order that is
+                             * different to that in which they were taken. */
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+
+                    /* If there was a task waiting for data to arrive on the
+                     * queue then unblock it now. */
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The unblocked task has a priority higher than
+                             * our own so yield immediately.  Yes it is ok to do
+                             * this from within the critical section - the kernel
+                             * takes care of that. */
+                            queueYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( xYieldRequired != pdFALSE )
+                    {
+                        /* This path is a special case that will only get
+                         * executed if the task was holding multiple mutexes and
+                         * the mutexes were given back in an order that is
+                         * different to that in which they were taken. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+
+                queueEXIT_CRITICAL( pxQueue );
+                traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+                return pdPASS;
+            }
+            else
+            {
+                #if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+                {
+                    /* A rendezvous channel is always full, but the item can be
+                     * copied straight into the buffer of a waiting receiver. */
+                    if( queueIS_RENDEZVOUS( pxQueue ) && ( prvHandoffToReceiver( pxQueue, pvItemToQueue ) != pdFALSE ) )
+                    {
+                        traceQUEUE_SEND( pxQueue );
+                        queueEXIT_CRITICAL( pxQueue );
+                        traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+                        return pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_RENDEZVOUS */
+
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    /* Return to the original privilege level before exiting
+                     * the function. */
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    queueRECORD_SEND_FAILED( pxQueue );
+                    traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+                    return errQUEUE_FULL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was full and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+
+                #if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+                {
+                    if( queueIS_RENDEZVOUS( pxQueue ) )
+                    {
+                        /* A receiver copies the item straight out of
+                         * pvItemToQueue, which is only read. */
+                        vTaskSetHandoffBuffer( ( void * ) pvItemToQueue ); /*lint !e9005 Const is cast away as the buffer is shared with receivers, but the item is never written. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_RENDEZVOUS */
+
+                queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+
+                /* Unlocking the queue means queue events can effect the
+                 * event list. It is possible that interrupts occurring now
+                 * remove this task from the event list again - but as the
+                 * scheduler is suspended the task will go onto the pending
+                 * ready list instead of the actual ready list. */
+                prvUnlockQueue( pxQueue );
+
+                /* Resuming the scheduler will move tasks from the pending
+                 * ready list into the ready list - so it is feasible that this
+                 * task is already in the ready list before it yields - in which
+                 * case the yield will not cause a context switch unless there
+                 * is also a higher priority task in the pending ready list. */
+                queueBLOCK_START( xBlockStart );
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+
+                queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_SENDER );
+
+                #if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+                {
+                    if( xTaskEndHandoff() != pdFALSE )
+                    {
+                        /* A receiver took the item from the rendezvous
+                         * channel. */
+                        traceQUEUE_SEND( pxQueue );
+                        traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+                        return pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_RENDEZVOUS */
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            traceQUEUE_SEND_FAILED( pxQueue );
+            queueRECORD_SEND_FAILED( pxQueue );
+            traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND );
+            return errQUEUE_FULL;
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
+                                     const void * const pvItemToQueue,
+                                     BaseType_t * const pxHigherPriorityTaskWoken,
+                                     const BaseType_t xCopyPosition )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+    BaseType_t xPosition = xCopyPosition;
+
+    traceBENCHMARK_API_ENTER( benchmarkAPI_QUEUE_SEND_FROM_ISR );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvItemToQueue == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( !( ( xCopyPosition == queueOVERWRITE ) && ( pxQueue->uxLength != 1 ) ) );
+    configASSERT( !( ( ( xCopyPosition == queueOVERWRITE ) || ( xCopyPosition == queueOVERWRITE_OLDEST ) ) && ( queueIS_PRIORITY_QUEUE( pxQueue ) || queueIS_RENDEZVOUS( pxQueue ) ) ) );
+    configASSERT( ( xCopyPosition < queueSEND_WITH_PRIORITY( 0 ) ) || ( queueIS_PRIORITY_QUEUE( pxQueue ) && ( xCopyPosition < queueSEND_WITH_PRIORITY( configQUEUE_MESSAGE_PRIORITIES ) ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+    {
+        /* A queue that drops its oldest item when full turns a send to the
+         * back into an overwrite of the oldest item, which only differs when
+         * the queue is full. */
+        if( ( xPosition == queueSEND_TO_BACK ) && ( pxQueue->ucOverflowPolicy == ( uint8_t ) queueOVERFLOW_DROP_OLDEST ) )
+        {
+            xPosition = queueOVERWRITE_OLDEST;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_OVERFLOW_POLICY */
+
+    /* Similar to xQueueGenericSend, except without blocking if there is no room
+     * in the queue.  Also don't directly wake a task that was blocked on a queue
+     * read, instead return a flag to say whether a context switch is required or
+     * not (i.e. has a task with a higher priority than us been woken by this
+     * post). */
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvObjectLockedSend( pxQueue, pvItemToQueue, xPosition ) != pdFALSE )
+        {
+            /* No task was waiting, so *pxHigherPriorityTaskWoken is left unchanged. */
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND_FROM_ISR );
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        if( queueCAN_SEND( pxQueue, xPosition ) )
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
+            const UBaseType_t uxPreviousMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            /* Semaphores use xQueueGiveFromISR(), so pxQueue will not be a
+             *  semaphore or mutex.  That means prvCopyDataToQueue() cannot result
+             *  in a task disinheriting a priority and prvCopyDataToQueue() can be
+             *  called here even though the disinherit function does not check if
+             *  the scheduler is suspended before accessing the ready lists. */
+            ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xPosition );
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        if( pxQueue->uxMessagesWaiting == uxPreviousMessagesWaiting )
+                        {
+                            /* Do not notify the queue set as an existing item
+                             * was overwritten in the queue so the number of items
+                             * in the queue has not changed. */
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The queue is a member of a queue set, and posting
+                             * to the queue set caused a higher priority task to
+                             * unblock.  A context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventListFromISR( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The task waiting has a higher priority so
+                                 *  record that a context switch is required. */
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventListFromISR( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* Not used in this path. */
+                    ( void ) uxPreviousMessagesWaiting;
+                }
+                #endif /* configUSE_QUEUE_SETS */
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was posted while it was locked. */
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueRECORD_SEND_FAILED_FROM_ISR( pxQueue );
+            queueRECORD_OVERFLOW( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus );
+
+    traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_SEND_FROM_ISR );
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
+                              BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    traceBENCHMARK_API_ENTER( benchmarkAPI_QUEUE_GIVE_FROM_ISR );
+
+    /* Similar to xQueueGenericSendFromISR() but used with semaphores where the
+     * item size is 0.  Don't directly wake a task that was blocked on a queue
+     * read, instead return a flag to say whether a context switch is required or
+     * not (i.e. has a task with a higher priority than us been woken by this
+     * post). */
+
+    configASSERT( pxQueue );
+
+    /* xQueueGenericSendFromISR() should be used instead of xQueueGiveFromISR()
+     * if the item size is not 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* Normally a mutex would not be given from an interrupt, especially if
+     * there is a mutex holder, as priority inheritance makes no sense for an
+     * interrupts, only tasks. */
+    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvObjectLockedSend( pxQueue, NULL, queueSEND_TO_BACK ) != pdFALSE )
+        {
+            /* No task was waiting, so *pxHigherPriorityTaskWoken is left unchanged. */
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+            traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_GIVE_FROM_ISR );
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* When the queue is used to implement a semaphore no data is ever
+         * moved through the queue but it is still valid to see if the queue 'has
+         * space'. */
+        if( uxMessagesWaiting < pxQueue->uxLength )
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            /* A task can only have an inherited priority if it is a mutex
+             * holder - and if there is a mutex holder then the mutex cannot be
+             * given from an ISR.  As this is the ISR version of the function it
+             * can be assumed there is no mutex holder and no need to determine if
+             * priority disinheritance is needed.  Simply increase the count of
+             * messages (semaphores) available. */
+            queueRECORD_LEVEL( pxQueue, uxMessagesWaiting + ( UBaseType_t ) 1, ( UBaseType_t ) 1, ( UBaseType_t ) 0 );
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                {
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        {
+                            /* The semaphore is a member of a queue set, and
+                             * posting to the queue set caused a higher priority
+                             * task to unblock.  A context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                        {
+                            if( xTaskRemoveFromEventListFromISR( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                            {
+                                /* The task waiting has a higher priority so
+                                 *  record that a context switch is required. */
+                                if( pxHigherPriorityTaskWoken != NULL )
+                                {
+                                    *pxHigherPriorityTaskWoken = pdTRUE;
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                #else /* configUSE_QUEUE_SETS */
+                {
+                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    {
+                        if( xTaskRemoveFromEventListFromISR( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            /* The task waiting has a higher priority so record that a
+                             * context switch is required. */
+                            if( pxHigherPriorityTaskWoken != NULL )
+                            {
+                                *pxHigherPriorityTaskWoken = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_SETS */
+            }
+            else
+            {
+                /* Increment the lock count so the task that unlocks the queue
+                 * knows that data was posted while it was locked. */
+                prvIncrementQueueTxLock( pxQueue, cTxLock );
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueRECORD_SEND_FAILED_FROM_ISR( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus );
+
+    traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_GIVE_FROM_ISR );
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueGiveMultipleFromISR( QueueHandle_t xQueue,
+                                      UBaseType_t uxCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    BaseType_t xYieldRequired = pdFALSE;
+    UBaseType_t uxSavedInterruptStatus;
+    UBaseType_t uxGiven;
+    Queue_t * const pxQueue = xQueue;
+
+    /* As xQueueGiveFromISR(), but adds uxCount to the count of a counting
+     * semaphore in one critical section, unblocking up to uxCount tasks. */
+
+    configASSERT( pxQueue );
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    /* A mutex cannot be given more than once. */
+    configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+    /* See the comment in xQueueGiveFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* The semaphore is either given uxCount times or not at all, so the
+         * caller never has to work out how many of the gives were lost. */
+        if( uxCount <= ( pxQueue->uxLength - uxMessagesWaiting ) )
+        {
+            const int8_t cTxLock = pxQueue->cTxLock;
+
+            traceQUEUE_SEND_FROM_ISR( pxQueue );
+
+            queueRECORD_LEVEL( pxQueue, uxMessagesWaiting + uxCount, uxCount, ( UBaseType_t ) 0 );
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting + uxCount;
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                #if ( configUSE_QUEUE_SETS == 1 )
+                    if( pxQueue->pxQueueSetContainer != NULL )
+                    {
+                        /* The queue set holds one entry for each give. */
+                        for( uxGiven = 0; uxGiven < uxCount; uxGiven++ )
+                        {
+                            if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    }
+                    else
+                #endif /* configUSE_QUEUE_SETS */
+                {
+                    /* Each give unblocks one waiting task, and the tasks are
+                     * removed from the event list highest priority first. */
+                    for( uxGiven = 0; uxGiven < uxCount; uxGiven++ )
+                    {
+                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            break;
+                        }
+
+                        if( xTaskRemoveFromEventListFromISR( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+            }
+            else
+            {
+                /* Increment the lock count once for each give, so the task
+                 * that unlocks the queue unblocks a task for each.  As in
+                 * prvIncrementQueueTxLock(), the count is capped at the number
+                 * of tasks. */
+                const UBaseType_t uxNumberOfTasks = uxTaskGetNumberOfTasks();
+
+                for( uxGiven = 0; ( uxGiven < uxCount ) && ( ( UBaseType_t ) pxQueue->cTxLock < uxNumberOfTasks ); uxGiven++ )
+                {
+                    configASSERT( pxQueue->cTxLock != queueINT8_MAX );
+                    pxQueue->cTxLock = ( int8_t ) ( pxQueue->cTxLock + ( int8_t ) 1 );
+                }
+            }
+
+            if( ( xYieldRequired != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+            {
+                *pxHigherPriorityTaskWoken = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdPASS;
+        }
+        else
+        {
+            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueRECORD_SEND_FAILED_FROM_ISR( pxQueue );
+            xReturn = errQUEUE_FULL;
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceive( QueueHandle_t xQueue,
+                          void * const pvBuffer,
+                          TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
+    traceBENCHMARK_API_ENTER( benchmarkAPI_QUEUE_RECEIVE );
+
+    /* Check the pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* The buffer into which data is received can only be NULL if the data size
+     * is zero (so no data is copied into the buffer). */
+    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvObjectLockedReceive( pxQueue, pvBuffer ) != pdFALSE )
+        {
+            /* No task was waiting to send, so none was unblocked. */
+            traceQUEUE_RECEIVE( pxQueue );
+            traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    #if ( configQUEUE_ASYNC_COPY_BYTES > 0 )
+    {
+        /* Items large enough to be worth offloading are copied out of the
+         * queue by the application's DMA engine when there is data available
+         * now.  Otherwise the item is received below. */
+        if( ( pxQueue->uxItemSize >= ( UBaseType_t ) configQUEUE_ASYNC_COPY_BYTES ) &&
+            ( !queueIS_PRIORITY_QUEUE( pxQueue ) ) &&
+            ( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING ) )
+        {
+            if( prvReceiveWithAsyncCopy( pxQueue, pvBuffer ) != pdFALSE )
+            {
+                traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                return pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configQUEUE_ASYNC_COPY_BYTES */
+
+    #if ( configQUEUE_LOW_LATENCY_COPY_BYTES > 0 )
+    {
+        /* Large items are copied out of the queue with interrupts enabled when
+         * there is data available now.  Otherwise the item is received below. */
+        if( ( pxQueue->uxItemSize >= ( UBaseType_t ) configQUEUE_LOW_LATENCY_COPY_BYTES ) &&
+            ( !queueIS_PRIORITY_QUEUE( pxQueue ) ) )
+        {
+            if( prvReceiveWithInterruptsEnabled( pxQueue, pvBuffer ) != pdFALSE )
+            {
+                traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                return pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configQUEUE_LOW_LATENCY_COPY_BYTES */
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( queueCAN_RECEIVE( pxQueue ) )
+            {
+                /* Data available, remove one item. */
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_RECEIVE( pxQueue );
+                queueRECORD_LEVEL( pxQueue, uxMessagesWaiting - ( UBaseType_t ) 1, ( UBaseType_t ) 0, ( UBaseType_t ) 1 );
+                pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+                queueSET_MEMBER_RECEIVED( pxQueue );
+
+                /* There is now space in the queue, were any tasks waiting to
+                 * post to the queue?  If so, unblock the highest priority waiting
+                 * task. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+                traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                return pdPASS;
+            }
+            else
+            {
+                #if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+                {
+                    /* A rendezvous channel is always empty, but the item of a
+                     * waiting sender can be copied straight into pvBuffer. */
+                    if( queueIS_RENDEZVOUS( pxQueue ) && ( prvTakeFromSender( pxQueue, pvBuffer ) != pdFALSE ) )
+                    {
+                        traceQUEUE_RECEIVE( pxQueue );
+                        queueEXIT_CRITICAL( pxQueue );
+                        traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                        return pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_QUEUE_RENDEZVOUS */
+
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    #if ( configUSE_QUEUE_DIRECT_BLOCKING == 1 )
+                    {
+                        /* The task was woken but another task or an interrupt
+                         * emptied the queue first.  Only now is the remaining
+                         * block time worked out. */
+                        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+                        {
+                            queueEXIT_CRITICAL( pxQueue );
+                            traceQUEUE_RECEIVE_FAILED( pxQueue );
+                            traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                            return errQUEUE_EMPTY;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                    #endif /* configUSE_QUEUE_DIRECT_BLOCKING */
+                }
+
+                #if ( configUSE_QUEUE_DIRECT_BLOCKING == 1 )
+                {
+                    /* Block without leaving the critical section, so the
+                     * queue cannot change between finding it empty and
+                     * joining the list of waiting tasks.  The yield takes
+                     * effect once the critical section is exited. */
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    queueSET_HANDOFF_BUFFER( pvBuffer );
+                    queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    queueBLOCK_START( xBlockStart );
+                    portYIELD_WITHIN_API();
+                }
+                #endif
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        #if ( configUSE_QUEUE_DIRECT_BLOCKING == 1 )
+        {
+            /* The task has been woken.  Unless a sender handed the item
+             * straight to this task, loop back to try to read the data. */
+            queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_RECEIVER );
+
+            if( queueHANDOFF_RECEIVED() != pdFALSE )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+                traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                return pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else
+        {
+            /* Interrupts and other tasks can send to and receive from the queue
+             * now the critical section has been exited. */
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                /* The timeout has not expired.  If the queue is still empty place
+                 * the task on the list of tasks waiting to receive from the queue. */
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                    queueSET_HANDOFF_BUFFER( pvBuffer );
+                    queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    queueBLOCK_START( xBlockStart );
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_RECEIVER );
+
+                    if( queueHANDOFF_RECEIVED() != pdFALSE )
+                    {
+                        /* A sender copied the item straight into pvBuffer. */
+                        traceQUEUE_RECEIVE( pxQueue );
+                        traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                        return pdPASS;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    /* The queue contains data again.  Loop back to try and read the
+                     * data. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If there is no data in the queue exit, otherwise loop
+                 * back and attempt to read the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE );
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        #endif /* configUSE_QUEUE_DIRECT_BLOCKING */
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
+                                TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
+    #if ( configUSE_MUTEXES == 1 )
+        BaseType_t xInheritanceOccurred = pdFALSE;
+    #endif
+
+    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configSEMAPHORE_SPIN_COUNT > 0 ) )
+        BaseType_t xSpin = pdFALSE;
+        UBaseType_t uxSpinCount;
+    #endif
+
+    traceBENCHMARK_API_ENTER( benchmarkAPI_SEMAPHORE_TAKE );
+
+    /* Check the queue pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* Check this really is a semaphore, in which case the item size will be
+     * 0. */
+    configASSERT( pxQueue->uxItemSize == 0 );
+
+    #if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+    {
+        if( prvSemaphoreFastTake( pxQueue ) != pdFALSE )
+        {
+            traceBENCHMARK_API_EXIT( benchmarkAPI_SEMAPHORE_TAKE );
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_SEMAPHORE_FAST_PATH */
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvObjectLockedReceive( pxQueue, NULL ) != pdFALSE )
+        {
+            /* A mutex never takes this path, so there is no holder to record. */
+            traceQUEUE_RECEIVE( pxQueue );
+            traceBENCHMARK_API_EXIT( benchmarkAPI_SEMAPHORE_TAKE );
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
+     * statements within the function itself.  This is done in the interest
+     * of execution time efficiency. */
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            /* Semaphores are queues with an item size of 0, and where the
+             * number of messages in the queue is the semaphore's count value. */
+            const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( uxSemaphoreCount > ( UBaseType_t ) 0 )
+            {
+                traceQUEUE_RECEIVE( pxQueue );
+
+                /* Semaphores are queues with a data size of zero and where the
+                 * messages waiting is the semaphore's count.  Reduce the count. */
+                queueRECORD_LEVEL( pxQueue, uxSemaphoreCount - ( UBaseType_t ) 1, ( UBaseType_t ) 0, ( UBaseType_t ) 1 );
+                pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+                queueSET_MEMBER_RECEIVED( pxQueue );
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    {
+                        /* Record the information required to implement
+                         * priority inheritance should it become necessary. */
+                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+
+                        #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+                        {
+                            if( pxQueue->uxCeilingPriority != tskIDLE_PRIORITY )
+                            {
+                                /* Raise the new holder to the ceiling now, so
+                                 * no task at or below the ceiling can preempt
+                                 * it and then block on the mutex. */
+                                vTaskPriorityRaiseToCeiling( pxQueue->uxCeilingPriority );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_MUTEXES */
+
+                /* Check to see if other tasks are blocked waiting to give the
+                 * semaphore, and if so, unblock the highest priority such task. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+                traceBENCHMARK_API_EXIT( benchmarkAPI_SEMAPHORE_TAKE );
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The semaphore count was 0 and no block time is specified
+                     * (or the block time has expired) so exit now. */
+                    queueEXIT_CRITICAL( pxQueue );
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceBENCHMARK_API_EXIT( benchmarkAPI_SEMAPHORE_TAKE );
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The semaphore count was 0 and a block time was specified
+                     * so configure the timeout structure ready to block. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+
+                    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configSEMAPHORE_SPIN_COUNT > 0 ) )
+                    {
+                        /* On the first attempt decide whether to spin before
+                         * blocking.  Spinning only helps a mutex if its holder
+                         * is running, so can give it back, on another core. */
+                        #if ( configUSE_MUTEXES == 1 )
+                            if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                            {
+                                xSpin = xTaskIsRunningOnOtherCore( pxQueue->u.xSemaphore.xMutexHolder );
+                            }
+                            else
+                        #endif /* configUSE_MUTEXES */
+                        {
+                            xSpin = pdTRUE;
+                        }
+                    }
+                    #endif /* if ( ( configNUMBER_OF_CORES > 1 ) && ( configSEMAPHORE_SPIN_COUNT > 0 ) ) */
+                }
+                else
+                {
+                    #if ( configUSE_QUEUE_DIRECT_BLOCKING == 1 )
+                    {
+                        /* The task was woken but the semaphore was taken by
+                         * another task or an interrupt first.  Only now is the
+                         * remaining block time worked out. */
+                        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE )
+                        {
+                            #if ( configUSE_MUTEXES == 1 )
+                            {
+                                /* As below, disinherit the priority this task
+                                 * lent the mutex holder. */
+                                if( xInheritanceOccurred != pdFALSE )
+                                {
+                                    vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, prvGetDisinheritPriorityAfterTimeout( pxQueue ) );
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+                            }
+                            #endif /* configUSE_MUTEXES */
+
+                            queueEXIT_CRITICAL( pxQueue );
+                            traceQUEUE_RECEIVE_FAILED( pxQueue );
+                            traceBENCHMARK_API_EXIT( benchmarkAPI_SEMAPHORE_TAKE );
+                            return errQUEUE_EMPTY;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else
+                    {
+                        /* Entry time was already set. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                    #endif /* configUSE_QUEUE_DIRECT_BLOCKING */
+                }
+
+                #if ( configUSE_QUEUE_DIRECT_BLOCKING == 1 )
+                {
+                    /* Block without leaving the critical section, as in
+                     * xQueueReceive(). */
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                    #if ( configUSE_MUTEXES == 1 )
+                    {
+                        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                        {
+                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            vTaskPlaceOnMutexEventList( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->u.xSemaphore.xMutexHolder ), xTicksToWait );
+                        }
+                        else
+                        {
+                            queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                        }
+                    }
+                    #else
+                    {
+                        queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    }
+                    #endif /* if ( configUSE_MUTEXES == 1 ) */
+
+                    queueBLOCK_START( xBlockStart );
+                    portYIELD_WITHIN_API();
+                }
+                #endif /* configUSE_QUEUE_DIRECT_BLOCKING */
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        #if ( configUSE_QUEUE_DIRECT_BLOCKING == 1 )
+        {
+            /* The task has been woken.  Loop back to try to take the
+             * semaphore. */
+            queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_RECEIVER );
+        }
+        #else
+        {
+
+            /* Interrupts and other tasks can give to and take from the semaphore
+             * now the critical section has been exited. */
+
+            #if ( ( configNUMBER_OF_CORES > 1 ) && ( configSEMAPHORE_SPIN_COUNT > 0 ) )
+            {
+                if( xSpin != pdFALSE )
+                {
+                    /* Poll the count for a bounded time, without entering a
+                     * critical section.  If the semaphore becomes available the
+                     * checks below find it and loop back to take it, so the two
+                     * context switches of blocking and being woken are avoided. */
+                    xSpin = pdFALSE;
+
+                    for( uxSpinCount = ( UBaseType_t ) 0U; uxSpinCount < ( UBaseType_t ) configSEMAPHORE_SPIN_COUNT; uxSpinCount++ )
+                    {
+                        if( pxQueue->uxMessagesWaiting != ( UBaseType_t ) 0 )
+                        {
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( ( configNUMBER_OF_CORES > 1 ) && ( configSEMAPHORE_SPIN_COUNT > 0 ) ) */
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                /* A block time is specified and not expired.  If the semaphore
+                 * count is 0 then enter the Blocked state to wait for a semaphore to
+                 * become available.  As semaphores are implemented with queues the
+                 * queue being empty is equivalent to the semaphore count being 0. */
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+
+                    #if ( configUSE_MUTEXES == 1 )
+                    {
+                        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                        {
+                            taskENTER_CRITICAL();
+                            {
+                                xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
+                            }
+                            taskEXIT_CRITICAL();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* if ( configUSE_MUTEXES == 1 ) */
 
-            traceQUEUE_SEND_FROM_ISR( pxQueue );
+                    #if ( configUSE_MUTEXES == 1 )
+                    {
+                        if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                        {
+                            vTaskPlaceOnMutexEventList( &( pxQueue->xTasksWaitingToReceive ), &( pxQueue->u.xSemaphore.xMutexHolder ), xTicksToWait );
+                        }
+                        else
+                        {
+                            queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                        }
+                    }
+                    #else
+                    {
+                        queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    }
+                    #endif /* if ( configUSE_MUTEXES == 1 ) */
+                    prvUnlockQueue( pxQueue );
 
-            /* Semaphores use xQueueGiveFromISR(), so pxQueue will not be a
-             *  semaphore or mutex.  That means prvCopyDataToQueue() cannot result
-             *  in a task disinheriting a priority and prvCopyDataToQueue() can be
-             *  called here even though the disinherit function does not check if
-             *  the scheduler is suspended before accessing the ready lists. */
-            ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+                    queueBLOCK_START( xBlockStart );
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-            /* The event list is not altered if the queue is locked.  This will
-             * be done when the queue is unlocked later. */
-            if( cTxLock == queueUNLOCKED )
+                    queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_RECEIVER );
+                }
+                else
+                {
+                    /* There was no timeout and the semaphore count was not 0, so
+                     * attempt to take the semaphore again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                /* If the semaphore count is 0 exit now as the timeout has
+                 * expired.  Otherwise return to attempt to take the semaphore that is
+                 * known to be available.  As semaphores are implemented by queues the
+                 * queue being empty is equivalent to the semaphore count being 0. */
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    #if ( configUSE_MUTEXES == 1 )
+                    {
+                        /* xInheritanceOccurred could only have be set if
+                         * pxQueue->uxQueueType == queueQUEUE_IS_MUTEX so no need to
+                         * test the mutex type again to check it is actually a mutex. */
+                        if( xInheritanceOccurred != pdFALSE )
+                        {
+                            taskENTER_CRITICAL();
+                            {
+                                UBaseType_t uxHighestWaitingPriority;
+
+                                /* This task blocking on the mutex caused another
+                                 * task to inherit this task's priority.  Now this task
+                                 * has timed out the priority should be disinherited
+                                 * again, but only as low as the next highest priority
+                                 * task that is waiting for the same mutex. */
+                                uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
+                                vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
+                            }
+                            taskEXIT_CRITICAL();
+                        }
+                    }
+                    #endif /* configUSE_MUTEXES */
+
+                    traceQUEUE_RECEIVE_FAILED( pxQueue );
+                    traceBENCHMARK_API_EXIT( benchmarkAPI_SEMAPHORE_TAKE );
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        #endif /* configUSE_QUEUE_DIRECT_BLOCKING */
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeek( QueueHandle_t xQueue,
+                       void * const pvBuffer,
+                       TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
+
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
+    /* Check the pointer is not NULL. */
+    configASSERT( ( pxQueue ) );
+
+    /* The buffer into which data is received can only be NULL if the data size
+     * is zero (so no data is copied into the buffer. */
+    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* A rendezvous channel never holds an item to peek at. */
+    configASSERT( !queueIS_RENDEZVOUS( pxQueue ) );
+
+    /* Cannot block if the scheduler is suspended. */
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904  This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+            /* Is there data in the queue now?  To be running the calling task
+             * must be the highest priority task wanting to access the queue. */
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                prvPeekDataFromQueue( pxQueue, pvBuffer );
+                traceQUEUE_PEEK( pxQueue );
+
+                /* The data is being left in the queue, so see if there are
+                 * any other tasks waiting for the data. */
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+                    {
+                        /* The task waiting has a higher priority than this task. */
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+                return pdPASS;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was empty and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+                    traceQUEUE_PEEK_FAILED( pxQueue );
+                    return errQUEUE_EMPTY;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was empty and a block time was specified so
+                     * configure the timeout structure ready to enter the blocked
+                     * state. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now that the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            /* Timeout has not expired yet, check to see if there is data in the
+            * queue now, and if not enter the Blocked state to wait for data. */
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                queueBLOCK_START( xBlockStart );
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_RECEIVER );
+            }
+            else
+            {
+                /* There is data in the queue now, so don't enter the blocked
+                 * state, instead return to try and obtain the data. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired.  If there is still no data in the queue
+             * exit, otherwise go back and try to read the data again. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            {
+                traceQUEUE_PEEK_FAILED( pxQueue );
+                return errQUEUE_EMPTY;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
+                                 void * const pvBuffer,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    traceBENCHMARK_API_ENTER( benchmarkAPI_QUEUE_RECEIVE_FROM_ISR );
+
+    configASSERT( pxQueue );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    #if ( configUSE_GRANULAR_LOCKS == 1 )
+    {
+        if( prvObjectLockedReceive( pxQueue, pvBuffer ) != pdFALSE )
+        {
+            /* No task was waiting to send, so *pxHigherPriorityTaskWoken is left unchanged. */
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+            traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE_FROM_ISR );
+            return pdPASS;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_GRANULAR_LOCKS */
+
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+
+        /* Cannot block in an ISR, so check there is data available. */
+        if( queueCAN_RECEIVE( pxQueue ) )
+        {
+            const int8_t cRxLock = pxQueue->cRxLock;
+
+            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+
+            prvCopyDataFromQueue( pxQueue, pvBuffer );
+            queueRECORD_LEVEL( pxQueue, uxMessagesWaiting - ( UBaseType_t ) 1, ( UBaseType_t ) 0, ( UBaseType_t ) 1 );
+            pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+            queueSET_MEMBER_RECEIVED( pxQueue );
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that an ISR has removed data while the queue was
+             * locked. */
+            if( cRxLock == queueUNLOCKED )
             {
-                #if ( configUSE_QUEUE_SETS == 1 )
+                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
                 {
-                    if( pxQueue->pxQueueSetContainer != NULL )
+                    if( xTaskRemoveFromEventListFromISR( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
                     {
-                        if( ( xCopyPosition == queueOVERWRITE ) && ( uxPreviousMessagesWaiting != ( UBaseType_t ) 0 ) )
-                        {
-                            /* Do not notify the queue set as an existing item
-                             * was overwritten in the queue so the number of items
-                             * in the queue has not changed. */
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                        else if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                        /* The task waiting has a higher priority than us so
+                         * force a context switch. */
+                        if( pxHigherPriorityTaskWoken != NULL )
                         {
-                            /* The queue is a member of a queue set, and posting
-                             * to the queue set caused a higher priority task to
-                             * unblock.  A context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
+                            *pxHigherPriorityTaskWoken = pdTRUE;
                         }
                         else
                         {
@@ -1126,108 +4004,46 @@ BaseType_t xQueueGenericSendFromISR( QueueHandle_t xQueue,
                     }
                     else
                     {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                        {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                            {
-                                /* The task waiting has a higher priority so
-                                 *  record that a context switch is required. */
-                                if( pxHigherPriorityTaskWoken != NULL )
-                                {
-                                    *pxHigherPriorityTaskWoken = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #else /* configUSE_QUEUE_SETS */
+                else
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                    {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                        {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    /* Not used in this path. */
-                    ( void ) uxPreviousMessagesWaiting;
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                #endif /* configUSE_QUEUE_SETS */
             }
             else
             {
                 /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was posted while it was locked. */
-                prvIncrementQueueTxLock( pxQueue, cTxLock );
+                 * knows that data was removed while it was locked. */
+                prvIncrementQueueRxLock( pxQueue, cRxLock );
             }
 
             xReturn = pdPASS;
         }
         else
         {
-            traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
-            xReturn = errQUEUE_FULL;
+            xReturn = pdFAIL;
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus );
 
+    traceBENCHMARK_API_EXIT( benchmarkAPI_QUEUE_RECEIVE_FROM_ISR );
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
-                              BaseType_t * const pxHigherPriorityTaskWoken )
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
+                              void * const pvBuffer )
 {
     BaseType_t xReturn;
     UBaseType_t uxSavedInterruptStatus;
     Queue_t * const pxQueue = xQueue;
 
-    /* Similar to xQueueGenericSendFromISR() but used with semaphores where the
-     * item size is 0.  Don't directly wake a task that was blocked on a queue
-     * read, instead return a flag to say whether a context switch is required or
-     * not (i.e. has a task with a higher priority than us been woken by this
-     * post). */
-
     configASSERT( pxQueue );
-
-    /* xQueueGenericSendFromISR() should be used instead of xQueueGiveFromISR()
-     * if the item size is not 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
-
-    /* Normally a mutex would not be given from an interrupt, especially if
-     * there is a mutex holder, as priority inheritance makes no sense for an
-     * interrupts, only tasks. */
-    configASSERT( !( ( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX ) && ( pxQueue->u.xSemaphore.xMutexHolder != NULL ) ) );
+    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
 
     /* RTOS ports that support interrupt nesting have the concept of a maximum
      * system call (or maximum API call) interrupt priority.  Interrupts that are
@@ -1245,148 +4061,252 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue,
      * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
     portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue );
     {
-        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        /* Cannot block in an ISR, so check there is data available. */
+        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+        {
+            traceQUEUE_PEEK_FROM_ISR( pxQueue );
 
-        /* When the queue is used to implement a semaphore no data is ever
-         * moved through the queue but it is still valid to see if the queue 'has
-         * space'. */
-        if( uxMessagesWaiting < pxQueue->uxLength )
+            prvPeekDataFromQueue( pxQueue, pvBuffer );
+
+            xReturn = pdPASS;
+        }
+        else
         {
-            const int8_t cTxLock = pxQueue->cTxLock;
+            xReturn = pdFAIL;
+            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus );
 
-            traceQUEUE_SEND_FROM_ISR( pxQueue );
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
 
-            /* A task can only have an inherited priority if it is a mutex
-             * holder - and if there is a mutex holder then the mutex cannot be
-             * given from an ISR.  As this is the ISR version of the function it
-             * can be assumed there is no mutex holder and no need to determine if
-             * priority disinheritance is needed.  Simply increase the count of
-             * messages (semaphores) available. */
-            pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue,
+                               const void * const pvItems,
+                               UBaseType_t uxItemCount,
+                               TickType_t xTicksToWait )
+{
+    BaseType_t xEntryTimeSet = pdFALSE;
+    UBaseType_t uxItemsSent;
+    TimeOut_t xTimeOut;
+    Queue_t * const pxQueue = xQueue;
 
-            /* The event list is not altered if the queue is locked.  This will
-             * be done when the queue is unlocked later. */
-            if( cTxLock == queueUNLOCKED )
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
+    configASSERT( pxQueue );
+    configASSERT( pvItems );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0U );
+
+    /* Semaphores are given one at a time, and rendezvous channels transfer
+     * one item at a time. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    configASSERT( !queueIS_RENDEZVOUS( pxQueue ) );
+    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    {
+        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+    }
+    #endif
+
+    /*lint -save -e904 This function relaxes the coding standard somewhat to
+     * allow return statements within the function itself.  This is done in the
+     * interest of execution time efficiency. */
+    for( ; ; )
+    {
+        queueENTER_CRITICAL( pxQueue );
+        {
+            /* Is there room for at least one item on the queue now? */
+            if( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) )
             {
-                #if ( configUSE_QUEUE_SETS == 1 )
+                uxItemsSent = prvCopyItemsToQueue( pxQueue, pvItems, uxItemCount );
+                traceQUEUE_SEND_MULTIPLE( pxQueue, uxItemsSent );
+
+                if( prvUnblockTasksWaitingToReceive( pxQueue, uxItemsSent ) != pdFALSE )
                 {
-                    if( pxQueue->pxQueueSetContainer != NULL )
-                    {
-                        if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
-                        {
-                            /* The semaphore is a member of a queue set, and
-                             * posting to the queue set caused a higher priority
-                             * task to unblock.  A context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
-                        {
-                            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                            {
-                                /* The task waiting has a higher priority so
-                                 *  record that a context switch is required. */
-                                if( pxHigherPriorityTaskWoken != NULL )
-                                {
-                                    *pxHigherPriorityTaskWoken = pdTRUE;
-                                }
-                                else
-                                {
-                                    mtCOVERAGE_TEST_MARKER();
-                                }
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
+                    /* Yes it is ok to do this from within the critical section -
+                     * the kernel takes care of that. */
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                queueEXIT_CRITICAL( pxQueue );
+                return ( BaseType_t ) uxItemsSent;
+            }
+            else
+            {
+                if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* The queue was full and no block time is specified (or
+                     * the block time has expired) so leave now. */
+                    queueEXIT_CRITICAL( pxQueue );
+
+                    traceQUEUE_SEND_FAILED( pxQueue );
+                    queueRECORD_SEND_FAILED( pxQueue );
+                    return errQUEUE_FULL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    /* The queue was full and a block time was specified so
+                     * configure the timeout structure. */
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        queueEXIT_CRITICAL( pxQueue );
+
+        /* Interrupts and other tasks can send to and receive from the queue
+         * now the critical section has been exited. */
+
+        vTaskSuspendAll();
+        prvLockQueue( pxQueue );
+
+        /* Update the timeout state to see if it has expired yet. */
+        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        {
+            if( prvIsQueueFull( pxQueue ) != pdFALSE )
+            {
+                traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                prvUnlockQueue( pxQueue );
+
+                queueBLOCK_START( xBlockStart );
+                if( xTaskResumeAll() == pdFALSE )
+                {
+                    portYIELD_WITHIN_API();
                 }
-                #else /* configUSE_QUEUE_SETS */
+
+                queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_SENDER );
+            }
+            else
+            {
+                /* Try again. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+            }
+        }
+        else
+        {
+            /* The timeout has expired. */
+            prvUnlockQueue( pxQueue );
+            ( void ) xTaskResumeAll();
+
+            traceQUEUE_SEND_FAILED( pxQueue );
+            queueRECORD_SEND_FAILED( pxQueue );
+            return errQUEUE_FULL;
+        }
+    } /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue,
+                                      const void * const pvItems,
+                                      UBaseType_t uxItemCount,
+                                      BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    BaseType_t xReturn;
+    UBaseType_t uxItemsSent;
+    UBaseType_t uxSavedInterruptStatus;
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItems );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0U );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+    /* See the comments in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        if( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) )
+        {
+            int8_t cTxLock = pxQueue->cTxLock;
+
+            uxItemsSent = prvCopyItemsToQueue( pxQueue, pvItems, uxItemCount );
+            traceQUEUE_SEND_MULTIPLE_FROM_ISR( pxQueue, uxItemsSent );
+            xReturn = ( BaseType_t ) uxItemsSent;
+
+            /* The event list is not altered if the queue is locked.  This will
+             * be done when the queue is unlocked later. */
+            if( cTxLock == queueUNLOCKED )
+            {
+                if( prvUnblockTasksWaitingToReceive( pxQueue, uxItemsSent ) != pdFALSE )
                 {
-                    if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                    if( pxHigherPriorityTaskWoken != NULL )
                     {
-                        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                        {
-                            /* The task waiting has a higher priority so record that a
-                             * context switch is required. */
-                            if( pxHigherPriorityTaskWoken != NULL )
-                            {
-                                *pxHigherPriorityTaskWoken = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        *pxHigherPriorityTaskWoken = pdTRUE;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #endif /* configUSE_QUEUE_SETS */
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was posted while it was locked. */
-                prvIncrementQueueTxLock( pxQueue, cTxLock );
+                /* Increment the lock count once per item so the task that
+                 * unlocks the queue knows how much data was posted while it
+                 * was locked. */
+                while( uxItemsSent > ( UBaseType_t ) 0U )
+                {
+                    prvIncrementQueueTxLock( pxQueue, cTxLock );
+                    cTxLock = pxQueue->cTxLock;
+                    uxItemsSent--;
+                }
             }
-
-            xReturn = pdPASS;
         }
         else
         {
             traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+            queueRECORD_SEND_FAILED_FROM_ISR( pxQueue );
             xReturn = errQUEUE_FULL;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueReceive( QueueHandle_t xQueue,
-                          void * const pvBuffer,
-                          TickType_t xTicksToWait )
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue,
+                                  void * const pvBuffer,
+                                  UBaseType_t uxItemCount,
+                                  TickType_t xTicksToWait )
 {
     BaseType_t xEntryTimeSet = pdFALSE;
+    UBaseType_t uxItemsReceived;
     TimeOut_t xTimeOut;
     Queue_t * const pxQueue = xQueue;
 
-    /* Check the pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+    #if ( configUSE_QUEUE_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
 
-    /* The buffer into which data is received can only be NULL if the data size
-     * is zero (so no data is copied into the buffer). */
-    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0U );
 
-    /* Cannot block if the scheduler is suspended. */
+    /* Semaphores are taken one at a time, and rendezvous channels transfer
+     * one item at a time. */
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+    configASSERT( !queueIS_RENDEZVOUS( pxQueue ) );
     #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
     {
         configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
@@ -1398,40 +4318,25 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
      * interest of execution time efficiency. */
     for( ; ; )
     {
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( pxQueue );
         {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
-
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            /* Is there data in the queue now? */
+            if( queueCAN_RECEIVE( pxQueue ) )
             {
-                /* Data available, remove one item. */
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_RECEIVE( pxQueue );
-                pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
+                uxItemsReceived = prvCopyItemsFromQueue( pxQueue, pvBuffer, uxItemCount );
+                traceQUEUE_RECEIVE_MULTIPLE( pxQueue, uxItemsReceived );
 
-                /* There is now space in the queue, were any tasks waiting to
-                 * post to the queue?  If so, unblock the highest priority waiting
-                 * task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                if( prvUnblockTasksWaitingToSend( pxQueue, uxItemsReceived ) != pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        queueYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    queueYIELD_IF_USING_PREEMPTION();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                taskEXIT_CRITICAL();
-                return pdPASS;
+                queueEXIT_CRITICAL( pxQueue );
+                return ( BaseType_t ) uxItemsReceived;
             }
             else
             {
@@ -1439,7 +4344,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 {
                     /* The queue was empty and no block time is specified (or
                      * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
+                    queueEXIT_CRITICAL( pxQueue );
                     traceQUEUE_RECEIVE_FAILED( pxQueue );
                     return errQUEUE_EMPTY;
                 }
@@ -1457,7 +4362,7 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 }
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
 
         /* Interrupts and other tasks can send to and receive from the queue
          * now the critical section has been exited. */
@@ -1473,9 +4378,10 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
             if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
             {
                 traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
                 prvUnlockQueue( pxQueue );
 
+                queueBLOCK_START( xBlockStart );
                 if( xTaskResumeAll() == pdFALSE )
                 {
                     portYIELD_WITHIN_API();
@@ -1484,6 +4390,8 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_RECEIVER );
             }
             else
             {
@@ -1514,513 +4422,814 @@ BaseType_t xQueueReceive( QueueHandle_t xQueue,
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueueSemaphoreTake( QueueHandle_t xQueue,
-                                TickType_t xTicksToWait )
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue,
+                                         void * const pvBuffer,
+                                         UBaseType_t uxItemCount,
+                                         BaseType_t * const pxHigherPriorityTaskWoken )
 {
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
+    BaseType_t xReturn;
+    UBaseType_t uxItemsReceived;
+    UBaseType_t uxSavedInterruptStatus;
     Queue_t * const pxQueue = xQueue;
 
-    #if ( configUSE_MUTEXES == 1 )
-        BaseType_t xInheritanceOccurred = pdFALSE;
-    #endif
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+    configASSERT( uxItemCount > ( UBaseType_t ) 0U );
+    configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
 
-    /* Check the queue pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+    /* See the comments in xQueueGenericSendFromISR(). */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-    /* Check this really is a semaphore, in which case the item size will be
-     * 0. */
-    configASSERT( pxQueue->uxItemSize == 0 );
+    uxSavedInterruptStatus = queueENTER_CRITICAL_FROM_ISR( pxQueue );
+    {
+        /* Cannot block in an ISR, so check there is data available. */
+        if( queueCAN_RECEIVE( pxQueue ) )
+        {
+            int8_t cRxLock = pxQueue->cRxLock;
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+            uxItemsReceived = prvCopyItemsFromQueue( pxQueue, pvBuffer, uxItemCount );
+            traceQUEUE_RECEIVE_MULTIPLE_FROM_ISR( pxQueue, uxItemsReceived );
+            xReturn = ( BaseType_t ) uxItemsReceived;
+
+            /* If the queue is locked the event list will not be modified.
+             * Instead update the lock count so the task that unlocks the queue
+             * will know that ISRs have removed data while the queue was
+             * locked. */
+            if( cRxLock == queueUNLOCKED )
+            {
+                if( prvUnblockTasksWaitingToSend( pxQueue, uxItemsReceived ) != pdFALSE )
+                {
+                    if( pxHigherPriorityTaskWoken != NULL )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                while( uxItemsReceived > ( UBaseType_t ) 0U )
+                {
+                    prvIncrementQueueRxLock( pxQueue, cRxLock );
+                    cRxLock = pxQueue->cRxLock;
+                    uxItemsReceived--;
+                }
+            }
+        }
+        else
+        {
+            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            xReturn = errQUEUE_EMPTY;
+        }
+    }
+    queueEXIT_CRITICAL_FROM_ISR( pxQueue, uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_ZERO_COPY == 1 )
+
+    static BaseType_t prvCommitWriteSlot( Queue_t * const pxQueue )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        BaseType_t xYieldRequired = pdFALSE;
+
+        traceQUEUE_SEND( pxQueue );
+
+        /* The item is already in place, so just add it to the back of
+         * the queue as prvCopyDataToQueue() would. */
+        pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->pcWriteTo = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        queueRECORD_LEVEL( pxQueue, pxQueue->uxMessagesWaiting + ( UBaseType_t ) 1, ( UBaseType_t ) 1, ( UBaseType_t ) 0 );
+        pxQueue->uxMessagesWaiting++;
+        pxQueue->ucSlotsHeld &= ( uint8_t ) ~queueWRITE_SLOT_HELD;
+
+        #if ( configUSE_QUEUE_SETS == 1 )
+            if( pxQueue->pxQueueSetContainer != NULL )
+            {
+                xYieldRequired = prvNotifyQueueSetContainer( pxQueue );
+            }
+            else
+        #endif /* configUSE_QUEUE_SETS */
+        {
+            /* If there was a task waiting for data to arrive on the
+             * queue then unblock it now. */
+            if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+            {
+                xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        /* A task may have been blocked only because the slot was held,
+         * so unblock a sending task if there is still space. */
+        if( ( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) ) &&
+            ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+        {
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xYieldRequired;
     }
-    #endif
+/*-----------------------------------------------------------*/
 
-    /*lint -save -e904 This function relaxes the coding standard somewhat to allow return
-     * statements within the function itself.  This is done in the interest
-     * of execution time efficiency. */
-    for( ; ; )
+    static BaseType_t prvReleaseReadSlot( Queue_t * const pxQueue )
     {
-        taskENTER_CRITICAL();
+        BaseType_t xYieldRequired = pdFALSE;
+
+        /* Remove the item from the front of the queue as
+         * prvCopyDataFromQueue() would, but without the copy. */
+        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        traceQUEUE_RECEIVE( pxQueue );
+        queueRECORD_LEVEL( pxQueue, pxQueue->uxMessagesWaiting - ( UBaseType_t ) 1, ( UBaseType_t ) 0, ( UBaseType_t ) 1 );
+        pxQueue->uxMessagesWaiting--;
+        pxQueue->ucSlotsHeld &= ( uint8_t ) ~queueREAD_SLOT_HELD;
+        queueSET_MEMBER_RECEIVED( pxQueue );
+
+        /* There is now space in the queue, were any tasks waiting to
+         * post to the queue?  If so, unblock the highest priority waiting
+         * task. */
+        if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+        {
+            xYieldRequired = xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* A task may have been blocked only because the slot was held,
+         * so unblock a receiving task if there is more data. */
+        if( ( queueCAN_RECEIVE( pxQueue ) ) &&
+            ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
+        {
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+            {
+                xYieldRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xYieldRequired;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueAcquireSlot( QueueHandle_t xQueue,
+                                  void ** const ppvSlot,
+                                  TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * const pxQueue = xQueue;
+
+        #if ( configUSE_QUEUE_STATS == 1 )
+            TickType_t xBlockStart;
+        #endif
+
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+
+        /* Items in a priority queue are not stored in order. */
+        configASSERT( !queueIS_PRIORITY_QUEUE( pxQueue ) );
+
+        /* Semaphores and rendezvous channels do not have any storage to hand
+         * out. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( !queueIS_RENDEZVOUS( pxQueue ) );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            /* Semaphores are queues with an item size of 0, and where the
-             * number of messages in the queue is the semaphore's count value. */
-            const UBaseType_t uxSemaphoreCount = pxQueue->uxMessagesWaiting;
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
 
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxSemaphoreCount > ( UBaseType_t ) 0 )
+        /*lint -save -e904 This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
             {
-                traceQUEUE_RECEIVE( pxQueue );
-
-                /* Semaphores are queues with a data size of zero and where the
-                 * messages waiting is the semaphore's count.  Reduce the count. */
-                pxQueue->uxMessagesWaiting = uxSemaphoreCount - ( UBaseType_t ) 1;
+                /* Is there a free slot at the back of the queue, and is no other
+                 * task already holding it? */
+                if( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) )
+                {
+                    /* The slot is not added to the queue until it is committed,
+                     * so pcWriteTo is left unchanged. */
+                    *ppvSlot = ( void * ) pxQueue->pcWriteTo;
+                    pxQueue->ucSlotsHeld |= queueWRITE_SLOT_HELD;
 
-                #if ( configUSE_MUTEXES == 1 )
+                    queueEXIT_CRITICAL( pxQueue );
+                    return pdPASS;
+                }
+                else
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    if( xTicksToWait == ( TickType_t ) 0 )
                     {
-                        /* Record the information required to implement
-                         * priority inheritance should it become necessary. */
-                        pxQueue->u.xSemaphore.xMutexHolder = pvTaskIncrementMutexHeldCount();
+                        /* No slot is free and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+
+                        traceQUEUE_SEND_FAILED( pxQueue );
+                        queueRECORD_SEND_FAILED( pxQueue );
+                        return errQUEUE_FULL;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* No slot is free and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
                     }
                     else
                     {
+                        /* Entry time was already set. */
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #endif /* configUSE_MUTEXES */
+            }
+            queueEXIT_CRITICAL( pxQueue );
 
-                /* Check to see if other tasks are blocked waiting to give the
-                 * semaphore, and if so, unblock the highest priority such task. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+            /* Interrupts and other tasks can send to and receive from the queue
+             * now the critical section has been exited. */
+
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueFull( pxQueue ) != pdFALSE )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        queueYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
+                    traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+                    queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    queueBLOCK_START( xBlockStart );
+                    if( xTaskResumeAll() == pdFALSE )
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        portYIELD_WITHIN_API();
                     }
+
+                    queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_SENDER );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Try again. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
                 }
-
-                taskEXIT_CRITICAL();
-                return pdPASS;
             }
             else
             {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The semaphore count was 0 and no block time is specified
-                     * (or the block time has expired) so exit now. */
-                    taskEXIT_CRITICAL();
-                    traceQUEUE_RECEIVE_FAILED( pxQueue );
-                    return errQUEUE_EMPTY;
-                }
-                else if( xEntryTimeSet == pdFALSE )
+                /* The timeout has expired. */
+                prvUnlockQueue( pxQueue );
+                ( void ) xTaskResumeAll();
+
+                traceQUEUE_SEND_FAILED( pxQueue );
+                queueRECORD_SEND_FAILED( pxQueue );
+                return errQUEUE_FULL;
+            }
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueCommitSlot( QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xYieldRequired = pdFALSE;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        queueENTER_CRITICAL( pxQueue );
+        {
+            /* Only the task that acquired the slot may commit it. */
+            configASSERT( ( pxQueue->ucSlotsHeld & queueWRITE_SLOT_HELD ) != 0U );
+
+            if( ( pxQueue->ucSlotsHeld & queueWRITE_SLOT_HELD ) != 0U )
+            {
+                xYieldRequired = prvCommitWriteSlot( pxQueue );
+
+                if( xYieldRequired != pdFALSE )
                 {
-                    /* The semaphore count was 0 and a block time was specified
-                     * so configure the timeout structure ready to block. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
+                    /* Yes it is ok to do this from within the critical section -
+                     * the kernel takes care of that. */
+                    queueYIELD_IF_USING_PREEMPTION();
                 }
                 else
                 {
-                    /* Entry time was already set. */
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( pxQueue );
 
-        /* Interrupts and other tasks can give to and take from the semaphore
-         * now the critical section has been exited. */
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
 
-        vTaskSuspendAll();
-        prvLockQueue( pxQueue );
+    BaseType_t xQueuePeekSlot( QueueHandle_t xQueue,
+                               void ** const ppvSlot,
+                               TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        int8_t * pcSlot;
+        Queue_t * const pxQueue = xQueue;
 
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+        #if ( configUSE_QUEUE_STATS == 1 )
+            TickType_t xBlockStart;
+        #endif
+
+        configASSERT( pxQueue );
+        configASSERT( ppvSlot );
+
+        /* Items in a priority queue are not stored in order. */
+        configASSERT( !queueIS_PRIORITY_QUEUE( pxQueue ) );
+
+        /* Semaphores and rendezvous channels do not have any storage to hand
+         * out. */
+        configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+        configASSERT( !queueIS_RENDEZVOUS( pxQueue ) );
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
         {
-            /* A block time is specified and not expired.  If the semaphore
-             * count is 0 then enter the Blocked state to wait for a semaphore to
-             * become available.  As semaphores are implemented with queues the
-             * queue being empty is equivalent to the semaphore count being 0. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            queueENTER_CRITICAL( pxQueue );
             {
-                traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+                /* Is there data in the queue now, and is no other task already
+                 * holding the item at its front? */
+                if( queueCAN_RECEIVE( pxQueue ) )
+                {
+                    /* The item is not removed from the queue until the slot is
+                     * released, so pcReadFrom is left unchanged. */
+                    pcSlot = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
-                #if ( configUSE_MUTEXES == 1 )
+                    if( pcSlot >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+                    {
+                        pcSlot = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceQUEUE_PEEK( pxQueue );
+                    *ppvSlot = ( void * ) pcSlot;
+                    pxQueue->ucSlotsHeld |= queueREAD_SLOT_HELD;
+
+                    queueEXIT_CRITICAL( pxQueue );
+                    return pdPASS;
+                }
+                else
                 {
-                    if( pxQueue->uxQueueType == queueQUEUE_IS_MUTEX )
+                    if( xTicksToWait == ( TickType_t ) 0 )
                     {
-                        taskENTER_CRITICAL();
-                        {
-                            xInheritanceOccurred = xTaskPriorityInherit( pxQueue->u.xSemaphore.xMutexHolder );
-                        }
-                        taskEXIT_CRITICAL();
+                        /* The queue was empty and no block time is specified (or
+                         * the block time has expired) so leave now. */
+                        queueEXIT_CRITICAL( pxQueue );
+                        traceQUEUE_PEEK_FAILED( pxQueue );
+                        return errQUEUE_EMPTY;
+                    }
+                    else if( xEntryTimeSet == pdFALSE )
+                    {
+                        /* The queue was empty and a block time was specified so
+                         * configure the timeout structure. */
+                        vTaskInternalSetTimeOutState( &xTimeOut );
+                        xEntryTimeSet = pdTRUE;
                     }
                     else
                     {
+                        /* Entry time was already set. */
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
+            }
+            queueEXIT_CRITICAL( pxQueue );
 
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
-                prvUnlockQueue( pxQueue );
+            /* Interrupts and other tasks can send to and receive from the queue
+             * now the critical section has been exited. */
 
-                if( xTaskResumeAll() == pdFALSE )
+            vTaskSuspendAll();
+            prvLockQueue( pxQueue );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
                 {
-                    portYIELD_WITHIN_API();
+                    traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
+                    queuePLACE_ON_EVENT_LIST( pxQueue, &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+                    prvUnlockQueue( pxQueue );
+
+                    queueBLOCK_START( xBlockStart );
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    queueBLOCK_END( pxQueue, xBlockStart, queueSTATS_RECEIVER );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The queue contains data again.  Loop back to try and read
+                     * the data. */
+                    prvUnlockQueue( pxQueue );
+                    ( void ) xTaskResumeAll();
                 }
             }
             else
             {
-                /* There was no timeout and the semaphore count was not 0, so
-                 * attempt to take the semaphore again. */
+                /* Timed out.  If there is no data in the queue exit, otherwise
+                 * loop back and attempt to read the data. */
                 prvUnlockQueue( pxQueue );
                 ( void ) xTaskResumeAll();
+
+                if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+                {
+                    traceQUEUE_PEEK_FAILED( pxQueue );
+                    return errQUEUE_EMPTY;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-        }
-        else
+        } /*lint -restore */
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xQueueReleaseSlot( QueueHandle_t xQueue )
+    {
+        BaseType_t xReturn = pdFAIL;
+        BaseType_t xYieldRequired = pdFALSE;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        queueENTER_CRITICAL( pxQueue );
         {
-            /* Timed out. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
+            /* Only the task that peeked the slot may release it. */
+            configASSERT( ( pxQueue->ucSlotsHeld & queueREAD_SLOT_HELD ) != 0U );
 
-            /* If the semaphore count is 0 exit now as the timeout has
-             * expired.  Otherwise return to attempt to take the semaphore that is
-             * known to be available.  As semaphores are implemented by queues the
-             * queue being empty is equivalent to the semaphore count being 0. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            if( ( pxQueue->ucSlotsHeld & queueREAD_SLOT_HELD ) != 0U )
             {
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    /* xInheritanceOccurred could only have be set if
-                     * pxQueue->uxQueueType == queueQUEUE_IS_MUTEX so no need to
-                     * test the mutex type again to check it is actually a mutex. */
-                    if( xInheritanceOccurred != pdFALSE )
-                    {
-                        taskENTER_CRITICAL();
-                        {
-                            UBaseType_t uxHighestWaitingPriority;
+                xYieldRequired = prvReleaseReadSlot( pxQueue );
 
-                            /* This task blocking on the mutex caused another
-                             * task to inherit this task's priority.  Now this task
-                             * has timed out the priority should be disinherited
-                             * again, but only as low as the next highest priority
-                             * task that is waiting for the same mutex. */
-                            uxHighestWaitingPriority = prvGetDisinheritPriorityAfterTimeout( pxQueue );
-                            vTaskPriorityDisinheritAfterTimeout( pxQueue->u.xSemaphore.xMutexHolder, uxHighestWaitingPriority );
-                        }
-                        taskEXIT_CRITICAL();
-                    }
+                if( xYieldRequired != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                #endif /* configUSE_MUTEXES */
 
-                traceQUEUE_RECEIVE_FAILED( pxQueue );
-                return errQUEUE_EMPTY;
+                xReturn = pdPASS;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-    } /*lint -restore */
-}
-/*-----------------------------------------------------------*/
+        queueEXIT_CRITICAL( pxQueue );
 
-BaseType_t xQueuePeek( QueueHandle_t xQueue,
-                       void * const pvBuffer,
-                       TickType_t xTicksToWait )
-{
-    BaseType_t xEntryTimeSet = pdFALSE;
-    TimeOut_t xTimeOut;
-    int8_t * pcOriginalReadPosition;
-    Queue_t * const pxQueue = xQueue;
+        return xReturn;
+    }
 
-    /* Check the pointer is not NULL. */
-    configASSERT( ( pxQueue ) );
+#endif /* configUSE_QUEUE_ZERO_COPY */
+/*-----------------------------------------------------------*/
 
-    /* The buffer into which data is received can only be NULL if the data size
-     * is zero (so no data is copied into the buffer. */
-    configASSERT( !( ( ( pvBuffer ) == NULL ) && ( ( pxQueue )->uxItemSize != ( UBaseType_t ) 0U ) ) );
+#if ( configQUEUE_LOW_LATENCY_COPY_BYTES > 0 )
 
-    /* Cannot block if the scheduler is suspended. */
-    #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+    static BaseType_t prvSendWithInterruptsEnabled( Queue_t * const pxQueue,
+                                                    const void * const pvItemToQueue )
     {
-        configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
-    }
-    #endif
+        int8_t * pcSlot = NULL;
 
-    /*lint -save -e904  This function relaxes the coding standard somewhat to
-     * allow return statements within the function itself.  This is done in the
-     * interest of execution time efficiency. */
-    for( ; ; )
-    {
-        taskENTER_CRITICAL();
+        /* With the scheduler suspended no other task on this core can run and
+         * find the slot held, so holding it cannot cause a priority inversion.
+         * Interrupts, and tasks on other cores, that try to use the slot while
+         * it is held find the queue full. */
+        vTaskSuspendAll();
         {
-            const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
-
-            /* Is there data in the queue now?  To be running the calling task
-             * must be the highest priority task wanting to access the queue. */
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            queueENTER_CRITICAL( pxQueue );
             {
-                /* Remember the read position so it can be reset after the data
-                 * is read from the queue as this function is only peeking the
-                 * data, not removing it. */
-                pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-
-                prvCopyDataFromQueue( pxQueue, pvBuffer );
-                traceQUEUE_PEEK( pxQueue );
-
-                /* The data is not being removed, so reset the read pointer. */
-                pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
-
-                /* The data is being left in the queue, so see if there are
-                 * any other tasks waiting for the data. */
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE )
+                if( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) )
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority than this task. */
-                        queueYIELD_IF_USING_PREEMPTION();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    pcSlot = pxQueue->pcWriteTo;
+                    pxQueue->ucSlotsHeld |= queueWRITE_SLOT_HELD;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-
-                taskEXIT_CRITICAL();
-                return pdPASS;
             }
-            else
+            queueEXIT_CRITICAL( pxQueue );
+
+            if( pcSlot != NULL )
             {
-                if( xTicksToWait == ( TickType_t ) 0 )
-                {
-                    /* The queue was empty and no block time is specified (or
-                     * the block time has expired) so leave now. */
-                    taskEXIT_CRITICAL();
-                    traceQUEUE_PEEK_FAILED( pxQueue );
-                    return errQUEUE_EMPTY;
-                }
-                else if( xEntryTimeSet == pdFALSE )
-                {
-                    /* The queue was empty and a block time was specified so
-                     * configure the timeout structure ready to enter the blocked
-                     * state. */
-                    vTaskInternalSetTimeOutState( &xTimeOut );
-                    xEntryTimeSet = pdTRUE;
-                }
-                else
+                queueCOPY_ITEM( pxQueue, ( void * ) pcSlot, pvItemToQueue ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0. */
+
+                /* Any task unblocked by the commit is held in the pending
+                 * ready list until the scheduler is resumed, which then yields
+                 * if necessary. */
+                queueENTER_CRITICAL( pxQueue );
                 {
-                    /* Entry time was already set. */
-                    mtCOVERAGE_TEST_MARKER();
+                    ( void ) prvCommitWriteSlot( pxQueue );
                 }
+                queueEXIT_CRITICAL( pxQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
+        ( void ) xTaskResumeAll();
+
+        return ( pcSlot != NULL ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
 
-        /* Interrupts and other tasks can send to and receive from the queue
-         * now that the critical section has been exited. */
+    static BaseType_t prvReceiveWithInterruptsEnabled( Queue_t * const pxQueue,
+                                                       void * const pvBuffer )
+    {
+        int8_t * pcSlot = NULL;
 
         vTaskSuspendAll();
-        prvLockQueue( pxQueue );
-
-        /* Update the timeout state to see if it has expired yet. */
-        if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
         {
-            /* Timeout has not expired yet, check to see if there is data in the
-            * queue now, and if not enter the Blocked state to wait for data. */
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+            queueENTER_CRITICAL( pxQueue );
             {
-                traceBLOCKING_ON_QUEUE_PEEK( pxQueue );
-                vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
-                prvUnlockQueue( pxQueue );
-
-                if( xTaskResumeAll() == pdFALSE )
+                if( queueCAN_RECEIVE( pxQueue ) )
                 {
-                    portYIELD_WITHIN_API();
+                    pcSlot = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                    if( pcSlot >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+                    {
+                        pcSlot = pxQueue->pcHead;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxQueue->ucSlotsHeld |= queueREAD_SLOT_HELD;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
+            queueEXIT_CRITICAL( pxQueue );
+
+            if( pcSlot != NULL )
+            {
+                queueCOPY_ITEM( pxQueue, pvBuffer, ( void * ) pcSlot ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+
+                queueENTER_CRITICAL( pxQueue );
+                {
+                    ( void ) prvReleaseReadSlot( pxQueue );
+                }
+                queueEXIT_CRITICAL( pxQueue );
+            }
             else
             {
-                /* There is data in the queue now, so don't enter the blocked
-                 * state, instead return to try and obtain the data. */
-                prvUnlockQueue( pxQueue );
-                ( void ) xTaskResumeAll();
+                mtCOVERAGE_TEST_MARKER();
             }
         }
+        ( void ) xTaskResumeAll();
+
+        return ( pcSlot != NULL ) ? pdTRUE : pdFALSE;
+    }
+
+#endif /* configQUEUE_LOW_LATENCY_COPY_BYTES */
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_ASYNC_COPY_BYTES > 0 )
+
+    static void prvCopyAsync( void * pvDestination,
+                              const void * pvSource,
+                              size_t xBytes )
+    {
+        /* Discard a notification left at the index, so only the completion of
+         * this copy unblocks the task. */
+        ( void ) xTaskNotifyStateClearIndexed( NULL, configQUEUE_ASYNC_COPY_NOTIFY_INDEX );
+        ( void ) ulTaskNotifyValueClearIndexed( NULL, configQUEUE_ASYNC_COPY_NOTIFY_INDEX, UINT32_MAX );
+
+        if( configQUEUE_ASYNC_COPY_START( pvDestination, pvSource, xBytes, xTaskGetCurrentTaskHandle() ) != pdFALSE )
+        {
+            ( void ) ulTaskNotifyTakeIndexed( configQUEUE_ASYNC_COPY_NOTIFY_INDEX, pdTRUE, portMAX_DELAY );
+        }
         else
         {
-            /* The timeout has expired.  If there is still no data in the queue
-             * exit, otherwise go back and try to read the data again. */
-            prvUnlockQueue( pxQueue );
-            ( void ) xTaskResumeAll();
+            queueCOPY_BYTES( pvDestination, pvSource, xBytes );
+        }
+    }
+/*-----------------------------------------------------------*/
 
-            if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+    static BaseType_t prvSendWithAsyncCopy( Queue_t * const pxQueue,
+                                            const void * const pvItemToQueue )
+    {
+        int8_t * pcSlot = NULL;
+
+        /* The slot is held while this task blocks for the copy, so any other
+         * task or interrupt that tries to send to the queue meanwhile finds it
+         * full, as it would if the slot had been acquired with
+         * xQueueAcquireSlot(). */
+        queueENTER_CRITICAL( pxQueue );
+        {
+            if( queueCAN_SEND( pxQueue, queueSEND_TO_BACK ) )
             {
-                traceQUEUE_PEEK_FAILED( pxQueue );
-                return errQUEUE_EMPTY;
+                pcSlot = pxQueue->pcWriteTo;
+                pxQueue->ucSlotsHeld |= queueWRITE_SLOT_HELD;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-    } /*lint -restore */
-}
-/*-----------------------------------------------------------*/
+        queueEXIT_CRITICAL( pxQueue );
 
-BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue,
-                                 void * const pvBuffer,
-                                 BaseType_t * const pxHigherPriorityTaskWoken )
-{
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    Queue_t * const pxQueue = xQueue;
+        if( pcSlot != NULL )
+        {
+            prvCopyAsync( ( void * ) pcSlot, pvItemToQueue, ( size_t ) pxQueue->uxItemSize );
 
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+            /* Only now is the item in the queue, so only now is a task that is
+             * waiting to receive it unblocked. */
+            queueENTER_CRITICAL( pxQueue );
+            {
+                if( prvCommitWriteSlot( pxQueue ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+        return ( pcSlot != NULL ) ? pdTRUE : pdFALSE;
+    }
+/*-----------------------------------------------------------*/
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    static BaseType_t prvReceiveWithAsyncCopy( Queue_t * const pxQueue,
+                                               void * const pvBuffer )
     {
-        const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+        int8_t * pcSlot = NULL;
 
-        /* Cannot block in an ISR, so check there is data available. */
-        if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+        queueENTER_CRITICAL( pxQueue );
         {
-            const int8_t cRxLock = pxQueue->cRxLock;
-
-            traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
-
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->uxMessagesWaiting = uxMessagesWaiting - ( UBaseType_t ) 1;
-
-            /* If the queue is locked the event list will not be modified.
-             * Instead update the lock count so the task that unlocks the queue
-             * will know that an ISR has removed data while the queue was
-             * locked. */
-            if( cRxLock == queueUNLOCKED )
+            if( queueCAN_RECEIVE( pxQueue ) )
             {
-                if( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE )
+                pcSlot = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+                if( pcSlot >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
                 {
-                    if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
-                    {
-                        /* The task waiting has a higher priority than us so
-                         * force a context switch. */
-                        if( pxHigherPriorityTaskWoken != NULL )
-                        {
-                            *pxHigherPriorityTaskWoken = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    pcSlot = pxQueue->pcHead;
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+
+                pxQueue->ucSlotsHeld |= queueREAD_SLOT_HELD;
             }
             else
             {
-                /* Increment the lock count so the task that unlocks the queue
-                 * knows that data was removed while it was locked. */
-                prvIncrementQueueRxLock( pxQueue, cRxLock );
+                mtCOVERAGE_TEST_MARKER();
             }
+        }
+        queueEXIT_CRITICAL( pxQueue );
 
-            xReturn = pdPASS;
+        if( pcSlot != NULL )
+        {
+            prvCopyAsync( pvBuffer, ( void * ) pcSlot, ( size_t ) pxQueue->uxItemSize );
+
+            /* The slot is only freed for a waiting sender once the item has
+             * been copied out of it. */
+            queueENTER_CRITICAL( pxQueue );
+            {
+                if( prvReleaseReadSlot( pxQueue ) != pdFALSE )
+                {
+                    queueYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            queueEXIT_CRITICAL( pxQueue );
         }
         else
         {
-            xReturn = pdFAIL;
-            traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        return ( pcSlot != NULL ) ? pdTRUE : pdFALSE;
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-    return xReturn;
-}
+#endif /* configQUEUE_ASYNC_COPY_BYTES */
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,
-                              void * const pvBuffer )
-{
-    BaseType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
-    int8_t * pcOriginalReadPosition;
-    Queue_t * const pxQueue = xQueue;
-
-    configASSERT( pxQueue );
-    configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-    configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
-
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+#if ( configUSE_QUEUE_WORD_COPY == 1 )
 
-    uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+    static void prvCopyItem( void * pvDestination,
+                             const void * pvSource,
+                             size_t xBytes )
     {
-        /* Cannot block in an ISR, so check there is data available. */
-        if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
-        {
-            traceQUEUE_PEEK_FROM_ISR( pxQueue );
+        uint32_t * pulDestination;
+        const uint32_t * pulSource;
+        size_t xWords;
 
-            /* Remember the read position so it can be reset as nothing is
-             * actually being removed from the queue. */
-            pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-            prvCopyDataFromQueue( pxQueue, pvBuffer );
-            pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+        if( ( ( ( portPOINTER_SIZE_TYPE ) pvDestination | ( portPOINTER_SIZE_TYPE ) pvSource | ( portPOINTER_SIZE_TYPE ) xBytes ) & ( portPOINTER_SIZE_TYPE ) 3U ) == ( portPOINTER_SIZE_TYPE ) 0U ) /*lint !e923 !e9078 Only the alignment of the addresses is tested. */
+        {
+            pulDestination = ( uint32_t * ) pvDestination; /*lint !e9079 !e9087 Alignment checked above. */
+            pulSource = ( const uint32_t * ) pvSource;     /*lint !e9079 !e9087 Alignment checked above. */
 
-            xReturn = pdPASS;
+            for( xWords = xBytes / sizeof( uint32_t ); xWords > ( size_t ) 0; xWords-- )
+            {
+                *pulDestination = *pulSource;
+                pulDestination++;
+                pulSource++;
+            }
         }
         else
         {
-            xReturn = pdFAIL;
-            traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+            configCOPY_BYTES( pvDestination, pvSource, xBytes );
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-    return xReturn;
-}
+#endif /* configUSE_QUEUE_WORD_COPY */
 /*-----------------------------------------------------------*/
 
 UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
@@ -2064,50 +5273,194 @@ UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
     configASSERT( pxQueue );
     uxReturn = pxQueue->uxMessagesWaiting;
 
-    return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+    return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+    Queue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+    traceQUEUE_DELETE( pxQueue );
+
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    {
+        vQueueUnregisterQueue( pxQueue );
+    }
+    #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        vObjectRegistryRemove( &( pxQueue->xRegistryItem ) );
+    }
+    #endif
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    {
+        /* The queue can only have been allocated dynamically - free it
+         * again. */
+        vPortFreeObject( portOBJECT_POOL_QUEUE, pxQueue );
+    }
+    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+    {
+        /* The queue could have been allocated statically or dynamically, so
+         * check before attempting to free the memory. */
+        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        {
+            vPortFreeObject( portOBJECT_POOL_QUEUE, pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+    {
+        /* The queue must have been statically allocated, so is not going to be
+         * deleted.  Avoid compiler warnings about the unused parameter. */
+        ( void ) pxQueue;
+    }
+    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_STATS == 1 )
+
+    static void prvResetQueueStats( Queue_t * const pxQueue )
+    {
+        /* Called from a critical section. */
+        pxQueue->uxMessagesWaitingHighWater = pxQueue->uxMessagesWaiting;
+        pxQueue->ulItemsSent = 0U;
+        pxQueue->ulItemsReceived = 0U;
+        pxQueue->ulSendsFailed = 0U;
+        pxQueue->ulOccupancyTicks = 0U;
+        pxQueue->xSendBlockedTicks = ( TickType_t ) 0;
+        pxQueue->xReceiveBlockedTicks = ( TickType_t ) 0;
+        pxQueue->xLastLevelChange = xTaskGetTickCountFromISR();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRecordQueueLevel( Queue_t * const pxQueue,
+                                     UBaseType_t uxNewLevel,
+                                     UBaseType_t uxItemsSent,
+                                     UBaseType_t uxItemsReceived )
+    {
+        /* Called from a critical section in either a task or an interrupt, so
+         * the interrupt safe version of the tick count function is used. */
+        const TickType_t xNow = xTaskGetTickCountFromISR();
+
+        /* Add the number of items that were in the queue for each tick since
+         * the number last changed.  Dividing the sum by the number of items
+         * received gives the average number of ticks an item spent in the
+         * queue. */
+        pxQueue->ulOccupancyTicks += ( uint32_t ) pxQueue->uxMessagesWaiting * ( uint32_t ) ( xNow - pxQueue->xLastLevelChange );
+        pxQueue->xLastLevelChange = xNow;
+
+        if( uxNewLevel > pxQueue->uxMessagesWaitingHighWater )
+        {
+            pxQueue->uxMessagesWaitingHighWater = uxNewLevel;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxQueue->ulItemsSent += ( uint32_t ) uxItemsSent;
+        pxQueue->ulItemsReceived += ( uint32_t ) uxItemsReceived;
+    }
 /*-----------------------------------------------------------*/
 
-void vQueueDelete( QueueHandle_t xQueue )
-{
-    Queue_t * const pxQueue = xQueue;
-
-    configASSERT( pxQueue );
-    traceQUEUE_DELETE( pxQueue );
-
-    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+    static void prvRecordQueueSendFailed( Queue_t * const pxQueue )
     {
-        vQueueUnregisterQueue( pxQueue );
+        taskENTER_CRITICAL();
+        {
+            pxQueue->ulSendsFailed++;
+        }
+        taskEXIT_CRITICAL();
     }
-    #endif
+/*-----------------------------------------------------------*/
 
-    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+    static void prvAddQueueBlockedTime( Queue_t * const pxQueue,
+                                        TickType_t xBlockStart,
+                                        BaseType_t xSender )
     {
-        /* The queue can only have been allocated dynamically - free it
-         * again. */
-        vPortFree( pxQueue );
+        taskENTER_CRITICAL();
+        {
+            if( xSender != pdFALSE )
+            {
+                pxQueue->xSendBlockedTicks += xTaskGetTickCount() - xBlockStart;
+            }
+            else
+            {
+                pxQueue->xReceiveBlockedTicks += xTaskGetTickCount() - xBlockStart;
+            }
+        }
+        taskEXIT_CRITICAL();
     }
-    #elif ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+/*-----------------------------------------------------------*/
+
+    void vQueueGetStats( QueueHandle_t xQueue,
+                         QueueStats_t * pxQueueStats )
     {
-        /* The queue could have been allocated statically or dynamically, so
-         * check before attempting to free the memory. */
-        if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+        configASSERT( pxQueueStats );
+
+        taskENTER_CRITICAL();
+        {
+            /* Bring the occupancy sum up to date without changing the
+             * number of items. */
+            prvRecordQueueLevel( pxQueue, pxQueue->uxMessagesWaiting, ( UBaseType_t ) 0, ( UBaseType_t ) 0 );
+
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                pxQueueStats->uxQueueNumber = pxQueue->uxQueueNumber;
+            }
+            #else
+            {
+                pxQueueStats->uxQueueNumber = ( UBaseType_t ) 0;
+            }
+            #endif
+
+            pxQueueStats->uxLength = pxQueue->uxLength;
+            pxQueueStats->uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+            pxQueueStats->uxMessagesWaitingHighWater = pxQueue->uxMessagesWaitingHighWater;
+            pxQueueStats->ulItemsSent = pxQueue->ulItemsSent;
+            pxQueueStats->ulItemsReceived = pxQueue->ulItemsReceived;
+            pxQueueStats->ulSendsFailed = pxQueue->ulSendsFailed;
+            pxQueueStats->xSendBlockedTicks = pxQueue->xSendBlockedTicks;
+            pxQueueStats->xReceiveBlockedTicks = pxQueue->xReceiveBlockedTicks;
+            pxQueueStats->ulOccupancyTicks = pxQueue->ulOccupancyTicks;
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxQueueStats->ulItemsReceived > 0U )
         {
-            vPortFree( pxQueue );
+            pxQueueStats->xAverageResidencyTicks = ( TickType_t ) ( pxQueueStats->ulOccupancyTicks / pxQueueStats->ulItemsReceived );
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            pxQueueStats->xAverageResidencyTicks = ( TickType_t ) 0;
         }
     }
-    #else /* if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) ) */
+/*-----------------------------------------------------------*/
+
+    void vQueueResetStats( QueueHandle_t xQueue )
     {
-        /* The queue must have been statically allocated, so is not going to be
-         * deleted.  Avoid compiler warnings about the unused parameter. */
-        ( void ) pxQueue;
+        Queue_t * const pxQueue = xQueue;
+
+        configASSERT( pxQueue );
+
+        taskENTER_CRITICAL();
+        {
+            prvResetQueueStats( pxQueue );
+        }
+        taskEXIT_CRITICAL();
     }
-    #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-}
+
+#endif /* configUSE_QUEUE_STATS */
 /*-----------------------------------------------------------*/
 
 #if ( configUSE_TRACE_FACILITY == 1 )
@@ -2141,6 +5494,12 @@ void vQueueDelete( QueueHandle_t xQueue )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
+UBaseType_t uxQueueGetQueueItemSize( QueueHandle_t xQueue )
+{
+    return ( ( Queue_t * ) xQueue )->uxItemSize;
+}
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_MUTEXES == 1 )
 
     static UBaseType_t prvGetDisinheritPriorityAfterTimeout( const Queue_t * const pxQueue )
@@ -2162,6 +5521,21 @@ void vQueueDelete( QueueHandle_t xQueue )
             uxHighestPriorityOfWaitingTasks = tskIDLE_PRIORITY;
         }
 
+        #if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
+        {
+            /* The holder of a ceiling mutex must not drop below the ceiling
+             * while it still holds the mutex. */
+            if( uxHighestPriorityOfWaitingTasks < pxQueue->uxCeilingPriority )
+            {
+                uxHighestPriorityOfWaitingTasks = pxQueue->uxCeilingPriority;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif
+
         return uxHighestPriorityOfWaitingTasks;
     }
 
@@ -2196,9 +5570,29 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
         }
         #endif /* configUSE_MUTEXES */
     }
-    else if( xPosition == queueSEND_TO_BACK )
+    #if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+        else if( queueIS_PRIORITY_QUEUE( pxQueue ) )
+        {
+            prvCopyDataToPriorityQueue( pxQueue, pvItemToQueue, xPosition );
+        }
+    #endif /* configQUEUE_MESSAGE_PRIORITIES */
+    else if( ( xPosition == queueSEND_TO_BACK ) || ( xPosition == queueOVERWRITE_OLDEST ) )
     {
-        ( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        if( uxMessagesWaiting == pxQueue->uxLength )
+        {
+            /* Only queueOVERWRITE_OLDEST can write to a full queue.  The slot
+             * at pcWriteTo holds the oldest item, so the item is dropped by
+             * moving the read position past it. */
+            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcWriteTo;
+            --uxMessagesWaiting;
+            queueRECORD_OVERFLOW( pxQueue );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        queueCOPY_ITEM( pxQueue, ( void * ) pxQueue->pcWriteTo, pvItemToQueue ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
         pxQueue->pcWriteTo += pxQueue->uxItemSize;                                                       /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 
         if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )                                             /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
@@ -2212,63 +5606,354 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue,
     }
     else
     {
-        ( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+        queueCOPY_ITEM( pxQueue, ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
         pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 
-        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+        {
+            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xPosition == queueOVERWRITE )
+        {
+            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            {
+                /* An item is not being added but overwritten, so subtract
+                 * one from the recorded number of items in the queue so when
+                 * one is added again below the number of recorded items remains
+                 * correct. */
+                --uxMessagesWaiting;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+    queueRECORD_LEVEL( pxQueue, uxMessagesWaiting + ( UBaseType_t ) 1, ( UBaseType_t ) 1, ( UBaseType_t ) 0 );
+    pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+    {
+        #if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+            if( queueIS_PRIORITY_QUEUE( pxQueue ) )
+            {
+                prvCopyDataFromPriorityQueue( pxQueue, pvBuffer, pdTRUE );
+            }
+            else
+        #endif /* configQUEUE_MESSAGE_PRIORITIES */
+        {
+            pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+
+            if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+            {
+                pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            queueCOPY_ITEM( pxQueue, ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        }
+    }
+}
+/*-----------------------------------------------------------*/
+
+static void prvPeekDataFromQueue( Queue_t * const pxQueue,
+                                  void * const pvBuffer )
+{
+    int8_t * pcOriginalReadPosition;
+
+    #if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+        if( queueIS_PRIORITY_QUEUE( pxQueue ) )
+        {
+            prvCopyDataFromPriorityQueue( pxQueue, pvBuffer, pdFALSE );
+        }
+        else
+    #endif /* configQUEUE_MESSAGE_PRIORITIES */
+    #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+        if( queueIS_BITMAP_SET( pxQueue ) )
+        {
+            prvSelectQueueSetMember( pxQueue, pvBuffer );
+        }
+        else
+    #endif /* configUSE_QUEUE_SET_BITMAP */
+    {
+        /* Remember the read position so it can be reset after the data is
+         * read from the queue as the data is only being peeked, not
+         * removed. */
+        pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+        prvCopyDataFromQueue( pxQueue, pvBuffer );
+        pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configQUEUE_MESSAGE_PRIORITIES > 0 )
+
+    static void prvCopyDataToPriorityQueue( Queue_t * const pxQueue,
+                                            const void * pvItemToQueue,
+                                            const BaseType_t xPosition )
+    {
+        uint8_t * const pucNext = queuePRIORITY_NEXT( pxQueue );
+        uint8_t * const pucHead = queuePRIORITY_HEAD( pxQueue );
+        uint8_t * const pucTail = queuePRIORITY_TAIL( pxQueue );
+        uint8_t * const pucFree = queuePRIORITY_FREE( pxQueue );
+        const uint8_t ucSlot = *pucFree;
+        UBaseType_t uxPriority;
+
+        /* This function is called from a critical section, and the caller has
+         * already checked there is space in the queue. */
+        configASSERT( ucSlot != queuePRIORITY_NO_SLOT );
+        *pucFree = pucNext[ ucSlot ];
+
+        queueCOPY_ITEM( pxQueue, ( void * ) ( pxQueue->pcHead + ( ( UBaseType_t ) ucSlot * pxQueue->uxItemSize ) ), pvItemToQueue ); /*lint !e9016 !e9087 Pointer arithmetic on char types ok.  Cast to void required by function signature. */
+
+        if( xPosition == queueSEND_TO_FRONT )
+        {
+            uxPriority = ( UBaseType_t ) configQUEUE_MESSAGE_PRIORITIES - ( UBaseType_t ) 1U;
+            pucNext[ ucSlot ] = pucHead[ uxPriority ];
+
+            if( pucHead[ uxPriority ] == queuePRIORITY_NO_SLOT )
+            {
+                pucTail[ uxPriority ] = ucSlot;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pucHead[ uxPriority ] = ucSlot;
+        }
+        else
+        {
+            if( xPosition >= queueSEND_WITH_PRIORITY( 0 ) )
+            {
+                uxPriority = ( UBaseType_t ) ( xPosition - queueSEND_WITH_PRIORITY( 0 ) );
+            }
+            else
+            {
+                uxPriority = ( UBaseType_t ) 0U;
+            }
+
+            pucNext[ ucSlot ] = queuePRIORITY_NO_SLOT;
+
+            if( pucTail[ uxPriority ] == queuePRIORITY_NO_SLOT )
+            {
+                pucHead[ uxPriority ] = ucSlot;
+            }
+            else
+            {
+                pucNext[ pucTail[ uxPriority ] ] = ucSlot;
+            }
+
+            pucTail[ uxPriority ] = ucSlot;
+        }
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvCopyDataFromPriorityQueue( Queue_t * const pxQueue,
+                                              void * const pvBuffer,
+                                              const BaseType_t xRemove )
+    {
+        uint8_t * const pucNext = queuePRIORITY_NEXT( pxQueue );
+        uint8_t * const pucHead = queuePRIORITY_HEAD( pxQueue );
+        uint8_t * const pucFree = queuePRIORITY_FREE( pxQueue );
+        UBaseType_t uxPriority = ( UBaseType_t ) configQUEUE_MESSAGE_PRIORITIES - ( UBaseType_t ) 1U;
+        uint8_t ucSlot;
+
+        /* This function is called from a critical section, and the caller has
+         * already checked the queue is not empty.  Find the highest priority
+         * list that contains an item. */
+        while( ( pucHead[ uxPriority ] == queuePRIORITY_NO_SLOT ) && ( uxPriority > ( UBaseType_t ) 0U ) )
+        {
+            uxPriority--;
+        }
+
+        ucSlot = pucHead[ uxPriority ];
+        configASSERT( ucSlot != queuePRIORITY_NO_SLOT );
+
+        queueCOPY_ITEM( pxQueue, pvBuffer, ( void * ) ( pxQueue->pcHead + ( ( UBaseType_t ) ucSlot * pxQueue->uxItemSize ) ) ); /*lint !e9016 !e9087 Pointer arithmetic on char types ok.  Cast to void required by function signature. */
+
+        if( xRemove != pdFALSE )
+        {
+            pucHead[ uxPriority ] = pucNext[ ucSlot ];
+
+            if( pucHead[ uxPriority ] == queuePRIORITY_NO_SLOT )
+            {
+                queuePRIORITY_TAIL( pxQueue )[ uxPriority ] = queuePRIORITY_NO_SLOT;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Return the slot to the free list. */
+            pucNext[ ucSlot ] = *pucFree;
+            *pucFree = ucSlot;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configQUEUE_MESSAGE_PRIORITIES */
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCopyItemsToQueue( Queue_t * const pxQueue,
+                                        const void * pvItems,
+                                        UBaseType_t uxItemCount )
+{
+    const int8_t * pcItem = ( const int8_t * ) pvItems;
+    UBaseType_t uxItemsToCopy = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+    UBaseType_t uxIndex;
+
+    /* This function is called from a critical section. */
+
+    if( uxItemCount < uxItemsToCopy )
+    {
+        uxItemsToCopy = uxItemCount;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    for( uxIndex = ( UBaseType_t ) 0U; uxIndex < uxItemsToCopy; uxIndex++ )
+    {
+        /* The queue is not a mutex, so nothing can be disinherited. */
+        ( void ) prvCopyDataToQueue( pxQueue, pcItem, queueSEND_TO_BACK );
+        pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    }
+
+    return uxItemsToCopy;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvCopyItemsFromQueue( Queue_t * const pxQueue,
+                                          void * const pvBuffer,
+                                          UBaseType_t uxItemCount )
+{
+    int8_t * pcItem = ( int8_t * ) pvBuffer;
+    UBaseType_t uxItemsToCopy = pxQueue->uxMessagesWaiting;
+    UBaseType_t uxIndex;
+
+    /* This function is called from a critical section. */
+
+    if( uxItemCount < uxItemsToCopy )
+    {
+        uxItemsToCopy = uxItemCount;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    for( uxIndex = ( UBaseType_t ) 0U; uxIndex < uxItemsToCopy; uxIndex++ )
+    {
+        prvCopyDataFromQueue( pxQueue, pcItem );
+        pcItem += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    }
+
+    queueRECORD_LEVEL( pxQueue, pxQueue->uxMessagesWaiting - uxItemsToCopy, ( UBaseType_t ) 0, uxItemsToCopy );
+    pxQueue->uxMessagesWaiting -= uxItemsToCopy;
+    queueSET_MEMBER_RECEIVED( pxQueue );
+
+    return uxItemsToCopy;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasksWaitingToReceive( Queue_t * const pxQueue,
+                                                   UBaseType_t uxItemsAdded )
+{
+    BaseType_t xReturn = pdFALSE;
+
+    /* This function is called from a critical section. */
+
+    #if ( configUSE_QUEUE_SETS == 1 )
+        if( pxQueue->pxQueueSetContainer != NULL )
         {
-            pxQueue->u.xQueue.pcReadFrom = ( pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize );
+            /* The queue set holds one entry per item in its member queues. */
+            while( uxItemsAdded > ( UBaseType_t ) 0U )
+            {
+                if( prvNotifyQueueSetContainer( pxQueue ) != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                uxItemsAdded--;
+            }
         }
         else
+    #endif /* configUSE_QUEUE_SETS */
+    {
+        /* Each item can satisfy one waiting task, but normally there is only a
+         * single reader so only one task is unblocked. */
+        while( ( uxItemsAdded > ( UBaseType_t ) 0U ) &&
+               ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) == pdFALSE ) )
         {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        if( xPosition == queueOVERWRITE )
-        {
-            if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
             {
-                /* An item is not being added but overwritten, so subtract
-                 * one from the recorded number of items in the queue so when
-                 * one is added again below the number of recorded items remains
-                 * correct. */
-                --uxMessagesWaiting;
+                xReturn = pdTRUE;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+
+            uxItemsAdded--;
         }
     }
 
-    pxQueue->uxMessagesWaiting = uxMessagesWaiting + ( UBaseType_t ) 1;
-
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static void prvCopyDataFromQueue( Queue_t * const pxQueue,
-                                  void * const pvBuffer )
+static BaseType_t prvUnblockTasksWaitingToSend( Queue_t * const pxQueue,
+                                                UBaseType_t uxItemsRemoved )
 {
-    if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
-    {
-        pxQueue->u.xQueue.pcReadFrom += pxQueue->uxItemSize;           /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
+    BaseType_t xReturn = pdFALSE;
 
-        if( pxQueue->u.xQueue.pcReadFrom >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as use of the relational operator is the cleanest solutions. */
+    /* This function is called from a critical section. */
+
+    while( ( uxItemsRemoved > ( UBaseType_t ) 0U ) &&
+           ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) == pdFALSE ) )
+    {
+        if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
         {
-            pxQueue->u.xQueue.pcReadFrom = pxQueue->pcHead;
+            xReturn = pdTRUE;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        ( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+        uxItemsRemoved--;
     }
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
@@ -2280,7 +5965,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
      * removed from the queue while the queue was locked.  When a queue is
      * locked items can be added or removed, but the event lists cannot be
      * updated. */
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
         int8_t cTxLock = pxQueue->cTxLock;
 
@@ -2358,10 +6043,10 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         pxQueue->cTxLock = queueUNLOCKED;
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 
     /* Do the same for the Rx lock. */
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
         int8_t cRxLock = pxQueue->cRxLock;
 
@@ -2388,7 +6073,7 @@ static void prvUnlockQueue( Queue_t * const pxQueue )
 
         pxQueue->cRxLock = queueUNLOCKED;
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 }
 /*-----------------------------------------------------------*/
 
@@ -2396,9 +6081,18 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
 {
     BaseType_t xReturn;
 
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
-        if( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 )
+        #if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+            if( queueIS_RENDEZVOUS( pxQueue ) )
+            {
+                /* An item can be received from a rendezvous channel while a
+                 * task is waiting to send one. */
+                xReturn = listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) );
+            }
+            else
+        #endif
+        if( queueCAN_RECEIVE( pxQueue ) == pdFALSE )
         {
             xReturn = pdTRUE;
         }
@@ -2407,7 +6101,7 @@ static BaseType_t prvIsQueueEmpty( const Queue_t * pxQueue )
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
 
     return xReturn;
 }
@@ -2437,21 +6131,389 @@ static BaseType_t prvIsQueueFull( const Queue_t * pxQueue )
 {
     BaseType_t xReturn;
 
-    taskENTER_CRITICAL();
+    queueENTER_CRITICAL( pxQueue );
     {
+        #if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+            if( queueIS_RENDEZVOUS( pxQueue ) )
+            {
+                /* An item can be sent to a rendezvous channel while a task is
+                 * waiting to receive one. */
+                xReturn = listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) );
+            }
+            else
+        #endif
         if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
         {
             xReturn = pdTRUE;
         }
+        #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+            else if( pxQueue->ucSlotsHeld != 0U )
+            {
+                /* A held slot can prevent sending even if there is space, see
+                 * queueCAN_SEND().  Sending tasks are unblocked when the slot
+                 * is committed or released. */
+                xReturn = pdTRUE;
+            }
+        #endif
         else
         {
             xReturn = pdFALSE;
         }
     }
-    taskEXIT_CRITICAL();
+    queueEXIT_CRITICAL( pxQueue );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+    static BaseType_t prvHandoffToReceiver( Queue_t * const pxQueue,
+                                            const void * pvItemToQueue )
+    {
+        void * pvBuffer;
+        BaseType_t xReturn = pdFALSE;
+
+        /* Only an item sent to an empty queue can be handed off, otherwise it
+         * would overtake the items already queued.  Every send position is
+         * equivalent when the queue is empty.  A member of a queue set is
+         * excluded as the set must be notified of the item. */
+        #if ( configUSE_QUEUE_SETS == 1 )
+            if( pxQueue->pxQueueSetContainer != NULL )
+            {
+                pvBuffer = NULL;
+            }
+            else
+        #endif
+        {
+            if( ( pxQueue->uxItemSize > ( UBaseType_t ) 0 ) && ( pxQueue->uxMessagesWaiting == ( UBaseType_t ) 0 ) )
+            {
+                /* NULL if no task is waiting, or the task at the head of the
+                 * list is waiting in xQueuePeek() or xQueueWaitForAny(). */
+                pvBuffer = pvTaskClaimHandoffBuffer( &( pxQueue->xTasksWaitingToReceive ) );
+            }
+            else
+            {
+                pvBuffer = NULL;
+            }
+        }
+
+        if( pvBuffer != NULL )
+        {
+            queueCOPY_ITEM( pxQueue, pvBuffer, pvItemToQueue ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+            queueRECORD_LEVEL( pxQueue, ( UBaseType_t ) 0, ( UBaseType_t ) 1, ( UBaseType_t ) 1 );
+
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_RENDEZVOUS == 1 )
+
+    static BaseType_t prvTakeFromSender( Queue_t * const pxQueue,
+                                         void * const pvBuffer )
+    {
+        const void * pvItem;
+        BaseType_t xReturn = pdFALSE;
+
+        /* NULL if no task is waiting to send.  The sender stays blocked until
+         * it is removed from the event list below, so its item remains valid
+         * while it is copied. */
+        pvItem = pvTaskClaimHandoffBuffer( &( pxQueue->xTasksWaitingToSend ) );
+
+        if( pvItem != NULL )
+        {
+            queueCOPY_ITEM( pxQueue, pvBuffer, pvItem ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+            queueRECORD_LEVEL( pxQueue, ( UBaseType_t ) 0, ( UBaseType_t ) 1, ( UBaseType_t ) 1 );
+
+            if( xTaskRemoveFromEventList( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE )
+            {
+                queueYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_RENDEZVOUS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SEMAPHORE_FAST_PATH == 1 )
+
+/* Only counting semaphores can use the fast path.  A mutex or binary
+ * semaphore has a length of 1, and a member of a queue set must notify the
+ * set. */
+    #if ( configUSE_QUEUE_SETS == 1 )
+        #define queueCAN_USE_FAST_PATH( pxQueue ) \
+    ( ( ( pxQueue )->uxItemSize == ( UBaseType_t ) 0 ) && ( ( pxQueue )->uxLength > ( UBaseType_t ) 1 ) && ( ( pxQueue )->pxQueueSetContainer == NULL ) )
+    #else
+        #define queueCAN_USE_FAST_PATH( pxQueue ) \
+    ( ( ( pxQueue )->uxItemSize == ( UBaseType_t ) 0 ) && ( ( pxQueue )->uxLength > ( UBaseType_t ) 1 ) )
+    #endif
+
+    static BaseType_t prvSemaphoreFastGive( Queue_t * const pxQueue )
+    {
+        UBaseType_t uxCount;
+        BaseType_t xReturn = pdFALSE;
+
+        /* If no task is waiting for the semaphore the count can be
+         * incremented without unblocking anything.  An interrupt that changes
+         * the count between the read and the compare-and-swap makes the
+         * compare-and-swap fail, so it is retried with the new count.
+         *
+         * This task can be preempted between checking the list and the
+         * compare-and-swap by a task that then blocks on the semaphore, so the
+         * list is checked again once the count has changed.  A task blocks
+         * with the scheduler suspended after finding the count at zero, so
+         * with a single core it is either already in the list by then or
+         * will find the new count. */
+        if( queueCAN_USE_FAST_PATH( pxQueue ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
+        {
+            uxCount = pxQueue->uxMessagesWaiting;
+
+            while( uxCount < pxQueue->uxLength )
+            {
+                if( Atomic_CompareAndSwap_ux( &( pxQueue->uxMessagesWaiting ), uxCount + ( UBaseType_t ) 1, uxCount ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                {
+                    traceQUEUE_SEND( pxQueue );
+                    prvSemaphoreFastWake( &( pxQueue->xTasksWaitingToReceive ) );
+                    xReturn = pdTRUE;
+                    break;
+                }
+
+                uxCount = pxQueue->uxMessagesWaiting;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvSemaphoreFastTake( Queue_t * const pxQueue )
+    {
+        UBaseType_t uxCount;
+        BaseType_t xReturn = pdFALSE;
+
+        /* As prvSemaphoreFastGive(), but for tasks waiting to give the
+         * semaphore. */
+        if( queueCAN_USE_FAST_PATH( pxQueue ) && ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) )
+        {
+            uxCount = pxQueue->uxMessagesWaiting;
+
+            while( uxCount > ( UBaseType_t ) 0 )
+            {
+                if( Atomic_CompareAndSwap_ux( &( pxQueue->uxMessagesWaiting ), uxCount - ( UBaseType_t ) 1, uxCount ) == ATOMIC_COMPARE_AND_SWAP_SUCCESS )
+                {
+                    traceQUEUE_RECEIVE( pxQueue );
+                    prvSemaphoreFastWake( &( pxQueue->xTasksWaitingToSend ) );
+                    xReturn = pdTRUE;
+                    break;
+                }
+
+                uxCount = pxQueue->uxMessagesWaiting;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSemaphoreFastWake( List_t * const pxWaitingList )
+    {
+        /* Checking the list without a critical section is enough to find a
+         * task that blocked before the compare-and-swap, as tasks are only
+         * added to the list by other tasks with the scheduler suspended. */
+        if( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( listLIST_IS_EMPTY( pxWaitingList ) == pdFALSE )
+                {
+                    if( xTaskRemoveFromEventList( pxWaitingList ) != pdFALSE )
+                    {
+                        queueYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_SEMAPHORE_FAST_PATH */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_GRANULAR_LOCKS == 1 )
+
+    static void prvEnterQueueCritical( const Queue_t * const pxQueue )
+    {
+        taskENTER_CRITICAL();
+        queueGET_OBJECT_LOCK( pxQueue );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvExitQueueCritical( const Queue_t * const pxQueue )
+    {
+        queueRELEASE_OBJECT_LOCK( pxQueue );
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    static UBaseType_t prvEnterQueueCriticalFromISR( const Queue_t * const pxQueue )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        queueGET_OBJECT_LOCK( pxQueue );
+
+        return uxSavedInterruptStatus;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvExitQueueCriticalFromISR( const Queue_t * const pxQueue,
+                                             UBaseType_t uxSavedInterruptStatus )
+    {
+        queueRELEASE_OBJECT_LOCK( pxQueue );
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+        #define queueOBJECT_LOCK_SET_CHECK( pxQueue )    ( ( ( pxQueue )->pxQueueSetContainer == NULL ) && ( !queueIS_BITMAP_SET( pxQueue ) ) )
+    #elif ( configUSE_QUEUE_SETS == 1 )
+        #define queueOBJECT_LOCK_SET_CHECK( pxQueue )    ( ( pxQueue )->pxQueueSetContainer == NULL )
+    #else
+        #define queueOBJECT_LOCK_SET_CHECK( pxQueue )    ( pdTRUE )
+    #endif
+
+    #if ( configUSE_QUEUE_ZERO_COPY == 1 )
+        #define queueOBJECT_LOCK_SLOT_CHECK( pxQueue )    ( ( pxQueue )->ucSlotsHeld == 0U )
+    #else
+        #define queueOBJECT_LOCK_SLOT_CHECK( pxQueue )    ( pdTRUE )
+    #endif
+
+/* Only the spinlock is needed when nothing but the queue's own state changes.
+ * A locked queue has a task part way through blocking on it, or waking the
+ * tasks that are, which must see every change.  A mutex changes the priority
+ * of its holder, a member of a queue set must notify the set, a bitmap queue
+ * set and a priority queue do not hold their items in order, and a held
+ * zero-copy slot must not move. */
+    #define queueCAN_USE_OBJECT_LOCK( pxQueue )                                                           \
+    ( ( ( pxQueue )->cRxLock == queueUNLOCKED ) && ( ( pxQueue )->cTxLock == queueUNLOCKED ) &&           \
+      ( ( pxQueue )->uxQueueType != queueQUEUE_IS_MUTEX ) && ( !queueIS_PRIORITY_QUEUE( pxQueue ) ) &&   \
+      queueOBJECT_LOCK_SET_CHECK( pxQueue ) && queueOBJECT_LOCK_SLOT_CHECK( pxQueue ) )
+
+    static BaseType_t prvObjectLockedSend( Queue_t * const pxQueue,
+                                           const void * const pvItemToQueue,
+                                           const BaseType_t xCopyPosition )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xReturn = pdFALSE;
+
+        /* Tasks are only added to a queue's event lists while the queue is
+         * locked, and are only removed by a core that holds both the kernel's
+         * locks and the queue's spinlock, so if the queue is unlocked and no
+         * task is waiting to receive then adding the item cannot need to
+         * unblock a task.  Interrupts are masked so an interrupt on this core
+         * cannot try to obtain the spinlock while it is held. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        queueGET_OBJECT_LOCK( pxQueue );
+        {
+            if( queueCAN_USE_OBJECT_LOCK( pxQueue ) &&
+                queueCAN_SEND( pxQueue, xCopyPosition ) &&
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToReceive ) ) != pdFALSE ) )
+            {
+                ( void ) prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        queueRELEASE_OBJECT_LOCK( pxQueue );
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvObjectLockedReceive( Queue_t * const pxQueue,
+                                              void * const pvBuffer )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xReturn = pdFALSE;
+
+        /* As prvObjectLockedSend(), but for tasks waiting to send. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        queueGET_OBJECT_LOCK( pxQueue );
+        {
+            if( queueCAN_USE_OBJECT_LOCK( pxQueue ) &&
+                queueCAN_RECEIVE( pxQueue ) &&
+                ( listLIST_IS_EMPTY( &( pxQueue->xTasksWaitingToSend ) ) != pdFALSE ) )
+            {
+                prvCopyDataFromQueue( pxQueue, pvBuffer );
+                pxQueue->uxMessagesWaiting--;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        queueRELEASE_OBJECT_LOCK( pxQueue );
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
 
-    return xReturn;
-}
+#endif /* configUSE_GRANULAR_LOCKS */
 /*-----------------------------------------------------------*/
 
 BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
@@ -2514,6 +6576,13 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             pxEntryToWrite->pcQueueName = pcQueueName;
             pxEntryToWrite->xHandle = xQueue;
 
+            #if ( configUSE_OBJECT_REGISTRY == 1 )
+            {
+                /* Also name the queue in the object registry. */
+                xQueue->xRegistryItem.pcName = pcQueueName;
+            }
+            #endif
+
             traceQUEUE_REGISTRY_ADD( xQueue, pcQueueName );
         }
     }
@@ -2573,6 +6642,13 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                  * appear in the registry twice if it is added, removed, then
                  * added again. */
                 xQueueRegistry[ ux ].xHandle = ( QueueHandle_t ) 0;
+
+                #if ( configUSE_OBJECT_REGISTRY == 1 )
+                {
+                    xQueue->xRegistryItem.pcName = NULL;
+                }
+                #endif
+
                 break;
             }
             else
@@ -2585,6 +6661,44 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
 #endif /* configQUEUE_REGISTRY_SIZE */
 /*-----------------------------------------------------------*/
 
+#if ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_POST_MORTEM_SNAPSHOT == 1 ) )
+
+    void vQueueWalkRegistry( QueueWalkFunction_t pxFunction,
+                             void * pvContext )
+    {
+        UBaseType_t ux;
+        const Queue_t * pxQueue;
+        QueueWalkInfo_t xInfo;
+
+        configASSERT( pxFunction != NULL );
+
+        /* Nothing is locked, as this is called from fault handlers. */
+        for( ux = ( UBaseType_t ) 0U; ux < ( UBaseType_t ) configQUEUE_REGISTRY_SIZE; ux++ )
+        {
+            pxQueue = xQueueRegistry[ ux ].xHandle;
+
+            if( ( xQueueRegistry[ ux ].pcQueueName != NULL ) && ( pxQueue != NULL ) )
+            {
+                xInfo.xHandle = xQueueRegistry[ ux ].xHandle;
+                xInfo.pcQueueName = xQueueRegistry[ ux ].pcQueueName;
+                xInfo.uxMessagesWaiting = pxQueue->uxMessagesWaiting;
+                xInfo.uxLength = pxQueue->uxLength;
+                xInfo.uxItemSize = pxQueue->uxItemSize;
+                xInfo.uxTasksWaitingToSend = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToSend ) );
+                xInfo.uxTasksWaitingToReceive = listCURRENT_LIST_LENGTH( &( pxQueue->xTasksWaitingToReceive ) );
+
+                pxFunction( &xInfo, pvContext );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+
+#endif /* ( ( configQUEUE_REGISTRY_SIZE > 0 ) && ( configUSE_POST_MORTEM_SNAPSHOT == 1 ) ) */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TIMERS == 1 )
 
     void vQueueWaitForMessageRestricted( QueueHandle_t xQueue,
@@ -2631,7 +6745,16 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     {
         QueueSetHandle_t pxQueue;
 
-        pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+        #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+        {
+            /* The set holds one entry per member rather than one per event. */
+            pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET_BITMAP );
+        }
+        #else
+        {
+            pxQueue = xQueueGenericCreate( uxEventQueueLength, ( UBaseType_t ) sizeof( Queue_t * ), queueQUEUE_TYPE_SET );
+        }
+        #endif
 
         return pxQueue;
     }
@@ -2646,7 +6769,7 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     {
         BaseType_t xReturn;
 
-        taskENTER_CRITICAL();
+        queueENTER_CRITICAL( ( Queue_t * ) xQueueOrSemaphore );
         {
             if( ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer != NULL )
             {
@@ -2659,13 +6782,51 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
                  * items in the queue/semaphore. */
                 xReturn = pdFAIL;
             }
+            else if( queueIS_RENDEZVOUS( ( Queue_t * ) xQueueOrSemaphore ) )
+            {
+                /* A rendezvous channel never holds an item for the set to
+                 * report. */
+                xReturn = pdFAIL;
+            }
             else
             {
-                ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
-                xReturn = pdPASS;
+                #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+                {
+                    Queue_t ** const ppxMembers = queueSET_MEMBERS( xQueueSet );
+                    UBaseType_t uxIndex = ( UBaseType_t ) 0U;
+
+                    /* A queue set cannot itself be a member of a set. */
+                    configASSERT( !queueIS_BITMAP_SET( ( Queue_t * ) xQueueOrSemaphore ) );
+
+                    /* Find a free entry in the set. */
+                    while( ( uxIndex < xQueueSet->uxLength ) && ( ppxMembers[ uxIndex ] != NULL ) )
+                    {
+                        uxIndex++;
+                    }
+
+                    if( uxIndex < xQueueSet->uxLength )
+                    {
+                        ppxMembers[ uxIndex ] = ( Queue_t * ) xQueueOrSemaphore;
+                        ( ( Queue_t * ) xQueueOrSemaphore )->ucQueueSetIndex = ( uint8_t ) uxIndex;
+                        ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
+                        xReturn = pdPASS;
+                    }
+                    else
+                    {
+                        /* The set already holds as many members as it was
+                         * created for. */
+                        xReturn = pdFAIL;
+                    }
+                }
+                #else /* configUSE_QUEUE_SET_BITMAP */
+                {
+                    ( ( Queue_t * ) xQueueOrSemaphore )->pxQueueSetContainer = xQueueSet;
+                    xReturn = pdPASS;
+                }
+                #endif /* configUSE_QUEUE_SET_BITMAP */
             }
         }
-        taskEXIT_CRITICAL();
+        queueEXIT_CRITICAL( ( Queue_t * ) xQueueOrSemaphore );
 
         return xReturn;
     }
@@ -2695,12 +6856,19 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         }
         else
         {
-            taskENTER_CRITICAL();
+            queueENTER_CRITICAL( pxQueueOrSemaphore );
             {
                 /* The queue is no longer contained in the set. */
                 pxQueueOrSemaphore->pxQueueSetContainer = NULL;
+
+                #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+                {
+                    /* The queue is empty, so it is not marked as ready. */
+                    queueSET_MEMBERS( xQueueSet )[ pxQueueOrSemaphore->ucQueueSetIndex ] = NULL;
+                }
+                #endif
             }
-            taskEXIT_CRITICAL();
+            queueEXIT_CRITICAL( pxQueueOrSemaphore );
             xReturn = pdPASS;
         }
 
@@ -2717,7 +6885,17 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     {
         QueueSetMemberHandle_t xReturn = NULL;
 
-        ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
+        #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+        {
+            /* Members remain ready until they are empty, so the set is only
+             * peeked. */
+            ( void ) xQueuePeek( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
+        }
+        #else
+        {
+            ( void ) xQueueReceive( ( QueueHandle_t ) xQueueSet, &xReturn, xTicksToWait ); /*lint !e961 Casting from one typedef to another is not redundant. */
+        }
+        #endif
         return xReturn;
     }
 
@@ -2730,13 +6908,257 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
     {
         QueueSetMemberHandle_t xReturn = NULL;
 
-        ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL ); /*lint !e961 Casting from one typedef to another is not redundant. */
+        #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+        {
+            ( void ) xQueuePeekFromISR( ( QueueHandle_t ) xQueueSet, &xReturn ); /*lint !e961 Casting from one typedef to another is not redundant. */
+        }
+        #else
+        {
+            ( void ) xQueueReceiveFromISR( ( QueueHandle_t ) xQueueSet, &xReturn, NULL ); /*lint !e961 Casting from one typedef to another is not redundant. */
+        }
+        #endif
         return xReturn;
     }
 
 #endif /* configUSE_QUEUE_SETS */
 /*-----------------------------------------------------------*/
 
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+
+    QueueSetMemberHandle_t xQueueWaitForAny( QueueWaitRecord_t * const pxWaitRecords,
+                                             const UBaseType_t uxNumberOfRecords,
+                                             TickType_t xTicksToWait )
+    {
+        BaseType_t xEntryTimeSet = pdFALSE;
+        TimeOut_t xTimeOut;
+        Queue_t * pxQueue;
+        const TaskWaitRecord_t * pxSignalledRecord;
+        UBaseType_t uxFirst = 0U, x, uxIndex;
+        QueueSetMemberHandle_t xReturn = NULL;
+
+        configASSERT( pxWaitRecords );
+        configASSERT( uxNumberOfRecords > ( UBaseType_t ) 0U );
+
+        for( x = 0U; x < uxNumberOfRecords; x++ )
+        {
+            pxQueue = pxWaitRecords[ x ].xQueueOrSemaphore;
+            configASSERT( pxQueue );
+
+            /* Tasks waiting on a mutex through a record would not pass their
+             * priority to the mutex holder, writes to a queue set member do not
+             * unblock tasks waiting to read the member, and a rendezvous
+             * channel never holds an item for a record to find. */
+            configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+            configASSERT( !queueIS_RENDEZVOUS( pxQueue ) );
+
+            #if ( configUSE_QUEUE_SETS == 1 )
+            {
+                configASSERT( pxQueue->pxQueueSetContainer == NULL );
+            }
+            #endif
+        }
+
+        /* Cannot block if the scheduler is suspended. */
+        #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+        {
+            configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+        }
+        #endif
+
+        /*lint -save -e904  This function relaxes the coding standard somewhat to
+         * allow return statements within the function itself.  This is done in the
+         * interest of execution time efficiency. */
+        for( ; ; )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* Start with the object that ended the last wait, if any, so
+                 * it is returned in preference to the others. */
+                for( x = 0U; x < uxNumberOfRecords; x++ )
+                {
+                    uxIndex = uxFirst + x;
+
+                    if( uxIndex >= uxNumberOfRecords )
+                    {
+                        uxIndex -= uxNumberOfRecords;
+                    }
+
+                    pxQueue = pxWaitRecords[ uxIndex ].xQueueOrSemaphore;
+
+                    if( queueCAN_RECEIVE( pxQueue ) )
+                    {
+                        xReturn = pxQueue;
+                        break;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+
+                if( xReturn != NULL )
+                {
+                    taskEXIT_CRITICAL();
+                    return xReturn;
+                }
+                else if( xTicksToWait == ( TickType_t ) 0 )
+                {
+                    /* None of the objects are ready and no block time is
+                     * specified (or the block time has expired) so leave
+                     * now. */
+                    taskEXIT_CRITICAL();
+                    return NULL;
+                }
+                else if( xEntryTimeSet == pdFALSE )
+                {
+                    vTaskInternalSetTimeOutState( &xTimeOut );
+                    xEntryTimeSet = pdTRUE;
+                }
+                else
+                {
+                    /* Entry time was already set. */
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            /* Interrupts and other tasks can write to the objects now the
+             * critical section has been exited. */
+
+            vTaskSuspendAll();
+            prvLockWaitQueues( pxWaitRecords, uxNumberOfRecords );
+
+            /* Update the timeout state to see if it has expired yet. */
+            if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+            {
+                if( prvAreWaitQueuesEmpty( pxWaitRecords, uxNumberOfRecords ) != pdFALSE )
+                {
+                    /* Place the task on the event list of every object.  The
+                     * objects are locked, so an interrupt cannot unblock the
+                     * task before it has been placed on all of them. */
+                    for( x = 0U; x < uxNumberOfRecords; x++ )
+                    {
+                        pxQueue = pxWaitRecords[ x ].xQueueOrSemaphore;
+                        vTaskPlaceWaitRecordOnEventList( &( pxQueue->xTasksWaitingToReceive ), &( pxWaitRecords[ x ].xWaitRecord ) );
+                    }
+
+                    vTaskBlockOnWaitRecords( xTicksToWait );
+                    prvUnlockWaitQueues( pxWaitRecords, uxNumberOfRecords );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxSignalledRecord = pxTaskGetSignalledWaitRecord();
+
+                    for( x = 0U; x < uxNumberOfRecords; x++ )
+                    {
+                        if( &( pxWaitRecords[ x ].xWaitRecord ) == pxSignalledRecord )
+                        {
+                            uxFirst = x;
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
+                {
+                    /* An object is ready again.  Loop back to find it. */
+                    prvUnlockWaitQueues( pxWaitRecords, uxNumberOfRecords );
+                    ( void ) xTaskResumeAll();
+                }
+            }
+            else
+            {
+                /* Timed out.  If none of the objects are ready exit, otherwise
+                 * loop back to find the one that is. */
+                prvUnlockWaitQueues( pxWaitRecords, uxNumberOfRecords );
+                ( void ) xTaskResumeAll();
+
+                if( prvAreWaitQueuesEmpty( pxWaitRecords, uxNumberOfRecords ) != pdFALSE )
+                {
+                    return NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        } /*lint -restore */
+    }
+
+#endif /* configUSE_QUEUE_WAIT_FOR_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+
+    static void prvLockWaitQueues( QueueWaitRecord_t * const pxWaitRecords,
+                                   const UBaseType_t uxNumberOfRecords )
+    {
+        UBaseType_t x;
+        Queue_t * pxQueue;
+
+        for( x = 0U; x < uxNumberOfRecords; x++ )
+        {
+            pxQueue = pxWaitRecords[ x ].xQueueOrSemaphore;
+            prvLockQueue( pxQueue );
+        }
+    }
+
+#endif /* configUSE_QUEUE_WAIT_FOR_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+
+    static void prvUnlockWaitQueues( QueueWaitRecord_t * const pxWaitRecords,
+                                     const UBaseType_t uxNumberOfRecords )
+    {
+        UBaseType_t x;
+
+        for( x = 0U; x < uxNumberOfRecords; x++ )
+        {
+            prvUnlockQueue( pxWaitRecords[ x ].xQueueOrSemaphore );
+        }
+    }
+
+#endif /* configUSE_QUEUE_WAIT_FOR_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+
+    static BaseType_t prvAreWaitQueuesEmpty( QueueWaitRecord_t * const pxWaitRecords,
+                                             const UBaseType_t uxNumberOfRecords )
+    {
+        UBaseType_t x;
+        BaseType_t xReturn = pdTRUE;
+
+        for( x = 0U; x < uxNumberOfRecords; x++ )
+        {
+            if( prvIsQueueEmpty( pxWaitRecords[ x ].xQueueOrSemaphore ) == pdFALSE )
+            {
+                xReturn = pdFALSE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_WAIT_FOR_ANY */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_QUEUE_SETS == 1 )
 
     static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue )
@@ -2744,22 +7166,46 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
         Queue_t * pxQueueSetContainer = pxQueue->pxQueueSetContainer;
         BaseType_t xReturn = pdFALSE;
 
+        #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+            const UBaseType_t uxIndex = ( UBaseType_t ) pxQueue->ucQueueSetIndex;
+        #endif
+
         /* This function must be called form a critical section. */
 
         /* The following line is not reachable in unit tests because every call
          * to prvNotifyQueueSetContainer is preceded by a check that
          * pxQueueSetContainer != NULL */
         configASSERT( pxQueueSetContainer ); /* LCOV_EXCL_BR_LINE */
-        configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
 
-        if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        /* The set is written as well as the member, so its spinlock is held
+         * too. */
+        queueGET_OBJECT_LOCK( pxQueueSetContainer );
+
+        #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+            /* Only a member that was not already ready needs to be recorded
+             * and to wake the task waiting on the set. */
+            if( queueSET_MEMBER_IS_READY( pxQueueSetContainer, uxIndex ) == pdFALSE )
+        #else
+            configASSERT( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength );
+
+            if( pxQueueSetContainer->uxMessagesWaiting < pxQueueSetContainer->uxLength )
+        #endif /* configUSE_QUEUE_SET_BITMAP */
         {
             const int8_t cTxLock = pxQueueSetContainer->cTxLock;
 
             traceQUEUE_SET_SEND( pxQueueSetContainer );
 
-            /* The data copied is the handle of the queue that contains data. */
-            xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+            #if ( configUSE_QUEUE_SET_BITMAP == 1 )
+            {
+                queueSET_READY_BITS( pxQueueSetContainer )[ uxIndex >> 3 ] |= ( uint8_t ) ( 1U << ( uxIndex & 7U ) );
+                pxQueueSetContainer->uxMessagesWaiting++;
+            }
+            #else
+            {
+                /* The data copied is the handle of the queue that contains data. */
+                xReturn = prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+            }
+            #endif /* configUSE_QUEUE_SET_BITMAP */
 
             if( cTxLock == queueUNLOCKED )
             {
@@ -2790,7 +7236,92 @@ BaseType_t xQueueIsQueueFullFromISR( const QueueHandle_t xQueue )
             mtCOVERAGE_TEST_MARKER();
         }
 
+        queueRELEASE_OBJECT_LOCK( pxQueueSetContainer );
+
         return xReturn;
     }
 
 #endif /* configUSE_QUEUE_SETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_SET_BITMAP == 1 )
+
+    static void prvClearQueueSetMemberReady( const Queue_t * const pxQueue )
+    {
+        Queue_t * const pxQueueSet = pxQueue->pxQueueSetContainer;
+        const UBaseType_t uxIndex = ( UBaseType_t ) pxQueue->ucQueueSetIndex;
+
+        /* This function must be called from a critical section. */
+        queueGET_OBJECT_LOCK( pxQueueSet );
+
+        if( queueSET_MEMBER_IS_READY( pxQueueSet, uxIndex ) != pdFALSE )
+        {
+            queueSET_READY_BITS( pxQueueSet )[ uxIndex >> 3 ] &= ( uint8_t ) ~( uint8_t ) ( 1U << ( uxIndex & 7U ) );
+            pxQueueSet->uxMessagesWaiting--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        queueRELEASE_OBJECT_LOCK( pxQueueSet );
+    }
+    /*-----------------------------------------------------------*/
+
+    static void prvSelectQueueSetMember( Queue_t * const pxQueueSet,
+                                         void * const pvBuffer )
+    {
+        uint8_t * const pucNextIndex = queueSET_NEXT_INDEX( pxQueueSet );
+        const uint8_t * const pucReadyBits = queueSET_READY_BITS( pxQueueSet );
+        UBaseType_t uxIndex = ( UBaseType_t ) *pucNextIndex;
+        UBaseType_t uxChecked;
+
+        /* This function is called from a critical section, and the caller has
+         * already checked that at least one member is ready.  Whole bytes of
+         * the bitmap are skipped while no member they cover is ready. */
+        for( uxChecked = ( UBaseType_t ) 0U; uxChecked < pxQueueSet->uxLength; uxChecked++ )
+        {
+            if( queueSET_MEMBER_IS_READY( pxQueueSet, uxIndex ) != pdFALSE )
+            {
+                break;
+            }
+            else if( ( ( uxIndex & 7U ) == 0U ) && ( pucReadyBits[ uxIndex >> 3 ] == 0U ) && ( ( uxIndex + 8U ) <= pxQueueSet->uxLength ) )
+            {
+                uxChecked += ( UBaseType_t ) 7U;
+                uxIndex += ( UBaseType_t ) 8U;
+            }
+            else
+            {
+                uxIndex++;
+            }
+
+            if( uxIndex >= pxQueueSet->uxLength )
+            {
+                uxIndex = ( UBaseType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        configASSERT( queueSET_MEMBER_IS_READY( pxQueueSet, uxIndex ) != pdFALSE );
+
+        ( void ) memcpy( pvBuffer, ( void * ) &( queueSET_MEMBERS( pxQueueSet )[ uxIndex ] ), sizeof( Queue_t * ) ); /*lint !e9087 memcpy() requires void *. */
+
+        /* Start the next search after this member. */
+        uxIndex++;
+
+        if( uxIndex >= pxQueueSet->uxLength )
+        {
+            uxIndex = ( UBaseType_t ) 0U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        *pucNextIndex = ( uint8_t ) uxIndex;
+    }
+
+#endif /* configUSE_QUEUE_SET_BITMAP */
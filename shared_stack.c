@@ -0,0 +1,391 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "shared_stack.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include shared stack tasks.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_SHARED_STACK_TASKS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use shared stack tasks.
+    #endif
+
+    #if ( configUSE_QUEUE_WAIT_FOR_ANY != 1 )
+        #error configUSE_QUEUE_WAIT_FOR_ANY must be set to 1 to use shared stack tasks.
+    #endif
+
+/* A shared stack task is in its shared stack's activated list from the time
+ * it is activated until its function is called. */
+    typedef struct SharedStackTaskDefinition
+    {
+        SharedStackTaskFunction_t pxFunction;         /*< The function called for each activation. */
+        void * pvParameters;                          /*< The value passed to pxFunction. */
+        struct SharedStackDefinition * pxSharedStack; /*< The shared stack the task runs on. */
+        ListItem_t xActivationListItem;               /*< References the activated list of the shared stack while the task is waiting to run. */
+        uint32_t ulNotifiedValue;                     /*< The bits set since the task was last run. */
+    } SharedStackTask_t;
+
+/* The host task blocks on the wake semaphore, which is given when a task is
+ * activated by a notification, and on the activation queues.  The wait records
+ * and the tasks they activate are allocated in the same block as the shared
+ * stack.  The task activated by record n is pxQueueTasks[ n - 1 ]. */
+    typedef struct SharedStackDefinition
+    {
+        TaskHandle_t xHostTask;               /*< The task on whose stack the shared stack tasks run. */
+        SemaphoreHandle_t xWakeSemaphore;     /*< Given to unblock the host task when a task is notified. */
+        List_t xActivatedList;                /*< The tasks waiting to run, in the order they were activated. */
+        UBaseType_t uxMaxQueues;              /*< The number of entries in pxQueueTasks. */
+        volatile UBaseType_t uxQueues;        /*< The number of entries in pxQueueTasks that are used. */
+        QueueWaitRecord_t * pxWaitRecords;    /*< The objects the host task blocks on.  The first is always xWakeSemaphore. */
+        SharedStackTask_t ** pxQueueTasks;    /*< The tasks that have an activation queue. */
+    } SharedStack_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The function run by the host task of every shared stack.
+ */
+    static portTASK_FUNCTION_PROTO( prvSharedStackTask, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*
+ * Sets bits in the notification value of a task and appends the task to the
+ * activated list of its shared stack if it is not already there.  Returns
+ * pdTRUE if the task was appended.  Must be called from a critical section.
+ */
+    static BaseType_t prvActivateTask( SharedStackTask_t * pxTask,
+                                       uint32_t ulBitsToSet ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvActivateTask( SharedStackTask_t * pxTask,
+                                       uint32_t ulBitsToSet )
+    {
+        BaseType_t xActivated = pdFALSE;
+
+        pxTask->ulNotifiedValue |= ulBitsToSet;
+
+        if( listLIST_ITEM_CONTAINER( &( pxTask->xActivationListItem ) ) == NULL )
+        {
+            listINSERT_END( &( pxTask->pxSharedStack->xActivatedList ), &( pxTask->xActivationListItem ) );
+            xActivated = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xActivated;
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvSharedStackTask, pvParameters )
+    {
+        SharedStack_t * const pxSharedStack = ( SharedStack_t * ) pvParameters; /*lint !e9087 The parameter is always the shared stack the task hosts. */
+        SharedStackTask_t * pxTask;
+        QueueSetMemberHandle_t xReady;
+        UBaseType_t uxQueues;
+        UBaseType_t ux;
+        uint32_t ulNotifiedValue;
+
+        for( ; ; )
+        {
+            /* Tasks with an activation queue can be added while the host task
+             * is blocked, in which case the wake semaphore is given so the new
+             * queue is included the next time round. */
+            uxQueues = pxSharedStack->uxQueues;
+            xReady = xQueueWaitForAny( pxSharedStack->pxWaitRecords, uxQueues + 1U, portMAX_DELAY );
+
+            if( xReady == ( QueueSetMemberHandle_t ) pxSharedStack->xWakeSemaphore )
+            {
+                ( void ) xSemaphoreTake( pxSharedStack->xWakeSemaphore, 0 );
+            }
+            else if( xReady != NULL )
+            {
+                for( ux = 1U; ux <= uxQueues; ux++ )
+                {
+                    if( pxSharedStack->pxWaitRecords[ ux ].xQueueOrSemaphore == xReady )
+                    {
+                        taskENTER_CRITICAL();
+                        {
+                            ( void ) prvActivateTask( pxSharedStack->pxQueueTasks[ ux - 1U ], 0U );
+                        }
+                        taskEXIT_CRITICAL();
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Run every activated task to completion.  Tasks activated while
+             * these run are appended to the list and run in turn. */
+            for( ; ; )
+            {
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_IS_EMPTY( &( pxSharedStack->xActivatedList ) ) == pdFALSE )
+                    {
+                        pxTask = listGET_OWNER_OF_HEAD_ENTRY( &( pxSharedStack->xActivatedList ) );
+                        ( void ) uxListRemove( &( pxTask->xActivationListItem ) );
+                        ulNotifiedValue = pxTask->ulNotifiedValue;
+                        pxTask->ulNotifiedValue = 0U;
+                    }
+                    else
+                    {
+                        pxTask = NULL;
+                        ulNotifiedValue = 0U;
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxTask == NULL )
+                {
+                    break;
+                }
+
+                traceSHARED_STACK_TASK_START( pxTask );
+
+                pxTask->pxFunction( pxTask->pvParameters, ulNotifiedValue );
+
+                traceSHARED_STACK_TASK_END( pxTask );
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    SharedStackHandle_t xSharedStackCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                            configSTACK_DEPTH_TYPE uxStackDepth,
+                                            UBaseType_t uxPriority,
+                                            UBaseType_t uxMaxQueues )
+    {
+        SharedStack_t * pxSharedStack;
+
+        /* One more wait record than queues is needed for the wake semaphore. */
+        pxSharedStack = ( SharedStack_t * ) pvPortMalloc( sizeof( SharedStack_t ) +
+                                                          ( ( uxMaxQueues + 1U ) * sizeof( QueueWaitRecord_t ) ) +
+                                                          ( uxMaxQueues * sizeof( SharedStackTask_t * ) ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxSharedStack != NULL )
+        {
+            vListInitialise( &( pxSharedStack->xActivatedList ) );
+            pxSharedStack->uxMaxQueues = uxMaxQueues;
+            pxSharedStack->uxQueues = 0U;
+            pxSharedStack->pxWaitRecords = ( QueueWaitRecord_t * ) &( pxSharedStack[ 1 ] ); /*lint !e9087 The records follow the shared stack structure in the same allocation. */
+            pxSharedStack->pxQueueTasks = ( SharedStackTask_t ** ) &( pxSharedStack->pxWaitRecords[ uxMaxQueues + 1U ] ); /*lint !e9087 The task pointers follow the records in the same allocation. */
+            pxSharedStack->xWakeSemaphore = xSemaphoreCreateBinary();
+
+            if( pxSharedStack->xWakeSemaphore != NULL )
+            {
+                pxSharedStack->pxWaitRecords[ 0 ].xQueueOrSemaphore = pxSharedStack->xWakeSemaphore;
+
+                if( xTaskCreate( prvSharedStackTask,
+                                 pcName,
+                                 uxStackDepth,
+                                 ( void * ) pxSharedStack,
+                                 uxPriority,
+                                 &( pxSharedStack->xHostTask ) ) != pdPASS )
+                {
+                    vSemaphoreDelete( pxSharedStack->xWakeSemaphore );
+                    pxSharedStack->xWakeSemaphore = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxSharedStack->xWakeSemaphore == NULL )
+            {
+                vPortFree( pxSharedStack );
+                pxSharedStack = NULL;
+            }
+            else
+            {
+                traceSHARED_STACK_CREATE( pxSharedStack );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxSharedStack;
+    }
+/*-----------------------------------------------------------*/
+
+    SharedStackTaskHandle_t xSharedStackTaskCreate( SharedStackHandle_t xSharedStack,
+                                                    SharedStackTaskFunction_t pxFunction,
+                                                    void * pvParameters,
+                                                    QueueHandle_t xActivationQueue )
+    {
+        SharedStack_t * const pxSharedStack = xSharedStack;
+        SharedStackTask_t * pxTask = NULL;
+        UBaseType_t uxQueue;
+
+        configASSERT( pxSharedStack );
+        configASSERT( pxFunction );
+
+        if( ( xActivationQueue == NULL ) || ( pxSharedStack->uxQueues < pxSharedStack->uxMaxQueues ) )
+        {
+            pxTask = ( SharedStackTask_t * ) pvPortMalloc( sizeof( SharedStackTask_t ) ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pxTask != NULL )
+        {
+            pxTask->pxFunction = pxFunction;
+            pxTask->pvParameters = pvParameters;
+            pxTask->pxSharedStack = pxSharedStack;
+            pxTask->ulNotifiedValue = 0U;
+            vListInitialiseItem( &( pxTask->xActivationListItem ) );
+            listSET_LIST_ITEM_OWNER( &( pxTask->xActivationListItem ), pxTask );
+
+            if( xActivationQueue != NULL )
+            {
+                /* The host task only reads the entries below uxQueues, so the
+                 * new entry is filled in before uxQueues is incremented. */
+                taskENTER_CRITICAL();
+                {
+                    configASSERT( pxSharedStack->uxQueues < pxSharedStack->uxMaxQueues );
+
+                    for( uxQueue = 1U; uxQueue <= pxSharedStack->uxQueues; uxQueue++ )
+                    {
+                        configASSERT( pxSharedStack->pxWaitRecords[ uxQueue ].xQueueOrSemaphore != xActivationQueue );
+                    }
+
+                    pxSharedStack->pxWaitRecords[ uxQueue ].xQueueOrSemaphore = xActivationQueue;
+                    pxSharedStack->pxQueueTasks[ uxQueue - 1U ] = pxTask;
+                    pxSharedStack->uxQueues = uxQueue;
+                }
+                taskEXIT_CRITICAL();
+
+                ( void ) xSemaphoreGive( pxSharedStack->xWakeSemaphore );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            traceSHARED_STACK_TASK_CREATE( pxTask );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxTask;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSharedStackTaskNotify( SharedStackTaskHandle_t xTask,
+                                       uint32_t ulBitsToSet )
+    {
+        SharedStackTask_t * const pxTask = xTask;
+        BaseType_t xActivated;
+
+        configASSERT( pxTask );
+
+        taskENTER_CRITICAL();
+        {
+            xActivated = prvActivateTask( pxTask, ulBitsToSet );
+        }
+        taskEXIT_CRITICAL();
+
+        if( xActivated != pdFALSE )
+        {
+            ( void ) xSemaphoreGive( pxTask->pxSharedStack->xWakeSemaphore );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xSharedStackTaskNotifyFromISR( SharedStackTaskHandle_t xTask,
+                                              uint32_t ulBitsToSet,
+                                              BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        SharedStackTask_t * const pxTask = xTask;
+        BaseType_t xActivated;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( pxTask );
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
+        {
+            xActivated = prvActivateTask( pxTask, ulBitsToSet );
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        if( xActivated != pdFALSE )
+        {
+            ( void ) xSemaphoreGiveFromISR( pxTask->pxSharedStack->xWakeSemaphore, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pdPASS;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include shared stack tasks.  This #if is closed at the very bottom of this
+ * file. */
+#endif /* configUSE_SHARED_STACK_TASKS == 1 */
@@ -0,0 +1,552 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "spsc_queue.h"
+
+#if ( configUSE_TASK_NOTIFICATIONS != 1 )
+    #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build spsc_queue.c
+#endif
+
+#if ( INCLUDE_xTaskGetCurrentTaskHandle != 1 )
+    #error INCLUDE_xTaskGetCurrentTaskHandle must be set to 1 to build spsc_queue.c
+#endif
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/*
+ * The writer and the reader each own half of the structure.  uxHead and
+ * uxWriteIndex are only written by the writer, and uxTail and uxReadIndex are
+ * only written by the reader, so neither side needs to perform an atomic read
+ * modify write operation or enter a critical section to access the data.
+ * uxHead and uxTail are free running counts of the items written and read, so
+ * their difference is the number of items in the queue even after they wrap.
+ * portMEMORY_BARRIER() orders the copying of an item against the update of the
+ * count that makes it visible to the other side.
+ *
+ * A side that has to wait publishes its handle in xTaskWaitingToReceive or
+ * xTaskWaitingToSend, then checks the queue again before blocking on its task
+ * notification.  The other side checks the handle after updating its count,
+ * so at least one of them sees the other's update and a wake up cannot be
+ * missed.  The kernel is only entered when a task actually has to be woken.
+ */
+typedef struct SPSCQueueDefinition
+{
+    volatile UBaseType_t uxHead;                 /*< The number of items written, only updated by the writer. */
+    UBaseType_t uxWriteIndex;                    /*< The index of the next slot to write, only used by the writer. */
+    volatile UBaseType_t uxTail;                 /*< The number of items read, only updated by the reader. */
+    UBaseType_t uxReadIndex;                     /*< The index of the next slot to read, only used by the reader. */
+    UBaseType_t uxLength;                        /*< The number of items the queue can hold. */
+    UBaseType_t uxItemSize;                      /*< The size of each item in bytes. */
+    uint8_t * pucStorage;                        /*< The storage area of uxLength * uxItemSize bytes. */
+    volatile TaskHandle_t xTaskWaitingToReceive; /*< The reader while it is waiting for an item, otherwise NULL. */
+    volatile TaskHandle_t xTaskWaitingToSend;    /*< The writer while it is waiting for space, otherwise NULL. */
+    uint8_t ucStaticallyAllocated;               /*< Set to pdTRUE if the memory used by the queue was statically allocated so no attempt is made to free it. */
+} SPSCQueue_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called by both the dynamic and static create functions to fill in the
+ * members of a newly created queue.
+ */
+static void prvInitialiseNewSPSCQueue( SPSCQueue_t * const pxQueue,
+                                       const UBaseType_t uxQueueLength,
+                                       const UBaseType_t uxItemSize,
+                                       uint8_t * const pucQueueStorage,
+                                       const uint8_t ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item into the queue if there is space, returning pdPASS if it was
+ * copied, otherwise pdFAIL.  Only called by the writer.
+ */
+static BaseType_t prvWriteItem( SPSCQueue_t * const pxQueue,
+                                const void * pvItemToQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Copies an item out of the queue if there is one, returning pdPASS if it was
+ * copied, otherwise pdFAIL.  Only called by the reader.
+ */
+static BaseType_t prvReadItem( SPSCQueue_t * const pxQueue,
+                               void * const pvBuffer ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewSPSCQueue( SPSCQueue_t * const pxQueue,
+                                       const UBaseType_t uxQueueLength,
+                                       const UBaseType_t uxItemSize,
+                                       uint8_t * const pucQueueStorage,
+                                       const uint8_t ucStaticallyAllocated )
+{
+    ( void ) memset( ( void * ) pxQueue, 0x00, sizeof( SPSCQueue_t ) ); /*lint !e9087 memset() requires void *. */
+    pxQueue->uxLength = uxQueueLength;
+    pxQueue->uxItemSize = uxItemSize;
+    pxQueue->pucStorage = pucQueueStorage;
+    pxQueue->ucStaticallyAllocated = ucStaticallyAllocated;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    SPSCQueueHandle_t xSPSCQueueCreate( const UBaseType_t uxQueueLength,
+                                        const UBaseType_t uxItemSize )
+    {
+        uint8_t * pucAllocatedMemory = NULL;
+        size_t xStorageSizeBytes;
+
+        configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+
+        /* Check for multiplication and addition overflow, then allocate the
+         * SPSCQueue_t structure and the storage area in a single call to
+         * pvPortMalloc().  The structure is placed at the start of the
+         * allocated memory and the storage area follows immediately after. */
+        if( ( ( SIZE_MAX / uxQueueLength ) >= uxItemSize ) &&
+            ( ( SIZE_MAX - sizeof( SPSCQueue_t ) ) >= ( ( size_t ) uxQueueLength * ( size_t ) uxItemSize ) ) )
+        {
+            xStorageSizeBytes = ( size_t ) uxQueueLength * ( size_t ) uxItemSize;
+            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( sizeof( SPSCQueue_t ) + xStorageSizeBytes ); /*lint !e9079 malloc() only returns void*. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( pucAllocatedMemory != NULL )
+        {
+            prvInitialiseNewSPSCQueue( ( SPSCQueue_t * ) pucAllocatedMemory,        /* Structure at the start of the allocated memory. */ /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+                                       uxQueueLength,
+                                       uxItemSize,
+                                       pucAllocatedMemory + sizeof( SPSCQueue_t ), /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer. */
+                                       ( uint8_t ) pdFALSE );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return ( SPSCQueueHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
+    }
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+
+    SPSCQueueHandle_t xSPSCQueueCreateStatic( const UBaseType_t uxQueueLength,
+                                              const UBaseType_t uxItemSize,
+                                              uint8_t * const pucQueueStorage,
+                                              StaticSPSCQueue_t * const pxStaticQueue )
+    {
+        SPSCQueue_t * const pxQueue = ( SPSCQueue_t * ) pxStaticQueue; /*lint !e740 !e9087 Safe cast as StaticSPSCQueue_t is opaque SPSCQueue_t. */
+        SPSCQueueHandle_t xReturn = NULL;
+
+        configASSERT( uxQueueLength > ( UBaseType_t ) 0 );
+        configASSERT( uxItemSize > ( UBaseType_t ) 0 );
+        configASSERT( pucQueueStorage );
+        configASSERT( pxStaticQueue );
+
+        #if ( configASSERT_DEFINED == 1 )
+        {
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticSPSCQueue_t equals the size of the real
+             * queue structure. */
+            volatile size_t xSize = sizeof( StaticSPSCQueue_t );
+            configASSERT( xSize == sizeof( SPSCQueue_t ) );
+        } /*lint !e529 xSize is referenced if configASSERT() is defined. */
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pucQueueStorage != NULL ) && ( pxStaticQueue != NULL ) )
+        {
+            prvInitialiseNewSPSCQueue( pxQueue, uxQueueLength, uxItemSize, pucQueueStorage, ( uint8_t ) pdTRUE );
+            xReturn = ( SPSCQueueHandle_t ) pxQueue;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configSUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vSPSCQueueDelete( SPSCQueueHandle_t xQueue )
+{
+    SPSCQueue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+    {
+        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+        {
+            /* Both the structure and the storage area were allocated using a
+             * single call to pvPortMalloc(), hence only one call to vPortFree()
+             * is required. */
+            vPortFree( ( void * ) pxQueue ); /*lint !e9087 Standard free() semantics require void *. */
+        }
+        #else
+        {
+            /* Should not be possible to get here, the flag must be corrupt.
+             * Force an assert. */
+            configASSERT( xQueue == ( SPSCQueueHandle_t ) ~0 );
+        }
+        #endif
+    }
+    else
+    {
+        /* The structure was not allocated dynamically and cannot be freed -
+         * just scrub it so future use will assert. */
+        ( void ) memset( ( void * ) pxQueue, 0x00, sizeof( SPSCQueue_t ) );
+    }
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvWriteItem( SPSCQueue_t * const pxQueue,
+                                const void * pvItemToQueue )
+{
+    BaseType_t xReturn = pdFAIL;
+    const UBaseType_t uxHead = pxQueue->uxHead;
+
+    if( ( UBaseType_t ) ( uxHead - pxQueue->uxTail ) < pxQueue->uxLength )
+    {
+        ( void ) memcpy( ( void * ) &( pxQueue->pucStorage[ pxQueue->uxWriteIndex * pxQueue->uxItemSize ] ), pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e9087 memcpy() requires void *. */
+
+        pxQueue->uxWriteIndex++;
+
+        if( pxQueue->uxWriteIndex == pxQueue->uxLength )
+        {
+            pxQueue->uxWriteIndex = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The item must be in the storage area before the reader can see the
+         * updated count. */
+        portMEMORY_BARRIER();
+        pxQueue->uxHead = uxHead + ( UBaseType_t ) 1;
+
+        /* The reader must see the updated count before its waiting state is
+         * checked. */
+        portMEMORY_BARRIER();
+        xReturn = pdPASS;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReadItem( SPSCQueue_t * const pxQueue,
+                               void * const pvBuffer )
+{
+    BaseType_t xReturn = pdFAIL;
+    const UBaseType_t uxTail = pxQueue->uxTail;
+
+    if( pxQueue->uxHead != uxTail )
+    {
+        /* The count must be read before the item it makes visible. */
+        portMEMORY_BARRIER();
+        ( void ) memcpy( pvBuffer, ( void * ) &( pxQueue->pucStorage[ pxQueue->uxReadIndex * pxQueue->uxItemSize ] ), ( size_t ) pxQueue->uxItemSize ); /*lint !e9087 memcpy() requires void *. */
+
+        pxQueue->uxReadIndex++;
+
+        if( pxQueue->uxReadIndex == pxQueue->uxLength )
+        {
+            pxQueue->uxReadIndex = ( UBaseType_t ) 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The item must have been copied out before the writer can reuse the
+         * slot. */
+        portMEMORY_BARRIER();
+        pxQueue->uxTail = uxTail + ( UBaseType_t ) 1;
+        portMEMORY_BARRIER();
+        xReturn = pdPASS;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCQueueSend( SPSCQueueHandle_t xQueue,
+                           const void * const pvItemToQueue,
+                           TickType_t xTicksToWait )
+{
+    SPSCQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemToQueue );
+
+    xReturn = prvWriteItem( pxQueue, pvItemToQueue );
+
+    if( ( xReturn == pdFAIL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Clear any stale notification, then publish that this task is
+             * waiting before looking at the queue again so a read that frees
+             * space after the check still unblocks this task. */
+            ( void ) xTaskNotifyStateClear( NULL );
+
+            /* Should only be one writer. */
+            configASSERT( pxQueue->xTaskWaitingToSend == NULL );
+            pxQueue->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+            portMEMORY_BARRIER();
+
+            xReturn = prvWriteItem( pxQueue, pvItemToQueue );
+
+            if( xReturn == pdFAIL )
+            {
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                xReturn = prvWriteItem( pxQueue, pvItemToQueue );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxQueue->xTaskWaitingToSend = NULL;
+        } while( ( xReturn == pdFAIL ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn == pdPASS )
+    {
+        /* Was a task waiting for the data? */
+        xTaskToNotify = pxQueue->xTaskWaitingToReceive;
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        xReturn = errQUEUE_FULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCQueueSendFromISR( SPSCQueueHandle_t xQueue,
+                                  const void * const pvItemToQueue,
+                                  BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SPSCQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxQueue );
+    configASSERT( pvItemToQueue );
+
+    if( prvWriteItem( pxQueue, pvItemToQueue ) == pdPASS )
+    {
+        /* Was a task waiting for the data?  Only then is the kernel entered. */
+        xTaskToNotify = pxQueue->xTaskWaitingToReceive;
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_FULL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCQueueReceive( SPSCQueueHandle_t xQueue,
+                              void * const pvBuffer,
+                              TickType_t xTicksToWait )
+{
+    SPSCQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+    TimeOut_t xTimeOut;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+
+    xReturn = prvReadItem( pxQueue, pvBuffer );
+
+    if( ( xReturn == pdFAIL ) && ( xTicksToWait != ( TickType_t ) 0 ) )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Clear any stale notification, then publish that this task is
+             * waiting before looking at the queue again so a write made after
+             * the check still unblocks this task. */
+            ( void ) xTaskNotifyStateClear( NULL );
+
+            /* Should only be one reader. */
+            configASSERT( pxQueue->xTaskWaitingToReceive == NULL );
+            pxQueue->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            portMEMORY_BARRIER();
+
+            xReturn = prvReadItem( pxQueue, pvBuffer );
+
+            if( xReturn == pdFAIL )
+            {
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                xReturn = prvReadItem( pxQueue, pvBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxQueue->xTaskWaitingToReceive = NULL;
+        } while( ( xReturn == pdFAIL ) && ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    if( xReturn == pdPASS )
+    {
+        /* Was a task waiting for space? */
+        xTaskToNotify = pxQueue->xTaskWaitingToSend;
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotify( xTaskToNotify, ( uint32_t ) 0, eNoAction );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        xReturn = errQUEUE_EMPTY;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xSPSCQueueReceiveFromISR( SPSCQueueHandle_t xQueue,
+                                     void * const pvBuffer,
+                                     BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    SPSCQueue_t * const pxQueue = xQueue;
+    BaseType_t xReturn;
+    TaskHandle_t xTaskToNotify;
+
+    configASSERT( pxQueue );
+    configASSERT( pvBuffer );
+
+    if( prvReadItem( pxQueue, pvBuffer ) == pdPASS )
+    {
+        /* Was a task waiting for space?  Only then is the kernel entered. */
+        xTaskToNotify = pxQueue->xTaskWaitingToSend;
+
+        if( xTaskToNotify != NULL )
+        {
+            ( void ) xTaskNotifyFromISR( xTaskToNotify, ( uint32_t ) 0, eNoAction, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = errQUEUE_EMPTY;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxSPSCQueueMessagesWaiting( const SPSCQueueHandle_t xQueue )
+{
+    const SPSCQueue_t * const pxQueue = xQueue;
+
+    configASSERT( pxQueue );
+
+    /* Correct even after the counts have wrapped. */
+    return ( UBaseType_t ) ( pxQueue->uxHead - pxQueue->uxTail );
+}
+/*-----------------------------------------------------------*/
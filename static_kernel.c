@@ -0,0 +1,201 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "semphr.h"
+#include "event_groups.h"
+#include "timers.h"
+#include "static_kernel.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to use the static kernel profile.  This #if is closed at the very bottom of
+ * this file. */
+#if ( configUSE_STATIC_KERNEL == 1 )
+
+/* Define the memory of each object in the tables, and declare the application
+ * functions the tables name. */
+    #define skDEFINE_TASK( xName, pxTaskCode, uxStackDepth, pvParameters, uxPriority ) \
+    extern void pxTaskCode( void * pvTaskParameters );                                 \
+    StaticTask_t xStaticKernelTask_##xName;                                            \
+    static StackType_t uxStaticKernelStack_##xName[ uxStackDepth ];
+
+    #define skDEFINE_QUEUE( xName, uxQueueLength, uxItemSize )                      \
+    StaticQueue_t xStaticKernelQueue_##xName;                                       \
+    static uint8_t ucStaticKernelQueueStorage_##xName[ ( uxQueueLength ) * ( uxItemSize ) ];
+
+    #define skDEFINE_SEMAPHORE( xName ) \
+    StaticSemaphore_t xStaticKernelSemaphore_##xName;
+
+    #define skDEFINE_COUNTING_SEMAPHORE( xName, uxMaxCount, uxInitialCount ) \
+    StaticSemaphore_t xStaticKernelSemaphore_##xName;
+
+    #define skDEFINE_EVENT_GROUP( xName ) \
+    StaticEventGroup_t xStaticKernelEventGroup_##xName;
+
+    #define skDEFINE_TIMER( xName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction ) \
+    extern void pxCallbackFunction( TimerHandle_t xTimer );                                           \
+    StaticTimer_t xStaticKernelTimer_##xName;
+
+    configSTATIC_KERNEL_TASKS( skDEFINE_TASK )
+    configSTATIC_KERNEL_QUEUES( skDEFINE_QUEUE )
+    configSTATIC_KERNEL_BINARY_SEMAPHORES( skDEFINE_SEMAPHORE )
+    configSTATIC_KERNEL_COUNTING_SEMAPHORES( skDEFINE_COUNTING_SEMAPHORE )
+    configSTATIC_KERNEL_MUTEXES( skDEFINE_SEMAPHORE )
+    configSTATIC_KERNEL_EVENT_GROUPS( skDEFINE_EVENT_GROUP )
+
+    #if ( configUSE_TIMERS == 1 )
+        configSTATIC_KERNEL_TIMERS( skDEFINE_TIMER )
+    #endif
+
+/* Add a queue or semaphore to the queue registry under the name of its table
+ * entry. */
+    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+        #define skREGISTER( xQueue, xName )    vQueueAddToRegistry( ( xQueue ), #xName )
+    #else
+        #define skREGISTER( xQueue, xName )
+    #endif
+
+/* Create each object in the tables.  Creating an object from memory that is
+ * not NULL cannot fail, and the kernel uses the memory as the object, so the
+ * handles returned are the same as the sk...() handle macros and are not kept. */
+    #define skCREATE_TASK( xName, pxTaskCode, uxStackDepth, pvParameters, uxPriority ) \
+    ( void ) xTaskCreateStatic( pxTaskCode, #xName, ( uint32_t ) ( uxStackDepth ), ( pvParameters ), ( uxPriority ), uxStaticKernelStack_##xName, &( xStaticKernelTask_##xName ) );
+
+    #define skCREATE_QUEUE( xName, uxQueueLength, uxItemSize )                                                                               \
+    ( void ) xQueueCreateStatic( ( uxQueueLength ), ( uxItemSize ), ucStaticKernelQueueStorage_##xName, &( xStaticKernelQueue_##xName ) ); \
+    skREGISTER( skQUEUE( xName ), xName );
+
+    #define skCREATE_BINARY_SEMAPHORE( xName )                                     \
+    ( void ) xSemaphoreCreateBinaryStatic( &( xStaticKernelSemaphore_##xName ) ); \
+    skREGISTER( skSEMAPHORE( xName ), xName );
+
+    #define skCREATE_COUNTING_SEMAPHORE( xName, uxMaxCount, uxInitialCount )                                             \
+    ( void ) xSemaphoreCreateCountingStatic( ( uxMaxCount ), ( uxInitialCount ), &( xStaticKernelSemaphore_##xName ) ); \
+    skREGISTER( skSEMAPHORE( xName ), xName );
+
+    #define skCREATE_MUTEX( xName )                                               \
+    ( void ) xSemaphoreCreateMutexStatic( &( xStaticKernelSemaphore_##xName ) ); \
+    skREGISTER( skSEMAPHORE( xName ), xName );
+
+    #define skCREATE_EVENT_GROUP( xName ) \
+    ( void ) xEventGroupCreateStatic( &( xStaticKernelEventGroup_##xName ) );
+
+    #define skCREATE_TIMER( xName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction ) \
+    ( void ) xTimerCreateStatic( #xName, ( xTimerPeriodInTicks ), ( xAutoReload ), ( pvTimerID ), pxCallbackFunction, &( xStaticKernelTimer_##xName ) );
+
+/* The memory of the idle task, or idle tasks, and of the timer service task. */
+    static StaticTask_t xIdleTaskTCB;
+    static StackType_t uxIdleTaskStack[ configMINIMAL_STACK_SIZE ];
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        static StaticTask_t xPassiveIdleTaskTCBs[ configNUMBER_OF_CORES - 1 ];
+        static StackType_t uxPassiveIdleTaskStacks[ configNUMBER_OF_CORES - 1 ][ configMINIMAL_STACK_SIZE ];
+    #endif
+
+    #if ( configUSE_TIMERS == 1 )
+        static StaticTask_t xTimerTaskTCB;
+        static StackType_t uxTimerTaskStack[ configTIMER_TASK_STACK_DEPTH ];
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    void vStaticKernelCreateObjects( void )
+    {
+        /* The objects the tasks use are created first, although no task runs
+         * until the scheduler has started. */
+        configSTATIC_KERNEL_QUEUES( skCREATE_QUEUE )
+        configSTATIC_KERNEL_BINARY_SEMAPHORES( skCREATE_BINARY_SEMAPHORE )
+        configSTATIC_KERNEL_COUNTING_SEMAPHORES( skCREATE_COUNTING_SEMAPHORE )
+        configSTATIC_KERNEL_MUTEXES( skCREATE_MUTEX )
+        configSTATIC_KERNEL_EVENT_GROUPS( skCREATE_EVENT_GROUP )
+
+        #if ( configUSE_TIMERS == 1 )
+            configSTATIC_KERNEL_TIMERS( skCREATE_TIMER )
+        #endif
+
+        configSTATIC_KERNEL_TASKS( skCREATE_TASK )
+    }
+/*-----------------------------------------------------------*/
+
+    void vApplicationGetIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                        StackType_t ** ppxIdleTaskStackBuffer,
+                                        uint32_t * pulIdleTaskStackSize )
+    {
+        *ppxIdleTaskTCBBuffer = &xIdleTaskTCB;
+        *ppxIdleTaskStackBuffer = uxIdleTaskStack;
+        *pulIdleTaskStackSize = ( uint32_t ) configMINIMAL_STACK_SIZE;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configNUMBER_OF_CORES > 1 )
+
+        void vApplicationGetPassiveIdleTaskMemory( StaticTask_t ** ppxIdleTaskTCBBuffer,
+                                                   StackType_t ** ppxIdleTaskStackBuffer,
+                                                   uint32_t * pulIdleTaskStackSize,
+                                                   BaseType_t xPassiveIdleTaskIndex )
+        {
+            *ppxIdleTaskTCBBuffer = &( xPassiveIdleTaskTCBs[ xPassiveIdleTaskIndex ] );
+            *ppxIdleTaskStackBuffer = &( uxPassiveIdleTaskStacks[ xPassiveIdleTaskIndex ][ 0 ] );
+            *pulIdleTaskStackSize = ( uint32_t ) configMINIMAL_STACK_SIZE;
+        }
+
+    #endif /* configNUMBER_OF_CORES > 1 */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMERS == 1 )
+
+        void vApplicationGetTimerTaskMemory( StaticTask_t ** ppxTimerTaskTCBBuffer,
+                                             StackType_t ** ppxTimerTaskStackBuffer,
+                                             uint32_t * pulTimerTaskStackSize )
+        {
+            *ppxTimerTaskTCBBuffer = &xTimerTaskTCB;
+            *ppxTimerTaskStackBuffer = uxTimerTaskStack;
+            *pulTimerTaskStackSize = ( uint32_t ) configTIMER_TASK_STACK_DEPTH;
+        }
+
+    #endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to use the static kernel profile.  If you want to use it then ensure
+ * configUSE_STATIC_KERNEL is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_STATIC_KERNEL == 1 */
@@ -40,6 +40,14 @@
 #include "task.h"
 #include "stream_buffer.h"
 
+#if ( ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 ) || ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 ) || ( configUSE_OVERFLOW_POLICY == 1 ) )
+    #include "atomic.h"
+#endif
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+    #include "object_registry.h"
+#endif
+
 #if ( configUSE_TASK_NOTIFICATIONS != 1 )
     #error configUSE_TASK_NOTIFICATIONS must be set to 1 to build stream_buffer.c
 #endif
@@ -98,7 +106,7 @@
     {                                                                                \
         UBaseType_t uxSavedInterruptStatus;                                          \
                                                                                      \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();  \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();      \
         {                                                                            \
             if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )                     \
             {                                                                        \
@@ -109,7 +117,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToSend = NULL;                       \
             }                                                                        \
         }                                                                            \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                 \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                        \
     }
 #endif /* sbRECEIVE_COMPLETED_FROM_ISR */
 
@@ -175,7 +183,7 @@
     {                                                                                   \
         UBaseType_t uxSavedInterruptStatus;                                             \
                                                                                         \
-        uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();     \
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();         \
         {                                                                               \
             if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )                     \
             {                                                                           \
@@ -186,7 +194,7 @@
                 ( pxStreamBuffer )->xTaskWaitingToReceive = NULL;                       \
             }                                                                           \
         }                                                                               \
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );                    \
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );                           \
     }
 #endif /* sbSEND_COMPLETE_FROM_ISR */
 
@@ -210,12 +218,141 @@
 
 /*lint -restore (9026) */
 
-/* The number of bytes used to hold the length of a message in the buffer. */
+/* The number of bytes used to hold the length of a message in the buffer, unless
+ * a different number was chosen when the message buffer was created. */
 #define sbBYTES_TO_STORE_MESSAGE_LENGTH    ( sizeof( configMESSAGE_BUFFER_LENGTH_TYPE ) )
 
 /* Bits stored in the ucFlags field of the stream buffer. */
 #define sbFLAGS_IS_MESSAGE_BUFFER          ( ( uint8_t ) 1 ) /* Set if the stream buffer was created as a message buffer, in which case it holds discrete messages rather than a stream. */
 #define sbFLAGS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 2 ) /* Set if the stream buffer was created using statically allocated memory. */
+#define sbFLAGS_IS_MULTI_PRODUCER          ( ( uint8_t ) 4 ) /* Set if the message buffer can be written to by more than one task or interrupt at a time. */
+#define sbFLAGS_LENGTH_BYTES_MASK          ( ( uint8_t ) 0x38 ) /* Holds the number of bytes used to store each message length if it was chosen when the message buffer was created, otherwise 0. */
+#define sbFLAGS_LENGTH_BYTES_SHIFT         ( 3U )
+#define sbFLAGS_IS_POWER_OF_TWO            ( ( uint8_t ) 0x40 ) /* Set if the length of the buffer is a power of two, in which case indexes are wrapped with a mask. */
+#define sbFLAGS_IS_CACHE_MAINTAINED        ( ( uint8_t ) 0x80 ) /* Set if the data cache is cleaned and invalidated over the bytes copied into and out of the buffer. */
+
+/* The message length width passed to the create functions is held above the
+ * buffer type and its options in xStreamBufferType - see
+ * sbTYPE_MESSAGE_LENGTH_BYTES(). */
+#define sbTYPE_MASK                        ( ( BaseType_t ) 0x03 )
+#define sbTYPE_LENGTH_BYTES_SHIFT          ( 4U )
+
+/* The number of bytes used to store the length of each message held in
+ * pxStreamBuffer. */
+#define sbGET_BYTES_TO_STORE_MESSAGE_LENGTH( pxStreamBuffer )                                                          \
+    ( ( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_LENGTH_BYTES_MASK ) != ( uint8_t ) 0 ) ?                                \
+      ( ( size_t ) ( ( pxStreamBuffer )->ucFlags & sbFLAGS_LENGTH_BYTES_MASK ) >> sbFLAGS_LENGTH_BYTES_SHIFT ) : \
+      sbBYTES_TO_STORE_MESSAGE_LENGTH )
+
+/* The size of every message held in pxStreamBuffer if it is a fixed size
+ * message buffer, otherwise 0. */
+#if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+    #define sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer )    ( ( pxStreamBuffer )->xMessageSize )
+#else
+    #define sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer )    ( ( size_t ) 0 )
+#endif
+
+#if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+
+/* The number of bytes stored ahead of the data of each message held in
+ * pxStreamBuffer - the message length, followed by the tick count at which the
+ * message was sent if messages in the buffer expire.  Messages in a fixed size
+ * message buffer, which cannot expire, have no header. */
+    #define sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer )                                       \
+    ( ( sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) != ( size_t ) 0 ) ? ( size_t ) 0 :          \
+      ( sbGET_BYTES_TO_STORE_MESSAGE_LENGTH( pxStreamBuffer ) +                                \
+        ( ( ( pxStreamBuffer )->xMessageLifetime != ( TickType_t ) 0 ) ? sizeof( TickType_t ) : ( size_t ) 0 ) ) )
+
+/* Discard the expired messages at the front of pxStreamBuffer before the
+ * reader counts the bytes available. */
+    #define sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer )                                             \
+    do {                                                                                          \
+        if( ( pxStreamBuffer )->xMessageLifetime != ( TickType_t ) 0 )                            \
+        {                                                                                         \
+            ( void ) prvDiscardExpiredMessages( ( pxStreamBuffer ), ( pxStreamBuffer )->xLength ); \
+        }                                                                                         \
+    } while( 0 )
+
+/* The space a writer needing xRequiredSpace bytes can use, after discarding
+ * expired messages to make room if there is not enough. */
+    #define sbSPACES_AVAILABLE_TO_SEND( pxStreamBuffer, xRequiredSpace )                                  \
+    ( ( ( pxStreamBuffer )->xMessageLifetime != ( TickType_t ) 0 ) ?                                     \
+      prvDiscardExpiredMessages( ( pxStreamBuffer ), ( xRequiredSpace ) ) : xStreamBufferSpacesAvailable( pxStreamBuffer ) )
+#else
+    #define sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer ) \
+    ( ( sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) != ( size_t ) 0 ) ? ( size_t ) 0 : sbGET_BYTES_TO_STORE_MESSAGE_LENGTH( pxStreamBuffer ) )
+    #define sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer )
+    #define sbSPACES_AVAILABLE_TO_SEND( pxStreamBuffer, xRequiredSpace )    xStreamBufferSpacesAvailable( pxStreamBuffer )
+#endif /* configUSE_MESSAGE_BUFFER_EXPIRY */
+
+/* Wraps xIndex, which must be less than twice the length of the buffer, back
+ * into the buffer.  The length of a power of two length buffer minus one is
+ * a mask of the valid indexes, so the compare and subtract is not needed. */
+#define sbWRAP_INDEX( pxStreamBuffer, xIndex )                                                 \
+    ( ( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_POWER_OF_TWO ) != ( uint8_t ) 0 ) ?         \
+      ( ( xIndex ) & ( ( pxStreamBuffer )->xLength - ( size_t ) 1 ) ) :                         \
+      ( ( ( xIndex ) >= ( pxStreamBuffer )->xLength ) ? ( ( xIndex ) - ( pxStreamBuffer )->xLength ) : ( xIndex ) ) )
+
+#if ( configUSE_STREAM_BUFFER_CACHE_MAINTENANCE == 1 )
+
+/* Write the bytes just copied into the storage area of a cache maintained
+ * buffer back to memory, or discard any stale copy of the bytes about to be
+ * copied out of it, so a DMA controller and the processor see the same data. */
+    #define sbCLEAN_STORAGE( pxStreamBuffer, pucStart, xCount )                            \
+    do {                                                                                  \
+        if( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_CACHE_MAINTAINED ) != ( uint8_t ) 0 ) \
+        {                                                                                 \
+            portCLEAN_DCACHE_BY_ADDRESS( ( pucStart ), ( xCount ) );                      \
+        }                                                                                 \
+    } while( 0 )
+
+    #define sbINVALIDATE_STORAGE( pxStreamBuffer, pucStart, xCount )                       \
+    do {                                                                                  \
+        if( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_CACHE_MAINTAINED ) != ( uint8_t ) 0 ) \
+        {                                                                                 \
+            portINVALIDATE_DCACHE_BY_ADDRESS( ( pucStart ), ( xCount ) );                 \
+        }                                                                                 \
+    } while( 0 )
+#else
+    #define sbCLEAN_STORAGE( pxStreamBuffer, pucStart, xCount )
+    #define sbINVALIDATE_STORAGE( pxStreamBuffer, pucStart, xCount )
+#endif /* configUSE_STREAM_BUFFER_CACHE_MAINTENANCE */
+
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+
+/* Record a send or receive of xBytes bytes, for vStreamBufferGetStats().  A
+ * send of zero bytes is recorded as a failed send.  The time a task spends
+ * blocked waiting for space or data is measured around its call to
+ * xTaskNotifyWait(). */
+    #define sbSTATS_SENDER                                           pdTRUE
+    #define sbSTATS_RECEIVER                                         pdFALSE
+    #define sbRECORD_SEND( pxStreamBuffer, xBytes )                  prvRecordStreamBufferSend( ( pxStreamBuffer ), ( xBytes ) )
+    #define sbRECORD_RECEIVE( pxStreamBuffer, xBytes )               prvRecordStreamBufferReceive( ( pxStreamBuffer ), ( xBytes ) )
+    #define sbBLOCK_START( xBlockStart )                             ( xBlockStart ) = xTaskGetTickCount()
+    #define sbBLOCK_END( pxStreamBuffer, xBlockStart, xSender )      prvAddStreamBufferBlockedTime( ( pxStreamBuffer ), ( xBlockStart ), ( xSender ) )
+#else
+    #define sbRECORD_SEND( pxStreamBuffer, xBytes )
+    #define sbRECORD_RECEIVE( pxStreamBuffer, xBytes )
+    #define sbBLOCK_START( xBlockStart )
+    #define sbBLOCK_END( pxStreamBuffer, xBlockStart, xSender )
+#endif /* configUSE_STREAM_BUFFER_STATS */
+
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+
+/* Add a newly created stream or message buffer to the object registry. */
+    #define sbREGISTER( pxStreamBuffer )                                                                   \
+    vObjectRegistryAdd( &( ( pxStreamBuffer )->xRegistryItem ), ( pxStreamBuffer ),                        \
+                        ( ( ( pxStreamBuffer )->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) ? \
+                        eObjectMessageBuffer : eObjectStreamBuffer, NULL )
+
+/* The members of the structure before the registry item, which
+ * prvInitialiseNewStreamBuffer() clears.  The registry item is left alone so
+ * a buffer that is reset stays in the registry. */
+    #define sbINITIALISED_BYTES    offsetof( StreamBuffer_t, xRegistryItem )
+#else
+    #define sbREGISTER( pxStreamBuffer )
+    #define sbINITIALISED_BYTES    sizeof( StreamBuffer_t )
+#endif /* configUSE_OBJECT_REGISTRY */
 
 /*-----------------------------------------------------------*/
 
@@ -223,9 +360,13 @@
 typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention uses tag. */
 {
     volatile size_t xTail;                       /* Index to the next item to read within the buffer. */
+    #if ( configSTREAM_BUFFER_CACHE_LINE_BYTES > 0 )
+        uint8_t ucTailPadding[ configSTREAM_BUFFER_CACHE_LINE_BYTES - sizeof( size_t ) ]; /* Keeps xTail, which is written by the reader, out of the cache line holding xHead, which is written by the writer. */
+    #endif
     volatile size_t xHead;                       /* Index to the next item to write within the buffer. */
     size_t xLength;                              /* The length of the buffer pointed to by pucBuffer. */
     size_t xTriggerLevelBytes;                   /* The number of bytes that must be in the stream buffer before a task that is waiting for data is unblocked. */
+    size_t xSendTriggerLevelBytes;               /* The number of bytes that must be free in the stream buffer before a task that is waiting for space is unblocked. */
     volatile TaskHandle_t xTaskWaitingToReceive; /* Holds the handle of a task waiting for data, or NULL if no tasks are waiting. */
     volatile TaskHandle_t xTaskWaitingToSend;    /* Holds the handle of a task waiting to send data to a message buffer that is full. */
     uint8_t * pucBuffer;                         /* Points to the buffer itself - that is - the RAM that stores the data passed through the buffer. */
@@ -239,6 +380,41 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
         StreamBufferCallbackFunction_t pxSendCompletedCallback;    /* Optional callback called on send complete. sbSEND_COMPLETED is called if this is NULL. */
         StreamBufferCallbackFunction_t pxReceiveCompletedCallback; /* Optional callback called on receive complete.  sbRECEIVE_COMPLETED is called if this is NULL. */
     #endif
+
+    #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+        volatile uint32_t ulReserveHead; /* Index to the end of the space reserved by writers of a multi producer message buffer.  xHead only moves up to it as messages are committed. */
+    #endif
+
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        size_t xBytesHighWater;          /* The most bytes the buffer has held since the statistics were reset. */
+        size_t xLastLevel;               /* The number of bytes in the buffer when the statistics were last updated. */
+        uint32_t ulSends;                /* The number of sends that wrote at least one byte. */
+        uint32_t ulSendsFailed;          /* The number of sends that wrote nothing because the buffer was full. */
+        uint32_t ulBytesSent;            /* The number of bytes written. */
+        uint32_t ulReceives;             /* The number of receives that read at least one byte. */
+        uint32_t ulBytesReceived;        /* The number of bytes read. */
+        uint32_t ulOccupancyTicks;       /* The number of bytes in the buffer summed over every tick. */
+        TickType_t xSendBlockedTicks;    /* The total time the writer has spent blocked waiting for space. */
+        TickType_t xReceiveBlockedTicks; /* The total time the reader has spent blocked waiting for data. */
+        TickType_t xLastLevelChange;     /* The tick count when xLastLevel was recorded. */
+    #endif
+
+    #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+        TickType_t xMessageLifetime; /* The number of ticks after which an unread message is discarded, or 0 if messages do not expire, in which case they are stored without the tick count at which they were sent. */
+    #endif
+
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+        uint8_t ucOverflowPolicy;             /* sbOVERFLOW_PARTIAL_WRITE or sbOVERFLOW_DROP_NEWEST, as set by xStreamBufferSetOverflowPolicy(). */
+        volatile UBaseType_t uxOverflowCount; /* The number of bytes, or for a message buffer messages, xStreamBufferSendFromISR() has dropped. */
+    #endif
+
+    #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+        size_t xMessageSize; /* The size of every message held by a fixed size message buffer, which stores no message lengths, or 0 for any other buffer. */
+    #endif
+
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+        ObjectRegistryItem_t xRegistryItem; /* Links the buffer into the object registry.  Must be the last member. */
+    #endif
 } StreamBuffer_t;
 
 /*
@@ -246,6 +422,24 @@ typedef struct StreamBufferDef_t                 /*lint !e9058 Style convention
  */
 static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
 
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+
+/*
+ * Functions that maintain the statistics returned by vStreamBufferGetStats().
+ * The writer and reader can run in different contexts, so the statistics are
+ * updated in an interrupt safe critical section.
+ */
+    static void prvUpdateStreamBufferOccupancy( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+    static void prvRecordStreamBufferSend( StreamBuffer_t * const pxStreamBuffer,
+                                           size_t xBytesSent ) PRIVILEGED_FUNCTION;
+    static void prvRecordStreamBufferReceive( StreamBuffer_t * const pxStreamBuffer,
+                                              size_t xBytesReceived ) PRIVILEGED_FUNCTION;
+    static void prvAddStreamBufferBlockedTime( StreamBuffer_t * const pxStreamBuffer,
+                                               TickType_t xBlockStart,
+                                               BaseType_t xSender ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_STATS */
+
 /*
  * Add xCount bytes from pucData into the pxStreamBuffer's data storage area.
  * This function does not update the buffer's xHead pointer, so multiple writes
@@ -262,6 +456,31 @@ static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
                                      size_t xCount,
                                      size_t xHead ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies the first xCount bytes held in the array of fragments pointed to by
+ * pxFragments into the buffer's data storage area, one fragment after another,
+ * using prvWriteBytesToBuffer().  Like prvWriteBytesToBuffer(), this does not
+ * update xHead, but returns the index that follows the last byte written.
+ */
+static size_t prvWriteFragmentsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                         const StreamBufferFragment_t * pxFragments,
+                                         size_t xCount,
+                                         size_t xHead ) PRIVILEGED_FUNCTION;
+
+/*
+ * Write the length of a message to, or read the length of a message from, a
+ * message buffer, using the number of bytes chosen for lengths when the message
+ * buffer was created.  Like prvWriteBytesToBuffer() and
+ * prvReadBytesFromBuffer(), these do not update xHead or xTail, but return the
+ * index that follows the length.
+ */
+static size_t prvWriteMessageLengthToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                             size_t xMessageLength,
+                                             size_t xHead ) PRIVILEGED_FUNCTION;
+static size_t prvReadMessageLengthFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                              size_t * const pxMessageLength,
+                                              size_t xTail ) PRIVILEGED_FUNCTION;
+
 /*
  * If the stream buffer is being used as a message buffer, then reads an entire
  * message out of the buffer.  If the stream buffer is being used as a stream
@@ -277,12 +496,13 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
 /*
  * If the stream buffer is being used as a message buffer, then writes an entire
  * message to the buffer.  If the stream buffer is being used as a stream
- * buffer then write as many bytes as possible to the buffer.
- * prvWriteBytestoBuffer() is called to actually send the bytes to the buffer's
- * data storage area.
+ * buffer then write as many bytes as possible to the buffer.  The data is
+ * the xDataLengthBytes bytes held in the fragments pointed to by pxFragments.
+ * prvWriteFragmentsToBuffer() is called to actually send the bytes to the
+ * buffer's data storage area.
  */
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                       const void * pvTxData,
+                                       const StreamBufferFragment_t * pxFragments,
                                        size_t xDataLengthBytes,
                                        size_t xSpace,
                                        size_t xRequiredSpace ) PRIVILEGED_FUNCTION;
@@ -304,6 +524,97 @@ static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                       size_t xCount,
                                       size_t xTail ) PRIVILEGED_FUNCTION;
 
+/*
+ * The number of bytes that can be written to, or read from, the buffer in
+ * place - that is - without wrapping back to the start of the buffer's data
+ * storage area.
+ */
+static size_t prvContiguousSpaceInBuffer( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+static size_t prvContiguousBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move xHead (or xTail) forward over xCount bytes that were written (or read)
+ * in place.  Returns pdFAIL without updating the buffer if xCount is larger
+ * than the contiguous span that could have been acquired.
+ */
+static BaseType_t prvCommitBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                          size_t xCount ) PRIVILEGED_FUNCTION;
+static BaseType_t prvReleaseBytesFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                             size_t xCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Move xTail forward over up to xCount bytes without copying them out of the
+ * buffer.  Returns the number of bytes skipped, which is limited to the number
+ * of bytes in the buffer.
+ */
+static size_t prvSkipBytesInBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                    size_t xCount ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+
+/*
+ * Writes a message to a multi producer message buffer.  Space for the message
+ * and its length word is reserved by atomically moving ulReserveHead, so
+ * several writers can copy their messages into the buffer at the same time.
+ * Returns xDataLengthBytes, or 0 if there was not enough space.
+ */
+    static size_t prvWriteMultiProducerMessage( StreamBuffer_t * const pxStreamBuffer,
+                                                const StreamBufferFragment_t * pxFragments,
+                                                size_t xDataLengthBytes ) PRIVILEGED_FUNCTION;
+
+/*
+ * Writes the length word of the message reserved at xReservedHead, which makes
+ * the message committed, then moves xHead past every committed message so the
+ * reader can see them.  Writers can commit out of order, so xHead stops at the
+ * first message that has been reserved but not yet committed - the writer of
+ * that message moves xHead on when it commits.
+ */
+    static void prvCommitMultiProducerMessage( StreamBuffer_t * const pxStreamBuffer,
+                                               size_t xReservedHead,
+                                               size_t xMessageLength ) PRIVILEGED_FUNCTION;
+
+/*
+ * Zeros xCount bytes starting at xTail once they have been read from a multi
+ * producer message buffer.  Space is only ever reserved from zeroed bytes, so
+ * a length word that reads as zero belongs to a message that is not committed.
+ */
+    static void prvZeroBytesInBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xCount,
+                                      size_t xTail ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
+#if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+
+/*
+ * Discards messages that have been held for at least the message lifetime from
+ * the front of a message buffer until xSpaceWanted bytes are free, stopping at
+ * the first message that has not expired.  Returns the number of bytes free.
+ */
+    static size_t prvDiscardExpiredMessages( StreamBuffer_t * const pxStreamBuffer,
+                                             size_t xSpaceWanted ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of ticks until the message at the front of a message
+ * buffer expires, or portMAX_DELAY if messages do not expire or the message
+ * buffer is empty.  Must be called from a critical section.
+ */
+    static TickType_t prvTicksUntilExpiry( StreamBuffer_t * const pxStreamBuffer ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_MESSAGE_BUFFER_EXPIRY */
+
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+
+/*
+ * Adds xCount to the number of bytes or messages dropped by a writer.  The
+ * count is updated atomically as interrupts writing to a multi producer message
+ * buffer can drop messages at the same time.
+ */
+    static void prvRecordOverflow( StreamBuffer_t * const pxStreamBuffer,
+                                   size_t xCount ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_OVERFLOW_POLICY */
+
 /*
  * Called by both pxStreamBufferCreate() and pxStreamBufferCreateStatic() to
  * initialise the members of the newly created stream buffer structure.
@@ -320,23 +631,76 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
     StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
                                                      size_t xTriggerLevelBytes,
-                                                     BaseType_t xIsMessageBuffer,
+                                                     BaseType_t xStreamBufferType,
                                                      StreamBufferCallbackFunction_t pxSendCompletedCallback,
                                                      StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
     {
-        uint8_t * pucAllocatedMemory;
+        uint8_t * pucAllocatedMemory, * pucStorageArea;
+        size_t xStoragePadding;
         uint8_t ucFlags;
+        size_t xLengthBytes;
+        BaseType_t xIsPowerOfTwoLength, xIsCacheMaintained;
+
+        #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+            size_t xMessageSize = 0;
+        #endif
+
+        /* Separate any message length width and the power of two length and
+         * cache maintenance options from the buffer type. */
+        xLengthBytes = ( size_t ) ( ( UBaseType_t ) xStreamBufferType >> sbTYPE_LENGTH_BYTES_SHIFT );
+        xIsPowerOfTwoLength = ( ( xStreamBufferType & sbTYPE_POWER_OF_TWO_LENGTH ) != 0 ) ? pdTRUE : pdFALSE;
+        xIsCacheMaintained = ( ( xStreamBufferType & sbTYPE_CACHE_MAINTAINED ) != 0 ) ? pdTRUE : pdFALSE;
+        xStreamBufferType &= sbTYPE_MASK;
+
+        #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+        {
+            /* The length field of a fixed size message buffer's type holds the
+             * size of its messages instead, as they are stored without a
+             * length.  The storage area must be a whole number of messages,
+             * one of which is always left empty. */
+            if( xStreamBufferType == sbTYPE_FIXED_SIZE_MESSAGE_BUFFER )
+            {
+                xMessageSize = xLengthBytes;
+                xLengthBytes = 0;
+                configASSERT( xMessageSize > ( size_t ) 0 );
+                configASSERT( ( xBufferSizeBytes / xMessageSize ) >= ( size_t ) 2 );
+                configASSERT( ( xBufferSizeBytes % xMessageSize ) == ( size_t ) 0 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_FIXED_SIZE_MESSAGE_BUFFERS */
 
         /* In case the stream buffer is going to be used as a message buffer
          * (that is, it will hold discrete messages with a little meta data that
          * says how big the next message is) check the buffer will be large enough
          * to hold at least one message. */
-        if( xIsMessageBuffer == pdTRUE )
+        if( xStreamBufferType == sbTYPE_MESSAGE_BUFFER )
         {
             /* Is a message buffer but not statically allocated. */
             ucFlags = sbFLAGS_IS_MESSAGE_BUFFER;
             configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
         }
+
+        #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+            else if( xStreamBufferType == sbTYPE_MULTI_PRODUCER_MESSAGE_BUFFER )
+            {
+                /* Is a multi producer message buffer but not statically
+                 * allocated. */
+                ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_MULTI_PRODUCER;
+                configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+            }
+        #endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+        #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+            else if( xStreamBufferType == sbTYPE_FIXED_SIZE_MESSAGE_BUFFER )
+            {
+                /* Is a fixed size message buffer but not statically
+                 * allocated. */
+                ucFlags = sbFLAGS_IS_MESSAGE_BUFFER;
+            }
+        #endif /* configUSE_FIXED_SIZE_MESSAGE_BUFFERS */
         else
         {
             /* Not a message buffer and not statically allocated. */
@@ -344,6 +708,43 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             configASSERT( xBufferSizeBytes > 0 );
         }
 
+        /* Message lengths can only be held by message buffers, and their width
+         * must be 1, 2 or 4 bytes if it is chosen rather than left at the
+         * default. */
+        configASSERT( ( xLengthBytes == ( size_t ) 0 ) || ( ( ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) );
+        configASSERT( ( xLengthBytes == ( size_t ) 0 ) || ( xLengthBytes == ( size_t ) 1 ) || ( xLengthBytes == ( size_t ) 2 ) || ( xLengthBytes == ( size_t ) 4 ) );
+        configASSERT( xLengthBytes <= sizeof( size_t ) );
+        ucFlags |= ( uint8_t ) ( xLengthBytes << sbFLAGS_LENGTH_BYTES_SHIFT );
+
+        /* Indexes into a power of two length buffer are wrapped with a mask, so
+         * the length must really be a power of two. */
+        if( xIsPowerOfTwoLength != pdFALSE )
+        {
+            configASSERT( ( xBufferSizeBytes != ( size_t ) 0 ) && ( ( xBufferSizeBytes & ( xBufferSizeBytes - ( size_t ) 1 ) ) == ( size_t ) 0 ) );
+            ucFlags |= sbFLAGS_IS_POWER_OF_TWO;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_STREAM_BUFFER_CACHE_MAINTENANCE == 1 )
+        {
+            if( xIsCacheMaintained != pdFALSE )
+            {
+                ucFlags |= sbFLAGS_IS_CACHE_MAINTAINED;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else
+        {
+            configASSERT( xIsCacheMaintained == pdFALSE );
+        }
+        #endif /* configUSE_STREAM_BUFFER_CACHE_MAINTENANCE */
+
         configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
 
         /* A trigger level of 0 would cause a waiting task to unblock even when
@@ -360,11 +761,38 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
          * incremented so the free space is returned as the user would expect -
          * this is a quirk of the implementation that means otherwise the free
          * space would be reported as one byte smaller than would be logically
-         * expected. */
-        if( xBufferSizeBytes < ( xBufferSizeBytes + 1 + sizeof( StreamBuffer_t ) ) )
+         * expected.  That is not possible for a power of two length buffer, as
+         * the length would no longer be a power of two, so its storage area may
+         * instead be padded to start on a cache line.  Nor is it possible for a
+         * fixed size message buffer, the length of which must remain a whole
+         * number of messages.  The storage area of a
+         * cache maintained buffer is padded to start on a cache line, and to
+         * leave the rest of its last cache line unused. */
+        if( xIsCacheMaintained != pdFALSE )
+        {
+            xStoragePadding = ( size_t ) configSTREAM_BUFFER_CACHE_LINE_BYTES * ( size_t ) 2;
+        }
+        else if( xIsPowerOfTwoLength != pdFALSE )
+        {
+            xStoragePadding = ( size_t ) configSTREAM_BUFFER_CACHE_LINE_BYTES;
+        }
+        else
         {
-            xBufferSizeBytes++;
-            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( xBufferSizeBytes + sizeof( StreamBuffer_t ) ); /*lint !e9079 malloc() only returns void*. */
+            xStoragePadding = ( size_t ) 0;
+        }
+
+        if( xBufferSizeBytes < ( xBufferSizeBytes + 1 + xStoragePadding + sizeof( StreamBuffer_t ) ) )
+        {
+            if( ( xIsPowerOfTwoLength == pdFALSE ) && ( xStreamBufferType != sbTYPE_FIXED_SIZE_MESSAGE_BUFFER ) )
+            {
+                xBufferSizeBytes++;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pucAllocatedMemory = ( uint8_t * ) pvPortMalloc( xBufferSizeBytes + xStoragePadding + sizeof( StreamBuffer_t ) ); /*lint !e9079 malloc() only returns void*. */
         }
         else
         {
@@ -373,19 +801,44 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
         if( pucAllocatedMemory != NULL )
         {
+            /* The storage area follows the structure, moved up to the next cache
+             * line boundary if padding was allocated. */
+            pucStorageArea = pucAllocatedMemory + sizeof( StreamBuffer_t ); /*lint !e9016 Indexing past structure valid for uint8_t pointer, also storage area has no alignment requirement. */
+
+            #if ( configSTREAM_BUFFER_CACHE_LINE_BYTES > 0 )
+            {
+                if( xStoragePadding != ( size_t ) 0 )
+                {
+                    pucStorageArea += ( ( size_t ) configSTREAM_BUFFER_CACHE_LINE_BYTES - ( ( size_t ) ( portPOINTER_SIZE_TYPE ) pucStorageArea % ( size_t ) configSTREAM_BUFFER_CACHE_LINE_BYTES ) ) % ( size_t ) configSTREAM_BUFFER_CACHE_LINE_BYTES; /*lint !e923 !e9078 Avoiding casts between pointers and integers is not practical when aligning the storage area. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configSTREAM_BUFFER_CACHE_LINE_BYTES */
+
             prvInitialiseNewStreamBuffer( ( StreamBuffer_t * ) pucAllocatedMemory,       /* Structure at the start of the allocated memory. */ /*lint !e9087 Safe cast as allocated memory is aligned. */ /*lint !e826 Area is not too small and alignment is guaranteed provided malloc() behaves as expected and returns aligned buffer. */
-                                          pucAllocatedMemory + sizeof( StreamBuffer_t ), /* Storage area follows. */ /*lint !e9016 Indexing past structure valid for uint8_t pointer, also storage area has no alignment requirement. */
+                                          pucStorageArea,
                                           xBufferSizeBytes,
                                           xTriggerLevelBytes,
                                           ucFlags,
                                           pxSendCompletedCallback,
                                           pxReceiveCompletedCallback );
 
-            traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), xIsMessageBuffer );
+            #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+            {
+                ( ( StreamBuffer_t * ) pucAllocatedMemory )->xMessageSize = xMessageSize; /*lint !e9087 !e826 Safe cast as above. */
+            }
+            #endif
+
+            sbREGISTER( ( StreamBuffer_t * ) pucAllocatedMemory ); /*lint !e9087 !e826 Safe cast as above. */
+
+            traceSTREAM_BUFFER_CREATE( ( ( StreamBuffer_t * ) pucAllocatedMemory ), xStreamBufferType );
         }
         else
         {
-            traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer );
+            traceSTREAM_BUFFER_CREATE_FAILED( xStreamBufferType );
         }
 
         return ( StreamBufferHandle_t ) pucAllocatedMemory; /*lint !e9087 !e826 Safe cast as allocated memory is aligned. */
@@ -397,7 +850,7 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
 
     StreamBufferHandle_t xStreamBufferGenericCreateStatic( size_t xBufferSizeBytes,
                                                            size_t xTriggerLevelBytes,
-                                                           BaseType_t xIsMessageBuffer,
+                                                           BaseType_t xStreamBufferType,
                                                            uint8_t * const pucStreamBufferStorageArea,
                                                            StaticStreamBuffer_t * const pxStaticStreamBuffer,
                                                            StreamBufferCallbackFunction_t pxSendCompletedCallback,
@@ -406,11 +859,53 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
         StreamBuffer_t * const pxStreamBuffer = ( StreamBuffer_t * ) pxStaticStreamBuffer; /*lint !e740 !e9087 Safe cast as StaticStreamBuffer_t is opaque Streambuffer_t. */
         StreamBufferHandle_t xReturn;
         uint8_t ucFlags;
+        size_t xLengthBytes;
+        BaseType_t xIsPowerOfTwoLength, xIsCacheMaintained;
+
+        #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+            size_t xMessageSize = 0;
+        #endif
+
+        /* Separate any message length width and the power of two length and
+         * cache maintenance options from the buffer type. */
+        xLengthBytes = ( size_t ) ( ( UBaseType_t ) xStreamBufferType >> sbTYPE_LENGTH_BYTES_SHIFT );
+        xIsPowerOfTwoLength = ( ( xStreamBufferType & sbTYPE_POWER_OF_TWO_LENGTH ) != 0 ) ? pdTRUE : pdFALSE;
+        xIsCacheMaintained = ( ( xStreamBufferType & sbTYPE_CACHE_MAINTAINED ) != 0 ) ? pdTRUE : pdFALSE;
+        xStreamBufferType &= sbTYPE_MASK;
+
+        #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+        {
+            /* The length field of a fixed size message buffer's type holds the
+             * size of its messages instead, as they are stored without a
+             * length.  The storage area must be a whole number of messages,
+             * one of which is always left empty. */
+            if( xStreamBufferType == sbTYPE_FIXED_SIZE_MESSAGE_BUFFER )
+            {
+                xMessageSize = xLengthBytes;
+                xLengthBytes = 0;
+                configASSERT( xMessageSize > ( size_t ) 0 );
+                configASSERT( ( xBufferSizeBytes / xMessageSize ) >= ( size_t ) 2 );
+                configASSERT( ( xBufferSizeBytes % xMessageSize ) == ( size_t ) 0 );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_FIXED_SIZE_MESSAGE_BUFFERS */
 
         configASSERT( pucStreamBufferStorageArea );
         configASSERT( pxStaticStreamBuffer );
         configASSERT( xTriggerLevelBytes <= xBufferSizeBytes );
 
+        #if ( configSTREAM_BUFFER_CACHE_LINE_BYTES > 0 )
+        {
+            /* The storage area of a power of two length or cache maintained
+             * buffer must start on a cache line. */
+            configASSERT( ( ( xIsPowerOfTwoLength == pdFALSE ) && ( xIsCacheMaintained == pdFALSE ) ) || ( ( ( size_t ) ( portPOINTER_SIZE_TYPE ) pucStreamBufferStorageArea % ( size_t ) configSTREAM_BUFFER_CACHE_LINE_BYTES ) == ( size_t ) 0 ) );
+        }
+        #endif /* configSTREAM_BUFFER_CACHE_LINE_BYTES */
+
         /* A trigger level of 0 would cause a waiting task to unblock even when
          * the buffer was empty. */
         if( xTriggerLevelBytes == ( size_t ) 0 )
@@ -418,22 +913,76 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
             xTriggerLevelBytes = ( size_t ) 1;
         }
 
-        if( xIsMessageBuffer != pdFALSE )
+        if( xStreamBufferType == sbTYPE_MESSAGE_BUFFER )
         {
             /* Statically allocated message buffer. */
             ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
         }
+
+        #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+            else if( xStreamBufferType == sbTYPE_MULTI_PRODUCER_MESSAGE_BUFFER )
+            {
+                /* Statically allocated multi producer message buffer. */
+                ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_MULTI_PRODUCER | sbFLAGS_IS_STATICALLY_ALLOCATED;
+            }
+        #endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+        #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+            else if( xStreamBufferType == sbTYPE_FIXED_SIZE_MESSAGE_BUFFER )
+            {
+                /* Statically allocated fixed size message buffer. */
+                ucFlags = sbFLAGS_IS_MESSAGE_BUFFER | sbFLAGS_IS_STATICALLY_ALLOCATED;
+            }
+        #endif /* configUSE_FIXED_SIZE_MESSAGE_BUFFERS */
         else
         {
             /* Statically allocated stream buffer. */
             ucFlags = sbFLAGS_IS_STATICALLY_ALLOCATED;
         }
 
+        /* Message lengths can only be held by message buffers, and their width
+         * must be 1, 2 or 4 bytes if it is chosen rather than left at the
+         * default. */
+        configASSERT( ( xLengthBytes == ( size_t ) 0 ) || ( ( ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 ) );
+        configASSERT( ( xLengthBytes == ( size_t ) 0 ) || ( xLengthBytes == ( size_t ) 1 ) || ( xLengthBytes == ( size_t ) 2 ) || ( xLengthBytes == ( size_t ) 4 ) );
+        configASSERT( xLengthBytes <= sizeof( size_t ) );
+        ucFlags |= ( uint8_t ) ( xLengthBytes << sbFLAGS_LENGTH_BYTES_SHIFT );
+
+        /* Indexes into a power of two length buffer are wrapped with a mask, so
+         * the length must really be a power of two. */
+        if( xIsPowerOfTwoLength != pdFALSE )
+        {
+            configASSERT( ( xBufferSizeBytes != ( size_t ) 0 ) && ( ( xBufferSizeBytes & ( xBufferSizeBytes - ( size_t ) 1 ) ) == ( size_t ) 0 ) );
+            ucFlags |= sbFLAGS_IS_POWER_OF_TWO;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_STREAM_BUFFER_CACHE_MAINTENANCE == 1 )
+        {
+            if( xIsCacheMaintained != pdFALSE )
+            {
+                ucFlags |= sbFLAGS_IS_CACHE_MAINTAINED;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else
+        {
+            configASSERT( xIsCacheMaintained == pdFALSE );
+            ( void ) xIsCacheMaintained;
+        }
+        #endif /* configUSE_STREAM_BUFFER_CACHE_MAINTENANCE */
+
         /* In case the stream buffer is going to be used as a message buffer
          * (that is, it will hold discrete messages with a little meta data that
          * says how big the next message is) check the buffer will be large enough
-         * to hold at least one message. */
-        configASSERT( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH );
+         * to hold at least one message.  The size of a fixed size message buffer
+         * was checked above. */
+        configASSERT( ( xBufferSizeBytes > sbBYTES_TO_STORE_MESSAGE_LENGTH ) || ( xStreamBufferType == sbTYPE_FIXED_SIZE_MESSAGE_BUFFER ) );
 
         #if ( configASSERT_DEFINED == 1 )
         {
@@ -459,14 +1008,22 @@ static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
              * again. */
             pxStreamBuffer->ucFlags |= sbFLAGS_IS_STATICALLY_ALLOCATED;
 
-            traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer );
+            #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+            {
+                pxStreamBuffer->xMessageSize = xMessageSize;
+            }
+            #endif
+
+            sbREGISTER( pxStreamBuffer );
+
+            traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xStreamBufferType );
 
             xReturn = ( StreamBufferHandle_t ) pxStaticStreamBuffer; /*lint !e9087 Data hiding requires cast to opaque type. */
         }
         else
         {
             xReturn = NULL;
-            traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xIsMessageBuffer );
+            traceSTREAM_BUFFER_CREATE_STATIC_FAILED( xReturn, xStreamBufferType );
         }
 
         return xReturn;
@@ -482,6 +1039,12 @@ void vStreamBufferDelete( StreamBufferHandle_t xStreamBuffer )
 
     traceSTREAM_BUFFER_DELETE( xStreamBuffer );
 
+    #if ( configUSE_OBJECT_REGISTRY == 1 )
+    {
+        vObjectRegistryRemove( &( pxStreamBuffer->xRegistryItem ) );
+    }
+    #endif
+
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) pdFALSE )
     {
         #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
@@ -512,11 +1075,24 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     BaseType_t xReturn = pdFAIL;
     StreamBufferCallbackFunction_t pxSendCallback = NULL, pxReceiveCallback = NULL;
+    size_t xSendTriggerLevelBytes;
 
     #if ( configUSE_TRACE_FACILITY == 1 )
         UBaseType_t uxStreamBufferNumber;
     #endif
 
+    #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+        TickType_t xMessageLifetime;
+    #endif
+
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+        uint8_t ucOverflowPolicy;
+    #endif
+
+    #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+        size_t xMessageSize;
+    #endif
+
     configASSERT( pxStreamBuffer );
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -539,6 +1115,26 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
             }
             #endif
 
+            xSendTriggerLevelBytes = pxStreamBuffer->xSendTriggerLevelBytes;
+
+            #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+            {
+                xMessageLifetime = pxStreamBuffer->xMessageLifetime;
+            }
+            #endif
+
+            #if ( configUSE_OVERFLOW_POLICY == 1 )
+            {
+                ucOverflowPolicy = pxStreamBuffer->ucOverflowPolicy;
+            }
+            #endif
+
+            #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+            {
+                xMessageSize = pxStreamBuffer->xMessageSize;
+            }
+            #endif
+
             prvInitialiseNewStreamBuffer( pxStreamBuffer,
                                           pxStreamBuffer->pucBuffer,
                                           pxStreamBuffer->xLength,
@@ -547,6 +1143,26 @@ BaseType_t xStreamBufferReset( StreamBufferHandle_t xStreamBuffer )
                                           pxSendCallback,
                                           pxReceiveCallback );
 
+            pxStreamBuffer->xSendTriggerLevelBytes = xSendTriggerLevelBytes;
+
+            #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+            {
+                pxStreamBuffer->xMessageLifetime = xMessageLifetime;
+            }
+            #endif
+
+            #if ( configUSE_OVERFLOW_POLICY == 1 )
+            {
+                pxStreamBuffer->ucOverflowPolicy = ucOverflowPolicy;
+            }
+            #endif
+
+            #if ( configUSE_FIXED_SIZE_MESSAGE_BUFFERS == 1 )
+            {
+                pxStreamBuffer->xMessageSize = xMessageSize;
+            }
+            #endif
+
             #if ( configUSE_TRACE_FACILITY == 1 )
             {
                 pxStreamBuffer->uxStreamBufferNumber = uxStreamBufferNumber;
@@ -594,65 +1210,231 @@ BaseType_t xStreamBufferSetTriggerLevel( StreamBufferHandle_t xStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
-size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
+BaseType_t xStreamBufferSetSendTriggerLevel( StreamBufferHandle_t xStreamBuffer,
+                                             size_t xTriggerLevel )
 {
-    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xSpace;
-    size_t xOriginalTail;
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
 
     configASSERT( pxStreamBuffer );
 
-    /* The code below reads xTail and then xHead.  This is safe if the stream
-     * buffer is updated once between the two reads - but not if the stream buffer
-     * is updated more than once between the two reads - hence the loop. */
-    do
+    /* It is not valid for the trigger level to be 0. */
+    if( xTriggerLevel == ( size_t ) 0 )
     {
-        xOriginalTail = pxStreamBuffer->xTail;
-        xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
-        xSpace -= pxStreamBuffer->xHead;
-    } while( xOriginalTail != pxStreamBuffer->xTail );
-
-    xSpace -= ( size_t ) 1;
+        xTriggerLevel = ( size_t ) 1;
+    }
 
-    if( xSpace >= pxStreamBuffer->xLength )
+    /* The send trigger level is the number of bytes that must be free in the
+     * stream buffer before a task that is waiting for space is unblocked.  An
+     * empty stream buffer reports xLength - 1 bytes of free space, so a higher
+     * level could never be reached. */
+    if( xTriggerLevel < pxStreamBuffer->xLength )
     {
-        xSpace -= pxStreamBuffer->xLength;
+        pxStreamBuffer->xSendTriggerLevelBytes = xTriggerLevel;
+        xReturn = pdPASS;
     }
     else
     {
-        mtCOVERAGE_TEST_MARKER();
+        xReturn = pdFALSE;
     }
 
-    return xSpace;
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer )
-{
-    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn;
+#if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
 
-    configASSERT( pxStreamBuffer );
+    BaseType_t xStreamBufferSetMessageLifetime( StreamBufferHandle_t xStreamBuffer,
+                                                TickType_t xLifetime )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn = pdFAIL;
 
-    xReturn = prvBytesInBuffer( pxStreamBuffer );
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+        configASSERT( pxStreamBuffer );
 
-size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
-                          const void * pvTxData,
-                          size_t xDataLengthBytes,
-                          TickType_t xTicksToWait )
+        /* Only message buffers hold the discrete messages that expire. */
+        configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+        /* Setting a lifetime adds the time sent to the start of every message,
+         * so it can only be changed while the message buffer is empty and no
+         * tasks are blocked on it.  Writers to a multi producer message buffer
+         * find the end of each message from the length alone, so messages in
+         * a multi producer message buffer cannot expire, and nor can messages
+         * in a fixed size message buffer, which have no header to hold the
+         * time. */
+        if( ( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) == ( uint8_t ) 0 ) &&
+            ( sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) == ( size_t ) 0 ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( ( pxStreamBuffer->xHead == pxStreamBuffer->xTail ) &&
+                    ( pxStreamBuffer->xTaskWaitingToReceive == NULL ) &&
+                    ( pxStreamBuffer->xTaskWaitingToSend == NULL ) )
+                {
+                    pxStreamBuffer->xMessageLifetime = xLifetime;
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MESSAGE_BUFFER_EXPIRY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+
+    BaseType_t xStreamBufferSetOverflowPolicy( StreamBufferHandle_t xStreamBuffer,
+                                               BaseType_t xPolicy )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+        BaseType_t xReturn;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( ( xPolicy == sbOVERFLOW_PARTIAL_WRITE ) || ( xPolicy == sbOVERFLOW_DROP_NEWEST ) );
+
+        /* A message buffer never writes part of a message. */
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 )
+        {
+            pxStreamBuffer->ucOverflowPolicy = ( uint8_t ) xPolicy;
+            xReturn = pdPASS;
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxStreamBufferGetOverflowCount( StreamBufferHandle_t xStreamBuffer )
+    {
+        const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        return pxStreamBuffer->uxOverflowCount;
+    }
+
+#endif /* configUSE_OVERFLOW_POLICY */
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSpacesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xSpace;
+    size_t xOriginalTail;
+
+    configASSERT( pxStreamBuffer );
+
+    /* The code below reads xTail and then xHead.  This is safe if the stream
+     * buffer is updated once between the two reads - but not if the stream buffer
+     * is updated more than once between the two reads - hence the loop. */
+    do
+    {
+        xOriginalTail = pxStreamBuffer->xTail;
+        xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+
+        #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+        {
+            /* Space that has been reserved by a writer is not free, even if
+             * the message written to it has not been committed yet. */
+            if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+            {
+                xSpace -= ( size_t ) pxStreamBuffer->ulReserveHead;
+            }
+            else
+            {
+                xSpace -= pxStreamBuffer->xHead;
+            }
+        }
+        #else
+        {
+            xSpace -= pxStreamBuffer->xHead;
+        }
+        #endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+    } while( xOriginalTail != pxStreamBuffer->xTail );
+
+    xSpace -= ( size_t ) 1;
+
+    xSpace = sbWRAP_INDEX( pxStreamBuffer, xSpace );
+
+    return xSpace;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferBytesAvailable( StreamBufferHandle_t xStreamBuffer )
+{
+    const StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvBytesInBuffer( pxStreamBuffer );
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
+                          const void * pvTxData,
+                          size_t xDataLengthBytes,
+                          TickType_t xTicksToWait )
+{
+    StreamBufferFragment_t xFragment;
+
+    configASSERT( pvTxData );
+
+    /* The data is sent as a message, or stream, made of a single fragment. */
+    xFragment.pvData = pvTxData;
+    xFragment.xDataLengthBytes = xDataLengthBytes;
+
+    return xStreamBufferSendV( xStreamBuffer, &xFragment, ( size_t ) 1, xTicksToWait );
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSendV( StreamBufferHandle_t xStreamBuffer,
+                           const StreamBufferFragment_t * pxFragments,
+                           size_t xFragmentCount,
+                           TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReturn, xSpace = 0;
-    size_t xRequiredSpace = xDataLengthBytes;
+    size_t xDataLengthBytes = 0, xRequiredSpace, x;
     TimeOut_t xTimeOut;
+    TickType_t xTicksToBlock;
     size_t xMaxReportedSpace = 0;
 
-    configASSERT( pvTxData );
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
+    configASSERT( pxFragments );
     configASSERT( pxStreamBuffer );
 
+    /* The fragments are written one after another, so the length of the
+     * message, or of the stream data, is the total length of all of them. */
+    for( x = 0; x < xFragmentCount; x++ )
+    {
+        configASSERT( ( pxFragments[ x ].pvData != NULL ) || ( pxFragments[ x ].xDataLengthBytes == ( size_t ) 0 ) );
+
+        /* Overflow? */
+        configASSERT( ( xDataLengthBytes + pxFragments[ x ].xDataLengthBytes ) >= xDataLengthBytes );
+        xDataLengthBytes += pxFragments[ x ].xDataLengthBytes;
+    }
+
+    xRequiredSpace = xDataLengthBytes;
+
     /* The maximum amount of space a stream buffer will ever report is its length
      * minus 1. */
     xMaxReportedSpace = pxStreamBuffer->xLength - ( size_t ) 1;
@@ -663,10 +1445,11 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
      * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xRequiredSpace += sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer );
 
-        /* Overflow? */
-        configASSERT( xRequiredSpace > xDataLengthBytes );
+        /* Overflow?  Fixed size messages have no header, so need no more space
+         * than their length. */
+        configASSERT( xRequiredSpace >= xDataLengthBytes );
 
         /* If this is a message buffer then it must be possible to write the
          * whole message. */
@@ -680,6 +1463,21 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+        {
+            /* Only one task can wait for space in a message buffer, so writers
+             * to a multi producer message buffer never block. */
+            if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+            {
+                xTicksToWait = ( TickType_t ) 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
     }
     else
     {
@@ -704,9 +1502,11 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         {
             /* Wait until the required number of bytes are free in the message
              * buffer. */
+            xTicksToBlock = xTicksToWait;
+
             taskENTER_CRITICAL();
             {
-                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+                xSpace = sbSPACES_AVAILABLE_TO_SEND( pxStreamBuffer, xRequiredSpace );
 
                 if( xSpace < xRequiredSpace )
                 {
@@ -716,6 +1516,14 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
                     /* Should only be one writer. */
                     configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
                     pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+
+                    #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+                    {
+                        /* Wake when the oldest message expires, if that is
+                         * sooner, so its space can be reclaimed then. */
+                        xTicksToBlock = configMIN( xTicksToWait, prvTicksUntilExpiry( pxStreamBuffer ) );
+                    }
+                    #endif
                 }
                 else
                 {
@@ -726,7 +1534,9 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
             taskEXIT_CRITICAL();
 
             traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
-            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            sbBLOCK_START( xBlockStart );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToBlock );
+            sbBLOCK_END( pxStreamBuffer, xBlockStart, sbSTATS_SENDER );
             pxStreamBuffer->xTaskWaitingToSend = NULL;
         } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
     }
@@ -735,20 +1545,37 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
         mtCOVERAGE_TEST_MARKER();
     }
 
-    if( xSpace == ( size_t ) 0 )
+    /* Messages may also have expired while waiting for space. */
+    if( xSpace < xRequiredSpace )
     {
-        xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+        xSpace = sbSPACES_AVAILABLE_TO_SEND( pxStreamBuffer, xRequiredSpace );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+    #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+    {
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+        {
+            xReturn = prvWriteMultiProducerMessage( pxStreamBuffer, pxFragments, xDataLengthBytes );
+        }
+        else
+        {
+            xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xSpace, xRequiredSpace );
+        }
+    }
+    #else
+    {
+        xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xSpace, xRequiredSpace );
+    }
+    #endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
 
     if( xReturn > ( size_t ) 0 )
     {
         traceSTREAM_BUFFER_SEND( xStreamBuffer, xReturn );
+        sbRECORD_SEND( pxStreamBuffer, xReturn );
 
         /* Was a task waiting for the data? */
         if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
@@ -764,6 +1591,7 @@ size_t xStreamBufferSend( StreamBufferHandle_t xStreamBuffer,
     {
         mtCOVERAGE_TEST_MARKER();
         traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer );
+        sbRECORD_SEND( pxStreamBuffer, ( size_t ) 0 );
     }
 
     return xReturn;
@@ -778,25 +1606,59 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReturn, xSpace;
     size_t xRequiredSpace = xDataLengthBytes;
+    StreamBufferFragment_t xFragment;
 
     configASSERT( pvTxData );
     configASSERT( pxStreamBuffer );
 
+    xFragment.pvData = pvTxData;
+    xFragment.xDataLengthBytes = xDataLengthBytes;
+
     /* This send function is used to write to both message buffers and stream
      * buffers.  If this is a message buffer then the space needed must be
      * increased by the amount of bytes needed to store the length of the
      * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xRequiredSpace += sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xRequiredSpace += sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
-    xReturn = prvWriteMessageToBuffer( pxStreamBuffer, pvTxData, xDataLengthBytes, xSpace, xRequiredSpace );
+    xSpace = sbSPACES_AVAILABLE_TO_SEND( pxStreamBuffer, xRequiredSpace );
+
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+    {
+        /* Only stream buffers can have this policy.  With no space the write
+         * below writes nothing. */
+        if( ( xSpace < xRequiredSpace ) && ( pxStreamBuffer->ucOverflowPolicy == ( uint8_t ) sbOVERFLOW_DROP_NEWEST ) )
+        {
+            xSpace = 0;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_OVERFLOW_POLICY */
+    #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+    {
+        if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+        {
+            xReturn = prvWriteMultiProducerMessage( pxStreamBuffer, &xFragment, xDataLengthBytes );
+        }
+        else
+        {
+            xReturn = prvWriteMessageToBuffer( pxStreamBuffer, &xFragment, xDataLengthBytes, xSpace, xRequiredSpace );
+        }
+    }
+    #else
+    {
+        xReturn = prvWriteMessageToBuffer( pxStreamBuffer, &xFragment, xDataLengthBytes, xSpace, xRequiredSpace );
+    }
+    #endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
 
     if( xReturn > ( size_t ) 0 )
     {
@@ -815,37 +1677,85 @@ size_t xStreamBufferSendFromISR( StreamBufferHandle_t xStreamBuffer,
         mtCOVERAGE_TEST_MARKER();
     }
 
+    #if ( configUSE_OVERFLOW_POLICY == 1 )
+    {
+        if( xReturn < xDataLengthBytes )
+        {
+            if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+            {
+                prvRecordOverflow( pxStreamBuffer, ( size_t ) 1 );
+            }
+            else
+            {
+                prvRecordOverflow( pxStreamBuffer, xDataLengthBytes - xReturn );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_OVERFLOW_POLICY */
+
     traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xReturn );
+    sbRECORD_SEND( pxStreamBuffer, xReturn );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
 static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                       const void * pvTxData,
+                                       const StreamBufferFragment_t * pxFragments,
                                        size_t xDataLengthBytes,
                                        size_t xSpace,
                                        size_t xRequiredSpace )
 {
     size_t xNextHead = pxStreamBuffer->xHead;
-    configMESSAGE_BUFFER_LENGTH_TYPE xMessageLength;
 
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
         /* This is a message buffer, as opposed to a stream buffer. */
 
-        /* Convert xDataLengthBytes to the message length type. */
-        xMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xDataLengthBytes;
-
-        /* Ensure the data length given fits within configMESSAGE_BUFFER_LENGTH_TYPE. */
-        configASSERT( ( size_t ) xMessageLength == xDataLengthBytes );
-
-        if( xSpace >= xRequiredSpace )
+        if( sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) != ( size_t ) 0 )
+        {
+            /* Messages in a fixed size message buffer are stored without a
+             * length, so only messages of the fixed size can be written.  As
+             * the buffer is a whole number of messages long, the message is
+             * written to a single slot that does not wrap. */
+            if( ( xSpace < xRequiredSpace ) || ( xDataLengthBytes != sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) ) )
+            {
+                xDataLengthBytes = 0;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else if( xSpace >= xRequiredSpace )
         {
             /* There is enough space to write both the message length and the message
              * itself into the buffer.  Start by writing the length of the data, the data
              * itself will be written later in this function. */
-            xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextHead );
+            xNextHead = prvWriteMessageLengthToBuffer( pxStreamBuffer, xDataLengthBytes, xNextHead );
+
+            #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+            {
+                if( pxStreamBuffer->xMessageLifetime != ( TickType_t ) 0 )
+                {
+                    /* The length is followed by the time the message was sent,
+                     * from which the reader and writer tell if it has expired.
+                     * This is called from tasks and interrupts, so the interrupt
+                     * safe version of the tick count function is used. */
+                    const TickType_t xTimeSent = xTaskGetTickCountFromISR();
+
+                    xNextHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xTimeSent ), sizeof( TickType_t ), xNextHead );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_MESSAGE_BUFFER_EXPIRY */
         }
         else
         {
@@ -864,7 +1774,7 @@ static size_t prvWriteMessageToBuffer( StreamBuffer_t * const pxStreamBuffer,
     if( xDataLengthBytes != ( size_t ) 0 )
     {
         /* Write the data to the buffer. */
-        pxStreamBuffer->xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pvTxData, xDataLengthBytes, xNextHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+        pxStreamBuffer->xHead = prvWriteFragmentsToBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xNextHead );
     }
 
     return xDataLengthBytes;
@@ -879,6 +1789,10 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
     size_t xReceivedLength = 0, xBytesAvailable, xBytesToStoreMessageLength;
 
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
     configASSERT( pvRxData );
     configASSERT( pxStreamBuffer );
 
@@ -889,7 +1803,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
      * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xBytesToStoreMessageLength = sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer );
     }
     else
     {
@@ -902,6 +1816,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
          * performed atomically. */
         taskENTER_CRITICAL();
         {
+            sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer );
             xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 
             /* If this function was invoked by a message buffer read then
@@ -929,10 +1844,13 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
         {
             /* Wait for data to be available. */
             traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            sbBLOCK_START( xBlockStart );
             ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            sbBLOCK_END( pxStreamBuffer, xBlockStart, sbSTATS_RECEIVER );
             pxStreamBuffer->xTaskWaitingToReceive = NULL;
 
             /* Recheck the data available after blocking. */
+            sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer );
             xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
         }
         else
@@ -942,6 +1860,7 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     }
     else
     {
+        sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer );
         xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
     }
 
@@ -954,11 +1873,20 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
     {
         xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
 
-        /* Was a task waiting for space in the buffer? */
         if( xReceivedLength != ( size_t ) 0 )
         {
             traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength );
-            prvRECEIVE_COMPLETED( xStreamBuffer );
+            sbRECORD_RECEIVE( pxStreamBuffer, xReceivedLength );
+
+            /* Was a task waiting for space in the buffer? */
+            if( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= pxStreamBuffer->xSendTriggerLevelBytes )
+            {
+                prvRECEIVE_COMPLETED( xStreamBuffer );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
@@ -975,47 +1903,173 @@ size_t xStreamBufferReceive( StreamBufferHandle_t xStreamBuffer,
 }
 /*-----------------------------------------------------------*/
 
-size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
+size_t xStreamBufferReceiveBatch( StreamBufferHandle_t xStreamBuffer,
+                                  void * pvRxData,
+                                  size_t xBufferLengthBytes,
+                                  size_t * const pxMessageLengths,
+                                  size_t xMaxMessages,
+                                  TickType_t xTicksToWait )
 {
     StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
-    size_t xReturn, xBytesAvailable;
-    configMESSAGE_BUFFER_LENGTH_TYPE xTempReturn;
+    size_t xBytesAvailable, xMessageLength, xBytesToStoreMessageLength, xBytesUsed = 0, xMessagesReceived = 0;
+    uint8_t * const pucRxData = ( uint8_t * ) pvRxData; /*lint !e9079 Data is copied into the caller's buffer a byte at a time. */
 
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
+    configASSERT( pvRxData );
+    configASSERT( pxMessageLengths );
     configASSERT( pxStreamBuffer );
 
-    /* Ensure the stream buffer is being used as a message buffer. */
-    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    /* Only message buffers hold the discrete messages that are indexed by
+     * pxMessageLengths. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 );
+
+    xBytesToStoreMessageLength = sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer );
+
+    if( xTicksToWait != ( TickType_t ) 0 )
     {
-        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer );
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            if( xBytesAvailable <= xBytesToStoreMessageLength )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClear( NULL );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
 
-        if( xBytesAvailable > sbBYTES_TO_STORE_MESSAGE_LENGTH )
+        if( xBytesAvailable <= xBytesToStoreMessageLength )
         {
-            /* The number of bytes available is greater than the number of bytes
-             * required to hold the length of the next message, so another message
-             * is available. */
-            ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempReturn, sbBYTES_TO_STORE_MESSAGE_LENGTH, pxStreamBuffer->xTail );
-            xReturn = ( size_t ) xTempReturn;
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            sbBLOCK_START( xBlockStart );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            sbBLOCK_END( pxStreamBuffer, xBlockStart, sbSTATS_RECEIVER );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+
+            /* Recheck the data available after blocking. */
+            sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer );
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
         }
         else
         {
-            /* The minimum amount of bytes in a message buffer is
-             * ( sbBYTES_TO_STORE_MESSAGE_LENGTH + 1 ), so if xBytesAvailable is
-             * less than sbBYTES_TO_STORE_MESSAGE_LENGTH the only other valid
-             * value is 0. */
-            configASSERT( xBytesAvailable == 0 );
-            xReturn = 0;
+            mtCOVERAGE_TEST_MARKER();
         }
     }
     else
     {
-        xReturn = 0;
+        sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer );
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
     }
 
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
+    /* Copy out complete messages, packed one after the other, until either the
+     * message buffer is empty, the caller's buffer cannot hold the next message,
+     * or the length index is full.  Message buffers never hold zero length
+     * messages, so a zero return from prvReadMessageFromBuffer() means the next
+     * message did not fit and was left in the message buffer. */
+    while( ( xMessagesReceived < xMaxMessages ) && ( xBytesAvailable > xBytesToStoreMessageLength ) )
+    {
+        xMessageLength = prvReadMessageFromBuffer( pxStreamBuffer, &( pucRxData[ xBytesUsed ] ), xBufferLengthBytes - xBytesUsed, xBytesAvailable );
 
-size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
+        if( xMessageLength == ( size_t ) 0 )
+        {
+            break;
+        }
+
+        pxMessageLengths[ xMessagesReceived ] = xMessageLength;
+        xMessagesReceived++;
+        xBytesUsed += xMessageLength;
+        xBytesAvailable -= xMessageLength + xBytesToStoreMessageLength;
+    }
+
+    if( xMessagesReceived != ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesUsed );
+        sbRECORD_RECEIVE( pxStreamBuffer, xBytesUsed );
+
+        /* Was a task waiting for space in the buffer?  The whole batch frees
+         * space at once, so the writer is only notified once. */
+        if( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= pxStreamBuffer->xSendTriggerLevelBytes )
+        {
+            prvRECEIVE_COMPLETED( xStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer );
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xMessagesReceived;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferNextMessageLengthBytes( StreamBufferHandle_t xStreamBuffer )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xReturn, xBytesAvailable;
+
+    configASSERT( pxStreamBuffer );
+
+    /* Ensure the stream buffer is being used as a message buffer. */
+    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer );
+        xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+        if( xBytesAvailable > sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer ) )
+        {
+            /* The number of bytes available is greater than the number of bytes
+             * required to hold the length of the next message, so another message
+             * is available. */
+            if( sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) != ( size_t ) 0 )
+            {
+                xReturn = sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer );
+            }
+            else
+            {
+                ( void ) prvReadMessageLengthFromBuffer( pxStreamBuffer, &xReturn, pxStreamBuffer->xTail );
+            }
+        }
+        else
+        {
+            /* The minimum amount of bytes in a message buffer is
+             * ( sbGET_MESSAGE_HEADER_BYTES() + 1 ), so if xBytesAvailable is
+             * less than sbGET_MESSAGE_HEADER_BYTES() the only other valid value
+             * is 0. */
+            configASSERT( xBytesAvailable == 0 );
+            xReturn = 0;
+        }
+    }
+    else
+    {
+        xReturn = 0;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
                                     void * pvRxData,
                                     size_t xBufferLengthBytes,
                                     BaseType_t * const pxHigherPriorityTaskWoken )
@@ -1033,13 +2087,14 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
      * message. */
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        xBytesToStoreMessageLength = sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer );
     }
     else
     {
         xBytesToStoreMessageLength = 0;
     }
 
+    sbDISCARD_EXPIRED_MESSAGES( pxStreamBuffer );
     xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
 
     /* Whether receiving a discrete message (where xBytesToStoreMessageLength
@@ -1052,7 +2107,8 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
         xReceivedLength = prvReadMessageFromBuffer( pxStreamBuffer, pvRxData, xBufferLengthBytes, xBytesAvailable );
 
         /* Was a task waiting for space in the buffer? */
-        if( xReceivedLength != ( size_t ) 0 )
+        if( ( xReceivedLength != ( size_t ) 0 ) &&
+            ( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= pxStreamBuffer->xSendTriggerLevelBytes ) )
         {
             prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
         }
@@ -1067,6 +2123,7 @@ size_t xStreamBufferReceiveFromISR( StreamBufferHandle_t xStreamBuffer,
     }
 
     traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength );
+    sbRECORD_RECEIVE( pxStreamBuffer, xReceivedLength );
 
     return xReceivedLength;
 }
@@ -1078,19 +2135,43 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
                                         size_t xBytesAvailable )
 {
     size_t xCount, xNextMessageLength;
-    configMESSAGE_BUFFER_LENGTH_TYPE xTempNextMessageLength;
-    size_t xNextTail = pxStreamBuffer->xTail;
+    const size_t xTail = pxStreamBuffer->xTail;
+    size_t xNextTail = xTail;
 
     if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
     {
-        /* A discrete message is being received.  First receive the length
-         * of the message. */
-        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &xTempNextMessageLength, sbBYTES_TO_STORE_MESSAGE_LENGTH, xNextTail );
-        xNextMessageLength = ( size_t ) xTempNextMessageLength;
+        if( sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) != ( size_t ) 0 )
+        {
+            /* A message in a fixed size message buffer has no header, and is
+             * never split by the end of the buffer. */
+            xNextMessageLength = sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer );
+        }
+        else
+        {
+            /* A discrete message is being received.  First receive the length
+             * of the message. */
+            xNextTail = prvReadMessageLengthFromBuffer( pxStreamBuffer, &xNextMessageLength, xNextTail );
+
+            #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+            {
+                /* Skip the time the message was sent, which was checked when
+                 * expired messages were discarded. */
+                if( pxStreamBuffer->xMessageLifetime != ( TickType_t ) 0 )
+                {
+                    xNextTail += sizeof( TickType_t );
+                    xNextTail = sbWRAP_INDEX( pxStreamBuffer, xNextTail );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_MESSAGE_BUFFER_EXPIRY */
 
-        /* Reduce the number of bytes available by the number of bytes just
-         * read out. */
-        xBytesAvailable -= sbBYTES_TO_STORE_MESSAGE_LENGTH;
+            /* Reduce the number of bytes available by the number of bytes just
+             * read out. */
+            xBytesAvailable -= sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer );
+        }
 
         /* Check there is enough space in the buffer provided by the
          * user. */
@@ -1117,7 +2198,53 @@ static size_t prvReadMessageFromBuffer( StreamBuffer_t * pxStreamBuffer,
     if( xCount != ( size_t ) 0 )
     {
         /* Read the actual data and update the tail to mark the data as officially consumed. */
-        pxStreamBuffer->xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+        xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, xNextTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+
+        #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+        {
+            /* The space must be zeroed before it is freed for use by writers. */
+            if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+            {
+                prvZeroBytesInBuffer( pxStreamBuffer, xCount + sbGET_BYTES_TO_STORE_MESSAGE_LENGTH( pxStreamBuffer ), pxStreamBuffer->xTail );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
+        #if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+        {
+            if( pxStreamBuffer->xMessageLifetime != ( TickType_t ) 0 )
+            {
+                ATOMIC_ENTER_CRITICAL();
+                {
+                    /* A writer short of space may have discarded the message
+                     * while it was being read, having seen it expire, in which
+                     * case the bytes read may have been overwritten and the
+                     * message is not received. */
+                    if( pxStreamBuffer->xTail == xTail )
+                    {
+                        pxStreamBuffer->xTail = xNextTail;
+                    }
+                    else
+                    {
+                        xCount = 0;
+                    }
+                }
+                ATOMIC_EXIT_CRITICAL();
+            }
+            else
+            {
+                pxStreamBuffer->xTail = xNextTail;
+            }
+        }
+        #else
+        {
+            pxStreamBuffer->xTail = xNextTail;
+        }
+        #endif /* configUSE_MESSAGE_BUFFER_EXPIRY */
     }
 
     return xCount;
@@ -1160,9 +2287,15 @@ BaseType_t xStreamBufferIsFull( StreamBufferHandle_t xStreamBuffer )
      * buffers, which store discrete messages, and stream buffers, which store a
      * continuous stream of bytes.  Discrete messages include an additional
      * sbBYTES_TO_STORE_MESSAGE_LENGTH bytes that hold the length of the message. */
-    if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    if( sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) != ( size_t ) 0 )
     {
-        xBytesToStoreMessageLength = sbBYTES_TO_STORE_MESSAGE_LENGTH;
+        /* A fixed size message buffer is full when there is not enough space
+         * for another message. */
+        xBytesToStoreMessageLength = sbGET_FIXED_MESSAGE_SIZE( pxStreamBuffer ) - ( size_t ) 1;
+    }
+    else if( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) != ( uint8_t ) 0 )
+    {
+        xBytesToStoreMessageLength = sbGET_MESSAGE_HEADER_BYTES( pxStreamBuffer );
     }
     else
     {
@@ -1192,7 +2325,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxStreamBuffer )->xTaskWaitingToReceive != NULL )
         {
@@ -1208,7 +2341,7 @@ BaseType_t xStreamBufferSendCompletedFromISR( StreamBufferHandle_t xStreamBuffer
             xReturn = pdFALSE;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
@@ -1223,7 +2356,7 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
 
     configASSERT( pxStreamBuffer );
 
-    uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+    uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
     {
         if( ( pxStreamBuffer )->xTaskWaitingToSend != NULL )
         {
@@ -1239,162 +2372,1265 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
             xReturn = pdFALSE;
         }
     }
-    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
     return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                     const uint8_t * pucData,
-                                     size_t xCount,
-                                     size_t xHead )
+size_t xStreamBufferAcquireWrite( StreamBufferHandle_t xStreamBuffer,
+                                  uint8_t ** ppucData,
+                                  TickType_t xTicksToWait )
 {
-    size_t xFirstLength;
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xSpace;
+    TimeOut_t xTimeOut;
 
-    configASSERT( xCount > ( size_t ) 0 );
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
 
-    /* Calculate the number of bytes that can be added in the first write -
-     * which may be less than the total number of bytes that need to be added if
-     * the buffer will wrap back to the beginning. */
-    xFirstLength = configMIN( pxStreamBuffer->xLength - xHead, xCount );
+    configASSERT( pxStreamBuffer );
+    configASSERT( ppucData );
 
-    /* Write as many bytes as can be written in the first write. */
-    configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    /* A message buffer stores a length word ahead of each message, so only
+     * stream buffers can be written to in place. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
 
-    /* If the number of bytes written was less than the number that could be
-     * written in the first write... */
-    if( xCount > xFirstLength )
-    {
-        /* ...then write the remaining bytes to the start of the buffer. */
-        configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
-        ( void ) memcpy( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
-    }
-    else
+    if( xTicksToWait != ( TickType_t ) 0 )
     {
-        mtCOVERAGE_TEST_MARKER();
-    }
+        vTaskSetTimeOutState( &xTimeOut );
 
-    xHead += xCount;
+        do
+        {
+            /* Wait until at least one byte is free in the stream buffer. */
+            taskENTER_CRITICAL();
+            {
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
 
-    if( xHead >= pxStreamBuffer->xLength )
-    {
-        xHead -= pxStreamBuffer->xLength;
+                if( xSpace == ( size_t ) 0 )
+                {
+                    /* Clear notification state as going to wait for space. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one writer. */
+                    configASSERT( pxStreamBuffer->xTaskWaitingToSend == NULL );
+                    pxStreamBuffer->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    taskEXIT_CRITICAL();
+                    break;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer );
+            sbBLOCK_START( xBlockStart );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            sbBLOCK_END( pxStreamBuffer, xBlockStart, sbSTATS_SENDER );
+            pxStreamBuffer->xTaskWaitingToSend = NULL;
+        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    return xHead;
+    *ppucData = &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xHead ] );
+
+    return prvContiguousSpaceInBuffer( pxStreamBuffer );
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
-                                      uint8_t * pucData,
-                                      size_t xCount,
-                                      size_t xTail )
+BaseType_t xStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesWritten )
 {
-    size_t xFirstLength;
-
-    configASSERT( xCount != ( size_t ) 0 );
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
 
-    /* Calculate the number of bytes that can be read - which may be
-     * less than the number wanted if the data wraps around to the start of
-     * the buffer. */
-    xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
+    configASSERT( pxStreamBuffer );
 
-    /* Obtain the number of bytes it is possible to obtain in the first
-     * read.  Asserts check bounds of read and write. */
-    configASSERT( xFirstLength <= xCount );
-    configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
-    ( void ) memcpy( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    xReturn = prvCommitBytesToBuffer( pxStreamBuffer, xBytesWritten );
 
-    /* If the total number of wanted bytes is greater than the number
-     * that could be read in the first read... */
-    if( xCount > xFirstLength )
+    if( ( xReturn == pdPASS ) && ( xBytesWritten != ( size_t ) 0 ) )
     {
-        /* ...then read the remaining bytes from the start of the buffer. */
-        ( void ) memcpy( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesWritten );
+        sbRECORD_SEND( pxStreamBuffer, xBytesWritten );
+
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    /* Move the tail pointer to effectively remove the data read from the buffer. */
-    xTail += xCount;
-
-    if( xTail >= pxStreamBuffer->xLength )
-    {
-        xTail -= pxStreamBuffer->xLength;
-    }
-
-    return xTail;
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+BaseType_t xStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xBytesWritten,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
 {
-/* Returns the distance between xTail and xHead. */
-    size_t xCount;
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
 
-    xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
-    xCount -= pxStreamBuffer->xTail;
+    configASSERT( pxStreamBuffer );
 
-    if( xCount >= pxStreamBuffer->xLength )
+    xReturn = prvCommitBytesToBuffer( pxStreamBuffer, xBytesWritten );
+
+    if( ( xReturn == pdPASS ) && ( xBytesWritten != ( size_t ) 0 ) )
     {
-        xCount -= pxStreamBuffer->xLength;
+        /* Was a task waiting for the data? */
+        if( prvBytesInBuffer( pxStreamBuffer ) >= pxStreamBuffer->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETE_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
     else
     {
         mtCOVERAGE_TEST_MARKER();
     }
 
-    return xCount;
+    traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, ( xReturn == pdPASS ) ? xBytesWritten : ( size_t ) 0 );
+    sbRECORD_SEND( pxStreamBuffer, ( xReturn == pdPASS ) ? xBytesWritten : ( size_t ) 0 );
+
+    return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
-                                          uint8_t * const pucBuffer,
-                                          size_t xBufferSizeBytes,
-                                          size_t xTriggerLevelBytes,
-                                          uint8_t ucFlags,
-                                          StreamBufferCallbackFunction_t pxSendCompletedCallback,
-                                          StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
+size_t xStreamBufferAcquireRead( StreamBufferHandle_t xStreamBuffer,
+                                 uint8_t ** ppucData,
+                                 TickType_t xTicksToWait )
 {
-    /* Assert here is deliberately writing to the entire buffer to ensure it can
-     * be written to without generating exceptions, and is setting the buffer to a
-     * known value to assist in development/debugging. */
-    #if ( configASSERT_DEFINED == 1 )
-    {
-        /* The value written just has to be identifiable when looking at the
-         * memory.  Don't use 0xA5 as that is the stack fill value and could
-         * result in confusion as to what is actually being observed. */
-        const BaseType_t xWriteValue = 0x55;
-        configASSERT( memset( pucBuffer, ( int ) xWriteValue, xBufferSizeBytes ) == pucBuffer );
-    } /*lint !e529 !e438 xWriteValue is only used if configASSERT() is defined. */
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xBytesAvailable;
+
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        TickType_t xBlockStart;
     #endif
 
-    ( void ) memset( ( void * ) pxStreamBuffer, 0x00, sizeof( StreamBuffer_t ) ); /*lint !e9087 memset() requires void *. */
-    pxStreamBuffer->pucBuffer = pucBuffer;
-    pxStreamBuffer->xLength = xBufferSizeBytes;
-    pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
-    pxStreamBuffer->ucFlags = ucFlags;
-    #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
-    {
-        pxStreamBuffer->pxSendCompletedCallback = pxSendCompletedCallback;
-        pxStreamBuffer->pxReceiveCompletedCallback = pxReceiveCompletedCallback;
-    }
-    #else
+    configASSERT( pxStreamBuffer );
+    configASSERT( ppucData );
+
+    /* Message buffers must be read a whole message at a time. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    if( xTicksToWait != ( TickType_t ) 0 )
     {
-        ( void ) pxSendCompletedCallback;
+        /* Checking if there is data and clearing the notification state must be
+         * performed atomically. */
+        taskENTER_CRITICAL();
+        {
+            xBytesAvailable = prvBytesInBuffer( pxStreamBuffer );
+
+            if( xBytesAvailable == ( size_t ) 0 )
+            {
+                /* Clear notification state as going to wait for data. */
+                ( void ) xTaskNotifyStateClear( NULL );
+
+                /* Should only be one reader. */
+                configASSERT( pxStreamBuffer->xTaskWaitingToReceive == NULL );
+                pxStreamBuffer->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        if( xBytesAvailable == ( size_t ) 0 )
+        {
+            /* Wait for data to be available. */
+            traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer );
+            sbBLOCK_START( xBlockStart );
+            ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+            sbBLOCK_END( pxStreamBuffer, xBlockStart, sbSTATS_RECEIVER );
+            pxStreamBuffer->xTaskWaitingToReceive = NULL;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    *ppucData = &( pxStreamBuffer->pucBuffer[ pxStreamBuffer->xTail ] );
+
+    return prvContiguousBytesInBuffer( pxStreamBuffer );
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReleaseRead( StreamBufferHandle_t xStreamBuffer,
+                                     size_t xBytesRead )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvReleaseBytesFromBuffer( pxStreamBuffer, xBytesRead );
+
+    if( ( xReturn == pdPASS ) && ( xBytesRead != ( size_t ) 0 ) )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xBytesRead );
+        sbRECORD_RECEIVE( pxStreamBuffer, xBytesRead );
+
+        /* Was a task waiting for space in the buffer? */
+        if( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= pxStreamBuffer->xSendTriggerLevelBytes )
+        {
+            prvRECEIVE_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xStreamBufferReleaseReadFromISR( StreamBufferHandle_t xStreamBuffer,
+                                            size_t xBytesRead,
+                                            BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    BaseType_t xReturn;
+
+    configASSERT( pxStreamBuffer );
+
+    xReturn = prvReleaseBytesFromBuffer( pxStreamBuffer, xBytesRead );
+
+    /* Was a task waiting for space in the buffer? */
+    if( ( xReturn == pdPASS ) && ( xBytesRead != ( size_t ) 0 ) &&
+        ( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= pxStreamBuffer->xSendTriggerLevelBytes ) )
+    {
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, ( xReturn == pdPASS ) ? xBytesRead : ( size_t ) 0 );
+    sbRECORD_RECEIVE( pxStreamBuffer, ( xReturn == pdPASS ) ? xBytesRead : ( size_t ) 0 );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferPeek( StreamBufferHandle_t xStreamBuffer,
+                          void * pvRxData,
+                          size_t xBufferLengthBytes )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xCount;
+
+    configASSERT( pvRxData );
+    configASSERT( pxStreamBuffer );
+
+    /* Peeking at part of a message would leave the reader out of step with
+     * the message lengths, so only stream buffers can be peeked at. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    xCount = configMIN( prvBytesInBuffer( pxStreamBuffer ), xBufferLengthBytes );
+
+    if( xCount != ( size_t ) 0 )
+    {
+        /* Copy the bytes, but do not move xTail, so they stay in the buffer. */
+        ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) pvRxData, xCount, pxStreamBuffer->xTail ); /*lint !e9079 Data storage area is implemented as uint8_t array for ease of sizing, indexing and alignment. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSkip( StreamBufferHandle_t xStreamBuffer,
+                          size_t xBytesToSkip )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xCount;
+
+    configASSERT( pxStreamBuffer );
+
+    xCount = prvSkipBytesInBuffer( pxStreamBuffer, xBytesToSkip );
+
+    if( xCount != ( size_t ) 0 )
+    {
+        traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xCount );
+        sbRECORD_RECEIVE( pxStreamBuffer, xCount );
+
+        /* Was a task waiting for space in the buffer? */
+        if( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= pxStreamBuffer->xSendTriggerLevelBytes )
+        {
+            prvRECEIVE_COMPLETED( pxStreamBuffer );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSkipFromISR( StreamBufferHandle_t xStreamBuffer,
+                                 size_t xBytesToSkip,
+                                 BaseType_t * const pxHigherPriorityTaskWoken )
+{
+    StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+    size_t xCount;
+
+    configASSERT( pxStreamBuffer );
+
+    xCount = prvSkipBytesInBuffer( pxStreamBuffer, xBytesToSkip );
+
+    /* Was a task waiting for space in the buffer? */
+    if( ( xCount != ( size_t ) 0 ) &&
+        ( xStreamBufferSpacesAvailable( pxStreamBuffer ) >= pxStreamBuffer->xSendTriggerLevelBytes ) )
+    {
+        prvRECEIVE_COMPLETED_FROM_ISR( pxStreamBuffer, pxHigherPriorityTaskWoken );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xCount );
+    sbRECORD_RECEIVE( pxStreamBuffer, xCount );
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+size_t xStreamBufferSplice( StreamBufferHandle_t xDestination,
+                            StreamBufferHandle_t xSource,
+                            size_t xMaxBytes,
+                            TickType_t xTicksToWait )
+{
+    StreamBuffer_t * const pxDestination = xDestination;
+    StreamBuffer_t * const pxSource = xSource;
+    size_t xCount, xBytesAvailable, xSpace, xFirstLength, xNextHead, xNextTail;
+    TimeOut_t xTimeOut;
+
+    #if ( configUSE_STREAM_BUFFER_STATS == 1 )
+        TickType_t xBlockStart;
+    #endif
+
+    configASSERT( pxDestination );
+    configASSERT( pxSource );
+    configASSERT( pxDestination != pxSource );
+
+    /* Moving part of a message would leave the reader out of step with the
+     * message lengths, so only stream buffers can be spliced. */
+    configASSERT( ( pxDestination->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+    configASSERT( ( pxSource->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    if( xTicksToWait != ( TickType_t ) 0 )
+    {
+        vTaskSetTimeOutState( &xTimeOut );
+
+        do
+        {
+            /* Wait until there is data in the source and space in the
+             * destination, waiting as the reader of the source or the writer
+             * of the destination as appropriate. */
+            taskENTER_CRITICAL();
+            {
+                xBytesAvailable = prvBytesInBuffer( pxSource );
+                xSpace = xStreamBufferSpacesAvailable( pxDestination );
+
+                if( xBytesAvailable == ( size_t ) 0 )
+                {
+                    /* Clear notification state as going to wait for data. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one reader. */
+                    configASSERT( pxSource->xTaskWaitingToReceive == NULL );
+                    pxSource->xTaskWaitingToReceive = xTaskGetCurrentTaskHandle();
+                }
+                else if( xSpace == ( size_t ) 0 )
+                {
+                    /* Clear notification state as going to wait for space. */
+                    ( void ) xTaskNotifyStateClear( NULL );
+
+                    /* Should only be one writer. */
+                    configASSERT( pxDestination->xTaskWaitingToSend == NULL );
+                    pxDestination->xTaskWaitingToSend = xTaskGetCurrentTaskHandle();
+                }
+                else
+                {
+                    taskEXIT_CRITICAL();
+                    break;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xBytesAvailable == ( size_t ) 0 )
+            {
+                traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xSource );
+                sbBLOCK_START( xBlockStart );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                sbBLOCK_END( pxSource, xBlockStart, sbSTATS_RECEIVER );
+                pxSource->xTaskWaitingToReceive = NULL;
+            }
+            else
+            {
+                traceBLOCKING_ON_STREAM_BUFFER_SEND( xDestination );
+                sbBLOCK_START( xBlockStart );
+                ( void ) xTaskNotifyWait( ( uint32_t ) 0, ( uint32_t ) 0, NULL, xTicksToWait );
+                sbBLOCK_END( pxDestination, xBlockStart, sbSTATS_SENDER );
+                pxDestination->xTaskWaitingToSend = NULL;
+            }
+        } while( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xCount = configMIN( prvBytesInBuffer( pxSource ), xStreamBufferSpacesAvailable( pxDestination ) );
+    xCount = configMIN( xCount, xMaxBytes );
+
+    if( xCount != ( size_t ) 0 )
+    {
+        /* Copy straight from the source's storage area to the destination's.
+         * prvWriteBytesToBuffer() handles the destination wrapping, so only
+         * the source wrapping needs a second copy. */
+        xFirstLength = configMIN( pxSource->xLength - pxSource->xTail, xCount );
+
+        sbINVALIDATE_STORAGE( pxSource, &( pxSource->pucBuffer[ pxSource->xTail ] ), xFirstLength );
+        xNextHead = prvWriteBytesToBuffer( pxDestination, &( pxSource->pucBuffer[ pxSource->xTail ] ), xFirstLength, pxDestination->xHead );
+
+        if( xCount > xFirstLength )
+        {
+            sbINVALIDATE_STORAGE( pxSource, pxSource->pucBuffer, xCount - xFirstLength );
+            xNextHead = prvWriteBytesToBuffer( pxDestination, pxSource->pucBuffer, xCount - xFirstLength, xNextHead );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The bytes are in the destination before they leave the source. */
+        pxDestination->xHead = xNextHead;
+
+        xNextTail = pxSource->xTail + xCount;
+        xNextTail = sbWRAP_INDEX( pxSource, xNextTail );
+        pxSource->xTail = xNextTail;
+
+        traceSTREAM_BUFFER_SEND( xDestination, xCount );
+        sbRECORD_SEND( pxDestination, xCount );
+        traceSTREAM_BUFFER_RECEIVE( xSource, xCount );
+        sbRECORD_RECEIVE( pxSource, xCount );
+
+        /* Was a task waiting for data in the destination? */
+        if( prvBytesInBuffer( pxDestination ) >= pxDestination->xTriggerLevelBytes )
+        {
+            prvSEND_COMPLETED( pxDestination );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Was a task waiting for space in the source? */
+        if( xStreamBufferSpacesAvailable( pxSource ) >= pxSource->xSendTriggerLevelBytes )
+        {
+            prvRECEIVE_COMPLETED( pxSource );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                     const uint8_t * pucData,
+                                     size_t xCount,
+                                     size_t xHead )
+{
+    size_t xFirstLength;
+
+    configASSERT( xCount > ( size_t ) 0 );
+
+    /* Calculate the number of bytes that can be added in the first write -
+     * which may be less than the total number of bytes that need to be added if
+     * the buffer will wrap back to the beginning. */
+    xFirstLength = configMIN( pxStreamBuffer->xLength - xHead, xCount );
+
+    /* Write as many bytes as can be written in the first write. */
+    configASSERT( ( xHead + xFirstLength ) <= pxStreamBuffer->xLength );
+    configCOPY_BYTES( ( void * ) ( &( pxStreamBuffer->pucBuffer[ xHead ] ) ), ( const void * ) pucData, xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    sbCLEAN_STORAGE( pxStreamBuffer, &( pxStreamBuffer->pucBuffer[ xHead ] ), xFirstLength );
+
+    /* If the number of bytes written was less than the number that could be
+     * written in the first write... */
+    if( xCount > xFirstLength )
+    {
+        /* ...then write the remaining bytes to the start of the buffer. */
+        configASSERT( ( xCount - xFirstLength ) <= pxStreamBuffer->xLength );
+        configCOPY_BYTES( ( void * ) pxStreamBuffer->pucBuffer, ( const void * ) &( pucData[ xFirstLength ] ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+        sbCLEAN_STORAGE( pxStreamBuffer, pxStreamBuffer->pucBuffer, xCount - xFirstLength );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    xHead += xCount;
+
+    xHead = sbWRAP_INDEX( pxStreamBuffer, xHead );
+
+    return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteFragmentsToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                         const StreamBufferFragment_t * pxFragments,
+                                         size_t xCount,
+                                         size_t xHead )
+{
+    size_t xFragmentLength;
+
+    while( xCount != ( size_t ) 0 )
+    {
+        xFragmentLength = configMIN( pxFragments->xDataLengthBytes, xCount );
+
+        /* Empty fragments are skipped. */
+        if( xFragmentLength != ( size_t ) 0 )
+        {
+            xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) pxFragments->pvData, xFragmentLength, xHead ); /*lint !e9079 Storage buffer is implemented as uint8_t for ease of sizing, alignment and access. */
+            xCount -= xFragmentLength;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxFragments++;
+    }
+
+    return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadBytesFromBuffer( StreamBuffer_t * pxStreamBuffer,
+                                      uint8_t * pucData,
+                                      size_t xCount,
+                                      size_t xTail )
+{
+    size_t xFirstLength;
+
+    configASSERT( xCount != ( size_t ) 0 );
+
+    /* Calculate the number of bytes that can be read - which may be
+     * less than the number wanted if the data wraps around to the start of
+     * the buffer. */
+    xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
+
+    /* Obtain the number of bytes it is possible to obtain in the first
+     * read.  Asserts check bounds of read and write. */
+    configASSERT( xFirstLength <= xCount );
+    configASSERT( ( xTail + xFirstLength ) <= pxStreamBuffer->xLength );
+    sbINVALIDATE_STORAGE( pxStreamBuffer, &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength );
+    configCOPY_BYTES( ( void * ) pucData, ( const void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+
+    /* If the total number of wanted bytes is greater than the number
+     * that could be read in the first read... */
+    if( xCount > xFirstLength )
+    {
+        /* ...then read the remaining bytes from the start of the buffer. */
+        sbINVALIDATE_STORAGE( pxStreamBuffer, pxStreamBuffer->pucBuffer, xCount - xFirstLength );
+        configCOPY_BYTES( ( void * ) &( pucData[ xFirstLength ] ), ( void * ) ( pxStreamBuffer->pucBuffer ), xCount - xFirstLength ); /*lint !e9087 memcpy() requires void *. */
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    /* Move the tail pointer to effectively remove the data read from the buffer. */
+    xTail += xCount;
+
+    xTail = sbWRAP_INDEX( pxStreamBuffer, xTail );
+
+    return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvWriteMessageLengthToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                             size_t xMessageLength,
+                                             size_t xHead )
+{
+    const size_t xLengthBytes = ( size_t ) ( pxStreamBuffer->ucFlags & sbFLAGS_LENGTH_BYTES_MASK ) >> sbFLAGS_LENGTH_BYTES_SHIFT;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+    uint8_t ucMessageLength[ 4 ];
+    size_t x;
+
+    if( xLengthBytes == ( size_t ) 0 )
+    {
+        /* Convert xMessageLength to the message length type. */
+        xTempMessageLength = ( configMESSAGE_BUFFER_LENGTH_TYPE ) xMessageLength;
+
+        /* Ensure the data length given fits within configMESSAGE_BUFFER_LENGTH_TYPE. */
+        configASSERT( ( size_t ) xTempMessageLength == xMessageLength );
+
+        xHead = prvWriteBytesToBuffer( pxStreamBuffer, ( const uint8_t * ) &( xTempMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xHead );
+    }
+    else
+    {
+        /* Ensure the data length given fits within the number of bytes chosen
+         * for message lengths. */
+        configASSERT( ( xLengthBytes >= sizeof( size_t ) ) || ( ( xMessageLength >> ( xLengthBytes * ( size_t ) 8 ) ) == ( size_t ) 0 ) );
+
+        /* Store the least significant byte first. */
+        for( x = 0; x < xLengthBytes; x++ )
+        {
+            ucMessageLength[ x ] = ( uint8_t ) ( xMessageLength >> ( x * ( size_t ) 8 ) );
+        }
+
+        xHead = prvWriteBytesToBuffer( pxStreamBuffer, ucMessageLength, xLengthBytes, xHead );
+    }
+
+    return xHead;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvReadMessageLengthFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                              size_t * const pxMessageLength,
+                                              size_t xTail )
+{
+    const size_t xLengthBytes = ( size_t ) ( pxStreamBuffer->ucFlags & sbFLAGS_LENGTH_BYTES_MASK ) >> sbFLAGS_LENGTH_BYTES_SHIFT;
+    configMESSAGE_BUFFER_LENGTH_TYPE xTempMessageLength;
+    uint8_t ucMessageLength[ 4 ];
+    size_t x;
+
+    if( xLengthBytes == ( size_t ) 0 )
+    {
+        xTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &( xTempMessageLength ), sbBYTES_TO_STORE_MESSAGE_LENGTH, xTail );
+        *pxMessageLength = ( size_t ) xTempMessageLength;
+    }
+    else
+    {
+        xTail = prvReadBytesFromBuffer( pxStreamBuffer, ucMessageLength, xLengthBytes, xTail );
+
+        /* The least significant byte is stored first. */
+        *pxMessageLength = 0;
+
+        for( x = 0; x < xLengthBytes; x++ )
+        {
+            *pxMessageLength |= ( size_t ) ucMessageLength[ x ] << ( x * ( size_t ) 8 );
+        }
+    }
+
+    return xTail;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+{
+/* Returns the distance between xTail and xHead. */
+    size_t xCount;
+
+    xCount = pxStreamBuffer->xLength + pxStreamBuffer->xHead;
+    xCount -= pxStreamBuffer->xTail;
+
+    xCount = sbWRAP_INDEX( pxStreamBuffer, xCount );
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvContiguousSpaceInBuffer( StreamBuffer_t * const pxStreamBuffer )
+{
+    /* The free space starts at xHead and can only be used up to the end of the
+     * buffer without wrapping. */
+    return configMIN( xStreamBufferSpacesAvailable( pxStreamBuffer ), pxStreamBuffer->xLength - pxStreamBuffer->xHead );
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvContiguousBytesInBuffer( const StreamBuffer_t * const pxStreamBuffer )
+{
+    /* The data starts at xTail and can only be used up to the end of the
+     * buffer without wrapping. */
+    return configMIN( prvBytesInBuffer( pxStreamBuffer ), pxStreamBuffer->xLength - pxStreamBuffer->xTail );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCommitBytesToBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                          size_t xCount )
+{
+    size_t xNextHead;
+    BaseType_t xReturn;
+
+    /* Bytes can only be committed from the span returned by
+     * xStreamBufferAcquireWrite(), which never wraps. */
+    if( xCount <= prvContiguousSpaceInBuffer( pxStreamBuffer ) )
+    {
+        xNextHead = pxStreamBuffer->xHead + xCount;
+
+        xNextHead = sbWRAP_INDEX( pxStreamBuffer, xNextHead );
+
+        pxStreamBuffer->xHead = xNextHead;
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = pdFAIL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvReleaseBytesFromBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                             size_t xCount )
+{
+    size_t xNextTail;
+    BaseType_t xReturn;
+
+    /* Bytes can only be released from the span returned by
+     * xStreamBufferAcquireRead(), which never wraps. */
+    if( xCount <= prvContiguousBytesInBuffer( pxStreamBuffer ) )
+    {
+        xNextTail = pxStreamBuffer->xTail + xCount;
+
+        xNextTail = sbWRAP_INDEX( pxStreamBuffer, xNextTail );
+
+        pxStreamBuffer->xTail = xNextTail;
+        xReturn = pdPASS;
+    }
+    else
+    {
+        xReturn = pdFAIL;
+    }
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvSkipBytesInBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                    size_t xCount )
+{
+    size_t xNextTail;
+
+    /* Skipping part of a message would leave the reader out of step with the
+     * message lengths, so only stream buffers can be skipped through. */
+    configASSERT( ( pxStreamBuffer->ucFlags & sbFLAGS_IS_MESSAGE_BUFFER ) == ( uint8_t ) 0 );
+
+    xCount = configMIN( prvBytesInBuffer( pxStreamBuffer ), xCount );
+
+    if( xCount != ( size_t ) 0 )
+    {
+        xNextTail = pxStreamBuffer->xTail + xCount;
+        xNextTail = sbWRAP_INDEX( pxStreamBuffer, xNextTail );
+        pxStreamBuffer->xTail = xNextTail;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    return xCount;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+
+    static size_t prvWriteMultiProducerMessage( StreamBuffer_t * const pxStreamBuffer,
+                                                const StreamBufferFragment_t * pxFragments,
+                                                size_t xDataLengthBytes )
+    {
+        const size_t xBytesToStoreMessageLength = sbGET_BYTES_TO_STORE_MESSAGE_LENGTH( pxStreamBuffer );
+        const size_t xRequiredSpace = xDataLengthBytes + xBytesToStoreMessageLength;
+        uint32_t ulReservedHead;
+        size_t xSpace, xNextHead;
+
+        /* A zero length word marks a message that is not committed, so zero
+         * length messages cannot be written. */
+        if( xDataLengthBytes != ( size_t ) 0 )
+        {
+            /* Reserve the space by moving ulReserveHead, retrying if another
+             * writer reserved space between reading and updating it. */
+            do
+            {
+                ulReservedHead = pxStreamBuffer->ulReserveHead;
+
+                xSpace = pxStreamBuffer->xLength + pxStreamBuffer->xTail;
+                xSpace -= ( size_t ) ulReservedHead + ( size_t ) 1;
+
+                xSpace = sbWRAP_INDEX( pxStreamBuffer, xSpace );
+
+                if( xSpace < xRequiredSpace )
+                {
+                    /* Not enough space, so do not write data to the buffer. */
+                    xDataLengthBytes = 0;
+                    break;
+                }
+
+                xNextHead = ( size_t ) ulReservedHead + xRequiredSpace;
+
+                xNextHead = sbWRAP_INDEX( pxStreamBuffer, xNextHead );
+            } while( Atomic_CompareAndSwap_u32( &( pxStreamBuffer->ulReserveHead ), ( uint32_t ) xNextHead, ulReservedHead ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xDataLengthBytes != ( size_t ) 0 )
+        {
+            /* The reserved space belongs to this writer alone, so the data can
+             * be copied in without holding any lock.  It follows the length
+             * word, which is written when the message is committed. */
+            xNextHead = ( size_t ) ulReservedHead + xBytesToStoreMessageLength;
+
+            xNextHead = sbWRAP_INDEX( pxStreamBuffer, xNextHead );
+
+            ( void ) prvWriteFragmentsToBuffer( pxStreamBuffer, pxFragments, xDataLengthBytes, xNextHead );
+
+            prvCommitMultiProducerMessage( pxStreamBuffer, ( size_t ) ulReservedHead, xDataLengthBytes );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xDataLengthBytes;
+    }
+
+#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+
+    static void prvCommitMultiProducerMessage( StreamBuffer_t * const pxStreamBuffer,
+                                               size_t xReservedHead,
+                                               size_t xMessageLength )
+    {
+        size_t xNextHead, xReserveHead;
+
+        ATOMIC_ENTER_CRITICAL();
+
+        /* Writing the length word commits the message.  It is written inside the
+         * critical section so a partly written length word is never read
+         * below. */
+        ( void ) prvWriteMessageLengthToBuffer( pxStreamBuffer, xMessageLength, xReservedHead );
+
+        /* Move xHead past the committed messages that follow it.  Space that
+         * has been reserved but not committed still holds the zeros written
+         * when it was last freed, so its length word reads as zero. */
+        xNextHead = pxStreamBuffer->xHead;
+        xReserveHead = ( size_t ) pxStreamBuffer->ulReserveHead;
+
+        while( xNextHead != xReserveHead )
+        {
+            xNextHead = prvReadMessageLengthFromBuffer( pxStreamBuffer, &xMessageLength, xNextHead );
+
+            if( xMessageLength == ( size_t ) 0 )
+            {
+                break;
+            }
+
+            xNextHead += xMessageLength;
+
+            xNextHead = sbWRAP_INDEX( pxStreamBuffer, xNextHead );
+
+            pxStreamBuffer->xHead = xNextHead;
+        }
+
+        ATOMIC_EXIT_CRITICAL();
+    }
+
+#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+
+    static void prvZeroBytesInBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                      size_t xCount,
+                                      size_t xTail )
+    {
+        size_t xFirstLength;
+
+        /* Zero up to the end of the buffer, then any bytes that wrapped back to
+         * the start of the buffer. */
+        xFirstLength = configMIN( pxStreamBuffer->xLength - xTail, xCount );
+        ( void ) memset( ( void * ) &( pxStreamBuffer->pucBuffer[ xTail ] ), 0x00, xFirstLength ); /*lint !e9087 memset() requires void *. */
+
+        if( xCount > xFirstLength )
+        {
+            ( void ) memset( ( void * ) pxStreamBuffer->pucBuffer, 0x00, xCount - xFirstLength ); /*lint !e9087 memset() requires void *. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MESSAGE_BUFFER_EXPIRY == 1 )
+
+    static size_t prvDiscardExpiredMessages( StreamBuffer_t * const pxStreamBuffer,
+                                             size_t xSpaceWanted )
+    {
+        /* Called from tasks and interrupts, so the interrupt safe version of
+         * the tick count function is used. */
+        const TickType_t xNow = xTaskGetTickCountFromISR();
+        size_t xSpace, xNextTail, xMessageLength;
+        TickType_t xTimeSent;
+
+        /* Both the reader and a writer that is short of space discard messages,
+         * so xTail is only moved here inside a critical section, and the reader
+         * only moves xTail past a message it has read if xTail did not move
+         * while the message was being read. */
+        ATOMIC_ENTER_CRITICAL();
+        {
+            xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+
+            while( ( xSpace < xSpaceWanted ) && ( pxStreamBuffer->xHead != pxStreamBuffer->xTail ) )
+            {
+                xNextTail = prvReadMessageLengthFromBuffer( pxStreamBuffer, &xMessageLength, pxStreamBuffer->xTail );
+                xNextTail = prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &( xTimeSent ), sizeof( TickType_t ), xNextTail );
+
+                /* Messages are held in the order they were sent, so none after
+                 * the first message that has not expired have expired either. */
+                if( ( TickType_t ) ( xNow - xTimeSent ) < pxStreamBuffer->xMessageLifetime )
+                {
+                    break;
+                }
+
+                xNextTail += xMessageLength;
+                pxStreamBuffer->xTail = sbWRAP_INDEX( pxStreamBuffer, xNextTail );
+                traceSTREAM_BUFFER_MESSAGE_EXPIRED( pxStreamBuffer, xMessageLength );
+
+                xSpace = xStreamBufferSpacesAvailable( pxStreamBuffer );
+            }
+        }
+        ATOMIC_EXIT_CRITICAL();
+
+        return xSpace;
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvTicksUntilExpiry( StreamBuffer_t * const pxStreamBuffer )
+    {
+        TickType_t xReturn = portMAX_DELAY, xTimeSent, xAge;
+        size_t xNextTail, xMessageLength;
+
+        if( ( pxStreamBuffer->xMessageLifetime != ( TickType_t ) 0 ) && ( pxStreamBuffer->xHead != pxStreamBuffer->xTail ) )
+        {
+            xNextTail = prvReadMessageLengthFromBuffer( pxStreamBuffer, &xMessageLength, pxStreamBuffer->xTail );
+            ( void ) prvReadBytesFromBuffer( pxStreamBuffer, ( uint8_t * ) &( xTimeSent ), sizeof( TickType_t ), xNextTail );
+
+            xAge = xTaskGetTickCount() - xTimeSent;
+
+            /* An expired message would already have been discarded, but wait
+             * for at least one tick whatever the time stamp says. */
+            if( xAge < pxStreamBuffer->xMessageLifetime )
+            {
+                xReturn = pxStreamBuffer->xMessageLifetime - xAge;
+            }
+            else
+            {
+                xReturn = ( TickType_t ) 1;
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_MESSAGE_BUFFER_EXPIRY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_OVERFLOW_POLICY == 1 )
+
+    static void prvRecordOverflow( StreamBuffer_t * const pxStreamBuffer,
+                                   size_t xCount )
+    {
+        UBaseType_t uxCount;
+
+        do
+        {
+            uxCount = pxStreamBuffer->uxOverflowCount;
+        } while( Atomic_CompareAndSwap_ux( &( pxStreamBuffer->uxOverflowCount ), uxCount + ( UBaseType_t ) xCount, uxCount ) != ATOMIC_COMPARE_AND_SWAP_SUCCESS );
+    }
+
+#endif /* configUSE_OVERFLOW_POLICY */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewStreamBuffer( StreamBuffer_t * const pxStreamBuffer,
+                                          uint8_t * const pucBuffer,
+                                          size_t xBufferSizeBytes,
+                                          size_t xTriggerLevelBytes,
+                                          uint8_t ucFlags,
+                                          StreamBufferCallbackFunction_t pxSendCompletedCallback,
+                                          StreamBufferCallbackFunction_t pxReceiveCompletedCallback )
+{
+    /* Assert here is deliberately writing to the entire buffer to ensure it can
+     * be written to without generating exceptions, and is setting the buffer to a
+     * known value to assist in development/debugging. */
+    #if ( configASSERT_DEFINED == 1 )
+    {
+        /* The value written just has to be identifiable when looking at the
+         * memory.  Don't use 0xA5 as that is the stack fill value and could
+         * result in confusion as to what is actually being observed. */
+        const BaseType_t xWriteValue = 0x55;
+        configASSERT( memset( pucBuffer, ( int ) xWriteValue, xBufferSizeBytes ) == pucBuffer );
+    } /*lint !e529 !e438 xWriteValue is only used if configASSERT() is defined. */
+    #endif
+
+    ( void ) memset( ( void * ) pxStreamBuffer, 0x00, sbINITIALISED_BYTES ); /*lint !e9087 memset() requires void *. */
+    pxStreamBuffer->pucBuffer = pucBuffer;
+    pxStreamBuffer->xLength = xBufferSizeBytes;
+    pxStreamBuffer->xTriggerLevelBytes = xTriggerLevelBytes;
+    pxStreamBuffer->xSendTriggerLevelBytes = ( size_t ) 1;
+    pxStreamBuffer->ucFlags = ucFlags;
+
+    #if ( configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS == 1 )
+    {
+        if( ( ucFlags & sbFLAGS_IS_MULTI_PRODUCER ) != ( uint8_t ) 0 )
+        {
+            /* ulReserveHead is updated with 32-bit atomic operations. */
+            configASSERT( ( size_t ) ( ( uint32_t ) xBufferSizeBytes ) == xBufferSizeBytes );
+
+            /* A zero length word marks a message that is not committed, so the
+             * storage area must start zeroed. */
+            ( void ) memset( ( void * ) pucBuffer, 0x00, xBufferSizeBytes ); /*lint !e9087 memset() requires void *. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_MULTI_PRODUCER_MESSAGE_BUFFERS */
+
+    /* The storage area of a cache maintained buffer may have been filled above,
+     * and dirty cache lines left by the fill could later be written back over
+     * data written to the storage area by a DMA controller. */
+    sbCLEAN_STORAGE( pxStreamBuffer, pucBuffer, xBufferSizeBytes );
+
+    #if ( configUSE_SB_COMPLETED_CALLBACK == 1 )
+    {
+        pxStreamBuffer->pxSendCompletedCallback = pxSendCompletedCallback;
+        pxStreamBuffer->pxReceiveCompletedCallback = pxReceiveCompletedCallback;
+    }
+    #else
+    {
+        ( void ) pxSendCompletedCallback;
         ( void ) pxReceiveCompletedCallback;
     }
     #endif
 }
 
+#if ( configUSE_STREAM_BUFFER_STATS == 1 )
+
+    static void prvUpdateStreamBufferOccupancy( StreamBuffer_t * const pxStreamBuffer )
+    {
+        /* Called from a critical section in either a task or an interrupt, so
+         * the interrupt safe version of the tick count function is used. */
+        const TickType_t xNow = xTaskGetTickCountFromISR();
+        const size_t xBytesInBuffer = prvBytesInBuffer( pxStreamBuffer );
+
+        /* Add the number of bytes that were in the buffer for each tick since
+         * the last update.  Dividing the sum by the number of bytes received
+         * gives the average number of ticks a byte spent in the buffer. */
+        pxStreamBuffer->ulOccupancyTicks += ( uint32_t ) pxStreamBuffer->xLastLevel * ( uint32_t ) ( xNow - pxStreamBuffer->xLastLevelChange );
+        pxStreamBuffer->xLastLevelChange = xNow;
+        pxStreamBuffer->xLastLevel = xBytesInBuffer;
+
+        if( xBytesInBuffer > pxStreamBuffer->xBytesHighWater )
+        {
+            pxStreamBuffer->xBytesHighWater = xBytesInBuffer;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRecordStreamBufferSend( StreamBuffer_t * const pxStreamBuffer,
+                                           size_t xBytesSent )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( xBytesSent > ( size_t ) 0 )
+            {
+                prvUpdateStreamBufferOccupancy( pxStreamBuffer );
+                pxStreamBuffer->ulSends++;
+                pxStreamBuffer->ulBytesSent += ( uint32_t ) xBytesSent;
+            }
+            else
+            {
+                pxStreamBuffer->ulSendsFailed++;
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRecordStreamBufferReceive( StreamBuffer_t * const pxStreamBuffer,
+                                              size_t xBytesReceived )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        if( xBytesReceived > ( size_t ) 0 )
+        {
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                prvUpdateStreamBufferOccupancy( pxStreamBuffer );
+                pxStreamBuffer->ulReceives++;
+                pxStreamBuffer->ulBytesReceived += ( uint32_t ) xBytesReceived;
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddStreamBufferBlockedTime( StreamBuffer_t * const pxStreamBuffer,
+                                               TickType_t xBlockStart,
+                                               BaseType_t xSender )
+    {
+        const TickType_t xBlockedTicks = xTaskGetTickCount() - xBlockStart;
+
+        /* Only the writer updates the send time and only the reader updates
+         * the receive time, so no critical section is needed. */
+        if( xSender != pdFALSE )
+        {
+            pxStreamBuffer->xSendBlockedTicks += xBlockedTicks;
+        }
+        else
+        {
+            pxStreamBuffer->xReceiveBlockedTicks += xBlockedTicks;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vStreamBufferGetStats( StreamBufferHandle_t xStreamBuffer,
+                                StreamBufferStats_t * pxStreamBufferStats )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+        configASSERT( pxStreamBufferStats );
+
+        taskENTER_CRITICAL();
+        {
+            prvUpdateStreamBufferOccupancy( pxStreamBuffer );
+
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                pxStreamBufferStats->uxStreamBufferNumber = pxStreamBuffer->uxStreamBufferNumber;
+            }
+            #else
+            {
+                pxStreamBufferStats->uxStreamBufferNumber = ( UBaseType_t ) 0;
+            }
+            #endif
+
+            pxStreamBufferStats->xLength = pxStreamBuffer->xLength;
+            pxStreamBufferStats->xBytesAvailable = pxStreamBuffer->xLastLevel;
+            pxStreamBufferStats->xBytesHighWater = pxStreamBuffer->xBytesHighWater;
+            pxStreamBufferStats->ulSends = pxStreamBuffer->ulSends;
+            pxStreamBufferStats->ulSendsFailed = pxStreamBuffer->ulSendsFailed;
+            pxStreamBufferStats->ulBytesSent = pxStreamBuffer->ulBytesSent;
+            pxStreamBufferStats->ulReceives = pxStreamBuffer->ulReceives;
+            pxStreamBufferStats->ulBytesReceived = pxStreamBuffer->ulBytesReceived;
+            pxStreamBufferStats->xSendBlockedTicks = pxStreamBuffer->xSendBlockedTicks;
+            pxStreamBufferStats->xReceiveBlockedTicks = pxStreamBuffer->xReceiveBlockedTicks;
+            pxStreamBufferStats->ulOccupancyTicks = pxStreamBuffer->ulOccupancyTicks;
+        }
+        taskEXIT_CRITICAL();
+
+        if( pxStreamBufferStats->ulBytesReceived > 0U )
+        {
+            pxStreamBufferStats->xAverageResidencyTicks = ( TickType_t ) ( pxStreamBufferStats->ulOccupancyTicks / pxStreamBufferStats->ulBytesReceived );
+        }
+        else
+        {
+            pxStreamBufferStats->xAverageResidencyTicks = ( TickType_t ) 0;
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vStreamBufferResetStats( StreamBufferHandle_t xStreamBuffer )
+    {
+        StreamBuffer_t * const pxStreamBuffer = xStreamBuffer;
+
+        configASSERT( pxStreamBuffer );
+
+        taskENTER_CRITICAL();
+        {
+            pxStreamBuffer->xLastLevel = prvBytesInBuffer( pxStreamBuffer );
+            pxStreamBuffer->xLastLevelChange = xTaskGetTickCount();
+            pxStreamBuffer->xBytesHighWater = pxStreamBuffer->xLastLevel;
+            pxStreamBuffer->ulSends = 0U;
+            pxStreamBuffer->ulSendsFailed = 0U;
+            pxStreamBuffer->ulBytesSent = 0U;
+            pxStreamBuffer->ulReceives = 0U;
+            pxStreamBuffer->ulBytesReceived = 0U;
+            pxStreamBuffer->ulOccupancyTicks = 0U;
+            pxStreamBuffer->xSendBlockedTicks = ( TickType_t ) 0;
+            pxStreamBuffer->xReceiveBlockedTicks = ( TickType_t ) 0;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_STREAM_BUFFER_STATS */
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
     UBaseType_t uxStreamBufferGetStreamBufferNumber( StreamBufferHandle_t xStreamBuffer )
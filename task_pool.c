@@ -0,0 +1,257 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "task_pool.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include task pools.  This #if is closed at the very bottom of this file. */
+#if ( configUSE_TASK_POOLS == 1 )
+
+    #if ( configSUPPORT_DYNAMIC_ALLOCATION != 1 )
+        #error configSUPPORT_DYNAMIC_ALLOCATION must be set to 1 to use task pools.
+    #endif
+
+    #if ( INCLUDE_vTaskDelete != 1 )
+        #error INCLUDE_vTaskDelete must be set to 1 to use task pools.
+    #endif
+
+    #if ( configUSE_TASK_NOTIFICATIONS != 1 )
+        #error configUSE_TASK_NOTIFICATIONS must be set to 1 to use task pools.
+    #endif
+
+/* A job as held in the job queue of a pool. */
+    typedef struct TaskPoolJob
+    {
+        TaskPoolJobFunction_t pxJobFunction; /*< The function the worker calls. */
+        void * pvParameter;                  /*< The value passed to pxJobFunction. */
+        TaskHandle_t xTaskToNotify;          /*< The task notified when the job completes, or NULL. */
+        UBaseType_t uxIndexToNotify;         /*< The notification index of xTaskToNotify that is incremented. */
+    } TaskPoolJob_t;
+
+/* The worker task handles are allocated in the same block as the pool, so the
+ * workers that were created can be deleted again if creating the pool fails. */
+    typedef struct TaskPoolDefinition
+    {
+        QueueHandle_t xJobQueue;       /*< Holds the jobs that are waiting for a free worker. */
+        UBaseType_t uxNumberOfWorkers; /*< The number of entries in pxWorkers. */
+        TaskHandle_t * pxWorkers;      /*< The handles of the worker tasks. */
+    } TaskPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The function run by every worker task.  Waits for a job on the pool's job
+ * queue, runs it, then signals its completion if requested.
+ */
+    static portTASK_FUNCTION_PROTO( prvTaskPoolWorker, pvParameters ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvTaskPoolWorker, pvParameters )
+    {
+        TaskPool_t * const pxPool = ( TaskPool_t * ) pvParameters; /*lint !e9087 The parameter is always the pool the worker belongs to. */
+        TaskPoolJob_t xJob;
+
+        for( ; ; )
+        {
+            if( xQueueReceive( pxPool->xJobQueue, &xJob, portMAX_DELAY ) == pdPASS )
+            {
+                traceTASK_POOL_JOB_START( pxPool, xJob.pxJobFunction );
+
+                xJob.pxJobFunction( xJob.pvParameter );
+
+                traceTASK_POOL_JOB_END( pxPool, xJob.pxJobFunction );
+
+                if( xJob.xTaskToNotify != NULL )
+                {
+                    ( void ) xTaskNotifyGiveIndexed( xJob.xTaskToNotify, xJob.uxIndexToNotify );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    TaskPoolHandle_t xTaskPoolCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                      UBaseType_t uxNumberOfWorkers,
+                                      configSTACK_DEPTH_TYPE uxStackDepth,
+                                      UBaseType_t uxPriority,
+                                      UBaseType_t uxMaxPendingJobs )
+    {
+        TaskPool_t * pxPool;
+        UBaseType_t uxCreated = 0;
+        BaseType_t xResult = pdPASS;
+
+        configASSERT( uxNumberOfWorkers > ( UBaseType_t ) 0 );
+        configASSERT( uxMaxPendingJobs > ( UBaseType_t ) 0 );
+
+        pxPool = ( TaskPool_t * ) pvPortMalloc( sizeof( TaskPool_t ) + ( uxNumberOfWorkers * sizeof( TaskHandle_t ) ) ); /*lint !e9079 malloc() only returns void*. */
+
+        if( pxPool != NULL )
+        {
+            pxPool->uxNumberOfWorkers = uxNumberOfWorkers;
+            pxPool->pxWorkers = ( TaskHandle_t * ) &( pxPool[ 1 ] ); /*lint !e9087 The handles follow the pool structure in the same allocation. */
+            pxPool->xJobQueue = xQueueCreate( uxMaxPendingJobs, sizeof( TaskPoolJob_t ) );
+
+            if( pxPool->xJobQueue == NULL )
+            {
+                xResult = pdFAIL;
+            }
+
+            while( ( uxCreated < uxNumberOfWorkers ) && ( xResult == pdPASS ) )
+            {
+                xResult = xTaskCreate( prvTaskPoolWorker,
+                                       pcName,
+                                       uxStackDepth,
+                                       ( void * ) pxPool,
+                                       uxPriority,
+                                       &( pxPool->pxWorkers[ uxCreated ] ) );
+
+                if( xResult == pdPASS )
+                {
+                    uxCreated++;
+                }
+            }
+
+            if( xResult != pdPASS )
+            {
+                /* The workers that were created are blocked on the job queue,
+                 * which is still empty, so they can be deleted. */
+                while( uxCreated > ( UBaseType_t ) 0 )
+                {
+                    uxCreated--;
+                    vTaskDelete( pxPool->pxWorkers[ uxCreated ] );
+                }
+
+                if( pxPool->xJobQueue != NULL )
+                {
+                    vQueueDelete( pxPool->xJobQueue );
+                }
+
+                vPortFree( pxPool );
+                pxPool = NULL;
+            }
+            else
+            {
+                traceTASK_POOL_CREATE( pxPool );
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxPool;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPoolSubmit( TaskPoolHandle_t xPool,
+                                TaskPoolJobFunction_t pxJobFunction,
+                                void * pvParameter,
+                                TaskHandle_t xTaskToNotify,
+                                UBaseType_t uxIndexToNotify,
+                                TickType_t xTicksToWait )
+    {
+        TaskPool_t * const pxPool = xPool;
+        TaskPoolJob_t xJob;
+
+        configASSERT( pxPool );
+        configASSERT( pxJobFunction );
+        configASSERT( ( xTaskToNotify == NULL ) || ( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES ) );
+
+        xJob.pxJobFunction = pxJobFunction;
+        xJob.pvParameter = pvParameter;
+        xJob.xTaskToNotify = xTaskToNotify;
+        xJob.uxIndexToNotify = uxIndexToNotify;
+
+        traceTASK_POOL_SUBMIT( pxPool, pxJobFunction );
+
+        return xQueueSendToBack( pxPool->xJobQueue, &xJob, xTicksToWait );
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskPoolSubmitFromISR( TaskPoolHandle_t xPool,
+                                       TaskPoolJobFunction_t pxJobFunction,
+                                       void * pvParameter,
+                                       TaskHandle_t xTaskToNotify,
+                                       UBaseType_t uxIndexToNotify,
+                                       BaseType_t * pxHigherPriorityTaskWoken )
+    {
+        TaskPool_t * const pxPool = xPool;
+        TaskPoolJob_t xJob;
+
+        configASSERT( pxPool );
+        configASSERT( pxJobFunction );
+        configASSERT( ( xTaskToNotify == NULL ) || ( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES ) );
+
+        xJob.pxJobFunction = pxJobFunction;
+        xJob.pvParameter = pvParameter;
+        xJob.xTaskToNotify = xTaskToNotify;
+        xJob.uxIndexToNotify = uxIndexToNotify;
+
+        traceTASK_POOL_SUBMIT( pxPool, pxJobFunction );
+
+        return xQueueSendToBackFromISR( pxPool->xJobQueue, &xJob, pxHigherPriorityTaskWoken );
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t uxTaskPoolGetPendingJobs( TaskPoolHandle_t xPool )
+    {
+        TaskPool_t * const pxPool = xPool;
+
+        configASSERT( pxPool );
+
+        return uxQueueMessagesWaiting( pxPool->xJobQueue );
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include task pools.  This #if is closed at the very bottom of this file. */
+#endif /* configUSE_TASK_POOLS == 1 */
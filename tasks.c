@@ -41,6 +41,10 @@
 #include "timers.h"
 #include "stack_macros.h"
 
+#if ( configUSE_STATIC_KERNEL == 1 )
+    #include "static_kernel.h"
+#endif
+
 /* Lint e9021, e961 and e750 are suppressed as a MISRA exception justified
  * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
  * for the header files above, but not in this file, in order to generate the
@@ -63,14 +67,128 @@
 /* If the cooperative scheduler is being used then a yield should not be
  * performed just because a higher priority task has been woken. */
     #define taskYIELD_IF_USING_PREEMPTION()
+    #define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )    ( void ) ( pxTCB )
 #else
     #define taskYIELD_IF_USING_PREEMPTION()    portYIELD_WITHIN_API()
+
+    #if ( configNUMBER_OF_CORES > 1 )
+
+/* Request the core that is running the task referenced by pxTCB to select a
+ * new task to run.  Must be called from a critical section. */
+        #define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )         \
+    {                                                                    \
+        if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )                    \
+        {                                                                \
+            prvYieldCore( ( pxTCB )->xTaskRunState );                    \
+        }                                                                \
+    }
+    #endif
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/* Values that can be assigned to the xTaskRunState member of the TCB when the
+ * task is not running on any core.  Otherwise xTaskRunState holds the number of
+ * the core the task is running on. */
+    #define taskTASK_NOT_RUNNING             ( ( BaseType_t ) ( -1 ) )
+    #define taskTASK_SCHEDULED_TO_YIELD      ( ( BaseType_t ) ( -2 ) )
+
+/* Bits that can be set in the uxTaskAttributes member of the TCB. */
+    #define taskATTRIBUTE_IS_IDLE            ( ( UBaseType_t ) ( 1U << 0U ) )
+
+    #define taskVALID_CORE_ID( xCoreID )     ( ( ( ( xCoreID ) >= ( BaseType_t ) 0 ) && ( ( xCoreID ) < ( BaseType_t ) configNUMBER_OF_CORES ) ) ? pdTRUE : pdFALSE )
+
+/* Evaluates to pdTRUE if the core affinity of pxTCB allows it to run on the
+ * core xCoreID. */
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        #define taskCAN_RUN_ON_CORE( pxTCB, xCoreID )    ( ( ( ( pxTCB )->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) ( xCoreID ) ) ) != 0U ) ? pdTRUE : pdFALSE )
+    #else
+        #define taskCAN_RUN_ON_CORE( pxTCB, xCoreID )    ( pdTRUE )
+    #endif
+
+    #define taskTASK_IS_RUNNING( pxTCB )     ( ( ( ( pxTCB )->xTaskRunState >= ( BaseType_t ) 0 ) && ( ( pxTCB )->xTaskRunState < ( BaseType_t ) configNUMBER_OF_CORES ) ) ? pdTRUE : pdFALSE )
+    #define taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB )    ( ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING ) ? pdTRUE : pdFALSE )
+#else
+    #define taskTASK_IS_RUNNING( pxTCB )     ( ( ( pxTCB ) == pxCurrentTCB ) ? pdTRUE : pdFALSE )
+    #define taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB )    taskTASK_IS_RUNNING( pxTCB )
 #endif
 
+/* Evaluates to pdTRUE if tick count xTimeA is before xTimeB.  Correct across a
+ * tick count overflow provided the two are less than half the tick range
+ * apart. */
+#define taskTICK_IS_BEFORE( xTimeA, xTimeB )    ( ( ( TickType_t ) ( ( xTimeA ) - ( xTimeB ) ) > ( portMAX_DELAY >> 1 ) ) ? pdTRUE : pdFALSE )
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/* Evaluates to pdTRUE if pxTCB should preempt pxRunningTCB - either it has a
+ * higher priority, or both are in the deadline band and pxTCB has the earlier
+ * deadline. */
+    #define taskTASK_CAN_PREEMPT( pxTCB, pxRunningTCB )                    \
+    ( ( ( ( pxTCB )->uxPriority > ( pxRunningTCB )->uxPriority ) ||        \
+        ( ( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) && \
+          ( ( pxRunningTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) && \
+          ( prvDeadlineIsEarlier( ( pxTCB ), ( pxRunningTCB ) ) != pdFALSE ) ) ) ? pdTRUE : pdFALSE )
+
+/* Tasks in the deadline band are not time sliced, the one with the earliest
+ * deadline runs until it blocks. */
+    #define taskPRIORITY_IS_TIME_SLICED( uxPriority )    ( ( ( uxPriority ) != ( UBaseType_t ) configEDF_PRIORITY ) ? pdTRUE : pdFALSE )
+#else
+    #define taskTASK_CAN_PREEMPT( pxTCB, pxRunningTCB )    ( ( ( pxTCB )->uxPriority > ( pxRunningTCB )->uxPriority ) ? pdTRUE : pdFALSE )
+    #define taskPRIORITY_IS_TIME_SLICED( uxPriority )      ( pdTRUE )
+#endif
+
+/* The ticks a task has run for in its time slice only need to be counted if a
+ * time slice can be longer than one tick. */
+#if ( ( configTIME_SLICE_TICKS > 1 ) || ( configUSE_PER_PRIORITY_TIME_SLICE == 1 ) )
+    #define taskCOUNT_TIME_SLICE_TICKS    1
+#else
+    #define taskCOUNT_TIME_SLICE_TICKS    0
+#endif
+
+#if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 )
+    #define taskTIME_SLICE_LENGTH( uxPriority )    ( ( xTimeSliceLengths[ ( uxPriority ) ] != ( TickType_t ) 0U ) ? xTimeSliceLengths[ ( uxPriority ) ] : ( TickType_t ) configTIME_SLICE_TICKS )
+#else
+    #define taskTIME_SLICE_LENGTH( uxPriority )    ( ( TickType_t ) configTIME_SLICE_TICKS )
+#endif
+
+/* xTimeSliceCount is 0 while a task has no time slice in progress, and
+ * otherwise one more than the number of ticks it has run for in its current
+ * time slice. */
+#define taskTIME_SLICE_EXPIRED( pxTCB )    ( ( ( pxTCB )->xTimeSliceCount > taskTIME_SLICE_LENGTH( ( pxTCB )->uxPriority ) ) ? pdTRUE : pdFALSE )
+
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION              ( ( uint8_t ) 0 ) /* Must be zero as it is the initialised value. */
 #define taskWAITING_NOTIFICATION                  ( ( uint8_t ) 1 )
 #define taskNOTIFICATION_RECEIVED                 ( ( uint8_t ) 2 )
+#define taskSPINNING_NOTIFICATION                 ( ( uint8_t ) 3 ) /* Polling in xTaskGenericNotifyWaitSpin(), not blocked. */
+
+/* Records the run time counter in a task that an interrupt is unblocking, so
+ * the time it takes the task to start running can be measured when it is next
+ * switched in. */
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+        #define taskRECORD_ISR_WAKE( pxTCB )                                    \
+    do {                                                                        \
+        portALT_GET_RUN_TIME_COUNTER_VALUE( ( pxTCB )->ulISRWakeTime );         \
+        ( pxTCB )->ucISRWakePending = ( uint8_t ) pdTRUE;                       \
+    } while( 0 )
+    #else
+        #define taskRECORD_ISR_WAKE( pxTCB )                                    \
+    do {                                                                        \
+        ( pxTCB )->ulISRWakeTime = portGET_RUN_TIME_COUNTER_VALUE();            \
+        ( pxTCB )->ucISRWakePending = ( uint8_t ) pdTRUE;                       \
+    } while( 0 )
+    #endif
+#else
+    #define taskRECORD_ISR_WAKE( pxTCB )
+#endif
+
+/* Tells the application that a task has been added to a ready list. */
+#if ( configUSE_SCHEDULER_EVENT_HOOKS == 1 )
+    #define taskCALL_READIED_HOOK( pxTCB )    vApplicationTaskReadiedHook( ( TaskHandle_t ) ( pxTCB ) )
+#else
+    #define taskCALL_READIED_HOOK( pxTCB )
+#endif
 
 /*
  * The value used to fill the stack of a task when the task is created.  This
@@ -85,13 +203,48 @@
 
 /* If any of the following are set then task stacks are filled with a known
  * value so the high water mark can be determined.  If none of the following are
- * set then don't fill the stack so there is no unnecessary dependency on memset. */
-#if ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+ * set then don't fill the stack so there is no unnecessary dependency on memset.
+ * Stack overflow checking only needs the fill if it is done in software. */
+#if ( ( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) && ( taskSTACK_OVERFLOW_CHECKED_IN_HARDWARE == 0 ) ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    1
 #else
     #define tskSET_NEW_STACKS_TO_KNOWN_VALUE    0
 #endif
 
+/*
+ * Record how deep the stack of a task that is being switched out has reached.
+ * pxTopOfStack holds the stack pointer saved by the port's context switch.
+ * Ports that save the context elsewhere, such as some MPU ports, leave
+ * pxTopOfStack outside the stack, which the bounds check ignores.
+ */
+#if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+    #if ( portSTACK_GROWTH < 0 )
+        #define taskRECORD_STACK_HIGH_WATER_MARK( pxTCB )                                   \
+    do {                                                                                    \
+        StackType_t * pxSavedStackPointer = ( StackType_t * ) ( pxTCB )->pxTopOfStack;      \
+                                                                                            \
+        if( ( pxSavedStackPointer < ( pxTCB )->pxStackHighWaterMark ) &&                    \
+            ( pxSavedStackPointer >= ( pxTCB )->pxStack ) )                                 \
+        {                                                                                   \
+            ( pxTCB )->pxStackHighWaterMark = pxSavedStackPointer;                          \
+        }                                                                                   \
+    } while( 0 )
+    #else
+        #define taskRECORD_STACK_HIGH_WATER_MARK( pxTCB )                                   \
+    do {                                                                                    \
+        StackType_t * pxSavedStackPointer = ( StackType_t * ) ( pxTCB )->pxTopOfStack;      \
+                                                                                            \
+        if( ( pxSavedStackPointer > ( pxTCB )->pxStackHighWaterMark ) &&                    \
+            ( pxSavedStackPointer <= ( pxTCB )->pxEndOfStack ) )                            \
+        {                                                                                   \
+            ( pxTCB )->pxStackHighWaterMark = pxSavedStackPointer;                          \
+        }                                                                                   \
+    } while( 0 )
+    #endif
+#else
+    #define taskRECORD_STACK_HIGH_WATER_MARK( pxTCB )
+#endif
+
 /*
  * Macros used by vListTask to indicate which state a task is in.
  */
@@ -115,7 +268,114 @@
     #define configIDLE_TASK_NAME    "IDLE"
 #endif
 
-#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+/* The name allocated to the reaper task.  This can be overridden by defining
+ * configTASK_REAPER_NAME in FreeRTOSConfig.h. */
+#ifndef configTASK_REAPER_NAME
+    #define configTASK_REAPER_NAME    "Reaper"
+#endif
+
+/* The sleep state governor holds the average ratio of the time actually slept
+ * to the time requested as a fixed point fraction of tskSLEEP_ACCURACY_ONE.
+ * Each new sleep contributes 1 / 2^tskSLEEP_ACCURACY_SHIFT of the average. */
+#if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+    #define tskSLEEP_ACCURACY_ONE      ( ( uint32_t ) 256U )
+    #define tskSLEEP_ACCURACY_SHIFT    ( 3U )
+#endif
+
+/* Select the task to run from the ready list of priority uxPriority.  The
+ * deadline band is held in deadline order so its head is always taken, other
+ * lists are indexed through, so the tasks of the same priority get an equal
+ * share of the processor time. */
+#if ( ( configNUMBER_OF_CORES == 1 ) && ( taskCOUNT_TIME_SLICE_TICKS == 1 ) )
+    #define taskSELECT_TASK_FROM_TIME_SLICED_LIST( uxPriority )    prvSelectTimeSlicedTask( &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+#else
+    #define taskSELECT_TASK_FROM_TIME_SLICED_LIST( uxPriority )    listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ ( uxPriority ) ] ) )
+#endif
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #define taskSELECT_TASK_FROM_READY_LIST( uxPriority )                                                            \
+    {                                                                                                                \
+        if( ( uxPriority ) == ( UBaseType_t ) configEDF_PRIORITY )                                                   \
+        {                                                                                                            \
+            pxCurrentTCB = listGET_OWNER_OF_HEAD_ENTRY( &( pxReadyTasksLists[ ( uxPriority ) ] ) ); /*lint !e9079 void * is used as this macro is used with timers too. */ \
+        }                                                                                                            \
+        else                                                                                                         \
+        {                                                                                                            \
+            taskSELECT_TASK_FROM_TIME_SLICED_LIST( uxPriority );                                                     \
+        }                                                                                                            \
+    }
+#else
+    #define taskSELECT_TASK_FROM_READY_LIST( uxPriority )    taskSELECT_TASK_FROM_TIME_SLICED_LIST( uxPriority )
+#endif
+
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+
+/* If configUSE_BITMAP_TASK_SELECTION is 1 then task selection is performed
+ * using a generic two level bitmap.  Bit ( uxPriority & 7 ) of
+ * ucReadyPriorityBitmap[ uxPriority >> 3 ] is set while the ready list of
+ * uxPriority is not empty, and bit n of ucReadyPriorityGroups is set while
+ * ucReadyPriorityBitmap[ n ] is not zero.  The highest set bit of each level is
+ * found with a lookup table, so selection takes the same time whichever
+ * priorities are ready, without needing a count leading zeros instruction. */
+
+/* The bit number of the most significant set bit of an 8-bit value that is not
+ * zero. */
+    #define taskHIGHEST_SET_BIT( ucBits )                                                                                         \
+    ( ( ( ucBits ) > ( uint8_t ) 0x0FU ) ? ( UBaseType_t ) ( ucHighestSetBitInNibble[ ( ucBits ) >> 4 ] + ( uint8_t ) 4U ) : \
+      ( UBaseType_t ) ucHighestSetBitInNibble[ ( ucBits ) ] )
+
+    #define taskRECORD_READY_PRIORITY( uxPriority )                                                     \
+    {                                                                                                   \
+        ucReadyPriorityBitmap[ ( uxPriority ) >> 3 ] |= ( uint8_t ) ( 1U << ( ( uxPriority ) & 0x07U ) ); \
+        ucReadyPriorityGroups |= ( uint8_t ) ( 1U << ( ( uxPriority ) >> 3 ) );                          \
+    } /* taskRECORD_READY_PRIORITY */
+
+/*-----------------------------------------------------------*/
+
+    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                                      \
+    {                                                                                               \
+        UBaseType_t uxTopGroup;                                                                     \
+        UBaseType_t uxTopPriority;                                                                  \
+                                                                                                    \
+        /* Find the highest priority list that contains ready tasks.  There is                   \
+         * always at least the idle task ready. */                                                  \
+        configASSERT( ucReadyPriorityGroups != ( uint8_t ) 0U );                                    \
+        uxTopGroup = taskHIGHEST_SET_BIT( ucReadyPriorityGroups );                                  \
+        uxTopPriority = ( uxTopGroup << 3 ) + taskHIGHEST_SET_BIT( ucReadyPriorityBitmap[ uxTopGroup ] ); \
+        configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 );     \
+        taskSELECT_TASK_FROM_READY_LIST( uxTopPriority );                                           \
+    } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
+
+/*-----------------------------------------------------------*/
+
+/* Clear the bit of uxPriority, and the bit of its group if no other priority
+ * in the group has ready tasks.  The uxTopReadyPriority parameter is unused,
+ * it is only present so the macro can be called in the same way as the port
+ * provided version. */
+    #define portRESET_READY_PRIORITY( uxPriority, uxTopReadyPriority )                                   \
+    {                                                                                                    \
+        ucReadyPriorityBitmap[ ( uxPriority ) >> 3 ] &= ( uint8_t ) ~( 1U << ( ( uxPriority ) & 0x07U ) ); \
+                                                                                                         \
+        if( ucReadyPriorityBitmap[ ( uxPriority ) >> 3 ] == ( uint8_t ) 0U )                             \
+        {                                                                                                \
+            ucReadyPriorityGroups &= ( uint8_t ) ~( 1U << ( ( uxPriority ) >> 3 ) );                     \
+        }                                                                                                \
+    }
+
+/* Only reset the bit if the ready list of the priority has become empty.  If
+ * the TCB being reset is referenced from a delayed or suspended list then it
+ * won't be in a ready list. */
+    #define taskRESET_READY_PRIORITY( uxPriority )                                                     \
+    {                                                                                                  \
+        if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ ( uxPriority ) ] ) ) == ( UBaseType_t ) 0 ) \
+        {                                                                                              \
+            portRESET_READY_PRIORITY( ( uxPriority ), ( uxTopReadyPriority ) );                        \
+        }                                                                                              \
+    }
+
+#elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 
 /* If configUSE_PORT_OPTIMISED_TASK_SELECTION is 0 then task selection is
  * performed in a generic way that is not optimised to any particular
@@ -133,7 +393,8 @@
 
 /*-----------------------------------------------------------*/
 
-    #define taskSELECT_HIGHEST_PRIORITY_TASK()                                \
+    #if ( configNUMBER_OF_CORES == 1 )
+        #define taskSELECT_HIGHEST_PRIORITY_TASK()                            \
     {                                                                         \
         UBaseType_t uxTopPriority = uxTopReadyPriority;                       \
                                                                               \
@@ -144,11 +405,16 @@
             --uxTopPriority;                                                  \
         }                                                                     \
                                                                               \
-        /* listGET_OWNER_OF_NEXT_ENTRY indexes through the list, so the tasks of \
-         * the  same priority get an equal share of the processor time. */                    \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) ); \
+        taskSELECT_TASK_FROM_READY_LIST( uxTopPriority );                     \
         uxTopReadyPriority = uxTopPriority;                                                   \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK */
+    #else
+
+/* When there is more than one core the ready lists may have to be searched
+ * beyond the first list that contains ready tasks, as a ready task can already
+ * be running on another core. */
+        #define taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID )    prvSelectHighestPriorityTask( xCoreID )
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
 /*-----------------------------------------------------------*/
 
@@ -176,7 +442,7 @@
         /* Find the highest priority list that contains ready tasks. */                         \
         portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );                          \
         configASSERT( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxTopPriority ] ) ) > 0 ); \
-        listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, &( pxReadyTasksLists[ uxTopPriority ] ) );   \
+        taskSELECT_TASK_FROM_READY_LIST( uxTopPriority );                                       \
     } /* taskSELECT_HIGHEST_PRIORITY_TASK() */
 
 /*-----------------------------------------------------------*/
@@ -192,7 +458,7 @@
         }                                                                                              \
     }
 
-#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+#endif /* configUSE_BITMAP_TASK_SELECTION, configUSE_PORT_OPTIMISED_TASK_SELECTION */
 
 /*-----------------------------------------------------------*/
 
@@ -214,15 +480,136 @@
 
 /*-----------------------------------------------------------*/
 
+/*
+ * Insert the task represented by pxTCB into the ready list of its priority.
+ * It is inserted at the end of the list, other than in the deadline band,
+ * where it is inserted in order of deadline.
+ */
+#if ( configUSE_EDF_SCHEDULING == 1 )
+    #define prvInsertTaskIntoReadyList( pxTCB )                                                                \
+    {                                                                                                          \
+        if( ( pxTCB )->uxPriority == ( UBaseType_t ) configEDF_PRIORITY )                                      \
+        {                                                                                                      \
+            prvAddTaskToDeadlineOrderedList( pxTCB );                                                          \
+        }                                                                                                      \
+        else                                                                                                   \
+        {                                                                                                      \
+            listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
+        }                                                                                                      \
+    }
+#else
+    #define prvInsertTaskIntoReadyList( pxTCB )    listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) )
+#endif
+
+/* Move the port's stack guard region to the stack of the task that is about to
+ * run.  Tasks whose stacks did not come from the stack pool run without a
+ * guard. */
+#if ( portSTACK_POOL_GUARD_SIZE > 0 )
+    #define taskSET_STACK_GUARD( pxTCB )    portSET_STACK_GUARD( pvPortGetStackGuard( ( pxTCB )->pxStack ) )
+#else
+    #define taskSET_STACK_GUARD( pxTCB )
+#endif
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+/* While the port is deferring the tick the tick count lags real time, so it is
+ * brought up to date before it is read or a scheduling decision is made.  A
+ * task readied at a lower priority than the running task does not change what
+ * runs, so does not need the tick back. */
+    #define taskSTOP_DYNAMIC_TICK()                   \
+    do {                                              \
+        if( xDynamicTickActive != pdFALSE )           \
+        {                                             \
+            prvStopDynamicTick();                     \
+        }                                             \
+    } while( 0 )
+
+    #define taskSTOP_DYNAMIC_TICK_FOR( pxTCB )                   \
+    do {                                                         \
+        if( ( xDynamicTickActive != pdFALSE ) &&                 \
+            ( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority ) ) \
+        {                                                        \
+            prvStopDynamicTick();                                \
+        }                                                        \
+    } while( 0 )
+#else
+    #define taskSTOP_DYNAMIC_TICK()
+    #define taskSTOP_DYNAMIC_TICK_FOR( pxTCB )
+#endif /* configUSE_DYNAMIC_TICK */
+
 /*
  * Place the task represented by pxTCB into the appropriate ready list for
- * the task.  It is inserted at the end of the list.
+ * the task.
  */
-#define prvAddTaskToReadyList( pxTCB )                                                                 \
-    traceMOVED_TASK_TO_READY_STATE( pxTCB );                                                           \
-    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );                                                \
-    listINSERT_END( &( pxReadyTasksLists[ ( pxTCB )->uxPriority ] ), &( ( pxTCB )->xStateListItem ) ); \
-    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB )
+#if ( taskCOUNT_TIME_SLICE_TICKS == 1 )
+    #define prvAddEligibleTaskToReadyList( pxTCB )          \
+    taskSTOP_DYNAMIC_TICK_FOR( pxTCB );                     \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );                \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );     \
+    ( pxTCB )->xTimeSliceCount = ( TickType_t ) 0U;         \
+    prvInsertTaskIntoReadyList( pxTCB );                    \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );           \
+    taskCALL_READIED_HOOK( pxTCB )
+#else
+    #define prvAddEligibleTaskToReadyList( pxTCB )          \
+    taskSTOP_DYNAMIC_TICK_FOR( pxTCB );                     \
+    traceMOVED_TASK_TO_READY_STATE( pxTCB );                \
+    taskRECORD_READY_PRIORITY( ( pxTCB )->uxPriority );     \
+    prvInsertTaskIntoReadyList( pxTCB );                    \
+    tracePOST_MOVED_TASK_TO_READY_STATE( pxTCB );           \
+    taskCALL_READIED_HOOK( pxTCB )
+#endif
+
+#if ( configUSE_TIME_PARTITIONS == 1 )
+
+/* A task can run while the partition it belongs to owns the current window of
+ * the partition schedule.  Tasks that are not in a partition, which includes
+ * the idle task, are in partition 0.  The idle task can always run, and the
+ * other partition 0 tasks can run in every window if
+ * configTIME_PARTITION_DONATE_IDLE_TIME is 1. */
+    #define taskPARTITION_IS_ACTIVE( pxTCB )                                                        \
+    ( ( ( pxTCB )->uxPartition == uxActivePartition ) ||                                            \
+      ( ( ( pxTCB )->uxPartition == ( UBaseType_t ) 0U ) &&                                         \
+        ( ( configTIME_PARTITION_DONATE_IDLE_TIME == 1 ) || ( ( pxTCB ) == xIdleTaskHandle ) ) ) )
+
+/* A task that is ready to run while its partition is not active is parked in
+ * the parked list of its partition instead of its ready list, and is moved to
+ * its ready list when its partition next becomes active. */
+    #define prvAddTaskToReadyList( pxTCB )                                                                         \
+    {                                                                                                              \
+        if( taskPARTITION_IS_ACTIVE( pxTCB ) != pdFALSE )                                                          \
+        {                                                                                                          \
+            prvAddEligibleTaskToReadyList( pxTCB );                                                                \
+        }                                                                                                          \
+        else                                                                                                       \
+        {                                                                                                          \
+            listINSERT_END( &( xParkedTaskLists[ ( pxTCB )->uxPartition ] ), &( ( pxTCB )->xStateListItem ) );     \
+        }                                                                                                          \
+    }
+#elif ( configUSE_MIXED_CRITICALITY == 1 )
+
+/* A low criticality task cannot run while the kernel is in high criticality
+ * mode. */
+    #define taskTASK_IS_SHED( pxTCB ) \
+    ( ( uxCriticalityMode == tskCRITICALITY_HIGH ) && ( ( pxTCB )->uxCriticality == tskCRITICALITY_LOW ) )
+
+/* A task that is ready to run while it is shed is placed in the shed task list
+ * instead of its ready list, and is moved to its ready list when the kernel
+ * returns to low criticality mode. */
+    #define prvAddTaskToReadyList( pxTCB )                                          \
+    {                                                                               \
+        if( taskTASK_IS_SHED( pxTCB ) == pdFALSE )                                  \
+        {                                                                           \
+            prvAddEligibleTaskToReadyList( pxTCB );                                 \
+        }                                                                           \
+        else                                                                        \
+        {                                                                           \
+            listINSERT_END( &xShedTaskList, &( ( pxTCB )->xStateListItem ) );       \
+        }                                                                           \
+    }
+#else
+    #define prvAddTaskToReadyList( pxTCB )    prvAddEligibleTaskToReadyList( pxTCB )
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -249,6 +636,29 @@
     #define taskEVENT_LIST_ITEM_VALUE_IN_USE    0x8000000000000000ULL
 #endif
 
+/* A task blocked in xQueueWaitForAny() is linked into event lists through its
+ * wait records rather than through its own event list item. */
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+    #define taskIS_WAITING_ON_EVENT( pxTCB )                                        \
+    ( ( ( listLIST_ITEM_CONTAINER( &( ( pxTCB )->xEventListItem ) ) != NULL ) ||    \
+        ( ( pxTCB )->pxWaitRecords != NULL ) ) ? pdTRUE : pdFALSE )
+#else
+    #define taskIS_WAITING_ON_EVENT( pxTCB ) \
+    ( ( listLIST_ITEM_CONTAINER( &( ( pxTCB )->xEventListItem ) ) != NULL ) ? pdTRUE : pdFALSE )
+#endif
+
+/* An interrupt that ends an xQueueWaitForAny() removes the waiting task's
+ * records from the event lists of all the objects it waited on, including
+ * objects that are locked, so with configUSE_QUEUE_WAIT_FOR_ANY tasks insert
+ * into event lists with interrupts masked. */
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+    #define taskENTER_EVENT_LIST_CRITICAL()    taskENTER_CRITICAL()
+    #define taskEXIT_EVENT_LIST_CRITICAL()     taskEXIT_CRITICAL()
+#else
+    #define taskENTER_EVENT_LIST_CRITICAL()
+    #define taskEXIT_EVENT_LIST_CRITICAL()
+#endif
+
 /*
  * Task control block.  A task control block (TCB) is allocated for each task,
  * and stores task state information, including a pointer to the task's context
@@ -266,7 +676,44 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     ListItem_t xEventListItem;                  /*< Used to reference a task from an event list. */
     UBaseType_t uxPriority;                     /*< The priority of the task.  0 is the lowest priority. */
     StackType_t * pxStack;                      /*< Points to the start of the stack. */
-    char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        volatile BaseType_t xTaskRunState; /*< The core the task is running on, or taskTASK_NOT_RUNNING/taskTASK_SCHEDULED_TO_YIELD if it is not running. */
+        UBaseType_t uxTaskAttributes;      /*< Task attributes - currently only used to identify the idle tasks. */
+    #endif
+    #if ( configUSE_CORE_AFFINITY == 1 )
+        UBaseType_t uxCoreAffinityMask; /*< Bit N is set if the task is allowed to run on core N. */
+    #endif
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+        TickType_t xRelativeDeadline; /*< The deadline of each release relative to its release time.  0 if the task was not created with xTaskCreateDeadline(). */
+        TickType_t xAbsoluteDeadline; /*< The deadline of the current release. */
+    #endif
+    #if ( configUSE_TASK_BUDGETS == 1 )
+        TickType_t xBudgetTicks;       /*< The number of ticks the task may run for in each budget period.  0 if the task has no budget. */
+        TickType_t xBudgetPeriod;      /*< The length of the budget period in ticks. */
+        TickType_t xBudgetRemaining;   /*< The ticks left in the current budget period.  0 while the task is throttled. */
+        TickType_t xBudgetPeriodStart; /*< The tick count at which the current budget period started. */
+    #endif
+    #if ( configUSE_TIME_PARTITIONS == 1 )
+        UBaseType_t uxPartition; /*< The time partition the task belongs to, or 0 if it is not in a partition. */
+    #endif
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+        UBaseType_t uxCriticality; /*< tskCRITICALITY_LOW if the task is shed in high criticality mode, otherwise tskCRITICALITY_HIGH. */
+    #endif
+    #if ( taskCOUNT_TIME_SLICE_TICKS == 1 )
+        TickType_t xTimeSliceCount; /*< Progress through the current time slice, see taskTIME_SLICE_EXPIRED(). */
+    #endif
+    #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+        UBaseType_t uxPreemptionDisable; /*< The nesting depth of vTaskPreemptionDisable() calls.  Only written by the task itself. */
+    #endif
+    #if ( configUSE_TCB_HOT_LAYOUT == 0 )
+        #if ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_COPY )
+            char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        #elif ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_REFERENCE )
+            const char * pcTaskName; /*< Points to the name given to the task when created, which the application keeps valid for the life of the task. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        #endif
+    #elif ( configGENERATE_RUN_TIME_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /*< Stores the amount of time the task has spent in the Running state.  Updated by every context switch, so kept with the members above. */
+    #endif
 
     #if ( ( portSTACK_GROWTH > 0 ) || ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
         StackType_t * pxEndOfStack; /*< Points to the highest valid address for the stack. */
@@ -286,18 +733,28 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
         UBaseType_t uxMutexesHeld;
     #endif
 
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+        TaskHandle_t * pxBlockingMutexHolder; /*< Points to the holder of the mutex the task is blocked on, if any - used to pass inherited priorities along chains of mutexes. */
+    #endif
+
     #if ( configUSE_APPLICATION_TASK_TAG == 1 )
         TaskHookFunction_t pxTaskTag;
     #endif
 
-    #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+    #if ( ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 ) && ( configUSE_TCB_HOT_LAYOUT == 0 ) )
         void * pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
     #endif
 
-    #if ( configGENERATE_RUN_TIME_STATS == 1 )
+    #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_TCB_HOT_LAYOUT == 0 ) )
         configRUN_TIME_COUNTER_TYPE ulRunTimeCounter; /*< Stores the amount of time the task has spent in the Running state. */
     #endif
 
+    #if ( configUSE_CORE_RUN_TIME_STATS == 1 )
+        UBaseType_t uxCoresRunOn;    /*< Bit N is set once the task has run on core N. */
+        UBaseType_t uxLastCoreRunOn; /*< The core the task last ran on.  Only valid once uxCoresRunOn is not 0. */
+        UBaseType_t uxMigrations;    /*< The number of times the task has started running on a different core from the one it last ran on. */
+    #endif
+
     #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
         configTLS_BLOCK_TYPE xTLSBlock; /*< Memory block used as Thread Local Storage (TLS) Block for the task. */
     #endif
@@ -320,15 +777,101 @@ typedef struct tskTaskControlBlock       /* The old naming convention is used to
     #if ( configUSE_POSIX_ERRNO == 1 )
         int iTaskErrno;
     #endif
+
+    #if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+        uint64_t ullEventItemBits; /*< Holds the event bits an event group would otherwise store in xEventListItem, which is too narrow for 64-bit event bits. */
+    #endif
+
+    #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        size_t xHeapBytesAllocated; /*< The heap memory held by blocks the task allocated and has not yet freed. */
+        size_t xHeapQuota;          /*< The most heap memory the task can hold, or 0 for no limit. */
+        uint8_t ucHeapOwnerDeleted; /*< Set to pdTRUE if the task was deleted while it still held heap memory, in which case the TCB is freed with the task's last block. */
+    #endif
+
+    #if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+        configRUN_TIME_COUNTER_TYPE ulISRWakeTime;                       /*< The run time counter value when an interrupt last unblocked the task. */
+        configRUN_TIME_COUNTER_TYPE ulISRWakeLatencyMin;                 /*< The statistics returned by vTaskGetISRWakeLatencyStats(). */
+        configRUN_TIME_COUNTER_TYPE ulISRWakeLatencyMax;
+        configRUN_TIME_COUNTER_TYPE ulISRWakeLatencyTotal;
+        uint32_t ulISRWakeCount;
+        uint32_t ulISRWakeHistogram[ configISR_WAKE_LATENCY_BUCKETS ];
+        uint8_t ucISRWakePending;                                        /*< Set to pdTRUE while ulISRWakeTime holds a wake that has not yet been measured. */
+    #endif
+
+    #if ( configUSE_PERIODIC_TASK_STATS == 1 )
+        TaskPeriodicStats_t xPeriodicStats; /*< The statistics returned by vTaskGetPeriodicStats(), updated by xTaskDelayUntil(). */
+    #endif
+
+    #if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+        uint32_t ulRunTimeWindowPeriod;                                                /*< The period to which ulRunTimeWindowCurrent[] belongs. */
+        configRUN_TIME_COUNTER_TYPE ulRunTimeWindowCurrent[ tskRUN_TIME_WINDOWS ];     /*< The run time accumulated in each window that is still in progress. */
+        configRUN_TIME_COUNTER_TYPE ulRunTimeWindowCompleted[ tskRUN_TIME_WINDOWS ];   /*< The run time in the most recently completed instance of each window. */
+    #endif
+
+    #if ( configUSE_TASK_ITERATOR == 1 )
+        struct tskTaskControlBlock * pxRegistryNext;     /*< The next task in creation order, used by xTaskIteratorNext(). */
+        struct tskTaskControlBlock * pxRegistryPrevious; /*< The previous task in creation order. */
+    #endif
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+        StackType_t * pxStackHighWaterMark; /*< The deepest stack word known to have been used. */
+    #endif
+    #if ( configUSE_TASK_MAILBOXES == 1 )
+        void * volatile pvMailbox[ configTASK_NOTIFICATION_ARRAY_ENTRIES ]; /*< The message most recently posted to each notification index by xTaskGenericMailboxSend(). */
+    #endif
+    #if ( configTASK_NAME_HASH_BUCKETS > 0 )
+        struct tskTaskControlBlock * pxNameHashNext; /*< The next task whose name hashes to the same bucket of the task name index. */
+    #endif
+    #if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+        TaskWaitRecord_t * pxWaitRecords;         /*< The records linking the task into event lists while it is blocked in xQueueWaitForAny(), otherwise NULL. */
+        TaskWaitRecord_t * pxSignalledWaitRecord; /*< The record through which the last xQueueWaitForAny() wait was ended, or NULL if it was not ended by an event. */
+    #endif
+    #if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+        void * pvHandoffBuffer;     /*< The buffer a sender can copy an item into directly while the task is blocked in xQueueReceive(), otherwise NULL. */
+        BaseType_t xHandoffComplete; /*< pdTRUE if a sender copied an item into pvHandoffBuffer during the last wait. */
+    #endif
+    #if ( configUSE_WAIT_ON_ADDRESS == 1 )
+        const volatile uint32_t * pulWaitAddress; /*< The address the task is blocked on in xTaskWaitOnAddress(), or NULL once vTaskWakeAddress() has woken it. */
+    #endif
+
+    /* Members a context switch never touches, moved here, out of the way of
+     * the members it does, when configUSE_TCB_HOT_LAYOUT is 1. */
+    #if ( configUSE_TCB_HOT_LAYOUT == 1 )
+        #if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS > 0 )
+            void * pvThreadLocalStoragePointers[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
+        #endif
+        #if ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_COPY )
+            char pcTaskName[ configMAX_TASK_NAME_LEN ]; /*< Descriptive name given to the task when created.  Facilitates debugging only. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        #elif ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_REFERENCE )
+            const char * pcTaskName; /*< Points to the name given to the task when created, which the application keeps valid for the life of the task. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+        #endif
+    #endif
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
  * below to enable the use of older kernel aware debuggers. */
 typedef tskTCB TCB_t;
 
+/* The name of the task pxTCB, as a char * for pcTaskGetName() and the stack
+ * overflow hook, whichever way configTASK_NAME_STORAGE holds names. */
+#if ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_COPY )
+    #define taskGET_TASK_NAME( pxTCB )    ( &( ( pxTCB )->pcTaskName[ 0 ] ) )
+#elif ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_REFERENCE )
+    #define taskGET_TASK_NAME( pxTCB )    ( ( char * ) ( pxTCB )->pcTaskName ) /*lint !e9005 The name is returned through the original non-const API. */
+#else
+    #define taskGET_TASK_NAME( pxTCB )    ( ( void ) ( pxTCB ), ( char * ) "" )
+#endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
-portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#else
+
+/* Each core has its own current TCB.  Within this file pxCurrentTCB refers to
+ * the TCB of the task running on the calling core. */
+    portDONT_DISCARD PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+    #define pxCurrentTCB    xTaskGetCurrentTaskHandle()
+#endif
 
 /* Lists for ready and blocked tasks. --------------------
  * xDelayedTaskList1 and xDelayedTaskList2 could be moved to function scope but
@@ -339,8 +882,48 @@ PRIVILEGED_DATA static List_t xDelayedTaskList1;                         /*< Del
 PRIVILEGED_DATA static List_t xDelayedTaskList2;                         /*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
 PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;              /*< Points to the delayed task list currently being used. */
 PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;      /*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/* Tasks that wake within configDELAYED_TASK_WHEEL_SIZE ticks are held in the
+ * slot of the wheel indexed by their wake time modulo the wheel size instead
+ * of a sorted delayed list, so blocking and unblocking them is O(1).  The slot
+ * for the new tick count is checked on every tick. */
+    #define taskDELAYED_TASK_WHEEL_MASK    ( ( TickType_t ) configDELAYED_TASK_WHEEL_SIZE - ( TickType_t ) 1 )
+    PRIVILEGED_DATA static List_t xDelayedTaskWheel[ configDELAYED_TASK_WHEEL_SIZE ]; /*< Slots of unordered delayed tasks. */
+#endif
 PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
+#if ( configUSE_WAIT_ON_ADDRESS == 1 )
+
+/* Tasks blocked in xTaskWaitOnAddress() are held, in priority order, in the
+ * list selected by their address.  Addresses are assumed to be 4 byte aligned,
+ * so the two least significant bits are dropped before hashing. */
+    #define taskWAIT_ON_ADDRESS_LIST( pulAddress ) \
+    ( &( xWaitOnAddressLists[ ( ( portPOINTER_SIZE_TYPE ) ( pulAddress ) >> 2 ) % ( portPOINTER_SIZE_TYPE ) configWAIT_ON_ADDRESS_LISTS ] ) )
+    PRIVILEGED_DATA static List_t xWaitOnAddressLists[ configWAIT_ON_ADDRESS_LISTS ]; /*< Tasks blocked in xTaskWaitOnAddress(). */
+#endif
+
+#if ( configUSE_TIME_PARTITIONS == 1 )
+
+    PRIVILEGED_DATA static List_t xParkedTaskLists[ configNUMBER_OF_TIME_PARTITIONS + 1 ];  /*< Tasks that are ready to run, but whose partition is not active. */
+    PRIVILEGED_DATA static const TimePartitionWindow_t * pxPartitionWindows = NULL;         /*< The partition schedule, or NULL if there is none. */
+    PRIVILEGED_DATA static UBaseType_t uxNumberOfPartitionWindows = ( UBaseType_t ) 0U;     /*< The number of windows in the partition schedule. */
+    PRIVILEGED_DATA static UBaseType_t uxPartitionWindow = ( UBaseType_t ) 0U;              /*< The index of the current window. */
+    PRIVILEGED_DATA static TickType_t xPartitionWindowTicksLeft = ( TickType_t ) 0U;        /*< The number of ticks until the current window ends. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxActivePartition = ( UBaseType_t ) 0U;     /*< The partition that owns the current window. */
+
+#endif
+
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+    PRIVILEGED_DATA static List_t xShedTaskList;                                              /*< Low criticality tasks that are ready to run, but are shed because the kernel is in high criticality mode. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxCriticalityMode = tskCRITICALITY_LOW;       /*< The current criticality mode. */
+    PRIVILEGED_DATA static TickType_t xCriticalityHoldOffTicks = ( TickType_t ) 0U;           /*< The ticks spent in high criticality mode since the switch or the last budget overrun by a high criticality task. */
+    PRIVILEGED_DATA static volatile BaseType_t xIdleRanInHighMode = pdFALSE;                  /*< Set by the idle task, and cleared whenever xCriticalityHoldOffTicks is. */
+
+#endif
+
 #if ( INCLUDE_vTaskDelete == 1 )
 
     PRIVILEGED_DATA static List_t xTasksWaitingTermination; /*< Tasks that have been deleted - but their memory not yet freed. */
@@ -352,6 +935,10 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 
     PRIVILEGED_DATA static List_t xSuspendedTaskList; /*< Tasks that are currently suspended. */
 
+    #if ( configUSE_TASK_STATE_COUNTS == 1 )
+        PRIVILEGED_DATA static UBaseType_t uxSuspendedTaskCount = ( UBaseType_t ) 0U; /*< The number of tasks in xSuspendedTaskList that are suspended rather than blocked indefinitely. */
+    #endif
+
 #endif
 
 /* Global POSIX errno. Its value is changed upon context switching to match
@@ -363,20 +950,95 @@ PRIVILEGED_DATA static List_t xPendingReadyList;                         /*< Tas
 /* Other file private variables. --------------------------------*/
 PRIVILEGED_DATA static volatile UBaseType_t uxCurrentNumberOfTasks = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
-PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+    PRIVILEGED_DATA static volatile uint8_t ucReadyPriorityGroups = ( uint8_t ) 0U;                                           /*< Bit n is set while ucReadyPriorityBitmap[ n ] is not zero. */
+    PRIVILEGED_DATA static volatile uint8_t ucReadyPriorityBitmap[ ( configMAX_PRIORITIES + 7 ) / 8 ] = { ( uint8_t ) 0U }; /*< One bit per priority, set while its ready list is not empty. */
+    static const uint8_t ucHighestSetBitInNibble[ 16 ] = { 0U, 0U, 1U, 1U, 2U, 2U, 2U, 2U, 3U, 3U, 3U, 3U, 3U, 3U, 3U, 3U };
+#else
+    PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority = tskIDLE_PRIORITY;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning = pdFALSE;
 PRIVILEGED_DATA static volatile TickType_t xPendedTicks = ( TickType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPending = pdFALSE;
+#else
+    PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ] = { pdFALSE };
+#endif
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    PRIVILEGED_DATA static volatile BaseType_t xDynamicTickActive = pdFALSE; /*< pdTRUE while the port is deferring the tick at the kernel's request. */
+#endif
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configNUMBER_OF_CORES > 1 ) )
+    PRIVILEGED_DATA static volatile UBaseType_t uxCoresHalted = 0U;        /*< The number of cores halted in portWAIT_FOR_INTERRUPT() by their idle task. */
+    PRIVILEGED_DATA static volatile BaseType_t xTicklessSleepingCore = -1; /*< The core that has suppressed the tick, or -1 if the tick is running. */
+#endif
+#if ( configUSE_WAKE_AFFINITY == 1 )
+    PRIVILEGED_DATA static volatile uint32_t ulCrossCoreYields = 0U; /*< The number of times another core was interrupted to yield. */
+#endif
+#if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 )
+    PRIVILEGED_DATA static TickType_t xTimeSliceLengths[ configMAX_PRIORITIES ]; /*< The time slice length of each priority in ticks, 0 to use configTIME_SLICE_TICKS. */
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows = ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber = ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime = ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                          /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) )
+    PRIVILEGED_DATA static TickType_t xNextTickTimerExpiry = portMAX_DELAY; /*< The next expiry of a timer that calls its callback from the tick interrupt, which xNextTaskUnblockTime must not pass. */
+#endif
+#if ( configNUMBER_OF_CORES == 1 )
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle = NULL;                      /*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+    PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];   /*< Holds the handles of the idle tasks, one per core.  The idle tasks are created automatically when the scheduler is started. */
+#endif
+#if ( configUSE_TASK_REAPER == 1 )
+    PRIVILEGED_DATA static TaskHandle_t xReaperTaskHandle = NULL; /*< Holds the handle of the reaper task, which is created when the scheduler is started. */
+#endif
 
 /* Improve support for OpenOCD. The kernel tracks Ready tasks via priority lists.
  * For tracking the state of remote threads, OpenOCD uses uxTopUsedPriority
  * to determine the number of priority lists to read back from the remote target. */
 const volatile UBaseType_t uxTopUsedPriority = configMAX_PRIORITIES - 1U;
 
+#if ( configUSE_TCB_HOT_LAYOUT == 1 )
+
+/* The offsets of the TCB members kernel aware debuggers read, for debuggers
+ * that assume the original TCB layout rather than reading the debug
+ * information.  usTaskNameLength is 0 if the TCB holds a pointer to the name
+ * rather than the name itself, and both it and usTaskNameOffset are 0 if names
+ * are not stored.  usVersion is incremented if the structure ever changes. */
+    typedef struct tskTaskControlBlockLayout
+    {
+        uint16_t usVersion;
+        uint16_t usTCBSize;
+        uint16_t usTopOfStackOffset;
+        uint16_t usStateListItemOffset;
+        uint16_t usEventListItemOffset;
+        uint16_t usPriorityOffset;
+        uint16_t usStackOffset;
+        uint16_t usTaskNameOffset;
+        uint16_t usTaskNameLength;
+    } TaskControlBlockLayout_t;
+
+    const volatile TaskControlBlockLayout_t xTaskControlBlockLayout =
+    {
+        1U,
+        ( uint16_t ) sizeof( TCB_t ),
+        ( uint16_t ) offsetof( TCB_t, pxTopOfStack ),
+        ( uint16_t ) offsetof( TCB_t, xStateListItem ),
+        ( uint16_t ) offsetof( TCB_t, xEventListItem ),
+        ( uint16_t ) offsetof( TCB_t, uxPriority ),
+        ( uint16_t ) offsetof( TCB_t, pxStack ),
+        #if ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_COPY )
+            ( uint16_t ) offsetof( TCB_t, pcTaskName ),
+            ( uint16_t ) configMAX_TASK_NAME_LEN
+        #elif ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_REFERENCE )
+            ( uint16_t ) offsetof( TCB_t, pcTaskName ),
+            0U
+        #else
+            0U,
+            0U
+        #endif
+    };
+#endif /* configUSE_TCB_HOT_LAYOUT */
+
 /* Context switches are held pending while the scheduler is suspended.  Also,
  * interrupts must not manipulate the xStateListItem of a TCB, or any of the
  * lists the xStateListItem can be referenced from, if the scheduler is suspended.
@@ -391,11 +1053,120 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 /* Do not move these variables to function scope as doing so prevents the
  * code working with debuggers that need to remove the static qualifier. */
-    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;    /*< Holds the value of a timer/counter the last time a task was switched in. */
+    #if ( configNUMBER_OF_CORES == 1 )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL; /*< Holds the value of a timer/counter the last time a task was switched in. */
+    #else
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ] = { 0UL }; /*< Holds the value of a timer/counter the last time a task was switched in on each core. */
+    #endif
+    #if ( configUSE_CORE_RUN_TIME_STATS == 1 )
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulCoreIdleRunTime[ configNUMBER_OF_CORES ] = { 0UL }; /*< The time each core has spent running an idle task. */
+    #endif
     PRIVILEGED_DATA static volatile configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL; /*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+
+    PRIVILEGED_DATA static uint32_t ulRunTimeWindowPeriod = 0UL;                                   /*< The number of windowed run time periods completed since the scheduler started. */
+    PRIVILEGED_DATA static TickType_t xRunTimeWindowPeriodTicks = ( TickType_t ) 0U;               /*< The ticks counted in the period in progress. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulRunTimeWindowStart[ tskRUN_TIME_WINDOWS ];    /*< The run time counter value when each window in progress started. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulRunTimeWindowDuration[ tskRUN_TIME_WINDOWS ]; /*< The run time counter ticks in the most recently completed instance of each window. */
+
+    static const uint32_t ulRunTimeWindowPeriods[ tskRUN_TIME_WINDOWS ] =
+    {
+        ( uint32_t ) configRUN_TIME_WINDOW_SHORT_PERIODS,
+        ( uint32_t ) configRUN_TIME_WINDOW_MEDIUM_PERIODS,
+        ( uint32_t ) configRUN_TIME_WINDOW_LONG_PERIODS
+    };
+
+#endif
+
+#if ( configUSE_SCHEDULER_EVENT_HOOKS == 1 )
+
+/* Set when a task other than an idle task is switched out, and cleared by
+ * the idle task when it calls vApplicationIdleEntryHook(). */
+    #if ( configNUMBER_OF_CORES == 1 )
+        PRIVILEGED_DATA static volatile BaseType_t xIdleEntryPending = pdFALSE;
+    #else
+        PRIVILEGED_DATA static volatile BaseType_t xIdleEntryPending[ configNUMBER_OF_CORES ] = { pdFALSE };
+    #endif
+
+#endif
+
+#if ( configUSE_DVFS_GOVERNOR == 1 )
+
+    PRIVILEGED_DATA static TickType_t xDvfsPeriodTicks = ( TickType_t ) 0U;                      /*< The ticks counted in the governor period in progress. */
+    PRIVILEGED_DATA static UBaseType_t uxDvfsLevel = ( UBaseType_t ) ( configDVFS_LEVELS - 1 ); /*< The current performance level.  The CPU is assumed to start at full speed. */
+    PRIVILEGED_DATA static UBaseType_t uxDvfsLoad = ( UBaseType_t ) 0U;                          /*< The CPU load, as a percentage, over the last completed governor period. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulDvfsPeriodStart = 0UL;                  /*< The run time counter value when the governor period in progress started. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulDvfsIdleStart = 0UL;                    /*< The idle run time when the governor period in progress started. */
+
+    #ifdef configDVFS_SCALED_RUN_TIME_COUNTER
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulDvfsScaledBase = 0UL;    /*< The scaled counter value when the conversion was last rebased. */
+        PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulDvfsConvertedBase = 0UL; /*< The converted counter value at the same moment. */
+    #endif
+
+#endif
+
+#if ( configUSE_TASK_ITERATOR == 1 )
+
+/* Every task that has been created and not yet deleted, in the order in which
+ * the tasks were created, and so in increasing order of uxTCBNumber. */
+    PRIVILEGED_DATA static TCB_t * pxTaskRegistryHead = NULL;
+    PRIVILEGED_DATA static TCB_t * pxTaskRegistryTail = NULL;
+
+#endif
+
+#if ( configTASK_NAME_HASH_BUCKETS > 0 )
+
+/* Every task that has been created and not yet deleted, chained through
+ * pxNameHashNext from the bucket selected by the hash of its name. */
+    PRIVILEGED_DATA static TCB_t * pxTaskNameHashTable[ configTASK_NAME_HASH_BUCKETS ];
+
+#endif
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+    PRIVILEGED_DATA static UBaseType_t uxProfiledCriticalNesting[ configNUMBER_OF_CORES ];                     /*< The critical section nesting depth on each core, counted separately from the port's count so it works with every port. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulCriticalSectionEntryTime[ configNUMBER_OF_CORES ];     /*< The run time counter value when the outermost critical section on each core was entered. */
+    PRIVILEGED_DATA static void * pvCriticalSectionEntryCaller[ configNUMBER_OF_CORES ];                       /*< Where the outermost critical section on each core was entered. */
+    PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulSchedulerSuspendTime = 0U;                            /*< The run time counter value when the scheduler was suspended. */
+    PRIVILEGED_DATA static void * pvSchedulerSuspendCaller = NULL;                                             /*< Where the scheduler was suspended. */
+    PRIVILEGED_DATA static CriticalSectionStats_t xCriticalSectionStats;
+    PRIVILEGED_DATA static CriticalSectionStats_t xSchedulerSuspendStats;
+
+#endif
+
+#if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+
+    PRIVILEGED_DATA static const SleepState_t * pxSleepStates = NULL;                      /*< The states registered by vTaskSetSleepStates(), shallowest first. */
+    PRIVILEGED_DATA static UBaseType_t uxNumberOfSleepStates = ( UBaseType_t ) 0U;
+    PRIVILEGED_DATA static const SleepState_t * pxSelectedSleepState = NULL;               /*< The state to enter during the sleep in progress, or NULL to use the port's default sleep. */
+    PRIVILEGED_DATA static BaseType_t xSleepEntered = pdFALSE;                             /*< Set when the port actually slept, rather than aborting the sleep. */
+    PRIVILEGED_DATA static TickType_t xSleepRequestedTime = ( TickType_t ) 0U;             /*< The sleep time the port programmed its timer for. */
+    PRIVILEGED_DATA static uint32_t ulSleepPredictionAccuracy = tskSLEEP_ACCURACY_ONE;     /*< The average ratio of the time slept to xSleepRequestedTime. */
+
+#endif
+
+#if ( configUSE_IDLE_WORK == 1 )
+
+    PRIVILEGED_DATA static List_t xIdleWorkList;                                           /*< Items queued by xTaskQueueIdleWork(), highest priority first.  Initialised by the first call to xTaskQueueIdleWork(). */
+    PRIVILEGED_DATA static IdleWork_t * volatile pxRunningIdleWork = NULL;                 /*< The item whose function the idle task is running, which is not in xIdleWorkList while it runs. */
+    PRIVILEGED_DATA static volatile BaseType_t xRunningIdleWorkCancelled = pdFALSE;        /*< Set if pxRunningIdleWork is cancelled while it runs. */
+
+#endif
+
+#if ( configUSE_TICK_COUNT_64 == 1 )
+
+/* Two copies of the 64-bit tick count.  The writer only ever updates the copy
+ * that uxTickCount64Sequence tells readers not to use, so a reader that
+ * interrupts the writer always finds a complete value, and a reader that is
+ * interrupted by the writer sees the sequence change and reads again. */
+    PRIVILEGED_DATA static volatile UBaseType_t uxTickCount64Sequence = ( UBaseType_t ) 0U; /*< Readers use ullTickCount64[ uxTickCount64Sequence & 1 ]. */
+    PRIVILEGED_DATA static volatile uint64_t ullTickCount64[ 2 ] = { ( uint64_t ) configINITIAL_TICK_COUNT, ( uint64_t ) configINITIAL_TICK_COUNT };
+
+#endif
+
 /*lint -restore */
 
 /*-----------------------------------------------------------*/
@@ -413,6 +1184,18 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended = ( UBaseType_t
 
 #endif /* INCLUDE_vTaskSuspend */
 
+/*
+ * Returns pdTRUE if eTaskGetState() would report the task as suspended.  Unlike
+ * prvTaskIsTaskSuspended() this returns pdFALSE for a task that is blocked
+ * indefinitely on a notification, so uxSuspendedTaskCount agrees with
+ * eTaskGetState().  Must be called from a critical section.
+ */
+#if ( ( configUSE_TASK_STATE_COUNTS == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+
+    static BaseType_t prvTaskIsInSuspendedState( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Utility to ready all the lists used by the scheduler.  This is called
  * automatically upon the creation of the first task.
@@ -432,6 +1215,33 @@ static void prvInitialiseTaskLists( void ) PRIVILEGED_FUNCTION;
  */
 static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * The passive idle tasks run on the cores other than the first when
+ * configNUMBER_OF_CORES is greater than 1.  Unlike prvIdleTask() they do not
+ * free the memory of deleted tasks or call the idle hook, so those actions are
+ * still performed by a single task.
+ */
+    static portTASK_FUNCTION_PROTO( prvPassiveIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Create the idle task(s), one per core.  Returns pdPASS if all the idle
+ * tasks were created, otherwise pdFAIL.
+ */
+static BaseType_t prvCreateIdleTasks( void ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_TASK_REAPER == 1 )
+
+/*
+ * The reaper task frees the memory of tasks that deleted themselves.  It is
+ * notified by vTaskDelete() each time a task is placed on the termination
+ * list, so the memory is reclaimed even if the idle task does not run.
+ */
+    static portTASK_FUNCTION_PROTO( prvReaperTask, pvParameters ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * Utility to free all memory allocated by the scheduler to hold a TCB,
  * including the stack pointed to by the TCB.
@@ -446,28 +1256,156 @@ static portTASK_FUNCTION_PROTO( prvIdleTask, pvParameters ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
- * Used only by the idle task.  This checks to see if anything has been placed
- * in the list of tasks waiting to be deleted.  If so the task is cleaned up
- * and its TCB deleted.
+ * Frees the TCB of a deleted task.  If configUSE_TASK_HEAP_ACCOUNTING is 1 and
+ * the task still holds heap memory then freeing the TCB is deferred until the
+ * last block charged to the task is freed, as the heap stores the TCB address
+ * in the header of each of those blocks.
  */
-static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
+#if ( ( INCLUDE_vTaskDelete == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
-/*
- * The currently executing task is entering the Blocked state.  Add the task to
- * either the current or the overflow delayed task list.
- */
-static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
-                                            const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION;
+    static void prvFreeTCB( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
 
 /*
- * Fills an TaskStatus_t structure with information on each task that is
- * referenced from the pxList list (which may be a ready list, a delayed list,
- * a suspended list, etc.).
- *
- * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
- * NORMAL APPLICATION CODE.
+ * Called as a task is switched in.  If an interrupt unblocked the task then
+ * the time since then, ulNow minus the time recorded by taskRECORD_ISR_WAKE(),
+ * is added to the task's latency statistics.
  */
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+
+    static void prvMeasureISRWakeLatency( TCB_t * pxTCB,
+                                          configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Called by xTaskDelayUntil() once the calling task runs again.  Adds how late
+ * the task started relative to xReleaseTime to its periodic statistics, counts
+ * an overrun if xWasDelayed is pdFALSE, and returns the lateness.
+ */
+#if ( configUSE_PERIODIC_TASK_STATS == 1 )
+
+    static TickType_t prvRecordPeriodicRelease( TickType_t xReleaseTime,
+                                                BaseType_t xWasDelayed ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Functions used when configUSE_WINDOWED_RUN_TIME_STATS is 1.
+ * prvUpdateRunTimeWindows() brings the window accumulators of pxTCB up to date
+ * with the current period, completing any windows that ended since the task
+ * last ran.  prvAddWindowedRunTime() adds ulRunTime to each window in
+ * progress.  prvCompleteRunTimeWindowPeriod() is called from the tick
+ * interrupt at the end of each period.  It charges the running tasks for the
+ * time they have run so far, then records the duration of each window that
+ * ended with the period.
+ */
+/*
+ * Add a task to, and remove a task from, the list of tasks walked by
+ * xTaskIteratorNext().  Must be called from a critical section.
+ */
+#if ( configUSE_TASK_ITERATOR == 1 )
+
+    static void prvRegisterTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static void prvUnregisterTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Return the bucket of the task name index that holds tasks called pcName.
+ */
+#if ( configTASK_NAME_HASH_BUCKETS > 0 )
+
+    static UBaseType_t prvTaskNameHash( const char * pcName ) PRIVILEGED_FUNCTION; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+#endif
+
+/*
+ * Add a task to, and remove a task from, the task name index searched by
+ * xTaskGetHandle().  Must be called from a critical section.
+ */
+#if ( configTASK_NAME_HASH_BUCKETS > 0 )
+
+    static void prvAddTaskToNameIndex( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static void prvRemoveTaskFromNameIndex( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+/*
+ * Adds the time elapsed since ulStartTime to pxStats, recording pvCaller if it
+ * is the longest duration seen.  Must be called with interrupts masked.
+ */
+    static void prvRecordCriticalDuration( CriticalSectionStats_t * pxStats,
+                                           configRUN_TIME_COUNTER_TYPE ulStartTime,
+                                           void * pvCaller ) PRIVILEGED_FUNCTION;
+
+/*
+ * Reads the run time counter used to time critical sections.
+ */
+    static configRUN_TIME_COUNTER_TYPE prvGetCriticalSectionTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+
+    static void prvUpdateRunTimeWindows( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+    static void prvAddWindowedRunTime( TCB_t * pxTCB,
+                                       configRUN_TIME_COUNTER_TYPE ulRunTime ) PRIVILEGED_FUNCTION;
+
+    static void prvCompleteRunTimeWindowPeriod( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Functions used when configUSE_DVFS_GOVERNOR is 1.  prvGetDvfsIdleRunTime()
+ * returns the run time of the idle tasks up to ulNow, including the time since
+ * a running idle task was switched in.  prvDvfsGovernor() is called from the
+ * tick interrupt at the end of each governor period to measure the load over
+ * the period and change the performance level.  prvDvfsConvertRunTime()
+ * converts a reading of configDVFS_SCALED_RUN_TIME_COUNTER() to counts of the
+ * highest level's clock.  Must be called with interrupts masked.
+ */
+#if ( configUSE_DVFS_GOVERNOR == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvGetDvfsIdleRunTime( configRUN_TIME_COUNTER_TYPE ulNow ) PRIVILEGED_FUNCTION;
+
+    static void prvDvfsGovernor( void ) PRIVILEGED_FUNCTION;
+
+    #ifdef configDVFS_SCALED_RUN_TIME_COUNTER
+        static configRUN_TIME_COUNTER_TYPE prvDvfsConvertRunTime( configRUN_TIME_COUNTER_TYPE ulScaledCount ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif
+
+/*
+ * Used only by the idle task.  This checks to see if anything has been placed
+ * in the list of tasks waiting to be deleted.  If so the task is cleaned up
+ * and its TCB deleted.
+ */
+static void prvCheckTasksWaitingTermination( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * The currently executing task is entering the Blocked state.  Add the task to
+ * either the current or the overflow delayed task list.
+ */
+static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
+                                            const BaseType_t xCanBlockIndefinitely ) PRIVILEGED_FUNCTION FREERTOS_FAST_FUNCTION;
+
+/*
+ * Fills an TaskStatus_t structure with information on each task that is
+ * referenced from the pxList list (which may be a ready list, a delayed list,
+ * a suspended list, etc.).
+ *
+ * THIS FUNCTION IS INTENDED FOR DEBUGGING ONLY, AND SHOULD NOT BE CALLED FROM
+ * NORMAL APPLICATION CODE.
+ */
+#if ( configUSE_TRACE_FACILITY == 1 )
 
     static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
                                                      List_t * pxList,
@@ -475,11 +1413,24 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Calls pxFunction for each task referenced from pxList, without writing to
+ * the list.  Used by vTaskWalkTasks().
+ */
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    static void prvWalkTasksWithinSingleList( const List_t * pxList,
+                                              eTaskState eState,
+                                              TaskWalkFunction_t pxFunction,
+                                              void * pvContext ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Searches pxList for a task with name pcNameToQuery - returning a handle to
  * the task if it is found, or NULL if the task is not found.
  */
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( ( INCLUDE_xTaskGetHandle == 1 ) && ( configTASK_NAME_HASH_BUCKETS == 0 ) )
 
     static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
                                                      const char pcNameToQuery[] ) PRIVILEGED_FUNCTION;
@@ -493,7 +1444,16 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
  */
 #if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 0 )
+        static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Returns the high water mark of the stack of the task pxTCB, in words.  Scans
+ * the whole unused part of the stack, or only beyond the deepest point already
+ * known if configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK is 1.
+ */
+    static configSTACK_DEPTH_TYPE prvTaskGetFreeStackSpace( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
@@ -512,12 +1472,239 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
 #endif
 
+/*
+ * Tickless idle with more than one core.  prvAllCoresAreIdle() returns pdTRUE
+ * if every core is running its idle task and is not about to select another
+ * task.  prvIdleCoreSleep() is called by the idle tasks.  It suppresses the tick
+ * if every other core is already halted, and otherwise halts the calling core
+ * until it is interrupted.
+ */
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configNUMBER_OF_CORES > 1 ) )
+
+    static BaseType_t prvAllCoresAreIdle( void ) PRIVILEGED_FUNCTION;
+    static void prvIdleCoreSleep( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Select the deepest registered sleep state that fits the predicted idle time
+ * and shorten *pxExpectedIdleTime by its exit latency, then fold the time
+ * actually slept into the prediction accuracy once the sleep has ended.
+ */
+#if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+
+    static void prvSelectSleepState( TickType_t * pxExpectedIdleTime ) PRIVILEGED_FUNCTION;
+    static void prvUpdateSleepPrediction( TickType_t xTimeSlept ) PRIVILEGED_FUNCTION;
+
+#endif
+
+/*
+ * Run slices of the queued idle work, highest priority first, until the work
+ * runs out or configIDLE_WORK_BUDGET_TICKS ticks have passed.
+ */
+#if ( configUSE_IDLE_WORK == 1 )
+
+    static void prvRunIdleWork( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
  * will exit the Blocked state.
  */
 static void prvResetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * Remove the wait records of a task blocked in xQueueWaitForAny() from the
+ * event lists they are in.  If one is in pxSignalledList it is noted as the
+ * record through which the wait ended.  Returns pdTRUE if the task had wait
+ * records, otherwise pdFALSE.  Must be called from a critical section.
+ */
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+    static BaseType_t prvRemoveWaitRecords( TCB_t * const pxTCB,
+                                            const List_t * const pxSignalledList ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Advance the 64-bit tick count by xTicks.  Called wherever xTickCount is
+ * advanced, from the same context and with the same protection.
+ */
+#if ( configUSE_TICK_COUNT_64 == 1 )
+    static void prvAdvanceTickCount64( TickType_t xTicks ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Stop the port deferring the tick and add the ticks that have passed since
+ * the last tick interrupt to the tick count.
+ */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    static void prvStopDynamicTick( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Returns the number of ticks from the current tick count to the next tick on
+ * which a task is unblocked, or 1 if that is the next tick or has passed.
+ */
+#if ( configUSE_DYNAMIC_TICK == 1 )
+    static TickType_t prvGetDynamicTickLimit( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Move the task at the head of xPendingReadyList to its ready list, noting
+ * whether a yield is needed.  Must be called from a critical section.  Returns
+ * the task moved.
+ */
+static TCB_t * prvMovePendingReadyTask( void ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by xTaskResumeAll() before it resumes the scheduler.  Moves tasks from
+ * xPendingReadyList to the ready lists configPENDING_READY_BATCH_SIZE at a
+ * time, leaving the critical section between batches, until no more than one
+ * batch remains.  Returns the last task moved, or NULL if none were moved.
+ */
+#if ( configPENDING_READY_BATCH_SIZE > 0 )
+    static TCB_t * prvMovePendingReadyTasksInBatches( void ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Called from xTaskIncrementTick() to move a task whose timeout has expired
+ * from the delayed list (or delayed task wheel) it is in to the ready list.
+ * Returns pdTRUE if the unblocked task should preempt the calling core's task.
+ */
+static BaseType_t prvUnblockDelayedTask( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+/*
+ * Returns pdTRUE if pxTCB must run before pxOtherTCB within the deadline band.
+ * A task without a deadline, which can only be in the band because it has
+ * inherited its priority, runs before any task with a deadline.
+ */
+    static BaseType_t prvDeadlineIsEarlier( const TCB_t * pxTCB,
+                                            const TCB_t * pxOtherTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Inserts pxTCB into the ready list of the deadline band after all the tasks
+ * that must run before it.
+ */
+    static void prvAddTaskToDeadlineOrderedList( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( configNUMBER_OF_CORES == 1 ) && ( taskCOUNT_TIME_SLICE_TICKS == 1 ) )
+
+/*
+ * Selects the next task to run from pxReadyList, which holds the highest
+ * priority ready tasks.  A task that was preempted by a higher priority task
+ * part way through its time slice is selected again to complete it, otherwise
+ * the list is indexed through as normal.
+ */
+    static void prvSelectTimeSlicedTask( List_t * const pxReadyList ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TIME_PARTITIONS == 1 )
+
+/*
+ * Makes uxPartition the active partition.  Ready tasks that can no longer run
+ * are parked, and parked tasks that can now run are moved to their ready
+ * lists.  Returns pdTRUE if the running task was parked, or a task of higher
+ * priority than the running task was made ready, so a context switch is
+ * required.  Takes time proportional to the number of ready tasks, so should
+ * only be called when the partition changes.
+ */
+    static BaseType_t prvActivatePartition( UBaseType_t uxPartition ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+/*
+ * Called from xTaskIncrementTick() to charge the tick that has just ended to
+ * the budget of pxTCB, which was running during it.  If that exhausts the
+ * budget the task is moved to the delayed list until the start of its next
+ * budget period, and pdTRUE is returned.  If configUSE_MIXED_CRITICALITY is 1
+ * a high criticality task that exhausts its budget switches the kernel to high
+ * criticality mode instead, and pdTRUE is returned if that requires a context
+ * switch.
+ */
+    static BaseType_t prvChargeTaskBudget( TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+/*
+ * Switches the kernel to uxMode.  Switching to high criticality mode moves the
+ * ready low criticality tasks to the shed task list, and switching back moves
+ * them to their ready lists again and lets the timer service task call the
+ * deferred timer callbacks.  Returns pdTRUE if a context switch is required.
+ * Must be called from a critical section or the tick interrupt.
+ */
+    static BaseType_t prvSetCriticalityMode( UBaseType_t uxMode ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( INCLUDE_vTaskDelay == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+
+/*
+ * Returns the number of ticks, between xTicksToDelay and xTicksToDelay plus
+ * xSlackInTicks, after which the calling task should be woken so it wakes on
+ * the same tick as a task that is already in the Blocked state, or
+ * xTicksToDelay if no task wakes within that window.  Must be called with the
+ * scheduler suspended.
+ */
+    static TickType_t prvGetCoalescedDelay( const TickType_t xTicksToDelay,
+                                            const TickType_t xSlackInTicks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Returns the number of ticks until the first task in pxList that wakes at
+ * least xTicksToDelay ticks from now wakes, or 0 if there is no such task.
+ */
+    static TickType_t prvGetTicksToFirstWakeAfter( const List_t * const pxList,
+                                                   const TickType_t xTicksToDelay ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+/*
+ * Returns the tick count at which the next task in the delayed task wheel or
+ * the delayed lists will be unblocked.  Those in the wheel are not included in
+ * xNextTaskUnblockTime.
+ */
+    static TickType_t prvGetNextTaskUnblockTime( void ) PRIVILEGED_FUNCTION;
+
+#endif
+
+#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+
+/*
+ * Sets the priority of a task that holds a mutex while it inherits, or
+ * disinherits, a priority, moving the task to the matching ready list if it is
+ * in the Ready state.
+ */
+    static void prvSetInheritedPriority( TCB_t * const pxTCB,
+                                         const UBaseType_t uxNewPriority ) PRIVILEGED_FUNCTION;
+
+/*
+ * If pxTCB is blocked on a mutex then re-sorts its event list item within the
+ * mutex's list of waiting tasks, as its priority has changed, and returns the
+ * holder of that mutex.  Otherwise returns NULL.
+ */
+    static TCB_t * prvGetBlockingMutexHolder( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called after the priority of pxTCB has been raised by priority inheritance,
+ * or lowered because a task waiting for a mutex held by pxTCB timed out, to
+ * pass the change on to the holders of the chain of mutexes pxTCB is blocked
+ * on, up to configPRIORITY_INHERITANCE_DEPTH holders in total.
+ */
+    static void prvPropagateInheritedPriority( TCB_t * pxTCB,
+                                               const BaseType_t xRaised ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
 /*
@@ -548,6 +1735,60 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
+/*
+ * Create a task without adding it to the ready list, so the create functions
+ * can finish setting up the TCB (for example its core affinity) before the
+ * scheduler can select it.  The handle of the created task is returned in
+ * pxCreatedTask if it is not NULL.  NULL is returned if the task could not be
+ * created.
+ */
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const uint32_t ulStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        StackType_t * const puxStackBuffer,
+                                        StaticTask_t * const pxTaskBuffer,
+                                        TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+    static TCB_t * prvCreateTask( TaskFunction_t pxTaskCode,
+                                  const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                  const configSTACK_DEPTH_TYPE usStackDepth,
+                                  void * const pvParameters,
+                                  UBaseType_t uxPriority,
+                                  TaskHandle_t * const pxCreatedTask ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Update the notification value and state at index uxIndexToNotify of pxTCB
+ * as specified by eAction.  The state before the update is returned in
+ * pucOriginalNotifyState.  Returns pdFAIL if eAction is
+ * eSetValueWithoutOverwrite and a notification was already pending, otherwise
+ * pdPASS.  Must be called from within a critical section.
+ */
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+    static BaseType_t prvTaskNotifyUpdate( TCB_t * pxTCB,
+                                           UBaseType_t uxIndexToNotify,
+                                           uint32_t ulValue,
+                                           eNotifyAction eAction,
+                                           uint8_t * pucOriginalNotifyState ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * A task blocked in xTaskNotifyWaitAny() is waiting at several indexes.  Once
+ * it has been unblocked by a notification at uxIndexNotified, return its other
+ * waiting indexes to taskNOT_WAITING_NOTIFICATION so a notification at one of
+ * them does not try to unblock it a second time.  Must be called from within a
+ * critical section.
+ */
+#if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 ) )
+    static void prvTaskNotifyCancelOtherWaits( TCB_t * pxTCB,
+                                               UBaseType_t uxIndexNotified ) PRIVILEGED_FUNCTION;
+#endif
+
 /*
  * freertos_tasks_c_additions_init() should only be called if the user definable
  * macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is the only macro
@@ -559,343 +1800,565 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * Select the highest priority ready task that is not already running on
+ * another core to run on the core xCoreID.
+ */
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called when the task referenced by pxTCB has been made ready, or had its
+ * priority raised, to request a yield on the core running the lowest priority
+ * task, if that task has a lower priority than pxTCB.  Must be called from a
+ * critical section.
+ */
+    #if ( configUSE_PREEMPTION == 1 )
+        static void prvYieldForTask( const TCB_t * pxTCB ) PRIVILEGED_FUNCTION;
+    #endif
+
+/*
+ * Without preemption a task made ready is not pushed to an idle core, so the
+ * idle tasks pull work instead.  Returns pdTRUE if at least one ready task that
+ * is not an idle task is not running either.  The ready lists
+ * are read without taking the scheduler locks so an idle core only contends
+ * for them when there is a task it can steal.  An occasional incorrect result
+ * does not matter as the idle task checks again on its next iteration.
+ */
+    #if ( configUSE_PREEMPTION == 0 )
+        static BaseType_t prvReadyTaskIsWaiting( void ) PRIVILEGED_FUNCTION;
+    #endif
+
+#endif /* if ( configNUMBER_OF_CORES > 1 ) */
+
 /*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+#if ( configNUMBER_OF_CORES > 1 )
 
-    TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
-                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                    const uint32_t ulStackDepth,
-                                    void * const pvParameters,
-                                    UBaseType_t uxPriority,
-                                    StackType_t * const puxStackBuffer,
-                                    StaticTask_t * const pxTaskBuffer )
-    {
-        TCB_t * pxNewTCB;
-        TaskHandle_t xReturn;
+    #if ( configUSE_WAKE_AFFINITY == 1 )
+        #define taskRECORD_CROSS_CORE_YIELD()    ( ulCrossCoreYields++ )
+    #else
+        #define taskRECORD_CROSS_CORE_YIELD()
+    #endif
 
-        configASSERT( puxStackBuffer != NULL );
-        configASSERT( pxTaskBuffer != NULL );
+/* Record that pxTCB is starting to run on core xCoreID, and add ulRunTime to
+ * the idle time of core xCoreID if it is the idle task running there that the
+ * time is being charged to. */
+    #if ( configUSE_CORE_RUN_TIME_STATS == 1 )
+        #define taskRECORD_CORE_RUN_ON( pxTCB, xCoreID )                                            \
+        {                                                                                           \
+            if( ( ( pxTCB )->uxCoresRunOn != 0U ) &&                                                \
+                ( ( pxTCB )->uxLastCoreRunOn != ( UBaseType_t ) ( xCoreID ) ) )                     \
+            {                                                                                       \
+                ( pxTCB )->uxMigrations++;                                                          \
+            }                                                                                       \
+            ( pxTCB )->uxCoresRunOn |= ( ( UBaseType_t ) 1U << ( UBaseType_t ) ( xCoreID ) );       \
+            ( pxTCB )->uxLastCoreRunOn = ( UBaseType_t ) ( xCoreID );                               \
+        }
+
+        #define taskRECORD_CORE_IDLE_TIME( xCoreID, ulRunTime )                                     \
+        {                                                                                           \
+            if( ( pxCurrentTCBs[ ( xCoreID ) ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )  \
+            {                                                                                       \
+                ulCoreIdleRunTime[ ( xCoreID ) ] += ( ulRunTime );                                  \
+            }                                                                                       \
+        }
+    #else /* if ( configUSE_CORE_RUN_TIME_STATS == 1 ) */
+        #define taskRECORD_CORE_RUN_ON( pxTCB, xCoreID )
+        #define taskRECORD_CORE_IDLE_TIME( xCoreID, ulRunTime )
+    #endif /* if ( configUSE_CORE_RUN_TIME_STATS == 1 ) */
+
+/* Request the core xCoreID to select a new task to run.  If xCoreID is the
+ * calling core then the yield is held pending until the calling core leaves
+ * the critical section, otherwise the port is asked to interrupt the other core
+ * (unless it has already been asked to do so).  Must be called from a critical
+ * section. */
+    #define prvYieldCore( xCoreID )                                                              \
+    {                                                                                            \
+        if( ( xCoreID ) == ( BaseType_t ) portGET_CORE_ID() )                                    \
+        {                                                                                        \
+            xYieldPendings[ ( xCoreID ) ] = pdTRUE;                                              \
+        }                                                                                        \
+        else if( pxCurrentTCBs[ ( xCoreID ) ]->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD )    \
+        {                                                                                        \
+            portYIELD_CORE( xCoreID );                                                           \
+            taskRECORD_CROSS_CORE_YIELD();                                                       \
+            pxCurrentTCBs[ ( xCoreID ) ]->xTaskRunState = taskTASK_SCHEDULED_TO_YIELD;           \
+        }                                                                                        \
+        else                                                                                     \
+        {                                                                                        \
+            mtCOVERAGE_TEST_MARKER();                                                            \
+        }                                                                                        \
+    }
 
-        #if ( configASSERT_DEFINED == 1 )
-        {
-            /* Sanity check that the size of the structure used to declare a
-             * variable of type StaticTask_t equals the size of the real task
-             * structure. */
-            volatile size_t xSize = sizeof( StaticTask_t );
-            configASSERT( xSize == sizeof( TCB_t ) );
-            ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
-        }
-        #endif /* configASSERT_DEFINED */
+/*-----------------------------------------------------------*/
 
-        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+    #if ( configUSE_PREEMPTION == 1 )
+
+        static void prvYieldForTask( const TCB_t * pxTCB )
         {
-            /* The memory used for the task's TCB and stack are passed into this
-             * function - use them. */
-            pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
-            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
-
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
-            {
-                /* Tasks can be created statically or dynamically, so note this
-                 * task was created statically in case the task is later deleted. */
-                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
-            }
-            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-
-            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, &xReturn, pxNewTCB, NULL );
-            prvAddNewTaskToReadyList( pxNewTCB );
-        }
-        else
-        {
-            xReturn = NULL;
-        }
+            BaseType_t xLowestPriorityToPreempt;
+            BaseType_t xCurrentCoreTaskPriority;
+            BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+            BaseType_t xCoreID;
 
-        return xReturn;
-    }
-
-#endif /* SUPPORT_STATIC_ALLOCATION */
-/*-----------------------------------------------------------*/
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
 
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+            /* A yield is not required for a task that is already running. */
+            if( taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) == pdFALSE )
+            {
+                /* Only a core running a task with a priority strictly lower than
+                 * that of pxTCB is preempted.  xLowestPriorityToPreempt becomes -1
+                 * if pxTCB has the idle priority, which is fine as the idle tasks
+                 * are treated as having a priority of -1 below. */
+                xLowestPriorityToPreempt = ( BaseType_t ) pxTCB->uxPriority;
+                --xLowestPriorityToPreempt;
+
+                for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    xCurrentCoreTaskPriority = ( BaseType_t ) pxCurrentTCBs[ xCoreID ]->uxPriority;
 
-    BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition,
-                                            TaskHandle_t * pxCreatedTask )
-    {
-        TCB_t * pxNewTCB;
-        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+                    /* The idle tasks are preempted in preference to application
+                     * tasks that also run at the idle priority. */
+                    if( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                    {
+                        xCurrentCoreTaskPriority = xCurrentCoreTaskPriority - 1;
+                    }
 
-        configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
-        configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+                    /* Skip cores pxTCB is not allowed to run on, and cores
+                     * that are already going to select a new task. */
+                    if( ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) &&
+                        ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) &&
+                        ( xYieldPendings[ xCoreID ] == pdFALSE ) )
+                    {
+                        #if ( configUSE_WAKE_AFFINITY == 1 )
+                        {
+                            /* On a tie keep the calling core once it has been
+                             * chosen, as yielding it needs no interrupt. */
+                            if( ( xCurrentCoreTaskPriority < xLowestPriorityToPreempt ) ||
+                                ( ( xCurrentCoreTaskPriority == xLowestPriorityToPreempt ) &&
+                                  ( xLowestPriorityCore != ( BaseType_t ) portGET_CORE_ID() ) ) )
+                            {
+                                xLowestPriorityToPreempt = xCurrentCoreTaskPriority;
+                                xLowestPriorityCore = xCoreID;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #else /* if ( configUSE_WAKE_AFFINITY == 1 ) */
+                        if( xCurrentCoreTaskPriority <= xLowestPriorityToPreempt )
+                        {
+                            xLowestPriorityToPreempt = xCurrentCoreTaskPriority;
+                            xLowestPriorityCore = xCoreID;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        #endif /* if ( configUSE_WAKE_AFFINITY == 1 ) */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
 
-        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
-        {
-            /* Allocate space for the TCB.  Where the memory comes from depends
-             * on the implementation of the port malloc function and whether or
-             * not static allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
-            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+                #if ( configUSE_EDF_SCHEDULING == 1 )
+                {
+                    /* When no core runs a lower priority task, a task in the
+                     * deadline band preempts the task in the band with the
+                     * latest deadline, provided its own deadline is earlier. */
+                    if( ( xLowestPriorityCore < ( BaseType_t ) 0 ) && ( pxTCB->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) )
+                    {
+                        const TCB_t * pxLatestDeadlineTCB = pxTCB;
 
-            /* Store the stack location in the TCB. */
-            pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+                        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                        {
+                            if( ( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) != pdFALSE ) &&
+                                ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) &&
+                                ( xYieldPendings[ xCoreID ] == pdFALSE ) &&
+                                ( pxCurrentTCBs[ xCoreID ]->uxPriority == ( UBaseType_t ) configEDF_PRIORITY ) &&
+                                ( prvDeadlineIsEarlier( pxLatestDeadlineTCB, pxCurrentTCBs[ xCoreID ] ) != pdFALSE ) )
+                            {
+                                pxLatestDeadlineTCB = pxCurrentTCBs[ xCoreID ];
+                                xLowestPriorityCore = xCoreID;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configUSE_EDF_SCHEDULING */
 
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+                if( xLowestPriorityCore >= ( BaseType_t ) 0 )
+                {
+                    prvYieldCore( xLowestPriorityCore );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
             {
-                /* Tasks can be created statically or dynamically, so note this
-                 * task was created statically in case the task is later deleted. */
-                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
-
-            prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
-                                  pxTaskDefinition->pcName,
-                                  ( uint32_t ) pxTaskDefinition->usStackDepth,
-                                  pxTaskDefinition->pvParameters,
-                                  pxTaskDefinition->uxPriority,
-                                  pxCreatedTask, pxNewTCB,
-                                  pxTaskDefinition->xRegions );
-
-            prvAddNewTaskToReadyList( pxNewTCB );
-            xReturn = pdPASS;
         }
 
-        return xReturn;
-    }
+    #endif /* configUSE_PREEMPTION */
 
-#endif /* ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
-
-    BaseType_t xTaskCreateRestricted( const TaskParameters_t * const pxTaskDefinition,
-                                      TaskHandle_t * pxCreatedTask )
+    static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
     {
-        TCB_t * pxNewTCB;
-        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+        UBaseType_t uxCurrentPriority = uxTopReadyPriority;
+        BaseType_t xTaskScheduled = pdFALSE;
+        BaseType_t xDecrementTopPriority = pdTRUE;
+        TCB_t * pxTCB;
+        const List_t * pxReadyList;
+        const ListItem_t * pxEndMarker;
+        ListItem_t * pxIterator;
 
-        configASSERT( pxTaskDefinition->puxStackBuffer );
+        #if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configUSE_PREEMPTION == 1 ) )
+            TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+        #endif
 
-        if( pxTaskDefinition->puxStackBuffer != NULL )
+        configASSERT( xSchedulerRunning != pdFALSE );
+
+        /* A task that is still ready when it yields is moved to the end of its
+         * ready list so the other tasks of the same priority, possibly
+         * including one that was only just created, are selected before it. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ),
+                                     &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) ) != pdFALSE )
         {
-            /* Allocate space for the TCB.  Where the memory comes from depends
-             * on the implementation of the port malloc function and whether or
-             * not static allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+            listFAST_REMOVE( &( pxCurrentTCBs[ xCoreID ]->xStateListItem ) );
+            prvInsertTaskIntoReadyList( pxCurrentTCBs[ xCoreID ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-            if( pxNewTCB != NULL )
+        while( xTaskScheduled == pdFALSE )
+        {
+            if( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxCurrentPriority ] ) ) == pdFALSE )
             {
-                memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+                pxReadyList = &( pxReadyTasksLists[ uxCurrentPriority ] );
+                pxEndMarker = listGET_END_MARKER( pxReadyList );
 
-                /* Store the stack location in the TCB. */
-                pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+                /* This list is not empty, so uxTopReadyPriority must not be
+                 * decremented any further. */
+                xDecrementTopPriority = pdFALSE;
 
-                #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+                for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
                 {
-                    /* Tasks can be created statically or dynamically, so note
-                     * this task had a statically allocated stack in case it is
-                     * later deleted.  The TCB was allocated dynamically. */
-                    pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
-                }
-                #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+                    pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
 
-                prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
-                                      pxTaskDefinition->pcName,
-                                      ( uint32_t ) pxTaskDefinition->usStackDepth,
-                                      pxTaskDefinition->pvParameters,
-                                      pxTaskDefinition->uxPriority,
-                                      pxCreatedTask, pxNewTCB,
-                                      pxTaskDefinition->xRegions );
+                    if( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) == pdFALSE )
+                    {
+                        /* The core affinity of the task does not allow it to
+                         * run on this core. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                    else if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                    {
+                        /* The task is not running on any core, so swap it in. */
+                        pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_NOT_RUNNING;
+                        pxTCB->xTaskRunState = xCoreID;
+                        pxCurrentTCBs[ xCoreID ] = pxTCB;
+                        taskRECORD_CORE_RUN_ON( pxTCB, xCoreID );
+                        xTaskScheduled = pdTRUE;
+                    }
+                    else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+                    {
+                        /* The task is already running on this core and is
+                         * still the best choice - it may have been asked to
+                         * yield by another core. */
+                        configASSERT( ( pxTCB->xTaskRunState == xCoreID ) || ( pxTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) );
+                        pxTCB->xTaskRunState = xCoreID;
+                        xTaskScheduled = pdTRUE;
+                    }
+                    else
+                    {
+                        /* The task is running on another core. */
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                prvAddNewTaskToReadyList( pxNewTCB );
-                xReturn = pdPASS;
+                    if( xTaskScheduled != pdFALSE )
+                    {
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                if( xDecrementTopPriority != pdFALSE )
+                {
+                    uxTopReadyPriority--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-        }
-
-        return xReturn;
-    }
-
-#endif /* portUSING_MPU_WRAPPERS */
-/*-----------------------------------------------------------*/
 
-#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+            /* There is an idle task per core, so a task is always found by the
+             * time the idle priority is reached. */
+            if( uxCurrentPriority > tskIDLE_PRIORITY )
+            {
+                uxCurrentPriority--;
+            }
+            else
+            {
+                break;
+            }
+        }
 
-    BaseType_t xTaskCreate( TaskFunction_t pxTaskCode,
-                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                            const configSTACK_DEPTH_TYPE usStackDepth,
-                            void * const pvParameters,
-                            UBaseType_t uxPriority,
-                            TaskHandle_t * const pxCreatedTask )
-    {
-        TCB_t * pxNewTCB;
-        BaseType_t xReturn;
+        configASSERT( xTaskScheduled != pdFALSE );
 
-        /* If the stack grows down then allocate the stack then the TCB so the stack
-         * does not grow into the TCB.  Likewise if the stack grows up then allocate
-         * the TCB then the stack. */
-        #if ( portSTACK_GROWTH > 0 )
+        #if ( ( configUSE_CORE_AFFINITY == 1 ) && ( configUSE_PREEMPTION == 1 ) )
         {
-            /* Allocate space for the TCB.  Where the memory comes from depends on
-             * the implementation of the port malloc function and whether or not static
-             * allocation is being used. */
-            pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
-
-            if( pxNewTCB != NULL )
+            /* A task that was switched out of this core in favour of a task
+             * that can only run here may be able to preempt a lower priority
+             * task on one of the other cores it is allowed to run on.  This is
+             * called with the scheduler locks held, but not from a critical
+             * section, so prvYieldForTask() cannot be used. */
+            if( ( pxPreviousTCB != pxCurrentTCBs[ xCoreID ] ) &&
+                ( pxPreviousTCB->xTaskRunState == taskTASK_NOT_RUNNING ) &&
+                ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxPreviousTCB->uxPriority ] ), &( pxPreviousTCB->xStateListItem ) ) != pdFALSE ) )
             {
-                memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+                BaseType_t xOtherCoreID;
+                BaseType_t xLowestPriorityCore = ( BaseType_t ) -1;
+                BaseType_t xLowestPriority = ( BaseType_t ) pxPreviousTCB->uxPriority;
+                BaseType_t xOtherCoreTaskPriority;
 
-                /* Allocate space for the stack used by the task being created.
-                 * The base of the stack memory stored in the TCB so the task can
-                 * be deleted later if required. */
-                pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                /* Only a strictly lower priority task is preempted, idle tasks
+                 * counting as one priority below the idle priority. */
+                --xLowestPriority;
 
-                if( pxNewTCB->pxStack == NULL )
+                for( xOtherCoreID = ( BaseType_t ) 0; xOtherCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xOtherCoreID++ )
                 {
-                    /* Could not allocate the stack.  Delete the allocated TCB. */
-                    vPortFree( pxNewTCB );
-                    pxNewTCB = NULL;
-                }
-            }
-        }
-        #else /* portSTACK_GROWTH */
-        {
-            StackType_t * pxStack;
+                    if( ( xOtherCoreID != xCoreID ) &&
+                        ( taskCAN_RUN_ON_CORE( pxPreviousTCB, xOtherCoreID ) != pdFALSE ) &&
+                        ( taskTASK_IS_RUNNING( pxCurrentTCBs[ xOtherCoreID ] ) != pdFALSE ) &&
+                        ( xYieldPendings[ xOtherCoreID ] == pdFALSE ) )
+                    {
+                        xOtherCoreTaskPriority = ( BaseType_t ) pxCurrentTCBs[ xOtherCoreID ]->uxPriority;
 
-            /* Allocate space for the stack used by the task being created. */
-            pxStack = pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+                        if( ( pxCurrentTCBs[ xOtherCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                        {
+                            xOtherCoreTaskPriority = xOtherCoreTaskPriority - 1;
+                        }
 
-            if( pxStack != NULL )
-            {
-                /* Allocate space for the TCB. */
-                pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+                        if( xOtherCoreTaskPriority <= xLowestPriority )
+                        {
+                            xLowestPriority = xOtherCoreTaskPriority;
+                            xLowestPriorityCore = xOtherCoreID;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
 
-                if( pxNewTCB != NULL )
+                if( xLowestPriorityCore >= ( BaseType_t ) 0 )
                 {
-                    memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
-
-                    /* Store the stack location in the TCB. */
-                    pxNewTCB->pxStack = pxStack;
+                    prvYieldCore( xLowestPriorityCore );
                 }
                 else
                 {
-                    /* The stack cannot be used as the TCB was not created.  Free
-                     * it again. */
-                    vPortFreeStack( pxStack );
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
             else
             {
-                pxNewTCB = NULL;
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* portSTACK_GROWTH */
+        #endif /* ( ( configUSE_CORE_AFFINITY == 1 ) && ( configUSE_PREEMPTION == 1 ) ) */
+    }
 
-        if( pxNewTCB != NULL )
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_PREEMPTION == 0 )
+
+        static BaseType_t prvReadyTaskIsWaiting( void )
         {
-            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
+            UBaseType_t uxPriority;
+            UBaseType_t uxReadyTasks = 0U;
+            UBaseType_t uxWaitingThreshold = ( UBaseType_t ) ( 2 * configNUMBER_OF_CORES );
+            BaseType_t xCoreID;
+            BaseType_t xReturn = pdFALSE;
+
+            /* Running tasks remain in their ready list, and the idle tasks
+             * never leave the ready lists, so the lists hold the
+             * configNUMBER_OF_CORES idle tasks plus every other ready task.
+             * Each core that is not running its idle task is running one of
+             * the other tasks, so one of those is waiting for a core once the
+             * lists hold more than ( 2 * configNUMBER_OF_CORES ) tasks, less
+             * one for each core that is running an idle task. */
+            for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
             {
-                /* Tasks can be created statically or dynamically, so note this
-                 * task was created dynamically in case it is later deleted. */
-                pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+                if( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+                {
+                    uxWaitingThreshold--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-            prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
-            prvAddNewTaskToReadyList( pxNewTCB );
-            xReturn = pdPASS;
-        }
-        else
-        {
-            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+            /* uxTopReadyPriority may be higher than the highest priority
+             * ready task, but never lower. */
+            for( uxPriority = uxTopReadyPriority; ; uxPriority-- )
+            {
+                uxReadyTasks += listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) );
+
+                if( uxReadyTasks > uxWaitingThreshold )
+                {
+                    xReturn = pdTRUE;
+                    break;
+                }
+
+                if( uxPriority == tskIDLE_PRIORITY )
+                {
+                    break;
+                }
+            }
+
+            return xReturn;
         }
 
-        return xReturn;
-    }
+    #endif /* configUSE_PREEMPTION */
+
+#endif /* if ( configNUMBER_OF_CORES > 1 ) */
 
-#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
-                                  const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-                                  const uint32_t ulStackDepth,
-                                  void * const pvParameters,
-                                  UBaseType_t uxPriority,
-                                  TaskHandle_t * const pxCreatedTask,
-                                  TCB_t * pxNewTCB,
-                                  const MemoryRegion_t * const xRegions )
-{
-    StackType_t * pxTopOfStack;
-    UBaseType_t x;
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
-    #if ( portUSING_MPU_WRAPPERS == 1 )
-        /* Should the task be created in privileged mode? */
-        BaseType_t xRunPrivileged;
+    static TCB_t * prvCreateStaticTask( TaskFunction_t pxTaskCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const uint32_t ulStackDepth,
+                                        void * const pvParameters,
+                                        UBaseType_t uxPriority,
+                                        StackType_t * const puxStackBuffer,
+                                        StaticTask_t * const pxTaskBuffer,
+                                        TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
 
-        if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
+        configASSERT( puxStackBuffer != NULL );
+        configASSERT( pxTaskBuffer != NULL );
+
+        #if ( configASSERT_DEFINED == 1 )
         {
-            xRunPrivileged = pdTRUE;
+            /* Sanity check that the size of the structure used to declare a
+             * variable of type StaticTask_t equals the size of the real task
+             * structure. */
+            volatile size_t xSize = sizeof( StaticTask_t );
+            configASSERT( xSize == sizeof( TCB_t ) );
+            ( void ) xSize; /* Prevent lint warning when configASSERT() is not used. */
+        }
+        #endif /* configASSERT_DEFINED */
+
+        if( ( pxTaskBuffer != NULL ) && ( puxStackBuffer != NULL ) )
+        {
+            /* The memory used for the task's TCB and stack are passed into this
+             * function - use them. */
+            pxNewTCB = ( TCB_t * ) pxTaskBuffer; /*lint !e740 !e9087 Unusual cast is ok as the structures are designed to have the same alignment, and the size is checked by an assert. */
+            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+            pxNewTCB->pxStack = ( StackType_t * ) puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+            {
+                /* Tasks can be created statically or dynamically, so note this
+                 * task was created statically in case the task is later deleted. */
+                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+            }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            prvInitialiseNewTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
         }
         else
         {
-            xRunPrivileged = pdFALSE;
+            pxNewTCB = NULL;
         }
-        uxPriority &= ~portPRIVILEGE_BIT;
-    #endif /* portUSING_MPU_WRAPPERS == 1 */
 
-    /* Avoid dependency on memset() if it is not required. */
-    #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
-    {
-        /* Fill the stack with a known value to assist debugging. */
-        ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
+        return pxNewTCB;
     }
-    #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
+/*-----------------------------------------------------------*/
 
-    /* Calculate the top of stack address.  This depends on whether the stack
-     * grows from high memory to low (as per the 80x86) or vice versa.
-     * portSTACK_GROWTH is used to make the result positive or negative as required
-     * by the port. */
-    #if ( portSTACK_GROWTH < 0 )
+    TaskHandle_t xTaskCreateStatic( TaskFunction_t pxTaskCode,
+                                    const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                    const uint32_t ulStackDepth,
+                                    void * const pvParameters,
+                                    UBaseType_t uxPriority,
+                                    StackType_t * const puxStackBuffer,
+                                    StaticTask_t * const pxTaskBuffer )
     {
-        pxTopOfStack = &( pxNewTCB->pxStack[ ulStackDepth - ( uint32_t ) 1 ] );
-        pxTopOfStack = ( StackType_t * ) ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) ); /*lint !e923 !e9033 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical.  Size differences accounted for using portPOINTER_SIZE_TYPE type.  Checked by assert(). */
+        TCB_t * pxNewTCB;
+        TaskHandle_t xReturn = NULL;
 
-        /* Check the alignment of the calculated top of stack is correct. */
-        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
+        pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, &xReturn );
 
-        #if ( configRECORD_STACK_HIGH_ADDRESS == 1 )
+        if( pxNewTCB != NULL )
         {
-            /* Also record the stack's high address, which may assist
-             * debugging. */
-            pxNewTCB->pxEndOfStack = pxTopOfStack;
+            prvAddNewTaskToReadyList( pxNewTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* configRECORD_STACK_HIGH_ADDRESS */
-    }
-    #else /* portSTACK_GROWTH */
-    {
-        pxTopOfStack = pxNewTCB->pxStack;
-
-        /* Check the alignment of the stack buffer is correct. */
-        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pxNewTCB->pxStack & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
 
-        /* The other extreme of the stack space is required if stack checking is
-         * performed. */
-        pxNewTCB->pxEndOfStack = pxNewTCB->pxStack + ( ulStackDepth - ( uint32_t ) 1 );
+        return xReturn;
     }
-    #endif /* portSTACK_GROWTH */
+/*-----------------------------------------------------------*/
 
-    /* Store the task name in the TCB. */
-    if( pcName != NULL )
+    UBaseType_t xTaskCreateStaticBatch( const TaskStaticParameters_t * const pxTaskTable,
+                                        UBaseType_t uxNumberOfTasks,
+                                        TaskHandle_t * const pxCreatedTasks )
     {
-        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+        const TaskStaticParameters_t * pxEntry;
+        UBaseType_t uxTask;
+        UBaseType_t uxCreated = 0U;
+
+        configASSERT( ( pxTaskTable != NULL ) || ( uxNumberOfTasks == 0U ) );
+        configASSERT( xSchedulerRunning == pdFALSE );
+
+        /* Initialise every task before any is added to the ready lists.  The
+         * TCBs are not reachable by the scheduler or interrupts until then, so
+         * this needs no critical section. */
+        for( uxTask = 0U; uxTask < uxNumberOfTasks; uxTask++ )
         {
-            pxNewTCB->pcTaskName[ x ] = pcName[ x ];
+            pxEntry = &( pxTaskTable[ uxTask ] );
 
-            /* Don't copy all configMAX_TASK_NAME_LEN if the string is shorter than
-             * configMAX_TASK_NAME_LEN characters just in case the memory after the
-             * string is not accessible (extremely unlikely). */
-            if( pcName[ x ] == ( char ) 0x00 )
+            if( ( pxEntry->puxStackBuffer != NULL ) && ( pxEntry->pxTaskBuffer != NULL ) )
             {
-                break;
+                ( void ) prvCreateStaticTask( pxEntry->pxTaskCode,
+                                              pxEntry->pcName,
+                                              pxEntry->ulStackDepth,
+                                              pxEntry->pvParameters,
+                                              pxEntry->uxPriority,
+                                              pxEntry->puxStackBuffer,
+                                              pxEntry->pxTaskBuffer,
+                                              NULL );
+                uxCreated++;
             }
             else
             {
@@ -903,789 +2366,941 @@ static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
             }
         }
 
-        /* Ensure the name string is terminated in the case that the string length
-         * was greater or equal to configMAX_TASK_NAME_LEN. */
-        pxNewTCB->pcTaskName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+        /* The critical sections entered by prvAddNewTaskToReadyList() nest
+         * inside this one, so they only adjust the nesting count. */
+        taskENTER_CRITICAL();
+        {
+            for( uxTask = 0U; uxTask < uxNumberOfTasks; uxTask++ )
+            {
+                pxEntry = &( pxTaskTable[ uxTask ] );
 
-    /* This is used as an array index so must ensure it's not too large. */
-    configASSERT( uxPriority < configMAX_PRIORITIES );
+                if( ( pxEntry->puxStackBuffer != NULL ) && ( pxEntry->pxTaskBuffer != NULL ) )
+                {
+                    prvAddNewTaskToReadyList( ( TCB_t * ) pxEntry->pxTaskBuffer ); /*lint !e740 !e9087 StaticTask_t is the opaque form of TCB_t. */
 
-    if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
-    {
-        uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
+                    if( pxCreatedTasks != NULL )
+                    {
+                        pxCreatedTasks[ uxTask ] = ( TaskHandle_t ) pxEntry->pxTaskBuffer;
+                    }
+                }
+                else if( pxCreatedTasks != NULL )
+                {
+                    pxCreatedTasks[ uxTask ] = NULL;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
 
-    pxNewTCB->uxPriority = uxPriority;
-    #if ( configUSE_MUTEXES == 1 )
-    {
-        pxNewTCB->uxBasePriority = uxPriority;
+        return uxCreated;
     }
-    #endif /* configUSE_MUTEXES */
-
-    vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
-    vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
-
-    /* Set the pxNewTCB as a link back from the ListItem_t.  This is so we can get
-     * back to  the containing TCB from a generic item in a list. */
-    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
+/*-----------------------------------------------------------*/
 
-    /* Event lists are always in priority order. */
-    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
+    #if ( configUSE_CORE_AFFINITY == 1 )
 
-    #if ( portUSING_MPU_WRAPPERS == 1 )
-    {
-        vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
-    }
-    #else
-    {
-        /* Avoid compiler warning about unreferenced parameter. */
-        ( void ) xRegions;
-    }
-    #endif
+        TaskHandle_t xTaskCreateStaticAffinitySet( TaskFunction_t pxTaskCode,
+                                                   const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                   const uint32_t ulStackDepth,
+                                                   void * const pvParameters,
+                                                   UBaseType_t uxPriority,
+                                                   StackType_t * const puxStackBuffer,
+                                                   StaticTask_t * const pxTaskBuffer,
+                                                   UBaseType_t uxCoreAffinityMask )
+        {
+            TCB_t * pxNewTCB;
+            TaskHandle_t xReturn = NULL;
 
-    #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
-    {
-        /* Allocate and initialize memory for the task's TLS Block. */
-        configINIT_TLS_BLOCK( pxNewTCB->xTLSBlock );
-    }
-    #endif
+            pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, ulStackDepth, pvParameters, uxPriority, puxStackBuffer, pxTaskBuffer, &xReturn );
 
-    /* Initialize the TCB stack to look as if the task was already running,
-     * but had been interrupted by the scheduler.  The return address is set
-     * to the start of the task function. Once the stack has been initialised
-     * the top of stack variable is updated. */
-    #if ( portUSING_MPU_WRAPPERS == 1 )
-    {
-        /* If the port has capability to detect stack overflow,
-         * pass the stack end address to the stack initialization
-         * function as well. */
-        #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
-        {
-            #if ( portSTACK_GROWTH < 0 )
+            if( pxNewTCB != NULL )
             {
-                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters, xRunPrivileged );
+                /* Set the affinity before the task can be selected to run. */
+                pxNewTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+                prvAddNewTaskToReadyList( pxNewTCB );
             }
-            #else /* portSTACK_GROWTH */
+            else
             {
-                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters, xRunPrivileged );
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* portSTACK_GROWTH */
-        }
-        #else /* portHAS_STACK_OVERFLOW_CHECKING */
-        {
-            pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters, xRunPrivileged );
+
+            return xReturn;
         }
-        #endif /* portHAS_STACK_OVERFLOW_CHECKING */
-    }
-    #else /* portUSING_MPU_WRAPPERS */
-    {
-        /* If the port has capability to detect stack overflow,
-         * pass the stack end address to the stack initialization
-         * function as well. */
-        #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+
+    #endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+
+        TaskHandle_t xTaskCreateStaticDeadline( TaskFunction_t pxTaskCode,
+                                                const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                const uint32_t ulStackDepth,
+                                                void * const pvParameters,
+                                                TickType_t xPeriod,
+                                                TickType_t xRelativeDeadline,
+                                                StackType_t * const puxStackBuffer,
+                                                StaticTask_t * const pxTaskBuffer )
         {
-            #if ( portSTACK_GROWTH < 0 )
+            TCB_t * pxNewTCB;
+            TaskHandle_t xReturn = NULL;
+
+            configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
+            configASSERT( xRelativeDeadline <= xPeriod );
+            ( void ) xPeriod;
+
+            pxNewTCB = prvCreateStaticTask( pxTaskCode, pcName, ulStackDepth, pvParameters, ( UBaseType_t ) configEDF_PRIORITY, puxStackBuffer, pxTaskBuffer, &xReturn );
+
+            if( pxNewTCB != NULL )
             {
-                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters );
+                /* Set the deadline before the task can be selected to run.  The
+                 * first release of the task is the time it is created. */
+                pxNewTCB->xRelativeDeadline = xRelativeDeadline;
+                pxNewTCB->xAbsoluteDeadline = xTaskGetTickCount() + xRelativeDeadline;
+
+                prvAddNewTaskToReadyList( pxNewTCB );
             }
-            #else /* portSTACK_GROWTH */
+            else
             {
-                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters );
+                mtCOVERAGE_TEST_MARKER();
             }
-            #endif /* portSTACK_GROWTH */
+
+            return xReturn;
         }
-        #else /* portHAS_STACK_OVERFLOW_CHECKING */
+
+    #endif /* configUSE_EDF_SCHEDULING */
+
+#endif /* SUPPORT_STATIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+
+    BaseType_t xTaskCreateRestrictedStatic( const TaskParameters_t * const pxTaskDefinition,
+                                            TaskHandle_t * pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+        configASSERT( pxTaskDefinition->puxStackBuffer != NULL );
+        configASSERT( pxTaskDefinition->pxTaskBuffer != NULL );
+
+        if( ( pxTaskDefinition->puxStackBuffer != NULL ) && ( pxTaskDefinition->pxTaskBuffer != NULL ) )
         {
-            pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters );
+            /* Allocate space for the TCB.  Where the memory comes from depends
+             * on the implementation of the port malloc function and whether or
+             * not static allocation is being used. */
+            pxNewTCB = ( TCB_t * ) pxTaskDefinition->pxTaskBuffer;
+            memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+            /* Store the stack location in the TCB. */
+            pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+            {
+                /* Tasks can be created statically or dynamically, so note this
+                 * task was created statically in case the task is later deleted. */
+                pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_AND_TCB;
+            }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+            prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
+                                  pxTaskDefinition->pcName,
+                                  ( uint32_t ) pxTaskDefinition->usStackDepth,
+                                  pxTaskDefinition->pvParameters,
+                                  pxTaskDefinition->uxPriority,
+                                  pxCreatedTask, pxNewTCB,
+                                  pxTaskDefinition->xRegions );
+
+            prvAddNewTaskToReadyList( pxNewTCB );
+            xReturn = pdPASS;
         }
-        #endif /* portHAS_STACK_OVERFLOW_CHECKING */
-    }
-    #endif /* portUSING_MPU_WRAPPERS */
 
-    if( pxCreatedTask != NULL )
-    {
-        /* Pass the handle out in an anonymous way.  The handle can be used to
-         * change the created task's priority, delete the created task, etc.*/
-        *pxCreatedTask = ( TaskHandle_t ) pxNewTCB;
-    }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
+        return xReturn;
     }
-}
+
+#endif /* ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
 /*-----------------------------------------------------------*/
 
-static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
-{
-    /* Ensure interrupts don't access the task lists while the lists are being
-     * updated. */
-    taskENTER_CRITICAL();
+#if ( ( portUSING_MPU_WRAPPERS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    BaseType_t xTaskCreateRestricted( const TaskParameters_t * const pxTaskDefinition,
+                                      TaskHandle_t * pxCreatedTask )
     {
-        uxCurrentNumberOfTasks++;
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
+
+        configASSERT( pxTaskDefinition->puxStackBuffer );
 
-        if( pxCurrentTCB == NULL )
+        if( pxTaskDefinition->puxStackBuffer != NULL )
         {
-            /* There are no other tasks, or all the other tasks are in
-             * the suspended state - make this the current task. */
-            pxCurrentTCB = pxNewTCB;
+            /* Allocate space for the TCB.  Where the memory comes from depends
+             * on the implementation of the port malloc function and whether or
+             * not static allocation is being used. */
+            pxNewTCB = ( TCB_t * ) pvPortMallocObject( portOBJECT_POOL_TASK, sizeof( TCB_t ) );
 
-            if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+            if( pxNewTCB != NULL )
             {
-                /* This is the first task to be created so do the preliminary
-                 * initialisation required.  We will not recover if this call
-                 * fails, but we will report the failure. */
-                prvInitialiseTaskLists();
+                memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+                /* Store the stack location in the TCB. */
+                pxNewTCB->pxStack = pxTaskDefinition->puxStackBuffer;
+
+                #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 )
+                {
+                    /* Tasks can be created statically or dynamically, so note
+                     * this task had a statically allocated stack in case it is
+                     * later deleted.  The TCB was allocated dynamically. */
+                    pxNewTCB->ucStaticallyAllocated = tskSTATICALLY_ALLOCATED_STACK_ONLY;
+                }
+                #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
+
+                prvInitialiseNewTask( pxTaskDefinition->pvTaskCode,
+                                      pxTaskDefinition->pcName,
+                                      ( uint32_t ) pxTaskDefinition->usStackDepth,
+                                      pxTaskDefinition->pvParameters,
+                                      pxTaskDefinition->uxPriority,
+                                      pxCreatedTask, pxNewTCB,
+                                      pxTaskDefinition->xRegions );
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+                xReturn = pdPASS;
             }
-            else
+        }
+
+        return xReturn;
+    }
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+#if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+    static TCB_t * prvCreateTask( TaskFunction_t pxTaskCode,
+                                  const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                  const configSTACK_DEPTH_TYPE usStackDepth,
+                                  void * const pvParameters,
+                                  UBaseType_t uxPriority,
+                                  TaskHandle_t * const pxCreatedTask )
+    {
+        TCB_t * pxNewTCB;
+
+        /* If the stack grows down then allocate the stack then the TCB so the stack
+         * does not grow into the TCB.  Likewise if the stack grows up then allocate
+         * the TCB then the stack. */
+        #if ( portSTACK_GROWTH > 0 )
+        {
+            /* Allocate space for the TCB.  Where the memory comes from depends on
+             * the implementation of the port malloc function and whether or not static
+             * allocation is being used. */
+            pxNewTCB = ( TCB_t * ) pvPortMallocObject( portOBJECT_POOL_TASK, sizeof( TCB_t ) );
+
+            if( pxNewTCB != NULL )
             {
-                mtCOVERAGE_TEST_MARKER();
+                memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+                /* Allocate space for the stack used by the task being created.
+                 * The base of the stack memory stored in the TCB so the task can
+                 * be deleted later if required. */
+                pxNewTCB->pxStack = ( StackType_t * ) pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+                if( pxNewTCB->pxStack == NULL )
+                {
+                    /* Could not allocate the stack.  Delete the allocated TCB. */
+                    vPortFreeObject( portOBJECT_POOL_TASK, pxNewTCB );
+                    pxNewTCB = NULL;
+                }
             }
         }
-        else
+        #else /* portSTACK_GROWTH */
         {
-            /* If the scheduler is not already running, make this task the
-             * current task if it is the highest priority task to be created
-             * so far. */
-            if( xSchedulerRunning == pdFALSE )
+            StackType_t * pxStack;
+
+            /* Allocate space for the stack used by the task being created. */
+            pxStack = pvPortMallocStack( ( ( ( size_t ) usStackDepth ) * sizeof( StackType_t ) ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation is the stack. */
+
+            if( pxStack != NULL )
             {
-                if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
+                /* Allocate space for the TCB. */
+                pxNewTCB = ( TCB_t * ) pvPortMallocObject( portOBJECT_POOL_TASK, sizeof( TCB_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of TCB_t is always a pointer to the task's stack. */
+
+                if( pxNewTCB != NULL )
                 {
-                    pxCurrentTCB = pxNewTCB;
+                    memset( ( void * ) pxNewTCB, 0x00, sizeof( TCB_t ) );
+
+                    /* Store the stack location in the TCB. */
+                    pxNewTCB->pxStack = pxStack;
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The stack cannot be used as the TCB was not created.  Free
+                     * it again. */
+                    vPortFreeStack( pxStack );
                 }
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                pxNewTCB = NULL;
             }
         }
+        #endif /* portSTACK_GROWTH */
 
-        uxTaskNumber++;
+        if( pxNewTCB != NULL )
+        {
+            #if ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e9029 !e731 Macro has been consolidated for readability reasons. */
+            {
+                /* Tasks can be created statically or dynamically, so note this
+                 * task was created dynamically in case it is later deleted. */
+                pxNewTCB->ucStaticallyAllocated = tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB;
+            }
+            #endif /* tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE */
 
-        #if ( configUSE_TRACE_FACILITY == 1 )
+            prvInitialiseNewTask( pxTaskCode, pcName, ( uint32_t ) usStackDepth, pvParameters, uxPriority, pxCreatedTask, pxNewTCB, NULL );
+        }
+        else
         {
-            /* Add a counter into the TCB for tracing only. */
-            pxNewTCB->uxTCBNumber = uxTaskNumber;
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* configUSE_TRACE_FACILITY */
-        traceTASK_CREATE( pxNewTCB );
-
-        prvAddTaskToReadyList( pxNewTCB );
 
-        portSETUP_TCB( pxNewTCB );
+        return pxNewTCB;
     }
-    taskEXIT_CRITICAL();
+/*-----------------------------------------------------------*/
 
-    if( xSchedulerRunning != pdFALSE )
+    BaseType_t xTaskCreate( TaskFunction_t pxTaskCode,
+                            const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                            const configSTACK_DEPTH_TYPE usStackDepth,
+                            void * const pvParameters,
+                            UBaseType_t uxPriority,
+                            TaskHandle_t * const pxCreatedTask )
     {
-        /* If the created task is of a higher priority than the current task
-         * then it should run now. */
-        if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+        TCB_t * pxNewTCB;
+        BaseType_t xReturn;
+
+        pxNewTCB = prvCreateTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask );
+
+        if( pxNewTCB != NULL )
         {
-            taskYIELD_IF_USING_PREEMPTION();
+            prvAddNewTaskToReadyList( pxNewTCB );
+            xReturn = pdPASS;
         }
         else
         {
-            mtCOVERAGE_TEST_MARKER();
+            xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
         }
+
+        return xReturn;
     }
-    else
-    {
-        mtCOVERAGE_TEST_MARKER();
-    }
-}
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
-
-    void vTaskDelete( TaskHandle_t xTaskToDelete )
-    {
-        TCB_t * pxTCB;
+    #if ( configUSE_CORE_AFFINITY == 1 )
 
-        taskENTER_CRITICAL();
+        BaseType_t xTaskCreateAffinitySet( TaskFunction_t pxTaskCode,
+                                           const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                           const configSTACK_DEPTH_TYPE usStackDepth,
+                                           void * const pvParameters,
+                                           UBaseType_t uxPriority,
+                                           UBaseType_t uxCoreAffinityMask,
+                                           TaskHandle_t * const pxCreatedTask )
         {
-            /* If null is passed in here then it is the calling task that is
-             * being deleted. */
-            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
+            TCB_t * pxNewTCB;
+            BaseType_t xReturn;
 
-            /* Remove task from the ready/delayed list. */
-            if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+            pxNewTCB = prvCreateTask( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask );
+
+            if( pxNewTCB != NULL )
             {
-                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+                /* Set the affinity before the task can be selected to run. */
+                pxNewTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+                xReturn = pdPASS;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
             }
 
-            /* Is the task waiting on an event also? */
-            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            return xReturn;
+        }
+
+    #endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_EDF_SCHEDULING == 1 )
+
+        BaseType_t xTaskCreateDeadline( TaskFunction_t pxTaskCode,
+                                        const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const configSTACK_DEPTH_TYPE usStackDepth,
+                                        void * const pvParameters,
+                                        TickType_t xPeriod,
+                                        TickType_t xRelativeDeadline,
+                                        TaskHandle_t * const pxCreatedTask )
+        {
+            TCB_t * pxNewTCB;
+            BaseType_t xReturn;
+
+            configASSERT( xRelativeDeadline > ( TickType_t ) 0U );
+            configASSERT( xRelativeDeadline <= xPeriod );
+            ( void ) xPeriod;
+
+            pxNewTCB = prvCreateTask( pxTaskCode, pcName, usStackDepth, pvParameters, ( UBaseType_t ) configEDF_PRIORITY, pxCreatedTask );
+
+            if( pxNewTCB != NULL )
             {
-                ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                /* Set the deadline before the task can be selected to run.  The
+                 * first release of the task is the time it is created. */
+                pxNewTCB->xRelativeDeadline = xRelativeDeadline;
+                pxNewTCB->xAbsoluteDeadline = xTaskGetTickCount() + xRelativeDeadline;
+
+                prvAddNewTaskToReadyList( pxNewTCB );
+                xReturn = pdPASS;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                xReturn = errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY;
             }
 
-            /* Increment the uxTaskNumber also so kernel aware debuggers can
-             * detect that the task lists need re-generating.  This is done before
-             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
-             * not return. */
-            uxTaskNumber++;
+            return xReturn;
+        }
 
-            if( pxTCB == pxCurrentTCB )
-            {
-                /* A task is deleting itself.  This cannot complete within the
-                 * task itself, as a context switch to another task is required.
-                 * Place the task in the termination list.  The idle task will
-                 * check the termination list and free up any memory allocated by
-                 * the scheduler for the TCB and stack of the deleted task. */
-                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+    #endif /* configUSE_EDF_SCHEDULING */
 
-                /* Increment the ucTasksDeleted variable so the idle task knows
-                 * there is a task that has been deleted and that it should therefore
-                 * check the xTasksWaitingTermination list. */
-                ++uxDeletedTasksWaitingCleanUp;
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
 
-                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
-                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
-                traceTASK_DELETE( pxTCB );
+static void prvInitialiseNewTask( TaskFunction_t pxTaskCode,
+                                  const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                  const uint32_t ulStackDepth,
+                                  void * const pvParameters,
+                                  UBaseType_t uxPriority,
+                                  TaskHandle_t * const pxCreatedTask,
+                                  TCB_t * pxNewTCB,
+                                  const MemoryRegion_t * const xRegions )
+{
+    StackType_t * pxTopOfStack;
 
-                /* The pre-delete hook is primarily for the Windows simulator,
-                 * in which Windows specific clean up operations are performed,
-                 * after which it is not possible to yield away from this task -
-                 * hence xYieldPending is used to latch that a context switch is
-                 * required. */
-                portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
-            }
-            else
-            {
-                --uxCurrentNumberOfTasks;
-                traceTASK_DELETE( pxTCB );
+    #if ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_COPY )
+        UBaseType_t x;
+    #endif
 
-                /* Reset the next expected unblock time in case it referred to
-                 * the task that has just been deleted. */
-                prvResetNextTaskUnblockTime();
-            }
-        }
-        taskEXIT_CRITICAL();
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+        /* Should the task be created in privileged mode? */
+        BaseType_t xRunPrivileged;
 
-        /* If the task is not deleting itself, call prvDeleteTCB from outside of
-         * critical section. If a task deletes itself, prvDeleteTCB is called
-         * from prvCheckTasksWaitingTermination which is called from Idle task. */
-        if( pxTCB != pxCurrentTCB )
+        if( ( uxPriority & portPRIVILEGE_BIT ) != 0U )
         {
-            prvDeleteTCB( pxTCB );
+            xRunPrivileged = pdTRUE;
         }
-
-        /* Force a reschedule if it is the currently running task that has just
-         * been deleted. */
-        if( xSchedulerRunning != pdFALSE )
+        else
         {
-            if( pxTCB == pxCurrentTCB )
-            {
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            xRunPrivileged = pdFALSE;
         }
-    }
-
-#endif /* INCLUDE_vTaskDelete */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_xTaskDelayUntil == 1 )
+        uxPriority &= ~portPRIVILEGE_BIT;
+    #endif /* portUSING_MPU_WRAPPERS == 1 */
 
-    BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
-                                const TickType_t xTimeIncrement )
+    /* Avoid dependency on memset() if it is not required. */
+    #if ( tskSET_NEW_STACKS_TO_KNOWN_VALUE == 1 )
     {
-        TickType_t xTimeToWake;
-        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
-
-        configASSERT( pxPreviousWakeTime );
-        configASSERT( ( xTimeIncrement > 0U ) );
-        configASSERT( uxSchedulerSuspended == 0 );
-
-        vTaskSuspendAll();
+        #if ( configSTACK_FILL_LIMIT_WORDS > 0 )
         {
-            /* Minor optimisation.  The tick count cannot change in this
-             * block. */
-            const TickType_t xConstTickCount = xTickCount;
+            uint32_t ulFillDepth = ulStackDepth;
 
-            /* Generate the tick time at which the task wants to wake. */
-            xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+            /* Stack overflow checking method 2 checks the last 20 bytes of
+             * the stack. */
+            #if ( configCHECK_FOR_STACK_OVERFLOW > 1 )
+                configASSERT( ( ( size_t ) configSTACK_FILL_LIMIT_WORDS * sizeof( StackType_t ) ) >= ( size_t ) 24 );
+            #endif
 
-            if( xConstTickCount < *pxPreviousWakeTime )
-            {
-                /* The tick count has overflowed since this function was
-                 * lasted called.  In this case the only time we should ever
-                 * actually delay is if the wake time has also  overflowed,
-                 * and the wake time is greater than the tick time.  When this
-                 * is the case it is as if neither time had overflowed. */
-                if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
-                {
-                    xShouldDelay = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
+            if( ulFillDepth > ( uint32_t ) configSTACK_FILL_LIMIT_WORDS )
             {
-                /* The tick time has not overflowed.  In this case we will
-                 * delay if either the wake time has overflowed, and/or the
-                 * tick time is less than the wake time. */
-                if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
-                {
-                    xShouldDelay = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                ulFillDepth = ( uint32_t ) configSTACK_FILL_LIMIT_WORDS;
             }
 
-            /* Update the wake time ready for the next call. */
-            *pxPreviousWakeTime = xTimeToWake;
-
-            if( xShouldDelay != pdFALSE )
+            /* Only the deep end of the stack is filled.  A task that never
+             * reaches it leaves the fill intact, so its free stack space is
+             * reported as ulFillDepth. */
+            #if ( portSTACK_GROWTH < 0 )
             {
-                traceTASK_DELAY_UNTIL( xTimeToWake );
-
-                /* prvAddCurrentTaskToDelayedList() needs the block time, not
-                 * the time to wake, so subtract the current tick count. */
-                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+                ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulFillDepth * sizeof( StackType_t ) );
             }
-            else
+            #else
             {
-                mtCOVERAGE_TEST_MARKER();
+                ( void ) memset( &( pxNewTCB->pxStack[ ulStackDepth - ulFillDepth ] ), ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulFillDepth * sizeof( StackType_t ) );
             }
+            #endif
         }
-        xAlreadyYielded = xTaskResumeAll();
-
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
-        {
-            portYIELD_WITHIN_API();
-        }
-        else
+        #else /* if ( configSTACK_FILL_LIMIT_WORDS > 0 ) */
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* Fill the stack with a known value to assist debugging. */
+            ( void ) memset( pxNewTCB->pxStack, ( int ) tskSTACK_FILL_BYTE, ( size_t ) ulStackDepth * sizeof( StackType_t ) );
         }
-
-        return xShouldDelay;
+        #endif /* if ( configSTACK_FILL_LIMIT_WORDS > 0 ) */
     }
+    #endif /* tskSET_NEW_STACKS_TO_KNOWN_VALUE */
 
-#endif /* INCLUDE_xTaskDelayUntil */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskDelay == 1 )
-
-    void vTaskDelay( const TickType_t xTicksToDelay )
+    /* Calculate the top of stack address.  This depends on whether the stack
+     * grows from high memory to low (as per the 80x86) or vice versa.
+     * portSTACK_GROWTH is used to make the result positive or negative as required
+     * by the port. */
+    #if ( portSTACK_GROWTH < 0 )
     {
-        BaseType_t xAlreadyYielded = pdFALSE;
-
-        /* A delay time of zero just forces a reschedule. */
-        if( xTicksToDelay > ( TickType_t ) 0U )
-        {
-            configASSERT( uxSchedulerSuspended == 0 );
-            vTaskSuspendAll();
-            {
-                traceTASK_DELAY();
+        pxTopOfStack = &( pxNewTCB->pxStack[ ulStackDepth - ( uint32_t ) 1 ] );
+        pxTopOfStack = ( StackType_t * ) ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack ) & ( ~( ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) ) ); /*lint !e923 !e9033 !e9078 MISRA exception.  Avoiding casts between pointers and integers is not practical.  Size differences accounted for using portPOINTER_SIZE_TYPE type.  Checked by assert(). */
 
-                /* A task that is removed from the event list while the
-                 * scheduler is suspended will not get placed in the ready
-                 * list or removed from the blocked list until the scheduler
-                 * is resumed.
-                 *
-                 * This task cannot be in an event list as it is the currently
-                 * executing task. */
-                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
-            }
-            xAlreadyYielded = xTaskResumeAll();
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        /* Check the alignment of the calculated top of stack is correct. */
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pxTopOfStack & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
 
-        /* Force a reschedule if xTaskResumeAll has not already done so, we may
-         * have put ourselves to sleep. */
-        if( xAlreadyYielded == pdFALSE )
-        {
-            portYIELD_WITHIN_API();
-        }
-        else
+        #if ( configRECORD_STACK_HIGH_ADDRESS == 1 )
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* Also record the stack's high address, which may assist
+             * debugging. */
+            pxNewTCB->pxEndOfStack = pxTopOfStack;
         }
+        #endif /* configRECORD_STACK_HIGH_ADDRESS */
     }
+    #else /* portSTACK_GROWTH */
+    {
+        pxTopOfStack = pxNewTCB->pxStack;
 
-#endif /* INCLUDE_vTaskDelay */
-/*-----------------------------------------------------------*/
+        /* Check the alignment of the stack buffer is correct. */
+        configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pxNewTCB->pxStack & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0UL ) );
 
-#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+        /* The other extreme of the stack space is required if stack checking is
+         * performed. */
+        pxNewTCB->pxEndOfStack = pxNewTCB->pxStack + ( ulStackDepth - ( uint32_t ) 1 );
+    }
+    #endif /* portSTACK_GROWTH */
 
-    eTaskState eTaskGetState( TaskHandle_t xTask )
+    /* Store the task name in the TCB. */
+    #if ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_REFERENCE )
     {
-        eTaskState eReturn;
-        List_t const * pxStateList;
-        List_t const * pxDelayedList;
-        List_t const * pxOverflowedDelayedList;
-        const TCB_t * const pxTCB = xTask;
-
-        configASSERT( pxTCB );
-
-        if( pxTCB == pxCurrentTCB )
-        {
-            /* The task calling this function is querying its own state. */
-            eReturn = eRunning;
-        }
-        else
+        /* The TCB was zeroed, so a task created without a name is given an
+         * empty one. */
+        pxNewTCB->pcTaskName = ( pcName != NULL ) ? pcName : "";
+    }
+    #elif ( configTASK_NAME_STORAGE == TASK_NAME_STORAGE_COPY )
+    if( pcName != NULL )
+    {
+        for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
         {
-            taskENTER_CRITICAL();
+            pxNewTCB->pcTaskName[ x ] = pcName[ x ];
+
+            /* Don't copy all configMAX_TASK_NAME_LEN if the string is shorter than
+             * configMAX_TASK_NAME_LEN characters just in case the memory after the
+             * string is not accessible (extremely unlikely). */
+            if( pcName[ x ] == ( char ) 0x00 )
             {
-                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-                pxDelayedList = pxDelayedTaskList;
-                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+                break;
             }
-            taskEXIT_CRITICAL();
-
-            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            else
             {
-                /* The task being queried is referenced from one of the Blocked
-                 * lists. */
-                eReturn = eBlocked;
+                mtCOVERAGE_TEST_MARKER();
             }
+        }
 
-            #if ( INCLUDE_vTaskSuspend == 1 )
-                else if( pxStateList == &xSuspendedTaskList )
-                {
-                    /* The task being queried is referenced from the suspended
-                     * list.  Is it genuinely suspended or is it blocked
-                     * indefinitely? */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL )
-                    {
-                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
-                        {
-                            BaseType_t x;
+        /* Ensure the name string is terminated in the case that the string length
+         * was greater or equal to configMAX_TASK_NAME_LEN. */
+        pxNewTCB->pcTaskName[ configMAX_TASK_NAME_LEN - 1 ] = '\0';
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+    #else /* configTASK_NAME_STORAGE */
+    {
+        /* Names are not stored. */
+        ( void ) pcName;
+    }
+    #endif /* configTASK_NAME_STORAGE */
 
-                            /* The task does not appear on the event list item of
-                             * and of the RTOS objects, but could still be in the
-                             * blocked state if it is waiting on its notification
-                             * rather than waiting on an object.  If not, is
-                             * suspended. */
-                            eReturn = eSuspended;
+    /* This is used as an array index so must ensure it's not too large. */
+    configASSERT( uxPriority < configMAX_PRIORITIES );
 
-                            for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
-                            {
-                                if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
-                                {
-                                    eReturn = eBlocked;
-                                    break;
-                                }
-                            }
-                        }
-                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                        {
-                            eReturn = eSuspended;
-                        }
-                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-                    }
-                    else
-                    {
-                        eReturn = eBlocked;
-                    }
-                }
-            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
+    if( uxPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+    {
+        uxPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
 
-            #if ( INCLUDE_vTaskDelete == 1 )
-                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
-                {
-                    /* The task being queried is referenced from the deleted
-                     * tasks list, or it is not referenced from any lists at
-                     * all. */
-                    eReturn = eDeleted;
-                }
-            #endif
+    pxNewTCB->uxPriority = uxPriority;
+    #if ( configUSE_MUTEXES == 1 )
+    {
+        pxNewTCB->uxBasePriority = uxPriority;
+    }
+    #endif /* configUSE_MUTEXES */
 
-            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
-            {
-                /* If the task is not in any other state, it must be in the
-                 * Ready (including pending ready) state. */
-                eReturn = eReady;
-            }
-        }
+    vListInitialiseItem( &( pxNewTCB->xStateListItem ) );
+    vListInitialiseItem( &( pxNewTCB->xEventListItem ) );
 
-        return eReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+    /* Set the pxNewTCB as a link back from the ListItem_t.  This is so we can get
+     * back to  the containing TCB from a generic item in a list. */
+    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xStateListItem ), pxNewTCB );
 
-#endif /* INCLUDE_eTaskGetState */
-/*-----------------------------------------------------------*/
+    /* Event lists are always in priority order. */
+    listSET_LIST_ITEM_VALUE( &( pxNewTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    listSET_LIST_ITEM_OWNER( &( pxNewTCB->xEventListItem ), pxNewTCB );
 
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+    {
+        vPortStoreTaskMPUSettings( &( pxNewTCB->xMPUSettings ), xRegions, pxNewTCB->pxStack, ulStackDepth );
+    }
+    #else
+    {
+        /* Avoid compiler warning about unreferenced parameter. */
+        ( void ) xRegions;
+    }
+    #endif
 
-    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
+    #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
     {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn;
+        /* Allocate and initialize memory for the task's TLS Block. */
+        configINIT_TLS_BLOCK( pxNewTCB->xTLSBlock );
+    }
+    #endif
 
-        taskENTER_CRITICAL();
+    /* Initialize the TCB stack to look as if the task was already running,
+     * but had been interrupted by the scheduler.  The return address is set
+     * to the start of the task function. Once the stack has been initialised
+     * the top of stack variable is updated. */
+    #if ( portUSING_MPU_WRAPPERS == 1 )
+    {
+        /* If the port has capability to detect stack overflow,
+         * pass the stack end address to the stack initialization
+         * function as well. */
+        #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
         {
-            /* If null is passed in here then it is the priority of the task
-             * that called uxTaskPriorityGet() that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters, xRunPrivileged );
+            }
+            #else /* portSTACK_GROWTH */
+            {
+                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters, xRunPrivileged );
+            }
+            #endif /* portSTACK_GROWTH */
         }
-        taskEXIT_CRITICAL();
-
-        return uxReturn;
+        #else /* portHAS_STACK_OVERFLOW_CHECKING */
+        {
+            pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters, xRunPrivileged );
+        }
+        #endif /* portHAS_STACK_OVERFLOW_CHECKING */
     }
-
-#endif /* INCLUDE_uxTaskPriorityGet */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_uxTaskPriorityGet == 1 )
-
-    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
+    #else /* portUSING_MPU_WRAPPERS */
     {
-        TCB_t const * pxTCB;
-        UBaseType_t uxReturn, uxSavedInterruptState;
-
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-        uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+        /* If the port has capability to detect stack overflow,
+         * pass the stack end address to the stack initialization
+         * function as well. */
+        #if ( portHAS_STACK_OVERFLOW_CHECKING == 1 )
         {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being queried. */
-            pxTCB = prvGetTCBFromHandle( xTask );
-            uxReturn = pxTCB->uxPriority;
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters );
+            }
+            #else /* portSTACK_GROWTH */
+            {
+                pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters );
+            }
+            #endif /* portSTACK_GROWTH */
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
-
-        return uxReturn;
+        #else /* portHAS_STACK_OVERFLOW_CHECKING */
+        {
+            pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters );
+        }
+        #endif /* portHAS_STACK_OVERFLOW_CHECKING */
     }
+    #endif /* portUSING_MPU_WRAPPERS */
 
-#endif /* INCLUDE_uxTaskPriorityGet */
-/*-----------------------------------------------------------*/
-
-#if ( INCLUDE_vTaskPrioritySet == 1 )
-
-    void vTaskPrioritySet( TaskHandle_t xTask,
-                           UBaseType_t uxNewPriority )
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
     {
-        TCB_t * pxTCB;
-        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
-        BaseType_t xYieldRequired = pdFALSE;
+        /* The initial context is below the top of the stack, and is found by
+         * the first scan. */
+        pxNewTCB->pxStackHighWaterMark = pxTopOfStack;
+    }
+    #endif
 
-        configASSERT( uxNewPriority < configMAX_PRIORITIES );
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* Initialize task state and task attributes. */
+        pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
 
-        /* Ensure the new priority is valid. */
-        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+        if( ( pxTaskCode == prvIdleTask ) || ( pxTaskCode == prvPassiveIdleTask ) )
         {
-            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+            pxNewTCB->uxTaskAttributes |= taskATTRIBUTE_IS_IDLE;
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+    }
+    #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
 
-        taskENTER_CRITICAL();
+    #if ( configUSE_CORE_AFFINITY == 1 )
+    {
+        /* The idle tasks must be able to run on any core so every core always
+         * has a task it can select. */
+        if( ( pxNewTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
         {
-            /* If null is passed in here then it is the priority of the calling
-             * task that is being changed. */
-            pxTCB = prvGetTCBFromHandle( xTask );
+            pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+        }
+        else
+        {
+            pxNewTCB->uxCoreAffinityMask = configTASK_DEFAULT_CORE_AFFINITY;
+        }
+    }
+    #endif
 
-            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+    {
+        /* Only the tasks that are tagged can be shed. */
+        pxNewTCB->uxCriticality = tskCRITICALITY_HIGH;
+    }
+    #endif
 
-            #if ( configUSE_MUTEXES == 1 )
-            {
-                uxCurrentBasePriority = pxTCB->uxBasePriority;
-            }
-            #else
+    if( pxCreatedTask != NULL )
+    {
+        /* Pass the handle out in an anonymous way.  The handle can be used to
+         * change the created task's priority, delete the created task, etc.*/
+        *pxCreatedTask = ( TaskHandle_t ) pxNewTCB;
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+
+    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        /* Ensure interrupts don't access the task lists while the lists are being
+         * updated. */
+        taskENTER_CRITICAL();
+        {
+            uxCurrentNumberOfTasks++;
+
+            if( pxCurrentTCB == NULL )
             {
-                uxCurrentBasePriority = pxTCB->uxPriority;
-            }
-            #endif
+                /* There are no other tasks, or all the other tasks are in
+                 * the suspended state - make this the current task. */
+                pxCurrentTCB = pxNewTCB;
 
-            if( uxCurrentBasePriority != uxNewPriority )
+                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+                {
+                    /* This is the first task to be created so do the preliminary
+                     * initialisation required.  We will not recover if this call
+                     * fails, but we will report the failure. */
+                    prvInitialiseTaskLists();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
             {
-                /* The priority change may have readied a task of higher
-                 * priority than the calling task. */
-                if( uxNewPriority > uxCurrentBasePriority )
+                /* If the scheduler is not already running, make this task the
+                 * current task if it is the highest priority task to be created
+                 * so far. */
+                if( xSchedulerRunning == pdFALSE )
                 {
-                    if( pxTCB != pxCurrentTCB )
+                    if( pxCurrentTCB->uxPriority <= pxNewTCB->uxPriority )
                     {
-                        /* The priority of a task other than the currently
-                         * running task is being raised.  Is the priority being
-                         * raised above that of the running task? */
-                        if( uxNewPriority > pxCurrentTCB->uxPriority )
-                        {
-                            xYieldRequired = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+                        pxCurrentTCB = pxNewTCB;
                     }
                     else
                     {
-                        /* The priority of the running task is being raised,
-                         * but the running task must already be the highest
-                         * priority task able to run so no yield is required. */
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                else if( pxTCB == pxCurrentTCB )
+                else
                 {
-                    /* Setting the priority of the running task down means
-                     * there may now be another task of higher priority that
-                     * is ready to execute. */
-                    xYieldRequired = pdTRUE;
-                }
-                else
-                {
-                    /* Setting the priority of any other task down does not
-                     * require a yield as the running task must be above the
-                     * new priority of the task being modified. */
+                    mtCOVERAGE_TEST_MARKER();
                 }
+            }
 
-                /* Remember the ready list the task might be referenced from
-                 * before its uxPriority member is changed so the
-                 * taskRESET_READY_PRIORITY() macro can function correctly. */
-                uxPriorityUsedOnEntry = pxTCB->uxPriority;
+            uxTaskNumber++;
 
-                #if ( configUSE_MUTEXES == 1 )
-                {
-                    /* Only change the priority being used if the task is not
-                     * currently using an inherited priority. */
-                    if( pxTCB->uxBasePriority == pxTCB->uxPriority )
-                    {
-                        pxTCB->uxPriority = uxNewPriority;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                /* Add a counter into the TCB for tracing only. */
+                pxNewTCB->uxTCBNumber = uxTaskNumber;
+            }
+            #endif /* configUSE_TRACE_FACILITY */
 
-                    /* The base priority gets set whatever. */
-                    pxTCB->uxBasePriority = uxNewPriority;
-                }
-                #else /* if ( configUSE_MUTEXES == 1 ) */
-                {
-                    pxTCB->uxPriority = uxNewPriority;
-                }
-                #endif /* if ( configUSE_MUTEXES == 1 ) */
+            #if ( configUSE_TASK_ITERATOR == 1 )
+            {
+                prvRegisterTask( pxNewTCB );
+            }
+            #endif
 
-                /* Only reset the event list item value if the value is not
-                 * being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+            #if ( configTASK_NAME_HASH_BUCKETS > 0 )
+            {
+                prvAddTaskToNameIndex( pxNewTCB );
+            }
+            #endif
+
+            traceTASK_CREATE( pxNewTCB );
+
+            prvAddTaskToReadyList( pxNewTCB );
+
+            portSETUP_TCB( pxNewTCB );
+        }
+        taskEXIT_CRITICAL();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the created task is of a higher priority than the current task
+             * then it should run now. */
+            if( taskTASK_CAN_PREEMPT( pxNewTCB, pxCurrentTCB ) != pdFALSE )
+            {
+                taskYIELD_IF_USING_PREEMPTION();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#else /* #if ( configNUMBER_OF_CORES == 1 ) */
+
+    static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
+    {
+        /* Ensure that no other core or interrupt accesses the task lists while
+         * the lists are being updated. */
+        taskENTER_CRITICAL();
+        {
+            uxCurrentNumberOfTasks++;
+
+            if( xSchedulerRunning == pdFALSE )
+            {
+                if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    /* This is the first task to be created so do the preliminary
+                     * initialisation required.  We will not recover if this call
+                     * fails, but we will report the failure. */
+                    prvInitialiseTaskLists();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
 
-                /* If the task is in the blocked or suspended list we need do
-                 * nothing more than change its priority variable. However, if
-                 * the task is in a ready list it needs to be removed and placed
-                 * in the list appropriate to its new priority. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                /* Every core starts by running its idle task, which yields
+                 * straight away to get the application tasks running. */
+                if( ( pxNewTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
                 {
-                    /* The task is currently in its ready list - remove before
-                     * adding it to its new ready list.  As we are in a critical
-                     * section we can do this even if the scheduler is suspended. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
-                    }
-                    else
+                    BaseType_t xCoreID;
+
+                    for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
                     {
-                        mtCOVERAGE_TEST_MARKER();
+                        if( pxCurrentTCBs[ xCoreID ] == NULL )
+                        {
+                            pxNewTCB->xTaskRunState = xCoreID;
+                            pxCurrentTCBs[ xCoreID ] = pxNewTCB;
+                            taskRECORD_CORE_RUN_ON( pxNewTCB, xCoreID );
+                            break;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
-
-                    prvAddTaskToReadyList( pxTCB );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                if( xYieldRequired != pdFALSE )
+            uxTaskNumber++;
+
+            #if ( configUSE_TRACE_FACILITY == 1 )
+            {
+                /* Add a counter into the TCB for tracing only. */
+                pxNewTCB->uxTCBNumber = uxTaskNumber;
+            }
+            #endif /* configUSE_TRACE_FACILITY */
+
+            #if ( configUSE_TASK_ITERATOR == 1 )
+            {
+                prvRegisterTask( pxNewTCB );
+            }
+            #endif
+
+            #if ( configTASK_NAME_HASH_BUCKETS > 0 )
+            {
+                prvAddTaskToNameIndex( pxNewTCB );
+            }
+            #endif
+
+            traceTASK_CREATE( pxNewTCB );
+
+            prvAddTaskToReadyList( pxNewTCB );
+
+            portSETUP_TCB( pxNewTCB );
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                if( xSchedulerRunning != pdFALSE )
                 {
-                    taskYIELD_IF_USING_PREEMPTION();
+                    /* If the created task has a higher priority than a task
+                     * that is currently running then it should run now. */
+                    prvYieldForTask( pxNewTCB );
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
-
-                /* Remove compiler warning about unused variables when the port
-                 * optimised task selection is not being used. */
-                ( void ) uxPriorityUsedOnEntry;
             }
+            #endif /* #if ( configUSE_PREEMPTION == 1 ) */
         }
         taskEXIT_CRITICAL();
     }
 
-#endif /* INCLUDE_vTaskPrioritySet */
+#endif /* #if ( configNUMBER_OF_CORES == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( INCLUDE_vTaskDelete == 1 )
 
-    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    void vTaskDelete( TaskHandle_t xTaskToDelete )
     {
         TCB_t * pxTCB;
+        BaseType_t xDeleteTCBInIdleTask = pdFALSE;
 
         taskENTER_CRITICAL();
         {
-            /* If null is passed in here then it is the running task that is
-             * being suspended. */
-            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+            /* If null is passed in here then it is the calling task that is
+             * being deleted. */
+            pxTCB = prvGetTCBFromHandle( xTaskToDelete );
 
-            traceTASK_SUSPEND( pxTCB );
+            #if ( ( configUSE_TASK_STATE_COUNTS == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+            {
+                if( prvTaskIsInSuspendedState( pxTCB ) != pdFALSE )
+                {
+                    uxSuspendedTaskCount--;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
 
-            /* Remove task from the ready/delayed list and place in the
-             * suspended list. */
+            /* Remove task from the ready/delayed list. */
             if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
             {
                 taskRESET_READY_PRIORITY( pxTCB->uxPriority );
@@ -1705,101 +3320,181 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
                 mtCOVERAGE_TEST_MARKER();
             }
 
-            vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+            #if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+            {
+                ( void ) prvRemoveWaitRecords( pxTCB, NULL );
+            }
+            #endif
 
-            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            /* Increment the uxTaskNumber also so kernel aware debuggers can
+             * detect that the task lists need re-generating.  This is done before
+             * portPRE_TASK_DELETE_HOOK() as in the Windows port that macro will
+             * not return. */
+            uxTaskNumber++;
+
+            #if ( configUSE_TASK_ITERATOR == 1 )
             {
-                BaseType_t x;
+                prvUnregisterTask( pxTCB );
+            }
+            #endif
 
-                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+            #if ( configTASK_NAME_HASH_BUCKETS > 0 )
+            {
+                prvRemoveTaskFromNameIndex( pxTCB );
+            }
+            #endif
+
+            /* If the task is running, or has been asked to yield by another core,
+             * then it cannot be freed until it has been switched out. */
+            if( taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) != pdFALSE )
+            {
+                /* A task is deleting itself, or on a multi-core system a task
+                 * running on another core is being deleted.  This cannot complete
+                 * while the task is running, as a context switch to another task
+                 * is required.  Place the task in the termination list.  The idle
+                 * task will check the termination list and free up any memory
+                 * allocated by the scheduler for the TCB and stack of the deleted
+                 * task. */
+                vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+
+                /* Increment the ucTasksDeleted variable so the idle task knows
+                 * there is a task that has been deleted and that it should therefore
+                 * check the xTasksWaitingTermination list. */
+                ++uxDeletedTasksWaitingCleanUp;
+
+                /* Call the delete hook before portPRE_TASK_DELETE_HOOK() as
+                 * portPRE_TASK_DELETE_HOOK() does not return in the Win32 port. */
+                traceTASK_DELETE( pxTCB );
+
+                /* The pre-delete hook is primarily for the Windows simulator,
+                 * in which Windows specific clean up operations are performed,
+                 * after which it is not possible to yield away from this task -
+                 * hence xYieldPending is used to latch that a context switch is
+                 * required. */
+                #if ( configNUMBER_OF_CORES == 1 )
+                    portPRE_TASK_DELETE_HOOK( pxTCB, &xYieldPending );
+                #else
+                    portPRE_TASK_DELETE_HOOK( pxTCB, &( xYieldPendings[ portGET_CORE_ID() ] ) );
+                #endif
+
+                xDeleteTCBInIdleTask = pdTRUE;
+
+                #if ( configUSE_TASK_REAPER == 1 )
                 {
-                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                    /* Wake the reaper task to free the task once it has been
+                     * switched out. */
+                    if( xReaperTaskHandle != NULL )
                     {
-                        /* The task was blocked to wait for a notification, but is
-                         * now suspended, so no notification was received. */
-                        pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+                        ( void ) xTaskGenericNotify( xReaperTaskHandle, tskDEFAULT_INDEX_TO_NOTIFY, 0, eIncrement, NULL );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
                     }
                 }
+                #endif /* configUSE_TASK_REAPER */
             }
-            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
-        }
-        taskEXIT_CRITICAL();
-
-        if( xSchedulerRunning != pdFALSE )
-        {
-            /* Reset the next expected unblock time in case it referred to the
-             * task that is now in the Suspended state. */
-            taskENTER_CRITICAL();
+            else
             {
+                --uxCurrentNumberOfTasks;
+                traceTASK_DELETE( pxTCB );
+
+                /* Reset the next expected unblock time in case it referred to
+                 * the task that has just been deleted. */
                 prvResetNextTaskUnblockTime();
             }
-            taskEXIT_CRITICAL();
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Force a reschedule on the core running the task that has
+                 * just been deleted.  If that is this core then the yield is
+                 * performed when the critical section is exited. */
+                if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) )
+                {
+                    if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+                    {
+                        configASSERT( uxSchedulerSuspended == 0 );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    prvYieldCore( pxTCB->xTaskRunState );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
         }
-        else
+        taskEXIT_CRITICAL();
+
+        /* If the task is not running, call prvDeleteTCB from outside of
+         * critical section. If a task deletes itself, prvDeleteTCB is called
+         * from prvCheckTasksWaitingTermination which is called from Idle task. */
+        if( xDeleteTCBInIdleTask != pdTRUE )
         {
-            mtCOVERAGE_TEST_MARKER();
+            prvDeleteTCB( pxTCB );
         }
 
-        if( pxTCB == pxCurrentTCB )
+        #if ( configNUMBER_OF_CORES == 1 )
         {
+            /* Force a reschedule if it is the currently running task that has just
+             * been deleted. */
             if( xSchedulerRunning != pdFALSE )
             {
-                /* The current task has just been suspended. */
-                configASSERT( uxSchedulerSuspended == 0 );
-                portYIELD_WITHIN_API();
-            }
-            else
-            {
-                /* The scheduler is not running, but the task that was pointed
-                 * to by pxCurrentTCB has just been suspended and pxCurrentTCB
-                 * must be adjusted to point to a different task. */
-                if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                if( pxTCB == pxCurrentTCB )
                 {
-                    /* No other tasks are ready, so set pxCurrentTCB back to
-                     * NULL so when the next task is created pxCurrentTCB will
-                     * be set to point to it no matter what its relative priority
-                     * is. */
-                    pxCurrentTCB = NULL;
+                    configASSERT( uxSchedulerSuspended == 0 );
+                    portYIELD_WITHIN_API();
                 }
                 else
                 {
-                    vTaskSwitchContext();
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
     }
 
-#endif /* INCLUDE_vTaskSuspend */
+#endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
+#if ( INCLUDE_xTaskDelayUntil == 1 )
 
-    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
+    BaseType_t xTaskDelayUntil( TickType_t * const pxPreviousWakeTime,
+                                const TickType_t xTimeIncrement )
     {
-        BaseType_t xReturn = pdFALSE;
-        const TCB_t * const pxTCB = xTask;
+        TickType_t xTimeToWake;
+        BaseType_t xAlreadyYielded, xShouldDelay = pdFALSE;
 
-        /* Accesses xPendingReadyList so must be called from a critical
-         * section. */
+        configASSERT( pxPreviousWakeTime );
+        configASSERT( ( xTimeIncrement > 0U ) );
+        configASSERT( uxSchedulerSuspended == 0 );
 
-        /* It does not make sense to check if the calling task is suspended. */
-        configASSERT( xTask );
+        taskSTOP_DYNAMIC_TICK();
 
-        /* Is the task being resumed actually in the suspended list? */
-        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        vTaskSuspendAll();
         {
-            /* Has the task already been resumed from within an ISR? */
-            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            /* Minor optimisation.  The tick count cannot change in this
+             * block. */
+            const TickType_t xConstTickCount = xTickCount;
+
+            /* Generate the tick time at which the task wants to wake. */
+            xTimeToWake = *pxPreviousWakeTime + xTimeIncrement;
+
+            if( xConstTickCount < *pxPreviousWakeTime )
             {
-                /* Is it in the suspended list because it is in the Suspended
-                 * state, or because is is blocked with no timeout? */
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTCB->xEventListItem ) ) != pdFALSE ) /*lint !e961.  The cast is only redundant when NULL is used. */
+                /* The tick count has overflowed since this function was
+                 * lasted called.  In this case the only time we should ever
+                 * actually delay is if the wake time has also  overflowed,
+                 * and the wake time is greater than the tick time.  When this
+                 * is the case it is as if neither time had overflowed. */
+                if( ( xTimeToWake < *pxPreviousWakeTime ) && ( xTimeToWake > xConstTickCount ) )
                 {
-                    xReturn = pdTRUE;
+                    xShouldDelay = pdTRUE;
                 }
                 else
                 {
@@ -1808,217 +3503,1711 @@ static void prvAddNewTaskToReadyList( TCB_t * pxNewTCB )
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* The tick time has not overflowed.  In this case we will
+                 * delay if either the wake time has overflowed, and/or the
+                 * tick time is less than the wake time. */
+                if( ( xTimeToWake < *pxPreviousWakeTime ) || ( xTimeToWake > xConstTickCount ) )
+                {
+                    xShouldDelay = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        return xReturn;
-    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
-
-#endif /* INCLUDE_vTaskSuspend */
-/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskSuspend == 1 )
-
-    void vTaskResume( TaskHandle_t xTaskToResume )
-    {
-        TCB_t * const pxTCB = xTaskToResume;
-
-        /* It does not make sense to resume the calling task. */
-        configASSERT( xTaskToResume );
+            /* Update the wake time ready for the next call. */
+            *pxPreviousWakeTime = xTimeToWake;
 
-        /* The parameter cannot be NULL as it is impossible to resume the
-         * currently executing task. */
-        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
-        {
-            taskENTER_CRITICAL();
+            #if ( configUSE_EDF_SCHEDULING == 1 )
             {
-                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
-                {
-                    traceTASK_RESUME( pxTCB );
-
-                    /* The ready list can be accessed even if the scheduler is
-                     * suspended because this is inside a critical section. */
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                TCB_t * const pxTCB = pxCurrentTCB;
 
-                    /* A higher priority task may have just been resumed. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                /* The wake time is the next release of a task that has a
+                 * deadline, so its deadline moves on to that of the release. */
+                if( pxTCB->xRelativeDeadline > ( TickType_t ) 0U )
+                {
+                    if( taskTICK_IS_BEFORE( pxTCB->xAbsoluteDeadline, xConstTickCount ) != pdFALSE )
                     {
-                        /* This yield may not cause the task just resumed to run,
-                         * but will leave the lists in the correct state for the
-                         * next yield. */
-                        taskYIELD_IF_USING_PREEMPTION();
+                        traceTASK_DEADLINE_MISSED( pxTCB );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    taskENTER_CRITICAL();
+                    {
+                        pxTCB->xAbsoluteDeadline = xTimeToWake + pxTCB->xRelativeDeadline;
+
+                        /* A task that does not delay because its next release
+                         * has already passed stays in the ready list, which
+                         * must be kept in deadline order. */
+                        if( ( xShouldDelay == pdFALSE ) &&
+                            ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ configEDF_PRIORITY ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+                        {
+                            listFAST_REMOVE( &( pxTCB->xStateListItem ) );
+                            prvAddTaskToDeadlineOrderedList( pxTCB );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    taskEXIT_CRITICAL();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            taskEXIT_CRITICAL();
+            #endif /* configUSE_EDF_SCHEDULING */
+
+            if( xShouldDelay != pdFALSE )
+            {
+                traceTASK_DELAY_UNTIL( xTimeToWake );
+
+                /* prvAddCurrentTaskToDelayedList() needs the block time, not
+                 * the time to wake, so subtract the current tick count. */
+                prvAddCurrentTaskToDelayedList( xTimeToWake - xConstTickCount, pdFALSE );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        xAlreadyYielded = xTaskResumeAll();
+
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
+        {
+            portYIELD_WITHIN_API();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
-
-#endif /* INCLUDE_vTaskSuspend */
-
-/*-----------------------------------------------------------*/
-
-#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
-
-    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
-    {
-        BaseType_t xYieldRequired = pdFALSE;
-        TCB_t * const pxTCB = xTaskToResume;
-        UBaseType_t uxSavedInterruptStatus;
 
-        configASSERT( xTaskToResume );
-
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
-
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        #if ( configUSE_PERIODIC_TASK_STATS == 1 )
         {
-            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
-            {
-                traceTASK_RESUME_FROM_ISR( pxTCB );
+            TickType_t xLateness = prvRecordPeriodicRelease( xTimeToWake, xShouldDelay );
 
-                /* Check the ready lists can be accessed. */
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            #if ( configUSE_PERIODIC_OVERRUN_HOOK == 1 )
+            {
+                if( xShouldDelay == pdFALSE )
                 {
-                    /* Ready lists can be accessed so move the task from the
-                     * suspended list to the ready list directly. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                    {
-                        xYieldRequired = pdTRUE;
-
-                        /* Mark that a yield is pending in case the user is not
-                         * using the return value to initiate a context switch
-                         * from the ISR using portYIELD_FROM_ISR. */
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-
-                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
+                    /* Called from the task itself rather than from within the
+                     * kernel so the hook can log or take corrective action. */
+                    vApplicationTaskOverrunHook( pxCurrentTCB, xLateness );
                 }
                 else
                 {
-                    /* The delayed or ready lists cannot be accessed so the task
-                     * is held in the pending ready list until the scheduler is
-                     * unsuspended. */
-                    vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else
+            #else
             {
-                mtCOVERAGE_TEST_MARKER();
+                ( void ) xLateness;
             }
+            #endif /* configUSE_PERIODIC_OVERRUN_HOOK */
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        #endif /* configUSE_PERIODIC_TASK_STATS */
 
-        return xYieldRequired;
+        return xShouldDelay;
     }
 
-#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+#endif /* INCLUDE_xTaskDelayUntil */
 /*-----------------------------------------------------------*/
 
-void vTaskStartScheduler( void )
-{
-    BaseType_t xReturn;
+#if ( INCLUDE_vTaskDelay == 1 )
 
-    /* Add the idle task at the lowest priority. */
-    #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+    void vTaskDelay( const TickType_t xTicksToDelay )
     {
-        StaticTask_t * pxIdleTaskTCBBuffer = NULL;
-        StackType_t * pxIdleTaskStackBuffer = NULL;
-        uint32_t ulIdleTaskStackSize;
+        BaseType_t xAlreadyYielded = pdFALSE;
+
+        /* A delay time of zero just forces a reschedule. */
+        if( xTicksToDelay > ( TickType_t ) 0U )
+        {
+            configASSERT( uxSchedulerSuspended == 0 );
+            vTaskSuspendAll();
+            {
+                traceTASK_DELAY();
 
-        /* The Idle task is created using user provided RAM - obtain the
-         * address of the RAM then create the idle task. */
-        vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
-        xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
-                                             configIDLE_TASK_NAME,
-                                             ulIdleTaskStackSize,
-                                             ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
-                                             portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                                             pxIdleTaskStackBuffer,
-                                             pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+                /* A task that is removed from the event list while the
+                 * scheduler is suspended will not get placed in the ready
+                 * list or removed from the blocked list until the scheduler
+                 * is resumed.
+                 *
+                 * This task cannot be in an event list as it is the currently
+                 * executing task. */
+                prvAddCurrentTaskToDelayedList( xTicksToDelay, pdFALSE );
+            }
+            xAlreadyYielded = xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        if( xIdleTaskHandle != NULL )
+        /* Force a reschedule if xTaskResumeAll has not already done so, we may
+         * have put ourselves to sleep. */
+        if( xAlreadyYielded == pdFALSE )
         {
-            xReturn = pdPASS;
+            portYIELD_WITHIN_API();
         }
         else
         {
-            xReturn = pdFAIL;
+            mtCOVERAGE_TEST_MARKER();
         }
     }
-    #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
-    {
-        /* The Idle task is being created using dynamically allocated RAM. */
-        xReturn = xTaskCreate( prvIdleTask,
-                               configIDLE_TASK_NAME,
-                               configMINIMAL_STACK_SIZE,
-                               ( void * ) NULL,
-                               portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
-                               &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
-    }
-    #endif /* configSUPPORT_STATIC_ALLOCATION */
 
-    #if ( configUSE_TIMERS == 1 )
+#endif /* INCLUDE_vTaskDelay */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_vTaskDelay == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+
+    void vTaskDelayWithSlack( const TickType_t xTicksToDelay,
+                              const TickType_t xSlackInTicks )
     {
-        if( xReturn == pdPASS )
+        BaseType_t xAlreadyYielded = pdFALSE;
+
+        /* A delay time of zero just forces a reschedule. */
+        if( xTicksToDelay > ( TickType_t ) 0U )
         {
-            xReturn = xTimerCreateTimerTask();
+            configASSERT( uxSchedulerSuspended == 0 );
+            vTaskSuspendAll();
+            {
+                traceTASK_DELAY();
+
+                /* As per vTaskDelay(), but the delay is first extended to the
+                 * wake time of another task if that is within the slack. */
+                prvAddCurrentTaskToDelayedList( prvGetCoalescedDelay( xTicksToDelay, xSlackInTicks ), pdFALSE );
+            }
+            xAlreadyYielded = xTaskResumeAll();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
-    }
-    #endif /* configUSE_TIMERS */
 
-    if( xReturn == pdPASS )
-    {
-        /* freertos_tasks_c_additions_init() should only be called if the user
-         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
-         * the only macro called by the function. */
-        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+        if( xAlreadyYielded == pdFALSE )
         {
-            freertos_tasks_c_additions_init();
+            portYIELD_WITHIN_API();
         }
-        #endif
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( INCLUDE_vTaskDelay == 1 ) && ( configUSE_TIMER_SLACK == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_eTaskGetState == 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_xTaskAbortDelay == 1 ) )
+
+    eTaskState eTaskGetState( TaskHandle_t xTask )
+    {
+        eTaskState eReturn;
+        List_t const * pxStateList;
+        List_t const * pxDelayedList;
+        List_t const * pxOverflowedDelayedList;
+        const TCB_t * const pxTCB = xTask;
+
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            List_t const * pxWheelSlot;
+        #endif
+
+        configASSERT( pxTCB );
+
+        if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+        {
+            /* The task calling this function is querying its own state, or on a
+             * multi-core system the task is running on another core. */
+            eReturn = eRunning;
+        }
+        else
+        {
+            taskENTER_CRITICAL();
+            {
+                pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
+                pxDelayedList = pxDelayedTaskList;
+                pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    /* A task in the wheel is in the slot of its wake time. */
+                    pxWheelSlot = &( xDelayedTaskWheel[ listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) & taskDELAYED_TASK_WHEEL_MASK ] );
+                }
+                #endif
+            }
+            taskEXIT_CRITICAL();
+
+            if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+            {
+                /* The task being queried is referenced from one of the Blocked
+                 * lists. */
+                eReturn = eBlocked;
+            }
+
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                else if( pxStateList == pxWheelSlot )
+                {
+                    /* The task being queried is in the delayed task wheel. */
+                    eReturn = eBlocked;
+                }
+            #endif
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+                else if( pxStateList == &xSuspendedTaskList )
+                {
+                    /* The task being queried is referenced from the suspended
+                     * list.  Is it genuinely suspended or is it blocked
+                     * indefinitely? */
+                    if( taskIS_WAITING_ON_EVENT( pxTCB ) == pdFALSE )
+                    {
+                        #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+                        {
+                            BaseType_t x;
+
+                            /* The task does not appear on the event list item of
+                             * and of the RTOS objects, but could still be in the
+                             * blocked state if it is waiting on its notification
+                             * rather than waiting on an object.  If not, is
+                             * suspended. */
+                            eReturn = eSuspended;
+
+                            for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                            {
+                                if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                                {
+                                    eReturn = eBlocked;
+                                    break;
+                                }
+                            }
+                        }
+                        #else /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                        {
+                            eReturn = eSuspended;
+                        }
+                        #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+                    }
+                    else
+                    {
+                        eReturn = eBlocked;
+                    }
+                }
+            #endif /* if ( INCLUDE_vTaskSuspend == 1 ) */
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+                else if( ( pxStateList == &xTasksWaitingTermination ) || ( pxStateList == NULL ) )
+                {
+                    /* The task being queried is referenced from the deleted
+                     * tasks list, or it is not referenced from any lists at
+                     * all. */
+                    eReturn = eDeleted;
+                }
+            #endif
+
+            else /*lint !e525 Negative indentation is intended to make use of pre-processor clearer. */
+            {
+                /* If the task is not in any other state, it must be in the
+                 * Ready (including pending ready) state. */
+                eReturn = eReady;
+            }
+        }
+
+        return eReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+
+#endif /* INCLUDE_eTaskGetState */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
+
+    UBaseType_t uxTaskPriorityGet( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the priority of the task
+             * that called uxTaskPriorityGet() that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPriority;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskPriorityGet == 1 )
+
+    UBaseType_t uxTaskPriorityGetFromISR( const TaskHandle_t xTask )
+    {
+        TCB_t const * pxTCB;
+        UBaseType_t uxReturn, uxSavedInterruptState;
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being queried. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPriority;
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskPriorityGet */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskPrioritySet == 1 )
+
+    void vTaskPrioritySet( TaskHandle_t xTask,
+                           UBaseType_t uxNewPriority )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxCurrentBasePriority, uxPriorityUsedOnEntry;
+        UBaseType_t uxItemsRemaining;
+        BaseType_t xYieldRequired = pdFALSE;
+
+        #if ( configNUMBER_OF_CORES > 1 )
+            BaseType_t xYieldForTask = pdFALSE;
+        #endif
+
+        configASSERT( uxNewPriority < configMAX_PRIORITIES );
+
+        /* Ensure the new priority is valid. */
+        if( uxNewPriority >= ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            uxNewPriority = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the priority of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            traceTASK_PRIORITY_SET( pxTCB, uxNewPriority );
+
+            #if ( configUSE_MUTEXES == 1 )
+            {
+                uxCurrentBasePriority = pxTCB->uxBasePriority;
+            }
+            #else
+            {
+                uxCurrentBasePriority = pxTCB->uxPriority;
+            }
+            #endif
+
+            if( uxCurrentBasePriority != uxNewPriority )
+            {
+                /* The priority change may have readied a task of higher
+                 * priority than the calling task. */
+                if( uxNewPriority > uxCurrentBasePriority )
+                {
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        if( pxTCB != pxCurrentTCB )
+                        {
+                            /* The priority of a task other than the currently
+                             * running task is being raised.  Is the priority being
+                             * raised above that of the running task? */
+                            if( uxNewPriority > pxCurrentTCB->uxPriority )
+                            {
+                                xYieldRequired = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        else
+                        {
+                            /* The priority of the running task is being raised,
+                             * but the running task must already be the highest
+                             * priority task able to run so no yield is required. */
+                        }
+                    }
+                    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+                    {
+                        /* The priority of a task is being raised, so it may now
+                         * be able to preempt the task running on one of the
+                         * cores.  That is checked once its priority has been
+                         * updated. */
+                        xYieldForTask = pdTRUE;
+                    }
+                    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+                }
+                else if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                {
+                    /* Setting the priority of the running task down means
+                     * there may now be another task of higher priority that
+                     * is ready to execute. */
+                    xYieldRequired = pdTRUE;
+                }
+                else
+                {
+                    /* Setting the priority of any other task down does not
+                     * require a yield as the running task must be above the
+                     * new priority of the task being modified. */
+                }
+
+                /* Remember the ready list the task might be referenced from
+                 * before its uxPriority member is changed so the
+                 * taskRESET_READY_PRIORITY() macro can function correctly. */
+                uxPriorityUsedOnEntry = pxTCB->uxPriority;
+
+                #if ( configUSE_MUTEXES == 1 )
+                {
+                    /* Only change the priority being used if the task is not
+                     * currently using an inherited priority. */
+                    if( pxTCB->uxBasePriority == pxTCB->uxPriority )
+                    {
+                        pxTCB->uxPriority = uxNewPriority;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* The base priority gets set whatever. */
+                    pxTCB->uxBasePriority = uxNewPriority;
+                }
+                #else /* if ( configUSE_MUTEXES == 1 ) */
+                {
+                    pxTCB->uxPriority = uxNewPriority;
+                }
+                #endif /* if ( configUSE_MUTEXES == 1 ) */
+
+                /* Only reset the event list item value if the value is not
+                 * being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                {
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* If the task is in the blocked or suspended list we need do
+                 * nothing more than change its priority variable. However, if
+                 * the task is in a ready list it needs to be removed and placed
+                 * in the list appropriate to its new priority. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                {
+                    /* The task is currently in its ready list - remove before
+                     * adding it to its new ready list.  As we are in a critical
+                     * section we can do this even if the scheduler is suspended. */
+                    listFAST_REMOVE_COUNT( &( pxTCB->xStateListItem ), uxItemsRemaining );
+
+                    if( uxItemsRemaining == ( UBaseType_t ) 0 )
+                    {
+                        /* It is known that the task is in its ready list so
+                         * there is no need to check again and the port level
+                         * reset macro can be called directly. */
+                        portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xYieldRequired != pdFALSE )
+                {
+                    #if ( configNUMBER_OF_CORES == 1 )
+                        taskYIELD_IF_USING_PREEMPTION();
+                    #else
+                        taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+                    #endif
+                }
+                else
+                {
+                    #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+                    {
+                        if( xYieldForTask != pdFALSE )
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                    }
+                    #endif
+
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Remove compiler warning about unused variables when the port
+                 * optimised task selection is not being used. */
+                ( void ) uxPriorityUsedOnEntry;
+
+                #if ( configNUMBER_OF_CORES > 1 )
+                    ( void ) xYieldForTask;
+                #endif
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* INCLUDE_vTaskPrioritySet */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CORE_AFFINITY == 1 )
+
+    void vTaskCoreAffinitySet( const TaskHandle_t xTask,
+                               UBaseType_t uxCoreAffinityMask )
+    {
+        TCB_t * pxTCB;
+        BaseType_t xCoreID;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the affinity of the calling
+             * task that is being changed. */
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                {
+                    xCoreID = pxTCB->xTaskRunState;
+
+                    /* The task must leave a core it is no longer allowed to
+                     * run on. */
+                    if( taskCAN_RUN_ON_CORE( pxTCB, xCoreID ) == pdFALSE )
+                    {
+                        prvYieldCore( xCoreID );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    #if ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* The task may now be allowed on a core running a
+                         * lower priority task. */
+                        prvYieldForTask( pxTCB );
+                    }
+                    #endif
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CORE_AFFINITY == 1 )
+
+    UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxCoreAffinityMask;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxCoreAffinityMask;
+    }
+
+#endif /* configUSE_CORE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_WAKE_AFFINITY == 1 )
+
+    uint32_t ulTaskGetCrossCoreYieldCount( void )
+    {
+        return ulCrossCoreYields;
+    }
+
+#endif /* configUSE_WAKE_AFFINITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    void vTaskSetBudget( TaskHandle_t xTask,
+                         TickType_t xBudgetTicks,
+                         TickType_t xPeriodTicks )
+    {
+        TCB_t * pxTCB;
+
+        configASSERT( ( xBudgetTicks == ( TickType_t ) 0U ) || ( xBudgetTicks <= xPeriodTicks ) );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* Throttling an idle task would leave a core with no task to run. */
+            #if ( configNUMBER_OF_CORES == 1 )
+                configASSERT( pxTCB != xIdleTaskHandle );
+            #else
+                configASSERT( ( pxTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U );
+            #endif
+
+            /* A task that is throttled when its budget is changed still waits
+             * for the end of its current budget period. */
+            pxTCB->xBudgetTicks = xBudgetTicks;
+            pxTCB->xBudgetPeriod = xPeriodTicks;
+            pxTCB->xBudgetRemaining = xBudgetTicks;
+            pxTCB->xBudgetPeriodStart = xTickCount;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONS == 1 )
+
+    void vTaskSetPartitionSchedule( const TimePartitionWindow_t * const pxWindows,
+                                    UBaseType_t uxNumberOfWindows )
+    {
+        UBaseType_t uxWindow;
+
+        configASSERT( pxWindows );
+        configASSERT( uxNumberOfWindows > ( UBaseType_t ) 0U );
+
+        for( uxWindow = ( UBaseType_t ) 0U; uxWindow < uxNumberOfWindows; uxWindow++ )
+        {
+            configASSERT( pxWindows[ uxWindow ].uxPartition <= ( UBaseType_t ) configNUMBER_OF_TIME_PARTITIONS );
+            configASSERT( pxWindows[ uxWindow ].xDurationTicks > ( TickType_t ) 0U );
+        }
+
+        taskENTER_CRITICAL();
+        {
+            pxPartitionWindows = pxWindows;
+            uxNumberOfPartitionWindows = uxNumberOfWindows;
+            uxPartitionWindow = ( UBaseType_t ) 0U;
+            xPartitionWindowTicksLeft = pxWindows[ 0 ].xDurationTicks;
+
+            /* Before the scheduler starts the first window is activated by
+             * vTaskStartScheduler(), once the idle task exists. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                if( prvActivatePartition( pxWindows[ 0 ].uxPartition ) != pdFALSE )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TIME_PARTITIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONS == 1 )
+
+    void vTaskSetPartition( TaskHandle_t xTask,
+                            UBaseType_t uxPartition )
+    {
+        TCB_t * pxTCB;
+
+        configASSERT( uxPartition <= ( UBaseType_t ) configNUMBER_OF_TIME_PARTITIONS );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* The idle task must be able to run in every window. */
+            configASSERT( ( pxTCB != xIdleTaskHandle ) || ( uxPartition == ( UBaseType_t ) 0U ) );
+
+            if( ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) ||
+                ( listIS_CONTAINED_WITHIN( &( xParkedTaskLists[ pxTCB->uxPartition ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                /* The task is ready to run, so is moved to the ready or
+                 * parked list that matches its new partition. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+
+                pxTCB->uxPartition = uxPartition;
+                prvAddTaskToReadyList( pxTCB );
+
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    if( taskPARTITION_IS_ACTIVE( pxTCB ) == pdFALSE )
+                    {
+                        /* Yield if the running task has been parked. */
+                        if( pxTCB == pxCurrentTCB )
+                        {
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The task is blocked or suspended, so is placed according
+                 * to its new partition when it is next ready. */
+                pxTCB->uxPartition = uxPartition;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TIME_PARTITIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONS == 1 )
+
+    UBaseType_t uxTaskGetPartition( const TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxPartition;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_TIME_PARTITIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONS == 1 )
+
+    UBaseType_t uxTaskGetActivePartition( void )
+    {
+        return uxActivePartition;
+    }
+
+#endif /* configUSE_TIME_PARTITIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+    void vTaskSetCriticality( TaskHandle_t xTask,
+                              UBaseType_t uxCriticality )
+    {
+        TCB_t * pxTCB;
+
+        configASSERT( ( uxCriticality == tskCRITICALITY_LOW ) || ( uxCriticality == tskCRITICALITY_HIGH ) );
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            /* Shedding the idle task would leave no task to run. */
+            configASSERT( ( pxTCB != xIdleTaskHandle ) || ( uxCriticality == tskCRITICALITY_HIGH ) );
+
+            if( ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) ||
+                ( listIS_CONTAINED_WITHIN( &xShedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                /* The task is ready to run, so is moved to the ready or shed
+                 * list that matches its new criticality. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+
+                pxTCB->uxCriticality = uxCriticality;
+                prvAddTaskToReadyList( pxTCB );
+
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    if( taskTASK_IS_SHED( pxTCB ) != pdFALSE )
+                    {
+                        /* Yield if the running task has been shed. */
+                        if( pxTCB == pxCurrentTCB )
+                        {
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                /* The task is blocked or suspended, so is placed according
+                 * to its new criticality when it is next ready. */
+                pxTCB->uxCriticality = uxCriticality;
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+    UBaseType_t uxTaskGetCriticality( const TaskHandle_t xTask )
+    {
+        const TCB_t * pxTCB;
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            uxReturn = pxTCB->uxCriticality;
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+    void vTaskSetCriticalityMode( UBaseType_t uxMode )
+    {
+        configASSERT( ( uxMode == tskCRITICALITY_LOW ) || ( uxMode == tskCRITICALITY_HIGH ) );
+
+        taskENTER_CRITICAL();
+        {
+            if( uxMode != uxCriticalityMode )
+            {
+                if( prvSetCriticalityMode( uxMode ) != pdFALSE )
+                {
+                    if( xSchedulerRunning != pdFALSE )
+                    {
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else if( uxMode == tskCRITICALITY_HIGH )
+            {
+                /* Asking for high criticality mode again restarts the time
+                 * before the kernel can return to low criticality mode. */
+                xCriticalityHoldOffTicks = ( TickType_t ) 0U;
+                xIdleRanInHighMode = pdFALSE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+    UBaseType_t uxTaskGetCriticalityMode( void )
+    {
+        return uxCriticalityMode;
+    }
+
+#endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PER_PRIORITY_TIME_SLICE == 1 )
+
+    void vTaskSetTimeSliceLength( UBaseType_t uxPriority,
+                                  TickType_t xTicks )
+    {
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        if( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            taskENTER_CRITICAL();
+            {
+                xTimeSliceLengths[ uxPriority ] = xTicks;
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xTaskGetTimeSliceLength( UBaseType_t uxPriority )
+    {
+        TickType_t xReturn = ( TickType_t ) 0U;
+
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        if( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            xReturn = taskTIME_SLICE_LENGTH( uxPriority );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_PER_PRIORITY_TIME_SLICE */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    void vTaskSuspend( TaskHandle_t xTaskToSuspend )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxItemsRemaining;
+
+        taskENTER_CRITICAL();
+        {
+            /* If null is passed in here then it is the running task that is
+             * being suspended. */
+            pxTCB = prvGetTCBFromHandle( xTaskToSuspend );
+
+            traceTASK_SUSPEND( pxTCB );
+
+            #if ( configUSE_TASK_STATE_COUNTS == 1 )
+            {
+                if( prvTaskIsInSuspendedState( pxTCB ) == pdFALSE )
+                {
+                    uxSuspendedTaskCount++;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
+            /* Remove task from the ready/delayed list and place in the
+             * suspended list. */
+            listFAST_REMOVE_COUNT( &( pxTCB->xStateListItem ), uxItemsRemaining );
+
+            if( uxItemsRemaining == ( UBaseType_t ) 0 )
+            {
+                taskRESET_READY_PRIORITY( pxTCB->uxPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* Is the task waiting on an event also? */
+            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+            {
+                listFAST_REMOVE( &( pxTCB->xEventListItem ) );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+            {
+                ( void ) prvRemoveWaitRecords( pxTCB, NULL );
+            }
+            #endif
+
+            listFAST_INSERT_END( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            {
+                BaseType_t x;
+
+                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                {
+                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                    {
+                        /* The task was blocked to wait for a notification, but is
+                         * now suspended, so no notification was received. */
+                        pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+                    }
+                }
+            }
+            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Force a reschedule on the core running the task that has
+                 * just been suspended.  If that is this core then the yield is
+                 * performed when the critical section is exited. */
+                if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) )
+                {
+                    if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+                    {
+                        configASSERT( uxSchedulerSuspended == 0 );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    prvYieldCore( pxTCB->xTaskRunState );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* #if ( configNUMBER_OF_CORES > 1 ) */
+        }
+        taskEXIT_CRITICAL();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Reset the next expected unblock time in case it referred to the
+             * task that is now in the Suspended state. */
+            taskENTER_CRITICAL();
+            {
+                prvResetNextTaskUnblockTime();
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( pxTCB == pxCurrentTCB )
+            {
+                if( xSchedulerRunning != pdFALSE )
+                {
+                    /* The current task has just been suspended. */
+                    configASSERT( uxSchedulerSuspended == 0 );
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    /* The scheduler is not running, but the task that was pointed
+                     * to by pxCurrentTCB has just been suspended and pxCurrentTCB
+                     * must be adjusted to point to a different task. */
+                    if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == uxCurrentNumberOfTasks ) /*lint !e931 Right has no side effect, just volatile. */
+                    {
+                        /* No other tasks are ready, so set pxCurrentTCB back to
+                         * NULL so when the next task is created pxCurrentTCB will
+                         * be set to point to it no matter what its relative priority
+                         * is. */
+                        pxCurrentTCB = NULL;
+                    }
+                    else
+                    {
+                        vTaskSwitchContext();
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* #if ( configNUMBER_OF_CORES == 1 ) */
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    static BaseType_t prvTaskIsTaskSuspended( const TaskHandle_t xTask )
+    {
+        BaseType_t xReturn = pdFALSE;
+        const TCB_t * const pxTCB = xTask;
+
+        /* Accesses xPendingReadyList so must be called from a critical
+         * section. */
+
+        /* It does not make sense to check if the calling task is suspended. */
+        configASSERT( xTask );
+
+        /* Is the task being resumed actually in the suspended list? */
+        if( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE )
+        {
+            /* Has the task already been resumed from within an ISR? */
+            if( listIS_CONTAINED_WITHIN( &xPendingReadyList, &( pxTCB->xEventListItem ) ) == pdFALSE )
+            {
+                /* Is it in the suspended list because it is in the Suspended
+                 * state, or because is is blocked with no timeout? */
+                if( taskIS_WAITING_ON_EVENT( pxTCB ) == pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    } /*lint !e818 xTask cannot be a pointer to const because it is a typedef. */
+
+#endif /* INCLUDE_vTaskSuspend */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TASK_STATE_COUNTS == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+
+    static BaseType_t prvTaskIsInSuspendedState( const TCB_t * pxTCB )
+    {
+        BaseType_t xReturn = pdFALSE;
+
+        /* The same tests as eTaskGetState() makes for a task referenced from
+         * the suspended list.  A task resumed from an ISR while the scheduler
+         * was suspended is in the pending ready list, so is waiting on an
+         * event. */
+        if( ( listIS_CONTAINED_WITHIN( &xSuspendedTaskList, &( pxTCB->xStateListItem ) ) != pdFALSE ) &&
+            ( taskIS_WAITING_ON_EVENT( pxTCB ) == pdFALSE ) )
+        {
+            xReturn = pdTRUE;
+
+            #if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            {
+                BaseType_t x;
+
+                for( x = 0; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                {
+                    if( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION )
+                    {
+                        xReturn = pdFALSE;
+                        break;
+                    }
+                }
+            }
+            #endif /* if ( configUSE_TASK_NOTIFICATIONS == 1 ) */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* ( ( configUSE_TASK_STATE_COUNTS == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskSuspend == 1 )
+
+    void vTaskResume( TaskHandle_t xTaskToResume )
+    {
+        TCB_t * const pxTCB = xTaskToResume;
+
+        /* It does not make sense to resume the calling task. */
+        configASSERT( xTaskToResume );
+
+        /* The parameter cannot be NULL as it is impossible to resume the
+         * currently executing task. */
+        if( ( pxTCB != pxCurrentTCB ) && ( pxTCB != NULL ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+                {
+                    traceTASK_RESUME( pxTCB );
+
+                    #if ( configUSE_TASK_STATE_COUNTS == 1 )
+                    {
+                        if( prvTaskIsInSuspendedState( pxTCB ) != pdFALSE )
+                        {
+                            uxSuspendedTaskCount--;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif
+
+                    /* The ready list can be accessed even if the scheduler is
+                     * suspended because this is inside a critical section. */
+                    listFAST_REMOVE( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* A higher priority task may have just been resumed. */
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
+                        {
+                            /* This yield may not cause the task just resumed to run,
+                             * but will leave the lists in the correct state for the
+                             * next yield. */
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #elif ( configUSE_PREEMPTION == 1 )
+                    {
+                        prvYieldForTask( pxTCB );
+                    }
+                    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* INCLUDE_vTaskSuspend */
+
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) )
+
+    BaseType_t xTaskResumeFromISR( TaskHandle_t xTaskToResume )
+    {
+        BaseType_t xYieldRequired = pdFALSE;
+        TCB_t * const pxTCB = xTaskToResume;
+        UBaseType_t uxSavedInterruptStatus;
+
+        configASSERT( xTaskToResume );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
+            {
+                traceTASK_RESUME_FROM_ISR( pxTCB );
+                taskRECORD_ISR_WAKE( pxTCB );
+
+                #if ( configUSE_TASK_STATE_COUNTS == 1 )
+                {
+                    if( prvTaskIsInSuspendedState( pxTCB ) != pdFALSE )
+                    {
+                        uxSuspendedTaskCount--;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+
+                /* Check the ready lists can be accessed. */
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    /* Ready lists can be accessed so move the task from the
+                     * suspended list to the ready list directly. */
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+
+                            /* Mark that a yield is pending in case the user is not
+                             * using the return value to initiate a context switch
+                             * from the ISR using portYIELD_FROM_ISR. */
+                            xYieldPending = pdTRUE;
+                            portPEND_YIELD_FROM_ISR();
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+                    listFAST_REMOVE( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed or ready lists cannot be accessed so the task
+                     * is held in the pending ready list until the scheduler is
+                     * unsuspended. */
+                    listFAST_INSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
+
+                #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) )
+                {
+                    /* Request a yield on the core that should run the resumed
+                     * task, which holds the yield pending if the scheduler is
+                     * suspended. */
+                    prvYieldForTask( pxTCB );
+
+                    if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                    {
+                        xYieldRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* #if ( ( configNUMBER_OF_CORES > 1 ) && ( configUSE_PREEMPTION == 1 ) ) */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return xYieldRequired;
+    }
+
+#endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvCreateIdleTasks( void )
+{
+    BaseType_t xReturn = pdPASS;
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* Add the idle task at the lowest priority. */
+        #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+        {
+            StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+            StackType_t * pxIdleTaskStackBuffer = NULL;
+            uint32_t ulIdleTaskStackSize;
+
+            /* The Idle task is created using user provided RAM - obtain the
+             * address of the RAM then create the idle task. */
+            vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+            xIdleTaskHandle = xTaskCreateStatic( prvIdleTask,
+                                                 configIDLE_TASK_NAME,
+                                                 ulIdleTaskStackSize,
+                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                 pxIdleTaskStackBuffer,
+                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+            if( xIdleTaskHandle != NULL )
+            {
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+        {
+            /* The Idle task is being created using dynamically allocated RAM. */
+            xReturn = xTaskCreate( prvIdleTask,
+                                   configIDLE_TASK_NAME,
+                                   configMINIMAL_STACK_SIZE,
+                                   ( void * ) NULL,
+                                   portPRIVILEGE_BIT,  /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                   &xIdleTaskHandle ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+        }
+        #endif /* configSUPPORT_STATIC_ALLOCATION */
+    }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+    {
+        BaseType_t xCoreID;
+        UBaseType_t uxNameLength;
+        TaskFunction_t pxIdleTaskFunction;
+        char cIdleName[ configMAX_TASK_NAME_LEN + 3 ]; /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+
+        /* The idle tasks are named configIDLE_TASK_NAME followed by the number
+         * of the core they run on. */
+        for( uxNameLength = ( UBaseType_t ) 0; uxNameLength < ( UBaseType_t ) configMAX_TASK_NAME_LEN; uxNameLength++ )
+        {
+            cIdleName[ uxNameLength ] = configIDLE_TASK_NAME[ uxNameLength ];
+
+            if( cIdleName[ uxNameLength ] == ( char ) 0x00 )
+            {
+                break;
+            }
+        }
+
+        for( xCoreID = ( BaseType_t ) 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+        {
+            if( xCoreID < ( BaseType_t ) 10 )
+            {
+                cIdleName[ uxNameLength ] = ( char ) ( xCoreID + ( BaseType_t ) '0' );
+                cIdleName[ uxNameLength + 1U ] = ( char ) 0x00;
+            }
+            else
+            {
+                cIdleName[ uxNameLength ] = ( char ) ( ( xCoreID / ( BaseType_t ) 10 ) + ( BaseType_t ) '0' );
+                cIdleName[ uxNameLength + 1U ] = ( char ) ( ( xCoreID % ( BaseType_t ) 10 ) + ( BaseType_t ) '0' );
+                cIdleName[ uxNameLength + 2U ] = ( char ) 0x00;
+            }
+
+            /* Only the idle task on the first core frees the memory of deleted
+             * tasks and calls the idle hook. */
+            if( xCoreID == ( BaseType_t ) 0 )
+            {
+                pxIdleTaskFunction = prvIdleTask;
+            }
+            else
+            {
+                pxIdleTaskFunction = prvPassiveIdleTask;
+            }
+
+            #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+            {
+                StaticTask_t * pxIdleTaskTCBBuffer = NULL;
+                StackType_t * pxIdleTaskStackBuffer = NULL;
+                uint32_t ulIdleTaskStackSize;
+
+                /* The Idle tasks are created using user provided RAM - obtain
+                 * the address of the RAM then create the idle task. */
+                if( xCoreID == ( BaseType_t ) 0 )
+                {
+                    vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+                }
+                else
+                {
+                    vApplicationGetPassiveIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID - ( BaseType_t ) 1 );
+                }
+
+                xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic( pxIdleTaskFunction,
+                                                                 cIdleName,
+                                                                 ulIdleTaskStackSize,
+                                                                 ( void * ) NULL,       /*lint !e961.  The cast is not redundant for all compilers. */
+                                                                 portPRIVILEGE_BIT,     /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                                                 pxIdleTaskStackBuffer,
+                                                                 pxIdleTaskTCBBuffer ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+                if( xIdleTaskHandles[ xCoreID ] != NULL )
+                {
+                    xReturn = pdPASS;
+                }
+                else
+                {
+                    xReturn = pdFAIL;
+                }
+            }
+            #else /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+            {
+                /* The Idle tasks are being created using dynamically allocated RAM. */
+                xReturn = xTaskCreate( pxIdleTaskFunction,
+                                       cIdleName,
+                                       configMINIMAL_STACK_SIZE,
+                                       ( void * ) NULL,
+                                       portPRIVILEGE_BIT,               /* In effect ( tskIDLE_PRIORITY | portPRIVILEGE_BIT ), but tskIDLE_PRIORITY is zero. */
+                                       &xIdleTaskHandles[ xCoreID ] ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+            }
+            #endif /* configSUPPORT_STATIC_ALLOCATION */
+        }
+    }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskStartScheduler( void )
+{
+    BaseType_t xReturn;
+
+    #if ( configUSE_STATIC_KERNEL == 1 )
+    {
+        /* Create the objects listed in the static kernel tables. */
+        vStaticKernelCreateObjects();
+    }
+    #endif
+
+    /* Add the idle task(s) at the lowest priority. */
+    xReturn = prvCreateIdleTasks();
+
+    #if ( configUSE_TIMERS == 1 )
+    {
+        if( xReturn == pdPASS )
+        {
+            xReturn = xTimerCreateTimerTask();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TIMERS */
+
+    #if ( configUSE_TASK_REAPER == 1 )
+    {
+        if( xReturn == pdPASS )
+        {
+            xReturn = xTaskCreate( prvReaperTask,
+                                   configTASK_REAPER_NAME,
+                                   configTASK_REAPER_STACK_DEPTH,
+                                   NULL,
+                                   ( ( UBaseType_t ) configTASK_REAPER_PRIORITY ) | portPRIVILEGE_BIT,
+                                   &xReaperTaskHandle );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TASK_REAPER */
+
+    if( xReturn == pdPASS )
+    {
+        /* freertos_tasks_c_additions_init() should only be called if the user
+         * definable macro FREERTOS_TASKS_C_ADDITIONS_INIT() is defined, as that is
+         * the only macro called by the function. */
+        #ifdef FREERTOS_TASKS_C_ADDITIONS_INIT
+        {
+            freertos_tasks_c_additions_init();
+        }
+        #endif
+
+        #if ( configUSE_TIME_PARTITIONS == 1 )
+        {
+            /* The first window of the partition schedule starts now that the
+             * idle task exists. */
+            if( uxNumberOfPartitionWindows > ( UBaseType_t ) 0U )
+            {
+                uxPartitionWindow = ( UBaseType_t ) 0U;
+                xPartitionWindowTicksLeft = pxPartitionWindows[ 0 ].xDurationTicks;
+                ( void ) prvActivatePartition( pxPartitionWindows[ 0 ].uxPartition );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The task selected to run first may have been parked. */
+            if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) == pdFALSE )
+            {
+                taskSELECT_HIGHEST_PRIORITY_TASK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIME_PARTITIONS */
+
+        #if ( configUSE_MIXED_CRITICALITY == 1 )
+        {
+            /* The task selected to run first may have been shed by a call to
+             * vTaskSetCriticalityMode() before the scheduler was started. */
+            if( listIS_CONTAINED_WITHIN( &xShedTaskList, &( pxCurrentTCB->xStateListItem ) ) != pdFALSE )
+            {
+                taskSELECT_HIGHEST_PRIORITY_TASK();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MIXED_CRITICALITY */
 
         /* Interrupts are turned off here, to ensure a tick does not occur
          * before or during the call to xPortStartScheduler().  The stacks of
@@ -2027,246 +5216,5863 @@ void vTaskStartScheduler( void )
          * starts to run. */
         portDISABLE_INTERRUPTS();
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Switch C-Runtime's TLS Block to point to the TLS
+             * block specific to the task that will run first. */
+            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
+
+        xNextTaskUnblockTime = portMAX_DELAY;
+        xSchedulerRunning = pdTRUE;
+        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+
+        #if ( configUSE_TICK_COUNT_64 == 1 )
+        {
+            ullTickCount64[ 0 ] = ( uint64_t ) configINITIAL_TICK_COUNT;
+            ullTickCount64[ 1 ] = ( uint64_t ) configINITIAL_TICK_COUNT;
+        }
+        #endif
+
+        /* If configGENERATE_RUN_TIME_STATS is defined then the following
+         * macro must be defined to configure the timer/counter used to generate
+         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
+         * is set to 0 and the following line fails to build then ensure you do not
+         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
+         * FreeRTOSConfig.h file. */
+        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+
+        #if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+        {
+            UBaseType_t uxWindow;
+            configRUN_TIME_COUNTER_TYPE ulNow;
+
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+            #else
+                ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+
+            /* The first windows start now. */
+            for( uxWindow = 0U; uxWindow < ( UBaseType_t ) tskRUN_TIME_WINDOWS; uxWindow++ )
+            {
+                ulRunTimeWindowStart[ uxWindow ] = ulNow;
+            }
+        }
+        #endif /* configUSE_WINDOWED_RUN_TIME_STATS */
+
+        #if ( configUSE_DVFS_GOVERNOR == 1 )
+        {
+            /* The first governor period starts now. */
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( ulDvfsPeriodStart );
+            #else
+                ulDvfsPeriodStart = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+        }
+        #endif /* configUSE_DVFS_GOVERNOR */
+
+        traceTASK_SWITCHED_IN();
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            taskSET_STACK_GUARD( pxCurrentTCB );
+        }
+        #endif
+
+        /* Setting up the timer tick is hardware specific and thus in the
+         * portable interface. */
+        xPortStartScheduler();
+
+        /* In most cases, xPortStartScheduler() will not return. If it
+         * returns pdTRUE then there was not enough heap memory available
+         * to create either the Idle or the Timer task. If it returned
+         * pdFALSE, then the application called xTaskEndScheduler().
+         * Most ports don't implement xTaskEndScheduler() as there is
+         * nothing to return to. */
+    }
+    else
+    {
+        /* This line will only be reached if the kernel could not be started,
+         * because there was not enough FreeRTOS heap to create the idle task
+         * or the timer task. */
+        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
+    }
+
+    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
+     * meaning xIdleTaskHandle is not used anywhere else. */
+    #if ( configNUMBER_OF_CORES == 1 )
+        ( void ) xIdleTaskHandle;
+    #else
+        ( void ) xIdleTaskHandles;
+    #endif
+
+    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
+     * from getting optimized out as it is no longer used by the kernel. */
+    ( void ) uxTopUsedPriority;
+
+    #if ( configUSE_TCB_HOT_LAYOUT == 1 )
+    {
+        /* As uxTopUsedPriority, for debuggers that read the TCB layout. */
+        ( void ) xTaskControlBlockLayout;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+void vTaskEndScheduler( void )
+{
+    /* Stop the scheduler interrupts and call the portable scheduler end
+     * routine so the original ISRs can be restored if necessary.  The port
+     * layer must ensure interrupts enable  bit is left in the correct state. */
+    portDISABLE_INTERRUPTS();
+    xSchedulerRunning = pdFALSE;
+    vPortEndScheduler();
+}
+/*----------------------------------------------------------*/
+
+void vTaskSuspendAll( void )
+{
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* A critical section is not required as the variable is of type
+         * BaseType_t.  Please read Richard Barry's reply in the following link to a
+         * post in the FreeRTOS support forum before reporting this as a bug! -
+         * https://goo.gl/wu4acr */
+
+        /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
+         * do not otherwise exhibit real time behaviour. */
+        portSOFTWARE_BARRIER();
+
+        /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
+         * is used to allow calls to vTaskSuspendAll() to nest. */
+        ++uxSchedulerSuspended;
+
+        /* Enforces ordering for ports and optimised compilers that may otherwise place
+         * the above increment elsewhere. */
+        portMEMORY_BARRIER();
+
+        #if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+        {
+            /* Interrupts do not access these variables so no critical section
+             * is needed. */
+            if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+            {
+                ulSchedulerSuspendTime = prvGetCriticalSectionTime();
+                pvSchedulerSuspendCaller = portGET_RETURN_ADDRESS();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_CRITICAL_SECTION_PROFILING */
+    }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+    {
+        UBaseType_t uxSavedInterruptStatus;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* Writes to uxSchedulerSuspended must be protected by both the task
+             * and ISR locks.  Interrupts are masked before the locks are
+             * obtained so this task cannot be switched out while it holds them.
+             * The task lock remains held until the matching call to
+             * xTaskResumeAll(), which prevents the other cores from switching
+             * context or entering a critical section while the scheduler is
+             * suspended.  It is safe to unmask interrupts again once
+             * uxSchedulerSuspended has been incremented as that prevents context
+             * switches on this core. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            portGET_TASK_LOCK();
+            portGET_ISR_LOCK();
+
+            ++uxSchedulerSuspended;
+
+            #if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+            {
+                if( uxSchedulerSuspended == ( UBaseType_t ) 1U )
+                {
+                    ulSchedulerSuspendTime = prvGetCriticalSectionTime();
+                    pvSchedulerSuspendCaller = portGET_RETURN_ADDRESS();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_CRITICAL_SECTION_PROFILING */
+
+            portRELEASE_ISR_LOCK();
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    static TickType_t prvGetExpectedIdleTime( void )
+    {
+        TickType_t xReturn;
+        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+
+        /* uxHigherPriorityReadyTasks takes care of the case where
+         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
+         * task that are in the Ready state, even though the idle task is
+         * running. */
+        #if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+        {
+            /* The idle priority is bit 0 of the first group, so any other bit
+             * set in either level means there are higher priority ready tasks. */
+            if( ( ucReadyPriorityGroups > ( uint8_t ) 0x01U ) || ( ucReadyPriorityBitmap[ 0 ] > ( uint8_t ) 0x01U ) )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #elif ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        {
+            if( uxTopReadyPriority > tskIDLE_PRIORITY )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #else
+        {
+            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+
+            /* When port optimised task selection is used the uxTopReadyPriority
+             * variable is used as a bit map.  If bits other than the least
+             * significant bit are set then there are tasks that have a priority
+             * above the idle priority that are in the Ready state.  This takes
+             * care of the case where the co-operative scheduler is in use. */
+            if( uxTopReadyPriority > uxLeastSignificantBit )
+            {
+                uxHigherPriorityReadyTasks = pdTRUE;
+            }
+        }
+        #endif /* if ( configUSE_BITMAP_TASK_SELECTION == 1 ) */
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
+        #else
+            if( prvAllCoresAreIdle() == pdFALSE )
+        #endif
+        {
+            xReturn = 0;
+        }
+        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+        {
+            /* There are other idle priority tasks in the ready state.  If
+             * time slicing is used then the very next tick interrupt must be
+             * processed. */
+            xReturn = 0;
+        }
+        else if( uxHigherPriorityReadyTasks != pdFALSE )
+        {
+            /* There are tasks in the Ready state that have a priority above the
+             * idle priority.  This path can only be reached if
+             * configUSE_PREEMPTION is 0. */
+            xReturn = 0;
+        }
+        else
+        {
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                xReturn = prvGetNextTaskUnblockTime() - xTickCount;
+            }
+            #else
+            {
+                xReturn = xNextTaskUnblockTime - xTickCount;
+            }
+            #endif
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+#if ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configNUMBER_OF_CORES > 1 ) )
+
+    static BaseType_t prvAllCoresAreIdle( void )
+    {
+        BaseType_t xCoreID;
+        BaseType_t xReturn = pdTRUE;
+
+        for( xCoreID = ( BaseType_t ) 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            if( ( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U ) ||
+                ( pxCurrentTCBs[ xCoreID ]->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD ) ||
+                ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+            {
+                xReturn = pdFALSE;
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        return xReturn;
+    }
+/*----------------------------------------------------------*/
+
+    static void prvIdleCoreSleep( void )
+    {
+        TickType_t xExpectedIdleTime;
+        UBaseType_t uxSavedInterruptStatus;
+        UBaseType_t uxSavedLockStatus;
+        BaseType_t xSleepingCore;
+        BaseType_t xTickSuppressed = pdFALSE;
+
+        #if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+            TickType_t xTimeBeforeSleep;
+        #endif
+
+        /* As in prvIdleTask(), a preliminary test is performed without the
+         * scheduler suspended.  It fails unless every core is idle. */
+        xExpectedIdleTime = prvGetExpectedIdleTime();
+
+        if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+        {
+            vTaskSuspendAll();
+            {
+                /* No core can switch to another task while the scheduler is
+                 * suspended, so the expected idle time is now valid. */
+                xExpectedIdleTime = prvGetExpectedIdleTime();
+
+                configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+
+                #if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+                {
+                    prvSelectSleepState( &xExpectedIdleTime );
+                    xTimeBeforeSleep = xTickCount + xPendedTicks;
+                }
+                #endif
+
+                if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                {
+                    /* This core holds the task lock until the scheduler is
+                     * resumed, so the tick is only suppressed once every other
+                     * core is halted.  A core still running its idle task
+                     * could otherwise wait for the task lock, with interrupts
+                     * masked, for the whole of the sleep. */
+                    uxSavedLockStatus = taskENTER_CRITICAL_FROM_ISR();
+                    {
+                        if( uxCoresHalted == ( UBaseType_t ) ( configNUMBER_OF_CORES - 1 ) )
+                        {
+                            xTicklessSleepingCore = ( BaseType_t ) portGET_CORE_ID();
+                            xTickSuppressed = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    taskEXIT_CRITICAL_FROM_ISR( uxSavedLockStatus );
+
+                    if( xTickSuppressed != pdFALSE )
+                    {
+                        traceLOW_POWER_IDLE_BEGIN();
+                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+                        traceLOW_POWER_IDLE_END();
+
+                        xTicklessSleepingCore = ( BaseType_t ) -1;
+
+                        #if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+                        {
+                            prvUpdateSleepPrediction( ( xTickCount + xPendedTicks ) - xTimeBeforeSleep );
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xTickSuppressed == pdFALSE )
+        {
+            /* Another core is still busy, or this core is the last to go
+             * idle but the tick cannot be suppressed yet.  Interrupts stay
+             * masked until the wait has been recorded as over, so this idle
+             * task cannot be switched out, or moved to another core, in
+             * between.  The interrupt that ends the wait is taken when they
+             * are unmasked. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+            {
+                uxSavedLockStatus = taskENTER_CRITICAL_FROM_ISR();
+                {
+                    uxCoresHalted++;
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedLockStatus );
+
+                portWAIT_FOR_INTERRUPT();
+
+                uxSavedLockStatus = taskENTER_CRITICAL_FROM_ISR();
+                {
+                    uxCoresHalted--;
+                    xSleepingCore = xTicklessSleepingCore;
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedLockStatus );
+
+                /* The first core to wake ends the sleep of the core that
+                 * suppressed the tick, which then corrects the tick count
+                 * with vTaskStepTick() and resumes the scheduler.  The
+                 * interrupt that woke this core may have readied a task that
+                 * is being held pending until then. */
+                if( xSleepingCore >= ( BaseType_t ) 0 )
+                {
+                    portYIELD_CORE( xSleepingCore );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configNUMBER_OF_CORES > 1 ) ) */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskResumeAll( void )
+{
+    TCB_t * pxTCB = NULL;
+    BaseType_t xAlreadyYielded = pdFALSE;
+
+    /* vTaskSuspendAll() does nothing until the scheduler is running when
+     * there is more than one core. */
+    #if ( configNUMBER_OF_CORES > 1 )
+        if( xSchedulerRunning != pdFALSE )
+    #endif
+    {
+        /* If uxSchedulerSuspended is zero then this function does not match a
+         * previous call to vTaskSuspendAll(). */
+        configASSERT( uxSchedulerSuspended );
+
+        #if ( configPENDING_READY_BATCH_SIZE > 0 )
+        {
+            /* Bound the time spent with interrupts masked by moving all but
+             * the last batch of pending ready tasks before the critical
+             * section below. */
+            pxTCB = prvMovePendingReadyTasksInBatches();
+        }
+        #endif
+
+        /* It is possible that an ISR caused a task to be removed from an event
+         * list while the scheduler was suspended.  If this was the case then the
+         * removed task will have been added to the xPendingReadyList.  Once the
+         * scheduler has been resumed it is safe to move all the pending ready
+         * tasks from this list into their appropriate ready list. */
+        taskENTER_CRITICAL();
+        {
+            #if ( configNUMBER_OF_CORES > 1 )
+                const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+            #endif
+
+            --uxSchedulerSuspended;
+
+            #if ( configNUMBER_OF_CORES > 1 )
+            {
+                /* Release the task lock obtained by vTaskSuspendAll().  The lock is
+                 * still held by the critical section. */
+                portRELEASE_TASK_LOCK();
+            }
+            #endif
+
+            #if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+            {
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    prvRecordCriticalDuration( &xSchedulerSuspendStats, ulSchedulerSuspendTime, pvSchedulerSuspendCaller );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_CRITICAL_SECTION_PROFILING */
+
+            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            {
+                if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+                {
+                    /* Move any readied tasks from the pending list into the
+                     * appropriate ready list. */
+                    while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                    {
+                        pxTCB = prvMovePendingReadyTask();
+                    }
+
+                    if( pxTCB != NULL )
+                    {
+                        /* A task was unblocked while the scheduler was suspended,
+                         * which may have prevented the next unblock time from being
+                         * re-calculated, in which case re-calculate it now.  Mainly
+                         * important for low power tickless implementations, where
+                         * this can prevent an unnecessary exit from low power
+                         * state. */
+                        prvResetNextTaskUnblockTime();
+                    }
+
+                    /* If any ticks occurred while the scheduler was suspended then
+                     * they should be processed now.  This ensures the tick count does
+                     * not  slip, and that any delayed tasks are resumed at the correct
+                     * time. */
+                    {
+                        TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+
+                        if( xPendedCounts > ( TickType_t ) 0U )
+                        {
+                            do
+                            {
+                                if( xTaskIncrementTick() != pdFALSE )
+                                {
+                                    #if ( configNUMBER_OF_CORES == 1 )
+                                        xYieldPending = pdTRUE;
+                                    #else
+                                        xYieldPendings[ xCoreID ] = pdTRUE;
+                                    #endif
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+
+                                --xPendedCounts;
+                            } while( xPendedCounts > ( TickType_t ) 0U );
+
+                            xPendedTicks = 0;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    #if ( configNUMBER_OF_CORES == 1 )
+                        if( xYieldPending != pdFALSE )
+                    #else
+                        if( xYieldPendings[ xCoreID ] != pdFALSE )
+                    #endif
+                    {
+                        #if ( configUSE_PREEMPTION != 0 )
+                        {
+                            xAlreadyYielded = pdTRUE;
+                        }
+                        #endif
+
+                        /* When there is more than one core the pending yield is
+                         * performed when the critical section is exited. */
+                        #if ( configNUMBER_OF_CORES == 1 )
+                        {
+                            taskYIELD_IF_USING_PREEMPTION();
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+
+    return xAlreadyYielded;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+
+    void vTaskPreemptionDisable( void )
+    {
+        /* Only the task itself writes its count, and vTaskSwitchContext() only
+         * reads it, so no critical section is needed. */
+        pxCurrentTCB->uxPreemptionDisable++;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskPreemptionEnable( void )
+    {
+        configASSERT( pxCurrentTCB->uxPreemptionDisable > ( UBaseType_t ) 0U );
+
+        pxCurrentTCB->uxPreemptionDisable--;
+
+        if( ( pxCurrentTCB->uxPreemptionDisable == ( UBaseType_t ) 0U ) &&
+            ( xYieldPending != pdFALSE ) &&
+            ( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE ) )
+        {
+            /* A context switch was held while preemption was disabled. */
+            portYIELD_WITHIN_API();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* configUSE_TASK_PREEMPTION_DISABLE */
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCount( void )
+{
+    TickType_t xTicks;
+
+    taskSTOP_DYNAMIC_TICK();
+
+    /* Critical section required if running on a 16 bit processor. */
+    portTICK_TYPE_ENTER_CRITICAL();
+    {
+        xTicks = xTickCount;
+    }
+    portTICK_TYPE_EXIT_CRITICAL();
+
+    return xTicks;
+}
+/*-----------------------------------------------------------*/
+
+TickType_t xTaskGetTickCountFromISR( void )
+{
+    TickType_t xReturn;
+    UBaseType_t uxSavedInterruptStatus;
+
+    /* RTOS ports that support interrupt nesting have the concept of a maximum
+     * system call (or maximum API call) interrupt priority.  Interrupts that are
+     * above the maximum system call priority are kept permanently enabled, even
+     * when the RTOS kernel is in a critical section, but cannot make any calls to
+     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+     * failure if a FreeRTOS API function is called from an interrupt that has been
+     * assigned a priority above the configured maximum system call priority.
+     * Only FreeRTOS functions that end in FromISR can be called from interrupts
+     * that have been assigned a priority at or (logically) below the maximum
+     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
+     * safe API to ensure interrupt entry is as fast and as simple as possible.
+     * More information (albeit Cortex-M specific) is provided on the following
+     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+    taskSTOP_DYNAMIC_TICK();
+
+    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
+    {
+        xReturn = xTickCount;
+    }
+    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICK_COUNT_64 == 1 )
+
+    static void prvAdvanceTickCount64( TickType_t xTicks )
+    {
+        /* Point readers at ullTickCount64[ 1 ] while ullTickCount64[ 0 ] is
+         * updated, then back at ullTickCount64[ 0 ] while ullTickCount64[ 1 ]
+         * is brought level with it. */
+        uxTickCount64Sequence++;
+        portMEMORY_BARRIER();
+        ullTickCount64[ 0 ] += ( uint64_t ) xTicks;
+        portMEMORY_BARRIER();
+        uxTickCount64Sequence++;
+        portMEMORY_BARRIER();
+        ullTickCount64[ 1 ] = ullTickCount64[ 0 ];
+    }
+
+#endif /* configUSE_TICK_COUNT_64 */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICK_COUNT_64 == 1 )
+
+    uint64_t ullTaskGetTickCount64( void )
+    {
+        UBaseType_t uxSequence;
+        uint64_t ullTicks;
+
+        taskSTOP_DYNAMIC_TICK();
+
+        /* No critical section is needed.  The copy being read is only written
+         * after the sequence has moved on, so read again if it has. */
+        do
+        {
+            uxSequence = uxTickCount64Sequence;
+            portMEMORY_BARRIER();
+            ullTicks = ullTickCount64[ uxSequence & ( UBaseType_t ) 1U ];
+            portMEMORY_BARRIER();
+        } while( uxSequence != uxTickCount64Sequence );
+
+        return ullTicks;
+    }
+
+#endif /* configUSE_TICK_COUNT_64 */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxTaskGetNumberOfTasks( void )
+{
+    /* A critical section is not required because the variables are of type
+     * BaseType_t. */
+    return uxCurrentNumberOfTasks;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_STATE_COUNTS == 1 )
+
+    UBaseType_t uxTaskGetNumberOfTasksInState( eTaskState eState )
+    {
+        UBaseType_t uxReady = ( UBaseType_t ) 0U;
+        UBaseType_t uxRunning = ( UBaseType_t ) 0U;
+        UBaseType_t uxSuspended = ( UBaseType_t ) 0U;
+        UBaseType_t uxDeleted = ( UBaseType_t ) 0U;
+        UBaseType_t uxIndex;
+        UBaseType_t uxReturn;
+
+        taskENTER_CRITICAL();
+        {
+            /* Ready tasks are counted from the lengths of the lists that hold
+             * them, and suspended and deleted tasks are counted as they enter
+             * and leave those states, so every task not counted is blocked. */
+            for( uxIndex = ( UBaseType_t ) 0U; uxIndex < ( UBaseType_t ) configMAX_PRIORITIES; uxIndex++ )
+            {
+                uxReady += listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxIndex ] ) );
+            }
+
+            #if ( configUSE_TIME_PARTITIONS == 1 )
+            {
+                for( uxIndex = ( UBaseType_t ) 0U; uxIndex <= ( UBaseType_t ) configNUMBER_OF_TIME_PARTITIONS; uxIndex++ )
+                {
+                    uxReady += listCURRENT_LIST_LENGTH( &( xParkedTaskLists[ uxIndex ] ) );
+                }
+            }
+            #endif
+
+            #if ( configUSE_MIXED_CRITICALITY == 1 )
+            {
+                uxReady += listCURRENT_LIST_LENGTH( &xShedTaskList );
+            }
+            #endif
+
+            /* The running tasks remain in the ready lists. */
+            if( xSchedulerRunning != pdFALSE )
+            {
+                uxRunning = ( UBaseType_t ) configNUMBER_OF_CORES;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                uxSuspended = uxSuspendedTaskCount;
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+            {
+                uxDeleted = uxDeletedTasksWaitingCleanUp;
+            }
+            #endif
+
+            switch( eState )
+            {
+                case eRunning:
+                    uxReturn = uxRunning;
+                    break;
+
+                case eReady:
+                    uxReturn = uxReady - uxRunning;
+                    break;
+
+                case eBlocked:
+                    uxReturn = uxCurrentNumberOfTasks - uxReady - uxSuspended - uxDeleted;
+                    break;
+
+                case eSuspended:
+                    uxReturn = uxSuspended;
+                    break;
+
+                case eDeleted:
+                    uxReturn = uxDeleted;
+                    break;
+
+                case eInvalid:
+                default:
+                    uxReturn = ( UBaseType_t ) 0U;
+                    break;
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_TASK_STATE_COUNTS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_STATE_COUNTS == 1 )
+
+    UBaseType_t uxTaskGetNumberOfReadyTasksAtPriority( UBaseType_t uxPriority )
+    {
+        UBaseType_t uxReturn;
+
+        configASSERT( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES );
+
+        /* A critical section is not required as the length of a single list
+         * is read. */
+        if( uxPriority < ( UBaseType_t ) configMAX_PRIORITIES )
+        {
+            uxReturn = listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) );
+        }
+        else
+        {
+            uxReturn = ( UBaseType_t ) 0U;
+        }
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_TASK_STATE_COUNTS */
+/*-----------------------------------------------------------*/
+
+char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+{
+    TCB_t * pxTCB;
+
+    /* If null is passed in here then the name of the calling task is being
+     * queried. */
+    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+    configASSERT( pxTCB );
+    return taskGET_TASK_NAME( pxTCB );
+}
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetHandle == 1 ) && ( configTASK_NAME_HASH_BUCKETS == 0 ) )
+
+    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
+                                                     const char pcNameToQuery[] )
+    {
+        TCB_t * pxNextTCB;
+        TCB_t * pxFirstTCB;
+        TCB_t * pxReturn = NULL;
+        UBaseType_t x;
+        char cNextChar;
+        BaseType_t xBreakLoop;
+
+        /* This function is called with the scheduler suspended. */
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                /* Check each character in the name looking for a match or
+                 * mismatch. */
+                xBreakLoop = pdFALSE;
+
+                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+                {
+                    cNextChar = pxNextTCB->pcTaskName[ x ];
+
+                    if( cNextChar != pcNameToQuery[ x ] )
+                    {
+                        /* Characters didn't match. */
+                        xBreakLoop = pdTRUE;
+                    }
+                    else if( cNextChar == ( char ) 0x00 )
+                    {
+                        /* Both strings terminated, a match must have been
+                         * found. */
+                        pxReturn = pxNextTCB;
+                        xBreakLoop = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    if( xBreakLoop != pdFALSE )
+                    {
+                        break;
+                    }
+                }
+
+                if( pxReturn != NULL )
+                {
+                    /* The handle has been found. */
+                    break;
+                }
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxReturn;
+    }
+
+#endif /* ( INCLUDE_xTaskGetHandle == 1 ) && ( configTASK_NAME_HASH_BUCKETS == 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configTASK_NAME_HASH_BUCKETS > 0 )
+
+    static UBaseType_t prvTaskNameHash( const char * pcName ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        uint32_t ulHash = 2166136261UL;
+        UBaseType_t x;
+
+        /* FNV-1a over at most the part of the name that is stored in the TCB. */
+        for( x = ( UBaseType_t ) 0; ( x < ( UBaseType_t ) configMAX_TASK_NAME_LEN ) && ( pcName[ x ] != ( char ) 0x00 ); x++ )
+        {
+            ulHash ^= ( uint32_t ) ( uint8_t ) pcName[ x ];
+            ulHash *= 16777619UL;
+        }
+
+        return ( UBaseType_t ) ( ulHash % ( uint32_t ) configTASK_NAME_HASH_BUCKETS );
+    }
+
+#endif /* configTASK_NAME_HASH_BUCKETS */
+/*-----------------------------------------------------------*/
+
+#if ( configTASK_NAME_HASH_BUCKETS > 0 )
+
+    static void prvAddTaskToNameIndex( TCB_t * pxTCB )
+    {
+        const UBaseType_t uxBucket = prvTaskNameHash( &( pxTCB->pcTaskName[ 0 ] ) );
+
+        pxTCB->pxNameHashNext = pxTaskNameHashTable[ uxBucket ];
+        pxTaskNameHashTable[ uxBucket ] = pxTCB;
+    }
+
+#endif /* configTASK_NAME_HASH_BUCKETS */
+/*-----------------------------------------------------------*/
+
+#if ( configTASK_NAME_HASH_BUCKETS > 0 )
+
+    static void prvRemoveTaskFromNameIndex( TCB_t * pxTCB )
+    {
+        TCB_t ** ppxLink = &( pxTaskNameHashTable[ prvTaskNameHash( &( pxTCB->pcTaskName[ 0 ] ) ) ] );
+
+        while( *ppxLink != NULL )
+        {
+            if( *ppxLink == pxTCB )
+            {
+                *ppxLink = pxTCB->pxNameHashNext;
+                break;
+            }
+
+            ppxLink = &( ( *ppxLink )->pxNameHashNext );
+        }
+
+        pxTCB->pxNameHashNext = NULL;
+    }
+
+#endif /* configTASK_NAME_HASH_BUCKETS */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetHandle == 1 ) && ( configTASK_NAME_HASH_BUCKETS > 0 ) )
+
+    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        TCB_t * pxTCB;
+        const UBaseType_t uxBucket = prvTaskNameHash( pcNameToQuery );
+
+        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
+        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+
+        /* Only the tasks in one bucket are compared, so a critical section is
+         * short enough to keep the chain from changing during the search. */
+        taskENTER_CRITICAL();
+        {
+            for( pxTCB = pxTaskNameHashTable[ uxBucket ]; pxTCB != NULL; pxTCB = pxTCB->pxNameHashNext )
+            {
+                if( strncmp( pxTCB->pcTaskName, pcNameToQuery, ( size_t ) configMAX_TASK_NAME_LEN ) == 0 )
+                {
+                    break;
+                }
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return pxTCB;
+    }
+
+#endif /* ( INCLUDE_xTaskGetHandle == 1 ) && ( configTASK_NAME_HASH_BUCKETS > 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetHandle == 1 ) && ( configTASK_NAME_HASH_BUCKETS == 0 ) )
+
+    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        UBaseType_t uxQueue = configMAX_PRIORITIES;
+        TCB_t * pxTCB;
+
+        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
+        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+
+        vTaskSuspendAll();
+        {
+            /* Search the ready lists. */
+            do
+            {
+                uxQueue--;
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
+
+                if( pxTCB != NULL )
+                {
+                    /* Found the handle. */
+                    break;
+                }
+            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+            /* Search the delayed lists. */
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+            }
+
+            if( pxTCB == NULL )
+            {
+                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+            }
+
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            {
+                UBaseType_t uxSlot;
+
+                for( uxSlot = ( UBaseType_t ) 0U; ( uxSlot < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SIZE ) && ( pxTCB == NULL ); uxSlot++ )
+                {
+                    pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel[ uxSlot ] ), pcNameToQuery );
+                }
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                if( pxTCB == NULL )
+                {
+                    /* Search the suspended list. */
+                    pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
+                }
+            }
+            #endif
+
+            #if ( INCLUDE_vTaskDelete == 1 )
+            {
+                if( pxTCB == NULL )
+                {
+                    /* Search the deleted list. */
+                    pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
+                }
+            }
+            #endif
+        }
+        ( void ) xTaskResumeAll();
+
+        return pxTCB;
+    }
+
+#endif /* ( INCLUDE_xTaskGetHandle == 1 ) && ( configTASK_NAME_HASH_BUCKETS == 0 ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
+                                      const UBaseType_t uxArraySize,
+                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+    {
+        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+
+        vTaskSuspendAll();
+        {
+            /* Is there a space in the array for each task in the system? */
+            if( uxArraySize >= uxCurrentNumberOfTasks )
+            {
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Ready state. */
+                do
+                {
+                    uxQueue--;
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
+                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+                #if ( configUSE_MIXED_CRITICALITY == 1 )
+                {
+                    /* Shed tasks are ready to run, they are only held back. */
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xShedTaskList, eReady );
+                }
+                #endif
+
+                /* Fill in an TaskStatus_t structure with information on each
+                 * task in the Blocked state. */
+                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    UBaseType_t uxSlot;
+
+                    for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SIZE; uxSlot++ )
+                    {
+                        uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel[ uxSlot ] ), eBlocked );
+                    }
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskDelete == 1 )
+                {
+                    /* Fill in an TaskStatus_t structure with information on
+                     * each task that has been deleted but not yet cleaned up. */
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
+                }
+                #endif
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* Fill in an TaskStatus_t structure with information on
+                     * each task in the Suspended state. */
+                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
+                }
+                #endif
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
+                        #else
+                            *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                        #endif
+                    }
+                }
+                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                {
+                    if( pulTotalRunTime != NULL )
+                    {
+                        *pulTotalRunTime = 0;
+                    }
+                }
+                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_POST_MORTEM_SNAPSHOT == 1 )
+
+    static void prvWalkTasksWithinSingleList( const List_t * pxList,
+                                              eTaskState eState,
+                                              TaskWalkFunction_t pxFunction,
+                                              void * pvContext )
+    {
+        const ListItem_t * pxListItem;
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( pxList );
+        UBaseType_t uxRemaining = listCURRENT_LIST_LENGTH( pxList );
+        TCB_t * pxTCB;
+        StackType_t * pxTopOfStack;
+        UBaseType_t uxWindowWords;
+        TaskWalkInfo_t xInfo;
+
+        /* The list is walked from its end marker rather than with
+         * listGET_OWNER_OF_NEXT_ENTRY(), which would move the list's index. */
+        for( pxListItem = listGET_HEAD_ENTRY( pxList ); ( uxRemaining > ( UBaseType_t ) 0U ) && ( pxListItem != NULL ) && ( pxListItem != pxEndMarker ); pxListItem = listGET_NEXT( pxListItem ) )
+        {
+            uxRemaining--;
+            pxTCB = listGET_LIST_ITEM_OWNER( pxListItem ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            if( pxTCB == NULL )
+            {
+                break;
+            }
+
+            xInfo.xHandle = pxTCB;
+            xInfo.pcTaskName = taskGET_TASK_NAME( pxTCB );
+            xInfo.eCurrentState = eState;
+
+            #if ( INCLUDE_vTaskSuspend == 1 )
+            {
+                /* Tasks blocked without a timeout are held in the suspended
+                 * list. */
+                if( ( eState == eSuspended ) && ( taskIS_WAITING_ON_EVENT( pxTCB ) != pdFALSE ) )
+                {
+                    xInfo.eCurrentState = eBlocked;
+                }
+            }
+            #endif
+
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                xInfo.xRunningOnCore = ( pxTCB == pxCurrentTCB ) ? ( BaseType_t ) 0 : ( BaseType_t ) -1;
+            }
+            #else
+            {
+                xInfo.xRunningOnCore = ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) ? pxTCB->xTaskRunState : ( BaseType_t ) -1;
+            }
+            #endif
+
+            xInfo.uxCurrentPriority = pxTCB->uxPriority;
+
+            #if ( configUSE_MUTEXES == 1 )
+            {
+                xInfo.uxBasePriority = pxTCB->uxBasePriority;
+            }
+            #else
+            {
+                xInfo.uxBasePriority = pxTCB->uxPriority;
+            }
+            #endif
+
+            pxTopOfStack = ( StackType_t * ) pxTCB->pxTopOfStack;
+            xInfo.pxTopOfStack = pxTopOfStack;
+            xInfo.pxStackBase = pxTCB->pxStack;
+            xInfo.pxStackWindow = NULL;
+            xInfo.uxStackWindowWords = 0;
+
+            /* The window holds the words most recently pushed, so starts at
+             * pxTopOfStack and extends into the used part of the stack, but is
+             * left empty if the stack pointer has overflowed the stack area. */
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                if( pxTopOfStack >= pxTCB->pxStack )
+                {
+                    uxWindowWords = ( UBaseType_t ) configPOST_MORTEM_STACK_WINDOW_WORDS;
+
+                    #if ( configRECORD_STACK_HIGH_ADDRESS == 1 )
+                    {
+                        if( pxTopOfStack > pxTCB->pxEndOfStack )
+                        {
+                            uxWindowWords = 0;
+                        }
+                        else if( ( UBaseType_t ) ( pxTCB->pxEndOfStack - pxTopOfStack ) < uxWindowWords )
+                        {
+                            uxWindowWords = ( UBaseType_t ) ( pxTCB->pxEndOfStack - pxTopOfStack ) + ( UBaseType_t ) 1U;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configRECORD_STACK_HIGH_ADDRESS */
+
+                    xInfo.pxStackWindow = pxTopOfStack;
+                    xInfo.uxStackWindowWords = uxWindowWords;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* portSTACK_GROWTH */
+            {
+                if( ( pxTopOfStack >= pxTCB->pxStack ) && ( pxTopOfStack <= pxTCB->pxEndOfStack ) )
+                {
+                    uxWindowWords = ( UBaseType_t ) configPOST_MORTEM_STACK_WINDOW_WORDS;
+
+                    if( ( UBaseType_t ) ( pxTopOfStack - pxTCB->pxStack ) < uxWindowWords )
+                    {
+                        uxWindowWords = ( UBaseType_t ) ( pxTopOfStack - pxTCB->pxStack ) + ( UBaseType_t ) 1U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xInfo.pxStackWindow = pxTopOfStack - uxWindowWords + 1;
+                    xInfo.uxStackWindowWords = uxWindowWords;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* portSTACK_GROWTH */
+
+            pxFunction( &xInfo, pvContext );
+        }
+    }
+/*----------------------------------------------------------*/
+
+    void vTaskWalkTasks( TaskWalkFunction_t pxFunction,
+                         void * pvContext )
+    {
+        UBaseType_t uxQueue;
+
+        configASSERT( pxFunction != NULL );
+
+        /* Every task is on exactly one of these lists through its state list
+         * item, so each is reported once.  Tasks on xPendingReadyList are
+         * found through the list holding their state list item. */
+        for( uxQueue = ( UBaseType_t ) configMAX_PRIORITIES; uxQueue > ( UBaseType_t ) 0U; uxQueue-- )
+        {
+            prvWalkTasksWithinSingleList( &( pxReadyTasksLists[ uxQueue - ( UBaseType_t ) 1U ] ), eReady, pxFunction, pvContext );
+        }
+
+        #if ( configUSE_TIME_PARTITIONS == 1 )
+        {
+            for( uxQueue = 0; uxQueue <= ( UBaseType_t ) configNUMBER_OF_TIME_PARTITIONS; uxQueue++ )
+            {
+                prvWalkTasksWithinSingleList( &( xParkedTaskLists[ uxQueue ] ), eReady, pxFunction, pvContext );
+            }
+        }
+        #endif
+
+        #if ( configUSE_MIXED_CRITICALITY == 1 )
+        {
+            prvWalkTasksWithinSingleList( &xShedTaskList, eReady, pxFunction, pvContext );
+        }
+        #endif
+
+        prvWalkTasksWithinSingleList( &xDelayedTaskList1, eBlocked, pxFunction, pvContext );
+        prvWalkTasksWithinSingleList( &xDelayedTaskList2, eBlocked, pxFunction, pvContext );
+
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+        {
+            for( uxQueue = 0; uxQueue < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SIZE; uxQueue++ )
+            {
+                prvWalkTasksWithinSingleList( &( xDelayedTaskWheel[ uxQueue ] ), eBlocked, pxFunction, pvContext );
+            }
+        }
+        #endif
+
+        #if ( INCLUDE_vTaskDelete == 1 )
+        {
+            prvWalkTasksWithinSingleList( &xTasksWaitingTermination, eDeleted, pxFunction, pvContext );
+        }
+        #endif
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+        {
+            prvWalkTasksWithinSingleList( &xSuspendedTaskList, eSuspended, pxFunction, pvContext );
+        }
+        #endif
+    }
+/*----------------------------------------------------------*/
+
+    void vTaskGetKernelState( TaskKernelState_t * pxKernelState )
+    {
+        BaseType_t xCoreID;
+
+        configASSERT( pxKernelState != NULL );
+
+        /* Read directly, rather than through xTaskGetTickCount(), as the
+         * critical section it enters on some ports could be held by the code
+         * that faulted. */
+        pxKernelState->xTickCount = xTickCount;
+        pxKernelState->uxNumberOfTasks = uxCurrentNumberOfTasks;
+
+        #if ( configUSE_BITMAP_TASK_SELECTION == 1 )
+        {
+            /* There is no uxTopReadyPriority variable, so find the highest
+             * priority with its bit set, as taskSELECT_HIGHEST_PRIORITY_TASK()
+             * does. */
+            if( ucReadyPriorityGroups != ( uint8_t ) 0U )
+            {
+                UBaseType_t uxTopGroup = taskHIGHEST_SET_BIT( ucReadyPriorityGroups );
+
+                pxKernelState->uxTopReadyPriority = ( uxTopGroup << 3 ) + taskHIGHEST_SET_BIT( ucReadyPriorityBitmap[ uxTopGroup ] );
+            }
+            else
+            {
+                pxKernelState->uxTopReadyPriority = tskIDLE_PRIORITY;
+            }
+        }
+        #else
+        {
+            pxKernelState->uxTopReadyPriority = uxTopReadyPriority;
+        }
+        #endif /* configUSE_BITMAP_TASK_SELECTION */
+
+        if( xSchedulerRunning == pdFALSE )
+        {
+            pxKernelState->xSchedulerState = taskSCHEDULER_NOT_STARTED;
+        }
+        else if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+        {
+            pxKernelState->xSchedulerState = taskSCHEDULER_RUNNING;
+        }
+        else
+        {
+            pxKernelState->xSchedulerState = taskSCHEDULER_SUSPENDED;
+        }
+
+        for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                pxKernelState->xCurrentTasks[ xCoreID ] = pxCurrentTCB;
+            }
+            #else
+            {
+                pxKernelState->xCurrentTasks[ xCoreID ] = pxCurrentTCBs[ xCoreID ];
+            }
+            #endif
+        }
+    }
+
+#endif /* configUSE_POST_MORTEM_SNAPSHOT */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ITERATOR == 1 )
+
+    static void prvRegisterTask( TCB_t * pxTCB )
+    {
+        pxTCB->pxRegistryNext = NULL;
+        pxTCB->pxRegistryPrevious = pxTaskRegistryTail;
+
+        if( pxTaskRegistryTail != NULL )
+        {
+            pxTaskRegistryTail->pxRegistryNext = pxTCB;
+        }
+        else
+        {
+            pxTaskRegistryHead = pxTCB;
+        }
+
+        pxTaskRegistryTail = pxTCB;
+    }
+
+#endif /* configUSE_TASK_ITERATOR */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ITERATOR == 1 )
+
+    static void prvUnregisterTask( TCB_t * pxTCB )
+    {
+        if( pxTCB->pxRegistryPrevious != NULL )
+        {
+            pxTCB->pxRegistryPrevious->pxRegistryNext = pxTCB->pxRegistryNext;
+        }
+        else
+        {
+            pxTaskRegistryHead = pxTCB->pxRegistryNext;
+        }
+
+        if( pxTCB->pxRegistryNext != NULL )
+        {
+            pxTCB->pxRegistryNext->pxRegistryPrevious = pxTCB->pxRegistryPrevious;
+        }
+        else
+        {
+            pxTaskRegistryTail = pxTCB->pxRegistryPrevious;
+        }
+
+        pxTCB->pxRegistryNext = NULL;
+        pxTCB->pxRegistryPrevious = NULL;
+    }
+
+#endif /* configUSE_TASK_ITERATOR */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ITERATOR == 1 )
+
+    void vTaskIteratorInit( TaskIterator_t * pxIterator )
+    {
+        configASSERT( pxIterator );
+
+        pxIterator->pvNextTask = NULL;
+        pxIterator->uxLastTCBNumber = ( UBaseType_t ) 0U;
+
+        /* uxTaskNumber never matches this value after the first task has been
+         * created, so the first call to xTaskIteratorNext() starts from the
+         * first task. */
+        pxIterator->uxTaskNumber = ( UBaseType_t ) 0U;
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                portALT_GET_RUN_TIME_COUNTER_VALUE( pxIterator->ulTotalRunTime );
+            #else
+                pxIterator->ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+            #endif
+        }
+        #else
+        {
+            pxIterator->ulTotalRunTime = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        }
+        #endif
+    }
+
+#endif /* configUSE_TASK_ITERATOR */
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TASK_ITERATOR == 1 )
+
+    BaseType_t xTaskIteratorNext( TaskIterator_t * pxIterator,
+                                  TaskStatus_t * pxTaskStatus,
+                                  BaseType_t xGetFreeStackSpace )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxSnapshotTaskNumber;
+        BaseType_t xReturn = pdFALSE;
+
+        configASSERT( pxIterator );
+        configASSERT( pxTaskStatus );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxIterator->uxTaskNumber == uxTaskNumber )
+            {
+                /* No task has been created or deleted since the last call, so
+                 * the task that followed the last one returned is still valid. */
+                pxTCB = ( TCB_t * ) pxIterator->pvNextTask;
+            }
+            else
+            {
+                /* uxTaskNumber changes whenever a task is created or deleted,
+                 * in which case the remembered task might have been freed.
+                 * Find the position again from the TCB numbers, which increase
+                 * along the list. */
+                pxTCB = pxTaskRegistryHead;
+
+                while( ( pxTCB != NULL ) && ( pxTCB->uxTCBNumber <= pxIterator->uxLastTCBNumber ) )
+                {
+                    pxTCB = pxTCB->pxRegistryNext;
+                }
+            }
+
+            if( pxTCB != NULL )
+            {
+                vTaskGetInfo( pxTCB, pxTaskStatus, pdFALSE, eInvalid );
+
+                pxIterator->uxLastTCBNumber = pxTCB->uxTCBNumber;
+                pxIterator->pvNextTask = pxTCB->pxRegistryNext;
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                pxIterator->pvNextTask = NULL;
+            }
+
+            pxIterator->uxTaskNumber = uxTaskNumber;
+            uxSnapshotTaskNumber = uxTaskNumber;
+        }
+        taskEXIT_CRITICAL();
+
+        if( ( xReturn != pdFALSE ) && ( xGetFreeStackSpace != pdFALSE ) )
+        {
+            /* Scanning the stack takes too long to do in the critical section.
+             * A task cannot be deleted while the scheduler is suspended, and
+             * if no task has been deleted since the critical section then the
+             * TCB and stack are still valid. */
+            vTaskSuspendAll();
+            {
+                if( uxTaskNumber == uxSnapshotTaskNumber )
+                {
+                    pxTaskStatus->usStackHighWaterMark = prvTaskGetFreeStackSpace( pxTCB );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_ITERATOR */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+             * started, then xIdleTaskHandle will be NULL. */
+            configASSERT( ( xIdleTaskHandle != NULL ) );
+            return xIdleTaskHandle;
+        }
+
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+
+        TaskHandle_t xTaskGetIdleTaskHandle( void )
+        {
+            /* Return the handle of the idle task that frees the memory of
+             * deleted tasks and calls the idle hook. */
+            return xTaskGetIdleTaskHandleForCore( ( BaseType_t ) 0 );
+        }
+/*-----------------------------------------------------------*/
+
+        TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+        {
+            configASSERT( taskVALID_CORE_ID( xCoreID ) != pdFALSE );
+
+            /* If xTaskGetIdleTaskHandleForCore() is called before the scheduler
+             * has been started, then xIdleTaskHandles[ xCoreID ] will be NULL. */
+            configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+            return xIdleTaskHandles[ xCoreID ];
+        }
+
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+#endif /* INCLUDE_xTaskGetIdleTaskHandle */
+/*----------------------------------------------------------*/
+
+/* This conditional compilation should use inequality to 0, not equality to 1.
+ * This is to ensure vTaskStepTick() is available when user defined low power mode
+ * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
+ * 1. */
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    void vTaskStepTick( TickType_t xTicksToJump )
+    {
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            /* The wheel slots that are stepped over are not checked, so the
+             * jump must not pass the wake time of a task in the wheel either. */
+            const TickType_t xUnblockTime = prvGetNextTaskUnblockTime();
+        #else
+            const TickType_t xUnblockTime = xNextTaskUnblockTime;
+        #endif
+
+        /* Correct the tick count value after a period during which the tick
+         * was suppressed.  Note this does *not* call the tick hook function for
+         * each stepped tick. */
+        configASSERT( ( xTickCount + xTicksToJump ) <= xUnblockTime );
+
+        if( ( xTickCount + xTicksToJump ) == xUnblockTime )
+        {
+            /* Arrange for xTickCount to reach the unblock time in
+             * xTaskIncrementTick() when the scheduler resumes.  This ensures
+             * that any delayed tasks are resumed at the correct time. */
+            configASSERT( uxSchedulerSuspended );
+            configASSERT( xTicksToJump != ( TickType_t ) 0 );
+
+            /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+            taskENTER_CRITICAL();
+            {
+                xPendedTicks++;
+            }
+            taskEXIT_CRITICAL();
+            xTicksToJump--;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        xTickCount += xTicksToJump;
+
+        #if ( configUSE_TICK_COUNT_64 == 1 )
+        {
+            prvAdvanceTickCount64( xTicksToJump );
+        }
+        #endif
+
+        traceINCREASE_TICK_COUNT( xTicksToJump );
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
+{
+    BaseType_t xYieldOccurred;
+
+    /* Must not be called with the scheduler suspended as the implementation
+     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
+    configASSERT( uxSchedulerSuspended == 0 );
+
+    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
+     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
+    vTaskSuspendAll();
+
+    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
+    taskENTER_CRITICAL();
+    {
+        xPendedTicks += xTicksToCatchUp;
+    }
+    taskEXIT_CRITICAL();
+    xYieldOccurred = xTaskResumeAll();
+
+    return xYieldOccurred;
+}
+/*----------------------------------------------------------*/
+
+BaseType_t xTaskCatchUpTicksFromISR( TickType_t xTicksToCatchUp )
+{
+    BaseType_t xSwitchRequired = pdFALSE;
+    TickType_t xNextUnblockTime;
+    TickType_t xTicksToJump;
+    UBaseType_t uxSavedInterruptStatus;
+
+    uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    {
+        if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+        {
+            /* The ticks are processed when the scheduler is resumed, as they
+             * would have been had they been reported one at a time. */
+            xPendedTicks += xTicksToCatchUp;
+        }
+        else
+        {
+            while( xTicksToCatchUp > ( TickType_t ) 0U )
+            {
+                #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                {
+                    xNextUnblockTime = prvGetNextTaskUnblockTime();
+                }
+                #else
+                {
+                    xNextUnblockTime = xNextTaskUnblockTime;
+                }
+                #endif
+
+                /* No task is unblocked on any tick before the next unblock
+                 * time, and the tick count cannot overflow before it either as
+                 * xNextTaskUnblockTime is reset when the delayed lists are
+                 * switched.  The tick count can therefore be moved straight to
+                 * the tick before it, leaving the last of the ticks to
+                 * xTaskIncrementTick() so time slicing, the tick hook and the
+                 * unblocking of tasks are handled as normal. */
+                if( xNextUnblockTime > xTickCount )
+                {
+                    xTicksToJump = ( xNextUnblockTime - xTickCount ) - ( TickType_t ) 1U;
+
+                    if( xTicksToJump > ( xTicksToCatchUp - ( TickType_t ) 1U ) )
+                    {
+                        xTicksToJump = xTicksToCatchUp - ( TickType_t ) 1U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    xTicksToJump = 0;
+                }
+
+                if( xTicksToJump > ( TickType_t ) 0U )
+                {
+                    xTickCount += xTicksToJump;
+
+                    #if ( configUSE_TICK_COUNT_64 == 1 )
+                    {
+                        prvAdvanceTickCount64( xTicksToJump );
+                    }
+                    #endif
+
+                    traceINCREASE_TICK_COUNT( xTicksToJump );
+                    xTicksToCatchUp -= xTicksToJump;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                if( xTaskIncrementTick() != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                xTicksToCatchUp--;
+            }
+        }
+    }
+    taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+    return xSwitchRequired;
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_DYNAMIC_TICK == 1 )
+
+    static TickType_t prvGetDynamicTickLimit( void )
+    {
+        TickType_t xNextUnblockTime;
+        TickType_t xReturn;
+
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+        {
+            xNextUnblockTime = prvGetNextTaskUnblockTime();
+        }
+        #else
+        {
+            xNextUnblockTime = xNextTaskUnblockTime;
+        }
+        #endif
+
+        /* xNextTaskUnblockTime is reset when the delayed lists are switched,
+         * so the tick count cannot overflow before the next unblock time. */
+        if( xNextUnblockTime > xTickCount )
+        {
+            xReturn = xNextUnblockTime - xTickCount;
+        }
+        else
+        {
+            xReturn = ( TickType_t ) 1U;
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvStopDynamicTick( void )
+    {
+        TickType_t xTicks;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            /* The tick interrupt may have been taken since the flag was
+             * tested. */
+            if( xDynamicTickActive != pdFALSE )
+            {
+                xDynamicTickActive = pdFALSE;
+
+                /* The tick on which the next task unblocks is left to the
+                 * tick interrupt, so xTaskIncrementTick() processes it. */
+                xTicks = portDYNAMIC_TICK_STOP( prvGetDynamicTickLimit() - ( TickType_t ) 1U );
+
+                if( xTicks > ( TickType_t ) 0U )
+                {
+                    xTickCount += xTicks;
+
+                    #if ( configUSE_TICK_COUNT_64 == 1 )
+                    {
+                        prvAdvanceTickCount64( xTicks );
+                    }
+                    #endif
+
+                    traceINCREASE_TICK_COUNT( xTicks );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xTaskGetDynamicTickPeriod( void )
+    {
+        TickType_t xReturn = ( TickType_t ) 1U;
+        UBaseType_t uxSavedInterruptStatus;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            xDynamicTickActive = pdFALSE;
+
+            /* Only defer the tick if nothing is waiting for it.  Pended ticks,
+             * a pended yield or tasks in the pending ready list all need the
+             * scheduler, and so does the running task sharing its priority
+             * with other ready tasks if they are time sliced. */
+            if( ( uxSchedulerSuspended == ( UBaseType_t ) 0U ) &&
+                ( xPendedTicks == ( TickType_t ) 0U ) &&
+                ( xYieldPending == pdFALSE ) &&
+                ( listLIST_IS_EMPTY( &xPendingReadyList ) != pdFALSE ) )
+            {
+                xReturn = prvGetDynamicTickLimit();
+
+                #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+                {
+                    if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > 1U )
+                    {
+                        xReturn = ( TickType_t ) 1U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+
+                #if ( configUSE_TICKLESS_IDLE != 0 )
+                {
+                    /* The idle task suppresses the tick itself. */
+                    if( pxCurrentTCB == xIdleTaskHandle )
+                    {
+                        xReturn = ( TickType_t ) 1U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+
+                if( xReturn > ( TickType_t ) 1U )
+                {
+                    xDynamicTickActive = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_DYNAMIC_TICK */
+/*----------------------------------------------------------*/
+
+#if ( INCLUDE_xTaskAbortDelay == 1 )
+
+    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB = xTask;
+        BaseType_t xReturn;
+
+        configASSERT( pxTCB );
+
+        vTaskSuspendAll();
+        {
+            /* A task can only be prematurely removed from the Blocked state if
+             * it is actually in the Blocked state, and a task that has been
+             * throttled for exceeding its budget cannot be released early. */
+            #if ( configUSE_TASK_BUDGETS == 1 )
+                if( ( eTaskGetState( xTask ) == eBlocked ) &&
+                    ( ( pxTCB->xBudgetTicks == ( TickType_t ) 0U ) || ( pxTCB->xBudgetRemaining > ( TickType_t ) 0U ) ) )
+            #else
+                if( eTaskGetState( xTask ) == eBlocked )
+            #endif
+            {
+                xReturn = pdPASS;
+
+                /* Remove the reference to the task from the blocked list.  An
+                 * interrupt won't touch the xStateListItem because the
+                 * scheduler is suspended. */
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+                /* Is the task waiting on an event also?  If so remove it from
+                 * the event list too.  Interrupts can touch the event list item,
+                 * even though the scheduler is suspended, so a critical section
+                 * is used. */
+                taskENTER_CRITICAL();
+                {
+                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                    {
+                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+
+                        /* This lets the task know it was forcibly removed from the
+                         * blocked state so it should not re-evaluate its block time and
+                         * then block again. */
+                        pxTCB->ucDelayAborted = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    #if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+                    {
+                        if( prvRemoveWaitRecords( pxTCB, NULL ) != pdFALSE )
+                        {
+                            pxTCB->ucDelayAborted = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif
+                }
+                taskEXIT_CRITICAL();
+
+                /* Place the unblocked task into the appropriate ready list. */
+                prvAddTaskToReadyList( pxTCB );
+
+                /* A task being unblocked cannot cause an immediate context
+                 * switch if preemption is turned off. */
+                #if ( configUSE_PREEMPTION == 1 )
+                {
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        /* Preemption is on, but a context switch should only be
+                         * performed if the unblocked task has a priority that is
+                         * higher than the currently executing task. */
+                        if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
+                        {
+                            /* Pend the yield to be performed when the scheduler
+                             * is unsuspended. */
+                            xYieldPending = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+                    {
+                        /* A yield on this core is held pending until the
+                         * scheduler is unsuspended. */
+                        taskENTER_CRITICAL();
+                        {
+                            prvYieldForTask( pxTCB );
+                        }
+                        taskEXIT_CRITICAL();
+                    }
+                    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+                }
+                #endif /* configUSE_PREEMPTION */
+            }
+            else
+            {
+                xReturn = pdFAIL;
+            }
+        }
+        ( void ) xTaskResumeAll();
+
+        return xReturn;
+    }
+
+#endif /* INCLUDE_xTaskAbortDelay */
+/*----------------------------------------------------------*/
+
+#if ( ( configNUMBER_OF_CORES == 1 ) && ( taskCOUNT_TIME_SLICE_TICKS == 1 ) )
+
+    static void prvSelectTimeSlicedTask( List_t * const pxReadyList )
+    {
+        TCB_t * pxTCB = NULL;
+
+        /* pxIndex references the task most recently selected from the list,
+         * unless that task has since left the list. */
+        if( listGET_INDEX( pxReadyList ) != listGET_END_MARKER( pxReadyList ) )
+        {
+            pxTCB = listGET_LIST_ITEM_OWNER( listGET_INDEX( pxReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* The task that is switching out is the one at pxIndex if it yielded
+         * or its time slice expired, in which case the next task is taken. */
+        if( ( pxTCB != NULL ) &&
+            ( pxTCB != pxCurrentTCB ) &&
+            ( pxTCB->xTimeSliceCount != ( TickType_t ) 0U ) &&
+            ( taskTIME_SLICE_EXPIRED( pxTCB ) == pdFALSE ) )
+        {
+            pxCurrentTCB = pxTCB;
+        }
+        else
+        {
+            if( pxTCB != NULL )
+            {
+                pxTCB->xTimeSliceCount = ( TickType_t ) 0U;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            listGET_OWNER_OF_NEXT_ENTRY( pxCurrentTCB, pxReadyList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            pxCurrentTCB->xTimeSliceCount = ( TickType_t ) 1U;
+        }
+    }
+
+#endif /* ( ( configNUMBER_OF_CORES == 1 ) && ( taskCOUNT_TIME_SLICE_TICKS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockDelayedTask( TCB_t * pxTCB )
+{
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+
+    /* Is the task waiting on an event also?  If so remove
+     * it from the event list. */
+    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+    {
+        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+    }
+    else
+    {
+        mtCOVERAGE_TEST_MARKER();
+    }
+
+    #if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+    {
+        ( void ) prvRemoveWaitRecords( pxTCB, NULL );
+    }
+    #endif
+
+    #if ( configUSE_TASK_BUDGETS == 1 )
+    {
+        /* A throttled task is unblocked at the start of its next budget
+         * period. */
+        if( ( pxTCB->xBudgetTicks > ( TickType_t ) 0U ) && ( pxTCB->xBudgetRemaining == ( TickType_t ) 0U ) )
+        {
+            pxTCB->xBudgetPeriodStart = xTickCount;
+            pxTCB->xBudgetRemaining = pxTCB->xBudgetTicks;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif /* configUSE_TASK_BUDGETS */
+
+    /* Place the unblocked task into the appropriate ready
+     * list. */
+    prvAddTaskToReadyList( pxTCB );
+
+    /* A task being unblocked cannot cause an immediate
+     * context switch if preemption is turned off. */
+    #if ( configUSE_PREEMPTION == 1 )
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            /* Preemption is on, but a context switch should
+             * only be performed if the unblocked task's
+             * priority is higher than the currently executing
+             * task.
+             * The case of equal priority tasks sharing
+             * processing time (which happens when both
+             * preemption and time slicing are on) is
+             * handled in xTaskIncrementTick().*/
+            if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
+            {
+                xSwitchRequired = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* if ( configNUMBER_OF_CORES == 1 ) */
+        {
+            /* Preempt the core running the lowest priority
+             * task, if any, in favour of the unblocked task. */
+            prvYieldForTask( pxTCB );
+        }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+    }
+    #endif /* configUSE_PREEMPTION */
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EDF_SCHEDULING == 1 )
+
+    static BaseType_t prvDeadlineIsEarlier( const TCB_t * pxTCB,
+                                            const TCB_t * pxOtherTCB )
+    {
+        BaseType_t xReturn;
+
+        if( pxOtherTCB->xRelativeDeadline == ( TickType_t ) 0U )
+        {
+            xReturn = pdFALSE;
+        }
+        else if( pxTCB->xRelativeDeadline == ( TickType_t ) 0U )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            xReturn = taskTICK_IS_BEFORE( pxTCB->xAbsoluteDeadline, pxOtherTCB->xAbsoluteDeadline );
+        }
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvAddTaskToDeadlineOrderedList( TCB_t * pxTCB )
+    {
+        List_t * const pxReadyList = &( pxReadyTasksLists[ configEDF_PRIORITY ] );
+        const ListItem_t * const pxEndMarker = listGET_END_MARKER( pxReadyList );
+        ListItem_t * pxIterator;
+
+        /* Tasks with equal deadlines are kept in the order they became ready.
+         * The list is walked from its head as listGET_OWNER_OF_NEXT_ENTRY() is
+         * not used on this list to select a task, so pxIndex is not
+         * meaningful. */
+        for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != pxEndMarker; pxIterator = listGET_NEXT( pxIterator ) )
+        {
+            if( prvDeadlineIsEarlier( pxTCB, listGET_LIST_ITEM_OWNER( pxIterator ) ) != pdFALSE )
+            {
+                break;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+        listINSERT_BEFORE( pxReadyList, pxIterator, &( pxTCB->xStateListItem ) );
+    }
+
+#endif /* configUSE_EDF_SCHEDULING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_BUDGETS == 1 )
+
+    static BaseType_t prvChargeTaskBudget( TCB_t * pxTCB )
+    {
+        BaseType_t xThrottled = pdFALSE;
+        const TickType_t xChargedTick = xTickCount - ( TickType_t ) 1;
+        TickType_t xReplenishTime;
+        UBaseType_t uxItemsRemaining;
+
+        /* A task that is not in its ready list is part way through blocking,
+         * so is not charged. */
+        if( ( pxTCB->xBudgetTicks > ( TickType_t ) 0U ) &&
+            ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+        {
+            if( ( TickType_t ) ( xChargedTick - pxTCB->xBudgetPeriodStart ) >= pxTCB->xBudgetPeriod )
+            {
+                pxTCB->xBudgetPeriodStart = xChargedTick;
+                pxTCB->xBudgetRemaining = pxTCB->xBudgetTicks;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The remaining budget is already 0 if the task was resumed while
+             * throttled. */
+            if( pxTCB->xBudgetRemaining > ( TickType_t ) 0U )
+            {
+                pxTCB->xBudgetRemaining--;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( pxTCB->xBudgetRemaining == ( TickType_t ) 0U )
+            {
+                traceTASK_BUDGET_EXHAUSTED( pxTCB );
+
+                #if ( configUSE_MIXED_CRITICALITY == 1 )
+                    if( pxTCB->uxCriticality == tskCRITICALITY_HIGH )
+                    {
+                        /* A high criticality task's budget is what it needs in
+                         * low criticality mode, so rather than throttling the
+                         * task the overrun switches the kernel to high
+                         * criticality mode.  One tick of budget is left so the
+                         * task is not seen as throttled, and each further tick
+                         * it runs for counts as another overrun. */
+                        pxTCB->xBudgetRemaining = ( TickType_t ) 1U;
+
+                        if( uxCriticalityMode == tskCRITICALITY_LOW )
+                        {
+                            xThrottled = prvSetCriticalityMode( tskCRITICALITY_HIGH );
+                        }
+                        else
+                        {
+                            /* The load has not subsided yet. */
+                            xCriticalityHoldOffTicks = ( TickType_t ) 0U;
+                            xIdleRanInHighMode = pdFALSE;
+                        }
+                    }
+                    else
+                #endif /* configUSE_MIXED_CRITICALITY */
+                {
+                    xReplenishTime = pxTCB->xBudgetPeriodStart + pxTCB->xBudgetPeriod;
+
+                    listFAST_REMOVE_COUNT( &( pxTCB->xStateListItem ), uxItemsRemaining );
+
+                    if( uxItemsRemaining == ( UBaseType_t ) 0 )
+                    {
+                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ), xReplenishTime );
+
+                    if( xReplenishTime < xTickCount )
+                    {
+                        /* The replenish time has overflowed. */
+                        vListInsert( pxOverflowDelayedTaskList, &( pxTCB->xStateListItem ) );
+                    }
+                    else
+                    {
+                        vListInsert( pxDelayedTaskList, &( pxTCB->xStateListItem ) );
+
+                        if( xReplenishTime < xNextTaskUnblockTime )
+                        {
+                            xNextTaskUnblockTime = xReplenishTime;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+
+                    xThrottled = pdTRUE;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xThrottled;
+    }
+
+#endif /* configUSE_TASK_BUDGETS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MIXED_CRITICALITY == 1 )
+
+    static BaseType_t prvSetCriticalityMode( UBaseType_t uxMode )
+    {
+        BaseType_t xSwitchRequired = pdFALSE;
+        UBaseType_t uxIndex;
+        List_t * pxList;
+        ListItem_t * pxIterator;
+        ListItem_t * pxNext;
+        TCB_t * pxTCB;
+
+        traceCRITICALITY_MODE_SWITCH( uxMode );
+
+        uxCriticalityMode = uxMode;
+        xCriticalityHoldOffTicks = ( TickType_t ) 0U;
+        xIdleRanInHighMode = pdFALSE;
+
+        if( uxMode == tskCRITICALITY_HIGH )
+        {
+            /* Shed the ready tasks of low criticality. */
+            for( uxIndex = ( UBaseType_t ) 0U; uxIndex < ( UBaseType_t ) configMAX_PRIORITIES; uxIndex++ )
+            {
+                pxList = &( pxReadyTasksLists[ uxIndex ] );
+                pxIterator = listGET_HEAD_ENTRY( pxList );
+
+                while( pxIterator != listGET_END_MARKER( pxList ) )
+                {
+                    pxNext = listGET_NEXT( pxIterator );
+                    pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                    if( pxTCB->uxCriticality == tskCRITICALITY_LOW )
+                    {
+                        ( void ) uxListRemove( pxIterator );
+                        listINSERT_END( &xShedTaskList, pxIterator );
+
+                        if( pxTCB == pxCurrentTCB )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    pxIterator = pxNext;
+                }
+
+                taskRESET_READY_PRIORITY( uxIndex );
+            }
+        }
+        else
+        {
+            /* Make the shed tasks ready again. */
+            while( listLIST_IS_EMPTY( &xShedTaskList ) == pdFALSE )
+            {
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( &xShedTaskList );
+                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                prvAddEligibleTaskToReadyList( pxTCB );
+
+                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            #if ( configUSE_TIMERS == 1 )
+            {
+                if( xTimerReleaseDeferredCallbacks() != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+        }
+
+        return xSwitchRequired;
+    }
+
+#endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIME_PARTITIONS == 1 )
+
+    static BaseType_t prvActivatePartition( UBaseType_t uxPartition )
+    {
+        BaseType_t xSwitchRequired = pdFALSE;
+        UBaseType_t uxIndex;
+        List_t * pxList;
+        ListItem_t * pxIterator;
+        ListItem_t * pxNext;
+        TCB_t * pxTCB;
+
+        traceTIME_PARTITION_SWITCH( uxPartition );
+
+        uxActivePartition = uxPartition;
+
+        /* Park the ready tasks that can no longer run. */
+        for( uxIndex = ( UBaseType_t ) 0U; uxIndex < ( UBaseType_t ) configMAX_PRIORITIES; uxIndex++ )
+        {
+            pxList = &( pxReadyTasksLists[ uxIndex ] );
+            pxIterator = listGET_HEAD_ENTRY( pxList );
+
+            while( pxIterator != listGET_END_MARKER( pxList ) )
+            {
+                pxNext = listGET_NEXT( pxIterator );
+                pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                if( taskPARTITION_IS_ACTIVE( pxTCB ) == pdFALSE )
+                {
+                    ( void ) uxListRemove( pxIterator );
+                    listINSERT_END( &( xParkedTaskLists[ pxTCB->uxPartition ] ), pxIterator );
+
+                    if( pxTCB == pxCurrentTCB )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxIterator = pxNext;
+            }
+
+            taskRESET_READY_PRIORITY( uxIndex );
+        }
+
+        /* Make the parked tasks that can now run ready. */
+        for( uxIndex = ( UBaseType_t ) 0U; uxIndex <= ( UBaseType_t ) configNUMBER_OF_TIME_PARTITIONS; uxIndex++ )
+        {
+            pxList = &( xParkedTaskLists[ uxIndex ] );
+            pxIterator = listGET_HEAD_ENTRY( pxList );
+
+            while( pxIterator != listGET_END_MARKER( pxList ) )
+            {
+                pxNext = listGET_NEXT( pxIterator );
+                pxTCB = listGET_LIST_ITEM_OWNER( pxIterator );
+
+                if( taskPARTITION_IS_ACTIVE( pxTCB ) != pdFALSE )
+                {
+                    ( void ) uxListRemove( pxIterator );
+                    prvAddEligibleTaskToReadyList( pxTCB );
+
+                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxIterator = pxNext;
+            }
+        }
+
+        return xSwitchRequired;
+    }
+
+#endif /* configUSE_TIME_PARTITIONS */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskIncrementTick( void )
+{
+    TCB_t * pxTCB;
+    TickType_t xItemValue;
+    BaseType_t xSwitchRequired = pdFALSE;
+
+    #if ( configNUMBER_OF_CORES > 1 )
+        UBaseType_t uxSavedInterruptStatus;
+
+        #if ( configUSE_PREEMPTION == 1 )
+            BaseType_t xYieldRequiredForCore[ configNUMBER_OF_CORES ] = { pdFALSE };
+            BaseType_t xCoreID;
+        #endif
+
+        /* The tick interrupt only runs on one core, but the lists it touches
+         * are shared with the other cores. */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+    #endif /* configNUMBER_OF_CORES > 1 */
+
+    /* Called by the portable layer each time a tick interrupt occurs.
+     * Increments the tick then checks to see if the new tick value will cause any
+     * tasks to be unblocked. */
+    traceTASK_INCREMENT_TICK( xTickCount );
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        /* Minor optimisation.  The tick count cannot change in this
+         * block. */
+        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
+
+        /* Increment the RTOS tick, switching the delayed and overflowed
+         * delayed lists if it wraps to 0. */
+        xTickCount = xConstTickCount;
+
+        #if ( configUSE_TICK_COUNT_64 == 1 )
+        {
+            prvAdvanceTickCount64( ( TickType_t ) 1 );
+        }
+        #endif
+
+        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+        {
+            taskSWITCH_DELAYED_LISTS();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_TIME_PARTITIONS == 1 )
+        {
+            /* Move to the next window of the partition schedule when the
+             * current one ends.  This is done before the delayed lists are
+             * checked below so tasks unblocked on this tick are placed
+             * according to the new window. */
+            if( uxNumberOfPartitionWindows > ( UBaseType_t ) 0U )
+            {
+                xPartitionWindowTicksLeft--;
+
+                if( xPartitionWindowTicksLeft == ( TickType_t ) 0U )
+                {
+                    uxPartitionWindow++;
+
+                    if( uxPartitionWindow >= uxNumberOfPartitionWindows )
+                    {
+                        uxPartitionWindow = ( UBaseType_t ) 0U;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    xPartitionWindowTicksLeft = pxPartitionWindows[ uxPartitionWindow ].xDurationTicks;
+
+                    if( pxPartitionWindows[ uxPartitionWindow ].uxPartition != uxActivePartition )
+                    {
+                        if( prvActivatePartition( pxPartitionWindows[ uxPartitionWindow ].uxPartition ) != pdFALSE )
+                        {
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TIME_PARTITIONS */
+
+        #if ( configUSE_TASK_BUDGETS == 1 )
+        {
+            /* Throttling a task places it in a delayed list, so is done
+             * before the delayed lists are checked below. */
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                if( prvChargeTaskBudget( pxCurrentTCB ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else
+            {
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( prvChargeTaskBudget( pxCurrentTCBs[ xCoreID ] ) != pdFALSE )
+                    {
+                        xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+        }
+        #endif /* configUSE_TASK_BUDGETS */
+
+        #if ( ( configUSE_MIXED_CRITICALITY == 1 ) && ( configCRITICALITY_RESTORE_TICKS > 0 ) )
+        {
+            /* Return to low criticality mode once the hold off time has
+             * passed and the idle task has run in it. */
+            if( uxCriticalityMode == tskCRITICALITY_HIGH )
+            {
+                if( xCriticalityHoldOffTicks < ( TickType_t ) configCRITICALITY_RESTORE_TICKS )
+                {
+                    xCriticalityHoldOffTicks++;
+                }
+                else if( xIdleRanInHighMode != pdFALSE )
+                {
+                    if( prvSetCriticalityMode( tskCRITICALITY_LOW ) != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MIXED_CRITICALITY */
+
+        #if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+        {
+            xRunTimeWindowPeriodTicks++;
+
+            if( xRunTimeWindowPeriodTicks >= ( TickType_t ) configRUN_TIME_WINDOW_PERIOD_TICKS )
+            {
+                xRunTimeWindowPeriodTicks = ( TickType_t ) 0U;
+                prvCompleteRunTimeWindowPeriod();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_WINDOWED_RUN_TIME_STATS */
+
+        #if ( configUSE_DVFS_GOVERNOR == 1 )
+        {
+            xDvfsPeriodTicks++;
+
+            if( xDvfsPeriodTicks >= ( TickType_t ) configDVFS_PERIOD_TICKS )
+            {
+                xDvfsPeriodTicks = ( TickType_t ) 0U;
+                prvDvfsGovernor();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_DVFS_GOVERNOR */
+
+        /* See if this tick has made a timeout expire.  Tasks are stored in
+         * the  queue in the order of their wake time - meaning once one task
+         * has been found whose block time has not expired there is no need to
+         * look any further down the list. */
+        if( xConstTickCount >= xNextTaskUnblockTime )
+        {
+            for( ; ; )
+            {
+                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                {
+                    /* The delayed list is empty.  Set xNextTaskUnblockTime
+                     * to the maximum possible value so it is extremely
+                     * unlikely that the
+                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
+                     * next time through. */
+                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    break;
+                }
+                else
+                {
+                    /* The delayed list is not empty, get the value of the
+                     * item at the head of the delayed list.  This is the time
+                     * at which the task at the head of the delayed list must
+                     * be removed from the Blocked state. */
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+                    if( xConstTickCount < xItemValue )
+                    {
+                        /* It is not time to unblock this item yet, but the
+                         * item value is the time at which the task at the head
+                         * of the blocked list must be removed from the Blocked
+                         * state -  so record the item value in
+                         * xNextTaskUnblockTime. */
+                        xNextTaskUnblockTime = xItemValue;
+                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    /* It is time to remove the item from the Blocked state. */
+                    if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+        }
+
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+        {
+            List_t * const pxWheelSlot = &( xDelayedTaskWheel[ xConstTickCount & taskDELAYED_TASK_WHEEL_MASK ] );
+
+            /* Every task in the wheel slot of this tick count is due now - a
+             * task is only placed in the wheel if it wakes within one
+             * revolution of the wheel, and the slot is visited every tick. */
+            while( listLIST_IS_EMPTY( pxWheelSlot ) == pdFALSE )
+            {
+                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxWheelSlot ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                configASSERT( listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) ) == xConstTickCount );
+
+                if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+        }
+        #endif /* configUSE_DELAYED_TASK_WHEEL */
+
+        #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) )
+        {
+            /* Call the callbacks of the timers that expire on this tick and
+             * call their callbacks from the tick interrupt.  The next such
+             * expiry must not be suppressed or skipped, so it limits the next
+             * unblock time as the wake time of a delayed task does. */
+            xNextTickTimerExpiry = xTimerProcessTickCallbacks( xConstTickCount );
+
+            if( xNextTickTimerExpiry < xNextTaskUnblockTime )
+            {
+                xNextTaskUnblockTime = xNextTickTimerExpiry;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) ) */
+
+        /* Tasks of equal priority to the currently running task will share
+         * processing time (time slice) if preemption is on, and the application
+         * writer has not explicitly turned time slicing off. */
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                #if ( taskCOUNT_TIME_SLICE_TICKS == 1 )
+                {
+                    /* Saturates once the time slice has expired so it cannot
+                     * wrap while the task has its priority to itself. */
+                    if( taskTIME_SLICE_EXPIRED( pxCurrentTCB ) == pdFALSE )
+                    {
+                        pxCurrentTCB->xTimeSliceCount++;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+
+                if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+                    ( taskPRIORITY_IS_TIME_SLICED( pxCurrentTCB->uxPriority ) != pdFALSE ) )
+                {
+                    #if ( taskCOUNT_TIME_SLICE_TICKS == 1 )
+                        if( taskTIME_SLICE_EXPIRED( pxCurrentTCB ) != pdFALSE )
+                    #endif
+                    {
+                        xSwitchRequired = pdTRUE;
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* if ( configNUMBER_OF_CORES == 1 ) */
+            {
+                /* The ready list of a priority that is running on more cores
+                 * than it has tasks holds no task to switch to, which
+                 * prvSelectHighestPriorityTask() handles by reselecting the
+                 * running task. */
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    #if ( taskCOUNT_TIME_SLICE_TICKS == 1 )
+                    {
+                        if( taskTIME_SLICE_EXPIRED( pxCurrentTCBs[ xCoreID ] ) == pdFALSE )
+                        {
+                            pxCurrentTCBs[ xCoreID ]->xTimeSliceCount++;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif
+
+                    if( ( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] ) ) > ( UBaseType_t ) 1 ) &&
+                        ( taskPRIORITY_IS_TIME_SLICED( pxCurrentTCBs[ xCoreID ]->uxPriority ) != pdFALSE ) )
+                    {
+                        #if ( taskCOUNT_TIME_SLICE_TICKS == 1 )
+                            if( taskTIME_SLICE_EXPIRED( pxCurrentTCBs[ xCoreID ] ) != pdFALSE )
+                        #endif
+                        {
+                            xYieldRequiredForCore[ xCoreID ] = pdTRUE;
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+        }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            /* Guard against the tick hook being called when the pended tick
+             * count is being unwound (when the scheduler is being unlocked). */
+            if( xPendedTicks == ( TickType_t ) 0 )
+            {
+                vApplicationTickHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_TICK_HOOK */
+
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                if( xYieldPending != pdFALSE )
+                {
+                    xSwitchRequired = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #else /* if ( configNUMBER_OF_CORES == 1 ) */
+            {
+                for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                {
+                    if( ( xYieldRequiredForCore[ xCoreID ] != pdFALSE ) || ( xYieldPendings[ xCoreID ] != pdFALSE ) )
+                    {
+                        if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+                        {
+                            /* The context switch on this core is performed
+                             * by the tick interrupt on return. */
+                            xSwitchRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            prvYieldCore( xCoreID );
+                        }
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+        }
+        #endif /* configUSE_PREEMPTION */
+    }
+    else
+    {
+        ++xPendedTicks;
+
+        /* The tick hook gets called at regular intervals, even if the
+         * scheduler is locked. */
+        #if ( configUSE_TICK_HOOK == 1 )
+        {
+            vApplicationTickHook();
+        }
+        #endif
+    }
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+    }
+    #endif
+
+    return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
+                                     TaskHookFunction_t pxHookFunction )
+    {
+        TCB_t * xTCB;
+
+        /* If xTask is NULL then it is the task hook of the calling task that is
+         * getting set. */
+        if( xTask == NULL )
+        {
+            xTCB = ( TCB_t * ) pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xTCB->pxTaskTag = pxHookFunction;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        taskENTER_CRITICAL();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        TaskHookFunction_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* If xTask is NULL then set the calling task's hook. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        /* Save the hook function in the TCB.  A critical section is required as
+         * the value can be accessed from an interrupt. */
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            xReturn = pxTCB->pxTaskTag;
+        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+
+    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
+                                             void * pvParameter )
+    {
+        TCB_t * xTCB;
+        BaseType_t xReturn;
+
+        /* If xTask is NULL then we are calling our own task hook. */
+        if( xTask == NULL )
+        {
+            xTCB = pxCurrentTCB;
+        }
+        else
+        {
+            xTCB = xTask;
+        }
+
+        if( xTCB->pxTaskTag != NULL )
+        {
+            xReturn = xTCB->pxTaskTag( pvParameter );
+        }
+        else
+        {
+            xReturn = pdFAIL;
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_APPLICATION_TASK_TAG */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES == 1 )
+    void vTaskSwitchContext( void )
+    {
+        taskSTOP_DYNAMIC_TICK();
+
+        if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+        {
+            /* The scheduler is currently suspended - do not allow a context
+             * switch. */
+            xYieldPending = pdTRUE;
+        }
+
+        #if ( configUSE_TASK_PREEMPTION_DISABLE == 1 )
+            else if( ( pxCurrentTCB->uxPreemptionDisable != ( UBaseType_t ) 0U ) &&
+                     ( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ), &( pxCurrentTCB->xStateListItem ) ) != pdFALSE ) )
+            {
+                /* The running task has disabled its preemption and is still
+                 * able to run, so hold the switch until it calls
+                 * vTaskPreemptionEnable().  A task that blocks, suspends or
+                 * deletes itself has left the ready list and is switched out
+                 * as normal. */
+                xYieldPending = pdTRUE;
+            }
+        #endif /* configUSE_TASK_PREEMPTION_DISABLE */
+        else
+        {
+            xYieldPending = pdFALSE;
+            traceBENCHMARK_TASK_SWITCHED_OUT();
+            traceTASK_SWITCHED_OUT();
+
+            #if ( configUSE_SCHEDULER_EVENT_HOOKS == 1 )
+            {
+                if( pxCurrentTCB != xIdleTaskHandle )
+                {
+                    xIdleEntryPending = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+
+            #if ( configGENERATE_RUN_TIME_STATS == 1 )
+            {
+                #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                    portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                #else
+                    ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                #endif
+
+                /* Add the amount of time the task has been running to the
+                 * accumulated time so far.  The time the task started running was
+                 * stored in ulTaskSwitchedInTime.  Note that there is no overflow
+                 * protection here so count values are only valid until the timer
+                 * overflows.  The guard against negative values is to protect
+                 * against suspect run time stat counter implementations - which
+                 * are provided by the application, not the kernel. */
+                if( ulTotalRunTime > ulTaskSwitchedInTime )
+                {
+                    pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+
+                    #if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+                    {
+                        prvAddWindowedRunTime( pxCurrentTCB, ulTotalRunTime - ulTaskSwitchedInTime );
+                    }
+                    #endif
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                ulTaskSwitchedInTime = ulTotalRunTime;
+            }
+            #endif /* configGENERATE_RUN_TIME_STATS */
+
+            /* Check for stack overflow, if configured. */
+            taskCHECK_FOR_STACK_OVERFLOW();
+            taskRECORD_STACK_HIGH_WATER_MARK( pxCurrentTCB );
+
+            /* Before the currently running task is switched out, save its errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
+            }
+            #endif
+
+            /* Select a new task to run using either the generic C or port
+             * optimised asm code. */
+            taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            traceTASK_SWITCHED_IN();
+            traceBENCHMARK_TASK_SWITCHED_IN();
+            taskSET_STACK_GUARD( pxCurrentTCB );
+
+            #if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+            {
+                prvMeasureISRWakeLatency( pxCurrentTCB, ulTotalRunTime );
+            }
+            #endif
+
+            /* After the new task is switched in, update the global errno. */
+            #if ( configUSE_POSIX_ERRNO == 1 )
+            {
+                FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
+            }
+            #endif
+
+            #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+            {
+                /* Switch C-Runtime's TLS Block to point to the TLS
+                 * Block specific to this task. */
+                configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            }
+            #endif
+        }
+    }
+#else /* if ( configNUMBER_OF_CORES == 1 ) */
+    void vTaskSwitchContext( BaseType_t xCoreID )
+    {
+        /* Acquire both locks:
+         * - The ISR lock protects the ready list from simultaneous access by
+         *   both other ISRs and tasks.
+         * - We also take the task lock to pause here in case another core has
+         *   suspended the scheduler. We don't want to simply set xYieldPending
+         *   and move on if another core suspended the scheduler. We should only
+         *   do that if the current core has suspended the scheduler. */
+        portGET_TASK_LOCK();
+        portGET_ISR_LOCK();
+        {
+            /* vTaskSwitchContext() must never be called from within a critical
+             * section. This is not necessarily true for single core FreeRTOS,
+             * but it is for this SMP port. */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0 );
+
+            if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
+            {
+                /* The scheduler is currently suspended - do not allow a context
+                 * switch. */
+                xYieldPendings[ xCoreID ] = pdTRUE;
+            }
+            else
+            {
+                xYieldPendings[ xCoreID ] = pdFALSE;
+                traceBENCHMARK_TASK_SWITCHED_OUT();
+                traceTASK_SWITCHED_OUT();
+
+                #if ( configUSE_SCHEDULER_EVENT_HOOKS == 1 )
+                {
+                    if( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) == 0U )
+                    {
+                        xIdleEntryPending[ xCoreID ] = pdTRUE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+
+                #if ( configGENERATE_RUN_TIME_STATS == 1 )
+                {
+                    #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+                        portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
+                    #else
+                        ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
+                    #endif
+
+                    /* Add the amount of time the task has been running to the
+                     * accumulated time so far.  The time the task started
+                     * running was stored in ulTaskSwitchedInTime[ xCoreID ]. */
+                    if( ulTotalRunTime > ulTaskSwitchedInTime[ xCoreID ] )
+                    {
+                        pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime[ xCoreID ] );
+                        taskRECORD_CORE_IDLE_TIME( xCoreID, ulTotalRunTime - ulTaskSwitchedInTime[ xCoreID ] );
+
+                        #if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+                        {
+                            prvAddWindowedRunTime( pxCurrentTCBs[ xCoreID ], ulTotalRunTime - ulTaskSwitchedInTime[ xCoreID ] );
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    ulTaskSwitchedInTime[ xCoreID ] = ulTotalRunTime;
+                }
+                #endif /* configGENERATE_RUN_TIME_STATS */
+
+                /* Check for stack overflow, if configured. */
+                taskCHECK_FOR_STACK_OVERFLOW();
+                taskRECORD_STACK_HIGH_WATER_MARK( pxCurrentTCBs[ xCoreID ] );
+
+                /* Before the currently running task is switched out, save its errno. */
+                #if ( configUSE_POSIX_ERRNO == 1 )
+                {
+                    pxCurrentTCBs[ xCoreID ]->iTaskErrno = FreeRTOS_errno;
+                }
+                #endif
+
+                /* Select a new task to run. */
+                taskSELECT_HIGHEST_PRIORITY_TASK( xCoreID );
+                traceTASK_SWITCHED_IN();
+                traceBENCHMARK_TASK_SWITCHED_IN();
+
+                #if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+                {
+                    prvMeasureISRWakeLatency( pxCurrentTCBs[ xCoreID ], ulTotalRunTime );
+                }
+                #endif
+
+                #if ( taskCOUNT_TIME_SLICE_TICKS == 1 )
+                {
+                    /* The selected task starts a new time slice. */
+                    pxCurrentTCBs[ xCoreID ]->xTimeSliceCount = ( TickType_t ) 1U;
+                }
+                #endif
+
+                /* After the new task is switched in, update the global errno. */
+                #if ( configUSE_POSIX_ERRNO == 1 )
+                {
+                    FreeRTOS_errno = pxCurrentTCBs[ xCoreID ]->iTaskErrno;
+                }
+                #endif
+
+                #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+                {
+                    /* Switch C-Runtime's TLS Block to point to the TLS
+                     * Block specific to this task. */
+                    configSET_TLS_BLOCK( pxCurrentTCBs[ xCoreID ]->xTLSBlock );
+                }
+                #endif
+            }
+        }
+        portRELEASE_ISR_LOCK();
+        portRELEASE_TASK_LOCK();
+    }
+#endif /* if ( configNUMBER_OF_CORES == 1 ) */
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnEventList( List_t * const pxEventList,
+                            const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+    /* Place the event list item of the TCB in the appropriate event list.
+     * This is placed in the list in priority order so the highest priority task
+     * is the first to be woken by the event.
+     *
+     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
+     * Normally, the xItemValue of a TCB's ListItem_t members is:
+     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
+     * Therefore, the event list is sorted in descending priority order.
+     *
+     * The queue that contains the event list is locked, preventing
+     * simultaneous access from interrupts. */
+    taskENTER_EVENT_LIST_CRITICAL();
+    {
+        vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    }
+    taskEXIT_EVENT_LIST_CRITICAL();
+
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+    {
+        /* vTaskPlaceOnMutexEventList() sets this after the call if the event
+         * list belongs to a mutex. */
+        pxCurrentTCB->pxBlockingMutexHolder = NULL;
+    }
+    #endif
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    void vTaskPlaceOnMutexEventList( List_t * const pxEventList,
+                                     TaskHandle_t * const pxMutexHolder,
+                                     const TickType_t xTicksToWait )
+    {
+        /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+         * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+        vTaskPlaceOnEventList( pxEventList, xTicksToWait );
+
+        #if ( configPRIORITY_INHERITANCE_DEPTH > 1 )
+        {
+            /* Record which mutex the task is blocked on so a task that later
+             * causes this task to inherit a priority can pass the priority on
+             * to the holder of that mutex. */
+            pxCurrentTCB->pxBlockingMutexHolder = pxMutexHolder;
+        }
+        #else
+        {
+            ( void ) pxMutexHolder;
+        }
+        #endif
+    }
+
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_ORDER == 1 )
+
+    void vTaskPlaceOnEventListFifo( List_t * const pxEventList,
+                                    const TickType_t xTicksToWait )
+    {
+        configASSERT( pxEventList );
+
+        /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
+         * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+
+        /* Place the event list item of the TCB at the end of the event list,
+         * so the task that has waited longest is the first to be woken.  This
+         * takes constant time, whereas vListInsert() walks the list to find the
+         * task's place in priority order.  The event list item value still
+         * holds the task's priority, but the list is not ordered by it. */
+        taskENTER_EVENT_LIST_CRITICAL();
+        {
+            listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        }
+        taskEXIT_EVENT_LIST_CRITICAL();
+
+        #if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+        {
+            pxCurrentTCB->pxBlockingMutexHolder = NULL;
+        }
+        #endif
+
+        prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+    }
+
+#endif /* configUSE_QUEUE_WAIT_ORDER */
+/*-----------------------------------------------------------*/
+
+void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
+                                     const TickType_t xItemValue,
+                                     const TickType_t xTicksToWait )
+{
+    configASSERT( pxEventList );
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event groups implementation. */
+    configASSERT( uxSchedulerSuspended != 0 );
+
+    /* Store the item value in the event list item.  It is safe to access the
+     * event list item here as interrupts won't access the event list item of a
+     * task that is not in the Blocked state. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Place the event list item of the TCB at the end of the appropriate event
+     * list.  It is safe to access the event list here because it is part of an
+     * event group implementation - and interrupts don't access event groups
+     * directly (instead they access them indirectly by pending function calls to
+     * the task level). */
+    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+    #if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+    {
+        pxCurrentTCB->pxBlockingMutexHolder = NULL;
+    }
+    #endif
+
+    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TIMERS == 1 )
+
+    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
+                                          TickType_t xTicksToWait,
+                                          const BaseType_t xWaitIndefinitely )
+    {
+        configASSERT( pxEventList );
+
+        /* This function should not be called by application code hence the
+         * 'Restricted' in its name.  It is not part of the public API.  It is
+         * designed for use by kernel code, and has special calling requirements -
+         * it should be called with the scheduler suspended. */
+
+
+        /* Place the event list item of the TCB in the appropriate event list.
+         * In this case it is assume that this is the only task that is going to
+         * be waiting on this event list, so the faster vListInsertEnd() function
+         * can be used in place of vListInsert. */
+        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+
+        #if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+        {
+            pxCurrentTCB->pxBlockingMutexHolder = NULL;
+        }
+        #endif
+
+        /* If the task should block indefinitely then set the block time to a
+         * value that will be recognised as an indefinite delay inside the
+         * prvAddCurrentTaskToDelayedList() function. */
+        if( xWaitIndefinitely != pdFALSE )
+        {
+            xTicksToWait = portMAX_DELAY;
+        }
+
+        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
+        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
+    }
+
+#endif /* configUSE_TIMERS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+
+    void vTaskPlaceWaitRecordOnEventList( List_t * const pxEventList,
+                                          TaskWaitRecord_t * const pxWaitRecord )
+    {
+        configASSERT( pxEventList );
+        configASSERT( pxWaitRecord );
+
+        /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED AND THE
+         * QUEUE BEING ACCESSED LOCKED. */
+
+        /* The record stands in for the task's event list item, so is placed
+         * in the event list in the same priority order. */
+        vListInitialiseItem( &( pxWaitRecord->xEventListItem ) );
+        listSET_LIST_ITEM_OWNER( &( pxWaitRecord->xEventListItem ), pxCurrentTCB );
+        listSET_LIST_ITEM_VALUE( &( pxWaitRecord->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+
+        taskENTER_CRITICAL();
+        {
+            vListInsert( pxEventList, &( pxWaitRecord->xEventListItem ) );
+            pxWaitRecord->pxNext = pxCurrentTCB->pxWaitRecords;
+            pxCurrentTCB->pxWaitRecords = pxWaitRecord;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_QUEUE_WAIT_FOR_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+
+    void vTaskBlockOnWaitRecords( const TickType_t xTicksToWait )
+    {
+        /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
+        configASSERT( pxCurrentTCB->pxWaitRecords != NULL );
+
+        pxCurrentTCB->pxSignalledWaitRecord = NULL;
+
+        #if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
+        {
+            pxCurrentTCB->pxBlockingMutexHolder = NULL;
+        }
+        #endif
+
+        prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+    }
+
+#endif /* configUSE_QUEUE_WAIT_FOR_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+
+    TaskWaitRecord_t * pxTaskGetSignalledWaitRecord( void )
+    {
+        /* The records were removed from their event lists when the calling
+         * task was unblocked, so nothing else writes this now. */
+        return pxCurrentTCB->pxSignalledWaitRecord;
+    }
+
+#endif /* configUSE_QUEUE_WAIT_FOR_ANY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+    void vTaskSetHandoffBuffer( void * pvBuffer )
+    {
+        /* Called before the task is placed on the event list, so no other
+         * task or interrupt reads these until the task is on the list. */
+        pxCurrentTCB->pvHandoffBuffer = pvBuffer;
+        pxCurrentTCB->xHandoffComplete = pdFALSE;
+    }
+
+#endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+    void * pvTaskClaimHandoffBuffer( const List_t * const pxEventList )
+    {
+        TCB_t * pxTCB;
+        void * pvBuffer = NULL;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION. */
+
+        if( listLIST_IS_EMPTY( pxEventList ) == pdFALSE )
+        {
+            /* The task at the head of the event list is the one
+             * xTaskRemoveFromEventList() unblocks. */
+            pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            pvBuffer = pxTCB->pvHandoffBuffer;
+
+            if( pvBuffer != NULL )
+            {
+                pxTCB->pvHandoffBuffer = NULL;
+                pxTCB->xHandoffComplete = pdTRUE;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pvBuffer;
+    }
+
+#endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_DIRECT_HANDOFF == 1 )
+
+    BaseType_t xTaskEndHandoff( void )
+    {
+        BaseType_t xReturn;
+
+        /* The task is no longer on the event list, so nothing else writes
+         * these now. */
+        xReturn = pxCurrentTCB->xHandoffComplete;
+        pxCurrentTCB->pvHandoffBuffer = NULL;
+        pxCurrentTCB->xHandoffComplete = pdFALSE;
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_DIRECT_HANDOFF */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+
+    static BaseType_t prvRemoveWaitRecords( TCB_t * const pxTCB,
+                                            const List_t * const pxSignalledList )
+    {
+        TaskWaitRecord_t * pxWaitRecord = pxTCB->pxWaitRecords;
+        const List_t * pxEventList;
+        BaseType_t xReturn = pdFALSE;
+
+        if( pxWaitRecord != NULL )
+        {
+            while( pxWaitRecord != NULL )
+            {
+                pxEventList = listLIST_ITEM_CONTAINER( &( pxWaitRecord->xEventListItem ) );
+
+                if( pxEventList != NULL )
+                {
+                    if( pxEventList == pxSignalledList )
+                    {
+                        pxTCB->pxSignalledWaitRecord = pxWaitRecord;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    listREMOVE_ITEM( &( pxWaitRecord->xEventListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxWaitRecord = pxWaitRecord->pxNext;
+            }
+
+            pxTCB->pxWaitRecords = NULL;
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_QUEUE_WAIT_FOR_ANY */
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+{
+    TCB_t * pxUnblockedTCB;
+    BaseType_t xReturn;
+
+    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+     * called from a critical section within an ISR. */
+
+    /* The event list is sorted in priority order, so the first in the list can
+     * be removed as it is known to be the highest priority.  Remove the TCB from
+     * the delayed list, and add it to the ready list.
+     *
+     * If an event is for a queue that is locked then this function will never
+     * get called - the lock count on the queue will get modified instead.  This
+     * means exclusive access to the event list is guaranteed here.
+     *
+     * This function assumes that a check has already been made to ensure that
+     * pxEventList is not empty. */
+    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+
+    #if ( configUSE_QUEUE_WAIT_FOR_ANY == 1 )
+    {
+        /* The head entry is one of the task's wait records if the task is
+         * blocked in xQueueWaitForAny(). */
+        if( prvRemoveWaitRecords( pxUnblockedTCB, pxEventList ) == pdFALSE )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #else
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+    }
+    #endif
+
+    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    {
+        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+        prvAddTaskToReadyList( pxUnblockedTCB );
+
+        #if ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+             * might be set to the blocked task's time out time.  If the task is
+             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+             * normally left unchanged, because it is automatically reset to a new
+             * value when the tick count equals xNextTaskUnblockTime.  However if
+             * tickless idling is used it might be more important to enter sleep mode
+             * at the earliest possible time - so reset xNextTaskUnblockTime here to
+             * ensure it is updated at the earliest possible time. */
+            prvResetNextTaskUnblockTime();
+        }
+        #endif
+    }
+    else
+    {
+        /* The delayed and ready lists cannot be accessed, so hold this task
+         * pending until the scheduler is resumed. */
+        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
+    }
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        if( taskTASK_CAN_PREEMPT( pxUnblockedTCB, pxCurrentTCB ) != pdFALSE )
+        {
+            /* Return true if the task removed from the event list has a higher
+             * priority than the calling task.  This allows the calling task to know if
+             * it should force a context switch now. */
+            xReturn = pdTRUE;
+
+            /* Mark that a yield is pending in case the user is not using the
+             * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
+            xYieldPending = pdTRUE;
+            portPEND_YIELD_FROM_ISR();
+        }
+        else
+        {
+            xReturn = pdFALSE;
+        }
+    }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+    {
+        xReturn = pdFALSE;
+
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            prvYieldForTask( pxUnblockedTCB );
+
+            /* Only report a required context switch if it is this core that
+             * must yield - other cores have already been interrupted. */
+            if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        #endif /* configUSE_PREEMPTION */
+    }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+
+    BaseType_t xTaskRemoveFromEventListFromISR( const List_t * const pxEventList )
+    {
+        TCB_t * pxUnblockedTCB;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION WITHIN AN ISR.
+         * As with xTaskRemoveFromEventList() the list is known not to be
+         * empty, and the task at its head is the one that will be unblocked. */
+        pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        configASSERT( pxUnblockedTCB );
+        taskRECORD_ISR_WAKE( pxUnblockedTCB );
+
+        return xTaskRemoveFromEventList( pxEventList );
+    }
+
+#endif /* configUSE_ISR_WAKE_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
+                                        const TickType_t xItemValue )
+{
+    TCB_t * pxUnblockedTCB;
+
+    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
+     * the event flags implementation. */
+    configASSERT( uxSchedulerSuspended != pdFALSE );
+
+    /* Store the new item value in the event list. */
+    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+    /* Remove the event list form the event flag.  Interrupts do not access
+     * event flags. */
+    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    configASSERT( pxUnblockedTCB );
+    listREMOVE_ITEM( pxEventListItem );
+
+    #if ( configUSE_TICKLESS_IDLE != 0 )
+    {
+        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
+         * might be set to the blocked task's time out time.  If the task is
+         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
+         * normally left unchanged, because it is automatically reset to a new
+         * value when the tick count equals xNextTaskUnblockTime.  However if
+         * tickless idling is used it might be more important to enter sleep mode
+         * at the earliest possible time - so reset xNextTaskUnblockTime here to
+         * ensure it is updated at the earliest possible time. */
+        prvResetNextTaskUnblockTime();
+    }
+    #endif
+
+    /* Remove the task from the delayed list and add it to the ready list.  The
+     * scheduler is suspended so interrupts will not be accessing the ready
+     * lists. */
+    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+    prvAddTaskToReadyList( pxUnblockedTCB );
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        if( taskTASK_CAN_PREEMPT( pxUnblockedTCB, pxCurrentTCB ) != pdFALSE )
+        {
+            /* The unblocked task has a priority above that of the calling task, so
+             * a context switch is required.  This function is called with the
+             * scheduler suspended so xYieldPending is set so the context switch
+             * occurs immediately that the scheduler is resumed (unsuspended). */
+            xYieldPending = pdTRUE;
+        }
+    }
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+    {
+        #if ( configUSE_PREEMPTION == 1 )
+        {
+            /* Suspending the scheduler only stops this core from switching,
+             * so a critical section is needed to touch the other cores. */
+            taskENTER_CRITICAL();
+            {
+                prvYieldForTask( pxUnblockedTCB );
+            }
+            taskEXIT_CRITICAL();
+        }
+        #endif
+    }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR == 1 )
+
+    BaseType_t xTaskRemoveFromUnorderedEventListFromISR( ListItem_t * pxEventListItem,
+                                                         const TickType_t xItemValue )
+    {
+        TCB_t * pxUnblockedTCB;
+        BaseType_t xReturn;
+
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
+         * called from a critical section within an ISR. */
+
+        /* Store the new item value in the event list. */
+        listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+
+        /* Remove the event list item from the event flag.  The event flag only
+         * accesses its event lists from within critical sections when this
+         * function is used, so exclusive access is guaranteed here. */
+        pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        configASSERT( pxUnblockedTCB );
+        listREMOVE_ITEM( pxEventListItem );
+
+        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        {
+            listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
+            prvAddTaskToReadyList( pxUnblockedTCB );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                /* See the comment in xTaskRemoveFromEventList(). */
+                prvResetNextTaskUnblockTime();
+            }
+            #endif
+        }
+        else
+        {
+            /* The delayed and ready lists cannot be accessed, so hold this task
+             * pending until the scheduler is resumed.  The item value is not
+             * changed by the pending ready list, so the task can still read the
+             * event bits that unblocked it. */
+            listINSERT_END( &( xPendingReadyList ), pxEventListItem );
+        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( taskTASK_CAN_PREEMPT( pxUnblockedTCB, pxCurrentTCB ) != pdFALSE )
+            {
+                /* Return true if the task removed from the event list has a
+                 * higher priority than the calling task, and mark that a yield is
+                 * pending in case the caller does not use the return value. */
+                xReturn = pdTRUE;
+                xYieldPending = pdTRUE;
+                portPEND_YIELD_FROM_ISR();
+            }
+            else
+            {
+                xReturn = pdFALSE;
+            }
+        }
+        #else /* if ( configNUMBER_OF_CORES == 1 ) */
+        {
+            xReturn = pdFALSE;
+
+            #if ( configUSE_PREEMPTION == 1 )
+            {
+                prvYieldForTask( pxUnblockedTCB );
+
+                /* Only report a required context switch if it is this core that
+                 * must yield - other cores have already been interrupted. */
+                if( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE )
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            #endif /* configUSE_PREEMPTION */
+        }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+        return xReturn;
+    }
+
+#endif /* configUSE_EVENT_GROUP_DIRECT_SET_FROM_ISR */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) )
+
+    void vTaskSetTickTimerExpiry( const TickType_t xExpiryTime )
+    {
+        /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  The tick
+         * interrupt sets both values again on the next tick, so a timer that
+         * is stopped before it expires causes at most one extra tick. */
+        if( xExpiryTime < xNextTickTimerExpiry )
+        {
+            xNextTickTimerExpiry = xExpiryTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        if( xExpiryTime < xNextTaskUnblockTime )
+        {
+            xNextTaskUnblockTime = xExpiryTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+
+#endif /* if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    configASSERT( pxTimeOut );
+    taskSTOP_DYNAMIC_TICK();
+    taskENTER_CRITICAL();
+    {
+        pxTimeOut->xOverflowCount = xNumOfOverflows;
+        pxTimeOut->xTimeOnEntering = xTickCount;
+    }
+    taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
+{
+    /* For internal use only as it does not use a critical section. */
+    taskSTOP_DYNAMIC_TICK();
+    pxTimeOut->xOverflowCount = xNumOfOverflows;
+    pxTimeOut->xTimeOnEntering = xTickCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
+                                 TickType_t * const pxTicksToWait )
+{
+    BaseType_t xReturn;
+
+    configASSERT( pxTimeOut );
+    configASSERT( pxTicksToWait );
+
+    taskSTOP_DYNAMIC_TICK();
+
+    taskENTER_CRITICAL();
+    {
+        /* Minor optimisation.  The tick count cannot change in this block. */
+        const TickType_t xConstTickCount = xTickCount;
+        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
+
+        #if ( INCLUDE_xTaskAbortDelay == 1 )
+            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
+            {
+                /* The delay was aborted, which is not the same as a time out,
+                 * but has the same result. */
+                pxCurrentTCB->ucDelayAborted = pdFALSE;
+                xReturn = pdTRUE;
+            }
+            else
+        #endif
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            if( *pxTicksToWait == portMAX_DELAY )
+            {
+                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
+                 * specified is the maximum block time then the task should block
+                 * indefinitely, and therefore never time out. */
+                xReturn = pdFALSE;
+            }
+            else
+        #endif
+
+        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
+        {
+            /* The tick count is greater than the time at which
+             * vTaskSetTimeout() was called, but has also overflowed since
+             * vTaskSetTimeOut() was called.  It must have wrapped all the way
+             * around and gone past again. This passed since vTaskSetTimeout()
+             * was called. */
+            xReturn = pdTRUE;
+            *pxTicksToWait = ( TickType_t ) 0;
+        }
+        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
+        {
+            /* Not a genuine timeout. Adjust parameters for time remaining. */
+            *pxTicksToWait -= xElapsedTime;
+            vTaskInternalSetTimeOutState( pxTimeOut );
+            xReturn = pdFALSE;
+        }
+        else
+        {
+            *pxTicksToWait = ( TickType_t ) 0;
+            xReturn = pdTRUE;
+        }
+    }
+    taskEXIT_CRITICAL();
+
+    return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vTaskMissedYield( void )
+{
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        xYieldPending = pdTRUE;
+    }
+    #else
+    {
+        xYieldPendings[ portGET_CORE_ID() ] = pdTRUE;
+    }
+    #endif
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    {
+        UBaseType_t uxReturn;
+        TCB_t const * pxTCB;
+
+        if( xTask != NULL )
+        {
+            pxTCB = xTask;
+            uxReturn = pxTCB->uxTaskNumber;
+        }
+        else
+        {
+            uxReturn = 0U;
+        }
+
+        return uxReturn;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vTaskSetTaskNumber( TaskHandle_t xTask,
+                             const UBaseType_t uxHandle )
+    {
+        TCB_t * pxTCB;
+
+        if( xTask != NULL )
+        {
+            pxTCB = xTask;
+            pxTCB->uxTaskNumber = uxHandle;
+        }
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+
+/*
+ * -----------------------------------------------------------
+ * The Idle task.
+ * ----------------------------------------------------------
+ *
+ * The portTASK_FUNCTION() macro is used to allow port/compiler specific
+ * language extensions.  The equivalent prototype for this function is:
+ *
+ * void prvIdleTask( void *pvParameters );
+ *
+ */
+static portTASK_FUNCTION( prvIdleTask, pvParameters )
+{
+    /* Stop warnings. */
+    ( void ) pvParameters;
+
+    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
+     * SCHEDULER IS STARTED. **/
+
+    /* In case a task that has a secure context deletes itself, in which case
+     * the idle task is responsible for deleting the task's secure context, if
+     * any. */
+    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+
+    #if ( configNUMBER_OF_CORES > 1 )
+    {
+        /* All cores start up running an idle task.  This initial yield gets
+         * the application tasks started. */
+        taskYIELD();
+    }
+    #endif
+
+    for( ; ; )
+    {
+        portIDLE_LOOP_HOOK();
+
+        #if ( configUSE_MIXED_CRITICALITY == 1 )
+        {
+            /* The idle task only runs when no other task is ready, which
+             * shows the load has subsided enough to leave high criticality
+             * mode. */
+            xIdleRanInHighMode = pdTRUE;
+        }
+        #endif
+
+        /* See if any tasks have deleted themselves - if so then the idle task
+         * is responsible for freeing the deleted task's TCB and stack.  With a
+         * single core the reaper task does this instead.  With more than one
+         * core the idle task still checks, as the reaper task cannot free a
+         * task that is still running on another core when it is notified. */
+        #if ( ( configUSE_TASK_REAPER == 0 ) || ( configNUMBER_OF_CORES > 1 ) )
+        {
+            prvCheckTasksWaitingTermination();
+        }
+        #endif
+
+        #if ( configUSE_PREEMPTION == 0 )
+        {
+            /* If we are not using preemption we keep forcing a task switch to
+             * see if any other task has become available.  If we are using
+             * preemption we don't need to do this as any task becoming available
+             * will automatically get the processor anyway. */
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                taskYIELD();
+            }
+            #else
+            {
+                /* Only switch when there is a task to take over, so an idle
+                 * core does not keep taking the scheduler locks the busy cores
+                 * need. */
+                if( prvReadyTaskIsWaiting() != pdFALSE )
+                {
+                    taskYIELD();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+        }
+        #endif /* configUSE_PREEMPTION */
+
+        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+        {
+            /* When using preemption tasks of equal priority will be
+             * timesliced.  If a task that is sharing the idle priority is ready
+             * to run then the idle task should yield before the end of the
+             * timeslice.
+             *
+             * A critical region is not required here as we are just reading from
+             * the list, and an occasional incorrect value will not matter.  If
+             * the ready list at the idle priority contains more than one task
+             * per core then a task other than an idle task is ready to
+             * execute. */
+            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+            {
+                taskYIELD();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+        #if ( configUSE_SCHEDULER_EVENT_HOOKS == 1 )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+                volatile BaseType_t * const pxEntryPending = &xIdleEntryPending;
+            #else
+                volatile BaseType_t * const pxEntryPending = &( xIdleEntryPending[ portGET_CORE_ID() ] );
+            #endif
+
+            /* Another task has run since the idle task last got here, so
+             * this core has just gone idle. */
+            if( *pxEntryPending != pdFALSE )
+            {
+                *pxEntryPending = pdFALSE;
+                vApplicationIdleEntryHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_SCHEDULER_EVENT_HOOKS */
+
+        #if ( configUSE_IDLE_HOOK == 1 )
+        {
+            /* Call the user defined function from within the idle task. */
+            vApplicationIdleHook();
+        }
+        #endif /* configUSE_IDLE_HOOK */
+
+        #if ( configUSE_IDLE_WORK == 1 )
+        {
+            prvRunIdleWork();
+        }
+        #endif
+
+        /* This conditional compilation should use inequality to 0, not equality
+         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
+         * user defined low power mode  implementations require
+         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
+        #if ( ( configUSE_TICKLESS_IDLE != 0 ) && ( configNUMBER_OF_CORES == 1 ) )
+        {
+            TickType_t xExpectedIdleTime;
+
+            #if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+                TickType_t xTimeBeforeSleep;
+            #endif
+
+            /* It is not desirable to suspend then resume the scheduler on
+             * each iteration of the idle task.  Therefore, a preliminary
+             * test of the expected idle time is performed without the
+             * scheduler suspended.  The result here is not necessarily
+             * valid. */
+            xExpectedIdleTime = prvGetExpectedIdleTime();
+
+            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            {
+                vTaskSuspendAll();
+                {
+                    /* Now the scheduler is suspended, the expected idle
+                     * time can be sampled again, and this time its value can
+                     * be used. */
+                    configASSERT( xNextTaskUnblockTime >= xTickCount );
+                    xExpectedIdleTime = prvGetExpectedIdleTime();
+
+                    /* Define the following macro to set xExpectedIdleTime to 0
+                     * if the application does not want
+                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
+                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+
+                    #if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+                    {
+                        /* Shortening the sleep by the exit latency of the
+                         * selected state may leave too little time to sleep,
+                         * so select before the time is checked. */
+                        prvSelectSleepState( &xExpectedIdleTime );
+                        xTimeBeforeSleep = xTickCount + xPendedTicks;
+                    }
+                    #endif
+
+                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+                    {
+                        traceLOW_POWER_IDLE_BEGIN();
+                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
+                        traceLOW_POWER_IDLE_END();
+
+                        #if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+                        {
+                            prvUpdateSleepPrediction( ( xTickCount + xPendedTicks ) - xTimeBeforeSleep );
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                ( void ) xTaskResumeAll();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #elif ( configUSE_TICKLESS_IDLE != 0 )
+        {
+            prvIdleCoreSleep();
+        }
+        #endif /* configUSE_TICKLESS_IDLE */
+    }
+}
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+/*
+ * -----------------------------------------------------------
+ * The passive idle task.
+ * ----------------------------------------------------------
+ *
+ * Runs on every core other than the one running prvIdleTask() when there is
+ * nothing else to do.  Freeing deleted tasks and calling the idle hook is
+ * left to prvIdleTask(), so the passive idle tasks only yield and call the
+ * optional passive idle hook.
+ */
+    static portTASK_FUNCTION( prvPassiveIdleTask, pvParameters )
+    {
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            #if ( configUSE_PREEMPTION == 0 )
+            {
+                /* Steal a ready task that is not running, if there is one.  See
+                 * the comment in prvIdleTask(). */
+                if( prvReadyTaskIsWaiting() != pdFALSE )
+                {
+                    taskYIELD();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_PREEMPTION */
+
+            #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
+            {
+                /* See the comment in prvIdleTask(). */
+                if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
+                {
+                    taskYIELD();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
+
+            #if ( configUSE_PASSIVE_IDLE_HOOK == 1 )
+            {
+                /* Call the user defined function from within the passive idle task. */
+                vApplicationPassiveIdleHook();
+            }
+            #endif /* configUSE_PASSIVE_IDLE_HOOK */
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
+            {
+                prvIdleCoreSleep();
+            }
+            #endif /* configUSE_TICKLESS_IDLE */
+        }
+    }
+
+#endif /* configNUMBER_OF_CORES > 1 */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    {
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            /* The idle tasks exist in addition to the application tasks. */
+            const UBaseType_t uxNonApplicationTasks = ( UBaseType_t ) configNUMBER_OF_CORES;
+        #endif /* INCLUDE_vTaskSuspend */
+
+        eSleepModeStatus eReturn = eStandardSleep;
+
+        /* This function must be called from a critical section. */
+
+        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+        {
+            /* A task was made ready while the scheduler was suspended. */
+            eReturn = eAbortSleep;
+        }
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            else if( xYieldPending != pdFALSE )
+            {
+                /* A yield was pended while the scheduler was suspended. */
+                eReturn = eAbortSleep;
+            }
+        #else
+            else if( prvAllCoresAreIdle() == pdFALSE )
+            {
+                /* A yield was pended while the scheduler was suspended. */
+                eReturn = eAbortSleep;
+            }
+            else if( uxCoresHalted != ( UBaseType_t ) ( configNUMBER_OF_CORES - 1 ) )
+            {
+                /* Another core has already woken, and will end this core's
+                 * sleep as soon as it starts. */
+                eReturn = eAbortSleep;
+            }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+        else if( xPendedTicks != 0 )
+        {
+            /* A tick interrupt has already occurred but was held pending
+             * because the scheduler is suspended. */
+            eReturn = eAbortSleep;
+        }
+
+        #if ( INCLUDE_vTaskSuspend == 1 )
+            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            {
+                /* If all the tasks are in the suspended list (which might mean they
+                 * have an infinite block time rather than actually being suspended)
+                 * then it is safe to turn all clocks off and just wait for external
+                 * interrupts. */
+                eReturn = eNoTasksWaitingTimeout;
+            }
+        #endif /* INCLUDE_vTaskSuspend */
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return eReturn;
+    }
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_SLEEP_STATE_GOVERNOR == 1 )
+
+    void vTaskSetSleepStates( const SleepState_t * pxStates,
+                              UBaseType_t uxNumberOfStates )
+    {
+        configASSERT( ( pxStates != NULL ) || ( uxNumberOfStates == 0U ) );
+
+        /* The idle task only reads the states with the scheduler suspended. */
+        vTaskSuspendAll();
+        {
+            if( pxStates != NULL )
+            {
+                pxSleepStates = pxStates;
+                uxNumberOfSleepStates = uxNumberOfStates;
+            }
+            else
+            {
+                pxSleepStates = NULL;
+                uxNumberOfSleepStates = ( UBaseType_t ) 0U;
+            }
+        }
+        ( void ) xTaskResumeAll();
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvSelectSleepState( TickType_t * pxExpectedIdleTime )
+    {
+        TickType_t xPredictedIdleTime;
+        UBaseType_t uxState = uxNumberOfSleepStates;
+        const SleepState_t * pxState;
+
+        pxSelectedSleepState = NULL;
+        xSleepEntered = pdFALSE;
+
+        /* Scale the expected idle time by the accuracy of past predictions,
+         * splitting the multiplication so it cannot overflow.  Wake ups
+         * before the expected time make the prediction shorter, so frequent
+         * early wake ups steer the selection towards shallower states. */
+        xPredictedIdleTime = ( TickType_t ) ( ( *pxExpectedIdleTime / tskSLEEP_ACCURACY_ONE ) * ulSleepPredictionAccuracy );
+        xPredictedIdleTime += ( TickType_t ) ( ( ( *pxExpectedIdleTime % tskSLEEP_ACCURACY_ONE ) * ulSleepPredictionAccuracy ) / tskSLEEP_ACCURACY_ONE );
+
+        /* The states are ordered shallowest first, so search from the end for
+         * the deepest state worth entering. */
+        while( ( uxState > ( UBaseType_t ) 0U ) && ( pxSelectedSleepState == NULL ) )
+        {
+            uxState--;
+            pxState = &( pxSleepStates[ uxState ] );
+
+            if( xPredictedIdleTime >= ( pxState->xEntryLatency + pxState->xExitLatency + pxState->xMinimumResidency ) )
+            {
+                /* Wake early enough for the state to be left by the time the
+                 * next task unblocks. */
+                pxSelectedSleepState = pxState;
+                *pxExpectedIdleTime -= pxState->xExitLatency;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvUpdateSleepPrediction( TickType_t xTimeSlept )
+    {
+        uint32_t ulSample;
+
+        /* Only sleeps the port actually entered say anything about the
+         * accuracy of the prediction. */
+        if( ( xSleepEntered != pdFALSE ) && ( xSleepRequestedTime > ( TickType_t ) 0U ) )
+        {
+            if( xTimeSlept >= xSleepRequestedTime )
+            {
+                ulSample = tskSLEEP_ACCURACY_ONE;
+            }
+            else if( xSleepRequestedTime <= ( TickType_t ) ( portMAX_DELAY / tskSLEEP_ACCURACY_ONE ) )
+            {
+                ulSample = ( uint32_t ) ( ( xTimeSlept * tskSLEEP_ACCURACY_ONE ) / xSleepRequestedTime );
+            }
+            else
+            {
+                ulSample = ( uint32_t ) ( xTimeSlept / ( xSleepRequestedTime / tskSLEEP_ACCURACY_ONE ) );
+
+                if( ulSample > tskSLEEP_ACCURACY_ONE )
+                {
+                    ulSample = tskSLEEP_ACCURACY_ONE;
+                }
+            }
+
+            ulSleepPredictionAccuracy -= ulSleepPredictionAccuracy >> tskSLEEP_ACCURACY_SHIFT;
+            ulSleepPredictionAccuracy += ulSample >> tskSLEEP_ACCURACY_SHIFT;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxSelectedSleepState = NULL;
+        xSleepEntered = pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskEnterSleepState( TickType_t * pxExpectedIdleTime )
+    {
+        /* Called by the port with its timer programmed for *pxExpectedIdleTime
+         * ticks, which may be less than the time the idle task asked for if
+         * the timer cannot count that far. */
+        if( pxSelectedSleepState != NULL )
+        {
+            pxSelectedSleepState->pxEnterState( pxExpectedIdleTime );
+        }
+
+        if( *pxExpectedIdleTime > ( TickType_t ) 0U )
+        {
+            xSleepEntered = pdTRUE;
+            xSleepRequestedTime = *pxExpectedIdleTime;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskExitSleepState( TickType_t xExpectedIdleTime )
+    {
+        if( pxSelectedSleepState != NULL )
+        {
+            pxSelectedSleepState->pxExitState( xExpectedIdleTime );
+        }
+    }
+
+#endif /* configUSE_SLEEP_STATE_GOVERNOR */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_IDLE_WORK == 1 )
+
+    BaseType_t xTaskQueueIdleWork( IdleWork_t * pxWork,
+                                   IdleWorkFunction_t pxFunction,
+                                   void * pvParameter,
+                                   UBaseType_t uxPriority )
+    {
+        BaseType_t xReturn = pdFAIL;
+
+        configASSERT( pxWork );
+        configASSERT( pxFunction );
+
+        taskENTER_CRITICAL();
+        {
+            if( listLIST_IS_INITIALISED( &xIdleWorkList ) == pdFALSE )
+            {
+                vListInitialise( &xIdleWorkList );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( listIS_CONTAINED_WITHIN( &xIdleWorkList, &( pxWork->xListItem ) ) == pdFALSE )
+            {
+                pxWork->pxFunction = pxFunction;
+                pxWork->pvParameter = pvParameter;
+
+                /* The list is held in ascending order of item value, and an
+                 * item is inserted after those of equal value, so inverting
+                 * the priority keeps the highest priority work at the head and
+                 * items of equal priority in the order they were queued. */
+                vListInitialiseItem( &( pxWork->xListItem ) );
+                listSET_LIST_ITEM_OWNER( &( pxWork->xListItem ), pxWork );
+                listSET_LIST_ITEM_VALUE( &( pxWork->xListItem ), portMAX_DELAY - ( TickType_t ) uxPriority );
+                vListInsert( &xIdleWorkList, &( pxWork->xListItem ) );
+
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTaskCancelIdleWork( IdleWork_t * pxWork )
+    {
+        BaseType_t xReturn = pdFAIL;
+
+        configASSERT( pxWork );
+
+        taskENTER_CRITICAL();
+        {
+            if( listIS_CONTAINED_WITHIN( &xIdleWorkList, &( pxWork->xListItem ) ) != pdFALSE )
+            {
+                ( void ) uxListRemove( &( pxWork->xListItem ) );
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* An item is taken off the list while its function runs, so stop
+             * the idle task putting it back afterwards. */
+            if( pxRunningIdleWork == pxWork )
+            {
+                xRunningIdleWorkCancelled = pdTRUE;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvRunIdleWork( void )
+    {
+        const TickType_t xStartTime = xTaskGetTickCount();
+        IdleWork_t * pxWork;
+        BaseType_t xMoreWork;
+
+        do
+        {
+            /* The list is not initialised until work is first queued, but an
+             * uninitialised list has no items so reads as empty. */
+            taskENTER_CRITICAL();
+            {
+                if( listLIST_IS_EMPTY( &xIdleWorkList ) == pdFALSE )
+                {
+                    pxWork = listGET_OWNER_OF_HEAD_ENTRY( &xIdleWorkList );
+                    ( void ) uxListRemove( &( pxWork->xListItem ) );
+                }
+                else
+                {
+                    pxWork = NULL;
+                }
+
+                pxRunningIdleWork = pxWork;
+                xRunningIdleWorkCancelled = pdFALSE;
+            }
+            taskEXIT_CRITICAL();
+
+            if( pxWork == NULL )
+            {
+                break;
+            }
+
+            xMoreWork = pxWork->pxFunction( pxWork->pvParameter );
+
+            taskENTER_CRITICAL();
+            {
+                /* Put the item back behind any others of the same priority,
+                 * unless it is complete, was cancelled, or was queued again
+                 * while it ran.  A cancelled item may already have been freed,
+                 * so it is not touched. */
+                if( ( xMoreWork != pdFALSE ) &&
+                    ( xRunningIdleWorkCancelled == pdFALSE ) &&
+                    ( listIS_CONTAINED_WITHIN( &xIdleWorkList, &( pxWork->xListItem ) ) == pdFALSE ) )
+                {
+                    vListInsert( &xIdleWorkList, &( pxWork->xListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxRunningIdleWork = NULL;
+            }
+            taskEXIT_CRITICAL();
+        } while( ( xTaskGetTickCount() - xStartTime ) < ( TickType_t ) configIDLE_WORK_BUDGET_TICKS );
+    }
+
+#endif /* configUSE_IDLE_WORK */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
+                                            BaseType_t xIndex,
+                                            void * pvValue )
+    {
+        TCB_t * pxTCB;
+
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToSet );
+            configASSERT( pxTCB != NULL );
+            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+        }
+    }
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+
+    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
+                                               BaseType_t xIndex )
+    {
+        void * pvReturn = NULL;
+        TCB_t * pxTCB;
+
+        if( ( xIndex >= 0 ) &&
+            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        {
+            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
+            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+        }
+        else
+        {
+            pvReturn = NULL;
+        }
+
+        return pvReturn;
+    }
+
+#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
+                                  const MemoryRegion_t * const xRegions )
+    {
+        TCB_t * pxTCB;
+
+        /* If null is passed in here then we are modifying the MPU settings of
+         * the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+
+        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+    }
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+#if ( portUSING_MPU_WRAPPERS == 1 )
+
+    xMPU_SETTINGS * xTaskGetMPUSettings( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        return &( pxTCB->xMPUSettings );
+    }
+
+#endif /* portUSING_MPU_WRAPPERS */
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseTaskLists( void )
+{
+    UBaseType_t uxPriority;
+
+    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    {
+        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
+    }
+
+    vListInitialise( &xDelayedTaskList1 );
+    vListInitialise( &xDelayedTaskList2 );
+    vListInitialise( &xPendingReadyList );
+
+    #if ( configUSE_TIME_PARTITIONS == 1 )
+    {
+        UBaseType_t uxPartition;
+
+        for( uxPartition = ( UBaseType_t ) 0U; uxPartition <= ( UBaseType_t ) configNUMBER_OF_TIME_PARTITIONS; uxPartition++ )
+        {
+            vListInitialise( &( xParkedTaskLists[ uxPartition ] ) );
+        }
+    }
+    #endif /* configUSE_TIME_PARTITIONS */
+
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+    {
+        vListInitialise( &xShedTaskList );
+    }
+    #endif /* configUSE_MIXED_CRITICALITY */
+
+    #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+    {
+        UBaseType_t uxSlot;
+
+        for( uxSlot = ( UBaseType_t ) 0U; uxSlot < ( UBaseType_t ) configDELAYED_TASK_WHEEL_SIZE; uxSlot++ )
+        {
+            vListInitialise( &( xDelayedTaskWheel[ uxSlot ] ) );
+        }
+    }
+    #endif /* configUSE_DELAYED_TASK_WHEEL */
+
+    #if ( configUSE_WAIT_ON_ADDRESS == 1 )
+    {
+        UBaseType_t uxList;
+
+        for( uxList = ( UBaseType_t ) 0U; uxList < ( UBaseType_t ) configWAIT_ON_ADDRESS_LISTS; uxList++ )
+        {
+            vListInitialise( &( xWaitOnAddressLists[ uxList ] ) );
+        }
+    }
+    #endif /* configUSE_WAIT_ON_ADDRESS */
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        vListInitialise( &xTasksWaitingTermination );
+    }
+    #endif /* INCLUDE_vTaskDelete */
+
+    #if ( INCLUDE_vTaskSuspend == 1 )
+    {
+        vListInitialise( &xSuspendedTaskList );
+    }
+    #endif /* INCLUDE_vTaskSuspend */
+
+    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+     * using list2. */
+    pxDelayedTaskList = &xDelayedTaskList1;
+    pxOverflowDelayedTaskList = &xDelayedTaskList2;
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_REAPER == 1 )
+
+    static portTASK_FUNCTION( prvReaperTask, pvParameters )
+    {
+        /* Stop warnings. */
+        ( void ) pvParameters;
+
+        for( ; ; )
+        {
+            /* The notification value counts the tasks that have deleted
+             * themselves since the termination list was last emptied. */
+            ( void ) ulTaskGenericNotifyTake( tskDEFAULT_INDEX_TO_NOTIFY, pdTRUE, portMAX_DELAY );
+            prvCheckTasksWaitingTermination();
+        }
+    }
+
+#endif /* configUSE_TASK_REAPER */
+/*-----------------------------------------------------------*/
+
+static void prvCheckTasksWaitingTermination( void )
+{
+    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK OR THE REAPER TASK **/
+
+    #if ( INCLUDE_vTaskDelete == 1 )
+    {
+        TCB_t * pxTCB;
+
+        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
+         * being called too often in the idle task. */
+        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+        {
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                taskENTER_CRITICAL();
+                {
+                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                    ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                    --uxCurrentNumberOfTasks;
+                    --uxDeletedTasksWaitingCleanUp;
+                }
+                taskEXIT_CRITICAL();
+
+                prvDeleteTCB( pxTCB );
+            }
+            #else /* if ( configNUMBER_OF_CORES == 1 ) */
+            {
+                pxTCB = NULL;
+
+                taskENTER_CRITICAL();
+                {
+                    /* Another core may have emptied the list since the
+                     * count was read outside of the critical section. */
+                    if( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+                    {
+                        pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                        /* A task that deleted itself is still running until
+                         * its core has switched away from it. */
+                        if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+                        {
+                            ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+                            --uxCurrentNumberOfTasks;
+                            --uxDeletedTasksWaitingCleanUp;
+                        }
+                        else
+                        {
+                            /* Try again on the next pass of the idle task. */
+                            pxTCB = NULL;
+                        }
+                    }
+                }
+                taskEXIT_CRITICAL();
+
+                if( pxTCB != NULL )
+                {
+                    prvDeleteTCB( pxTCB );
+                }
+                else
+                {
+                    break;
+                }
+            }
+            #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+        }
+    }
+    #endif /* INCLUDE_vTaskDelete */
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    void vTaskGetInfo( TaskHandle_t xTask,
+                       TaskStatus_t * pxTaskStatus,
+                       BaseType_t xGetFreeStackSpace,
+                       eTaskState eState )
+    {
+        TCB_t * pxTCB;
+
+        /* xTask is NULL then get the state of the calling task. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
+        pxTaskStatus->pcTaskName = ( const char * ) taskGET_TASK_NAME( pxTCB );
+        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
+        pxTaskStatus->pxStackBase = pxTCB->pxStack;
+        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
+            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
+            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
+        #endif
+        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+
+        #if ( configUSE_MUTEXES == 1 )
+        {
+            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
+        }
+        #else
+        {
+            pxTaskStatus->uxBasePriority = 0;
+        }
+        #endif
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
+        }
+        #else
+        {
+            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
+        }
+        #endif
+
+        #if ( configUSE_CORE_RUN_TIME_STATS == 1 )
+        {
+            pxTaskStatus->uxCoresRunOn = pxTCB->uxCoresRunOn;
+            pxTaskStatus->uxMigrations = pxTCB->uxMigrations;
+        }
+        #endif
+
+        /* Obtaining the task state is a little fiddly, so is only done if the
+         * value of eState passed into this function is eInvalid - otherwise the
+         * state is just set to whatever is passed in. */
+        if( eState != eInvalid )
+        {
+            if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+            {
+                pxTaskStatus->eCurrentState = eRunning;
+            }
+            else
+            {
+                pxTaskStatus->eCurrentState = eState;
+
+                #if ( INCLUDE_vTaskSuspend == 1 )
+                {
+                    /* If the task is in the suspended list then there is a
+                     *  chance it is actually just blocked indefinitely - so really
+                     *  it should be reported as being in the Blocked state. */
+                    if( eState == eSuspended )
+                    {
+                        vTaskSuspendAll();
+                        {
+                            if( taskIS_WAITING_ON_EVENT( pxTCB ) != pdFALSE )
+                            {
+                                pxTaskStatus->eCurrentState = eBlocked;
+                            }
+                        }
+                        ( void ) xTaskResumeAll();
+                    }
+                }
+                #endif /* INCLUDE_vTaskSuspend */
+            }
+        }
+        else
+        {
+            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
+        }
+
+        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
+         * parameter is provided to allow it to be skipped. */
+        if( xGetFreeStackSpace != pdFALSE )
+        {
+            pxTaskStatus->usStackHighWaterMark = prvTaskGetFreeStackSpace( pxTCB );
+        }
+        else
+        {
+            pxTaskStatus->usStackHighWaterMark = 0;
+        }
+
+        #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+        {
+            pxTaskStatus->xHeapBytesAllocated = pxTCB->xHeapBytesAllocated;
+        }
+        #endif
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TRACE_FACILITY == 1 )
+
+    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
+                                                     List_t * pxList,
+                                                     eTaskState eState )
+    {
+        configLIST_VOLATILE TCB_t * pxNextTCB;
+        configLIST_VOLATILE TCB_t * pxFirstTCB;
+        UBaseType_t uxTask = 0;
+
+        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        {
+            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+            /* Populate an TaskStatus_t structure within the
+             * pxTaskStatusArray array for each task that is referenced from
+             * pxList.  See the definition of TaskStatus_t in task.h for the
+             * meaning of each TaskStatus_t structure member. */
+            do
+            {
+                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
+                uxTask++;
+            } while( pxNextTCB != pxFirstTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxTask;
+    }
+
+#endif /* configUSE_TRACE_FACILITY */
+/*-----------------------------------------------------------*/
+
+#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+
+    #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 0 )
+
+        static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+        {
+            uint32_t ulCount = 0U;
+
+            while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
+            {
+                pucStackByte -= portSTACK_GROWTH;
+                ulCount++;
+            }
+
+            ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
+
+            return ( configSTACK_DEPTH_TYPE ) ulCount;
+        }
+
+    #endif /* configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK */
+/*-----------------------------------------------------------*/
+
+    static configSTACK_DEPTH_TYPE prvTaskGetFreeStackSpace( TCB_t * pxTCB )
+    {
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        #if ( configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK == 1 )
+        {
+            StackType_t xFillWord;
+            StackType_t * pxWord;
+            StackType_t * pxDeepest;
+            StackType_t * pxLimit;
+            UBaseType_t uxUnusedRun = 0U;
+
+            ( void ) memset( &xFillWord, ( int ) tskSTACK_FILL_BYTE, sizeof( xFillWord ) );
+
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                pxLimit = pxTCB->pxStack;
+            }
+            #else
+            {
+                pxLimit = pxTCB->pxEndOfStack;
+            }
+            #endif
+
+            /* Every word between the top of the stack and the deepest known
+             * point has been used, so only walk on from that point until a run
+             * of configSTACK_HIGH_WATER_MARK_GAP_WORDS unused words, or the end
+             * of the stack, is found. */
+            pxDeepest = pxTCB->pxStackHighWaterMark;
+            pxWord = pxDeepest;
+
+            while( ( pxWord != pxLimit ) && ( uxUnusedRun < ( UBaseType_t ) configSTACK_HIGH_WATER_MARK_GAP_WORDS ) )
+            {
+                pxWord += portSTACK_GROWTH;
+
+                if( *pxWord == xFillWord )
+                {
+                    uxUnusedRun++;
+                }
+                else
+                {
+                    uxUnusedRun = 0U;
+                    pxDeepest = pxWord;
+                }
+            }
+
+            /* The task may have been switched out at a deeper point while the
+             * stack was being scanned. */
+            taskENTER_CRITICAL();
+            {
+                #if ( portSTACK_GROWTH < 0 )
+                {
+                    if( pxDeepest < pxTCB->pxStackHighWaterMark )
+                    {
+                        pxTCB->pxStackHighWaterMark = pxDeepest;
+                    }
+
+                    uxReturn = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxStackHighWaterMark - pxTCB->pxStack );
+                }
+                #else
+                {
+                    if( pxDeepest > pxTCB->pxStackHighWaterMark )
+                    {
+                        pxTCB->pxStackHighWaterMark = pxDeepest;
+                    }
+
+                    uxReturn = ( configSTACK_DEPTH_TYPE ) ( pxTCB->pxEndOfStack - pxTCB->pxStackHighWaterMark );
+                }
+                #endif
+            }
+            taskEXIT_CRITICAL();
+        }
+        #else /* configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK */
+        {
+            #if ( portSTACK_GROWTH < 0 )
+            {
+                uxReturn = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+            }
+            #else
+            {
+                uxReturn = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+            }
+            #endif
+        }
+        #endif /* configUSE_INCREMENTAL_STACK_HIGH_WATER_MARK */
+
+        return uxReturn;
+    }
+
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+
+/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
+ * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
+ * user to determine the return type.  It gets around the problem of the value
+ * overflowing on 8-bit types without breaking backward compatibility for
+ * applications that expect an 8-bit return type. */
+    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        configSTACK_DEPTH_TYPE uxReturn;
+
+        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
+         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
+         * allows the user to determine the return type.  It gets around the
+         * problem of the value overflowing on 8-bit types without breaking
+         * backward compatibility for applications that expect an 8-bit return
+         * type. */
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        uxReturn = prvTaskGetFreeStackSpace( pxTCB );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+
+    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxReturn;
+
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        uxReturn = ( UBaseType_t ) prvTaskGetFreeStackSpace( pxTCB );
+
+        return uxReturn;
+    }
+
+#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+/*-----------------------------------------------------------*/
+
+#if ( INCLUDE_vTaskDelete == 1 )
+
+    static void prvDeleteTCB( TCB_t * pxTCB )
+    {
+        /* This call is required specifically for the TriCore port.  It must be
+         * above the vPortFree() calls.  The call is also used by ports/demos that
+         * want to allocate and clean RAM statically. */
+        portCLEAN_UP_TCB( pxTCB );
+
+        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+        {
+            /* Free up the memory allocated for the task's TLS Block. */
+            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+        }
+        #endif
+
+        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
+        {
+            /* The task can only have been allocated dynamically - free both
+             * the stack and TCB. */
+            vPortFreeStack( pxTCB->pxStack );
+            prvFreeTCB( pxTCB );
+        }
+        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+        {
+            /* The task could have been allocated statically or dynamically, so
+             * check what was statically allocated before trying to free the
+             * memory. */
+            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            {
+                /* Both the stack and TCB were allocated dynamically, so both
+                 * must be freed. */
+                vPortFreeStack( pxTCB->pxStack );
+                prvFreeTCB( pxTCB );
+            }
+            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+            {
+                /* Only the stack was statically allocated, so the TCB is the
+                 * only memory that must be freed. */
+                prvFreeTCB( pxTCB );
+            }
+            else
+            {
+                /* Neither the stack nor the TCB were allocated dynamically, so
+                 * nothing needs to be freed. */
+                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
+
+                #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+                {
+                    /* The application owns the memory of a statically
+                     * allocated TCB, so the TCB cannot be kept until the heap
+                     * memory still charged to the task is freed. */
+                    configASSERT( pxTCB->xHeapBytesAllocated == ( size_t ) 0 );
+                }
+                #endif
+
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+    }
+
+#endif /* INCLUDE_vTaskDelete */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_vTaskDelete == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+    static void prvFreeTCB( TCB_t * pxTCB )
+    {
+        #if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
         {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * block specific to the task that will run first. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
-        }
-        #endif
+            BaseType_t xDeferFree;
 
-        xNextTaskUnblockTime = portMAX_DELAY;
-        xSchedulerRunning = pdTRUE;
-        xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+            taskENTER_CRITICAL();
+            {
+                if( pxTCB->xHeapBytesAllocated != ( size_t ) 0 )
+                {
+                    /* vTaskHeapRelease() frees the TCB when the last block
+                     * charged to the task is freed. */
+                    pxTCB->ucHeapOwnerDeleted = pdTRUE;
+                    xDeferFree = pdTRUE;
+                }
+                else
+                {
+                    xDeferFree = pdFALSE;
+                }
+            }
+            taskEXIT_CRITICAL();
 
-        /* If configGENERATE_RUN_TIME_STATS is defined then the following
-         * macro must be defined to configure the timer/counter used to generate
-         * the run time counter time base.   NOTE:  If configGENERATE_RUN_TIME_STATS
-         * is set to 0 and the following line fails to build then ensure you do not
-         * have portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() defined in your
-         * FreeRTOSConfig.h file. */
-        portCONFIGURE_TIMER_FOR_RUN_TIME_STATS();
+            if( xDeferFree == pdFALSE )
+            {
+                vPortFreeObject( portOBJECT_POOL_TASK, pxTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #else /* if ( configUSE_TASK_HEAP_ACCOUNTING == 1 ) */
+        {
+            vPortFreeObject( portOBJECT_POOL_TASK, pxTCB );
+        }
+        #endif /* configUSE_TASK_HEAP_ACCOUNTING */
+    }
 
-        traceTASK_SWITCHED_IN();
+#endif /* ( INCLUDE_vTaskDelete == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+/*-----------------------------------------------------------*/
 
-        /* Setting up the timer tick is hardware specific and thus in the
-         * portable interface. */
-        xPortStartScheduler();
+static TCB_t * prvMovePendingReadyTask( void )
+{
+    TCB_t * pxTCB;
 
-        /* In most cases, xPortStartScheduler() will not return. If it
-         * returns pdTRUE then there was not enough heap memory available
-         * to create either the Idle or the Timer task. If it returned
-         * pdFALSE, then the application called xTaskEndScheduler().
-         * Most ports don't implement xTaskEndScheduler() as there is
-         * nothing to return to. */
+    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+    portMEMORY_BARRIER();
+    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+    prvAddTaskToReadyList( pxTCB );
+
+    #if ( configNUMBER_OF_CORES == 1 )
+    {
+        /* If the moved task has a priority higher than the current
+         * task then a yield must be performed. */
+        if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
+        {
+            xYieldPending = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-    else
+    #elif ( configUSE_PREEMPTION == 1 )
     {
-        /* This line will only be reached if the kernel could not be started,
-         * because there was not enough FreeRTOS heap to create the idle task
-         * or the timer task. */
-        configASSERT( xReturn != errCOULD_NOT_ALLOCATE_REQUIRED_MEMORY );
+        /* If the moved task has a priority higher than the task
+         * running on any core then that core must yield. */
+        prvYieldForTask( pxTCB );
     }
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
-    /* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
-     * meaning xIdleTaskHandle is not used anywhere else. */
-    ( void ) xIdleTaskHandle;
-
-    /* OpenOCD makes use of uxTopUsedPriority for thread debugging. Prevent uxTopUsedPriority
-     * from getting optimized out as it is no longer used by the kernel. */
-    ( void ) uxTopUsedPriority;
+    return pxTCB;
 }
 /*-----------------------------------------------------------*/
 
-void vTaskEndScheduler( void )
+#if ( configPENDING_READY_BATCH_SIZE > 0 )
+
+    static TCB_t * prvMovePendingReadyTasksInBatches( void )
+    {
+        TCB_t * pxTCB = NULL;
+        BaseType_t xMoreToMove = pdTRUE;
+        UBaseType_t uxMoved;
+
+        while( xMoreToMove != pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* The scheduler stays suspended while the batches are moved, so
+                 * interrupts that ready further tasks add them to the end of
+                 * xPendingReadyList, and no other task can run.  Only the
+                 * outermost xTaskResumeAll() moves tasks. */
+                if( ( uxSchedulerSuspended == ( UBaseType_t ) 1U ) &&
+                    ( listCURRENT_LIST_LENGTH( &xPendingReadyList ) > ( UBaseType_t ) configPENDING_READY_BATCH_SIZE ) )
+                {
+                    for( uxMoved = 0U; uxMoved < ( UBaseType_t ) configPENDING_READY_BATCH_SIZE; uxMoved++ )
+                    {
+                        pxTCB = prvMovePendingReadyTask();
+                    }
+                }
+                else
+                {
+                    xMoreToMove = pdFALSE;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+        return pxTCB;
+    }
+
+#endif /* configPENDING_READY_BATCH_SIZE */
+/*-----------------------------------------------------------*/
+
+static void prvResetNextTaskUnblockTime( void )
 {
-    /* Stop the scheduler interrupts and call the portable scheduler end
-     * routine so the original ISRs can be restored if necessary.  The port
-     * layer must ensure interrupts enable  bit is left in the correct state. */
-    portDISABLE_INTERRUPTS();
-    xSchedulerRunning = pdFALSE;
-    vPortEndScheduler();
+    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+    {
+        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+         * the maximum possible value so it is  extremely unlikely that the
+         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+         * there is an item in the delayed list. */
+        xNextTaskUnblockTime = portMAX_DELAY;
+    }
+    else
+    {
+        /* The new current delayed list is not empty, get the value of
+         * the item at the head of the delayed list.  This is the time at
+         * which the task at the head of the delayed list should be removed
+         * from the Blocked state. */
+        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
+    }
+
+    #if ( ( configUSE_TIMERS == 1 ) && ( configUSE_TIMER_TICK_CALLBACKS == 1 ) )
+    {
+        /* Nor must the tick at which the next timer that calls its callback
+         * from the tick interrupt expires be suppressed or skipped. */
+        if( xNextTickTimerExpiry < xNextTaskUnblockTime )
+        {
+            xNextTaskUnblockTime = xNextTickTimerExpiry;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+    #endif
 }
-/*----------------------------------------------------------*/
+/*-----------------------------------------------------------*/
 
-void vTaskSuspendAll( void )
-{
-    /* A critical section is not required as the variable is of type
-     * BaseType_t.  Please read Richard Barry's reply in the following link to a
-     * post in the FreeRTOS support forum before reporting this as a bug! -
-     * https://goo.gl/wu4acr */
+#if ( ( INCLUDE_vTaskDelay == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
 
-    /* portSOFTWARE_BARRIER() is only implemented for emulated/simulated ports that
-     * do not otherwise exhibit real time behaviour. */
-    portSOFTWARE_BARRIER();
+    static TickType_t prvGetCoalescedDelay( const TickType_t xTicksToDelay,
+                                            const TickType_t xSlackInTicks )
+    {
+        TickType_t xReturn = xTicksToDelay;
+        TickType_t xLatestDelay = xTicksToDelay + xSlackInTicks;
+        TickType_t xTicksAhead;
 
-    /* The scheduler is suspended if uxSchedulerSuspended is non-zero.  An increment
-     * is used to allow calls to vTaskSuspendAll() to nest. */
-    ++uxSchedulerSuspended;
+        if( xLatestDelay < xTicksToDelay )
+        {
+            xLatestDelay = portMAX_DELAY;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    /* Enforces ordering for ports and optimised compilers that may otherwise place
-     * the above increment elsewhere. */
-    portMEMORY_BARRIER();
-}
-/*----------------------------------------------------------*/
+        /* Every task in the delayed list wakes before every task in the
+         * overflow delayed list, so the overflow delayed list only needs to be
+         * searched if no task in the delayed list wakes late enough. */
+        xTicksAhead = prvGetTicksToFirstWakeAfter( pxDelayedTaskList, xTicksToDelay );
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+        if( xTicksAhead == ( TickType_t ) 0U )
+        {
+            xTicksAhead = prvGetTicksToFirstWakeAfter( pxOverflowDelayedTaskList, xTicksToDelay );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    static TickType_t prvGetExpectedIdleTime( void )
+        if( ( xTicksAhead != ( TickType_t ) 0U ) && ( xTicksAhead <= xLatestDelay ) )
+        {
+            xReturn = xTicksAhead;
+            xLatestDelay = xTicksAhead;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+        {
+            /* A task in the wheel might wake earlier still.  The slot of each
+             * tick within one revolution of the wheel only holds tasks that
+             * wake on that tick. */
+            for( xTicksAhead = xTicksToDelay; ( xTicksAhead <= xLatestDelay ) && ( xTicksAhead < ( TickType_t ) configDELAYED_TASK_WHEEL_SIZE ); xTicksAhead++ )
+            {
+                if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ ( xTickCount + xTicksAhead ) & taskDELAYED_TASK_WHEEL_MASK ] ) ) == pdFALSE )
+                {
+                    xReturn = xTicksAhead;
+                    break;
+                }
+            }
+        }
+        #endif /* configUSE_DELAYED_TASK_WHEEL */
+
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvGetTicksToFirstWakeAfter( const List_t * const pxList,
+                                                   const TickType_t xTicksToDelay )
     {
-        TickType_t xReturn;
-        UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+        const ListItem_t * pxListItem;
+        TickType_t xTicksAhead;
+        TickType_t xReturn = ( TickType_t ) 0U;
 
-        /* uxHigherPriorityReadyTasks takes care of the case where
-         * configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
-         * task that are in the Ready state, even though the idle task is
-         * running. */
-        #if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+        /* The list is in wake time order, and the wake times of the tasks in
+         * it are all either after the tick count or, in the overflow delayed
+         * list, after the tick count overflows, so the number of ticks until
+         * each task wakes only ever increases along the list. */
+        for( pxListItem = listGET_HEAD_ENTRY( pxList ); pxListItem != listGET_END_MARKER( pxList ); pxListItem = listGET_NEXT( pxListItem ) )
         {
-            if( uxTopReadyPriority > tskIDLE_PRIORITY )
+            xTicksAhead = listGET_LIST_ITEM_VALUE( pxListItem ) - xTickCount;
+
+            if( xTicksAhead >= xTicksToDelay )
             {
-                uxHigherPriorityReadyTasks = pdTRUE;
+                xReturn = xTicksAhead;
+                break;
             }
         }
-        #else
+
+        return xReturn;
+    }
+
+#endif /* ( ( INCLUDE_vTaskDelay == 1 ) && ( configUSE_TIMER_SLACK == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+    static TickType_t prvGetNextTaskUnblockTime( void )
+    {
+        TickType_t xReturn = xNextTaskUnblockTime;
+        TickType_t xTicksAhead;
+
+        /* Only the slots before xNextTaskUnblockTime need to be checked.  This
+         * is only called when the idle task is about to suppress the tick or
+         * when several ticks are processed at once, so the cost of walking the
+         * wheel is not paid on every tick. */
+        for( xTicksAhead = ( TickType_t ) 1; xTicksAhead < ( TickType_t ) configDELAYED_TASK_WHEEL_SIZE; xTicksAhead++ )
+        {
+            /* xNextTaskUnblockTime is never before xTickCount, so this also
+             * stops the search before the tick count would overflow. */
+            if( xTicksAhead >= ( xReturn - xTickCount ) )
+            {
+                break;
+            }
+
+            if( listLIST_IS_EMPTY( &( xDelayedTaskWheel[ ( xTickCount + xTicksAhead ) & taskDELAYED_TASK_WHEEL_MASK ] ) ) == pdFALSE )
+            {
+                xReturn = xTickCount + xTicksAhead;
+                break;
+            }
+        }
+
+        return xReturn;
+    }
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
+
+    #if ( configNUMBER_OF_CORES == 1 )
+
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
         {
-            const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+            TaskHandle_t xReturn;
 
-            /* When port optimised task selection is used the uxTopReadyPriority
-             * variable is used as a bit map.  If bits other than the least
-             * significant bit are set then there are tasks that have a priority
-             * above the idle priority that are in the Ready state.  This takes
-             * care of the case where the co-operative scheduler is in use. */
-            if( uxTopReadyPriority > uxLeastSignificantBit )
+            /* A critical section is not required as this is not called from
+             * an interrupt and the current TCB will always be the same for any
+             * individual execution thread. */
+            xReturn = pxCurrentTCB;
+
+            return xReturn;
+        }
+
+    #else /* if ( configNUMBER_OF_CORES == 1 ) */
+
+        TaskHandle_t xTaskGetCurrentTaskHandle( void )
+        {
+            TaskHandle_t xReturn;
+            UBaseType_t uxSavedInterruptStatus;
+
+            /* Interrupts are masked so the calling task cannot be moved to
+             * another core between reading the core ID and the TCB. */
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
             {
-                uxHigherPriorityReadyTasks = pdTRUE;
+                xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+            }
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+            return xReturn;
+        }
+/*-----------------------------------------------------------*/
+
+        TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+        {
+            TaskHandle_t xReturn = NULL;
+
+            if( taskVALID_CORE_ID( xCoreID ) != pdFALSE )
+            {
+                xReturn = pxCurrentTCBs[ xCoreID ];
             }
+
+            return xReturn;
+        }
+
+    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    BaseType_t xTaskIsRunningOnOtherCore( TaskHandle_t xTask )
+    {
+        const TCB_t * const pxTCB = xTask;
+        BaseType_t xReturn = pdFALSE;
+
+        /* Called from a critical section, so neither the task nor the caller
+         * can change core while the run state is checked. */
+        if( ( pxTCB != NULL ) &&
+            ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) &&
+            ( pxTCB->xTaskRunState != ( BaseType_t ) portGET_CORE_ID() ) )
+        {
+            xReturn = pdTRUE;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 ) */
 
-        if( pxCurrentTCB->uxPriority > tskIDLE_PRIORITY )
-        {
-            xReturn = 0;
-        }
-        else if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > 1 )
-        {
-            /* There are other idle priority tasks in the ready state.  If
-             * time slicing is used then the very next tick interrupt must be
-             * processed. */
-            xReturn = 0;
-        }
-        else if( uxHigherPriorityReadyTasks != pdFALSE )
+        return xReturn;
+    }
+
+#endif /* configNUMBER_OF_CORES > 1 */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+
+    BaseType_t xTaskGetSchedulerState( void )
+    {
+        BaseType_t xReturn;
+
+        if( xSchedulerRunning == pdFALSE )
         {
-            /* There are tasks in the Ready state that have a priority above the
-             * idle priority.  This path can only be reached if
-             * configUSE_PREEMPTION is 0. */
-            xReturn = 0;
+            xReturn = taskSCHEDULER_NOT_STARTED;
         }
         else
         {
-            xReturn = xNextTaskUnblockTime - xTickCount;
+            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+            {
+                xReturn = taskSCHEDULER_RUNNING;
+            }
+            else
+            {
+                xReturn = taskSCHEDULER_SUSPENDED;
+            }
         }
 
         return xReturn;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskResumeAll( void )
-{
-    TCB_t * pxTCB = NULL;
-    BaseType_t xAlreadyYielded = pdFALSE;
+#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
 
-    /* If uxSchedulerSuspended is zero then this function does not match a
-     * previous call to vTaskSuspendAll(). */
-    configASSERT( uxSchedulerSuspended );
+#if ( configUSE_MUTEXES == 1 )
 
-    /* It is possible that an ISR caused a task to be removed from an event
-     * list while the scheduler was suspended.  If this was the case then the
-     * removed task will have been added to the xPendingReadyList.  Once the
-     * scheduler has been resumed it is safe to move all the pending ready
-     * tasks from this list into their appropriate ready list. */
-    taskENTER_CRITICAL();
+    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
     {
-        --uxSchedulerSuspended;
+        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxItemsRemaining;
 
-        if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+        /* If the mutex was given back by an interrupt while the queue was
+         * locked then the mutex holder might now be NULL.  _RB_ Is this still
+         * needed as interrupts can no longer use mutexes? */
+        if( pxMutexHolder != NULL )
         {
-            if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
+            /* If the holder of the mutex has a priority below the priority of
+             * the task attempting to obtain the mutex then it will temporarily
+             * inherit the priority of the task attempting to obtain the mutex. */
+            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
             {
-                /* Move any readied tasks from the pending list into the
-                 * appropriate ready list. */
-                while( listLIST_IS_EMPTY( &xPendingReadyList ) == pdFALSE )
+                /* Adjust the mutex holder state to account for its new
+                 * priority.  Only reset the event list item value if the value is
+                 * not being used for anything else. */
+                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
                 {
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xPendingReadyList ) ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
-                    portMEMORY_BARRIER();
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* If the moved task has a priority higher than the current
-                     * task then a yield must be performed. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                    {
-                        xYieldPending = pdTRUE;
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
                 }
-
-                if( pxTCB != NULL )
+                else
                 {
-                    /* A task was unblocked while the scheduler was suspended,
-                     * which may have prevented the next unblock time from being
-                     * re-calculated, in which case re-calculate it now.  Mainly
-                     * important for low power tickless implementations, where
-                     * this can prevent an unnecessary exit from low power
-                     * state. */
-                    prvResetNextTaskUnblockTime();
+                    mtCOVERAGE_TEST_MARKER();
                 }
 
-                /* If any ticks occurred while the scheduler was suspended then
-                 * they should be processed now.  This ensures the tick count does
-                 * not  slip, and that any delayed tasks are resumed at the correct
-                 * time. */
+                /* If the task being modified is in the ready state it will need
+                 * to be moved into a new list. */
+                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
                 {
-                    TickType_t xPendedCounts = xPendedTicks; /* Non-volatile copy. */
+                    listFAST_REMOVE_COUNT( &( pxMutexHolderTCB->xStateListItem ), uxItemsRemaining );
 
-                    if( xPendedCounts > ( TickType_t ) 0U )
+                    if( uxItemsRemaining == ( UBaseType_t ) 0 )
                     {
-                        do
-                        {
-                            if( xTaskIncrementTick() != pdFALSE )
-                            {
-                                xYieldPending = pdTRUE;
-                            }
-                            else
-                            {
-                                mtCOVERAGE_TEST_MARKER();
-                            }
-
-                            --xPendedCounts;
-                        } while( xPendedCounts > ( TickType_t ) 0U );
-
-                        xPendedTicks = 0;
+                        /* It is known that the task is in its ready list so
+                         * there is no need to check again and the port level
+                         * reset macro can be called directly. */
+                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
+
+                    /* Inherit the priority before being moved into the new list. */
+                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
+                    prvAddTaskToReadyList( pxMutexHolderTCB );
+                }
+                else
+                {
+                    /* Just inherit the priority. */
+                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
                 }
 
-                if( xYieldPending != pdFALSE )
+                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
+
+                #if ( configPRIORITY_INHERITANCE_DEPTH > 1 )
                 {
-                    #if ( configUSE_PREEMPTION != 0 )
-                    {
-                        xAlreadyYielded = pdTRUE;
-                    }
-                    #endif
-                    taskYIELD_IF_USING_PREEMPTION();
+                    /* The holder might itself be blocked on a mutex. */
+                    prvPropagateInheritedPriority( pxMutexHolderTCB, pdTRUE );
+                }
+                #endif
+
+                /* Inheritance occurred. */
+                xReturn = pdTRUE;
+            }
+            else
+            {
+                if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
+                {
+                    /* The base priority of the mutex holder is lower than the
+                     * priority of the task attempting to take the mutex, but the
+                     * current priority of the mutex holder is not lower than the
+                     * priority of the task attempting to take the mutex.
+                     * Therefore the mutex holder must have already inherited a
+                     * priority, but inheritance would have occurred if that had
+                     * not been the case. */
+                    xReturn = pdTRUE;
                 }
                 else
                 {
@@ -2278,2815 +11084,3475 @@ BaseType_t xTaskResumeAll( void )
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return xReturn;
     }
-    taskEXIT_CRITICAL();
 
-    return xAlreadyYielded;
-}
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-TickType_t xTaskGetTickCount( void )
-{
-    TickType_t xTicks;
+#if ( configUSE_MUTEX_PRIORITY_CEILING == 1 )
 
-    /* Critical section required if running on a 16 bit processor. */
-    portTICK_TYPE_ENTER_CRITICAL();
+    void vTaskPriorityRaiseToCeiling( UBaseType_t uxCeilingPriority )
     {
-        xTicks = xTickCount;
-    }
-    portTICK_TYPE_EXIT_CRITICAL();
+        TCB_t * const pxTCB = pxCurrentTCB;
+        UBaseType_t uxItemsRemaining;
 
-    return xTicks;
-}
-/*-----------------------------------------------------------*/
+        configASSERT( pxTCB );
+        configASSERT( pxTCB->uxMutexesHeld );
 
-TickType_t xTaskGetTickCountFromISR( void )
-{
-    TickType_t xReturn;
-    UBaseType_t uxSavedInterruptStatus;
+        /* Only the priority the task is running at is changed.  The base
+         * priority is left alone so xTaskPriorityDisinherit() restores it when
+         * the task gives back its last mutex. */
+        if( pxTCB->uxPriority < uxCeilingPriority )
+        {
+            /* The calling task is running so is in a ready list, and its event
+             * list item value cannot be in use for anything else. */
+            listFAST_REMOVE_COUNT( &( pxTCB->xStateListItem ), uxItemsRemaining );
 
-    /* RTOS ports that support interrupt nesting have the concept of a maximum
-     * system call (or maximum API call) interrupt priority.  Interrupts that are
-     * above the maximum system call priority are kept permanently enabled, even
-     * when the RTOS kernel is in a critical section, but cannot make any calls to
-     * FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-     * then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-     * failure if a FreeRTOS API function is called from an interrupt that has been
-     * assigned a priority above the configured maximum system call priority.
-     * Only FreeRTOS functions that end in FromISR can be called from interrupts
-     * that have been assigned a priority at or (logically) below the maximum
-     * system call  interrupt priority.  FreeRTOS maintains a separate interrupt
-     * safe API to ensure interrupt entry is as fast and as simple as possible.
-     * More information (albeit Cortex-M specific) is provided on the following
-     * link: https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-    portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+            if( uxItemsRemaining == ( UBaseType_t ) 0 )
+            {
+                portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-    uxSavedInterruptStatus = portTICK_TYPE_SET_INTERRUPT_MASK_FROM_ISR();
-    {
-        xReturn = xTickCount;
+            traceTASK_PRIORITY_INHERIT( pxTCB, uxCeilingPriority );
+            pxTCB->uxPriority = uxCeilingPriority;
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxCeilingPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            prvAddTaskToReadyList( pxTCB );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
-    portTICK_TYPE_CLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-
-    return xReturn;
-}
-/*-----------------------------------------------------------*/
-
-UBaseType_t uxTaskGetNumberOfTasks( void )
-{
-    /* A critical section is not required because the variables are of type
-     * BaseType_t. */
-    return uxCurrentNumberOfTasks;
-}
-/*-----------------------------------------------------------*/
-
-char * pcTaskGetName( TaskHandle_t xTaskToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
-{
-    TCB_t * pxTCB;
 
-    /* If null is passed in here then the name of the calling task is being
-     * queried. */
-    pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-    configASSERT( pxTCB );
-    return &( pxTCB->pcTaskName[ 0 ] );
-}
+#endif /* configUSE_MUTEX_PRIORITY_CEILING */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( configUSE_MUTEXES == 1 )
 
-    static TCB_t * prvSearchForNameWithinSingleList( List_t * pxList,
-                                                     const char pcNameToQuery[] )
+    BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
     {
-        TCB_t * pxNextTCB;
-        TCB_t * pxFirstTCB;
-        TCB_t * pxReturn = NULL;
-        UBaseType_t x;
-        char cNextChar;
-        BaseType_t xBreakLoop;
-
-        /* This function is called with the scheduler suspended. */
+        TCB_t * const pxTCB = pxMutexHolder;
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t uxItemsRemaining;
 
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        if( pxMutexHolder != NULL )
         {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            /* A task can only have an inherited priority if it holds the mutex.
+             * If the mutex is held by a task then it cannot be given from an
+             * interrupt, and if a mutex is given by the holding task then it must
+             * be the running state task. */
+            configASSERT( pxTCB == pxCurrentTCB );
+            configASSERT( pxTCB->uxMutexesHeld );
+            ( pxTCB->uxMutexesHeld )--;
 
-            do
+            /* Has the holder of the mutex inherited the priority of another
+             * task? */
+            if( pxTCB->uxPriority != pxTCB->uxBasePriority )
             {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-                /* Check each character in the name looking for a match or
-                 * mismatch. */
-                xBreakLoop = pdFALSE;
-
-                for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
+                /* Only disinherit if no other mutexes are held. */
+                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
                 {
-                    cNextChar = pxNextTCB->pcTaskName[ x ];
+                    /* A task can only have an inherited priority if it holds
+                     * the mutex.  If the mutex is held by a task then it cannot be
+                     * given from an interrupt, and if a mutex is given by the
+                     * holding task then it must be the running state task.  Remove
+                     * the holding task from the ready list. */
+                    listFAST_REMOVE_COUNT( &( pxTCB->xStateListItem ), uxItemsRemaining );
 
-                    if( cNextChar != pcNameToQuery[ x ] )
+                    if( uxItemsRemaining == ( UBaseType_t ) 0 )
                     {
-                        /* Characters didn't match. */
-                        xBreakLoop = pdTRUE;
-                    }
-                    else if( cNextChar == ( char ) 0x00 )
-                    {
-                        /* Both strings terminated, a match must have been
-                         * found. */
-                        pxReturn = pxNextTCB;
-                        xBreakLoop = pdTRUE;
+                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
 
-                    if( xBreakLoop != pdFALSE )
-                    {
-                        break;
-                    }
+                    /* Disinherit the priority before adding the task into the
+                     * new  ready list. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
+                    pxTCB->uxPriority = pxTCB->uxBasePriority;
+
+                    /* Reset the event list item value.  It cannot be in use for
+                     * any other purpose if this task is running, and it must be
+                     * running to give back the mutex. */
+                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    prvAddTaskToReadyList( pxTCB );
+
+                    /* Return true to indicate that a context switch is required.
+                     * This is only actually required in the corner case whereby
+                     * multiple mutexes were held and the mutexes were given back
+                     * in an order different to that in which they were taken.
+                     * If a context switch did not occur when the first mutex was
+                     * returned, even if a task was waiting on it, then a context
+                     * switch should occur when the last mutex is returned whether
+                     * a task is waiting on it or not. */
+                    xReturn = pdTRUE;
                 }
-
-                if( pxReturn != NULL )
+                else
                 {
-                    /* The handle has been found. */
-                    break;
+                    mtCOVERAGE_TEST_MARKER();
                 }
-            } while( pxNextTCB != pxFirstTCB );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        return pxReturn;
+        return xReturn;
     }
 
-#endif /* INCLUDE_xTaskGetHandle */
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetHandle == 1 )
+#if ( configUSE_MUTEXES == 1 )
 
-    TaskHandle_t xTaskGetHandle( const char * pcNameToQuery ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
+                                              UBaseType_t uxHighestPriorityWaitingTask )
     {
-        UBaseType_t uxQueue = configMAX_PRIORITIES;
-        TCB_t * pxTCB;
-
-        /* Task names will be truncated to configMAX_TASK_NAME_LEN - 1 bytes. */
-        configASSERT( strlen( pcNameToQuery ) < configMAX_TASK_NAME_LEN );
+        TCB_t * const pxTCB = pxMutexHolder;
+        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
+        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+        UBaseType_t uxItemsRemaining;
 
-        vTaskSuspendAll();
+        if( pxMutexHolder != NULL )
         {
-            /* Search the ready lists. */
-            do
-            {
-                uxQueue--;
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) &( pxReadyTasksLists[ uxQueue ] ), pcNameToQuery );
-
-                if( pxTCB != NULL )
-                {
-                    /* Found the handle. */
-                    break;
-                }
-            } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-
-            /* Search the delayed lists. */
-            if( pxTCB == NULL )
-            {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
-            }
+            /* If pxMutexHolder is not NULL then the holder must hold at least
+             * one mutex. */
+            configASSERT( pxTCB->uxMutexesHeld );
 
-            if( pxTCB == NULL )
+            /* Determine the priority to which the priority of the task that
+             * holds the mutex should be set.  This will be the greater of the
+             * holding task's base priority and the priority of the highest
+             * priority task that is waiting to obtain the mutex. */
+            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
             {
-                pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+                uxPriorityToUse = uxHighestPriorityWaitingTask;
             }
-
-            #if ( INCLUDE_vTaskSuspend == 1 )
+            else
             {
-                if( pxTCB == NULL )
-                {
-                    /* Search the suspended list. */
-                    pxTCB = prvSearchForNameWithinSingleList( &xSuspendedTaskList, pcNameToQuery );
-                }
+                uxPriorityToUse = pxTCB->uxBasePriority;
             }
-            #endif
 
-            #if ( INCLUDE_vTaskDelete == 1 )
+            /* Does the priority need to change? */
+            if( pxTCB->uxPriority != uxPriorityToUse )
             {
-                if( pxTCB == NULL )
+                /* Only disinherit if no other mutexes are held.  This is a
+                 * simplification in the priority inheritance implementation.  If
+                 * the task that holds the mutex is also holding other mutexes then
+                 * the other mutexes may have caused the priority inheritance. */
+                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
                 {
-                    /* Search the deleted list. */
-                    pxTCB = prvSearchForNameWithinSingleList( &xTasksWaitingTermination, pcNameToQuery );
-                }
-            }
-            #endif
-        }
-        ( void ) xTaskResumeAll();
-
-        return pxTCB;
-    }
-
-#endif /* INCLUDE_xTaskGetHandle */
-/*-----------------------------------------------------------*/
+                    /* If a task has timed out because it already holds the
+                     * mutex it was trying to obtain then it cannot of inherited
+                     * its own priority. */
+                    configASSERT( pxTCB != pxCurrentTCB );
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+                    /* Disinherit the priority, remembering the previous
+                     * priority to facilitate determining the subject task's
+                     * state. */
+                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
+                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
+                    pxTCB->uxPriority = uxPriorityToUse;
 
-    UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray,
-                                      const UBaseType_t uxArraySize,
-                                      configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
-    {
-        UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
+                    /* Only reset the event list item value if the value is not
+                     * being used for anything else. */
+                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                    {
+                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-        vTaskSuspendAll();
-        {
-            /* Is there a space in the array for each task in the system? */
-            if( uxArraySize >= uxCurrentNumberOfTasks )
-            {
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Ready state. */
-                do
-                {
-                    uxQueue--;
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( pxReadyTasksLists[ uxQueue ] ), eReady );
-                } while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    /* If the running task is not the task that holds the mutex
+                     * then the task that holds the mutex could be in either the
+                     * Ready, Blocked or Suspended states.  Only remove the task
+                     * from its current state list if it is in the Ready state as
+                     * the task's priority is going to change and there is one
+                     * Ready list per priority. */
+                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                    {
+                        listFAST_REMOVE_COUNT( &( pxTCB->xStateListItem ), uxItemsRemaining );
 
-                /* Fill in an TaskStatus_t structure with information on each
-                 * task in the Blocked state. */
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-                uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+                        if( uxItemsRemaining == ( UBaseType_t ) 0 )
+                        {
+                            /* It is known that the task is in its ready list so
+                             * there is no need to check again and the port level
+                             * reset macro can be called directly. */
+                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
 
-                #if ( INCLUDE_vTaskDelete == 1 )
-                {
-                    /* Fill in an TaskStatus_t structure with information on
-                     * each task that has been deleted but not yet cleaned up. */
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xTasksWaitingTermination, eDeleted );
-                }
-                #endif
+                        prvAddTaskToReadyList( pxTCB );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
-                {
-                    /* Fill in an TaskStatus_t structure with information on
-                     * each task in the Suspended state. */
-                    uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &xSuspendedTaskList, eSuspended );
-                }
-                #endif
+                    #if ( configNUMBER_OF_CORES > 1 )
+                    {
+                        /* The holder may be running on another core, in which
+                         * case that core must reselect now its priority has
+                         * dropped. */
+                        if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+                        {
+                            prvYieldCore( pxTCB->xTaskRunState );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #endif /* configNUMBER_OF_CORES > 1 */
 
-                #if ( configGENERATE_RUN_TIME_STATS == 1 )
-                {
-                    if( pulTotalRunTime != NULL )
+                    #if ( configPRIORITY_INHERITANCE_DEPTH > 1 )
                     {
-                        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                            portALT_GET_RUN_TIME_COUNTER_VALUE( ( *pulTotalRunTime ) );
-                        #else
-                            *pulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-                        #endif
+                        /* The holder might itself be blocked on a mutex whose
+                         * holder inherited the priority from it. */
+                        prvPropagateInheritedPriority( pxTCB, pdFALSE );
                     }
+                    #endif
                 }
-                #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+                else
                 {
-                    if( pulTotalRunTime != NULL )
-                    {
-                        *pulTotalRunTime = 0;
-                    }
+                    mtCOVERAGE_TEST_MARKER();
                 }
-                #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        ( void ) xTaskResumeAll();
-
-        return uxTask;
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
     }
 
-#endif /* configUSE_TRACE_FACILITY */
-/*----------------------------------------------------------*/
+#endif /* configUSE_MUTEXES */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskGetIdleTaskHandle == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
 
-    TaskHandle_t xTaskGetIdleTaskHandle( void )
+    static void prvSetInheritedPriority( TCB_t * const pxTCB,
+                                         const UBaseType_t uxNewPriority )
     {
-        /* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-         * started, then xIdleTaskHandle will be NULL. */
-        configASSERT( ( xIdleTaskHandle != NULL ) );
-        return xIdleTaskHandle;
-    }
-
-#endif /* INCLUDE_xTaskGetIdleTaskHandle */
-/*----------------------------------------------------------*/
+        const UBaseType_t uxPriorityUsedOnEntry = pxTCB->uxPriority;
+        UBaseType_t uxItemsRemaining;
 
-/* This conditional compilation should use inequality to 0, not equality to 1.
- * This is to ensure vTaskStepTick() is available when user defined low power mode
- * implementations require configUSE_TICKLESS_IDLE to be set to a value other than
- * 1. */
-#if ( configUSE_TICKLESS_IDLE != 0 )
+        pxTCB->uxPriority = uxNewPriority;
 
-    void vTaskStepTick( TickType_t xTicksToJump )
-    {
-        /* Correct the tick count value after a period during which the tick
-         * was suppressed.  Note this does *not* call the tick hook function for
-         * each stepped tick. */
-        configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
+        /* Only reset the event list item value if the value is not being used
+         * for anything else. */
+        if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+        {
+            listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxNewPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        if( ( xTickCount + xTicksToJump ) == xNextTaskUnblockTime )
+        /* There is one ready list per priority, so if the task is in the Ready
+         * state it must move to the list for its new priority. */
+        if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
         {
-            /* Arrange for xTickCount to reach xNextTaskUnblockTime in
-             * xTaskIncrementTick() when the scheduler resumes.  This ensures
-             * that any delayed tasks are resumed at the correct time. */
-            configASSERT( uxSchedulerSuspended );
-            configASSERT( xTicksToJump != ( TickType_t ) 0 );
+            listFAST_REMOVE_COUNT( &( pxTCB->xStateListItem ), uxItemsRemaining );
 
-            /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
-            taskENTER_CRITICAL();
+            if( uxItemsRemaining == ( UBaseType_t ) 0 )
             {
-                xPendedTicks++;
+                portRESET_READY_PRIORITY( uxPriorityUsedOnEntry, uxTopReadyPriority );
             }
-            taskEXIT_CRITICAL();
-            xTicksToJump--;
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            prvAddTaskToReadyList( pxTCB );
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
 
-        xTickCount += xTicksToJump;
-        traceINCREASE_TICK_COUNT( xTicksToJump );
+        #if ( configNUMBER_OF_CORES > 1 )
+        {
+            /* A task running on another core must reselect if its priority
+             * has dropped. */
+            if( ( uxNewPriority < uxPriorityUsedOnEntry ) && ( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE ) )
+            {
+                prvYieldCore( pxTCB->xTaskRunState );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configNUMBER_OF_CORES > 1 */
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
-/*----------------------------------------------------------*/
+#endif /* ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) ) */
+/*-----------------------------------------------------------*/
 
-BaseType_t xTaskCatchUpTicks( TickType_t xTicksToCatchUp )
-{
-    BaseType_t xYieldOccurred;
+#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
 
-    /* Must not be called with the scheduler suspended as the implementation
-     * relies on xPendedTicks being wound down to 0 in xTaskResumeAll(). */
-    configASSERT( uxSchedulerSuspended == 0 );
+    static TCB_t * prvGetBlockingMutexHolder( TCB_t * const pxTCB )
+    {
+        TCB_t * pxHolderTCB = NULL;
+        List_t * pxEventList;
 
-    /* Use xPendedTicks to mimic xTicksToCatchUp number of ticks occurring when
-     * the scheduler is suspended so the ticks are executed in xTaskResumeAll(). */
-    vTaskSuspendAll();
+        /* pxBlockingMutexHolder is only valid while the task's event list item
+         * is still in the event list of the mutex.  It is not cleared when the
+         * task is unblocked, so also check the task has not been moved to the
+         * pending ready list. */
+        pxEventList = listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) );
 
-    /* Prevent the tick interrupt modifying xPendedTicks simultaneously. */
-    taskENTER_CRITICAL();
-    {
-        xPendedTicks += xTicksToCatchUp;
+        if( ( pxTCB->pxBlockingMutexHolder != NULL ) &&
+            ( pxEventList != NULL ) &&
+            ( pxEventList != &xPendingReadyList ) )
+        {
+            /* Mutex event lists are sorted by priority, and the task's event
+             * list item value was updated with its priority. */
+            listFAST_REMOVE( &( pxTCB->xEventListItem ) );
+            vListInsert( pxEventList, &( pxTCB->xEventListItem ) );
+
+            pxHolderTCB = *( pxTCB->pxBlockingMutexHolder );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return pxHolderTCB;
     }
-    taskEXIT_CRITICAL();
-    xYieldOccurred = xTaskResumeAll();
 
-    return xYieldOccurred;
-}
-/*----------------------------------------------------------*/
+#endif /* ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) ) */
+/*-----------------------------------------------------------*/
 
-#if ( INCLUDE_xTaskAbortDelay == 1 )
+#if ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) )
 
-    BaseType_t xTaskAbortDelay( TaskHandle_t xTask )
+    static void prvPropagateInheritedPriority( TCB_t * pxTCB,
+                                               const BaseType_t xRaised )
     {
-        TCB_t * pxTCB = xTask;
-        BaseType_t xReturn;
-
-        configASSERT( pxTCB );
+        TCB_t * pxHolderTCB;
+        UBaseType_t uxDepth = ( UBaseType_t ) 1, uxPriorityToUse;
+        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
+        BaseType_t xContinue = pdTRUE;
 
-        vTaskSuspendAll();
+        /* The depth is bounded so the time spent here, and so the worst case
+         * time interrupts are disabled, is deterministic. */
+        while( xContinue != pdFALSE )
         {
-            /* A task can only be prematurely removed from the Blocked state if
-             * it is actually in the Blocked state. */
-            if( eTaskGetState( xTask ) == eBlocked )
-            {
-                xReturn = pdPASS;
-
-                /* Remove the reference to the task from the blocked list.  An
-                 * interrupt won't touch the xStateListItem because the
-                 * scheduler is suspended. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+            pxHolderTCB = prvGetBlockingMutexHolder( pxTCB );
+            xContinue = pdFALSE;
 
-                /* Is the task waiting on an event also?  If so remove it from
-                 * the event list too.  Interrupts can touch the event list item,
-                 * even though the scheduler is suspended, so a critical section
-                 * is used. */
-                taskENTER_CRITICAL();
+            if( ( pxHolderTCB != NULL ) && ( uxDepth < ( UBaseType_t ) configPRIORITY_INHERITANCE_DEPTH ) )
+            {
+                if( xRaised != pdFALSE )
                 {
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                    {
-                        ( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+                    /* The holder inherits the raised priority, as a task that
+                     * holds a mutex does when a higher priority task blocks on
+                     * it. */
+                    uxPriorityToUse = pxTCB->uxPriority;
 
-                        /* This lets the task know it was forcibly removed from the
-                         * blocked state so it should not re-evaluate its block time and
-                         * then block again. */
-                        pxTCB->ucDelayAborted = pdTRUE;
+                    if( pxHolderTCB->uxPriority < uxPriorityToUse )
+                    {
+                        traceTASK_PRIORITY_INHERIT( pxHolderTCB, uxPriorityToUse );
+                        prvSetInheritedPriority( pxHolderTCB, uxPriorityToUse );
+                        xContinue = pdTRUE;
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                taskEXIT_CRITICAL();
-
-                /* Place the unblocked task into the appropriate ready list. */
-                prvAddTaskToReadyList( pxTCB );
-
-                /* A task being unblocked cannot cause an immediate context
-                 * switch if preemption is turned off. */
-                #if ( configUSE_PREEMPTION == 1 )
+                else
                 {
-                    /* Preemption is on, but a context switch should only be
-                     * performed if the unblocked task has a priority that is
-                     * higher than the currently executing task. */
-                    if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                    /* As in vTaskPriorityDisinheritAfterTimeout(), the holder
+                     * drops back to the greater of its base priority and the
+                     * highest priority of the tasks still waiting for the
+                     * mutex, but only if it holds no other mutexes. */
+                    if( pxHolderTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
                     {
-                        /* Pend the yield to be performed when the scheduler
-                         * is unsuspended. */
-                        xYieldPending = pdTRUE;
+                        uxPriorityToUse = ( UBaseType_t ) configMAX_PRIORITIES - ( UBaseType_t ) listGET_ITEM_VALUE_OF_HEAD_ENTRY( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) );
+
+                        if( uxPriorityToUse < pxHolderTCB->uxBasePriority )
+                        {
+                            uxPriorityToUse = pxHolderTCB->uxBasePriority;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        if( pxHolderTCB->uxPriority > uxPriorityToUse )
+                        {
+                            traceTASK_PRIORITY_DISINHERIT( pxHolderTCB, uxPriorityToUse );
+                            prvSetInheritedPriority( pxHolderTCB, uxPriorityToUse );
+                            xContinue = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                #endif /* configUSE_PREEMPTION */
+
+                pxTCB = pxHolderTCB;
+                uxDepth++;
             }
             else
             {
-                xReturn = pdFAIL;
+                mtCOVERAGE_TEST_MARKER();
             }
         }
-        ( void ) xTaskResumeAll();
-
-        return xReturn;
     }
 
-#endif /* INCLUDE_xTaskAbortDelay */
-/*----------------------------------------------------------*/
-
-BaseType_t xTaskIncrementTick( void )
-{
-    TCB_t * pxTCB;
-    TickType_t xItemValue;
-    BaseType_t xSwitchRequired = pdFALSE;
+#endif /* ( ( configUSE_MUTEXES == 1 ) && ( configPRIORITY_INHERITANCE_DEPTH > 1 ) ) */
+/*-----------------------------------------------------------*/
 
-    /* Called by the portable layer each time a tick interrupt occurs.
-     * Increments the tick then checks to see if the new tick value will cause any
-     * tasks to be unblocked. */
-    traceTASK_INCREMENT_TICK( xTickCount );
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+    void vTaskEnterCritical( void )
     {
-        /* Minor optimisation.  The tick count cannot change in this
-         * block. */
-        const TickType_t xConstTickCount = xTickCount + ( TickType_t ) 1;
-
-        /* Increment the RTOS tick, switching the delayed and overflowed
-         * delayed lists if it wraps to 0. */
-        xTickCount = xConstTickCount;
+        portDISABLE_INTERRUPTS();
 
-        if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+        if( xSchedulerRunning != pdFALSE )
         {
-            taskSWITCH_DELAYED_LISTS();
+            ( pxCurrentTCB->uxCriticalNesting )++;
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( pxCurrentTCB->uxCriticalNesting == 1 )
+            {
+                portASSERT_IF_IN_ISR();
+            }
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+    }
 
-        /* See if this tick has made a timeout expire.  Tasks are stored in
-         * the  queue in the order of their wake time - meaning once one task
-         * has been found whose block time has not expired there is no need to
-         * look any further down the list. */
-        if( xConstTickCount >= xNextTaskUnblockTime )
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+
+    void vTaskExitCritical( void )
+    {
+        if( xSchedulerRunning != pdFALSE )
         {
-            for( ; ; )
+            if( pxCurrentTCB->uxCriticalNesting > 0U )
             {
-                if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+                ( pxCurrentTCB->uxCriticalNesting )--;
+
+                if( pxCurrentTCB->uxCriticalNesting == 0U )
                 {
-                    /* The delayed list is empty.  Set xNextTaskUnblockTime
-                     * to the maximum possible value so it is extremely
-                     * unlikely that the
-                     * if( xTickCount >= xNextTaskUnblockTime ) test will pass
-                     * next time through. */
-                    xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    break;
+                    portENABLE_INTERRUPTS();
                 }
                 else
                 {
-                    /* The delayed list is not empty, get the value of the
-                     * item at the head of the delayed list.  This is the time
-                     * at which the task at the head of the delayed list must
-                     * be removed from the Blocked state. */
-                    pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                    xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
 
-                    if( xConstTickCount < xItemValue )
-                    {
-                        /* It is not time to unblock this item yet, but the
-                         * item value is the time at which the task at the head
-                         * of the blocked list must be removed from the Blocked
-                         * state -  so record the item value in
-                         * xNextTaskUnblockTime. */
-                        xNextTaskUnblockTime = xItemValue;
-                        break; /*lint !e9011 Code structure here is deemed easier to understand with multiple breaks. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+#endif /* portCRITICAL_NESTING_IN_TCB */
+/*-----------------------------------------------------------*/
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+    void vTaskEnterCritical( void )
+    {
+        portDISABLE_INTERRUPTS();
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                portGET_TASK_LOCK();
+                portGET_ISR_LOCK();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+
+            /* This is not the interrupt safe version of the enter critical
+             * function so  assert() if it is being called from an interrupt
+             * context.  Only API functions that end in "FromISR" can be used in an
+             * interrupt.  Only assert if the critical nesting count is 1 to
+             * protect against recursive calls if the assert function also uses a
+             * critical section. */
+            if( portGET_CRITICAL_NESTING_COUNT() == 1U )
+            {
+                portASSERT_IF_IN_ISR();
+            }
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    UBaseType_t vTaskEnterCriticalFromISR( void )
+    {
+        UBaseType_t uxSavedInterruptStatus = 0;
+
+        if( xSchedulerRunning != pdFALSE )
+        {
+            uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+            if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+            {
+                portGET_ISR_LOCK();
+            }
+
+            portINCREMENT_CRITICAL_NESTING_COUNT();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        return uxSavedInterruptStatus;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTaskExitCritical( void )
+    {
+        if( xSchedulerRunning != pdFALSE )
+        {
+            /* If the critical nesting count is zero then this function
+             * does not match a previous call to vTaskEnterCritical(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
 
-                    /* It is time to remove the item from the Blocked state. */
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+            {
+                portDECREMENT_CRITICAL_NESTING_COUNT();
 
-                    /* Is the task waiting on an event also?  If so remove
-                     * it from the event list. */
-                    if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    BaseType_t xYieldCurrentTask;
+
+                    /* Read the pending yield before the locks are released
+                     * so it cannot be cleared by another core first. */
+                    xYieldCurrentTask = xYieldPendings[ portGET_CORE_ID() ];
+
+                    portRELEASE_ISR_LOCK();
+                    portRELEASE_TASK_LOCK();
+                    portENABLE_INTERRUPTS();
+
+                    /* When a task yields in a critical section it just sets
+                     * xYieldPending to true. So now that we have exited the
+                     * critical section check if xYieldPending is true, and
+                     * if so yield. */
+                    if( xYieldCurrentTask != pdFALSE )
                     {
-                        listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
+                        portYIELD();
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* Place the unblocked task into the appropriate ready
-                     * list. */
-                    prvAddTaskToReadyList( pxTCB );
-
-                    /* A task being unblocked cannot cause an immediate
-                     * context switch if preemption is turned off. */
-                    #if ( configUSE_PREEMPTION == 1 )
-                    {
-                        /* Preemption is on, but a context switch should
-                         * only be performed if the unblocked task's
-                         * priority is higher than the currently executing
-                         * task.
-                         * The case of equal priority tasks sharing
-                         * processing time (which happens when both
-                         * preemption and time slicing are on) is
-                         * handled below.*/
-                        if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                        {
-                            xSwitchRequired = pdTRUE;
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
-                    }
-                    #endif /* configUSE_PREEMPTION */
                 }
-            }
-        }
-
-        /* Tasks of equal priority to the currently running task will share
-         * processing time (time slice) if preemption is on, and the application
-         * writer has not explicitly turned time slicing off. */
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
-        {
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
-            {
-                xSwitchRequired = pdTRUE;
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
+/*-----------------------------------------------------------*/
 
-        #if ( configUSE_TICK_HOOK == 1 )
+    void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+    {
+        if( xSchedulerRunning != pdFALSE )
         {
-            /* Guard against the tick hook being called when the pended tick
-             * count is being unwound (when the scheduler is being unlocked). */
-            if( xPendedTicks == ( TickType_t ) 0 )
+            /* If critical nesting count is zero then this function
+             * does not match a previous call to vTaskEnterCriticalFromISR(). */
+            configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+            if( portGET_CRITICAL_NESTING_COUNT() > 0U )
             {
-                vApplicationTickHook();
+                portDECREMENT_CRITICAL_NESTING_COUNT();
+
+                if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+                {
+                    portRELEASE_ISR_LOCK();
+                    portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configUSE_TICK_HOOK */
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+    }
 
-        #if ( configUSE_PREEMPTION == 1 )
+#endif /* configNUMBER_OF_CORES > 1 */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+    static configRUN_TIME_COUNTER_TYPE prvGetCriticalSectionTime( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTime;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulTime );
+        #else
+            ulTime = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        return ulTime;
+    }
+
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+    static void prvRecordCriticalDuration( CriticalSectionStats_t * pxStats,
+                                           configRUN_TIME_COUNTER_TYPE ulStartTime,
+                                           void * pvCaller )
+    {
+        configRUN_TIME_COUNTER_TYPE ulDuration;
+        UBaseType_t uxBucket = 0U;
+
+        ulDuration = prvGetCriticalSectionTime() - ulStartTime;
+
+        if( ( pxStats->ulCount == 0U ) || ( ulDuration > pxStats->ulMaximum ) )
         {
-            if( xYieldPending != pdFALSE )
-            {
-                xSwitchRequired = pdTRUE;
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
+            pxStats->ulMaximum = ulDuration;
+            pxStats->pvMaximumCaller = pvCaller;
         }
-        #endif /* configUSE_PREEMPTION */
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        pxStats->ulCount++;
+
+        /* The bucket is the index of the most significant set bit, capped at
+         * the last bucket. */
+        while( ( ulDuration > ( configRUN_TIME_COUNTER_TYPE ) 1U ) && ( uxBucket < ( UBaseType_t ) ( configCRITICAL_SECTION_PROFILING_BUCKETS - 1 ) ) )
+        {
+            ulDuration >>= 1U;
+            uxBucket++;
+        }
+
+        pxStats->ulHistogram[ uxBucket ]++;
     }
-    else
+
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+    void vTaskProfiledEnterCritical( void )
     {
-        ++xPendedTicks;
+        BaseType_t xCoreID;
 
-        /* The tick hook gets called at regular intervals, even if the
-         * scheduler is locked. */
-        #if ( configUSE_TICK_HOOK == 1 )
+        portENTER_CRITICAL();
+
+        xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+        if( uxProfiledCriticalNesting[ xCoreID ] == ( UBaseType_t ) 0U )
         {
-            vApplicationTickHook();
+            ulCriticalSectionEntryTime[ xCoreID ] = prvGetCriticalSectionTime();
+            pvCriticalSectionEntryCaller[ xCoreID ] = portGET_RETURN_ADDRESS();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxProfiledCriticalNesting[ xCoreID ]++;
+    }
+
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+    void vTaskProfiledExitCritical( void )
+    {
+        const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+        configASSERT( uxProfiledCriticalNesting[ xCoreID ] > ( UBaseType_t ) 0U );
+        uxProfiledCriticalNesting[ xCoreID ]--;
+
+        if( uxProfiledCriticalNesting[ xCoreID ] == ( UBaseType_t ) 0U )
+        {
+            prvRecordCriticalDuration( &xCriticalSectionStats, ulCriticalSectionEntryTime[ xCoreID ], pvCriticalSectionEntryCaller[ xCoreID ] );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
+
+        portEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+    UBaseType_t uxTaskProfiledEnterCriticalFromISR( void )
+    {
+        UBaseType_t uxSavedInterruptStatus;
+        BaseType_t xCoreID;
+
+        #if ( configNUMBER_OF_CORES == 1 )
+            uxSavedInterruptStatus = ( UBaseType_t ) portSET_INTERRUPT_MASK_FROM_ISR();
+        #else
+            uxSavedInterruptStatus = ( UBaseType_t ) portENTER_CRITICAL_FROM_ISR();
         #endif
+
+        xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+        if( uxProfiledCriticalNesting[ xCoreID ] == ( UBaseType_t ) 0U )
+        {
+            ulCriticalSectionEntryTime[ xCoreID ] = prvGetCriticalSectionTime();
+            pvCriticalSectionEntryCaller[ xCoreID ] = portGET_RETURN_ADDRESS();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        uxProfiledCriticalNesting[ xCoreID ]++;
+
+        return uxSavedInterruptStatus;
     }
 
-    return xSwitchRequired;
-}
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
 
-    void vTaskSetApplicationTaskTag( TaskHandle_t xTask,
-                                     TaskHookFunction_t pxHookFunction )
+    void vTaskProfiledExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
     {
-        TCB_t * xTCB;
+        const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
 
-        /* If xTask is NULL then it is the task hook of the calling task that is
-         * getting set. */
-        if( xTask == NULL )
+        configASSERT( uxProfiledCriticalNesting[ xCoreID ] > ( UBaseType_t ) 0U );
+        uxProfiledCriticalNesting[ xCoreID ]--;
+
+        if( uxProfiledCriticalNesting[ xCoreID ] == ( UBaseType_t ) 0U )
         {
-            xTCB = ( TCB_t * ) pxCurrentTCB;
+            prvRecordCriticalDuration( &xCriticalSectionStats, ulCriticalSectionEntryTime[ xCoreID ], pvCriticalSectionEntryCaller[ xCoreID ] );
         }
         else
         {
-            xTCB = xTask;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
+        #if ( configNUMBER_OF_CORES == 1 )
+            portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        #else
+            portEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+        #endif
+    }
+
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+    void vTaskGetCriticalSectionStats( CriticalSectionStats_t * pxStats )
+    {
+        configASSERT( pxStats );
+
         taskENTER_CRITICAL();
         {
-            xTCB->pxTaskTag = pxHookFunction;
+            *pxStats = xCriticalSectionStats;
         }
         taskEXIT_CRITICAL();
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
 
-    TaskHookFunction_t xTaskGetApplicationTaskTag( TaskHandle_t xTask )
+    void vTaskGetSchedulerSuspendStats( CriticalSectionStats_t * pxStats )
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
+        configASSERT( pxStats );
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
-
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
         taskENTER_CRITICAL();
         {
-            xReturn = pxTCB->pxTaskTag;
+            *pxStats = xSchedulerSuspendStats;
         }
         taskEXIT_CRITICAL();
+    }
 
-        return xReturn;
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_CRITICAL_SECTION_PROFILING == 1 )
+
+    void vTaskResetCriticalSectionStats( void )
+    {
+        /* The port macros are used so this critical section is not itself
+         * recorded in the statistics it clears. */
+        portENTER_CRITICAL();
+        {
+            ( void ) memset( &xCriticalSectionStats, 0x00, sizeof( xCriticalSectionStats ) );
+            ( void ) memset( &xSchedulerSuspendStats, 0x00, sizeof( xSchedulerSuspendStats ) );
+        }
+        portEXIT_CRITICAL();
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* configUSE_CRITICAL_SECTION_PROFILING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
 
-    TaskHookFunction_t xTaskGetApplicationTaskTagFromISR( TaskHandle_t xTask )
+    static char * prvWriteNameToBuffer( char * pcBuffer,
+                                        const char * pcTaskName )
     {
-        TCB_t * pxTCB;
-        TaskHookFunction_t xReturn;
-        UBaseType_t uxSavedInterruptStatus;
+        size_t x;
 
-        /* If xTask is NULL then set the calling task's hook. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        /* Start by copying the entire string. */
+        strcpy( pcBuffer, pcTaskName );
 
-        /* Save the hook function in the TCB.  A critical section is required as
-         * the value can be accessed from an interrupt. */
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        /* Pad the end of the string with spaces to ensure columns line up when
+         * printed out. */
+        for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
         {
-            xReturn = pxTCB->pxTaskTag;
+            pcBuffer[ x ] = ' ';
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-        return xReturn;
+        /* Terminate. */
+        pcBuffer[ x ] = ( char ) 0x00;
+
+        /* Return the new end of string. */
+        return &( pcBuffer[ x ] );
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_APPLICATION_TASK_TAG == 1 )
+#if ( ( configUSE_TASK_ITERATOR == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
-    BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask,
-                                             void * pvParameter )
+    size_t xTaskFormatTaskStatus( const TaskStatus_t * pxTaskStatus,
+                                  configRUN_TIME_COUNTER_TYPE ulTotalRunTime,
+                                  char * pcWriteBuffer,
+                                  size_t xBufferLength )
     {
-        TCB_t * xTCB;
-        BaseType_t xReturn;
+        char cStatus;
+        int iWritten;
+        size_t xReturn = 0;
+
+        configASSERT( pxTaskStatus );
+        configASSERT( pcWriteBuffer );
+
+        switch( pxTaskStatus->eCurrentState )
+        {
+            case eRunning:
+                cStatus = tskRUNNING_CHAR;
+                break;
+
+            case eReady:
+                cStatus = tskREADY_CHAR;
+                break;
+
+            case eBlocked:
+                cStatus = tskBLOCKED_CHAR;
+                break;
+
+            case eSuspended:
+                cStatus = tskSUSPENDED_CHAR;
+                break;
+
+            case eDeleted:
+                cStatus = tskDELETED_CHAR;
+                break;
+
+            case eInvalid: /* Fall through. */
+            default:       /* Should not get here, but it is included
+                            * to prevent static checking errors. */
+                cStatus = '?';
+                break;
+        }
+
+        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        {
+            configRUN_TIME_COUNTER_TYPE ulStatsAsPercentage = 0;
+
+            /* For percentage calculations. */
+            ulTotalRunTime /= 100UL;
+
+            /* Avoid divide by zero errors. */
+            if( ulTotalRunTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+            {
+                ulStatsAsPercentage = pxTaskStatus->ulRunTimeCounter / ulTotalRunTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* If xTask is NULL then we are calling our own task hook. */
-        if( xTask == NULL )
-        {
-            xTCB = pxCurrentTCB;
+            iWritten = snprintf( pcWriteBuffer, xBufferLength, "%-*s\t%c\t%u\t%u\t%u\t%lu\t%lu%%\r\n",
+                                 ( int ) ( configMAX_TASK_NAME_LEN - 1 ), pxTaskStatus->pcTaskName, cStatus,
+                                 ( unsigned int ) pxTaskStatus->uxCurrentPriority, ( unsigned int ) pxTaskStatus->usStackHighWaterMark,
+                                 ( unsigned int ) pxTaskStatus->xTaskNumber, ( unsigned long ) pxTaskStatus->ulRunTimeCounter,
+                                 ( unsigned long ) ulStatsAsPercentage );
         }
-        else
+        #else /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
         {
-            xTCB = xTask;
+            ( void ) ulTotalRunTime;
+
+            iWritten = snprintf( pcWriteBuffer, xBufferLength, "%-*s\t%c\t%u\t%u\t%u\r\n",
+                                 ( int ) ( configMAX_TASK_NAME_LEN - 1 ), pxTaskStatus->pcTaskName, cStatus,
+                                 ( unsigned int ) pxTaskStatus->uxCurrentPriority, ( unsigned int ) pxTaskStatus->usStackHighWaterMark,
+                                 ( unsigned int ) pxTaskStatus->xTaskNumber );
         }
+        #endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
 
-        if( xTCB->pxTaskTag != NULL )
+        /* snprintf() returns the length the line would have had, so clip it to
+         * what fitted in the buffer. */
+        if( ( iWritten > 0 ) && ( xBufferLength > ( size_t ) 0 ) )
         {
-            xReturn = xTCB->pxTaskTag( pvParameter );
+            xReturn = ( size_t ) iWritten;
+
+            if( xReturn >= xBufferLength )
+            {
+                xReturn = xBufferLength - ( size_t ) 1;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
         else
         {
-            xReturn = pdFAIL;
+            mtCOVERAGE_TEST_MARKER();
         }
 
         return xReturn;
     }
 
-#endif /* configUSE_APPLICATION_TASK_TAG */
+#endif /* ( ( configUSE_TASK_ITERATOR == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
 /*-----------------------------------------------------------*/
 
-void vTaskSwitchContext( void )
-{
-    if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
-    {
-        /* The scheduler is currently suspended - do not allow a context
-         * switch. */
-        xYieldPending = pdTRUE;
-    }
-    else
+#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+
+    void vTaskList( char * pcWriteBuffer )
     {
-        xYieldPending = pdFALSE;
-        traceTASK_SWITCHED_OUT();
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        char cStatus;
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, and is used by many
+         * of the demo applications.  Do not consider it to be part of the
+         * scheduler.
+         *
+         * vTaskList() calls uxTaskGetSystemState(), then formats part of the
+         * uxTaskGetSystemState() output into a human readable table that
+         * displays task: names, states, priority, stack usage and task number.
+         * Stack usage specified as the number of unused StackType_t words stack can hold
+         * on top of stack - not the number of bytes.
+         *
+         * vTaskList() has a dependency on the sprintf() C library function that
+         * might bloat the code size, use a lot of stack, and provide different
+         * results on different platforms.  An alternative, tiny, third party,
+         * and limited functionality implementation of sprintf() is provided in
+         * many of the FreeRTOS/Demo sub-directories in a file called
+         * printf-stdarg.c (note printf-stdarg.c does not provide a full
+         * snprintf() implementation!).
+         *
+         * It is recommended that production systems call uxTaskGetSystemState()
+         * directly to get access to raw stats data, rather than indirectly
+         * through a call to vTaskList().
+         */
+
+
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
+
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
+
+        /* Allocate an array index for each task.  NOTE!  if
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+
+        if( pxTaskStatusArray != NULL )
         {
-            #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
-                portALT_GET_RUN_TIME_COUNTER_VALUE( ulTotalRunTime );
-            #else
-                ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
-            #endif
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
 
-            /* Add the amount of time the task has been running to the
-             * accumulated time so far.  The time the task started running was
-             * stored in ulTaskSwitchedInTime.  Note that there is no overflow
-             * protection here so count values are only valid until the timer
-             * overflows.  The guard against negative values is to protect
-             * against suspect run time stat counter implementations - which
-             * are provided by the application, not the kernel. */
-            if( ulTotalRunTime > ulTaskSwitchedInTime )
-            {
-                pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
-            }
-            else
+            /* Create a human readable table from the binary data. */
+            for( x = 0; x < uxArraySize; x++ )
             {
-                mtCOVERAGE_TEST_MARKER();
-            }
+                switch( pxTaskStatusArray[ x ].eCurrentState )
+                {
+                    case eRunning:
+                        cStatus = tskRUNNING_CHAR;
+                        break;
 
-            ulTaskSwitchedInTime = ulTotalRunTime;
-        }
-        #endif /* configGENERATE_RUN_TIME_STATS */
+                    case eReady:
+                        cStatus = tskREADY_CHAR;
+                        break;
+
+                    case eBlocked:
+                        cStatus = tskBLOCKED_CHAR;
+                        break;
 
-        /* Check for stack overflow, if configured. */
-        taskCHECK_FOR_STACK_OVERFLOW();
+                    case eSuspended:
+                        cStatus = tskSUSPENDED_CHAR;
+                        break;
 
-        /* Before the currently running task is switched out, save its errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
-        {
-            pxCurrentTCB->iTaskErrno = FreeRTOS_errno;
-        }
-        #endif
+                    case eDeleted:
+                        cStatus = tskDELETED_CHAR;
+                        break;
 
-        /* Select a new task to run using either the generic C or port
-         * optimised asm code. */
-        taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-        traceTASK_SWITCHED_IN();
+                    case eInvalid: /* Fall through. */
+                    default:       /* Should not get here, but it is included
+                                    * to prevent static checking errors. */
+                        cStatus = ( char ) 0x00;
+                        break;
+                }
 
-        /* After the new task is switched in, update the global errno. */
-        #if ( configUSE_POSIX_ERRNO == 1 )
-        {
-            FreeRTOS_errno = pxCurrentTCB->iTaskErrno;
-        }
-        #endif
+                /* Write the task name to the string, padding with spaces so it
+                 * can be printed in tabular form more easily. */
+                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
+                /* Write the rest of the string. */
+                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+            }
+
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
         {
-            /* Switch C-Runtime's TLS Block to point to the TLS
-             * Block specific to this task. */
-            configSET_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif
     }
-}
-/*-----------------------------------------------------------*/
 
-void vTaskPlaceOnEventList( List_t * const pxEventList,
-                            const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+/*----------------------------------------------------------*/
 
-    /* THIS FUNCTION MUST BE CALLED WITH EITHER INTERRUPTS DISABLED OR THE
-     * SCHEDULER SUSPENDED AND THE QUEUE BEING ACCESSED LOCKED. */
+#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) )
 
-    /* Place the event list item of the TCB in the appropriate event list.
-     * This is placed in the list in priority order so the highest priority task
-     * is the first to be woken by the event.
-     *
-     * Note: Lists are sorted in ascending order by ListItem_t.xItemValue.
-     * Normally, the xItemValue of a TCB's ListItem_t members is:
-     *      xItemValue = ( configMAX_PRIORITIES - uxPriority )
-     * Therefore, the event list is sorted in descending priority order.
-     *
-     * The queue that contains the event list is locked, preventing
-     * simultaneous access from interrupts. */
-    vListInsert( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    {
+        TaskStatus_t * pxTaskStatusArray;
+        UBaseType_t uxArraySize, x;
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
-/*-----------------------------------------------------------*/
+        /*
+         * PLEASE NOTE:
+         *
+         * This function is provided for convenience only, and is used by many
+         * of the demo applications.  Do not consider it to be part of the
+         * scheduler.
+         *
+         * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
+         * of the uxTaskGetSystemState() output into a human readable table that
+         * displays the amount of time each task has spent in the Running state
+         * in both absolute and percentage terms.
+         *
+         * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
+         * function that might bloat the code size, use a lot of stack, and
+         * provide different results on different platforms.  An alternative,
+         * tiny, third party, and limited functionality implementation of
+         * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
+         * a file called printf-stdarg.c (note printf-stdarg.c does not provide
+         * a full snprintf() implementation!).
+         *
+         * It is recommended that production systems call uxTaskGetSystemState()
+         * directly to get access to raw stats data, rather than indirectly
+         * through a call to vTaskGetRunTimeStats().
+         */
 
-void vTaskPlaceOnUnorderedEventList( List_t * pxEventList,
-                                     const TickType_t xItemValue,
-                                     const TickType_t xTicksToWait )
-{
-    configASSERT( pxEventList );
+        /* Make sure the write buffer does not contain a string. */
+        *pcWriteBuffer = ( char ) 0x00;
 
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event groups implementation. */
-    configASSERT( uxSchedulerSuspended != 0 );
+        /* Take a snapshot of the number of tasks in case it changes while this
+         * function is executing. */
+        uxArraySize = uxCurrentNumberOfTasks;
 
-    /* Store the item value in the event list item.  It is safe to access the
-     * event list item here as interrupts won't access the event list item of a
-     * task that is not in the Blocked state. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
+        /* Allocate an array index for each task.  NOTE!  If
+         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
+         * equate to NULL. */
+        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
 
-    /* Place the event list item of the TCB at the end of the appropriate event
-     * list.  It is safe to access the event list here because it is part of an
-     * event group implementation - and interrupts don't access event groups
-     * directly (instead they access them indirectly by pending function calls to
-     * the task level). */
-    listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+        if( pxTaskStatusArray != NULL )
+        {
+            /* Generate the (binary) data. */
+            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
 
-    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-}
-/*-----------------------------------------------------------*/
+            /* For percentage calculations. */
+            ulTotalTime /= 100UL;
 
-#if ( configUSE_TIMERS == 1 )
+            /* Avoid divide by zero errors. */
+            if( ulTotalTime > 0UL )
+            {
+                /* Create a human readable table from the binary data. */
+                for( x = 0; x < uxArraySize; x++ )
+                {
+                    /* What percentage of the total run time has the task used?
+                     * This will always be rounded down to the nearest integer.
+                     * ulTotalRunTime has already been divided by 100. */
+                    ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+
+                    /* Write the task name to the string, padding with
+                     * spaces so it can be printed in tabular form more
+                     * easily. */
+                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+
+                    if( ulStatsAsPercentage > 0UL )
+                    {
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        {
+                            sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+                        }
+                        #else
+                        {
+                            /* sizeof( int ) == sizeof( long ) so a smaller
+                             * printf() library can be used. */
+                            sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        /* If the percentage is zero here then the task has
+                         * consumed less than 1% of the total run time. */
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        {
+                            sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+                        }
+                        #else
+                        {
+                            /* sizeof( int ) == sizeof( long ) so a smaller
+                             * printf() library can be used. */
+                            sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        #endif
+                    }
 
-    void vTaskPlaceOnEventListRestricted( List_t * const pxEventList,
-                                          TickType_t xTicksToWait,
-                                          const BaseType_t xWaitIndefinitely )
-    {
-        configASSERT( pxEventList );
+                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                }
 
-        /* This function should not be called by application code hence the
-         * 'Restricted' in its name.  It is not part of the public API.  It is
-         * designed for use by kernel code, and has special calling requirements -
-         * it should be called with the scheduler suspended. */
+                #if ( configUSE_CORE_RUN_TIME_STATS == 1 )
+                {
+                    BaseType_t xCoreID;
 
+                    /* The percentage of the total time each core spent idle,
+                     * rounded down in the same way. */
+                    for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+                    {
+                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        {
+                            sprintf( pcWriteBuffer, "Core %u idle\t%lu\t\t%lu%%\r\n", ( unsigned int ) xCoreID, ulCoreIdleRunTime[ xCoreID ], ulCoreIdleRunTime[ xCoreID ] / ulTotalTime );
+                        }
+                        #else
+                        {
+                            sprintf( pcWriteBuffer, "Core %u idle\t%u\t\t%u%%\r\n", ( unsigned int ) xCoreID, ( unsigned int ) ulCoreIdleRunTime[ xCoreID ], ( unsigned int ) ( ulCoreIdleRunTime[ xCoreID ] / ulTotalTime ) ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                        }
+                        #endif
 
-        /* Place the event list item of the TCB in the appropriate event list.
-         * In this case it is assume that this is the only task that is going to
-         * be waiting on this event list, so the faster vListInsertEnd() function
-         * can be used in place of vListInsert. */
-        listINSERT_END( pxEventList, &( pxCurrentTCB->xEventListItem ) );
+                        pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                    }
+                }
+                #endif /* configUSE_CORE_RUN_TIME_STATS */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-        /* If the task should block indefinitely then set the block time to a
-         * value that will be recognised as an indefinite delay inside the
-         * prvAddCurrentTaskToDelayedList() function. */
-        if( xWaitIndefinitely != pdFALSE )
+            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
+             * is 0 then vPortFree() will be #defined to nothing. */
+            vPortFree( pxTaskStatusArray );
+        }
+        else
         {
-            xTicksToWait = portMAX_DELAY;
+            mtCOVERAGE_TEST_MARKER();
         }
-
-        traceTASK_DELAY_UNTIL( ( xTickCount + xTicksToWait ) );
-        prvAddCurrentTaskToDelayedList( xTicksToWait, xWaitIndefinitely );
     }
 
-#endif /* configUSE_TIMERS */
+#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskRemoveFromEventList( const List_t * const pxEventList )
+TickType_t uxTaskResetEventItemValue( void )
 {
-    TCB_t * pxUnblockedTCB;
-    BaseType_t xReturn;
+    TickType_t uxReturn;
 
-    /* THIS FUNCTION MUST BE CALLED FROM A CRITICAL SECTION.  It can also be
-     * called from a critical section within an ISR. */
+    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
 
-    /* The event list is sorted in priority order, so the first in the list can
-     * be removed as it is known to be the highest priority.  Remove the TCB from
-     * the delayed list, and add it to the ready list.
-     *
-     * If an event is for a queue that is locked then this function will never
-     * get called - the lock count on the queue will get modified instead.  This
-     * means exclusive access to the event list is guaranteed here.
-     *
-     * This function assumes that a check has already been made to ensure that
-     * pxEventList is not empty. */
-    pxUnblockedTCB = listGET_OWNER_OF_HEAD_ENTRY( pxEventList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( &( pxUnblockedTCB->xEventListItem ) );
+    /* Reset the event list item to its normal value - so it can be used with
+     * queues and semaphores. */
+    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
-    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-    {
-        listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-        prvAddTaskToReadyList( pxUnblockedTCB );
+    return uxReturn;
+}
+/*-----------------------------------------------------------*/
 
-        #if ( configUSE_TICKLESS_IDLE != 0 )
-        {
-            /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-             * might be set to the blocked task's time out time.  If the task is
-             * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-             * normally left unchanged, because it is automatically reset to a new
-             * value when the tick count equals xNextTaskUnblockTime.  However if
-             * tickless idling is used it might be more important to enter sleep mode
-             * at the earliest possible time - so reset xNextTaskUnblockTime here to
-             * ensure it is updated at the earliest possible time. */
-            prvResetNextTaskUnblockTime();
-        }
-        #endif
-    }
-    else
-    {
-        /* The delayed and ready lists cannot be accessed, so hold this task
-         * pending until the scheduler is resumed. */
-        listINSERT_END( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
-    }
+#if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+    void vTaskSetEventItemBits( TaskHandle_t xTask,
+                                uint64_t ullEventItemBits )
     {
-        /* Return true if the task removed from the event list has a higher
-         * priority than the calling task.  This allows the calling task to know if
-         * it should force a context switch now. */
-        xReturn = pdTRUE;
+        TCB_t * pxTCB;
 
-        /* Mark that a yield is pending in case the user is not using the
-         * "xHigherPriorityTaskWoken" parameter to an ISR safe FreeRTOS function. */
-        xYieldPending = pdTRUE;
-    }
-    else
-    {
-        xReturn = pdFALSE;
+        /* If null is passed in here then the calling task's bits are set. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+        pxTCB->ullEventItemBits = ullEventItemBits;
     }
 
-    return xReturn;
-}
+#endif /* configUSE_64_BIT_EVENT_GROUPS */
 /*-----------------------------------------------------------*/
 
-void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem,
-                                        const TickType_t xItemValue )
-{
-    TCB_t * pxUnblockedTCB;
-
-    /* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED.  It is used by
-     * the event flags implementation. */
-    configASSERT( uxSchedulerSuspended != pdFALSE );
-
-    /* Store the new item value in the event list. */
-    listSET_LIST_ITEM_VALUE( pxEventListItem, xItemValue | taskEVENT_LIST_ITEM_VALUE_IN_USE );
-
-    /* Remove the event list form the event flag.  Interrupts do not access
-     * event flags. */
-    pxUnblockedTCB = listGET_LIST_ITEM_OWNER( pxEventListItem ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-    configASSERT( pxUnblockedTCB );
-    listREMOVE_ITEM( pxEventListItem );
+#if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
 
-    #if ( configUSE_TICKLESS_IDLE != 0 )
+    uint64_t ullTaskGetEventItemBits( TaskHandle_t xTask )
     {
-        /* If a task is blocked on a kernel object then xNextTaskUnblockTime
-         * might be set to the blocked task's time out time.  If the task is
-         * unblocked for a reason other than a timeout xNextTaskUnblockTime is
-         * normally left unchanged, because it is automatically reset to a new
-         * value when the tick count equals xNextTaskUnblockTime.  However if
-         * tickless idling is used it might be more important to enter sleep mode
-         * at the earliest possible time - so reset xNextTaskUnblockTime here to
-         * ensure it is updated at the earliest possible time. */
-        prvResetNextTaskUnblockTime();
-    }
-    #endif
+        TCB_t const * pxTCB;
 
-    /* Remove the task from the delayed list and add it to the ready list.  The
-     * scheduler is suspended so interrupts will not be accessing the ready
-     * lists. */
-    listREMOVE_ITEM( &( pxUnblockedTCB->xStateListItem ) );
-    prvAddTaskToReadyList( pxUnblockedTCB );
+        /* If null is passed in here then the calling task's bits are read. */
+        pxTCB = prvGetTCBFromHandle( xTask );
 
-    if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
-    {
-        /* The unblocked task has a priority above that of the calling task, so
-         * a context switch is required.  This function is called with the
-         * scheduler suspended so xYieldPending is set so the context switch
-         * occurs immediately that the scheduler is resumed (unsuspended). */
-        xYieldPending = pdTRUE;
+        return pxTCB->ullEventItemBits;
     }
-}
+
+#endif /* configUSE_64_BIT_EVENT_GROUPS */
 /*-----------------------------------------------------------*/
 
-void vTaskSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    configASSERT( pxTimeOut );
-    taskENTER_CRITICAL();
+#if ( configUSE_64_BIT_EVENT_GROUPS == 1 )
+
+    uint64_t ullTaskResetEventItemBits( void )
     {
-        pxTimeOut->xOverflowCount = xNumOfOverflows;
-        pxTimeOut->xTimeOnEntering = xTickCount;
+        /* The event list item value only recorded that the item was in use by
+         * an event group, the event bits themselves are held in the TCB. */
+        ( void ) uxTaskResetEventItemValue();
+
+        return pxCurrentTCB->ullEventItemBits;
     }
-    taskEXIT_CRITICAL();
-}
-/*-----------------------------------------------------------*/
 
-void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut )
-{
-    /* For internal use only as it does not use a critical section. */
-    pxTimeOut->xOverflowCount = xNumOfOverflows;
-    pxTimeOut->xTimeOnEntering = xTickCount;
-}
+#endif /* configUSE_64_BIT_EVENT_GROUPS */
 /*-----------------------------------------------------------*/
 
-BaseType_t xTaskCheckForTimeOut( TimeOut_t * const pxTimeOut,
-                                 TickType_t * const pxTicksToWait )
-{
-    BaseType_t xReturn;
-
-    configASSERT( pxTimeOut );
-    configASSERT( pxTicksToWait );
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
 
-    taskENTER_CRITICAL();
+    size_t xTaskGetHeapBytesAllocated( TaskHandle_t xTask )
     {
-        /* Minor optimisation.  The tick count cannot change in this block. */
-        const TickType_t xConstTickCount = xTickCount;
-        const TickType_t xElapsedTime = xConstTickCount - pxTimeOut->xTimeOnEntering;
-
-        #if ( INCLUDE_xTaskAbortDelay == 1 )
-            if( pxCurrentTCB->ucDelayAborted != ( uint8_t ) pdFALSE )
-            {
-                /* The delay was aborted, which is not the same as a time out,
-                 * but has the same result. */
-                pxCurrentTCB->ucDelayAborted = pdFALSE;
-                xReturn = pdTRUE;
-            }
-            else
-        #endif
-
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            if( *pxTicksToWait == portMAX_DELAY )
-            {
-                /* If INCLUDE_vTaskSuspend is set to 1 and the block time
-                 * specified is the maximum block time then the task should block
-                 * indefinitely, and therefore never time out. */
-                xReturn = pdFALSE;
-            }
-            else
-        #endif
+        TCB_t * pxTCB;
+        size_t xReturn;
 
-        if( ( xNumOfOverflows != pxTimeOut->xOverflowCount ) && ( xConstTickCount >= pxTimeOut->xTimeOnEntering ) ) /*lint !e525 Indentation preferred as is to make code within pre-processor directives clearer. */
-        {
-            /* The tick count is greater than the time at which
-             * vTaskSetTimeout() was called, but has also overflowed since
-             * vTaskSetTimeOut() was called.  It must have wrapped all the way
-             * around and gone past again. This passed since vTaskSetTimeout()
-             * was called. */
-            xReturn = pdTRUE;
-            *pxTicksToWait = ( TickType_t ) 0;
-        }
-        else if( xElapsedTime < *pxTicksToWait ) /*lint !e961 Explicit casting is only redundant with some compilers, whereas others require it to prevent integer conversion errors. */
-        {
-            /* Not a genuine timeout. Adjust parameters for time remaining. */
-            *pxTicksToWait -= xElapsedTime;
-            vTaskInternalSetTimeOutState( pxTimeOut );
-            xReturn = pdFALSE;
-        }
-        else
+        taskENTER_CRITICAL();
         {
-            *pxTicksToWait = ( TickType_t ) 0;
-            xReturn = pdTRUE;
+            pxTCB = prvGetTCBFromHandle( xTask );
+            xReturn = pxTCB->xHeapBytesAllocated;
         }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
     }
-    taskEXIT_CRITICAL();
 
-    return xReturn;
-}
+#endif /* configUSE_TASK_HEAP_ACCOUNTING */
 /*-----------------------------------------------------------*/
 
-void vTaskMissedYield( void )
-{
-    xYieldPending = pdTRUE;
-}
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
+
+    void vTaskSetHeapQuota( TaskHandle_t xTask,
+                            size_t xQuota )
+    {
+        TCB_t * pxTCB;
+
+        taskENTER_CRITICAL();
+        {
+            pxTCB = prvGetTCBFromHandle( xTask );
+            pxTCB->xHeapQuota = xQuota;
+        }
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_TASK_HEAP_ACCOUNTING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
 
-    UBaseType_t uxTaskGetTaskNumber( TaskHandle_t xTask )
+    BaseType_t xTaskHeapQuotaAllows( size_t xBytes )
     {
-        UBaseType_t uxReturn;
-        TCB_t const * pxTCB;
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdTRUE;
 
-        if( xTask != NULL )
+        /* Memory allocated before the scheduler starts is not charged to any
+         * task. */
+        if( xSchedulerRunning != pdFALSE )
         {
-            pxTCB = xTask;
-            uxReturn = pxTCB->uxTaskNumber;
+            taskENTER_CRITICAL();
+            {
+                pxTCB = pxCurrentTCB;
+
+                if( pxTCB->xHeapQuota != ( size_t ) 0 )
+                {
+                    /* Written to avoid overflowing when the task is already
+                     * over a quota that was lowered after it allocated. */
+                    if( ( pxTCB->xHeapBytesAllocated > pxTCB->xHeapQuota ) ||
+                        ( xBytes > ( pxTCB->xHeapQuota - pxTCB->xHeapBytesAllocated ) ) )
+                    {
+                        xReturn = pdFALSE;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
         }
         else
         {
-            uxReturn = 0U;
+            mtCOVERAGE_TEST_MARKER();
         }
 
-        return uxReturn;
+        return xReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_TASK_HEAP_ACCOUNTING */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
 
-    void vTaskSetTaskNumber( TaskHandle_t xTask,
-                             const UBaseType_t uxHandle )
+    TaskHandle_t xTaskHeapCharge( size_t xBytes )
     {
-        TCB_t * pxTCB;
+        TCB_t * pxTCB = NULL;
 
-        if( xTask != NULL )
+        if( xSchedulerRunning != pdFALSE )
         {
-            pxTCB = xTask;
-            pxTCB->uxTaskNumber = uxHandle;
+            taskENTER_CRITICAL();
+            {
+                pxTCB = pxCurrentTCB;
+                pxTCB->xHeapBytesAllocated += xBytes;
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-    }
-
-#endif /* configUSE_TRACE_FACILITY */
 
-/*
- * -----------------------------------------------------------
- * The Idle task.
- * ----------------------------------------------------------
- *
- * The portTASK_FUNCTION() macro is used to allow port/compiler specific
- * language extensions.  The equivalent prototype for this function is:
- *
- * void prvIdleTask( void *pvParameters );
- *
- */
-static portTASK_FUNCTION( prvIdleTask, pvParameters )
-{
-    /* Stop warnings. */
-    ( void ) pvParameters;
+        return pxTCB;
+    }
 
-    /** THIS IS THE RTOS IDLE TASK - WHICH IS CREATED AUTOMATICALLY WHEN THE
-     * SCHEDULER IS STARTED. **/
+#endif /* configUSE_TASK_HEAP_ACCOUNTING */
+/*-----------------------------------------------------------*/
 
-    /* In case a task that has a secure context deletes itself, in which case
-     * the idle task is responsible for deleting the task's secure context, if
-     * any. */
-    portALLOCATE_SECURE_CONTEXT( configMINIMAL_SECURE_STACK_SIZE );
+#if ( configUSE_TASK_HEAP_ACCOUNTING == 1 )
 
-    for( ; ; )
+    void vTaskHeapRelease( TaskHandle_t xOwner,
+                           size_t xBytes )
     {
-        /* See if any tasks have deleted themselves - if so then the idle task
-         * is responsible for freeing the deleted task's TCB and stack. */
-        prvCheckTasksWaitingTermination();
+        TCB_t * const pxTCB = xOwner;
+        BaseType_t xFreeTCB = pdFALSE;
 
-        #if ( configUSE_PREEMPTION == 0 )
+        if( pxTCB != NULL )
         {
-            /* If we are not using preemption we keep forcing a task switch to
-             * see if any other task has become available.  If we are using
-             * preemption we don't need to do this as any task becoming available
-             * will automatically get the processor anyway. */
-            taskYIELD();
-        }
-        #endif /* configUSE_PREEMPTION */
+            taskENTER_CRITICAL();
+            {
+                configASSERT( pxTCB->xHeapBytesAllocated >= xBytes );
+                pxTCB->xHeapBytesAllocated -= xBytes;
 
-        #if ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) )
-        {
-            /* When using preemption tasks of equal priority will be
-             * timesliced.  If a task that is sharing the idle priority is ready
-             * to run then the idle task should yield before the end of the
-             * timeslice.
-             *
-             * A critical region is not required here as we are just reading from
-             * the list, and an occasional incorrect value will not matter.  If
-             * the ready list at the idle priority contains more than one task
-             * then a task other than the idle task is ready to execute. */
-            if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+                if( ( pxTCB->xHeapBytesAllocated == ( size_t ) 0 ) && ( pxTCB->ucHeapOwnerDeleted != ( uint8_t ) pdFALSE ) )
+                {
+                    xFreeTCB = pdTRUE;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            if( xFreeTCB != pdFALSE )
             {
-                taskYIELD();
+                /* The task was deleted and this was the last block charged to
+                 * it, so its TCB is no longer referenced. */
+                vPortFreeObject( portOBJECT_POOL_TASK, pxTCB );
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configIDLE_SHOULD_YIELD == 1 ) ) */
-
-        #if ( configUSE_IDLE_HOOK == 1 )
+        else
         {
-            /* Call the user defined function from within the idle task. */
-            vApplicationIdleHook();
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* configUSE_IDLE_HOOK */
+    }
 
-        /* This conditional compilation should use inequality to 0, not equality
-         * to 1.  This is to ensure portSUPPRESS_TICKS_AND_SLEEP() is called when
-         * user defined low power mode  implementations require
-         * configUSE_TICKLESS_IDLE to be set to a value other than 1. */
-        #if ( configUSE_TICKLESS_IDLE != 0 )
+#endif /* configUSE_TASK_HEAP_ACCOUNTING */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+
+    static void prvMeasureISRWakeLatency( TCB_t * pxTCB,
+                                          configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulLatency;
+        UBaseType_t uxBucket = 0U;
+
+        if( pxTCB->ucISRWakePending != ( uint8_t ) pdFALSE )
         {
-            TickType_t xExpectedIdleTime;
+            pxTCB->ucISRWakePending = ( uint8_t ) pdFALSE;
 
-            /* It is not desirable to suspend then resume the scheduler on
-             * each iteration of the idle task.  Therefore, a preliminary
-             * test of the expected idle time is performed without the
-             * scheduler suspended.  The result here is not necessarily
-             * valid. */
-            xExpectedIdleTime = prvGetExpectedIdleTime();
+            /* Unsigned arithmetic gives the right answer if the counter wrapped
+             * once between the wake and now. */
+            ulLatency = ulNow - pxTCB->ulISRWakeTime;
 
-            if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
+            if( ( pxTCB->ulISRWakeCount == 0U ) || ( ulLatency < pxTCB->ulISRWakeLatencyMin ) )
             {
-                vTaskSuspendAll();
-                {
-                    /* Now the scheduler is suspended, the expected idle
-                     * time can be sampled again, and this time its value can
-                     * be used. */
-                    configASSERT( xNextTaskUnblockTime >= xTickCount );
-                    xExpectedIdleTime = prvGetExpectedIdleTime();
-
-                    /* Define the following macro to set xExpectedIdleTime to 0
-                     * if the application does not want
-                     * portSUPPRESS_TICKS_AND_SLEEP() to be called. */
-                    configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( xExpectedIdleTime );
+                pxTCB->ulISRWakeLatencyMin = ulLatency;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
 
-                    if( xExpectedIdleTime >= configEXPECTED_IDLE_TIME_BEFORE_SLEEP )
-                    {
-                        traceLOW_POWER_IDLE_BEGIN();
-                        portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime );
-                        traceLOW_POWER_IDLE_END();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                ( void ) xTaskResumeAll();
+            if( ulLatency > pxTCB->ulISRWakeLatencyMax )
+            {
+                pxTCB->ulISRWakeLatencyMax = ulLatency;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
+
+            pxTCB->ulISRWakeLatencyTotal += ulLatency;
+            pxTCB->ulISRWakeCount++;
+
+            /* The bucket is the index of the most significant set bit, capped
+             * at the last bucket. */
+            while( ( ulLatency > ( configRUN_TIME_COUNTER_TYPE ) 1U ) && ( uxBucket < ( UBaseType_t ) ( configISR_WAKE_LATENCY_BUCKETS - 1 ) ) )
+            {
+                ulLatency >>= 1U;
+                uxBucket++;
+            }
+
+            pxTCB->ulISRWakeHistogram[ uxBucket ]++;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        #endif /* configUSE_TICKLESS_IDLE */
     }
-}
+
+#endif /* configUSE_ISR_WAKE_LATENCY_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TICKLESS_IDLE != 0 )
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
 
-    eSleepModeStatus eTaskConfirmSleepModeStatus( void )
+    void vTaskGetISRWakeLatencyStats( TaskHandle_t xTask,
+                                      ISRWakeLatencyStats_t * pxStats )
     {
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            /* The idle task exists in addition to the application tasks. */
-            const UBaseType_t uxNonApplicationTasks = 1;
-        #endif /* INCLUDE_vTaskSuspend */
-
-        eSleepModeStatus eReturn = eStandardSleep;
+        TCB_t * pxTCB;
+        UBaseType_t uxBucket;
 
-        /* This function must be called from a critical section. */
+        configASSERT( pxStats );
 
-        if( listCURRENT_LIST_LENGTH( &xPendingReadyList ) != 0 )
+        taskENTER_CRITICAL();
         {
-            /* A task was made ready while the scheduler was suspended. */
-            eReturn = eAbortSleep;
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxStats->ulMinimum = pxTCB->ulISRWakeLatencyMin;
+            pxStats->ulMaximum = pxTCB->ulISRWakeLatencyMax;
+            pxStats->ulTotal = pxTCB->ulISRWakeLatencyTotal;
+            pxStats->ulCount = pxTCB->ulISRWakeCount;
+
+            for( uxBucket = 0U; uxBucket < ( UBaseType_t ) configISR_WAKE_LATENCY_BUCKETS; uxBucket++ )
+            {
+                pxStats->ulHistogram[ uxBucket ] = pxTCB->ulISRWakeHistogram[ uxBucket ];
+            }
         }
-        else if( xYieldPending != pdFALSE )
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_ISR_WAKE_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_ISR_WAKE_LATENCY_STATS == 1 )
+
+    void vTaskResetISRWakeLatencyStats( TaskHandle_t xTask )
+    {
+        TCB_t * pxTCB;
+        UBaseType_t uxBucket;
+
+        taskENTER_CRITICAL();
         {
-            /* A yield was pended while the scheduler was suspended. */
-            eReturn = eAbortSleep;
+            pxTCB = prvGetTCBFromHandle( xTask );
+
+            pxTCB->ulISRWakeLatencyMin = 0U;
+            pxTCB->ulISRWakeLatencyMax = 0U;
+            pxTCB->ulISRWakeLatencyTotal = 0U;
+            pxTCB->ulISRWakeCount = 0U;
+
+            for( uxBucket = 0U; uxBucket < ( UBaseType_t ) configISR_WAKE_LATENCY_BUCKETS; uxBucket++ )
+            {
+                pxTCB->ulISRWakeHistogram[ uxBucket ] = 0U;
+            }
         }
-        else if( xPendedTicks != 0 )
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_ISR_WAKE_LATENCY_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_PERIODIC_TASK_STATS == 1 )
+
+    static TickType_t prvRecordPeriodicRelease( TickType_t xReleaseTime,
+                                                BaseType_t xWasDelayed )
+    {
+        TCB_t * const pxTCB = pxCurrentTCB;
+        TaskPeriodicStats_t * const pxStats = &( pxTCB->xPeriodicStats );
+        TickType_t xLateness, xBucketLateness;
+        UBaseType_t uxBucket = 0U;
+
+        taskENTER_CRITICAL();
         {
-            /* A tick interrupt has already occurred but was held pending
-             * because the scheduler is suspended. */
-            eReturn = eAbortSleep;
-        }
+            /* The task is running again, so the time since its release is how
+             * late it started.  A delay aborted by xTaskAbortDelay() returns
+             * before the release, which counts as on time. */
+            if( taskTICK_IS_BEFORE( xTickCount, xReleaseTime ) != pdFALSE )
+            {
+                xLateness = 0U;
+            }
+            else
+            {
+                xLateness = xTickCount - xReleaseTime;
+            }
 
-        #if ( INCLUDE_vTaskSuspend == 1 )
-            else if( listCURRENT_LIST_LENGTH( &xSuspendedTaskList ) == ( uxCurrentNumberOfTasks - uxNonApplicationTasks ) )
+            if( ( pxStats->ulReleases == 0U ) || ( xLateness < pxStats->xLatenessMin ) )
             {
-                /* If all the tasks are in the suspended list (which might mean they
-                 * have an infinite block time rather than actually being suspended)
-                 * then it is safe to turn all clocks off and just wait for external
-                 * interrupts. */
-                eReturn = eNoTasksWaitingTimeout;
+                pxStats->xLatenessMin = xLateness;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xLateness > pxStats->xLatenessMax )
+            {
+                pxStats->xLatenessMax = xLateness;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxStats->ulReleases++;
+
+            if( xWasDelayed == pdFALSE )
+            {
+                pxStats->ulOverruns++;
+                traceTASK_PERIOD_OVERRUN( pxTCB, xLateness );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            /* The bucket is the index of the most significant set bit, capped
+             * at the last bucket. */
+            xBucketLateness = xLateness;
+
+            while( ( xBucketLateness > ( TickType_t ) 1U ) && ( uxBucket < ( UBaseType_t ) ( configPERIODIC_TASK_STATS_BUCKETS - 1 ) ) )
+            {
+                xBucketLateness >>= 1U;
+                uxBucket++;
             }
-        #endif /* INCLUDE_vTaskSuspend */
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+
+            pxStats->ulHistogram[ uxBucket ]++;
         }
+        taskEXIT_CRITICAL();
 
-        return eReturn;
+        return xLateness;
     }
 
-#endif /* configUSE_TICKLESS_IDLE */
+#endif /* configUSE_PERIODIC_TASK_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+#if ( configUSE_PERIODIC_TASK_STATS == 1 )
 
-    void vTaskSetThreadLocalStoragePointer( TaskHandle_t xTaskToSet,
-                                            BaseType_t xIndex,
-                                            void * pvValue )
+    void vTaskGetPeriodicStats( TaskHandle_t xTask,
+                                TaskPeriodicStats_t * pxStats )
     {
         TCB_t * pxTCB;
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        configASSERT( pxStats );
+
+        taskENTER_CRITICAL();
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToSet );
-            configASSERT( pxTCB != NULL );
-            pxTCB->pvThreadLocalStoragePointers[ xIndex ] = pvValue;
+            pxTCB = prvGetTCBFromHandle( xTask );
+            *pxStats = pxTCB->xPeriodicStats;
         }
+        taskEXIT_CRITICAL();
     }
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+#endif /* configUSE_PERIODIC_TASK_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( configNUM_THREAD_LOCAL_STORAGE_POINTERS != 0 )
+#if ( configUSE_PERIODIC_TASK_STATS == 1 )
 
-    void * pvTaskGetThreadLocalStoragePointer( TaskHandle_t xTaskToQuery,
-                                               BaseType_t xIndex )
+    void vTaskResetPeriodicStats( TaskHandle_t xTask )
     {
-        void * pvReturn = NULL;
         TCB_t * pxTCB;
 
-        if( ( xIndex >= 0 ) &&
-            ( xIndex < configNUM_THREAD_LOCAL_STORAGE_POINTERS ) )
+        taskENTER_CRITICAL();
         {
-            pxTCB = prvGetTCBFromHandle( xTaskToQuery );
-            pvReturn = pxTCB->pvThreadLocalStoragePointers[ xIndex ];
+            pxTCB = prvGetTCBFromHandle( xTask );
+            ( void ) memset( ( void * ) &( pxTCB->xPeriodicStats ), 0x00, sizeof( TaskPeriodicStats_t ) );
         }
-        else
+        taskEXIT_CRITICAL();
+    }
+
+#endif /* configUSE_PERIODIC_TASK_STATS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_MUTEXES == 1 )
+
+    TaskHandle_t pvTaskIncrementMutexHeldCount( void )
+    {
+        /* If xSemaphoreCreateMutex() is called before any tasks have been created
+         * then pxCurrentTCB will be NULL. */
+        if( pxCurrentTCB != NULL )
         {
-            pvReturn = NULL;
+            ( pxCurrentTCB->uxMutexesHeld )++;
         }
 
-        return pvReturn;
+        return pxCurrentTCB;
     }
 
-#endif /* configNUM_THREAD_LOCAL_STORAGE_POINTERS */
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-#if ( portUSING_MPU_WRAPPERS == 1 )
+#if ( configUSE_MUTEXES == 1 )
 
-    void vTaskAllocateMPURegions( TaskHandle_t xTaskToModify,
-                                  const MemoryRegion_t * const xRegions )
+    BaseType_t xTaskDecrementMutexHeldCount( void )
     {
-        TCB_t * pxTCB;
+        TCB_t * const pxTCB = pxCurrentTCB;
+        BaseType_t xReturn = pdFALSE;
 
-        /* If null is passed in here then we are modifying the MPU settings of
-         * the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTaskToModify );
+        configASSERT( pxTCB );
+        configASSERT( pxTCB->uxMutexesHeld );
 
-        vPortStoreTaskMPUSettings( &( pxTCB->xMPUSettings ), xRegions, NULL, 0 );
+        /* Only the task itself changes its mutex held count, and no other task
+         * can cause it to inherit a priority once it holds no mutexes, so the
+         * critical section is only needed if the task is giving back its last
+         * mutex while running at an inherited priority. */
+        if( ( pxTCB->uxMutexesHeld == ( UBaseType_t ) 1 ) && ( pxTCB->uxPriority != pxTCB->uxBasePriority ) )
+        {
+            taskENTER_CRITICAL();
+            {
+                xReturn = xTaskPriorityDisinherit( pxTCB );
+            }
+            taskEXIT_CRITICAL();
+        }
+        else
+        {
+            ( pxTCB->uxMutexesHeld )--;
+        }
+
+        return xReturn;
     }
 
-#endif /* portUSING_MPU_WRAPPERS */
+#endif /* configUSE_MUTEXES */
 /*-----------------------------------------------------------*/
 
-static void prvInitialiseTaskLists( void )
-{
-    UBaseType_t uxPriority;
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+    uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
+                                      BaseType_t xClearCountOnExit,
+                                      TickType_t xTicksToWait )
     {
-        vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
-    }
+        uint32_t ulReturn;
 
-    vListInitialise( &xDelayedTaskList1 );
-    vListInitialise( &xDelayedTaskList2 );
-    vListInitialise( &xPendingReadyList );
+        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-    #if ( INCLUDE_vTaskDelete == 1 )
-    {
-        vListInitialise( &xTasksWaitingTermination );
+        taskENTER_CRITICAL();
+        {
+            /* Only block if the notification count is not already non-zero. */
+            if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
+            {
+                /* Mark this task as waiting for a notification. */
+                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
+
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait );
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        taskENTER_CRITICAL();
+        {
+            traceTASK_NOTIFY_TAKE( uxIndexToWait );
+            ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+
+            if( ulReturn != 0UL )
+            {
+                if( xClearCountOnExit != pdFALSE )
+                {
+                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
+                }
+                else
+                {
+                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
+        }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
     }
-    #endif /* INCLUDE_vTaskDelete */
 
-    #if ( INCLUDE_vTaskSuspend == 1 )
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait,
+                                       uint32_t ulBitsToClearOnEntry,
+                                       uint32_t ulBitsToClearOnExit,
+                                       uint32_t * pulNotificationValue,
+                                       TickType_t xTicksToWait )
     {
-        vListInitialise( &xSuspendedTaskList );
+        BaseType_t xReturn;
+
+        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        taskENTER_CRITICAL();
+        {
+            /* Only block if a notification is not already pending. */
+            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+            {
+                /* Clear bits in the task's notification value as bits may get
+                 * set  by the notifying task or interrupt.  This can be used to
+                 * clear the value to zero. */
+                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
+
+                /* Mark this task as waiting for a notification. */
+                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
+
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait );
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+
+        taskENTER_CRITICAL();
+        {
+            traceTASK_NOTIFY_WAIT( uxIndexToWait );
+
+            if( pulNotificationValue != NULL )
+            {
+                /* Output the current notification value, which may or may not
+                 * have changed. */
+                *pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+            }
+
+            /* If ucNotifyValue is set then either the task never entered the
+             * blocked state (because a notification was already pending) or the
+             * task unblocked because of a notification.  Otherwise the task
+             * unblocked because of a timeout. */
+            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+            {
+                /* A notification was not received. */
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                /* A notification was already pending or a notification was
+                 * received while the task was waiting. */
+                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
+                xReturn = pdTRUE;
+            }
+
+            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
+        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
     }
-    #endif /* INCLUDE_vTaskSuspend */
 
-    /* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-     * using list2. */
-    pxDelayedTaskList = &xDelayedTaskList1;
-    pxOverflowDelayedTaskList = &xDelayedTaskList2;
-}
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-static void prvCheckTasksWaitingTermination( void )
-{
-    /** THIS FUNCTION IS CALLED FROM THE RTOS IDLE TASK **/
+#if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_TASK_NOTIFY_SPIN == 1 ) )
 
-    #if ( INCLUDE_vTaskDelete == 1 )
+    BaseType_t xTaskGenericNotifyWaitSpin( UBaseType_t uxIndexToWait,
+                                           uint32_t ulBitsToClearOnEntry,
+                                           uint32_t ulBitsToClearOnExit,
+                                           uint32_t * pulNotificationValue,
+                                           UBaseType_t uxSpinCount,
+                                           TickType_t xTicksToWait )
     {
         TCB_t * pxTCB;
+        UBaseType_t uxSpin;
 
-        /* uxDeletedTasksWaitingCleanUp is used to prevent taskENTER_CRITICAL()
-         * being called too often in the idle task. */
-        while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        if( uxSpinCount > ( UBaseType_t ) 0U )
         {
             taskENTER_CRITICAL();
-            {
-                pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                ( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-                --uxCurrentNumberOfTasks;
-                --uxDeletedTasksWaitingCleanUp;
+            {
+                pxTCB = pxCurrentTCB;
+
+                if( pxTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+                {
+                    /* Clear the bits now, as a notification may arrive while
+                     * polling, and mark the task as spinning so a notifier
+                     * signals an event but does not try to unblock it. */
+                    pxTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
+                    pxTCB->ucNotifyState[ uxIndexToWait ] = taskSPINNING_NOTIFICATION;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             taskEXIT_CRITICAL();
 
-            prvDeleteTCB( pxTCB );
+            /* The bits have been cleared once already, so must not be
+             * cleared again if the task goes on to block. */
+            ulBitsToClearOnEntry = 0U;
+
+            /* Poll outside of a critical section.  The task can still be
+             * preempted, and ucNotifyState is volatile, so the notification is
+             * seen whichever core or interrupt sends it. */
+            for( uxSpin = 0U; uxSpin < uxSpinCount; uxSpin++ )
+            {
+                if( pxTCB->ucNotifyState[ uxIndexToWait ] == taskNOTIFICATION_RECEIVED )
+                {
+                    break;
+                }
+
+                portWAIT_FOR_EVENT();
+            }
         }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
+
+        /* Complete the wait, which returns at once if the notification arrived
+         * while polling, and otherwise blocks for up to xTicksToWait.  It also
+         * returns the spinning state to taskNOT_WAITING_NOTIFICATION. */
+        return xTaskGenericNotifyWait( uxIndexToWait, ulBitsToClearOnEntry, ulBitsToClearOnExit, pulNotificationValue, xTicksToWait );
     }
-    #endif /* INCLUDE_vTaskDelete */
-}
+
+#endif /* ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configUSE_TASK_NOTIFY_SPIN == 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    void vTaskGetInfo( TaskHandle_t xTask,
-                       TaskStatus_t * pxTaskStatus,
-                       BaseType_t xGetFreeStackSpace,
-                       eTaskState eState )
+    BaseType_t xTaskNotifyWaitAny( UBaseType_t uxIndexMask,
+                                   uint32_t ulBitsToClearOnEntry,
+                                   uint32_t ulBitsToClearOnExit,
+                                   uint32_t * pulNotificationValue,
+                                   UBaseType_t * puxIndexNotified,
+                                   TickType_t xTicksToWait )
     {
-        TCB_t * pxTCB;
-
-        /* xTask is NULL then get the state of the calling task. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        BaseType_t xReturn = pdFALSE;
+        UBaseType_t x;
+        UBaseType_t uxFirstIndex = configTASK_NOTIFICATION_ARRAY_ENTRIES;
+        UBaseType_t uxIndexNotified = configTASK_NOTIFICATION_ARRAY_ENTRIES;
 
-        pxTaskStatus->xHandle = ( TaskHandle_t ) pxTCB;
-        pxTaskStatus->pcTaskName = ( const char * ) &( pxTCB->pcTaskName[ 0 ] );
-        pxTaskStatus->uxCurrentPriority = pxTCB->uxPriority;
-        pxTaskStatus->pxStackBase = pxTCB->pxStack;
-        #if ( ( portSTACK_GROWTH > 0 ) && ( configRECORD_STACK_HIGH_ADDRESS == 1 ) )
-            pxTaskStatus->pxTopOfStack = pxTCB->pxTopOfStack;
-            pxTaskStatus->pxEndOfStack = pxTCB->pxEndOfStack;
-        #endif
-        pxTaskStatus->xTaskNumber = pxTCB->uxTCBNumber;
+        /* Every index must have a bit in the mask, and at least one must be
+         * waited on. */
+        configASSERT( configTASK_NOTIFICATION_ARRAY_ENTRIES <= ( sizeof( UBaseType_t ) * 8U ) );
+        configASSERT( uxIndexMask != ( UBaseType_t ) 0U );
 
-        #if ( configUSE_MUTEXES == 1 )
-        {
-            pxTaskStatus->uxBasePriority = pxTCB->uxBasePriority;
-        }
-        #else
+        taskENTER_CRITICAL();
         {
-            pxTaskStatus->uxBasePriority = 0;
-        }
-        #endif
+            /* Only block if a notification is not already pending at one of
+             * the indexes. */
+            for( x = 0U; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+            {
+                if( ( uxIndexMask & tskNOTIFY_INDEX_BIT( x ) ) != ( UBaseType_t ) 0U )
+                {
+                    if( uxFirstIndex == configTASK_NOTIFICATION_ARRAY_ENTRIES )
+                    {
+                        uxFirstIndex = x;
+                    }
 
-        #if ( configGENERATE_RUN_TIME_STATS == 1 )
-        {
-            pxTaskStatus->ulRunTimeCounter = pxTCB->ulRunTimeCounter;
-        }
-        #else
-        {
-            pxTaskStatus->ulRunTimeCounter = ( configRUN_TIME_COUNTER_TYPE ) 0;
-        }
-        #endif
+                    if( pxCurrentTCB->ucNotifyState[ x ] == taskNOTIFICATION_RECEIVED )
+                    {
+                        xReturn = pdTRUE;
+                        break;
+                    }
+                }
+            }
 
-        /* Obtaining the task state is a little fiddly, so is only done if the
-         * value of eState passed into this function is eInvalid - otherwise the
-         * state is just set to whatever is passed in. */
-        if( eState != eInvalid )
-        {
-            if( pxTCB == pxCurrentTCB )
+            configASSERT( uxFirstIndex < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+            if( xReturn == pdFALSE )
             {
-                pxTaskStatus->eCurrentState = eRunning;
+                /* Mark the task as waiting at every index in the mask.  The
+                 * first notification to arrive unblocks it and cancels the
+                 * wait at the others. */
+                for( x = 0U; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+                {
+                    if( ( uxIndexMask & tskNOTIFY_INDEX_BIT( x ) ) != ( UBaseType_t ) 0U )
+                    {
+                        pxCurrentTCB->ulNotifiedValue[ x ] &= ~ulBitsToClearOnEntry;
+                        pxCurrentTCB->ucNotifyState[ x ] = taskWAITING_NOTIFICATION;
+                    }
+                }
+
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_WAIT_BLOCK( uxFirstIndex );
+
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
             else
             {
-                pxTaskStatus->eCurrentState = eState;
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
 
-                #if ( INCLUDE_vTaskSuspend == 1 )
+        taskENTER_CRITICAL();
+        {
+            /* Report the lowest notified index, leaving notifications pending
+             * at any others to be returned by later calls, and stop waiting at
+             * the indexes that were not notified. */
+            for( x = 0U; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
+            {
+                if( ( uxIndexMask & tskNOTIFY_INDEX_BIT( x ) ) != ( UBaseType_t ) 0U )
                 {
-                    /* If the task is in the suspended list then there is a
-                     *  chance it is actually just blocked indefinitely - so really
-                     *  it should be reported as being in the Blocked state. */
-                    if( eState == eSuspended )
+                    if( pxCurrentTCB->ucNotifyState[ x ] == taskNOTIFICATION_RECEIVED )
                     {
-                        vTaskSuspendAll();
+                        if( uxIndexNotified == configTASK_NOTIFICATION_ARRAY_ENTRIES )
                         {
-                            if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
-                            {
-                                pxTaskStatus->eCurrentState = eBlocked;
-                            }
+                            uxIndexNotified = x;
                         }
-                        ( void ) xTaskResumeAll();
+                    }
+                    else
+                    {
+                        pxCurrentTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
                     }
                 }
-                #endif /* INCLUDE_vTaskSuspend */
             }
-        }
-        else
-        {
-            pxTaskStatus->eCurrentState = eTaskGetState( pxTCB );
-        }
 
-        /* Obtaining the stack space takes some time, so the xGetFreeStackSpace
-         * parameter is provided to allow it to be skipped. */
-        if( xGetFreeStackSpace != pdFALSE )
-        {
-            #if ( portSTACK_GROWTH > 0 )
+            if( uxIndexNotified == configTASK_NOTIFICATION_ARRAY_ENTRIES )
             {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
+                /* A notification was not received. */
+                traceTASK_NOTIFY_WAIT( uxFirstIndex );
+                xReturn = pdFALSE;
             }
-            #else
+            else
             {
-                pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxStack );
+                traceTASK_NOTIFY_WAIT( uxIndexNotified );
+
+                if( pulNotificationValue != NULL )
+                {
+                    *pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexNotified ];
+                }
+
+                if( puxIndexNotified != NULL )
+                {
+                    *puxIndexNotified = uxIndexNotified;
+                }
+
+                pxCurrentTCB->ulNotifiedValue[ uxIndexNotified ] &= ~ulBitsToClearOnExit;
+                pxCurrentTCB->ucNotifyState[ uxIndexNotified ] = taskNOT_WAITING_NOTIFICATION;
+                xReturn = pdTRUE;
             }
-            #endif
-        }
-        else
-        {
-            pxTaskStatus->usStackHighWaterMark = 0;
         }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TRACE_FACILITY == 1 )
+#if ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 ) )
 
-    static UBaseType_t prvListTasksWithinSingleList( TaskStatus_t * pxTaskStatusArray,
-                                                     List_t * pxList,
-                                                     eTaskState eState )
+    static void prvTaskNotifyCancelOtherWaits( TCB_t * pxTCB,
+                                               UBaseType_t uxIndexNotified )
     {
-        configLIST_VOLATILE TCB_t * pxNextTCB;
-        configLIST_VOLATILE TCB_t * pxFirstTCB;
-        UBaseType_t uxTask = 0;
+        UBaseType_t x;
 
-        if( listCURRENT_LIST_LENGTH( pxList ) > ( UBaseType_t ) 0 )
+        for( x = 0U; x < configTASK_NOTIFICATION_ARRAY_ENTRIES; x++ )
         {
-            listGET_OWNER_OF_NEXT_ENTRY( pxFirstTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-
-            /* Populate an TaskStatus_t structure within the
-             * pxTaskStatusArray array for each task that is referenced from
-             * pxList.  See the definition of TaskStatus_t in task.h for the
-             * meaning of each TaskStatus_t structure member. */
-            do
+            if( ( x != uxIndexNotified ) && ( pxTCB->ucNotifyState[ x ] == taskWAITING_NOTIFICATION ) )
             {
-                listGET_OWNER_OF_NEXT_ENTRY( pxNextTCB, pxList ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-                vTaskGetInfo( ( TaskHandle_t ) pxNextTCB, &( pxTaskStatusArray[ uxTask ] ), pdTRUE, eState );
-                uxTask++;
-            } while( pxNextTCB != pxFirstTCB );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+                pxTCB->ucNotifyState[ x ] = taskNOT_WAITING_NOTIFICATION;
+            }
         }
-
-        return uxTask;
     }
 
-#endif /* configUSE_TRACE_FACILITY */
+#endif /* ( ( configUSE_TASK_NOTIFICATIONS == 1 ) && ( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    static configSTACK_DEPTH_TYPE prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
+    static BaseType_t prvTaskNotifyUpdate( TCB_t * pxTCB,
+                                           UBaseType_t uxIndexToNotify,
+                                           uint32_t ulValue,
+                                           eNotifyAction eAction,
+                                           uint8_t * pucOriginalNotifyState )
     {
-        uint32_t ulCount = 0U;
-
-        while( *pucStackByte == ( uint8_t ) tskSTACK_FILL_BYTE )
-        {
-            pucStackByte -= portSTACK_GROWTH;
-            ulCount++;
-        }
-
-        ulCount /= ( uint32_t ) sizeof( StackType_t ); /*lint !e961 Casting is not redundant on smaller architectures. */
-
-        return ( configSTACK_DEPTH_TYPE ) ulCount;
-    }
+        BaseType_t xReturn = pdPASS;
+        uint8_t ucOriginalNotifyState;
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 ) ) */
-/*-----------------------------------------------------------*/
+        ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+        pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark2 == 1 )
+        switch( eAction )
+        {
+            case eSetBits:
+                pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
+                break;
 
-/* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are the
- * same except for their return type.  Using configSTACK_DEPTH_TYPE allows the
- * user to determine the return type.  It gets around the problem of the value
- * overflowing on 8-bit types without breaking backward compatibility for
- * applications that expect an 8-bit return type. */
-    configSTACK_DEPTH_TYPE uxTaskGetStackHighWaterMark2( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        configSTACK_DEPTH_TYPE uxReturn;
+            case eIncrement:
+                ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+                break;
 
-        /* uxTaskGetStackHighWaterMark() and uxTaskGetStackHighWaterMark2() are
-         * the same except for their return type.  Using configSTACK_DEPTH_TYPE
-         * allows the user to determine the return type.  It gets around the
-         * problem of the value overflowing on 8-bit types without breaking
-         * backward compatibility for applications that expect an 8-bit return
-         * type. */
+            case eSetValueWithOverwrite:
+                pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                break;
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+            case eSetValueWithoutOverwrite:
 
-        #if portSTACK_GROWTH < 0
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
-        }
-        #else
-        {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
-        }
-        #endif
+                if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
+                {
+                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
+                }
+                else
+                {
+                    /* The value could not be written to the task. */
+                    xReturn = pdFAIL;
+                }
 
-        uxReturn = prvTaskCheckFreeStackSpace( pucEndOfStack );
+                break;
 
-        return uxReturn;
-    }
+            case eNoAction:
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark2 */
-/*-----------------------------------------------------------*/
+                /* The task is being notified without its notify value being
+                 * updated. */
+                break;
 
-#if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
+            default:
 
-    UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
-    {
-        TCB_t * pxTCB;
-        uint8_t * pucEndOfStack;
-        UBaseType_t uxReturn;
+                /* Should not get here if all enums are handled.
+                 * Artificially force an assert by testing a value the
+                 * compiler can't assume is const. */
+                configASSERT( xTickCount == ( TickType_t ) 0 );
 
-        pxTCB = prvGetTCBFromHandle( xTask );
+                break;
+        }
 
-        #if portSTACK_GROWTH < 0
+        #if ( configUSE_TASK_NOTIFY_SPIN == 1 )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+            /* Wake the task if it is polling on another core. */
+            if( ucOriginalNotifyState == taskSPINNING_NOTIFICATION )
+            {
+                portSEND_EVENT();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        #else
+        #endif /* configUSE_TASK_NOTIFY_SPIN */
+
+        #if ( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 )
         {
-            pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                prvTaskNotifyCancelOtherWaits( pxTCB, uxIndexToNotify );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
         }
-        #endif
+        #endif /* configTASK_NOTIFICATION_ARRAY_ENTRIES */
 
-        uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
+        *pucOriginalNotifyState = ucOriginalNotifyState;
 
-        return uxReturn;
+        return xReturn;
     }
 
-#endif /* INCLUDE_uxTaskGetStackHighWaterMark */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( INCLUDE_vTaskDelete == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    static void prvDeleteTCB( TCB_t * pxTCB )
+    BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
+                                   UBaseType_t uxIndexToNotify,
+                                   uint32_t ulValue,
+                                   eNotifyAction eAction,
+                                   uint32_t * pulPreviousNotificationValue )
     {
-        /* This call is required specifically for the TriCore port.  It must be
-         * above the vPortFree() calls.  The call is also used by ports/demos that
-         * want to allocate and clean RAM statically. */
-        portCLEAN_UP_TCB( pxTCB );
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdPASS;
+        uint8_t ucOriginalNotifyState;
 
-        #if ( ( configUSE_NEWLIB_REENTRANT == 1 ) || ( configUSE_C_RUNTIME_TLS_SUPPORT == 1 ) )
-        {
-            /* Free up the memory allocated for the task's TLS Block. */
-            configDEINIT_TLS_BLOCK( pxCurrentTCB->xTLSBlock );
-        }
-        #endif
+        traceBENCHMARK_API_ENTER( benchmarkAPI_TASK_NOTIFY );
 
-        #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( portUSING_MPU_WRAPPERS == 0 ) )
-        {
-            /* The task can only have been allocated dynamically - free both
-             * the stack and TCB. */
-            vPortFreeStack( pxTCB->pxStack );
-            vPortFree( pxTCB );
-        }
-        #elif ( tskSTATIC_AND_DYNAMIC_ALLOCATION_POSSIBLE != 0 ) /*lint !e731 !e9029 Macro has been consolidated for readability reasons. */
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( xTaskToNotify );
+        pxTCB = xTaskToNotify;
+
+        taskENTER_CRITICAL();
         {
-            /* The task could have been allocated statically or dynamically, so
-             * check what was statically allocated before trying to free the
-             * memory. */
-            if( pxTCB->ucStaticallyAllocated == tskDYNAMICALLY_ALLOCATED_STACK_AND_TCB )
+            if( pulPreviousNotificationValue != NULL )
             {
-                /* Both the stack and TCB were allocated dynamically, so both
-                 * must be freed. */
-                vPortFreeStack( pxTCB->pxStack );
-                vPortFree( pxTCB );
+                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
             }
-            else if( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_ONLY )
+
+            xReturn = prvTaskNotifyUpdate( pxTCB, uxIndexToNotify, ulValue, eAction, &ucOriginalNotifyState );
+
+            traceTASK_NOTIFY( uxIndexToNotify );
+
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
-                /* Only the stack was statically allocated, so the TCB is the
-                 * only memory that must be freed. */
-                vPortFree( pxTCB );
+                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                prvAddTaskToReadyList( pxTCB );
+
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                #if ( configUSE_TICKLESS_IDLE != 0 )
+                {
+                    /* If a task is blocked waiting for a notification then
+                     * xNextTaskUnblockTime might be set to the blocked task's time
+                     * out time.  If the task is unblocked for a reason other than
+                     * a timeout xNextTaskUnblockTime is normally left unchanged,
+                     * because it will automatically get reset to a new value when
+                     * the tick count equals xNextTaskUnblockTime.  However if
+                     * tickless idling is used it might be more important to enter
+                     * sleep mode at the earliest possible time - so reset
+                     * xNextTaskUnblockTime here to ensure it is updated at the
+                     * earliest possible time. */
+                    prvResetNextTaskUnblockTime();
+                }
+                #endif
+
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
+                    {
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        taskYIELD_IF_USING_PREEMPTION();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #elif ( configUSE_PREEMPTION == 1 )
+                {
+                    /* A yield on this core is performed when the critical
+                     * section is exited. */
+                    prvYieldForTask( pxTCB );
+                }
+                #endif /* if ( configNUMBER_OF_CORES == 1 ) */
             }
             else
             {
-                /* Neither the stack nor the TCB were allocated dynamically, so
-                 * nothing needs to be freed. */
-                configASSERT( pxTCB->ucStaticallyAllocated == tskSTATICALLY_ALLOCATED_STACK_AND_TCB );
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+        taskEXIT_CRITICAL();
+
+        traceBENCHMARK_API_EXIT( benchmarkAPI_TASK_NOTIFY );
+        return xReturn;
     }
 
-#endif /* INCLUDE_vTaskDelete */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-    if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-    {
-        /* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-         * the maximum possible value so it is  extremely unlikely that the
-         * if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-         * there is an item in the delayed list. */
-        xNextTaskUnblockTime = portMAX_DELAY;
-    }
-    else
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    BaseType_t xTaskGenericNotifyGroup( TaskHandle_t const * pxTasksToNotify,
+                                        UBaseType_t uxNumberOfTasks,
+                                        UBaseType_t uxIndexToNotify,
+                                        uint32_t ulValue,
+                                        eNotifyAction eAction )
     {
-        /* The new current delayed list is not empty, get the value of
-         * the item at the head of the delayed list.  This is the time at
-         * which the task at the head of the delayed list should be removed
-         * from the Blocked state. */
-        xNextTaskUnblockTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxDelayedTaskList );
-    }
-}
-/*-----------------------------------------------------------*/
+        TCB_t * pxTCB;
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxTask;
+        uint8_t ucOriginalNotifyState;
+        BaseType_t xTaskWoken = pdFALSE;
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+        #if ( configNUMBER_OF_CORES == 1 )
+            BaseType_t xYieldRequired = pdFALSE;
+        #endif
 
-    TaskHandle_t xTaskGetCurrentTaskHandle( void )
-    {
-        TaskHandle_t xReturn;
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        configASSERT( ( pxTasksToNotify != NULL ) || ( uxNumberOfTasks == 0U ) );
 
-        /* A critical section is not required as this is not called from
-         * an interrupt and the current TCB will always be the same for any
-         * individual execution thread. */
-        xReturn = pxCurrentTCB;
+        taskENTER_CRITICAL();
+        {
+            for( uxTask = 0; uxTask < uxNumberOfTasks; uxTask++ )
+            {
+                pxTCB = pxTasksToNotify[ uxTask ];
+                configASSERT( pxTCB );
 
-        return xReturn;
-    }
+                if( prvTaskNotifyUpdate( pxTCB, uxIndexToNotify, ulValue, eAction, &ucOriginalNotifyState ) != pdPASS )
+                {
+                    xReturn = pdFAIL;
+                }
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
-/*-----------------------------------------------------------*/
+                traceTASK_NOTIFY( uxIndexToNotify );
 
-#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+                if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
 
-    BaseType_t xTaskGetSchedulerState( void )
-    {
-        BaseType_t xReturn;
+                    /* The task should not have been on an event list. */
+                    configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
-        if( xSchedulerRunning == pdFALSE )
-        {
-            xReturn = taskSCHEDULER_NOT_STARTED;
-        }
-        else
-        {
-            if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                    xTaskWoken = pdTRUE;
+
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
+                        {
+                            xYieldRequired = pdTRUE;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                    #elif ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* A yield on this core is performed when the critical
+                         * section is exited. */
+                        prvYieldForTask( pxTCB );
+                    }
+                    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
             {
-                xReturn = taskSCHEDULER_RUNNING;
+                /* See xTaskGenericNotify() - recalculated once for the whole
+                 * group rather than once per woken task. */
+                if( xTaskWoken != pdFALSE )
+                {
+                    prvResetNextTaskUnblockTime();
+                }
             }
-            else
+            #endif
+
+            #if ( configNUMBER_OF_CORES == 1 )
             {
-                xReturn = taskSCHEDULER_SUSPENDED;
+                /* A single yield decision is made for the whole group. */
+                if( xYieldRequired != pdFALSE )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+            #endif
         }
+        taskEXIT_CRITICAL();
+
+        /* Only used when tickless idle is enabled. */
+        ( void ) xTaskWoken;
 
         return xReturn;
     }
 
-#endif /* ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) ) */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    BaseType_t xTaskPriorityInherit( TaskHandle_t const pxMutexHolder )
+    BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
+                                          UBaseType_t uxIndexToNotify,
+                                          uint32_t ulValue,
+                                          eNotifyAction eAction,
+                                          uint32_t * pulPreviousNotificationValue,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
     {
-        TCB_t * const pxMutexHolderTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
+        TCB_t * pxTCB;
+        uint8_t ucOriginalNotifyState;
+        BaseType_t xReturn = pdPASS;
+        UBaseType_t uxSavedInterruptStatus;
 
-        /* If the mutex was given back by an interrupt while the queue was
-         * locked then the mutex holder might now be NULL.  _RB_ Is this still
-         * needed as interrupts can no longer use mutexes? */
-        if( pxMutexHolder != NULL )
+        traceBENCHMARK_API_ENTER( benchmarkAPI_TASK_NOTIFY_FROM_ISR );
+
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+        pxTCB = xTaskToNotify;
+
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
         {
-            /* If the holder of the mutex has a priority below the priority of
-             * the task attempting to obtain the mutex then it will temporarily
-             * inherit the priority of the task attempting to obtain the mutex. */
-            if( pxMutexHolderTCB->uxPriority < pxCurrentTCB->uxPriority )
+            if( pulPreviousNotificationValue != NULL )
             {
-                /* Adjust the mutex holder state to account for its new
-                 * priority.  Only reset the event list item value if the value is
-                 * not being used for anything else. */
-                if( ( listGET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
+                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+            }
+
+            xReturn = prvTaskNotifyUpdate( pxTCB, uxIndexToNotify, ulValue, eAction, &ucOriginalNotifyState );
+
+            traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
+
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            {
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+
+                taskRECORD_ISR_WAKE( pxTCB );
+
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                 {
-                    listSET_LIST_ITEM_VALUE( &( pxMutexHolderTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
                 }
                 else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
                 }
 
-                /* If the task being modified is in the ready state it will need
-                 * to be moved into a new list. */
-                if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxMutexHolderTCB->uxPriority ] ), &( pxMutexHolderTCB->xStateListItem ) ) != pdFALSE )
+                #if ( configNUMBER_OF_CORES == 1 )
                 {
-                    if( uxListRemove( &( pxMutexHolderTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+                    if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
                     {
-                        /* It is known that the task is in its ready list so
-                         * there is no need to check again and the port level
-                         * reset macro can be called directly. */
-                        portRESET_READY_PRIORITY( pxMutexHolderTCB->uxPriority, uxTopReadyPriority );
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
+                        {
+                            *pxHigherPriorityTaskWoken = pdTRUE;
+                        }
+
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter to an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
+                        portPEND_YIELD_FROM_ISR();
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
-
-                    /* Inherit the priority before being moved into the new list. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                    prvAddTaskToReadyList( pxMutexHolderTCB );
                 }
-                else
+                #elif ( configUSE_PREEMPTION == 1 )
                 {
-                    /* Just inherit the priority. */
-                    pxMutexHolderTCB->uxPriority = pxCurrentTCB->uxPriority;
-                }
+                    prvYieldForTask( pxTCB );
 
-                traceTASK_PRIORITY_INHERIT( pxMutexHolderTCB, pxCurrentTCB->uxPriority );
-
-                /* Inheritance occurred. */
-                xReturn = pdTRUE;
-            }
-            else
-            {
-                if( pxMutexHolderTCB->uxBasePriority < pxCurrentTCB->uxPriority )
-                {
-                    /* The base priority of the mutex holder is lower than the
-                     * priority of the task attempting to take the mutex, but the
-                     * current priority of the mutex holder is not lower than the
-                     * priority of the task attempting to take the mutex.
-                     * Therefore the mutex holder must have already inherited a
-                     * priority, but inheritance would have occurred if that had
-                     * not been the case. */
-                    xReturn = pdTRUE;
+                    /* Only this core's yield is left to the caller - other
+                     * cores have already been interrupted. */
+                    if( ( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
                 }
-                else
+                #else
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    /* Without preemption a task that is made ready never
+                     * requires a yield. */
+                    ( void ) pxHigherPriorityTaskWoken;
                 }
+                #endif /* if ( configNUMBER_OF_CORES == 1 ) */
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
+        traceBENCHMARK_API_EXIT( benchmarkAPI_TASK_NOTIFY_FROM_ISR );
         return xReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    BaseType_t xTaskPriorityDisinherit( TaskHandle_t const pxMutexHolder )
+    void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify,
+                                        UBaseType_t uxIndexToNotify,
+                                        BaseType_t * pxHigherPriorityTaskWoken )
     {
-        TCB_t * const pxTCB = pxMutexHolder;
-        BaseType_t xReturn = pdFALSE;
+        TCB_t * pxTCB;
+        uint8_t ucOriginalNotifyState;
+        UBaseType_t uxSavedInterruptStatus;
 
-        if( pxMutexHolder != NULL )
-        {
-            /* A task can only have an inherited priority if it holds the mutex.
-             * If the mutex is held by a task then it cannot be given from an
-             * interrupt, and if a mutex is given by the holding task then it must
-             * be the running state task. */
-            configASSERT( pxTCB == pxCurrentTCB );
-            configASSERT( pxTCB->uxMutexesHeld );
-            ( pxTCB->uxMutexesHeld )--;
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-            /* Has the holder of the mutex inherited the priority of another
-             * task? */
-            if( pxTCB->uxPriority != pxTCB->uxBasePriority )
-            {
-                /* Only disinherit if no other mutexes are held. */
-                if( pxTCB->uxMutexesHeld == ( UBaseType_t ) 0 )
-                {
-                    /* A task can only have an inherited priority if it holds
-                     * the mutex.  If the mutex is held by a task then it cannot be
-                     * given from an interrupt, and if a mutex is given by the
-                     * holding task then it must be the running state task.  Remove
-                     * the holding task from the ready list. */
-                    if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                    {
-                        portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+        /* RTOS ports that support interrupt nesting have the concept of a
+         * maximum  system call (or maximum API call) interrupt priority.
+         * Interrupts that are  above the maximum system call priority are keep
+         * permanently enabled, even when the RTOS kernel is in a critical section,
+         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
+         * is defined in FreeRTOSConfig.h then
+         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+         * failure if a FreeRTOS API function is called from an interrupt that has
+         * been assigned a priority above the configured maximum system call
+         * priority.  Only FreeRTOS functions that end in FromISR can be called
+         * from interrupts  that have been assigned a priority at or (logically)
+         * below the maximum system call interrupt priority.  FreeRTOS maintains a
+         * separate interrupt safe API to ensure interrupt entry is as fast and as
+         * simple as possible.  More information (albeit Cortex-M specific) is
+         * provided on the following link:
+         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
+        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-                    /* Disinherit the priority before adding the task into the
-                     * new  ready list. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, pxTCB->uxBasePriority );
-                    pxTCB->uxPriority = pxTCB->uxBasePriority;
+        pxTCB = xTaskToNotify;
 
-                    /* Reset the event list item value.  It cannot be in use for
-                     * any other purpose if this task is running, and it must be
-                     * running to give back the mutex. */
-                    listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxTCB->uxPriority ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    prvAddTaskToReadyList( pxTCB );
+        uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+        {
+            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
 
-                    /* Return true to indicate that a context switch is required.
-                     * This is only actually required in the corner case whereby
-                     * multiple mutexes were held and the mutexes were given back
-                     * in an order different to that in which they were taken.
-                     * If a context switch did not occur when the first mutex was
-                     * returned, even if a task was waiting on it, then a context
-                     * switch should occur when the last mutex is returned whether
-                     * a task is waiting on it or not. */
-                    xReturn = pdTRUE;
+            /* 'Giving' is equivalent to incrementing a count in a counting
+             * semaphore. */
+            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
+
+            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
+
+            #if ( configUSE_TASK_NOTIFY_SPIN == 1 )
+            {
+                if( ucOriginalNotifyState == taskSPINNING_NOTIFICATION )
+                {
+                    portSEND_EVENT();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
-
-        return xReturn;
-    }
-
-#endif /* configUSE_MUTEXES */
-/*-----------------------------------------------------------*/
-
-#if ( configUSE_MUTEXES == 1 )
-
-    void vTaskPriorityDisinheritAfterTimeout( TaskHandle_t const pxMutexHolder,
-                                              UBaseType_t uxHighestPriorityWaitingTask )
-    {
-        TCB_t * const pxTCB = pxMutexHolder;
-        UBaseType_t uxPriorityUsedOnEntry, uxPriorityToUse;
-        const UBaseType_t uxOnlyOneMutexHeld = ( UBaseType_t ) 1;
-
-        if( pxMutexHolder != NULL )
-        {
-            /* If pxMutexHolder is not NULL then the holder must hold at least
-             * one mutex. */
-            configASSERT( pxTCB->uxMutexesHeld );
+            #endif /* configUSE_TASK_NOTIFY_SPIN */
 
-            /* Determine the priority to which the priority of the task that
-             * holds the mutex should be set.  This will be the greater of the
-             * holding task's base priority and the priority of the highest
-             * priority task that is waiting to obtain the mutex. */
-            if( pxTCB->uxBasePriority < uxHighestPriorityWaitingTask )
-            {
-                uxPriorityToUse = uxHighestPriorityWaitingTask;
-            }
-            else
+            /* If the task is in the blocked state specifically to wait for a
+             * notification then unblock it now. */
+            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
             {
-                uxPriorityToUse = pxTCB->uxBasePriority;
-            }
+                /* The task should not have been on an event list. */
+                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
 
-            /* Does the priority need to change? */
-            if( pxTCB->uxPriority != uxPriorityToUse )
-            {
-                /* Only disinherit if no other mutexes are held.  This is a
-                 * simplification in the priority inheritance implementation.  If
-                 * the task that holds the mutex is also holding other mutexes then
-                 * the other mutexes may have caused the priority inheritance. */
-                if( pxTCB->uxMutexesHeld == uxOnlyOneMutexHeld )
-                {
-                    /* If a task has timed out because it already holds the
-                     * mutex it was trying to obtain then it cannot of inherited
-                     * its own priority. */
-                    configASSERT( pxTCB != pxCurrentTCB );
+                taskRECORD_ISR_WAKE( pxTCB );
 
-                    /* Disinherit the priority, remembering the previous
-                     * priority to facilitate determining the subject task's
-                     * state. */
-                    traceTASK_PRIORITY_DISINHERIT( pxTCB, uxPriorityToUse );
-                    uxPriorityUsedOnEntry = pxTCB->uxPriority;
-                    pxTCB->uxPriority = uxPriorityToUse;
+                #if ( configTASK_NOTIFICATION_ARRAY_ENTRIES > 1 )
+                {
+                    prvTaskNotifyCancelOtherWaits( pxTCB, uxIndexToNotify );
+                }
+                #endif
 
-                    /* Only reset the event list item value if the value is not
-                     * being used for anything else. */
-                    if( ( listGET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ) ) & taskEVENT_LIST_ITEM_VALUE_IN_USE ) == 0UL )
-                    {
-                        listSET_LIST_ITEM_VALUE( &( pxTCB->xEventListItem ), ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) uxPriorityToUse ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+                {
+                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                    prvAddTaskToReadyList( pxTCB );
+                }
+                else
+                {
+                    /* The delayed and ready lists cannot be accessed, so hold
+                     * this task pending until the scheduler is resumed. */
+                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                }
 
-                    /* If the running task is not the task that holds the mutex
-                     * then the task that holds the mutex could be in either the
-                     * Ready, Blocked or Suspended states.  Only remove the task
-                     * from its current state list if it is in the Ready state as
-                     * the task's priority is going to change and there is one
-                     * Ready list per priority. */
-                    if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ uxPriorityUsedOnEntry ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+                #if ( configNUMBER_OF_CORES == 1 )
+                {
+                    if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
                     {
-                        if( uxListRemove( &( pxTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
-                        {
-                            /* It is known that the task is in its ready list so
-                             * there is no need to check again and the port level
-                             * reset macro can be called directly. */
-                            portRESET_READY_PRIORITY( pxTCB->uxPriority, uxTopReadyPriority );
-                        }
-                        else
+                        /* The notified task has a priority above the currently
+                         * executing task so a yield is required. */
+                        if( pxHigherPriorityTaskWoken != NULL )
                         {
-                            mtCOVERAGE_TEST_MARKER();
+                            *pxHigherPriorityTaskWoken = pdTRUE;
                         }
 
-                        prvAddTaskToReadyList( pxTCB );
+                        /* Mark that a yield is pending in case the user is not
+                         * using the "xHigherPriorityTaskWoken" parameter in an ISR
+                         * safe FreeRTOS function. */
+                        xYieldPending = pdTRUE;
+                        portPEND_YIELD_FROM_ISR();
                     }
                     else
                     {
                         mtCOVERAGE_TEST_MARKER();
                     }
                 }
-                else
+                #elif ( configUSE_PREEMPTION == 1 )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    prvYieldForTask( pxTCB );
+
+                    /* Only this core's yield is left to the caller - other
+                     * cores have already been interrupted. */
+                    if( ( xYieldPendings[ portGET_CORE_ID() ] != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+                    {
+                        *pxHigherPriorityTaskWoken = pdTRUE;
+                    }
+                }
+                #else
+                {
+                    /* Without preemption a task that is made ready never
+                     * requires a yield. */
+                    ( void ) pxHigherPriorityTaskWoken;
                 }
+                #endif /* if ( configNUMBER_OF_CORES == 1 ) */
             }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
         }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
 
-    void vTaskEnterCritical( void )
+    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
+                                             UBaseType_t uxIndexToClear )
     {
-        portDISABLE_INTERRUPTS();
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
 
-        if( xSchedulerRunning != pdFALSE )
-        {
-            ( pxCurrentTCB->uxCriticalNesting )++;
+        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-            /* This is not the interrupt safe version of the enter critical
-             * function so  assert() if it is being called from an interrupt
-             * context.  Only API functions that end in "FromISR" can be used in an
-             * interrupt.  Only assert if the critical nesting count is 1 to
-             * protect against recursive calls if the assert function also uses a
-             * critical section. */
-            if( pxCurrentTCB->uxCriticalNesting == 1 )
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        taskENTER_CRITICAL();
+        {
+            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
             {
-                portASSERT_IF_IN_ISR();
+                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
+                xReturn = pdPASS;
+            }
+            else
+            {
+                xReturn = pdFAIL;
             }
         }
-        else
+        taskEXIT_CRITICAL();
+
+        return xReturn;
+    }
+
+#endif /* configUSE_TASK_NOTIFICATIONS */
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+
+    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
+                                            UBaseType_t uxIndexToClear,
+                                            uint32_t ulBitsToClear )
+    {
+        TCB_t * pxTCB;
+        uint32_t ulReturn;
+
+        /* If null is passed in here then it is the calling task that is having
+         * its notification state cleared. */
+        pxTCB = prvGetTCBFromHandle( xTask );
+
+        taskENTER_CRITICAL();
         {
-            mtCOVERAGE_TEST_MARKER();
+            /* Return the notification as it was before the bits were cleared,
+             * then clear the bit mask. */
+            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
+            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
         }
+        taskEXIT_CRITICAL();
+
+        return ulReturn;
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configUSE_TASK_NOTIFICATIONS */
 /*-----------------------------------------------------------*/
 
-#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+#if ( configUSE_TASK_MAILBOXES == 1 )
 
-    void vTaskExitCritical( void )
+    BaseType_t xTaskGenericMailboxSend( TaskHandle_t xTaskToNotify,
+                                        UBaseType_t uxIndexToNotify,
+                                        void * pvMessage,
+                                        BaseType_t xOverwrite )
     {
-        if( xSchedulerRunning != pdFALSE )
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
+
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+
+        pxTCB = xTaskToNotify;
+
+        taskENTER_CRITICAL();
         {
-            if( pxCurrentTCB->uxCriticalNesting > 0U )
+            if( ( xOverwrite == pdFALSE ) &&
+                ( pxTCB->ucNotifyState[ uxIndexToNotify ] == taskNOTIFICATION_RECEIVED ) )
             {
-                ( pxCurrentTCB->uxCriticalNesting )--;
-
-                if( pxCurrentTCB->uxCriticalNesting == 0U )
-                {
-                    portENABLE_INTERRUPTS();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                /* The previous message has not been received yet. */
+                xReturn = pdFAIL;
             }
             else
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* Store the message before the notification is given so the
+                 * receiver can never observe the notification without the
+                 * message.  The critical section nests, so the message and the
+                 * notification state are updated as one operation. */
+                pxTCB->pvMailbox[ uxIndexToNotify ] = pvMessage;
+                xReturn = xTaskGenericNotify( xTaskToNotify, uxIndexToNotify, 0, eNoAction, NULL );
             }
         }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
-        }
+        taskEXIT_CRITICAL();
+
+        return xReturn;
     }
 
-#endif /* portCRITICAL_NESTING_IN_TCB */
+#endif /* configUSE_TASK_MAILBOXES */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 )
+#if ( configUSE_TASK_MAILBOXES == 1 )
 
-    static char * prvWriteNameToBuffer( char * pcBuffer,
-                                        const char * pcTaskName )
+    BaseType_t xTaskGenericMailboxSendFromISR( TaskHandle_t xTaskToNotify,
+                                               UBaseType_t uxIndexToNotify,
+                                               void * pvMessage,
+                                               BaseType_t xOverwrite,
+                                               BaseType_t * pxHigherPriorityTaskWoken )
     {
-        size_t x;
+        TCB_t * pxTCB;
+        BaseType_t xReturn;
+        UBaseType_t uxSavedInterruptStatus;
 
-        /* Start by copying the entire string. */
-        strcpy( pcBuffer, pcTaskName );
+        configASSERT( xTaskToNotify );
+        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-        /* Pad the end of the string with spaces to ensure columns line up when
-         * printed out. */
-        for( x = strlen( pcBuffer ); x < ( size_t ) ( configMAX_TASK_NAME_LEN - 1 ); x++ )
+        pxTCB = xTaskToNotify;
+
+        uxSavedInterruptStatus = ( UBaseType_t ) taskENTER_CRITICAL_FROM_ISR();
         {
-            pcBuffer[ x ] = ' ';
+            if( ( xOverwrite == pdFALSE ) &&
+                ( pxTCB->ucNotifyState[ uxIndexToNotify ] == taskNOTIFICATION_RECEIVED ) )
+            {
+                xReturn = pdFAIL;
+            }
+            else
+            {
+                pxTCB->pvMailbox[ uxIndexToNotify ] = pvMessage;
+                xReturn = xTaskGenericNotifyFromISR( xTaskToNotify, uxIndexToNotify, 0, eNoAction, NULL, pxHigherPriorityTaskWoken );
+            }
         }
+        taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
-        /* Terminate. */
-        pcBuffer[ x ] = ( char ) 0x00;
-
-        /* Return the new end of string. */
-        return &( pcBuffer[ x ] );
+        return xReturn;
     }
 
-#endif /* ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) */
+#endif /* configUSE_TASK_MAILBOXES */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
+#if ( configUSE_TASK_MAILBOXES == 1 )
 
-    void vTaskList( char * pcWriteBuffer )
+    BaseType_t xTaskGenericMailboxReceive( UBaseType_t uxIndexToWaitOn,
+                                           void ** ppvMessage,
+                                           TickType_t xTicksToWait )
     {
-        TaskStatus_t * pxTaskStatusArray;
-        UBaseType_t uxArraySize, x;
-        char cStatus;
-
-        /*
-         * PLEASE NOTE:
-         *
-         * This function is provided for convenience only, and is used by many
-         * of the demo applications.  Do not consider it to be part of the
-         * scheduler.
-         *
-         * vTaskList() calls uxTaskGetSystemState(), then formats part of the
-         * uxTaskGetSystemState() output into a human readable table that
-         * displays task: names, states, priority, stack usage and task number.
-         * Stack usage specified as the number of unused StackType_t words stack can hold
-         * on top of stack - not the number of bytes.
-         *
-         * vTaskList() has a dependency on the sprintf() C library function that
-         * might bloat the code size, use a lot of stack, and provide different
-         * results on different platforms.  An alternative, tiny, third party,
-         * and limited functionality implementation of sprintf() is provided in
-         * many of the FreeRTOS/Demo sub-directories in a file called
-         * printf-stdarg.c (note printf-stdarg.c does not provide a full
-         * snprintf() implementation!).
-         *
-         * It is recommended that production systems call uxTaskGetSystemState()
-         * directly to get access to raw stats data, rather than indirectly
-         * through a call to vTaskList().
-         */
+        BaseType_t xReturn;
 
+        configASSERT( ppvMessage );
+        configASSERT( uxIndexToWaitOn < configTASK_NOTIFICATION_ARRAY_ENTRIES );
 
-        /* Make sure the write buffer does not contain a string. */
-        *pcWriteBuffer = ( char ) 0x00;
+        taskENTER_CRITICAL();
+        {
+            /* Only block if a message is not already pending. */
+            if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
+            {
+                pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskWAITING_NOTIFICATION;
 
-        /* Take a snapshot of the number of tasks in case it changes while this
-         * function is executing. */
-        uxArraySize = uxCurrentNumberOfTasks;
+                if( xTicksToWait > ( TickType_t ) 0 )
+                {
+                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
+                    traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWaitOn );
 
-        /* Allocate an array index for each task.  NOTE!  if
-         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-         * equate to NULL. */
-        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+                    /* All ports are written to allow a yield in a critical
+                     * section (some will yield immediately, others wait until the
+                     * critical section exits) - but it is not something that
+                     * application code should ever do. */
+                    portYIELD_WITHIN_API();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
 
-        if( pxTaskStatusArray != NULL )
+        taskENTER_CRITICAL();
         {
-            /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, NULL );
+            traceTASK_NOTIFY_WAIT( uxIndexToWaitOn );
 
-            /* Create a human readable table from the binary data. */
-            for( x = 0; x < uxArraySize; x++ )
+            if( pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] != taskNOTIFICATION_RECEIVED )
             {
-                switch( pxTaskStatusArray[ x ].eCurrentState )
-                {
-                    case eRunning:
-                        cStatus = tskRUNNING_CHAR;
-                        break;
+                /* Timed out without a message being posted. */
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                /* The message is read in the same critical section that
+                 * consumes the notification, so a message posted with
+                 * overwrite after this point is left pending. */
+                *ppvMessage = pxCurrentTCB->pvMailbox[ uxIndexToWaitOn ];
+                pxCurrentTCB->pvMailbox[ uxIndexToWaitOn ] = NULL;
+                xReturn = pdTRUE;
+            }
 
-                    case eReady:
-                        cStatus = tskREADY_CHAR;
-                        break;
+            pxCurrentTCB->ucNotifyState[ uxIndexToWaitOn ] = taskNOT_WAITING_NOTIFICATION;
+        }
+        taskEXIT_CRITICAL();
 
-                    case eBlocked:
-                        cStatus = tskBLOCKED_CHAR;
-                        break;
+        return xReturn;
+    }
 
-                    case eSuspended:
-                        cStatus = tskSUSPENDED_CHAR;
-                        break;
+#endif /* configUSE_TASK_MAILBOXES */
+/*-----------------------------------------------------------*/
 
-                    case eDeleted:
-                        cStatus = tskDELETED_CHAR;
-                        break;
+#if ( configUSE_WAIT_ON_ADDRESS == 1 )
 
-                    case eInvalid: /* Fall through. */
-                    default:       /* Should not get here, but it is included
-                                    * to prevent static checking errors. */
-                        cStatus = ( char ) 0x00;
-                        break;
-                }
+    BaseType_t xTaskWaitOnAddress( const volatile uint32_t * pulAddress,
+                                   uint32_t ulExpectedValue,
+                                   TickType_t xTicksToWait )
+    {
+        BaseType_t xReturn = pdFALSE;
+        BaseType_t xBlocked = pdFALSE;
 
-                /* Write the task name to the string, padding with spaces so it
-                 * can be printed in tabular form more easily. */
-                pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+        configASSERT( pulAddress );
+
+        taskENTER_CRITICAL();
+        {
+            /* The value is compared in the same critical section that places
+             * the task in the list, so a vTaskWakeAddress() that follows a
+             * change to the value cannot be missed. */
+            if( ( *pulAddress == ulExpectedValue ) && ( xTicksToWait > ( TickType_t ) 0 ) )
+            {
+                /* Cannot block while the scheduler is suspended. */
+                #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+                {
+                    configASSERT( xTaskGetSchedulerState() != taskSCHEDULER_SUSPENDED );
+                }
+                #endif
 
-                /* Write the rest of the string. */
-                sprintf( pcWriteBuffer, "\t%c\t%u\t%u\t%u\r\n", cStatus, ( unsigned int ) pxTaskStatusArray[ x ].uxCurrentPriority, ( unsigned int ) pxTaskStatusArray[ x ].usStackHighWaterMark, ( unsigned int ) pxTaskStatusArray[ x ].xTaskNumber ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                pcWriteBuffer += strlen( pcWriteBuffer );                                                                                                                                                                                                /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                pxCurrentTCB->pulWaitAddress = pulAddress;
+                vTaskPlaceOnEventList( taskWAIT_ON_ADDRESS_LIST( pulAddress ), xTicksToWait );
+                xBlocked = pdTRUE;
+                traceTASK_WAIT_ON_ADDRESS_BLOCK( pulAddress );
+
+                /* All ports are written to allow a yield in a critical
+                 * section (some will yield immediately, others wait until the
+                 * critical section exits) - but it is not something that
+                 * application code should ever do. */
+                portYIELD_WITHIN_API();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
+        }
+        taskEXIT_CRITICAL();
 
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
+        if( xBlocked != pdFALSE )
+        {
+            taskENTER_CRITICAL();
+            {
+                /* vTaskWakeAddress() clears the address of each task it wakes,
+                 * so it is still set if the wait timed out or was aborted. */
+                if( pxCurrentTCB->pulWaitAddress == NULL )
+                {
+                    xReturn = pdTRUE;
+                }
+                else
+                {
+                    pxCurrentTCB->pulWaitAddress = NULL;
+                }
+            }
+            taskEXIT_CRITICAL();
         }
         else
         {
             mtCOVERAGE_TEST_MARKER();
         }
+
+        return xReturn;
     }
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
-/*----------------------------------------------------------*/
+#endif /* configUSE_WAIT_ON_ADDRESS */
+/*-----------------------------------------------------------*/
 
-#if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) && ( configUSE_TRACE_FACILITY == 1 ) )
+#if ( configUSE_WAIT_ON_ADDRESS == 1 )
 
-    void vTaskGetRunTimeStats( char * pcWriteBuffer )
+    void vTaskWakeAddress( const volatile uint32_t * pulAddress,
+                           UBaseType_t uxTasksToWake )
     {
-        TaskStatus_t * pxTaskStatusArray;
-        UBaseType_t uxArraySize, x;
-        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
-
-        /*
-         * PLEASE NOTE:
-         *
-         * This function is provided for convenience only, and is used by many
-         * of the demo applications.  Do not consider it to be part of the
-         * scheduler.
-         *
-         * vTaskGetRunTimeStats() calls uxTaskGetSystemState(), then formats part
-         * of the uxTaskGetSystemState() output into a human readable table that
-         * displays the amount of time each task has spent in the Running state
-         * in both absolute and percentage terms.
-         *
-         * vTaskGetRunTimeStats() has a dependency on the sprintf() C library
-         * function that might bloat the code size, use a lot of stack, and
-         * provide different results on different platforms.  An alternative,
-         * tiny, third party, and limited functionality implementation of
-         * sprintf() is provided in many of the FreeRTOS/Demo sub-directories in
-         * a file called printf-stdarg.c (note printf-stdarg.c does not provide
-         * a full snprintf() implementation!).
-         *
-         * It is recommended that production systems call uxTaskGetSystemState()
-         * directly to get access to raw stats data, rather than indirectly
-         * through a call to vTaskGetRunTimeStats().
-         */
-
-        /* Make sure the write buffer does not contain a string. */
-        *pcWriteBuffer = ( char ) 0x00;
+        List_t * pxList;
+        ListItem_t * pxItem;
+        TCB_t * pxTCB;
+        UBaseType_t uxItems;
+        UBaseType_t uxTasksWoken = ( UBaseType_t ) 0U;
 
-        /* Take a snapshot of the number of tasks in case it changes while this
-         * function is executing. */
-        uxArraySize = uxCurrentNumberOfTasks;
+        #if ( configNUMBER_OF_CORES == 1 )
+            BaseType_t xYieldRequired = pdFALSE;
+        #endif
 
-        /* Allocate an array index for each task.  NOTE!  If
-         * configSUPPORT_DYNAMIC_ALLOCATION is set to 0 then pvPortMalloc() will
-         * equate to NULL. */
-        pxTaskStatusArray = pvPortMalloc( uxCurrentNumberOfTasks * sizeof( TaskStatus_t ) ); /*lint !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack and this allocation allocates a struct that has the alignment requirements of a pointer. */
+        configASSERT( pulAddress );
 
-        if( pxTaskStatusArray != NULL )
+        taskENTER_CRITICAL();
         {
-            /* Generate the (binary) data. */
-            uxArraySize = uxTaskGetSystemState( pxTaskStatusArray, uxArraySize, &ulTotalTime );
+            pxList = taskWAIT_ON_ADDRESS_LIST( pulAddress );
+            pxItem = listGET_HEAD_ENTRY( pxList );
 
-            /* For percentage calculations. */
-            ulTotalTime /= 100UL;
-
-            /* Avoid divide by zero errors. */
-            if( ulTotalTime > 0UL )
+            /* Other addresses can hash to the same list, so each waiting task
+             * is checked.  The list is in priority order, so the highest
+             * priority tasks waiting on the address are the ones woken.  The
+             * list length is used as the loop bound, so the list is never
+             * followed before it is initialised by the first task created. */
+            for( uxItems = listCURRENT_LIST_LENGTH( pxList ); ( uxItems > ( UBaseType_t ) 0U ) && ( uxTasksWoken < uxTasksToWake ); uxItems-- )
             {
-                /* Create a human readable table from the binary data. */
-                for( x = 0; x < uxArraySize; x++ )
-                {
-                    /* What percentage of the total run time has the task used?
-                     * This will always be rounded down to the nearest integer.
-                     * ulTotalRunTime has already been divided by 100. */
-                    ulStatsAsPercentage = pxTaskStatusArray[ x ].ulRunTimeCounter / ulTotalTime;
+                pxTCB = listGET_LIST_ITEM_OWNER( pxItem ); /*lint !e9079 void * is used as this macro is used with timers too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                pxItem = listGET_NEXT( pxItem );
 
-                    /* Write the task name to the string, padding with
-                     * spaces so it can be printed in tabular form more
-                     * easily. */
-                    pcWriteBuffer = prvWriteNameToBuffer( pcWriteBuffer, pxTaskStatusArray[ x ].pcTaskName );
+                if( pxTCB->pulWaitAddress == pulAddress )
+                {
+                    pxTCB->pulWaitAddress = NULL;
+                    listREMOVE_ITEM( &( pxTCB->xEventListItem ) );
 
-                    if( ulStatsAsPercentage > 0UL )
+                    if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
                     {
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
-                        {
-                            sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
-                        }
-                        #else
-                        {
-                            /* sizeof( int ) == sizeof( long ) so a smaller
-                             * printf() library can be used. */
-                            sprintf( pcWriteBuffer, "\t%u\t\t%u%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned int ) ulStatsAsPercentage ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
-                        }
-                        #endif
+                        listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
+                        prvAddTaskToReadyList( pxTCB );
                     }
                     else
                     {
-                        /* If the percentage is zero here then the task has
-                         * consumed less than 1% of the total run time. */
-                        #ifdef portLU_PRINTF_SPECIFIER_REQUIRED
+                        /* The delayed and ready lists cannot be accessed, so
+                         * hold this task pending until the scheduler is
+                         * resumed. */
+                        listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
+                    }
+
+                    uxTasksWoken++;
+
+                    #if ( configNUMBER_OF_CORES == 1 )
+                    {
+                        if( taskTASK_CAN_PREEMPT( pxTCB, pxCurrentTCB ) != pdFALSE )
                         {
-                            sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+                            xYieldRequired = pdTRUE;
                         }
-                        #else
+                        else
                         {
-                            /* sizeof( int ) == sizeof( long ) so a smaller
-                             * printf() library can be used. */
-                            sprintf( pcWriteBuffer, "\t%u\t\t<1%%\r\n", ( unsigned int ) pxTaskStatusArray[ x ].ulRunTimeCounter ); /*lint !e586 sprintf() allowed as this is compiled with many compilers and this is a utility function only - not part of the core kernel implementation. */
+                            mtCOVERAGE_TEST_MARKER();
                         }
-                        #endif
                     }
-
-                    pcWriteBuffer += strlen( pcWriteBuffer ); /*lint !e9016 Pointer arithmetic ok on char pointers especially as in this case where it best denotes the intent of the code. */
+                    #elif ( configUSE_PREEMPTION == 1 )
+                    {
+                        /* A yield on this core is performed when the critical
+                         * section is exited. */
+                        prvYieldForTask( pxTCB );
+                    }
+                    #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
                 }
             }
-            else
+
+            traceTASK_WAKE_ADDRESS( pulAddress, uxTasksWoken );
+
+            #if ( configUSE_TICKLESS_IDLE != 0 )
             {
-                mtCOVERAGE_TEST_MARKER();
+                /* See xTaskGenericNotify() - recalculated once for all the
+                 * woken tasks rather than once per task. */
+                if( uxTasksWoken > ( UBaseType_t ) 0U )
+                {
+                    prvResetNextTaskUnblockTime();
+                }
             }
+            #endif
 
-            /* Free the array again.  NOTE!  If configSUPPORT_DYNAMIC_ALLOCATION
-             * is 0 then vPortFree() will be #defined to nothing. */
-            vPortFree( pxTaskStatusArray );
-        }
-        else
-        {
-            mtCOVERAGE_TEST_MARKER();
+            #if ( configNUMBER_OF_CORES == 1 )
+            {
+                if( xYieldRequired != pdFALSE )
+                {
+                    taskYIELD_IF_USING_PREEMPTION();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
         }
+        taskEXIT_CRITICAL();
     }
 
-#endif /* ( ( configGENERATE_RUN_TIME_STATS == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) ) */
+#endif /* configUSE_WAIT_ON_ADDRESS */
 /*-----------------------------------------------------------*/
 
-TickType_t uxTaskResetEventItemValue( void )
-{
-    TickType_t uxReturn;
-
-    uxReturn = listGET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ) );
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-    /* Reset the event list item to its normal value - so it can be used with
-     * queues and semaphores. */
-    listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xEventListItem ), ( ( TickType_t ) configMAX_PRIORITIES - ( TickType_t ) pxCurrentTCB->uxPriority ) ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter( const TaskHandle_t xTask )
+    {
+        return xTask->ulRunTimeCounter;
+    }
 
-    return uxReturn;
-}
+#endif
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_MUTEXES == 1 )
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-    TaskHandle_t pvTaskIncrementMutexHeldCount( void )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimePercent( const TaskHandle_t xTask )
     {
-        /* If xSemaphoreCreateMutex() is called before any tasks have been created
-         * then pxCurrentTCB will be NULL. */
-        if( pxCurrentTCB != NULL )
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+
+        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+
+        /* For percentage calculations. */
+        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+
+        /* Avoid divide by zero errors. */
+        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
         {
-            ( pxCurrentTCB->uxMutexesHeld )++;
+            ulReturn = xTask->ulRunTimeCounter / ulTotalTime;
+        }
+        else
+        {
+            ulReturn = 0;
         }
 
-        return pxCurrentTCB;
+        return ulReturn;
     }
 
-#endif /* configUSE_MUTEXES */
+#endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
 
-    uint32_t ulTaskGenericNotifyTake( UBaseType_t uxIndexToWait,
-                                      BaseType_t xClearCountOnExit,
-                                      TickType_t xTicksToWait )
+    static void prvUpdateRunTimeWindows( TCB_t * pxTCB )
     {
-        uint32_t ulReturn;
-
-        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        UBaseType_t uxWindow;
+        uint32_t ulTaskWindow, ulCurrentWindow;
 
-        taskENTER_CRITICAL();
+        if( pxTCB->ulRunTimeWindowPeriod != ulRunTimeWindowPeriod )
         {
-            /* Only block if the notification count is not already non-zero. */
-            if( pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] == 0UL )
+            for( uxWindow = 0U; uxWindow < ( UBaseType_t ) tskRUN_TIME_WINDOWS; uxWindow++ )
             {
-                /* Mark this task as waiting for a notification. */
-                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
-
-                if( xTicksToWait > ( TickType_t ) 0 )
-                {
-                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-                    traceTASK_NOTIFY_TAKE_BLOCK( uxIndexToWait );
+                ulTaskWindow = pxTCB->ulRunTimeWindowPeriod / ulRunTimeWindowPeriods[ uxWindow ];
+                ulCurrentWindow = ulRunTimeWindowPeriod / ulRunTimeWindowPeriods[ uxWindow ];
 
-                    /* All ports are written to allow a yield in a critical
-                     * section (some will yield immediately, others wait until the
-                     * critical section exits) - but it is not something that
-                     * application code should ever do. */
-                    portYIELD_WITHIN_API();
-                }
-                else
+                if( ulTaskWindow != ulCurrentWindow )
                 {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
-            }
-        }
-        taskEXIT_CRITICAL();
-
-        taskENTER_CRITICAL();
-        {
-            traceTASK_NOTIFY_TAKE( uxIndexToWait );
-            ulReturn = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+                    /* The window the accumulator belongs to has ended.  It is
+                     * only the most recently completed window if no whole
+                     * window passed in which the task did not run at all. */
+                    if( ( ulTaskWindow + 1UL ) == ulCurrentWindow )
+                    {
+                        pxTCB->ulRunTimeWindowCompleted[ uxWindow ] = pxTCB->ulRunTimeWindowCurrent[ uxWindow ];
+                    }
+                    else
+                    {
+                        pxTCB->ulRunTimeWindowCompleted[ uxWindow ] = 0U;
+                    }
 
-            if( ulReturn != 0UL )
-            {
-                if( xClearCountOnExit != pdFALSE )
-                {
-                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = 0UL;
+                    pxTCB->ulRunTimeWindowCurrent[ uxWindow ] = 0U;
                 }
                 else
-                {
-                    pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] = ulReturn - ( uint32_t ) 1;
-                }
-            }
-            else
-            {
-                mtCOVERAGE_TEST_MARKER();
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
 
-            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
+            pxTCB->ulRunTimeWindowPeriod = ulRunTimeWindowPeriod;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        taskEXIT_CRITICAL();
-
-        return ulReturn;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_WINDOWED_RUN_TIME_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
 
-    BaseType_t xTaskGenericNotifyWait( UBaseType_t uxIndexToWait,
-                                       uint32_t ulBitsToClearOnEntry,
-                                       uint32_t ulBitsToClearOnExit,
-                                       uint32_t * pulNotificationValue,
-                                       TickType_t xTicksToWait )
+    static void prvAddWindowedRunTime( TCB_t * pxTCB,
+                                       configRUN_TIME_COUNTER_TYPE ulRunTime )
     {
-        BaseType_t xReturn;
+        UBaseType_t uxWindow;
 
-        configASSERT( uxIndexToWait < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        prvUpdateRunTimeWindows( pxTCB );
 
-        taskENTER_CRITICAL();
+        for( uxWindow = 0U; uxWindow < ( UBaseType_t ) tskRUN_TIME_WINDOWS; uxWindow++ )
         {
-            /* Only block if a notification is not already pending. */
-            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
-            {
-                /* Clear bits in the task's notification value as bits may get
-                 * set  by the notifying task or interrupt.  This can be used to
-                 * clear the value to zero. */
-                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnEntry;
+            pxTCB->ulRunTimeWindowCurrent[ uxWindow ] += ulRunTime;
+        }
+    }
 
-                /* Mark this task as waiting for a notification. */
-                pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskWAITING_NOTIFICATION;
+#endif /* configUSE_WINDOWED_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
 
-                if( xTicksToWait > ( TickType_t ) 0 )
-                {
-                    prvAddCurrentTaskToDelayedList( xTicksToWait, pdTRUE );
-                    traceTASK_NOTIFY_WAIT_BLOCK( uxIndexToWait );
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
 
-                    /* All ports are written to allow a yield in a critical
-                     * section (some will yield immediately, others wait until the
-                     * critical section exits) - but it is not something that
-                     * application code should ever do. */
-                    portYIELD_WITHIN_API();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+    static void prvCompleteRunTimeWindowPeriod( void )
+    {
+        configRUN_TIME_COUNTER_TYPE ulNow;
+        UBaseType_t uxWindow;
+
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+        #else
+            ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
+
+        /* A task can run for many periods without being switched out, so
+         * charge the running tasks up to the end of the period before it is
+         * completed. */
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            if( ulNow > ulTaskSwitchedInTime )
+            {
+                pxCurrentTCB->ulRunTimeCounter += ( ulNow - ulTaskSwitchedInTime );
+                prvAddWindowedRunTime( pxCurrentTCB, ulNow - ulTaskSwitchedInTime );
+                ulTaskSwitchedInTime = ulNow;
             }
             else
             {
                 mtCOVERAGE_TEST_MARKER();
             }
         }
-        taskEXIT_CRITICAL();
-
-        taskENTER_CRITICAL();
+        #else /* if ( configNUMBER_OF_CORES == 1 ) */
         {
-            traceTASK_NOTIFY_WAIT( uxIndexToWait );
+            BaseType_t xCoreID;
 
-            if( pulNotificationValue != NULL )
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
             {
-                /* Output the current notification value, which may or may not
-                 * have changed. */
-                *pulNotificationValue = pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ];
+                if( ulNow > ulTaskSwitchedInTime[ xCoreID ] )
+                {
+                    pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulNow - ulTaskSwitchedInTime[ xCoreID ] );
+                    taskRECORD_CORE_IDLE_TIME( xCoreID, ulNow - ulTaskSwitchedInTime[ xCoreID ] );
+                    prvAddWindowedRunTime( pxCurrentTCBs[ xCoreID ], ulNow - ulTaskSwitchedInTime[ xCoreID ] );
+                    ulTaskSwitchedInTime[ xCoreID ] = ulNow;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+        }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
-            /* If ucNotifyValue is set then either the task never entered the
-             * blocked state (because a notification was already pending) or the
-             * task unblocked because of a notification.  Otherwise the task
-             * unblocked because of a timeout. */
-            if( pxCurrentTCB->ucNotifyState[ uxIndexToWait ] != taskNOTIFICATION_RECEIVED )
+        ulRunTimeWindowPeriod++;
+
+        for( uxWindow = 0U; uxWindow < ( UBaseType_t ) tskRUN_TIME_WINDOWS; uxWindow++ )
+        {
+            if( ( ulRunTimeWindowPeriod % ulRunTimeWindowPeriods[ uxWindow ] ) == 0UL )
             {
-                /* A notification was not received. */
-                xReturn = pdFALSE;
+                /* Unsigned arithmetic gives the right answer if the counter
+                 * wrapped once during the window. */
+                ulRunTimeWindowDuration[ uxWindow ] = ulNow - ulRunTimeWindowStart[ uxWindow ];
+                ulRunTimeWindowStart[ uxWindow ] = ulNow;
             }
             else
             {
-                /* A notification was already pending or a notification was
-                 * received while the task was waiting. */
-                pxCurrentTCB->ulNotifiedValue[ uxIndexToWait ] &= ~ulBitsToClearOnExit;
-                xReturn = pdTRUE;
+                mtCOVERAGE_TEST_MARKER();
             }
-
-            pxCurrentTCB->ucNotifyState[ uxIndexToWait ] = taskNOT_WAITING_NOTIFICATION;
         }
-        taskEXIT_CRITICAL();
-
-        return xReturn;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_WINDOWED_RUN_TIME_STATS */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
 
-    BaseType_t xTaskGenericNotify( TaskHandle_t xTaskToNotify,
-                                   UBaseType_t uxIndexToNotify,
-                                   uint32_t ulValue,
-                                   eNotifyAction eAction,
-                                   uint32_t * pulPreviousNotificationValue )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetWindowedRunTimeCounter( const TaskHandle_t xTask,
+                                                                 eRunTimeWindow eWindow )
     {
         TCB_t * pxTCB;
-        BaseType_t xReturn = pdPASS;
-        uint8_t ucOriginalNotifyState;
+        configRUN_TIME_COUNTER_TYPE ulReturn;
 
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
-        configASSERT( xTaskToNotify );
-        pxTCB = xTaskToNotify;
+        configASSERT( ( UBaseType_t ) eWindow < ( UBaseType_t ) tskRUN_TIME_WINDOWS );
 
         taskENTER_CRITICAL();
         {
-            if( pulPreviousNotificationValue != NULL )
-            {
-                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
-            }
+            pxTCB = prvGetTCBFromHandle( xTask );
+            prvUpdateRunTimeWindows( pxTCB );
+            ulReturn = pxTCB->ulRunTimeWindowCompleted[ eWindow ];
+        }
+        taskEXIT_CRITICAL();
 
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
+        return ulReturn;
+    }
 
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+#endif /* configUSE_WINDOWED_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
 
-            switch( eAction )
-            {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
 
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetWindowedRunTimePercent( const TaskHandle_t xTask,
+                                                                 eRunTimeWindow eWindow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
 
-                case eSetValueWithOverwrite:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
+        ulReturn = ulTaskGetWindowedRunTimeCounter( xTask, eWindow );
 
-                case eSetValueWithoutOverwrite:
+        taskENTER_CRITICAL();
+        {
+            ulTotalTime = ulRunTimeWindowDuration[ eWindow ];
+        }
+        taskEXIT_CRITICAL();
 
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-                    {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    }
-                    else
-                    {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
-                    }
+        /* For percentage calculations. */
+        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
 
-                    break;
+        /* Avoid divide by zero errors, which occur until the window has
+         * completed once. */
+        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        {
+            ulReturn /= ulTotalTime;
+        }
+        else
+        {
+            ulReturn = 0;
+        }
 
-                case eNoAction:
+        return ulReturn;
+    }
 
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
+#endif /* configUSE_WINDOWED_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
 
-                default:
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            return ulTaskGetRunTimeCounter( xIdleTaskHandle );
+        }
+        #else
+        {
+            configRUN_TIME_COUNTER_TYPE ulReturn = 0;
+            BaseType_t xCoreID;
 
-                    break;
+            /* The idle time is the time spent in the idle tasks of all cores. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                ulReturn += ulTaskGetRunTimeCounter( xIdleTaskHandles[ xCoreID ] );
             }
 
-            traceTASK_NOTIFY( uxIndexToNotify );
+            return ulReturn;
+        }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+    }
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
-            {
-                listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                prvAddTaskToReadyList( pxTCB );
+#endif
+/*-----------------------------------------------------------*/
 
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
+#if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-                #if ( configUSE_TICKLESS_IDLE != 0 )
-                {
-                    /* If a task is blocked waiting for a notification then
-                     * xNextTaskUnblockTime might be set to the blocked task's time
-                     * out time.  If the task is unblocked for a reason other than
-                     * a timeout xNextTaskUnblockTime is normally left unchanged,
-                     * because it will automatically get reset to a new value when
-                     * the tick count equals xNextTaskUnblockTime.  However if
-                     * tickless idling is used it might be more important to enter
-                     * sleep mode at the earliest possible time - so reset
-                     * xNextTaskUnblockTime here to ensure it is updated at the
-                     * earliest possible time. */
-                    prvResetNextTaskUnblockTime();
-                }
-                #endif
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            return ulTaskGetRunTimePercent( xIdleTaskHandle );
+        }
+        #else
+        {
+            configRUN_TIME_COUNTER_TYPE ulReturn = 0;
+            BaseType_t xCoreID;
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    taskYIELD_IF_USING_PREEMPTION();
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
-            }
-            else
+            /* Average the idle time of all cores so 100 means every core was
+             * idle for the whole time. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
             {
-                mtCOVERAGE_TEST_MARKER();
+                ulReturn += ulTaskGetRunTimePercent( xIdleTaskHandles[ xCoreID ] );
             }
-        }
-        taskEXIT_CRITICAL();
 
-        return xReturn;
+            return ulReturn / ( configRUN_TIME_COUNTER_TYPE ) configNUMBER_OF_CORES;
+        }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_CORE_RUN_TIME_STATS == 1 )
 
-    BaseType_t xTaskGenericNotifyFromISR( TaskHandle_t xTaskToNotify,
-                                          UBaseType_t uxIndexToNotify,
-                                          uint32_t ulValue,
-                                          eNotifyAction eAction,
-                                          uint32_t * pulPreviousNotificationValue,
-                                          BaseType_t * pxHigherPriorityTaskWoken )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounterForCore( BaseType_t xCoreID )
     {
-        TCB_t * pxTCB;
-        uint8_t ucOriginalNotifyState;
-        BaseType_t xReturn = pdPASS;
-        UBaseType_t uxSavedInterruptStatus;
+        configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
 
-        configASSERT( xTaskToNotify );
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        return ulCoreIdleRunTime[ xCoreID ];
+    }
+/*-----------------------------------------------------------*/
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercentForCore( BaseType_t xCoreID )
+    {
+        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
+
+        configASSERT( taskVALID_CORE_ID( xCoreID ) == pdTRUE );
+
+        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+
+        /* For percentage calculations. */
+        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+
+        /* Avoid divide by zero errors. */
+        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        {
+            ulReturn = ulCoreIdleRunTime[ xCoreID ] / ulTotalTime;
+        }
+        else
+        {
+            ulReturn = 0;
+        }
+
+        return ulReturn;
+    }
 
-        pxTCB = xTaskToNotify;
+#endif /* configUSE_CORE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
+
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleWindowedRunTimeCounter( eRunTimeWindow eWindow )
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
         {
-            if( pulPreviousNotificationValue != NULL )
+            return ulTaskGetWindowedRunTimeCounter( xIdleTaskHandle, eWindow );
+        }
+        #else
+        {
+            configRUN_TIME_COUNTER_TYPE ulReturn = 0;
+            BaseType_t xCoreID;
+
+            /* The idle time is the time spent in the idle tasks of all cores. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
             {
-                *pulPreviousNotificationValue = pxTCB->ulNotifiedValue[ uxIndexToNotify ];
+                ulReturn += ulTaskGetWindowedRunTimeCounter( xIdleTaskHandles[ xCoreID ], eWindow );
             }
 
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
+            return ulReturn;
+        }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+    }
 
-            switch( eAction )
-            {
-                case eSetBits:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] |= ulValue;
-                    break;
+#endif /* configUSE_WINDOWED_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
 
-                case eIncrement:
-                    ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-                    break;
+#if ( configUSE_WINDOWED_RUN_TIME_STATS == 1 )
 
-                case eSetValueWithOverwrite:
-                    pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    break;
+    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleWindowedRunTimePercent( eRunTimeWindow eWindow )
+    {
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            return ulTaskGetWindowedRunTimePercent( xIdleTaskHandle, eWindow );
+        }
+        #else
+        {
+            configRUN_TIME_COUNTER_TYPE ulReturn = 0;
+            BaseType_t xCoreID;
 
-                case eSetValueWithoutOverwrite:
+            /* Average the idle time of all cores so 100 means every core was
+             * idle for the whole window. */
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+            {
+                ulReturn += ulTaskGetWindowedRunTimePercent( xIdleTaskHandles[ xCoreID ], eWindow );
+            }
 
-                    if( ucOriginalNotifyState != taskNOTIFICATION_RECEIVED )
-                    {
-                        pxTCB->ulNotifiedValue[ uxIndexToNotify ] = ulValue;
-                    }
-                    else
-                    {
-                        /* The value could not be written to the task. */
-                        xReturn = pdFAIL;
-                    }
+            return ulReturn / ( configRUN_TIME_COUNTER_TYPE ) configNUMBER_OF_CORES;
+        }
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
+    }
 
-                    break;
+#endif /* configUSE_WINDOWED_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
 
-                case eNoAction:
+#if ( configUSE_DVFS_GOVERNOR == 1 )
 
-                    /* The task is being notified without its notify value being
-                     * updated. */
-                    break;
+    static configRUN_TIME_COUNTER_TYPE prvGetDvfsIdleRunTime( configRUN_TIME_COUNTER_TYPE ulNow )
+    {
+        configRUN_TIME_COUNTER_TYPE ulIdle;
 
-                default:
+        #if ( configNUMBER_OF_CORES == 1 )
+        {
+            ulIdle = xIdleTaskHandle->ulRunTimeCounter;
 
-                    /* Should not get here if all enums are handled.
-                     * Artificially force an assert by testing a value the
-                     * compiler can't assume is const. */
-                    configASSERT( xTickCount == ( TickType_t ) 0 );
-                    break;
+            /* The idle task may have been running for most of the period
+             * without being switched out. */
+            if( ( pxCurrentTCB == xIdleTaskHandle ) && ( ulNow > ulTaskSwitchedInTime ) )
+            {
+                ulIdle += ulNow - ulTaskSwitchedInTime;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
             }
+        }
+        #else /* if ( configNUMBER_OF_CORES == 1 ) */
+        {
+            BaseType_t xCoreID;
 
-            traceTASK_NOTIFY_FROM_ISR( uxIndexToNotify );
+            ulIdle = 0UL;
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
             {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
-
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-                {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
-                }
+                ulIdle += xIdleTaskHandles[ xCoreID ]->ulRunTimeCounter;
 
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+                if( ( ( pxCurrentTCBs[ xCoreID ]->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U ) &&
+                    ( ulNow > ulTaskSwitchedInTime[ xCoreID ] ) )
                 {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
-                    {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
-                    }
-
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter to an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
+                    ulIdle += ulNow - ulTaskSwitchedInTime[ xCoreID ];
                 }
                 else
                 {
@@ -5094,227 +14560,203 @@ TickType_t uxTaskResetEventItemValue( void )
                 }
             }
         }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+        #endif /* if ( configNUMBER_OF_CORES == 1 ) */
 
-        return xReturn;
+        return ulIdle;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_DVFS_GOVERNOR */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( configUSE_DVFS_GOVERNOR == 1 )
 
-    void vTaskGenericNotifyGiveFromISR( TaskHandle_t xTaskToNotify,
-                                        UBaseType_t uxIndexToNotify,
-                                        BaseType_t * pxHigherPriorityTaskWoken )
+    static void prvDvfsGovernor( void )
     {
-        TCB_t * pxTCB;
-        uint8_t ucOriginalNotifyState;
-        UBaseType_t uxSavedInterruptStatus;
+        configRUN_TIME_COUNTER_TYPE ulNow, ulIdleNow, ulElapsed, ulIdle;
+        UBaseType_t uxLoad = uxDvfsLoad;
+        UBaseType_t uxNewLevel = uxDvfsLevel;
 
-        configASSERT( xTaskToNotify );
-        configASSERT( uxIndexToNotify < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        #ifdef portALT_GET_RUN_TIME_COUNTER_VALUE
+            portALT_GET_RUN_TIME_COUNTER_VALUE( ulNow );
+        #else
+            ulNow = portGET_RUN_TIME_COUNTER_VALUE();
+        #endif
 
-        /* RTOS ports that support interrupt nesting have the concept of a
-         * maximum  system call (or maximum API call) interrupt priority.
-         * Interrupts that are  above the maximum system call priority are keep
-         * permanently enabled, even when the RTOS kernel is in a critical section,
-         * but cannot make any calls to FreeRTOS API functions.  If configASSERT()
-         * is defined in FreeRTOSConfig.h then
-         * portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-         * failure if a FreeRTOS API function is called from an interrupt that has
-         * been assigned a priority above the configured maximum system call
-         * priority.  Only FreeRTOS functions that end in FromISR can be called
-         * from interrupts  that have been assigned a priority at or (logically)
-         * below the maximum system call interrupt priority.  FreeRTOS maintains a
-         * separate interrupt safe API to ensure interrupt entry is as fast and as
-         * simple as possible.  More information (albeit Cortex-M specific) is
-         * provided on the following link:
-         * https://www.FreeRTOS.org/RTOS-Cortex-M3-M4.html */
-        portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+        ulIdleNow = prvGetDvfsIdleRunTime( ulNow );
 
-        pxTCB = xTaskToNotify;
+        /* Every core contributes to the time available. */
+        ulElapsed = ( ulNow - ulDvfsPeriodStart ) * ( configRUN_TIME_COUNTER_TYPE ) configNUMBER_OF_CORES;
+        ulIdle = ulIdleNow - ulDvfsIdleStart;
 
-        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        /* Leave the load unchanged if the counter did not advance far enough
+         * to measure it. */
+        if( ulElapsed >= ( configRUN_TIME_COUNTER_TYPE ) 100 )
         {
-            ucOriginalNotifyState = pxTCB->ucNotifyState[ uxIndexToNotify ];
-            pxTCB->ucNotifyState[ uxIndexToNotify ] = taskNOTIFICATION_RECEIVED;
-
-            /* 'Giving' is equivalent to incrementing a count in a counting
-             * semaphore. */
-            ( pxTCB->ulNotifiedValue[ uxIndexToNotify ] )++;
-
-            traceTASK_NOTIFY_GIVE_FROM_ISR( uxIndexToNotify );
+            ulIdle /= ( ulElapsed / ( configRUN_TIME_COUNTER_TYPE ) 100 );
 
-            /* If the task is in the blocked state specifically to wait for a
-             * notification then unblock it now. */
-            if( ucOriginalNotifyState == taskWAITING_NOTIFICATION )
+            if( ulIdle > ( configRUN_TIME_COUNTER_TYPE ) 100 )
             {
-                /* The task should not have been on an event list. */
-                configASSERT( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) == NULL );
-
-                if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-                {
-                    listREMOVE_ITEM( &( pxTCB->xStateListItem ) );
-                    prvAddTaskToReadyList( pxTCB );
-                }
-                else
-                {
-                    /* The delayed and ready lists cannot be accessed, so hold
-                     * this task pending until the scheduler is resumed. */
-                    listINSERT_END( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
-                }
-
-                if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
-                {
-                    /* The notified task has a priority above the currently
-                     * executing task so a yield is required. */
-                    if( pxHigherPriorityTaskWoken != NULL )
-                    {
-                        *pxHigherPriorityTaskWoken = pdTRUE;
-                    }
-
-                    /* Mark that a yield is pending in case the user is not
-                     * using the "xHigherPriorityTaskWoken" parameter in an ISR
-                     * safe FreeRTOS function. */
-                    xYieldPending = pdTRUE;
-                }
-                else
-                {
-                    mtCOVERAGE_TEST_MARKER();
-                }
+                ulIdle = ( configRUN_TIME_COUNTER_TYPE ) 100;
             }
-        }
-        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
-    }
-
-#endif /* configUSE_TASK_NOTIFICATIONS */
-/*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+            uxLoad = ( UBaseType_t ) ( ( configRUN_TIME_COUNTER_TYPE ) 100 - ulIdle );
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-    BaseType_t xTaskGenericNotifyStateClear( TaskHandle_t xTask,
-                                             UBaseType_t uxIndexToClear )
-    {
-        TCB_t * pxTCB;
-        BaseType_t xReturn;
+        /* Go straight to full speed when busy, so a burst of work is not
+         * slowed, but step down one level at a time when quiet. */
+        if( uxLoad >= ( UBaseType_t ) configDVFS_UP_THRESHOLD )
+        {
+            uxNewLevel = ( UBaseType_t ) ( configDVFS_LEVELS - 1 );
+        }
+        else if( ( uxLoad <= ( UBaseType_t ) configDVFS_DOWN_THRESHOLD ) && ( uxDvfsLevel > ( UBaseType_t ) 0U ) )
+        {
+            uxNewLevel = uxDvfsLevel - ( UBaseType_t ) 1U;
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
+        }
 
-        configASSERT( uxIndexToClear < configTASK_NOTIFICATION_ARRAY_ENTRIES );
+        #ifdef configDVFS_SCALED_RUN_TIME_COUNTER
+        {
+            configRUN_TIME_COUNTER_TYPE ulScaledCount = configDVFS_SCALED_RUN_TIME_COUNTER();
 
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+            /* Rebase every period, at the old level, so the conversion never
+             * spans a level change or a wrap of the scaled counter. */
+            ulDvfsConvertedBase = prvDvfsConvertRunTime( ulScaledCount );
+            ulDvfsScaledBase = ulScaledCount;
+        }
+        #endif
 
-        taskENTER_CRITICAL();
+        if( uxNewLevel != uxDvfsLevel )
         {
-            if( pxTCB->ucNotifyState[ uxIndexToClear ] == taskNOTIFICATION_RECEIVED )
-            {
-                pxTCB->ucNotifyState[ uxIndexToClear ] = taskNOT_WAITING_NOTIFICATION;
-                xReturn = pdPASS;
-            }
-            else
+            traceDVFS_LEVEL_CHANGE( uxDvfsLevel, uxNewLevel );
+            uxDvfsLevel = uxNewLevel;
+            portSET_PERFORMANCE_LEVEL( uxNewLevel );
+
+            #ifdef configDVFS_LEVEL_CLOCK_HZ
             {
-                xReturn = pdFAIL;
+                portCPU_CLOCK_CHANGED( configDVFS_LEVEL_CLOCK_HZ( uxNewLevel ) );
             }
+            #endif
+        }
+        else
+        {
+            mtCOVERAGE_TEST_MARKER();
         }
-        taskEXIT_CRITICAL();
 
-        return xReturn;
+        uxDvfsLoad = uxLoad;
+        ulDvfsPeriodStart = ulNow;
+        ulDvfsIdleStart = ulIdleNow;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* configUSE_DVFS_GOVERNOR */
 /*-----------------------------------------------------------*/
 
-#if ( configUSE_TASK_NOTIFICATIONS == 1 )
+#if ( ( configUSE_DVFS_GOVERNOR == 1 ) && defined( configDVFS_SCALED_RUN_TIME_COUNTER ) )
 
-    uint32_t ulTaskGenericNotifyValueClear( TaskHandle_t xTask,
-                                            UBaseType_t uxIndexToClear,
-                                            uint32_t ulBitsToClear )
+    static configRUN_TIME_COUNTER_TYPE prvDvfsConvertRunTime( configRUN_TIME_COUNTER_TYPE ulScaledCount )
     {
-        TCB_t * pxTCB;
-        uint32_t ulReturn;
-
-        /* If null is passed in here then it is the calling task that is having
-         * its notification state cleared. */
-        pxTCB = prvGetTCBFromHandle( xTask );
+        uint64_t ullElapsed;
 
-        taskENTER_CRITICAL();
-        {
-            /* Return the notification as it was before the bits were cleared,
-             * then clear the bit mask. */
-            ulReturn = pxTCB->ulNotifiedValue[ uxIndexToClear ];
-            pxTCB->ulNotifiedValue[ uxIndexToClear ] &= ~ulBitsToClear;
-        }
-        taskEXIT_CRITICAL();
+        /* Unsigned arithmetic gives the right answer if the scaled counter
+         * wrapped once since the last rebase. */
+        ullElapsed = ( uint64_t ) ( configRUN_TIME_COUNTER_TYPE ) ( ulScaledCount - ulDvfsScaledBase );
+        ullElapsed *= ( uint64_t ) configDVFS_LEVEL_CLOCK_HZ( configDVFS_LEVELS - 1 );
+        ullElapsed /= ( uint64_t ) configDVFS_LEVEL_CLOCK_HZ( uxDvfsLevel );
 
-        return ulReturn;
+        return ulDvfsConvertedBase + ( configRUN_TIME_COUNTER_TYPE ) ullElapsed;
     }
 
-#endif /* configUSE_TASK_NOTIFICATIONS */
+#endif /* ( ( configUSE_DVFS_GOVERNOR == 1 ) && defined( configDVFS_SCALED_RUN_TIME_COUNTER ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#if ( ( configUSE_DVFS_GOVERNOR == 1 ) && defined( configDVFS_SCALED_RUN_TIME_COUNTER ) )
 
-    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimeCounter( const TaskHandle_t xTask )
+    configRUN_TIME_COUNTER_TYPE ulTaskGetDvfsRunTimeCounter( void )
     {
-        return xTask->ulRunTimeCounter;
+        configRUN_TIME_COUNTER_TYPE ulReturn;
+        UBaseType_t uxSavedInterruptStatus;
+
+        /* Only masks interrupts, not a critical section, as this is called
+         * from within the kernel wherever it reads the run time counter. */
+        uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+        {
+            ulReturn = prvDvfsConvertRunTime( configDVFS_SCALED_RUN_TIME_COUNTER() );
+        }
+        portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+        return ulReturn;
     }
 
-#endif
+#endif /* ( ( configUSE_DVFS_GOVERNOR == 1 ) && defined( configDVFS_SCALED_RUN_TIME_COUNTER ) ) */
 /*-----------------------------------------------------------*/
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#if ( configUSE_SCHEDULER_EVENT_HOOKS == 1 )
 
-    configRUN_TIME_COUNTER_TYPE ulTaskGetRunTimePercent( const TaskHandle_t xTask )
+    UBaseType_t uxTaskGetReadyTaskCount( void )
     {
-        configRUN_TIME_COUNTER_TYPE ulTotalTime, ulReturn;
-
-        ulTotalTime = portGET_RUN_TIME_COUNTER_VALUE();
+        UBaseType_t uxPriority;
+        UBaseType_t uxCount = 0U;
 
-        /* For percentage calculations. */
-        ulTotalTime /= ( configRUN_TIME_COUNTER_TYPE ) 100;
+        /* Read without a critical section, as it is called from
+         * vApplicationTaskReadiedHook() with the ready lists already locked, and
+         * an occasional stale count does not matter to a load balancer. */
+        for( uxPriority = 0U; uxPriority < ( UBaseType_t ) configMAX_PRIORITIES; uxPriority++ )
+        {
+            uxCount += listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ uxPriority ] ) );
+        }
 
-        /* Avoid divide by zero errors. */
-        if( ulTotalTime > ( configRUN_TIME_COUNTER_TYPE ) 0 )
+        /* The idle tasks are always in the ready lists. */
+        if( uxCount > ( UBaseType_t ) configNUMBER_OF_CORES )
         {
-            ulReturn = xTask->ulRunTimeCounter / ulTotalTime;
+            uxCount -= ( UBaseType_t ) configNUMBER_OF_CORES;
         }
         else
         {
-            ulReturn = 0;
+            uxCount = 0U;
         }
 
-        return ulReturn;
+        return uxCount;
     }
 
-#endif /* if ( configGENERATE_RUN_TIME_STATS == 1 ) */
+#endif /* configUSE_SCHEDULER_EVENT_HOOKS */
 /*-----------------------------------------------------------*/
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#if ( configUSE_DVFS_GOVERNOR == 1 )
 
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimeCounter( void )
+    UBaseType_t uxTaskGetPerformanceLevel( void )
     {
-        return ulTaskGetRunTimeCounter( xIdleTaskHandle );
+        return uxDvfsLevel;
     }
 
-#endif
+#endif /* configUSE_DVFS_GOVERNOR */
 /*-----------------------------------------------------------*/
 
-#if ( configGENERATE_RUN_TIME_STATS == 1 )
+#if ( configUSE_DVFS_GOVERNOR == 1 )
 
-    configRUN_TIME_COUNTER_TYPE ulTaskGetIdleRunTimePercent( void )
+    UBaseType_t uxTaskGetCpuLoad( void )
     {
-        return ulTaskGetRunTimePercent( xIdleTaskHandle );
+        return uxDvfsLoad;
     }
 
-#endif
+#endif /* configUSE_DVFS_GOVERNOR */
 /*-----------------------------------------------------------*/
 
 static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
                                             const BaseType_t xCanBlockIndefinitely )
 {
     TickType_t xTimeToWake;
-    const TickType_t xConstTickCount = xTickCount;
+    TickType_t xConstTickCount;
+    UBaseType_t uxItemsRemaining;
+
+    /* The wake time is relative to the tick count, so it must be current. */
+    taskSTOP_DYNAMIC_TICK();
+    xConstTickCount = xTickCount;
 
     #if ( INCLUDE_xTaskAbortDelay == 1 )
     {
@@ -5327,7 +14769,9 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
 
     /* Remove the task from the ready list before adding it to the blocked list
      * as the same list item is used for both lists. */
-    if( uxListRemove( &( pxCurrentTCB->xStateListItem ) ) == ( UBaseType_t ) 0 )
+    listFAST_REMOVE_COUNT( &( pxCurrentTCB->xStateListItem ), uxItemsRemaining );
+
+    if( uxItemsRemaining == ( UBaseType_t ) 0 )
     {
         /* The current task must be in a ready list, so there is no need to
          * check, and the port reset macro can be called directly. */
@@ -5357,6 +14801,18 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
             /* The list item will be inserted in wake time order. */
             listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+            #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+                if( ( xTicksToWait != ( TickType_t ) 0 ) && ( xTicksToWait < ( TickType_t ) configDELAYED_TASK_WHEEL_SIZE ) )
+                {
+                    /* The task wakes within one revolution of the wheel, so it
+                     * can be placed in the slot of its wake time without
+                     * walking a sorted list.  The slot is correct even if the
+                     * wake time has overflowed. */
+                    listINSERT_END( &( xDelayedTaskWheel[ xTimeToWake & taskDELAYED_TASK_WHEEL_MASK ] ), &( pxCurrentTCB->xStateListItem ) );
+                }
+                else
+            #endif
+
             if( xTimeToWake < xConstTickCount )
             {
                 /* Wake time has overflowed.  Place this item in the overflow
@@ -5393,6 +14849,15 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait,
         /* The list item will be inserted in wake time order. */
         listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
+        #if ( configUSE_DELAYED_TASK_WHEEL == 1 )
+            if( ( xTicksToWait != ( TickType_t ) 0 ) && ( xTicksToWait < ( TickType_t ) configDELAYED_TASK_WHEEL_SIZE ) )
+            {
+                /* The task wakes within one revolution of the wheel. */
+                listINSERT_END( &( xDelayedTaskWheel[ xTimeToWake & taskDELAYED_TASK_WHEEL_MASK ] ), &( pxCurrentTCB->xStateListItem ) );
+            }
+            else
+        #endif
+
         if( xTimeToWake < xConstTickCount )
         {
             /* Wake time has overflowed.  Place this item in the overflow list. */
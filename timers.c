@@ -39,6 +39,10 @@
 #include "queue.h"
 #include "timers.h"
 
+#if ( configUSE_OBJECT_REGISTRY == 1 )
+    #include "object_registry.h"
+#endif
+
 #if ( INCLUDE_xTimerPendFunctionCall == 1 ) && ( configUSE_TIMERS == 0 )
     #error configUSE_TIMERS must be set to 1 to make the xTimerPendFunctionCall() function available.
 #endif
@@ -70,6 +74,21 @@
     #define tmrSTATUS_IS_ACTIVE                  ( ( uint8_t ) 0x01 )
     #define tmrSTATUS_IS_STATICALLY_ALLOCATED    ( ( uint8_t ) 0x02 )
     #define tmrSTATUS_IS_AUTORELOAD              ( ( uint8_t ) 0x04 )
+    #define tmrSTATUS_CALLBACK_FROM_TICK         ( ( uint8_t ) 0x08 )
+    #define tmrSTATUS_IS_LOW_CRITICALITY         ( ( uint8_t ) 0x10 )
+    #define tmrSTATUS_CALLBACK_DEFERRED          ( ( uint8_t ) 0x20 )
+
+/* When configUSE_TIMER_DIRECT_COMMANDS is 1 tasks other than the timer service
+ * task access the active timer lists with the scheduler suspended, so the timer
+ * service task must also suspend the scheduler while it accesses them.  It
+ * resumes the scheduler again while it executes timer callbacks. */
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+        #define tmrENTER_LIST_ACCESS()    vTaskSuspendAll()
+        #define tmrEXIT_LIST_ACCESS()     ( void ) xTaskResumeAll()
+    #else
+        #define tmrENTER_LIST_ACCESS()
+        #define tmrEXIT_LIST_ACCESS()
+    #endif
 
 /* The definition of the timers themselves. */
     typedef struct tmrTimerControl                  /* The old naming convention is used to prevent breaking kernel aware debuggers. */
@@ -82,6 +101,18 @@
         #if ( configUSE_TRACE_FACILITY == 1 )
             UBaseType_t uxTimerNumber;              /*<< An ID assigned by trace tools such as FreeRTOS+Trace */
         #endif
+        #if ( configUSE_TIMER_SLACK == 1 )
+            TickType_t xTimerSlackInTicks;          /*<< How long the timer's callback can be deferred after its expiry time so it is called together with the callbacks of other timers. */
+        #endif
+        #if ( configUSE_TIMER_SERVICE_INSTANCES == 1 )
+            struct tmrTimerService * pxService;     /*<< The timer service that manages the timer. */
+        #endif
+        #if ( configUSE_MIXED_CRITICALITY == 1 )
+            struct tmrTimerControl * pxNextDeferred; /*<< The next timer whose callback is deferred, while tmrSTATUS_CALLBACK_DEFERRED is set. */
+        #endif
+        #if ( configUSE_OBJECT_REGISTRY == 1 )
+            ObjectRegistryItem_t xRegistryItem;     /*<< Links the timer into the object registry. */
+        #endif
         uint8_t ucStatus;                           /*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
     } xTIMER;
 
@@ -89,6 +120,35 @@
  * name below to enable the use of older kernel aware debuggers. */
     typedef xTIMER Timer_t;
 
+    #if ( configUSE_TIMER_PENDED_WORK == 1 )
+
+/* The definition of the work items used by xTimerPendWork(). */
+        typedef struct tmrPendedWork
+        {
+            struct tmrPendedWork * pxNext; /*<< The next pending work item, in the order in which they were pended. */
+            PendedFunction_t pxFunction;   /*<< The function to execute from the timer service task. */
+            void * pvParameter1;           /*<< The value of the function's first parameter. */
+            uint32_t ulParameter2;         /*<< The value of the function's second parameter. */
+            BaseType_t xIsPending;         /*<< pdTRUE from the time the work item is pended to the time its function is about to be executed. */
+        } PendedWork_t;
+    #endif /* configUSE_TIMER_PENDED_WORK */
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+/* The definition of the high resolution timers.  The ucStatus member uses the
+ * same bit definitions as the ucStatus member of a software timer. */
+        typedef struct tmrHRTimerControl
+        {
+            const char * pcTimerName;                     /*<< Text name.  This is not used by the kernel, it is included simply to make debugging easier. */ /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+            struct tmrHRTimerControl * pxNext;            /*<< The next active high resolution timer, in expiry time order. */
+            uint64_t ullExpiryTime;                       /*<< The value of portHR_TIMER_GET_TIME() at which the timer expires. */
+            uint32_t ulPeriodInMicroseconds;              /*<< How quickly and often the timer expires. */
+            void * pvTimerID;                             /*<< An ID to identify the timer. */
+            HRTimerCallbackFunction_t pxCallbackFunction; /*<< The function that will be called when the timer expires. */
+            uint8_t ucStatus;                             /*<< Holds bits to say if the timer was statically allocated or not, and if it is active or not. */
+        } HRTimer_t;
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
 /* The definition of messages that can be sent and received on the timer queue.
  * Two types of message can be queued - messages that manipulate a software timer,
  * and messages that request the execution of a non-timer related callback.  The
@@ -125,23 +185,105 @@
         } u;
     } DaemonTaskMessage_t;
 
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/* When configUSE_TIMER_WHEEL is 1 the two active timer lists are replaced by
+ * two timing wheels, which are switched on a tick count overflow in the same
+ * way as the lists.  Level N of a wheel holds the timers whose expiry time
+ * first differs from the wheel's cursor in digit N, where each digit is
+ * configTIMER_WHEEL_SLOT_BITS bits of the tick count, and the slot is the value
+ * of that digit.  All the timers in a level 0 slot therefore expire at the
+ * same time.  As the cursor advances, the timers in the slots it reaches are
+ * moved down to lower levels, and the timers that have expired are moved into
+ * the expiry time ordered xExpiredTimers list. */
+        #define tmrWHEEL_SLOTS     ( ( UBaseType_t ) 1U << configTIMER_WHEEL_SLOT_BITS )
+        #define tmrWHEEL_LEVELS    ( ( ( sizeof( TickType_t ) * ( size_t ) 8 ) + ( size_t ) configTIMER_WHEEL_SLOT_BITS - ( size_t ) 1 ) / ( size_t ) configTIMER_WHEEL_SLOT_BITS )
+
+/* Obtain digit uxLevel of xTime. */
+        #define tmrWHEEL_DIGIT( xTime, uxLevel )    ( ( UBaseType_t ) ( ( ( xTime ) >> ( ( uxLevel ) * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS ) ) & ( TickType_t ) ( tmrWHEEL_SLOTS - 1U ) ) )
+
+        typedef struct tmrTimerWheel
+        {
+            TickType_t xCursor;                                     /*<< All the timers in the slots expire after this time. */
+            List_t xExpiredTimers;                                  /*<< Timers that expire at or before xCursor, in expiry time order. */
+            List_t xSlots[ tmrWHEEL_LEVELS ][ tmrWHEEL_SLOTS ]; /*<< Unordered lists of timers, see above. */
+        } TimerWheel_t;
+    #endif /* configUSE_TIMER_WHEEL */
+
+/* The state of a timer service task.  Active timers are referenced from
+ * xActiveTimerList1 and xActiveTimerList2 in expire time order, with the nearest
+ * expiry time at the front of the list.  Only the timer service task is allowed
+ * to access these lists, unless configUSE_TIMER_DIRECT_COMMANDS is 1, in which
+ * case other tasks can access them with the scheduler suspended.  There is
+ * always a default timer service, xTimerService.  When
+ * configUSE_TIMER_SERVICE_INSTANCES is 1 further timer services, each with its
+ * own task and command queue, can be created with xTimerServiceCreate(). */
+    typedef struct tmrTimerService
+    {
+        #if ( configUSE_TIMER_WHEEL == 0 )
+            List_t xActiveTimerList1;
+            List_t xActiveTimerList2;
+            List_t * pxCurrentTimerList;         /*<< The active timers that expire before the tick count overflows. */
+            List_t * pxOverflowTimerList;        /*<< The active timers that expire after the tick count overflows. */
+        #else
+            TimerWheel_t xTimerWheel1;           /*<< Used in place of the active timer lists, see above. */
+            TimerWheel_t xTimerWheel2;
+            TimerWheel_t * pxCurrentTimerWheel;
+            TimerWheel_t * pxOverflowTimerWheel;
+        #endif
+        QueueHandle_t xTimerQueue;               /*<< A queue that is used to send commands to the timer service task. */
+        TaskHandle_t xTimerTaskHandle;           /*<< The timer service task. */
+        TickType_t xLastTime;                    /*<< The tick count when the timer service task last checked for a tick count overflow. */
+        #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+            TickType_t xTimerTaskWakeTime;       /*<< The time at which the timer service task will next unblock, recorded before it blocks so a task that adds a timer directly can tell if the timer service task must be unblocked earlier. */
+            BaseType_t xTimerTaskWaitsIndefinitely;
+        #endif
+        #if ( configUSE_MIXED_CRITICALITY == 1 )
+            Timer_t * pxDeferredTimers;          /*<< The low criticality timers whose callbacks were deferred in high criticality mode, most recent first. */
+        #endif
+    } TimerService_t;
+
+/* Obtain the timer service that manages pxTimer. */
+    #if ( configUSE_TIMER_SERVICE_INSTANCES == 1 )
+        #define tmrGET_TIMER_SERVICE( pxTimer )    ( ( pxTimer )->pxService )
+    #else
+        #define tmrGET_TIMER_SERVICE( pxTimer )    ( &xTimerService )
+    #endif
+
 /*lint -save -e956 A manual analysis and inspection has been used to determine
  * which static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
- * time order, with the nearest expiry time at the front of the list.  Only the
- * timer service task is allowed to access these lists.
- * xActiveTimerList1 and xActiveTimerList2 could be at function scope but that
- * breaks some kernel aware debuggers, and debuggers that reply on removing the
- * static qualifier. */
-    PRIVILEGED_DATA static List_t xActiveTimerList1;
-    PRIVILEGED_DATA static List_t xActiveTimerList2;
-    PRIVILEGED_DATA static List_t * pxCurrentTimerList;
-    PRIVILEGED_DATA static List_t * pxOverflowTimerList;
-
-/* A queue that is used to send commands to the timer service task. */
-    PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
-    PRIVILEGED_DATA static TaskHandle_t xTimerTaskHandle = NULL;
+/* The default timer service.  It could be at function scope but that breaks
+ * some kernel aware debuggers, and debuggers that reply on removing the static
+ * qualifier. */
+    PRIVILEGED_DATA static TimerService_t xTimerService;
+
+    #if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+/* Timers that call their callbacks from the tick interrupt are held in these
+ * lists instead of in the active timer lists.  They are switched by the tick
+ * interrupt when the tick count overflows, and are only accessed from critical
+ * sections. */
+        PRIVILEGED_DATA static List_t xTickTimerList1;
+        PRIVILEGED_DATA static List_t xTickTimerList2;
+        PRIVILEGED_DATA static List_t * pxCurrentTickTimerList;
+        PRIVILEGED_DATA static List_t * pxOverflowTickTimerList;
+    #endif
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+/* The active high resolution timers, in expiry time order.  Only accessed from
+ * critical sections. */
+        PRIVILEGED_DATA static HRTimer_t * pxActiveHRTimers = NULL;
+    #endif
+
+    #if ( configUSE_TIMER_PENDED_WORK == 1 )
+
+/* The work items waiting to be processed by the default timer service task, in
+ * first in, first out order.  Only accessed from critical sections. */
+        PRIVILEGED_DATA static PendedWork_t * pxPendedWorkHead = NULL;
+        PRIVILEGED_DATA static PendedWork_t * pxPendedWorkTail = NULL;
+    #endif
 
 /*lint -restore */
 
@@ -160,15 +302,21 @@
  */
     static portTASK_FUNCTION_PROTO( prvTimerTask, pvParameters ) PRIVILEGED_FUNCTION;
 
+/*
+ * Initialise the active timer lists of a timer service.
+ */
+    static void prvInitialiseTimerService( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+
 /*
  * Called by the timer service task to interpret and process a command it
  * received on the timer queue.
  */
-    static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
+    static void prvProcessReceivedCommands( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
 
 /*
- * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * Insert the timer into either xActiveTimerList1, or xActiveTimerList2, of the
+ * timer service that manages it, depending on if the expire time causes a timer
+ * counter overflow.
  */
     static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
                                                   const TickType_t xNextExpiryTime,
@@ -188,20 +336,29 @@
  * An active timer has reached its expire time.  Reload the timer if it is an
  * auto-reload timer, then call its callback.
  */
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
+    static void prvProcessExpiredTimer( TimerService_t * const pxService,
+                                        const TickType_t xNextExpireTime,
                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+/*
+ * Process the timers that have expired by xTimeNow, up to
+ * configTIMER_EXPIRED_BATCH_SIZE of them, in expiry time order.
+ */
+    static void prvProcessExpiredTimers( TimerService_t * const pxService,
+                                         const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
  */
-    static void prvSwitchTimerLists( void ) PRIVILEGED_FUNCTION;
+    static void prvSwitchTimerLists( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
 
 /*
  * Obtain the current tick count, setting *pxTimerListsWereSwitched to pdTRUE
  * if a tick count overflow occurred since prvSampleTimeNow() was last called.
  */
-    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
+    static TickType_t prvSampleTimeNow( TimerService_t * const pxService,
+                                        BaseType_t * const pxTimerListsWereSwitched ) PRIVILEGED_FUNCTION;
 
 /*
  * If the timer list contains any active timers then return the expire time of
@@ -209,15 +366,135 @@
  * timer list does not contain any timers then return 0 and set *pxListWasEmpty
  * to pdTRUE.
  */
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+    static TickType_t prvGetNextExpireTime( TimerService_t * const pxService,
+                                            BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+/*
+ * Return the latest time at which the timer service task can unblock without
+ * calling the callback of any timer in the current timer list later than its
+ * expiry time plus its slack.  The current timer list must not be empty.
+ */
+        static TickType_t prvGetCoalescedExpireTime( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+    #endif
 
 /*
  * If a timer has expired, process it.  Otherwise, block the timer service task
  * until either a timer does expire or a command is received.
  */
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
+    static void prvProcessTimerOrBlockTask( TimerService_t * const pxService,
+                                            TickType_t xNextExpireTime,
                                             BaseType_t xListWasEmpty ) PRIVILEGED_FUNCTION;
 
+/*
+ * Call the callback function of a timer that has expired.  If
+ * configUSE_MIXED_CRITICALITY is 1 the callback of a low criticality timer is
+ * deferred instead while the kernel is in high criticality mode.
+ */
+    static void prvCallTimerCallback( Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+
+/*
+ * Call the callbacks that prvCallTimerCallback() deferred, if the kernel has
+ * returned to low criticality mode.
+ */
+        static void prvCallDeferredCallbacks( TimerService_t * const pxService ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove a timer that is about to be deleted from the deferred callbacks.
+ */
+        static void prvCancelDeferredCallback( TimerService_t * const pxService,
+                                               Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_MIXED_CRITICALITY */
+
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+
+/*
+ * Apply a start, reset, stop or change period command sent from a task to the
+ * active timer lists without going through the timer queue.  Returns pdFALSE if
+ * the command must be sent to the timer service task instead, which is the case
+ * if the tick count has overflowed but the timer lists have not been switched
+ * yet, if the timer has already expired so its callback must be called, or if
+ * the timer queue holds commands that must be processed first.
+ * *pxWakeTimerTask is set to pdTRUE if the timer service task must be
+ * unblocked to recalculate the time at which it next unblocks.
+ */
+        static BaseType_t prvExecuteCommandDirectly( Timer_t * const pxTimer,
+                                                     const BaseType_t xCommandID,
+                                                     const TickType_t xOptionalValue,
+                                                     BaseType_t * const pxWakeTimerTask ) PRIVILEGED_FUNCTION;
+    #endif /* configUSE_TIMER_DIRECT_COMMANDS */
+
+    #if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+/*
+ * If pxTimer calls its callback from the tick interrupt, apply the command to
+ * it in a critical section and return pdTRUE.  Otherwise return pdFALSE, in
+ * which case the command must be sent to the timer service task.  A command to
+ * delete such a timer also removes it from the tick timer lists, but still
+ * returns pdFALSE so the timer service task can free the timer.
+ */
+        static BaseType_t prvExecuteTickTimerCommand( Timer_t * const pxTimer,
+                                                      const BaseType_t xCommandID,
+                                                      const TickType_t xOptionalValue ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert a timer that calls its callback from the tick interrupt into the tick
+ * timer list for the expiry time one period after xTimeNow.
+ */
+        static void prvInsertTickTimer( Timer_t * const pxTimer,
+                                        const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+    #endif /* configUSE_TIMER_TICK_CALLBACKS */
+
+    #if ( configUSE_TIMER_PENDED_WORK == 1 )
+
+/*
+ * Add pxWork to the end of the list of pending work items, unless it is
+ * already pending, in which case return pdFALSE.  *pxListWasEmpty is set to
+ * pdTRUE if the list was empty, in which case the timer service task must be
+ * woken.  Must be called from a critical section.
+ */
+        static BaseType_t prvAppendPendedWork( PendedWork_t * const pxWork,
+                                               const uint32_t ulParameter2,
+                                               BaseType_t * const pxListWasEmpty ) PRIVILEGED_FUNCTION;
+
+/*
+ * Called by the default timer service task to execute the functions of the
+ * work items that were pending when it was called.
+ */
+        static void prvProcessPendedWork( void ) PRIVILEGED_FUNCTION;
+    #endif /* configUSE_TIMER_PENDED_WORK */
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+/*
+ * Fill in the members of a high resolution timer structure that has been
+ * allocated either statically or dynamically.
+ */
+        static void prvInitialiseNewHRTimer( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                             const uint32_t ulPeriodInMicroseconds,
+                                             const BaseType_t xAutoReload,
+                                             void * const pvTimerID,
+                                             HRTimerCallbackFunction_t pxCallbackFunction,
+                                             HRTimer_t * pxNewTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert pxTimer, the expiry time of which has been set, into the list of
+ * active high resolution timers, reprogramming the compare channel if it is
+ * now the first timer to expire.  Must be called from a critical section.
+ */
+        static void prvInsertHRTimer( HRTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Remove pxTimer from the list of active high resolution timers if it is in
+ * it.  Must be called from a critical section.
+ */
+        static void prvRemoveHRTimer( HRTimer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+
 /*
  * Called after a Timer_t structure has been allocated either statically or
  * dynamically to fill in the structure's members.
@@ -228,6 +505,39 @@
                                        void * const pvTimerID,
                                        TimerCallbackFunction_t pxCallbackFunction,
                                        Timer_t * pxNewTimer ) PRIVILEGED_FUNCTION;
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+/*
+ * Initialise an empty timing wheel with its cursor at time 0.
+ */
+        static void prvInitialiseTimerWheel( TimerWheel_t * const pxWheel ) PRIVILEGED_FUNCTION;
+
+/*
+ * Insert pxTimer, the list item value of which holds its expiry time, into
+ * pxWheel.
+ */
+        static void prvInsertTimerInWheel( TimerWheel_t * const pxWheel,
+                                           Timer_t * const pxTimer ) PRIVILEGED_FUNCTION;
+
+/*
+ * Advance the cursor of pxWheel to xTime, which must not be before the cursor,
+ * moving the timers that expire at or before xTime into the expired list.
+ */
+        static void prvAdvanceTimerWheel( TimerWheel_t * const pxWheel,
+                                          const TickType_t xTime ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return the earliest time at which a timer in pxWheel can expire, setting
+ * *pxWheelWasEmpty to pdFALSE, or return 0 and set *pxWheelWasEmpty to pdTRUE
+ * if pxWheel holds no timers.  The time is exact if the next timer is in the
+ * expired list or in level 0, otherwise it is the start of the slot holding the
+ * next timer, at which time the wheel must be advanced to find out more.
+ */
+        static TickType_t prvGetNextWheelExpireTime( TimerWheel_t * const pxWheel,
+                                                     BaseType_t * const pxWheelWasEmpty ) PRIVILEGED_FUNCTION;
+
+    #endif /* configUSE_TIMER_WHEEL */
 /*-----------------------------------------------------------*/
 
     BaseType_t xTimerCreateTimerTask( void )
@@ -240,7 +550,7 @@
          * been created then the initialisation will already have been performed. */
         prvCheckForValidListAndQueue();
 
-        if( xTimerQueue != NULL )
+        if( xTimerService.xTimerQueue != NULL )
         {
             #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
             {
@@ -249,15 +559,15 @@
                 uint32_t ulTimerTaskStackSize;
 
                 vApplicationGetTimerTaskMemory( &pxTimerTaskTCBBuffer, &pxTimerTaskStackBuffer, &ulTimerTaskStackSize );
-                xTimerTaskHandle = xTaskCreateStatic( prvTimerTask,
-                                                      configTIMER_SERVICE_TASK_NAME,
-                                                      ulTimerTaskStackSize,
-                                                      NULL,
-                                                      ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-                                                      pxTimerTaskStackBuffer,
-                                                      pxTimerTaskTCBBuffer );
-
-                if( xTimerTaskHandle != NULL )
+                xTimerService.xTimerTaskHandle = xTaskCreateStatic( prvTimerTask,
+                                                                    configTIMER_SERVICE_TASK_NAME,
+                                                                    ulTimerTaskStackSize,
+                                                                    &xTimerService,
+                                                                    ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
+                                                                    pxTimerTaskStackBuffer,
+                                                                    pxTimerTaskTCBBuffer );
+
+                if( xTimerService.xTimerTaskHandle != NULL )
                 {
                     xReturn = pdPASS;
                 }
@@ -267,9 +577,9 @@
                 xReturn = xTaskCreate( prvTimerTask,
                                        configTIMER_SERVICE_TASK_NAME,
                                        configTIMER_TASK_STACK_DEPTH,
-                                       NULL,
+                                       &xTimerService,
                                        ( ( UBaseType_t ) configTIMER_TASK_PRIORITY ) | portPRIVILEGE_BIT,
-                                       &xTimerTaskHandle );
+                                       &( xTimerService.xTimerTaskHandle ) );
             }
             #endif /* configSUPPORT_STATIC_ALLOCATION */
         }
@@ -293,7 +603,7 @@
         {
             Timer_t * pxNewTimer;
 
-            pxNewTimer = ( Timer_t * ) pvPortMalloc( sizeof( Timer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
+            pxNewTimer = ( Timer_t * ) pvPortMallocObject( portOBJECT_POOL_TIMER, sizeof( Timer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of Timer_t is always a pointer to the timer's mame. */
 
             if( pxNewTimer != NULL )
             {
@@ -310,6 +620,129 @@
     #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
 /*-----------------------------------------------------------*/
 
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) )
+
+        TimerHandle_t xTimerCreateWithSlack( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                             const TickType_t xTimerPeriodInTicks,
+                                             const BaseType_t xAutoReload,
+                                             void * const pvTimerID,
+                                             TimerCallbackFunction_t pxCallbackFunction,
+                                             const TickType_t xSlackInTicks )
+        {
+            Timer_t * pxNewTimer;
+
+            pxNewTimer = xTimerCreate( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction );
+
+            if( pxNewTimer != NULL )
+            {
+                pxNewTimer->xTimerSlackInTicks = xSlackInTicks;
+            }
+
+            return pxNewTimer;
+        }
+
+    #endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SLACK == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SERVICE_INSTANCES == 1 ) )
+
+        TimerServiceHandle_t xTimerServiceCreate( const char * const pcName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                                  const configSTACK_DEPTH_TYPE usStackDepth,
+                                                  const UBaseType_t uxPriority,
+                                                  const UBaseType_t uxQueueLength )
+        {
+            TimerService_t * pxNewService;
+
+            configASSERT( uxQueueLength > ( UBaseType_t ) 0U );
+
+            pxNewService = ( TimerService_t * ) pvPortMalloc( sizeof( TimerService_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack. */
+
+            if( pxNewService != NULL )
+            {
+                prvInitialiseTimerService( pxNewService );
+
+                /* The timer lists are switched when the tick count is seen to
+                 * be lower than xLastTime, so start from the time now in case
+                 * the scheduler is already running. */
+                pxNewService->xLastTime = xTaskGetTickCount();
+
+                pxNewService->xTimerQueue = xQueueCreate( uxQueueLength, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ) );
+
+                if( pxNewService->xTimerQueue != NULL )
+                {
+                    #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                    {
+                        vQueueAddToRegistry( pxNewService->xTimerQueue, pcName );
+                    }
+                    #endif
+
+                    if( xTaskCreate( prvTimerTask,
+                                     pcName,
+                                     usStackDepth,
+                                     pxNewService,
+                                     uxPriority | portPRIVILEGE_BIT,
+                                     &( pxNewService->xTimerTaskHandle ) ) != pdPASS )
+                    {
+                        #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                        {
+                            vQueueUnregisterQueue( pxNewService->xTimerQueue );
+                        }
+                        #endif
+
+                        vQueueDelete( pxNewService->xTimerQueue );
+                        vPortFree( pxNewService );
+                        pxNewService = NULL;
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                else
+                {
+                    vPortFree( pxNewService );
+                    pxNewService = NULL;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxNewService;
+        }
+
+    #endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SERVICE_INSTANCES == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SERVICE_INSTANCES == 1 ) )
+
+        TimerHandle_t xTimerCreateForService( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                              const TickType_t xTimerPeriodInTicks,
+                                              const BaseType_t xAutoReload,
+                                              void * const pvTimerID,
+                                              TimerCallbackFunction_t pxCallbackFunction,
+                                              TimerServiceHandle_t xService )
+        {
+            Timer_t * pxNewTimer;
+
+            pxNewTimer = xTimerCreate( pcTimerName, xTimerPeriodInTicks, xAutoReload, pvTimerID, pxCallbackFunction );
+
+            if( ( pxNewTimer != NULL ) && ( xService != NULL ) )
+            {
+                pxNewTimer->pxService = xService;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return pxNewTimer;
+        }
+
+    #endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_TIMER_SERVICE_INSTANCES == 1 ) ) */
+/*-----------------------------------------------------------*/
+
     #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
 
         TimerHandle_t xTimerCreateStatic( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
@@ -374,11 +807,29 @@
         pxNewTimer->pxCallbackFunction = pxCallbackFunction;
         vListInitialiseItem( &( pxNewTimer->xTimerListItem ) );
 
+        #if ( configUSE_TIMER_SLACK == 1 )
+        {
+            pxNewTimer->xTimerSlackInTicks = ( TickType_t ) 0U;
+        }
+        #endif
+
+        #if ( configUSE_TIMER_SERVICE_INSTANCES == 1 )
+        {
+            pxNewTimer->pxService = &xTimerService;
+        }
+        #endif
+
         if( xAutoReload != pdFALSE )
         {
             pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
         }
 
+        #if ( configUSE_OBJECT_REGISTRY == 1 )
+        {
+            vObjectRegistryAdd( &( pxNewTimer->xRegistryItem ), pxNewTimer, eObjectTimer, pcTimerName );
+        }
+        #endif
+
         traceTIMER_CREATE( pxNewTimer );
     }
 /*-----------------------------------------------------------*/
@@ -390,12 +841,16 @@
                                      const TickType_t xTicksToWait )
     {
         BaseType_t xReturn = pdFAIL;
+        BaseType_t xCommandExecuted = pdFALSE;
         DaemonTaskMessage_t xMessage;
+        QueueHandle_t xTimerQueue;
 
         configASSERT( xTimer );
 
-        /* Send a message to the timer service task to perform a particular action
-         * on a particular timer definition. */
+        /* Send a message to the timer service task that manages the timer to
+         * perform a particular action on a particular timer definition. */
+        xTimerQueue = tmrGET_TIMER_SERVICE( ( Timer_t * ) xTimer )->xTimerQueue;
+
         if( xTimerQueue != NULL )
         {
             /* Send a command to the timer service task to start the xTimer timer. */
@@ -403,11 +858,53 @@
             xMessage.u.xTimerParameters.xMessageValue = xOptionalValue;
             xMessage.u.xTimerParameters.pxTimer = xTimer;
 
-            if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+            #if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+            {
+                /* Timers that call their callbacks from the tick interrupt are
+                 * not managed by the timer service task. */
+                xCommandExecuted = prvExecuteTickTimerCommand( xTimer, xCommandID, xOptionalValue );
+            }
+            #endif
+
+            if( xCommandExecuted != pdFALSE )
+            {
+                xReturn = pdPASS;
+            }
+            else if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
             {
                 if( xTaskGetSchedulerState() == taskSCHEDULER_RUNNING )
                 {
-                    xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+                    {
+                        BaseType_t xWakeTimerTask;
+
+                        if( prvExecuteCommandDirectly( xTimer, xCommandID, xOptionalValue, &xWakeTimerTask ) != pdFALSE )
+                        {
+                            if( xWakeTimerTask != pdFALSE )
+                            {
+                                /* The result is not checked as the timer
+                                 * service task does not block while the queue is
+                                 * full. */
+                                xMessage.xMessageID = tmrCOMMAND_WAKE_TIMER_TASK;
+                                ( void ) xQueueSendToBack( xTimerQueue, &xMessage, tmrNO_DELAY );
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            xReturn = pdPASS;
+                        }
+                        else
+                        {
+                            xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                        }
+                    }
+                    #else /* if ( configUSE_TIMER_DIRECT_COMMANDS == 1 ) */
+                    {
+                        xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                    }
+                    #endif /* configUSE_TIMER_DIRECT_COMMANDS */
                 }
                 else
                 {
@@ -430,671 +927,2307 @@
     }
 /*-----------------------------------------------------------*/
 
-    TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
-    {
-        /* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
-         * started, then xTimerTaskHandle will be NULL. */
-        configASSERT( ( xTimerTaskHandle != NULL ) );
-        return xTimerTaskHandle;
-    }
-/*-----------------------------------------------------------*/
-
-    TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
-    {
-        Timer_t * pxTimer = xTimer;
-
-        configASSERT( xTimer );
-        return pxTimer->xTimerPeriodInTicks;
-    }
-/*-----------------------------------------------------------*/
-
-    void vTimerSetReloadMode( TimerHandle_t xTimer,
-                              const BaseType_t xAutoReload )
-    {
-        Timer_t * pxTimer = xTimer;
+    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
 
-        configASSERT( xTimer );
-        taskENTER_CRITICAL();
+        static BaseType_t prvExecuteCommandDirectly( Timer_t * const pxTimer,
+                                                     const BaseType_t xCommandID,
+                                                     const TickType_t xOptionalValue,
+                                                     BaseType_t * const pxWakeTimerTask )
         {
-            if( xAutoReload != pdFALSE )
-            {
-                pxTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
-            }
-            else
-            {
-                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_AUTORELOAD );
-            }
-        }
-        taskEXIT_CRITICAL();
-    }
-/*-----------------------------------------------------------*/
+            TimerService_t * const pxService = tmrGET_TIMER_SERVICE( pxTimer );
+            BaseType_t xReturn = pdFALSE;
+            TickType_t xTimeNow;
+            TickType_t xCommandTime;
 
-    BaseType_t xTimerGetReloadMode( TimerHandle_t xTimer )
-    {
-        Timer_t * pxTimer = xTimer;
-        BaseType_t xReturn;
+            *pxWakeTimerTask = pdFALSE;
 
-        configASSERT( xTimer );
-        taskENTER_CRITICAL();
-        {
-            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) == 0 )
-            {
-                /* Not an auto-reload timer. */
-                xReturn = pdFALSE;
-            }
-            else
+            vTaskSuspendAll();
             {
-                /* Is an auto-reload timer. */
-                xReturn = pdTRUE;
-            }
-        }
-        taskEXIT_CRITICAL();
+                xTimeNow = xTaskGetTickCount();
+
+                /* Timers are only deleted by the timer service task, and the
+                 * timer lists can only be used once the timer service task has
+                 * switched them following a tick count overflow.  Commands
+                 * already in the timer queue, sent from interrupts or by
+                 * earlier commands that could not be applied directly, must be
+                 * processed first, so this command goes through the queue
+                 * behind them. */
+                if( ( xCommandID != tmrCOMMAND_DELETE ) &&
+                    ( xTimeNow >= pxService->xLastTime ) &&
+                    ( uxQueueMessagesWaiting( pxService->xTimerQueue ) == ( UBaseType_t ) 0 ) )
+                {
+                    if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+                    {
+                        listFAST_REMOVE( &( pxTimer->xTimerListItem ) );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+
+                    traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+                    if( xCommandID == tmrCOMMAND_STOP )
+                    {
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        xReturn = pdPASS;
+                    }
+                    else
+                    {
+                        if( xCommandID == tmrCOMMAND_CHANGE_PERIOD )
+                        {
+                            /* As when the timer service task processes the
+                             * command, the new period is relative to the time
+                             * now. */
+                            pxTimer->xTimerPeriodInTicks = xOptionalValue;
+                            configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+                            xCommandTime = xTimeNow;
+                        }
+                        else
+                        {
+                            xCommandTime = xOptionalValue;
+                        }
+
+                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+                        /* A timer that has already expired is left out of the
+                         * active lists and the command is sent to the timer
+                         * service task, which then calls the timer's callback. */
+                        if( prvInsertTimerInActiveList( pxTimer, xCommandTime + pxTimer->xTimerPeriodInTicks, xTimeNow, xCommandTime ) == pdFALSE )
+                        {
+                            /* The timer service task has to be unblocked if it
+                             * would otherwise remain blocked past the new expiry
+                             * time.  If it is not blocked then it obtains the
+                             * next expire time again before it blocks. */
+                            if( ( pxService->xTimerTaskWaitsIndefinitely != pdFALSE ) ||
+                                ( ( TickType_t ) ( xCommandTime + pxTimer->xTimerPeriodInTicks - xTimeNow ) < ( TickType_t ) ( pxService->xTimerTaskWakeTime - xTimeNow ) ) )
+                            {
+                                *pxWakeTimerTask = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            xReturn = pdPASS;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            ( void ) xTaskResumeAll();
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_TIMER_DIRECT_COMMANDS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+        static BaseType_t prvExecuteTickTimerCommand( Timer_t * const pxTimer,
+                                                      const BaseType_t xCommandID,
+                                                      const TickType_t xOptionalValue )
+        {
+            BaseType_t xReturn = pdFALSE;
+            UBaseType_t uxSavedInterruptStatus = ( UBaseType_t ) 0U;
+            TickType_t xTimeNow;
+
+            if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+            {
+                taskENTER_CRITICAL();
+                xTimeNow = xTaskGetTickCount();
+            }
+            else
+            {
+                uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                xTimeNow = xTaskGetTickCountFromISR();
+            }
+
+            if( ( pxTimer->ucStatus & tmrSTATUS_CALLBACK_FROM_TICK ) != 0U )
+            {
+                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+                {
+                    listFAST_REMOVE( &( pxTimer->xTimerListItem ) );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                traceTIMER_COMMAND_RECEIVED( pxTimer, xCommandID, xOptionalValue );
+
+                switch( xCommandID )
+                {
+                    case tmrCOMMAND_START_DONT_TRACE:
+                    case tmrCOMMAND_START:
+                    case tmrCOMMAND_START_FROM_ISR:
+                    case tmrCOMMAND_RESET:
+                    case tmrCOMMAND_RESET_FROM_ISR:
+                        /* The command is executed when it is issued, so the
+                         * expiry time is always one period from now. */
+                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                        prvInsertTickTimer( pxTimer, xTimeNow );
+                        xReturn = pdTRUE;
+                        break;
+
+                    case tmrCOMMAND_STOP:
+                    case tmrCOMMAND_STOP_FROM_ISR:
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        xReturn = pdTRUE;
+                        break;
+
+                    case tmrCOMMAND_CHANGE_PERIOD:
+                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                        pxTimer->xTimerPeriodInTicks = xOptionalValue;
+                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+                        prvInsertTickTimer( pxTimer, xTimeNow );
+                        xReturn = pdTRUE;
+                        break;
+
+                    default:
+                        /* The timer is deleted by the timer service task. */
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                        break;
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            if( xCommandID < tmrFIRST_FROM_ISR_COMMAND )
+            {
+                taskEXIT_CRITICAL();
+            }
+            else
+            {
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+            }
+
+            return xReturn;
+        }
+
+    #endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+        static void prvInsertTickTimer( Timer_t * const pxTimer,
+                                        const TickType_t xTimeNow )
+        {
+            const TickType_t xNextExpiryTime = xTimeNow + pxTimer->xTimerPeriodInTicks;
+
+            listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+            listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+            if( xNextExpiryTime <= xTimeNow )
+            {
+                /* The expiry time has overflowed. */
+                vListInsert( pxOverflowTickTimerList, &( pxTimer->xTimerListItem ) );
+            }
+            else
+            {
+                vListInsert( pxCurrentTickTimerList, &( pxTimer->xTimerListItem ) );
+
+                /* Make sure the tick at which the timer expires is processed. */
+                vTaskSetTickTimerExpiry( xNextExpiryTime );
+            }
+        }
+
+    #endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+        TickType_t xTimerProcessTickCallbacks( const TickType_t xTimeNow )
+        {
+            Timer_t * pxTimer;
+            List_t * pxTemp;
+            TickType_t xNextExpireTime;
+
+            /* This is called from the tick interrupt, so the tick timer lists
+             * cannot also be in use by a critical section. */
+            if( xTimeNow == ( TickType_t ) 0U )
+            {
+                /* The tick count has overflowed.  Every timer in the current
+                 * list expired on an earlier tick, so the list is empty. */
+                configASSERT( ( listLIST_IS_EMPTY( pxCurrentTickTimerList ) ) );
+
+                pxTemp = pxCurrentTickTimerList;
+                pxCurrentTickTimerList = pxOverflowTickTimerList;
+                pxOverflowTickTimerList = pxTemp;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            for( ; ; )
+            {
+                if( listLIST_IS_EMPTY( pxCurrentTickTimerList ) != pdFALSE )
+                {
+                    xNextExpireTime = portMAX_DELAY;
+                    break;
+                }
+
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTickTimerList );
+
+                if( xNextExpireTime > xTimeNow )
+                {
+                    break;
+                }
+
+                pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTickTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                listFAST_REMOVE( &( pxTimer->xTimerListItem ) );
+
+                if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+                {
+                    prvInsertTickTimer( pxTimer, xTimeNow );
+                }
+                else
+                {
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                }
+
+                traceTIMER_EXPIRED( pxTimer );
+                pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+            }
+
+            return xNextExpireTime;
+        }
+
+    #endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+    TaskHandle_t xTimerGetTimerDaemonTaskHandle( void )
+    {
+        /* If xTimerGetTimerDaemonTaskHandle() is called before the scheduler has been
+         * started, then xTimerTaskHandle will be NULL. */
+        configASSERT( ( xTimerService.xTimerTaskHandle != NULL ) );
+        return xTimerService.xTimerTaskHandle;
+    }
+/*-----------------------------------------------------------*/
+
+    TickType_t xTimerGetPeriod( TimerHandle_t xTimer )
+    {
+        Timer_t * pxTimer = xTimer;
+
+        configASSERT( xTimer );
+        return pxTimer->xTimerPeriodInTicks;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTimerSetReloadMode( TimerHandle_t xTimer,
+                              const BaseType_t xAutoReload )
+    {
+        Timer_t * pxTimer = xTimer;
+
+        configASSERT( xTimer );
+        taskENTER_CRITICAL();
+        {
+            if( xAutoReload != pdFALSE )
+            {
+                pxTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
+            }
+            else
+            {
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_AUTORELOAD );
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTimerGetReloadMode( TimerHandle_t xTimer )
+    {
+        Timer_t * pxTimer = xTimer;
+        BaseType_t xReturn;
+
+        configASSERT( xTimer );
+        taskENTER_CRITICAL();
+        {
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) == 0 )
+            {
+                /* Not an auto-reload timer. */
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                /* Is an auto-reload timer. */
+                xReturn = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
 
         return xReturn;
     }
 
-    UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer )
+    UBaseType_t uxTimerGetReloadMode( TimerHandle_t xTimer )
+    {
+        return ( UBaseType_t ) xTimerGetReloadMode( xTimer );
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+
+        void vTimerSetCallbackFromTick( TimerHandle_t xTimer,
+                                        const BaseType_t xCallbackFromTick )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                /* The timer must be dormant, as it is about to move between
+                 * the active timer lists and the tick timer lists. */
+                configASSERT( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0U );
+
+                if( xCallbackFromTick != pdFALSE )
+                {
+                    pxTimer->ucStatus |= tmrSTATUS_CALLBACK_FROM_TICK;
+                }
+                else
+                {
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_CALLBACK_FROM_TICK );
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_TIMER_TICK_CALLBACKS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        void vTimerSetSlack( TimerHandle_t xTimer,
+                             const TickType_t xSlackInTicks )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+
+            /* Only read by the timer service task when it is about to block,
+             * so takes effect from the next time the task blocks. */
+            taskENTER_CRITICAL();
+            {
+                pxTimer->xTimerSlackInTicks = xSlackInTicks;
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SERVICE_INSTANCES == 1 )
+
+        void vTimerSetService( TimerHandle_t xTimer,
+                               TimerServiceHandle_t xService )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+
+            taskENTER_CRITICAL();
+            {
+                /* The timer lists of the old service may still reference the
+                 * timer, so it can only move while it is dormant. */
+                configASSERT( ( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0U ) );
+                configASSERT( ( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) != pdFALSE ) ); /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+
+                #if ( configUSE_MIXED_CRITICALITY == 1 )
+                    configASSERT( ( ( pxTimer->ucStatus & tmrSTATUS_CALLBACK_DEFERRED ) == 0U ) );
+                #endif
+
+                if( xService != NULL )
+                {
+                    pxTimer->pxService = xService;
+                }
+                else
+                {
+                    pxTimer->pxService = &xTimerService;
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_TIMER_SERVICE_INSTANCES */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+
+        void vTimerSetCriticality( TimerHandle_t xTimer,
+                                   const UBaseType_t uxCriticality )
+        {
+            Timer_t * pxTimer = xTimer;
+
+            configASSERT( xTimer );
+            configASSERT( ( uxCriticality == tskCRITICALITY_LOW ) || ( uxCriticality == tskCRITICALITY_HIGH ) );
+
+            /* A callback that is already deferred is still called when the
+             * kernel returns to low criticality mode. */
+            taskENTER_CRITICAL();
+            {
+                if( uxCriticality == tskCRITICALITY_LOW )
+                {
+                    pxTimer->ucStatus |= tmrSTATUS_IS_LOW_CRITICALITY;
+                }
+                else
+                {
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_LOW_CRITICALITY );
+                }
+            }
+            taskEXIT_CRITICAL();
+        }
+
+    #endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+
+        UBaseType_t uxTimerGetCriticality( TimerHandle_t xTimer )
+        {
+            Timer_t * pxTimer = xTimer;
+            UBaseType_t uxReturn;
+
+            configASSERT( xTimer );
+
+            taskENTER_CRITICAL();
+            {
+                if( ( pxTimer->ucStatus & tmrSTATUS_IS_LOW_CRITICALITY ) != 0U )
+                {
+                    uxReturn = tskCRITICALITY_LOW;
+                }
+                else
+                {
+                    uxReturn = tskCRITICALITY_HIGH;
+                }
+            }
+            taskEXIT_CRITICAL();
+
+            return uxReturn;
+        }
+
+    #endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+
+        BaseType_t xTimerReleaseDeferredCallbacks( void )
+        {
+            DaemonTaskMessage_t xMessage;
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+            /* The message only unblocks the timer service task, which then
+             * calls the deferred callbacks.  It is not needed if no callback
+             * was deferred, and the result is not checked as a full queue will
+             * wake the task anyway. */
+            if( ( xTimerService.xTimerQueue != NULL ) && ( xTimerService.pxDeferredTimers != NULL ) )
+            {
+                xMessage.xMessageID = tmrCOMMAND_WAKE_TIMER_TASK;
+                ( void ) xQueueSendToBackFromISR( xTimerService.xTimerQueue, &xMessage, &xHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            return xHigherPriorityTaskWoken;
+        }
+
+    #endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+    TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
+    {
+        Timer_t * pxTimer = xTimer;
+        TickType_t xReturn;
+
+        configASSERT( xTimer );
+        xReturn = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+        return xReturn;
+    }
+/*-----------------------------------------------------------*/
+
+    const char * pcTimerGetName( TimerHandle_t xTimer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    {
+        Timer_t * pxTimer = xTimer;
+
+        configASSERT( xTimer );
+        return pxTimer->pcTimerName;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvReloadTimer( Timer_t * const pxTimer,
+                                TickType_t xExpiredTime,
+                                const TickType_t xTimeNow )
+    {
+        /* Insert the timer into the appropriate list for the next expiry time.
+         * If the next expiry time has already passed, advance the expiry time,
+         * call the callback function, and try again. */
+        while( prvInsertTimerInActiveList( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime ) != pdFALSE )
+        {
+            /* Advance the expiry time. */
+            xExpiredTime += pxTimer->xTimerPeriodInTicks;
+
+            /* Call the timer callback. */
+            prvCallTimerCallback( pxTimer );
+
+            #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+            {
+                /* The callback executed with the scheduler resumed, so another
+                 * task may have stopped or restarted the timer. */
+                if( ( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) || /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+                    ( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0U ) )
+                {
+                    break;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif /* configUSE_TIMER_DIRECT_COMMANDS */
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvCallTimerCallback( Timer_t * const pxTimer )
+    {
+        #if ( configUSE_MIXED_CRITICALITY == 1 )
+        {
+            if( ( ( pxTimer->ucStatus & tmrSTATUS_IS_LOW_CRITICALITY ) != 0U ) &&
+                ( uxTaskGetCriticalityMode() == tskCRITICALITY_HIGH ) )
+            {
+                /* The callback is called by prvCallDeferredCallbacks() once
+                 * the kernel returns to low criticality mode.  A timer that is
+                 * already waiting to have its callback called is not added
+                 * again. */
+                if( ( pxTimer->ucStatus & tmrSTATUS_CALLBACK_DEFERRED ) == 0U )
+                {
+                    TimerService_t * const pxService = tmrGET_TIMER_SERVICE( pxTimer );
+
+                    pxTimer->ucStatus |= tmrSTATUS_CALLBACK_DEFERRED;
+                    pxTimer->pxNextDeferred = pxService->pxDeferredTimers;
+                    pxService->pxDeferredTimers = pxTimer;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                return;
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_MIXED_CRITICALITY */
+
+        traceTIMER_EXPIRED( pxTimer );
+
+        /* Allow other tasks to run, and to access the active timer lists, while
+         * the callback executes. */
+        tmrEXIT_LIST_ACCESS();
+        {
+            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+        }
+        tmrENTER_LIST_ACCESS();
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+
+        static void prvCallDeferredCallbacks( TimerService_t * const pxService )
+        {
+            Timer_t * pxTimer;
+
+            tmrENTER_LIST_ACCESS();
+            {
+                /* Stop if the kernel switches back to high criticality mode
+                 * while a callback executes, in which case the remaining
+                 * callbacks stay deferred. */
+                while( ( pxService->pxDeferredTimers != NULL ) &&
+                       ( uxTaskGetCriticalityMode() == tskCRITICALITY_LOW ) )
+                {
+                    pxTimer = pxService->pxDeferredTimers;
+                    pxService->pxDeferredTimers = pxTimer->pxNextDeferred;
+                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_CALLBACK_DEFERRED );
+
+                    prvCallTimerCallback( pxTimer );
+                }
+            }
+            tmrEXIT_LIST_ACCESS();
+        }
+
+    #endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_MIXED_CRITICALITY == 1 )
+
+        static void prvCancelDeferredCallback( TimerService_t * const pxService,
+                                               Timer_t * const pxTimer )
+        {
+            Timer_t ** ppxLink;
+
+            if( ( pxTimer->ucStatus & tmrSTATUS_CALLBACK_DEFERRED ) != 0U )
+            {
+                ppxLink = &( pxService->pxDeferredTimers );
+
+                while( *ppxLink != pxTimer )
+                {
+                    ppxLink = &( ( *ppxLink )->pxNextDeferred );
+                }
+
+                *ppxLink = pxTimer->pxNextDeferred;
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_CALLBACK_DEFERRED );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+    #endif /* configUSE_MIXED_CRITICALITY */
+/*-----------------------------------------------------------*/
+
+    static void prvProcessExpiredTimer( TimerService_t * const pxService,
+                                        const TickType_t xNextExpireTime,
+                                        const TickType_t xTimeNow )
+    {
+        #if ( configUSE_TIMER_WHEEL == 0 )
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );                        /*lint !e9087 !e9079 void * is used as this macro is used with tasks too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #else
+            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( &( pxService->pxCurrentTimerWheel->xExpiredTimers ) ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+        #endif
+
+        /* Remove the timer from the list of active timers.  A check has already
+         * been performed to ensure the list is not empty. */
+
+        listFAST_REMOVE( &( pxTimer->xTimerListItem ) );
+
+        /* If the timer is an auto-reload timer then calculate the next
+         * expiry time and re-insert the timer in the list of active timers. */
+        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+        {
+            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
+        }
+        else
+        {
+            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+        }
+
+        /* Call the timer callback. */
+        prvCallTimerCallback( pxTimer );
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessExpiredTimers( TimerService_t * const pxService,
+                                         const TickType_t xTimeNow )
+    {
+        UBaseType_t uxTimersProcessed = 0U;
+        TickType_t xExpireTime;
+
+        /* The timers are all processed against the one sample of the tick
+         * count, so timers that expire on the same tick are handled without
+         * suspending the scheduler and sampling the time again for each of
+         * them.  Reloaded timers are reinserted after xTimeNow, so are not
+         * found again. */
+        do
+        {
+            #if ( configUSE_TIMER_WHEEL == 0 )
+            {
+                if( ( listLIST_IS_EMPTY( pxService->pxCurrentTimerList ) != pdFALSE ) ||
+                    ( listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList ) > xTimeNow ) )
+                {
+                    break;
+                }
+
+                xExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
+            }
+            #else
+            {
+                if( listLIST_IS_EMPTY( &( pxService->pxCurrentTimerWheel->xExpiredTimers ) ) != pdFALSE )
+                {
+                    break;
+                }
+
+                xExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxService->pxCurrentTimerWheel->xExpiredTimers ) );
+            }
+            #endif /* configUSE_TIMER_WHEEL */
+
+            prvProcessExpiredTimer( pxService, xExpireTime, xTimeNow );
+            uxTimersProcessed++;
+        } while( uxTimersProcessed < ( UBaseType_t ) configTIMER_EXPIRED_BATCH_SIZE );
+    }
+/*-----------------------------------------------------------*/
+
+    static portTASK_FUNCTION( prvTimerTask, pvParameters )
+    {
+        TimerService_t * const pxService = ( TimerService_t * ) pvParameters;
+        TickType_t xNextExpireTime;
+        BaseType_t xListWasEmpty;
+
+        #if ( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
+        {
+            extern void vApplicationDaemonTaskStartupHook( void );
+
+            /* Allow the application writer to execute some code in the context of
+             * this task at the point the task starts executing.  This is useful if the
+             * application includes initialisation code that would benefit from
+             * executing after the scheduler has been started.  Only the default
+             * timer service task calls the hook. */
+            if( pxService == &xTimerService )
+            {
+                vApplicationDaemonTaskStartupHook();
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        #endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
+
+        for( ; ; )
+        {
+            /* Query the timers list to see if it contains any timers, and if so,
+             * obtain the time at which the next timer will expire. */
+            xNextExpireTime = prvGetNextExpireTime( pxService, &xListWasEmpty );
+
+            /* If a timer has expired, process it.  Otherwise, block this task
+             * until either a timer does expire, or a command is received. */
+            prvProcessTimerOrBlockTask( pxService, xNextExpireTime, xListWasEmpty );
+
+            /* Empty the command queue. */
+            prvProcessReceivedCommands( pxService );
+
+            #if ( configUSE_MIXED_CRITICALITY == 1 )
+            {
+                prvCallDeferredCallbacks( pxService );
+            }
+            #endif
+
+            #if ( configUSE_TIMER_PENDED_WORK == 1 )
+            {
+                /* Only the default timer service task executes pended work. */
+                if( pxService == &xTimerService )
+                {
+                    prvProcessPendedWork();
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            }
+            #endif
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessTimerOrBlockTask( TimerService_t * const pxService,
+                                            TickType_t xNextExpireTime,
+                                            BaseType_t xListWasEmpty )
+    {
+        TickType_t xTimeNow;
+        BaseType_t xTimerListsWereSwitched;
+
+        vTaskSuspendAll();
+        {
+            #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+            {
+                /* Other tasks may have changed the active timers since the next
+                 * expire time was obtained, so obtain it again now the
+                 * scheduler is suspended. */
+                xNextExpireTime = prvGetNextExpireTime( pxService, &xListWasEmpty );
+            }
+            #endif
+
+            /* Obtain the time now to make an assessment as to whether the timer
+             * has expired or not.  If obtaining the time causes the lists to switch
+             * then don't process this timer as any timers that remained in the list
+             * when the lists were switched will have been processed within the
+             * prvSampleTimeNow() function. */
+            xTimeNow = prvSampleTimeNow( pxService, &xTimerListsWereSwitched );
+
+            if( xTimerListsWereSwitched == pdFALSE )
+            {
+                /* The tick count has not overflowed, has the timer expired? */
+                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                {
+                    /* If other tasks access the active timer lists directly the
+                     * scheduler remains suspended while the timer is processed. */
+                    #if ( configUSE_TIMER_DIRECT_COMMANDS == 0 )
+                    {
+                        ( void ) xTaskResumeAll();
+                    }
+                    #endif
+
+                    #if ( configUSE_TIMER_WHEEL == 1 )
+                    {
+                        /* xNextExpireTime might only be the start of a slot in
+                         * a higher level of the wheel, so advance the wheel to
+                         * find out if a timer has actually expired. */
+                        prvAdvanceTimerWheel( pxService->pxCurrentTimerWheel, xTimeNow );
+                    }
+                    #endif
+
+                    prvProcessExpiredTimers( pxService, xTimeNow );
+
+                    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+                    {
+                        ( void ) xTaskResumeAll();
+                    }
+                    #endif
+                }
+                else
+                {
+                    /* The tick count has not overflowed, and the next expire
+                     * time has not been reached yet.  This task should therefore
+                     * block to wait for the next expire time or a command to be
+                     * received - whichever comes first.  The following line cannot
+                     * be reached unless xNextExpireTime > xTimeNow, except in the
+                     * case when the current timer list is empty. */
+                    if( xListWasEmpty != pdFALSE )
+                    {
+                        /* The current timer list is empty - is the overflow list
+                         * also empty? */
+                        #if ( configUSE_TIMER_WHEEL == 0 )
+                        {
+                            xListWasEmpty = listLIST_IS_EMPTY( pxService->pxOverflowTimerList );
+                        }
+                        #else
+                        {
+                            ( void ) prvGetNextWheelExpireTime( pxService->pxOverflowTimerWheel, &xListWasEmpty );
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        #if ( configUSE_TIMER_SLACK == 1 )
+                        {
+                            /* Block until the last moment at which all the
+                             * timers that have expired by then are still within
+                             * their slack, so their callbacks are called
+                             * together. */
+                            xNextExpireTime = prvGetCoalescedExpireTime( pxService );
+                        }
+                        #else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                        #endif
+                    }
+
+                    #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+                    {
+                        pxService->xTimerTaskWakeTime = xNextExpireTime;
+                        pxService->xTimerTaskWaitsIndefinitely = xListWasEmpty;
+                    }
+                    #endif
+
+                    vQueueWaitForMessageRestricted( pxService->xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
+
+                    if( xTaskResumeAll() == pdFALSE )
+                    {
+                        /* Yield to wait for either a command to arrive, or the
+                         * block time to expire.  If a command arrived between the
+                         * critical section being exited and this yield then the yield
+                         * will not cause the task to block. */
+                        portYIELD_WITHIN_API();
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+            }
+            else
+            {
+                ( void ) xTaskResumeAll();
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvGetNextExpireTime( TimerService_t * const pxService,
+                                            BaseType_t * const pxListWasEmpty )
+    {
+        TickType_t xNextExpireTime;
+
+        /* Timers are listed in expiry time order, with the head of the list
+         * referencing the task that will expire first.  Obtain the time at which
+         * the timer with the nearest expiry time will expire.  If there are no
+         * active timers then just set the next expire time to 0.  That will cause
+         * this task to unblock when the tick count overflows, at which point the
+         * timer lists will be switched and the next expiry time can be
+         * re-assessed.  */
+        #if ( configUSE_TIMER_WHEEL == 0 )
+        {
+            *pxListWasEmpty = listLIST_IS_EMPTY( pxService->pxCurrentTimerList );
+
+            if( *pxListWasEmpty == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
+            }
+            else
+            {
+                /* Ensure the task unblocks when the tick count rolls over. */
+                xNextExpireTime = ( TickType_t ) 0U;
+            }
+        }
+        #else
+        {
+            xNextExpireTime = prvGetNextWheelExpireTime( pxService->pxCurrentTimerWheel, pxListWasEmpty );
+        }
+        #endif /* configUSE_TIMER_WHEEL */
+
+        return xNextExpireTime;
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_SLACK == 1 )
+
+        static TickType_t prvGetCoalescedExpireTime( TimerService_t * const pxService )
+        {
+            const ListItem_t * pxListItem = listGET_HEAD_ENTRY( pxService->pxCurrentTimerList );
+            const ListItem_t * const pxListEnd = listGET_END_MARKER( pxService->pxCurrentTimerList );
+            const Timer_t * pxTimer;
+            TickType_t xExpireTime;
+            TickType_t xLatestTime = tmrMAX_TIME_BEFORE_OVERFLOW;
+
+            /* Timers that expire after the latest time found so far cannot
+             * make it any earlier, so the walk stops at the first of them. */
+            while( ( pxListItem != pxListEnd ) && ( listGET_LIST_ITEM_VALUE( pxListItem ) <= xLatestTime ) )
+            {
+                pxTimer = ( const Timer_t * ) listGET_LIST_ITEM_OWNER( pxListItem ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+                xExpireTime = listGET_LIST_ITEM_VALUE( pxListItem ) + pxTimer->xTimerSlackInTicks;
+
+                /* An expire time that overflows with the slack added does not
+                 * limit the time, as the lists are switched before then. */
+                if( ( xExpireTime >= listGET_LIST_ITEM_VALUE( pxListItem ) ) && ( xExpireTime < xLatestTime ) )
+                {
+                    xLatestTime = xExpireTime;
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                pxListItem = listGET_NEXT( pxListItem );
+            }
+
+            return xLatestTime;
+        }
+
+    #endif /* configUSE_TIMER_SLACK */
+/*-----------------------------------------------------------*/
+
+    static TickType_t prvSampleTimeNow( TimerService_t * const pxService,
+                                        BaseType_t * const pxTimerListsWereSwitched )
+    {
+        TickType_t xTimeNow;
+
+        xTimeNow = xTaskGetTickCount();
+
+        if( xTimeNow < pxService->xLastTime )
+        {
+            prvSwitchTimerLists( pxService );
+            *pxTimerListsWereSwitched = pdTRUE;
+        }
+        else
+        {
+            *pxTimerListsWereSwitched = pdFALSE;
+        }
+
+        pxService->xLastTime = xTimeNow;
+
+        return xTimeNow;
+    }
+/*-----------------------------------------------------------*/
+
+    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
+                                                  const TickType_t xNextExpiryTime,
+                                                  const TickType_t xTimeNow,
+                                                  const TickType_t xCommandTime )
+    {
+        TimerService_t * const pxService = tmrGET_TIMER_SERVICE( pxTimer );
+        BaseType_t xProcessTimerNow = pdFALSE;
+
+        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
+        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+
+        if( xNextExpiryTime <= xTimeNow )
+        {
+            /* Has the expiry time elapsed between the command to start/reset a
+             * timer was issued, and the time the command was processed? */
+            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            {
+                /* The time between a command being issued and the command being
+                 * processed actually exceeds the timers period.  */
+                xProcessTimerNow = pdTRUE;
+            }
+            else
+            {
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    vListInsert( pxService->pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #else
+                {
+                    prvInsertTimerInWheel( pxService->pxOverflowTimerWheel, pxTimer );
+                }
+                #endif
+            }
+        }
+        else
+        {
+            if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+            {
+                /* If, since the command was issued, the tick count has overflowed
+                 * but the expiry time has not, then the timer must have already passed
+                 * its expiry time and should be processed immediately. */
+                xProcessTimerNow = pdTRUE;
+            }
+            else
+            {
+                #if ( configUSE_TIMER_WHEEL == 0 )
+                {
+                    vListInsert( pxService->pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                }
+                #else
+                {
+                    prvInsertTimerInWheel( pxService->pxCurrentTimerWheel, pxTimer );
+                }
+                #endif
+            }
+        }
+
+        return xProcessTimerNow;
+    }
+/*-----------------------------------------------------------*/
+
+    static void prvProcessReceivedCommands( TimerService_t * const pxService )
+    {
+        DaemonTaskMessage_t xMessages[ configTIMER_COMMAND_BATCH_SIZE ];
+        const DaemonTaskMessage_t * pxMessage;
+        Timer_t * pxTimer;
+        BaseType_t xTimerListsWereSwitched;
+        BaseType_t xMessagesReceived;
+        BaseType_t xMessageIndex;
+        TickType_t xTimeNow;
+
+        /* Receive the commands in batches, so the queue is only locked once
+         * for each batch rather than once for each command. */
+        while( ( xMessagesReceived = xQueueReceiveMultiple( pxService->xTimerQueue, xMessages, ( UBaseType_t ) configTIMER_COMMAND_BATCH_SIZE, tmrNO_DELAY ) ) > ( BaseType_t ) 0 ) /*lint !e603 xMessages does not have to be initialised as it is passed out, not in. */
+        {
+            /* prvSampleTimeNow() must be called after the commands are received
+             * from the timer queue so there is no possibility of a higher
+             * priority task adding a command to the queue with a time that is
+             * ahead of the timer daemon task (because it pre-empted the timer
+             * daemon task after the xTimeNow value was set).  As every command
+             * in the batch was received before the time is sampled, sampling it
+             * once for the whole batch is enough.  In this case the
+             * xTimerListsWereSwitched parameter is not used, but it must be
+             * present in the function call. */
+            tmrENTER_LIST_ACCESS();
+            {
+                xTimeNow = prvSampleTimeNow( pxService, &xTimerListsWereSwitched );
+            }
+            tmrEXIT_LIST_ACCESS();
+
+            for( xMessageIndex = 0; xMessageIndex < xMessagesReceived; xMessageIndex++ )
+            {
+                pxMessage = &( xMessages[ xMessageIndex ] );
+
+                #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+                {
+                    /* Negative commands are pended function calls rather than timer
+                     * commands, other than tmrCOMMAND_WAKE_TIMER_TASK, which only
+                     * unblocks this task. */
+                    if( ( pxMessage->xMessageID < ( BaseType_t ) 0 ) && ( pxMessage->xMessageID != tmrCOMMAND_WAKE_TIMER_TASK ) )
+                    {
+                        const CallbackParameters_t * const pxCallback = &( pxMessage->u.xCallbackParameters );
+
+                        /* The timer uses the xCallbackParameters member to request a
+                         * callback be executed.  Check the callback is not NULL. */
+                        configASSERT( pxCallback );
+
+                        /* Call the function. */
+                        pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* INCLUDE_xTimerPendFunctionCall */
+
+                /* Commands that are positive are timer commands rather than pended
+                 * function calls. */
+                if( pxMessage->xMessageID >= ( BaseType_t ) 0 )
+                {
+                    tmrENTER_LIST_ACCESS();
+                    {
+                        /* The messages uses the xTimerParameters member to work on a
+                         * software timer. */
+                        pxTimer = pxMessage->u.xTimerParameters.pxTimer;
+
+                        if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+                        {
+                            /* The timer is in a list, remove it. */
+                            listFAST_REMOVE( &( pxTimer->xTimerListItem ) );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        traceTIMER_COMMAND_RECEIVED( pxTimer, pxMessage->xMessageID, pxMessage->u.xTimerParameters.xMessageValue );
+
+                        switch( pxMessage->xMessageID )
+                        {
+                            case tmrCOMMAND_START:
+                            case tmrCOMMAND_START_FROM_ISR:
+                            case tmrCOMMAND_RESET:
+                            case tmrCOMMAND_RESET_FROM_ISR:
+                                /* Start or restart a timer. */
+                                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+                                if( prvInsertTimerInActiveList( pxTimer, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, pxMessage->u.xTimerParameters.xMessageValue ) != pdFALSE )
+                                {
+                                    /* The timer expired before it was added to the active
+                                     * timer list.  Process it now. */
+                                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
+                                    {
+                                        prvReloadTimer( pxTimer, pxMessage->u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
+                                    }
+                                    else
+                                    {
+                                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                    }
+
+                                    /* Call the timer callback. */
+                                    prvCallTimerCallback( pxTimer );
+                                }
+                                else
+                                {
+                                    mtCOVERAGE_TEST_MARKER();
+                                }
+
+                                break;
+
+                            case tmrCOMMAND_STOP:
+                            case tmrCOMMAND_STOP_FROM_ISR:
+                                /* The timer has already been removed from the active list. */
+                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                break;
+
+                            case tmrCOMMAND_CHANGE_PERIOD:
+                            case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
+                                pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+                                pxTimer->xTimerPeriodInTicks = pxMessage->u.xTimerParameters.xMessageValue;
+                                configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+
+                                /* The new period does not really have a reference, and can
+                                 * be longer or shorter than the old one.  The command time is
+                                 * therefore set to the current time, and as the period cannot
+                                 * be zero the next expiry time can only be in the future,
+                                 * meaning (unlike for the xTimerStart() case above) there is
+                                 * no fail case that needs to be handled here. */
+                                ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
+                                break;
+
+                            case tmrCOMMAND_DELETE:
+                                #if ( configUSE_MIXED_CRITICALITY == 1 )
+                                {
+                                    /* A deleted timer's deferred callback is
+                                     * discarded. */
+                                    prvCancelDeferredCallback( pxService, pxTimer );
+                                }
+                                #endif
+
+                                #if ( configUSE_OBJECT_REGISTRY == 1 )
+                                {
+                                    vObjectRegistryRemove( &( pxTimer->xRegistryItem ) );
+                                }
+                                #endif
+
+                                #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+                                {
+                                    /* The timer has already been removed from the active list,
+                                     * just free up the memory if the memory was dynamically
+                                     * allocated. */
+                                    if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                                    {
+                                        vPortFreeObject( portOBJECT_POOL_TIMER, pxTimer );
+                                    }
+                                    else
+                                    {
+                                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                    }
+                                }
+                                #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
+                                {
+                                    /* If dynamic allocation is not enabled, the memory
+                                     * could not have been dynamically allocated. So there is
+                                     * no need to free the memory - just mark the timer as
+                                     * "not active". */
+                                    pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+                                }
+                                #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+                                break;
+
+                            default:
+                                /* Don't expect to get here. */
+                                break;
+                        }
+                    }
+                    tmrEXIT_LIST_ACCESS();
+                }
+            }
+        }
+    }
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 0 )
+
+        static void prvSwitchTimerLists( TimerService_t * const pxService )
+        {
+            TickType_t xNextExpireTime;
+            List_t * pxTemp;
+
+            /* The tick count has overflowed.  The timer lists must be switched.
+             * If there are any timers still referenced from the current timer list
+             * then they must have expired and should be processed before the lists
+             * are switched. */
+            while( listLIST_IS_EMPTY( pxService->pxCurrentTimerList ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxService->pxCurrentTimerList );
+
+                /* Process the expired timer.  For auto-reload timers, be careful to
+                 * process only expirations that occur on the current list.  Further
+                 * expirations must wait until after the lists are switched. */
+                prvProcessExpiredTimer( pxService, xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            pxTemp = pxService->pxCurrentTimerList;
+            pxService->pxCurrentTimerList = pxService->pxOverflowTimerList;
+            pxService->pxOverflowTimerList = pxTemp;
+        }
+
+    #else /* if ( configUSE_TIMER_WHEEL == 0 ) */
+
+        static void prvSwitchTimerLists( TimerService_t * const pxService )
+        {
+            TimerWheel_t * pxTemp;
+
+            /* As above, but advancing the current wheel to the end of time
+             * moves every timer it still holds into its expired list. */
+            prvAdvanceTimerWheel( pxService->pxCurrentTimerWheel, tmrMAX_TIME_BEFORE_OVERFLOW );
+
+            while( listLIST_IS_EMPTY( &( pxService->pxCurrentTimerWheel->xExpiredTimers ) ) == pdFALSE )
+            {
+                prvProcessExpiredTimer( pxService, listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxService->pxCurrentTimerWheel->xExpiredTimers ) ), tmrMAX_TIME_BEFORE_OVERFLOW );
+            }
+
+            /* The now empty wheel becomes the overflow wheel, so its cursor
+             * restarts from the beginning of the next tick count period. */
+            pxService->pxCurrentTimerWheel->xCursor = ( TickType_t ) 0U;
+
+            pxTemp = pxService->pxCurrentTimerWheel;
+            pxService->pxCurrentTimerWheel = pxService->pxOverflowTimerWheel;
+            pxService->pxOverflowTimerWheel = pxTemp;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvInitialiseTimerWheel( TimerWheel_t * const pxWheel )
+        {
+            UBaseType_t uxLevel, uxSlot;
+
+            pxWheel->xCursor = ( TickType_t ) 0U;
+            vListInitialise( &( pxWheel->xExpiredTimers ) );
+
+            for( uxLevel = 0; uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS; uxLevel++ )
+            {
+                for( uxSlot = 0; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                {
+                    vListInitialise( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) );
+                }
+            }
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvInsertTimerInWheel( TimerWheel_t * const pxWheel,
+                                           Timer_t * const pxTimer )
+        {
+            ListItem_t * const pxListItem = &( pxTimer->xTimerListItem );
+            List_t * const pxExpiredTimers = &( pxWheel->xExpiredTimers );
+            const TickType_t xExpiryTime = listGET_LIST_ITEM_VALUE( pxListItem );
+            TickType_t xDifference;
+            UBaseType_t uxLevel;
+
+            if( xExpiryTime <= pxWheel->xCursor )
+            {
+                /* Timers reach the expired list in nearly ascending order, so
+                 * check the end of the list before searching it. */
+                if( ( listLIST_IS_EMPTY( pxExpiredTimers ) != pdFALSE ) ||
+                    ( listGET_LIST_ITEM_VALUE( listGET_PREVIOUS( listGET_END_MARKER( pxExpiredTimers ) ) ) <= xExpiryTime ) )
+                {
+                    listFAST_INSERT_END( pxExpiredTimers, pxListItem );
+                }
+                else
+                {
+                    vListInsert( pxExpiredTimers, pxListItem );
+                }
+            }
+            else
+            {
+                /* Find the most significant digit in which the expiry time
+                 * differs from the cursor.  The expiry time is after the cursor
+                 * so that digit of the expiry time is the larger. */
+                xDifference = xExpiryTime ^ pxWheel->xCursor;
+
+                for( uxLevel = ( UBaseType_t ) tmrWHEEL_LEVELS - 1U; ( xDifference >> ( uxLevel * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS ) ) == ( TickType_t ) 0U; uxLevel-- )
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                listFAST_INSERT_END( &( pxWheel->xSlots[ uxLevel ][ tmrWHEEL_DIGIT( xExpiryTime, uxLevel ) ] ), pxListItem );
+            }
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static void prvAdvanceTimerWheel( TimerWheel_t * const pxWheel,
+                                          const TickType_t xTime )
+        {
+            List_t * pxSlot;
+            TickType_t xDifference;
+            UBaseType_t uxHighestLevel, uxLevel, uxSlot, uxLastSlot, uxSlotLimit;
+
+            configASSERT( xTime >= pxWheel->xCursor );
+
+            xDifference = xTime ^ pxWheel->xCursor;
+
+            if( xDifference != ( TickType_t ) 0U )
+            {
+                /* Find the most significant digit that changes. */
+                for( uxHighestLevel = ( UBaseType_t ) tmrWHEEL_LEVELS - 1U; ( xDifference >> ( uxHighestLevel * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS ) ) == ( TickType_t ) 0U; uxHighestLevel-- )
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+
+                /* Every timer below that level, and every timer in a slot of
+                 * that level that is passed over, expires before xTime.  The
+                 * timers in the slot that xTime lands in are put back into the
+                 * wheel relative to the new cursor, which expires those at or
+                 * before xTime and moves the others to lower levels.  The slots
+                 * are visited in ascending time order to keep the expired list
+                 * cheap to insert into.  The other slots are still correct for
+                 * the new cursor. */
+                uxLastSlot = tmrWHEEL_DIGIT( xTime, uxHighestLevel );
+                pxWheel->xCursor = xTime;
+
+                for( uxLevel = 0; uxLevel <= uxHighestLevel; uxLevel++ )
+                {
+                    uxSlotLimit = ( uxLevel == uxHighestLevel ) ? ( uxLastSlot + 1U ) : tmrWHEEL_SLOTS;
+
+                    for( uxSlot = 0; uxSlot < uxSlotLimit; uxSlot++ )
+                    {
+                        pxSlot = &( pxWheel->xSlots[ uxLevel ][ uxSlot ] );
+
+                        while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+                        {
+                            Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+                            listFAST_REMOVE( &( pxTimer->xTimerListItem ) );
+                            prvInsertTimerInWheel( pxWheel, pxTimer );
+                        }
+                    }
+                }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_WHEEL == 1 )
+
+        static TickType_t prvGetNextWheelExpireTime( TimerWheel_t * const pxWheel,
+                                                     BaseType_t * const pxWheelWasEmpty )
+        {
+            TickType_t xNextExpireTime = ( TickType_t ) 0U;
+            TickType_t xLowerDigitsMask;
+            UBaseType_t uxLevel, uxSlot, uxShift;
+
+            *pxWheelWasEmpty = pdTRUE;
+
+            if( listLIST_IS_EMPTY( &( pxWheel->xExpiredTimers ) ) == pdFALSE )
+            {
+                xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( &( pxWheel->xExpiredTimers ) );
+                *pxWheelWasEmpty = pdFALSE;
+            }
+            else
+            {
+                /* The timers in a level all expire before those in the levels
+                 * above it, and the timers in a level all expire after the
+                 * cursor's digit for that level, so the first occupied slot
+                 * found holds the next timer to expire. */
+                for( uxLevel = 0; ( uxLevel < ( UBaseType_t ) tmrWHEEL_LEVELS ) && ( *pxWheelWasEmpty != pdFALSE ); uxLevel++ )
+                {
+                    for( uxSlot = tmrWHEEL_DIGIT( pxWheel->xCursor, uxLevel ) + 1U; uxSlot < tmrWHEEL_SLOTS; uxSlot++ )
+                    {
+                        if( listLIST_IS_EMPTY( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) ) == pdFALSE )
+                        {
+                            /* The slot starts at the time that has the cursor's
+                             * digits above this level, uxSlot in this level, and
+                             * zero below it. */
+                            uxShift = uxLevel * ( UBaseType_t ) configTIMER_WHEEL_SLOT_BITS;
+                            xLowerDigitsMask = ( ( ( TickType_t ) ( tmrWHEEL_SLOTS - 1U ) ) << uxShift ) | ( ( ( TickType_t ) 1U << uxShift ) - ( TickType_t ) 1U );
+                            xNextExpireTime = ( pxWheel->xCursor & ~xLowerDigitsMask ) | ( ( TickType_t ) uxSlot << uxShift );
+                            *pxWheelWasEmpty = pdFALSE;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            return xNextExpireTime;
+        }
+
+    #endif /* configUSE_TIMER_WHEEL */
+/*-----------------------------------------------------------*/
+
+    static void prvInitialiseTimerService( TimerService_t * const pxService )
     {
-        return ( UBaseType_t ) xTimerGetReloadMode( xTimer );
+        #if ( configUSE_TIMER_WHEEL == 0 )
+        {
+            vListInitialise( &( pxService->xActiveTimerList1 ) );
+            vListInitialise( &( pxService->xActiveTimerList2 ) );
+            pxService->pxCurrentTimerList = &( pxService->xActiveTimerList1 );
+            pxService->pxOverflowTimerList = &( pxService->xActiveTimerList2 );
+        }
+        #else
+        {
+            prvInitialiseTimerWheel( &( pxService->xTimerWheel1 ) );
+            prvInitialiseTimerWheel( &( pxService->xTimerWheel2 ) );
+            pxService->pxCurrentTimerWheel = &( pxService->xTimerWheel1 );
+            pxService->pxOverflowTimerWheel = &( pxService->xTimerWheel2 );
+        }
+        #endif /* configUSE_TIMER_WHEEL */
+
+        pxService->xTimerQueue = NULL;
+        pxService->xTimerTaskHandle = NULL;
+        pxService->xLastTime = ( TickType_t ) 0U;
+
+        #if ( configUSE_TIMER_DIRECT_COMMANDS == 1 )
+        {
+            pxService->xTimerTaskWakeTime = ( TickType_t ) 0U;
+            pxService->xTimerTaskWaitsIndefinitely = pdFALSE;
+        }
+        #endif
+
+        #if ( configUSE_MIXED_CRITICALITY == 1 )
+        {
+            pxService->pxDeferredTimers = NULL;
+        }
+        #endif
     }
 /*-----------------------------------------------------------*/
 
-    TickType_t xTimerGetExpiryTime( TimerHandle_t xTimer )
+    static void prvCheckForValidListAndQueue( void )
+    {
+        /* Check that the list from which active timers are referenced, and the
+         * queue used to communicate with the timer service, have been
+         * initialised. */
+        taskENTER_CRITICAL();
+        {
+            if( xTimerService.xTimerQueue == NULL )
+            {
+                prvInitialiseTimerService( &xTimerService );
+
+                #if ( configUSE_TIMER_TICK_CALLBACKS == 1 )
+                {
+                    vListInitialise( &xTickTimerList1 );
+                    vListInitialise( &xTickTimerList2 );
+                    pxCurrentTickTimerList = &xTickTimerList1;
+                    pxOverflowTickTimerList = &xTickTimerList2;
+                }
+                #endif
+
+                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+                {
+                    /* The timer queue is allocated statically in case
+                     * configSUPPORT_DYNAMIC_ALLOCATION is 0. */
+                    PRIVILEGED_DATA static StaticQueue_t xStaticTimerQueue;                                                                          /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+                    PRIVILEGED_DATA static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+
+                    xTimerService.xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
+                }
+                #else
+                {
+                    xTimerService.xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
+                }
+                #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+
+                #if ( configQUEUE_REGISTRY_SIZE > 0 )
+                {
+                    if( xTimerService.xTimerQueue != NULL )
+                    {
+                        vQueueAddToRegistry( xTimerService.xTimerQueue, "TmrQ" );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif /* configQUEUE_REGISTRY_SIZE */
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+        taskEXIT_CRITICAL();
+    }
+/*-----------------------------------------------------------*/
+
+    BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
     {
+        BaseType_t xReturn;
         Timer_t * pxTimer = xTimer;
-        TickType_t xReturn;
 
         configASSERT( xTimer );
-        xReturn = listGET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ) );
+
+        /* Is the timer in the list of active timers? */
+        taskENTER_CRITICAL();
+        {
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0 )
+            {
+                xReturn = pdFALSE;
+            }
+            else
+            {
+                xReturn = pdTRUE;
+            }
+        }
+        taskEXIT_CRITICAL();
+
         return xReturn;
+    } /*lint !e818 Can't be pointer to const due to the typedef. */
+/*-----------------------------------------------------------*/
+
+    void * pvTimerGetTimerID( const TimerHandle_t xTimer )
+    {
+        Timer_t * const pxTimer = xTimer;
+        void * pvReturn;
+
+        configASSERT( xTimer );
+
+        taskENTER_CRITICAL();
+        {
+            pvReturn = pxTimer->pvTimerID;
+        }
+        taskEXIT_CRITICAL();
+
+        return pvReturn;
     }
 /*-----------------------------------------------------------*/
 
-    const char * pcTimerGetName( TimerHandle_t xTimer ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+    void vTimerSetTimerID( TimerHandle_t xTimer,
+                           void * pvNewID )
     {
-        Timer_t * pxTimer = xTimer;
+        Timer_t * const pxTimer = xTimer;
 
         configASSERT( xTimer );
-        return pxTimer->pcTimerName;
+
+        taskENTER_CRITICAL();
+        {
+            pxTimer->pvTimerID = pvNewID;
+        }
+        taskEXIT_CRITICAL();
     }
 /*-----------------------------------------------------------*/
 
-    static void prvReloadTimer( Timer_t * const pxTimer,
-                                TickType_t xExpiredTime,
-                                const TickType_t xTimeNow )
-    {
-        /* Insert the timer into the appropriate list for the next expiry time.
-         * If the next expiry time has already passed, advance the expiry time,
-         * call the callback function, and try again. */
-        while( prvInsertTimerInActiveList( pxTimer, ( xExpiredTime + pxTimer->xTimerPeriodInTicks ), xTimeNow, xExpiredTime ) != pdFALSE )
+    #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+        BaseType_t xTimerPendFunctionCallFromISR( PendedFunction_t xFunctionToPend,
+                                                  void * pvParameter1,
+                                                  uint32_t ulParameter2,
+                                                  BaseType_t * pxHigherPriorityTaskWoken )
+        {
+            DaemonTaskMessage_t xMessage;
+            BaseType_t xReturn;
+
+            /* Complete the message with the function parameters and post it to the
+             * daemon task. */
+            xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR;
+            xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+            xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+            xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+
+            xReturn = xQueueSendFromISR( xTimerService.xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+
+            tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+
+            return xReturn;
+        }
+
+    #endif /* INCLUDE_xTimerPendFunctionCall */
+/*-----------------------------------------------------------*/
+
+    #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+
+        BaseType_t xTimerPendFunctionCall( PendedFunction_t xFunctionToPend,
+                                           void * pvParameter1,
+                                           uint32_t ulParameter2,
+                                           TickType_t xTicksToWait )
         {
-            /* Advance the expiry time. */
-            xExpiredTime += pxTimer->xTimerPeriodInTicks;
+            DaemonTaskMessage_t xMessage;
+            BaseType_t xReturn;
 
-            /* Call the timer callback. */
-            traceTIMER_EXPIRED( pxTimer );
-            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-        }
-    }
-/*-----------------------------------------------------------*/
+            /* This function can only be called after a timer has been created or
+             * after the scheduler has been started because, until then, the timer
+             * queue does not exist. */
+            configASSERT( xTimerService.xTimerQueue );
 
-    static void prvProcessExpiredTimer( const TickType_t xNextExpireTime,
-                                        const TickType_t xTimeNow )
-    {
-        Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ); /*lint !e9087 !e9079 void * is used as this macro is used with tasks too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+            /* Complete the message with the function parameters and post it to the
+             * daemon task. */
+            xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
+            xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
+            xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
+            xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
 
-        /* Remove the timer from the list of active timers.  A check has already
-         * been performed to ensure the list is not empty. */
+            xReturn = xQueueSendToBack( xTimerService.xTimerQueue, &xMessage, xTicksToWait );
 
-        ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+            tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
 
-        /* If the timer is an auto-reload timer then calculate the next
-         * expiry time and re-insert the timer in the list of active timers. */
-        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-        {
-            prvReloadTimer( pxTimer, xNextExpireTime, xTimeNow );
-        }
-        else
-        {
-            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
+            return xReturn;
         }
 
-        /* Call the timer callback. */
-        traceTIMER_EXPIRED( pxTimer );
-        pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-    }
+    #endif /* INCLUDE_xTimerPendFunctionCall */
 /*-----------------------------------------------------------*/
 
-    static portTASK_FUNCTION( prvTimerTask, pvParameters )
-    {
-        TickType_t xNextExpireTime;
-        BaseType_t xListWasEmpty;
-
-        /* Just to avoid compiler warnings. */
-        ( void ) pvParameters;
+    #if ( configUSE_TIMER_PENDED_WORK == 1 )
 
-        #if ( configUSE_DAEMON_TASK_STARTUP_HOOK == 1 )
+        PendedWorkHandle_t xTimerInitialisePendedWork( StaticPendedWork_t * pxPendedWorkBuffer,
+                                                       PendedFunction_t xFunctionToPend,
+                                                       void * pvParameter1 )
         {
-            extern void vApplicationDaemonTaskStartupHook( void );
+            PendedWork_t * pxWork;
 
-            /* Allow the application writer to execute some code in the context of
-             * this task at the point the task starts executing.  This is useful if the
-             * application includes initialisation code that would benefit from
-             * executing after the scheduler has been started. */
-            vApplicationDaemonTaskStartupHook();
-        }
-        #endif /* configUSE_DAEMON_TASK_STARTUP_HOOK */
+            #if ( configASSERT_DEFINED == 1 )
+            {
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticPendedWork_t equals the size of the
+                 * real work item structure. */
+                volatile size_t xSize = sizeof( StaticPendedWork_t );
+                configASSERT( xSize == sizeof( PendedWork_t ) );
+                ( void ) xSize; /* Keeps lint quiet when configASSERT() is not defined. */
+            }
+            #endif /* configASSERT_DEFINED */
 
-        for( ; ; )
-        {
-            /* Query the timers list to see if it contains any timers, and if so,
-             * obtain the time at which the next timer will expire. */
-            xNextExpireTime = prvGetNextExpireTime( &xListWasEmpty );
+            configASSERT( pxPendedWorkBuffer );
+            configASSERT( xFunctionToPend );
 
-            /* If a timer has expired, process it.  Otherwise, block this task
-             * until either a timer does expire, or a command is received. */
-            prvProcessTimerOrBlockTask( xNextExpireTime, xListWasEmpty );
+            /* The timer command queue is needed to wake the timer service task
+             * when work is pended. */
+            prvCheckForValidListAndQueue();
 
-            /* Empty the command queue. */
-            prvProcessReceivedCommands();
+            pxWork = ( PendedWork_t * ) pxPendedWorkBuffer; /*lint !e740 !e9087 StaticPendedWork_t is a pointer to a PendedWork_t, so guaranteed to be aligned and sized correctly (checked by an assert()), so this is safe. */
+            pxWork->pxNext = NULL;
+            pxWork->pxFunction = xFunctionToPend;
+            pxWork->pvParameter1 = pvParameter1;
+            pxWork->ulParameter2 = 0U;
+            pxWork->xIsPending = pdFALSE;
+
+            return pxWork;
         }
-    }
+
+    #endif /* configUSE_TIMER_PENDED_WORK */
 /*-----------------------------------------------------------*/
 
-    static void prvProcessTimerOrBlockTask( const TickType_t xNextExpireTime,
-                                            BaseType_t xListWasEmpty )
-    {
-        TickType_t xTimeNow;
-        BaseType_t xTimerListsWereSwitched;
+    #if ( configUSE_TIMER_PENDED_WORK == 1 )
 
-        vTaskSuspendAll();
+        static BaseType_t prvAppendPendedWork( PendedWork_t * const pxWork,
+                                               const uint32_t ulParameter2,
+                                               BaseType_t * const pxListWasEmpty )
         {
-            /* Obtain the time now to make an assessment as to whether the timer
-             * has expired or not.  If obtaining the time causes the lists to switch
-             * then don't process this timer as any timers that remained in the list
-             * when the lists were switched will have been processed within the
-             * prvSampleTimeNow() function. */
-            xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+            BaseType_t xReturn;
 
-            if( xTimerListsWereSwitched == pdFALSE )
+            *pxListWasEmpty = pdFALSE;
+
+            if( pxWork->xIsPending == pdFALSE )
             {
-                /* The tick count has not overflowed, has the timer expired? */
-                if( ( xListWasEmpty == pdFALSE ) && ( xNextExpireTime <= xTimeNow ) )
+                pxWork->pxNext = NULL;
+                pxWork->ulParameter2 = ulParameter2;
+                pxWork->xIsPending = pdTRUE;
+
+                if( pxPendedWorkTail == NULL )
                 {
-                    ( void ) xTaskResumeAll();
-                    prvProcessExpiredTimer( xNextExpireTime, xTimeNow );
+                    pxPendedWorkHead = pxWork;
+                    *pxListWasEmpty = pdTRUE;
                 }
                 else
                 {
-                    /* The tick count has not overflowed, and the next expire
-                     * time has not been reached yet.  This task should therefore
-                     * block to wait for the next expire time or a command to be
-                     * received - whichever comes first.  The following line cannot
-                     * be reached unless xNextExpireTime > xTimeNow, except in the
-                     * case when the current timer list is empty. */
-                    if( xListWasEmpty != pdFALSE )
-                    {
-                        /* The current timer list is empty - is the overflow list
-                         * also empty? */
-                        xListWasEmpty = listLIST_IS_EMPTY( pxOverflowTimerList );
-                    }
-
-                    vQueueWaitForMessageRestricted( xTimerQueue, ( xNextExpireTime - xTimeNow ), xListWasEmpty );
-
-                    if( xTaskResumeAll() == pdFALSE )
-                    {
-                        /* Yield to wait for either a command to arrive, or the
-                         * block time to expire.  If a command arrived between the
-                         * critical section being exited and this yield then the yield
-                         * will not cause the task to block. */
-                        portYIELD_WITHIN_API();
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
+                    pxPendedWorkTail->pxNext = pxWork;
                 }
+
+                pxPendedWorkTail = pxWork;
+                xReturn = pdPASS;
             }
             else
             {
-                ( void ) xTaskResumeAll();
+                xReturn = pdFALSE;
             }
+
+            return xReturn;
         }
-    }
-/*-----------------------------------------------------------*/
 
-    static TickType_t prvGetNextExpireTime( BaseType_t * const pxListWasEmpty )
-    {
-        TickType_t xNextExpireTime;
+    #endif /* configUSE_TIMER_PENDED_WORK */
+/*-----------------------------------------------------------*/
 
-        /* Timers are listed in expiry time order, with the head of the list
-         * referencing the task that will expire first.  Obtain the time at which
-         * the timer with the nearest expiry time will expire.  If there are no
-         * active timers then just set the next expire time to 0.  That will cause
-         * this task to unblock when the tick count overflows, at which point the
-         * timer lists will be switched and the next expiry time can be
-         * re-assessed.  */
-        *pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+    #if ( configUSE_TIMER_PENDED_WORK == 1 )
 
-        if( *pxListWasEmpty == pdFALSE )
+        BaseType_t xTimerPendWork( PendedWorkHandle_t xWork,
+                                   uint32_t ulParameter2 )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            PendedWork_t * const pxWork = xWork;
+            DaemonTaskMessage_t xMessage;
+            BaseType_t xReturn;
+            BaseType_t xListWasEmpty;
+
+            configASSERT( xWork );
+            configASSERT( xTimerService.xTimerQueue );
+
+            taskENTER_CRITICAL();
+            {
+                xReturn = prvAppendPendedWork( pxWork, ulParameter2, &xListWasEmpty );
+            }
+            taskEXIT_CRITICAL();
+
+            if( xListWasEmpty != pdFALSE )
+            {
+                /* The timer service task executes every pending work item each
+                 * time it runs, so it only has to be woken when the first one is
+                 * added.  The result is not checked as the timer service task
+                 * runs anyway if the queue is full. */
+                xMessage.xMessageID = tmrCOMMAND_WAKE_TIMER_TASK;
+                ( void ) xQueueSendToBack( xTimerService.xTimerQueue, &xMessage, tmrNO_DELAY );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            tracePEND_FUNC_CALL( pxWork->pxFunction, pxWork->pvParameter1, ulParameter2, xReturn );
+
+            return xReturn;
         }
-        else
+
+    #endif /* configUSE_TIMER_PENDED_WORK */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_TIMER_PENDED_WORK == 1 )
+
+        BaseType_t xTimerPendWorkFromISR( PendedWorkHandle_t xWork,
+                                          uint32_t ulParameter2,
+                                          BaseType_t * pxHigherPriorityTaskWoken )
         {
-            /* Ensure the task unblocks when the tick count rolls over. */
-            xNextExpireTime = ( TickType_t ) 0U;
+            PendedWork_t * const pxWork = xWork;
+            DaemonTaskMessage_t xMessage;
+            UBaseType_t uxSavedInterruptStatus;
+            BaseType_t xReturn;
+            BaseType_t xListWasEmpty;
+
+            configASSERT( xWork );
+
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                xReturn = prvAppendPendedWork( pxWork, ulParameter2, &xListWasEmpty );
+            }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            if( xListWasEmpty != pdFALSE )
+            {
+                /* As per xTimerPendWork(). */
+                xMessage.xMessageID = tmrCOMMAND_WAKE_TIMER_TASK;
+                ( void ) xQueueSendToBackFromISR( xTimerService.xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+
+            tracePEND_FUNC_CALL_FROM_ISR( pxWork->pxFunction, pxWork->pvParameter1, ulParameter2, xReturn );
+
+            return xReturn;
         }
 
-        return xNextExpireTime;
-    }
+    #endif /* configUSE_TIMER_PENDED_WORK */
 /*-----------------------------------------------------------*/
 
-    static TickType_t prvSampleTimeNow( BaseType_t * const pxTimerListsWereSwitched )
-    {
-        TickType_t xTimeNow;
-        PRIVILEGED_DATA static TickType_t xLastTime = ( TickType_t ) 0U; /*lint !e956 Variable is only accessible to one task. */
-
-        xTimeNow = xTaskGetTickCount();
+    #if ( configUSE_TIMER_PENDED_WORK == 1 )
 
-        if( xTimeNow < xLastTime )
+        static void prvProcessPendedWork( void )
         {
-            prvSwitchTimerLists();
-            *pxTimerListsWereSwitched = pdTRUE;
+            PendedWork_t * pxWork;
+            PendedWork_t * pxNext;
+            PendedFunction_t pxFunction;
+            void * pvParameter1;
+            uint32_t ulParameter2;
+
+            /* Take the whole list, so work items pended while their functions
+             * are executing are left until next time rather than keeping this
+             * task here indefinitely. */
+            taskENTER_CRITICAL();
+            {
+                pxWork = pxPendedWorkHead;
+                pxPendedWorkHead = NULL;
+                pxPendedWorkTail = NULL;
+            }
+            taskEXIT_CRITICAL();
+
+            while( pxWork != NULL )
+            {
+                /* Once a work item is no longer pending it can be pended again,
+                 * which overwrites its members, so read them first. */
+                taskENTER_CRITICAL();
+                {
+                    pxNext = pxWork->pxNext;
+                    pxFunction = pxWork->pxFunction;
+                    pvParameter1 = pxWork->pvParameter1;
+                    ulParameter2 = pxWork->ulParameter2;
+                    pxWork->xIsPending = pdFALSE;
+                }
+                taskEXIT_CRITICAL();
+
+                pxFunction( pvParameter1, ulParameter2 );
+
+                pxWork = pxNext;
+            }
         }
-        else
+
+    #endif /* configUSE_TIMER_PENDED_WORK */
+/*-----------------------------------------------------------*/
+
+    #if ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) )
+
+        HRTimerHandle_t xHRTimerCreate( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                        const uint32_t ulPeriodInMicroseconds,
+                                        const BaseType_t xAutoReload,
+                                        void * const pvTimerID,
+                                        HRTimerCallbackFunction_t pxCallbackFunction )
         {
-            *pxTimerListsWereSwitched = pdFALSE;
-        }
+            HRTimer_t * pxNewTimer;
 
-        xLastTime = xTimeNow;
+            pxNewTimer = ( HRTimer_t * ) pvPortMalloc( sizeof( HRTimer_t ) ); /*lint !e9087 !e9079 All values returned by pvPortMalloc() have at least the alignment required by the MCU's stack, and the first member of HRTimer_t is always a pointer to the timer's name. */
 
-        return xTimeNow;
-    }
-/*-----------------------------------------------------------*/
+            if( pxNewTimer != NULL )
+            {
+                pxNewTimer->ucStatus = 0x00;
+                prvInitialiseNewHRTimer( pcTimerName, ulPeriodInMicroseconds, xAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
+            }
 
-    static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer,
-                                                  const TickType_t xNextExpiryTime,
-                                                  const TickType_t xTimeNow,
-                                                  const TickType_t xCommandTime )
-    {
-        BaseType_t xProcessTimerNow = pdFALSE;
+            return pxNewTimer;
+        }
 
-        listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xNextExpiryTime );
-        listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+    #endif /* ( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
 
-        if( xNextExpiryTime <= xTimeNow )
+    #if ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) )
+
+        HRTimerHandle_t xHRTimerCreateStatic( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                              const uint32_t ulPeriodInMicroseconds,
+                                              const BaseType_t xAutoReload,
+                                              void * const pvTimerID,
+                                              HRTimerCallbackFunction_t pxCallbackFunction,
+                                              StaticHRTimer_t * pxTimerBuffer )
         {
-            /* Has the expiry time elapsed between the command to start/reset a
-             * timer was issued, and the time the command was processed? */
-            if( ( ( TickType_t ) ( xTimeNow - xCommandTime ) ) >= pxTimer->xTimerPeriodInTicks ) /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+            HRTimer_t * pxNewTimer;
+
+            #if ( configASSERT_DEFINED == 1 )
             {
-                /* The time between a command being issued and the command being
-                 * processed actually exceeds the timers period.  */
-                xProcessTimerNow = pdTRUE;
+                /* Sanity check that the size of the structure used to declare a
+                 * variable of type StaticHRTimer_t equals the size of the real
+                 * timer structure. */
+                volatile size_t xSize = sizeof( StaticHRTimer_t );
+                configASSERT( xSize == sizeof( HRTimer_t ) );
+                ( void ) xSize; /* Keeps lint quiet when configASSERT() is not defined. */
             }
-            else
+            #endif /* configASSERT_DEFINED */
+
+            configASSERT( pxTimerBuffer );
+            pxNewTimer = ( HRTimer_t * ) pxTimerBuffer; /*lint !e740 !e9087 StaticHRTimer_t is a pointer to a HRTimer_t, so guaranteed to be aligned and sized correctly (checked by an assert()), so this is safe. */
+
+            if( pxNewTimer != NULL )
             {
-                vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+                pxNewTimer->ucStatus = tmrSTATUS_IS_STATICALLY_ALLOCATED;
+                prvInitialiseNewHRTimer( pcTimerName, ulPeriodInMicroseconds, xAutoReload, pvTimerID, pxCallbackFunction, pxNewTimer );
             }
+
+            return pxNewTimer;
         }
-        else
+
+    #endif /* ( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configUSE_HIGH_RESOLUTION_TIMERS == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+        static void prvInitialiseNewHRTimer( const char * const pcTimerName, /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
+                                             const uint32_t ulPeriodInMicroseconds,
+                                             const BaseType_t xAutoReload,
+                                             void * const pvTimerID,
+                                             HRTimerCallbackFunction_t pxCallbackFunction,
+                                             HRTimer_t * pxNewTimer )
         {
-            if( ( xTimeNow < xCommandTime ) && ( xNextExpiryTime >= xCommandTime ) )
+            /* 0 is not a valid value for ulPeriodInMicroseconds. */
+            configASSERT( ( ulPeriodInMicroseconds > 0 ) );
+
+            pxNewTimer->pcTimerName = pcTimerName;
+            pxNewTimer->pxNext = NULL;
+            pxNewTimer->ullExpiryTime = 0U;
+            pxNewTimer->ulPeriodInMicroseconds = ulPeriodInMicroseconds;
+            pxNewTimer->pvTimerID = pvTimerID;
+            pxNewTimer->pxCallbackFunction = pxCallbackFunction;
+
+            if( xAutoReload != pdFALSE )
+            {
+                pxNewTimer->ucStatus |= tmrSTATUS_IS_AUTORELOAD;
+            }
+        }
+
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+/*-----------------------------------------------------------*/
+
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
+
+        static void prvInsertHRTimer( HRTimer_t * const pxTimer )
+        {
+            HRTimer_t ** ppxNext = &pxActiveHRTimers;
+
+            /* Timers that expire at the same time expire in the order in which
+             * they were inserted. */
+            while( ( *ppxNext != NULL ) && ( ( *ppxNext )->ullExpiryTime <= pxTimer->ullExpiryTime ) )
             {
-                /* If, since the command was issued, the tick count has overflowed
-                 * but the expiry time has not, then the timer must have already passed
-                 * its expiry time and should be processed immediately. */
-                xProcessTimerNow = pdTRUE;
+                ppxNext = &( ( *ppxNext )->pxNext );
+            }
+
+            pxTimer->pxNext = *ppxNext;
+            *ppxNext = pxTimer;
+            pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+
+            if( pxActiveHRTimers == pxTimer )
+            {
+                portHR_TIMER_SET_COMPARE( pxTimer->ullExpiryTime );
             }
             else
             {
-                vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+                mtCOVERAGE_TEST_MARKER();
             }
         }
 
-        return xProcessTimerNow;
-    }
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 /*-----------------------------------------------------------*/
 
-    static void prvProcessReceivedCommands( void )
-    {
-        DaemonTaskMessage_t xMessage;
-        Timer_t * pxTimer;
-        BaseType_t xTimerListsWereSwitched;
-        TickType_t xTimeNow;
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-        while( xQueueReceive( xTimerQueue, &xMessage, tmrNO_DELAY ) != pdFAIL ) /*lint !e603 xMessage does not have to be initialised as it is passed out, not in, and it is not used unless xQueueReceive() returns pdTRUE. */
+        static void prvRemoveHRTimer( HRTimer_t * const pxTimer )
         {
-            #if ( INCLUDE_xTimerPendFunctionCall == 1 )
-            {
-                /* Negative commands are pended function calls rather than timer
-                 * commands. */
-                if( xMessage.xMessageID < ( BaseType_t ) 0 )
-                {
-                    const CallbackParameters_t * const pxCallback = &( xMessage.u.xCallbackParameters );
-
-                    /* The timer uses the xCallbackParameters member to request a
-                     * callback be executed.  Check the callback is not NULL. */
-                    configASSERT( pxCallback );
+            HRTimer_t ** ppxNext = &pxActiveHRTimers;
 
-                    /* Call the function. */
-                    pxCallback->pxCallbackFunction( pxCallback->pvParameter1, pxCallback->ulParameter2 );
-                }
-                else
+            if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) != 0U )
+            {
+                while( *ppxNext != pxTimer )
                 {
-                    mtCOVERAGE_TEST_MARKER();
+                    ppxNext = &( ( *ppxNext )->pxNext );
                 }
-            }
-            #endif /* INCLUDE_xTimerPendFunctionCall */
 
-            /* Commands that are positive are timer commands rather than pended
-             * function calls. */
-            if( xMessage.xMessageID >= ( BaseType_t ) 0 )
-            {
-                /* The messages uses the xTimerParameters member to work on a
-                 * software timer. */
-                pxTimer = xMessage.u.xTimerParameters.pxTimer;
+                *ppxNext = pxTimer->pxNext;
+                pxTimer->pxNext = NULL;
+                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
 
-                if( listIS_CONTAINED_WITHIN( NULL, &( pxTimer->xTimerListItem ) ) == pdFALSE ) /*lint !e961. The cast is only redundant when NULL is passed into the macro. */
+                /* If the timer was the first to expire the compare interrupt
+                 * is left as it is, and finds nothing to do if it fires before
+                 * the next timer expires. */
+                if( pxActiveHRTimers == NULL )
                 {
-                    /* The timer is in a list, remove it. */
-                    ( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+                    portHR_TIMER_DISABLE_COMPARE();
                 }
                 else
                 {
                     mtCOVERAGE_TEST_MARKER();
                 }
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
 
-                traceTIMER_COMMAND_RECEIVED( pxTimer, xMessage.xMessageID, xMessage.u.xTimerParameters.xMessageValue );
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+/*-----------------------------------------------------------*/
 
-                /* In this case the xTimerListsWereSwitched parameter is not used, but
-                 *  it must be present in the function call.  prvSampleTimeNow() must be
-                 *  called after the message is received from xTimerQueue so there is no
-                 *  possibility of a higher priority task adding a message to the message
-                 *  queue with a time that is ahead of the timer daemon task (because it
-                 *  pre-empted the timer daemon task after the xTimeNow value was set). */
-                xTimeNow = prvSampleTimeNow( &xTimerListsWereSwitched );
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-                switch( xMessage.xMessageID )
-                {
-                    case tmrCOMMAND_START:
-                    case tmrCOMMAND_START_FROM_ISR:
-                    case tmrCOMMAND_RESET:
-                    case tmrCOMMAND_RESET_FROM_ISR:
-                        /* Start or restart a timer. */
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
+        BaseType_t xHRTimerStart( HRTimerHandle_t xTimer )
+        {
+            HRTimer_t * const pxTimer = xTimer;
 
-                        if( prvInsertTimerInActiveList( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow, xMessage.u.xTimerParameters.xMessageValue ) != pdFALSE )
-                        {
-                            /* The timer expired before it was added to the active
-                             * timer list.  Process it now. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0 )
-                            {
-                                prvReloadTimer( pxTimer, xMessage.u.xTimerParameters.xMessageValue + pxTimer->xTimerPeriodInTicks, xTimeNow );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
+            configASSERT( xTimer );
 
-                            /* Call the timer callback. */
-                            traceTIMER_EXPIRED( pxTimer );
-                            pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
-                        }
-                        else
-                        {
-                            mtCOVERAGE_TEST_MARKER();
-                        }
+            taskENTER_CRITICAL();
+            {
+                prvRemoveHRTimer( pxTimer );
+                pxTimer->ullExpiryTime = portHR_TIMER_GET_TIME() + ( uint64_t ) pxTimer->ulPeriodInMicroseconds;
+                prvInsertHRTimer( pxTimer );
+            }
+            taskEXIT_CRITICAL();
 
-                        break;
+            return pdPASS;
+        }
 
-                    case tmrCOMMAND_STOP:
-                    case tmrCOMMAND_STOP_FROM_ISR:
-                        /* The timer has already been removed from the active list. */
-                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        break;
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+/*-----------------------------------------------------------*/
 
-                    case tmrCOMMAND_CHANGE_PERIOD:
-                    case tmrCOMMAND_CHANGE_PERIOD_FROM_ISR:
-                        pxTimer->ucStatus |= tmrSTATUS_IS_ACTIVE;
-                        pxTimer->xTimerPeriodInTicks = xMessage.u.xTimerParameters.xMessageValue;
-                        configASSERT( ( pxTimer->xTimerPeriodInTicks > 0 ) );
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-                        /* The new period does not really have a reference, and can
-                         * be longer or shorter than the old one.  The command time is
-                         * therefore set to the current time, and as the period cannot
-                         * be zero the next expiry time can only be in the future,
-                         * meaning (unlike for the xTimerStart() case above) there is
-                         * no fail case that needs to be handled here. */
-                        ( void ) prvInsertTimerInActiveList( pxTimer, ( xTimeNow + pxTimer->xTimerPeriodInTicks ), xTimeNow, xTimeNow );
-                        break;
+        BaseType_t xHRTimerStartFromISR( HRTimerHandle_t xTimer )
+        {
+            HRTimer_t * const pxTimer = xTimer;
+            UBaseType_t uxSavedInterruptStatus;
 
-                    case tmrCOMMAND_DELETE:
-                        #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
-                        {
-                            /* The timer has already been removed from the active list,
-                             * just free up the memory if the memory was dynamically
-                             * allocated. */
-                            if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
-                            {
-                                vPortFree( pxTimer );
-                            }
-                            else
-                            {
-                                pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                            }
-                        }
-                        #else /* if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) */
-                        {
-                            /* If dynamic allocation is not enabled, the memory
-                             * could not have been dynamically allocated. So there is
-                             * no need to free the memory - just mark the timer as
-                             * "not active". */
-                            pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
-                        }
-                        #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-                        break;
+            configASSERT( xTimer );
 
-                    default:
-                        /* Don't expect to get here. */
-                        break;
-                }
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+            {
+                prvRemoveHRTimer( pxTimer );
+                pxTimer->ullExpiryTime = portHR_TIMER_GET_TIME() + ( uint64_t ) pxTimer->ulPeriodInMicroseconds;
+                prvInsertHRTimer( pxTimer );
             }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            return pdPASS;
         }
-    }
+
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 /*-----------------------------------------------------------*/
 
-    static void prvSwitchTimerLists( void )
-    {
-        TickType_t xNextExpireTime;
-        List_t * pxTemp;
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-        /* The tick count has overflowed.  The timer lists must be switched.
-         * If there are any timers still referenced from the current timer list
-         * then they must have expired and should be processed before the lists
-         * are switched. */
-        while( listLIST_IS_EMPTY( pxCurrentTimerList ) == pdFALSE )
+        BaseType_t xHRTimerStop( HRTimerHandle_t xTimer )
         {
-            xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+            configASSERT( xTimer );
+
+            taskENTER_CRITICAL();
+            {
+                prvRemoveHRTimer( xTimer );
+            }
+            taskEXIT_CRITICAL();
 
-            /* Process the expired timer.  For auto-reload timers, be careful to
-             * process only expirations that occur on the current list.  Further
-             * expirations must wait until after the lists are switched. */
-            prvProcessExpiredTimer( xNextExpireTime, tmrMAX_TIME_BEFORE_OVERFLOW );
+            return pdPASS;
         }
 
-        pxTemp = pxCurrentTimerList;
-        pxCurrentTimerList = pxOverflowTimerList;
-        pxOverflowTimerList = pxTemp;
-    }
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 /*-----------------------------------------------------------*/
 
-    static void prvCheckForValidListAndQueue( void )
-    {
-        /* Check that the list from which active timers are referenced, and the
-         * queue used to communicate with the timer service, have been
-         * initialised. */
-        taskENTER_CRITICAL();
-        {
-            if( xTimerQueue == NULL )
-            {
-                vListInitialise( &xActiveTimerList1 );
-                vListInitialise( &xActiveTimerList2 );
-                pxCurrentTimerList = &xActiveTimerList1;
-                pxOverflowTimerList = &xActiveTimerList2;
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-                #if ( configSUPPORT_STATIC_ALLOCATION == 1 )
-                {
-                    /* The timer queue is allocated statically in case
-                     * configSUPPORT_DYNAMIC_ALLOCATION is 0. */
-                    PRIVILEGED_DATA static StaticQueue_t xStaticTimerQueue;                                                                          /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
-                    PRIVILEGED_DATA static uint8_t ucStaticTimerQueueStorage[ ( size_t ) configTIMER_QUEUE_LENGTH * sizeof( DaemonTaskMessage_t ) ]; /*lint !e956 Ok to declare in this manner to prevent additional conditional compilation guards in other locations. */
+        BaseType_t xHRTimerStopFromISR( HRTimerHandle_t xTimer )
+        {
+            UBaseType_t uxSavedInterruptStatus;
 
-                    xTimerQueue = xQueueCreateStatic( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, ( UBaseType_t ) sizeof( DaemonTaskMessage_t ), &( ucStaticTimerQueueStorage[ 0 ] ), &xStaticTimerQueue );
-                }
-                #else
-                {
-                    xTimerQueue = xQueueCreate( ( UBaseType_t ) configTIMER_QUEUE_LENGTH, sizeof( DaemonTaskMessage_t ) );
-                }
-                #endif /* if ( configSUPPORT_STATIC_ALLOCATION == 1 ) */
+            configASSERT( xTimer );
 
-                #if ( configQUEUE_REGISTRY_SIZE > 0 )
-                {
-                    if( xTimerQueue != NULL )
-                    {
-                        vQueueAddToRegistry( xTimerQueue, "TmrQ" );
-                    }
-                    else
-                    {
-                        mtCOVERAGE_TEST_MARKER();
-                    }
-                }
-                #endif /* configQUEUE_REGISTRY_SIZE */
-            }
-            else
+            uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
             {
-                mtCOVERAGE_TEST_MARKER();
+                prvRemoveHRTimer( xTimer );
             }
+            taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+            return pdPASS;
         }
-        taskEXIT_CRITICAL();
-    }
-/*-----------------------------------------------------------*/
 
-    BaseType_t xTimerIsTimerActive( TimerHandle_t xTimer )
-    {
-        BaseType_t xReturn;
-        Timer_t * pxTimer = xTimer;
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
+/*-----------------------------------------------------------*/
 
-        configASSERT( xTimer );
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-        /* Is the timer in the list of active timers? */
-        taskENTER_CRITICAL();
+        void vHRTimerDelete( HRTimerHandle_t xTimer )
         {
-            if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0 )
+            HRTimer_t * const pxTimer = xTimer;
+
+            configASSERT( xTimer );
+
+            taskENTER_CRITICAL();
             {
-                xReturn = pdFALSE;
+                prvRemoveHRTimer( pxTimer );
             }
-            else
+            taskEXIT_CRITICAL();
+
+            #if ( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
             {
-                xReturn = pdTRUE;
+                if( ( pxTimer->ucStatus & tmrSTATUS_IS_STATICALLY_ALLOCATED ) == ( uint8_t ) 0 )
+                {
+                    vPortFree( pxTimer );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
             }
+            #endif /* configSUPPORT_DYNAMIC_ALLOCATION */
         }
-        taskEXIT_CRITICAL();
 
-        return xReturn;
-    } /*lint !e818 Can't be pointer to const due to the typedef. */
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 /*-----------------------------------------------------------*/
 
-    void * pvTimerGetTimerID( const TimerHandle_t xTimer )
-    {
-        Timer_t * const pxTimer = xTimer;
-        void * pvReturn;
-
-        configASSERT( xTimer );
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-        taskENTER_CRITICAL();
+        BaseType_t xHRTimerIsTimerActive( HRTimerHandle_t xTimer )
         {
-            pvReturn = pxTimer->pvTimerID;
-        }
-        taskEXIT_CRITICAL();
-
-        return pvReturn;
-    }
-/*-----------------------------------------------------------*/
+            BaseType_t xReturn;
+            HRTimer_t * const pxTimer = xTimer;
 
-    void vTimerSetTimerID( TimerHandle_t xTimer,
-                           void * pvNewID )
-    {
-        Timer_t * const pxTimer = xTimer;
+            configASSERT( xTimer );
 
-        configASSERT( xTimer );
+            taskENTER_CRITICAL();
+            {
+                if( ( pxTimer->ucStatus & tmrSTATUS_IS_ACTIVE ) == 0U )
+                {
+                    xReturn = pdFALSE;
+                }
+                else
+                {
+                    xReturn = pdTRUE;
+                }
+            }
+            taskEXIT_CRITICAL();
 
-        taskENTER_CRITICAL();
-        {
-            pxTimer->pvTimerID = pvNewID;
+            return xReturn;
         }
-        taskEXIT_CRITICAL();
-    }
+
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 /*-----------------------------------------------------------*/
 
-    #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-        BaseType_t xTimerPendFunctionCallFromISR( PendedFunction_t xFunctionToPend,
-                                                  void * pvParameter1,
-                                                  uint32_t ulParameter2,
-                                                  BaseType_t * pxHigherPriorityTaskWoken )
+        void * pvHRTimerGetTimerID( const HRTimerHandle_t xTimer )
         {
-            DaemonTaskMessage_t xMessage;
-            BaseType_t xReturn;
-
-            /* Complete the message with the function parameters and post it to the
-             * daemon task. */
-            xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK_FROM_ISR;
-            xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
-            xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
-            xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+            HRTimer_t * const pxTimer = xTimer;
 
-            xReturn = xQueueSendFromISR( xTimerQueue, &xMessage, pxHigherPriorityTaskWoken );
-
-            tracePEND_FUNC_CALL_FROM_ISR( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+            configASSERT( xTimer );
 
-            return xReturn;
+            /* The ID is set when the timer is created and never changes. */
+            return pxTimer->pvTimerID;
         }
 
-    #endif /* INCLUDE_xTimerPendFunctionCall */
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 /*-----------------------------------------------------------*/
 
-    #if ( INCLUDE_xTimerPendFunctionCall == 1 )
+    #if ( configUSE_HIGH_RESOLUTION_TIMERS == 1 )
 
-        BaseType_t xTimerPendFunctionCall( PendedFunction_t xFunctionToPend,
-                                           void * pvParameter1,
-                                           uint32_t ulParameter2,
-                                           TickType_t xTicksToWait )
+        BaseType_t xHRTimerCompareHandler( void )
         {
-            DaemonTaskMessage_t xMessage;
-            BaseType_t xReturn;
+            HRTimer_t * pxTimer;
+            uint64_t ullTimeNow;
+            UBaseType_t uxSavedInterruptStatus;
+            BaseType_t xHigherPriorityTaskWoken = pdFALSE;
 
-            /* This function can only be called after a timer has been created or
-             * after the scheduler has been started because, until then, the timer
-             * queue does not exist. */
-            configASSERT( xTimerQueue );
+            do
+            {
+                pxTimer = NULL;
 
-            /* Complete the message with the function parameters and post it to the
-             * daemon task. */
-            xMessage.xMessageID = tmrCOMMAND_EXECUTE_CALLBACK;
-            xMessage.u.xCallbackParameters.pxCallbackFunction = xFunctionToPend;
-            xMessage.u.xCallbackParameters.pvParameter1 = pvParameter1;
-            xMessage.u.xCallbackParameters.ulParameter2 = ulParameter2;
+                uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+                {
+                    ullTimeNow = portHR_TIMER_GET_TIME();
 
-            xReturn = xQueueSendToBack( xTimerQueue, &xMessage, xTicksToWait );
+                    if( pxActiveHRTimers == NULL )
+                    {
+                        portHR_TIMER_DISABLE_COMPARE();
+                    }
+                    else if( pxActiveHRTimers->ullExpiryTime > ullTimeNow )
+                    {
+                        /* The port generates the interrupt straight away if
+                         * the expiry time passes before the compare channel is
+                         * programmed, so there is no race here. */
+                        portHR_TIMER_SET_COMPARE( pxActiveHRTimers->ullExpiryTime );
+                    }
+                    else
+                    {
+                        pxTimer = pxActiveHRTimers;
+                        pxActiveHRTimers = pxTimer->pxNext;
+                        pxTimer->pxNext = NULL;
+                        pxTimer->ucStatus &= ( ( uint8_t ) ~tmrSTATUS_IS_ACTIVE );
 
-            tracePEND_FUNC_CALL( xFunctionToPend, pvParameter1, ulParameter2, xReturn );
+                        if( ( pxTimer->ucStatus & tmrSTATUS_IS_AUTORELOAD ) != 0U )
+                        {
+                            /* The next expiry time is relative to the expiry
+                             * time, not to the time now, so the period does not
+                             * drift.  Expiries that have already been missed
+                             * entirely are skipped rather than called late. */
+                            pxTimer->ullExpiryTime += ( uint64_t ) pxTimer->ulPeriodInMicroseconds;
 
-            return xReturn;
+                            if( pxTimer->ullExpiryTime <= ullTimeNow )
+                            {
+                                pxTimer->ullExpiryTime = ullTimeNow + ( uint64_t ) pxTimer->ulPeriodInMicroseconds;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+
+                            prvInsertHRTimer( pxTimer );
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+                    }
+                }
+                taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+                /* The callback is called outside of the critical section, so
+                 * it can start and stop high resolution timers, including its
+                 * own. */
+                if( pxTimer != NULL )
+                {
+                    pxTimer->pxCallbackFunction( pxTimer, &xHigherPriorityTaskWoken );
+                }
+                else
+                {
+                    mtCOVERAGE_TEST_MARKER();
+                }
+            } while( pxTimer != NULL );
+
+            return xHigherPriorityTaskWoken;
         }
 
-    #endif /* INCLUDE_xTimerPendFunctionCall */
+    #endif /* configUSE_HIGH_RESOLUTION_TIMERS */
 /*-----------------------------------------------------------*/
 
     #if ( configUSE_TRACE_FACILITY == 1 )
@@ -0,0 +1,443 @@
+/*
+ * FreeRTOS Kernel <DEVELOPMENT BRANCH>
+ * Copyright (C) 2021 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ *
+ */
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+ * all the API functions to use the MPU wrappers.  That should only be done when
+ * task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Lint e961, e9021 and e750 are suppressed as a MISRA exception justified
+ * because the MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined
+ * for the header files above, but not in this file, in order to generate the
+ * correct privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750 !e9021. */
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace recorder.  This #if is closed at the very bottom of this
+ * file. */
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+    #ifndef configTRACE_RECORDER_TIMESTAMP
+        #if ( ( configGENERATE_RUN_TIME_STATS == 1 ) && defined( portGET_RUN_TIME_COUNTER_VALUE ) )
+            #define configTRACE_RECORDER_TIMESTAMP()    ( ( uint32_t ) portGET_RUN_TIME_COUNTER_VALUE() )
+        #else
+            #define configTRACE_RECORDER_TIMESTAMP()    ( ( uint32_t ) xTaskGetTickCountFromISR() )
+        #endif
+    #endif
+
+    #define traceRECORDER_INDEX_MASK    ( ( uint32_t ) configTRACE_RECORDER_BUFFER_LENGTH - 1U )
+
+/* Bits of the first byte of a record streamed out of the ITM. */
+    #define traceRECORDER_ITM_CORE_ID_BIT    ( ( uint8_t ) 0x40U )
+    #define traceRECORDER_ITM_DROPPED_BIT    ( ( uint8_t ) 0x80U )
+
+/* The longest ITM record - the first byte, the event ID, the core ID and four
+ * five byte varints - rounded up to whole 32-bit packets. */
+    #define traceRECORDER_ITM_MAX_RECORD_BYTES    ( 24U )
+
+    #if ( configTRACE_RECORDER_TRANSPORT == traceRECORDER_TRANSPORT_RAM )
+
+/*
+ * The ring buffer of one core.  Only the core itself writes records, and
+ * interrupts are masked while it does, so ulHead and ulDropped have a single
+ * writer.  ulTail is only written by the task that reads the buffer.  ulHead
+ * and ulTail are free running counts of the records written and read, so
+ * their difference is the number of records in the buffer even after they
+ * wrap.  portMEMORY_BARRIER() orders the writing of a record against the
+ * update of ulHead that makes it visible to the reader.
+ */
+        typedef struct TraceRecorderBuffer
+        {
+            volatile uint32_t ulHead;    /*< The number of records written, only updated by the core that owns the buffer. */
+            volatile uint32_t ulTail;    /*< The number of records read, only updated by the reader. */
+            volatile uint32_t ulDropped; /*< The number of events dropped because the buffer was full. */
+            TraceRecord_t xRecords[ configTRACE_RECORDER_BUFFER_LENGTH ];
+        } TraceRecorderBuffer_t;
+
+        PRIVILEGED_DATA static TraceRecorderBuffer_t xTraceRecorderBuffers[ configNUMBER_OF_CORES ];
+
+    #else /* configTRACE_RECORDER_TRANSPORT */
+
+/*
+ * The state of one core's ITM stream.  Only the core itself updates it, with
+ * interrupts masked, so each member has a single writer.  The previous
+ * timestamp and object are what the next record is encoded relative to.
+ */
+        typedef struct TraceRecorderStream
+        {
+            uint32_t ulPreviousTimestamp;
+            uint32_t ulPreviousObject;
+            uint32_t ulUnreported;       /*< The number of events dropped since the last record streamed. */
+            volatile uint32_t ulDropped; /*< The number of events dropped because the ITM FIFO was full. */
+        } TraceRecorderStream_t;
+
+        PRIVILEGED_DATA static TraceRecorderStream_t xTraceRecorderStreams[ configNUMBER_OF_CORES ];
+
+    #endif /* configTRACE_RECORDER_TRANSPORT */
+
+    PRIVILEGED_DATA static volatile BaseType_t xTraceRecorderRunning = pdTRUE;
+
+/*-----------------------------------------------------------*/
+
+    #if ( configTRACE_RECORDER_TRANSPORT == traceRECORDER_TRANSPORT_ITM )
+
+/*
+ * Appends ulValue to pucRecord at xIndex as an unsigned LEB128 varint, and
+ * returns the index that follows it.
+ */
+        static size_t prvEncodeVarint( uint8_t * pucRecord,
+                                       size_t xIndex,
+                                       uint32_t ulValue ) PRIVILEGED_FUNCTION;
+
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    #if ( configTRACE_RECORDER_TRANSPORT == traceRECORDER_TRANSPORT_RAM )
+
+        void vTraceRecorderEvent( uint8_t ucEventID,
+                                  uint32_t ulObject,
+                                  uint32_t ulValue )
+        {
+            TraceRecorderBuffer_t * pxBuffer;
+            TraceRecord_t * pxRecord;
+            UBaseType_t uxSavedInterruptStatus;
+            BaseType_t xCoreID;
+            uint32_t ulHead;
+
+            #if ( configUSE_TRACE_RECORDER_STREAM_HOOK == 1 )
+                BaseType_t xCallStreamHook = pdFALSE;
+            #endif
+
+            if( xTraceRecorderRunning != pdFALSE )
+            {
+                /* Masking interrupts stops an interrupt on this core recording an
+                 * event between the slot being chosen and ulHead being updated.
+                 * Other cores write to their own buffers, so no lock is needed. */
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+                {
+                    xCoreID = ( BaseType_t ) portGET_CORE_ID();
+                    pxBuffer = &( xTraceRecorderBuffers[ xCoreID ] );
+                    ulHead = pxBuffer->ulHead;
+
+                    if( ( ulHead - pxBuffer->ulTail ) < ( uint32_t ) configTRACE_RECORDER_BUFFER_LENGTH )
+                    {
+                        pxRecord = &( pxBuffer->xRecords[ ulHead & traceRECORDER_INDEX_MASK ] );
+                        pxRecord->ulTimestamp = configTRACE_RECORDER_TIMESTAMP();
+                        pxRecord->ulObject = ulObject;
+                        pxRecord->ulValue = ulValue;
+                        pxRecord->usSequence = ( uint16_t ) ( ulHead + pxBuffer->ulDropped );
+                        pxRecord->ucEventID = ucEventID;
+                        pxRecord->ucCoreID = ( uint8_t ) xCoreID;
+
+                        /* The record must be complete before the reader can see
+                         * it. */
+                        portMEMORY_BARRIER();
+                        pxBuffer->ulHead = ulHead + 1U;
+
+                        #if ( configUSE_TRACE_RECORDER_STREAM_HOOK == 1 )
+                        {
+                            if( ( ( ulHead + 1U ) - pxBuffer->ulTail ) == ( uint32_t ) configTRACE_RECORDER_STREAM_THRESHOLD )
+                            {
+                                xCallStreamHook = pdTRUE;
+                            }
+                            else
+                            {
+                                mtCOVERAGE_TEST_MARKER();
+                            }
+                        }
+                        #endif
+                    }
+                    else
+                    {
+                        ( pxBuffer->ulDropped )++;
+                    }
+                }
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+                #if ( configUSE_TRACE_RECORDER_STREAM_HOOK == 1 )
+                {
+                    if( xCallStreamHook != pdFALSE )
+                    {
+                        vApplicationTraceRecorderStreamHook( xCoreID );
+                    }
+                    else
+                    {
+                        mtCOVERAGE_TEST_MARKER();
+                    }
+                }
+                #endif
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        UBaseType_t uxTraceRecorderRead( BaseType_t xCoreID,
+                                         TraceRecord_t * pxRecords,
+                                         UBaseType_t uxMaxRecords )
+        {
+            TraceRecorderBuffer_t * pxBuffer;
+            uint32_t ulHead, ulTail;
+            UBaseType_t uxCount = 0;
+
+            configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+            configASSERT( ( pxRecords != NULL ) || ( uxMaxRecords == 0U ) );
+
+            pxBuffer = &( xTraceRecorderBuffers[ xCoreID ] );
+            ulTail = pxBuffer->ulTail;
+            ulHead = pxBuffer->ulHead;
+
+            /* Records are not read before the update of ulHead that published
+             * them. */
+            portMEMORY_BARRIER();
+
+            while( ( ulTail != ulHead ) && ( uxCount < uxMaxRecords ) )
+            {
+                pxRecords[ uxCount ] = pxBuffer->xRecords[ ulTail & traceRECORDER_INDEX_MASK ];
+                ulTail++;
+                uxCount++;
+            }
+
+            /* The records must be copied out before the writer can reuse their
+             * slots. */
+            portMEMORY_BARRIER();
+            pxBuffer->ulTail = ulTail;
+
+            return uxCount;
+        }
+/*-----------------------------------------------------------*/
+
+        uint32_t ulTraceRecorderGetDroppedCount( BaseType_t xCoreID )
+        {
+            configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+            return xTraceRecorderBuffers[ xCoreID ].ulDropped;
+        }
+/*-----------------------------------------------------------*/
+
+        const TraceRecord_t * pxTraceRecorderGetRecentRecord( BaseType_t xCoreID,
+                                                              UBaseType_t uxAge )
+        {
+            const TraceRecorderBuffer_t * pxBuffer;
+            const TraceRecord_t * pxRecord = NULL;
+            uint32_t ulHead;
+
+            configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+            pxBuffer = &( xTraceRecorderBuffers[ xCoreID ] );
+            ulHead = pxBuffer->ulHead;
+
+            /* Slots are only reused once they have been read, so the newest
+             * configTRACE_RECORDER_BUFFER_LENGTH records are always intact. */
+            if( ( ( uint32_t ) uxAge < ulHead ) && ( ( uint32_t ) uxAge < ( uint32_t ) configTRACE_RECORDER_BUFFER_LENGTH ) )
+            {
+                pxRecord = &( pxBuffer->xRecords[ ( ulHead - 1U - ( uint32_t ) uxAge ) & traceRECORDER_INDEX_MASK ] );
+            }
+
+            return pxRecord;
+        }
+/*-----------------------------------------------------------*/
+
+    #else /* configTRACE_RECORDER_TRANSPORT */
+
+        void vTraceRecorderEvent( uint8_t ucEventID,
+                                  uint32_t ulObject,
+                                  uint32_t ulValue )
+        {
+            TraceRecorderStream_t * pxStream;
+            UBaseType_t uxSavedInterruptStatus;
+            BaseType_t xCoreID;
+            uint8_t ucRecord[ traceRECORDER_ITM_MAX_RECORD_BYTES ];
+            uint8_t ucFirstByte = 0U;
+            size_t xLength = 1U;
+            size_t xIndex;
+            uint32_t ulTimestamp;
+            uint32_t ulPacket;
+
+            if( ( xTraceRecorderRunning != pdFALSE ) && portITM_PORT_ENABLED( configTRACE_RECORDER_ITM_PORT ) )
+            {
+                /* Masking interrupts stops an interrupt on this core streaming
+                 * an event in the middle of this one. */
+                uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+                {
+                    xCoreID = ( BaseType_t ) portGET_CORE_ID();
+                    pxStream = &( xTraceRecorderStreams[ xCoreID ] );
+
+                    /* Drop the event rather than stall if the FIFO is full.
+                     * Once a record is started the rest of it follows, as a
+                     * partial record would corrupt the stream. */
+                    if( portITM_PORT_READY( configTRACE_RECORDER_ITM_PORT ) )
+                    {
+                        ucRecord[ xLength ] = ucEventID;
+                        xLength++;
+
+                        #if ( configNUMBER_OF_CORES > 1 )
+                        {
+                            ucFirstByte |= traceRECORDER_ITM_CORE_ID_BIT;
+                            ucRecord[ xLength ] = ( uint8_t ) xCoreID;
+                            xLength++;
+                        }
+                        #endif
+
+                        if( pxStream->ulUnreported != 0U )
+                        {
+                            ucFirstByte |= traceRECORDER_ITM_DROPPED_BIT;
+                            xLength = prvEncodeVarint( ucRecord, xLength, pxStream->ulUnreported );
+                            pxStream->ulUnreported = 0U;
+                        }
+                        else
+                        {
+                            mtCOVERAGE_TEST_MARKER();
+                        }
+
+                        ulTimestamp = configTRACE_RECORDER_TIMESTAMP();
+                        xLength = prvEncodeVarint( ucRecord, xLength, ulTimestamp - pxStream->ulPreviousTimestamp );
+                        xLength = prvEncodeVarint( ucRecord, xLength, ulObject ^ pxStream->ulPreviousObject );
+                        xLength = prvEncodeVarint( ucRecord, xLength, ulValue );
+                        pxStream->ulPreviousTimestamp = ulTimestamp;
+                        pxStream->ulPreviousObject = ulObject;
+
+                        ucRecord[ 0 ] = ucFirstByte | ( uint8_t ) ( xLength - 1U );
+
+                        while( ( xLength & 3U ) != 0U )
+                        {
+                            ucRecord[ xLength ] = 0U;
+                            xLength++;
+                        }
+
+                        /* ITM packets are sent least significant byte
+                         * first. */
+                        for( xIndex = 0U; xIndex < xLength; xIndex += 4U )
+                        {
+                            ulPacket = ( uint32_t ) ucRecord[ xIndex ] |
+                                       ( ( uint32_t ) ucRecord[ xIndex + 1U ] << 8 ) |
+                                       ( ( uint32_t ) ucRecord[ xIndex + 2U ] << 16 ) |
+                                       ( ( uint32_t ) ucRecord[ xIndex + 3U ] << 24 );
+
+                            while( !portITM_PORT_READY( configTRACE_RECORDER_ITM_PORT ) )
+                            {
+                                /* Wait for the FIFO to accept the rest of the
+                                 * record. */
+                            }
+
+                            portITM_PORT_WRITE( configTRACE_RECORDER_ITM_PORT, ulPacket );
+                        }
+                    }
+                    else
+                    {
+                        ( pxStream->ulDropped )++;
+                        ( pxStream->ulUnreported )++;
+                    }
+                }
+                portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+            }
+            else
+            {
+                mtCOVERAGE_TEST_MARKER();
+            }
+        }
+/*-----------------------------------------------------------*/
+
+        static size_t prvEncodeVarint( uint8_t * pucRecord,
+                                       size_t xIndex,
+                                       uint32_t ulValue )
+        {
+            while( ulValue >= 0x80U )
+            {
+                pucRecord[ xIndex ] = ( uint8_t ) ( ( ulValue & 0x7FU ) | 0x80U );
+                xIndex++;
+                ulValue >>= 7;
+            }
+
+            pucRecord[ xIndex ] = ( uint8_t ) ulValue;
+
+            return xIndex + 1U;
+        }
+/*-----------------------------------------------------------*/
+
+        UBaseType_t uxTraceRecorderRead( BaseType_t xCoreID,
+                                         TraceRecord_t * pxRecords,
+                                         UBaseType_t uxMaxRecords )
+        {
+            configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+            /* Records are streamed out as they are recorded, so none are
+             * kept. */
+            ( void ) xCoreID;
+            ( void ) pxRecords;
+            ( void ) uxMaxRecords;
+
+            return 0U;
+        }
+/*-----------------------------------------------------------*/
+
+        uint32_t ulTraceRecorderGetDroppedCount( BaseType_t xCoreID )
+        {
+            configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+            return xTraceRecorderStreams[ xCoreID ].ulDropped;
+        }
+/*-----------------------------------------------------------*/
+
+        const TraceRecord_t * pxTraceRecorderGetRecentRecord( BaseType_t xCoreID,
+                                                              UBaseType_t uxAge )
+        {
+            configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+            ( void ) xCoreID;
+            ( void ) uxAge;
+
+            return NULL;
+        }
+/*-----------------------------------------------------------*/
+
+    #endif /* configTRACE_RECORDER_TRANSPORT */
+
+    void vTraceRecorderStart( void )
+    {
+        xTraceRecorderRunning = pdTRUE;
+    }
+/*-----------------------------------------------------------*/
+
+    void vTraceRecorderStop( void )
+    {
+        xTraceRecorderRunning = pdFALSE;
+    }
+/*-----------------------------------------------------------*/
+
+/* This entire source file will be skipped if the application is not configured
+ * to include the trace recorder.  If you want to include the trace recorder then
+ * ensure configUSE_TRACE_RECORDER is set to 1 in FreeRTOSConfig.h. */
+#endif /* configUSE_TRACE_RECORDER == 1 */